@@ -6,6 +6,15 @@ find_package(CUDA REQUIRED)
 
 include_directories(${CUDA_INCLUDE_DIRS})
 SET(ALL_CUDA_LIBS ${CUDA_LIBRARIES} ${CUDA_cusparse_LIBRARY} ${CUDA_cublas_LIBRARY})
+
+# nvJPEG comes with the toolkit since CUDA 10 (and with JetPack); MJPEG is decoded with it when it's there
+find_library(CUDA_nvjpeg_LIBRARY nvjpeg HINTS ${CUDA_TOOLKIT_ROOT_DIR} PATH_SUFFIXES lib64 lib lib/x64)
+if(CUDA_nvjpeg_LIBRARY)
+    add_definitions(-DRS2_USE_NVJPEG)
+    SET(ALL_CUDA_LIBS ${ALL_CUDA_LIBS} ${CUDA_nvjpeg_LIBRARY})
+else()
+    message(STATUS "nvJPEG not found: MJPEG is decoded on the CPU")
+endif()
 SET(LIBS ${LIBS} ${ALL_CUDA_LIBS})
 
 message(STATUS "CUDA_LIBRARIES: ${CUDA_INCLUDE_DIRS} ${ALL_CUDA_LIBS}")
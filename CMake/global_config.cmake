@@ -55,6 +55,18 @@ macro(global_set_flags)
         add_definitions(-DRS2_USE_CUDA)
     endif()
 
+    if (BUILD_WITH_VULKAN)
+        add_definitions(-DRS2_USE_VULKAN)
+    endif()
+
+    if (BUILD_WITH_OPENCL)
+        add_definitions(-DRS2_USE_OPENCL)
+    endif()
+
+    if (BUILD_WITH_TURBOJPEG)
+        add_definitions(-DRS2_USE_TURBOJPEG)
+    endif()
+
     if (BUILD_SHARED_LIBS)
         add_definitions(-DBUILD_SHARED_LIBS)
     endif()
@@ -63,6 +75,18 @@ macro(global_set_flags)
         include(CMake/cuda_config.cmake)
     endif()
 
+    if (BUILD_WITH_VULKAN)
+        include(CMake/vulkan_config.cmake)
+    endif()
+
+    if (BUILD_WITH_OPENCL)
+        include(CMake/opencl_config.cmake)
+    endif()
+
+    if (BUILD_WITH_TURBOJPEG)
+        include(CMake/turbojpeg_config.cmake)
+    endif()
+
     if(BUILD_PYTHON_BINDINGS)
         include(libusb_config)
         include(CMake/external_pybind11.cmake)
@@ -87,6 +111,23 @@ endmacro()
 macro(global_target_config)
     target_link_libraries(${LRS_TARGET} PRIVATE realsense-file ${CMAKE_THREAD_LIBS_INIT})
 
+    if (BUILD_WITH_VULKAN)
+        target_link_libraries(${LRS_TARGET} PRIVATE Vulkan::Vulkan)
+    endif()
+
+    if (BUILD_WITH_OPENCL)
+        target_link_libraries(${LRS_TARGET} PRIVATE OpenCL::OpenCL)
+    endif()
+
+    if (BUILD_WITH_CUDA AND CUDA_nvjpeg_LIBRARY)
+        target_link_libraries(${LRS_TARGET} PRIVATE ${CUDA_nvjpeg_LIBRARY})
+    endif()
+
+    if (BUILD_WITH_TURBOJPEG)
+        target_include_directories(${LRS_TARGET} PRIVATE ${TURBOJPEG_INCLUDE_DIR})
+        target_link_libraries(${LRS_TARGET} PRIVATE ${TURBOJPEG_LIBRARY})
+    endif()
+
     set_target_properties (${LRS_TARGET} PROPERTIES FOLDER Library)
 
     target_include_directories(${LRS_TARGET}
@@ -1,5 +1,8 @@
 option(ENABLE_CCACHE "Build with ccache." ON)
 option(BUILD_WITH_CUDA "Enable CUDA" OFF)
+option(BUILD_WITH_VULKAN "Enable Vulkan compute for processing blocks; needs no window, so works headless" OFF)
+option(BUILD_WITH_OPENCL "Enable OpenCL format conversions, e.g. on integrated GPUs" OFF)
+option(BUILD_WITH_TURBOJPEG "Decode MJPEG with libjpeg-turbo rather than stb_image" OFF)
 option(BUILD_GLSL_EXTENSIONS "Build GLSL extensions API" ON)
 option(BUILD_WITH_OPENMP "Use OpenMP" OFF)
 option(BUILD_EASYLOGGINGPP "Build EasyLogging++ as a part of the build" ON)
@@ -28,6 +31,7 @@ option(BUILD_OPENNI2_BINDINGS "Build OpenNI bindings" OFF)
 option(IMPORT_DEPTH_CAM_FW "Download the latest firmware for the depth cameras" ON)
 option(BUILD_CV_KINFU_EXAMPLE "Build OpenCV KinectFusion example" OFF)
 option(FORCE_RSUSB_BACKEND "Use RS USB backend, mandatory for Win7/MacOS/Android, optional for Linux" OFF)
+option(ENABLE_V4L2_EPOLL "Service all V4L2 capture nodes from one shared epoll thread pool instead of a select() thread per device (Linux only)" OFF)
 option(FORCE_LIBUVC "Explicitly turn-on libuvc backend - deprecated, use FORCE_RSUSB_BACKEND instead" OFF)
 option(FORCE_WINUSB_UVC "Explicitly turn-on winusb_uvc (for win7) backend - deprecated, use FORCE_RSUSB_BACKEND instead" OFF)
 option(ANDROID_USB_HOST_UVC "Build UVC backend for Android - deprecated, use FORCE_RSUSB_BACKEND instead" OFF)
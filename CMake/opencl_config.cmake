@@ -0,0 +1,12 @@
+info("Building with OpenCL requires CMake v3.7+")
+cmake_minimum_required(VERSION 3.7.0)
+
+find_package(OpenCL REQUIRED)
+
+# Kernels are built at run time, for whatever device there is; shared virtual memory needs the 2.0 API, but is only
+# used where the device has it
+add_definitions(-DCL_TARGET_OPENCL_VERSION=200)
+# Queues are made the 1.2 way, which 2.0 deprecates, so 1.2 devices can be used too
+add_definitions(-DCL_USE_DEPRECATED_OPENCL_1_2_APIS)
+
+message(STATUS "OpenCL ${OpenCL_VERSION_STRING}: ${OpenCL_LIBRARIES}")
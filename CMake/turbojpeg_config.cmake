@@ -0,0 +1,10 @@
+# libjpeg-turbo's TurboJPEG API: libturbojpeg0-dev on Debian/Ubuntu, libjpeg-turbo-devel on Fedora, or the
+# libjpeg-turbo installer on Windows (point CMAKE_PREFIX_PATH at it)
+find_path(TURBOJPEG_INCLUDE_DIR turbojpeg.h)
+find_library(TURBOJPEG_LIBRARY NAMES turbojpeg turbojpeg-static)
+
+if(NOT TURBOJPEG_INCLUDE_DIR OR NOT TURBOJPEG_LIBRARY)
+    message(FATAL_ERROR "BUILD_WITH_TURBOJPEG requires libjpeg-turbo's turbojpeg.h and library")
+endif()
+
+message(STATUS "TurboJPEG: ${TURBOJPEG_LIBRARY}")
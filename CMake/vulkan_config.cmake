@@ -0,0 +1,11 @@
+info("Building with Vulkan requires CMake v3.19+")
+cmake_minimum_required(VERSION 3.19.0)
+
+find_package(Vulkan REQUIRED)
+
+# The compute shaders are compiled to SPIR-V as part of the build
+if(NOT Vulkan_GLSLC_EXECUTABLE)
+    message(FATAL_ERROR "Building with Vulkan requires glslc, from the Vulkan SDK or shaderc")
+endif()
+
+message(STATUS "Vulkan: ${Vulkan_LIBRARIES}, ${Vulkan_GLSLC_EXECUTABLE}")
@@ -21,6 +21,8 @@
 #include "subdevice-model.h"
 #include "device-model.h"
 
+#include <iomanip>
+
 using namespace rs400;
 using rsutils::json;
 using namespace rs2::sw_update;
@@ -3188,7 +3190,13 @@ namespace rs2
                                 }
                             });
 
-                            label = rsutils::string::from() << pb->get_name() << "##" << id;
+                            // The cost of the filter on this machine, while it runs
+                            auto took = pb->is_enabled() && sub->post_processing_enabled ? pb->get_average_time_ms() : 0.f;
+                            if( took )
+                                label = rsutils::string::from() << pb->get_name() << " (" << std::fixed
+                                                                << std::setprecision( 2 ) << took << " ms)##" << id;
+                            else
+                                label = rsutils::string::from() << pb->get_name() << "##" << id;
                             if (ImGui::TreeNode(label.c_str()))
                             {
                                 pb->draw_options( viewer,
@@ -89,6 +89,7 @@ void post_processing_filters::zero_first_pixel(const rs2::frame& f)
 
 void post_processing_filters::map_id(rs2::frame new_frame, rs2::frame old_frame)
 {
+    std::lock_guard<std::mutex> lock(origin_mutex);
     if (auto new_set = new_frame.as<rs2::frameset>())
     {
         if (auto old_set = old_frame.as<rs2::frameset>())
@@ -180,6 +181,7 @@ std::vector<rs2::frame> post_processing_filters::handle_frame(rs2::frame f, cons
 
     if (viewer.is_3d_view)
     {
+        std::lock_guard<std::mutex> lock(pc_mutex);
         if (auto depth = viewer.get_3d_depth_source(filtered))
         {
             switch (depth.get_profile().format())
@@ -231,8 +233,40 @@ void post_processing_filters::stop()
         viewer.syncer->stop();
         render_thread->join();
         render_thread.reset();
+        stop_stream_workers();
     }
 }
+
+void post_processing_filters::stop_stream_workers()
+{
+    for (auto&& w : stream_workers)
+    {
+        w.second->done = true;
+        w.second->thread.join();
+    }
+    stream_workers.clear();
+}
+
+void post_processing_filters::stream_loop(int id, rs2::frame_queue queue, stream_worker& worker)
+{
+    while (render_thread_active && !worker.done)
+    {
+        try
+        {
+            frame frm;
+            if (queue.try_wait_for_frame(&frm, 30))
+                processing_block.invoke(frm);
+        }
+        catch (...) {}
+
+        // Until the stream closes
+        std::lock_guard<std::mutex> lock(viewer.streams_mutex);
+        if (!frames_queue.count(id))
+            break;
+    }
+    worker.done = true;
+}
+
 void post_processing_filters::render_loop()
 {
     while (render_thread_active)
@@ -241,14 +275,46 @@ void post_processing_filters::render_loop()
         {
             if (viewer.synchronization_enable)
             {
+                stop_stream_workers();
                 auto frames = viewer.syncer->try_wait_for_frames();
                 for (auto f : frames)
                 {
                     processing_block.invoke(f);
                 }
             }
+            else if (!config_file::instance().get(configurations::performance::glsl_for_processing))
+            {
+                std::map<int, rs2::frame_queue> frames_queue_local;
+                {
+                    std::lock_guard<std::mutex> lock(viewer.streams_mutex);
+                    frames_queue_local = frames_queue;
+                }
+                for (auto it = stream_workers.begin(); it != stream_workers.end();)
+                {
+                    if (it->second->done)
+                    {
+                        it->second->thread.join();
+                        it = stream_workers.erase(it);
+                    }
+                    else
+                        ++it;
+                }
+                for (auto&& q : frames_queue_local)
+                {
+                    auto& worker = stream_workers[q.first];
+                    if (worker)
+                        continue;
+                    worker.reset(new stream_worker());
+                    auto w = worker.get();
+                    int id = q.first;
+                    auto queue = q.second;
+                    w->thread = std::thread([this, id, queue, w]() { stream_loop(id, queue, *w); });
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            }
             else
             {
+                stop_stream_workers();
                 std::map<int, rs2::frame_queue> frames_queue_local;
                 {
                     std::lock_guard<std::mutex> lock(viewer.streams_mutex);
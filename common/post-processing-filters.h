@@ -6,6 +6,7 @@
 #include <librealsense2-gl/rs_processing_gl.hpp>
 #include <string>
 #include <map>
+#include <mutex>
 #include <thread>
 #include "opengl3.h"
 #include <GLFW/glfw3.h>
@@ -108,6 +109,19 @@ namespace rs2
         std::shared_ptr<std::thread> render_thread;              // Post processing filter rendering Thread running render_loop()
         void render_loop();                     // Post processing filter rendering function
 
+        /* Without synchronization, each stream's frames go through the filters on a thread of its own, so that the
+           streams don't wait for one another; the GLSL blocks stay on the rendering thread */
+        struct stream_worker
+        {
+            std::thread thread;
+            std::atomic<bool> done{ false };
+        };
+        std::map<int, std::unique_ptr<stream_worker>> stream_workers;   // By the stream of frames_queue; render_loop's
+        void stream_loop(int id, rs2::frame_queue queue, stream_worker& worker);
+        void stop_stream_workers();
+        std::mutex origin_mutex;                // The streams map their ids at once
+        std::mutex pc_mutex;                    // While the depth's points are made, the texture's map is kept
+
         std::shared_ptr<gl::uploader> uploader; // GL element that helps pre-emptively copy frames to the GPU
     };
 }
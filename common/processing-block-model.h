@@ -4,6 +4,8 @@
 #pragma once
 
 #include <librealsense2/rs.hpp>
+#include <atomic>
+#include <chrono>
 #include <string>
 
 
@@ -26,7 +28,19 @@ namespace rs2
 
         const std::string& get_name() const { return _name; }
 
-        rs2::frame invoke( rs2::frame f ) const { return _invoker( f ); }
+        rs2::frame invoke( rs2::frame f ) const
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto res = _invoker( f );
+            std::chrono::duration< float, std::milli > took = std::chrono::steady_clock::now() - start;
+            // Frames of several streams may be timed at once; one that's lost to another is no loss
+            float average = _average_ms.load();
+            _average_ms = average ? average + 0.05f * ( took.count() - average ) : took.count();
+            return res;
+        }
+
+        // A moving average of the time invoke() takes, or 0 before any frame
+        float get_average_time_ms() const { return _average_ms.load(); }
 
         void save_to_config_file();
 
@@ -63,6 +77,7 @@ namespace rs2
         std::string _full_name;
         std::function<rs2::frame( rs2::frame )> _invoker;
         subdevice_model* _owner;
+        mutable std::atomic< float > _average_ms{ 0.f };
     };
 
     void save_processing_block_to_config_file(const char* name,
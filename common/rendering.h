@@ -384,6 +384,77 @@ namespace rs2
         GLuint texture;
         rs2::frame_queue last_queue[2];
         mutable rs2::frame last[2];
+
+        // What the texture's storage was last allocated as: while frames keep to it, they are uploaded into it
+        struct texture_storage
+        {
+            GLint internal_format = 0;
+            int width = 0, height = 0;
+            GLenum format = 0, type = 0;
+
+            bool operator==(const texture_storage& other) const
+            {
+                return internal_format == other.internal_format && width == other.width && height == other.height
+                    && format == other.format && type == other.type;
+            }
+        } storage;
+
+        // A ring of pixel buffers the frames are copied to, so that the driver can transfer one to the texture while
+        // the next is written, rather than stalling the render thread on the copy from the frame
+        static const int pixel_buffers = 3;
+        GLuint pbo[pixel_buffers] = {};
+        int next_pbo = 0;
+
+        static int bytes_per_pixel(GLenum format, GLenum type)
+        {
+            int components = 1;
+            switch (format)
+            {
+            case GL_RG: case GL_LUMINANCE_ALPHA: components = 2; break;
+            case GL_RGB: components = 3; break;
+            case GL_RGBA: components = 4; break;
+            }
+            return components * (type == GL_FLOAT ? 4 : type == GL_UNSIGNED_SHORT ? 2 : 1);
+        }
+
+        // glTexImage2D of the texture bound, that only allocates the storage when there's none of this kind yet
+        void tex_image(GLint internal_format, int width, int height, GLenum format, GLenum type, const void* data)
+        {
+            texture_storage wanted{ internal_format, width, height, format, type };
+            if (!(storage == wanted) || !data || !GLAD_GL_VERSION_3_0)
+            {
+                glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, type, data);
+                storage = data ? wanted : texture_storage();
+                return;
+            }
+
+            // Frames are tightly packed: the buffer is uploaded as such
+            const GLsizeiptr size = GLsizeiptr(width) * height * bytes_per_pixel(format, type);
+            if (!pbo[0])
+                glGenBuffers(pixel_buffers, pbo);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[next_pbo]);
+            next_pbo = (next_pbo + 1) % pixel_buffers;
+
+            // Orphaned, the last contents stay with the driver until it's done with them
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+            if (auto mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT))
+            {
+                memcpy(mapped, data, size);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+                GLint alignment = 4;
+                glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+                glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, type, nullptr);
+                glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+            else
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, type, data);
+            }
+        }
     public:
         std::shared_ptr<colorizer> colorize;
         std::shared_ptr<yuy_decoder> yuy2rgb;
@@ -395,11 +466,13 @@ namespace rs2
         texture_buffer(const texture_buffer& other)
         {
             texture = other.texture;
+            storage = other.storage;
         }
 
         texture_buffer& operator=(const texture_buffer& other)
         {
             texture = other.texture;
+            storage = other.storage;
             return *this;
         }
 
@@ -430,6 +503,7 @@ namespace rs2
                 glGenTextures(1, &texture);
             glBindTexture(GL_TEXTURE_2D, texture);
             glTexImage2D(GL_TEXTURE_2D, 0, format, w, h, 0, format, GL_UNSIGNED_BYTE, data);
+            storage = texture_storage();
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
@@ -484,13 +558,13 @@ namespace rs2
                     {
                         // Upload vertices
                         data = pc.get_vertices();
-                        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, data);
+                        tex_image(GL_RGB16F, width, height, GL_RGB, GL_FLOAT, data);
                     }
                     else
                     {
                         // Upload texture coordinates
                         data = pc.get_texture_coordinates();
-                        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, width, height, 0, GL_RG, GL_FLOAT, data);
+                        tex_image(GL_RG16F, width, height, GL_RG, GL_FLOAT, data);
                     }
 
                     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -518,11 +592,11 @@ namespace rs2
                     {
                         if (prefered_format == RS2_FORMAT_Z16)
                         {
-                            glTexImage2D(GL_TEXTURE_2D, 0, GL_RG8, width, height, 0, GL_RG, GL_UNSIGNED_BYTE, data);
+                            tex_image(GL_RG8, width, height, GL_RG, GL_UNSIGNED_BYTE, data);
                         }
                         else if (prefered_format == RS2_FORMAT_DISPARITY32)
                         {
-                            glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, width, height, 0, GL_RED, GL_FLOAT, data);
+                            tex_image(GL_R32F, width, height, GL_RED, GL_FLOAT, data);
                         }
                         else
                         {
@@ -532,10 +606,10 @@ namespace rs2
                                 {
                                     data = colorized_frame.get_data();
 
-                                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB,
+                                    tex_image(GL_RGB,
                                         colorized_frame.get_width(),
                                         colorized_frame.get_height(),
-                                        0, GL_RGB, GL_UNSIGNED_BYTE,
+                                        GL_RGB, GL_UNSIGNED_BYTE,
                                         data);
 
                                 }
@@ -543,13 +617,13 @@ namespace rs2
                             }
                         }
                     }
-                    else glTexImage2D(GL_TEXTURE_2D, 0, GL_RG8, width, height, 0, GL_RG, GL_UNSIGNED_BYTE, data);
+                    else tex_image(GL_RG8, width, height, GL_RG, GL_UNSIGNED_BYTE, data);
                     break;
                 case RS2_FORMAT_FG:
-                    glTexImage2D( GL_TEXTURE_2D, 0, GL_LUMINANCE, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_SHORT, data);
+                    tex_image(GL_LUMINANCE, width, height, GL_LUMINANCE, GL_UNSIGNED_SHORT, data);
                     break;
                 case RS2_FORMAT_XYZ32F:
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_FLOAT, data);
+                    tex_image(GL_RGB, width, height, GL_RGB, GL_FLOAT, data);
                     break;
                 case RS2_FORMAT_YUYV:
                     if (yuy2rgb)
@@ -561,10 +635,10 @@ namespace rs2
                                 glBindTexture(GL_TEXTURE_2D, texture);
                                 data = colorized_frame.get_data();
 
-                                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB,
+                                tex_image(GL_RGB,
                                     colorized_frame.get_width(),
                                     colorized_frame.get_height(),
-                                    0, GL_RGB, GL_UNSIGNED_BYTE,
+                                    GL_RGB, GL_UNSIGNED_BYTE,
                                     colorized_frame.get_data());
                             }
                             rendered_frame = colorized_frame;
@@ -572,7 +646,7 @@ namespace rs2
                     }
                     else
                     {
-                        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, data);
+                        tex_image(GL_RGB, width, height, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, data);
                     }
                     break;
                 case RS2_FORMAT_Y411:
@@ -585,10 +659,10 @@ namespace rs2
                                 glBindTexture(GL_TEXTURE_2D, texture);
                                 data = colorized_frame.get_data();
 
-                                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB,
+                                tex_image(GL_RGB,
                                     colorized_frame.get_width(),
                                     colorized_frame.get_height(),
-                                    0, GL_RGB, GL_UNSIGNED_BYTE,
+                                    GL_RGB, GL_UNSIGNED_BYTE,
                                     colorized_frame.get_data());
                             }
                             rendered_frame = colorized_frame;
@@ -596,20 +670,20 @@ namespace rs2
                     }
                     else
                     {
-                        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, data);
+                        tex_image(GL_RGB, width, height, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, data);
                     }
                     break;
                 case RS2_FORMAT_UYVY: // Use luminance component only to avoid costly UVUY->RGB conversion
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_SHORT, data);
+                    tex_image(GL_LUMINANCE, width, height, GL_LUMINANCE, GL_UNSIGNED_SHORT, data);
                     break;
                 case RS2_FORMAT_RGB8: case RS2_FORMAT_BGR8: // Display both RGB and BGR by interpreting them RGB, to show the flipped byte ordering. Obviously, GL_BGR could be used on OpenGL 1.2+
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+                    tex_image(GL_RGB, width, height, GL_RGB, GL_UNSIGNED_BYTE, data);
                     break;
                 case RS2_FORMAT_RGBA8: case RS2_FORMAT_BGRA8: // Display both RGBA and BGRA by interpreting them RGBA, to show the flipped byte ordering. Obviously, GL_BGRA could be used on OpenGL 1.2+
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                    tex_image(GL_RGBA, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
                     break;
                 case RS2_FORMAT_Y8:
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, data);
+                    tex_image(GL_RGB, width, height, GL_LUMINANCE, GL_UNSIGNED_BYTE, data);
                     break;
                 case RS2_FORMAT_MOTION_XYZ32F:
                 {
@@ -638,12 +712,12 @@ namespace rs2
                 }
                 case RS2_FORMAT_Y16:
                 case RS2_FORMAT_Y10BPACK:
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_SHORT, data);
+                    tex_image(GL_RGB, width, height, GL_LUMINANCE, GL_UNSIGNED_SHORT, data);
                     break;
                 case RS2_FORMAT_RAW8:
                 case RS2_FORMAT_MOTION_RAW:
                 case RS2_FORMAT_GPIO_RAW:
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, data);
+                    tex_image(GL_LUMINANCE, width, height, GL_LUMINANCE, GL_UNSIGNED_BYTE, data);
                     break;
                 case RS2_FORMAT_6DOF:
                 {
@@ -680,7 +754,7 @@ namespace rs2
                 default:
                 {
                     memset((void*)data, 0, height*width);
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, data);
+                    tex_image(GL_LUMINANCE, width, height, GL_LUMINANCE, GL_UNSIGNED_BYTE, data);
                 }
                 }
 
@@ -42,6 +42,8 @@ rs2_context* rs2_create_context(int api_version, rs2_error** error);
 *             raw: leave all formats from camera as they are
 *         options-update-interval: 1000 - (uint32_t) time interval in milliseconds for option value change notifications
 *             (see rs2_set_options_changed_callback)
+*         lazy-backend: false           - (bool) start the device factories (USB/UVC watchers, DDS) only once devices
+*             are first queried or device changes subscribed to, so contexts for playback or software devices never do
 * \param[out] error  If non-null, receives any error that occurs during this call, otherwise, errors are ignored.
 * \return            Context object
 */
@@ -73,6 +75,8 @@ void rs2_set_devices_changed_callback(const rs2_context* context, rs2_devices_ch
 
 /**
  * Create a new device and add it to the context
+ * A file recorded from several devices (see rs2_create_multi_record_device) adds a device for each of them; the
+ * first is returned, and the others are listed by rs2_query_devices
  * \param ctx   The context to which the new device will be added
  * \param file  The file from which the device should be created
  * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
@@ -89,7 +93,7 @@ rs2_device* rs2_context_add_device(rs2_context* ctx, const char* file, rs2_error
 void rs2_context_add_software_device(rs2_context* ctx, rs2_device* dev, rs2_error** error);
 
 /**
- * Removes a playback device from the context, if exists
+ * Removes a playback device from the context, if exists, and the others of a file recorded from several devices
  * \param[in]  ctx       The context from which the device should be removed
  * \param[in]  file      The file name that was used to add the device
  * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
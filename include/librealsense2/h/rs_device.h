@@ -48,6 +48,17 @@ int rs2_device_list_contains(const rs2_device_list* info_list, const rs2_device*
 */
 rs2_device* rs2_create_device(const rs2_device_list* info_list, int index, rs2_error** error);
 
+/**
+* Creates all the devices in a list. Same as calling rs2_create_device for each, except that the devices are created
+* concurrently (up to the "device-creation/threads" context setting at a time), which is much faster with many devices.
+* If any device cannot be created, none are returned and the first error is reported.
+* \param[in]  info_list the list containing the devices to create
+* \param[out] devices   Receives the devices, in list order; must have room for rs2_get_device_count(info_list) devices,
+*                       each to be released by rs2_delete_device
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_create_devices(const rs2_device_list* info_list, rs2_device** devices, rs2_error** error);
+
 /**
 * Delete RealSense device
 * \param[in]  device    Realsense device to delete
@@ -122,6 +133,28 @@ const rs2_raw_data_buffer* rs2_send_and_receive_raw_data(rs2_device* device, voi
 */
 int rs2_is_device_extendable_to(const rs2_device* device, rs2_extension extension, rs2_error ** error);
 
+/** \brief What it costs a device to keep its global time: the device clock is read by all its sensors together */
+typedef struct rs2_global_time_telemetry
+{
+    unsigned long long polls;        /**< Reads of the device clock */
+    unsigned long long failed_polls; /**< Of them, those that failed */
+    double command_last_ms;          /**< From sending a read of the device clock until it was answered */
+    double command_avg_ms;
+    double command_max_ms;
+    double residual_ms;              /**< RMS of the samples' distance from the fit */
+    double drift_ms;                 /**< How far the last sample was from the fit before it */
+    double interval_ms;              /**< Until the next read: longer while the fit holds */
+    int users;                       /**< Sensors streaming with global time */
+} rs2_global_time_telemetry;
+
+/**
+* retrieve what it costs the device to keep its global time, since it was created
+* \param[in]  device    Realsense device, which must be extendable to RS2_EXTENSION_GLOBAL_TIMER
+* \param[out] telemetry receives the counters
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_global_time_telemetry(const rs2_device* device, rs2_global_time_telemetry* telemetry, rs2_error** error);
+
 /**
 * Create a static snapshot of all connected sensors within a specific device.
 * \param[in]  device    Specific RealSense device
@@ -207,6 +240,20 @@ void rs2_update_firmware_cpp(const rs2_device* device, const void* fw_image, int
 */
 void rs2_update_firmware(const rs2_device* device, const void* fw_image, int fw_image_size, rs2_update_progress_callback_ptr callback, void* client_data, rs2_error** error);
 
+/**
+* Update several devices to the provided firmware at once, each on a thread of its own; the devices must be extendable to
+* RS2_EXTENSION_UPDATE_DEVICE. The image is checked once per kind of device, and the call returns when all are done.
+* \param[in]  devices       Devices to update
+* \param[in]  count         Number of devices
+* \param[in]  fw_image      Firmware image buffer
+* \param[in]  fw_image_size Firmware image buffer size
+* \param[in]  callback      Optional callback for update progress notifications, called from the thread of each device
+* \param[in]  client_data   Optional array of 'count' client data, the one of each device passed to the callback with its progress
+* \param[out] error         If non-null, receives any error that occurs during this call, otherwise, errors are ignored; names
+*                           each device that failed, the others being updated
+*/
+void rs2_update_firmware_devices(const rs2_device* const* devices, int count, const void* fw_image, int fw_image_size, rs2_update_progress_callback_ptr callback, void* const* client_data, rs2_error** error);
+
 /**
 * Create backup of camera flash memory. Such backup does not constitute valid firmware image, and cannot be
 * loaded back to the device, but it does contain all calibration and device information.
@@ -505,9 +552,16 @@ void rs2_set_calibration_table(const rs2_device* device, const void* calibration
 /* Serialize JSON content, returns ASCII-serialized JSON string on success. otherwise nullptr */
 rs2_raw_data_buffer* rs2_serialize_json(rs2_device* dev, rs2_error** error);
 
-/* Load JSON and apply advanced-mode controls */
+/* Load JSON and apply advanced-mode controls; the content may also be the same object encoded as CBOR or MessagePack */
 void rs2_load_json(rs2_device* dev, const void* json_content, unsigned content_size, rs2_error** error);
 
+/* Serialize the same settings as rs2_serialize_json, with the options and calibration table of the device, into a compact
+*  binary snapshot; returns it on success, otherwise nullptr */
+rs2_raw_data_buffer* rs2_serialize_snapshot(rs2_device* dev, rs2_error** error);
+
+/* Restore a snapshot from rs2_serialize_snapshot: only the settings that differ from the device's current ones are written */
+void rs2_load_snapshot(rs2_device* dev, const void* snapshot, unsigned snapshot_size, rs2_error** error);
+
 /**
 *  Run target-based focal length calibration
 * \param[in]    device: device to calibrate
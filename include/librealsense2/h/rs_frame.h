@@ -74,12 +74,46 @@ typedef enum rs2_frame_metadata_value
     RS2_FRAME_METADATA_SUB_PRESET_INFO                      , /**< Sub-preset information */
     RS2_FRAME_METADATA_CALIB_INFO                           , /**< FW-controlled frame counter to be using in Calibration scenarios */
     RS2_FRAME_METADATA_CRC                                  , /**< CRC checksum of the Metadata */
+    RS2_FRAME_METADATA_POINT_COUNT                          , /**< Number of points in a points frame with a packed rs2_points_layout */
+    RS2_FRAME_METADATA_DELIVERY_LATENCY                     , /**< Microseconds from the frame's arrival from the backend until it was last handed to a callback */
+    RS2_FRAME_METADATA_SCENE_CHANGE                         , /**< Thousandths of the compared pixels that changed since the last frame the scene-change gate let through, for the frames it lets through */
+    RS2_FRAME_METADATA_SKIPPED_FRAMES                       , /**< Number of frames the scene-change gate held back, for showing nothing new, before the frame it let through */
+    RS2_FRAME_METADATA_DEQUEUE_LATENCY                      , /**< Microseconds from the driver completing the frame (its time of arrival) until it was dequeued from it; where the driver timestamps its buffers (V4L2) */
 
     RS2_FRAME_METADATA_COUNT
 } rs2_frame_metadata_value;
 const char* rs2_frame_metadata_to_string(rs2_frame_metadata_value metadata);
 const char* rs2_frame_metadata_value_to_string(rs2_frame_metadata_value metadata);
 
+/** \brief The metadata of a batch of frames, in columns laid out as Apache Arrow arrays. Each column has a value per
+* frame, and may have a validity bitmap: a bit per frame, least significant bit first, set where the frame has a
+* value. Without a bitmap, every frame has one. The columns are only valid during the callback they're passed to. */
+struct rs2_metadata_batch
+{
+    int rows;                                                   /**< Frames in the batch */
+    const int* stream;                                          /**< The rs2_stream of each frame */
+    const int* index;                                           /**< The stream index of each frame */
+    const unsigned long long* frame_number;
+    const double* timestamp;                                    /**< In milliseconds, in the timestamp domain of the frame */
+    const rs2_metadata_type* values[RS2_FRAME_METADATA_COUNT];  /**< Per rs2_frame_metadata_value: the value of each frame, 0 where it has none */
+    const unsigned char* validity[RS2_FRAME_METADATA_COUNT];    /**< Per rs2_frame_metadata_value: its bitmap, or null where every frame has a value */
+    int null_count[RS2_FRAME_METADATA_COUNT];                   /**< Per rs2_frame_metadata_value: the frames that have no value */
+};
+
+/** \brief What a frame callback usually asks of every frame, as one call gets it */
+typedef struct rs2_frame_info
+{
+    const void* data;                       /**< The frame data */
+    int data_size;                          /**< The size of the frame data, in bytes */
+    int width;                              /**< The frame width, in pixels; 0 for frames that aren't video frames */
+    int height;                             /**< The frame height, in pixels; 0 for frames that aren't video frames */
+    int stride;                             /**< The frame stride, in bytes; 0 for frames that aren't video frames */
+    int bpp;                                /**< Bits per pixel; 0 for frames that aren't video frames */
+    rs2_time_t timestamp;                   /**< The frame timestamp, in milliseconds */
+    rs2_timestamp_domain timestamp_domain;  /**< The domain of the timestamp */
+    unsigned long long frame_number;        /**< The frame number */
+} rs2_frame_info;
+
 /** \brief Calibration target type. */
 typedef enum rs2_calib_target_type
 {
@@ -108,6 +142,17 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 */
 int rs2_supports_frame_metadata(const rs2_frame* frame, rs2_frame_metadata_value frame_metadata, rs2_error** error);
 
+/**
+* retrieve all the metadata the frame supports, in one call
+* \param[in] frame             handle returned from a callback
+* \param[out] values           receives the values, indexed by rs2_frame_metadata_value; unsupported ones are set to 0
+* \param[out] supported        if non-null, receives 1 for the supported metadata and 0 for the others
+* \param[in] count             how many each array has room for: RS2_FRAME_METADATA_COUNT for all the metadata
+* \param[out] error         if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                how many of the first 'count' are supported
+*/
+int rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_metadata_type* values, int* supported, int count, rs2_error** error);
+
 /**
 * retrieve timestamp domain from frame handle. timestamps can only be comparable if they are in common domain
 * (for example, depth timestamp might come from system time while color timestamp might come from the device)
@@ -142,6 +187,14 @@ rs2_sensor* rs2_get_frame_sensor(const rs2_frame* frame, rs2_error** error);
 */
 unsigned long long rs2_get_frame_number(const rs2_frame* frame, rs2_error** error);
 
+/**
+* retrieve the data, size, dimensions, stride, bits per pixel, timestamp and number of a frame, in one call
+* \param[in] frame      handle returned from a callback
+* \param[out] info      receives what the frame has of them
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_frame_info(const rs2_frame* frame, rs2_frame_info* info, rs2_error** error);
+
 /**
 * retrieve data size from frame handle
 * \param[in] frame      handle returned from a callback
@@ -158,6 +211,28 @@ int rs2_get_frame_data_size(const rs2_frame* frame, rs2_error** error);
 */
 const void* rs2_get_frame_data(const rs2_frame* frame, rs2_error** error);
 
+/**
+* retrieve the DMABUF file descriptor backing the frame data, when the frame wraps a kernel buffer (Linux only, with
+* "zero-copy-frames" enabled in the context settings). The descriptor is owned by the library and is valid only while
+* the frame is alive.
+* \param[in] frame      handle returned from a callback
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* 
+eturn               the file descriptor, or -1 if the frame data is not backed by one
+*/
+int rs2_get_frame_dmabuf_fd(const rs2_frame* frame, rs2_error** error);
+
+/**
+* retrieve the frame data in GPU memory, for frames that a CUDA processing block left there (when the library is built
+* with CUDA). The memory is owned by the frame, and is valid only while the frame is alive; the data is complete by the
+* time the frame is handed on.
+* \param[in] frame      handle returned from a callback
+* \param[out] device    if non-null, receives the CUDA device the data is on, or -1
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return               the device pointer, or null if the frame data is only in host memory
+*/
+const void* rs2_get_frame_cuda_data(const rs2_frame* frame, int* device, rs2_error** error);
+
 /**
 * retrieve frame width in pixels
 * \param[in] frame      handle returned from a callback
@@ -192,6 +192,25 @@ rs2_sensor* rs2_software_device_add_sensor(rs2_device* dev, const char* sensor_n
  */
 void rs2_software_sensor_on_video_frame(rs2_sensor* sensor, rs2_software_video_frame frame, rs2_error** error);
 
+/**
+ * Allocate a video frame of the software sensor's own frame pool, for its pixels to be written in place (at
+ * rs2_get_frame_data, rows of frame.stride bytes) and then injected with rs2_software_sensor_submit_frame, without
+ * a buffer of the application to be allocated and copied for every frame
+ * \param[in] sensor the software sensor
+ * \param[in] frame  the frame components, as for rs2_software_sensor_on_video_frame; pixels and deleter are not used
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ * \return            the frame, to be submitted or released by rs2_release_frame; null when the sensor is not streaming
+ */
+rs2_frame* rs2_software_sensor_allocate_video_frame(rs2_sensor* sensor, rs2_software_video_frame frame, rs2_error** error);
+
+/**
+ * Inject a frame allocated by rs2_software_sensor_allocate_video_frame of the same sensor
+ * \param[in] sensor the software sensor
+ * \param[in] frame  the frame, whose reference is taken over: it should not be released afterwards
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_software_sensor_submit_frame(rs2_sensor* sensor, rs2_frame* frame, rs2_error** error);
+
 /**
 * Inject motion frame to software sonsor
 * \param[in] sensor the software sensor
@@ -124,6 +124,47 @@ extern "C" {
         RS2_OPTION_OHM_TEMPERATURE, /**< Temperature of the Optical Head Sensor */
         RS2_OPTION_SOC_PVT_TEMPERATURE, /**< Temperature of PVT SOC */
         RS2_OPTION_GYRO_SENSITIVITY,/**< Control of the gyro sensitivity level, see rs2_gyro_sensitivity for values */ 
+        RS2_OPTION_FRAME_POOL_HITS, /**< Read-only: number of frame buffers reused from the sensor's frame pool */
+        RS2_OPTION_FRAME_POOL_MISSES, /**< Read-only: number of frame buffers the sensor had to newly allocate */
+        RS2_OPTION_FILTER_THREADS, /**< Number of threads a processing block may split each frame across; 1 processes on the calling thread only */
+        RS2_OPTION_HISTOGRAM_REFRESH_INTERVAL, /**< Colorizer: recompute the equalization histogram at most every this many frames, unless the scene changes; 1 recomputes it for every frame */
+        RS2_OPTION_POINTS_LAYOUT, /**< Pointcloud: layout of the output points, see rs2_points_layout for values */
+        RS2_OPTION_FILTER_ROI_LEFT, /**< Depth post-processing: left edge of the region of interest, as a fraction of the frame width. Blocks compute inside the region only and output no depth outside it */
+        RS2_OPTION_FILTER_ROI_TOP, /**< Depth post-processing: top edge of the region of interest, as a fraction of the frame height */
+        RS2_OPTION_FILTER_ROI_RIGHT, /**< Depth post-processing: right edge of the region of interest, as a fraction of the frame width */
+        RS2_OPTION_FILTER_ROI_BOTTOM, /**< Depth post-processing: bottom edge of the region of interest, as a fraction of the frame height */
+        RS2_OPTION_PIPELINE_STAGE, /**< Depth pipeline: the stage that the options several stages have (magnitude, smooth alpha and delta, holes fill, threads) are read from and set on */
+        RS2_OPTION_SYNC_DEADLINE, /**< Syncer: milliseconds after the first frame of a set arrives that the set is released even if incomplete; 0 for no deadline */
+        RS2_OPTION_SYNC_DROP_LATE_FRAMES, /**< Syncer: drop frames that arrive after their set was released by the deadline */
+        RS2_OPTION_SYNC_LATE_FRAMES, /**< Syncer: number of frames that missed the deadline of their set */
+        RS2_OPTION_SYNC_DROPPED_FRAMES, /**< Syncer: number of late frames that were dropped */
+        RS2_OPTION_CUDA_DEVICE, /**< CUDA processing blocks: index of the GPU to process on; -1 for the context's default (the "cuda" settings) */
+        RS2_OPTION_READBACK_LATENCY, /**< GLSL processing blocks: frames whose readback to the host may still be in flight; 0 reads back only when the data is asked for */
+        RS2_OPTION_FRAMES_IN_FLIGHT, /**< MJPEG converter: frames decoded at the same time, on the processing thread pool; 1 decodes each frame as it arrives */
+        RS2_OPTION_POINTS_MIN_X, /**< Pointcloud: points with a smaller x, in meters in the depth camera's frame, are dropped like points without depth */
+        RS2_OPTION_POINTS_MAX_X, /**< Pointcloud: points with a larger x, in meters in the depth camera's frame, are dropped like points without depth */
+        RS2_OPTION_POINTS_MIN_Y, /**< Pointcloud: points with a smaller y, in meters in the depth camera's frame, are dropped like points without depth */
+        RS2_OPTION_POINTS_MAX_Y, /**< Pointcloud: points with a larger y, in meters in the depth camera's frame, are dropped like points without depth */
+        RS2_OPTION_POINTS_MIN_Z, /**< Pointcloud: points with a smaller z, in meters in the depth camera's frame, are dropped like points without depth */
+        RS2_OPTION_POINTS_MAX_Z, /**< Pointcloud: points with a larger z, in meters in the depth camera's frame, are dropped like points without depth */
+        RS2_OPTION_CONVERSION_THREADS, /**< Sensors: threads each frame's format conversion may be split across, in bands of rows, on the processing thread pool; 1 converts on the sensor's thread only */
+        RS2_OPTION_OCCLUSION_DECIMATION, /**< Pointcloud: occlusion removal scans every Nth row of depth and applies what it found to the rows in between; 1 scans every row */
+        RS2_OPTION_DEPTH_NORMALIZE_OUTPUT, /**< Depth normalize: the output, distance in meters (0) or disparity (1) */
+        RS2_OPTION_LAZY_CONVERSION, /**< Sensors: interleaved formats are unpacked when the data of a frame is first asked for, not when it arrives, so frames nobody looks at aren't unpacked */
+        RS2_OPTION_AUTO_EXPOSURE_SUBSAMPLING, /**< Host auto-exposure: the histogram is made of every Nth pixel of every Nth row; 1 uses every pixel */
+        RS2_OPTION_DEPTH_QUALITY_WINDOW, /**< Depth quality metrics: the number of frames the metrics are over */
+        RS2_OPTION_DEPTH_QUALITY_FILL_RATE, /**< Depth quality metrics, read-only: percentage of the pixels of the region of interest with depth */
+        RS2_OPTION_DEPTH_QUALITY_PLANE_FIT_RMS_ERROR, /**< Depth quality metrics, read-only: RMS of the distances, in mm, of the points of the region of interest from the plane fitted to them */
+        RS2_OPTION_DEPTH_QUALITY_DISTANCE, /**< Depth quality metrics, read-only: distance, in mm, of the camera from the plane fitted to the region of interest */
+        RS2_OPTION_DEPTH_FUSION_OUTPUT, /**< Depth fusion: the output, the points of all the cameras (0) or a height map of them (1) */
+        RS2_OPTION_DEPTH_FUSION_CELL_SIZE, /**< Depth fusion: the size of the cells of the height map, in meters */
+        RS2_OPTION_DEPTH_FUSION_MAP_SIZE, /**< Depth fusion: the number of cells on a side of the height map */
+        RS2_OPTION_POINTS_VOXEL_SIZE, /**< Pointcloud: points are downsampled to the centroid of those in each voxel of this side, in meters; 0 keeps them all */
+        RS2_OPTION_TEMPORAL_MOTION_COMPENSATION, /**< Temporal filter: warp the history by the rotation the gyro frames passed through the filter measured since the last frame */
+        RS2_OPTION_SCENE_CHANGE_THRESHOLD, /**< Scene-change gate: the percentage of the compared pixels that must have changed for a frame to go through */
+        RS2_OPTION_SCENE_CHANGE_KEEP_ALIVE, /**< Scene-change gate: a frame goes through after this many ms without one, changed or not; 0 for never */
+        RS2_OPTION_MEMORY_USAGE, /**< Read-only: KB of frame memory the sensor holds, in frames and pooled for reuse; see the "memory-budget-mb" context setting */
+        RS2_OPTION_ALIGN_OUTPUT_SCALE, /**< Align: the aligned frames are this fraction of the size of the stream aligned to, in each direction; the depth is sampled to match */
         RS2_OPTION_COUNT /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
     } rs2_option;
 
@@ -287,6 +328,21 @@ extern "C" {
     } rs2_gyro_sensitivity;
     const char * rs2_gyro_sensitivity_to_string( rs2_gyro_sensitivity mode );
 
+    /** \brief values for RS2_OPTION_POINTS_LAYOUT option.
+    * The packed layouts hold the valid (non-zero depth) points only, in pixel order, as five consecutive arrays of
+    * RS2_FRAME_METADATA_POINT_COUNT values each: x, y, z, then the texture coordinates u, v. The frame data (see
+    * rs2_get_frame_data and rs2_get_frame_data_size) is these arrays; the vertices and texture coordinates accessors
+    * are only available with RS2_POINTS_LAYOUT_INTERLEAVED. */
+    typedef enum rs2_points_layout
+    {
+        RS2_POINTS_LAYOUT_INTERLEAVED = 0,          /**< x, y, z floats for every pixel, followed by u, v floats for every pixel */
+        RS2_POINTS_LAYOUT_PACKED_FLOAT = 1,         /**< Packed, with all the values as 32-bit floats; x, y, z in meters */
+        RS2_POINTS_LAYOUT_PACKED_HALF = 2,          /**< Packed, with all the values as 16-bit (IEEE 754 half precision) floats; x, y, z in meters */
+        RS2_POINTS_LAYOUT_PACKED_MILLIMETERS = 3,   /**< Packed, with x, y, z as 16-bit signed integers in millimeters (saturated), u, v as half precision floats */
+        RS2_POINTS_LAYOUT_COUNT                     /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+    } rs2_points_layout;
+    const char * rs2_points_layout_to_string( rs2_points_layout layout );
+
     /**
     * check if an option is read-only
     * \param[in] options  the options container
@@ -323,6 +379,23 @@ extern "C" {
     */
     void rs2_set_option(const rs2_options* options, rs2_option option, float value, rs2_error** error);
 
+    /**
+    * write new values to sensor options, without waiting for them to be set: the writes are queued, for all the sensors
+    * of the device, and set one at a time in the order they were queued. A write still queued when another comes for
+    * the same option takes on its value instead, so the option is only set once.
+    * Only float and integer options can be set this way; their values are checked before anything is queued.
+    * \param[in] options    the options container, which must be a sensor
+    * \param[in] option_ids the options to write
+    * \param[in] values     the new value of each
+    * \param[in] count      how many options to write
+    * \param[in] callback   if non-null, called once all of them are set: with the first error (which the callback must
+    *                       release with rs2_free_error), or null if none failed; it must not delete the sensor
+    * \param[in] user       passed on to the callback
+    * \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_set_options_async(const rs2_options* options, const rs2_option* option_ids, const float* values, int count,
+                               rs2_options_set_callback_ptr callback, void* user, rs2_error** error);
+
     /**
     * write new value to sensor option
     * \param[in] options       the options container
@@ -50,6 +50,9 @@ extern "C" {
     * The application can maintain the frames handles to defer processing. However, if the application maintains too long history, the device
     * may lack memory resources to produce new frames, and the following call to this method shall fail to retrieve new frames, until resources
     * are retained.
+    * With the "pipeline": { "latest-only": true } context setting, the set is made when asked for, of the latest frame of each stream,
+    * and of all the samples of each motion stream since the last set (up to "imu-queue-size", 32 by default), oldest first: the frames
+    * then never wait in a queue, whatever the pace of the application.
     * \param[in] pipe the pipeline
     * \param[in] timeout_ms   Max time in milliseconds to wait until an exception will be thrown
     * \param[out] error         if non-null, receives any error that occurs during this call, otherwise, errors are ignored
@@ -74,6 +77,18 @@ extern "C" {
     */
     int rs2_pipeline_poll_for_frames(rs2_pipeline* pipe, rs2_frame** output_frame, rs2_error ** error);
 
+    /**
+    * Takes all the frames sets available, up to max_frames, oldest first, without blocking the calling thread.
+    * The pipeline keeps only the latest frames set unless the "pipeline": { "queue-size": N } context setting is given.
+    * \param[in] pipe the pipeline
+    * \param[out] output_frames an array of at least max_frames frame handles; each to be released using rs2_release_frame
+    * \param[in] max_frames the most frames sets to take
+    * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    * 
+eturn the number of frames sets stored to output_frames
+    */
+    int rs2_pipeline_poll_for_frames_batch(rs2_pipeline* pipe, rs2_frame** output_frames, int max_frames, rs2_error ** error);
+
     /**
     * Wait until a new set of frames becomes available.
     * The frames set includes time-synchronized frames of each enabled stream in the pipeline.
@@ -35,6 +35,16 @@ rs2_processing_block* rs2_create_colorizer(rs2_error** error);
 */
 rs2_processing_block* rs2_create_sync_processing_block(rs2_error** error);
 
+/**
+* Creates Sync processing block for the frames of several devices, started with inter-camera hardware sync
+* (RS2_OPTION_INTER_CAM_SYNC_MODE). Each device's frames are matched as by the Sync processing block, and the
+* resulting framesets are matched across devices on their global timestamps, into one composite frame for all
+* \param[in] max_jitter_ms  The most framesets can be apart and still be matched; it's never more than half a frame,
+*                           and 0 means half a frame
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_multi_device_sync_processing_block(float max_jitter_ms, rs2_error** error);
+
 /**
 * Creates Point-Cloud processing block. This block accepts depth frames and outputs Points frames
 * In addition, given non-depth frame, the block will align texture coordinate to the non-depth stream
@@ -162,6 +172,16 @@ void rs2_delete_processing_block(rs2_processing_block* block);
 */
 rs2_frame_queue* rs2_create_frame_queue(int capacity, rs2_error** error);
 
+/**
+* create frame queue, like rs2_create_frame_queue, that neither enqueuing nor dequeuing takes a lock for: waiting for a
+* frame spins for a while before going to sleep, and enqueuing only wakes up a waiting thread when there is one.
+* Meant for queues that see a lot of traffic, when the cost of a lock and a wake-up on every frame matters
+* \param[in] capacity max number of frames to allow to be stored in the queue before older frames will start to get dropped
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return handle to the frame queue, must be released using rs2_delete_frame_queue
+*/
+rs2_frame_queue* rs2_create_lock_free_frame_queue(int capacity, rs2_error** error);
+
 /**
 * deletes frame queue and releases all frames inside it
 * \param[in] queue queue to delete
@@ -193,6 +213,17 @@ rs2_frame* rs2_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, r
 */
 int rs2_poll_for_frame(rs2_frame_queue* queue, rs2_frame** output_frame, rs2_error** error);
 
+/**
+* dequeue all the frames available, up to max_frames, without waiting for any; cheaper than polling for them one by one
+* \param[in] queue the frame queue data structure
+* \param[out] output_frames an array of at least max_frames frame handles, filled in the order of the queue; each to be released using rs2_release_frame
+* \param[in] max_frames the most frames to dequeue
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* 
+eturn the number of frames stored to output_frames
+*/
+int rs2_frame_queue_poll_batch(rs2_frame_queue* queue, rs2_frame** output_frames, int max_frames, rs2_error** error);
+
 /**
 * wait until new frame becomes available in the queue and dequeue it
 * \param[in] queue          the frame queue data structure
@@ -285,6 +316,136 @@ rs2_processing_block* rs2_create_hdr_merge_processing_block(rs2_error** error);
 */
 rs2_processing_block* rs2_create_sequence_id_filter(rs2_error** error);
 
+/**
+* Creates a depth pipeline processing block.
+* The block runs decimation, depth to disparity, spatial, temporal, hole filling and disparity to depth in one go, with
+* the same output as the chain of separate blocks, but without the intermediate frames
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_depth_pipeline_block(rs2_error** error);
+
+/**
+* Creates a depth normalize processing block.
+* The block does what the threshold filter followed by the units transform, or by depth to disparity, do, in one pass:
+* Z16 depth in the range of its min/max distance options in, distance in meters or disparity out, as selected by
+* RS2_OPTION_DEPTH_NORMALIZE_OUTPUT
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_depth_normalize_block(rs2_error** error);
+
+/**
+* Creates a depth quality metrics processing block.
+* The block passes depth frames through unchanged, and fits a plane to the points of its region of interest over the
+* last RS2_OPTION_DEPTH_QUALITY_WINDOW frames, as the depth-quality tool does. The fill rate, plane fit RMS error and
+* distance to the plane are read from the read-only RS2_OPTION_DEPTH_QUALITY_* options.
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_depth_quality_metrics_block(rs2_error** error);
+
+/**
+* Creates an undistort processing block.
+* The block remaps the pixels of color and infrared frames, in Y8, Y16, RGB8, BGR8, RGBA8 or BGRA8, to an image of the
+* same focal lengths and principal point with no distortion: its profile has the RS2_DISTORTION_NONE model. The remap
+* table is made once for each intrinsics.
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_undistort_filter_block(rs2_error** error);
+
+/**
+* Creates a depth fusion processing block.
+* The block puts the depth of several cameras in the coordinates of the first depth stream it sees, the reference: the
+* other streams are placed by the extrinsics registered between their profiles and the reference's (see
+* rs2_register_extrinsics). Each frame of the reference is output fused with the latest frames of the others, as the
+* points of all of them (RS2_FORMAT_XYZ32F) or as an orthographic height map of the nearest Z in each cell of a grid
+* across X and Y (RS2_FORMAT_DISTANCE), per RS2_OPTION_DEPTH_FUSION_OUTPUT.
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_depth_fusion_block(rs2_error** error);
+
+/**
+* Creates a scene-change gate processing block.
+* The block passes on only the frames that changed enough since the last frame of their stream it passed on
+* (RS2_OPTION_SCENE_CHANGE_THRESHOLD), as compared on a grid of every RS2_OPTION_FILTER_MAGNITUDE pixels, and one
+* every RS2_OPTION_SCENE_CHANGE_KEEP_ALIVE ms regardless; the others are dropped, so that the blocks after it have
+* nothing to do for them. A frameset is passed on or dropped whole, by its depth frame, or else by its first video
+* frame. The frames passed on carry RS2_FRAME_METADATA_SCENE_CHANGE and RS2_FRAME_METADATA_SKIPPED_FRAMES.
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_scene_change_gate_block(rs2_error** error);
+
+/**
+* Creates a sparse depth transform processing block.
+* The block converts Z16 depth frames to RS2_FORMAT_Z16_SPARSE ones, which hold only the valid (non-zero) pixels, or
+* back. A sparse frame has the dimensions and intrinsics of the depth: its data is the width and height (uint32), the
+* count of valid pixels up to the end of each row (uint32 each), then the column and depth of each valid pixel (uint16
+* each), row by row, all little-endian. It is smaller than the depth once fewer than about half the pixels are valid,
+* and rs2_depth_frame_get_distance and the pointcloud read it as it is.
+* \param[in] transform_to_sparse  true (non-zero) for Z16 to sparse, false (zero) for sparse to Z16
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_sparse_depth_transform_block(unsigned char transform_to_sparse, rs2_error** error);
+
+/**
+* Creates a processing graph: a tree of processing blocks that are run on the shared worker threads. Blocks on
+* different branches, and successive frames through the same branch, are processed concurrently, while each block
+* still sees one frame at a time, in order. The output for each frame is what the blocks at the ends of the branches
+* output, in one composite frame when there are several, in the order of the input
+* \param[in] max_in_flight  The most frames being processed at once (1-32); processing a frame waits for the oldest
+*                           to come out once there are that many
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_processing_graph(int max_in_flight, rs2_error** error);
+
+/**
+* Adds a block to a processing graph, before it gets its first frame. The block must output what it makes of a frame
+* from within rs2_process_frame(), as filters do, and its output goes to the graph from then on
+* \param[in] graph   The processing graph
+* \param[in] block   The block to add
+* \param[in] parent  The index of the block whose output feeds this one, as returned when it was added; -1 for the
+*                    input of the graph
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return           The index of the block in the graph
+*/
+int rs2_processing_graph_add_block(rs2_processing_block* graph, rs2_processing_block* block, int parent, rs2_error** error);
+
+/**
+* Adds a step to the load policy of a processing graph, before it gets its first frame: setting an option of one of its
+* blocks. While the graph falls behind (frames wait for room, or one of its blocks is busy nearly all the time), the
+* steps are taken one at a time, in the order they were added; once it keeps up again, they're undone in reverse,
+* each option going back to the value it had. Each change is reported with a RS2_NOTIFICATION_CATEGORY_PROCESSING_LOAD
+* notification (see rs2_processing_graph_set_notifications_callback).
+* \param[in] graph   The processing graph
+* \param[in] block   The index of the block, as returned by rs2_processing_graph_add_block
+* \param[in] option  The option of the block to set, e.g. RS2_OPTION_FILTER_MAGNITUDE of a decimation filter
+* \param[in] value   The value, cheaper to process with, to set it to
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* 
+eturn           The index of the step
+*/
+int rs2_processing_graph_add_load_step(rs2_processing_block* graph, int block, rs2_option option, float value, rs2_error** error);
+
+/**
+* Same as rs2_processing_graph_add_load_step, with a step that skips a block altogether: its input is passed on as its
+* output, e.g. to turn a temporal filter off
+* \param[in] graph   The processing graph
+* \param[in] block   The index of the block, as returned by rs2_processing_graph_add_block
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* 
+eturn           The index of the step
+*/
+int rs2_processing_graph_add_bypass_step(rs2_processing_block* graph, int block, rs2_error** error);
+
+/**
+* Sets the callback for the notifications of a processing graph, those of its load policy: they're delivered from a
+* thread of their own, never holding up the processing
+* \param[in] graph            The processing graph
+* \param[in] on_notification  function pointer to register as per-notifications callback
+* \param[in] user             user data passed to the callback
+* \param[out] error           if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_processing_graph_set_notifications_callback(rs2_processing_block* graph, rs2_notification_callback_ptr on_notification, void* user, rs2_error** error);
+void rs2_processing_graph_set_notifications_callback_cpp(rs2_processing_block* graph, rs2_notifications_callback* callback, rs2_error** error);
+
 /**
 * Retrieve processing block specific information, like name.
 * \param[in]  block     The processing block
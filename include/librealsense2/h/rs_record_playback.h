@@ -48,6 +48,21 @@ rs2_device* rs2_create_record_device(const rs2_device* device, const char* file,
 */
 rs2_device* rs2_create_record_device_ex(const rs2_device* device, const char* file, int compression_enabled, rs2_error** error);
 
+/**
+* Creates recording devices that record several devices into the same file, on a capture clock they share so their
+* frames are on one timeline. Each device writes through its own queue and thread. Adding the file to a context (see
+* rs2_context_add_device) then gives a playback device for each of them, in the same order.
+* \param[in]  devices               The devices to record
+* \param[in]  count                 The number of devices
+* \param[in]  file                  The desired path to which the recorders should save the data
+* \param[in]  compression_enabled   Indicates if compression is enabled, 0 means false, otherwise true
+* \param[out] record_devices        Receives 'count' recording devices, one for each of the devices, in order; each is
+*                                   to be released with rs2_delete_device
+* \param[out] error                 If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_create_multi_record_device(const rs2_device* const* devices, int count, const char* file, int compression_enabled,
+                                    rs2_device** record_devices, rs2_error** error);
+
 /**
 * Pause the recording device without stopping the actual device from streaming.
 * Pausing will cause the device to stop writing new data to the file, in particular, frames and changes to extensions
@@ -142,6 +157,32 @@ void rs2_playback_device_pause(const rs2_device* device, rs2_error** error);
  */
 void rs2_playback_device_set_real_time(const rs2_device* device, int real_time, rs2_error** error);
 
+/**
+ * Set the playback to work offline, for batch processing: as fast as the application handles the frames
+ *
+ * Frames are handed out in the order they were recorded, all from the same thread, while the next ones are read.
+ * Reading is held back while max_frames_in_flight frames are yet to be released by the application, so none are
+ * dropped. Keep it below the number of frames the application may hold on to at once plus those a processing
+ * pipeline (e.g., a syncer) may keep internally, or playback will keep waiting for them to be released.
+ * Offline playback is never real time.
+ * \param[in] device               A playback device
+ * \param[in] max_frames_in_flight Frames read and not yet released, at most; 0 to turn offline playback off
+ * \param[out] error               If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_device_set_offline(const rs2_device* device, int max_frames_in_flight, rs2_error** error);
+
+/**
+ * Play only part of the file, e.g. to split processing it between several playback devices
+ *
+ * Playback starts at the beginning of the range and ends, as at the end of the file, at its end. Takes effect the
+ * next time the playback starts.
+ * \param[in] device A playback device
+ * \param[in] start  Beginning of the range, in nanoseconds from the start of the file
+ * \param[in] end    End of the range (not included), in nanoseconds from the start of the file; 0 for the end of the file
+ * \param[out] error If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_device_set_range(const rs2_device* device, unsigned long long int start, unsigned long long int end, rs2_error** error);
+
 /**
  * Indicates if playback is in real time mode or non real time
  * \param[in] device A playback device
@@ -15,6 +15,7 @@ extern "C" {
 #endif
 
 #include "rs_types.h"
+#include "rs_frame.h"
 
 /** \brief Read-only strings that can be queried from the device.
    Not all information attributes are available on all camera types.
@@ -35,6 +36,7 @@ typedef enum rs2_camera_info {
     RS2_CAMERA_INFO_FIRMWARE_UPDATE_ID             , /**< Firmware update ID */
     RS2_CAMERA_INFO_IP_ADDRESS                     , /**< IP address for remote camera. */
     RS2_CAMERA_INFO_DFU_DEVICE_PATH                , /**< DFU Device node path */
+    RS2_CAMERA_INFO_CONVERSION_KERNEL              , /**< Format converters: the conversion the block runs, and the instruction set it runs it with */
     RS2_CAMERA_INFO_COUNT                            /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
 } rs2_camera_info;
 const char* rs2_camera_info_to_string(rs2_camera_info info);
@@ -94,6 +96,8 @@ typedef enum rs2_format
     RS2_FORMAT_Y16I            , /**< 12-bit per pixel interleaved. 12-bit left, 12-bit right. */
     RS2_FORMAT_M420            , /**< 24-bit for every pixel: y for each pixel, and u,v data for every four pixels - packed as 2 lines of y, 1 line of u,v */
     RS2_FORMAT_COMBINED_MOTION , /**< Combined motion data, as in the combined_motion structure */
+    RS2_FORMAT_Z16RVL          , /**< Losslessly compressed 16-bit depth values (RVL), as sent over the network by DDS devices */
+    RS2_FORMAT_Z16_SPARSE      , /**< 16-bit depth of the valid pixels only, with their column and a table of the rows (see rs2_create_sparse_depth_transform_block) */
     RS2_FORMAT_COUNT             /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
 } rs2_format;
 const char* rs2_format_to_string(rs2_format format);
@@ -113,6 +117,31 @@ typedef struct rs2_combined_motion
     struct { double x, y, z; } linear_acceleration;
 } rs2_combined_motion;
 
+/** \brief A gyro or accel sample, as a motion sensor delivered it (see rs2_get_motion_at) */
+typedef struct rs2_motion_sample
+{
+    double timestamp;   /**< In ms, in the domain of the sensor's frames */
+    float xyz[3];       /**< As in the motion frames: m/s^2 for accel, rad/s for gyro */
+} rs2_motion_sample;
+
+/** \brief What a sensor got from its backend for one of its streams, and what it handed on to its callback */
+typedef struct rs2_stream_telemetry
+{
+    rs2_stream stream;
+    int index;
+    unsigned long long frames_received;   /**< Frames that came from the backend */
+    unsigned long long frames_delivered;  /**< Frames handed to the sensor's callback */
+    unsigned long long frames_dropped;    /**< Frames missing between delivered ones, going by their frame numbers */
+    unsigned long long frames_discarded;  /**< Of the dropped ones: received, but no frame was available because too many were still held */
+    unsigned long long size_anomalies;    /**< Frames received with a size other than their stream profile calls for */
+    unsigned long long backend_errors;    /**< Errors the backend reported for the sensor (frame timeouts, corrupted frames): the same for all its streams */
+    double latency_last_ms;               /**< From the arrival of a frame in the backend until it was handed to the callback */
+    double latency_avg_ms;
+    double latency_max_ms;
+    unsigned int queue_depth;             /**< Frames of the stream currently held downstream: in queues, processing, or by the application */
+    unsigned int queue_depth_max;
+} rs2_stream_telemetry;
+
 /**
 * Deletes sensors list, any sensors created from this list will remain unaffected
 * \param[in] info_list list to delete
@@ -283,6 +312,33 @@ void rs2_stop(const rs2_sensor* sensor, rs2_error** error);
 */
 void rs2_set_notifications_callback(const rs2_sensor* sensor, rs2_notification_callback_ptr on_notification, void* user, rs2_error** error);
 
+/**
+* Provide the memory frame data from the specified sensor is stored in (e.g., pinned, huge-page or shared memory)
+* instead of the library's own heap buffers. This applies to video, depth and disparity frames allocated from now on;
+* memory returned by on_allocate is not zero-filled and is handed back to on_deallocate when the last reference to
+* the frame is released, possibly after the sensor is stopped.
+* \param[in] sensor          RealSense sensor
+* \param[in] on_allocate     returns a buffer of at least 'size' bytes, or null to fall back to the default allocation;
+*                            pass null here to restore the default allocator
+* \param[in] on_deallocate   returns a buffer obtained from on_allocate
+* \param[in] user            user data passed to both callbacks
+* \param[out] error          if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_allocator(const rs2_sensor* sensor, rs2_frame_allocate_ptr on_allocate, rs2_frame_deallocate_ptr on_deallocate, void* user, rs2_error** error);
+
+/**
+* Store the frame data from the specified sensor in memory placed on a NUMA node and/or in huge pages, in place of the
+* library's own heap buffers (and of any allocator set with rs2_set_frame_allocator). With the sensor's threads on the
+* CPUs of the same node (see the "threads" context settings), its frames then never cross sockets.
+* Applies to the same frames as rs2_set_frame_allocator; the memory is kept and reused from frame to frame.
+* \param[in] sensor          RealSense sensor
+* \param[in] numa_node       the node to place frames on, or -1 for no placement
+* \param[in] huge_pages      non-zero to back frames of half a huge page or more with huge pages: explicit (hugetlbfs on
+*                            Linux, large pages on Windows) when available, transparent huge pages otherwise
+* \param[out] error          if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_memory_policy(const rs2_sensor* sensor, int numa_node, int huge_pages, rs2_error** error);
+
 /**
 * set callback to get notifications from specified device
 * \param[in] sensor  RealSense sensor
@@ -355,6 +411,40 @@ rs2_stream_profile_list * rs2_get_debug_stream_profiles( rs2_sensor * sensor, rs
 */
 rs2_stream_profile_list* rs2_get_active_streams(rs2_sensor* sensor, rs2_error** error);
 
+/**
+* retrieve the telemetry of the streams the sensor has streamed since it was last opened, whatever its backend
+* \param[in] sensor      input RealSense subdevice
+* \param[out] telemetry  receives up to 'count' entries, one per stream; may be null if 'count' is 0
+* \param[in] count       number of entries 'telemetry' has room for
+* \param[out] error      if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                number of streams there is telemetry for, which may be more than 'count'
+*/
+int rs2_get_stream_telemetry(const rs2_sensor* sensor, rs2_stream_telemetry* telemetry, int count, rs2_error** error);
+
+/**
+* sink the metadata of every frame the sensor gets into columns (see rs2_metadata_batch), handed on in batches; the
+* columns are allocated once, here. Batches are handed on from the thread of the frame that fills them, so the
+* callback should copy them somewhere and return.
+* \param[in] sensor      input RealSense subdevice
+* \param[in] batch_size  frames per batch
+* \param[in] callback    receives the batches; null to stop sinking, after handing on what's left
+* \param[in] user        passed to the callback
+* \param[out] error      if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_metadata_sink(const rs2_sensor* sensor, int batch_size, rs2_metadata_batch_callback_ptr callback, void* user, rs2_error** error);
+
+/**
+* the same, with a callback object; null to stop sinking
+*/
+void rs2_set_metadata_sink_cpp(const rs2_sensor* sensor, int batch_size, rs2_metadata_batch_callback* callback, rs2_error** error);
+
+/**
+* hand on the frames of the metadata sink that aren't in a batch yet, as a smaller batch
+* \param[in] sensor      input RealSense subdevice
+* \param[out] error      if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_flush_metadata_sink(const rs2_sensor* sensor, rs2_error** error);
+
 /**
 * Get pointer to specific stream profile
 * \param[in] list        the list of supported profiles returned by rs2_get_supported_profiles
@@ -659,6 +749,34 @@ void rs2_set_motion_device_intrinsics(const rs2_sensor* sensor, const rs2_stream
 */
 float rs2_get_max_usable_depth_range(rs2_sensor const * sensor, rs2_error** error);
 
+/**
+* The motion at a timestamp, from the last samples of a stream of a motion sensor, which it keeps (a few seconds' worth)
+* as it delivers them: linearly interpolated between the two on either side of it, found by binary search. This saves
+* keeping a buffer of the motion frames to look them up, e.g. by the timestamps of depth frames.
+* \param[in]  sensor     Sensor that supports the MOTION_SENSOR extension
+* \param[in]  stream     RS2_STREAM_GYRO or RS2_STREAM_ACCEL
+* \param[in]  timestamp  In ms, in the domain of the sensor's frames (e.g. global time for both it and the depth)
+* \param[out] sample     Receives the motion at 'timestamp'
+* \param[out] before     If non-null, receives the sample at or before 'timestamp'
+* \param[out] after      If non-null, receives the sample at or after 'timestamp'
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                1 if there are samples on either side of 'timestamp'; otherwise 0, and nothing is written
+*/
+int rs2_get_motion_at(const rs2_sensor* sensor, rs2_stream stream, double timestamp, rs2_motion_sample* sample, rs2_motion_sample* before, rs2_motion_sample* after, rs2_error** error);
+
+/**
+* The samples of a stream of a motion sensor within a time window, out of the ones it keeps (see rs2_get_motion_at)
+* \param[in]  sensor     Sensor that supports the MOTION_SENSOR extension
+* \param[in]  stream     RS2_STREAM_GYRO or RS2_STREAM_ACCEL
+* \param[in]  from       In ms, the timestamp of the first sample wanted, if there's one there
+* \param[in]  to         In ms, the timestamp of the last sample wanted, if there's one there
+* \param[out] samples    Receives up to 'count' samples, oldest first; may be null if 'count' is 0
+* \param[in]  count      Number of samples 'samples' has room for
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                Number of samples in the window, which may be more than 'count'
+*/
+int rs2_get_motion_in_range(const rs2_sensor* sensor, rs2_stream stream, double from, double to, rs2_motion_sample* samples, int count, rs2_error** error);
+
 #ifdef __cplusplus
 }
 #endif
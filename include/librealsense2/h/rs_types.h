@@ -22,6 +22,9 @@ typedef enum rs2_notification_category{
     RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR,                /**< Received unknown error from the device */
     RS2_NOTIFICATION_CATEGORY_FIRMWARE_UPDATE_RECOMMENDED,  /**< Current firmware version installed is not the latest available */
     RS2_NOTIFICATION_CATEGORY_POSE_RELOCALIZATION,          /**< A relocalization event has updated the pose provided by a pose sensor */
+    RS2_NOTIFICATION_CATEGORY_FRAMES_DROPPED,               /**< Frames were dropped by the recorder and are missing from the file */
+    RS2_NOTIFICATION_CATEGORY_PROCESSING_LOAD,              /**< A processing graph lowered its quality to keep up with the frames, or restored it */
+    RS2_NOTIFICATION_CATEGORY_MEMORY_BUDGET,                /**< A sensor holds more frame memory than its share of the "memory-budget-mb" context setting, or is back within it */
     RS2_NOTIFICATION_CATEGORY_COUNT                         /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
 } rs2_notification_category;
 const char* rs2_notification_category_to_string(rs2_notification_category category);
@@ -189,6 +192,14 @@ typedef enum rs2_extension
     RS2_EXTENSION_MAX_USABLE_RANGE_SENSOR,
     RS2_EXTENSION_DEBUG_STREAM_SENSOR,
     RS2_EXTENSION_CALIBRATION_CHANGE_DEVICE,
+    RS2_EXTENSION_DEPTH_PIPELINE,
+    RS2_EXTENSION_PROCESSING_GRAPH,
+    RS2_EXTENSION_DEPTH_NORMALIZE,
+    RS2_EXTENSION_DEPTH_QUALITY_METRICS,
+    RS2_EXTENSION_UNDISTORT_FILTER,
+    RS2_EXTENSION_DEPTH_FUSION,
+    RS2_EXTENSION_SCENE_CHANGE_GATE,
+    RS2_EXTENSION_SPARSE_DEPTH_TRANSFORM,
     RS2_EXTENSION_COUNT
 } rs2_extension;
 const char* rs2_extension_type_to_string(rs2_extension type);
@@ -252,6 +263,8 @@ typedef struct rs2_sensor rs2_sensor;
 typedef struct rs2_options rs2_options;
 typedef struct rs2_options_list rs2_options_list;
 typedef struct rs2_options_changed_callback rs2_options_changed_callback;
+typedef struct rs2_metadata_batch rs2_metadata_batch;
+typedef struct rs2_metadata_batch_callback rs2_metadata_batch_callback;
 typedef struct rs2_devices_changed_callback rs2_devices_changed_callback;
 typedef struct rs2_notification rs2_notification;
 typedef struct rs2_notifications_callback rs2_notifications_callback;
@@ -267,6 +280,10 @@ typedef void (*rs2_frame_callback_ptr)(rs2_frame*, void*);
 typedef void (*rs2_frame_processor_callback_ptr)(rs2_frame*, rs2_source*, void*);
 typedef void (*rs2_update_progress_callback_ptr)(const float, void*);
 typedef void (*rs2_options_changed_callback_ptr)(const rs2_options_list *);
+typedef void (*rs2_options_set_callback_ptr)(rs2_error *, void *);
+typedef void (*rs2_metadata_batch_callback_ptr)(const rs2_metadata_batch *, void *);
+typedef void * (*rs2_frame_allocate_ptr)(int size, void * user);
+typedef void (*rs2_frame_deallocate_ptr)(void * data, int size, void * user);
 
 typedef double      rs2_time_t;     /**< Timestamp format. units are milliseconds */
 typedef long long   rs2_metadata_type; /**< Metadata attribute type is defined as 64 bit signed integer*/
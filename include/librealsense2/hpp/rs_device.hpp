@@ -137,6 +137,18 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * retrieve what it costs the device to keep its global time; the device must be a global timer
+        */
+        rs2_global_time_telemetry get_global_time_telemetry() const
+        {
+            rs2_error* e = nullptr;
+            rs2_global_time_telemetry telemetry;
+            rs2_get_global_time_telemetry(_dev.get(), &telemetry, &e);
+            error::handle(e);
+            return telemetry;
+        }
+
         device& operator=(const std::shared_ptr<rs2_device> dev)
         {
             _dev.reset();
@@ -350,6 +362,38 @@ namespace rs2
         }
     };
 
+    // Update several devices to the provided firmware at once, each on a thread of its own, and return when all are
+    // done. The callback gets the index of a device and its progress, from the thread of that device.
+    template<class T>
+    inline void update_devices(const std::vector<update_device>& devices, const std::vector<uint8_t>& fw_image, T callback)
+    {
+        struct progress
+        {
+            T* callback;
+            size_t index;
+        };
+        std::vector<progress> progresses;
+        std::vector<const rs2_device*> devs;
+        for (size_t i = 0; i < devices.size(); ++i)
+        {
+            progresses.push_back({ &callback, i });
+            devs.push_back(devices[i].get().get());
+        }
+        std::vector<void*> client_data;
+        for (auto& p : progresses)
+            client_data.push_back(&p);
+
+        rs2_error* e = nullptr;
+        rs2_update_firmware_devices(devs.data(), int(devs.size()), fw_image.data(), int(fw_image.size()),
+            [](const float p, void* user)
+            {
+                auto data = static_cast<progress*>(user);
+                (*data->callback)(data->index, p);
+            },
+            client_data.data(), &e);
+        error::handle(e);
+    }
+
     typedef std::vector<uint8_t> calibration_table;
 
     class calibrated_device : public device
@@ -1023,10 +1067,17 @@ namespace rs2
         device_list()
             : _list(nullptr) {}
 
+        // All the devices, created concurrently
         operator std::vector<device>() const
         {
+            rs2_error* e = nullptr;
+            std::vector<rs2_device*> devices(size());
+            rs2_create_devices(_list.get(), devices.data(), &e);
+            error::handle(e);
+
             std::vector<device> res;
-            for (auto&& dev : *this) res.push_back(dev);
+            for (auto dev : devices)
+                res.push_back(device(std::shared_ptr<rs2_device>(dev, rs2_delete_device)));
             return res;
         }
 
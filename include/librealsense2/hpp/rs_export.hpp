@@ -7,6 +7,7 @@
 #include <map>
 #include <fstream>
 #include <cmath>
+#include <cstring>
 #include <sstream>
 #include <cassert>
 #include "rs_processing.hpp"
@@ -87,8 +88,7 @@ namespace rs2
             std::vector<rs2::vertex> new_verts;
             std::vector<vec3d> normals;
             std::vector<std::array<uint8_t, 3>> new_tex;
-            std::map<size_t, size_t> idx_map;
-            std::map<size_t, std::vector<vec3d>> index_to_normals;
+            std::vector<int> idx_map(p.size(), -1);   // Of each point, its index in new_verts; -1 when it has none
 
             new_verts.reserve(p.size());
             if (use_texcoords) new_tex.reserve(p.size());
@@ -99,7 +99,7 @@ namespace rs2
                 if (fabs(verts[i].x) >= min_distance || fabs(verts[i].y) >= min_distance ||
                     fabs(verts[i].z) >= min_distance)
                 {
-                    idx_map[int(i)] = int(new_verts.size());
+                    idx_map[i] = int(new_verts.size());
                     new_verts.push_back({ verts[i].x, -1 * verts[i].y, -1 * verts[i].z });
                     if (use_texcoords)
                     {
@@ -110,44 +110,54 @@ namespace rs2
             }
 
             auto profile = p.get_profile().as<video_stream_profile>();
-            auto width = profile.width(), height = profile.height();
-            static const auto threshold = get_option(OPTION_PLY_THRESHOLD);
-            std::vector<std::array<size_t, 3>> faces;
+            size_t width = profile.width(), height = profile.height();
+            const auto threshold = get_option(OPTION_PLY_THRESHOLD);
+            std::vector<std::array<int, 3>> faces;
+            std::vector<vec3d> normal_sums;     // Of the faces around each vertex
+            std::vector<uint8_t> has_normal;
+            if (mesh && use_normals)
+            {
+                normal_sums.resize(new_verts.size(), vec3d{ 0, 0, 0 });
+                has_normal.resize(new_verts.size(), 0);
+            }
             if (mesh)
             {
-                for (size_t x = 0; x < width - 1; ++x) {
-                    for (size_t y = 0; y < height - 1; ++y) {
+                // Which squares of neighboring points are close in depth is found for a whole row at a time, without
+                // branches, so that the loop can be vectorized
+                std::vector<uint8_t> close(width);
+                for (size_t y = 0; y + 1 < height; ++y) {
+                    const vertex* top = verts + y * width;
+                    const vertex* bottom = top + width;
+                    for (size_t x = 0; x + 1 < width; ++x) {
+                        const float za = top[x].z, zb = top[x + 1].z, zc = bottom[x].z, zd = bottom[x + 1].z;
+                        close[x] = uint8_t((za != 0) & (zb != 0) & (zc != 0) & (zd != 0)
+                            & (fabs(za - zb) < threshold) & (fabs(za - zc) < threshold)
+                            & (fabs(zb - zd) < threshold) & (fabs(zc - zd) < threshold));
+                    }
+                    for (size_t x = 0; x + 1 < width; ++x) {
+                        if (!close[x])
+                            continue;
                         auto a = y * width + x, b = y * width + x + 1, c = (y + 1)*width + x, d = (y + 1)*width + x + 1;
-                        if (verts[a].z && verts[b].z && verts[c].z && verts[d].z
-                            && fabs(verts[a].z - verts[b].z) < threshold && fabs(verts[a].z - verts[c].z) < threshold
-                            && fabs(verts[b].z - verts[d].z) < threshold && fabs(verts[c].z - verts[d].z) < threshold)
-                        {
-                            if (idx_map.count(a) == 0 || idx_map.count(b) == 0 || idx_map.count(c) == 0 ||
-                                idx_map.count(d) == 0)
-                                continue;
-                            faces.push_back({ idx_map[a], idx_map[d], idx_map[b] });
-                            faces.push_back({ idx_map[d], idx_map[a], idx_map[c] });
-
-                            if (use_normals)
-                            {
-                                vec3d point_a = { verts[a].x ,  -1 * verts[a].y,  -1 * verts[a].z };
-                                vec3d point_b = { verts[b].x ,  -1 * verts[b].y,  -1 * verts[b].z };
-                                vec3d point_c = { verts[c].x ,  -1 * verts[c].y,  -1 * verts[c].z };
-                                vec3d point_d = { verts[d].x ,  -1 * verts[d].y,  -1 * verts[d].z };
-
-                                auto n1 = cross(point_d - point_a, point_b - point_a);
-                                auto n2 = cross(point_c - point_a, point_d - point_a);
-
-                                index_to_normals[idx_map[a]].push_back(n1);
-                                index_to_normals[idx_map[a]].push_back(n2);
-
-                                index_to_normals[idx_map[b]].push_back(n1);
-
-                                index_to_normals[idx_map[c]].push_back(n2);
+                        if (idx_map[a] < 0 || idx_map[b] < 0 || idx_map[c] < 0 || idx_map[d] < 0)
+                            continue;
+                        faces.push_back({ idx_map[a], idx_map[d], idx_map[b] });
+                        faces.push_back({ idx_map[d], idx_map[a], idx_map[c] });
 
-                                index_to_normals[idx_map[d]].push_back(n1);
-                                index_to_normals[idx_map[d]].push_back(n2);
-                            }
+                        if (use_normals)
+                        {
+                            vec3d point_a = { verts[a].x ,  -1 * verts[a].y,  -1 * verts[a].z };
+                            vec3d point_b = { verts[b].x ,  -1 * verts[b].y,  -1 * verts[b].z };
+                            vec3d point_c = { verts[c].x ,  -1 * verts[c].y,  -1 * verts[c].z };
+                            vec3d point_d = { verts[d].x ,  -1 * verts[d].y,  -1 * verts[d].z };
+
+                            auto n1 = cross(point_d - point_a, point_b - point_a);
+                            auto n2 = cross(point_c - point_a, point_d - point_a);
+
+                            normal_sums[idx_map[a]] = normal_sums[idx_map[a]] + n1 + n2;
+                            normal_sums[idx_map[b]] = normal_sums[idx_map[b]] + n1;
+                            normal_sums[idx_map[c]] = normal_sums[idx_map[c]] + n2;
+                            normal_sums[idx_map[d]] = normal_sums[idx_map[d]] + n1 + n2;
+                            has_normal[idx_map[a]] = has_normal[idx_map[b]] = has_normal[idx_map[c]] = has_normal[idx_map[d]] = 1;
                         }
                     }
                 }
@@ -155,14 +165,11 @@ namespace rs2
 
             if (mesh && use_normals)
             {
+                normals.reserve(new_verts.size());
                 for (size_t i = 0; i < new_verts.size(); ++i)
                 {
-                    auto normals_vec = index_to_normals[i];
-                    vec3d sum = { 0, 0, 0 };
-                    for (auto& n : normals_vec)
-                        sum = sum + n;
-                    if (normals_vec.size() > 0)
-                        normals.push_back((sum.normalize()));
+                    if (has_normal[i])
+                        normals.push_back(normal_sums[i].normalize());
                     else
                         normals.push_back({ 0, 0, 0 });
                 }
@@ -202,37 +209,44 @@ namespace rs2
             {
                 out.close();
                 out.open(fname, std::ios_base::app | std::ios_base::binary);
+
+                // The vertices, then the faces, each laid out in a buffer and written at once rather than field by
+                // field (we assume little endian architecture on your device)
+                const bool with_normals = mesh && use_normals;
+                const size_t vertex_size = 3 * sizeof(float) + (with_normals ? 3 * sizeof(float) : 0) + (use_texcoords ? 3 : 0);
+                std::vector<uint8_t> buffer(new_verts.size() * vertex_size);
+                auto out_vertex = buffer.data();
                 for (size_t i = 0; i < new_verts.size(); ++i)
                 {
-                    // we assume little endian architecture on your device
-                    out.write(reinterpret_cast<const char*>(&(new_verts[i].x)), sizeof(float));
-                    out.write(reinterpret_cast<const char*>(&(new_verts[i].y)), sizeof(float));
-                    out.write(reinterpret_cast<const char*>(&(new_verts[i].z)), sizeof(float));
-
-                    if (mesh && use_normals)
+                    const float xyz[3] = { new_verts[i].x, new_verts[i].y, new_verts[i].z };
+                    memcpy(out_vertex, xyz, sizeof(xyz));
+                    out_vertex += sizeof(xyz);
+                    if (with_normals)
                     {
-                        out.write(reinterpret_cast<const char*>(&(normals[i].x)), sizeof(float));
-                        out.write(reinterpret_cast<const char*>(&(normals[i].y)), sizeof(float));
-                        out.write(reinterpret_cast<const char*>(&(normals[i].z)), sizeof(float));
+                        const float n[3] = { normals[i].x, normals[i].y, normals[i].z };
+                        memcpy(out_vertex, n, sizeof(n));
+                        out_vertex += sizeof(n);
                     }
-
                     if (use_texcoords)
                     {
-                        out.write(reinterpret_cast<const char*>(&(new_tex[i][0])), sizeof(uint8_t));
-                        out.write(reinterpret_cast<const char*>(&(new_tex[i][1])), sizeof(uint8_t));
-                        out.write(reinterpret_cast<const char*>(&(new_tex[i][2])), sizeof(uint8_t));
+                        memcpy(out_vertex, new_tex[i].data(), 3);
+                        out_vertex += 3;
                     }
                 }
+                out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+
                 if (mesh)
                 {
-                    auto size = faces.size();
-                    for (size_t i = 0; i < size; ++i) {
-                        static const int three = 3;
-                        out.write(reinterpret_cast<const char*>(&three), sizeof(uint8_t));
-                        out.write(reinterpret_cast<const char*>(&(faces[i][0])), sizeof(int));
-                        out.write(reinterpret_cast<const char*>(&(faces[i][1])), sizeof(int));
-                        out.write(reinterpret_cast<const char*>(&(faces[i][2])), sizeof(int));
+                    const size_t face_size = sizeof(uint8_t) + 3 * sizeof(int);
+                    buffer.resize(faces.size() * face_size);
+                    auto out_face = buffer.data();
+                    for (auto const& face : faces)
+                    {
+                        *out_face = 3;
+                        memcpy(out_face + 1, face.data(), 3 * sizeof(int));
+                        out_face += face_size;
                     }
+                    out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
                 }
             }
             else
@@ -5,6 +5,7 @@
 #define LIBREALSENSE_RS2_FRAME_HPP
 
 #include "rs_types.hpp"
+#include <map>
 
 namespace rs2
 {
@@ -516,6 +517,24 @@ namespace rs2
             return r != 0;
         }
 
+        /** retrieve all the metadata the frame supports, in one call
+        * \return            the supported frame_metadata and their values
+        */
+        std::map<rs2_frame_metadata_value, rs2_metadata_type> get_frame_metadata_all() const
+        {
+            rs2_error* e = nullptr;
+            rs2_metadata_type values[RS2_FRAME_METADATA_COUNT];
+            int supported[RS2_FRAME_METADATA_COUNT];
+            rs2_get_frame_metadata_all(frame_ref, values, supported, RS2_FRAME_METADATA_COUNT, &e);
+            error::handle(e);
+
+            std::map<rs2_frame_metadata_value, rs2_metadata_type> res;
+            for (int i = 0; i < RS2_FRAME_METADATA_COUNT; ++i)
+                if (supported[i])
+                    res[rs2_frame_metadata_value(i)] = values[i];
+            return res;
+        }
+
         /**
         * retrieve frame number (from frame handle)
         * \return               the frame number of the frame, in milliseconds since the device was started
@@ -528,6 +547,19 @@ namespace rs2
             return r;
         }
 
+        /**
+        * retrieve the data, size, dimensions, stride, bits per pixel, timestamp and number of the frame, at once
+        * \return               what the frame has of them; the video ones are 0 for frames that aren't video frames
+        */
+        rs2_frame_info get_frame_info() const
+        {
+            rs2_error* e = nullptr;
+            rs2_frame_info info;
+            rs2_get_frame_info(frame_ref, &info, &e);
+            error::handle(e);
+            return info;
+        }
+
         /**
         * retrieve data size from frame handle
         * \return               the number of bytes in frame
@@ -552,6 +584,32 @@ namespace rs2
             return r;
         }
 
+        /**
+        * retrieve the DMABUF file descriptor backing the frame data, owned by the frame
+        * 
+eturn               the file descriptor, or -1 if the frame data is not backed by one
+        */
+        int get_dmabuf_fd() const
+        {
+            rs2_error* e = nullptr;
+            auto r = rs2_get_frame_dmabuf_fd(frame_ref, &e);
+            error::handle(e);
+            return r;
+        }
+
+        /**
+        * retrieve the frame data in GPU memory, for frames that a CUDA processing block left there, owned by the frame
+        * \param[out] device    if non-null, receives the CUDA device the data is on, or -1
+        * \return               the device pointer, or null if the frame data is only in host memory
+        */
+        const void* get_cuda_data(int* device = nullptr) const
+        {
+            rs2_error* e = nullptr;
+            auto r = rs2_get_frame_cuda_data(frame_ref, device, &e);
+            error::handle(e);
+            return r;
+        }
+
         /**
         * retrieve stream profile from frame handle
         * \return  stream_profile - the pointer to the stream profile
@@ -105,6 +105,35 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Get a video frame of the sensor's own pool to write the pixels of in place, then inject with submit_frame()
+        *
+        * \param[in] frame   the parameters of the frame; its pixels and deleter are not used
+        * \return            the frame, or an empty one when the sensor is not streaming
+        */
+        video_frame allocate_video_frame(rs2_software_video_frame frame)
+        {
+            rs2_error* e = nullptr;
+            auto f = rs2_software_sensor_allocate_video_frame(_sensor.get(), frame, &e);
+            error::handle(e);
+            return rs2::frame(f);
+        }
+
+        /**
+        * Inject a frame of allocate_video_frame()
+        *
+        * \param[in] f   the frame; it can't be written to afterwards
+        */
+        void submit_frame(const frame& f)
+        {
+            rs2_error* e = nullptr;
+            rs2_frame* ref = f.get();
+            rs2_frame_add_ref(ref, &e);
+            error::handle(e);
+            rs2_software_sensor_submit_frame(_sensor.get(), ref, &e);
+            error::handle(e);
+        }
+
         /**
         * Inject motion frame into the sensor
         *
@@ -8,6 +8,9 @@
 #include "../h/rs_types.h"
 
 #include <memory>
+#include <future>
+#include <utility>
+#include <vector>
 
 
 namespace rs2
@@ -260,6 +263,30 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * write new values to the options without waiting for them to be set: see rs2_set_options_async
+        * \param[in] values     the options to write, and their new values
+        * \return               ready once all of them are set; holds the first error, if any failed
+        */
+        std::future< void > set_options_async( std::vector< std::pair< rs2_option, float > > const & values ) const
+        {
+            std::vector< rs2_option > ids;
+            std::vector< float > vals;
+            for( auto & v : values )
+            {
+                ids.push_back( v.first );
+                vals.push_back( v.second );
+            }
+            auto promise = new std::promise< void >();
+            auto future = promise->get_future();
+            rs2_error * e = nullptr;
+            rs2_set_options_async( _options, ids.data(), vals.data(), static_cast< int >( ids.size() ), &on_options_set, promise, &e );
+            if( e )
+                delete promise;
+            error::handle( e );
+            return future;
+        }
+
         /**
         * write new value to the option
         * \param[in] option     option id to be queried
@@ -343,6 +370,20 @@ namespace rs2
         }
 
     private:
+        static void on_options_set( rs2_error * e, void * user )
+        {
+            std::unique_ptr< std::promise< void > > promise( static_cast< std::promise< void > * >( user ) );
+            try
+            {
+                error::handle( e );
+                promise->set_value();
+            }
+            catch( ... )
+            {
+                promise->set_exception( std::current_exception() );
+            }
+        }
+
         rs2_options* _options;
     };
 
@@ -545,6 +545,30 @@ namespace rs2
             return res > 0;
         }
 
+        /**
+        * Take all the sets of frames available, up to max, oldest first, without blocking the calling thread.
+        * Unless the "pipeline": { "queue-size": N } context setting is given, the pipeline keeps only the latest set.
+        *
+        * \param[out] output   At least max frames sets
+        * \return              The number of frames sets stored to output
+        */
+        size_t poll_for_frames_batch(frameset* output, size_t max) const
+        {
+            if (!output)
+            {
+                throw std::invalid_argument("null frameset");
+            }
+            if (!max)
+                return 0;
+            std::vector<rs2_frame*> refs(max);
+            rs2_error* e = nullptr;
+            auto n = rs2_pipeline_poll_for_frames_batch(_pipeline.get(), refs.data(), int(max), &e);
+            error::handle(e);
+            for (int i = 0; i < n; ++i)
+                output[i] = frameset(frame(refs[i]));
+            return size_t(n);
+        }
+
         bool try_wait_for_frames(frameset* f, unsigned int timeout_ms = RS2_DEFAULT_TIMEOUT) const
         {
             if (!f)
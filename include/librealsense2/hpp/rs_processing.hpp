@@ -139,12 +139,14 @@ namespace rs2
         * to help developers who are not using async APIs
         * param[in] capacity size of the frame queue
         * param[in] keep_frames  if set to true, the queue automatically calls keep() on every frame enqueued into it.
+        * param[in] lock_free    if set to true, enqueuing and dequeuing take no lock (see rs2_create_lock_free_frame_queue)
         */
-        explicit frame_queue(unsigned int capacity, bool keep_frames = false) : _capacity(capacity), _keep(keep_frames)
+        explicit frame_queue(unsigned int capacity, bool keep_frames = false, bool lock_free = false)
+            : _capacity(capacity), _keep(keep_frames)
         {
             rs2_error* e = nullptr;
             _queue = std::shared_ptr<rs2_frame_queue>(
-                rs2_create_frame_queue(capacity, &e),
+                lock_free ? rs2_create_lock_free_frame_queue(capacity, &e) : rs2_create_frame_queue(capacity, &e),
                 rs2_delete_frame_queue);
             error::handle(e);
         }
@@ -191,6 +193,24 @@ namespace rs2
             return res > 0;
         }
 
+        /**
+        * dequeue all the frames available, up to max, without waiting for any
+        * \param[out] output - at least max frames, filled in the order of the queue
+        * \return the number of frames stored to output
+        */
+        size_t poll_for_frames_batch(frame* output, size_t max) const
+        {
+            if (!max)
+                return 0;
+            std::vector<rs2_frame*> refs(max);
+            rs2_error* e = nullptr;
+            auto n = rs2_frame_queue_poll_batch(_queue.get(), refs.data(), int(max), &e);
+            error::handle(e);
+            for (int i = 0; i < n; ++i)
+                output[i] = frame{ refs[i] };
+            return size_t(n);
+        }
+
         template<typename T>
         typename std::enable_if<std::is_base_of<rs2::frame, T>::value, bool>::type try_wait_for_frame(T* output, unsigned int timeout_ms = 5000) const
         {
@@ -625,6 +645,11 @@ namespace rs2
         */
         asynchronous_syncer() : processing_block(init()) {}
 
+        /**
+        * Asynchronous syncer for a sync processing block that was already created
+        */
+        explicit asynchronous_syncer(std::shared_ptr<rs2_processing_block> block) : processing_block(block) {}
+
     private:
         std::shared_ptr<rs2_processing_block> init()
         {
@@ -697,11 +722,43 @@ namespace rs2
         {
             _sync.invoke(std::move(f));
         }
+
+    protected:
+        syncer(std::shared_ptr<rs2_processing_block> block, int queue_size)
+            :_sync(block), _results(queue_size)
+        {
+            _sync.start(_results);
+        }
+
     private:
         asynchronous_syncer _sync;
         frame_queue _results;
     };
 
+    class multi_device_syncer : public syncer
+    {
+    public:
+        /**
+        * Sync instance for the frames of several hardware-synchronized devices (see RS2_OPTION_INTER_CAM_SYNC_MODE):
+        * the framesets of all the devices are matched on their global timestamps, and come out as one
+        * \param[in] max_jitter_ms  The most framesets can be apart and still be matched, up to half a frame; 0 for half a frame
+        */
+        multi_device_syncer(float max_jitter_ms = 0, int queue_size = 1)
+            : syncer(init(max_jitter_ms), queue_size) {}
+
+    private:
+        static std::shared_ptr<rs2_processing_block> init(float max_jitter_ms)
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_multi_device_sync_processing_block(max_jitter_ms, &e),
+                rs2_delete_processing_block);
+
+            error::handle(e);
+            return block;
+        }
+    };
+
     /**
     Auxiliary processing block that performs image alignment using depth data and camera calibration
     */
@@ -714,6 +771,8 @@ namespace rs2
         To perform alignment of a depth image to the other, set the align_to parameter with the other stream type.
         To perform alignment of a non depth image to a depth image, set the align_to parameter to RS2_STREAM_DEPTH.
         Camera calibration and frame's stream type are determined on the fly, according to the first valid frameset passed to process().
+        With RS2_OPTION_ALIGN_OUTPUT_SCALE below 1, the aligned frames are made in a grid that many times smaller than
+        the stream aligned to, whose intrinsics they carry, and the alignment costs about the square of it as much.
 
         * \param[in] align_to      The stream type to which alignment should be made.
         */
@@ -1188,5 +1247,343 @@ namespace rs2
             return block;
         }
     };
+
+    class depth_pipeline : public filter
+    {
+    public:
+        /**
+        * Create depth pipeline processing block
+        * The block runs decimation, depth to disparity, spatial, temporal, hole filling and disparity to depth in one
+        * go, with the output of the chain of separate filters. RS2_OPTION_PIPELINE_STAGE selects the stage that the
+        * options several stages have are of.
+        */
+        depth_pipeline() : filter(init(), 1) {}
+
+        depth_pipeline(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_DEPTH_PIPELINE, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_depth_pipeline_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class depth_normalize : public filter
+    {
+    public:
+        /**
+        * Create depth normalize processing block
+        * The block does what the threshold filter followed by the units transform, or by depth to disparity, do, in
+        * one pass. It has the options of the threshold filter, and RS2_OPTION_DEPTH_NORMALIZE_OUTPUT selects distance
+        * in meters or disparity for the output.
+        */
+        depth_normalize() : filter(init(), 1) {}
+
+        depth_normalize(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_DEPTH_NORMALIZE, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_depth_normalize_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class depth_quality_metrics : public filter
+    {
+    public:
+        /**
+        * Create depth quality metrics processing block
+        * The block passes depth frames through unchanged, and fits a plane to the points of its region of interest
+        * over the last RS2_OPTION_DEPTH_QUALITY_WINDOW frames. The metrics of the depth-quality tool are read from its
+        * read-only options: RS2_OPTION_DEPTH_QUALITY_FILL_RATE, RS2_OPTION_DEPTH_QUALITY_PLANE_FIT_RMS_ERROR and
+        * RS2_OPTION_DEPTH_QUALITY_DISTANCE.
+        */
+        depth_quality_metrics() : filter(init(), 1) {}
+
+        depth_quality_metrics(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_DEPTH_QUALITY_METRICS, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_depth_quality_metrics_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class undistort_filter : public filter
+    {
+    public:
+        /**
+        * Create undistort processing block
+        * The block remaps color and infrared frames (Y8, Y16, RGB8, BGR8, RGBA8 or BGRA8) to images of the same
+        * intrinsics without distortion. Frames of other formats, and of no distortion, pass through.
+        */
+        undistort_filter() : filter(init(), 1) {}
+
+        undistort_filter(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_UNDISTORT_FILTER, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_undistort_filter_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class depth_fusion : public filter
+    {
+    public:
+        /**
+        * Create depth fusion processing block
+        * The depth of several cameras, placed relative to the first depth stream the block sees by the extrinsics
+        * registered to it (stream_profile::register_extrinsics_to), is output with each frame of that stream as one
+        * point cloud or as a height map (RS2_OPTION_DEPTH_FUSION_OUTPUT). Frames can be processed one at a time, or
+        * as framesets.
+        */
+        depth_fusion() : filter(init(), 1) {}
+
+        depth_fusion(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_DEPTH_FUSION, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_depth_fusion_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class scene_change_gate : public filter
+    {
+    public:
+        /**
+        * Create scene-change gate processing block
+        * Frames, or framesets, that changed less than RS2_OPTION_SCENE_CHANGE_THRESHOLD percent of their pixels since
+        * the last the block passed on are dropped, except for one every RS2_OPTION_SCENE_CHANGE_KEEP_ALIVE ms. Put
+        * ahead of costly blocks, or of a branch of a processing_graph, it spares them the frames showing nothing new.
+        */
+        scene_change_gate() : filter(init(), 1) {}
+
+        scene_change_gate(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_SCENE_CHANGE_GATE, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_scene_change_gate_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class sparse_depth_transform : public filter
+    {
+    public:
+        /**
+        * Create sparse depth transform processing block
+        * Z16 depth frames are converted to RS2_FORMAT_Z16_SPARSE ones, of their valid pixels only, or back; a frameset
+        * has its depth frame replaced. depth_frame::get_distance() and the pointcloud take the sparse frames as they
+        * are, at a cost in the count of valid pixels rather than of all of them.
+        */
+        sparse_depth_transform(bool transform_to_sparse = true) : filter(init(transform_to_sparse), 1) {}
+
+        sparse_depth_transform(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_SPARSE_DEPTH_TRANSFORM, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init(bool transform_to_sparse)
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_sparse_depth_transform_block(uint8_t(transform_to_sparse), &e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    template<class T> class notifications_callback;  // rs_sensor.hpp
+
+    class processing_graph : public processing_block
+    {
+    public:
+        /**
+        * Create a processing graph: a tree of processing blocks run on the shared worker threads, so that blocks on
+        * different branches, and successive frames through the same branch, are processed concurrently. Each block
+        * still sees one frame at a time, in order. Start it with a callback or a frame_queue for the output, which
+        * comes out in the order of the input.
+        * \param[in] max_in_flight  The most frames being processed at once; invoke() waits once there are that many
+        */
+        explicit processing_graph(int max_in_flight = 2) : processing_block(init(max_in_flight)) {}
+
+        /**
+        * Add a block, before the graph gets its first frame. It must output what it makes of a frame from within
+        * its own processing, as filters do, and its output goes to the graph from then on.
+        * What comes out of the graph for each frame is the output of the blocks nothing was added to, in one
+        * frameset when there are several.
+        * \param[in] block   The block to add
+        * \param[in] parent  The index of the block whose output feeds this one, as returned by add(); -1 for the input
+        * \return           The index of the block in the graph
+        */
+        int add(processing_block const & block, int parent = -1)
+        {
+            rs2_error* e = nullptr;
+            auto index = rs2_processing_graph_add_block(get(), block.get(), parent, &e);
+            error::handle(e);
+            return index;
+        }
+
+        /**
+        * Add a step to the load policy, before the graph gets its first frame: while the graph falls behind, the steps
+        * are taken one at a time, in order, and undone in reverse once it keeps up again
+        * \param[in] block   The index of the block, as returned by add()
+        * \param[in] option  The option of the block to set
+        * \param[in] value   The value, cheaper to process with, to set it to
+        * \return           The index of the step
+        */
+        int add_load_step(int block, rs2_option option, float value)
+        {
+            rs2_error* e = nullptr;
+            auto index = rs2_processing_graph_add_load_step(get(), block, option, value, &e);
+            error::handle(e);
+            return index;
+        }
+
+        /**
+        * Same, with a step that skips the block: its input is passed on as its output
+        * \param[in] block   The index of the block, as returned by add()
+        * \return           The index of the step
+        */
+        int add_bypass_step(int block)
+        {
+            rs2_error* e = nullptr;
+            auto index = rs2_processing_graph_add_bypass_step(get(), block, &e);
+            error::handle(e);
+            return index;
+        }
+
+        /**
+        * Register a callback for the notifications of the load policy, each time a step is taken or undone
+        * \param[in] callback   notifications callback, taking an rs2::notification
+        */
+        template<class T>
+        void set_notifications_callback(T callback)
+        {
+            rs2_error* e = nullptr;
+            rs2_processing_graph_set_notifications_callback_cpp(get(),
+                new notifications_callback<T>(std::move(callback)), &e);
+            error::handle(e);
+        }
+
+    private:
+        static std::shared_ptr<rs2_processing_block> init(int max_in_flight)
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_processing_graph(max_in_flight, &e),
+                rs2_delete_processing_block);
+            error::handle(e);
+            return block;
+        }
+    };
 }
 #endif // LIBREALSENSE_RS2_PROCESSING_HPP
@@ -126,6 +126,35 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Set the playback to work offline, for batch processing: as fast as the application handles the frames
+        *
+        * Frames are handed out in the order they were recorded, all from the same thread, while the next ones are read.
+        * Reading is held back while max_frames_in_flight frames are yet to be released by the application, so none are
+        * dropped. Keep it below the number of frames the application may hold on to at once plus those a processing
+        * pipeline (e.g., a syncer) may keep internally, or playback will keep waiting for them to be released.
+        * \param[in] max_frames_in_flight  Frames read and not yet released, at most; 0 to turn offline playback off
+        */
+        void set_offline(int max_frames_in_flight) const
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_device_set_offline(_dev.get(), max_frames_in_flight, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Play only part of the file, e.g. to split processing it between several playback devices
+        * Takes effect the next time the playback starts.
+        * \param[in] start  Beginning of the range, from the start of the file
+        * \param[in] end    End of the range (not included), from the start of the file; zero for the end of the file
+        */
+        void set_range(std::chrono::nanoseconds start, std::chrono::nanoseconds end) const
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_device_set_range(_dev.get(), start.count(), end.count(), &e);
+            error::handle(e);
+        }
+
         /**
         * Set the playing speed
         * \param[in] speed  Indicates a multiplication of the speed to play (e.g: 1 = normal, 0.5 twice as slow)
@@ -235,6 +264,31 @@ namespace rs2
         }
 
 
+        /**
+        * Creates recording devices that record all of the given devices into the one file, on a shared clock, so
+        * that loading it plays back all of them together
+        * \param[in]  file                  The desired path to which the recorders should save the data
+        * \param[in]  devices               The devices to record
+        * \param[in]  compression_enabled   Indicates if compression is enabled
+        * \return A recorder for each of the devices, in order
+        */
+        static std::vector<recorder> record_all(const std::string& file, const std::vector<rs2::device>& devices,
+                                                bool compression_enabled = true)
+        {
+            std::vector<const rs2_device*> handles;
+            for (auto&& dev : devices)
+                handles.push_back(dev.get().get());
+            std::vector<rs2_device*> recorded(devices.size(), nullptr);
+            rs2_error* e = nullptr;
+            rs2_create_multi_record_device(handles.data(), static_cast<int>(handles.size()), file.c_str(),
+                                           compression_enabled, recorded.data(), &e);
+            rs2::error::handle(e);
+            std::vector<recorder> recorders;
+            for (auto dev : recorded)
+                recorders.push_back(recorder(std::shared_ptr<rs2_device>(dev, rs2_delete_device)));
+            return recorders;
+        }
+
         /**
         * Pause the recording device without stopping the actual device from streaming.
         */
@@ -98,6 +98,21 @@ namespace rs2
         void release() override { delete this; }
     };
 
+    template<class T>
+    class metadata_batch_callback : public rs2_metadata_batch_callback
+    {
+        T on_batch_function;
+    public:
+        explicit metadata_batch_callback(T on_batch) : on_batch_function(on_batch) {}
+
+        void on_batch(const rs2_metadata_batch* batch) override
+        {
+            on_batch_function(*batch);
+        }
+
+        void release() override { delete this; }
+    };
+
 
     class sensor : public options
     {
@@ -212,6 +227,32 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Provide the memory frame data is stored in, instead of the library's own heap buffers
+        * \param[in] on_allocate     returns a buffer of at least 'size' bytes, or null to use the default allocation;
+        *                            null restores the default allocator
+        * \param[in] on_deallocate   returns a buffer obtained from on_allocate, once its frame is released
+        * \param[in] user            user data passed to both callbacks
+        */
+        void set_frame_allocator(rs2_frame_allocate_ptr on_allocate, rs2_frame_deallocate_ptr on_deallocate, void * user) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_frame_allocator(_sensor.get(), on_allocate, on_deallocate, user, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Place frame data on a NUMA node and/or in huge pages, instead of the library's own heap buffers
+        * \param[in] numa_node       the node to place frames on, or -1 for no placement
+        * \param[in] huge_pages      back the bigger frames with huge pages
+        */
+        void set_frame_memory_policy(int numa_node, bool huge_pages = false) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_frame_memory_policy(_sensor.get(), numa_node, huge_pages ? 1 : 0, &e);
+            error::handle(e);
+        }
+
         /**
         * Retrieves the list of stream profiles supported by the sensor.
         * \return   list of stream profiles that given sensor can provide
@@ -266,6 +307,52 @@ namespace rs2
             return results;
         }
 
+        /**
+        * Retrieves the telemetry of the streams the sensor has streamed since it was last opened: frames received,
+        * delivered and dropped, latency, frames held downstream, and errors
+        */
+        std::vector<rs2_stream_telemetry> get_stream_telemetry() const
+        {
+            rs2_error* e = nullptr;
+            std::vector<rs2_stream_telemetry> results(rs2_get_stream_telemetry(_sensor.get(), nullptr, 0, &e));
+            error::handle(e);
+
+            // A stream may have been added in between
+            auto count = rs2_get_stream_telemetry(_sensor.get(), results.data(), int(results.size()), &e);
+            error::handle(e);
+            if (size_t(count) < results.size())
+                results.resize(count);
+            return results;
+        }
+
+        /**
+        * Sinks the metadata of every frame the sensor gets into columns, handed to 'callback' in batches of
+        * 'batch_size' frames (see rs2_metadata_batch); they're only valid during the callback
+        */
+        template<class T>
+        void set_metadata_sink(T callback, int batch_size) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_metadata_sink_cpp(_sensor.get(), batch_size, new metadata_batch_callback<T>(std::move(callback)), &e);
+            error::handle(e);
+        }
+
+        /** Stops sinking metadata, after handing on what's left */
+        void reset_metadata_sink() const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_metadata_sink_cpp(_sensor.get(), 0, nullptr, &e);
+            error::handle(e);
+        }
+
+        /** Hands on the frames sunk since the last batch, as a smaller batch */
+        void flush_metadata_sink() const
+        {
+            rs2_error* e = nullptr;
+            rs2_flush_metadata_sink(_sensor.get(), &e);
+            error::handle(e);
+        }
+
         /**
         * get the recommended list of filters by the sensor
         * \return   list of filters that recommended by sensor
@@ -400,6 +487,35 @@ namespace rs2
             error::handle(e);
         }
         operator bool() const { return _sensor.get() != nullptr; }
+
+        /**
+        * The motion at a timestamp, interpolated between the samples of the stream the sensor keeps on either side of it
+        * (see rs2_get_motion_at)
+        * \return  false if the samples kept don't reach 'timestamp', in which case nothing is written
+        */
+        bool get_motion_at(rs2_stream stream, double timestamp, rs2_motion_sample& sample,
+            rs2_motion_sample* before = nullptr, rs2_motion_sample* after = nullptr) const
+        {
+            rs2_error* e = nullptr;
+            auto found = rs2_get_motion_at(_sensor.get(), stream, timestamp, &sample, before, after, &e);
+            error::handle(e);
+            return found != 0;
+        }
+
+        /** The samples of the stream the sensor keeps within [from, to], in ms, oldest first */
+        std::vector<rs2_motion_sample> get_motion_in_range(rs2_stream stream, double from, double to) const
+        {
+            rs2_error* e = nullptr;
+            std::vector<rs2_motion_sample> results(rs2_get_motion_in_range(_sensor.get(), stream, from, to, nullptr, 0, &e));
+            error::handle(e);
+
+            // More may have come in between, and the oldest gone
+            auto count = rs2_get_motion_in_range(_sensor.get(), stream, from, to, results.data(), int(results.size()), &e);
+            error::handle(e);
+            if (size_t(count) < results.size())
+                results.resize(count);
+            return results;
+        }
     };
 
     class fisheye_sensor : public sensor
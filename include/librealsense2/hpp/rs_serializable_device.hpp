@@ -53,5 +53,31 @@ namespace rs2
                 &e);
             rs2::error::handle(e);
         }
+
+        // A compact binary snapshot of the same settings, with the options and calibration table of the device
+        std::vector<uint8_t> serialize_snapshot() const
+        {
+            rs2_error* e = nullptr;
+            std::shared_ptr<rs2_raw_data_buffer> snapshot(
+                rs2_serialize_snapshot(_dev.get(), &e),
+                rs2_delete_raw_data);
+            rs2::error::handle(e);
+
+            auto size = rs2_get_raw_data_size(snapshot.get(), &e);
+            rs2::error::handle(e);
+
+            auto start = rs2_get_raw_data(snapshot.get(), &e);
+            rs2::error::handle(e);
+
+            return std::vector<uint8_t>(start, start + size);
+        }
+
+        // Writes only the settings of the snapshot that differ from the device's
+        void load_snapshot(const std::vector<uint8_t>& snapshot) const
+        {
+            rs2_error* e = nullptr;
+            rs2_load_snapshot(_dev.get(), snapshot.data(), (unsigned int)snapshot.size(), &e);
+            rs2::error::handle(e);
+        }
     };
 }
@@ -104,6 +104,14 @@ struct rs2_options_changed_callback
 };
 typedef std::shared_ptr< rs2_options_changed_callback > rs2_options_changed_callback_sptr;
 
+struct rs2_metadata_batch_callback
+{
+    virtual void on_batch( const rs2_metadata_batch * batch ) = 0;
+    virtual void release() = 0;
+    virtual ~rs2_metadata_batch_callback() {}
+};
+typedef std::shared_ptr< rs2_metadata_batch_callback > rs2_metadata_batch_callback_sptr;
+
 namespace rs2
 {
     class error : public std::runtime_error
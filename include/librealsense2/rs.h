@@ -91,6 +91,33 @@ void rs2_log_to_console(rs2_log_severity min_severity, rs2_error ** error);
 
 void rs2_log_to_file(rs2_log_severity min_severity, const char * file_path, rs2_error ** error);
 
+/**
+* Write the messages of the binary log to a file, as they are, for tools/binary-log-decoder to put into words later.
+* Only messages logged with a format (LOG_DEBUG_FMT and the likes; they're mostly from the paths that see every
+* frame) go there, and they do instead of to the other logs. Any file before is closed.
+* \param[in] min_severity   the minimum severity of the messages to write; RS2_LOG_SEVERITY_NONE stops writing them
+* \param[in] file_path      the file to write to; it's overwritten
+* \param[out] error         if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_log_to_binary_file(rs2_log_severity min_severity, const char * file_path, rs2_error ** error);
+
+/**
+* Start or stop tracing frames through the pipeline: each frame is stamped when it arrives from the backend, as every
+* processing block (format conversions included) works on it, as it's synced, queued and handed to a callback.
+* Only frames that arrive while it's on are traced. The latest stamps are kept until they're exported.
+* \param[in] enable   non-zero to start tracing, zero to stop
+* \param[out] error   if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_enable_frame_tracing(int enable, rs2_error ** error);
+
+/**
+* Write the frame stamps kept since the last export to a file, in the Chrome trace (JSON) format, for
+* chrome://tracing or https://ui.perfetto.dev. Each frame shows as a slice, with where its time went inside it.
+* \param[in] file_path  the file to write to; it's overwritten
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_export_frame_trace(const char * file_path, rs2_error ** error);
+
 void rs2_log_to_callback_cpp( rs2_log_severity min_severity, rs2_log_callback * callback, rs2_error ** error );
 
 void rs2_log_to_callback( rs2_log_severity min_severity, rs2_log_callback_ptr callback, void * arg, rs2_error** error );
@@ -30,6 +30,27 @@ namespace rs2
         error::handle(e);
     }
 
+    inline void log_to_binary_file(rs2_log_severity min_severity, const char * file_path)
+    {
+        rs2_error* e = nullptr;
+        rs2_log_to_binary_file(min_severity, file_path, &e);
+        error::handle(e);
+    }
+
+    inline void enable_frame_tracing(bool enable = true)
+    {
+        rs2_error* e = nullptr;
+        rs2_enable_frame_tracing(enable ? 1 : 0, &e);
+        error::handle(e);
+    }
+
+    inline void export_frame_trace(const char * file_path)
+    {
+        rs2_error* e = nullptr;
+        rs2_export_frame_trace(file_path, &e);
+        error::handle(e);
+    }
+
     inline void reset_logger()
     {
         rs2_error* e = nullptr;
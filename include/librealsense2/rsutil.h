@@ -38,6 +38,30 @@ void rs2_project_color_pixel_to_depth_pixel(float to_pixel[2],
     const struct rs2_extrinsics* depth_to_color,
     const float from_pixel[2]);
 
+/* rs2_project_point_to_pixel for count points, 3 floats each; pixels takes 2 floats for each */
+void rs2_project_points_to_pixels(float* pixels, const rs2_intrinsics* intrin, const float* points, int count);
+
+/* rs2_deproject_pixel_to_point for count pixels, 2 floats each, at their depths (or at 1 when depths is null); points takes 3 floats for each */
+void rs2_deproject_pixels_to_points(float* points, const rs2_intrinsics* intrin, const float* pixels, const float* depths, int count);
+
+/* What rs2_project_color_pixels_to_depth_pixels keeps from call to call of the same depth stream: the rays of its pixels */
+typedef struct rs2_color_to_depth_cache rs2_color_to_depth_cache;
+rs2_color_to_depth_cache* rs2_create_color_to_depth_cache(rs2_error** error);
+void rs2_delete_color_to_depth_cache(rs2_color_to_depth_cache* cache);
+
+/* rs2_project_color_pixel_to_depth_pixel for count color pixels. With a cache, the rays of the depth pixels are computed
+   once while the depth intrinsics and depth_to_color extrinsics stay the same, and interpolated between pixels; without
+   one (null), every color pixel is searched for as by rs2_project_color_pixel_to_depth_pixel. */
+void rs2_project_color_pixels_to_depth_pixels(float* to_pixels,
+    rs2_color_to_depth_cache* cache,
+    const uint16_t* data, float depth_scale,
+    float depth_min, float depth_max,
+    const struct rs2_intrinsics* depth_intrin,
+    const struct rs2_intrinsics* color_intrin,
+    const struct rs2_extrinsics* color_to_depth,
+    const struct rs2_extrinsics* depth_to_color,
+    const float* from_pixels, int count);
+
 
 #ifdef __cplusplus
 }
@@ -4,6 +4,14 @@
 #include "algo.h"
 #include "option.h"
 #include "core/video-frame.h"
+#include <rsutils/os/thread.h>
+#include <limits>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 using namespace librealsense;
 
@@ -27,6 +35,11 @@ float auto_exposure_state::get_auto_exposure_step() const
     return step;
 }
 
+unsigned auto_exposure_state::get_auto_exposure_sample_rate() const
+{
+    return sample_rate;
+}
+
 void auto_exposure_state::set_enable_auto_exposure(bool value)
 {
     is_auto_exposure = value;
@@ -47,6 +60,11 @@ void auto_exposure_state::set_auto_exposure_step(float value)
     step = value;
 }
 
+void auto_exposure_state::set_auto_exposure_sample_rate(unsigned value)
+{
+    sample_rate = value < 1 ? 1 : value > max_sample_rate ? max_sample_rate : value;
+}
+
 auto_exposure_mechanism::auto_exposure_mechanism(option& gain_option, option& exposure_option, const auto_exposure_state& auto_exposure_state)
     : _gain_option(gain_option), _exposure_option(exposure_option),
       _auto_exposure_algo(auto_exposure_state),
@@ -56,6 +74,7 @@ auto_exposure_mechanism::auto_exposure_mechanism(option& gain_option, option& ex
     _exposure_thread = std::make_shared<std::thread>(
                 [this]()
     {
+        rsutils::os::init_thread("auto-exposure");
         while (_keep_alive)
         {
             std::unique_lock<std::mutex> lk(_queue_mtx);
@@ -96,6 +115,14 @@ auto_exposure_mechanism::auto_exposure_mechanism(option& gain_option, option& ex
                 auto gain_value = static_cast<float>(2. + (values[1] - 15.) / 8.);
 
                 bool sts = _auto_exposure_algo.analyze_image(frame);
+
+                // While the exposure stays where it is, look at fewer and fewer frames; back to the usual rate as
+                // soon as it has to move
+                if (sts)
+                    _skip_frames = auto_exposure_state::skip_frames;
+                else
+                    _skip_frames = std::min(2 * _skip_frames + 1, unsigned(auto_exposure_state::max_skip_frames));
+
                 if (sts)
                 {
                     bool modify_exposure, modify_gain;
@@ -155,7 +182,8 @@ void auto_exposure_mechanism::update_auto_exposure_roi(const region_of_interest&
 void auto_exposure_mechanism::add_frame(frame_holder frame)
 {
 
-    if (!_keep_alive || (_skip_frames && (_frames_counter++) != _skip_frames))
+    // _skip_frames may drop below the counter, when the exposure starts moving again
+    if (!_keep_alive || (_frames_counter++) < _skip_frames)
     {
         return;
     }
@@ -243,10 +271,11 @@ bool auto_exposure_algorithm::analyze_image(const frame_interface* image)
     }
 
     std::vector<int> H(256);
-    auto total_weight = number_of_pixels;
 
     auto cols = frame->get_width();
-    im_hist((uint8_t*)frame->get_frame_data(), image_roi, frame->get_bpp() / 8 * cols, &H[0]);
+    auto total_weight = im_hist((uint8_t*)frame->get_frame_data(), image_roi, frame->get_bpp() / 8 * cols, &H[0]);
+    if (total_weight == 0)
+        return false;
 
     histogram_metric score = {};
     histogram_score(H, total_weight, score);
@@ -299,17 +328,88 @@ void auto_exposure_algorithm::update_roi(const region_of_interest& ae_roi)
     is_roi_initialized = true;
 }
 
-void auto_exposure_algorithm::im_hist(const uint8_t* data, const region_of_interest& image_roi, const int rowStep, int h[])
+// Counts 8 pixels, packed in a word, in 4 histograms: consecutive pixels are often of the same value, and
+// incrementing the same counter back to back stalls on the store of the one before
+static inline void count_pixels(uint32_t banks[4][256], uint64_t pixels)
+{
+    for (int b = 0; b < 8; ++b, pixels >>= 8)
+        ++banks[b & 3][pixels & 0xff];
+}
+
+int auto_exposure_algorithm::im_hist(const uint8_t* data, const region_of_interest& image_roi, const int rowStep, int h[])
 {
     std::lock_guard<std::recursive_mutex> lock(state_mutex);
 
-    for (int i = 0; i < 256; ++i)
-        h[i] = 0;
+    const int step = int(state.get_auto_exposure_sample_rate());
+    uint32_t banks[4][256] = {};
+    int count = 0;
 
     const uint8_t* rowData = data + (image_roi.min_y * rowStep);
-    for (int i = image_roi.min_y; i < image_roi.max_y; ++i, rowData += rowStep)
-        for (int j = image_roi.min_x; j < image_roi.max_x; j+=state.sample_rate)
-            ++h[rowData[j]];
+    for (int i = image_roi.min_y; i <= image_roi.max_y; i += step, rowData += step * rowStep)
+    {
+        const uint8_t* p = rowData + image_roi.min_x;
+        // The pixels of the row that are sampled
+        const int n = (image_roi.max_x - image_roi.min_x) / step + 1;
+        int j = 0;
+        // 16 sampled pixels at a time, picked out of 16 * step bytes: with a step, the last of these bytes is only
+        // there if the row has another sampled pixel after them
+        const int simd_end = n - (step > 1 ? 1 : 0);
+#if defined(__SSSE3__)
+        if (step == 1 || step == 2 || step == 4)
+        {
+            const __m128i low_byte = _mm_set1_epi16(0x00ff);
+            const __m128i low_byte_of_4 = _mm_set1_epi32(0x000000ff);
+            for (; j + 16 <= simd_end; j += 16, p += 16 * step)
+            {
+                __m128i v;
+                if (step == 1)
+                    v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                else if (step == 2)
+                    v = _mm_packus_epi16(
+                        _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), low_byte),
+                        _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)), low_byte));
+                else
+                {
+                    __m128i v0 = _mm_packs_epi32(
+                        _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), low_byte_of_4),
+                        _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)), low_byte_of_4));
+                    __m128i v1 = _mm_packs_epi32(
+                        _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32)), low_byte_of_4),
+                        _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)), low_byte_of_4));
+                    v = _mm_packus_epi16(v0, v1);
+                }
+                alignas(16) uint64_t lanes[2];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+                count_pixels(banks, lanes[0]);
+                count_pixels(banks, lanes[1]);
+            }
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        if (step == 1 || step == 2 || step == 4)
+        {
+            for (; j + 16 <= simd_end; j += 16, p += 16 * step)
+            {
+                uint8x16_t v;
+                if (step == 1)
+                    v = vld1q_u8(p);
+                else if (step == 2)
+                    v = vld2q_u8(p).val[0];
+                else
+                    v = vld4q_u8(p).val[0];
+                uint64x2_t lanes = vreinterpretq_u64_u8(v);
+                count_pixels(banks, vgetq_lane_u64(lanes, 0));
+                count_pixels(banks, vgetq_lane_u64(lanes, 1));
+            }
+        }
+#endif
+        for (; j < n; ++j, p += step)
+            ++banks[j & 3][*p];
+        count += n;
+    }
+
+    for (int i = 0; i < 256; ++i)
+        h[i] = int(banks[0][i] + banks[1][i] + banks[2][i] + banks[3][i]);
+    return count;
 }
 
 void auto_exposure_algorithm::increase_exposure_target(float mult, float& target_exposure)
@@ -576,11 +676,16 @@ rect_gaussian_dots_target_calculator::rect_gaussian_dots_target_calculator(int w
     _hwidth = _width >> 1;
     _hheight = _height >> 1;
 
-    _imgt.resize(_tsize2);
     _img.resize(_size);
+    _rows.resize(_height * _wt);
+    _correlation.resize(_ht * _wt);
+    _sum.resize((_width + 1) * (_height + 1));
+    _square_sum.resize(_sum.size());
     _ncc.resize(_size);
     memset(_ncc.data(), 0, _size * sizeof(double));
 
+    decompose_template();
+
     _buf.resize(_patch_size);
 }
 
@@ -594,7 +699,8 @@ bool rect_gaussian_dots_target_calculator::calculate(const uint8_t* img, float*
     if (target_dims_size < 4)
         return ret;
 
-    normalize(img);
+    if (!normalize(img))
+        return ret;
     calculate_ncc();
 
     if (find_corners())
@@ -618,7 +724,58 @@ bool rect_gaussian_dots_target_calculator::calculate(const uint8_t* img, float*
     return ret;
 }
 
-void rect_gaussian_dots_target_calculator::normalize(const uint8_t* img)
+void rect_gaussian_dots_target_calculator::decompose_template()
+{
+    // Power iterations, each term taken out of the template before looking for the next
+    std::vector<double> t(_template);
+    std::vector<double> x(_tsize), y(_tsize);
+    _template_factors.resize(_template_rank * _tsize);
+    for (int k = 0; k < _template_rank; ++k)
+    {
+        double length = 0.0;
+        for (int i = 0; i < _tsize; ++i)
+        {
+            x[i] = 1.0 + i;
+            length += x[i] * x[i];
+        }
+        for (int i = 0; i < _tsize; ++i)
+            x[i] /= sqrt(length);
+        double lambda = 0.0;
+        for (int it = 0; it < 100; ++it)
+        {
+            double norm = 0.0;
+            for (int i = 0; i < _tsize; ++i)
+            {
+                y[i] = 0.0;
+                for (int j = 0; j < _tsize; ++j)
+                    y[i] += t[i * _tsize + j] * x[j];
+                norm += y[i] * y[i];
+            }
+            norm = sqrt(norm);
+            if (norm == 0.0)
+                break;
+            lambda = 0.0;
+            for (int i = 0; i < _tsize; ++i)
+            {
+                lambda += x[i] * y[i];
+                x[i] = y[i] / norm;
+            }
+        }
+        _template_weights[k] = static_cast<float>(lambda);
+        for (int i = 0; i < _tsize; ++i)
+        {
+            _template_factors[k * _tsize + i] = static_cast<float>(x[i]);
+            for (int j = 0; j < _tsize; ++j)
+                t[i * _tsize + j] -= lambda * x[i] * x[j];
+        }
+    }
+
+    _template_sum = 0.0;
+    for (auto v : _template)
+        _template_sum += v;
+}
+
+bool rect_gaussian_dots_target_calculator::normalize(const uint8_t* img)
 {
     uint8_t min_val = 255;
     uint8_t max_val = 0;
@@ -627,7 +784,37 @@ void rect_gaussian_dots_target_calculator::normalize(const uint8_t* img)
     const uint8_t* p = img + _roi_start_y * _full_width + _roi_start_x;
     for (int j = 0; j < _height; ++j)
     {
-        for (int i = 0; i < _width; ++i)
+        int i = 0;
+#if defined(__SSSE3__)
+        __m128i vmin = _mm_set1_epi8(char(min_val));
+        __m128i vmax = _mm_set1_epi8(char(max_val));
+        for (; i + 16 <= _width; i += 16, p += 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            vmin = _mm_min_epu8(vmin, v);
+            vmax = _mm_max_epu8(vmax, v);
+        }
+        alignas(16) uint8_t lanes[2][16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes[0]), vmin);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes[1]), vmax);
+        for (int n = 0; n < 16; ++n)
+        {
+            min_val = std::min(min_val, lanes[0][n]);
+            max_val = std::max(max_val, lanes[1][n]);
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        uint8x16_t vmin = vdupq_n_u8(min_val);
+        uint8x16_t vmax = vdupq_n_u8(max_val);
+        for (; i + 16 <= _width; i += 16, p += 16)
+        {
+            uint8x16_t v = vld1q_u8(p);
+            vmin = vminq_u8(vmin, v);
+            vmax = vmaxq_u8(vmax, v);
+        }
+        min_val = vminvq_u8(vmin);
+        max_val = vmaxvq_u8(vmax);
+#endif
+        for (; i < _width; ++i)
         {
             if (*p < min_val)
                 min_val = *p;
@@ -641,35 +828,118 @@ void rect_gaussian_dots_target_calculator::normalize(const uint8_t* img)
         p += jumper;
     }
 
-    if (max_val > min_val)
-    {
-        double factor = 1.0 / (max_val - min_val);
+    if (max_val <= min_val)
+        return false;
 
-        p = img;
-        double* q = _img.data();
-        p = img + _roi_start_y * _full_width + _roi_start_x;
-        for (int j = 0; j < _height; ++j)
-        {
-            for (int i = 0; i < _width; ++i)
-                *q++ = 1.0f - (*p++ - min_val) * factor;
+    _min_val = min_val;
+    _factor = 1.0 / (max_val - min_val);
+    const float factor = static_cast<float>(_factor);
 
-            p += jumper;
+    float* q = _img.data();
+    p = img + _roi_start_y * _full_width + _roi_start_x;
+    const int iwidth = _width + 1;
+    uint32_t* s = _sum.data() + iwidth;
+    uint32_t* s2 = _square_sum.data() + iwidth;
+    for (int j = 0; j < _height; ++j)
+    {
+        int i = 0;
+#if defined(__SSSE3__)
+        const __m128i vmin = _mm_set1_epi8(char(min_val));
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 vfactor = _mm_set1_ps(factor);
+        for (; i + 16 <= _width; i += 16)
+        {
+            __m128i v = _mm_subs_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), vmin);
+            __m128i w[2] = { _mm_unpacklo_epi8(v, zero), _mm_unpackhi_epi8(v, zero) };
+            for (int n = 0; n < 4; ++n)
+            {
+                __m128i d = (n & 1) ? _mm_unpackhi_epi16(w[n >> 1], zero) : _mm_unpacklo_epi16(w[n >> 1], zero);
+                _mm_storeu_ps(q + i + 4 * n, _mm_sub_ps(one, _mm_mul_ps(_mm_cvtepi32_ps(d), vfactor)));
+            }
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        const uint8x16_t vmin = vdupq_n_u8(min_val);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        for (; i + 16 <= _width; i += 16)
+        {
+            uint8x16_t v = vsubq_u8(vld1q_u8(p + i), vmin);
+            uint16x8_t w[2] = { vmovl_u8(vget_low_u8(v)), vmovl_u8(vget_high_u8(v)) };
+            for (int n = 0; n < 4; ++n)
+            {
+                uint32x4_t d = (n & 1) ? vmovl_u16(vget_high_u16(w[n >> 1])) : vmovl_u16(vget_low_u16(w[n >> 1]));
+                vst1q_f32(q + i + 4 * n, vmlsq_n_f32(one, vcvtq_f32_u32(d), factor));
+            }
         }
+#endif
+        for (; i < _width; ++i)
+            q[i] = 1.0f - (p[i] - min_val) * factor;
+
+        // The integral images, left and top of the pixel
+        s[0] = s2[0] = 0;
+        uint32_t row = 0, row2 = 0;
+        for (i = 0; i < _width; ++i)
+        {
+            uint32_t d = p[i] - min_val;
+            row += d;
+            row2 += d * d;
+            s[i + 1] = s[i + 1 - iwidth] + row;
+            s2[i + 1] = s2[i + 1 - iwidth] + row2;
+        }
+
+        q += _width;
+        p += _full_width;
+        s += iwidth;
+        s2 += iwidth;
     }
+
+    return true;
 }
 
-void rect_gaussian_dots_target_calculator::calculate_ncc()
+// out[i] += k * in[i], for i in [0, count)
+static inline void multiply_add(float* out, const float* in, float k, int count)
 {
-    double* pncc = _ncc.data() + (_htsize * _width + _htsize);
-    double* pi = _img.data();
-    double* pit = _imgt.data();
+    int i = 0;
+#if defined(__SSSE3__)
+    const __m128 vk = _mm_set1_ps(k);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(in + i), vk)));
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(out + i, vmlaq_n_f32(vld1q_f32(out + i), vld1q_f32(in + i), k));
+#endif
+    for (; i < count; ++i)
+        out[i] += k * in[i];
+}
 
-    const double* pt = nullptr;
-    const double* qi = nullptr;
+void rect_gaussian_dots_target_calculator::calculate_ncc()
+{
+    // The correlation of each window of _img with the template, one separable term at a time
+    std::fill(_correlation.begin(), _correlation.end(), 0.0f);
+    for (int k = 0; k < _template_rank; ++k)
+    {
+        const float* u = _template_factors.data() + k * _tsize;
+        for (int j = 0; j < _height; ++j)
+        {
+            float* r = _rows.data() + j * _wt;
+            std::fill(r, r + _wt, 0.0f);
+            for (int n = 0; n < _tsize; ++n)
+                multiply_add(r, _img.data() + j * _width + n, u[n], _wt);
+        }
+        for (int j = 0; j < _ht; ++j)
+        {
+            float* c = _correlation.data() + j * _wt;
+            for (int m = 0; m < _tsize; ++m)
+                multiply_add(c, _rows.data() + (j + m) * _wt, _template_weights[k] * u[m], _wt);
+        }
+    }
 
-    double sum = 0.0;
-    double mean = 0.0;
-    double norm = 0.0;
+    double* pncc = _ncc.data() + (_htsize * _width + _htsize);
+    const float* pc = _correlation.data();
+    const int iwidth = _width + 1;
+    const uint32_t* s = _sum.data();
+    const uint32_t* s2 = _square_sum.data();
+    const int below = _tsize * iwidth;
 
     double min_val = 2.0;
     double max_val = -2.0;
@@ -679,53 +949,34 @@ void rect_gaussian_dots_target_calculator::calculate_ncc()
     {
         for (int i = 0; i < _wt; ++i)
         {
-            qi = pi;
-            sum = 0.0f;
-            for (int m = 0; m < _tsize; ++m)
+            // Sums of the pixels of the window less the ROI's minimum, and of their squares; the unsigned wrap
+            // around of the integral images cancels out
+            int a = j * iwidth + i;
+            uint32_t sum = s[a + below + _tsize] - s[a + below] - s[a + _tsize] + s[a];
+            uint32_t sum2 = s2[a + below + _tsize] - s2[a + below] - s2[a + _tsize] + s2[a];
+
+            // The pixels of _img are 1 - _factor * those: sum((img - mean)^2) = _factor^2 * spread / _tsize2
+            int64_t spread = int64_t(_tsize2) * sum2 - int64_t(sum) * sum;
+            if (spread == 0)
+                tmp = std::numeric_limits<double>::quiet_NaN();  // As the division by a zero norm made it: no peak
+            else
             {
-                for (int n = 0; n < _tsize; ++n)
-                    sum += *qi++;
-
-                qi += _wt;
-            }
+                double mean = 1.0 - _factor * sum / _tsize2;
+                double norm = _factor * sqrt(double(spread) / _tsize2);
+                tmp = (pc[i] - mean * _template_sum) / norm;
 
-            mean = sum / _tsize2;
+                if (tmp < min_val)
+                    min_val = tmp;
 
-            qi = pi;
-            sum = 0.0f;
-            pit = _imgt.data();
-            for (int m = 0; m < _tsize; ++m)
-            {
-                for (int n = 0; n < _tsize; ++n)
-                {
-                    *pit = *qi++ - mean;
-                    sum += *pit * *pit;
-                    ++pit;
-                }
-                qi += _wt;
+                if (tmp > max_val)
+                    max_val = tmp;
             }
 
-            norm = sqrt(sum);
-
-            pt = _template.data();
-            pit = _imgt.data();
-            sum = 0.0;
-            for (int k = 0; k < _tsize2; ++k)
-                sum += *pit++ * *pt++;
-
-            tmp = sum / norm;
-            if (tmp < min_val)
-                min_val = tmp;
-
-            if (tmp > max_val)
-                max_val = tmp;
-
             *pncc++ = tmp;
-            ++pi;
         }
 
         pncc += _tsize;
-        pi += _tsize;
+        pc += _wt;
     }
 
     if (max_val > min_val)
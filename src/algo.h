@@ -32,27 +32,32 @@ namespace librealsense
             is_auto_exposure(true),
             mode(auto_exposure_modes::auto_exposure_hybrid),
             rate(60),
-            step(ae_step_default_value)
+            step(ae_step_default_value),
+            sample_rate(1)
         {}
 
         bool get_enable_auto_exposure() const;
         auto_exposure_modes get_auto_exposure_mode() const;
         unsigned get_auto_exposure_antiflicker_rate() const;
         float get_auto_exposure_step() const;
+        unsigned get_auto_exposure_sample_rate() const;
 
         void set_enable_auto_exposure(bool value);
         void set_auto_exposure_mode(auto_exposure_modes value);
         void set_auto_exposure_antiflicker_rate(unsigned value);
         void set_auto_exposure_step(float value);
+        void set_auto_exposure_sample_rate(unsigned value);
 
-        static const unsigned      sample_rate = 1;
         static const unsigned      skip_frames = 2;
+        static const unsigned      max_skip_frames = 15;   // While the exposure stays converged
+        static const unsigned      max_sample_rate = 8;
 
     private:
         bool                is_auto_exposure;
         auto_exposure_modes mode;
         unsigned            rate;
         float               step;
+        unsigned            sample_rate;    // Every Nth pixel of every Nth row makes the histogram
     };
 
 
@@ -68,7 +73,8 @@ namespace librealsense
         struct histogram_metric { int under_exposure_count; int over_exposure_count; int shadow_limit; int highlight_limit; int lower_q; int upper_q; float main_mean; float main_std; };
         enum class rounding_mode_type { round, ceil, floor };
 
-        inline void im_hist(const uint8_t* data, const region_of_interest& image_roi, const int rowStep, int h[]);
+        // Returns the number of pixels counted
+        inline int im_hist(const uint8_t* data, const region_of_interest& image_roi, const int rowStep, int h[]);
         void increase_exposure_target(float mult, float& target_exposure);
         void decrease_exposure_target(float mult, float& target_exposure);
         void increase_exposure_gain(const float& target_exposure, const float& target_exposure0, float& exposure, float& gain);
@@ -167,8 +173,10 @@ namespace librealsense
         rect_gaussian_dots_target_calculator& operator=(const rect_gaussian_dots_target_calculator&&) = delete;
 
     protected:
-        void normalize(const uint8_t* img);
+        // False when the ROI is of one value, and has no target to find
+        bool normalize(const uint8_t* img);
         void calculate_ncc();
+        void decompose_template();
 
         bool find_corners();
         void refine_corners();
@@ -184,7 +192,6 @@ namespace librealsense
         const int _tsize = 28; // template size
         const int _htsize = _tsize >> 1;
         const int _tsize2 = _tsize * _tsize;
-        std::vector<double> _imgt;
 
         const std::vector<double> _template
         {
@@ -218,10 +225,25 @@ namespace librealsense
             -0.02855973, -0.02855973, -0.02841493, -0.02827013, -0.02798063, -0.02769113, -0.02740153, -0.02682253, -0.02624343, -0.02566433, -0.02508533, -0.02465103, -0.02421673, -0.02392713, -0.02378243, -0.02392713, -0.02421673, -0.02465103, -0.02508533, -0.02566433, -0.02624343, -0.02682253, -0.02740153, -0.02769113, -0.02798063, -0.02827013, -0.02841493, -0.02855973,
         };
 
+        // The template is symmetric and, to within 1e-4, a sum of 3 separable (outer product) terms: correlating with
+        // it is 3 passes along rows and 3 along columns, of _tsize taps each
+        static const int _template_rank = 3;
+        float _template_weights[_template_rank];
+        std::vector<float> _template_factors;       // _template_rank vectors of _tsize
+        double _template_sum = 0;
+
         const double _thresh = 0.7; // used internally, range from 0 to 1 for normalized image ma
         std::vector<double> _buf;
 
-        std::vector<double> _img;
+        std::vector<float> _img;
+        std::vector<float> _rows;                   // One pass along the rows of _img, for one template term
+        std::vector<float> _correlation;            // Of _img and the template, _ht rows of _wt
+        // Integral images of the ROI's pixels less its minimum, and of their squares: the window sums are exact, and
+        // the windows of one value are told apart as they were with the division by their zero norm
+        std::vector<uint32_t> _sum;
+        std::vector<uint32_t> _square_sum;
+        uint8_t _min_val = 0;
+        double _factor = 0;
         std::vector<double> _ncc;
         int _width = 0;
         int _height = 0;
@@ -2,9 +2,46 @@
 // Copyright(c) 2019 Intel Corporation. All Rights Reserved.
 
 #include <jni.h>
+#include <dlfcn.h>
+#include <cstring>
+#include <android/hardware_buffer.h>
+#include <android/rect.h>
 #include "error.h"
 #include "../../../include/librealsense2/rs.h"
 
+// The AHardwareBuffer functions are in API 26; we take them from libandroid at runtime, so the library can still be
+// loaded on older devices
+struct hardware_buffer_api {
+    AHardwareBuffer *(*from_hardware_buffer)(JNIEnv *, jobject) = nullptr;
+    void (*describe)(const AHardwareBuffer *, AHardwareBuffer_Desc *) = nullptr;
+    int (*lock)(AHardwareBuffer *, uint64_t, int32_t, const ARect *, void **) = nullptr;
+    int (*unlock)(AHardwareBuffer *, int32_t *) = nullptr;
+
+    hardware_buffer_api() {
+        if (auto lib = dlopen("libandroid.so", RTLD_NOW)) {
+            from_hardware_buffer = reinterpret_cast<decltype(from_hardware_buffer)>(dlsym(lib, "AHardwareBuffer_fromHardwareBuffer"));
+            describe = reinterpret_cast<decltype(describe)>(dlsym(lib, "AHardwareBuffer_describe"));
+            lock = reinterpret_cast<decltype(lock)>(dlsym(lib, "AHardwareBuffer_lock"));
+            unlock = reinterpret_cast<decltype(unlock)>(dlsym(lib, "AHardwareBuffer_unlock"));
+        }
+    }
+    bool available() const { return from_hardware_buffer && describe && lock && unlock; }
+};
+
+// The size of a pixel of the hardware buffer's format, or 0 when it's none we know of
+static uint32_t hardware_buffer_pixel_size(uint32_t format) {
+    switch (format) {
+        case AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM:
+        case AHARDWAREBUFFER_FORMAT_R8G8B8X8_UNORM:
+        case AHARDWAREBUFFER_FORMAT_R10G10B10A2_UNORM: return 4;
+        case AHARDWAREBUFFER_FORMAT_R8G8B8_UNORM: return 3;
+        case AHARDWAREBUFFER_FORMAT_R5G6B5_UNORM: return 2;
+        case AHARDWAREBUFFER_FORMAT_R16G16B16A16_FLOAT: return 8;
+        case AHARDWAREBUFFER_FORMAT_BLOB: return 1;
+        default: return 0;
+    }
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_intel_realsense_librealsense_Frame_nAddRef(JNIEnv *env, jclass type, jlong handle) {
     rs2_error *e = NULL;
@@ -47,6 +84,77 @@ Java_com_intel_realsense_librealsense_Frame_nGetData(JNIEnv *env, jclass type, j
     handle_error(env, e);
 }
 
+extern "C" JNIEXPORT jobject JNICALL
+Java_com_intel_realsense_librealsense_Frame_nGetDataBuffer(JNIEnv *env, jclass type, jlong handle) {
+    rs2_error *e = NULL;
+    auto frame = reinterpret_cast<const rs2_frame *>(handle);
+    int size = rs2_get_frame_data_size(frame, &e);
+    handle_error(env, e);
+    if (e)
+        return nullptr;
+    const void *data = rs2_get_frame_data(frame, &e);
+    handle_error(env, e);
+    if (e)
+        return nullptr;
+    // A view of the frame's own memory, which stays in the frame pool: nothing is copied or allocated
+    return env->NewDirectByteBuffer(const_cast<void *>(data), size);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_intel_realsense_librealsense_VideoFrame_nCopyToHardwareBuffer(JNIEnv *env, jclass type,
+                                                                       jlong handle, jobject buffer) {
+    static const hardware_buffer_api api;
+    if (!api.available()) {
+        env->ThrowNew(env->FindClass("java/lang/UnsupportedOperationException"),
+                      "AHardwareBuffer is not available on this device");
+        return;
+    }
+
+    rs2_error *e = NULL;
+    auto frame = reinterpret_cast<const rs2_frame *>(handle);
+    int width = rs2_get_frame_width(frame, &e);
+    int height = e ? 0 : rs2_get_frame_height(frame, &e);
+    int stride = e ? 0 : rs2_get_frame_stride_in_bytes(frame, &e);
+    int bpp = e ? 0 : rs2_get_frame_bits_per_pixel(frame, &e) / 8;
+    auto src = e ? nullptr : static_cast<const uint8_t *>(rs2_get_frame_data(frame, &e));
+    handle_error(env, e);
+    if (e)
+        return;
+
+    AHardwareBuffer *hb = api.from_hardware_buffer(env, buffer);
+    if (!hb) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"), "not a HardwareBuffer");
+        return;
+    }
+    AHardwareBuffer_Desc desc;
+    api.describe(hb, &desc);
+
+    // BLOB buffers take the data as it is; the others, row by row, in rows of the buffer's stride
+    const size_t row_size = size_t(width) * bpp;
+    uint32_t pixel_size = hardware_buffer_pixel_size(desc.format);
+    if (!pixel_size)
+        pixel_size = uint32_t(bpp);
+    const bool blob = desc.format == AHARDWAREBUFFER_FORMAT_BLOB;
+    const bool fits = blob ? desc.width >= size_t(stride) * height
+                           : desc.height >= uint32_t(height) && size_t(desc.stride) * pixel_size >= row_size;
+    if (!fits) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"), "the HardwareBuffer is too small for the frame");
+        return;
+    }
+
+    void *dst = nullptr;
+    if (api.lock(hb, AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN, -1, nullptr, &dst) || !dst) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalStateException"), "failed to lock the HardwareBuffer");
+        return;
+    }
+    if (blob)
+        memcpy(dst, src, size_t(stride) * height);
+    else
+        for (int y = 0; y < height; ++y)
+            memcpy(static_cast<uint8_t *>(dst) + size_t(y) * desc.stride * pixel_size, src + size_t(y) * stride, row_size);
+    api.unlock(hb, nullptr);
+}
+
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_intel_realsense_librealsense_Points_nGetData(JNIEnv *env, jclass type, jlong handle,
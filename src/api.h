@@ -8,6 +8,7 @@
 #include <rsutils/subscription.h>
 #include "pose.h"
 #include "librealsense-exception.h"
+#include "log.h"
 
 #include <librealsense2/rs.h>
 #include <type_traits>
@@ -399,6 +400,23 @@ try {\
 return __p.invoke(func);\
 } catch(...) { librealsense::translate_exception(__FUNCTION__, "", error); __api_logger.report_error(); return R; } } }
 
+// For the trivial accessors that are called several times per frame: the API logger, and everything it costs, is
+// only there while what it logs goes somewhere
+#define BEGIN_FAST_API_CALL { auto func = [&](){
+
+#define FAST_API_RETURN(R, ...) };\
+if( librealsense::is_logging( RS2_LOG_SEVERITY_INFO ) ) {\
+api_logger __api_logger(__FUNCTION__);\
+result_printer<decltype(fetch_return_type(func, &decltype(func)::operator()))> __p(&__api_logger);\
+__api_logger.set_params([&](){ std::ostringstream ss; librealsense::stream_args(ss, #__VA_ARGS__, __VA_ARGS__); return ss.str(); });\
+try {\
+return __p.invoke(func);\
+} catch(...) {\
+librealsense::translate_exception(__FUNCTION__, __api_logger.get_params(), error); __api_logger.report_error(); return R; } }\
+try {\
+return func();\
+} catch(...) { std::ostringstream ss; librealsense::stream_args(ss, #__VA_ARGS__, __VA_ARGS__); librealsense::translate_exception(__FUNCTION__, ss.str(), error); return R; } }
+
 #else // No API tracing:
 
 #define BEGIN_API_CALL try
@@ -406,6 +424,8 @@ return __p.invoke(func);\
 #define HANDLE_EXCEPTIONS_AND_RETURN(R, ...) catch(...) { std::ostringstream ss; librealsense::stream_args(ss, #__VA_ARGS__, __VA_ARGS__); librealsense::translate_exception(__FUNCTION__, ss.str(), error); return R; }
 #define NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(R) catch(...) { librealsense::translate_exception(__FUNCTION__, "", error); return R; }
 #define NOARGS_HANDLE_EXCEPTIONS_AND_RETURN_VOID() catch(...) { librealsense::translate_exception(__FUNCTION__, "", error); }
+#define BEGIN_FAST_API_CALL BEGIN_API_CALL
+#define FAST_API_RETURN HANDLE_EXCEPTIONS_AND_RETURN
 
 #endif
 
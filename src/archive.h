@@ -11,6 +11,8 @@ namespace librealsense
 {
     class frame_interface;
     class sensor_interface;
+    struct frame_pool_stats;
+    class frame_allocator;
 
     class archive_interface
     {
@@ -23,17 +25,21 @@ namespace librealsense
 
         virtual std::shared_ptr< sensor_interface > get_sensor() const = 0;
         virtual void set_sensor( const std::weak_ptr< sensor_interface > & ) = 0;
+        virtual void set_frame_allocator( const std::shared_ptr< frame_allocator > & ) = 0;
 
         virtual void flush() = 0;
 
         virtual frame_interface* publish_frame(frame_interface* frame) = 0;
         virtual void unpublish_frame(frame_interface* frame) = 0;
         virtual void keep_frame(frame_interface* frame) = 0;
+        // Frames given out and not yet returned
+        virtual uint32_t get_published_count() const = 0;
         virtual ~archive_interface() = default;
     };
 
     std::shared_ptr<archive_interface> make_archive(rs2_extension type,
         std::atomic<uint32_t>* in_max_frame_queue_size,
-        std::shared_ptr<metadata_parser_map> parsers);
+        std::shared_ptr<metadata_parser_map> parsers,
+        std::shared_ptr<frame_pool_stats> pool_stats = nullptr);
 
 }
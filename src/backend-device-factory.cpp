@@ -19,6 +19,7 @@
 #include <rsutils/shared-ptr-singleton.h>
 #include <rsutils/signal.h>
 #include <rsutils/json.h>
+#include <rsutils/time/stopwatch.h>
 
 
 namespace librealsense {
@@ -179,9 +180,13 @@ std::vector< std::shared_ptr< device_info > > backend_device_factory::query_devi
         return {};  // We don't carry any software devices
 
     auto backend = _device_watcher->get_backend();
+    rsutils::time::stopwatch sw;
     platform::backend_device_group group( backend->query_uvc_devices(),
                                           backend->query_usb_devices(),
                                           backend->query_hid_devices() );
+    LOG_DEBUG( "backend devices queried in " << sw.get_elapsed_ms() << " ms: " << group.uvc_devices.size()
+                                             << " UVC, " << group.usb_devices.size() << " USB, "
+                                             << group.hid_devices.size() << " HID" );
     auto devices = create_devices_from_group( group, requested_mask );
     return { devices.begin(), devices.end() };
 }
@@ -53,8 +53,9 @@ std::ostream & operator<<( std::ostream & os, guid const & g )
 
 double monotonic_to_realtime(double monotonic)
 {
-    auto realtime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-    auto time_since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    // In fractions of ms: the driver timestamps are in usec, and are compared with the system time of the frames
+    auto realtime = std::chrono::duration< double, std::milli >( std::chrono::system_clock::now().time_since_epoch() ).count();
+    auto time_since_epoch = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now().time_since_epoch() ).count();
     return monotonic + (realtime - time_since_epoch);
 }
 
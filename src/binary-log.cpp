@@ -0,0 +1,214 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "binary-log.h"
+
+#include <rsutils/concurrency/concurrency.h>
+#include <rsutils/os/thread.h>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace librealsense {
+namespace binary_log {
+
+
+namespace detail {
+std::atomic< int > min_severity( RS2_LOG_SEVERITY_NONE );
+}
+
+
+namespace {
+
+
+std::mutex sites_mutex;
+std::vector< site * > sites;  // By id - 1; sites are static, so these never go away
+
+
+// Drains the ring into the file, on a thread of its own
+class file_sink
+{
+    lock_free_queue< record > _queue;
+    std::atomic< uint64_t > _dropped{ 0 };
+    std::ofstream _file;
+    std::vector< bool > _written;  // The sites already in the file
+    std::atomic< bool > _stopping{ false };
+    std::thread _thread;
+
+    template< class T >
+    void out( T const & v )
+    {
+        _file.write( reinterpret_cast< char const * >( &v ), sizeof( v ) );
+    }
+    void out_string( char const * s )
+    {
+        auto n = uint16_t( std::min< size_t >( strlen( s ), 0xffff ) );
+        out( n );
+        _file.write( s, n );
+    }
+
+    void out_site( uint32_t id )
+    {
+        if( _written.size() < id )
+            _written.resize( id, false );
+        if( _written[id - 1] )
+            return;
+        site * s;
+        {
+            std::lock_guard< std::mutex > lock( sites_mutex );
+            s = sites[id - 1];
+        }
+        out( 'S' );
+        out( id );
+        out( uint8_t( s->severity ) );
+        out( uint32_t( s->line ) );
+        out_string( s->file );
+        out_string( s->format );
+        _written[id - 1] = true;
+    }
+
+    void out_record( record const & r )
+    {
+        out_site( r.site );
+        out( 'M' );
+        out( r.site );
+        out( r.time_ns );
+        out( r.thread );
+        out( r.size );
+        _file.write( reinterpret_cast< char const * >( r.data ), r.size );
+    }
+
+    void drain()
+    {
+        rsutils::os::init_thread( "binary-log" );
+        std::vector< record > batch( 64 );
+        while( true )
+        {
+            auto n = _queue.try_dequeue_batch( batch.data(), batch.size() );
+            if( auto dropped = _dropped.exchange( 0 ) )
+            {
+                out( 'D' );
+                out( dropped );
+            }
+            for( size_t i = 0; i < n; ++i )
+                out_record( batch[i] );
+            if( n )
+                continue;
+            if( _stopping )
+                break;
+            // Nothing for now: whatever's there should be in the file, should we go down
+            _file.flush();
+            if( _queue.dequeue( batch.data(), 100 ) )
+                out_record( batch[0] );
+        }
+        _file.flush();
+    }
+
+public:
+    file_sink( char const * path )
+        : _queue( 16384, [this]( record const & ) { ++_dropped; } )
+        , _file( path, std::ios::binary | std::ios::trunc )
+    {
+        if( ! _file )
+            throw std::runtime_error( std::string( "failed to open binary log file: " ) + path );
+
+        static char const magic[8] = { 'R', 'S', '2', 'B', 'L', 'O', 'G', 0 };
+        _file.write( magic, sizeof( magic ) );
+        out( file_version );
+        out( int64_t( std::chrono::duration_cast< std::chrono::nanoseconds >(
+                          std::chrono::system_clock::now().time_since_epoch() ).count() ) );
+        out( int64_t( std::chrono::duration_cast< std::chrono::nanoseconds >(
+                          std::chrono::steady_clock::now().time_since_epoch() ).count() ) );
+
+        _thread = std::thread( [this]() { drain(); } );
+    }
+
+    ~file_sink()
+    {
+        _stopping = true;
+        _thread.join();
+    }
+
+    void push( record & r ) { _queue.enqueue( std::move( r ) ); }
+};
+
+
+// Replaced as a whole when the file changes; messages already on their way to the old one may still get there
+std::mutex sink_mutex;
+std::shared_ptr< file_sink > the_sink;
+
+
+uint32_t site_id( site & s, char const * format )
+{
+    auto id = s.id.load( std::memory_order_acquire );
+    if( id )
+        return id;
+    std::lock_guard< std::mutex > lock( sites_mutex );
+    id = s.id.load( std::memory_order_relaxed );
+    if( ! id )
+    {
+        s.format = format;
+        sites.push_back( &s );
+        id = uint32_t( sites.size() );
+        s.id.store( id, std::memory_order_release );
+    }
+    return id;
+}
+
+
+uint32_t this_thread_id()
+{
+    static thread_local uint32_t const id = uint32_t( std::hash< std::thread::id >()( std::this_thread::get_id() ) );
+    return id;
+}
+
+
+}  // namespace
+
+
+void log_to_file( rs2_log_severity min_severity, char const * path )
+{
+    std::shared_ptr< file_sink > sink;
+    if( min_severity < RS2_LOG_SEVERITY_NONE )
+    {
+        if( ! path )
+            throw std::runtime_error( "null binary log file path" );
+        sink = std::make_shared< file_sink >( path );
+    }
+    std::shared_ptr< file_sink > old;
+    {
+        std::lock_guard< std::mutex > lock( sink_mutex );
+        old = std::move( the_sink );
+        the_sink = std::move( sink );
+        detail::min_severity = the_sink ? min_severity : RS2_LOG_SEVERITY_NONE;
+    }
+    // The old one finishes writing what it has outside the lock
+}
+
+
+void write_record( site & s, char const * format, record & r )
+{
+    r.site = site_id( s, format );
+    r.thread = this_thread_id();
+    r.time_ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+                    std::chrono::steady_clock::now().time_since_epoch() ).count();
+
+    // Only takes a reference with the lock: the queue itself is lock-free
+    std::shared_ptr< file_sink > sink;
+    {
+        std::lock_guard< std::mutex > lock( sink_mutex );
+        sink = the_sink;
+    }
+    if( sink )
+        sink->push( r );
+}
+
+
+}  // namespace binary_log
+}  // namespace librealsense
@@ -0,0 +1,183 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <librealsense2/h/rs_types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+
+namespace librealsense {
+namespace binary_log {
+
+
+// A binary log: messages are recorded as their call site and their arguments, as they are, into a lock-free ring;
+// a thread of its own writes them to a file. They're only put into words when the file is decoded (see
+// tools/binary-log-decoder), so logging from the paths that see every frame costs next to nothing.
+//
+// For LOG_DEBUG_FMT and the likes (see log.h): the format has a {} for each argument. Numbers, strings and pointers
+// are recorded as they are; anything else is streamed into a string on the spot.
+//
+// The file, in the host's byte order:
+//     header:  "RS2BLOG\0", u32 version, i64 system-clock ns and i64 steady-clock ns, both at the start
+//     records: u8 kind, then
+//         'S' (a site, before its first message): u32 id, u8 severity, u32 line, u16 size + file, u16 size + format
+//         'M' (a message): u32 site id, i64 steady-clock ns, u32 thread, u16 size + arguments
+//         'D' (messages lost since the last): u64 count
+//     arguments: u8 type, then 'i' i64, 'u' u64, 'f' double, 'c' char, 'p' u64, or 's' u16 size + characters
+//
+static const uint32_t file_version = 1;
+
+
+// Where messages are logged from: one per LOG_*_FMT, made an id when it's first logged from
+struct site
+{
+    rs2_log_severity const severity;
+    char const * const file;
+    int const line;
+    char const * format = nullptr;
+    std::atomic< uint32_t > id{ 0 };
+
+    site( rs2_log_severity severity_, char const * file_, int line_ )
+        : severity( severity_ ), file( file_ ), line( line_ ) {}
+};
+
+
+// Starts writing messages of 'min_severity' and up to the file, instead of whatever file there was; NONE stops it
+void log_to_file( rs2_log_severity min_severity, char const * path );
+
+namespace detail {
+extern std::atomic< int > min_severity;
+}
+
+// Cheap: for the macros
+inline bool is_logging( rs2_log_severity severity )
+{
+    return severity >= detail::min_severity.load( std::memory_order_relaxed );
+}
+
+
+// A message, as it's recorded
+struct record
+{
+    static size_t const max_size = 232;
+
+    uint32_t site = 0;
+    uint32_t thread = 0;
+    int64_t time_ns = 0;
+    uint16_t size = 0;
+    uint8_t data[max_size];
+
+    void put( char type, void const * p, size_t n )
+    {
+        if( size + 1 + n > max_size )
+            return;  // Truncated: the decoder shows what's missing with the format
+        data[size++] = uint8_t( type );
+        memcpy( data + size, p, n );
+        size += uint16_t( n );
+    }
+    void put_string( char const * s, size_t n )
+    {
+        if( size + 3 > max_size )
+            return;
+        n = std::min( n, max_size - size - 3 );
+        uint16_t n16 = uint16_t( n );
+        data[size++] = 's';
+        memcpy( data + size, &n16, 2 );
+        memcpy( data + size + 2, s, n );
+        size += uint16_t( 2 + n );
+    }
+
+    template< class T >
+    typename std::enable_if< std::is_integral< T >::value && std::is_signed< T >::value >::type add( T v )
+    {
+        int64_t i = v;
+        put( 'i', &i, sizeof( i ) );
+    }
+    template< class T >
+    typename std::enable_if< std::is_integral< T >::value && ! std::is_signed< T >::value >::type add( T v )
+    {
+        uint64_t u = v;
+        put( 'u', &u, sizeof( u ) );
+    }
+    template< class T >
+    typename std::enable_if< std::is_floating_point< T >::value >::type add( T v )
+    {
+        double d = v;
+        put( 'f', &d, sizeof( d ) );
+    }
+    template< class T >
+    typename std::enable_if< ! std::is_arithmetic< T >::value >::type add( T const & v )
+    {
+        std::ostringstream ss;
+        ss << v;
+        add( ss.str() );
+    }
+    void add( bool v ) { add( int( v ) ); }
+    void add( char v ) { put( 'c', &v, 1 ); }
+    void add( char const * s ) { put_string( s, s ? strlen( s ) : 0 ); }
+    void add( char * s ) { add( (char const *)s ); }
+    void add( std::string const & s ) { put_string( s.data(), s.size() ); }
+    void add( void const * p )
+    {
+        uint64_t u = reinterpret_cast< uintptr_t >( p );
+        put( 'p', &u, sizeof( u ) );
+    }
+};
+
+
+void write_record( site &, char const * format, record & );
+
+
+inline void add_all( record & ) {}
+template< class T, class... Args >
+void add_all( record & r, T const & v, Args const &... args )
+{
+    r.add( v );
+    add_all( r, args... );
+}
+
+template< class... Args >
+void write( site & s, char const * format, Args const &... args )
+{
+    record r;
+    add_all( r, args... );
+    write_record( s, format, r );
+}
+
+
+// For when the message is needed now, for the other logs: the {} replaced with the arguments as streamed
+inline void format_to( std::ostream & os, char const * format )
+{
+    os << format;
+}
+template< class T, class... Args >
+void format_to( std::ostream & os, char const * format, T const & v, Args const &... args )
+{
+    auto placeholder = strstr( format, "{}" );
+    if( ! placeholder )
+    {
+        os << format;
+        return;
+    }
+    os.write( format, placeholder - format );
+    os << v;
+    format_to( os, placeholder + 2, args... );
+}
+template< class... Args >
+std::string format( char const * format, Args const &... args )
+{
+    std::ostringstream ss;
+    format_to( ss, format, args... );
+    return ss.str();
+}
+
+
+}  // namespace binary_log
+}  // namespace librealsense
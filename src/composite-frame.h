@@ -6,21 +6,35 @@
 #include "frame.h"
 
 namespace librealsense {
+// The embedded frames are kept inline, up to INLINE_FRAMES of them, so that with the archive reusing the composite
+// frames themselves, typical framesets need no allocation; bigger ones go in the frame data.
 class composite_frame : public frame
 {
 public:
+    static constexpr size_t INLINE_FRAMES = 8;
+
     composite_frame()
         : frame()
     {
     }
 
+    // Sets whether the frames are inline or in 'data', which would then have to be big enough for them
+    void set_embedded_frames_count( size_t count )
+    {
+        _n_frames = count;
+        _inline = count <= INLINE_FRAMES;
+    }
+
     frame_interface * get_frame( int i ) const
     {
         auto frames = get_frames();
         return frames[i];
     }
 
-    frame_interface ** get_frames() const { return (frame_interface **)data.data(); }
+    frame_interface ** get_frames() const
+    {
+        return _inline ? const_cast< frame_interface ** >( _inline_frames ) : (frame_interface **)data.data();
+    }
 
     const frame_interface * first() const { return get_frame( 0 ); }
     frame_interface * first() { return get_frame( 0 ); }
@@ -34,7 +48,7 @@ public:
         frame::keep();
     }
 
-    size_t get_embedded_frames_count() const { return data.size() / sizeof( rs2_frame * ); }
+    size_t get_embedded_frames_count() const { return _n_frames; }
 
     // In the next section we make the composite frame "look and feel" like the first of its
     // children
@@ -62,6 +76,11 @@ public:
     {
         return first()->get_sensor();
     }
+
+private:
+    frame_interface * _inline_frames[INLINE_FRAMES] = {};
+    size_t _n_frames = 0;
+    bool _inline = true;
 };
 
 MAP_EXTENSION( RS2_EXTENSION_COMPOSITE_FRAME, librealsense::composite_frame );
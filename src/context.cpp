@@ -9,6 +9,18 @@
 #include "dds/rsdds-device-factory.h"
 #endif
 #include "rscore-pp-block-factory.h"
+#include "proc/processing-thread-pool.h"
+#include "low-latency.h"
+#include "memory-stats.h"
+#ifdef RS2_USE_CUDA
+#include "cuda/cuda-device.h"
+#endif
+#ifdef RS2_USE_VULKAN
+#include "vulkan/vulkan-device.h"
+#endif
+#ifdef RS2_USE_OPENCL
+#include "opencl/opencl-device.h"
+#endif
 
 #include <librealsense2/hpp/rs_types.hpp>  // rs2_devices_changed_callback
 #include <librealsense2/rs.h>              // RS2_API_FULL_VERSION_STR
@@ -16,9 +28,14 @@
 
 #include <rsutils/os/special-folder.h>
 #include <rsutils/os/executable-name.h>
+#include <rsutils/os/thread.h>
 #include <rsutils/easylogging/easyloggingpp.h>
 #include <rsutils/string/from.h>
 #include <rsutils/json.h>
+#include <rsutils/time/stopwatch.h>
+
+#include <atomic>
+#include <thread>
 #include <rsutils/json-config.h>
 using json = rsutils::json;
 
@@ -47,7 +64,30 @@ namespace librealsense {
     context::context( json const & settings )
         : _settings( load_settings( settings ) )  // global | application | local
         , _device_mask( _settings.nested( "device-mask" ).default_value< unsigned >( RS2_PRODUCT_LINE_ANY ) )
+        , _factories_created( false )
     {
+        // Before any of our threads get started
+        if( auto thread_settings = _settings.nested( "threads" ) )
+            rsutils::os::configure_threads( thread_settings );
+        if( auto pool_settings = _settings.nested( "thread-pool" ) )
+            processing_thread_pool::configure( pool_settings );
+        if( auto low_latency = _settings.nested( "low-latency" ) )
+            low_latency_settings::configure( low_latency );
+        if( auto mb = _settings.nested( "memory-budget-mb" ).default_value( 0u ) )
+            _memory_budget = std::make_shared< memory_budget >( uint64_t( mb ) << 20 );
+#ifdef RS2_USE_CUDA
+        if( auto cuda_settings = _settings.nested( "cuda" ) )
+            cuda::configure( cuda_settings );
+#endif
+#ifdef RS2_USE_VULKAN
+        if( auto vulkan_settings = _settings.nested( "vulkan" ) )
+            vulkan::configure( vulkan_settings );
+#endif
+#ifdef RS2_USE_OPENCL
+        if( auto opencl_settings = _settings.nested( "opencl" ) )
+            opencl::configure( opencl_settings );
+#endif
+
         static bool version_logged = false;
         if( ! version_logged )
         {
@@ -72,13 +112,30 @@ namespace librealsense {
                     std::vector< std::shared_ptr< device_info > > const & added )
             { invoke_devices_changed_callbacks( removed, added ); } ) );
 #endif
+        _factories_created = true;
+    }
+
+
+    void context::ensure_factories() const
+    {
+        std::lock_guard< std::mutex > lock( _factories_mutex );
+        if( _factories_created )
+            return;
+        auto sptr = _self.lock();
+        if( ! sptr )
+            return;  // Being destroyed
+        LOG_DEBUG( "starting device factories" );
+        const_cast< context * >( this )->create_factories( sptr );
     }
 
 
     /*static*/ std::shared_ptr< context > context::make( json const & settings )
     {
         std::shared_ptr< context > sptr( new context( settings ) );
-        sptr->create_factories( sptr );
+        sptr->_self = sptr;
+        // Playback and software devices need no backend, so a lazy context doesn't start it until asked for others
+        if( ! sptr->_settings.nested( "lazy-backend" ).default_value( false ) )
+            sptr->create_factories( sptr );
         return sptr;
     }
 
@@ -109,13 +166,24 @@ namespace librealsense {
     std::vector< std::shared_ptr< device_info > > context::query_devices( int requested_mask ) const
     {
         std::vector< std::shared_ptr< device_info > > list;
-        for( auto & factory : _factories )
+        // A mask of only software devices (with no product line of them) has nothing to find in the factories
+        if( combine_device_masks( requested_mask, get_device_mask() ) & RS2_PRODUCT_LINE_ANY )
+            ensure_factories();
+        std::vector< std::shared_ptr< device_factory > > factories;
+        {
+            std::lock_guard< std::mutex > lock( _factories_mutex );
+            factories = _factories;
+        }
+        for( auto & factory : factories )
         {
+            rsutils::time::stopwatch sw;
+            auto const n_before = list.size();
             for( auto & dev_info : factory->query_devices( requested_mask ) )
             {
                 LOG_INFO( "... " << dev_info->get_address() );
                 list.push_back( dev_info );
             }
+            LOG_DEBUG( "... " << ( list.size() - n_before ) << " devices queried in " << sw.get_elapsed_ms() << " ms" );
         }
         for( auto & item : _user_devices )
         {
@@ -131,6 +199,49 @@ namespace librealsense {
     }
 
 
+    std::vector< std::shared_ptr< device_interface > >
+    context::create_devices( std::vector< std::shared_ptr< device_info > > const & infos ) const
+    {
+        rsutils::time::stopwatch total;
+        std::vector< std::shared_ptr< device_interface > > devices( infos.size() );
+        std::vector< std::exception_ptr > errors( infos.size() );
+        std::atomic< size_t > next( 0 );
+        auto worker = [&]()
+        {
+            for( size_t i; ( i = next++ ) < infos.size(); )
+            {
+                rsutils::time::stopwatch sw;
+                try
+                {
+                    devices[i] = infos[i]->create_device();
+                }
+                catch( ... )
+                {
+                    errors[i] = std::current_exception();
+                }
+                LOG_INFO( "... " << infos[i]->get_address() << ( errors[i] ? " failed after " : " created in " )
+                                 << sw.get_elapsed_ms() << " ms" );
+            }
+        };
+
+        size_t max_threads = _settings.nested( "device-creation", "threads" ).default_value< size_t >( 4 );
+        auto const n_threads = std::min( infos.size(), std::max( max_threads, size_t( 1 ) ) );
+        std::vector< std::thread > threads;
+        for( size_t t = 1; t < n_threads; ++t )
+            threads.emplace_back( worker );
+        worker();
+        for( auto & thread : threads )
+            thread.join();
+        LOG_INFO( "Created " << infos.size() << " devices in " << total.get_elapsed_ms() << " ms (" << n_threads
+                             << " threads)" );
+
+        for( auto & error : errors )
+            if( error )
+                std::rethrow_exception( error );
+        return devices;
+    }
+
+
     void context::invoke_devices_changed_callbacks(
         std::vector< std::shared_ptr< device_info > > const & rs2_devices_info_removed,
         std::vector< std::shared_ptr< device_info > > const & rs2_devices_info_added )
@@ -141,6 +252,8 @@ namespace librealsense {
 
     rsutils::subscription context::on_device_changes( devices_changed_callback && callback )
     {
+        // Changes can only be seen once the device watchers are running
+        ensure_factories();
         return _devices_changed.subscribe( std::move( callback ) );
     }
 
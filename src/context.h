@@ -6,13 +6,16 @@
 #include <rsutils/json.h>
 #include <vector>
 #include <map>
+#include <mutex>
 
 
 namespace librealsense
 {
     class device_factory;
     class device_info;
+    class device_interface;
     class processing_block_interface;
+    class memory_budget;
 
 
     class context
@@ -20,6 +23,9 @@ namespace librealsense
         context( rsutils::json const & );  // private! use make()
 
         void create_factories( std::shared_ptr< context > const & sptr );
+        // With "lazy-backend" in the settings, the factories (and the device watchers and DDS participants they
+        // start) are only created once devices are first queried for, or changes subscribed to
+        void ensure_factories() const;
 
     public:
         static std::shared_ptr< context > make( rsutils::json const & );
@@ -47,6 +53,13 @@ namespace librealsense
         //
         std::vector< std::shared_ptr< device_info > > query_devices( int mask ) const;
 
+        // Create devices from several device-infos at once. Devices spend most of their creation waiting on their own
+        // firmware, so they're created concurrently, up to the "device-creation/threads" setting at a time (default
+        // 4). If any fails, the first failure is thrown once they're all done.
+        //
+        std::vector< std::shared_ptr< device_interface > >
+        create_devices( std::vector< std::shared_ptr< device_info > > const & ) const;
+
         using devices_changed_callback
             = std::function< void( std::vector< std::shared_ptr< device_info > > const & devices_removed,
                                    std::vector< std::shared_ptr< device_info > > const & devices_added ) >;
@@ -62,6 +75,9 @@ namespace librealsense
 
         const rsutils::json & get_settings() const { return _settings; }
 
+        // From the "memory-budget-mb" setting; null without one (or with 0), for no limit
+        std::shared_ptr< memory_budget > const & get_memory_budget() const { return _memory_budget; }
+
         // Create processing blocks given a name and settings.
         //
         std::shared_ptr< processing_block_interface > create_pp_block( std::string const & name,
@@ -79,8 +95,13 @@ namespace librealsense
 
         rsutils::json _settings; // Save operation settings
         unsigned const _device_mask;
+        std::shared_ptr< memory_budget > _memory_budget;
 
-        std::vector< std::shared_ptr< device_factory > > _factories;
+        // Created by make(), or by ensure_factories() when lazy
+        mutable std::vector< std::shared_ptr< device_factory > > _factories;
+        mutable std::mutex _factories_mutex;
+        mutable bool _factories_created;
+        std::weak_ptr< context > _self;  // For ensure_factories()
     };
 
 }
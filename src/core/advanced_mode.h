@@ -142,6 +142,8 @@ namespace librealsense
 
         std::vector<uint8_t> serialize_json() const override;
         void load_json(const std::string& json_content) override;
+        std::vector<uint8_t> serialize_snapshot() const override;
+        void load_snapshot(const std::vector<uint8_t>& snapshot) override;
 
         void register_to_visual_preset_option();
         void unregister_from_visual_preset_option();
@@ -211,12 +213,26 @@ namespace librealsense
         std::string _block_message;
 
         preset get_all() const;
-        void set_all( const preset & p );
-        void set_all_depth( const preset & p );
-        void set_all_rgb( const preset & p );
+        // With the current values of the device, only the groups and controls that differ from them are written
+        void set_all( const preset & p, const preset * current = nullptr );
+        void set_all_depth( const preset & p, const preset * current );
+        void set_all_rgb( const preset & p, const preset * current );
         bool should_set_rgb_preset() const;
 
         std::vector<uint8_t> send_receive(const std::vector<uint8_t>& input) const;
+        std::vector< std::vector< uint8_t > > send_receive( const std::vector< std::vector< uint8_t > > & batch,
+                                                            std::chrono::milliseconds delay ) const;
+
+        // The FW needs a little time after each SET_ADV
+        static constexpr std::chrono::milliseconds set_delay() { return std::chrono::milliseconds( 20 ); }
+
+        template<class T>
+        std::vector<uint8_t> encode_set(const T& strct, EtAdvancedModeRegGroup cmd) const
+        {
+            auto ptr = (uint8_t*)(&strct);
+            std::vector<uint8_t> data(ptr, ptr + sizeof(T));
+            return encode_command(ds::fw_cmd::SET_ADV, static_cast<uint32_t>(cmd), 0, 0, 0, data);
+        }
 
         template<class T>
         void set(const T& strct, EtAdvancedModeRegGroup cmd) const
@@ -224,27 +240,29 @@ namespace librealsense
             if( _blocked )
                 throw std::runtime_error( _block_message );
 
-            auto ptr = (uint8_t*)(&strct);
-            std::vector<uint8_t> data(ptr, ptr + sizeof(T));
-
-            assert_no_error(ds::fw_cmd::SET_ADV,
-                send_receive(encode_command(ds::fw_cmd::SET_ADV, static_cast<uint32_t>(cmd), 0, 0, 0, data)));
-            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            assert_no_error(ds::fw_cmd::SET_ADV, send_receive(encode_set(strct, cmd)));
+            std::this_thread::sleep_for(set_delay());
         }
 
+        // Several SET_ADV commands (from encode_set) in one batch, in order
+        void set( const std::vector< std::vector< uint8_t > > & batch ) const;
+
         template<class T>
-        T get(EtAdvancedModeRegGroup cmd, T* ptr = static_cast<T*>(nullptr), int mode = 0) const
+        static T decode_get(const std::vector<uint8_t>& results)
         {
-            T res;
-            auto data = assert_no_error(ds::fw_cmd::GET_ADV,
-                send_receive(encode_command(ds::fw_cmd::GET_ADV,
-                static_cast<uint32_t>(cmd), mode)));
+            auto data = assert_no_error(ds::fw_cmd::GET_ADV, results);
             if (data.size() < sizeof(T))
             {
                 throw std::runtime_error("The camera returned invalid sized result!");
             }
-            res = *reinterpret_cast<T*>(data.data());
-            return res;
+            return *reinterpret_cast<T*>(data.data());
+        }
+
+        template<class T>
+        T get(EtAdvancedModeRegGroup cmd, T* ptr = static_cast<T*>(nullptr), int mode = 0) const
+        {
+            return decode_get<T>(send_receive(encode_command(ds::fw_cmd::GET_ADV,
+                static_cast<uint32_t>(cmd), mode)));
         }
 
         static uint32_t pack(uint8_t c0, uint8_t c1, uint8_t c2, uint8_t c3);
@@ -7,6 +7,8 @@
 #include <map>
 #include <memory>
 #include <array>
+#include <bitset>
+#include <atomic>
 #include <cstring>  // memcpy
 
 
@@ -50,6 +52,49 @@ static_assert( sizeof( metadata_array_value ) == sizeof( rs2_metadata_type ) + 1
                "unexpected size for metadata array members" );
 
 
+// Every metadata value the parsers of a frame find, indexed by rs2_frame_metadata_value (or frame_metadata_internal)
+struct metadata_table
+{
+    std::array< rs2_metadata_type, RS2_FRAME_METADATA_ACTUAL_COUNT > values = {};
+    std::bitset< RS2_FRAME_METADATA_ACTUAL_COUNT > valid;
+};
+
+
+// The metadata_table of a frame, once the first lookup decoded it (see frame::find_metadata). Copies start out
+// without it, so assigning a frame's additional data means decoding it again.
+class decoded_metadata
+{
+    mutable std::shared_ptr< const metadata_table > _table;
+
+public:
+    decoded_metadata() = default;
+    decoded_metadata( decoded_metadata const & ) {}
+    decoded_metadata & operator=( decoded_metadata const & )
+    {
+        reset();
+        return *this;
+    }
+
+    // Frames are read from several threads: whoever decodes first publishes the table
+    std::shared_ptr< const metadata_table > get() const { return std::atomic_load( &_table ); }
+    void set( std::shared_ptr< const metadata_table > table ) const { std::atomic_store( &_table, std::move( table ) ); }
+
+    // For whoever changes what the parsers read after the frame was looked at
+    void reset() const { std::atomic_store( &_table, std::shared_ptr< const metadata_table >() ); }
+};
+
+
+// The part of a frame that processing blocks restricted their output to (see processing_block::get_roi), as fractions
+// of its width and height. There is no data outside it.
+struct normalized_roi
+{
+    float left = 0.f;
+    float top = 0.f;
+    float right = 1.f;
+    float bottom = 1.f;
+};
+
+
 struct frame_additional_data : frame_header
 {
     uint32_t metadata_size = 0;
@@ -66,6 +111,18 @@ struct frame_additional_data : frame_header
 
     uint32_t raw_size = 0;  // The frame transmitted size (payload only)
 
+    normalized_roi roi;  // Kept by the frames processing blocks derive from this one
+
+    rs2_time_t delivery_time = 0;  // When the frame was last handed to a callback, in system time; 0 if never
+    rs2_time_t dequeue_time = 0;   // When it was taken from the driver, in system time, if system_time is the driver's
+
+    uint32_t trace_id = 0;  // For frame_trace (see frame-trace.h), when it's on; kept by derived frames, like the roi
+
+    int32_t scene_change = -1;    // Set by the scene-change gate that let it through, in thousandths; -1 if none did
+    uint32_t skipped_frames = 0;  // The frames that gate held back before it
+
+    decoded_metadata decoded;  // What the metadata parsers found, on the first lookup
+
     frame_additional_data() {}
 
     frame_additional_data( metadata_array const & metadata )
@@ -0,0 +1,49 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <librealsense2/h/rs_types.h>
+#include <memory>
+
+
+namespace librealsense {
+
+
+// Supplies the memory frame data is stored in, in place of the archive's own heap buffers. This lets frames live in
+// pinned, huge-page or shared memory so they can be consumed without another copy.
+//
+class frame_allocator
+{
+public:
+    virtual ~frame_allocator() = default;
+
+    // Return a buffer of at least 'size' bytes, or nullptr to fall back to the default allocation.
+    // The memory need not be initialized.
+    virtual void * allocate( size_t size ) = 0;
+
+    // Called once the last reference to the frame owning 'data' is released
+    virtual void deallocate( void * data, size_t size ) = 0;
+};
+
+
+// Adapts the C API function pointers
+class frame_allocator_ptr : public frame_allocator
+{
+    rs2_frame_allocate_ptr _on_allocate;
+    rs2_frame_deallocate_ptr _on_deallocate;
+    void * _user;
+
+public:
+    frame_allocator_ptr( rs2_frame_allocate_ptr on_allocate, rs2_frame_deallocate_ptr on_deallocate, void * user )
+        : _on_allocate( on_allocate )
+        , _on_deallocate( on_deallocate )
+        , _user( user )
+    {
+    }
+
+    void * allocate( size_t size ) override { return _on_allocate( static_cast< int >( size ), _user ); }
+    void deallocate( void * data, size_t size ) override { _on_deallocate( data, static_cast< int >( size ), _user ); }
+};
+
+
+}  // namespace librealsense
@@ -33,6 +33,9 @@ public:
     virtual void set_timestamp_domain( rs2_timestamp_domain timestamp_domain ) = 0;
     virtual rs2_time_t get_frame_system_time() const = 0;  // TIME_OF_ARRIVAL
     virtual std::shared_ptr< stream_profile_interface > get_stream() const = 0;
+    // The profile without taking a reference to it: valid for as long as the frame is, which holds one. For the
+    // per-frame paths, where copying the shared_ptr is an atomic on a control block every thread shares
+    virtual stream_profile_interface * peek_stream() const = 0;
     virtual void set_stream( std::shared_ptr< stream_profile_interface > sp ) = 0;
 
     virtual std::shared_ptr< sensor_interface > get_sensor() const = 0;
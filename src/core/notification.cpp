@@ -3,11 +3,29 @@
 
 #include "notification.h"
 #include <rsutils/easylogging/easyloggingpp.h>
+#include <rsutils/shared-ptr-singleton.h>
+#include <rsutils/string/from.h>
+
+#include <atomic>
+#include <vector>
 
 
 namespace librealsense {
 
 
+// The notifications waiting for a processor's callback
+static const unsigned int max_pending_notifications = 64;
+
+
+notification::notification()
+    : category( RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR )
+    , type( 0 )
+    , severity( RS2_LOG_SEVERITY_NONE )
+    , timestamp( 0 )
+{
+}
+
+
 notification::notification( rs2_notification_category category,
                             int type,
                             rs2_log_severity severity,
@@ -23,33 +41,126 @@ notification::notification( rs2_notification_category category,
 }
 
 
+static bool is_repeat( notification const & a, notification const & b )
+{
+    return a.category == b.category && a.type == b.type && a.severity == b.severity
+        && a.description == b.description && a.serialized_data == b.serialized_data;
+}
+
+
+struct notifications_processor::queue_state
+{
+    lock_free_queue< notification > queue;
+    std::atomic< size_t > dropped;
+    std::atomic< bool > scheduled;  // A delivery is in the dispatcher, and will see whatever's in the queue
+
+    // Held while delivering, so the callback isn't replaced or destroyed under it
+    std::mutex callback_mutex;
+    rs2_notifications_callback_sptr callback;
+    bool closed;
+
+    queue_state()
+        : queue( max_pending_notifications, [this]( notification const & ) { ++dropped; } )
+        , dropped( 0 )
+        , scheduled( false )
+        , closed( false )
+    {
+    }
+};
+
+
+static std::shared_ptr< dispatcher > shared_dispatcher()
+{
+    // Only one delivery per processor is ever waiting in it, so it's never full for long
+    static rsutils::shared_ptr_singleton< dispatcher > the_dispatcher;
+    return the_dispatcher.instance( 256, nullptr, "notifications" );
+}
+
+
 notifications_processor::notifications_processor()
-    : _dispatcher( 10 )
+    : _state( std::make_shared< queue_state >() )
+    , _dispatcher( shared_dispatcher() )
 {
 }
 
 
 notifications_processor::~notifications_processor()
 {
-    _dispatcher.stop();
+    _state->queue.stop();
+    // Wait for a delivery that's in progress; those still queued will find nothing to do
+    std::lock_guard< std::mutex > lock( _state->callback_mutex );
+    _state->closed = true;
+    _state->callback.reset();
 }
 
 
 void notifications_processor::set_callback( rs2_notifications_callback_sptr callback )
 {
+    std::lock_guard< std::mutex > lock( _state->callback_mutex );
+    _state->callback = std::move( callback );
+}
+
+
+rs2_notifications_callback_sptr notifications_processor::get_callback() const
+{
+    std::lock_guard< std::mutex > lock( _state->callback_mutex );
+    return _state->callback;
+}
 
-    _dispatcher.stop();
 
-    std::lock_guard< std::mutex > lock( _callback_mutex );
-    _callback = std::move( callback );
-    _dispatcher.start();
+void notifications_processor::raise_notification( const notification n )
+{
+    notification copy( n );
+    if( ! _state->queue.enqueue( std::move( copy ) ) )
+        return;
+
+    if( ! _state->scheduled.exchange( true ) )
+    {
+        auto state = _state;
+        _dispatcher->invoke( [state]( dispatcher::cancellable_timer ) { deliver( state ); }, true );
+    }
 }
 
 
-rs2_notifications_callback_sptr notifications_processor::get_callback() const
+/*static*/ void notifications_processor::deliver( std::shared_ptr< queue_state > const & state )
 {
-    return _callback;
+    // Anything raised from now on needs another delivery
+    state->scheduled = false;
+
+    // Repeats of the same notification come out as one, with the time of the last
+    std::vector< notification > pending;
+    std::vector< size_t > repeats;
+    notification batch[16];
+    while( pending.size() < max_pending_notifications )
+    {
+        auto n = state->queue.try_dequeue_batch( batch, sizeof( batch ) / sizeof( batch[0] ) );
+        if( ! n )
+            break;
+        for( size_t i = 0; i < n; ++i )
+        {
+            if( ! pending.empty() && is_repeat( pending.back(), batch[i] ) )
+            {
+                pending.back().timestamp = batch[i].timestamp;
+                ++repeats.back();
+                continue;
+            }
+            pending.push_back( std::move( batch[i] ) );
+            repeats.push_back( 1 );
+        }
+    }
+    if( auto dropped = state->dropped.exchange( 0 ) )
+        LOG_WARNING( dropped << " notifications were dropped: the callback isn't keeping up" );
+
+    std::lock_guard< std::mutex > lock( state->callback_mutex );
+    for( size_t i = 0; i < pending.size(); ++i )
+    {
+        if( state->closed || ! state->callback )
+            return;
+        if( repeats[i] > 1 )
+            pending[i].description += rsutils::string::from() << " (repeated " << repeats[i] << " times)";
+        notify( *state->callback, pending[i] );
+    }
 }
 
 
-}  // namespace librealsense
\ No newline at end of file
+}  // namespace librealsense
@@ -13,6 +13,7 @@ namespace librealsense {
 
 struct notification
 {
+    notification();  // For the queue's slots
     notification( rs2_notification_category category,
                   int type,
                   rs2_log_severity severity,
@@ -35,6 +36,10 @@ public:
 };
 
 
+// Delivers notifications to the callback, from the dispatcher shared by all processors rather than a thread of its
+// own: raise_notification() only adds to a bounded lock-free queue, and never waits on the callback. When they come
+// faster than the callback takes them, the oldest are dropped and the same notification raised several times in a row
+// is delivered once, so a device flooding errors doesn't pile work up over everything else.
 class notifications_processor
 {
 public:
@@ -46,9 +51,15 @@ public:
     void raise_notification( const notification );
 
 private:
-    rs2_notifications_callback_sptr _callback;
-    std::mutex _callback_mutex;
-    dispatcher _dispatcher;
+    // What's shared with the deliveries, which may still be queued in the dispatcher once the processor is gone
+    struct queue_state;
+
+    static void deliver( std::shared_ptr< queue_state > const & state );
+    // In rs.cpp, with rs2_notification
+    static void notify( rs2_notifications_callback & callback, notification const & n );
+
+    std::shared_ptr< queue_state > _state;
+    std::shared_ptr< dispatcher > _dispatcher;
 };
 
 
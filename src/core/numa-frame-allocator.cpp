@@ -0,0 +1,159 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "numa-frame-allocator.h"
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined( __linux__ )
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace librealsense {
+
+
+// Released memory kept for reuse; a stream needs about as many as it has frames in flight
+static const size_t max_free_mappings = 16;
+
+#ifdef _WIN32
+static size_t huge_page_size()
+{
+    static const size_t size = GetLargePageMinimum();
+    return size;
+}
+#else
+static size_t huge_page_size() { return 2 * 1024 * 1024; }
+#endif
+
+
+numa_frame_allocator::numa_frame_allocator( int numa_node, bool huge_pages )
+    : _numa_node( numa_node )
+    , _huge_pages( huge_pages )
+    , _warned( false )
+{
+}
+
+
+numa_frame_allocator::~numa_frame_allocator()
+{
+    for( auto & m : _free )
+        unmap( m.data, m.length );
+}
+
+
+size_t numa_frame_allocator::mapped_size( size_t size ) const
+{
+    size_t page = 4096;
+    if( _huge_pages && huge_page_size() && size >= huge_page_size() / 2 )
+        page = huge_page_size();
+    return ( size + page - 1 ) / page * page;
+}
+
+
+void * numa_frame_allocator::allocate( size_t size )
+{
+    auto length = mapped_size( size );
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        for( auto it = _free.begin(); it != _free.end(); ++it )
+        {
+            if( it->length == length )
+            {
+                auto data = it->data;
+                _free.erase( it );
+                return data;
+            }
+        }
+    }
+    return map( length );
+}
+
+
+void numa_frame_allocator::deallocate( void * data, size_t size )
+{
+    mapping released = { data, mapped_size( size ) };
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _free.push_back( released );
+        if( _free.size() <= max_free_mappings )
+            return;
+        // Too many of them (the stream changed resolutions?): the oldest goes
+        released = _free.front();
+        _free.erase( _free.begin() );
+    }
+    unmap( released.data, released.length );
+}
+
+
+void * numa_frame_allocator::map( size_t length )
+{
+    const bool huge = _huge_pages && length >= huge_page_size() && length % huge_page_size() == 0;
+    bool placed = true;
+    void * data = nullptr;
+
+#ifdef _WIN32
+    DWORD node = _numa_node >= 0 ? DWORD( _numa_node ) : NUMA_NO_PREFERRED_NODE;
+    if( huge )
+        // Requires the "Lock pages in memory" privilege
+        data = VirtualAllocExNuma( GetCurrentProcess(), nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                                   PAGE_READWRITE, node );
+    if( ! data )
+        data = VirtualAllocExNuma( GetCurrentProcess(), nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE,
+                                   node );
+    placed = data != nullptr;
+#elif defined( __linux__ )
+#ifdef MAP_HUGETLB
+    if( huge )
+    {
+        data = mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+        if( data == MAP_FAILED )
+            data = nullptr;
+    }
+#endif
+    if( ! data )
+    {
+        data = mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        if( data == MAP_FAILED )
+            return nullptr;
+#ifdef MADV_HUGEPAGE
+        if( huge )
+            madvise( data, length, MADV_HUGEPAGE );
+#endif
+    }
+    if( _numa_node >= 0 )
+    {
+        // Before the pages are first touched, so they're faulted in on the node; preferred rather than bound, so
+        // a full node falls back to the others instead of failing the allocation
+        const int MPOL_PREFERRED_ = 1;
+        const size_t bits = 8 * sizeof( unsigned long );
+        std::vector< unsigned long > mask( _numa_node / bits + 1, 0 );
+        mask[_numa_node / bits] |= 1UL << ( _numa_node % bits );
+        placed = syscall( SYS_mbind, data, length, MPOL_PREFERRED_, mask.data(), mask.size() * bits + 1, 0 ) == 0;
+    }
+#else
+    // No placement on this platform: the archive falls back to its own buffers
+    placed = false;
+#endif
+
+    if( ! placed && ( _numa_node >= 0 || _huge_pages ) && ! _warned.exchange( true ) )
+        LOG_WARNING( "Frame memory could not be placed on NUMA node " << _numa_node
+                                                                      << ( _huge_pages ? " with huge pages" : "" ) );
+    return data;
+}
+
+
+void numa_frame_allocator::unmap( void * data, size_t length )
+{
+#ifdef _WIN32
+    VirtualFree( data, 0, MEM_RELEASE );
+#elif defined( __linux__ )
+    munmap( data, length );
+#endif
+}
+
+
+}  // namespace librealsense
@@ -0,0 +1,51 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include "frame-allocator.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace librealsense {
+
+
+// Frame memory placed on a NUMA node, and in huge pages for the big frames: with the threads of a camera kept on the
+// CPUs of the same node (see the "threads" context settings), its data never crosses to the other socket.
+// The memory is mapped directly from the OS and, once released, kept for the frames after it rather than unmapped, so
+// the pages are faulted in (and placed) only once.
+//
+class numa_frame_allocator : public frame_allocator
+{
+public:
+    // numa_node: the node to place frames on, or -1 to leave that to the OS (the node of the first thread writing them)
+    // huge_pages: back frames of half a huge page or more with huge pages, explicit (reserved with hugetlbfs, or
+    //             large pages on Windows) when there are any, transparent otherwise
+    numa_frame_allocator( int numa_node, bool huge_pages );
+    ~numa_frame_allocator();
+
+    void * allocate( size_t size ) override;
+    void deallocate( void * data, size_t size ) override;
+
+private:
+    size_t mapped_size( size_t size ) const;
+    void * map( size_t length );
+    static void unmap( void * data, size_t length );
+
+    const int _numa_node;
+    const bool _huge_pages;
+    std::atomic< bool > _warned;   // Of memory that could not be placed, once
+
+    struct mapping
+    {
+        void * data;
+        size_t length;
+    };
+    std::mutex _mutex;
+    std::vector< mapping > _free;  // Released, to be given out again before anything new is mapped
+};
+
+
+}  // namespace librealsense
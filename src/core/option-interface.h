@@ -6,6 +6,9 @@
 #include <src/basics.h>
 #include <librealsense2/h/rs_option.h>
 #include <rsutils/json-fwd.h>
+#include <rsutils/subscription.h>
+
+#include <functional>
 
 
 namespace librealsense {
@@ -41,6 +44,11 @@ public:
     virtual bool is_read_only() const { return false; }
     virtual const char * get_description() const = 0;
     virtual const char * get_value_description( float ) const { return nullptr; }
+
+    // Options that know when their value changes (e.g., when a remote device notifies of it) call 'cb' when it does,
+    // so they need not be polled for it; querying them then is expected to be cheap. Others return an inactive
+    // subscription.
+    virtual rsutils::subscription on_value_changed( std::function< void() > && cb ) { return {}; }
     
     // recordable< option >
     virtual void create_snapshot( std::shared_ptr< option > & snapshot ) const override;
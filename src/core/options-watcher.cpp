@@ -4,6 +4,7 @@
 #include <src/core/options-watcher.h>
 #include <proc/synthetic-stream.h>
 #include <rsutils/json.h>
+#include <rsutils/os/thread.h>
 
 using rsutils::json;
 
@@ -20,14 +21,25 @@ options_watcher::options_watcher( std::chrono::milliseconds update_interval )
 options_watcher::~options_watcher()
 {
     _destructing = true;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _notifying.clear();
+    }
     stop();
 }
 
 void options_watcher::register_option( rs2_option id, std::shared_ptr< option > option )
 {
+    auto notifying = option->on_value_changed( [this, id]() { on_value_changed( id ); } );
     {
         std::lock_guard< std::mutex > lock( _mutex );
+        if( _options.count( id ) && ! _notifying.erase( id ) )
+            --_n_polled;
         _options[id] = { option };
+        if( notifying.is_active() )
+            _notifying[id] = std::move( notifying );
+        else
+            ++_n_polled;
     }
 
     if( should_start() )
@@ -38,7 +50,8 @@ void options_watcher::unregister_option( rs2_option id )
 {
     {
         std::lock_guard< std::mutex > lock( _mutex );
-        _options.erase( id );
+        if( _options.erase( id ) && ! _notifying.erase( id ) )
+            --_n_polled;
     }
 
     if( should_stop() )
@@ -62,7 +75,8 @@ bool options_watcher::should_start() const
 
 bool options_watcher::should_stop() const
 {
-    return _on_values_changed.size() == 0 || _options.size() == 0 || _destructing;
+    // Only the polled options need the thread
+    return _on_values_changed.size() == 0 || _n_polled == 0 || _destructing;
 }
 
 void options_watcher::start()
@@ -70,6 +84,7 @@ void options_watcher::start()
     if( ! _updater.joinable() ) // If not already started
     {
         _updater = std::thread( [this]() {
+            rsutils::os::init_thread( "options" );
             update_options();
             thread_loop();
         } );
@@ -116,6 +131,34 @@ void options_watcher::thread_loop()
     }
 }
 
+// Returns true if the value is not the last known one
+static bool update_value( options_watcher::option_and_value & opt )
+{
+    try
+    {
+        json curr_val;
+        if( opt.sptr->is_enabled() )
+            curr_val = opt.sptr->query();
+
+        if( ! opt.p_last_known_value || *opt.p_last_known_value != curr_val )
+        {
+            opt.p_last_known_value = std::make_shared< const json >( std::move( curr_val ) );
+            return true;
+        }
+    }
+    catch( ... )
+    {
+        // Some options cannot be queried all the time (i.e. streaming only) - so if we HAD a value, it needs to be
+        // removed!
+        if( opt.p_last_known_value && ! opt.p_last_known_value->is_null() )
+        {
+            opt.p_last_known_value = std::make_shared< const json >();
+            return true;
+        }
+    }
+    return false;
+}
+
 options_watcher::options_and_values options_watcher::update_options()
 {
     options_and_values updated_options;
@@ -127,28 +170,12 @@ options_watcher::options_and_values options_watcher::update_options()
 
     for( auto & opt : _options )
     {
-        try
-        {
-            json curr_val;
-            if( opt.second.sptr->is_enabled() )
-                curr_val = opt.second.sptr->query();
-
-            if( ! opt.second.p_last_known_value || *opt.second.p_last_known_value != curr_val )
-            {
-                opt.second.p_last_known_value = std::make_shared< const json >( std::move( curr_val ) );
-                updated_options[opt.first] = opt.second;
-            }
-        }
-        catch( ... )
-        {
-            // Some options cannot be queried all the time (i.e. streaming only) - so if we HAD a value, it needs to be
-            // removed!
-            if( opt.second.p_last_known_value && ! opt.second.p_last_known_value->is_null() )
-            {
-                opt.second.p_last_known_value = std::make_shared< const json >();
-                updated_options[opt.first] = opt.second;
-            }
-        }
+        // Those that notify only need their first value
+        if( opt.second.p_last_known_value && _notifying.count( opt.first ) )
+            continue;
+
+        if( update_value( opt.second ) )
+            updated_options[opt.first] = opt.second;
 
         // Checking stop conditions after each query to ensure stop when requested.
         if( should_stop() )
@@ -158,6 +185,23 @@ options_watcher::options_and_values options_watcher::update_options()
     return updated_options;
 }
 
+void options_watcher::on_value_changed( rs2_option id )
+{
+    options_and_values updated_options;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        if( _destructing )
+            return;
+        auto it = _options.find( id );
+        if( it == _options.end() )
+            return;
+        // Kept up to date even with no one to notify, so that it's known once someone subscribes
+        if( update_value( it->second ) )
+            updated_options[id] = it->second;
+    }
+    notify( updated_options );
+}
+
 void options_watcher::notify( options_and_values const & updated_options )
 {
     if( ! updated_options.empty() )
@@ -21,9 +21,10 @@ namespace librealsense {
 
 
 // Watches registered options value and notifies interested users.
-// When a user subscribes to notification the options_watcher will automatically update (query) registered options
-// values in set time intervals (creates a thread). If one or more of the values have changed the watcher will notify
-// through the callback subscription.
+// Options that can tell when their value changes (see option::on_value_changed) notify the watcher as they do. The
+// others are polled: when a user subscribes to notification the options_watcher will automatically update (query)
+// them in set time intervals (creates a thread), all in one pass. If one or more of the values have changed the
+// watcher will notify through the callback subscription.
 class options_watcher
 {
 public:
@@ -53,10 +54,14 @@ protected:
     void start();
     void stop();
     void thread_loop();
+    // Queries the polled options, and those that notify but haven't yet
     virtual options_and_values update_options();
+    void on_value_changed( rs2_option id );
     void notify( options_and_values const & updated_options );
 
     options_and_values _options;
+    std::map< rs2_option, rsutils::subscription > _notifying;  // Options that notify, rather than being polled
+    size_t _n_polled = 0;
     rsutils::signal< options_and_values const & > _on_values_changed;
     std::chrono::milliseconds _update_interval;
     std::thread _updater;
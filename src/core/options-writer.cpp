@@ -0,0 +1,137 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <src/core/options-writer.h>
+#include <src/core/device-interface.h>
+#include <src/log.h>
+
+#include <algorithm>
+#include <map>
+
+
+namespace librealsense {
+
+
+std::shared_ptr< options_writer > options_writer::for_device( std::shared_ptr< device_interface > const & dev )
+{
+    static std::mutex mutex;
+    static std::map< device_interface const *, std::weak_ptr< options_writer > > writers;
+
+    std::lock_guard< std::mutex > lock( mutex );
+    for( auto it = writers.begin(); it != writers.end(); )
+    {
+        if( it->second.expired() )
+            it = writers.erase( it );
+        else
+            ++it;
+    }
+    auto & weak = writers[dev.get()];
+    auto writer = weak.lock();
+    if( ! writer )
+    {
+        writer = std::make_shared< options_writer >();
+        weak = writer;
+    }
+    return writer;
+}
+
+
+options_writer::options_writer()
+    : _dispatcher( 10, nullptr, "options-writer" )
+{
+}
+
+
+options_writer::~options_writer()
+{
+    _dispatcher.flush();
+}
+
+
+void options_writer::write( std::vector< std::pair< option *, float > > const & values,
+                            std::shared_ptr< void > owner,
+                            callback && cb )
+{
+    auto b = std::make_shared< batch >();
+    b->remaining = values.size();
+    b->cb = std::move( cb );
+    b->owner = std::move( owner );
+    if( values.empty() )
+    {
+        b->cb( nullptr );
+        return;
+    }
+
+    std::lock_guard< std::mutex > lock( _mutex );
+    for( auto & value : values )
+    {
+        auto it = std::find_if( _pending.begin(),
+                                _pending.end(),
+                                [&]( pending const & p ) { return p.opt == value.first; } );
+        if( it == _pending.end() )
+        {
+            _pending.push_back( { value.first, value.second, { b } } );
+            continue;
+        }
+        it->value = value.second;
+        if( std::find( it->batches.begin(), it->batches.end(), b ) != it->batches.end() )
+            --b->remaining;  // The same option twice in one call: only the last counts
+        else
+            it->batches.push_back( b );
+    }
+    if( ! _draining )
+    {
+        _draining = true;
+        _dispatcher.invoke( [this]( dispatcher::cancellable_timer ) { drain(); }, true );
+    }
+}
+
+
+void options_writer::drain()
+{
+    std::vector< pending > writes;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        writes.swap( _pending );
+        _draining = false;
+    }
+
+    for( auto & w : writes )
+    {
+        std::exception_ptr error;
+        try
+        {
+            w.opt->set( w.value );
+        }
+        catch( ... )
+        {
+            error = std::current_exception();
+        }
+
+        std::vector< std::shared_ptr< batch > > done;
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            for( auto & b : w.batches )
+            {
+                if( error && ! b->error )
+                    b->error = error;
+                if( ! --b->remaining )
+                    done.push_back( b );
+            }
+        }
+        for( auto & b : done )
+        {
+            try
+            {
+                b->cb( b->error );
+            }
+            catch( ... )
+            {
+                LOG_ERROR( "Exception in options-writer callback" );
+            }
+        }
+    }
+}
+
+
+}  // namespace librealsense
@@ -0,0 +1,70 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <src/core/option-interface.h>
+
+#include <rsutils/concurrency/concurrency.h>
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+
+namespace librealsense {
+
+
+class device_interface;
+
+
+// Sets options off the caller's thread: for all the sensors of a device, one at a time, in the order they were
+// queued. A write that's still queued when another comes for the same option takes on its value instead, so the
+// option is set once, and whoever queued either hears of that.
+class options_writer
+{
+public:
+    // Called once all the writes of a call are done: with the first error, or null if none failed
+    using callback = std::function< void( std::exception_ptr ) >;
+
+    // The device's, shared by whoever writes its options
+    static std::shared_ptr< options_writer > for_device( std::shared_ptr< device_interface > const & );
+
+    options_writer();
+    ~options_writer();  // Waits for whatever is queued
+
+    options_writer( options_writer const & ) = delete;
+    options_writer & operator=( options_writer const & ) = delete;
+
+    // The options must be kept alive, e.g. by 'owner', until the callback
+    void write( std::vector< std::pair< option *, float > > const & values,
+                std::shared_ptr< void > owner,
+                callback && cb );
+
+private:
+    struct batch
+    {
+        size_t remaining;
+        std::exception_ptr error;
+        callback cb;
+        std::shared_ptr< void > owner;
+    };
+    struct pending
+    {
+        option * opt;
+        float value;
+        std::vector< std::shared_ptr< batch > > batches;
+    };
+
+    void drain();
+
+    std::mutex _mutex;
+    std::vector< pending > _pending;
+    bool _draining = false;  // Whether a drain() is queued that hasn't taken the pending writes yet
+    dispatcher _dispatcher;
+};
+
+
+}  // namespace librealsense
@@ -11,6 +11,7 @@
 
 #include <src/core/options-watcher.h>
 #include <librealsense2/hpp/rs_types.hpp>
+#include <librealsense2/h/rs_sensor.h>
 
 #include <rsutils/subscription.h>
 
@@ -23,6 +24,7 @@ namespace librealsense {
 
 class stream_profile_interface;
 class device_interface;
+class metadata_sink;
 
 
 class sensor_interface
@@ -58,6 +60,13 @@ public:
     virtual void set_frames_callback( rs2_frame_callback_sptr cb ) = 0;
 
     virtual rsutils::subscription register_options_changed_callback( options_watcher::callback && cb ) = 0;
+
+    // Per stream, since the sensor was last opened; none if the sensor doesn't keep any
+    virtual std::vector< rs2_stream_telemetry > get_stream_telemetry() const { return {}; }
+
+    // Of every frame the sensor gets; false if it doesn't have frames of its own to sink
+    virtual bool set_metadata_sink( std::shared_ptr< metadata_sink > ) { return false; }
+    virtual bool flush_metadata_sink() { return false; }
 };
 
 
@@ -44,6 +44,9 @@ namespace librealsense
                                                        rs2_extension frame_type = RS2_EXTENSION_MOTION_FRAME) = 0;
 
         virtual frame_interface* allocate_composite_frame(std::vector<frame_holder> frames) = 0;
+        // Same, moving the frames out of the array: without allocating unless there are more than
+        // composite_frame::INLINE_FRAMES
+        virtual frame_interface* allocate_composite_frame(frame_holder* frames, size_t count) = 0;
 
         virtual frame_interface* allocate_points(std::shared_ptr<stream_profile_interface> stream, 
             frame_interface* original, 
@@ -224,74 +224,60 @@ __global__ void kernel_unpack_yuy2_bgra8_cuda(const uint8_t * src, uint8_t *dst,
 }
 
 
-void rscuda::unpack_yuy2_cuda_helper(const uint8_t* h_src, uint8_t* h_dst, int n, rs2_format format)
+namespace
 {
-    /*    cudaEvent_t start, stop;
-        cudaEventCreate(&start);
-        cudaEventCreate(&stop);
-        cudaEventRecord(start); */
-
-        // How many super pixels do we have?
-    int superPix = n / 2;
-    std::shared_ptr<uint8_t> d_dst;
-    std::shared_ptr<uint8_t> d_src = alloc_dev<uint8_t>(superPix * 4);
+    // Each thread converting frames (typically, each processing block) has its own streams and staging buffers
+    thread_local rscuda::pipelined_conversion conversion;
+}
 
-    auto result = cudaMemcpy(d_src.get(), h_src, superPix * sizeof(uint8_t) * 4, cudaMemcpyHostToDevice);
-    assert(result == cudaSuccess);
 
-    int numBlocks = superPix / RS2_CUDA_THREADS_PER_BLOCK;
+void rscuda::unpack_yuy2_cuda_helper(const uint8_t* h_src, uint8_t* h_dst, int n, rs2_format format)
+{
+    // How many super pixels do we have?
+    int superPix = n / 2;
     int size;
+    void (*kernel)(const uint8_t *, uint8_t *, int);
 
     switch (format)
     {
         // conversion to Y8 is currently not available in the API
         /*	case RS2_FORMAT_Y8:
             size = 1;
-             d_dst = alloc_dev<uint8_t>(n * size);
-            kernel_unpack_yuy2_y8_cuda<<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK>>>(devSrc, devDst, superPix);
+            kernel = kernel_unpack_yuy2_y8_cuda;
             break;
         */
     case RS2_FORMAT_Y16:
         size = 2;
-        d_dst = alloc_dev<uint8_t>(n * size);
-        kernel_unpack_yuy2_y16_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), superPix);
+        kernel = kernel_unpack_yuy2_y16_cuda;
         break;
     case RS2_FORMAT_RGB8:
         size = 3;
-        d_dst = alloc_dev<uint8_t>(n * size);
-        kernel_unpack_yuy2_rgb8_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), superPix);
+        kernel = kernel_unpack_yuy2_rgb8_cuda;
         break;
     case RS2_FORMAT_BGR8:
         size = 3;
-        d_dst = alloc_dev<uint8_t>(n * size);
-        kernel_unpack_yuy2_bgr8_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), superPix);
+        kernel = kernel_unpack_yuy2_bgr8_cuda;
         break;
     case RS2_FORMAT_RGBA8:
         size = 4;
-        d_dst = alloc_dev<uint8_t>(n * size);
-        kernel_unpack_yuy2_rgba8_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), superPix);
+        kernel = kernel_unpack_yuy2_rgba8_cuda;
         break;
     case RS2_FORMAT_BGRA8:
         size = 4;
-        d_dst = alloc_dev<uint8_t>(n * size);
-        kernel_unpack_yuy2_bgra8_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), superPix);
+        kernel = kernel_unpack_yuy2_bgra8_cuda;
         break;
     default:
         assert(false);
+        return;
     }
-    result = cudaGetLastError();
-    assert(result == cudaSuccess);
 
-    cudaStreamSynchronize(0);
-
-    result = cudaMemcpy(h_dst, d_dst.get(), n * sizeof(uint8_t) * size, cudaMemcpyDeviceToHost);
-    assert(result == cudaSuccess);
-
-    /*	cudaEventRecord(stop);
-        cudaEventSynchronize(stop);
-        float milliseconds = 0;
-        cudaEventElapsedTime(&milliseconds, start, stop);
-        std::cout << milliseconds << "\n"; */
+    uint8_t* const dst[] = { h_dst };
+    // Frames are converted as they arrive, on the context's device (not a block's: see device_option)
+    librealsense::cuda::device_scope scope(librealsense::cuda::default_device());
+    conversion.run(h_src, 4, superPix, dst, { size_t(size) * 2 },
+        [kernel](cudaStream_t stream, const uint8_t* d_src, uint8_t* const d_dst[], int, int count) {
+            kernel<<<calc_blocks(count, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(d_src, d_dst[0], count);
+        });
 }
 
 
@@ -308,38 +294,12 @@ __global__ void kernel_split_frame_y8_y8_from_y8i_cuda(uint8_t* a, uint8_t* b, i
 
 void rscuda::y8_y8_from_y8i_cuda_helper(uint8_t* const dest[], int count, const rscuda::y8i_pixel * source)
 {
-    /*    cudaEvent_t start, stop;
-        cudaEventCreate(&start);
-        cudaEventCreate(&stop);
-        cudaEventRecord(start); */
-
-    int numBlocks = count / RS2_CUDA_THREADS_PER_BLOCK;
-    uint8_t* a = dest[0];
-    uint8_t* b = dest[1];
-
-    auto d_src = alloc_dev<rscuda::y8i_pixel>(count);
-    auto d_dst_0 = alloc_dev<uint8_t>(count);
-    auto d_dst_1 = alloc_dev<uint8_t>(count);
-
-    auto result = cudaMemcpy(d_src.get(), source, count * sizeof(rscuda::y8i_pixel), cudaMemcpyHostToDevice);
-    assert(result == cudaSuccess);
-
-    kernel_split_frame_y8_y8_from_y8i_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_dst_0.get(), d_dst_1.get(), count, d_src.get());
-    cudaStreamSynchronize(0);
-
-    result = cudaGetLastError();
-    assert(result == cudaSuccess);
-
-    result = cudaMemcpy(a, d_dst_0.get(), count * sizeof(uint8_t), cudaMemcpyDeviceToHost);
-    assert(result == cudaSuccess);
-    result = cudaMemcpy(b, d_dst_1.get(), count * sizeof(uint8_t), cudaMemcpyDeviceToHost);
-    assert(result == cudaSuccess);
-
-    /*    cudaEventRecord(stop);
-        cudaEventSynchronize(stop);
-        float milliseconds = 0;
-        cudaEventElapsedTime(&milliseconds, start, stop);
-        std::cout << milliseconds << std::endl; */
+    librealsense::cuda::device_scope scope(librealsense::cuda::default_device());
+    conversion.run(source, sizeof(rscuda::y8i_pixel), count, dest, { sizeof(uint8_t), sizeof(uint8_t) },
+        [](cudaStream_t stream, const uint8_t* d_src, uint8_t* const d_dst[], int, int n) {
+            kernel_split_frame_y8_y8_from_y8i_cuda<<<calc_blocks(n, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+                d_dst[0], d_dst[1], n, reinterpret_cast<const rscuda::y8i_pixel*>(d_src));
+        });
 }
 
 __global__ void kernel_split_frame_y16_y16_from_y12i_cuda(uint16_t* a, uint16_t* b, int count, const rscuda::y12i_pixel * source)
@@ -356,44 +316,12 @@ __global__ void kernel_split_frame_y16_y16_from_y12i_cuda(uint16_t* a, uint16_t*
 
 void rscuda::y16_y16_from_y12i_10_cuda_helper(uint8_t* const dest[], int count, const rscuda::y12i_pixel * source)
 {
-    /*
-        cudaEvent_t start, stop;
-        cudaEventCreate(&start);
-        cudaEventCreate(&stop);
-        cudaEventRecord(start); */
-
-    source = reinterpret_cast<const y12i_pixel*>(source);
-
-    int numBlocks = count / RS2_CUDA_THREADS_PER_BLOCK;
-    uint16_t* a = reinterpret_cast<uint16_t*>(dest[0]);
-    uint16_t* b = reinterpret_cast<uint16_t*>(dest[1]);
-
-    auto d_src = alloc_dev<rscuda::y12i_pixel>(count);
-    auto d_dst_0 = alloc_dev<uint16_t>(count);
-    auto d_dst_1 = alloc_dev<uint16_t>(count);
-
-
-    auto result = cudaMemcpy(d_src.get(), source, count * sizeof(rscuda::y12i_pixel), cudaMemcpyHostToDevice);
-    assert(result == cudaSuccess);
-
-    kernel_split_frame_y16_y16_from_y12i_cuda <<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK>>> (d_dst_0.get(), d_dst_1.get(), count, d_src.get());
-    cudaStreamSynchronize(0);
-
-    result = cudaGetLastError();
-    assert(result == cudaSuccess);
-
-    result = cudaMemcpy(a, d_dst_0.get(), count * sizeof(uint16_t), cudaMemcpyDeviceToHost);
-    assert(result == cudaSuccess);
-    result = cudaMemcpy(b, d_dst_1.get(), count * sizeof(uint16_t), cudaMemcpyDeviceToHost);
-    assert(result == cudaSuccess);
-
-    /*
-    cudaEventRecord(stop);
-    cudaEventSynchronize(stop);
-    float milliseconds = 0;
-    cudaEventElapsedTime(&milliseconds, start, stop);
-    std::cout << milliseconds << std::endl;
-    */
+    librealsense::cuda::device_scope scope(librealsense::cuda::default_device());
+    conversion.run(source, sizeof(rscuda::y12i_pixel), count, dest, { sizeof(uint16_t), sizeof(uint16_t) },
+        [](cudaStream_t stream, const uint8_t* d_src, uint8_t* const d_dst[], int, int n) {
+            kernel_split_frame_y16_y16_from_y12i_cuda<<<calc_blocks(n, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+                reinterpret_cast<uint16_t*>(d_dst[0]), reinterpret_cast<uint16_t*>(d_dst[1]), n, reinterpret_cast<const rscuda::y12i_pixel*>(d_src));
+        });
 }
 
 
@@ -409,30 +337,13 @@ __global__ void kernel_z16_y8_from_sr300_inzi_cuda(const uint16_t* source, uint8
 
 void rscuda::unpack_z16_y8_from_sr300_inzi_cuda(uint8_t * const dest, const uint16_t * source, int count)
 {
-    /*  cudaEvent_t start, stop;
-        cudaEventCreate(&start);
-        cudaEventCreate(&stop);
-        cudaEventRecord(start); */
-
-    auto d_src = alloc_dev<uint16_t>(count);
-    auto d_dst = alloc_dev<uint8_t>(count);
-
-    int numBlocks = count / RS2_CUDA_THREADS_PER_BLOCK;
-
-    auto result = cudaMemcpy(d_src.get(), source, count * sizeof(uint16_t), cudaMemcpyHostToDevice);
-    assert(result == cudaSuccess);
-
-    kernel_z16_y8_from_sr300_inzi_cuda <<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK >>> (d_src.get(), d_dst.get(), count);
-    cudaStreamSynchronize(0);
-
-    result = cudaMemcpy(dest, d_dst.get(), count * sizeof(uint8_t), cudaMemcpyDeviceToHost);
-    assert(result == cudaSuccess);
-
-    /*  cudaEventRecord(stop);
-        cudaEventSynchronize(stop);
-        float milliseconds = 0;
-        cudaEventElapsedTime(&milliseconds, start, stop);
-        std::cout << milliseconds << std::endl; */
+    uint8_t* const dst[] = { dest };
+    librealsense::cuda::device_scope scope(librealsense::cuda::default_device());
+    conversion.run(source, sizeof(uint16_t), count, dst, { sizeof(uint8_t) },
+        [](cudaStream_t stream, const uint8_t* d_src, uint8_t* const d_dst[], int, int n) {
+            kernel_z16_y8_from_sr300_inzi_cuda<<<calc_blocks(n, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+                reinterpret_cast<const uint16_t*>(d_src), d_dst[0], n);
+        });
 }
 
 __global__ void kernel_z16_y16_from_sr300_inzi_cuda(uint16_t* const source, uint16_t* const dest, int count)
@@ -447,30 +358,13 @@ __global__ void kernel_z16_y16_from_sr300_inzi_cuda(uint16_t* const source, uint
 
 void rscuda::unpack_z16_y16_from_sr300_inzi_cuda(uint16_t * const dest, const uint16_t * source, int count)
 {
-    /*  cudaEvent_t start, stop;
-        cudaEventCreate(&start);
-        cudaEventCreate(&stop);
-        cudaEventRecord(start); */
-
-    auto d_src = alloc_dev<uint16_t>(count);
-    auto d_dst = alloc_dev<uint16_t>(count);
-
-    int numBlocks = count / RS2_CUDA_THREADS_PER_BLOCK;
-
-    auto result = cudaMemcpy(d_src.get(), source, count * sizeof(uint16_t), cudaMemcpyHostToDevice);
-    assert(result == cudaSuccess);
-
-    kernel_z16_y16_from_sr300_inzi_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), count);
-    cudaStreamSynchronize(0);
-
-    result = cudaMemcpy(dest, d_dst.get(), count * sizeof(uint16_t), cudaMemcpyDeviceToHost);
-    assert(result == cudaSuccess);
-
-    /*	cudaEventRecord(stop);
-        cudaEventSynchronize(stop);
-        float milliseconds = 0;
-        cudaEventElapsedTime(&milliseconds, start, stop);
-        std::cout << milliseconds << std::endl; */
+    uint8_t* const dst[] = { reinterpret_cast<uint8_t*>(dest) };
+    librealsense::cuda::device_scope scope(librealsense::cuda::default_device());
+    conversion.run(source, sizeof(uint16_t), count, dst, { sizeof(uint16_t) },
+        [](cudaStream_t stream, const uint8_t* d_src, uint8_t* const d_dst[], int, int n) {
+            kernel_z16_y16_from_sr300_inzi_cuda<<<calc_blocks(n, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+                reinterpret_cast<uint16_t*>(const_cast<uint8_t*>(d_src)), reinterpret_cast<uint16_t*>(d_dst[0]), n);
+        });
 }
 
 #endif
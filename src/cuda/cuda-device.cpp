@@ -0,0 +1,239 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_CUDA
+
+#include "cuda-device.h"
+
+#include "option.h"
+#include "core/options-container.h"
+
+#include <rsutils/easylogging/easyloggingpp.h>
+#include <rsutils/json.h>
+
+#include <cuda_runtime.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+
+namespace librealsense {
+namespace cuda {
+
+
+static std::atomic< int > the_default_device( 0 );
+
+
+void configure( rsutils::json const & settings )
+{
+    int device = settings.nested( "device" ).default_value( 0 );
+    if( device < 0 || device >= device_count() )
+    {
+        LOG_ERROR( "invalid CUDA device " << device << " in the context settings; using 0" );
+        device = 0;
+    }
+    LOG_INFO( "CUDA processing on device " << device );
+    the_default_device = device;
+}
+
+
+int default_device()
+{
+    return the_default_device;
+}
+
+
+int device_count()
+{
+    int count = 0;
+    if( cudaGetDeviceCount( &count ) != cudaSuccess )
+        return 0;
+    return count;
+}
+
+
+device_scope::device_scope( int device )
+    : _previous( -1 )
+{
+    int current = 0;
+    cudaGetDevice( &current );
+    if( current == device )
+        return;
+
+    auto res = cudaSetDevice( device );
+    if( res != cudaSuccess )
+        throw std::runtime_error( "failed to select CUDA device " + std::to_string( device ) + ": "
+                                  + cudaGetErrorString( res ) );
+    _previous = current;
+}
+
+
+device_scope::~device_scope()
+{
+    if( _previous >= 0 )
+        cudaSetDevice( _previous );
+}
+
+
+/*static*/ std::shared_ptr< memory_pool > memory_pool::of( int device )
+{
+    static std::mutex pools_mutex;
+    static std::map< int, std::shared_ptr< memory_pool > > pools;
+
+    std::lock_guard< std::mutex > lock( pools_mutex );
+    auto & pool = pools[device];
+    if( ! pool )
+        pool = std::make_shared< memory_pool >( device );
+    return pool;
+}
+
+
+/*static*/ std::shared_ptr< memory_pool > memory_pool::current()
+{
+    int device = 0;
+    cudaGetDevice( &device );
+    return of( device );
+}
+
+
+memory_pool::memory_pool( int device )
+    : _device( device )
+{
+}
+
+
+memory_pool::~memory_pool()
+{
+    trim();
+}
+
+
+/*static*/ size_t memory_pool::size_class( size_t bytes )
+{
+    // Multiples of a quarter of the power of two below, and of 256 bytes for the smallest
+    size_t power = 1024;
+    while( power * 2 <= bytes )
+        power *= 2;
+    size_t const step = power / 4;
+    return ( bytes + step - 1 ) / step * step;
+}
+
+
+std::shared_ptr< uint8_t > memory_pool::allocate( size_t bytes )
+{
+    auto const size = size_class( std::max< size_t >( bytes, 1 ) );
+
+    uint8_t * p = nullptr;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        auto it = _free.find( size );
+        if( it != _free.end() && ! it->second.empty() )
+        {
+            p = it->second.back();
+            it->second.pop_back();
+            _cached_bytes -= size;
+        }
+    }
+
+    if( ! p )
+    {
+        device_scope scope( _device );
+        auto res = cudaMalloc( reinterpret_cast< void ** >( &p ), size );
+        if( res != cudaSuccess )
+        {
+            // What we keep may be what's missing
+            cudaGetLastError();
+            trim();
+            res = cudaMalloc( reinterpret_cast< void ** >( &p ), size );
+        }
+        if( res != cudaSuccess )
+            throw std::runtime_error( std::string( "cudaMalloc failed: " ) + cudaGetErrorString( res ) );
+    }
+
+    auto self = shared_from_this();
+    return std::shared_ptr< uint8_t >( p, [self, size]( uint8_t * p ) { self->release( p, size ); } );
+}
+
+
+void memory_pool::release( uint8_t * p, size_t size )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        if( _cached_bytes + size <= max_cached_bytes )
+        {
+            _free[size].push_back( p );
+            _cached_bytes += size;
+            return;
+        }
+    }
+    try
+    {
+        device_scope scope( _device );
+        cudaFree( p );
+    }
+    catch( std::exception const & e )
+    {
+        LOG_ERROR( "failed to free CUDA memory: " << e.what() );
+    }
+}
+
+
+void memory_pool::trim()
+{
+    std::map< size_t, std::vector< uint8_t * > > free;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        std::swap( free, _free );
+        _cached_bytes = 0;
+    }
+    if( free.empty() )
+        return;
+
+    try
+    {
+        device_scope scope( _device );
+        for( auto & size_buffers : free )
+            for( auto p : size_buffers.second )
+                cudaFree( p );
+    }
+    catch( std::exception const & e )
+    {
+        LOG_ERROR( "failed to free CUDA memory: " << e.what() );
+    }
+}
+
+
+size_t memory_pool::cached_bytes() const
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    return _cached_bytes;
+}
+
+
+device_option::device_option( options_container & block )
+{
+    auto option = std::make_shared< ptr_option< int > >( -1,
+                                                         std::max( device_count() - 1, -1 ),
+                                                         1,
+                                                         -1,
+                                                         &_requested,
+                                                         "CUDA device to process on; -1 for the context's default" );
+    block.register_option( RS2_OPTION_CUDA_DEVICE, option );
+}
+
+
+int device_option::select( bool & moved )
+{
+    int device = _requested < 0 ? default_device() : _requested;
+    moved = device != _selected && _selected >= 0;
+    _selected = device;
+    return device;
+}
+
+
+}  // namespace cuda
+}  // namespace librealsense
+
+#endif  // RS2_USE_CUDA
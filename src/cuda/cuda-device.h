@@ -0,0 +1,111 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#ifdef RS2_USE_CUDA
+
+#include <rsutils/json-fwd.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace librealsense {
+
+
+class options_container;
+
+
+namespace cuda {
+
+
+// The "cuda" context settings:
+//     "cuda": { "device": 1 }
+// selects the device that CUDA processing runs on when a block isn't told otherwise (by RS2_OPTION_CUDA_DEVICE)
+void configure( rsutils::json const & settings );
+
+// The device from the settings, or 0
+int default_device();
+
+int device_count();
+
+
+// Makes a device the current one on the calling thread, for the scope; nothing is done when it already is
+class device_scope
+{
+public:
+    explicit device_scope( int device );
+    ~device_scope();
+
+    device_scope( device_scope const & ) = delete;
+    device_scope & operator=( device_scope const & ) = delete;
+
+private:
+    int _previous;
+};
+
+
+// Device memory of one device, kept for reuse: a buffer that's released goes back to the pool, and the next allocation
+// of about the same size gets it rather than going to cudaMalloc. Buffers that follow the resolution of the frames are
+// then only allocated once, across resolution changes.
+//
+// Sizes are rounded up to one of four classes per power of two, so the most that's wasted is a quarter.
+class memory_pool : public std::enable_shared_from_this< memory_pool >
+{
+public:
+    // The pool of a device (created as needed), or of the calling thread's current device
+    static std::shared_ptr< memory_pool > of( int device );
+    static std::shared_ptr< memory_pool > current();
+
+    explicit memory_pool( int device );
+    ~memory_pool();
+
+    int device() const { return _device; }
+
+    // At least 'bytes' of device memory, with the size class's alignment
+    std::shared_ptr< uint8_t > allocate( size_t bytes );
+
+    // Frees the buffers that were given back
+    void trim();
+
+    size_t cached_bytes() const;
+
+    // A pool keeps at most this much memory that isn't in use; more is freed as it's released
+    static const size_t max_cached_bytes = size_t( 256 ) << 20;
+
+    static size_t size_class( size_t bytes );
+
+private:
+    void release( uint8_t * p, size_t size );
+
+    int const _device;
+    mutable std::mutex _mutex;
+    std::map< size_t, std::vector< uint8_t * > > _free;
+    size_t _cached_bytes = 0;
+};
+
+
+// A processing block's choice of device, through RS2_OPTION_CUDA_DEVICE: -1 (the default) follows the context
+// settings. The block makes select()'s device current while it processes a frame.
+class device_option
+{
+public:
+    explicit device_option( options_container & block );
+
+    // The device to process on; 'moved' is set when it's another one than last time, for the block to drop what it
+    // had allocated on the last one
+    int select( bool & moved );
+
+private:
+    int _requested = -1;
+    int _selected = -1;
+};
+
+
+}  // namespace cuda
+}  // namespace librealsense
+
+#endif  // RS2_USE_CUDA
@@ -0,0 +1,96 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_CUDA
+
+#include "cuda-frame.h"
+#include "cuda-device.h"
+
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <cuda_runtime.h>
+
+#include <stdexcept>
+#include <string>
+
+
+namespace librealsense {
+namespace cuda {
+
+
+uint8_t * cuda_section::output( size_t size )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    int device = 0;
+    cudaGetDevice( &device );
+    if( size > _capacity || device != _device_index )
+    {
+        // From the device's pool: frames of another resolution may well have left what we need there
+        _device.reset();
+        _capacity = 0;
+        _device = memory_pool::of( device )->allocate( size );
+        _capacity = size;
+        _device_index = device;
+    }
+    _size = size;
+    _on_device = true;
+    _fetched = false;
+    return _device.get();
+}
+
+
+uint8_t const * cuda_section::input() const
+{
+    int device = 0;
+    cudaGetDevice( &device );
+
+    std::lock_guard< std::mutex > lock( _mutex );
+    // Content on another device is taken from the host, like any other
+    return _on_device && device == _device_index ? _device.get() : nullptr;
+}
+
+
+bool cuda_section::on_gpu() const
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    return _on_device;
+}
+
+
+uint8_t const * cuda_section::device_content( int & device_index ) const
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    device_index = _on_device ? _device_index : -1;
+    return _on_device ? _device.get() : nullptr;
+}
+
+
+void cuda_section::on_unpublish()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    _on_device = false;
+    _fetched = false;
+}
+
+
+void cuda_section::fetch_frame( void * to )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    if( ! _on_device || _fetched || ! to )
+        return;
+
+    auto res = cudaMemcpy( to, _device.get(), _size, cudaMemcpyDeviceToHost );
+    if( res != cudaSuccess )
+    {
+        // The frame is left with whatever its host data had; there's no one to throw at from get_data()
+        LOG_ERROR( "failed to fetch CUDA frame: " << cudaGetErrorString( res ) );
+        return;
+    }
+    _fetched = true;
+}
+
+
+}  // namespace cuda
+}  // namespace librealsense
+
+#endif  // RS2_USE_CUDA
@@ -0,0 +1,131 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#ifdef RS2_USE_CUDA
+
+#include "core/video-frame.h"
+#include "core/depth-frame.h"
+#include "core/disparity-frame.h"
+#include "points.h"
+
+#include <memory>
+#include <mutex>
+
+
+// Like the GL frames (see gl/synthetic-stream-gl.h), these aren't public extensions: processing blocks add them to
+// their own frame sources
+#define RS2_EXTENSION_VIDEO_FRAME_CUDA (rs2_extension)(RS2_EXTENSION_COUNT + 2)
+#define RS2_EXTENSION_DEPTH_FRAME_CUDA (rs2_extension)(RS2_EXTENSION_COUNT + 3)
+#define RS2_EXTENSION_POINTS_CUDA (rs2_extension)(RS2_EXTENSION_COUNT + 4)
+#define RS2_EXTENSION_DISPARITY_FRAME_CUDA (rs2_extension)(RS2_EXTENSION_COUNT + 5)
+
+
+namespace librealsense {
+namespace cuda {
+
+
+// The content of a frame that a CUDA block left in device memory, for the next CUDA block to take from there without
+// a round trip through the host. The frame's own (host) data is only filled in when it's asked for, the first time.
+//
+// The device memory stays with the frame object as it's recycled by its archive, so it's only allocated once.
+class cuda_section
+{
+public:
+    // Device memory for 'size' bytes of content: from here on the content is on the device, until the frame goes back
+    // to its archive. It must be complete (the stream synchronized) by the time anyone else gets the frame.
+    uint8_t * output( size_t size );
+
+    // The content on the current device, or null if it's on the host (or another device)
+    uint8_t const * input() const;
+    bool on_gpu() const;
+    // The content on whichever device it's on, or null (and -1) if it's on the host
+    uint8_t const * device_content( int & device_index ) const;
+
+    void on_publish() {}
+    void on_unpublish();
+
+    // Copy the content to the host frame data, if it hasn't been already
+    void fetch_frame( void * to );
+
+private:
+    mutable std::mutex _mutex;
+    std::shared_ptr< uint8_t > _device;
+    size_t _capacity = 0;
+    int _device_index = -1;     // Which device _device is on
+    size_t _size = 0;
+    bool _on_device = false;
+    bool _fetched = false;
+};
+
+
+class cuda_addon_interface
+{
+public:
+    virtual cuda_section & get_cuda_section() = 0;
+    virtual ~cuda_addon_interface() = default;
+};
+
+
+template< class T >
+class cuda_addon : public T, public cuda_addon_interface
+{
+public:
+    cuda_section & get_cuda_section() override { return _section; }
+    frame_interface * publish( std::shared_ptr< archive_interface > new_owner ) override
+    {
+        _section.on_publish();
+        return T::publish( new_owner );
+    }
+    void unpublish() override
+    {
+        _section.on_unpublish();
+        T::unpublish();
+    }
+    const uint8_t * get_frame_data() const override
+    {
+        auto res = T::get_frame_data();
+        _section.fetch_frame( (void *)res );
+        return res;
+    }
+    cuda_addon() : T(), _section() {}
+    cuda_addon( cuda_addon && other )
+        : T( (T &&)std::move( other ) )
+    {
+    }
+    cuda_addon & operator=( cuda_addon && other )
+    {
+        return (cuda_addon &)T::operator=( (T &&)std::move( other ) );
+    }
+
+private:
+    mutable cuda_section _section;
+};
+
+
+class cuda_video_frame : public cuda_addon< video_frame > {};
+class cuda_depth_frame : public cuda_addon< depth_frame > {};
+class cuda_points_frame : public cuda_addon< points > {};
+class cuda_disparity_frame : public cuda_addon< disparity_frame > {};
+
+
+// The section of a CUDA frame, or null for any other frame
+inline cuda_section * section_of( frame_interface const * f )
+{
+    auto addon = dynamic_cast< cuda_addon_interface * >( const_cast< frame_interface * >( f ) );
+    return addon ? &addon->get_cuda_section() : nullptr;
+}
+
+
+// The content of a frame on the device, if it's a CUDA frame whose content is there
+inline uint8_t const * device_data( frame_interface const * f )
+{
+    auto section = section_of( f );
+    return section ? section->input() : nullptr;
+}
+
+
+}  // namespace cuda
+}  // namespace librealsense
+
+#endif  // RS2_USE_CUDA
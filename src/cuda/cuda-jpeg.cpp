@@ -0,0 +1,97 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#ifdef RS2_USE_NVJPEG
+
+#include "cuda-jpeg.h"
+#include "cuda-device.h"
+
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <cuda_runtime.h>
+#include <nvjpeg.h>
+
+
+namespace librealsense {
+namespace cuda {
+
+
+namespace {
+
+
+// nvJPEG's handle and decoding state, with a stream to decode on, for one thread; made on the default device
+struct decoder
+{
+    int device = -1;
+    nvjpegHandle_t handle = nullptr;
+    nvjpegJpegState_t state = nullptr;
+    cudaStream_t stream = nullptr;
+    bool ok = false;
+
+    decoder()
+        : device( default_device() )
+    {
+        device_scope scope( device );
+        ok = nvjpegCreateSimple( &handle ) == NVJPEG_STATUS_SUCCESS
+          && nvjpegJpegStateCreate( handle, &state ) == NVJPEG_STATUS_SUCCESS
+          && cudaStreamCreateWithFlags( &stream, cudaStreamNonBlocking ) == cudaSuccess;
+        if( ! ok )
+            LOG_ERROR( "failed to initialize nvJPEG; decoding MJPEG on the CPU" );
+    }
+
+    ~decoder()
+    {
+        device_scope scope( device );
+        if( stream )
+            cudaStreamDestroy( stream );
+        if( state )
+            nvjpegJpegStateDestroy( state );
+        if( handle )
+            nvjpegDestroy( handle );
+    }
+};
+
+
+}  // namespace
+
+
+bool decode_jpeg( uint8_t * rgb, const uint8_t * jpeg, size_t size, int width, int height )
+{
+    thread_local decoder the_decoder;
+    auto & dec = the_decoder;
+    if( ! dec.ok )
+        return false;
+
+    device_scope scope( dec.device );
+
+    int components;
+    nvjpegChromaSubsampling_t subsampling;
+    int widths[NVJPEG_MAX_COMPONENT], heights[NVJPEG_MAX_COMPONENT];
+    if( nvjpegGetImageInfo( dec.handle, jpeg, size, &components, &subsampling, widths, heights )
+            != NVJPEG_STATUS_SUCCESS
+        || widths[0] != width || heights[0] != height )
+        return false;
+
+    // From the device's pool: the same buffer comes back frame after frame
+    size_t const rgb_size = size_t( width ) * height * 3;
+    auto d_rgb = memory_pool::of( dec.device )->allocate( rgb_size );
+
+    nvjpegImage_t image = {};
+    image.channel[0] = d_rgb.get();
+    image.pitch[0] = size_t( width ) * 3;
+    if( nvjpegDecode( dec.handle, dec.state, jpeg, size, NVJPEG_OUTPUT_RGBI, &image, dec.stream )
+        != NVJPEG_STATUS_SUCCESS )
+        return false;
+    if( cudaMemcpyAsync( rgb, d_rgb.get(), rgb_size, cudaMemcpyDeviceToHost, dec.stream ) != cudaSuccess
+        || cudaStreamSynchronize( dec.stream ) != cudaSuccess )
+    {
+        LOG_ERROR( "nvJPEG decode failed: " << cudaGetErrorString( cudaGetLastError() ) );
+        return false;
+    }
+    return true;
+}
+
+
+}  // namespace cuda
+}  // namespace librealsense
+
+#endif  // RS2_USE_NVJPEG
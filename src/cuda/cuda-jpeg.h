@@ -0,0 +1,24 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+#ifdef RS2_USE_NVJPEG
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace librealsense {
+namespace cuda {
+
+
+// Decodes a 'width' x 'height' JPEG into RGB8 with nvJPEG, on the context's default device. False when it can't (the
+// image isn't that size, or nvJPEG can't decode it), for the CPU to decode it.
+//
+// Each thread has a decoder of its own, so frames decoded on different threads overlap on the device.
+bool decode_jpeg( uint8_t * rgb, const uint8_t * jpeg, size_t size, int width, int height );
+
+
+}  // namespace cuda
+}  // namespace librealsense
+
+#endif  // RS2_USE_NVJPEG
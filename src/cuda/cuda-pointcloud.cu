@@ -1,6 +1,7 @@
 #ifdef RS2_USE_CUDA
 
 #include "cuda-pointcloud.cuh"
+#include "rscuda_utils.cuh"
 #include <iostream>
 #include <chrono>
 
@@ -61,55 +62,172 @@ void deproject_pixel_to_point_cuda(float points[3], const struct rs2_intrinsics
 __global__
 //void kernel_deproject_depth_cuda(float * points, const rs2_intrinsics & intrin, const uint16_t * depth, std::function<uint16_t(float)> map_depth)
 
-void kernel_deproject_depth_cuda(float * points, const rs2_intrinsics* intrin, const uint16_t * depth, float depth_scale)
+// 'points' and 'depth' start at pixel 'begin', and have 'count' pixels
+void kernel_deproject_depth_cuda(float * points, const rs2_intrinsics intrin, const uint16_t * depth, float depth_scale, int begin, int count,
+    const rscuda::points_bounds bounds, bool bounded)
 {
     int i = blockDim.x * blockIdx.x + threadIdx.x;
     
-    if (i >= (*intrin).height * (*intrin).width) {
+    if (i >= count) {
         return;
     }
     int stride = blockDim.x * gridDim.x;
     int a, b;
     
-    for (int j = i; j < (*intrin).height * (*intrin).width; j += stride) {
-        b = j / (*intrin).width;
-        a = j - b * (*intrin).width;
+    for (int j = i; j < count; j += stride) {
+        b = (begin + j) / intrin.width;
+        a = (begin + j) - b * intrin.width;
         const float pixel[] = { (float)a, (float)b };
-        deproject_pixel_to_point_cuda(points + j * 3, intrin, pixel, depth_scale * depth[j]);               
+        float * p = points + j * 3;
+        deproject_pixel_to_point_cuda(p, &intrin, pixel, depth_scale * depth[j]);
+        if (bounded && (p[0] < bounds.min[0] || p[0] > bounds.max[0] || p[1] < bounds.min[1] || p[1] > bounds.max[1]
+            || p[2] < bounds.min[2] || p[2] > bounds.max[2]))
+            p[0] = p[1] = p[2] = 0;
    }
 }
 
 
-void rscuda::deproject_depth_cuda(float * points, const rs2_intrinsics & intrin, const uint16_t * depth, float depth_scale)
+// Stream compaction of the points with depth, in three passes: each block counts its own, a scan turns the counts into
+// where each block starts (and, after them, the total), and each block then scatters its points from there
+
+__global__
+void kernel_count_valid_points(const float * points, int count, int * block_counts)
+{
+    int i = blockDim.x * blockIdx.x + threadIdx.x;
+    int n = __syncthreads_count(i < count && points[i * 3 + 2] != 0);
+    if (threadIdx.x == 0)
+        block_counts[blockIdx.x] = n;
+}
+
+// One thread: there are only as many counts as blocks, a few thousand at most
+__global__
+void kernel_scan_block_counts(int * block_counts, int blocks)
+{
+    int sum = 0;
+    for (int b = 0; b < blocks; ++b)
+    {
+        int n = block_counts[b];
+        block_counts[b] = sum;
+        sum += n;
+    }
+    block_counts[blocks] = sum;
+}
+
+__global__
+void kernel_pack_valid_points(float * packed, const float * points, int count, const int * block_offsets, int blocks)
+{
+    __shared__ int warp_offsets[RS2_CUDA_THREADS_PER_BLOCK / 32];
+
+    int i = blockDim.x * blockIdx.x + threadIdx.x;
+    bool valid = i < count && points[i * 3 + 2] != 0;
+    int lane = threadIdx.x & 31, warp = threadIdx.x >> 5;
+    unsigned ballot = __ballot_sync(0xffffffff, valid);
+    if (lane == 0)
+        warp_offsets[warp] = __popc(ballot);
+    __syncthreads();
+    if (threadIdx.x == 0)
+    {
+        int sum = 0;
+        for (int w = 0; w < RS2_CUDA_THREADS_PER_BLOCK / 32; ++w)
+        {
+            int n = warp_offsets[w];
+            warp_offsets[w] = sum;
+            sum += n;
+        }
+    }
+    __syncthreads();
+    if (!valid)
+        return;
+
+    int total = block_offsets[blocks];
+    int at = block_offsets[blockIdx.x] + warp_offsets[warp] + __popc(ballot & ((1u << lane) - 1));
+    packed[at] = points[i * 3];
+    packed[total + at] = points[i * 3 + 1];
+    packed[2 * total + at] = points[i * 3 + 2];
+    packed[3 * total + at] = 0;
+    packed[4 * total + at] = 0;
+}
+
+
+namespace
+{
+    // Each thread making pointclouds has its own streams and staging buffers
+    thread_local rscuda::pipelined_conversion deprojection;
+
+    // For deprojecting into device memory
+    thread_local std::shared_ptr<CUstream_st> device_stream;
+    thread_local rscuda::staging_buffer depth_staging;
+    thread_local int device_stream_device = -1;     // The device they're for
+
+    cudaStream_t get_device_stream()
+    {
+        int device = 0;
+        cudaGetDevice(&device);
+        if (device != device_stream_device)
+        {
+            device_stream.reset();
+            depth_staging = rscuda::staging_buffer();
+            device_stream_device = device;
+        }
+        if (!device_stream)
+            device_stream = rscuda::create_stream();
+        return device_stream.get();
+    }
+}
+
+
+void rscuda::deproject_depth_cuda(float * points, const rs2_intrinsics & intrin, const uint16_t * depth, float depth_scale, const points_bounds * bounds)
 {
+    const points_bounds box = bounds ? *bounds : points_bounds();
     int count = intrin.height * intrin.width;
-    int numBlocks = count / RS2_CUDA_THREADS_PER_BLOCK;
-    
-    float *dev_points = 0;	
-    uint16_t *dev_depth = 0;
-    rs2_intrinsics* dev_intrin = 0;
-    cudaError_t result;
-
-    result = cudaMalloc(&dev_points, count * sizeof(float) * 3);
-    assert(result == cudaSuccess);
-    result = cudaMalloc(&dev_depth, count * sizeof(uint16_t));
-    assert(result == cudaSuccess);
-    result = cudaMalloc(&dev_intrin, sizeof(rs2_intrinsics));
-    assert(result == cudaSuccess);
-       
-    result = cudaMemcpy(dev_depth, depth, count * sizeof(uint16_t), cudaMemcpyHostToDevice);
-    assert(result == cudaSuccess); 
-    result = cudaMemcpy(dev_intrin, &intrin, sizeof(rs2_intrinsics), cudaMemcpyHostToDevice);
-    assert(result == cudaSuccess); 
-     
-    kernel_deproject_depth_cuda<<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK>>>(dev_points, dev_intrin, dev_depth, depth_scale); 
-
-     result = cudaMemcpy(points, dev_points, count * sizeof(float) * 3, cudaMemcpyDeviceToHost);
-     assert(result == cudaSuccess);
-
-    cudaFree(dev_points);
-    cudaFree(dev_depth);
-    cudaFree(dev_intrin);
+    uint8_t* const dst[] = { reinterpret_cast<uint8_t*>(points) };
+
+    // The intrinsics go as a kernel argument, rather than as yet another copy to the device
+    deprojection.run(depth, sizeof(uint16_t), count, dst, { sizeof(float) * 3 },
+        [&](cudaStream_t stream, const uint8_t* d_depth, uint8_t* const d_points[], int begin, int n) {
+            kernel_deproject_depth_cuda<<<calc_blocks(n, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+                reinterpret_cast<float*>(d_points[0]), intrin, reinterpret_cast<const uint16_t*>(d_depth), depth_scale, begin, n,
+                box, bounds != nullptr);
+        });
+}
+
+
+void rscuda::deproject_depth_cuda_to_device(float * d_points, const rs2_intrinsics & intrin, const uint16_t * depth, bool depth_on_device, float depth_scale, const points_bounds * bounds)
+{
+    int count = intrin.height * intrin.width;
+    const points_bounds box = bounds ? *bounds : points_bounds();
+    cudaStream_t stream = get_device_stream();
+
+    const uint16_t * d_depth = depth;
+    if (!depth_on_device)
+    {
+        depth_staging.reserve(count * sizeof(uint16_t));
+        memcpy(depth_staging.host.get(), depth, count * sizeof(uint16_t));
+        cudaMemcpyAsync(depth_staging.dev.get(), depth_staging.host.get(), count * sizeof(uint16_t), cudaMemcpyHostToDevice, stream);
+        d_depth = reinterpret_cast<const uint16_t*>(depth_staging.dev.get());
+    }
+
+    kernel_deproject_depth_cuda<<<calc_blocks(count, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+        d_points, intrin, d_depth, depth_scale, 0, count, box, bounds != nullptr);
+    cudaStreamSynchronize(stream);
+}
+
+
+size_t rscuda::pack_points_cuda(float * d_packed, const float * d_points, int count)
+{
+    cudaStream_t stream = get_device_stream();
+    int blocks = calc_blocks(count, RS2_CUDA_THREADS_PER_BLOCK);
+    auto d_offsets = alloc_dev<int>(blocks + 1);
+
+    kernel_count_valid_points<<<blocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(d_points, count, d_offsets.get());
+    kernel_scan_block_counts<<<1, 1, 0, stream>>>(d_offsets.get(), blocks);
+    kernel_pack_valid_points<<<blocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(d_packed, d_points, count, d_offsets.get(), blocks);
+
+    // Only the count comes back: the points stay on the device until they're asked for
+    int total = 0;
+    cudaMemcpyAsync(&total, d_offsets.get() + blocks, sizeof(int), cudaMemcpyDeviceToHost, stream);
+    cudaStreamSynchronize(stream);
+    return size_t(total);
 }
 
 #endif
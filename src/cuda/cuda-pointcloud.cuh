@@ -23,7 +23,21 @@
 
 namespace rscuda
 {
-    void deproject_depth_cuda(float * points, const rs2_intrinsics & intrin, const uint16_t * depth, float depth_scale);
+    // With a box, the points outside it are left at zero, like the points without depth
+    struct points_bounds
+    {
+        float min[3];
+        float max[3];
+    };
+
+    void deproject_depth_cuda(float * points, const rs2_intrinsics & intrin, const uint16_t * depth, float depth_scale, const points_bounds * bounds = nullptr);
+
+    // The same, with the points left in device memory; 'depth' is on the host unless 'depth_on_device'
+    void deproject_depth_cuda_to_device(float * d_points, const rs2_intrinsics & intrin, const uint16_t * depth, bool depth_on_device, float depth_scale, const points_bounds * bounds = nullptr);
+
+    // Packs the points of 'd_points' that have depth into 'd_packed', both in device memory, in the order of their pixels
+    // and in RS2_POINTS_LAYOUT_PACKED_FLOAT, with zero texture coordinates. Returns how many there are.
+    size_t pack_points_cuda(float * d_packed, const float * d_points, int count);
 
 }
 
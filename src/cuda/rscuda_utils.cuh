@@ -4,6 +4,12 @@
 #include <stdexcept>
 #include <memory>
 #include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <initializer_list>
+#include <string>
+
+#include "cuda-device.h"
 
 // CUDA headers
 #include <cuda_runtime.h>
@@ -15,25 +21,161 @@
 
 namespace rscuda
 {
+    // Device memory of the current device, from its pool: released, it's kept for the next allocation of its size
     template<typename  T>
     std::shared_ptr<T> alloc_dev(int elements)
     {
-        T* d_data;
-        auto res = cudaMalloc(&d_data, sizeof(T) * elements);
+        auto buffer = librealsense::cuda::memory_pool::current()->allocate(sizeof(T) * elements);
+        return std::shared_ptr<T>(buffer, reinterpret_cast<T*>(buffer.get()));
+    }
+
+    // Page-locked host memory, which the device can copy to and from asynchronously
+    template<typename  T>
+    std::shared_ptr<T> alloc_host(int elements)
+    {
+        T* h_data;
+        auto res = cudaHostAlloc(&h_data, sizeof(T) * elements, cudaHostAllocDefault);
+        if (res != cudaSuccess)
+            throw std::runtime_error(std::string("cudaHostAlloc failed: ") + cudaGetErrorString(res));
+        return std::shared_ptr<T>(h_data, [](T* p) { cudaFreeHost(p); });
+    }
+
+    // Work on a stream of our own doesn't wait for (or hold up) work on other streams, like the default stream does
+    inline std::shared_ptr<CUstream_st> create_stream()
+    {
+        cudaStream_t stream;
+        auto res = cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
         if (res != cudaSuccess)
-            throw std::runtime_error("cudaMalloc failed status: " + res);
-        return std::shared_ptr<T>(d_data, [](T* p) { cudaFree(p); });
+            throw std::runtime_error(std::string("cudaStreamCreate failed: ") + cudaGetErrorString(res));
+        return std::shared_ptr<CUstream_st>(stream, [](cudaStream_t s) { cudaStreamDestroy(s); });
     }
 
+    inline std::shared_ptr<CUevent_st> create_event()
+    {
+        cudaEvent_t event;
+        auto res = cudaEventCreateWithFlags(&event, cudaEventDisableTiming);
+        if (res != cudaSuccess)
+            throw std::runtime_error(std::string("cudaEventCreate failed: ") + cudaGetErrorString(res));
+        return std::shared_ptr<CUevent_st>(event, [](cudaEvent_t e) { cudaEventDestroy(e); });
+    }
+
+    inline int calc_blocks(int count, int threads)
+    {
+        return (count + threads - 1) / threads;
+    }
+
+    // Pinned host memory and device memory of the same size, that only grows
+    struct staging_buffer
+    {
+        std::shared_ptr<uint8_t> host;
+        std::shared_ptr<uint8_t> dev;
+        size_t size = 0;
+
+        void reserve(size_t bytes)
+        {
+            if (bytes <= size)
+                return;
+            host = alloc_host<uint8_t>(int(bytes));
+            dev = alloc_dev<uint8_t>(int(bytes));
+            size = bytes;
+        }
+    };
+
+    // Runs an element-wise conversion on the device, as two halves on two streams of their own, each with its own
+    // staging: the host copies and transfers of one half overlap the kernel of the other.
+    //
+    // 'launch( stream, d_src, d_dst[], begin, count )' runs the kernel on 'count' elements: 'd_src' and the 'd_dst' are
+    // already offset to the first of them, 'begin' is its index in the whole. Each output 'i' has 'dst_bytes[i]' per
+    // element.
+    //
+    // Runs on the current device; the streams and staging are made again when that's another device than last time.
+    //
+    // Not thread-safe: have one per thread.
+    class pipelined_conversion
+    {
+    public:
+        template<class Launch>
+        void run(const void* src, size_t src_bytes, int count,
+                 uint8_t* const dst[], std::initializer_list<size_t> dst_bytes, Launch launch)
+        {
+            assert(dst_bytes.size() <= max_outputs);
+
+            int device = 0;
+            cudaGetDevice(&device);
+            if (device != _device)
+            {
+                for (auto & h : _halves)
+                    h = half();
+                _device = device;
+            }
+
+            size_t out_bytes = 0;
+            for (auto b : dst_bytes)
+                out_bytes += b;
+
+            int const half = (count + 1) / 2;
+            for (int i = 0; i < 2; ++i)
+            {
+                auto & h = _halves[i];
+                if (!h.stream)
+                    h.stream = create_stream();
+                h.begin = i * half;
+                h.count = std::max(0, std::min(half, count - h.begin));
+                if (!h.count)
+                    continue;
+
+                h.in.reserve(h.count * src_bytes);
+                h.out.reserve(h.count * out_bytes);
+                std::memcpy(h.in.host.get(), static_cast<const uint8_t*>(src) + h.begin * src_bytes, h.count * src_bytes);
+                cudaMemcpyAsync(h.in.dev.get(), h.in.host.get(), h.count * src_bytes, cudaMemcpyHostToDevice, h.stream.get());
+
+                uint8_t* d_dst[max_outputs];
+                size_t offset = 0, k = 0;
+                for (auto b : dst_bytes)
+                {
+                    d_dst[k++] = h.out.dev.get() + offset;
+                    offset += h.count * b;
+                }
+                launch(h.stream.get(), h.in.dev.get(), d_dst, h.begin, h.count);
+                auto result = cudaGetLastError();
+                assert(result == cudaSuccess);
+
+                cudaMemcpyAsync(h.out.host.get(), h.out.dev.get(), h.count * out_bytes, cudaMemcpyDeviceToHost, h.stream.get());
+            }
+
+            for (auto & h : _halves)
+            {
+                if (!h.count)
+                    continue;
+                cudaStreamSynchronize(h.stream.get());
+                size_t offset = 0, k = 0;
+                for (auto b : dst_bytes)
+                {
+                    std::memcpy(dst[k++] + h.begin * b, h.out.host.get() + offset, h.count * b);
+                    offset += h.count * b;
+                }
+            }
+        }
+
+    private:
+        static constexpr size_t max_outputs = 2;
+
+        struct half
+        {
+            std::shared_ptr<CUstream_st> stream;
+            staging_buffer in, out;
+            int begin = 0, count = 0;
+        };
+        half _halves[2];
+        int _device = -1;
+    };
+
     template<typename  T>
     std::shared_ptr<T> make_device_copy(T obj)
     {
-        T* d_data;
-        auto res = cudaMalloc(&d_data, sizeof(T));
-        if (res != cudaSuccess)
-            throw std::runtime_error("cudaMalloc failed status: " + res);
-        cudaMemcpy(d_data, &obj, sizeof(T), cudaMemcpyHostToDevice);
-        return std::shared_ptr<T>(d_data, [](T* data) { cudaFree(data); });
+        auto d_data = alloc_dev<T>(1);
+        cudaMemcpy(d_data.get(), &obj, sizeof(T), cudaMemcpyHostToDevice);
+        return d_data;
     }
 
     /* Given a point in 3D space, compute the corresponding pixel coordinates in an image with no distortion or forward distortion coefficients produced by the same camera */
@@ -5,6 +5,7 @@
 #include "rs-dds-option.h"
 
 #include <realdds/topics/dds-topic-names.h>
+#include <realdds/topics/metadata-msg.h>
 
 #include <src/librealsense-exception.h>
 #include <rsutils/json.h>
@@ -33,7 +34,15 @@ void dds_depth_sensor_proxy::add_no_metadata( frame * const f, streaming_impl &
 
 void dds_depth_sensor_proxy::add_frame_metadata( frame * const f, rsutils::json const & dds_md, streaming_impl & streaming )
 {
-    if( auto du = dds_md.nested( realdds::topics::metadata::key::header, realdds::topics::metadata::header::key::depth_units ) )
+    if( dds_md.is_binary() )
+    {
+        auto & bytes = dds_md.get_binary();
+        auto md = realdds::topics::metadata_msg::parse( bytes.data(), bytes.size() );
+        f->additional_data.depth_units = ( md->flags & realdds::topics::metadata_msg::HAS_DEPTH_UNITS )
+                                           ? md->depth_units
+                                           : get_depth_scale();
+    }
+    else if( auto du = dds_md.nested( realdds::topics::metadata::key::header, realdds::topics::metadata::header::key::depth_units ) )
     {
         try
         {
@@ -11,10 +11,12 @@
 #include <realdds/dds-trinsics.h>
 #include <realdds/dds-participant.h>
 #include <realdds/dds-topic-writer.h>
+#include <realdds/dds-video-codec.h>
 
 #include <realdds/topics/device-info-msg.h>
 #include <realdds/topics/flexible-msg.h>
 #include <realdds/topics/blob-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/topics/dds-topic-names.h>
 
 #include <src/stream.h>
@@ -47,6 +49,31 @@ static rs2_stream to_rs2_stream_type( std::string const & type_string )
 }
 
 
+// The server may offer compressed twins of its raw profiles (see realdds::dds_video_encoder), in whichever of the
+// encodings its settings chose. We only show one of each pair, so the formats converter has just the one way to each
+// format: the compressed, if the settings ask for it.
+static std::shared_ptr< realdds::dds_video_stream_profile >
+find_twin( realdds::dds_stream_profiles const & profiles,
+           realdds::dds_video_stream_profile const & profile,
+           bool compressed )
+{
+    auto encoding = compressed ? profile.encoding() : realdds::dds_video_encoder::raw( profile.encoding() );
+    if( ! encoding.is_valid() )
+        return {};
+    for( auto & p : profiles )
+    {
+        auto vp = std::dynamic_pointer_cast< realdds::dds_video_stream_profile >( p );
+        if( ! vp )
+            continue;
+        auto twin_encoding = compressed ? realdds::dds_video_encoder::raw( vp->encoding() ) : vp->encoding();
+        if( twin_encoding == encoding && vp->width() == profile.width() && vp->height() == profile.height()
+            && vp->frequency() == profile.frequency() )
+            return vp;
+    }
+    return {};
+}
+
+
 static rs2_video_stream to_rs2_video_stream( rs2_stream const stream_type,
                                              sid_index const & sidx,
                                              std::shared_ptr< realdds::dds_video_stream_profile > const & profile,
@@ -188,6 +215,9 @@ dds_device_proxy::dds_device_proxy( std::shared_ptr< const device_info > const &
     // need both the ID from that map key and the stream itself (for intrinsics information)
     std::map< sid_index, sid_index > type_and_index_to_dds_stream_sidx;
 
+    bool const compression
+        = _dds_dev->participant()->settings().nested( "device", "compression" ).default_value( false );
+
     _dds_dev->foreach_stream(
         [&]( std::shared_ptr< realdds::dds_stream > const & stream )
         {
@@ -223,9 +253,13 @@ dds_device_proxy::dds_device_proxy( std::shared_ptr< const device_info > const &
                 if( video_stream )
                 {
                     auto video_profile = std::static_pointer_cast< realdds::dds_video_stream_profile >( profile );
+                    if( find_twin( profiles, *video_profile, compression ) )
+                        continue;  // We show the other one
+                    // The default is always raw; a compressed twin stands in for it
+                    auto raw_twin = compression ? find_twin( profiles, *video_profile, false ) : nullptr;
                     auto raw_stream_profile = sensor.add_video_stream(
                         to_rs2_video_stream( stream_type, sidx, video_profile, video_stream->get_intrinsics() ),
-                        profile == default_profile );
+                        profile == default_profile || raw_twin == default_profile );
                     _stream_name_to_profiles[stream->name()].push_back( raw_stream_profile );
                 }
                 else if( motion_stream )
@@ -300,6 +334,16 @@ dds_device_proxy::dds_device_proxy( std::shared_ptr< const device_info > const &
         _metadata_subscription = _dds_dev->on_metadata_available(
             [this]( std::shared_ptr< const json > const & dds_md )
             {
+                if( dds_md->is_binary() )
+                {
+                    auto & bytes = dds_md->get_binary();
+                    auto stream_name = realdds::topics::metadata_msg::stream_name(
+                        realdds::topics::metadata_msg::parse( bytes.data(), bytes.size() ) );
+                    auto it = _stream_name_to_owning_sensor.find( stream_name );
+                    if( it != _stream_name_to_owning_sensor.end() )
+                        it->second->handle_new_metadata( stream_name, dds_md );
+                    return;
+                }
                 auto & stream_name = dds_md->nested( realdds::topics::metadata::key::stream_name ).string_ref();
                 auto it = _stream_name_to_owning_sensor.find( stream_name );
                 if( it != _stream_name_to_owning_sensor.end() )
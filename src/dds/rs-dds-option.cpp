@@ -113,6 +113,12 @@ bool rs_dds_option::is_enabled() const
 }
 
 
+rsutils::subscription rs_dds_option::on_value_changed( std::function< void() > && cb )
+{
+    return _dds_opt->on_value_changed( [cb]( json const & ) { cb(); } );
+}
+
+
 const char * rs_dds_option::get_description() const
 {
     return _dds_opt->get_description().c_str();
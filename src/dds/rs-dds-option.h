@@ -45,6 +45,8 @@ public:
 
     bool is_read_only() const override;
     bool is_enabled() const override;
+    // The device notifies of its option values as they change
+    rsutils::subscription on_value_changed( std::function< void() > && ) override;
     const char * get_description() const override;
     const char * get_value_description( float ) const override;
 };
@@ -12,15 +12,20 @@
 #include <realdds/topics/device-info-msg.h>
 #include <realdds/topics/image-msg.h>
 #include <realdds/topics/imu-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/topics/dds-topic-names.h>
 
 #include <src/core/options-registry.h>
 #include <src/core/frame-callback.h>
+#include <src/core/time-service.h>
 #include <src/stream.h>
 
 #include <src/proc/color-formats-converter.h>
+#include <src/proc/depth-formats-converter.h>
 
 #include <rsutils/json.h>
+
+#include <cstring>
 using rsutils::json;
 
 
@@ -136,10 +141,24 @@ void dds_sensor_proxy::register_basic_converters()
             RS2_FORMAT_YUYV,
             { RS2_FORMAT_YUYV, RS2_FORMAT_RGB8, RS2_FORMAT_Y8, RS2_FORMAT_RGBA8, RS2_FORMAT_BGR8, RS2_FORMAT_BGRA8 },
             RS2_STREAM_COLOR ) );
+    // Compressed by the server (see realdds::dds_video_encoder)
+    _formats_converter.register_converter( { { { RS2_FORMAT_MJPEG } },
+                                             { { RS2_FORMAT_RGB8, RS2_STREAM_COLOR } },
+                                             []() { return std::make_shared< mjpeg_converter >( RS2_FORMAT_RGB8 ); } } );
+    _formats_converter.register_converter( processing_block_factory::create_id_pbf( RS2_FORMAT_MJPEG, RS2_STREAM_COLOR ) );
 
     // Depth
     _formats_converter.register_converter(
         processing_block_factory::create_id_pbf( RS2_FORMAT_Z16, RS2_STREAM_DEPTH ) );
+    _formats_converter.register_converter( { { { RS2_FORMAT_Z16RVL } },
+                                             { { RS2_FORMAT_Z16, RS2_STREAM_DEPTH } },
+                                             []() { return std::make_shared< z16rvl_converter >(); } } );
+    _formats_converter.register_converter( { { { RS2_FORMAT_Z16_SPARSE } },
+                                             { { RS2_FORMAT_Z16, RS2_STREAM_DEPTH } },
+                                             []() { return std::make_shared< z16_sparse_converter >(); } } );
+    // Or as it is, for the blocks that read it in place (e.g., the pointcloud)
+    _formats_converter.register_converter(
+        processing_block_factory::create_id_pbf( RS2_FORMAT_Z16_SPARSE, RS2_STREAM_DEPTH ) );
 
     // Infrared (converter source needs type to be handled properly by formats_converter)
     _formats_converter.register_converter(
@@ -273,6 +292,7 @@ void dds_sensor_proxy::handle_video_data( realdds::topics::image_msg && dds_fram
                                           streaming_impl & streaming )
 {
     frame_additional_data data;  // with NO metadata by default!
+    data.system_time = time_service::get_time();  // arrival, from which the stream telemetry measures latency
     data.timestamp               // in ms
         = static_cast< rs2_time_t >( realdds::time_to_double( dds_frame.timestamp ) * 1e3 );
     data.timestamp_domain;  // from metadata, or leave default (hardware domain)
@@ -283,15 +303,27 @@ void dds_sensor_proxy::handle_video_data( realdds::topics::image_msg && dds_fram
     if( ! vid_profile )
         throw invalid_value_exception( "non-video profile provided to on_video_frame" );
 
-    auto stride = static_cast< int >( dds_frame.height > 0 ? dds_frame.raw_data.size() / dds_frame.height
-                                                           : dds_frame.raw_data.size() );
+    auto stride = static_cast< int >( dds_frame.height > 0 ? dds_frame.data_size() / dds_frame.height
+                                                           : dds_frame.data_size() );
     auto bpp = dds_frame.width > 0 ? stride / dds_frame.width : stride;
-    auto new_frame_interface = allocate_new_video_frame( vid_profile, stride, bpp, std::move( data ) );
+    // Unless it's in shared memory, the frame gets a buffer from the frame pool that we trade for the one realdds took
+    // the image into: realdds takes the next image into the pool buffer, so steady-state streaming doesn't allocate
+    auto const size = dds_frame.shared_data ? 0 : dds_frame.data_size();
+    auto new_frame_interface = allocate_new_video_frame( vid_profile, stride, bpp, std::move( data ), size );
     if( ! new_frame_interface )
         return;
 
     auto new_frame = static_cast< frame * >( new_frame_interface );
-    new_frame->data = std::move( dds_frame.raw_data );
+    if( dds_frame.shared_data )
+    {
+        // Right where the server put it, in shared memory: the slot is ours until the frame is let go
+        new_frame->external_size = dds_frame.data_size();
+        new_frame->external_data = std::const_pointer_cast< uint8_t >( std::move( dds_frame.shared_data ) );
+    }
+    else if( new_frame->external_data )
+        memcpy( new_frame->external_data.get(), dds_frame.raw_data.data(), size );  // From the frame allocator
+    else
+        new_frame->data.swap( dds_frame.raw_data );
 
     if( _md_enabled )
     {
@@ -312,6 +344,7 @@ void dds_sensor_proxy::handle_motion_data( realdds::topics::imu_msg && imu,
                                            streaming_impl & streaming )
 {
     frame_additional_data data;  // with NO metadata by default!
+    data.system_time = time_service::get_time();
     data.timestamp               // in ms
         = static_cast< rs2_time_t >( realdds::time_to_double( imu.timestamp() ) * 1e3 );
     data.timestamp_domain;  // leave default (hardware domain)
@@ -352,7 +385,15 @@ void dds_sensor_proxy::handle_new_metadata( std::string const & stream_name,
     auto it = _streaming_by_name.find( stream_name );
     if( it != _streaming_by_name.end() )
     {
-        if( auto timestamp = dds_md->nested( realdds::topics::metadata::key::header,
+        if( dds_md->is_binary() )
+        {
+            auto & bytes = dds_md->get_binary();
+            auto md = realdds::topics::metadata_msg::parse( bytes.data(), bytes.size() );
+            if( ! md )
+                throw std::runtime_error( "invalid binary metadata" );
+            it->second.syncer.enqueue_metadata( md->timestamp, dds_md );
+        }
+        else if( auto timestamp = dds_md->nested( realdds::topics::metadata::key::header,
                                              realdds::topics::metadata::header::key::timestamp ) )
             it->second.syncer.enqueue_metadata( timestamp.get< realdds::dds_nsec >(), dds_md );
         else
@@ -372,20 +413,18 @@ void dds_sensor_proxy::add_no_metadata( frame * const f, streaming_impl & stream
 }
 
 
-void dds_sensor_proxy::add_frame_metadata( frame * const f,
-                                           json const & dds_md,
-                                           streaming_impl & streaming )
+void dds_sensor_proxy::add_frame_number( frame * const f,
+                                         bool known,
+                                         unsigned long long frame_number,
+                                         streaming_impl & streaming )
 {
-    auto md_header = dds_md.nested( realdds::topics::metadata::key::header );
-    auto md = dds_md.nested( realdds::topics::metadata::key::metadata );
-
     // A frame number is "optional". If the server supplies it, we try to use it for the simple fact that,
     // otherwise, we have no way of detecting drops without some advanced heuristic tracking the FPS and
     // timestamps. If not supplied, we use an increasing counter.
     // Note that if we have no metadata, we have no frame-numbers! So we need a way of generating them
-    if( md_header.nested( realdds::topics::metadata::header::key::frame_number )
-            .get_ex( f->additional_data.frame_number ) )
+    if( known )
     {
+        f->additional_data.frame_number = frame_number;
         f->additional_data.last_frame_number = streaming.last_frame_number.exchange( f->additional_data.frame_number );
         if( f->additional_data.frame_number != f->additional_data.last_frame_number + 1
             && f->additional_data.last_frame_number )
@@ -399,6 +438,40 @@ void dds_sensor_proxy::add_frame_metadata( frame * const f,
         f->additional_data.last_frame_number = streaming.last_frame_number.fetch_add( 1 );
         f->additional_data.frame_number = f->additional_data.last_frame_number + 1;
     }
+}
+
+
+void dds_sensor_proxy::add_frame_metadata( frame * const f,
+                                           json const & dds_md,
+                                           streaming_impl & streaming )
+{
+    if( dds_md.is_binary() )
+    {
+        // Already validated when enqueued; the values are straight rs2_frame_metadata_value keys
+        auto & bytes = dds_md.get_binary();
+        auto md = realdds::topics::metadata_msg::parse( bytes.data(), bytes.size() );
+        add_frame_number( f, md->flags & realdds::topics::metadata_msg::HAS_FRAME_NUMBER, md->frame_number, streaming );
+        if( md->flags & realdds::topics::metadata_msg::HAS_TIMESTAMP_DOMAIN )
+            f->additional_data.timestamp_domain = static_cast< rs2_timestamp_domain >( md->timestamp_domain );
+
+        auto & metadata = reinterpret_cast< metadata_array & >( f->additional_data.metadata_blob );
+        auto values = realdds::topics::metadata_msg::values( md );
+        for( uint16_t i = 0; i < md->n_values; ++i )
+        {
+            // Keys that librealsense doesn't know are ignored, same as with JSON
+            if( values[i].key >= 0 && values[i].key < RS2_FRAME_METADATA_COUNT )
+                metadata[values[i].key] = { true, values[i].value };
+        }
+        return;
+    }
+
+    auto md_header = dds_md.nested( realdds::topics::metadata::key::header );
+    auto md = dds_md.nested( realdds::topics::metadata::key::metadata );
+
+    unsigned long long frame_number = 0;
+    bool const has_frame_number
+        = md_header.nested( realdds::topics::metadata::header::key::frame_number ).get_ex( frame_number );
+    add_frame_number( f, has_frame_number, frame_number, streaming );
 
     // Timestamp is already set in the frame - must be communicated in the metadata, but only for syncing
     // purposes, so we ignore here. The domain is optional, and really only rs-dds-adapter communicates it
@@ -504,9 +577,14 @@ void dds_sensor_proxy::stop()
         auto const & dds_stream = streamit->second;
 
         dds_stream->stop_streaming();
+        LOG_DEBUG( dds_stream->name() << " received: " << dds_stream->get_statistics().to_json() );
         dds_stream->close();
 
-        _streaming_by_name[dds_stream->name()].syncer.on_frame_ready( nullptr );
+        auto & syncer = _streaming_by_name[dds_stream->name()].syncer;
+        syncer.on_frame_ready( nullptr );
+        auto const stats = syncer.get_statistics();
+        LOG_DEBUG( dds_stream->name() << " metadata: " << stats.matched << " matched, " << stats.frames_without_metadata
+                                      << " frames without, " << stats.metadata_dropped << " dropped" );
 
         if( auto dds_video_stream = std::dynamic_pointer_cast< realdds::dds_video_stream >( dds_stream ) )
         {
@@ -104,7 +104,9 @@ protected:
                               std::shared_ptr< const rsutils::json > const & metadata );
 
     virtual void add_no_metadata( frame *, streaming_impl & );
+    // The metadata is either JSON or a JSON binary value holding a realdds::topics::metadata_msg (see dds_device)
     virtual void add_frame_metadata( frame *, rsutils::json const & metadata, streaming_impl & );
+    void add_frame_number( frame *, bool known, unsigned long long frame_number, streaming_impl & );
 
     friend class dds_device_proxy;  // Currently calls handle_new_metadata
 };
@@ -0,0 +1,80 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+
+namespace librealsense {
+
+
+// A conversion that writes the buffers of one or more frames (its planes), put off until the data of one of them is
+// first asked for (see frame::get_frame_data). The frames are handed on with their buffers, but not their data, and
+// the frames nobody looks at are never converted.
+// The conversion holds on to whatever it converts from, until it runs or all its frames are gone.
+class deferred_conversion
+{
+public:
+    typedef std::function< void( uint8_t * const planes[] ) > convert_function;
+
+    deferred_conversion( convert_function && convert, std::vector< uint8_t * > planes, std::vector< size_t > sizes )
+        : _convert( std::move( convert ) )
+        , _planes( std::move( planes ) )
+        , _sizes( std::move( sizes ) )
+        , _done( false )
+    {
+    }
+
+    bool is_done() const { return _done; }
+
+    // Converts, if it hasn't yet; frames are read from several threads, and all but the first wait for it
+    void run()
+    {
+        if( _done )
+            return;
+        std::lock_guard< std::mutex > lock( _mutex );
+        if( _done )
+            return;
+        if( _convert )
+        {
+            // The planes of frames that were released still have to be written somewhere
+            std::vector< std::vector< uint8_t > > scratch;
+            std::vector< uint8_t * > planes( _planes );
+            for( size_t i = 0; i < planes.size(); ++i )
+                if( ! planes[i] )
+                {
+                    scratch.emplace_back( _sizes[i] );
+                    planes[i] = scratch.back().data();
+                }
+            _convert( planes.data() );
+            _convert = nullptr;
+        }
+        _done = true;
+    }
+
+    // The frame of a plane is being released, and its buffer with it: the conversion mustn't write it anymore
+    void detach( size_t plane )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _planes[plane] = nullptr;
+        for( auto p : _planes )
+            if( p )
+                return;
+        _convert = nullptr;  // Nobody wants the data
+    }
+
+private:
+    std::mutex _mutex;
+    convert_function _convert;
+    std::vector< uint8_t * > _planes;
+    std::vector< size_t > _sizes;
+    std::atomic< bool > _done;
+};
+
+
+}  // namespace librealsense
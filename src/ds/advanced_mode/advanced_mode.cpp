@@ -5,6 +5,7 @@
 #include "json_loader.hpp"
 #include "ds/d400/d400-color.h"
 #include "ds/d500/d500-color.h"
+#include "auto-calibrated-device.h"
 
 #include <src/ds/features/amplitude-factor-feature.h>
 #include <src/ds/features/remove-ir-pattern-feature.h>
@@ -722,28 +723,185 @@ namespace librealsense
             throw wrong_api_call_sequence_exception( rsutils::string::from()
                                                      << "load_json(...) failed! Device is not in Advanced-Mode." );
 
-        auto p = get_all();
+        auto current = get_all();
+        auto p = current;
         update_structs(_depth_sensor.get_device(),  json_content, p);
-        set_all(p);
+        set_all(p, &current);
         _preset_opt->set(RS2_RS400_VISUAL_PRESET_CUSTOM);
     }
 
+    // The writable options of a sensor by their number; the visual preset is left out, as the snapshot has the values
+    // it would set
+    static json snapshot_options( const synthetic_sensor & sensor )
+    {
+        json options = json::object();
+        for( auto id : sensor.get_supported_options() )
+        {
+            if( id == RS2_OPTION_VISUAL_PRESET )
+                continue;
+            auto & opt = sensor.get_option( id );
+            if( opt.is_read_only() || ! opt.is_enabled() )
+                continue;
+            auto value = opt.get_value();
+            if( ! value.is_null() )
+                options[std::to_string( int( id ) )] = std::move( value );
+        }
+        return options;
+    }
+
+    static void load_snapshot_options( synthetic_sensor & sensor, json const & options )
+    {
+        for( auto it = options.begin(); it != options.end(); ++it )
+        {
+            auto id = rs2_option( std::stoi( it.key() ) );
+            if( ! sensor.supports_option( id ) )
+                continue;
+            auto & opt = sensor.get_option( id );
+            if( opt.is_read_only() || ! opt.is_enabled() || opt.get_value() == it.value() )
+                continue;
+            try
+            {
+                opt.set_value( it.value() );
+            }
+            catch( std::exception const & e )
+            {
+                // E.g., a manual exposure with auto-exposure on: as when a JSON sets it
+                LOG_WARNING( "Snapshot option " << get_string( id ) << " was not set: " << e.what() );
+            }
+        }
+    }
+
+    // The snapshot is CBOR: the preset structures as they are sent to the FW, in one binary field, and the options
+    // and calibration table of the device
+    //     { "version": 1, "product line": "D400", "preset": <bytes>, "depth": { "<option>": <value>, ... },
+    //       "color": { ... }, "calibration": <bytes> }
+    static const int SNAPSHOT_VERSION = 1;
+
+    std::vector<uint8_t> ds_advanced_mode_base::serialize_snapshot() const
+    {
+        if (!is_enabled())
+            throw wrong_api_call_sequence_exception( rsutils::string::from()
+                                                     << "serialize_snapshot() failed! Device is not in Advanced-Mode." );
+
+        auto p = get_all();
+        auto bytes = reinterpret_cast< const uint8_t * >( &p );
+        auto & dev = _depth_sensor.get_device();
+
+        json snapshot = json::object();
+        snapshot["version"] = SNAPSHOT_VERSION;
+        if( dev.supports_info( RS2_CAMERA_INFO_PRODUCT_LINE ) )
+            snapshot["product line"] = dev.get_info( RS2_CAMERA_INFO_PRODUCT_LINE );
+        snapshot["preset"] = json::binary( std::vector< uint8_t >( bytes, bytes + sizeof( p ) ) );
+        snapshot["depth"] = snapshot_options( _depth_sensor );
+        if( auto color = *_color_sensor )
+            snapshot["color"] = snapshot_options( *color );
+        if( auto calibrated = dynamic_cast< const auto_calibrated_interface * >( &dev ) )
+            snapshot["calibration"] = json::binary( calibrated->get_calibration_table() );
+        return json::to_cbor( snapshot );
+    }
+
+    void ds_advanced_mode_base::load_snapshot(const std::vector<uint8_t>& content)
+    {
+        if (!is_enabled())
+            throw wrong_api_call_sequence_exception( rsutils::string::from()
+                                                     << "load_snapshot(...) failed! Device is not in Advanced-Mode." );
+
+        json snapshot;
+        try
+        {
+            snapshot = json::from_cbor( content.begin(), content.end() );
+        }
+        catch( std::exception const & e )
+        {
+            throw invalid_value_exception( rsutils::string::from() << "Invalid snapshot: " << e.what() );
+        }
+        if( snapshot.nested( "version" ).default_value( 0 ) != SNAPSHOT_VERSION )
+            throw invalid_value_exception( "Unsupported snapshot version" );
+
+        auto & dev = _depth_sensor.get_device();
+        auto product_line = snapshot.nested( "product line" );
+        if( product_line && dev.supports_info( RS2_CAMERA_INFO_PRODUCT_LINE )
+            && product_line.string_ref_or_empty() != dev.get_info( RS2_CAMERA_INFO_PRODUCT_LINE ) )
+            throw invalid_value_exception( rsutils::string::from()
+                                           << "Snapshot of a " << product_line.string_ref_or_empty() << " device" );
+
+        auto binary = [&]( char const * key ) -> json::binary_t const *
+        {
+            auto it = snapshot.find( key );
+            return it != snapshot.end() && it->is_binary() ? &it->get_binary() : nullptr;
+        };
+        auto preset_bytes = binary( "preset" );
+        if( ! preset_bytes || preset_bytes->size() != sizeof( preset ) )
+            throw invalid_value_exception( "Snapshot is not of this version's advanced-mode preset" );
+
+        // The calibration first, and the controls last, so the options set on top of the preset are what's left
+        if( auto calibration = binary( "calibration" ) )
+        {
+            auto calibrated = dynamic_cast< auto_calibrated_interface * >( &dev );
+            if( calibrated && calibrated->get_calibration_table() != *calibration )
+                calibrated->set_calibration_table( *calibration );
+        }
+
+        auto current = get_all();
+        preset p;
+        memcpy( &p, preset_bytes->data(), sizeof( p ) );
+        set_all( p, &current );
+        _preset_opt->set( RS2_RS400_VISUAL_PRESET_CUSTOM );
+
+        load_snapshot_options( _depth_sensor, snapshot.nested( "depth" ).default_object() );
+        if( auto color = *_color_sensor )
+            load_snapshot_options( *color, snapshot.nested( "color" ).default_object() );
+    }
+
+    // Whether a group or control of the preset is to be written: with no current values, all are
+    template< class T >
+    static bool differs( const preset & p, const preset * current, T preset::*member )
+    {
+        return ! current || memcmp( &( p.*member ), &( current->*member ), sizeof( T ) ) != 0;
+    }
+
     preset ds_advanced_mode_base::get_all() const
     {
         preset p;
-        get_depth_control_group(&p.depth_controls);
-        get_rsm(&p.rsm);
-        get_rau_support_vector_control(&p.rsvc);
-        get_color_control(&p.color_control);
-        get_rau_color_thresholds_control(&p.rctc);
-        get_slo_color_thresholds_control(&p.sctc);
-        get_slo_penalty_control(&p.spc);
-        get_hdad(&p.hdad);
-        get_color_correction(&p.cc);
-        get_depth_table_control(&p.depth_table);
-        get_ae_control(&p.ae);
-        get_census_radius(&p.census);
-        get_amp_factor(&p.amplitude_factor);
+
+        // All the advanced-mode groups in one batch
+        std::vector< EtAdvancedModeRegGroup > groups = {
+            advanced_mode_traits< STDepthControlGroup >::group,
+            advanced_mode_traits< STRsm >::group,
+            advanced_mode_traits< STRauSupportVectorControl >::group,
+            advanced_mode_traits< STColorControl >::group,
+            advanced_mode_traits< STRauColorThresholdsControl >::group,
+            advanced_mode_traits< STSloColorThresholdsControl >::group,
+            advanced_mode_traits< STSloPenaltyControl >::group,
+            advanced_mode_traits< STHdad >::group,
+            advanced_mode_traits< STColorCorrection >::group,
+            advanced_mode_traits< STDepthTableControl >::group,
+            advanced_mode_traits< STAEControl >::group,
+            advanced_mode_traits< STCensusRadius >::group,
+        };
+        if( *_amplitude_factor_support )
+            groups.push_back( advanced_mode_traits< STAFactor >::group );
+        std::vector< std::vector< uint8_t > > batch;
+        for( auto group : groups )
+            batch.push_back( encode_command( ds::fw_cmd::GET_ADV, static_cast< uint32_t >( group ) ) );
+        auto results = send_receive( batch, std::chrono::milliseconds( 0 ) );
+        p.depth_controls = decode_get< STDepthControlGroup >( results[0] );
+        p.rsm = decode_get< STRsm >( results[1] );
+        p.rsvc = decode_get< STRauSupportVectorControl >( results[2] );
+        p.color_control = decode_get< STColorControl >( results[3] );
+        p.rctc = decode_get< STRauColorThresholdsControl >( results[4] );
+        p.sctc = decode_get< STSloColorThresholdsControl >( results[5] );
+        p.spc = decode_get< STSloPenaltyControl >( results[6] );
+        p.hdad = decode_get< STHdad >( results[7] );
+        p.cc = decode_get< STColorCorrection >( results[8] );
+        p.depth_table = decode_get< STDepthTableControl >( results[9] );
+        p.ae = decode_get< STAEControl >( results[10] );
+        p.census = decode_get< STCensusRadius >( results[11] );
+        if( *_amplitude_factor_support )
+            p.amplitude_factor = decode_get< STAFactor >( results[12] );
+        else
+            get_amp_factor( &p.amplitude_factor );
+
         get_laser_power(&p.laser_power);
         get_laser_state(&p.laser_state);
         get_depth_exposure(&p.depth_exposure);
@@ -766,67 +924,107 @@ namespace librealsense
         return p;
     }
 
-    void ds_advanced_mode_base::set_all( const preset & p )
+    void ds_advanced_mode_base::set_all( const preset & p, const preset * current )
     {
-        set_all_depth( p );
+        set_all_depth( p, current );
         if( should_set_rgb_preset() )
-            set_all_rgb( p );
+            set_all_rgb( p, current );
     }
 
-    void ds_advanced_mode_base::set_all_depth(const preset& p)
+    void ds_advanced_mode_base::set_all_depth( const preset & p, const preset * current )
     {
-        set(p.depth_controls, advanced_mode_traits<STDepthControlGroup>::group);
-        set(p.rsm           , advanced_mode_traits<STRsm>::group);
-        set(p.rsvc          , advanced_mode_traits<STRauSupportVectorControl>::group);
-        set(p.hdad          , advanced_mode_traits<STHdad>::group);
+        std::vector< std::vector< uint8_t > > batch;
+        auto add = [&]( const std::vector< uint8_t > & command, bool differ )
+        {
+            if( differ )
+                batch.push_back( command );
+        };
+        auto flush = [&]()
+        {
+            if( ! batch.empty() )
+                set( batch );
+            batch.clear();
+        };
+
+        // The groups go in batches, between the options they have to come before/after
+        add( encode_set( p.depth_controls, advanced_mode_traits< STDepthControlGroup >::group ), differs( p, current, &preset::depth_controls ) );
+        add( encode_set( p.rsm           , advanced_mode_traits< STRsm >::group ), differs( p, current, &preset::rsm ) );
+        add( encode_set( p.rsvc          , advanced_mode_traits< STRauSupportVectorControl >::group ), differs( p, current, &preset::rsvc ) );
+        add( encode_set( p.hdad          , advanced_mode_traits< STHdad >::group ), differs( p, current, &preset::hdad ) );
+        flush();
 
         // Setting auto-white-balance control before colorCorrection parameters
-        set_depth_auto_white_balance(p.depth_auto_white_balance);
-        set(p.cc            , advanced_mode_traits<STColorCorrection>::group);
+        if( differs( p, current, &preset::depth_auto_white_balance ) )
+            set_depth_auto_white_balance(p.depth_auto_white_balance);
 
-        set(p.depth_table   , advanced_mode_traits<STDepthTableControl>::group);
-        set(p.ae            , advanced_mode_traits<STAEControl>::group);
-        set(p.census        , advanced_mode_traits<STCensusRadius>::group);
+        add( encode_set( p.cc         , advanced_mode_traits< STColorCorrection >::group ), differs( p, current, &preset::cc ) );
+        add( encode_set( p.depth_table, advanced_mode_traits< STDepthTableControl >::group ), differs( p, current, &preset::depth_table ) );
+        add( encode_set( p.ae         , advanced_mode_traits< STAEControl >::group ), differs( p, current, &preset::ae ) );
+        add( encode_set( p.census     , advanced_mode_traits< STCensusRadius >::group ), differs( p, current, &preset::census ) );
         if (*_amplitude_factor_support)
-            set(p.amplitude_factor, advanced_mode_traits<STAFactor>::group);
-
-        set_laser_state(p.laser_state);
-        if (p.laser_state.was_set && p.laser_state.laser_state == 1) // 1 - on
+            add( encode_set( p.amplitude_factor, advanced_mode_traits< STAFactor >::group ), differs( p, current, &preset::amplitude_factor ) );
+        flush();
+
+        // What depends on a control that changed is written again, even where it's the same
+        const bool laser_state_differs = differs( p, current, &preset::laser_state );
+        if( laser_state_differs )
+            set_laser_state(p.laser_state);
+        if (p.laser_state.was_set && p.laser_state.laser_state == 1 // 1 - on
+            && ( laser_state_differs || differs( p, current, &preset::laser_power ) ) )
             set_laser_power(p.laser_power);
 
-        set_depth_auto_exposure(p.depth_auto_exposure);
+        const bool auto_exposure_differs = differs( p, current, &preset::depth_auto_exposure );
+        if( auto_exposure_differs )
+            set_depth_auto_exposure(p.depth_auto_exposure);
         if (p.depth_auto_exposure.was_set && p.depth_auto_exposure.auto_exposure == 0)
         {
-            set_depth_gain(p.depth_gain);
-            set_depth_exposure(p.depth_exposure);
+            if( auto_exposure_differs || differs( p, current, &preset::depth_gain ) )
+                set_depth_gain(p.depth_gain);
+            if( auto_exposure_differs || differs( p, current, &preset::depth_exposure ) )
+                set_depth_exposure(p.depth_exposure);
         }
 
         // Depth sensor related even though they have color in the name. Probably color from left IR imager.
-        set( p.color_control, advanced_mode_traits< STColorControl >::group );
-        set( p.rctc         , advanced_mode_traits< STRauColorThresholdsControl >::group );
-        set( p.sctc         , advanced_mode_traits< STSloColorThresholdsControl >::group );
-        set( p.spc          , advanced_mode_traits< STSloPenaltyControl >::group );
+        add( encode_set( p.color_control, advanced_mode_traits< STColorControl >::group ), differs( p, current, &preset::color_control ) );
+        add( encode_set( p.rctc         , advanced_mode_traits< STRauColorThresholdsControl >::group ), differs( p, current, &preset::rctc ) );
+        add( encode_set( p.sctc         , advanced_mode_traits< STSloColorThresholdsControl >::group ), differs( p, current, &preset::sctc ) );
+        add( encode_set( p.spc          , advanced_mode_traits< STSloPenaltyControl >::group ), differs( p, current, &preset::spc ) );
+        flush();
     }
 
-    void ds_advanced_mode_base::set_all_rgb( const preset & p )
+    void ds_advanced_mode_base::set_all_rgb( const preset & p, const preset * current )
     {
-        set_color_auto_exposure(p.color_auto_exposure);
+        const bool auto_exposure_differs = differs( p, current, &preset::color_auto_exposure );
+        if( auto_exposure_differs )
+            set_color_auto_exposure(p.color_auto_exposure);
         if (p.color_auto_exposure.was_set && p.color_auto_exposure.auto_exposure == 0)
         {
-            set_color_exposure(p.color_exposure);
-            set_color_gain(p.color_gain);
+            if( auto_exposure_differs || differs( p, current, &preset::color_exposure ) )
+                set_color_exposure(p.color_exposure);
+            if( auto_exposure_differs || differs( p, current, &preset::color_gain ) )
+                set_color_gain(p.color_gain);
         }
 
-        set_color_backlight_compensation(p.color_backlight_compensation);
-        set_color_brightness(p.color_brightness);
-        set_color_contrast(p.color_contrast);
-        set_color_gamma(p.color_gamma);
-        set_color_hue(p.color_hue);
-        set_color_saturation(p.color_saturation);
-        set_color_sharpness(p.color_sharpness);
-
-        set_color_auto_white_balance(p.color_auto_white_balance);
-        if (p.color_auto_white_balance.was_set && p.color_auto_white_balance.auto_white_balance == 0)
+        if( differs( p, current, &preset::color_backlight_compensation ) )
+            set_color_backlight_compensation(p.color_backlight_compensation);
+        if( differs( p, current, &preset::color_brightness ) )
+            set_color_brightness(p.color_brightness);
+        if( differs( p, current, &preset::color_contrast ) )
+            set_color_contrast(p.color_contrast);
+        if( differs( p, current, &preset::color_gamma ) )
+            set_color_gamma(p.color_gamma);
+        if( differs( p, current, &preset::color_hue ) )
+            set_color_hue(p.color_hue);
+        if( differs( p, current, &preset::color_saturation ) )
+            set_color_saturation(p.color_saturation);
+        if( differs( p, current, &preset::color_sharpness ) )
+            set_color_sharpness(p.color_sharpness);
+
+        const bool auto_white_balance_differs = differs( p, current, &preset::color_auto_white_balance );
+        if( auto_white_balance_differs )
+            set_color_auto_white_balance(p.color_auto_white_balance);
+        if (p.color_auto_white_balance.was_set && p.color_auto_white_balance.auto_white_balance == 0
+            && ( auto_white_balance_differs || differs( p, current, &preset::color_white_balance ) ) )
             set_color_white_balance(p.color_white_balance);
 
         // TODO: W/O due to a FW bug of power_line_frequency control on Windows OS
@@ -850,6 +1048,27 @@ namespace librealsense
         return res;
     }
 
+    std::vector< std::vector< uint8_t > >
+    ds_advanced_mode_base::send_receive( const std::vector< std::vector< uint8_t > > & batch,
+                                         std::chrono::milliseconds delay ) const
+    {
+        auto results = _hw_monitor->send( batch, delay );
+        for( auto & res : results )
+            if( res.empty() )
+                throw std::runtime_error( "Advanced mode write failed!" );
+        return results;
+    }
+
+    void ds_advanced_mode_base::set( const std::vector< std::vector< uint8_t > > & batch ) const
+    {
+        if( _blocked )
+            throw std::runtime_error( _block_message );
+
+        for( auto & results : send_receive( batch, set_delay() ) )
+            assert_no_error( ds::fw_cmd::SET_ADV, results );
+        std::this_thread::sleep_for( set_delay() );
+    }
+
     uint32_t ds_advanced_mode_base::pack(uint8_t c0, uint8_t c1, uint8_t c2, uint8_t c3)
     {
         return (c0 << 24) | (c1 << 16) | (c2 << 8) | c3;
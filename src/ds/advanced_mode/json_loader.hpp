@@ -124,6 +124,13 @@ namespace librealsense
         bool is_duplicated = false;
 
         virtual void load(const std::string& value) = 0;
+        // Numbers in the content, without going through their text
+        virtual void load(float value)
+        {
+            std::stringstream ss;
+            ss << value;
+            load(ss.str());
+        }
         virtual std::string save() const = 0;
     };
 
@@ -137,7 +144,11 @@ namespace librealsense
 
         void load(const std::string& str) override
         {
-            float value = static_cast<float>(::atof(str.c_str()));
+            load(static_cast<float>(::atof(str.c_str())));
+        }
+
+        void load(float value) override
+        {
             if (std::is_integral<S>::value) //in order to convert float to int correctly we add 0.5 and then use the floor function
                 value = std::floor(scale * value + 0.5f);
             else
@@ -159,6 +170,9 @@ namespace librealsense
         void load(const std::string& str) override
         {}
 
+        void load(float value) override
+        {}
+
         std::string save() const override
         {
             return "";
@@ -176,6 +190,7 @@ namespace librealsense
 
         std::map<std::string, float> _values;
 
+        using json_field::load;
         void load(const std::string& value) override
         {
             (strct->vals[0].*field) = static_cast<S>(_values[value]);
@@ -207,7 +222,11 @@ namespace librealsense
 
         void load(const std::string& str) override
         {
-            auto value = ::atof(str.c_str());
+            load(static_cast<float>(::atof(str.c_str())));
+        }
+
+        void load(float value) override
+        {
             (strct->vals[0].*field) = (value > 0) ? 0 : 1;
             strct->update = true;
         }
@@ -486,29 +505,22 @@ namespace librealsense
 
         preset_reader.check_device_info(dev);
 
-        auto parameters = preset_reader.get_params();
+        auto const & parameters = preset_reader.get_params();
         auto fields = initialize_field_parsers(p);
 
         for (auto it = parameters.begin(); it != parameters.end(); ++it)
         {
-            auto key = it.key();
-            auto value = it.value();
+            auto const & key = it.key();
+            auto const & value = it.value();
             auto kvp = fields.find(key);
             if (kvp != fields.end())
             {
                 try
                 {
                     if( ! value.is_string() )
-                    {
-                        float val = value;
-                        std::stringstream ss;
-                        ss << val;
-                        kvp->second->load(ss.str());
-                    }
+                        kvp->second->load(value.get<float>());
                     else
-                    {
-                        kvp->second->load(it.value());
-                    }
+                        kvp->second->load(value.string_ref());
                     kvp->second->was_set = true;
                 }
                 catch (...)
@@ -13,6 +13,12 @@
 
 #include <rsutils/string/from.h>
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 
 #undef UCAL_PROFILE
 #ifdef UCAL_PROFILE
@@ -1052,6 +1058,65 @@ namespace librealsense
         return res;
     }
 
+    // Counts the pixels of a row with depth in [min_depth, max_depth], and sums their depth
+    static void sum_valid_depth(const uint16_t* p, int count, uint16_t min_depth, uint16_t max_depth,
+                                int& counter, uint64_t& sum)
+    {
+        int i = 0;
+        uint32_t lanes_counter = 0;
+        uint64_t lanes_sum = 0;
+#if defined(__SSSE3__)
+        // No unsigned 16-bit comparisons before SSE4.1: the values are offset into the signed range instead
+        const __m128i offset = _mm_set1_epi16(short(0x8000));
+        const __m128i lo = _mm_set1_epi16(short(min_depth ^ 0x8000));
+        const __m128i hi = _mm_set1_epi16(short(max_depth ^ 0x8000));
+        const __m128i one = _mm_set1_epi16(1);
+        const __m128i zero = _mm_setzero_si128();
+        __m128i vcounter = zero, vsum = zero;    // 32-bit lanes
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i z = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            __m128i zs = _mm_xor_si128(z, offset);
+            __m128i outside = _mm_or_si128(_mm_cmplt_epi16(zs, lo), _mm_cmpgt_epi16(zs, hi));
+            vcounter = _mm_add_epi32(vcounter, _mm_madd_epi16(_mm_andnot_si128(outside, one), one));
+            z = _mm_andnot_si128(outside, z);
+            vsum = _mm_add_epi32(vsum, _mm_add_epi32(_mm_unpacklo_epi16(z, zero), _mm_unpackhi_epi16(z, zero)));
+        }
+        alignas(16) uint32_t lanes[2][4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes[0]), vcounter);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes[1]), vsum);
+        for (int n = 0; n < 4; ++n)
+        {
+            lanes_counter += lanes[0][n];
+            lanes_sum += lanes[1][n];
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        const uint16x8_t lo = vdupq_n_u16(min_depth);
+        const uint16x8_t hi = vdupq_n_u16(max_depth);
+        uint32x4_t vcounter = vdupq_n_u32(0), vsum = vdupq_n_u32(0);
+        for (; i + 8 <= count; i += 8)
+        {
+            uint16x8_t z = vld1q_u16(p + i);
+            uint16x8_t inside = vandq_u16(vcgeq_u16(z, lo), vcleq_u16(z, hi));
+            vcounter = vpadalq_u16(vcounter, vshrq_n_u16(inside, 15));
+            vsum = vpadalq_u16(vsum, vandq_u16(z, inside));
+        }
+        lanes_counter = vaddvq_u32(vcounter);
+        lanes_sum = vgetq_lane_u32(vsum, 0) + uint64_t(vgetq_lane_u32(vsum, 1))
+                  + vgetq_lane_u32(vsum, 2) + uint64_t(vgetq_lane_u32(vsum, 3));
+#endif
+        counter += int(lanes_counter);
+        sum += lanes_sum;
+        for (; i < count; ++i)
+        {
+            if (p[i] >= min_depth && p[i] <= max_depth)
+            {
+                ++counter;
+                sum += p[i];
+            }
+        }
+    }
+
     uint16_t auto_calibrated::calc_fill_rate(const rs2_frame* f)
     {
         auto frame = ((video_frame*)f);
@@ -1076,22 +1141,15 @@ namespace librealsense
         p += from * width + roi_start_w;
 
         int counter(0);
+        uint64_t sum(0);
         for (int j = from; j < to; ++j)
         {
-            for (int i = 0; i < roi_w; ++i)
-            {
-#ifdef SAVE_RAW_IMAGE
-                cropped_image[cropped_idx] = (*p);
-                cropped_idx++;
-#endif
-                if ((*p) >= _min_valid_depth && (*p) <= _max_valid_depth)
-                    ++counter;
-                ++p;
-            }
-            p += (width - roi_w);
 #ifdef SAVE_RAW_IMAGE
-            cropped_idx += (width - roi_w);
+            std::copy(p, p + roi_w, cropped_image.begin() + cropped_idx);
+            cropped_idx += width;
 #endif
+            sum_valid_depth(p, roi_w, _min_valid_depth, _max_valid_depth, counter, sum);
+            p += width;
         }
 #ifdef SAVE_RAW_IMAGE
         {
@@ -1240,26 +1298,17 @@ namespace librealsense
 
         p += roi_start_h * width + roi_start_w;
 
+        uint64_t sum(0);
         for (int j = 0; j < roi_h; ++j)
         {
-            for (int i = 0; i < roi_w; ++i)
-            {
-#ifdef SAVE_RAW_IMAGE
-                cropped_image[cropped_idx] = (*p);
-                cropped_idx++;
-#endif
-                if ((*p) >= _min_valid_depth && (*p) <= _max_valid_depth)
-                {
-                    ++_collected_counter;
-                    _collected_sum += *p;
-                }
-                ++p;
-            }
-            p += (width- roi_w);
 #ifdef SAVE_RAW_IMAGE
-            cropped_idx += (width - roi_w);
+            std::copy(p, p + roi_w, cropped_image.begin() + cropped_idx);
+            cropped_idx += width;
 #endif
+            sum_valid_depth(p, roi_w, _min_valid_depth, _max_valid_depth, _collected_counter, sum);
+            p += width;
         }
+        _collected_sum += static_cast<double>(sum);
 #ifdef SAVE_RAW_IMAGE
         {
             unsigned long milliseconds_since_epoch =
@@ -1382,7 +1431,8 @@ namespace librealsense
                     }
 #endif
 
-                    static const int FRAMES_TO_SKIP(_interactive_scan ? 1 : 0);
+                    // Not static: it'd be of whichever device got here first
+                    const int FRAMES_TO_SKIP(_interactive_scan ? 1 : 0);
                     int fw_host_offset = (_interactive_scan ? 0 : 1);
 
                     if (frame_counter + fw_host_offset < _total_frames)
@@ -50,7 +50,11 @@ namespace librealsense
 
         _color_calib_table_raw = [this]()
         {
-            return get_d400_raw_calibration_table(d400_calibration_table_id::rgb_calibration_id);
+            auto read = [this]() { return get_d400_raw_calibration_table( d400_calibration_table_id::rgb_calibration_id ); };
+            // With thermal compensation, the table changes with temperature and must be read every time
+            if( val_in_range( _pid, { ds::RS455_PID } ) )
+                return read();
+            return get_cached_calibration_table( "rgb", read );
         };
 
         _color_extrinsic = std::make_shared< rsutils::lazy< rs2_extrinsics > >(
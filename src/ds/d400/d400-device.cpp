@@ -86,7 +86,10 @@ namespace librealsense
 
     std::vector<uint8_t> d400_device::send_receive_raw_data(const std::vector<uint8_t>& input)
     {
-        return _hw_monitor->send(input);
+        auto res = _hw_monitor->send(input);
+        if( _calib_cache && ds::calibration_cache::is_calibration_write( input ) )
+            _calib_cache->clear();
+        return res;
     }
     
     std::vector<uint8_t> d400_device::build_command(uint32_t opcode,
@@ -307,7 +310,7 @@ namespace librealsense
             set_frame_metadata_modifier([&](frame_additional_data& data) {data.depth_units = _depth_units.load(); });
         }
 
-        void init_hdr_config(const option_range& exposure_range, const option_range& gain_range)
+        void init_hdr_config( std::function< option_range() > exposure_range, std::function< option_range() > gain_range )
         {
             _hdr_cfg = std::make_shared<hdr_config>(*(_owner->_hw_monitor), get_raw_sensor(),
                 exposure_range, gain_range);
@@ -417,6 +420,29 @@ namespace librealsense
         return _hw_monitor->send(cmd);
     }
 
+    std::vector< uint8_t >
+    d400_device::get_cached_calibration_table( std::string const & name,
+                                               std::function< std::vector< uint8_t >() > const & read ) const
+    {
+        if( _calib_cache )
+            return _calib_cache->get( name, read );
+        return read();
+    }
+
+    void d400_device::write_calibration() const
+    {
+        auto_calibrated::write_calibration();
+        if( _calib_cache )
+            _calib_cache->clear();
+    }
+
+    void d400_device::reset_to_factory_calibration() const
+    {
+        auto_calibrated::reset_to_factory_calibration();
+        if( _calib_cache )
+            _calib_cache->clear();
+    }
+
     std::vector<uint8_t> d400_device::get_new_calibration_table() const
     {
         if (_fw_version >= firmware_version("5.11.9.5"))
@@ -531,7 +557,11 @@ namespace librealsense
 
         _color_calib_table_raw = [this]()
         {
-            return get_d400_raw_calibration_table(d400_calibration_table_id::rgb_calibration_id);
+            auto read = [this]() { return get_d400_raw_calibration_table( d400_calibration_table_id::rgb_calibration_id ); };
+            // With thermal compensation, the table changes with temperature and must be read every time
+            if( val_in_range( _pid, { ds::RS455_PID } ) )
+                return read();
+            return get_cached_calibration_table( "rgb", read );
         };
 
         if (((hw_mon_over_xu) && (RS400_IMU_PID != _pid)) || (!group.usb_devices.size()))
@@ -571,8 +601,15 @@ namespace librealsense
         register_stream_to_extrinsic_group(*_left_ir_stream, 0);
         register_stream_to_extrinsic_group(*_right_ir_stream, 0);
 
-        _coefficients_table_raw = [this]() { return get_d400_raw_calibration_table(d400_calibration_table_id::coefficients_table_id); };
-        _new_calib_table_raw = [this]() { return get_new_calibration_table(); };
+        _coefficients_table_raw = [this]()
+        {
+            return get_cached_calibration_table( "coefficients", [this]() {
+                return get_d400_raw_calibration_table( d400_calibration_table_id::coefficients_table_id ); } );
+        };
+        _new_calib_table_raw = [this]()
+        {
+            return get_cached_calibration_table( "rec-params", [this]() { return get_new_calibration_table(); } );
+        };
 
         std::string device_name = (rs400_sku_names.end() != rs400_sku_names.find(_pid)) ? rs400_sku_names.at(_pid) : "RS4xx";
 
@@ -596,6 +633,7 @@ namespace librealsense
             _ds_device_common->get_fw_details( gvd_buff, optic_serial, asic_serial, fwv );
 
             _fw_version = firmware_version(fwv);
+            _calib_cache = ds::calibration_cache::create( ctx->get_settings(), optic_serial, fwv );
 
             _recommended_fw_version = firmware_version(D4XX_RECOMMENDED_FIRMWARE_VERSION);
             if (_fw_version >= firmware_version("5.10.4.0"))
@@ -615,6 +653,8 @@ namespace librealsense
                     usb_modality = false;
             }
 
+            // Z16H goes out as it comes: the format is deprecated, and so is its decoder (see
+            // rs2_create_huffman_depth_decompress_block), so there's no Z16 to convert it to on the host
             if (_fw_version >= firmware_version("5.12.1.1"))
             {
                 depth_sensor.register_processing_block(processing_block_factory::create_id_pbf(RS2_FORMAT_Z16H, RS2_STREAM_DEPTH));
@@ -689,6 +729,8 @@ namespace librealsense
                         error_control,
                         raw_depth_sensor->get_notifications_processor(),
                         std::make_shared< ds_notification_decoder >( d400_fw_error_report ) );
+                    _polling_error_handler->poll_on_change( raw_depth_sensor->get_uvc_device(), depth_xu.unit,
+                                                            DS5_ERROR_REPORTING );
 
                     depth_sensor.register_option(RS2_OPTION_ERROR_POLLING_ENABLED, std::make_shared<polling_errors_disable>(_polling_error_handler));
                 }
@@ -732,9 +774,9 @@ namespace librealsense
                 depth_xu,
                 DS5_EXPOSURE,
                 "Depth Exposure (usec)");
-            option_range exposure_range = uvc_xu_exposure_option->get_range();
+            auto exposure_range = [uvc_xu_exposure_option]() { return uvc_xu_exposure_option->get_range(); };
             auto uvc_pu_gain_option = std::make_shared<uvc_pu_option>( raw_depth_sensor, RS2_OPTION_GAIN);
-            option_range gain_range = uvc_pu_gain_option->get_range();
+            auto gain_range = [uvc_pu_gain_option]() { return uvc_pu_gain_option->get_range(); };
 
             //AUTO EXPOSURE
             auto enable_auto_exposure = std::make_shared<uvc_xu_option<uint8_t>>( raw_depth_sensor,
@@ -16,6 +16,7 @@
 #include "d400-options.h"
 
 #include "ds/ds-device-common.h"
+#include "ds/ds-calib-cache.h"
 #include "backend-device.h"
 
 namespace librealsense
@@ -67,11 +68,18 @@ namespace librealsense
         void update_flash(const std::vector<uint8_t>& image, rs2_update_progress_callback_sptr callback, int update_mode) override;
         bool check_fw_compatibility(const std::vector<uint8_t>& image) const override;
 
+        // auto_calibrated
+        void write_calibration() const override;
+        void reset_to_factory_calibration() const override;
+
     protected:
         std::shared_ptr<ds_device_common> _ds_device_common;
 
         std::vector<uint8_t> get_d400_raw_calibration_table(ds::d400_calibration_table_id table_id) const;
         std::vector<uint8_t> get_new_calibration_table() const;
+        // Through the calibration cache, if there is one
+        std::vector< uint8_t > get_cached_calibration_table( std::string const & name,
+                                                             std::function< std::vector< uint8_t >() > const & read ) const;
 
         bool is_camera_in_advanced_mode() const;
 
@@ -105,6 +113,7 @@ namespace librealsense
 
         rsutils::lazy< std::vector< uint8_t > > _coefficients_table_raw;
         rsutils::lazy< std::vector< uint8_t > > _new_calib_table_raw;
+        std::shared_ptr< ds::calibration_cache > _calib_cache;
 
         std::shared_ptr<polling_error_handler> _polling_error_handler;
         std::shared_ptr<d400_thermal_monitor> _thermal_monitor;
@@ -83,11 +83,15 @@ namespace librealsense
         // For FW >=5.16 the scale factor changed to 0.0001 to support higher resolution (diff between two adjacent samples)
         double gyro_scale_factor = _fw_version >= firmware_version( 5, 16, 0, 0 ) ? 0.0001 : 0.1 ;
 
+        auto history = motion_ep->get_motion_history();
         motion_ep->register_processing_block(
             { {RS2_FORMAT_MOTION_XYZ32F} },
             { {RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_ACCEL}, {RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_GYRO} },
-            [&, mm_correct_opt, gyro_scale_factor]()
-            { return std::make_shared< motion_to_accel_gyro >( _mm_calib, mm_correct_opt, gyro_scale_factor );
+            [&, mm_correct_opt, gyro_scale_factor, history]()
+            {
+                auto transform = std::make_shared< motion_to_accel_gyro >( _mm_calib, mm_correct_opt, gyro_scale_factor );
+                transform->set_motion_history( history );
+                return transform;
         });
 
         return motion_ep;
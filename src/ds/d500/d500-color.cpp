@@ -52,7 +52,8 @@ namespace librealsense
 
         _color_calib_table_raw = [this]()
         {
-            return get_d500_raw_calibration_table(d500_calibration_table_id::rgb_calibration_id);
+            return get_cached_calibration_table( "rgb", [this]() {
+                return get_d500_raw_calibration_table( d500_calibration_table_id::rgb_calibration_id ); } );
         };
 
         _color_extrinsic = std::make_shared< rsutils::lazy< rs2_extrinsics > >(
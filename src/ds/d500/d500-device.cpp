@@ -75,7 +75,10 @@ namespace librealsense
 
     std::vector<uint8_t> d500_device::send_receive_raw_data(const std::vector<uint8_t>& input)
     {
-        return _hw_monitor->send(input);
+        auto res = _hw_monitor->send(input);
+        if( _calib_cache && ds::calibration_cache::is_calibration_write( input ) )
+            _calib_cache->clear();
+        return res;
     }
     
     std::vector<uint8_t> d500_device::build_command(uint32_t opcode,
@@ -285,6 +288,15 @@ namespace librealsense
         return _hw_monitor->send(cmd);
     }
 
+    std::vector< uint8_t >
+    d500_device::get_cached_calibration_table( std::string const & name,
+                                               std::function< std::vector< uint8_t >() > const & read ) const
+    {
+        if( _calib_cache )
+            return _calib_cache->get( name, read );
+        return read();
+    }
+
     std::vector<uint8_t> d500_device::get_new_calibration_table() const // to be d500 adapted
     {
         command cmd(ds::RECPARAMSGET);
@@ -381,7 +393,8 @@ namespace librealsense
 
         _color_calib_table_raw = [this]()
         {
-            return get_d500_raw_calibration_table(d500_calibration_table_id::rgb_calibration_id);
+            return get_cached_calibration_table( "rgb", [this]() {
+                return get_d500_raw_calibration_table( d500_calibration_table_id::rgb_calibration_id ); } );
         };
 
         if (hw_mon_over_xu || (!group.usb_devices.size()))
@@ -418,8 +431,15 @@ namespace librealsense
         register_stream_to_extrinsic_group(*_left_ir_stream, 0);
         register_stream_to_extrinsic_group(*_right_ir_stream, 0);
 
-        _coefficients_table_raw = [this]() { return get_d500_raw_calibration_table(d500_calibration_table_id::depth_calibration_id); };
-        _new_calib_table_raw = [this]() { return get_new_calibration_table(); };
+        _coefficients_table_raw = [this]()
+        {
+            return get_cached_calibration_table( "depth", [this]() {
+                return get_d500_raw_calibration_table( d500_calibration_table_id::depth_calibration_id ); } );
+        };
+        _new_calib_table_raw = [this]()
+        {
+            return get_cached_calibration_table( "rec-params", [this]() { return get_new_calibration_table(); } );
+        };
 
         std::string device_name = (rs500_sku_names.end() != rs500_sku_names.find(_pid)) ? rs500_sku_names.at(_pid) : "RS5xx";
 
@@ -438,6 +458,9 @@ namespace librealsense
 
             _hw_monitor->get_gvd(gvd_buff.size(), gvd_buff.data(), ds::fw_cmd::GVD);
             get_gvd_details(gvd_buff, &gvd_parsed_fields);
+            _calib_cache = ds::calibration_cache::create( ctx->get_settings(),
+                                                          gvd_parsed_fields.optical_module_sn,
+                                                          gvd_parsed_fields.fw_version );
             
             _device_capabilities = ds_caps::CAP_ACTIVE_PROJECTOR | ds_caps::CAP_RGB_SENSOR | ds_caps::CAP_IMU_SENSOR |
                 ds_caps::CAP_BMI_085 | ds_caps::CAP_GLOBAL_SHUTTER | ds_caps::CAP_INTERCAM_HW_SYNC;
@@ -454,6 +477,7 @@ namespace librealsense
 
             _is_symmetrization_enabled = check_symmetrization_enabled();
 
+            // As for the D400: Z16H is deprecated and goes out undecoded
             depth_sensor.register_processing_block(processing_block_factory::create_id_pbf(RS2_FORMAT_Z16H, RS2_STREAM_DEPTH));
 
             depth_sensor.register_processing_block(
@@ -549,6 +573,9 @@ namespace librealsense
                 error_control,
                 raw_depth_sensor->get_notifications_processor(),
                 std::make_shared< ds_notification_decoder >( d500_fw_error_report ) );
+            _polling_error_handler->poll_on_change( raw_depth_sensor->get_uvc_device(),
+                                                    depth_xu.unit,
+                                                    DS5_ERROR_REPORTING );
 
             depth_sensor.register_option( RS2_OPTION_ERROR_POLLING_ENABLED,
                                           std::make_shared< polling_errors_disable >( _polling_error_handler ) );
@@ -17,6 +17,7 @@
 #include "ds/ds-options.h"
 
 #include "ds/ds-device-common.h"
+#include "ds/ds-calib-cache.h"
 #include "backend-device.h"
 
 #include <rsutils/lazy.h>
@@ -79,6 +80,9 @@ namespace librealsense
 
         std::vector<uint8_t> get_d500_raw_calibration_table(ds::d500_calibration_table_id table_id) const;
         std::vector<uint8_t> get_new_calibration_table() const;
+        // Through the calibration cache, if there is one
+        std::vector< uint8_t > get_cached_calibration_table( std::string const & name,
+                                                             std::function< std::vector< uint8_t >() > const & read ) const;
 
         bool is_camera_in_advanced_mode() const;
 
@@ -111,6 +115,7 @@ namespace librealsense
 
         rsutils::lazy< std::vector< uint8_t > > _coefficients_table_raw;
         rsutils::lazy< std::vector< uint8_t > > _new_calib_table_raw;
+        std::shared_ptr< ds::calibration_cache > _calib_cache;
 
         std::shared_ptr<polling_error_handler> _polling_error_handler;
         std::shared_ptr<d400_thermal_monitor> _thermal_monitor;
@@ -0,0 +1,147 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "ds-calib-cache.h"
+#include "ds-private.h"
+
+#include <rsutils/json-config.h>
+#include <rsutils/number/crc32.h>
+#include <rsutils/os/special-folder.h>
+#include <rsutils/string/hexarray.h>
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <cstdio>
+#include <fstream>
+
+
+namespace librealsense
+{
+    namespace ds
+    {
+        std::shared_ptr< calibration_cache > calibration_cache::create( rsutils::json const & settings,
+                                                                        std::string const & serial,
+                                                                        std::string const & fw_version )
+        {
+            auto setting = settings.nested( std::string( "calibration-cache", 17 ) );
+            if( ! setting || serial.empty() )
+                return nullptr;
+
+            std::string folder;
+            if( setting.is_string() )
+            {
+                folder = setting.string_ref();
+                if( ! folder.empty() && folder.back() != '/' && folder.back() != '\\' )
+                    folder += '/';
+            }
+            else if( ! setting.default_value( false ) )
+                return nullptr;
+            else
+                folder = rsutils::os::get_special_folder( rsutils::os::special_folder::app_data );
+
+            return std::make_shared< calibration_cache >( folder + "realsense-calib-" + serial + ".json", fw_version );
+        }
+
+        calibration_cache::calibration_cache( std::string filename, std::string fw_version )
+            : _filename( std::move( filename ) )
+            , _fw_version( std::move( fw_version ) )
+            , _tables( rsutils::json::object() )
+        {
+            try
+            {
+                auto j = rsutils::json_config::load_from_file( _filename );
+                if( j.nested( "firmware-version" ).default_value( std::string() ) == _fw_version )
+                {
+                    if( auto tables = j.nested( "tables" ) )
+                        _tables = tables;
+                }
+                else if( ! j.is_discarded() )
+                    LOG_DEBUG( "calibration cache " << _filename << " is for different firmware; ignoring" );
+            }
+            catch( std::exception const & e )
+            {
+                LOG_DEBUG( "failed to load calibration cache: " << e.what() );
+            }
+        }
+
+        std::vector< uint8_t > calibration_cache::get( std::string const & table,
+                                                       std::function< std::vector< uint8_t >() > const & read )
+        {
+            {
+                std::lock_guard< std::mutex > lock( _mutex );
+                if( auto cached = _tables.nested( table ) )
+                {
+                    try
+                    {
+                        auto bytes = cached.nested( "data" ).get< rsutils::string::hexarray >().detach();
+                        if( ! bytes.empty()
+                            && cached.nested( "crc" ).get< uint32_t >()
+                                   == rsutils::number::calc_crc32( bytes.data(), bytes.size() ) )
+                            return bytes;
+                    }
+                    catch( std::exception const & )
+                    {
+                    }
+                    LOG_DEBUG( "calibration cache '" << table << "' is corrupt; reading it again" );
+                }
+            }
+
+            auto bytes = read();
+            if( bytes.empty() )
+                return bytes;  // Nothing worth keeping
+
+            std::lock_guard< std::mutex > lock( _mutex );
+            _tables[table] = rsutils::json::object(
+                { { "crc", rsutils::number::calc_crc32( bytes.data(), bytes.size() ) },
+                  { "data", rsutils::string::hexarray::to_string( bytes ) } } );
+            save();
+            return bytes;
+        }
+
+        void calibration_cache::clear()
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _tables = rsutils::json::object();
+            if( std::remove( _filename.c_str() ) == 0 )
+                LOG_DEBUG( "calibration cache " << _filename << " removed" );
+        }
+
+        void calibration_cache::save() const
+        {
+            // Written whole and renamed into place, so another process never sees half a file
+            auto const tmp = _filename + ".tmp";
+            {
+                std::ofstream f( tmp, std::ios::trunc );
+                f << rsutils::json::object( { { "firmware-version", _fw_version }, { "tables", _tables } } ).dump();
+                if( ! f.good() )
+                {
+                    LOG_DEBUG( "failed to write calibration cache " << tmp );
+                    return;
+                }
+            }
+            std::remove( _filename.c_str() );  // Windows won't rename over it
+            if( std::rename( tmp.c_str(), _filename.c_str() ) != 0 )
+                LOG_DEBUG( "failed to write calibration cache " << _filename );
+        }
+
+        /*static*/ bool calibration_cache::is_calibration_write( std::vector< uint8_t > const & raw_command )
+        {
+            // Size (2), magic (2), then the opcode
+            if( raw_command.size() < 5 )
+                return false;
+            switch( raw_command[4] )
+            {
+            case FWB:
+            case FES:
+            case FEF:
+            case SETINTCAL:
+            case CALIBRECALC:
+            case CAL_RESTORE_DFLT:
+            case SETINTCALNEW:
+            case SET_HKR_CONFIG_TABLE:
+                return true;
+            default:
+                return false;
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <rsutils/json.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace librealsense
+{
+    namespace ds
+    {
+        // Raw calibration tables, kept on disk between runs so a device doesn't have to read them all again every
+        // time it's opened.
+        //
+        // Opt-in, with the "calibration-cache" context setting: true for the app-data folder, or the folder to use.
+        // There's a file per serial number, holding the tables for one firmware version; a firmware update makes it
+        // stale. Each table is kept with its CRC, which is checked when it's loaded.
+        //
+        // The device has no cheap way of telling us its calibration changed, so the cache is only as good as what we
+        // see: calibration written through this library (including raw debug commands) drops it, but calibration
+        // written from another host isn't noticed, and the file has to be removed by hand.
+        //
+        class calibration_cache
+        {
+        public:
+            // Returns null unless enabled in the settings
+            static std::shared_ptr< calibration_cache > create( rsutils::json const & settings,
+                                                                std::string const & serial,
+                                                                std::string const & fw_version );
+
+            // The table from the cache, or read (and kept) if it isn't there
+            std::vector< uint8_t > get( std::string const & table,
+                                        std::function< std::vector< uint8_t >() > const & read );
+
+            // Forget all tables, e.g. when the calibration is written
+            void clear();
+
+            // True if a raw HWM command (as for send_receive_raw_data) may change the calibration
+            static bool is_calibration_write( std::vector< uint8_t > const & raw_command );
+
+            calibration_cache( std::string filename, std::string fw_version );
+
+        private:
+            void save() const;
+
+            std::string const _filename;
+            std::string const _fw_version;
+            std::mutex _mutex;
+            rsutils::json _tables;
+        };
+    }
+}
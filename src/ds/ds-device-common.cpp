@@ -332,11 +332,11 @@ namespace librealsense
         res.push_back(std::make_shared<hdr_merge>()); // Requires HDR
         res.push_back(std::make_shared<sequence_id_filter>());
         res.push_back(std::make_shared<threshold>());
-        res.push_back(std::make_shared<disparity_transform>(true));
-        res.push_back(std::make_shared<spatial_filter>());
-        res.push_back(std::make_shared<temporal_filter>());
-        res.push_back(std::make_shared<hole_filling_filter>());
-        res.push_back(std::make_shared<disparity_transform>(false));
+        res.push_back(disparity_transform::create(true));
+        res.push_back(spatial_filter::create());
+        res.push_back(temporal_filter::create());
+        res.push_back(hole_filling_filter::create());
+        res.push_back(disparity_transform::create(false));
         return res;
     }
 } // namespace librealsense
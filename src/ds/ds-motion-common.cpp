@@ -24,6 +24,7 @@
 #include <src/stream.h>
 #include <src/fourcc.h>
 #include <src/metadata-parser.h>
+#include <src/motion-history.h>
 
 #include <cstddef>
 
@@ -132,6 +133,7 @@ namespace librealsense
                                         device * owner )
         : synthetic_sensor( name, sensor, owner )
         , _owner( owner )
+        , _motion_history( std::make_shared< motion_history >() )
     {
     }
 
@@ -142,6 +144,7 @@ namespace librealsense
                                         const std::map< uint32_t, rs2_stream > & motion_fourcc_to_rs2_stream )
         : synthetic_sensor( name, sensor, owner, motion_fourcc_to_rs2_format, motion_fourcc_to_rs2_stream )
         , _owner( owner )
+        , _motion_history( std::make_shared< motion_history >() )
     {
     }
 
@@ -239,6 +242,10 @@ namespace librealsense
             std::make_shared<auto_exposure_step_option>(auto_exposure,
                 ae_state,
                 option_range{ 0.1f, 1.0f, 0.1f, ae_step_default_value }));
+        ep->register_option(RS2_OPTION_AUTO_EXPOSURE_SUBSAMPLING,
+            std::make_shared<auto_exposure_sample_rate_option>(auto_exposure,
+                ae_state,
+                option_range{ 1.f, float(auto_exposure_state::max_sample_rate), 1.f, 1.f }));
         ep->register_option(RS2_OPTION_POWER_LINE_FREQUENCY,
             std::make_shared<auto_exposure_antiflicker_rate_option>(auto_exposure,
                 ae_state,
@@ -508,11 +515,15 @@ namespace librealsense
         catch (...) {}
 
         bool high_accuracy =  _fw_version >= firmware_version( 5, 16, 0, 0 );    
+        auto history = hid_ep->get_motion_history();
         hid_ep->register_processing_block(
             { {RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_ACCEL} },
             { {RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_ACCEL} },
-            [&, mm_correct_opt, high_accuracy]()
-            { return std::make_shared< acceleration_transform >( _mm_calib, mm_correct_opt, high_accuracy );
+            [&, mm_correct_opt, high_accuracy, history]()
+            {
+                auto transform = std::make_shared< acceleration_transform >( _mm_calib, mm_correct_opt, high_accuracy );
+                transform->set_motion_history( history );
+                return transform;
             });
 
         //TODO this FW version is relevant for d400 devices. Need to change for propre d500 devices support.
@@ -521,8 +532,10 @@ namespace librealsense
         hid_ep->register_processing_block(
             { {RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_GYRO} },
             { {RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_GYRO} },
-                                           [&, mm_correct_opt, gyro_scale_factor]() {
-                                               return std::make_shared< gyroscope_transform >( _mm_calib, mm_correct_opt, gyro_scale_factor );
+                                           [&, mm_correct_opt, gyro_scale_factor, history]() {
+                                               auto transform = std::make_shared< gyroscope_transform >( _mm_calib, mm_correct_opt, gyro_scale_factor );
+                                               transform->set_motion_history( history );
+                                               return transform;
             });
 
         return hid_ep;
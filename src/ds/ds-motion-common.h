@@ -96,11 +96,15 @@ namespace librealsense
 
         stream_profiles init_stream_profiles() override;
 
+        // Fed by the motion transforms, with the samples they deliver
+        std::shared_ptr< motion_history > get_motion_history() const override { return _motion_history; }
+
     private:
         std::shared_ptr<stream_interface> get_accel_stream() const;
         std::shared_ptr<stream_interface> get_gyro_stream() const;
 
         const device* _owner;
+        std::shared_ptr< motion_history > _motion_history;
     };
 
     class global_time_option;
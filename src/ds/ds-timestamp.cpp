@@ -52,7 +52,7 @@ namespace librealsense
         }
         size_t pin_index = 0;
 
-        if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
+        if (frame->peek_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
         _has_metadata[pin_index] = has_metadata(frame);
@@ -85,7 +85,7 @@ namespace librealsense
         }
         size_t pin_index = 0;
 
-        if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
+        if (frame->peek_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
         if(_has_metadata[pin_index] && f->additional_data.metadata_size > platform::uvc_header_size)
@@ -113,7 +113,7 @@ namespace librealsense
     {
         std::lock_guard<std::recursive_mutex> lock(_mtx);
         auto pin_index = 0;
-        if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
+        if (frame->peek_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
         return _has_metadata[pin_index] ? RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK :
@@ -135,7 +135,7 @@ namespace librealsense
         }
         size_t pin_index = 0;
 
-        if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
+        if (frame->peek_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
         _has_metadata[pin_index] = has_metadata(frame);
@@ -168,7 +168,7 @@ namespace librealsense
         }
         size_t pin_index = 0;
 
-        if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
+        if (frame->peek_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
         if(_has_metadata[pin_index] && f->additional_data.metadata_size > platform::uvc_header_mipi_size)
@@ -196,7 +196,7 @@ namespace librealsense
         }
         size_t pin_index = 0;
 
-        if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
+        if (frame->peek_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
         _has_metadata[pin_index] = has_metadata(frame);
@@ -229,7 +229,7 @@ namespace librealsense
         }
         size_t pin_index = 0;
 
-        if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
+        if (frame->peek_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
         if(_has_metadata[pin_index] && f->additional_data.metadata_size > platform::uvc_header_mipi_size)
@@ -313,7 +313,7 @@ namespace librealsense
     {
         std::lock_guard<std::recursive_mutex> lock(_mtx);
         auto pin_index = 0;
-        if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
+        if (frame->peek_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
         return ++counter[pin_index];
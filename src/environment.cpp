@@ -3,6 +3,7 @@
 
 #include "environment.h"
 #include "pose.h"
+#include "proc/output-profile-cache.h"
 #include "core/stream-interface.h"
 #include <rsutils/easylogging/easyloggingpp.h>
 
@@ -45,6 +46,7 @@ namespace librealsense
 
         if (_extrinsics.find(profile_idx) == _extrinsics.end())
             _extrinsics.insert({ profile_idx, {} });
+        invalidate_cache();
     }
 
     void extrinsics_graph::register_extrinsics( const stream_interface & from,
@@ -67,6 +69,7 @@ namespace librealsense
 
         _extrinsics[from_idx][to_idx] = extr;
         _extrinsics[to_idx][from_idx] = std::shared_ptr< rsutils::lazy< rs2_extrinsics > >( nullptr );
+        invalidate_cache();
     }
 
     void extrinsics_graph::register_extrinsics(const stream_interface & from, const stream_interface & to, rs2_extrinsics extr)
@@ -101,6 +104,7 @@ namespace librealsense
 
         auto & lazy_extr = *sp;
         lazy_extr = [=]() { return extr; };
+        invalidate_cache();
     }
 
     void extrinsics_graph::cleanup_extrinsics()
@@ -132,6 +136,8 @@ namespace librealsense
             }
         }
 
+        if (!invalid_ids.empty())
+            invalidate_cache();
         if (!invalid_ids.empty())
             LOG_INFO("Found " << invalid_ids.size() << " unreachable streams, " << std::dec << counter << " extrinsics deleted");
     }
@@ -155,19 +161,51 @@ namespace librealsense
 
     bool extrinsics_graph::try_fetch_extrinsics(const stream_interface& from, const stream_interface& to, rs2_extrinsics* extr)
     {
+        bool found;
+        if (try_fetch_cached(from, to, found, extr))
+            return found;
+
         std::lock_guard<std::mutex> lock(_mutex);
         cleanup_extrinsics();
         auto from_idx = find_stream_profile(from);
         auto to_idx = find_stream_profile(to);
 
-        if (from_idx == to_idx)
+        cached_extrinsics result{ from.shared_from_this(), to.shared_from_this(), true, identity_matrix() };
+        if (from_idx != to_idx)
         {
-            *extr = identity_matrix();
-            return true;
+            std::set<int> visited;
+            result.found = try_fetch_extrinsics(from_idx, to_idx, visited, &result.extr);
         }
+        if (result.found)
+            *extr = result.extr;
+
+        // Finding the streams above may have added them, which doesn't change any result already cached
+        auto cache = std::atomic_load(&_cache);
+        auto updated = std::make_shared< extrinsics_cache >();
+        if (cache && cache->size() < 4096)  // Otherwise, begins over: old streams might still be there
+            *updated = *cache;
+        (*updated)[{ &from, &to }] = result;
+        std::atomic_store(&_cache, std::shared_ptr< const extrinsics_cache >(updated));
+        return result.found;
+    }
+
+    bool extrinsics_graph::try_fetch_cached(const stream_interface& from, const stream_interface& to, bool& found, rs2_extrinsics* extr) const
+    {
+        auto cache = std::atomic_load(&_cache);
+        if (!cache)
+            return false;
+        auto it = cache->find({ &from, &to });
+        if (it == cache->end() || it->second.from.lock().get() != &from || it->second.to.lock().get() != &to)
+            return false;
+        found = it->second.found;
+        if (found)
+            *extr = it->second.extr;
+        return true;
+    }
 
-        std::set<int> visited;
-        return try_fetch_extrinsics(from_idx, to_idx, visited, extr);
+    void extrinsics_graph::invalidate_cache()
+    {
+        std::atomic_store(&_cache, std::shared_ptr< const extrinsics_cache >());
     }
 
     bool extrinsics_graph::try_fetch_extrinsics(int from, int to, std::set<int>& visited, rs2_extrinsics* extr)
@@ -239,11 +277,15 @@ namespace librealsense
 
 
     environment::environment()
-        : _stream_id( 0 )
+        : _output_profiles( new output_profile_cache )
+        , _stream_id( 0 )
     {
     }
 
 
+    environment::~environment() = default;
+
+
     environment& environment::get_instance()
     {
         static environment env;
@@ -254,4 +296,9 @@ namespace librealsense
     {
         return _extrinsics;
     }
+
+    output_profile_cache& environment::get_output_profile_cache()
+    {
+        return *_output_profiles;
+    }
 }
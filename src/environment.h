@@ -15,6 +15,7 @@
 namespace librealsense
 {
     class stream_interface;
+    class output_profile_cache;
 
 
     /**
@@ -40,7 +41,9 @@ namespace librealsense
     *         profile n for stream A----                                ----profile n for stream B
     * 
     * 
-    *        The search in the graph is implemented as DFS, and it is implemented in the try_fetch_extrinsics method
+    *        The search in the graph is implemented as DFS, and it is implemented in the try_fetch_extrinsics method.
+    *        Its results are cached until the graph changes, and looked up without locking, as they're mostly asked for
+    *        again and again on every frame (e.g., by pointcloud and align)
     */
     class extrinsics_graph
     {
@@ -96,6 +99,23 @@ namespace librealsense
 
         std::atomic<int> _locks_count;
 
+        // The results of try_fetch_extrinsics, by the streams they're between, so far
+        struct cached_extrinsics
+        {
+            // To tell the streams from any later at the same addresses
+            std::weak_ptr< const stream_interface > from, to;
+            bool found;
+            rs2_extrinsics extr;
+        };
+        typedef std::map< std::pair< const stream_interface *, const stream_interface * >, cached_extrinsics >
+            extrinsics_cache;
+        // Read with atomic_load, without _mutex; under _mutex, replaced by a copy with another result, or emptied when
+        // the graph changes
+        std::shared_ptr< const extrinsics_cache > _cache;
+        // False when there's no result cached; otherwise 'found' is the result
+        bool try_fetch_cached( const stream_interface & from, const stream_interface & to, bool & found,
+                               rs2_extrinsics * extr ) const;
+        void invalidate_cache();
     };
 
 
@@ -105,6 +125,8 @@ namespace librealsense
         static environment& get_instance();
 
         extrinsics_graph& get_extrinsics_graph();
+        // The profiles of the processing blocks' outputs, shared by all of them
+        output_profile_cache& get_output_profile_cache();
 
         int generate_stream_id() { return _stream_id.fetch_add(1); }
 
@@ -115,8 +137,10 @@ namespace librealsense
 
     private:
         extrinsics_graph _extrinsics;
+        std::unique_ptr< output_profile_cache > _output_profiles;
         std::atomic<int> _stream_id;
 
         environment();
+        ~environment();
     };
 }
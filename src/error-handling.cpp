@@ -4,6 +4,7 @@
 #include "error-handling.h"
 #include "core/notification.h"
 #include "librealsense-exception.h"
+#include "platform/uvc-device.h"
 
 #include <rsutils/string/from.h>
 
@@ -12,6 +13,9 @@
 
 namespace librealsense
 {
+    // With change reports, a poll only every so many intervals
+    static const unsigned int intervals_per_unreported_poll = 10;
+
     polling_error_handler::polling_error_handler(unsigned int poll_intervals_ms, std::shared_ptr<option> option,
         std::shared_ptr <notifications_processor> processor, std::shared_ptr<notification_decoder> decoder)
         :_poll_intervals_ms(poll_intervals_ms),
@@ -25,6 +29,9 @@ namespace librealsense
 
     polling_error_handler::~polling_error_handler()
     {
+        // No callback is in progress once it's replaced
+        if( auto device = _reporting_device.lock() )
+            device->set_control_change_callback( nullptr );
         stop();
     }
 
@@ -41,16 +48,58 @@ namespace librealsense
     {
         if( poll_intervals_ms )
             _poll_intervals_ms = poll_intervals_ms;
+        {
+            std::lock_guard< std::mutex > lock( _wake_mutex );
+            _stopping = false;
+        }
         _active_object->start();
     }
     void polling_error_handler::stop()
     {
+        // The polling loop waits on us, not on the active object
+        {
+            std::lock_guard< std::mutex > lock( _wake_mutex );
+            _stopping = true;
+        }
+        _wake_cv.notify_all();
         _active_object->stop();
     }
 
+    bool polling_error_handler::poll_on_change( std::shared_ptr< platform::uvc_device > const & device,
+                                                uint8_t unit,
+                                                uint8_t selector )
+    {
+        bool reported = device->set_control_change_callback(
+            [this, unit, selector]( uint8_t changed_unit, uint8_t changed_selector )
+            {
+                if( changed_unit != unit || changed_selector != selector )
+                    return;
+                {
+                    std::lock_guard< std::mutex > lock( _wake_mutex );
+                    _changed = true;
+                }
+                _wake_cv.notify_all();
+            } );
+        if( reported )
+        {
+            _reporting_device = device;
+            _intervals_per_poll = intervals_per_unreported_poll;
+        }
+        return reported;
+    }
+
     void polling_error_handler::polling( dispatcher::cancellable_timer cancellable_timer )
     {
-        if( cancellable_timer.try_sleep( std::chrono::milliseconds( _poll_intervals_ms ) ) )
+        bool stopping;
+        {
+            std::unique_lock< std::mutex > lock( _wake_mutex );
+            _wake_cv.wait_for( lock,
+                               std::chrono::milliseconds( _poll_intervals_ms ) * _intervals_per_poll,
+                               [&]() { return _changed || _stopping; } );
+            _changed = false;
+            stopping = _stopping;
+        }
+        if( ! stopping )
         {
             if( ! _silenced )
             {
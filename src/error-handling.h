@@ -5,11 +5,16 @@
 #include "core/option-interface.h"
 #include <rsutils/concurrency/concurrency.h>
 
+#include <condition_variable>
+
 
 namespace librealsense
 {
     class notification_decoder;
     class notifications_processor;
+    namespace platform {
+    class uvc_device;
+    }
 
 
     class polling_error_handler
@@ -26,6 +31,11 @@ namespace librealsense
         void start( unsigned int poll_intervals_ms = 0 );
         void stop();
 
+        // Polls as soon as the device reports the error control (of 'unit' and 'selector') changed, and otherwise only
+        // every few intervals, in case a report is missed or the device isn't powered to send any.
+        // Returns false, and polling stays as it is, when the device doesn't report control changes.
+        bool poll_on_change( std::shared_ptr< platform::uvc_device > const & device, uint8_t unit, uint8_t selector );
+
     private:
         void polling(dispatcher::cancellable_timer cancellable_timer);
 
@@ -35,6 +45,13 @@ namespace librealsense
         std::shared_ptr < active_object<> > _active_object;
         std::weak_ptr<notifications_processor> _notifications_processor;
         std::shared_ptr<notification_decoder> _decoder;
+
+        std::weak_ptr<platform::uvc_device> _reporting_device;  // That calls us when the error control changes
+        unsigned int _intervals_per_poll = 1;
+        std::mutex _wake_mutex;
+        std::condition_variable _wake_cv;
+        bool _changed = false;
+        bool _stopping = false;
     };
 
 
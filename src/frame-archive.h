@@ -3,7 +3,10 @@
 #pragma once
 
 #include "archive.h"
+#include "frame-buffer-pool.h"
 #include <src/core/frame-interface.h>
+#include <src/core/frame-allocator.h>
+#include <src/log.h>
 
 #include <atomic>
 #include <vector>
@@ -22,56 +25,53 @@ namespace librealsense
         std::shared_ptr<metadata_parser_map> _metadata_parsers = nullptr;
         callbacks_heap callback_inflight;
 
-        std::vector<T> freelist; // return frames here
+        std::shared_ptr< frame_pool_stats > _pool_stats;
+        frame_buffer_pool buffer_pool; // return frame buffers here
         std::atomic<bool> recycle_frames;
         int pending_frames = 0;
-        std::recursive_mutex mutex;
 
         std::weak_ptr<sensor_interface> _sensor;
         std::shared_ptr<sensor_interface> get_sensor() const override { return _sensor.lock(); }
         void set_sensor( const std::weak_ptr< sensor_interface > & s ) override { _sensor = s; }
 
+        std::shared_ptr< frame_allocator > _allocator;
+        void set_frame_allocator( const std::shared_ptr< frame_allocator > & a ) override { std::atomic_store( &_allocator, a ); }
+
+        bool alloc_external( T & backbuffer, const size_t size )
+        {
+            auto allocator = std::atomic_load( &_allocator );
+            if( ! allocator || ! size )
+                return false;
+            auto ptr = static_cast< uint8_t * >( allocator->allocate( size ) );
+            if( ! ptr )
+                return false;
+            // The allocator is captured so the memory can be returned even after it's replaced or the archive is gone
+            backbuffer.external_data.reset( ptr, [allocator, size]( uint8_t * p ) { allocator->deallocate( p, size ); } );
+            backbuffer.external_size = size;
+            return true;
+        }
+
         T alloc_frame(const size_t size, frame_additional_data && additional_data, bool requires_memory)
         {
             T backbuffer;
-            //const size_t size = modes[stream].get_image_size(stream);
+            if (requires_memory && ! alloc_external( backbuffer, size ))
             {
-                std::lock_guard<std::recursive_mutex> guard(mutex);
-
-                if (requires_memory)
-                {
-                    // Attempt to obtain a buffer of the appropriate size from the freelist
-                    for (auto it = begin(freelist); it != end(freelist); ++it)
-                    {
-                        if (it->data.size() == size)
-                        {
-                            backbuffer = std::move(*it);
-                            freelist.erase(it);
-                            break;
-                        }
-                    }
-                }
-
-                // Discard buffers that have been in the freelist for longer than 1s
-                for (auto it = begin(freelist); it != end(freelist);)
+                // Attempt to obtain a buffer of the appropriate size from the pool
+                if( buffer_pool.acquire( size, additional_data.timestamp, backbuffer.data ) )
+                    _pool_stats->on_hit();
+                else
                 {
-                    if (additional_data.timestamp > it->additional_data.timestamp + 1000) it = freelist.erase(it);
-                    else ++it;
+                    _pool_stats->on_miss( size );
+                    backbuffer.data.resize(size, 0);
                 }
             }
-
-            if (requires_memory)
-            {
-                backbuffer.data.resize(size, 0); // TODO: Allow users to provide a custom allocator for frame buffers
-            }
+            _pool_stats->on_frame();
             backbuffer.additional_data = std::move( additional_data );
             return backbuffer;
         }
 
         frame_interface* track_frame(T& f)
         {
-            std::unique_lock<std::recursive_mutex> lock(mutex);
-
             auto published_frame = f.publish(this->shared_from_this());
             if (published_frame)
             {
@@ -79,7 +79,7 @@ namespace librealsense
                 return published_frame;
             }
 
-            LOG_DEBUG("publish(...) failed");
+            LOG_DEBUG_FMT( "publish(...) failed" );
             return nullptr;
         }
 
@@ -88,15 +88,28 @@ namespace librealsense
             if( fi )
             {
                 auto f = (T *)fi;
-                std::unique_lock<std::recursive_mutex> lock(mutex);
 
                 fi->keep();
 
+                _pool_stats->in_use_bytes -= f->accounted_size;
+                f->accounted_size = 0;
+
+                // A conversion that hasn't run yet mustn't write to the buffer once it's reused
+                if( f->deferred )
+                {
+                    f->deferred->detach( f->deferred_plane );
+                    f->deferred.reset();
+                }
+
                 if (recycle_frames)
                 {
-                    freelist.push_back(std::move(*f));
+                    buffer_pool.release( std::move( f->data ), f->additional_data.timestamp );
                 }
-                lock.unlock();
+
+                // Whatever holds on to external memory lets go of it now, not when the frame object is reused
+                f->external_data.reset();
+                f->external_size = 0;
+                f->external_fd = -1;
 
                 if (f->is_fixed())
                     published_frames.deallocate(f);
@@ -119,7 +132,7 @@ namespace librealsense
             if (published_frames_count >= max_frames
                 && max_frames)
             {
-                LOG_DEBUG("User didn't release frame resource.");
+                LOG_DEBUG_FMT( "User didn't release frame resource." );
                 return nullptr;
             }
             auto new_frame = (max_frames ? published_frames.allocate() : new T());
@@ -128,26 +141,36 @@ namespace librealsense
             {
                 if (max_frames)
                     new_frame->mark_fixed();
+                else
+                    _pool_stats->on_new_object();
             }
             else
             {
                 new_frame = new T();
+                _pool_stats->on_new_object();
             }
 
             ++published_frames_count;
             *new_frame = std::move(*f);
+            new_frame->accounted_size = new_frame->data.size();
+            _pool_stats->in_use_bytes += new_frame->accounted_size;
 
             return new_frame;
         }
 
         std::shared_ptr<metadata_parser_map> get_md_parsers() const override { return _metadata_parsers; };
 
+        uint32_t get_published_count() const override { return published_frames_count; }
+
         friend class frame;
 
     public:
         explicit frame_archive( std::atomic< uint32_t > * in_max_frame_queue_size,
-                                std::shared_ptr< metadata_parser_map > const & parsers )
+                                std::shared_ptr< metadata_parser_map > const & parsers,
+                                std::shared_ptr< frame_pool_stats > const & pool_stats = nullptr )
             : max_frame_queue_size( in_max_frame_queue_size )
+            , _pool_stats( pool_stats ? pool_stats : std::make_shared< frame_pool_stats >() )
+            , buffer_pool( _pool_stats )
             , recycle_frames( true )
             , _metadata_parsers( parsers )
         {
@@ -184,10 +207,7 @@ namespace librealsense
             // wait until user is done with all the stuff he chose to borrow
             callback_inflight.wait_until_empty();
 
-            {
-                std::lock_guard<std::recursive_mutex> guard(mutex);
-                freelist.clear();
-            }
+            buffer_pool.clear();
 
             pending_frames = published_frames.get_size();
             if (pending_frames > 0)
@@ -203,8 +223,7 @@ namespace librealsense
         {
             if (pending_frames > 0)
             {
-                LOG_DEBUG("All frames from stream 0x"
-                    << std::hex << this << " are now released by the user" << std::dec);
+                LOG_DEBUG_FMT( "All frames from stream {} are now released by the user", (void const *)this );
             }
         }
 
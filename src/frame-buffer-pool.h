@@ -0,0 +1,269 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/h/rs_types.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+
+namespace librealsense {
+
+
+// Hit/miss counters for frame_buffer_pool, shared between a frame_source and its archives so they can be
+// exposed as (read-only) options; along with what else the archives allocate, for memory profiling
+struct frame_pool_stats
+{
+    std::atomic< uint64_t > hits{ 0 };
+    std::atomic< uint64_t > misses{ 0 };
+    std::atomic< uint64_t > frames{ 0 };       // Allocated, whether they have a buffer of their own or not
+    std::atomic< uint64_t > miss_bytes{ 0 };   // Of the buffers newly allocated
+    std::atomic< uint64_t > new_objects{ 0 };  // Frames that didn't fit in their archive's fixed heap
+
+    // The frame memory held right now: in published frames, and pooled for reuse; not counted towards the totals
+    std::atomic< uint64_t > in_use_bytes{ 0 };
+    std::atomic< uint64_t > pooled_bytes{ 0 };
+    // When not 0, what the two together should stay within: the pools stop keeping buffers beyond it, and keep them
+    // for a shorter time (see frame_source::set_memory_budget)
+    std::atomic< uint64_t > budget{ 0 };
+
+    uint64_t memory_usage() const { return in_use_bytes + pooled_bytes; }
+
+    // The subsystem's, for all the sources that make it up (see memory_stats); set before any frame is allocated
+    std::shared_ptr< frame_pool_stats > totals;
+
+    void on_frame()
+    {
+        ++frames;
+        if( totals )
+            totals->on_frame();
+    }
+    void on_hit()
+    {
+        ++hits;
+        if( totals )
+            totals->on_hit();
+    }
+    void on_miss( size_t bytes )
+    {
+        ++misses;
+        miss_bytes += bytes;
+        if( totals )
+            totals->on_miss( bytes );
+    }
+    void on_new_object()
+    {
+        ++new_objects;
+        if( totals )
+            totals->on_new_object();
+    }
+};
+
+
+// Size-bucketed pool of frame data buffers.
+//
+// Each bucket holds buffers of one exact size in a fixed array of slots. A slot is claimed by a single
+// compare-exchange on its state, so both acquire() and release() are lock-free and never allocate on their
+// own. Buffers older than MAX_AGE (in frame-timestamp milliseconds) are discarded rather than reused, the
+// same policy the archive had with its freelist.
+//
+// With stats, the bytes pooled are counted in them; and under a memory budget, a buffer that would take the memory
+// of the source past it is freed rather than pooled, and buffers are discarded after LOW_MEMORY_MAX_AGE.
+//
+class frame_buffer_pool
+{
+public:
+    using buffer = std::vector< uint8_t >;
+
+    static const int BUCKETS = 4;
+    static const int SLOTS = 8;
+    static constexpr rs2_time_t MAX_AGE = 1000.;
+    static constexpr rs2_time_t LOW_MEMORY_MAX_AGE = 250.;
+
+    frame_buffer_pool() = default;
+    explicit frame_buffer_pool( std::shared_ptr< frame_pool_stats > const & stats )
+        : _stats( stats )
+    {
+    }
+    ~frame_buffer_pool() { clear(); }
+    frame_buffer_pool( frame_buffer_pool const & ) = delete;
+    frame_buffer_pool & operator=( frame_buffer_pool const & ) = delete;
+
+    // Try to move a recycled buffer of exactly 'size' bytes into 'out'. Returns false on a miss.
+    // 'now' is the timestamp of the frame being allocated, and is used to age out stale buffers.
+    bool acquire( size_t size, rs2_time_t now, buffer & out )
+    {
+        if( ! size )
+            return false;
+
+        if( auto b = find_bucket( size ) )
+        {
+            for( auto & s : b->slots )
+            {
+                if( ! s.try_lock( FULL ) )
+                    continue;
+
+                bool const usable = s.data.size() == size && now <= s.timestamp + max_age();
+                on_unpooled( s.data.size() );
+                if( usable )
+                    out = std::move( s.data );
+                buffer().swap( s.data );  // free stale memory right away
+                s.unlock( EMPTY );
+                if( usable )
+                    return true;
+            }
+        }
+
+        // Miss: this is the slow path, so use it to let go of buffers nobody is asking for anymore (e.g.,
+        // after a resolution change)
+        trim( now );
+        return false;
+    }
+
+    // Return a buffer to the pool; if there's no room for it, it is simply freed
+    void release( buffer && data, rs2_time_t timestamp )
+    {
+        auto const size = data.size();
+        if( ! size || ! _enabled.load( std::memory_order_relaxed ) )
+            return;
+        if( _stats && _stats->budget && _stats->memory_usage() + size > _stats->budget )
+            return;
+
+        auto b = find_bucket( size );
+        if( ! b )
+            b = claim_bucket( size );
+        if( ! b )
+            return;
+
+        for( auto & s : b->slots )
+        {
+            if( ! s.try_lock( EMPTY ) )
+                continue;
+            s.data = std::move( data );
+            s.timestamp = timestamp;
+            if( _stats )
+                _stats->pooled_bytes += size;
+            s.unlock( FULL );
+            return;
+        }
+    }
+
+    // Free all pooled buffers; further release() calls are ignored
+    void clear()
+    {
+        _enabled = false;
+        for( auto & b : _buckets )
+        {
+            for( auto & s : b.slots )
+            {
+                if( s.try_lock( FULL ) )
+                {
+                    on_unpooled( s.data.size() );
+                    buffer().swap( s.data );
+                    s.unlock( EMPTY );
+                }
+            }
+        }
+    }
+
+private:
+    enum slot_state : int { EMPTY, BUSY, FULL };
+
+    struct slot
+    {
+        std::atomic< int > state{ EMPTY };
+        buffer data;
+        rs2_time_t timestamp = 0;
+
+        bool try_lock( int from )
+        {
+            // Cheap relaxed peek first, to avoid bouncing the cache line when the slot isn't interesting
+            if( state.load( std::memory_order_relaxed ) != from )
+                return false;
+            return state.compare_exchange_strong( from, BUSY, std::memory_order_acquire );
+        }
+        void unlock( int to ) { state.store( to, std::memory_order_release ); }
+    };
+
+    struct bucket
+    {
+        std::atomic< size_t > size{ 0 };  // 0 means unclaimed
+        slot slots[SLOTS];
+    };
+
+    rs2_time_t max_age() const
+    {
+        if( _stats && _stats->budget )
+            return LOW_MEMORY_MAX_AGE;
+        return MAX_AGE;
+    }
+
+    void on_unpooled( size_t bytes )
+    {
+        if( _stats )
+            _stats->pooled_bytes -= bytes;
+    }
+
+    bucket * find_bucket( size_t size )
+    {
+        for( auto & b : _buckets )
+            if( b.size.load( std::memory_order_acquire ) == size )
+                return &b;
+        return nullptr;
+    }
+
+    bucket * claim_bucket( size_t size )
+    {
+        for( auto & b : _buckets )
+        {
+            size_t expected = 0;
+            if( b.size.compare_exchange_strong( expected, size, std::memory_order_acq_rel ) || expected == size )
+                return &b;
+        }
+        return nullptr;
+    }
+
+    // Drop stale buffers and release buckets that end up empty. A bucket may get re-keyed while another
+    // thread is releasing into it; acquire() checks the actual buffer size, so that can only cost a miss.
+    void trim( rs2_time_t now )
+    {
+        for( auto & b : _buckets )
+        {
+            bool empty = true;
+            for( auto & s : b.slots )
+            {
+                if( s.try_lock( FULL ) )
+                {
+                    if( now > s.timestamp + max_age() )
+                    {
+                        on_unpooled( s.data.size() );
+                        buffer().swap( s.data );
+                        s.unlock( EMPTY );
+                    }
+                    else
+                    {
+                        s.unlock( FULL );
+                        empty = false;
+                    }
+                }
+                else if( s.state.load( std::memory_order_relaxed ) != EMPTY )
+                {
+                    empty = false;
+                }
+            }
+            if( empty )
+                b.size.store( 0, std::memory_order_release );
+        }
+    }
+
+    bucket _buckets[BUCKETS];
+    std::atomic< bool > _enabled{ true };
+    std::shared_ptr< frame_pool_stats > _stats;
+};
+
+
+}  // namespace librealsense
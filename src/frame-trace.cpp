@@ -0,0 +1,261 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "frame-trace.h"
+#include <src/core/extension.h>
+#include "composite-frame.h"
+#include <src/core/time-service.h>
+#include <src/core/enum-helpers.h>
+
+#include <rsutils/concurrency/concurrency.h>
+#include <rsutils/json.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+
+namespace librealsense {
+namespace frame_trace {
+
+
+namespace detail {
+std::atomic< bool > enabled( false );
+}
+
+
+namespace {
+
+
+struct event
+{
+    enum kind_t : uint8_t { arrival, at, span } kind = at;
+    uint32_t id = 0;
+    uint32_t thread = 0;
+    char const * name = nullptr;
+    double start = 0;  // Both in system time, ms
+    double end = 0;
+    // For arrivals only
+    rs2_stream stream = RS2_STREAM_ANY;
+    int index = 0;
+    unsigned long long number = 0;
+};
+
+
+lock_free_queue< event > & ring()
+{
+    // The latest, should nobody export them for a while
+    static lock_free_queue< event > r( 65536 );
+    return r;
+}
+
+
+std::atomic< uint32_t > last_id( 0 );
+
+
+uint32_t this_thread_id()
+{
+    static thread_local uint32_t const id = uint32_t( std::hash< std::thread::id >()( std::this_thread::get_id() ) );
+    return id;
+}
+
+
+// Calls 'fn' with each traced frame: the frame itself or, for a composite, those in it
+template< class Fn >
+void for_each_traced( frame_interface * fi, Fn && fn )
+{
+    if( auto composite = dynamic_cast< composite_frame * >( fi ) )
+    {
+        for( size_t i = 0; i < composite->get_embedded_frames_count(); ++i )
+            for_each_traced( composite->get_frame( int( i ) ), fn );
+    }
+    else if( auto f = dynamic_cast< frame * >( fi ) )
+    {
+        if( f->additional_data.trace_id )
+            fn( f->additional_data.trace_id );
+    }
+}
+
+
+}  // namespace
+
+
+void enable( bool on )
+{
+    detail::enabled = on;
+}
+
+
+char const * intern( std::string const & name )
+{
+    static std::mutex mutex;
+    static std::set< std::string > names;  // Never erased: the pointers into them stay good
+    std::lock_guard< std::mutex > lock( mutex );
+    return names.insert( name ).first->c_str();
+}
+
+
+void begin( frame & f, rs2_stream stream, int index )
+{
+    auto & data = f.additional_data;
+    if( data.trace_id || ! is_enabled() )
+        return;
+    data.trace_id = ++last_id;
+    if( ! data.trace_id )  // Wrapped around; 0 is for untraced
+        data.trace_id = ++last_id;
+
+    event e;
+    e.kind = event::arrival;
+    e.id = data.trace_id;
+    e.thread = this_thread_id();
+    e.name = "arrival";
+    e.end = time_service::get_time();
+    e.start = data.backend_timestamp > 0 ? data.backend_timestamp : e.end;
+    e.stream = stream;
+    e.index = index;
+    e.number = data.frame_number;
+    ring().enqueue( std::move( e ) );
+}
+
+
+void stamp( frame_interface * f, char const * stage )
+{
+    if( ! is_enabled() )
+        return;
+    auto now = time_service::get_time();
+    for_each_traced( f,
+                     [&]( uint32_t id )
+                     {
+                         event e;
+                         e.id = id;
+                         e.thread = this_thread_id();
+                         e.name = stage;
+                         e.start = e.end = now;
+                         ring().enqueue( std::move( e ) );
+                     } );
+}
+
+
+scope::scope( frame_interface * f, char const * name )
+    : _name( name )
+    , _start( 0 )
+{
+    if( ! is_enabled() )
+        return;
+    for_each_traced( f,
+                     [&]( uint32_t id )
+                     {
+                         if( _n_ids < max_ids )
+                             _ids[_n_ids++] = id;
+                     } );
+    if( _n_ids )
+        _start = time_service::get_time();
+}
+
+
+scope::~scope()
+{
+    if( ! _n_ids )
+        return;
+    event e;
+    e.kind = event::span;
+    e.thread = this_thread_id();
+    e.name = _name;
+    e.start = _start;
+    e.end = time_service::get_time();
+    for( int i = 0; i < _n_ids; ++i )
+    {
+        e.id = _ids[i];
+        ring().enqueue( event( e ) );
+    }
+}
+
+
+void export_trace( std::ostream & os )
+{
+    std::map< uint32_t, std::vector< event > > frames;
+    {
+        event e;
+        while( ring().try_dequeue( &e ) )
+            frames[e.id].push_back( e );
+    }
+
+    using rsutils::json;
+    json events = json::array();
+    auto us = []( double ms ) { return int64_t( ms * 1000 ); };
+    auto async = [&]( char const * ph, uint32_t id, std::string const & name, double t, json args = json() )
+    {
+        json j = { { "ph", ph }, { "cat", "frame" }, { "id", id }, { "name", name }, { "pid", 1 }, { "tid", 0 },
+                   { "ts", us( t ) } };
+        if( ! args.is_null() )
+            j["args"] = std::move( args );
+        events.push_back( std::move( j ) );
+    };
+
+    for( auto & f : frames )
+    {
+        auto & stamps = f.second;
+        std::stable_sort( stamps.begin(),
+                          stamps.end(),
+                          []( event const & a, event const & b ) { return a.start < b.start; } );
+
+        // The frame, named for its arrival (which may have been pushed out of the ring)
+        std::string name = "frame " + std::to_string( f.first );
+        json args;
+        if( stamps.front().kind == event::arrival )
+        {
+            auto & a = stamps.front();
+            name = std::string( get_string( a.stream ) ) + ( a.index ? std::to_string( a.index ) : "" ) + " #"
+                 + std::to_string( a.number );
+            args = { { "frame-number", a.number }, { "index", a.index } };
+        }
+        double last = stamps.front().start;
+        for( auto & e : stamps )
+            last = std::max( last, e.end );
+        async( "b", f.first, name, stamps.front().start, std::move( args ) );
+
+        // The steps: from one stamp to the next, named for the one they end with
+        double from = stamps.front().start;
+        for( auto & e : stamps )
+        {
+            if( e.end > from )
+            {
+                async( "b", f.first, e.name, from );
+                async( "e", f.first, e.name, e.end );
+            }
+            from = std::max( from, e.end );
+
+            // And, on the thread where it happened
+            json j = { { "name", e.name }, { "pid", 1 }, { "tid", e.thread }, { "ts", us( e.start ) },
+                       { "args", { { "frame", name } } } };
+            if( e.kind == event::at )
+                j["ph"] = "i", j["s"] = "t";
+            else
+                j["ph"] = "X", j["dur"] = us( e.end ) - us( e.start );
+            events.push_back( std::move( j ) );
+        }
+        async( "e", f.first, name, last );
+    }
+
+    os << json( { { "traceEvents", std::move( events ) }, { "displayTimeUnit", "ms" } } ).dump();
+}
+
+
+void export_trace( char const * path )
+{
+    if( ! path )
+        throw std::runtime_error( "null frame trace file path" );
+    std::ofstream file( path );
+    if( ! file )
+        throw std::runtime_error( std::string( "failed to open frame trace file: " ) + path );
+    export_trace( file );
+}
+
+
+}  // namespace frame_trace
+}  // namespace librealsense
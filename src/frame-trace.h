@@ -0,0 +1,79 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <librealsense2/h/rs_sensor.h>
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+
+namespace librealsense {
+
+
+class frame;
+class frame_interface;
+
+
+// Where the time goes between a frame arriving from the backend and being handed to the user: when it's on, each
+// frame gets an id when it's allocated (kept by the frames processing blocks derive from it), and is stamped as it
+// goes through the pipeline. The stamps are kept on the side, in a lock-free ring of the latest ones, and exported
+// in the Chrome trace format, for chrome://tracing or Perfetto:
+//     - each frame is an async slice, from its arrival to its last stamp, with a slice per step in between, named
+//       for the stamp that ends it; the time between a queue's stamp and the next is the time spent waiting in it
+//     - what runs on the frame (processing blocks, callbacks) also shows on the thread it runs in
+namespace frame_trace {
+
+
+void enable( bool );
+
+namespace detail {
+extern std::atomic< bool > enabled;
+}
+
+// Cheap: for the hooks
+inline bool is_enabled()
+{
+    return detail::enabled.load( std::memory_order_relaxed );
+}
+
+
+// Stage names are kept as pointers: anything that isn't a literal must be kept here, for as long as the traces are
+char const * intern( std::string const & name );
+
+
+// A frame that's new to the pipeline, from 'stream' (which it may not have yet): gives it an id, if it has none,
+// and stamps its arrival at the backend's time. Nothing when off.
+void begin( frame & f, rs2_stream stream, int index );
+
+// Stamps the frame (or each of a composite's) as having got to 'stage' now: a queue, a syncer. Nothing when off.
+void stamp( frame_interface * f, char const * stage );
+
+
+// What runs on a frame (or a composite's), from construction to destruction; nothing when off
+class scope
+{
+    static int const max_ids = 8;
+    uint32_t _ids[max_ids];
+    int _n_ids = 0;
+    char const * _name;
+    double _start;
+
+public:
+    scope( frame_interface * f, char const * name );
+    ~scope();
+
+    scope( scope const & ) = delete;
+    scope & operator=( scope const & ) = delete;
+};
+
+
+// Writes what's in the ring, in the Chrome trace (JSON) format, then clears it
+void export_trace( std::ostream & );
+void export_trace( char const * path );
+
+
+}  // namespace frame_trace
+}  // namespace librealsense
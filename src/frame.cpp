@@ -9,6 +9,7 @@
 #include "core/enum-helpers.h"
 
 #include <rsutils/string/from.h>
+#include <rsutils/sparse-depth.h>
 
 
 namespace librealsense {
@@ -34,8 +35,8 @@ std::ostream & operator<<( std::ostream & s, const frame_interface & f )
         }
         else
         {
-            s << "[" << get_abbr_string( f.get_stream()->get_stream_type() );
-            s << f.get_stream()->get_unique_id();
+            s << "[" << get_abbr_string( f.peek_stream()->get_stream_type() );
+            s << f.peek_stream()->get_unique_id();
             s << " " << f.get_header();
             s << "]";
         }
@@ -74,6 +75,15 @@ frame::frame( frame && r )
 frame & frame::operator=( frame && r )
 {
     data = std::move( r.data );
+    external_data = std::move( r.external_data );
+    external_size = r.external_size;
+    r.external_size = 0;
+    external_fd = r.external_fd;
+    r.external_fd = -1;
+    deferred = std::move( r.deferred );
+    deferred_plane = r.deferred_plane;
+    accounted_size = r.accounted_size;
+    r.accounted_size = 0;
     owner = r.owner;
     ref_count = r.ref_count.exchange( 0 );
     _kept = r._kept.exchange( false );
@@ -135,26 +145,86 @@ frame_interface * frame::publish( std::shared_ptr< archive_interface > new_owner
 
 bool frame::find_metadata( rs2_frame_metadata_value frame_metadata, rs2_metadata_type * p_value ) const
 {
-    if( ! metadata_parsers )
+    // Not from the device: see frame_source::invoke_callback
+    if( frame_metadata == RS2_FRAME_METADATA_DELIVERY_LATENCY )
+    {
+        if( additional_data.delivery_time <= 0 || additional_data.system_time <= 0 )
+            return false;
+        if( p_value )
+            *p_value = rs2_metadata_type( ( additional_data.delivery_time - additional_data.system_time ) * 1000 );
+        return true;
+    }
+
+    // Not from the device either: see uvc_sensor::open
+    if( frame_metadata == RS2_FRAME_METADATA_DEQUEUE_LATENCY )
+    {
+        if( additional_data.dequeue_time <= 0 || additional_data.system_time <= 0 )
+            return false;
+        if( p_value )
+            *p_value = rs2_metadata_type( ( additional_data.dequeue_time - additional_data.system_time ) * 1000 );
+        return true;
+    }
+
+    // Not from the device either: see scene_change_gate
+    if( frame_metadata == RS2_FRAME_METADATA_SCENE_CHANGE || frame_metadata == RS2_FRAME_METADATA_SKIPPED_FRAMES )
+    {
+        if( additional_data.scene_change < 0 )
+            return false;
+        if( p_value )
+            *p_value = frame_metadata == RS2_FRAME_METADATA_SCENE_CHANGE ? additional_data.scene_change
+                                                                         : additional_data.skipped_frames;
+        return true;
+    }
+
+    if( ! metadata_parsers || frame_metadata < 0 || frame_metadata >= RS2_FRAME_METADATA_ACTUAL_COUNT )
         return false;
-    auto parsers = metadata_parsers->equal_range( frame_metadata );
+    auto table = get_metadata_table();
+    if( ! table->valid[frame_metadata] )
+        return false;
+    if( p_value )
+        *p_value = table->values[frame_metadata];
+    return true;
+}
 
-    bool value_retrieved = false;
-    for( auto it = parsers.first; it != parsers.second; ++it )
-        if( it->second->find( *this, p_value ) )
-            value_retrieved = true;
+std::shared_ptr< const metadata_table > frame::get_metadata_table() const
+{
+    if( auto table = additional_data.decoded.get() )
+        return table;
 
-    return value_retrieved;
+    // Where several parsers find the same value, the last one wins
+    auto table = std::make_shared< metadata_table >();
+    if( metadata_parsers )
+    {
+        for( auto const & parser : *metadata_parsers )
+        {
+            auto const id = parser.first;
+            if( id < 0 || id >= RS2_FRAME_METADATA_ACTUAL_COUNT )
+                continue;
+            rs2_metadata_type value;
+            if( parser.second->find( *this, &value ) )
+            {
+                table->values[id] = value;
+                table->valid.set( id );
+            }
+        }
+    }
+    additional_data.decoded.set( table );
+    return table;
 }
 
 int frame::get_frame_data_size() const
 {
+    if( external_data )
+        return (int)external_size;
     return (int)data.size();
 }
 
 const uint8_t * frame::get_frame_data() const
 {
-    const uint8_t * frame_data = data.data();
+    if( deferred )
+        deferred->run();
+
+    const uint8_t * frame_data = external_data ? external_data.get() : data.data();
 
     if( on_release.get_data() )
     {
@@ -198,9 +268,18 @@ rs2_time_t frame::get_frame_system_time() const
 
 float depth_frame::get_distance( int x, int y ) const
 {
+    // Only the valid pixels: looked up in their row
+    if( peek_stream()->get_format() == RS2_FORMAT_Z16_SPARSE )
+    {
+        rsutils::sparse_depth::image sparse;
+        if( ! sparse.parse( get_frame_data(), get_frame_data_size() ) )
+            throw invalid_value_exception( "corrupt sparse depth frame" );
+        return sparse.at( uint32_t( x ), uint32_t( y ) ) * get_units();
+    }
+
     // If this frame does not itself contain Z16 depth data,
     // fall back to the original frame it was created from
-    if( _original && get_stream()->get_format() != RS2_FORMAT_Z16 )
+    if( _original && peek_stream()->get_format() != RS2_FORMAT_Z16 )
         return ( (depth_frame *)_original.frame )->get_distance( x, y );
 
     uint64_t pixel = 0;
@@ -7,6 +7,7 @@
 #include "core/frame-continuation.h"
 #include "core/frame-additional-data.h"
 #include "basics.h"
+#include "deferred-conversion.h"
 #include <atomic>
 #include <vector>
 #include <memory>
@@ -20,6 +21,16 @@ class LRS_EXTENSION_API frame : public frame_interface
 {
 public:
     std::vector< uint8_t > data;
+    // When the archive has a frame_allocator, the frame data lives here instead of in 'data'
+    std::shared_ptr< uint8_t > external_data;
+    size_t external_size = 0;
+    int external_fd = -1;  // DMABUF handle to external_data, when it's a kernel buffer we wrapped
+    // When the data is only converted once it's asked for, the conversion and which of its planes is ours
+    std::shared_ptr< deferred_conversion > deferred;
+    size_t deferred_plane = 0;
+    // What the archive counted the frame's data as when it was published (see frame_pool_stats::in_use_bytes)
+    size_t accounted_size = 0;
+
     frame_additional_data additional_data;
     std::shared_ptr< metadata_parser_map > metadata_parsers = nullptr;
     
@@ -38,16 +49,23 @@ public:
 
     virtual ~frame() { on_release.reset(); }
     frame_header const & get_header() const override { return additional_data; }
+    // From the metadata table, which all the parsers fill on the first lookup
     bool find_metadata( rs2_frame_metadata_value, rs2_metadata_type * p_output_value ) const override;
+    std::shared_ptr< const metadata_table > get_metadata_table() const;
     int get_frame_data_size() const override;
     const uint8_t * get_frame_data() const override;
     rs2_time_t get_frame_timestamp() const override;
     rs2_timestamp_domain get_frame_timestamp_domain() const override;
-    void set_timestamp( double new_ts ) override { additional_data.timestamp = new_ts; }
+    void set_timestamp( double new_ts ) override
+    {
+        additional_data.timestamp = new_ts;
+        additional_data.decoded.reset();
+    }
     unsigned long long get_frame_number() const override;
     void set_timestamp_domain( rs2_timestamp_domain timestamp_domain ) override
     {
         additional_data.timestamp_domain = timestamp_domain;
+        additional_data.decoded.reset();
     }
 
     // Return FPS calculated as (1000*d_frames/d_timestamp), or 0 if this cannot be estimated
@@ -56,6 +74,7 @@ public:
     rs2_time_t get_frame_system_time() const override;
 
     std::shared_ptr< stream_profile_interface > get_stream() const override { return stream; }
+    stream_profile_interface * peek_stream() const override { return stream.get(); }
     void set_stream( std::shared_ptr< stream_profile_interface > sp ) override
     {
         stream = std::move( sp );
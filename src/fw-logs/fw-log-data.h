@@ -71,6 +71,25 @@ namespace librealsense
         };
 
 
+        // One log, as it is in the buffer: nothing's put into words (see fw_logs_parser::format_message)
+        struct fw_log_record
+        {
+            uint32_t magic_number = 0;
+            uint32_t severity = 0;
+            uint32_t thread_id = 0;
+            uint32_t file_id = 0;
+            uint32_t group_id = 0;
+            uint32_t event_id = 0;
+            uint32_t line = 0;
+            uint32_t sequence = 0;
+            uint32_t params[3] = {};
+            uint64_t timestamp = 0;
+            double delta = 0.0;  // Since the one before, in ms; 0 for the first
+
+            rs2_log_severity get_severity() const { return fw_logs_severity_to_log_severity(severity); }
+        };
+
+
         class fw_log_data
         {
         public:
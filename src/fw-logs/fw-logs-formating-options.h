@@ -39,6 +39,9 @@ namespace librealsense
             bool get_file_name(int id, std::string* file_name) const;
             bool get_thread_name(uint32_t thread_id, std::string* thread_name) const;
             std::unordered_map<std::string, std::vector<kvp>> get_enums() const;
+            const std::unordered_map<int, fw_log_event>& get_events() const { return _fw_logs_event_list; }
+            const std::unordered_map<int, std::string>& get_file_names() const { return _fw_logs_file_names_list; }
+            const std::unordered_map<int, std::string>& get_thread_names() const { return _fw_logs_thread_names_list; }
             bool initialize_from_xml();
 
         private:
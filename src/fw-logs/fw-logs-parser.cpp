@@ -1,9 +1,7 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2019 Intel Corporation. All Rights Reserved.
 #include "fw-logs-parser.h"
-#include <regex>
-#include <sstream>
-#include "fw-string-formatter.h"
+#include <cstring>
 #include "stdint.h"
 
 using namespace std;
@@ -12,12 +10,43 @@ namespace librealsense
 {
     namespace fw_logs
     {
+        namespace
+        {
+            // Indexed by id, "Unknown" for the ids in between; ids past 'max_id' can't be in a log
+            vector<string> index_names(const unordered_map<int, string>& names, int max_id)
+            {
+                vector<string> result;
+                for (auto& n : names)
+                    if (n.first >= 0 && n.first <= max_id)
+                    {
+                        if (result.size() <= size_t(n.first))
+                            result.resize(n.first + 1, "Unknown");
+                        result[n.first] = n.second;
+                    }
+                return result;
+            }
+        }
+
         fw_logs_parser::fw_logs_parser(string xml_content)
             : _fw_logs_formating_options(xml_content),
+            // The enums are only there once the XML is read
+            _formatter((_fw_logs_formating_options.initialize_from_xml(), _fw_logs_formating_options.get_enums())),
+            _unknown_name("Unknown"),
             _last_timestamp(0),
             _timestamp_factor(0.00001)
         {
-            _fw_logs_formating_options.initialize_from_xml();
+            for (auto& e : _fw_logs_formating_options.get_events())
+            {
+                if (e.first < 0 || e.first > 0xffff)  // 16 bits in the log
+                    continue;
+                if (_events.size() <= size_t(e.first))
+                    _events.resize(e.first + 1);
+                _events[e.first].known = true;
+                _events[e.first].format = _formatter.compile(e.second.line, e.second.num_of_params);
+            }
+            _unknown_event = _formatter.compile("*** Unrecognized Log Id: {3}! P1 = 0x{0:x}, P2 = 0x{1:x}, P3 = 0x{2:x}", 4);
+            _file_names = index_names(_fw_logs_formating_options.get_file_names(), 0x7ff);
+            _thread_names = index_names(_fw_logs_formating_options.get_thread_names(), 0x7);
         }
 
 
@@ -29,62 +58,100 @@ namespace librealsense
         {
             fw_log_data log_data = fw_log_data();
 
-            if (!fw_log_msg || fw_log_msg->logs_buffer.size() == 0)
+            if (!fw_log_msg || fw_log_msg->logs_buffer.size() < sizeof(fw_log_binary))
                 return log_data;
 
-            log_data = fill_log_data(fw_log_msg);
-
-            //message
-            fw_string_formatter reg_exp(_fw_logs_formating_options.get_enums());
-            fw_log_event log_event_data;
-            _fw_logs_formating_options.get_event_data(log_data._event_id, &log_event_data);
+            fw_log_binary log_binary;
+            memcpy(&log_binary, fw_log_msg->logs_buffer.data(), sizeof(log_binary));
+            auto record = decode(log_binary);
+
+            log_data._magic_number = record.magic_number;
+            log_data._severity = record.severity;
+            log_data._thread_id = record.thread_id;
+            log_data._file_id = record.file_id;
+            log_data._group_id = record.group_id;
+            log_data._event_id = record.event_id;
+            log_data._line = record.line;
+            log_data._sequence = record.sequence;
+            log_data._p1 = record.params[0];
+            log_data._p2 = record.params[1];
+            log_data._p3 = record.params[2];
+            log_data._timestamp = record.timestamp;
+            log_data._delta = record.delta;
+
+            format_message(record, &log_data._message);
+            log_data._file_name = get_file_name(record.file_id);
+            log_data._thread_name = get_thread_name(record.thread_id);
 
-            uint32_t params[3] = { log_data._p1, log_data._p2, log_data._p3 };
-            reg_exp.generate_message(log_event_data.line, log_event_data.num_of_params, params, &log_data._message);
+            return log_data;
+        }
 
-            //file_name
-            _fw_logs_formating_options.get_file_name(log_data._file_id, &log_data._file_name);
+        size_t fw_logs_parser::parse_fw_logs(const uint8_t* buffer, size_t size, vector<fw_log_record>& records)
+        {
+            size_t const n = buffer ? size / BINARY_DATA_SIZE : 0;
+            records.reserve(records.size() + n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                fw_log_binary log_binary;
+                memcpy(&log_binary, buffer + i * BINARY_DATA_SIZE, sizeof(log_binary));
+                records.push_back(decode(log_binary));
+            }
+            return n;
+        }
 
-            //thread_name
-            _fw_logs_formating_options.get_thread_name(log_data._thread_id, &log_data._thread_name);
+        void fw_logs_parser::format_message(const fw_log_record& record, string* message) const
+        {
+            if (record.event_id < _events.size() && _events[record.event_id].known)
+            {
+                _formatter.format(_events[record.event_id].format, record.params, message);
+                return;
+            }
+            uint32_t params[4] = { record.params[0], record.params[1], record.params[2], record.event_id };
+            _formatter.format(_unknown_event, params, message);
+        }
 
-            return log_data;
+        const string& fw_logs_parser::get_file_name(uint32_t file_id) const
+        {
+            return file_id < _file_names.size() ? _file_names[file_id] : _unknown_name;
         }
 
-        fw_log_data fw_logs_parser::fill_log_data(const fw_logs_binary_data* fw_log_msg)
+        const string& fw_logs_parser::get_thread_name(uint32_t thread_id) const
         {
-            fw_log_data log_data;
+            return thread_id < _thread_names.size() ? _thread_names[thread_id] : _unknown_name;
+        }
 
-            auto* log_binary = reinterpret_cast<const fw_logs::fw_log_binary*>(fw_log_msg->logs_buffer.data());
+        fw_log_record fw_logs_parser::decode(const fw_log_binary& log_binary)
+        {
+            fw_log_record record;
 
             //parse first DWORD
-            log_data._magic_number = static_cast<uint32_t>(log_binary->dword1.bits.magic_number);
-            log_data._severity = static_cast<uint32_t>(log_binary->dword1.bits.severity);
-            log_data._thread_id = static_cast<uint32_t>(log_binary->dword1.bits.thread_id);
-            log_data._file_id = static_cast<uint32_t>(log_binary->dword1.bits.file_id);
-            log_data._group_id = static_cast<uint32_t>(log_binary->dword1.bits.group_id);
+            record.magic_number = static_cast<uint32_t>(log_binary.dword1.bits.magic_number);
+            record.severity = static_cast<uint32_t>(log_binary.dword1.bits.severity);
+            record.thread_id = static_cast<uint32_t>(log_binary.dword1.bits.thread_id);
+            record.file_id = static_cast<uint32_t>(log_binary.dword1.bits.file_id);
+            record.group_id = static_cast<uint32_t>(log_binary.dword1.bits.group_id);
 
             //parse second DWORD
-            log_data._event_id = static_cast<uint32_t>(log_binary->dword2.bits.event_id);
-            log_data._line = static_cast<uint32_t>(log_binary->dword2.bits.line_id);
-            log_data._sequence = static_cast<uint32_t>(log_binary->dword2.bits.seq_id);
+            record.event_id = static_cast<uint32_t>(log_binary.dword2.bits.event_id);
+            record.line = static_cast<uint32_t>(log_binary.dword2.bits.line_id);
+            record.sequence = static_cast<uint32_t>(log_binary.dword2.bits.seq_id);
 
             //parse third DWORD
-            log_data._p1 = static_cast<uint32_t>(log_binary->dword3.p1);
-            log_data._p2 = static_cast<uint32_t>(log_binary->dword3.p2);
+            record.params[0] = static_cast<uint32_t>(log_binary.dword3.p1);
+            record.params[1] = static_cast<uint32_t>(log_binary.dword3.p2);
 
             //parse forth DWORD
-            log_data._p3 = static_cast<uint32_t>(log_binary->dword4.p3);
+            record.params[2] = static_cast<uint32_t>(log_binary.dword4.p3);
 
             //parse fifth DWORD
-            log_data._timestamp = log_binary->dword5.timestamp;
+            record.timestamp = log_binary.dword5.timestamp;
 
-            log_data._delta = (_last_timestamp == 0) ? 
-                0 :(log_data._timestamp - _last_timestamp) * _timestamp_factor;
+            record.delta = (_last_timestamp == 0) ?
+                0 :(record.timestamp - _last_timestamp) * _timestamp_factor;
 
-            _last_timestamp = log_data._timestamp;
+            _last_timestamp = record.timestamp;
 
-            return log_data;
+            return record;
         }
     }
 }
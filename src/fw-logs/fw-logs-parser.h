@@ -5,12 +5,15 @@
 #include <vector>
 #include <memory>
 #include "fw-logs-formating-options.h"
+#include "fw-string-formatter.h"
 #include "fw-log-data.h"
 
 namespace librealsense
 {
     namespace fw_logs
     {
+        // The XML is read once, into tables indexed by the ids in the logs, with the formats already split into
+        // their parameters: parsing a log is decoding its bits, and its text is only made when it's asked for
         class fw_logs_parser : public std::enable_shared_from_this<fw_logs_parser>
         {
         public:
@@ -19,11 +22,29 @@ namespace librealsense
 
             fw_log_data parse_fw_log(const fw_logs_binary_data* fw_log_msg);
 
+            // Appends every log in the buffer (BINARY_DATA_SIZE bytes each; any remainder is ignored) to 'records',
+            // and returns how many there were
+            size_t parse_fw_logs(const uint8_t* buffer, size_t size, std::vector<fw_log_record>& records);
+
+            void format_message(const fw_log_record& record, std::string* message) const;
+            const std::string& get_file_name(uint32_t file_id) const;
+            const std::string& get_thread_name(uint32_t thread_id) const;
 
         private:
-            fw_log_data fill_log_data(const fw_logs_binary_data* fw_log_msg);
+            fw_log_record decode(const fw_log_binary& log_binary);
 
             fw_logs_formating_options _fw_logs_formating_options;
+            fw_string_formatter _formatter;
+            struct event_format
+            {
+                bool known = false;
+                fw_log_format format;
+            };
+            std::vector<event_format> _events;  // By event id
+            fw_log_format _unknown_event;        // The event id is its 4th parameter
+            std::vector<std::string> _file_names;
+            std::vector<std::string> _thread_names;
+            const std::string _unknown_name;
             uint64_t _last_timestamp;
             const double _timestamp_factor;
         };
@@ -5,11 +5,11 @@
 #include "fw-logs-formating-options.h"
 #include <rsutils/easylogging/easyloggingpp.h>
 
-#include <regex>
 #include <sstream>
 #include <iomanip>
-#include <iostream>
+#include <cctype>
 #include <cmath>
+#include <cstring>
 
 using namespace std;
 
@@ -18,8 +18,13 @@ namespace librealsense
     namespace fw_logs
     {
         fw_string_formatter::fw_string_formatter(std::unordered_map<std::string, std::vector<kvp>> enums)
-            :_enums(enums)
         {
+            for (auto& e : enums)
+            {
+                auto& values = _enums[e.first];
+                for (auto& v : e.second)
+                    values.emplace(v.first, std::move(v.second));
+            }
         }
 
 
@@ -27,123 +32,130 @@ namespace librealsense
         {
         }
 
-        bool fw_string_formatter::generate_message(const string& source, size_t num_of_params, const uint32_t* params, string* dest)
+        fw_log_format fw_string_formatter::compile(const string& source, size_t num_of_params) const
         {
-            map<string, string> exp_replace_map;
-            map<string, int> enum_replace_map;
-
-            if (params == nullptr && num_of_params > 0) return false;
-
-            for (size_t i = 0; i < num_of_params; i++)
+            fw_log_format result;
+            auto add_text = [&](const char* begin, const char* end)
             {
-                string regular_exp[4];
-                string replacement[4];
-                stringstream st_regular_exp[4];
-                stringstream st_replacement[4];
-
-                st_regular_exp[0] << "\\{\\b(" << i << ")\\}";
-                regular_exp[0] = st_regular_exp[0].str();
-
-                st_replacement[0] << params[i];
-                replacement[0] = st_replacement[0].str();
-
-                exp_replace_map[regular_exp[0]] = replacement[0];
-
-
-                st_regular_exp[1] << "\\{\\b(" << i << "):x\\}";
-                regular_exp[1] = st_regular_exp[1].str();
-
-                st_replacement[1] << hex << setw(2) << setfill('0') << params[i];
-                replacement[1] = st_replacement[1].str();
-
-                exp_replace_map[regular_exp[1]] = replacement[1];
-
-                st_regular_exp[2] << "\\{\\b(" << i << "):f\\}";
-                regular_exp[2] = st_regular_exp[2].str();
-                // Parse int32_t as 4 raw bytes of float
-                float tmp = *reinterpret_cast< const float * >( &params[i] );
-                if( std::isfinite( tmp ) )
-                    st_replacement[2] << tmp;
-                else
+                if (begin == end)
+                    return;
+                if (result.tokens.empty() || result.tokens.back().kind != fw_log_format::token::literal)
+                    result.tokens.emplace_back();
+                result.tokens.back().text.append(begin, end);
+            };
+
+            const char* p = source.c_str();
+            const char* end = p + source.size();
+            while (p < end)
+            {
+                auto brace = static_cast<const char*>(memchr(p, '{', end - p));
+                if (!brace)
+                    break;
+                add_text(p, brace);
+
+                // {N}, {N:x}, {N:f} or {N,Name}; N without leading zeros, and one of ours. Anything else stays as is.
+                fw_log_format::token t;
+                const char* q = brace + 1;
+                const char* digits = q;
+                while (q < end && isdigit((unsigned char)*q))
+                    t.param = t.param * 10 + size_t(*q++ - '0');
+                size_t n_digits = q - digits;
+                bool ok = n_digits > 0 && (n_digits == 1 || *digits != '0') && n_digits < 10 && t.param < num_of_params;
+                if (ok && q < end && *q == '}')
+                    t.kind = fw_log_format::token::dec;
+                else if (ok && end - q >= 3 && q[0] == ':' && (q[1] == 'x' || q[1] == 'f') && q[2] == '}')
                 {
-                    LOG_ERROR( "Expecting a number, received infinite or NaN" );
-                    st_replacement[2] << "0x" << hex << setw( 2 ) << setfill( '0' ) << params[i];
+                    t.kind = q[1] == 'x' ? fw_log_format::token::hex : fw_log_format::token::flt;
+                    q += 2;
                 }
-                replacement[2] = st_replacement[2].str();
-                exp_replace_map[regular_exp[2]] = replacement[2];
-
-
-                st_regular_exp[3] << "\\{\\b(" << i << "),[a-zA-Z]+\\}";
-                regular_exp[3] = st_regular_exp[3].str();
+                else if (ok && q < end && *q == ',')
+                {
+                    const char* name = ++q;
+                    while (q < end && isalpha((unsigned char)*q))
+                        ++q;
+                    auto it = _enums.find(string(name, q));
+                    ok = q > name && q < end && *q == '}' && it != _enums.end();  // Unknown enums stay as is
+                    if (ok)
+                    {
+                        t.kind = fw_log_format::token::enumerated;
+                        t.text = it->first;
+                        t.values = &it->second;
+                    }
+                }
+                else
+                    ok = false;
 
-                enum_replace_map[regular_exp[3]] = params[i];
+                if (!ok)
+                {
+                    add_text(brace, brace + 1);
+                    p = brace + 1;
+                    continue;
+                }
+                result.tokens.push_back(std::move(t));
+                p = q + 1;
             }
-
-            return replace_params(source, exp_replace_map, enum_replace_map, dest);
+            add_text(p, end);
+            return result;
         }
 
-        bool fw_string_formatter::replace_params(const string& source, const map<string, string>& exp_replace_map, const map<string, int>& enum_replace_map, string* dest)
+        void fw_string_formatter::format(const fw_log_format& format, const uint32_t* params, string* dest) const
         {
-            string source_temp(source);
-
-            for (auto exp_replace_it = exp_replace_map.begin(); exp_replace_it != exp_replace_map.end(); exp_replace_it++)
-            {
-                string destTemp;
-                regex e(exp_replace_it->first);
-                auto res = regex_replace(back_inserter(destTemp), source_temp.begin(), source_temp.end(), e, exp_replace_it->second);
-                source_temp = destTemp;
-            }
-
-            for (auto exp_replace_it = enum_replace_map.begin(); exp_replace_it != enum_replace_map.end(); exp_replace_it++)
+            dest->clear();
+            char buf[32];
+            for (auto& t : format.tokens)
             {
-                string destTemp;
-                regex e(exp_replace_it->first);
-                std::smatch m;
-                std::regex_search(source_temp, m, std::regex(e));
-
-                string enum_name;
-
-                string st_regular_exp = "[a-zA-Z]+";
-                regex e1(st_regular_exp);
-
-                for (size_t exp = 0; exp < m.size(); exp++)
+                switch (t.kind)
                 {
-                    string str = m[exp];
-
-                    std::smatch m1;
-
-                    regex e2 = e1;
-                    std::regex_search(str, m1, std::regex(e2));
-
-                    for (size_t exp = 0; exp < m1.size(); exp++)
+                case fw_log_format::token::literal:
+                    dest->append(t.text);
+                    break;
+                case fw_log_format::token::dec:
+                    dest->append(buf, snprintf(buf, sizeof(buf), "%u", params[t.param]));
+                    break;
+                case fw_log_format::token::hex:
+                    dest->append(buf, snprintf(buf, sizeof(buf), "%02x", params[t.param]));
+                    break;
+                case fw_log_format::token::flt:
+                {
+                    // Parse int32_t as 4 raw bytes of float
+                    float tmp;
+                    memcpy(&tmp, &params[t.param], sizeof(tmp));
+                    if (std::isfinite(tmp))
                     {
-                        enum_name = m1[exp];
-                        if (_enums.size() > 0 && _enums.find(enum_name) != _enums.end())
-                        {
-                            auto vec = _enums[enum_name];
-                            regex e3 = e;
-                            // Verify user's input is within the enumerated range
-                            int val = exp_replace_it->second;
-                            auto it = std::find_if(vec.begin(), vec.end(), [val](kvp& entry) { return entry.first == val; });
-                            if (it != vec.end())
-                            {
-                                regex_replace(back_inserter(destTemp), source_temp.begin(), source_temp.end(), e3, it->second);
-                            }
-                            else
-                            {
-                                stringstream s;
-                                s << "Protocol Error recognized!\nImproper log message received: " << source_temp
-                                    << ", invalid parameter: " << exp_replace_it->second << ".\n The range of supported values is \n";
-                                for_each(vec.begin(), vec.end(), [&s](kvp& entry) { s << entry.first << ":" << entry.second << " ,"; });
-                                std::cout << s.str().c_str() << std::endl;;
-                            }
-                            source_temp = destTemp;
-                        }
+                        ostringstream st;
+                        st << tmp;
+                        dest->append(st.str());
                     }
+                    else
+                    {
+                        LOG_ERROR("Expecting a number, received infinite or NaN");
+                        dest->append(buf, snprintf(buf, sizeof(buf), "0x%02x", params[t.param]));
+                    }
+                    break;
+                }
+                case fw_log_format::token::enumerated:
+                {
+                    // Verify the value is within the enumerated range
+                    auto it = t.values->find(int(params[t.param]));
+                    if (it != t.values->end())
+                        dest->append(it->second);
+                    else
+                    {
+                        LOG_WARNING("Protocol Error recognized! Improper log message received: invalid parameter "
+                                    << params[t.param] << " for " << t.text);
+                        dest->append(buf, snprintf(buf, sizeof(buf), "%u", params[t.param]));
+                    }
+                    break;
+                }
                 }
             }
+        }
+
+        bool fw_string_formatter::generate_message(const string& source, size_t num_of_params, const uint32_t* params, string* dest)
+        {
+            if (params == nullptr && num_of_params > 0) return false;
 
-            *dest = source_temp;
+            format(compile(source, num_of_params), params, dest);
             return true;
         }
     }
@@ -11,18 +11,34 @@ namespace librealsense
 {
     namespace fw_logs
     {
+        // A message format from the XML, split once into its text and the parameters in between:
+        //     {0} decimal, {0:x} hex, {0:f} the bits of a float, {0,EnumName} the enum's name for the value
+        struct fw_log_format
+        {
+            struct token
+            {
+                enum kind_t { literal, dec, hex, flt, enumerated } kind = literal;
+                size_t param = 0;
+                std::string text;  // For literals, or the enum's name
+                std::unordered_map< int, std::string > const * values = nullptr;  // For enumerated, if it's known
+            };
+            std::vector< token > tokens;
+        };
+
         class fw_string_formatter
         {
         public:
             fw_string_formatter(std::unordered_map<std::string, std::vector<std::pair<int, std::string>>> enums);
             ~fw_string_formatter(void);
 
+            // The formats point into the formatter, for the enums: they're only good for as long as it is
+            fw_log_format compile(const std::string& source, size_t num_of_params) const;
+            void format(const fw_log_format& format, const uint32_t* params, std::string* dest) const;
+
             bool generate_message(const std::string& source, size_t num_of_params, const uint32_t* params, std::string* dest);
 
         private:
-            bool replace_params(const std::string& source, const std::map<std::string, std::string>& exp_replace_map, const std::map<std::string, int>& enum_replace_map, std::string* dest);
-
-            std::unordered_map<std::string, std::vector<std::pair<int, std::string>>> _enums;
+            std::unordered_map<std::string, std::unordered_map<int, std::string>> _enums;
         };
     }
 }
@@ -42,6 +42,12 @@ namespace librealsense
     public:
         // Signed FW update
         virtual void update( const void * fw_image, int fw_image_size, rs2_update_progress_callback_sptr = nullptr ) const = 0;
+
+        // The same, with an image check_fw_compatibility() already accepted (e.g., once for several devices)
+        virtual void update_checked( const void * fw_image, int fw_image_size, rs2_update_progress_callback_sptr callback ) const
+        {
+            update( fw_image, fw_image_size, callback );
+        }
     };
 
     MAP_EXTENSION(RS2_EXTENSION_UPDATE_DEVICE, update_device_interface);
@@ -81,7 +81,7 @@ namespace librealsense
         LOG_INFO("DFU status: " << lock_status << " , DFU version is: " << payload.dfu_version);
     }
 
-    bool update_device::wait_for_state(std::shared_ptr<platform::usb_messenger> messenger, const rs2_dfu_state state, size_t timeout) const
+    bool update_device::wait_for_state(std::shared_ptr<platform::usb_messenger> messenger, const rs2_dfu_state state, size_t timeout, size_t poll_interval) const
     {
         std::chrono::milliseconds elapsed_milliseconds;
         auto start = std::chrono::system_clock::now();
@@ -103,7 +103,7 @@ namespace librealsense
             }
 
             // FW doesn't set the bwPollTimeout value, therefore it is wrong to use status.bwPollTimeout
-            std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_TIMEOUT));
+            std::this_thread::sleep_for(std::chrono::milliseconds(poll_interval));
 
             auto curr = std::chrono::system_clock::now();
             elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(curr - start);
@@ -152,6 +152,11 @@ namespace librealsense
         if (!check_fw_compatibility(buffer))
             throw librealsense::invalid_value_exception("Device: " + get_serial_number() + " failed to update firmware\nImage is unsupported for this device or corrupted");
 
+        update_checked(fw_image, fw_image_size, update_progress_callback);
+    }
+
+    void update_device::update_checked(const void* fw_image, int fw_image_size, rs2_update_progress_callback_sptr update_progress_callback) const
+    {
         auto messenger = _usb_device->open(FW_UPDATE_INTERFACE_NUMBER);
 
         const size_t transfer_size = 1024;
@@ -170,7 +175,9 @@ namespace librealsense
 
             auto curr_block = ((uint8_t*)fw_image + offset);
             auto sts = messenger->control_transfer(0x21 /*DFU_DOWNLOAD_PACKET*/, RS2_DFU_DOWNLOAD, block_number, 0, curr_block, uint32_t(chunk_size), transferred, 5000);
-            if (sts != platform::RS2_USB_STATUS_SUCCESS || !wait_for_state(messenger, RS2_DFU_STATE_DFU_DOWNLOAD_IDLE, 1000))
+            // A block is written in less than the default poll interval, which would otherwise add up to most of
+            // the update
+            if (sts != platform::RS2_USB_STATUS_SUCCESS || !wait_for_state(messenger, RS2_DFU_STATE_DFU_DOWNLOAD_IDLE, 1000, 10))
             {
                 auto state = get_dfu_state(messenger);
                 // the update process may be interrupted by another thread that trys to create another fw_update_device.
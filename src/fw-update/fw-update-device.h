@@ -105,6 +105,7 @@ namespace librealsense
         virtual ~update_device();
 
         virtual void update(const void* fw_image, int fw_image_size, rs2_update_progress_callback_sptr = nullptr) const override;
+        virtual void update_checked(const void* fw_image, int fw_image_size, rs2_update_progress_callback_sptr) const override;
         
         virtual sensor_interface& get_sensor(size_t i) override;
 
@@ -145,7 +146,8 @@ namespace librealsense
     protected:
         rs2_dfu_state get_dfu_state(std::shared_ptr<platform::usb_messenger> messenger) const;
         void detach(std::shared_ptr<platform::usb_messenger> messenger) const;
-        bool wait_for_state(std::shared_ptr<platform::usb_messenger> messenger, const rs2_dfu_state state, size_t timeout = 1000) const;
+        bool wait_for_state(std::shared_ptr<platform::usb_messenger> messenger, const rs2_dfu_state state, size_t timeout = 1000,
+                            size_t poll_interval = 100) const;
         void read_device_info(std::shared_ptr<platform::usb_messenger> messenger);
 
         const std::string & get_name() const { return _name; }
@@ -0,0 +1,100 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "fw-update-devices.h"
+#include "fw-update-device-interface.h"
+
+#include <src/core/info-interface.h>
+#include <src/librealsense-exception.h>
+#include <librealsense2/h/rs_types.h>
+#include <rsutils/easylogging/easyloggingpp.h>
+#include <rsutils/string/from.h>
+
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+
+namespace librealsense
+{
+    static std::string info_or_empty( const device_interface & dev, rs2_camera_info info )
+    {
+        return dev.supports_info( info ) ? dev.get_info( info ) : std::string();
+    }
+
+    void update_devices( std::vector< std::shared_ptr< device_interface > > const & devices,
+                         const void * fw_image,
+                         int fw_image_size,
+                         std::vector< rs2_update_progress_callback_sptr > const & callbacks )
+    {
+        std::vector< update_device_interface * > updaters;
+        std::vector< std::string > errors( devices.size() );
+        std::map< std::string, bool > compatible;  // By kind of device
+        std::vector< uint8_t > image( (const uint8_t *)fw_image, (const uint8_t *)fw_image + fw_image_size );
+        for( size_t i = 0; i < devices.size(); ++i )
+        {
+            auto fwu = dynamic_cast< update_device_interface * >( devices[i].get() );
+            if( ! fwu )
+                throw invalid_value_exception( rsutils::string::from() << "Device #" << i << " is not in update state" );
+            updaters.push_back( fwu );
+
+            auto kind = info_or_empty( *devices[i], RS2_CAMERA_INFO_PRODUCT_LINE ) + '/'
+                      + info_or_empty( *devices[i], RS2_CAMERA_INFO_PRODUCT_ID );
+            auto it = compatible.find( kind );
+            if( it == compatible.end() )
+            {
+                bool ok = false;
+                try
+                {
+                    ok = fwu->check_fw_compatibility( image );
+                }
+                catch( std::exception const & e )
+                {
+                    errors[i] = e.what();
+                }
+                it = compatible.emplace( kind, ok ).first;
+            }
+            if( ! it->second && errors[i].empty() )
+                errors[i] = "Image is unsupported for this device or corrupted";
+        }
+
+        // The transfers are each on their own USB device: the threads have nothing to share
+        std::vector< std::thread > threads;
+        for( size_t i = 0; i < devices.size(); ++i )
+        {
+            if( ! errors[i].empty() )
+                continue;
+            threads.emplace_back( [&, i]()
+            {
+                try
+                {
+                    updaters[i]->update_checked( image.data(), fw_image_size,
+                                                 i < callbacks.size() ? callbacks[i] : nullptr );
+                }
+                catch( std::exception const & e )
+                {
+                    errors[i] = e.what();
+                }
+                catch( ... )
+                {
+                    errors[i] = "unknown error";
+                }
+            } );
+        }
+        for( auto & t : threads )
+            t.join();
+
+        std::ostringstream failed;
+        for( size_t i = 0; i < devices.size(); ++i )
+        {
+            if( errors[i].empty() )
+                continue;
+            auto sn = info_or_empty( *devices[i], RS2_CAMERA_INFO_SERIAL_NUMBER );
+            LOG_ERROR( "Firmware update of device " << sn << " failed: " << errors[i] );
+            failed << "\n" << ( sn.empty() ? rsutils::string::from() << "#" << i : sn ) << ": " << errors[i];
+        }
+        if( failed.tellp() > 0 )
+            throw std::runtime_error( "Firmware update failed for:" + failed.str() );
+    }
+}
@@ -0,0 +1,22 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <src/core/device-interface.h>
+#include <librealsense2/hpp/rs_types.hpp>
+
+#include <memory>
+#include <vector>
+
+
+namespace librealsense
+{
+    // Signed FW update of several devices in DFU state at once, each on a thread of its own; 'callbacks' has the
+    // progress callback of each device (or null). The image is checked once for each kind of device (product line
+    // and ID) rather than once per device.
+    // Returns when all are done; throws, naming each that failed, if any did.
+    void update_devices( std::vector< std::shared_ptr< device_interface > > const & devices,
+                         const void * fw_image,
+                         int fw_image_size,
+                         std::vector< rs2_update_progress_callback_sptr > const & callbacks );
+}
@@ -38,6 +38,7 @@ void align_gl::cleanup_gpu_resources()
     _pc.reset();
     _other_texture.reset();
     _upload.reset();
+    _readback.clear();
     _enabled = 0;
 }
 
@@ -97,6 +98,10 @@ void align_gl::align_z_to_other(rs2::video_frame& aligned,
     //aligned.get_data();
     aligned = _upload->process(aligned);
     aligned = _upload->process(aligned);
+
+    perform_gl_action([&] {
+        _readback.push(aligned);
+    }, [] {});
 }
 
 // From: https://jamesgregson.blogspot.com/2011/11/matching-calibrated-cameras-with-opengl.html
@@ -258,9 +263,13 @@ void align_gl::align_other_to_z(rs2::video_frame& aligned,
     auto intr = prof.as<video_stream_profile>().get_intrinsics();
     auto extr = prof.get_extrinsics_to(prof);
     render(p, other, intr, extr, output_rgb);
+
+    perform_gl_action([&] {
+        _readback.push(aligned);
+    }, [] {});
 }
 
-align_gl::align_gl(rs2_stream to_stream) : align(to_stream, "Align (GLSL)")
+align_gl::align_gl(rs2_stream to_stream) : align(to_stream, "Align (GLSL)"), _readback(*this)
 {
     _source.add_extension<gpu_video_frame>(RS2_EXTENSION_VIDEO_FRAME_GL);
     _source.add_extension<gpu_depth_frame>(RS2_EXTENSION_DEPTH_FRAME_GL);
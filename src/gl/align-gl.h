@@ -60,6 +60,7 @@ namespace librealsense
             std::shared_ptr<rs2::gl::pointcloud_renderer> _renderer;
             std::shared_ptr<rs2::gl::uploader> _upload;
             std::shared_ptr<rs2::texture_buffer> _other_texture;
+            readback_ring _readback;
         };
     }
 }
@@ -350,11 +350,13 @@ namespace librealsense
 
             _shader.reset();
             _pick_shader.reset();
-            _model.reset();
+            for (auto& model : _models)
+                model.reset();
             _vertex_texture.reset();
             _uvs_texture.reset();
             _viz.reset();
             _fbo.reset();
+            _uploaded = false;
         }
 
         pointcloud_renderer::~pointcloud_renderer()
@@ -374,9 +376,7 @@ namespace librealsense
 
                 _vertex_texture = std::make_shared<rs2::texture_buffer>();
                 _uvs_texture = std::make_shared<rs2::texture_buffer>();
-
-                obj_mesh mesh = make_grid(_width, _height);
-                _model = vao::create(mesh);
+                _uploaded = false;
 
                 _fbo = std::make_shared<fbo>(1, 1);
                 glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -414,6 +414,7 @@ namespace librealsense
             register_option(OPTION_NORMAL_Z, std::make_shared<librealsense::float_option>(option_range{ -1.f, 1.f, 0, 0 }));
 
             register_option(OPTION_SCALE_FACTOR, std::make_shared<librealsense::float_option>(option_range{ 1, 4, 0, 1 }));
+            register_option(OPTION_LEVEL_OF_DETAIL, std::make_shared<librealsense::float_option>(option_range{ 0, 1, 1, 1 }));
             
             _filled_opt = &get_option(OPTION_FILLED);
             _mouse_x_opt = &get_option(OPTION_MOUSE_X);
@@ -430,10 +431,51 @@ namespace librealsense
             _normal_y_opt = &get_option(OPTION_NORMAL_Y);
             _normal_z_opt = &get_option(OPTION_NORMAL_Z);
             _scale_factor_opt = &get_option(OPTION_SCALE_FACTOR);
+            _lod_opt = &get_option(OPTION_LEVEL_OF_DETAIL);
 
             initialize();
         }
 
+        int pointcloud_renderer::lod_stride(const rs2::matrix4& p, const rs2::matrix4& v, const rs2::matrix4& f,
+            const int32_t vp[4]) const
+        {
+            // How far apart on the screen, in pixels, two neighboring depth pixels at 1m are (see translate_3d_to_2d
+            // for the order of the matrices)
+            matrix4 pc, vc, fc;
+            for (int i = 0; i < 4; i++)
+                for (int j = 0; j < 4; j++)
+                {
+                    pc(i, j) = p(j, i);
+                    vc(i, j) = v(j, i);
+                    fc(i, j) = f(j, i);
+                }
+            auto mvp = pc * vc * fc;
+            auto a = mvp * rs2::float4{ 0.f, 0.f, 1.f, 1.f };
+            auto b = mvp * rs2::float4{ 1.f / _fx, 1.f / _fx, 1.f, 1.f };
+            if (a.w <= 0.f || b.w <= 0.f)
+                return 1;   // Behind us: nothing to go by
+            auto dx = (b.x / b.w - a.x / a.w) * vp[2] / 2;
+            auto dy = (b.y / b.w - a.y / a.w) * vp[3] / 2;
+            auto footprint = std::max(std::abs(dx), std::abs(dy));
+
+            // About a point per screen pixel
+            int stride = 1;
+            while (stride < MAX_LOD_STRIDE && footprint * stride * 2 <= 1.f)
+                stride *= 2;
+            return stride;
+        }
+
+        std::shared_ptr<rs2::vao> pointcloud_renderer::get_model(int stride)
+        {
+            auto& model = _models[stride];
+            if (!model)
+            {
+                obj_mesh mesh = make_grid((_width + stride - 1) / stride, (_height + stride - 1) / stride);
+                model = vao::create(mesh);
+            }
+            return model;
+        }
+
         rs2::frame pointcloud_renderer::process_frame(const rs2::frame_source& src, const rs2::frame& f)
         {
             //scoped_timer t("pointcloud_renderer");
@@ -472,13 +514,25 @@ namespace librealsense
                     {
                         if (_width != width || _height != height)
                         {
-                            obj_mesh mesh = make_grid(width, height);
-                            _model = vao::create(mesh);
+                            for (auto& model : _models)
+                                model.reset();
 
                             _width = width;
                             _height = height;
+
+                            _fx = width / 2.f;  // About 90 degrees across, unless the profile says otherwise
+                            try
+                            {
+                                _fx = vf_profile.get_intrinsics().fx;
+                            }
+                            catch (...) {}
                         }
 
+                        int32_t lod_vp[4];
+                        glGetIntegerv(GL_VIEWPORT, lod_vp);
+                        int stride = _lod_opt->query() > 0.f ? lod_stride(p, v, f, lod_vp) : 1;
+                        auto model = get_model(stride);
+
                         auto points_f = (frame_interface*)points.get();
 
                         uint32_t vertex_tex_id = 0;
@@ -494,16 +548,26 @@ namespace librealsense
                         }
                         else
                         {
-                            _vertex_texture->upload(points, RS2_FORMAT_XYZ32F);
-                            vertex_tex_id = _vertex_texture->get_gl_handle();
+                            // The same points are drawn over and over until new ones come
+                            auto uid = points.get_profile().unique_id();
+                            if (!_uploaded || _uploaded_number != points.get_frame_number()
+                                || _uploaded_timestamp != points.get_timestamp() || _uploaded_uid != uid)
+                            {
+                                _vertex_texture->upload(points, RS2_FORMAT_XYZ32F);
+                                _uvs_texture->upload(points, RS2_FORMAT_Y16);
 
-                            _uvs_texture->upload(points, RS2_FORMAT_Y16);
+                                _uploaded = true;
+                                _uploaded_number = points.get_frame_number();
+                                _uploaded_timestamp = points.get_timestamp();
+                                _uploaded_uid = uid;
+                            }
+                            vertex_tex_id = _vertex_texture->get_gl_handle();
                             uv_tex_id = _uvs_texture->get_gl_handle();
                         }
 
                         if (!error)
                         {
-                            auto render_pc = [this, &vf_profile, curr_tex, vertex_tex_id, uv_tex_id]
+                            auto render_pc = [this, &vf_profile, &model, stride, curr_tex, vertex_tex_id, uv_tex_id]
                                 (std::shared_ptr<pointcloud_shader> shader, const rs2::matrix4& p){
                                 shader->begin();
                                 shader->set_mvp(get_matrix(
@@ -525,8 +589,16 @@ namespace librealsense
                                 glActiveTexture(GL_TEXTURE0 + shader->uvs_slot());
                                 glBindTexture(GL_TEXTURE_2D, uv_tex_id);
 
-                                if (_filled_opt->query() > 0.f) _model->draw();
-                                else _model->draw_points();
+                                if (_filled_opt->query() > 0.f) model->draw();
+                                else
+                                {
+                                    // Each point stands for stride x stride of them
+                                    GLfloat point_size = 1.f;
+                                    glGetFloatv(GL_POINT_SIZE, &point_size);
+                                    glPointSize(point_size * stride);
+                                    model->draw_points();
+                                    glPointSize(point_size);
+                                }
 
                                 glActiveTexture(GL_TEXTURE0 + shader->texture_slot());
 
@@ -91,25 +91,41 @@ namespace librealsense
 
             static const auto OPTION_SCALE_FACTOR = rs2_option(RS2_OPTION_COUNT + 15);
 
+            // When on (the default), the cloud is drawn with every 2nd, 4th or 8th point in each direction once its
+            // points are close enough together on the screen, the points being drawn that much bigger
+            static const auto OPTION_LEVEL_OF_DETAIL = rs2_option(RS2_OPTION_COUNT + 16);
+            static const int MAX_LOD_STRIDE = 8;
+
             void cleanup_gpu_resources() override;
             void create_gpu_resources() override;
 
             rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
         private:
+            // The subsampling its points call for: 1 to draw every one, up to MAX_LOD_STRIDE
+            int lod_stride(const rs2::matrix4& p, const rs2::matrix4& v, const rs2::matrix4& f, const int32_t vp[4]) const;
+            // The grid of every stride-th point, made the first time it's needed
+            std::shared_ptr<rs2::vao> get_model(int stride);
+
             std::shared_ptr<pointcloud_shader> _shader;
             std::shared_ptr<pointcloud_shader> _pick_shader;
-            std::shared_ptr<rs2::vao> _model;
+            std::shared_ptr<rs2::vao> _models[MAX_LOD_STRIDE + 1];  // By stride
             std::shared_ptr<rs2::texture_buffer> _vertex_texture;
             std::shared_ptr<rs2::texture_buffer> _uvs_texture;
             std::shared_ptr<rs2::texture_visualizer> _viz;
             std::shared_ptr<rs2::fbo> _fbo;
             int _width = 0;
             int _height = 0;
+            float _fx = 0.f;    // Of the depth, for the screen footprint of its pixels
+            // The points frame in the textures, which is only uploaded again when it's another
+            bool _uploaded = false;
+            unsigned long long _uploaded_number = 0;
+            double _uploaded_timestamp = 0;
+            int _uploaded_uid = 0;
             option *_filled_opt, *_mouse_x_opt, *_mouse_y_opt, *_mouse_pick_opt,
                 *_picked_id_opt, *_picked_x_opt, *_picked_y_opt, *_picked_z_opt, 
                 *_selected_opt, *_shaded_opt, *_origin_picked_opt,
-                *_normal_x_opt, *_normal_y_opt, *_normal_z_opt, *_scale_factor_opt;
+                *_normal_x_opt, *_normal_y_opt, *_normal_z_opt, *_scale_factor_opt, *_lod_opt;
             uint32_t color_tex;
             uint32_t xyz_tex;
 
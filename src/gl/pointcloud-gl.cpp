@@ -48,6 +48,8 @@ static const char* project_fragment_text =
 "uniform float height2;\n"
 "\n"
 "uniform float needs_projection;\n"
+"uniform vec3 bounds_min;\n"
+"uniform vec3 bounds_max;\n"
 "\n"
 "void main(void) {\n"
 "    float px = textCoords.x * width1;\n"
@@ -87,6 +89,11 @@ static const char* project_fragment_text =
 "    float nd = (dp.x + dp.y * 256.0) * 256.0;\n"
 "    float depth = depth_scale * nd;\n"
 "    vec4 xyz = vec4(x * depth, y * depth, depth, 1.0);\n"
+"    if (any(lessThan(xyz.xyz, bounds_min)) || any(greaterThan(xyz.xyz, bounds_max))) {\n"
+"        output_xyz = vec4(0.0, 0.0, 0.0, 1.0);\n"
+"        output_uv = vec4(0.0, 0.0, 0.0, 1.0);\n"
+"        return;\n"
+"    }\n"
 "    output_xyz = xyz;\n"
 ""
 "    if (needs_projection > 0) {"
@@ -262,6 +269,15 @@ public:
         _extrinsics_location = _shader->get_uniform_location("extrinsics");
 
         _requires_projection_location = _shader->get_uniform_location("needs_projection");
+        _bounds_min_location = _shader->get_uniform_location("bounds_min");
+        _bounds_max_location = _shader->get_uniform_location("bounds_max");
+    }
+
+    // Points outside the box come out at zero, like the points without depth
+    void set_bounds(const float min[3], const float max[3])
+    {
+        _shader->load_uniform(_bounds_min_location, rs2::float3{ min[0], min[1], min[2] });
+        _shader->load_uniform(_bounds_max_location, rs2::float3{ max[0], max[1], max[2] });
     }
 
     void requires_projection(bool val)
@@ -316,6 +332,8 @@ private:
     uint32_t _extrinsics_location;
 
     uint32_t _requires_projection_location;
+    uint32_t _bounds_min_location;
+    uint32_t _bounds_max_location;
 };
 
 class occulution_shader : public texture_2d_shader
@@ -375,6 +393,7 @@ void pointcloud_gl::cleanup_gpu_resources()
 {
     _projection_renderer.reset();
     _occu_renderer.reset();
+    _readback.clear();
     _enabled = 0;
 }
 void pointcloud_gl::create_gpu_resources()
@@ -403,7 +422,7 @@ pointcloud_gl::~pointcloud_gl()
 }
 
 pointcloud_gl::pointcloud_gl()
-    : pointcloud("Pointcloud (GLSL)"), _depth_data(rs2::frame{})
+    : pointcloud("Pointcloud (GLSL)"), _depth_data(rs2::frame{}), _readback(*this)
 {
     _source.add_extension<gl::gpu_points_frame>(RS2_EXTENSION_VIDEO_FRAME_GL);
 
@@ -532,6 +551,7 @@ void pointcloud_gl::get_texture_map(
         shader.set_extrinsics(extr);
         shader.set_size(0, width, height);
         shader.set_size(1, other_intrinsics.width, other_intrinsics.height);
+        shader.set_bounds(_bounds.min, _bounds.max);
         
         viz->draw_texture(depth_texture);
         shader.end();
@@ -607,6 +627,8 @@ void pointcloud_gl::get_texture_map(
         {
             glDeleteTextures(1, &depth_texture);
         }
+
+        _readback.push(output);
     }, [&]{
         _enabled = false;
     });
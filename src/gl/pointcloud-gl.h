@@ -44,6 +44,7 @@ namespace librealsense
             float _depth_scale;
             rs2_intrinsics _depth_intr;
             int _enabled = 0;
+            readback_ring _readback;
         };
     }
 }
@@ -46,6 +46,17 @@ namespace librealsense
             throw std::runtime_error("Selected RealSense format cannot be converted to GL format!");
         }
 
+        void wait_for(GLsync fence)
+        {
+            if (!fence)
+                return;
+            GLenum res;
+            do
+            {
+                res = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1ms
+            } while (res == GL_TIMEOUT_EXPIRED);
+        }
+
         void gpu_section::ensure_init()
         {
             if (!initialized)
@@ -181,6 +192,18 @@ namespace librealsense
                     textures[i] = 0;
                 }
             }
+            if (fetch_fence)
+            {
+                glDeleteSync(fetch_fence);
+                fetch_fence = nullptr;
+            }
+            if (fetch_pbo)
+            {
+                glDeleteBuffers(1, &fetch_pbo);
+                fetch_pbo = 0;
+                fetch_pbo_size = 0;
+            }
+            fetching = false;
         }
 
         gpu_section::~gpu_section()
@@ -228,6 +251,7 @@ namespace librealsense
             {
                 loaded[i] = false;
             }
+            fetching = false;
         }
 
         void gpu_section::on_unpublish()
@@ -236,6 +260,7 @@ namespace librealsense
             {
                 loaded[i] = false;
             }
+            fetching = false;
         }
 
         void gpu_section::output_texture(int id, uint32_t* tex, texture_type type)
@@ -280,6 +305,79 @@ namespace librealsense
             return res;
         }
 
+        // With a pixel pack buffer bound, 'to' is an offset into it
+        void gpu_section::read_textures(uint8_t* to)
+        {
+            auto ptr = to;
+
+            for (int i = 0; i < MAX_TEXTURES; i++)
+            if (textures[i] && loaded[i])
+            {
+                auto& vis = get_texture_visualizer();
+                //rs2::visualizer_2d vis;
+                rs2::fbo fbo(width, height);
+                uint32_t res;
+                glGenTextures(1, &res);
+                glBindTexture(GL_TEXTURE_2D, res);
+
+                auto textype = gl_format_mapping(types[i]);
+                if (textype.size)
+                    glTexImage2D(GL_TEXTURE_2D, 0, textype.internal_format, 
+                        width, height, 0, textype.gl_format, textype.data_type, nullptr);
+
+                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, res, 0);
+
+                fbo.bind();
+                glViewport(0, 0, width, height);
+                glClearColor(0, 0, 0, 1);
+                glClear(GL_COLOR_BUFFER_BIT);
+                vis.draw_texture(textures[i]);
+                glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+                if (textype.size)
+                {
+                    glReadPixels(0, 0, width, height, textype.gl_format, textype.data_type, ptr);
+                    ptr += width * height * textype.size;
+                }
+                
+                glDeleteTextures(1, &res);
+                
+                fbo.unbind();
+            }
+        }
+
+        void gpu_section::begin_fetch()
+        {
+            if (preloaded || !*this)
+                return;
+
+            auto size = get_frame_size();
+            if (!fetch_pbo)
+                glGenBuffers(1, &fetch_pbo);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, fetch_pbo);
+            if (size > fetch_pbo_size)
+            {
+                glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+                fetch_pbo_size = size;
+            }
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            read_textures(nullptr);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+            if (fetch_fence)
+                glDeleteSync(fetch_fence);
+            fetch_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            // Without a flush, the commands may not even be on their way before someone waits for them
+            glFlush();
+            fetching = true;
+        }
+
+        void gpu_section::wait_fetch()
+        {
+            if (fetching)
+                wait_for(fetch_fence);
+        }
+
         void gpu_section::fetch_frame(void* to)
         {
             if (preloaded) return;
@@ -293,50 +391,59 @@ namespace librealsense
             if (need_to_fetch)
             {
                 perform_gl_action([&]{
-                    auto ptr = (uint8_t*)to;
-
-                    for (int i = 0; i < MAX_TEXTURES; i++)
-                    if (textures[i] && loaded[i])
+                    if (fetching)
                     {
-                        auto& vis = get_texture_visualizer();
-                        //rs2::visualizer_2d vis;
-                        rs2::fbo fbo(width, height);
-                        uint32_t res;
-                        glGenTextures(1, &res);
-                        glBindTexture(GL_TEXTURE_2D, res);
-
-                        auto textype = gl_format_mapping(types[i]);
-                        if (textype.size)
-                            glTexImage2D(GL_TEXTURE_2D, 0, textype.internal_format, 
-                                width, height, 0, textype.gl_format, textype.data_type, nullptr);
-
-                        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, res, 0);
-
-                        fbo.bind();
-                        glViewport(0, 0, width, height);
-                        glClearColor(0, 0, 0, 1);
-                        glClear(GL_COLOR_BUFFER_BIT);
-                        vis.draw_texture(textures[i]);
-                        glReadBuffer(GL_COLOR_ATTACHMENT0);
-
-                        if (textype.size)
+                        wait_for(fetch_fence);
+                        auto size = get_frame_size();
+                        glBindBuffer(GL_PIXEL_PACK_BUFFER, fetch_pbo);
+                        if (auto data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT))
                         {
-                            glReadPixels(0, 0, width, height, textype.gl_format, textype.data_type, ptr);
-                            ptr += width * height * textype.size;
+                            memcpy(to, data, size);
+                            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
                         }
-                        
-                        glDeleteTextures(1, &res);
-                        
-                        fbo.unbind();
-
-                        preloaded = true;
+                        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                        fetching = false;
+                    }
+                    else
+                    {
+                        read_textures((uint8_t*)to);
                     }
+                    preloaded = true;
                 }, [&]{
                     memcpy(to, backup.get(), get_frame_size());
                 });
             }
         }
 
+        readback_ring::readback_ring(options_container& block)
+        {
+            auto opt = std::make_shared<librealsense::ptr_option<int>>(
+                0, 4, 1, 0, &_depth, "Frames of readback to the host left in flight; 0 reads back on demand");
+            block.register_option(RS2_OPTION_READBACK_LATENCY, opt);
+        }
+
+        void readback_ring::push(const rs2::frame& f)
+        {
+            if (!_depth)
+            {
+                _frames.clear();
+                return;
+            }
+
+            auto gf = dynamic_cast<gpu_addon_interface*>((frame_interface*)f.get());
+            if (!gf)
+                return;
+            gf->get_gpu_section().begin_fetch();
+            _frames.push_back(f);
+
+            while (int(_frames.size()) > _depth)
+            {
+                if (auto old = dynamic_cast<gpu_addon_interface*>((frame_interface*)_frames.front().get()))
+                    old->get_gpu_section().wait_fetch();
+                _frames.pop_front();
+            }
+        }
+
         context::context(GLFWwindow* share_with, glfw_binding binding) : _binding(binding)
         {
             if (binding.glfwInit) binding.glfwInit();
@@ -52,6 +52,11 @@ namespace librealsense
             uint32_t data_type;
         };
 
+        // Waits for the GPU to get past a fence, flushing the commands before it; a null fence is passed
+        void wait_for(GLsync fence);
+
+        // Reads pixels back through a ring of N buffers: query() starts a read into the next buffer and returns what the
+        // previous query read, so the copy to the host doesn't wait for the GPU to catch up
         template<class T, int N = 2>
         class pbo
         {
@@ -61,6 +66,7 @@ namespace librealsense
                 glGenBuffers(N, pboIds);
                 for (int i = 0; i < N; i++)
                 {
+                    fences[i] = nullptr;
                     glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[i]);
                     check_gl_error();
                     glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(T) * w * h, 0, GL_STREAM_READ);
@@ -85,6 +91,12 @@ namespace librealsense
                     glReadPixels(x0, y0, w, h, format, type, 0);
                     check_gl_error();
                 }
+                if (fences[next_idx])
+                    glDeleteSync(fences[next_idx]);
+                fences[next_idx] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+                // Mapping the buffer waits for its read anyway, but stalls the whole pipeline while at it
+                wait_for(fences[index]);
 
                 glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[index]);
                 check_gl_error();
@@ -105,11 +117,18 @@ namespace librealsense
 
             void reset()
             {
+                for (int i = 0; i < N; i++)
+                {
+                    if (fences[i])
+                        glDeleteSync(fences[i]);
+                    fences[i] = nullptr;
+                }
                 glDeleteBuffers(N, pboIds);
             }
 
         private:
             uint32_t pboIds[N];
+            GLsync fences[N];
             int index = 0;
         };
 
@@ -356,6 +375,12 @@ namespace librealsense
 
             void set_size(uint32_t width, uint32_t height, bool preloaded = false);
 
+            // Starts reading the output textures back to the host, into a pixel buffer of our own, without waiting
+            // for them: fetch_frame() then only waits for what's left of it. Within a GL session.
+            void begin_fetch();
+            // Waits for the readback begin_fetch() started to be done, without bringing it to the host
+            void wait_fetch();
+
             void cleanup_gpu_resources() override;
             void create_gpu_resources() override;
 
@@ -373,8 +398,13 @@ namespace librealsense
             bool backup_content = true;
             bool preloaded = false;
             bool initialized = false;
+            bool fetching = false;          // The content is on its way into fetch_pbo
+            uint32_t fetch_pbo = 0;
+            int fetch_pbo_size = 0;
+            GLsync fetch_fence = nullptr;
             std::unique_ptr<uint8_t[]> backup;
             void ensure_init();
+            void read_textures(uint8_t* to);
         };
 
         class gpu_addon_interface
@@ -418,6 +448,28 @@ namespace librealsense
             mutable gpu_section _section;
         };
 
+        // The readback of a GLSL block's output frames as they're made, for blocks whose frames are read on the CPU:
+        // with a depth of N, the readback of up to N frames is left in flight, and a new frame waits for the one N
+        // frames back to be done. A frame that's N frames old is then on its way to the host already, and reading it
+        // doesn't wait on the GPU; more depth is more frames of latency for the GPU to absorb.
+        //
+        // A depth of 0 (the default) reads a frame back only when its data is asked for, as GPU consumers never do.
+        class readback_ring
+        {
+        public:
+            // Registers RS2_OPTION_READBACK_LATENCY with the block
+            explicit readback_ring(options_container& block);
+
+            // A frame that was just made; within a GL session
+            void push(const rs2::frame& f);
+
+            void clear() { _frames.clear(); }
+
+        private:
+            int _depth = 0;
+            std::deque<rs2::frame> _frames;
+        };
+
         class gpu_video_frame : public gpu_addon<video_frame> {};
         class gpu_points_frame : public gpu_addon<points> {};
         class gpu_depth_frame : public gpu_addon<depth_frame> {};
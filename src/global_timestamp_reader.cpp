@@ -2,6 +2,7 @@
 // Copyright(c) 2015 Intel Corporation. All Rights Reserved.
 #include "global_timestamp_reader.h"
 #include <chrono>
+#include <cstring>
 
 using namespace std::chrono;
 
@@ -22,136 +23,228 @@ namespace librealsense
     }
 
     CLinearCoefficients::CLinearCoefficients(unsigned int buffer_size) :
-        _base_sample(0, 0),
+        _last_values(buffer_size + 1, CSample(0, 0)),
+        _first(0),
+        _count(0),
+        _added(0),
+        _sum_x(0), _sum_y(0), _sum_xy(0), _sum_x2(0),
         _buffer_size(buffer_size),
-        _time_span_ms(1000) // Spread the linear equation modifications over a whole second.
+        _base_sample(0, 0),
+        _prev_a(0), _prev_b(0),
+        _dest_a(1), _dest_b(0),
+        _prev_time(0),
+        _time_span_ms(1000), // Spread the linear equation modifications over a whole second.
+        _last_request_time(0),
+        _version(0)
     {
+        publish();
     }
 
     void CLinearCoefficients::reset()
     {
-        _last_values.clear();
+        _first = _count = _added = 0;
+        _sum_x = _sum_y = _sum_xy = _sum_x2 = 0;
     }
 
     bool CLinearCoefficients::is_full() const
     {
-        return _last_values.size() >= _buffer_size;
+        return _count >= _buffer_size;
+    }
+
+    void CLinearCoefficients::accumulate(CSample const& sample, double sign)
+    {
+        CSample crnt_sample(sample);
+        crnt_sample -= _base_sample;
+        _sum_x += sign * crnt_sample._x;
+        _sum_y += sign * crnt_sample._y;
+        _sum_xy += sign * (crnt_sample._x * crnt_sample._y);
+        _sum_x2 += sign * (crnt_sample._x * crnt_sample._x);
+    }
+
+    void CLinearCoefficients::recalc_sums()
+    {
+        _sum_x = _sum_y = _sum_xy = _sum_x2 = 0;
+        for (size_t i = 0; i < _count; ++i)
+            accumulate(_last_values[(_first + i) % _last_values.size()], 1);
+        _added = 0;
     }
 
     void CLinearCoefficients::add_value(CSample val)
     {
-        while (_last_values.size() > _buffer_size)
+        if (_count == _last_values.size())
         {
-            _last_values.pop_back();
+            accumulate(_last_values[_first], -1);
+            _first = (_first + 1) % _last_values.size();
+            --_count;
         }
-        _last_values.push_front(val);
+        if (!_count)
+            _base_sample = val;
+        _last_values[(_first + _count) % _last_values.size()] = val;
+        ++_count;
+        // Summed anew every time the ring comes round, so that what's added and taken off doesn't drift
+        if (++_added >= _last_values.size())
+            recalc_sums();
+        else
+            accumulate(val, 1);
         calc_linear_coefs();
+        publish();
     }
 
     void CLinearCoefficients::add_const_y_coefs(double dy)
     {
-        for (auto &&sample : _last_values)
-        {
-            sample._y += dy;
-        }
+        for (size_t i = 0; i < _count; ++i)
+            _last_values[(_first + i) % _last_values.size()]._y += dy;
+        _sum_xy += dy * _sum_x;
+        _sum_y += dy * _count;
     }
 
     void CLinearCoefficients::calc_linear_coefs()
     {
         // Calculate linear coefficients, based on calculus described in: https://www.statisticshowto.datasciencecentral.com/probability-and-statistics/regression-analysis/find-a-linear-regression-equation/
         // Calculate Std
-        double n(static_cast<double>(_last_values.size()));
+        double n(static_cast<double>(_count));
         double a(1);
         double b(0);
         double dt(1);
+        double last_request_time = _last_request_time.load(std::memory_order_relaxed);
         if (n == 1)
         {
-            _base_sample = _last_values.back();
             _dest_a = 1;
             _dest_b = 0;
             _prev_a = 0;
             _prev_b = 0;
-            _last_request_time = _last_values.front()._x;
+            last_request_time = _base_sample._x;
+            _last_request_time.store(last_request_time, std::memory_order_relaxed);
         }
         else
         {
-            double sum_x(0);
-            double sum_y(0);
-            double sum_xy(0);
-            double sum_x2(0);
-            for (auto sample = _last_values.begin(); sample != _last_values.end(); sample++)
-            {
-                CSample crnt_sample(*sample);
-                crnt_sample -= _base_sample;
-                sum_x += crnt_sample._x;
-                sum_y += crnt_sample._y;
-                sum_xy += (crnt_sample._x * crnt_sample._y);
-                sum_x2 += (crnt_sample._x * crnt_sample._x);
-            }
-            b = (sum_y*sum_x2 - sum_x * sum_xy) / (n*sum_x2 - sum_x * sum_x);
-            a = (n*sum_xy - sum_x * sum_y) / (n*sum_x2 - sum_x * sum_x);
+            b = (_sum_y*_sum_x2 - _sum_x * _sum_xy) / (n*_sum_x2 - _sum_x * _sum_x);
+            a = (n*_sum_xy - _sum_x * _sum_y) / (n*_sum_x2 - _sum_x * _sum_x);
 
-            if (_last_request_time - _prev_time < _time_span_ms)
+            if (last_request_time - _prev_time < _time_span_ms)
             {
-                dt = (_last_request_time - _prev_time) / _time_span_ms;
+                dt = (last_request_time - _prev_time) / _time_span_ms;
             }
         }
         _prev_a = _dest_a * dt + _prev_a * (1 - dt);
         _prev_b = _dest_b * dt + _prev_b * (1 - dt);
         _dest_a = a;
         _dest_b = b;
-        _prev_time = _last_request_time;
+        _prev_time = last_request_time;
+    }
+
+    void CLinearCoefficients::publish()
+    {
+        coefs c;
+        c.prev_a = _prev_a;
+        c.prev_b = _prev_b;
+        c.dest_a = _dest_a;
+        c.dest_b = _dest_b;
+        c.prev_time = _prev_time;
+        c.base_x = _base_sample._x;
+        c.base_y = _base_sample._y;
+        c.last_x = _count ? _last_values[(_first + _count - 1) % _last_values.size()]._x : 0;
+        double values[n_published];
+        memcpy(values, &c, sizeof(c));
+
+        auto version = _version.load(std::memory_order_relaxed);
+        _version.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < n_published; ++i)
+            _published[i].store(values[i], std::memory_order_relaxed);
+        _version.store(version + 2, std::memory_order_release);
     }
 
-    void CLinearCoefficients::get_a_b(double x, double& a, double& b) const
+    CLinearCoefficients::coefs CLinearCoefficients::published() const
     {
-        a = _dest_a;
-        b = _dest_b;
-        if (x - _prev_time < _time_span_ms)
+        double values[n_published];
+        unsigned version;
+        do
         {
-            double dt((x - _prev_time) / _time_span_ms);
-            a = _dest_a * dt + _prev_a * (1 - dt);
-            b = _dest_b * dt + _prev_b * (1 - dt);
+            version = _version.load(std::memory_order_acquire);
+            for (size_t i = 0; i < n_published; ++i)
+                values[i] = _published[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
         }
+        while ((version & 1) || _version.load(std::memory_order_relaxed) != version);
+        coefs c;
+        memcpy(&c, values, sizeof(c));
+        return c;
+    }
+
+    void CLinearCoefficients::get_a_b(coefs const& c, double x, double& a, double& b) const
+    {
+        a = c.dest_a;
+        b = c.dest_b;
+        if (x - c.prev_time < _time_span_ms)
+        {
+            double dt((x - c.prev_time) / _time_span_ms);
+            a = c.dest_a * dt + c.prev_a * (1 - dt);
+            b = c.dest_b * dt + c.prev_b * (1 - dt);
+        }
+    }
+
+    double CLinearCoefficients::samples_base_offset(double last_x, double x)
+    {
+        static const double max_device_time(pow(2, 32) * TIMESTAMP_USEC_TO_MSEC);
+        if ((last_x - x) > max_device_time / 2)
+            return max_device_time;
+        if ((x - last_x) > max_device_time / 2)
+            return -max_device_time;
+        return 0;
     }
 
     double CLinearCoefficients::calc_value(double x) const
     {
+        auto c = published();
+        // Once the device time wraps around, and until the samples are moved along with it, it's as far along
+        // as it would have been
+        x += samples_base_offset(c.last_x, x);
         double a, b;
-        get_a_b(x, a, b);
-        double y(a * (x - _base_sample._x) + b + _base_sample._y);
-        //LOG_DEBUG(__FUNCTION__ << ": " << x << " -> " << y << " with coefs:" << a << ", " << b << ", " << _base_sample._x << ", " << _base_sample._y);
+        get_a_b(c, x, a, b);
+        double y(a * (x - c.base_x) + b + c.base_y);
+        //LOG_DEBUG(__FUNCTION__ << ": " << x << " -> " << y << " with coefs:" << a << ", " << b << ", " << c.base_x << ", " << c.base_y);
         return y;
     }
 
     bool CLinearCoefficients::update_samples_base(double x)
     {
-        static const double max_device_time(pow(2, 32) * TIMESTAMP_USEC_TO_MSEC);
-        double base_x;
-        if (_last_values.empty())
+        if (!_count)
             return false;
-        if ((_last_values.front()._x - x) > max_device_time / 2)
-            base_x = max_device_time;
-        else if ((x - _last_values.front()._x) > max_device_time / 2)
-            base_x = -max_device_time;
-        else
+        double base_x = samples_base_offset(_last_values[(_first + _count - 1) % _last_values.size()]._x, x);
+        if (!base_x)
             return false;
         LOG_DEBUG(__FUNCTION__ << "(" << base_x << ")");
 
         double a, b;
-        get_a_b(x+base_x, a, b);
-        for (auto &&sample : _last_values)
-        {
-            sample._x -= base_x;
-        }
+        get_a_b(published(), x+base_x, a, b);
+        for (size_t i = 0; i < _count; ++i)
+            _last_values[(_first + i) % _last_values.size()]._x -= base_x;
         _prev_time -= base_x;
         _base_sample._y += a * base_x;
+        recalc_sums();
+        publish();
         return true;
     }
 
+    double CLinearCoefficients::residual() const
+    {
+        if (_count < 2)
+            return 0;
+        double sum_r2(0);
+        for (size_t i = 0; i < _count; ++i)
+        {
+            CSample crnt_sample(_last_values[(_first + i) % _last_values.size()]);
+            crnt_sample -= _base_sample;
+            double r(crnt_sample._y - (_dest_a * crnt_sample._x + _dest_b));
+            sum_r2 += r * r;
+        }
+        return sqrt(sum_r2 / _count);
+    }
+
     void CLinearCoefficients::update_last_sample_time(double x)
     {
-        _last_request_time = x;
+        _last_request_time.store(x, std::memory_order_relaxed);
     }
 
     time_diff_keeper::time_diff_keeper(global_time_interface* dev, const unsigned int sampling_interval_ms) :
@@ -161,12 +254,15 @@ namespace librealsense
         _users_count(0),
         _is_ready(false),
         _min_command_delay(1000),
+        _telemetry(),
+        _command_total_ms(0),
         _active_object([this](dispatcher::cancellable_timer cancellable_timer)
             {
                 polling(cancellable_timer);
-            })
+            }, "timestamp")
     {
         //LOG_DEBUG("start new time_diff_keeper ");
+        _telemetry.interval_ms = _poll_intervals_ms;
     }
 
     void time_diff_keeper::start()
@@ -189,8 +285,10 @@ namespace librealsense
         {
             LOG_DEBUG("time_diff_keeper::stop: stop object.");
             _active_object.stop();
+            std::lock_guard<std::recursive_mutex> lock(_update_mtx);
             _coefs.reset();
             _is_ready = false;
+            _telemetry.interval_ms = _poll_intervals_ms;
         }
     }
 
@@ -210,24 +308,35 @@ namespace librealsense
             double system_time_finish = duration<double, std::milli>(system_clock::now().time_since_epoch()).count();
             double command_delay = (system_time_finish-system_time_start)/2;
 
-            std::lock_guard<std::recursive_mutex> lock(_read_mtx);
+            std::lock_guard<std::recursive_mutex> lock(_update_mtx);
+            ++_telemetry.polls;
+            _telemetry.command_last_ms = system_time_finish - system_time_start;
+            _command_total_ms += _telemetry.command_last_ms;
+            _telemetry.command_avg_ms = _command_total_ms / _telemetry.polls;
+            _telemetry.command_max_ms = std::max(_telemetry.command_max_ms, _telemetry.command_last_ms);
             if (command_delay < _min_command_delay)
             {
                 _coefs.add_const_y_coefs(command_delay - _min_command_delay);
                 _min_command_delay = command_delay;
             }
             double system_time(system_time_finish - _min_command_delay);
+            double drift(0);
             if (_is_ready)
             {
                 _coefs.update_samples_base(sample_hw_time);
+                drift = system_time - _coefs.calc_value(sample_hw_time);
             }
             CSample crnt_sample(sample_hw_time, system_time);
             _coefs.add_value(crnt_sample);
             _is_ready = true;
+            update_poll_interval(drift);
             return true;
         }
         catch (const io_exception& ex)
         {
+            std::lock_guard<std::recursive_mutex> lock(_update_mtx);
+            ++_telemetry.polls;
+            ++_telemetry.failed_polls;
             LOG_DEBUG("Temporary skip during time_diff_keeper polling: " << ex.what());
         }
         catch (const wrong_api_call_sequence_exception& ex)
@@ -236,19 +345,57 @@ namespace librealsense
         }
         catch (const std::exception& ex)
         {
+            std::lock_guard<std::recursive_mutex> lock(_update_mtx);
+            ++_telemetry.polls;
+            ++_telemetry.failed_polls;
             LOG_ERROR("Error during time_diff_keeper polling: " << ex.what());
         }
         catch (...)
         {
+            std::lock_guard<std::recursive_mutex> lock(_update_mtx);
+            ++_telemetry.polls;
+            ++_telemetry.failed_polls;
             LOG_ERROR("Unknown error during time_diff_keeper polling!");
         }
         return false;
     }
 
+    void time_diff_keeper::update_poll_interval(double drift)
+    {
+        // Below this, a sample that's where the fit says it would be is as good as on it: the command delay alone
+        // varies more
+        static const double min_drift_ms = 0.05;
+
+        // Until there are enough samples, the device clock is read every poll interval; then, every 10, and
+        // twice as long every time the next sample is where the fit predicted it, up to 100
+        _telemetry.residual_ms = _coefs.residual();
+        _telemetry.drift_ms = drift;
+        double interval = _telemetry.interval_ms;
+        if (!_coefs.is_full())
+            interval = _poll_intervals_ms;
+        else if (std::abs(drift) > std::max(3 * _telemetry.residual_ms, min_drift_ms) || interval < 10. * _poll_intervals_ms)
+            interval = 10. * _poll_intervals_ms;
+        else
+            interval = std::min(2 * interval, 100. * _poll_intervals_ms);
+        _telemetry.interval_ms = interval;
+    }
+
+    rs2_global_time_telemetry time_diff_keeper::get_telemetry() const
+    {
+        std::lock_guard<std::recursive_mutex> lock(_update_mtx);
+        auto telemetry = _telemetry;
+        telemetry.users = _users_count;
+        return telemetry;
+    }
+
     void time_diff_keeper::polling(dispatcher::cancellable_timer cancellable_timer)
     {
         update_diff_time();
-        unsigned int time_to_sleep = _poll_intervals_ms + _coefs.is_full() * (9 * _poll_intervals_ms);
+        unsigned int time_to_sleep;
+        {
+            std::lock_guard<std::recursive_mutex> lock(_update_mtx);
+            time_to_sleep = static_cast<unsigned int>(_telemetry.interval_ms);
+        }
         if (!cancellable_timer.try_sleep( std::chrono::milliseconds( time_to_sleep )))
         {
             LOG_DEBUG("Notification: time_diff_keeper polling loop is being shut-down");
@@ -257,11 +404,11 @@ namespace librealsense
 
     double time_diff_keeper::get_system_hw_time(double crnt_hw_time, bool& is_ready)
     {
-        std::lock_guard<std::recursive_mutex> lock(_read_mtx);
+        // Called for every frame of every stream: the coefficients are read as they were last published, without
+        // waiting on the polling; it moves the samples along when the device time wraps around
         is_ready = _is_ready;
-        if (_is_ready)
+        if (is_ready)
         {
-            _coefs.update_samples_base(crnt_hw_time);
             _coefs.update_last_sample_time(crnt_hw_time);
             return _coefs.calc_value(crnt_hw_time);
         }
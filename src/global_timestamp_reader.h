@@ -6,7 +6,9 @@
 #include "sensor.h"
 #include "error-handling.h"
 #include "option.h"
-#include <deque>
+#include <librealsense2/h/rs_device.h>
+#include <atomic>
+#include <vector>
 
 namespace librealsense
 {
@@ -31,6 +33,11 @@ namespace librealsense
         double _y;
     };
 
+    // A linear regression over the last samples, kept as running sums over a fixed ring of them.
+    //
+    // Samples are added (and the regression updated) one writer at a time, under the caller's lock. What the frames
+    // need to convert their timestamps - calc_value() and update_last_sample_time() - can be called from any thread
+    // without one: the coefficients are published, as a whole, through a sequence lock.
     class CLinearCoefficients
     {
     public:
@@ -42,23 +49,49 @@ namespace librealsense
         void update_last_sample_time(double x);
         double calc_value(double x) const;
         bool is_full() const;
+        // RMS of the samples' distance from the fit; by the writer
+        double residual() const;
 
     private:
+        // Everything calc_value() needs, as the readers see it
+        struct coefs
+        {
+            double prev_a, prev_b;    //Linear regression coeffitions - previously used values.
+            double dest_a, dest_b;    //Linear regression coeffitions - recently calculated.
+            double prev_time;
+            double base_x, base_y;
+            double last_x;            //Of the latest sample: where the device time wraps around from
+        };
+        static const size_t n_published = sizeof( coefs ) / sizeof( double );
+
         void calc_linear_coefs();
-        void get_a_b(double x, double& a, double& b) const;
+        void get_a_b(coefs const& c, double x, double& a, double& b) const;
+        void accumulate(CSample const& sample, double sign);
+        void recalc_sums();
+        void publish();
+        coefs published() const;
+        static double samples_base_offset(double last_x, double x);
 
     private:
+        std::vector<CSample> _last_values;   // A ring of _buffer_size + 1 samples, the oldest at _first
+        size_t _first, _count;
+        size_t _added;                       // Since the sums were last summed anew
+        double _sum_x, _sum_y, _sum_xy, _sum_x2;  // Of the samples, relative to the base sample
         unsigned int _buffer_size;
-        std::deque<CSample> _last_values;
         CSample _base_sample;
         double _prev_a, _prev_b;    //Linear regression coeffitions - previously used values.
         double _dest_a, _dest_b;    //Linear regression coeffitions - recently calculated.
         double _prev_time, _time_span_ms;
-        double _last_request_time;
+        std::atomic<double> _last_request_time;
+
+        std::atomic<unsigned> _version;      // Odd while the coefficients are being published
+        std::atomic<double> _published[n_published];
     };
 
     class global_time_interface;
 
+    // Reads the device clock for all the sensors of a device, for as long as any streams with global time. The reads
+    // are control transfers that compete with streaming, so they're as far apart as the fit allows.
     class time_diff_keeper
     {
     public:
@@ -70,9 +103,11 @@ namespace librealsense
         double get_system_hw_time(double crnt_hw_time, bool& is_ready);
         void set_enabling_opt(std::shared_ptr<global_time_option> en_opt){ _option_is_enabled=en_opt; }
         bool is_enabled() const { return _option_is_enabled? _option_is_enabled->is_true() : false; }
+        rs2_global_time_telemetry get_telemetry() const;
 
     private:
         bool update_diff_time();
+        void update_poll_interval(double drift);
         void polling(dispatcher::cancellable_timer cancellable_timer);
 
     private:
@@ -81,11 +116,13 @@ namespace librealsense
         int             _users_count;
         std::shared_ptr<global_time_option> _option_is_enabled;
         active_object<> _active_object;
-        mutable std::recursive_mutex _read_mtx; // Watch only 1 reader at a time.
+        mutable std::recursive_mutex _update_mtx; // Watch only 1 update of the coefficients at a time; reading them takes no lock.
         mutable std::recursive_mutex _enable_mtx; // Watch only 1 start/stop operation at a time.
         CLinearCoefficients _coefs;
         double _min_command_delay;
-        bool _is_ready;
+        std::atomic<bool> _is_ready;
+        rs2_global_time_telemetry _telemetry;   // Under the _update_mtx, like the interval it has
+        double _command_total_ms;
     };
 
     class global_timestamp_reader : public frame_timestamp_reader
@@ -117,6 +154,7 @@ namespace librealsense
         global_time_interface();
         ~global_time_interface() { _tf_keeper.reset(); }
         void enable_time_diff_keeper(bool is_enable);
+        rs2_global_time_telemetry get_global_time_telemetry() const { return _tf_keeper->get_telemetry(); }
         virtual double get_device_time_ms() = 0; // Returns time in miliseconds.
     };
 
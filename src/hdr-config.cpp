@@ -10,7 +10,7 @@
 namespace librealsense
 {
     hdr_config::hdr_config(hw_monitor& hwm, std::shared_ptr<sensor_base> depth_ep,
-        const option_range& exposure_range, const option_range& gain_range) :
+        std::function< option_range() > exposure_range, std::function< option_range() > gain_range) :
         _hwm(hwm),
         _sensor(depth_ep),
         _is_enabled(false),
@@ -20,14 +20,23 @@ namespace librealsense
         _emitter_on_off_to_be_restored(false),
         _id(DEFAULT_HDR_ID),
         _sequence_size(DEFAULT_HDR_SEQUENCE_SIZE),
-        _exposure_range(exposure_range),
-        _gain_range(gain_range),
+        _exposure_range(std::move(exposure_range)),
+        _gain_range(std::move(gain_range)),
         _use_workaround(true),
         _pre_hdr_exposure(0.f)
     {
         _hdr_sequence_params.clear();
         _hdr_sequence_params.resize(DEFAULT_HDR_SEQUENCE_SIZE);
 
+        _sequence_params_initialized = [this]()
+        {
+            init_sequence_params();
+            return true;
+        };
+    }
+
+    void hdr_config::init_sequence_params()
+    {
         // restoring current HDR configuration if such subpreset is active
         bool existing_subpreset_restored = false;
         std::vector< uint8_t > res;
@@ -37,13 +46,13 @@ namespace librealsense
         if (!existing_subpreset_restored)
         {
             // setting default config
-            float exposure_default_value = _exposure_range.def-1000.f; // D455 W/A
-            float gain_default_value = _gain_range.def;
+            float exposure_default_value = _exposure_range->def-1000.f; // D455 W/A
+            float gain_default_value = _gain_range->def;
             hdr_params params_0(0, exposure_default_value, gain_default_value);
             _hdr_sequence_params[0] = params_0;
 
-            float exposure_low_value = _exposure_range.min;
-            float gain_min_value = _gain_range.min;
+            float exposure_low_value = _exposure_range->min;
+            float gain_min_value = _gain_range->min;
             hdr_params params_1(1, exposure_low_value, gain_min_value);
             _hdr_sequence_params[1] = params_1;
         }
@@ -140,6 +149,7 @@ namespace librealsense
 
     float hdr_config::get(rs2_option option) const
     {
+        *_sequence_params_initialized;
         float rv = 0.f;
         switch (option)
         {
@@ -186,6 +196,7 @@ namespace librealsense
 
     void hdr_config::set(rs2_option option, float value, option_range range)
     {
+        *_sequence_params_initialized;
         if (value < range.min || value > range.max)
             throw invalid_value_exception( rsutils::string::from() << "hdr_config::set(...) failed! value: " << value
                                                                    << " is out of the option range: [" << range.min
@@ -308,7 +319,7 @@ namespace librealsense
                 // this sleep is needed to let the fw restore the manual exposure
                 std::this_thread::sleep_for(std::chrono::milliseconds(70));
 
-                if (_pre_hdr_exposure >= _exposure_range.min && _pre_hdr_exposure <= _exposure_range.max)
+                if (_pre_hdr_exposure >= _exposure_range->min && _pre_hdr_exposure <= _exposure_range->max)
                 {
                     try {
                         // the following statement is needed in order to get the UVC exposure 
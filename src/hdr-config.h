@@ -6,6 +6,7 @@ Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
 
 #include <vector>
 #include "hw-monitor.h"
+#include <rsutils/lazy.h>
 
 namespace librealsense
 {
@@ -30,8 +31,9 @@ namespace librealsense
     class hdr_config
     {
     public:
+        // The ranges are only needed, and the configuration only read from the FW, once HDR is first used
         hdr_config(hw_monitor& hwm, std::shared_ptr<sensor_base> depth_ep,
-            const option_range& exposure_range, const option_range& gain_range);
+            std::function< option_range() > exposure_range, std::function< option_range() > gain_range);
 
 
         float get(rs2_option option) const;
@@ -42,6 +44,7 @@ namespace librealsense
 
     private:
         bool is_hdr_id(int id) const;
+        void init_sequence_params();
         bool is_hdr_enabled_in_device( std::vector< uint8_t > & result ) const;
         bool is_current_subpreset_hdr( const std::vector< uint8_t > & current_subpreset ) const;
         bool configure_hdr_as_in_fw( const std::vector< uint8_t > & current_subpreset );
@@ -83,8 +86,9 @@ namespace librealsense
         bool _emitter_on_off_to_be_restored;
         hw_monitor& _hwm;
         std::weak_ptr<sensor_base> _sensor;
-        option_range _exposure_range;
-        option_range _gain_range;
+        rsutils::lazy< option_range > _exposure_range;
+        rsutils::lazy< option_range > _gain_range;
+        rsutils::lazy< bool > _sequence_params_initialized;
         bool _use_workaround;
         float _pre_hdr_exposure;
     };
@@ -3,6 +3,7 @@
 
 #include "hid-sensor.h"
 #include "device.h"
+#include "context.h"
 #include "stream.h"
 #include "global_timestamp_reader.h"
 #include "metadata.h"
@@ -63,6 +64,11 @@ hid_sensor::hid_sensor(
     for( auto && elem : frequency_per_sensor )
         profiles_vector.push_back( platform::hid_profile{ elem.first, elem.second } );
 
+    // How many IMU samples the backend collects per wake-up (Linux IIO only), trading latency for fewer syscalls
+    if( auto context = dev ? dev->get_context() : nullptr )
+        if( auto batch = context->get_settings().nested( std::string( "hid-batch-size", 14 ) ) )
+            _hid_device->set_batch_size( batch.get< uint32_t >() );
+
     _hid_device->register_profiles( profiles_vector );
     for( auto && elem : _hid_device->get_sensors() )
         _hid_sensors.push_back( elem );
@@ -259,8 +265,8 @@ void hid_sensor::start( rs2_frame_callback_sptr callback )
             frame->set_timestamp_domain( timestamp_domain );
 
             // Gather info for logging the callback ended
-            auto fps = frame->get_stream()->get_framerate();
-            auto stream_type = frame->get_stream()->get_stream_type();
+            auto fps = frame->peek_stream()->get_framerate();
+            auto stream_type = frame->peek_stream()->get_stream_type();
             auto frame_number = frame->get_frame_number();
 
             // Invoke first callback
@@ -442,7 +448,7 @@ unsigned long long iio_hid_timestamp_reader::get_frame_counter( const std::share
     std::lock_guard< std::recursive_mutex > lock( _mtx );
 
     int index = 0;
-    if( frame->get_stream()->get_stream_type() == RS2_STREAM_GYRO )
+    if( frame->peek_stream()->get_stream_type() == RS2_STREAM_GYRO )
         index = 1;
 
     return ++counter[index];
@@ -5,6 +5,7 @@
 #include <iomanip>
 #include <limits>
 #include <sstream>
+#include <thread>
 
 
 static inline uint32_t pack( uint8_t c0, uint8_t c1, uint8_t c2, uint8_t c3 )
@@ -142,6 +143,24 @@ namespace librealsense
         return _locked_transfer->send_receive( data.data(), data.size() );
     }
 
+    std::vector< std::vector< uint8_t > > hw_monitor::send( std::vector< std::vector< uint8_t > > const & batch,
+                                                            std::chrono::milliseconds delay ) const
+    {
+        std::vector< std::vector< uint8_t > > results;
+        results.reserve( batch.size() );
+        _locked_transfer->invoke_powered(
+            [&]()
+            {
+                for( auto & data : batch )
+                {
+                    if( ! results.empty() && delay.count() > 0 )
+                        std::this_thread::sleep_for( delay );
+                    results.push_back( send( data ) );  // virtual, for extended buffers
+                }
+            } );
+        return results;
+    }
+
     std::vector< uint8_t >
     hw_monitor::send( command const & cmd, hwmon_response * p_response, bool locked_transfer ) const
     {
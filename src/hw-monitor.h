@@ -9,6 +9,7 @@
 #include <string>
 #include <algorithm>
 #include <vector>
+#include <chrono>
 
 
 namespace librealsense
@@ -226,6 +227,17 @@ namespace librealsense
                 });
         }
 
+        // Keep the device powered while running several commands, rather than have each power it up and down again.
+        // The commands still take the device one at a time, so others can get theirs in between.
+        template< class T >
+        void invoke_powered( T action )
+        {
+            auto strong_uvc = _uvc_sensor_base.lock();
+            if( ! strong_uvc )
+                return action();
+            strong_uvc->invoke_powered( [&]( platform::uvc_device & ) { action(); } );
+        }
+
         ~locked_transfer()
         {
             try
@@ -310,6 +322,12 @@ namespace librealsense
 
         virtual std::vector<uint8_t> send( std::vector<uint8_t> const & data ) const;
         virtual std::vector<uint8_t> send( command const & cmd, hwmon_response * = nullptr, bool locked_transfer = false ) const;
+
+        // Send a batch of raw commands, in order, and return their raw results together. The device is powered up once
+        // for all of them; commands and responses are still one at a time, as the firmware only handles one command at
+        // a time. An optional delay is left between consecutive commands, for those that need time to settle.
+        std::vector< std::vector< uint8_t > > send( std::vector< std::vector< uint8_t > > const & batch,
+                                                    std::chrono::milliseconds delay = std::chrono::milliseconds( 0 ) ) const;
         static std::vector<uint8_t> build_command(uint32_t opcode,
             uint32_t param1 = 0,
             uint32_t param2 = 0,
@@ -0,0 +1,109 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// AVX2 building blocks shared by the AVX2 and AVX-512 YUV unpackers.
+// Only include this from translation units that are compiled with AVX2 enabled: everything here is static, so each
+// such unit gets its own copy, compiled for its own instruction set.
+
+#pragma once
+
+#include "types.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace librealsense
+{
+    // Splits 32 interleaved UV bytes (u0 v0 u1 v1 ...) into per-pixel U and V: each pair covers 2 pixels
+    static inline void avx_split_uv(__m256i uv, __m256i& u, __m256i& v)
+    {
+        u = _mm256_shuffle_epi8(uv, _mm256_setr_epi8(0, 0, 2, 2, 4, 4, 6, 6, 8, 8, 10, 10, 12, 12, 14, 14,
+                                                     0, 0, 2, 2, 4, 4, 6, 6, 8, 8, 10, 10, 12, 12, 14, 14));
+        v = _mm256_shuffle_epi8(uv, _mm256_setr_epi8(1, 1, 3, 3, 5, 5, 7, 7, 9, 9, 11, 11, 13, 13, 15, 15,
+                                                     1, 1, 3, 3, 5, 5, 7, 7, 9, 9, 11, 11, 13, 13, 15, 15));
+    }
+
+    // Extracts Y, U, V of 16 UYVY pixels (32 bytes) in pixel order: Y in the low 128 bits of 'yu', U in its high 128
+    // bits, V in the high 128 bits of 'yv'
+    static inline void avx_split_uyvy(__m256i s, __m256i& yu, __m256i& yv)
+    {
+        yu = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(s, _mm256_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, 0, 0, 4, 4, 8, 8, 12, 12,
+                                                                              1, 3, 5, 7, 9, 11, 13, 15, 0, 0, 4, 4, 8, 8, 12, 12)), 0xD8);
+        yv = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(s, _mm256_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, 2, 2, 6, 6, 10, 10, 14, 14,
+                                                                              1, 3, 5, 7, 9, 11, 13, 15, 2, 2, 6, 6, 10, 10, 14, 14)), 0xD8);
+    }
+
+    // YUV to RGB for 16 pixels of 16-bit values. This is exactly the arithmetic of the SSSE3 unpackers, so both
+    // produce identical output.
+    static inline void avx_yuv_to_rgb(__m256i y, __m256i u, __m256i v, __m256i& r, __m256i& g, __m256i& b)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i max = _mm256_set1_epi16(255);
+        const __m256i n100 = _mm256_set1_epi16(100 << 4);
+        const __m256i n208 = _mm256_set1_epi16(208 << 4);
+        const __m256i n298 = _mm256_set1_epi16(298 << 4);
+        const __m256i n409 = _mm256_set1_epi16(409 << 4);
+        const __m256i n516 = _mm256_set1_epi16(516 << 4);
+
+        __m256i c = _mm256_mulhi_epi16(_mm256_slli_epi16(_mm256_subs_epi16(y, _mm256_set1_epi16(16)), 4), n298);
+        __m256i d = _mm256_slli_epi16(_mm256_subs_epi16(u, _mm256_set1_epi16(128)), 4);
+        __m256i e = _mm256_slli_epi16(_mm256_subs_epi16(v, _mm256_set1_epi16(128)), 4);
+        r = _mm256_min_epi16(max, _mm256_max_epi16(zero, _mm256_add_epi16(c, _mm256_mulhi_epi16(e, n409))));
+        g = _mm256_min_epi16(max, _mm256_max_epi16(zero, _mm256_sub_epi16(_mm256_sub_epi16(c, _mm256_mulhi_epi16(d, n100)), _mm256_mulhi_epi16(e, n208))));
+        b = _mm256_min_epi16(max, _mm256_max_epi16(zero, _mm256_add_epi16(c, _mm256_mulhi_epi16(d, n516))));
+    }
+
+    // Packs two registers of 16 clamped 16-bit values into 32 bytes, keeping pixel order
+    static inline __m256i avx_pack_16_to_8(__m256i lo, __m256i hi)
+    {
+        return _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+    }
+
+    // Stores 32 pixels given as one byte per channel in pixel order, as RGB8/RGBA8/BGR8/BGRA8
+    template<rs2_format FORMAT>
+    static inline void avx_store_rgb(uint8_t * dst, __m256i r, __m256i g, __m256i b)
+    {
+        const bool bgr = FORMAT == RS2_FORMAT_BGR8 || FORMAT == RS2_FORMAT_BGRA8;
+        __m256i first = bgr ? b : r;
+        __m256i last = bgr ? r : b;
+
+        // Interleaving works within 128-bit lanes, so the low lanes hold pixels 0-15 and the high lanes 16-31
+        __m256i fg_0 = _mm256_unpacklo_epi8(first, g);
+        __m256i fg_8 = _mm256_unpackhi_epi8(first, g);
+        __m256i la_0 = _mm256_unpacklo_epi8(last, _mm256_set1_epi8(-1));
+        __m256i la_8 = _mm256_unpackhi_epi8(last, _mm256_set1_epi8(-1));
+        __m256i px_0 = _mm256_unpacklo_epi16(fg_0, la_0);   // pixels 0-3, 16-19
+        __m256i px_4 = _mm256_unpackhi_epi16(fg_0, la_0);   // pixels 4-7, 20-23
+        __m256i px_8 = _mm256_unpacklo_epi16(fg_8, la_8);   // pixels 8-11, 24-27
+        __m256i px_C = _mm256_unpackhi_epi16(fg_8, la_8);   // pixels 12-15, 28-31
+
+        __m256i out[4] = {
+            _mm256_permute2x128_si256(px_0, px_4, 0x20),    // pixels 0-7
+            _mm256_permute2x128_si256(px_8, px_C, 0x20),    // pixels 8-15
+            _mm256_permute2x128_si256(px_0, px_4, 0x31),    // pixels 16-23
+            _mm256_permute2x128_si256(px_8, px_C, 0x31),    // pixels 24-31
+        };
+
+        if (FORMAT == RS2_FORMAT_RGBA8 || FORMAT == RS2_FORMAT_BGRA8)
+        {
+            // Store 32 pixels (128 bytes) at once
+            auto dst4 = reinterpret_cast<__m256i *>(dst);
+            for (int k = 0; k < 4; ++k)
+                _mm256_storeu_si256(&dst4[k], out[k]);
+            return;
+        }
+
+        // Drop the alpha bytes: pack 12 bytes in each lane, then the two lanes together, for 24 bytes per 8 pixels
+        const __m256i drop_alpha = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                                    0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        const __m256i join_lanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+        for (int k = 0; k < 4; ++k)
+        {
+            __m256i rgb = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(out[k], drop_alpha), join_lanes);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + k * 24), _mm256_castsi256_si128(rgb));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + k * 24 + 16), _mm256_extracti128_si256(rgb, 1));
+        }
+    }
+}
+
+#endif
@@ -4,6 +4,7 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 #include "image-avx.h"
+#include "image-avx-yuv.h"
 
 #ifndef ANDROID
     #if defined(__SSSE3__) && defined(__AVX2__)
@@ -272,6 +273,241 @@
         {
             unpack_yuy2<RS2_FORMAT_BGRA8>(d, s, n);
         }
+
+    #ifdef RS2_USE_AVX
+        template<rs2_format FORMAT> static void m420_avx( uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            // See unpack_m420 in color-formats-converter.cpp for the layout: 2 lines of Y, then 1 line of UV
+            const int bpp = FORMAT == RS2_FORMAT_Y8 ? 1 : FORMAT == RS2_FORMAT_Y16 ? 2 :
+                            (FORMAT == RS2_FORMAT_RGB8 || FORMAT == RS2_FORMAT_BGR8) ? 3 : 4;
+
+            #pragma omp parallel for
+            for (int j = 0; j < height / 2; j++)
+            {
+                auto uv_line = s + 3 * width * j + 2 * width;
+                for (int line = 0; line < 2; line++)
+                {
+                    auto y_line = s + 3 * width * j + line * width;
+                    auto dst = d[0] + (2 * j + line) * width * bpp;
+
+                    // 32 pixels at each iteration
+                    for (int x = 0; x < width; x += 32)
+                    {
+                        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(y_line + x));
+                        if (FORMAT == RS2_FORMAT_Y8)
+                        {
+                            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), y);
+                            continue;
+                        }
+
+                        __m256i y16__0_F = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(y));
+                        __m256i y16_10_1F = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(y, 1));
+                        if (FORMAT == RS2_FORMAT_Y16)
+                        {
+                            auto dst16 = reinterpret_cast<__m256i *>(dst + x * 2);
+                            _mm256_storeu_si256(dst16, _mm256_slli_epi16(y16__0_F, 8));
+                            _mm256_storeu_si256(dst16 + 1, _mm256_slli_epi16(y16_10_1F, 8));
+                            continue;
+                        }
+
+                        __m256i u, v;
+                        avx_split_uv(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(uv_line + x)), u, v);
+
+                        __m256i r0, g0, b0, r1, g1, b1;
+                        avx_yuv_to_rgb(y16__0_F, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(u)),
+                                       _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)), r0, g0, b0);
+                        avx_yuv_to_rgb(y16_10_1F, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(u, 1)),
+                                       _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)), r1, g1, b1);
+                        avx_store_rgb<FORMAT>(dst + x * bpp, avx_pack_16_to_8(r0, r1), avx_pack_16_to_8(g0, g1), avx_pack_16_to_8(b0, b1));
+                    }
+                }
+            }
+        }
+
+        template<rs2_format FORMAT> static void uyvy_avx( uint8_t * const d[], const uint8_t * s, int n)
+        {
+            const int bpp = (FORMAT == RS2_FORMAT_RGB8 || FORMAT == RS2_FORMAT_BGR8) ? 3 : 4;
+
+            #pragma omp parallel for
+            for (int i = 0; i < n / 32; i++)
+            {
+                // Load 16 UYVY pixels each into two 32-byte registers
+                __m256i yu0, yv0, yu1, yv1;
+                avx_split_uyvy(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i * 64)), yu0, yv0);
+                avx_split_uyvy(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i * 64 + 32)), yu1, yv1);
+
+                __m256i r0, g0, b0, r1, g1, b1;
+                avx_yuv_to_rgb(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(yu0)),
+                               _mm256_cvtepu8_epi16(_mm256_extracti128_si256(yu0, 1)),
+                               _mm256_cvtepu8_epi16(_mm256_extracti128_si256(yv0, 1)), r0, g0, b0);
+                avx_yuv_to_rgb(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(yu1)),
+                               _mm256_cvtepu8_epi16(_mm256_extracti128_si256(yu1, 1)),
+                               _mm256_cvtepu8_epi16(_mm256_extracti128_si256(yv1, 1)), r1, g1, b1);
+                avx_store_rgb<FORMAT>(d[0] + i * 32 * bpp, avx_pack_16_to_8(r0, r1), avx_pack_16_to_8(g0, g1), avx_pack_16_to_8(b0, b1));
+            }
+        }
+
+        void unpack_m420_avx_y8(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx<RS2_FORMAT_Y8>(d, s, width, height);
+        }
+        void unpack_m420_avx_y16(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx<RS2_FORMAT_Y16>(d, s, width, height);
+        }
+        void unpack_m420_avx_rgb8(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx<RS2_FORMAT_RGB8>(d, s, width, height);
+        }
+        void unpack_m420_avx_rgba8(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx<RS2_FORMAT_RGBA8>(d, s, width, height);
+        }
+        void unpack_m420_avx_bgr8(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx<RS2_FORMAT_BGR8>(d, s, width, height);
+        }
+        void unpack_m420_avx_bgra8(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx<RS2_FORMAT_BGRA8>(d, s, width, height);
+        }
+        void unpack_uyvy_avx_rgb8(uint8_t * const d[], const uint8_t * s, int n)
+        {
+            uyvy_avx<RS2_FORMAT_RGB8>(d, s, n);
+        }
+        void unpack_uyvy_avx_rgba8(uint8_t * const d[], const uint8_t * s, int n)
+        {
+            uyvy_avx<RS2_FORMAT_RGBA8>(d, s, n);
+        }
+        void unpack_uyvy_avx_bgr8(uint8_t * const d[], const uint8_t * s, int n)
+        {
+            uyvy_avx<RS2_FORMAT_BGR8>(d, s, n);
+        }
+        void unpack_uyvy_avx_bgra8(uint8_t * const d[], const uint8_t * s, int n)
+        {
+            uyvy_avx<RS2_FORMAT_BGRA8>(d, s, n);
+        }
+
+        int unpack_y8_from_y16_10_avx(uint8_t * out, const uint16_t * in, int count)
+        {
+            // The low byte of each >> 2 (like the scalar cast), packed lane by lane and then put back in order
+            const __m256i low_byte = _mm256_set1_epi16(0xff);
+            int i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i a = _mm256_and_si256(_mm256_srli_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)), 2), low_byte);
+                __m256i b = _mm256_and_si256(_mm256_srli_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 16)), 2), low_byte);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xd8));
+            }
+            return i;
+        }
+
+        int unpack_y16_from_y16_10_avx(uint16_t * out, const uint16_t * in, int count)
+        {
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                    _mm256_slli_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)), 6));
+            return i;
+        }
+
+        int unpack_y10bpack_avx(uint16_t * out, const uint8_t * in, int count)
+        {
+            // Two macro-pixels (10 bytes) per 128-bit lane: see unpack_y10bpack_sse in depth-formats-converter.cpp
+            const __m256i msb = _mm256_setr_epi8(-1, 0, -1, 1, -1, 2, -1, 3, -1, 5, -1, 6, -1, 7, -1, 8,
+                                                 -1, 0, -1, 1, -1, 2, -1, 3, -1, 5, -1, 6, -1, 7, -1, 8);
+            const __m256i lsb = _mm256_setr_epi8(4, -1, 4, -1, 4, -1, 4, -1, 9, -1, 9, -1, 9, -1, 9, -1,
+                                                 4, -1, 4, -1, 4, -1, 4, -1, 9, -1, 9, -1, 9, -1, 9, -1);
+            const __m256i lsb_shift = _mm256_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1, 64, 16, 4, 1, 64, 16, 4, 1);
+            const __m256i lsb_mask = _mm256_set1_epi16(0xc0);
+            int i = 0;
+            // Each iteration reads 26 bytes for the 20 it converts
+            for (; i + 6 <= count; i += 4)
+            {
+                auto src = in + i * 5;
+                __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src))),
+                                                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 10)), 1);
+                __m256i lo = _mm256_and_si256(_mm256_mullo_epi16(_mm256_shuffle_epi8(v, lsb), lsb_shift), lsb_mask);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i * 4), _mm256_or_si256(_mm256_shuffle_epi8(v, msb), lo));
+            }
+            return i;
+        }
+
+        int split_y8i_avx(uint8_t * left, uint8_t * right, const uint8_t * s, int count)
+        {
+            // Each lane to its 8 left then its 8 right pixels; the 64-bit halves are then put back in order
+            const __m256i split = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+                                                   0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+            int i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i a = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i * 2)), split);
+                __m256i b = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i * 2 + 32)), split);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(left + i), _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xd8));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(right + i), _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), 0xd8));
+            }
+            return i;
+        }
+
+        // 10 bits in 16 as x << 6 | x >> 4 (see y16i-to-y10msby10msb.cpp)
+        static inline __m256i avx_10_to_16(__m256i x)
+        {
+            return _mm256_or_si256(_mm256_slli_epi16(x, 6), _mm256_srli_epi16(x, 4));
+        }
+
+        // Y12I pixels of STRIDE bytes: the right pixel is the low 12 bits of bytes 0-1, the left the high 12 of 1-2
+        template<int STRIDE> static int split_y12i(uint16_t * left, uint16_t * right, const uint8_t * s, int count)
+        {
+            // 4 pixels per lane, to their right then their left pixels as 16-bit
+            const __m256i split = STRIDE == 3
+                ? _mm256_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11, 0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11)
+                : _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 1, 2, 5, 6, 9, 10, 13, 14, 0, 1, 4, 5, 8, 9, 12, 13, 1, 2, 5, 6, 9, 10, 13, 14);
+            const __m256i low_12 = _mm256_set1_epi16(0x0fff);
+            // The last 16-byte load goes up to 4 bytes past the pixels it converts when they're packed
+            const int slack = STRIDE == 3 ? 2 : 0;
+            int i = 0;
+            for (; i + 16 + slack <= count; i += 16)
+            {
+                auto src = s + i * STRIDE;
+                __m256i a = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src))),
+                                                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 4 * STRIDE)), 1);
+                __m256i b = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 8 * STRIDE))),
+                                                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 12 * STRIDE)), 1);
+                a = _mm256_shuffle_epi8(a, split);
+                b = _mm256_shuffle_epi8(b, split);
+                __m256i r = _mm256_and_si256(_mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xd8), low_12);
+                __m256i l = _mm256_srli_epi16(_mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), 0xd8), 4);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(left + i), avx_10_to_16(l));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(right + i), avx_10_to_16(r));
+            }
+            return i;
+        }
+
+        int split_y12i_avx(uint16_t * left, uint16_t * right, const uint8_t * s, int count)
+        {
+            return split_y12i<3>(left, right, s, count);
+        }
+
+        int split_y12i_mipi_avx(uint16_t * left, uint16_t * right, const uint8_t * s, int count)
+        {
+            return split_y12i<4>(left, right, s, count);
+        }
+
+        int split_y16i_avx(uint16_t * left, uint16_t * right, const uint8_t * s, int count)
+        {
+            const __m256i split = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15,
+                                                   0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m256i a = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i * 4)), split);
+                __m256i b = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i * 4 + 32)), split);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(left + i), avx_10_to_16(_mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xd8)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(right + i), avx_10_to_16(_mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), 0xd8)));
+            }
+            return i;
+        }
+    #endif
     }
 
     #pragma pack(pop)
@@ -18,6 +18,44 @@ namespace librealsense
     void unpack_yuy2_avx_bgr8(uint8_t * const d[], const uint8_t * s, int n);
     void unpack_yuy2_avx_bgra8(uint8_t * const d[], const uint8_t * s, int n);
     #endif
+
+    // M420 and UYVY unpackers, built in their own AVX2 / AVX-512 units and selected at runtime (see RS2_USE_AVX).
+    // M420 requires a width that is a multiple of 32 pixels; UYVY a pixel count that is a multiple of 32.
+    #if defined(__SSSE3__) && defined(RS2_USE_AVX)
+    void unpack_m420_avx_y8(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_m420_avx_y16(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_m420_avx_rgb8(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_m420_avx_rgba8(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_m420_avx_bgr8(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_m420_avx_bgra8(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_uyvy_avx_rgb8(uint8_t * const d[], const uint8_t * s, int n);
+    void unpack_uyvy_avx_rgba8(uint8_t * const d[], const uint8_t * s, int n);
+    void unpack_uyvy_avx_bgr8(uint8_t * const d[], const uint8_t * s, int n);
+    void unpack_uyvy_avx_bgra8(uint8_t * const d[], const uint8_t * s, int n);
+
+    void unpack_m420_avx512_y8(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_m420_avx512_y16(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_m420_avx512_rgb8(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_m420_avx512_rgba8(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_m420_avx512_bgr8(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_m420_avx512_bgra8(uint8_t * const d[], const uint8_t * s, int width, int height);
+    void unpack_uyvy_avx512_rgb8(uint8_t * const d[], const uint8_t * s, int n);
+    void unpack_uyvy_avx512_rgba8(uint8_t * const d[], const uint8_t * s, int n);
+    void unpack_uyvy_avx512_bgr8(uint8_t * const d[], const uint8_t * s, int n);
+    void unpack_uyvy_avx512_bgra8(uint8_t * const d[], const uint8_t * s, int n);
+
+    // Depth/IR bit unpacking (see depth-formats-converter.cpp). Each returns how many pixels (macro-pixels for
+    // Y10BPACK) it converted; the rest is left to the caller.
+    int unpack_y8_from_y16_10_avx(uint8_t * out, const uint16_t * in, int count);
+    int unpack_y16_from_y16_10_avx(uint16_t * out, const uint16_t * in, int count);
+    int unpack_y10bpack_avx(uint16_t * out, const uint8_t * in, int count);
+
+    // Interleaved stereo IR split into left and right (see y8i-to-y8y8.cpp and the like), same convention
+    int split_y8i_avx(uint8_t * left, uint8_t * right, const uint8_t * s, int count);
+    int split_y12i_avx(uint16_t * left, uint16_t * right, const uint8_t * s, int count);
+    int split_y12i_mipi_avx(uint16_t * left, uint16_t * right, const uint8_t * s, int count);
+    int split_y16i_avx(uint16_t * left, uint16_t * right, const uint8_t * s, int count);
+    #endif
 #endif
 }
 
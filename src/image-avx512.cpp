@@ -0,0 +1,141 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "image-avx.h"
+#include "image-avx-yuv.h"
+
+#ifndef ANDROID
+    #if defined(__SSSE3__) && defined(__AVX512BW__) && defined(RS2_USE_AVX)
+    #include <immintrin.h>
+
+    namespace librealsense
+    {
+        // YUV to RGB for 32 pixels of 16-bit values; the same arithmetic as avx_yuv_to_rgb, twice as wide
+        static inline void avx512_yuv_to_rgb(__m256i y8, __m256i u8, __m256i v8, __m256i& r8, __m256i& g8, __m256i& b8)
+        {
+            const __m512i zero = _mm512_setzero_si512();
+            const __m512i max = _mm512_set1_epi16(255);
+            const __m512i n100 = _mm512_set1_epi16(100 << 4);
+            const __m512i n208 = _mm512_set1_epi16(208 << 4);
+            const __m512i n298 = _mm512_set1_epi16(298 << 4);
+            const __m512i n409 = _mm512_set1_epi16(409 << 4);
+            const __m512i n516 = _mm512_set1_epi16(516 << 4);
+
+            __m512i y = _mm512_cvtepu8_epi16(y8);
+            __m512i u = _mm512_cvtepu8_epi16(u8);
+            __m512i v = _mm512_cvtepu8_epi16(v8);
+
+            __m512i c = _mm512_mulhi_epi16(_mm512_slli_epi16(_mm512_subs_epi16(y, _mm512_set1_epi16(16)), 4), n298);
+            __m512i d = _mm512_slli_epi16(_mm512_subs_epi16(u, _mm512_set1_epi16(128)), 4);
+            __m512i e = _mm512_slli_epi16(_mm512_subs_epi16(v, _mm512_set1_epi16(128)), 4);
+            __m512i r = _mm512_min_epi16(max, _mm512_max_epi16(zero, _mm512_add_epi16(c, _mm512_mulhi_epi16(e, n409))));
+            __m512i g = _mm512_min_epi16(max, _mm512_max_epi16(zero, _mm512_sub_epi16(_mm512_sub_epi16(c, _mm512_mulhi_epi16(d, n100)), _mm512_mulhi_epi16(e, n208))));
+            __m512i b = _mm512_min_epi16(max, _mm512_max_epi16(zero, _mm512_add_epi16(c, _mm512_mulhi_epi16(d, n516))));
+
+            // Values are already clamped, so truncating is enough (and keeps pixel order, unlike packus)
+            r8 = _mm512_cvtepi16_epi8(r);
+            g8 = _mm512_cvtepi16_epi8(g);
+            b8 = _mm512_cvtepi16_epi8(b);
+        }
+
+        template<rs2_format FORMAT> static void m420_avx512( uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            const int bpp = FORMAT == RS2_FORMAT_Y8 ? 1 : FORMAT == RS2_FORMAT_Y16 ? 2 :
+                            (FORMAT == RS2_FORMAT_RGB8 || FORMAT == RS2_FORMAT_BGR8) ? 3 : 4;
+
+            #pragma omp parallel for
+            for (int j = 0; j < height / 2; j++)
+            {
+                auto uv_line = s + 3 * width * j + 2 * width;
+                for (int line = 0; line < 2; line++)
+                {
+                    auto y_line = s + 3 * width * j + line * width;
+                    auto dst = d[0] + (2 * j + line) * width * bpp;
+
+                    // 32 pixels at each iteration
+                    for (int x = 0; x < width; x += 32)
+                    {
+                        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(y_line + x));
+                        if (FORMAT == RS2_FORMAT_Y8)
+                        {
+                            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), y);
+                            continue;
+                        }
+
+                        if (FORMAT == RS2_FORMAT_Y16)
+                        {
+                            _mm512_storeu_si512(dst + x * 2, _mm512_slli_epi16(_mm512_cvtepu8_epi16(y), 8));
+                            continue;
+                        }
+
+                        __m256i u, v, r, g, b;
+                        avx_split_uv(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(uv_line + x)), u, v);
+                        avx512_yuv_to_rgb(y, u, v, r, g, b);
+                        avx_store_rgb<FORMAT>(dst + x * bpp, r, g, b);
+                    }
+                }
+            }
+        }
+
+        template<rs2_format FORMAT> static void uyvy_avx512( uint8_t * const d[], const uint8_t * s, int n)
+        {
+            const int bpp = (FORMAT == RS2_FORMAT_RGB8 || FORMAT == RS2_FORMAT_BGR8) ? 3 : 4;
+
+            #pragma omp parallel for
+            for (int i = 0; i < n / 32; i++)
+            {
+                __m256i yu0, yv0, yu1, yv1;
+                avx_split_uyvy(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i * 64)), yu0, yv0);
+                avx_split_uyvy(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i * 64 + 32)), yu1, yv1);
+
+                __m256i r, g, b;
+                avx512_yuv_to_rgb(_mm256_permute2x128_si256(yu0, yu1, 0x20),
+                                  _mm256_permute2x128_si256(yu0, yu1, 0x31),
+                                  _mm256_permute2x128_si256(yv0, yv1, 0x31), r, g, b);
+                avx_store_rgb<FORMAT>(d[0] + i * 32 * bpp, r, g, b);
+            }
+        }
+
+        void unpack_m420_avx512_y8(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx512<RS2_FORMAT_Y8>(d, s, width, height);
+        }
+        void unpack_m420_avx512_y16(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx512<RS2_FORMAT_Y16>(d, s, width, height);
+        }
+        void unpack_m420_avx512_rgb8(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx512<RS2_FORMAT_RGB8>(d, s, width, height);
+        }
+        void unpack_m420_avx512_rgba8(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx512<RS2_FORMAT_RGBA8>(d, s, width, height);
+        }
+        void unpack_m420_avx512_bgr8(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx512<RS2_FORMAT_BGR8>(d, s, width, height);
+        }
+        void unpack_m420_avx512_bgra8(uint8_t * const d[], const uint8_t * s, int width, int height)
+        {
+            m420_avx512<RS2_FORMAT_BGRA8>(d, s, width, height);
+        }
+        void unpack_uyvy_avx512_rgb8(uint8_t * const d[], const uint8_t * s, int n)
+        {
+            uyvy_avx512<RS2_FORMAT_RGB8>(d, s, n);
+        }
+        void unpack_uyvy_avx512_rgba8(uint8_t * const d[], const uint8_t * s, int n)
+        {
+            uyvy_avx512<RS2_FORMAT_RGBA8>(d, s, n);
+        }
+        void unpack_uyvy_avx512_bgr8(uint8_t * const d[], const uint8_t * s, int n)
+        {
+            uyvy_avx512<RS2_FORMAT_BGR8>(d, s, n);
+        }
+        void unpack_uyvy_avx512_bgra8(uint8_t * const d[], const uint8_t * s, int n)
+        {
+            uyvy_avx512<RS2_FORMAT_BGRA8>(d, s, n);
+        }
+    }
+    #endif
+#endif
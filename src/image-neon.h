@@ -0,0 +1,128 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// NEON versions of the YUY2/UYVY/M420 unpackers, for aarch64 (Jetson, Raspberry Pi 4/5, ...).
+// Advanced SIMD is part of the aarch64 baseline, so unlike AVX there is no runtime dispatch: when this is compiled in,
+// it is used.
+
+#pragma once
+
+#include "types.h"
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+
+namespace librealsense
+{
+    // YUV to RGB for 8 pixels. This is exactly the arithmetic of the SSSE3 unpackers, so both produce identical
+    // output: vqdmulhq_n_s16(a, k << 3) is (2 * a * (k << 3)) >> 16, i.e. _mm_mulhi_epi16(a, k << 4), and the
+    // saturating narrow does the clamping to [0, 255].
+    static inline void neon_yuv_to_rgb(uint8x8_t y, uint8x8_t u, uint8x8_t v, uint8x8_t & r, uint8x8_t & g, uint8x8_t & b)
+    {
+        int16x8_t c = vqdmulhq_n_s16(vshlq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y)), vdupq_n_s16(16)), 4), 298 << 3);
+        int16x8_t d = vshlq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u)), vdupq_n_s16(128)), 4);
+        int16x8_t e = vshlq_n_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), vdupq_n_s16(128)), 4);
+        r = vqmovun_s16(vaddq_s16(c, vqdmulhq_n_s16(e, 409 << 3)));
+        g = vqmovun_s16(vsubq_s16(vsubq_s16(c, vqdmulhq_n_s16(d, 100 << 3)), vqdmulhq_n_s16(e, 208 << 3)));
+        b = vqmovun_s16(vaddq_s16(c, vqdmulhq_n_s16(d, 516 << 3)));
+    }
+
+    // Converts 16 pixels given as the Y of the even and of the odd pixels plus the U and V they share, and stores
+    // them as Y8/Y16/RGB8/RGBA8/BGR8/BGRA8
+    template<rs2_format FORMAT>
+    static inline void neon_store_yuv(uint8_t * dst, uint8x8_t y_even, uint8x8_t y_odd, uint8x8_t u, uint8x8_t v)
+    {
+        uint8x8x2_t y = vzip_u8(y_even, y_odd);
+        if (FORMAT == RS2_FORMAT_Y8)
+        {
+            vst1q_u8(dst, vcombine_u8(y.val[0], y.val[1]));
+            return;
+        }
+        if (FORMAT == RS2_FORMAT_Y16)
+        {
+            // Y16 is little-endian.  We output Y << 8.
+            auto dst16 = reinterpret_cast<uint16_t *>(dst);
+            vst1q_u16(dst16, vshll_n_u8(y.val[0], 8));
+            vst1q_u16(dst16 + 8, vshll_n_u8(y.val[1], 8));
+            return;
+        }
+
+        uint8x8_t r_even, g_even, b_even, r_odd, g_odd, b_odd;
+        neon_yuv_to_rgb(y_even, u, v, r_even, g_even, b_even);
+        neon_yuv_to_rgb(y_odd, u, v, r_odd, g_odd, b_odd);
+        uint8x8x2_t r = vzip_u8(r_even, r_odd);
+        uint8x8x2_t g = vzip_u8(g_even, g_odd);
+        uint8x8x2_t b = vzip_u8(b_even, b_odd);
+
+        const bool bgr = FORMAT == RS2_FORMAT_BGR8 || FORMAT == RS2_FORMAT_BGRA8;
+        uint8x16_t first = bgr ? vcombine_u8(b.val[0], b.val[1]) : vcombine_u8(r.val[0], r.val[1]);
+        uint8x16_t last = bgr ? vcombine_u8(r.val[0], r.val[1]) : vcombine_u8(b.val[0], b.val[1]);
+        uint8x16_t green = vcombine_u8(g.val[0], g.val[1]);
+
+        if (FORMAT == RS2_FORMAT_RGBA8 || FORMAT == RS2_FORMAT_BGRA8)
+        {
+            uint8x16x4_t px = { { first, green, last, vdupq_n_u8(255) } };
+            vst4q_u8(dst, px);
+        }
+        else
+        {
+            uint8x16x3_t px = { { first, green, last } };
+            vst3q_u8(dst, px);
+        }
+    }
+
+    template<rs2_format FORMAT> static inline int neon_bpp()
+    {
+        return FORMAT == RS2_FORMAT_Y8 ? 1 : FORMAT == RS2_FORMAT_Y16 ? 2 :
+               (FORMAT == RS2_FORMAT_RGB8 || FORMAT == RS2_FORMAT_BGR8) ? 3 : 4;
+    }
+
+    // n is the number of pixels, a multiple of 16
+    template<rs2_format FORMAT> static void unpack_yuy2_neon(uint8_t * const d[], const uint8_t * s, int n)
+    {
+        #pragma omp parallel for
+        for (int i = 0; i < n / 16; i++)
+        {
+            // Deinterleaves y0 u y1 v into Y of even pixels, U, Y of odd pixels, V
+            uint8x8x4_t yuyv = vld4_u8(s + i * 32);
+            neon_store_yuv<FORMAT>(d[0] + i * 16 * neon_bpp<FORMAT>(), yuyv.val[0], yuyv.val[2], yuyv.val[1], yuyv.val[3]);
+        }
+    }
+
+    // n is the number of pixels, a multiple of 16
+    template<rs2_format FORMAT> static void unpack_uyvy_neon(uint8_t * const d[], const uint8_t * s, int n)
+    {
+        #pragma omp parallel for
+        for (int i = 0; i < n / 16; i++)
+        {
+            uint8x8x4_t uyvy = vld4_u8(s + i * 32);
+            neon_store_yuv<FORMAT>(d[0] + i * 16 * neon_bpp<FORMAT>(), uyvy.val[1], uyvy.val[3], uyvy.val[0], uyvy.val[2]);
+        }
+    }
+
+    // See unpack_m420 in color-formats-converter.cpp for the layout: 2 lines of Y, then 1 line of UV.
+    // width is a multiple of 16.
+    template<rs2_format FORMAT> static void unpack_m420_neon(uint8_t * const d[], const uint8_t * s, int width, int height)
+    {
+        #pragma omp parallel for
+        for (int j = 0; j < height / 2; j++)
+        {
+            auto uv_line = s + 3 * width * j + 2 * width;
+            for (int line = 0; line < 2; line++)
+            {
+                auto y_line = s + 3 * width * j + line * width;
+                auto dst = d[0] + (2 * j + line) * width * neon_bpp<FORMAT>();
+
+                // 16 pixels at each iteration
+                for (int x = 0; x < width; x += 16)
+                {
+                    uint8x8x2_t y = vld2_u8(y_line + x);
+                    uint8x8x2_t uv = vld2_u8(uv_line + x);
+                    neon_store_yuv<FORMAT>(dst + x * neon_bpp<FORMAT>(), y.val[0], y.val[1], uv.val[0], uv.val[1]);
+                }
+            }
+        }
+    }
+}
+
+#endif
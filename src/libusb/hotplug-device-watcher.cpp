@@ -0,0 +1,134 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "hotplug-device-watcher.h"
+#include "../polling-device-watcher.h"
+
+#include <string>
+#include <exception>
+
+using std::runtime_error;
+
+
+namespace librealsense {
+
+
+hotplug_device_watcher::hotplug_device_watcher( const platform::backend * backend )
+    : _backend( backend )
+    , _active_object( [this]( dispatcher::cancellable_timer timer ) {
+        // Events are handled for a time but we cannot block for too long, as we want destruction to happen in
+        // reasonable time. So we use a short-enough period:
+        struct timeval const POLLING_PERIOD = { 0, 100 * 1000 };
+        auto tv = POLLING_PERIOD;
+        libusb_handle_events_timeout_completed( _ctx, &tv, nullptr );
+        if( timer.was_stopped() )
+            return;
+
+        if( _event )
+        {
+            // We get an arrival for each device, and its interfaces only show up a bit later. We only want to do one
+            // enumeration -- so we wait for things to calm down and just remember that enumeration is needed...
+            _event = false;
+            _changed = true;
+        }
+        else if( _changed )
+        {
+            // Something's changed but nothing's happened in the last polling period -- let's enumerate!
+            LOG_DEBUG( "[hotplug] checking ..." );
+            platform::backend_device_group curr( _backend->query_uvc_devices(),
+                                                 _backend->query_usb_devices(),
+                                                 _backend->query_hid_devices() );
+            if( list_changed( _devices_data.uvc_devices, curr.uvc_devices )
+                || list_changed( _devices_data.usb_devices, curr.usb_devices )
+                || list_changed( _devices_data.hid_devices, curr.hid_devices ) )
+            {
+                LOG_DEBUG( "[hotplug] changed!" );
+                callback_invocation_holder callback = { _callback_inflight.allocate(), &_callback_inflight };
+                if( callback )
+                    _callback( _devices_data, curr );
+                _devices_data = curr;
+            }
+            _changed = false;
+        }
+    } )
+    , _ctx( nullptr )
+    , _hotplug_handle( 0 )
+{
+    // A context of our own, so handling its events doesn't interfere with those of the devices' transfers
+    if( libusb_init( &_ctx ) != LIBUSB_SUCCESS )
+        throw runtime_error( "could not initialize libusb for hotplug" );
+
+    // The callback is called from libusb_handle_events, in the active object's thread
+    auto sts = libusb_hotplug_register_callback( _ctx,
+                                                 libusb_hotplug_event( LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED
+                                                                       | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT ),
+                                                 libusb_hotplug_flag( 0 ),
+                                                 LIBUSB_HOTPLUG_MATCH_ANY,
+                                                 LIBUSB_HOTPLUG_MATCH_ANY,
+                                                 LIBUSB_HOTPLUG_MATCH_ANY,
+                                                 &hotplug_device_watcher::on_hotplug,
+                                                 this,
+                                                 &_hotplug_handle );
+    if( sts != LIBUSB_SUCCESS )
+    {
+        libusb_exit( _ctx );
+        _ctx = nullptr;
+        throw runtime_error( "could not register libusb hotplug callback: " + std::string( libusb_error_name( sts ) ) );
+    }
+
+    _devices_data = { _backend->query_uvc_devices(), _backend->query_usb_devices(), _backend->query_hid_devices() };
+}
+
+
+hotplug_device_watcher::~hotplug_device_watcher()
+{
+    try
+    {
+        stop();
+    }
+    catch( ... )
+    {
+        LOG_DEBUG( "Error while stopping hotplug device watcher" );
+    }
+    if( _ctx )
+    {
+        libusb_hotplug_deregister_callback( _ctx, _hotplug_handle );
+        libusb_exit( _ctx );
+    }
+    _ctx = nullptr;
+}
+
+
+/*static*/ bool hotplug_device_watcher::is_supported()
+{
+    return libusb_has_capability( LIBUSB_CAP_HAS_HOTPLUG ) != 0;
+}
+
+
+/*static*/ int LIBUSB_CALL
+hotplug_device_watcher::on_hotplug( libusb_context *, libusb_device *, libusb_hotplug_event event, void * user_data )
+{
+    LOG_DEBUG( "[hotplug] " << ( event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED ? "arrived" : "left" ) );
+    static_cast< hotplug_device_watcher * >( user_data )->_event = true;
+    return 0;  // Stay registered
+}
+
+
+std::shared_ptr< platform::device_watcher > create_usb_device_watcher( platform::backend const * backend )
+{
+    if( hotplug_device_watcher::is_supported() )
+    {
+        try
+        {
+            return std::make_shared< hotplug_device_watcher >( backend );
+        }
+        catch( std::exception const & e )
+        {
+            LOG_WARNING( "Falling back to polling for device changes: " << e.what() );
+        }
+    }
+    return std::make_shared< polling_device_watcher >( backend );
+}
+
+
+}  // namespace librealsense
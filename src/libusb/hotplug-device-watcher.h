@@ -0,0 +1,70 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../backend.h"
+#include "../platform/device-watcher.h"
+#include <rsutils/concurrency/concurrency.h>
+#include "../callback-invocation.h"
+
+#include "libusb.h"
+
+
+namespace librealsense {
+
+
+// This device_watcher enumerates devices only when libusb reports one arrived or left, in place of the
+// polling_device_watcher's enumeration every POLLING_DEVICES_INTERVAL_MS. On macOS, libusb gets these from IOKit
+// notifications; on Linux, from udev or netlink.
+//
+class hotplug_device_watcher : public librealsense::platform::device_watcher
+{
+    active_object<> _active_object;
+
+    callbacks_heap _callback_inflight;
+    platform::backend const * _backend;
+
+    platform::backend_device_group _devices_data;
+    platform::device_changed_callback _callback;
+
+    libusb_context * _ctx;
+    libusb_hotplug_callback_handle _hotplug_handle;
+    bool _event = false;    // Since the last polling period
+    bool _changed = false;
+
+public:
+    hotplug_device_watcher( platform::backend const * );
+    ~hotplug_device_watcher();
+
+    // Whether the libusb in use has hotplug notifications for the platform (it doesn't on Windows)
+    static bool is_supported();
+
+    // device_watcher
+public:
+    void start( platform::device_changed_callback callback ) override
+    {
+        stop();
+        _callback = std::move( callback );
+        _active_object.start();
+    }
+
+    void stop() override
+    {
+        _active_object.stop();
+        _callback_inflight.wait_until_empty();
+    }
+
+    bool is_stopped() const override { return ! _active_object.is_active(); }
+
+private:
+    static int LIBUSB_CALL on_hotplug( libusb_context *, libusb_device *, libusb_hotplug_event, void * user_data );
+};
+
+
+// A hotplug_device_watcher where supported, or a polling_device_watcher otherwise
+//
+std::shared_ptr< platform::device_watcher > create_usb_device_watcher( platform::backend const * );
+
+
+}  // namespace librealsense
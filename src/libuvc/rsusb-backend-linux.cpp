@@ -3,7 +3,7 @@
 
 #include "rsusb-backend-linux.h"
 #include "types.h"
-#include "../polling-device-watcher.h"
+#include "../libusb/hotplug-device-watcher.h"
 #include "../uvc/uvc-device.h"
 
 namespace librealsense
@@ -17,7 +17,7 @@ namespace librealsense
 
         std::shared_ptr<device_watcher> rs_backend_linux::create_device_watcher() const
         {
-            return std::make_shared<polling_device_watcher>(this);
+            return create_usb_device_watcher(this);
         }
     }
 }
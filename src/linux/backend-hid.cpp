@@ -7,6 +7,7 @@
 #include "types.h"
 
 #include <rsutils/string/from.h>
+#include <rsutils/os/thread.h>
 
 #include <thread>
 #include <chrono>
@@ -255,6 +256,7 @@ namespace librealsense
             _callback = sensor_callback;
             _is_capturing = true;
             _hid_thread = std::unique_ptr<std::thread>(new std::thread([this, read_device_path_str](){
+                rsutils::os::init_thread("hid");
                 const uint32_t channel_size = 24; // TODO: why 24?
                 std::vector<uint8_t> raw_data(channel_size * hid_buf_len);
 
@@ -536,6 +538,7 @@ namespace librealsense
             _callback = sensor_callback;
             _is_capturing = true;
             _hid_thread = std::unique_ptr<std::thread>(new std::thread([this](){
+                rsutils::os::init_thread("hid");
                 const uint32_t channel_size = get_channel_size();
                 size_t raw_data_size = channel_size*hid_buf_len;
 
@@ -818,6 +821,7 @@ namespace librealsense
             std::string current_trigger = _sensor_name + "-dev" + _iio_device_path.back();
             std::string path = _iio_device_path + "/trigger/current_trigger";
             _pm_thread = std::unique_ptr<std::thread>(new std::thread([path,current_trigger](){
+                rsutils::os::init_thread("hid");
                 bool retry =true;
                 while (retry) {
                     try {
@@ -849,6 +853,19 @@ namespace librealsense
             write_fs_attribute(_iio_device_path + "/buffer/length", hid_buf_len);
         }
 
+        void iio_hid_sensor::set_watermark(uint32_t samples)
+        {
+            // Always written, as the kernel keeps whatever the last user left there
+            auto path = _iio_device_path + "/buffer/watermark";
+            if (!std::ifstream(path).good())
+            {
+                if (samples > 1)
+                    LOG_WARNING("HID: no IIO buffer watermark for " << _sensor_name << "; samples won't be batched");
+                return;
+            }
+            write_fs_attribute(path, std::min(std::max(samples, 1u), hid_buf_len));
+        }
+
         // calculate the storage size of a scan
         uint32_t iio_hid_sensor::get_channel_size() const
         {
@@ -1067,6 +1084,7 @@ namespace librealsense
                             continue;
 
                         auto device = std::unique_ptr<iio_hid_sensor>(new iio_hid_sensor(device_info.device_path, frequency, sensitivity));
+                        device->set_watermark(_batch_size);
                         _iio_hid_sensors.push_back(std::move(device));
                     }
                 }
@@ -143,6 +143,9 @@ namespace librealsense
 
             const std::string& get_sensor_name() const { return _sensor_name; }
 
+            // Have select() wake us only once this many samples are in the IIO buffer, so they're all read at once
+            void set_watermark(uint32_t samples);
+
         private:
             void clear_buffer();
 
@@ -217,6 +220,8 @@ namespace librealsense
 
             void set_gyro_scale_factor( double scale_factor ) override{};
 
+            void set_batch_size( uint32_t samples ) override { _batch_size = samples; }
+
         private:
             static bool get_hid_device_info(const char* dev_path, hid_device_info& device_info);
 
@@ -226,6 +231,7 @@ namespace librealsense
             std::vector<std::unique_ptr<hid_custom_sensor>> _hid_custom_sensors;
             std::vector<iio_hid_sensor*> _streaming_iio_sensors;
             std::vector<hid_custom_sensor*> _streaming_custom_sensors;
+            uint32_t _batch_size = 1;
             static constexpr const char* custom_id{"custom"};
         };
     }
@@ -6,18 +6,21 @@
 #include <src/platform/hid-data.h>
 #include <src/core/time-service.h>
 #include <src/core/notification.h>
+#include <src/log.h>
 #include "backend-hid.h"
 #include "backend.h"
 #include "types.h"
 #if defined(USING_UDEV)
 #include "udev-device-watcher.h"
 #else
-#include "../polling-device-watcher.h"
+#include "../libusb/hotplug-device-watcher.h"
 #endif
 #include "usb/usb-enumerator.h"
 #include "usb/usb-device.h"
 
 #include <rsutils/string/from.h>
+#include <rsutils/shared-ptr-singleton.h>
+#include <rsutils/os/thread.h>
 
 #include <cassert>
 #include <cstdlib>
@@ -57,6 +60,8 @@
 #include <cstddef> // offsetof
 
 #include <sys/signalfd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <signal.h>
 #pragma GCC diagnostic ignored "-Woverflow"
 
@@ -153,6 +158,12 @@ int lockf(int fd, int cmd, off_t length)
 }
 #endif
 
+#ifdef USING_V4L2_EPOLL
+constexpr bool use_epoll_reactor = true;
+#else
+constexpr bool use_epoll_reactor = false;
+#endif
+
 namespace librealsense
 {
     namespace platform
@@ -323,6 +334,20 @@ namespace librealsense
                                                     fd, _offset));
                 if(_start == MAP_FAILED)
                     throw linux_backend_exception("mmap failed");
+
+                // Export the buffer so frames can be handed on (to CUDA/EGL/VA-API) without copying
+                if (type == V4L2_BUF_TYPE_VIDEO_CAPTURE || type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE)
+                {
+                    v4l2_exportbuffer expbuf = {};
+                    expbuf.type = type;
+                    expbuf.index = index;
+                    expbuf.plane = 0;
+                    expbuf.flags = O_CLOEXEC | O_RDONLY;
+                    if (xioctl(fd, VIDIOC_EXPBUF, &expbuf) == 0)
+                        _dmabuf_fd = expbuf.fd;
+                    else
+                        LOG_DEBUG_V4L("xioctl(VIDIOC_EXPBUF) unsupported for fd " << std::dec << fd << ", buf " << index);
+                }
             }
             else
             {
@@ -357,6 +382,9 @@ namespace librealsense
 
         buffer::~buffer()
         {
+            if (_dmabuf_fd >= 0)
+                ::close(_dmabuf_fd);
+
             if (_use_memory_map)
             {
                if(munmap(_start, _original_length) < 0)
@@ -475,7 +503,7 @@ namespace librealsense
 
             if (nullptr == md_start)
             {
-                LOG_DEBUG("Could not parse metadata");
+                LOG_DEBUG_FMT( "Could not parse metadata" );
             }
             set_md_attributes(static_cast<uint8_t>(md_size),md_start);
         }
@@ -1171,6 +1199,7 @@ namespace librealsense
         {
             _is_capturing = false;
             if (_thread && _thread->joinable()) _thread->join();
+            if (_reactor) _reactor->remove(_reactor_id);
             for (auto&& fd : _fds)
             {
                 try { if (fd) ::close(fd);} catch (...) {}
@@ -1267,7 +1296,40 @@ namespace librealsense
                 streamon();
 
                 _is_capturing = true;
-                _thread = std::unique_ptr<std::thread>(new std::thread([this](){ capture_loop(); }));
+                if (use_epoll_reactor)
+                {
+                    static rsutils::shared_ptr_singleton<v4l2_epoll_reactor> the_reactor;
+                    _reactor = the_reactor.instance();
+
+                    // The stop pipe is only needed to wake up select()
+                    std::vector<int> fds;
+                    std::copy_if(_fds.begin(), _fds.end(), std::back_inserter(fds),
+                                 [this](int fd) { return fd != _stop_pipe_fd[0] && fd != _stop_pipe_fd[1]; });
+                    _reactor_id = _reactor->add(fds, [this](ready_fds& ready)
+                    {
+                        try
+                        {
+                            process_ready_fds(ready);
+                            return true;
+                        }
+                        catch (const std::exception& ex)
+                        {
+                            LOG_ERROR(ex.what());
+
+                            librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR, 0, RS2_LOG_SEVERITY_ERROR, ex.what()};
+
+                            _error_handler(n);
+                            return false;
+                        }
+                    }, std::chrono::seconds(5));
+                }
+                else
+                {
+                    _thread = std::unique_ptr<std::thread>(new std::thread([this](){
+                        rsutils::os::init_thread("capture");
+                        capture_loop();
+                    }));
+                }
 
                 // Starting the video/metadata syncer
                 _video_md_syncer.start();
@@ -1284,11 +1346,21 @@ namespace librealsense
             _is_capturing = false;
             _is_started = false;
 
-            // Stop nn-demand frames polling
-            signal_stop();
+            if (_reactor)
+            {
+                _video_md_syncer.stop();
+                _reactor->remove(_reactor_id);
+                _reactor.reset();
+                _reactor_id = -1;
+            }
+            else
+            {
+                // Stop nn-demand frames polling
+                signal_stop();
 
-            _thread->join();
-            _thread.reset();
+                _thread->join();
+                _thread.reset();
+            }
 
             // Notify kernel
             streamoff();
@@ -1366,6 +1438,15 @@ namespace librealsense
             return oss.str();
         }
 
+        // The buffer's timestamp is when the driver completed the frame, and is the frame's time of arrival unless the
+        // driver says it's on a clock other than monotonic (which monotonic_to_realtime() converts from)
+        static rs2_time_t driver_arrival_time( v4l2_buffer const & buf, double realtime_timestamp )
+        {
+            if( ( buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK ) != V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC )
+                return 0;
+            return realtime_timestamp;
+        }
+
         void v4l_uvc_device::poll()
         {
              fd_set fds{};
@@ -1418,240 +1499,255 @@ namespace librealsense
             }
             else
             {
-                if(val > 0)
+                ready_fds ready;
+                for (auto fd : _fds)
+                {
+                    if (FD_ISSET(fd, &fds))
+                        ready.set(fd);
+                }
+                process_ready_fds(ready);
+            }
+        }
+
+        void v4l_uvc_device::process_ready_fds(ready_fds& fds)
+        {
+            if(!fds.empty())
+            {
+                if(fds.is_set(_stop_pipe_fd[0]) || fds.is_set(_stop_pipe_fd[1]))
                 {
-                    if(FD_ISSET(_stop_pipe_fd[0], &fds) || FD_ISSET(_stop_pipe_fd[1], &fds))
+                    if(!_is_capturing)
                     {
-                        if(!_is_capturing)
-                        {
-                            LOG_INFO("V4L stream is closed");
-                            return;
-                        }
-                        else
-                        {
-                            LOG_ERROR("Stop pipe was signalled during streaming");
-                            return;
-                        }
+                        LOG_INFO("V4L stream is closed");
+                        return;
                     }
-                    else // Check and acquire data buffers from kernel
+                    else
                     {
-                        bool md_extracted = false;
-                        bool keep_md = false;
-                        bool wa_applied = false;
-                        buffers_mgr buf_mgr(_use_memory_map);
-                        if (_buf_dispatch.metadata_size())
-                        {
-                            buf_mgr = _buf_dispatch;    // Handle over MD buffer from the previous cycle
-                            md_extracted = true;
-                            wa_applied = true;
-                            _buf_dispatch.set_md_attributes(0,nullptr);
-                        }
+                        LOG_ERROR("Stop pipe was signalled during streaming");
+                        return;
+                    }
+                }
+                else // Check and acquire data buffers from kernel
+                {
+                    bool md_extracted = false;
+                    bool keep_md = false;
+                    bool wa_applied = false;
+                    buffers_mgr buf_mgr(_use_memory_map);
+                    if (_buf_dispatch.metadata_size())
+                    {
+                        buf_mgr = _buf_dispatch;    // Handle over MD buffer from the previous cycle
+                        md_extracted = true;
+                        wa_applied = true;
+                        _buf_dispatch.set_md_attributes(0,nullptr);
+                    }
 
-                        // Relax the required frame size for compressed formats, i.e. MJPG, Z16H
-                        bool compressed_format = val_in_range(_profile.format, { 0x4d4a5047U , 0x5a313648U});
+                    // Relax the required frame size for compressed formats, i.e. MJPG, Z16H
+                    bool compressed_format = val_in_range(_profile.format, { 0x4d4a5047U , 0x5a313648U});
 
-                        // METADATA STREAM
-                        // Read metadata. Metadata node performs a blocking call to ensure video and metadata sync
-                        acquire_metadata(buf_mgr,fds,compressed_format);
-                        md_extracted = true;
+                    // METADATA STREAM
+                    // Read metadata. Metadata node performs a blocking call to ensure video and metadata sync
+                    acquire_metadata(buf_mgr,fds,compressed_format);
+                    md_extracted = true;
+
+                    if (wa_applied)
+                    {
+                        auto fn = *(uint32_t*)((char*)(buf_mgr.metadata_start())+28);
+                        LOG_DEBUG_V4L("Extracting md buff, fn = " << fn);
+                    }
 
-                        if (wa_applied)
+                    // VIDEO STREAM
+                    if(fds.is_set(_fd))
+                    {
+                        fds.clear(_fd);
+                        v4l2_buffer buf = {};
+                        struct v4l2_plane planes[VIDEO_MAX_PLANES] = {};
+                        buf.type = _dev.buf_type;
+                        buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+                        if (_dev.buf_type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) {
+                            buf.m.planes = planes;
+                            buf.length = VIDEO_MAX_PLANES;
+                        }
+                        if(xioctl(_fd, VIDIOC_DQBUF, &buf) < 0)
                         {
-                            auto fn = *(uint32_t*)((char*)(buf_mgr.metadata_start())+28);
-                            LOG_DEBUG_V4L("Extracting md buff, fn = " << fn);
+                            LOG_DEBUG_V4L("Dequeued empty buf for fd " << std::dec << _fd);
+                        }
+                        LOG_DEBUG_V4L("Dequeued buf " << std::dec << buf.index << " for fd " << _fd << " seq " << buf.sequence);
+                        buf.type = _dev.buf_type;
+                        buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+                        if (_dev.buf_type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) {
+                            buf.bytesused = buf.m.planes[0].bytesused;
                         }
+                        auto buffer = _buffers[buf.index];
+                        buf_mgr.handle_buffer(e_video_buf, _fd, buf, buffer);
 
-                        // VIDEO STREAM
-                        if(FD_ISSET(_fd, &fds))
+                        if (_is_started)
                         {
-                            FD_CLR(_fd,&fds);
-                            v4l2_buffer buf = {};
-                            struct v4l2_plane planes[VIDEO_MAX_PLANES] = {};
-                            buf.type = _dev.buf_type;
-                            buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
-                            if (_dev.buf_type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) {
-                                buf.m.planes = planes;
-                                buf.length = VIDEO_MAX_PLANES;
-                            }
-                            if(xioctl(_fd, VIDIOC_DQBUF, &buf) < 0)
+                            if(buf.bytesused == 0)
                             {
-                                LOG_DEBUG_V4L("Dequeued empty buf for fd " << std::dec << _fd);
+                                LOG_DEBUG_V4L("Empty video frame arrived, index " << buf.index);
+                                return;
                             }
-                            LOG_DEBUG_V4L("Dequeued buf " << std::dec << buf.index << " for fd " << _fd << " seq " << buf.sequence);
-                            buf.type = _dev.buf_type;
-                            buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+
+                            // Drop partial and overflow frames (assumes D4XX metadata only)
+                            bool partial_frame = (!compressed_format && (buf.bytesused < buffer->get_full_length() - MAX_META_DATA_SIZE));
+                            bool overflow_frame = (buf.bytesused ==  buffer->get_length_frame_only() + MAX_META_DATA_SIZE);
                             if (_dev.buf_type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) {
-                                buf.bytesused = buf.m.planes[0].bytesused;
+                                /* metadata size is one line of profile, temporary disable validation */
+                                partial_frame = false;
+                                overflow_frame = false;
                             }
-                            auto buffer = _buffers[buf.index];
-                            buf_mgr.handle_buffer(e_video_buf, _fd, buf, buffer);
-
-                            if (_is_started)
+                            if (partial_frame || overflow_frame)
                             {
-                                if(buf.bytesused == 0)
-                                {
-                                    LOG_DEBUG_V4L("Empty video frame arrived, index " << buf.index);
-                                    return;
-                                }
-
-                                // Drop partial and overflow frames (assumes D4XX metadata only)
-                                bool partial_frame = (!compressed_format && (buf.bytesused < buffer->get_full_length() - MAX_META_DATA_SIZE));
-                                bool overflow_frame = (buf.bytesused ==  buffer->get_length_frame_only() + MAX_META_DATA_SIZE);
-                                if (_dev.buf_type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) {
-                                    /* metadata size is one line of profile, temporary disable validation */
-                                    partial_frame = false;
-                                    overflow_frame = false;
-                                }
-                                if (partial_frame || overflow_frame)
+                                auto percentage = (100 * buf.bytesused) / buffer->get_full_length();
+                                std::stringstream s;
+                                if (partial_frame)
                                 {
-                                    auto percentage = (100 * buf.bytesused) / buffer->get_full_length();
-                                    std::stringstream s;
-                                    if (partial_frame)
-                                    {
-                                        s << "Incomplete video frame detected!\nSize " << buf.bytesused
-                                            << " out of " << buffer->get_full_length() << " bytes (" << percentage << "%)";
-                                        if (overflow_frame)
-                                        {
-                                            s << ". Overflow detected: payload size " << buffer->get_length_frame_only();
-                                            LOG_ERROR("Corrupted UVC frame data, underflow and overflow reported:\n" << s.str().c_str());
-                                        }
-                                    }
-                                    else
+                                    s << "Incomplete video frame detected!\nSize " << buf.bytesused
+                                        << " out of " << buffer->get_full_length() << " bytes (" << percentage << "%)";
+                                    if (overflow_frame)
                                     {
-                                        if (overflow_frame)
-                                            s << "overflow video frame detected!\nSize " << buf.bytesused
-                                                << ", payload size " << buffer->get_length_frame_only();
-                                    }
-                                    LOG_DEBUG("Incomplete frame received: " << s.str()); // Ev -try1
-                                    bool kpi_violated = _frame_drop_monitor.update_and_check_kpi(_profile, buf.timestamp);
-                                    if (kpi_violated)
-                                    {
-                                        librealsense::notification n = { RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str() };
-                                        _error_handler(n);
-                                    }
-                                    
-                                    // Check if metadata was already allocated
-                                    if (buf_mgr.metadata_size())
-                                    {
-                                        LOG_WARNING("Metadata was present when partial frame arrived, mark md as extracted");
-                                        md_extracted = true;
-                                        LOG_DEBUG_V4L("Discarding md due to invalid video payload");
-                                        auto md_buf = buf_mgr.get_buffers().at(e_metadata_buf);
-                                        md_buf._data_buf->request_next_frame(md_buf._file_desc,true);
+                                        s << ". Overflow detected: payload size " << buffer->get_length_frame_only();
+                                        LOG_ERROR("Corrupted UVC frame data, underflow and overflow reported:\n" << s.str().c_str());
                                     }
                                 }
                                 else
                                 {
-                                    if (!_info.has_metadata_node)
+                                    if (overflow_frame)
+                                        s << "overflow video frame detected!\nSize " << buf.bytesused
+                                            << ", payload size " << buffer->get_length_frame_only();
+                                }
+                                LOG_DEBUG_FMT( "Incomplete frame received: {}", s.str() ); // Ev -try1
+                                bool kpi_violated = _frame_drop_monitor.update_and_check_kpi(_profile, buf.timestamp);
+                                if (kpi_violated)
+                                {
+                                    librealsense::notification n = { RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str() };
+                                    _error_handler(n);
+                                }
+                                
+                                // Check if metadata was already allocated
+                                if (buf_mgr.metadata_size())
+                                {
+                                    LOG_WARNING("Metadata was present when partial frame arrived, mark md as extracted");
+                                    md_extracted = true;
+                                    LOG_DEBUG_V4L("Discarding md due to invalid video payload");
+                                    auto md_buf = buf_mgr.get_buffers().at(e_metadata_buf);
+                                    md_buf._data_buf->request_next_frame(md_buf._file_desc,true);
+                                }
+                            }
+                            else
+                            {
+                                if (!_info.has_metadata_node)
+                                {
+                                    if(has_metadata())
                                     {
-                                        if(has_metadata())
-                                        {
-                                            auto timestamp = (double)buf.timestamp.tv_sec*1000.f + (double)buf.timestamp.tv_usec/1000.f;
-                                            timestamp = monotonic_to_realtime(timestamp);
+                                        auto timestamp = (double)buf.timestamp.tv_sec*1000.f + (double)buf.timestamp.tv_usec/1000.f;
+                                        timestamp = monotonic_to_realtime(timestamp);
 
-                                            // Read metadata. Metadata node performs a blocking call to ensure video and metadata sync
-                                            acquire_metadata(buf_mgr,fds,compressed_format);
-                                            md_extracted = true;
+                                        // Read metadata. Metadata node performs a blocking call to ensure video and metadata sync
+                                        acquire_metadata(buf_mgr,fds,compressed_format);
+                                        md_extracted = true;
 
-                                            if (wa_applied)
-                                            {
-                                                auto fn = *(uint32_t*)((char*)(buf_mgr.metadata_start())+28);
-                                                LOG_DEBUG_V4L("Extracting md buff, fn = " << fn);
-                                            }
+                                        if (wa_applied)
+                                        {
+                                            auto fn = *(uint32_t*)((char*)(buf_mgr.metadata_start())+28);
+                                            LOG_DEBUG_V4L("Extracting md buff, fn = " << fn);
+                                        }
 
-                                            auto frame_sz = buf_mgr.md_node_present() ? buf.bytesused :
-                                                                std::min(buf.bytesused - buf_mgr.metadata_size(), buffer->get_length_frame_only());
-                                            frame_object fo{ frame_sz, buf_mgr.metadata_size(),
-                                                             buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp };
+                                        auto frame_sz = buf_mgr.md_node_present() ? buf.bytesused :
+                                                            std::min(buf.bytesused - buf_mgr.metadata_size(), buffer->get_length_frame_only());
+                                        frame_object fo{ frame_sz, buf_mgr.metadata_size(),
+                                                         buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp,
+                                                         buffer->get_dmabuf_fd() };
+                                        fo.arrival_time = driver_arrival_time( buf, timestamp );
 
-                                            buffer->attach_buffer(buf);
-                                            buf_mgr.handle_buffer(e_video_buf,-1); // transfer new buffer request to the frame callback
+                                        buffer->attach_buffer(buf);
+                                        buf_mgr.handle_buffer(e_video_buf,-1); // transfer new buffer request to the frame callback
 
-                                            if (buf_mgr.verify_vd_md_sync())
-                                            {
-                                                //Invoke user callback and enqueue next frame
-                                                _callback(_profile, fo, [buf_mgr]() mutable {
-                                                    buf_mgr.request_next_frame();
-                                                });
-                                            }
-                                            else
-                                            {
-                                                LOG_WARNING("Video frame dropped, video and metadata buffers inconsistency");
-                                            }
+                                        if (buf_mgr.verify_vd_md_sync())
+                                        {
+                                            //Invoke user callback and enqueue next frame
+                                            _callback(_profile, fo, [buf_mgr]() mutable {
+                                                buf_mgr.request_next_frame();
+                                            });
                                         }
-                                        else // when metadata is not enabled at all, streaming only video
+                                        else
                                         {
-                                            auto timestamp = (double)buf.timestamp.tv_sec * 1000.f + (double)buf.timestamp.tv_usec / 1000.f;
-                                            timestamp = monotonic_to_realtime(timestamp);
-
-                                            LOG_DEBUG_V4L("no metadata streamed");
-                                            if (buf_mgr.verify_vd_md_sync())
-                                            {
-                                                buffer->attach_buffer(buf);
-                                                buf_mgr.handle_buffer(e_video_buf, -1); // transfer new buffer request to the frame callback
-
+                                            LOG_WARNING("Video frame dropped, video and metadata buffers inconsistency");
+                                        }
+                                    }
+                                    else // when metadata is not enabled at all, streaming only video
+                                    {
+                                        auto timestamp = (double)buf.timestamp.tv_sec * 1000.f + (double)buf.timestamp.tv_usec / 1000.f;
+                                        timestamp = monotonic_to_realtime(timestamp);
 
-                                                auto frame_sz = buf_mgr.md_node_present() ? buf.bytesused :
-                                                                    std::min(buf.bytesused - buf_mgr.metadata_size(),
-                                                                             buffer->get_length_frame_only());
+                                        LOG_DEBUG_V4L("no metadata streamed");
+                                        if (buf_mgr.verify_vd_md_sync())
+                                        {
+                                            buffer->attach_buffer(buf);
+                                            buf_mgr.handle_buffer(e_video_buf, -1); // transfer new buffer request to the frame callback
 
-                                                uint8_t md_size = buf_mgr.metadata_size();
-                                                void* md_start = buf_mgr.metadata_start();
 
-                                                // D457 development - hid over uvc - md size for IMU is 64
-                                                metadata_hid_raw meta_data{};
-                                                if (md_size == 0 && buffer->get_length_frame_only() <= 64)
-                                                {
-                                                    // Populate HID IMU data - Header
-                                                    populate_imu_data(meta_data, buffer->get_frame_start(), md_size, &md_start);
-                                                }
+                                            auto frame_sz = buf_mgr.md_node_present() ? buf.bytesused :
+                                                                std::min(buf.bytesused - buf_mgr.metadata_size(),
+                                                                         buffer->get_length_frame_only());
 
-                                                frame_object fo{ frame_sz, md_size,
-                                                            buffer->get_frame_start(), md_start, timestamp };
+                                            uint8_t md_size = buf_mgr.metadata_size();
+                                            void* md_start = buf_mgr.metadata_start();
 
-                                                //Invoke user callback and enqueue next frame
-                                                _callback(_profile, fo, [buf_mgr]() mutable {
-                                                    buf_mgr.request_next_frame();
-                                                });
-                                            }
-                                            else
+                                            // D457 development - hid over uvc - md size for IMU is 64
+                                            metadata_hid_raw meta_data{};
+                                            if (md_size == 0 && buffer->get_length_frame_only() <= 64)
                                             {
-                                                LOG_WARNING("Video frame dropped, video and metadata buffers inconsistency");
+                                                // Populate HID IMU data - Header
+                                                populate_imu_data(meta_data, buffer->get_frame_start(), md_size, &md_start);
                                             }
+
+                                            frame_object fo{ frame_sz, md_size,
+                                                        buffer->get_frame_start(), md_start, timestamp,
+                                                        buffer->get_dmabuf_fd() };
+                                            fo.arrival_time = driver_arrival_time( buf, timestamp );
+
+                                            //Invoke user callback and enqueue next frame
+                                            _callback(_profile, fo, [buf_mgr]() mutable {
+                                                buf_mgr.request_next_frame();
+                                            });
+                                        }
+                                        else
+                                        {
+                                            LOG_WARNING("Video frame dropped, video and metadata buffers inconsistency");
                                         }
-                                    }
-                                    else
-                                    {
-                                        // saving video buffer to syncer
-                                        _video_md_syncer.push_video({std::make_shared<v4l2_buffer>(buf), _fd, buf.index});
-                                        buf_mgr.handle_buffer(e_video_buf, -1);
                                     }
                                 }
-                            }
-                            else
-                            {
-                                LOG_DEBUG_V4L("Video frame arrived in idle mode."); // TODO - verification
+                                else
+                                {
+                                    // saving video buffer to syncer
+                                    _video_md_syncer.push_video({buf, _fd, buf.index, std::chrono::steady_clock::now()});
+                                    buf_mgr.handle_buffer(e_video_buf, -1);
+                                }
                             }
                         }
                         else
                         {
-                            if (_is_started)
-                                keep_md = true;
-                            LOG_DEBUG("FD_ISSET: no data on video node sink");
+                            LOG_DEBUG_V4L("Video frame arrived in idle mode."); // TODO - verification
                         }
-
-                        // pulling synchronized video and metadata and uploading them to user's callback
-                        upload_video_and_metadata_from_syncer(buf_mgr);
                     }
-                }
-                else // (val==0)
-                {
-                    LOG_WARNING("Frames didn't arrived within 5 seconds");
-                    librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_FRAMES_TIMEOUT, 0, RS2_LOG_SEVERITY_WARN,  "Frames didn't arrived within 5 seconds"};
+                    else
+                    {
+                        if (_is_started)
+                            keep_md = true;
+                        LOG_DEBUG_FMT( "FD_ISSET: no data on video node sink" );
+                    }
 
-                    _error_handler(n);
+                    // pulling synchronized video and metadata and uploading them to user's callback
+                    upload_video_and_metadata_from_syncer(buf_mgr);
                 }
             }
+            else // timeout
+            {
+                LOG_WARNING("Frames didn't arrived within 5 seconds");
+                librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_FRAMES_TIMEOUT, 0, RS2_LOG_SEVERITY_WARN,  "Frames didn't arrived within 5 seconds"};
+
+                _error_handler(n);
+            }
         }
 
         void v4l_uvc_device::populate_imu_data(metadata_hid_raw& meta_data, uint8_t* frame_start, uint8_t& md_size, void** md_start) const
@@ -1671,8 +1767,8 @@ namespace librealsense
         void v4l_uvc_device::upload_video_and_metadata_from_syncer(buffers_mgr& buf_mgr)
         {
             // uploading to user's callback
-            std::shared_ptr<v4l2_buffer> video_v4l2_buffer;
-            std::shared_ptr<v4l2_buffer> md_v4l2_buffer;
+            v4l2_buffer video_v4l2_buffer{};
+            v4l2_buffer md_v4l2_buffer{};
 
             if (_is_started && is_metadata_streamed())
             {
@@ -1680,39 +1776,41 @@ namespace librealsense
                 if (_video_md_syncer.pull_video_with_metadata(video_v4l2_buffer, md_v4l2_buffer, video_fd, md_fd))
                 {
                     // Preparing video buffer
-                    auto video_buffer = get_video_buffer(video_v4l2_buffer->index);
-                    video_buffer->attach_buffer(*video_v4l2_buffer);
+                    auto video_buffer = get_video_buffer(video_v4l2_buffer.index);
+                    video_buffer->attach_buffer(video_v4l2_buffer);
 
                     // happens when the video did not arrive on
                     // the current polling iteration (was taken from the syncer's video queue)
                     if (buf_mgr.get_buffers()[e_video_buf]._file_desc == -1)
                     {
-                        buf_mgr.handle_buffer(e_video_buf, video_fd, *video_v4l2_buffer, video_buffer);
+                        buf_mgr.handle_buffer(e_video_buf, video_fd, video_v4l2_buffer, video_buffer);
                     }
                     buf_mgr.handle_buffer(e_video_buf, -1); // transfer new buffer request to the frame callback
 
                     // Preparing metadata buffer
-                    auto metadata_buffer = get_md_buffer(md_v4l2_buffer->index);
-                    set_metadata_attributes(buf_mgr, md_v4l2_buffer->bytesused, metadata_buffer->get_frame_start());
-                    metadata_buffer->attach_buffer(*md_v4l2_buffer);
+                    auto metadata_buffer = get_md_buffer(md_v4l2_buffer.index);
+                    set_metadata_attributes(buf_mgr, md_v4l2_buffer.bytesused, metadata_buffer->get_frame_start());
+                    metadata_buffer->attach_buffer(md_v4l2_buffer);
 
                     if (buf_mgr.get_buffers()[e_metadata_buf]._file_desc == -1)
                     {
-                        buf_mgr.handle_buffer(e_metadata_buf, md_fd, *md_v4l2_buffer, metadata_buffer);
+                        buf_mgr.handle_buffer(e_metadata_buf, md_fd, md_v4l2_buffer, metadata_buffer);
                     }
                     buf_mgr.handle_buffer(e_metadata_buf, -1); // transfer new buffer request to the frame callback
 
-                    auto frame_sz = buf_mgr.md_node_present() ? video_v4l2_buffer->bytesused :
-                                        std::min(video_v4l2_buffer->bytesused - buf_mgr.metadata_size(),
+                    auto frame_sz = buf_mgr.md_node_present() ? video_v4l2_buffer.bytesused :
+                                        std::min(video_v4l2_buffer.bytesused - buf_mgr.metadata_size(),
                                                  video_buffer->get_length_frame_only());
 
-                    auto timestamp = (double)video_v4l2_buffer->timestamp.tv_sec * 1000.f + (double)video_v4l2_buffer->timestamp.tv_usec / 1000.f;
+                    auto timestamp = (double)video_v4l2_buffer.timestamp.tv_sec * 1000.f + (double)video_v4l2_buffer.timestamp.tv_usec / 1000.f;
                     timestamp = monotonic_to_realtime(timestamp);
 
                     // D457 work - to work with "normal camera", use frame_sz as the first input to the following frame_object:
                     //frame_object fo{ buf.bytesused - MAX_META_DATA_SIZE, buf_mgr.metadata_size(),
                     frame_object fo{ frame_sz, buf_mgr.metadata_size(),
-                                     video_buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp };
+                                     video_buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp,
+                                     video_buffer->get_dmabuf_fd() };
+                    fo.arrival_time = driver_arrival_time( video_v4l2_buffer, timestamp );
 
                     //Invoke user callback and enqueue next frame
                     _callback(_profile, fo, [buf_mgr]() mutable {
@@ -1721,7 +1819,7 @@ namespace librealsense
                 }
                 else
                 {
-                    LOG_DEBUG("video_md_syncer - synchronized video and md could not be pulled");
+                    LOG_DEBUG_FMT( "video_md_syncer - synchronized video and md could not be pulled" );
                 }
             }
         }
@@ -1748,7 +1846,7 @@ namespace librealsense
             return pos != std::string::npos;
         }
 
-        void v4l_uvc_device::acquire_metadata(buffers_mgr& buf_mgr,fd_set &, bool compressed_format)
+        void v4l_uvc_device::acquire_metadata(buffers_mgr& buf_mgr,ready_fds &, bool compressed_format)
         {
             if (has_metadata())
                 buf_mgr.set_md_from_video_node(compressed_format);
@@ -2076,6 +2174,188 @@ namespace librealsense
             }
         }
 
+        v4l2_epoll_reactor::v4l2_epoll_reactor()
+            : _running(true)
+        {
+            _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+            if (_epoll_fd < 0)
+                throw linux_backend_exception("v4l2_epoll_reactor: epoll_create1 failed");
+
+            // Used only to wake the threads up on destruction
+            _wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (_wake_fd < 0)
+            {
+                ::close(_epoll_fd);
+                throw linux_backend_exception("v4l2_epoll_reactor: eventfd failed");
+            }
+            epoll_event ev = {};
+            ev.events = EPOLLIN;
+            ev.data.u64 = ~0ULL;
+            epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wake_fd, &ev);
+
+            auto n_threads = std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2));
+            for (unsigned i = 0; i < n_threads; ++i)
+                _threads.emplace_back([this]() {
+                    rsutils::os::init_thread("capture");
+                    run();
+                });
+        }
+
+        v4l2_epoll_reactor::~v4l2_epoll_reactor()
+        {
+            _running = false;
+            uint64_t one = 1;
+            if (write(_wake_fd, &one, sizeof(one)) < 0)
+                LOG_ERROR("v4l2_epoll_reactor: could not wake up the polling threads");
+            for (auto&& t : _threads)
+            {
+                // The last reference may be released from within a handler
+                if (t.get_id() == std::this_thread::get_id())
+                    t.detach();
+                else if (t.joinable())
+                    t.join();
+            }
+            ::close(_wake_fd);
+            ::close(_epoll_fd);
+        }
+
+        void v4l2_epoll_reactor::arm(int id, int fd, int op) const
+        {
+            // One-shot, so a descriptor is handed to a single thread at a time; it's re-armed once handled
+            epoll_event ev = {};
+            ev.events = EPOLLIN | EPOLLONESHOT;
+            ev.data.u64 = (uint64_t(uint32_t(id)) << 32) | uint32_t(fd);
+            if (epoll_ctl(_epoll_fd, op, fd, &ev) < 0)
+                LOG_ERROR("v4l2_epoll_reactor: epoll_ctl failed for fd " << fd << ", error: " << strerror(errno));
+        }
+
+        int v4l2_epoll_reactor::add(const std::vector<int>& fds, handler h, std::chrono::milliseconds timeout)
+        {
+            auto reg = std::make_shared<registration>();
+            reg->fds = fds;
+            reg->h = std::move(h);
+            reg->timeout = timeout;
+            reg->last_event = std::chrono::steady_clock::now();
+
+            int id;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                id = _next_id++;
+                _registrations[id] = reg;
+            }
+            for (auto fd : fds)
+                arm(id, fd, EPOLL_CTL_ADD);
+            return id;
+        }
+
+        void v4l2_epoll_reactor::remove(int id)
+        {
+            std::shared_ptr<registration> reg;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it = _registrations.find(id);
+                if (it == _registrations.end())
+                    return;
+                reg = it->second;
+                _registrations.erase(it);
+            }
+            // Wait for a handler in progress; it won't re-arm anything once we're inactive
+            std::lock_guard<std::mutex> lock(reg->mutex);
+            reg->active = false;
+            for (auto fd : reg->fds)
+                epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        }
+
+        void v4l2_epoll_reactor::dispatch(int id, const std::shared_ptr<registration>& reg, ready_fds& fds)
+        {
+            std::vector<int> rearm;
+            for (auto fd : reg->fds)
+                if (fds.is_set(fd))
+                    rearm.push_back(fd);
+
+            std::lock_guard<std::mutex> lock(reg->mutex);
+            if (!reg->active)
+                return;
+            reg->last_event = std::chrono::steady_clock::now();
+            if (!reg->h(fds))
+            {
+                reg->active = false;
+                return;
+            }
+            for (auto fd : rearm)
+                arm(id, fd, EPOLL_CTL_MOD);
+        }
+
+        void v4l2_epoll_reactor::check_timeouts()
+        {
+            // One thread checking is enough
+            std::unique_lock<std::mutex> timeouts_lock(_timeouts_mutex, std::try_to_lock);
+            if (!timeouts_lock)
+                return;
+
+            std::vector<std::pair<int, std::shared_ptr<registration>>> regs;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                regs.assign(_registrations.begin(), _registrations.end());
+            }
+            auto now = std::chrono::steady_clock::now();
+            for (auto&& r : regs)
+            {
+                bool expired;
+                {
+                    std::lock_guard<std::mutex> lock(r.second->mutex);
+                    expired = r.second->active && now - r.second->last_event > r.second->timeout;
+                }
+                if (expired)
+                {
+                    ready_fds none;
+                    dispatch(r.first, r.second, none);
+                }
+            }
+        }
+
+        void v4l2_epoll_reactor::run()
+        {
+            const int max_events = 16;
+            epoll_event events[max_events];
+            while (_running)
+            {
+                int n = epoll_wait(_epoll_fd, events, max_events, 1000);
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    LOG_ERROR("v4l2_epoll_reactor: epoll_wait failed, error: " << strerror(errno));
+                    break;
+                }
+
+                for (int i = 0; i < n && _running; ++i)
+                {
+                    if (events[i].data.u64 == ~0ULL)
+                        break;
+
+                    auto id = int(events[i].data.u64 >> 32);
+                    auto fd = int(events[i].data.u64 & 0xFFFFFFFF);
+                    std::shared_ptr<registration> reg;
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        auto it = _registrations.find(id);
+                        if (it != _registrations.end())
+                            reg = it->second;
+                    }
+                    if (!reg)
+                        continue;
+
+                    ready_fds fds;
+                    fds.set(fd);
+                    dispatch(id, reg, fds);
+                }
+
+                if (_running)
+                    check_timeouts();
+            }
+        }
+
         void v4l_uvc_device::capture_loop()
         {
             try
@@ -2499,10 +2779,15 @@ namespace librealsense
         }
 
         // Retrieve metadata from a dedicated UVC node. For kernels 4.16+
-        void v4l_uvc_meta_device::acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds, bool)
+        void v4l_uvc_meta_device::acquire_metadata(buffers_mgr & buf_mgr,ready_fds &fds, bool)
         {
+            // In paired mode, a ready video buffer is reason enough to look for its metadata: it has usually arrived
+            // too, and if not, the (non-blocking) node just says so and we wait for it as usual
+            bool speculative = _paired_md_capture && _md_fd > 0 && _is_started && !fds.is_set(_md_fd) && fds.is_set(_fd)
+                               && !buf_mgr.metadata_size();
+
             //Use non-blocking metadata node polling
-            if(_md_fd > 0 && FD_ISSET(_md_fd, &fds))
+            if(_md_fd > 0 && (fds.is_set(_md_fd) || speculative))
             {
                 // In scenario if [md+vid] ->[md] ->[md,vid] the third md should not be retrieved but wait for next select
                 if (buf_mgr.metadata_size())
@@ -2517,7 +2802,7 @@ namespace librealsense
                     auto md_buf = buf_mgr.get_buffers().at(e_metadata_buf);
                     md_buf._data_buf->request_next_frame(md_buf._file_desc,true);
                 }
-                FD_CLR(_md_fd,&fds);
+                fds.clear(_md_fd);
 
                 v4l2_buffer buf{};
                 buf.type = _md_type;
@@ -2526,6 +2811,8 @@ namespace librealsense
                 // W/O multiplexing this will create a blocking call for metadata node
                 if(xioctl(_md_fd, VIDIOC_DQBUF, &buf) < 0)
                 {
+                    if (speculative && errno == EAGAIN)
+                        return;
                     LOG_DEBUG_V4L("Dequeued empty buf for md fd " << std::dec << _md_fd);
                 }
 
@@ -2541,7 +2828,7 @@ namespace librealsense
                 buf_mgr.handle_buffer(e_metadata_buf, _md_fd, buf, buffer);
 
                 // pushing metadata buffer to syncer
-                _video_md_syncer.push_metadata({std::make_shared<v4l2_buffer>(buf), _md_fd, buf.index});
+                _video_md_syncer.push_metadata({buf, _md_fd, buf.index, std::chrono::steady_clock::now()});
                 buf_mgr.handle_buffer(e_metadata_buf, -1);
             }
         }
@@ -2811,7 +3098,7 @@ namespace librealsense
 #if defined(USING_UDEV)
             return std::make_shared< udev_device_watcher >( this );
 #else
-            return std::make_shared< polling_device_watcher >( this );
+            return create_usb_device_watcher( this );
 #endif
         }
 
@@ -2829,7 +3116,7 @@ namespace librealsense
                 return;
             }
             _video_queue.push(video_buffer);
-            LOG_DEBUG_V4L("video_md_syncer - video pushed with sequence " << video_buffer._v4l2_buf->sequence << ", buf " << video_buffer._buffer_index);
+            LOG_DEBUG_V4L("video_md_syncer - video pushed with sequence " << video_buffer._v4l2_buf.sequence << ", buf " << video_buffer._buffer_index);
 
             // remove old video_buffer
             if (_video_queue.size() > 2)
@@ -2848,13 +3135,13 @@ namespace librealsense
                 return;
             }
             // override front buffer if it has the same sequence that the new buffer - happens with metadata sequence 0
-            if (_md_queue.size() > 0 && _md_queue.front()._v4l2_buf->sequence == md_buffer._v4l2_buf->sequence)
+            if (_md_queue.size() > 0 && _md_queue.front()._v4l2_buf.sequence == md_buffer._v4l2_buf.sequence)
             {
                 LOG_DEBUG_V4L("video_md_syncer - calling enqueue_front_buffer_before_throwing_it - md buf " << md_buffer._buffer_index << " and md buf " << _md_queue.front()._buffer_index << " have same sequence");
                 enqueue_front_buffer_before_throwing_it(_md_queue);
             }
             _md_queue.push(md_buffer);
-            LOG_DEBUG_V4L("video_md_syncer - md pushed with sequence " << md_buffer._v4l2_buf->sequence << ", buf " << md_buffer._buffer_index);
+            LOG_DEBUG_V4L("video_md_syncer - md pushed with sequence " << md_buffer._v4l2_buf.sequence << ", buf " << md_buffer._buffer_index);
             LOG_DEBUG_V4L("video_md_syncer - md queue size = " << _md_queue.size());
 
             // remove old md_buffer
@@ -2866,7 +3153,7 @@ namespace librealsense
             }
         }
 
-        bool v4l2_video_md_syncer::pull_video_with_metadata(std::shared_ptr<v4l2_buffer>& video_buffer, std::shared_ptr<v4l2_buffer>& md_buffer,
+        bool v4l2_video_md_syncer::pull_video_with_metadata(v4l2_buffer& video_buffer, v4l2_buffer& md_buffer,
                                                             int& video_fd, int& md_fd)
         {
             std::lock_guard<std::mutex> lock(_syncer_mutex);
@@ -2887,64 +3174,67 @@ namespace librealsense
                 return false;
             }
 
-            sync_buffer video_candidate = _video_queue.front();
-            sync_buffer md_candidate = _md_queue.front();
+            const sync_buffer video_candidate = _video_queue.front();
+            const sync_buffer md_candidate = _md_queue.front();
 
             // set video and md file descriptors
             video_fd = video_candidate._fd;
             md_fd = md_candidate._fd;
 
             // sync is ok if latest video and md have the same sequence
-            if (video_candidate._v4l2_buf->sequence == md_candidate._v4l2_buf->sequence)
+            if (video_candidate._v4l2_buf.sequence == md_candidate._v4l2_buf.sequence)
             {
                 video_buffer = video_candidate._v4l2_buf;
                 md_buffer = md_candidate._v4l2_buf;
+                pulled(video_candidate, md_candidate);
                 // removing from queues
                 _video_queue.pop();
                 _md_queue.pop();
-                LOG_DEBUG_V4L("video_md_syncer - video and md pulled with sequence " << video_candidate._v4l2_buf->sequence);
+                LOG_DEBUG_V4L("video_md_syncer - video and md pulled with sequence " << video_candidate._v4l2_buf.sequence);
                 return true;
             }
 
-            LOG_DEBUG_V4L("video_md_syncer - video_candidate seq " << video_candidate._v4l2_buf->sequence << ", md_candidate seq " << md_candidate._v4l2_buf->sequence);
+            LOG_DEBUG_V4L("video_md_syncer - video_candidate seq " << video_candidate._v4l2_buf.sequence << ", md_candidate seq " << md_candidate._v4l2_buf.sequence);
 
-            if (video_candidate._v4l2_buf->sequence > md_candidate._v4l2_buf->sequence && _md_queue.size() > 1)
+            if (video_candidate._v4l2_buf.sequence > md_candidate._v4l2_buf.sequence && _md_queue.size() > 1)
             {
                 // Enqueue of md buffer before throwing its content away
                 enqueue_buffer_before_throwing_it(md_candidate);
                 _md_queue.pop();
 
                 // checking remaining metadata buffer in queue
-                auto alternative_md_candidate = _md_queue.front();
+                const sync_buffer alternative_md_candidate = _md_queue.front();
                 // sync is ok if latest video and md have the same sequence
-                if (video_candidate._v4l2_buf->sequence == alternative_md_candidate._v4l2_buf->sequence)
+                if (video_candidate._v4l2_buf.sequence == alternative_md_candidate._v4l2_buf.sequence)
                 {
                     video_buffer = video_candidate._v4l2_buf;
                     md_buffer = alternative_md_candidate._v4l2_buf;
+                    pulled(video_candidate, alternative_md_candidate);
                     // removing from queues
                     _video_queue.pop();
                     _md_queue.pop();
-                    LOG_DEBUG_V4L("video_md_syncer - video and md pulled with sequence " << video_candidate._v4l2_buf->sequence);
+                    LOG_DEBUG_V4L("video_md_syncer - video and md pulled with sequence " << video_candidate._v4l2_buf.sequence);
                     return true;
                 }
             }
-            if (video_candidate._v4l2_buf->sequence < md_candidate._v4l2_buf->sequence && _video_queue.size() > 1)
+            if (video_candidate._v4l2_buf.sequence < md_candidate._v4l2_buf.sequence && _video_queue.size() > 1)
             {
                 // Enqueue of md buffer before throwing its content away
                 enqueue_buffer_before_throwing_it(video_candidate);
                 _video_queue.pop();
 
                 // checking remaining video buffer in queue
-                auto alternative_video_candidate = _video_queue.front();
+                const sync_buffer alternative_video_candidate = _video_queue.front();
                 // sync is ok if latest video and md have the same sequence
-                if (alternative_video_candidate._v4l2_buf->sequence == md_candidate._v4l2_buf->sequence)
+                if (alternative_video_candidate._v4l2_buf.sequence == md_candidate._v4l2_buf.sequence)
                 {
                     video_buffer = alternative_video_candidate._v4l2_buf;
                     md_buffer = md_candidate._v4l2_buf;
+                    pulled(alternative_video_candidate, md_candidate);
                     // removing from queues
                     _video_queue.pop();
                     _md_queue.pop();
-                    LOG_DEBUG_V4L("video_md_syncer - video and md pulled with sequence " << md_candidate._v4l2_buf->sequence);
+                    LOG_DEBUG_V4L("video_md_syncer - video and md pulled with sequence " << md_candidate._v4l2_buf.sequence);
                     return true;
                 }
             }
@@ -2955,28 +3245,54 @@ namespace librealsense
         {
             // Enqueue of buffer before throwing its content away
             LOG_DEBUG_V4L("video_md_syncer - Enqueue buf " << std::dec << sb._buffer_index << " for fd " << sb._fd << " before dropping it");
-            if (xioctl(sb._fd, VIDIOC_QBUF, sb._v4l2_buf.get()) < 0)
+            v4l2_buffer buf = sb._v4l2_buf;
+            if (xioctl(sb._fd, VIDIOC_QBUF, &buf) < 0)
             {
                 LOG_ERROR("xioctl(VIDIOC_QBUF) failed when requesting new frame! fd: " << sb._fd << " error: " << strerror(errno));
             }
         }
 
-        void v4l2_video_md_syncer::enqueue_front_buffer_before_throwing_it(std::queue<sync_buffer>& sync_queue)
+        void v4l2_video_md_syncer::enqueue_front_buffer_before_throwing_it(sync_ring& sync_queue)
         {
-            // Enqueue of buffer before throwing its content away
-            LOG_DEBUG_V4L("video_md_syncer - Enqueue buf " << std::dec << sync_queue.front()._buffer_index << " for fd " << sync_queue.front()._fd << " before dropping it");
-            if (xioctl(sync_queue.front()._fd, VIDIOC_QBUF, sync_queue.front()._v4l2_buf.get()) < 0)
-            {
-                LOG_ERROR("xioctl(VIDIOC_QBUF) failed when requesting new frame! fd: " << sync_queue.front()._fd << " error: " << strerror(errno));
-            }
+            enqueue_buffer_before_throwing_it(sync_queue.front());
             sync_queue.pop();
         }
 
+        void v4l2_video_md_syncer::pulled(const sync_buffer& video, const sync_buffer& md)
+        {
+            // From the first of the two to arrive until the pair is handed over
+            auto first = std::min(video._arrival, md._arrival);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - first).count();
+            ++_stats.pairs;
+            _stats.last_ms = ms;
+            _stats.max_ms = std::max(_stats.max_ms, ms);
+            _stats.total_ms += ms;
+            LOG_DEBUG_V4L("video_md_syncer - pairing latency " << ms << " ms");
+        }
+
+        v4l2_video_md_syncer::pairing_stats v4l2_video_md_syncer::get_pairing_stats() const
+        {
+            std::lock_guard<std::mutex> lock(_syncer_mutex);
+            return _stats;
+        }
+
+        void v4l2_video_md_syncer::start()
+        {
+            std::lock_guard<std::mutex> lock(_syncer_mutex);
+            _stats = {};
+            _is_ready = true;
+        }
+
 
         void v4l2_video_md_syncer::stop()
         {
              _is_ready = false;
              flush_queues();
+
+             auto stats = get_pairing_stats();
+             if (stats.pairs)
+                 LOG_DEBUG("video_md_syncer - " << stats.pairs << " frames paired with their metadata, waiting "
+                           << stats.average_ms() << " ms on average, " << stats.max_ms << " ms at most");
         }
 
         void v4l2_video_md_syncer::flush_queues()
@@ -2984,14 +3300,8 @@ namespace librealsense
             // Empty queues
             LOG_DEBUG_V4L("video_md_syncer - flush video and md queues");
             std::lock_guard<std::mutex> lock(_syncer_mutex);
-            while(!_video_queue.empty())
-            {
-                _video_queue.pop();
-            }
-            while(!_md_queue.empty())
-            {
-                _md_queue.pop();
-            }
+            _video_queue.clear();
+            _md_queue.clear();
             LOG_DEBUG_V4L("video_md_syncer - flush video and md queues done - mq_q size = " << _md_queue.size() << ", video_q size = " << _video_queue.size());
         }
     }
@@ -40,6 +40,8 @@
 #include <linux/videodev2.h>
 #include <regex>
 #include <list>
+#include <map>
+#include <mutex>
 
 // Metadata streaming nodes are available with kernels 4.16+
 #ifdef V4L2_META_FMT_UVC
@@ -141,9 +143,13 @@ namespace librealsense
 
             bool use_memory_map() const { return _use_memory_map; }
 
+            // DMABUF handle to the buffer (VIDIOC_EXPBUF), or -1 if the driver can't export it
+            int get_dmabuf_fd() const { return _dmabuf_fd; }
+
         private:
             v4l2_buf_type _type;
             uint8_t* _start;
+            int _dmabuf_fd = -1;
             uint32_t _length;
             uint32_t _original_length;
             uint32_t _offset;
@@ -235,6 +241,65 @@ namespace librealsense
             std::array<kernel_buf_guard, e_max_kernel_buf_type> buffers;
         };
 
+        // The file descriptors found readable by one polling cycle, whether by select() or by the epoll reactor.
+        // Unlike fd_set, it is not limited to descriptors below FD_SETSIZE.
+        class ready_fds
+        {
+        public:
+            void set(int fd) { _fds.push_back(fd); }
+            void clear(int fd) { _fds.erase(std::remove(_fds.begin(), _fds.end(), fd), _fds.end()); }
+            bool is_set(int fd) const { return std::find(_fds.begin(), _fds.end(), fd) != _fds.end(); }
+            bool empty() const { return _fds.empty(); }
+
+        private:
+            std::vector<int> _fds;
+        };
+
+        // A single epoll set, shared by all the V4L2 devices in the process and serviced by a small pool of threads,
+        // instead of a select() thread per device (USING_V4L2_EPOLL build option).
+        // Each device registers its video/metadata descriptors along with a handler. The handler of a given
+        // registration is never run concurrently with itself, so it keeps the same single-threaded semantics as
+        // the per-device capture loop. When none of a registration's descriptors became ready for 'timeout', its
+        // handler is called with an empty set.
+        class v4l2_epoll_reactor
+        {
+        public:
+            // Return false to stop receiving events
+            typedef std::function<bool(ready_fds&)> handler;
+
+            v4l2_epoll_reactor();
+            ~v4l2_epoll_reactor();
+
+            int add(const std::vector<int>& fds, handler h, std::chrono::milliseconds timeout);
+            // Blocks until a handler that is already running for the registration returns
+            void remove(int id);
+
+        private:
+            struct registration
+            {
+                std::mutex mutex;
+                std::vector<int> fds;
+                handler h;
+                bool active = true;
+                std::chrono::milliseconds timeout;
+                std::chrono::steady_clock::time_point last_event;
+            };
+
+            void run();
+            void dispatch(int id, const std::shared_ptr<registration>& reg, ready_fds& fds);
+            void check_timeouts();
+            void arm(int id, int fd, int op) const;
+
+            int _epoll_fd = -1;
+            int _wake_fd = -1;
+            std::atomic<bool> _running;
+            std::vector<std::thread> _threads;
+            std::mutex _mutex;
+            std::map<int, std::shared_ptr<registration>> _registrations;
+            int _next_id = 0;
+            std::mutex _timeouts_mutex;
+        };
+
         class v4l_uvc_interface
         {
             virtual void capture_loop() = 0;
@@ -251,7 +316,7 @@ namespace librealsense
             virtual void set_format(stream_profile profile) = 0;
             virtual void prepare_capture_buffers() = 0;
             virtual void stop_data_capture() = 0;
-            virtual void acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds, bool compressed_format) = 0;
+            virtual void acquire_metadata(buffers_mgr & buf_mgr,ready_fds &fds, bool compressed_format) = 0;
         };
 
         class v4l2_video_md_syncer
@@ -261,9 +326,21 @@ namespace librealsense
 
             struct sync_buffer
             {
-                std::shared_ptr<v4l2_buffer> _v4l2_buf;
+                v4l2_buffer _v4l2_buf;
                 int _fd;
                 __u32 _buffer_index;
+                std::chrono::steady_clock::time_point _arrival;
+            };
+
+            // How long the first buffer of each pair waited for the other one
+            struct pairing_stats
+            {
+                uint64_t pairs = 0;
+                double last_ms = 0;
+                double max_ms = 0;
+                double total_ms = 0;
+
+                double average_ms() const { return pairs ? total_ms / pairs : 0; }
             };
 
             // pushing video buffer to the video queue
@@ -274,19 +351,44 @@ namespace librealsense
             // pulling synced data
             // if returned value is true - the data could have been pulled
             // if returned value is false - no data is returned via the inout params because data could not be synced
-            bool pull_video_with_metadata(std::shared_ptr<v4l2_buffer>& video_buffer, std::shared_ptr<v4l2_buffer>& md_buffer, int& video_fd, int& md_fd);
+            bool pull_video_with_metadata(v4l2_buffer& video_buffer, v4l2_buffer& md_buffer, int& video_fd, int& md_fd);
 
-            inline void start() {_is_ready = true;}
+            void start();
             void stop();
 
+            pairing_stats get_pairing_stats() const;
+
         private:
+            // No more than a couple of buffers are ever kept per node, so they're held in place rather than allocated
+            class sync_ring
+            {
+            public:
+                bool empty() const { return _size == 0; }
+                size_t size() const { return _size; }
+                const sync_buffer& front() const { return _items[_begin]; }
+                void push(const sync_buffer& sb)
+                {
+                    assert(_size < _items.size());
+                    _items[(_begin + _size++) % _items.size()] = sb;
+                }
+                void pop() { _begin = (_begin + 1) % _items.size(); --_size; }
+                void clear() { _begin = _size = 0; }
+
+            private:
+                std::array<sync_buffer, 4> _items;
+                size_t _begin = 0;
+                size_t _size = 0;
+            };
+
             void enqueue_buffer_before_throwing_it(const sync_buffer& sb) const;
-            void enqueue_front_buffer_before_throwing_it(std::queue<sync_buffer>& sync_queue);
+            void enqueue_front_buffer_before_throwing_it(sync_ring& sync_queue);
             void flush_queues();
+            void pulled(const sync_buffer& video, const sync_buffer& md);
 
-            std::mutex _syncer_mutex;
-            std::queue<sync_buffer> _video_queue;
-            std::queue<sync_buffer> _md_queue;
+            mutable std::mutex _syncer_mutex;
+            sync_ring _video_queue;
+            sync_ring _md_queue;
+            pairing_stats _stats;
             bool _is_ready;
         };
 
@@ -345,6 +447,8 @@ namespace librealsense
 
             void close(stream_profile) override;
 
+            void set_paired_metadata_capture(bool paired) override { _paired_md_capture = paired; }
+
             std::string fourcc_to_string(uint32_t id) const;
 
             void signal_stop();
@@ -392,12 +496,13 @@ namespace librealsense
             virtual void set_format(stream_profile profile) override;
             virtual void prepare_capture_buffers() override;
             virtual void stop_data_capture() override;
-            virtual void acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds, bool compressed_format = false) override;
+            virtual void acquire_metadata(buffers_mgr & buf_mgr,ready_fds &fds, bool compressed_format = false) override;
             virtual void set_metadata_attributes(buffers_mgr& buf_mgr, __u32 bytesused, uint8_t* md_start);
             void subscribe_to_ctrl_event(uint32_t control_id);
             void unsubscribe_from_ctrl_event(uint32_t control_id);
             bool pend_for_ctrl_status_event();
             void upload_video_and_metadata_from_syncer(buffers_mgr& buf_mgr);
+            void process_ready_fds(ready_fds& fds);
             void populate_imu_data(metadata_hid_raw& meta_data, uint8_t* frame_start, uint8_t& md_size, void** md_start) const;
             // checking if metadata is streamed
             virtual inline bool is_metadata_streamed() const { return false;}
@@ -417,6 +522,8 @@ namespace librealsense
             std::atomic<bool> _is_alive;
             std::atomic<bool> _is_started;
             std::unique_ptr<std::thread> _thread;
+            std::shared_ptr<v4l2_epoll_reactor> _reactor;   // replaces _thread when the shared reactor is used
+            int _reactor_id = -1;
             std::unique_ptr<named_mutex> _named_mtx;
             struct device {
                 enum v4l2_buf_type buf_type;
@@ -431,6 +538,7 @@ namespace librealsense
             int _fd = 0;
             frame_drop_monitor _frame_drop_monitor;           // used to check the frames drops kpi
             v4l2_video_md_syncer _video_md_syncer;
+            bool _paired_md_capture = false;    // dequeue metadata along with its video buffer, see set_paired_metadata_capture()
 
         private:
             int _stop_pipe_fd[2]; // write to _stop_pipe_fd[1] and read from _stop_pipe_fd[0]
@@ -457,7 +565,7 @@ namespace librealsense
             void unmap_device_descriptor();
             void set_format(stream_profile profile);
             void prepare_capture_buffers();
-            virtual void acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds, bool compressed_format=false);
+            virtual void acquire_metadata(buffers_mgr & buf_mgr,ready_fds &fds, bool compressed_format=false);
             // checking if metadata is streamed
             virtual inline bool is_metadata_streamed() const { return _md_fd > 0;}
             virtual inline std::shared_ptr<buffer> get_md_buffer(__u32 index) const {return _md_buffers[index];}
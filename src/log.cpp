@@ -38,6 +38,11 @@ void librealsense::enable_rolling_log_file( unsigned max_size )
     logger.enable_rolling_log_file( max_size );
 }
 
+bool librealsense::is_logging( rs2_log_severity severity )
+{
+    return logger.is_logging( severity );
+}
+
 #else // BUILD_EASYLOGGINGPP
 
 void librealsense::log_to_console(rs2_log_severity min_severity)
@@ -64,5 +69,10 @@ void librealsense::enable_rolling_log_file( unsigned max_size )
 {
     throw std::runtime_error("enable_rolling_log_file is not supported without BUILD_EASYLOGGINGPP");
 }
+
+bool librealsense::is_logging( rs2_log_severity severity )
+{
+    return false;
+}
 #endif // BUILD_EASYLOGGINGPP
 
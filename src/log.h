@@ -3,6 +3,7 @@
 #pragma once
 
 #include "core/enum-helpers.h"
+#include "binary-log.h"
 #include <librealsense2/hpp/rs_types.hpp>
 
 #include <rsutils/string/from.h>
@@ -12,6 +13,8 @@
 #include <stdexcept>
 #include <mutex>
 #include <fstream>
+#include <atomic>
+#include <algorithm>
 
 
 namespace librealsense
@@ -22,6 +25,10 @@ namespace librealsense
     void reset_logger();
     void enable_rolling_log_file( unsigned max_size );
 
+    // Whether messages of 'severity' go anywhere: to the console, a file or a callback. Cheap, for whoever would
+    // rather not build the messages that wouldn't.
+    bool is_logging( rs2_log_severity severity );
+
 #if BUILD_EASYLOGGINGPP
     struct log_message
     {
@@ -66,7 +73,16 @@ namespace librealsense
         std::string filename;
         const std::string log_id = NAME;
 
+        // The least of the minimum severities, for is_logging()
+        std::atomic< int > least_severity{ RS2_LOG_SEVERITY_NONE };
+        void update_least_severity()
+        {
+            least_severity = std::min( { minimum_log_severity, minimum_console_severity, minimum_file_severity } );
+        }
+
     public:
+        bool is_logging( rs2_log_severity severity ) const { return severity >= least_severity; }
+
         static el::Level severity_to_level(rs2_log_severity severity)
         {
             switch (severity)
@@ -190,6 +206,7 @@ namespace librealsense
             if( min_severity != RS2_LOG_SEVERITY_NONE )
                 rsutils::os::ensure_console( false );  // don't create if none available
             minimum_console_severity = min_severity;
+            update_least_severity();
             open();
         }
 
@@ -201,6 +218,7 @@ namespace librealsense
             if (file_path)
                 filename = file_path;
 
+            update_least_severity();
             open();
         }
 
@@ -255,6 +273,10 @@ namespace librealsense
                 auto dispatcher = el::Helpers::logDispatchCallback< elpp_dispatcher >( dispatch_name );
                 dispatcher->callback = callback;
                 dispatcher->min_severity = min_severity;
+
+                // The callbacks get all the messages, and filter them themselves
+                minimum_log_severity = std::min( minimum_log_severity, min_severity );
+                update_least_severity();
                 
                 // Remove the default logger (which will log to standard out/err) or it'll still be active
                 //el::Helpers::uninstallLogDispatchCallback< el::base::DefaultLogDispatchCallback >( "DefaultLogDispatchCallback" );
@@ -272,6 +294,7 @@ namespace librealsense
             minimum_log_severity = RS2_LOG_SEVERITY_NONE;
             minimum_console_severity = RS2_LOG_SEVERITY_NONE;
             minimum_file_severity = RS2_LOG_SEVERITY_NONE;
+            update_least_severity();
         }
 
         // Callback: called by EL++ when the current log file has reached a certain maximum size.
@@ -336,3 +359,25 @@ namespace librealsense
     };
 #endif //BUILD_EASYLOGGINGPP
 }
+
+
+// Like LOG_DEBUG and the likes, but with a format and its arguments, e.g.:
+//     LOG_DEBUG_FMT( "frame {} from {} dropped", number, stream );
+// Into the binary log when there is one (see binary-log.h), where the message costs only its arguments' copy;
+// otherwise formatted for the other logs, if anything logs it.
+#define LOG_FMT_( SEVERITY, LOG, ... )                                                                                 \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if( librealsense::binary_log::is_logging( SEVERITY ) )                                                         \
+        {                                                                                                              \
+            static librealsense::binary_log::site _log_site( SEVERITY, __FILE__, __LINE__ );                           \
+            librealsense::binary_log::write( _log_site, __VA_ARGS__ );                                                 \
+        }                                                                                                              \
+        else if( librealsense::is_logging( SEVERITY ) )                                                                \
+            LOG( librealsense::binary_log::format( __VA_ARGS__ ) );                                                    \
+    }                                                                                                                  \
+    while( false )
+#define LOG_DEBUG_FMT( ... ) LOG_FMT_( RS2_LOG_SEVERITY_DEBUG, LOG_DEBUG, __VA_ARGS__ )
+#define LOG_INFO_FMT( ... ) LOG_FMT_( RS2_LOG_SEVERITY_INFO, LOG_INFO, __VA_ARGS__ )
+#define LOG_WARNING_FMT( ... ) LOG_FMT_( RS2_LOG_SEVERITY_WARN, LOG_WARNING, __VA_ARGS__ )
+#define LOG_ERROR_FMT( ... ) LOG_FMT_( RS2_LOG_SEVERITY_ERROR, LOG_ERROR, __VA_ARGS__ )
@@ -0,0 +1,81 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "low-latency.h"
+
+#include <rsutils/easylogging/easyloggingpp.h>
+#include <rsutils/json.h>
+#include <rsutils/os/thread.h>
+
+#include <mutex>
+
+
+namespace librealsense {
+
+
+namespace {
+
+
+std::mutex & settings_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+
+low_latency_settings & shared_settings()
+{
+    static low_latency_settings settings;
+    return settings;
+}
+
+
+}  // namespace
+
+
+/*static*/ low_latency_settings low_latency_settings::get()
+{
+    std::lock_guard< std::mutex > lock( settings_mutex() );
+    return shared_settings();
+}
+
+
+/*static*/ void low_latency_settings::configure( rsutils::json const & j )
+{
+    low_latency_settings settings;
+    if( j.is_boolean() )
+        settings.enabled = j.get< bool >();
+    else
+    {
+        settings.enabled = j.nested( "enabled" ).default_value( true );
+        settings.cpu = j.nested( "cpu" ).default_value( settings.cpu );
+        settings.busy_poll = std::chrono::microseconds(
+            j.nested( "busy-poll-us" ).default_value< long long >( settings.busy_poll.count() ) );
+    }
+    if( settings.enabled )
+        LOG_INFO( "low-latency mode: cpu " << settings.cpu << ", busy-polling " << settings.busy_poll.count()
+                                           << " usec" );
+
+    std::lock_guard< std::mutex > lock( settings_mutex() );
+    shared_settings() = settings;
+}
+
+
+void low_latency_settings::apply_to_delivery_thread() const
+{
+    static thread_local bool applied = false;
+    if( applied )
+        return;
+    applied = true;
+
+    // On top of whatever the "capture" thread role has
+    auto settings = rsutils::os::get_thread_settings( "capture" );
+    if( cpu >= 0 )
+        settings.cpus = { cpu };
+    if( ! settings.realtime_priority )
+        settings.priority = 1;
+    rsutils::os::apply_thread_settings( settings );
+}
+
+
+}  // namespace librealsense
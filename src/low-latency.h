@@ -0,0 +1,33 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <rsutils/json-fwd.h>
+
+#include <chrono>
+
+
+namespace librealsense {
+
+
+// The "low-latency" mode, from the context settings:
+//     "low-latency": { "cpu": 2, "busy-poll-us": 200 }    (or just true, for the defaults)
+// While it's on, the threads delivering frames from the backend are pinned to 'cpu' (when given) at a raised
+// priority, and frame queues created meanwhile spin for up to 'busy-poll-us' waiting for a frame before sleeping.
+//
+struct low_latency_settings
+{
+    bool enabled = false;
+    int cpu = -1;
+    std::chrono::microseconds busy_poll{ 200 };
+
+    // Process-wide: set by the last context whose settings had "low-latency"
+    static low_latency_settings get();
+    static void configure( rsutils::json const & settings );
+
+    // Pin the calling thread and raise its priority, once per thread
+    void apply_to_delivery_thread() const;
+};
+
+
+}  // namespace librealsense
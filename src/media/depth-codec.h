@@ -0,0 +1,55 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "proc/processing-thread-pool.h"
+#include <rsutils/depth-codec.h>
+
+
+namespace librealsense {
+
+
+// The lossless depth codec (see rsutils/depth-codec.h), with its bands spread over the processing pool when given one
+namespace depth_codec {
+
+
+inline rsutils::depth_codec::for_each_band_fn on( processing_thread_pool * pool )
+{
+    if( ! pool )
+        return nullptr;
+    return [pool]( size_t n, std::function< void( size_t ) > const & fn )
+    {
+        pool->parallel_for( n,
+                            int( pool->size() + 1 ),
+                            [&]( size_t begin, size_t end )
+                            {
+                                for( auto i = begin; i < end; ++i )
+                                    fn( i );
+                            } );
+    };
+}
+
+
+inline void encode( uint16_t const * pixels, size_t count, std::vector< uint8_t > & out,
+                    processing_thread_pool * pool = nullptr )
+{
+    rsutils::depth_codec::encode( pixels, count, out, on( pool ) );
+}
+
+
+inline size_t decoded_count( uint8_t const * data, size_t size )
+{
+    return rsutils::depth_codec::decoded_count( data, size );
+}
+
+
+inline bool decode( uint8_t const * data, size_t size, uint16_t * pixels, size_t count,
+                    processing_thread_pool * pool = nullptr )
+{
+    return rsutils::depth_codec::decode( data, size, pixels, count, on( pool ) );
+}
+
+
+}  // namespace depth_codec
+}  // namespace librealsense
@@ -12,24 +12,32 @@ namespace librealsense {
 class playback_device_info : public device_info
 {
     std::string const _filename;
+    uint32_t const _device_index;  // Of the device in the file, for files recorded from several
 
 public:
-    explicit playback_device_info( std::shared_ptr< context > const & ctx, std::string const & filename )
+    explicit playback_device_info( std::shared_ptr< context > const & ctx,
+                                   std::string const & filename,
+                                   uint32_t device_index = 0 )
         : device_info( ctx )
         , _filename( filename )
+        , _device_index( device_index )
     {
     }
 
     std::string const & get_filename() const { return _filename; }
+    uint32_t get_device_index() const { return _device_index; }
 
-    std::string get_address() const override { return "file://" + _filename; }
+    std::string get_address() const override
+    {
+        return "file://" + _filename + ( _device_index ? "#" + std::to_string( _device_index ) : std::string() );
+    }
 
     std::shared_ptr< device_interface > create_device() override;
 
     bool is_same_as( std::shared_ptr< const device_info > const & other ) const override
     {
         if( auto rhs = std::dynamic_pointer_cast< const playback_device_info >( other ) )
-            return _filename == rhs->_filename;
+            return _filename == rhs->_filename && _device_index == rhs->_device_index;
         return false;
     }
 };
@@ -27,20 +27,32 @@ std::shared_ptr< device_interface > playback_device_info::create_device()
 {
     auto playback_dev
         = std::make_shared< playback_device >( shared_from_this(),
-                                               std::make_shared< ros_reader >( _filename, get_context() ) );
+                                               std::make_shared< ros_reader >( _filename, get_context(), _device_index ),
+                                               _device_index );
     return playback_dev;
 }
 
 playback_device::playback_device( std::shared_ptr< const device_info > const & dev_info,
-                                  std::shared_ptr< device_serializer::reader > const & serializer )
+                                  std::shared_ptr< device_serializer::reader > const & serializer,
+                                  uint32_t device_index )
     : m_read_thread( []() { return std::make_shared< dispatcher >( std::numeric_limits< unsigned int >::max() ); } )
     , m_device_info( dev_info )
+    , m_device_index( device_index )
     , m_is_started( false )
     , m_is_paused( false )
     , m_sample_rate( 1 )
     , m_real_time( true )
     , m_prev_timestamp( 0 )
     , m_last_published_timestamp( 0 )
+    , m_max_frames_in_flight( 0 )
+    , m_frames_in_flight( std::make_shared< frames_in_flight >() )
+    , m_delivery_thread( []() {
+        auto d = std::make_shared< dispatcher >( std::numeric_limits< unsigned int >::max() );
+        d->start();
+        return d;
+    } )
+    , m_range_start( 0 )
+    , m_range_end( 0 )
 {
     if (serializer == nullptr)
     {
@@ -72,7 +84,7 @@ std::map<uint32_t, std::shared_ptr<playback_sensor>> playback_device::create_pla
     for (auto sensor_snapshot : device_description.get_sensors_snapshots())
     {
         //Each sensor will know its capabilities from the sensor_snapshot
-        auto sensor = std::make_shared<playback_sensor>(*this, sensor_snapshot);
+        auto sensor = std::make_shared<playback_sensor>(*this, sensor_snapshot, m_device_index);
 
         sensor->on_started( [this](uint32_t id, rs2_frame_callback_sptr user_callback) -> void
         {
@@ -196,6 +208,8 @@ playback_device::~playback_device()
     }
 
     (*m_read_thread)->stop();
+    if( m_delivery_thread.is_initialized() )
+        ( *m_delivery_thread )->stop();
 }
 
 std::shared_ptr<context> playback_device::get_context() const
@@ -303,7 +317,7 @@ void playback_device::seek_to_time(std::chrono::nanoseconds time)
                     }
                     //push frame to the sensor (see handle_frame definition for more details)
                     m_sensors.at(frame->stream_id.sensor_index)->handle_frame(std::move(frame->frame), m_real_time,
-                        []() { return device_serializer::nanoseconds(0); },
+                        []( dispatcher::cancellable_timer ) {},
                         []() { return false; },
                         [this, time]()
                         {
@@ -354,6 +368,8 @@ void playback_device::pause()
         if(m_is_started)
         {
             //Wait for any remaining sensor callbacks to return
+            if (m_delivery_thread.is_initialized())
+                (*m_delivery_thread)->flush();
             for (auto sensor : m_sensors)
             {
                 sensor.second->flush_pending_frames();
@@ -379,9 +395,9 @@ void playback_device::resume()
         if (m_is_paused == false)
             return;
 
-        auto total_duration = m_reader->query_duration();
-        if (m_last_published_timestamp >= total_duration)
-            m_last_published_timestamp = device_serializer::nanoseconds(0);
+        auto end = m_range_end.count() ? m_range_end : m_reader->query_duration();
+        if (m_last_published_timestamp >= end || m_last_published_timestamp < m_range_start)
+            m_last_published_timestamp = m_range_start;
         m_reader->reset();
         m_reader->seek_to_time(m_last_published_timestamp);
         while (m_last_published_timestamp != device_serializer::nanoseconds(0) && !m_reader->read_next_data()->is<serialized_frame>());
@@ -410,6 +426,87 @@ bool playback_device::is_real_time() const
     return m_real_time;
 }
 
+void playback_device::set_offline(int max_frames_in_flight)
+{
+    LOG_INFO("Set offline playback with " << max_frames_in_flight << " frames in flight");
+    (*m_read_thread)->invoke([this, max_frames_in_flight](dispatcher::cancellable_timer t)
+    {
+        // Whatever was on its way out with the previous setting goes first
+        if (m_delivery_thread.is_initialized())
+            (*m_delivery_thread)->flush();
+        m_max_frames_in_flight = max_frames_in_flight;
+        if (max_frames_in_flight)
+            m_real_time = false;
+    });
+    if ((*m_read_thread)->flush() == false)
+    {
+        LOG_ERROR("Error - timeout waiting for set_offline, possible deadlock detected");
+        assert(0); //Detect this immediately in debug
+    }
+}
+
+void playback_device::set_range(device_serializer::nanoseconds start, device_serializer::nanoseconds end)
+{
+    LOG_INFO("Set playback range to [" << start.count() << ", " << end.count() << ")");
+    (*m_read_thread)->invoke([this, start, end](dispatcher::cancellable_timer t)
+    {
+        m_range_start = start;
+        m_range_end = end;
+    });
+    if ((*m_read_thread)->flush() == false)
+    {
+        LOG_ERROR("Error - timeout waiting for set_range, possible deadlock detected");
+        assert(0); //Detect this immediately in debug
+    }
+}
+
+void playback_device::wait_for_frames_in_flight()
+{
+    // A consumer that holds on to more frames than allowed would stall playback for good, so we only wait so long
+    auto & in_flight = *m_frames_in_flight;
+    std::unique_lock< std::mutex > lock( in_flight.mutex );
+    if( ! in_flight.cv.wait_for( lock, std::chrono::seconds( 5 ),
+                                 [&]() { return in_flight.count < m_max_frames_in_flight; } ) )
+        LOG_WARNING( "Offline playback: " << in_flight.count << " frames still not released after 5s; going on" );
+}
+
+void playback_device::track_frame_in_flight(frame_holder& frame)
+{
+    auto in_flight = m_frames_in_flight;
+    {
+        std::lock_guard< std::mutex > lock( in_flight->mutex );
+        ++in_flight->count;
+    }
+    frame->attach_continuation( frame_continuation(
+        [in_flight]()
+        {
+            {
+                std::lock_guard< std::mutex > lock( in_flight->mutex );
+                --in_flight->count;
+            }
+            in_flight->cv.notify_all();
+        },
+        nullptr ) );
+}
+
+void playback_device::deliver_frame(std::shared_ptr<playback_sensor> const& sensor, frame_holder&& frame,
+                                    device_serializer::nanoseconds timestamp)
+{
+    track_frame_in_flight(frame);
+    auto pf = std::make_shared< frame_holder >( std::move( frame ) );
+    (*m_delivery_thread)->invoke( [this, sensor, pf, timestamp]( dispatcher::cancellable_timer t )
+    {
+        if( m_is_paused )
+            return;
+        sensor->deliver_frame( std::move( *pf ),
+                               [this, timestamp]()
+                               {
+                                   std::lock_guard< std::mutex > locker( m_last_published_timestamp_mutex );
+                                   m_last_published_timestamp = timestamp;
+                               } );
+    } );
+}
+
 std::shared_ptr< const device_info > playback_device::get_device_info() const
 {
     return m_device_info;
@@ -427,7 +524,7 @@ bool playback_device::is_valid() const
 
 void playback_device::update_time_base(device_serializer::nanoseconds base_timestamp)
 {
-    m_base_sys_time = std::chrono::high_resolution_clock::now();
+    m_base_sys_time = std::chrono::steady_clock::now();
     m_base_timestamp = base_timestamp;
     LOG_DEBUG("Updating Time Base... m_base_sys_time " << m_base_sys_time.time_since_epoch().count() << " m_base_timestamp " << m_base_timestamp.count());
 }
@@ -438,9 +535,20 @@ device_serializer::nanoseconds playback_device::calc_sleep_time(device_serialize
         return device_serializer::nanoseconds(0);
     //The time to sleep returned here equals to the difference between the file recording time
     // and the playback time.
-    auto now = std::chrono::high_resolution_clock::now();
-    auto play_time = now - m_base_sys_time;
+    auto due = calc_frame_time(timestamp);
+    auto now = std::chrono::steady_clock::now();
+    if(due <= now)
+    {
+        LOG_DEBUG("Recorded Time < Playing Time  (not sleeping)");
+        return device_serializer::nanoseconds(0);
+    }
+    auto sleep_time = std::chrono::duration_cast<device_serializer::nanoseconds>(due - now);
+    LOG_DEBUG("Sleep Time: " << sleep_time.count() << " == " << (sleep_time.count() * 1e-6) << " ms");
+    return sleep_time;
+}
 
+std::chrono::steady_clock::time_point playback_device::calc_frame_time(device_serializer::nanoseconds timestamp)
+{
     //Sometimes the first stream skip the first frame on the ros reader
     //and the second stream go back to the first frame so its timestamp is smaller then the base timestamp
     //in this case we need to restart the m_base_timestamp again
@@ -450,19 +558,55 @@ device_serializer::nanoseconds playback_device::calc_sleep_time(device_serialize
     }
     auto time_diff = timestamp - m_base_timestamp;
     auto recorded_time = std::chrono::duration_cast<device_serializer::nanoseconds>(time_diff / m_sample_rate.load());
-
-    LOG_DEBUG("Time Now  : " << now.time_since_epoch().count() << " ,    Time When Started: " << m_base_sys_time.time_since_epoch().count() << " , Diff: " << play_time.count() << " == " << (play_time.count() * 1e-6) << "ms");
-    LOG_DEBUG("Original Recording Delta: " << time_diff.count() << " == " << (time_diff.count() * 1e-6) << "ms");
     LOG_DEBUG("Frame Time: " << timestamp.count() << "  , First Frame: " << m_base_timestamp.count() << " ,  Diff: " << recorded_time.count() << " == " << (recorded_time.count() * 1e-6) << "ms");
+    return m_base_sys_time + recorded_time;
+}
 
-    if(recorded_time < play_time)
+void playback_device::wait_for_frame_time(dispatcher::cancellable_timer t, device_serializer::nanoseconds timestamp)
+{
+    if (!m_real_time || m_sample_rate <= 0)
+        return;
+
+    // The dispatcher's sleep can wake up a millisecond or more past what it's asked for, so it's only asked to get
+    // within spin_margin of the frame's time, and the rest is spun for
+    const auto spin_margin = std::chrono::milliseconds(2);
+    auto due = calc_frame_time(timestamp);
+    auto now = std::chrono::steady_clock::now();
+    if (due - now > spin_margin && !t.try_sleep(due - now - spin_margin))
+        return;
+    while ((now = std::chrono::steady_clock::now()) < due)
     {
-        LOG_DEBUG("Recorded Time < Playing Time  (not sleeping)");
-        return device_serializer::nanoseconds(0);
+        if (t.was_stopped())
+            return;
+        std::this_thread::yield();
     }
-    auto sleep_time = (recorded_time - play_time);
-    LOG_DEBUG("Sleep Time: " << sleep_time.count() << " == " << (sleep_time.count() * 1e-6) << " ms");
-    return sleep_time;
+
+    const double late_ns = double(std::chrono::duration_cast<device_serializer::nanoseconds>(now - due).count());
+    std::lock_guard<std::mutex> lock(m_timing_mutex);
+    ++m_timing_frames;
+    m_timing_total_late_ns += late_ns;
+    m_timing_max_late_ns = std::max(m_timing_max_late_ns, late_ns);
+    if (late_ns > 1e6)
+        ++m_timing_late_over_1ms;
+}
+
+playback_device::timing_stats playback_device::get_timing_stats() const
+{
+    std::lock_guard<std::mutex> lock(m_timing_mutex);
+    timing_stats stats;
+    stats.frames = m_timing_frames;
+    stats.mean_late_us = m_timing_frames ? m_timing_total_late_ns / m_timing_frames * 1e-3 : 0;
+    stats.max_late_us = m_timing_max_late_ns * 1e-3;
+    stats.frames_late_over_1ms = m_timing_late_over_1ms;
+    return stats;
+}
+
+void playback_device::log_timing_stats() const
+{
+    auto stats = get_timing_stats();
+    if (stats.frames)
+        LOG_INFO("Playback timing: " << stats.frames << " frames, " << stats.mean_late_us << " us late on average, "
+                 << stats.max_late_us << " us at most, " << stats.frames_late_over_1ms << " over 1 ms");
 }
 
 void playback_device::start()
@@ -481,6 +625,19 @@ void playback_device::start()
 
     m_is_started = true;
     catch_up();
+    {
+        std::lock_guard<std::mutex> lock(m_timing_mutex);
+        m_timing_frames = m_timing_late_over_1ms = 0;
+        m_timing_total_late_ns = m_timing_max_late_ns = 0;
+    }
+    if (m_range_start.count())
+    {
+        (*m_read_thread)->invoke([this](dispatcher::cancellable_timer t)
+        {
+            m_reader->seek_to_time(m_range_start);
+            m_prev_timestamp = m_range_start;
+        });
+    }
     try_looping();
     LOG_INFO("Playback started");
 }
@@ -512,6 +669,7 @@ void playback_device::stop_internal()
 
     m_is_started = false;
     m_is_paused = false;
+    log_timing_stats();
 
     m_reader->reset();
     m_prev_timestamp = std::chrono::nanoseconds(0);
@@ -551,6 +709,8 @@ void playback_device::do_loop(T action)
                 for (auto s : m_active_sensors)
                     playback_sensors_copy.push_back( s.second );
             }
+            if( m_delivery_thread.is_initialized() )
+                ( *m_delivery_thread )->flush();
             for( auto & psc : playback_sensors_copy )
             {
                 if( psc )
@@ -604,6 +764,9 @@ void playback_device::try_looping()
     {
         LOG_DEBUG("Read action invoked");
 
+        if (m_max_frames_in_flight)
+            wait_for_frames_in_flight();
+
         //Read next data from the serializer, on success: 'obj' will be a valid object that came from
         // sensor number 'sensor_index' with a timestamp equal to 'timestamp'
         std::shared_ptr<serialized_data> data = m_reader->read_next_data();
@@ -614,6 +777,11 @@ void playback_device::try_looping()
         }
 
         auto timestamp = data->get_timestamp();
+        if (m_range_end.count() && timestamp >= m_range_end && data->is<serialized_frame>())
+        {
+            LOG_INFO("End of playback range reached");
+            return false;
+        }
         m_prev_timestamp = timestamp;
         //Objects with timestamp of 0 are non streams.
         if (m_base_timestamp.count() == 0)
@@ -666,12 +834,18 @@ void playback_device::try_looping()
                 }
 
 
+                if( m_max_frames_in_flight )
+                {
+                    deliver_frame( it->second, std::move( frame->frame ), timestamp );
+                    return true;
+                }
+
                 // Dispatch frame to the relevant sensor (see handle_frame definition for more
                 // details)
                 it->second->handle_frame(
                     std::move( frame->frame ),
                     m_real_time,
-                    [this, timestamp]() { return calc_sleep_time( timestamp ); },
+                    [this, timestamp]( dispatcher::cancellable_timer t ) { wait_for_frame_time( t, timestamp ); },
                     [this]() { return m_is_paused == true; },
                     [this, timestamp]() {
                         std::lock_guard< std::mutex > locker( m_last_published_timestamp_mutex );
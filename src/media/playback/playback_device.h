@@ -3,6 +3,7 @@
 
 #pragma once
 #include <atomic>
+#include <condition_variable>
 #include "../../core/roi.h"
 #include "../../core/extension.h"
 #include "../../core/serialization.h"
@@ -22,8 +23,11 @@ namespace librealsense
         public info_container
     {
     public:
+        // The reader plays the device of the given index in the file
         playback_device( std::shared_ptr< const device_info > const &,
-                         std::shared_ptr< device_serializer::reader > const & serializer );
+                         std::shared_ptr< device_serializer::reader > const & serializer,
+                         uint32_t device_index = 0 );
+        uint32_t get_device_index() const { return m_device_index; }
         virtual ~playback_device();
 
         std::shared_ptr<context> get_context() const override;
@@ -44,8 +48,20 @@ namespace librealsense
         void stop();
         void set_real_time(bool real_time);
         bool is_real_time() const;
+        void set_offline(int max_frames_in_flight);
+        void set_range(device_serializer::nanoseconds start, device_serializer::nanoseconds end);
         const std::string& get_file_name() const;
         uint64_t get_position() const;
+
+        // How late the frames were handed to their sensors' callbacks, in real time, since playback started
+        struct timing_stats
+        {
+            uint64_t frames = 0;
+            double mean_late_us = 0;
+            double max_late_us = 0;
+            uint64_t frames_late_over_1ms = 0;
+        };
+        timing_stats get_timing_stats() const;
         rsutils::public_signal< playback_device, rs2_playback_status > playback_status_changed;
         std::shared_ptr< const device_info > get_device_info() const override;
         std::pair<uint32_t, rs2_extrinsics> get_extrinsics(const stream_interface& stream) const override;
@@ -65,6 +81,11 @@ namespace librealsense
     private:
         void update_time_base(device_serializer::nanoseconds base_timestamp);
         device_serializer::nanoseconds calc_sleep_time(device_serializer::nanoseconds  timestamp);
+        // When the frame of a timestamp is due, on the timeline all the streams share
+        std::chrono::steady_clock::time_point calc_frame_time(device_serializer::nanoseconds timestamp);
+        // Sleeps until close to the frame's time, then spins for the rest of it, and records how late it ends
+        void wait_for_frame_time(dispatcher::cancellable_timer t, device_serializer::nanoseconds timestamp);
+        void log_timing_stats() const;
         void start();
         void stop_internal();
         void try_looping();
@@ -77,15 +98,19 @@ namespace librealsense
         void register_extrinsics(const device_serializer::device_snapshot& device_description);
         void update_extensions(const device_serializer::device_snapshot& device_description);
         bool prefetch_done();
+        void wait_for_frames_in_flight();
+        void track_frame_in_flight(frame_holder& frame);
+        void deliver_frame(std::shared_ptr<playback_sensor> const& sensor, frame_holder&& frame, device_serializer::nanoseconds timestamp);
 
     private:
         rsutils::lazy< std::shared_ptr< dispatcher > > m_read_thread;
         std::shared_ptr< const device_info > m_device_info;
         std::shared_ptr<device_serializer::reader> m_reader;
         device_serializer::device_snapshot m_device_description;
+        uint32_t m_device_index;
         std::atomic_bool m_is_started;
         std::atomic_bool m_is_paused;
-        std::chrono::high_resolution_clock::time_point m_base_sys_time; // !< System time when reading began (first frame was read)
+        std::chrono::steady_clock::time_point m_base_sys_time; // !< System time when reading began (first frame was read)
         device_serializer::nanoseconds m_base_timestamp; // !< Timestamp of the first frame that has a real timestamp (different than 0)
         std::map<uint32_t, std::shared_ptr<playback_sensor>> m_sensors;
         std::map<uint32_t, std::shared_ptr<playback_sensor>> m_active_sensors;
@@ -97,6 +122,25 @@ namespace librealsense
         device_serializer::nanoseconds m_last_published_timestamp;
         std::mutex m_last_published_timestamp_mutex;
         std::mutex _active_sensors_mutex;
+
+        // Offline playback: frames go out in order from the delivery thread, reading held back by those not released
+        struct frames_in_flight
+        {
+            std::mutex mutex;
+            std::condition_variable cv;
+            int count = 0;
+        };
+        std::atomic<int> m_max_frames_in_flight;  // 0 when not offline
+        std::shared_ptr<frames_in_flight> m_frames_in_flight;
+        rsutils::lazy< std::shared_ptr< dispatcher > > m_delivery_thread;
+        device_serializer::nanoseconds m_range_start;
+        device_serializer::nanoseconds m_range_end;  // 0 for the end of the file
+
+        mutable std::mutex m_timing_mutex;  // The sensors' dispatchers all record to it
+        uint64_t m_timing_frames = 0;
+        double m_timing_total_late_ns = 0;
+        double m_timing_max_late_ns = 0;
+        uint64_t m_timing_late_over_1ms = 0;
     };
 
     MAP_EXTENSION(RS2_EXTENSION_PLAYBACK, playback_device);
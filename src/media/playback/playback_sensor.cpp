@@ -28,10 +28,12 @@ std::string profile_to_string(std::shared_ptr<stream_profile_interface> s)
     return os.str();
 }
 
-playback_sensor::playback_sensor(device_interface& parent_device, const device_serializer::sensor_snapshot& sensor_description):
+playback_sensor::playback_sensor(device_interface& parent_device, const device_serializer::sensor_snapshot& sensor_description,
+                                 uint32_t device_index):
     m_is_started(false),
     m_sensor_description(sensor_description),
     m_sensor_id(sensor_description.get_sensor_index()),
+    m_device_index(device_index),
     m_parent_device(parent_device),
     _default_queue_size(1)
 {
@@ -28,7 +28,9 @@ namespace librealsense
     public:
         using frame_interface_callback_t = std::function<void(frame_holder)>;
 
-        playback_sensor(device_interface& parent_device, const device_serializer::sensor_snapshot& sensor_description);
+        playback_sensor(device_interface& parent_device, const device_serializer::sensor_snapshot& sensor_description,
+                        uint32_t device_index = 0);
+        uint32_t get_device_index() const { return m_device_index; }  // In the file
         virtual ~playback_sensor();
 
         void on_started( std::function< void( uint32_t id, rs2_frame_callback_sptr user_callback ) > && callback )
@@ -99,6 +101,7 @@ namespace librealsense
         std::atomic<bool> m_is_started;
         device_serializer::sensor_snapshot m_sensor_description;
         uint32_t m_sensor_id;
+        uint32_t m_device_index;
         std::mutex m_mutex;
         std::map<std::pair<rs2_stream, uint32_t>, std::shared_ptr<stream_profile_interface>> m_streams;
         device_interface& m_parent_device;
@@ -109,13 +112,13 @@ namespace librealsense
 
     public:
         //handle frame use 3 lambda functions that determines if and when a frame should be published.
-        //calc_sleep - calculates the duration that the sensor should wait before publishing the frame,
-        // the start point for this calculation is the last playback resume.
+        //wait_for_frame - waits, on the sensor's dispatcher, until the frame should be published (it's given the
+        // dispatcher's cancellable_timer so a stop cuts it short); the time is relative to the last playback resume.
         //is_paused - check if the playback was paused while waiting for the frame publish time.
         //update_last_pushed_frame - lets the playback device know that a specific frame was published,
         // the playback device will use this info to determine which frames should be played next in a pause/resume scenario.
         template <class T, class K, class P>
-        void handle_frame(frame_holder frame, bool is_real_time, T calc_sleep, K is_paused, P update_last_pushed_frame)
+        void handle_frame(frame_holder frame, bool is_real_time, T wait_for_frame, K is_paused, P update_last_pushed_frame)
         {
             if (frame == nullptr)
             {
@@ -123,20 +126,14 @@ namespace librealsense
             }
             if (m_is_started)
             {
-                frame->get_owner()->set_sensor(shared_from_this());
-                auto type = frame->get_stream()->get_stream_type();
-                auto index = static_cast<uint32_t>(frame->get_stream()->get_stream_index());
-                frame->set_stream(m_streams[std::make_pair(type, index)]);
-                frame->set_sensor(shared_from_this());
+                assign_frame_stream(frame);
                 auto stream_id = frame.frame->get_stream()->get_unique_id();
                 //TODO: Ziv, remove usage of shared_ptr when frame_holder is cpoyable
                 auto pf = std::make_shared<frame_holder>(std::move(frame));
 
-                auto callback = [this, is_real_time, stream_id, pf, calc_sleep, is_paused, update_last_pushed_frame](dispatcher::cancellable_timer t)
+                auto callback = [this, is_real_time, stream_id, pf, wait_for_frame, is_paused, update_last_pushed_frame](dispatcher::cancellable_timer t)
                 {                  
-                    device_serializer::nanoseconds sleep_for = calc_sleep();
-                    if (sleep_for.count() > 0)
-                        t.try_sleep( sleep_for );
+                    wait_for_frame( t );
 
                     LOG_DEBUG("callback--> "<< *pf);
 
@@ -168,5 +165,38 @@ namespace librealsense
                     m_dispatchers.at( stream_id )->flush();
             }
         }
+
+        //deliver_frame hands the frame to the user right away, on the calling thread, for offline playback where
+        // the playback device takes care of the order and pace of the frames itself.
+        template <class P>
+        void deliver_frame(frame_holder frame, P update_last_pushed_frame)
+        {
+            if (frame == nullptr)
+            {
+                throw invalid_value_exception("null frame passed to deliver_frame");
+            }
+            if (!m_is_started || !is_streaming())
+                return;
+
+            assign_frame_stream(frame);
+            auto user_callback = m_user_callback;
+            if (user_callback)
+            {
+                frame_interface* pframe = nullptr;
+                std::swap(frame.frame, pframe);  // the callback owns it now
+                user_callback->on_frame((rs2_frame*)pframe);
+            }
+            update_last_pushed_frame();
+        }
+
+    private:
+        void assign_frame_stream(frame_holder& frame)
+        {
+            frame->get_owner()->set_sensor(shared_from_this());
+            auto type = frame->get_stream()->get_stream_type();
+            auto index = static_cast<uint32_t>(frame->get_stream()->get_stream_index());
+            frame->set_stream(m_streams[std::make_pair(type, index)]);
+            frame->set_sensor(shared_from_this());
+        }
     };
 }
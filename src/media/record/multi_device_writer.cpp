@@ -0,0 +1,92 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "multi_device_writer.h"
+
+using namespace librealsense;
+
+class multi_device_writer::device_writer : public device_serializer::writer
+{
+    std::shared_ptr< multi_device_writer > _owner;
+    uint32_t const _index;
+
+    device_serializer::writer & file() { return *_owner->_writer; }
+
+public:
+    device_writer( std::shared_ptr< multi_device_writer > const & owner, uint32_t index )
+        : _owner( owner )
+        , _index( index )
+    {
+    }
+
+    void write_device_description( const device_serializer::device_snapshot & device_description ) override
+    {
+        std::lock_guard< std::mutex > lock( _owner->_mutex );
+        _owner->_writer->write_device_description( device_description, _index );
+    }
+
+    void write_frame( const device_serializer::stream_identifier & stream_id,
+                      const device_serializer::nanoseconds & timestamp,
+                      frame_holder && frame ) override
+    {
+        auto id = stream_id;
+        id.device_index = _index;
+        std::lock_guard< std::mutex > lock( _owner->_mutex );
+        file().write_frame( id, timestamp, std::move( frame ) );
+    }
+
+    void write_snapshot( uint32_t,
+                         const device_serializer::nanoseconds & timestamp,
+                         rs2_extension type,
+                         const std::shared_ptr< extension_snapshot > & snapshot ) override
+    {
+        std::lock_guard< std::mutex > lock( _owner->_mutex );
+        file().write_snapshot( _index, timestamp, type, snapshot );
+    }
+
+    void write_snapshot( const device_serializer::sensor_identifier & sensor_id,
+                         const device_serializer::nanoseconds & timestamp,
+                         rs2_extension type,
+                         const std::shared_ptr< extension_snapshot > & snapshot ) override
+    {
+        std::lock_guard< std::mutex > lock( _owner->_mutex );
+        file().write_snapshot( { _index, sensor_id.sensor_index }, timestamp, type, snapshot );
+    }
+
+    void write_notification( const device_serializer::sensor_identifier & sensor_id,
+                             const device_serializer::nanoseconds & timestamp,
+                             const notification & n ) override
+    {
+        std::lock_guard< std::mutex > lock( _owner->_mutex );
+        file().write_notification( { _index, sensor_id.sensor_index }, timestamp, n );
+    }
+
+    const std::string & get_file_name() const override { return _owner->_writer->get_file_name(); }
+};
+
+
+multi_device_writer::multi_device_writer( std::shared_ptr< ros_writer > const & writer )
+    : _writer( writer )
+    , _clock( std::make_shared< record_device::capture_clock >() )
+{
+    if( ! _writer )
+        throw invalid_value_exception( "null writer" );
+}
+
+
+std::shared_ptr< device_serializer::writer > multi_device_writer::writer_of( uint32_t device_index )
+{
+    return std::make_shared< device_writer >( shared_from_this(), device_index );
+}
+
+
+/*static*/ std::vector< std::shared_ptr< record_device > >
+multi_device_writer::record( std::vector< std::shared_ptr< device_interface > > const & devices,
+                             std::shared_ptr< ros_writer > const & writer )
+{
+    auto file = std::make_shared< multi_device_writer >( writer );
+    std::vector< std::shared_ptr< record_device > > recorders;
+    for( uint32_t i = 0; i < devices.size(); ++i )
+        recorders.push_back( std::make_shared< record_device >( devices[i], file->writer_of( i ), file->get_clock() ) );
+    return recorders;
+}
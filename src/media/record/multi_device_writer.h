@@ -0,0 +1,38 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include "record_device.h"
+#include <media/ros/ros_writer.h>
+
+#include <mutex>
+
+
+namespace librealsense
+{
+    // One file for the recordings of several devices. Each device's record_device stages its frames in a queue and
+    // on a write thread of its own, and writes through the writer_of() its index, which files everything under that
+    // index; only the appending to the file is serialized. The devices share a capture clock, so the times the file
+    // indexes its messages by are one timeline for all of them.
+    // Playing the file back gives a playback device for each (see ros_reader::read_device_indices).
+    class multi_device_writer : public std::enable_shared_from_this< multi_device_writer >
+    {
+    public:
+        explicit multi_device_writer( std::shared_ptr< ros_writer > const & writer );
+
+        std::shared_ptr< device_serializer::writer > writer_of( uint32_t device_index );
+        std::shared_ptr< record_device::capture_clock > const & get_clock() const { return _clock; }
+
+        // Record devices for all of the given devices, in order, into the file
+        static std::vector< std::shared_ptr< record_device > >
+        record( std::vector< std::shared_ptr< device_interface > > const & devices,
+                std::shared_ptr< ros_writer > const & writer );
+
+    private:
+        class device_writer;
+
+        std::mutex _mutex;
+        std::shared_ptr< ros_writer > _writer;
+        std::shared_ptr< record_device::capture_clock > _clock;
+    };
+}
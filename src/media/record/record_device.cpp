@@ -6,12 +6,51 @@
 #include <core/advanced_mode.h>
 #include "record_device.h"
 #include <src/platform/backend-device-group.h>
+#include <src/context.h>
+#include <rsutils/json.h>
 
 using namespace librealsense;
 
+namespace
+{
+    record_device::queue_settings parse_queue_settings(rsutils::json const& settings)
+    {
+        record_device::queue_settings qs;
+        qs.max_bytes = settings.nested("queue-bytes").default_value(qs.max_bytes);
+        qs.max_frames = settings.nested("queue-frames").default_value(qs.max_frames);
+        auto overflow = settings.nested("overflow").default_value<std::string>("drop-newest");
+        if (overflow == "block")
+            qs.overflow = record_device::queue_settings::block;
+        else if (overflow == "drop-oldest")
+            qs.overflow = record_device::queue_settings::drop_oldest;
+        else if (overflow != "drop-newest")
+            LOG_WARNING("recorder: invalid overflow '" << overflow << "'; using 'drop-newest'");
+        return qs;
+    }
+}
+
+bool librealsense::record_device::direct_io(const std::shared_ptr<context>& ctx)
+{
+    return ctx && ctx->get_settings().nested("recorder", "direct-io").default_value(false);
+}
+
+bool librealsense::record_device::encode_depth(const std::shared_ptr<context>& ctx)
+{
+    if (!ctx)
+        return false;
+    auto codec = ctx->get_settings().nested("recorder", "depth-codec").default_value<std::string>("none");
+    if (codec == "rvl")
+        return true;
+    if (codec != "none")
+        LOG_WARNING("recorder: invalid depth-codec '" << codec << "'; using 'none'");
+    return false;
+}
+
 librealsense::record_device::record_device(std::shared_ptr<librealsense::device_interface> device,
-                                      std::shared_ptr<librealsense::device_serializer::writer> serializer):
+                                      std::shared_ptr<librealsense::device_serializer::writer> serializer,
+                                      std::shared_ptr<capture_clock> clock):
     m_write_thread([](){return std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max());}),
+    m_clock(clock),
     m_is_recording(true),
     m_record_total_pause_duration(0)
 {
@@ -27,6 +66,8 @@ librealsense::record_device::record_device(std::shared_ptr<librealsense::device_
 
     m_device = device;
     m_ros_writer = serializer;
+    if (auto ctx = m_device->get_context())
+        m_queue_settings = parse_queue_settings(ctx->get_settings().nested("recorder"));
     (*m_write_thread)->start(); //Start thread before creating the sensors (since they might write right away)
     m_sensors = create_record_sensors(m_device);
     LOG_DEBUG("Created record_device");
@@ -65,6 +106,23 @@ librealsense::record_device::~record_device()
     {
         s->disable_recording();
     }
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        m_stopping = true;
+    }
+    m_queue_cv.notify_all();
+    // Whatever was dropped since each stream was last written still needs to be in the file
+    (*m_write_thread)->invoke([this](dispatcher::cancellable_timer t)
+    {
+        std::map<device_serializer::stream_identifier, uint64_t> dropped;
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            dropped.swap(m_dropped);
+        }
+        if (m_is_recording)
+            for (auto&& d : dropped)
+                write_dropped_notification(d.first, d.second);
+    });
     if ((*m_write_thread)->flush() == false)
     {
         LOG_ERROR("Error - timeout waiting for flush, possible deadlock detected");
@@ -138,51 +196,130 @@ void librealsense::record_device::write_data(size_t sensor_index, librealsense::
         initialize_recording();
     });
 
-    //TODO: restore: uint64_t data_size = frame.frame->get_frame_data_size();
-    uint64_t cached_data_size = m_cached_data_size; //TODO: restore: (+ data_size)
-    if (cached_data_size > MAX_CACHED_DATA_SIZE)
-    {
-        LOG_WARNING("Recorder reached maximum cache size, frame dropped");
-        on_error("Recorder reached maximum cache size, frame dropped");
+    if (!frame)
         return;
-    }
 
-    m_cached_data_size = cached_data_size;
-    auto capture_time = get_capture_time();
-    //TODO: remove usage of shared pointer when frame_holder is copyable
-    auto frame_holder_ptr = std::make_shared<frame_holder>();
-    *frame_holder_ptr = std::move(frame);
-    (*m_write_thread)->invoke([this, frame_holder_ptr, sensor_index, capture_time/*, data_size*/, on_error](dispatcher::cancellable_timer t) {
-        if (m_is_recording == false)
-        {
-            return; //Recording is paused
-        }
-        std::call_once(m_first_frame_flag, [&]()
+    const uint32_t device_index = 0;
+    device_serializer::stream_identifier stream_id{ device_index,
+                                                    static_cast<uint32_t>(sensor_index),
+                                                    frame.frame->get_stream()->get_stream_type(),
+                                                    static_cast<uint32_t>(frame.frame->get_stream()->get_stream_index()) };
+    uint64_t data_size = frame.frame->get_frame_data_size();
+    {
+        // Frames wait here for the writer: once it falls behind (e.g., on slow storage), the queue settings decide
+        // whether we wait or what gets dropped, rather than letting memory grow without bound
+        std::unique_lock<std::mutex> locker(m_mutex);
+        while (!queue_has_room(data_size))
         {
-            try
+            if (m_stopping)
+                return;
+            if (m_queue_settings.overflow == queue_settings::block)
             {
-                write_header();
+                m_queue_cv.wait(locker, [&]() { return m_stopping || queue_has_room(data_size); });
+                continue;
             }
-            catch (const std::exception& e)
+            if (m_queue_settings.overflow == queue_settings::drop_oldest)
             {
-                LOG_ERROR("Failed to write header. " << e.what());
-                on_error( std::string( "Failed to write header. " ) + e.what() );
+                auto it = std::find_if(m_pending_frames.begin(), m_pending_frames.end(),
+                                       [&](pending_frame const& f) { return f.stream_id == stream_id; });
+                if (it != m_pending_frames.end())
+                {
+                    m_cached_data_size -= it->data_size;
+                    m_pending_frames.erase(it);
+                    ++m_dropped[stream_id];
+                    continue;
+                }
             }
-        });
+            if (!m_dropped[stream_id]++)
+                LOG_WARNING("Recorder reached maximum cache size, dropping " << get_string(stream_id.stream_type) << " frames");
+            return;
+        }
+        m_cached_data_size += data_size;
+        m_pending_frames.push_back({ stream_id, get_capture_time(), data_size, std::move(frame), on_error });
+    }
+
+    // One call per frame queued, each taking the oldest still there (if any, as some may have been dropped since)
+    (*m_write_thread)->invoke([this](dispatcher::cancellable_timer t) { write_next_frame(); });
+}
+
+bool librealsense::record_device::queue_has_room(uint64_t data_size) const
+{
+    // A frame larger than the whole budget still gets through once the queue is empty
+    if (m_pending_frames.empty())
+        return true;
+    if (m_queue_settings.max_frames && m_pending_frames.size() >= m_queue_settings.max_frames)
+        return false;
+    return m_cached_data_size + data_size <= m_queue_settings.max_bytes;
+}
+
+void librealsense::record_device::write_next_frame()
+{
+    pending_frame next;
+    uint64_t n_dropped = 0;
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        if (m_pending_frames.empty())
+            return;
+        next = std::move(m_pending_frames.front());
+        m_pending_frames.pop_front();
+        m_cached_data_size -= next.data_size;
+        auto it = m_dropped.find(next.stream_id);
+        if (it != m_dropped.end())
+        {
+            n_dropped = it->second;
+            m_dropped.erase(it);
+        }
+    }
+    m_queue_cv.notify_all();
 
+    if (m_is_recording == false)
+    {
+        return; //Recording is paused
+    }
+    std::call_once(m_first_frame_flag, [&]()
+    {
         try
         {
-            const uint32_t device_index = 0;
-            auto stream_type = frame_holder_ptr->frame->get_stream()->get_stream_type();
-            auto stream_index = static_cast<uint32_t>(frame_holder_ptr->frame->get_stream()->get_stream_index());
-            m_ros_writer->write_frame({ device_index, static_cast<uint32_t>(sensor_index), stream_type, stream_index }, capture_time, std::move(*frame_holder_ptr));
-            //TODO: restore: std::lock_guard<std::mutex> locker(m_mutex);  m_cached_data_size -= data_size;
+            write_header();
         }
-        catch(std::exception& e)
+        catch (const std::exception& e)
         {
-            on_error( std::string( "Failed to write frame. " ) + e.what() );
+            LOG_ERROR("Failed to write header. " << e.what());
+            next.on_error( std::string( "Failed to write header. " ) + e.what() );
         }
     });
+
+    // The gap goes into the file just before the frame that follows it
+    if (n_dropped)
+        write_dropped_notification(next.stream_id, n_dropped);
+    try
+    {
+        m_ros_writer->write_frame(next.stream_id, next.capture_time, std::move(next.frame));
+    }
+    catch(std::exception& e)
+    {
+        next.on_error( std::string( "Failed to write frame. " ) + e.what() );
+    }
+}
+
+void librealsense::record_device::write_dropped_notification(const device_serializer::stream_identifier& stream_id, uint64_t n_dropped)
+{
+    std::ostringstream description;
+    description << n_dropped << ' ' << get_string(stream_id.stream_type) << ' ' << stream_id.stream_index
+                << " frame" << (n_dropped == 1 ? "" : "s") << " dropped by the recorder";
+    notification n(RS2_NOTIFICATION_CATEGORY_FRAMES_DROPPED, 0, RS2_LOG_SEVERITY_WARN, description.str());
+    n.timestamp = std::chrono::duration<double, std::milli>(get_capture_time()).count();
+    n.serialized_data = rsutils::json::object({ { "stream", get_string(stream_id.stream_type) },
+                                                { "index", stream_id.stream_index },
+                                                { "dropped", n_dropped } }).dump();
+    try
+    {
+        m_ros_writer->write_notification({ stream_id.device_index, stream_id.sensor_index }, get_capture_time(), n);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("Failed to write dropped frames notification. " << e.what());
+    }
 }
 
 const std::string& librealsense::record_device::get_info(rs2_camera_info info) const
@@ -445,7 +582,13 @@ std::shared_ptr<matcher> record_device::create_matcher(const frame_holder& frame
 void record_device::initialize_recording()
 {
     //Expected to be called once when recording to file actually starts
-    m_capture_time_base = std::chrono::high_resolution_clock::now();
+    if (m_clock)
+    {
+        std::call_once(m_clock->started, [this]() { m_clock->base = std::chrono::high_resolution_clock::now(); });
+        m_capture_time_base = m_clock->base;
+    }
+    else
+        m_capture_time_base = std::chrono::high_resolution_clock::now();
     m_cached_data_size = 0;
     LOG_DEBUG( "Recording capture time base set to: " << m_capture_time_base.time_since_epoch().count() );
 
@@ -22,7 +22,40 @@ namespace librealsense
     public:
         static const uint64_t MAX_CACHED_DATA_SIZE = 1920 * 1080 * 4 * 30; // ~1 sec of HD video @ 30 FPS
 
-        record_device(std::shared_ptr<device_interface> device, std::shared_ptr<device_serializer::writer> serializer);
+        // How much may wait for the writer, and what happens to frames beyond that; from the context settings:
+        //     "recorder": { "queue-bytes": 248832000, "queue-frames": 0, "overflow": "block" | "drop-newest" | "drop-oldest",
+        //                   "direct-io": false, "depth-codec": "none" | "rvl" }
+        // Frames dropped are counted per stream and written into the file as notifications, where they're missing.
+        struct queue_settings
+        {
+            enum overflow_policy
+            {
+                block,        // The sensor waits for room
+                drop_newest,  // The frame that doesn't fit is dropped
+                drop_oldest   // The oldest frame of the same stream still waiting is dropped to make room
+            };
+
+            uint64_t max_bytes = MAX_CACHED_DATA_SIZE;
+            size_t max_frames = 0;  // 0 for no limit
+            overflow_policy overflow = drop_newest;
+        };
+
+        // Whether the file should be written with direct I/O, around the page cache ("direct-io", above)
+        static bool direct_io(const std::shared_ptr<context>& ctx);
+
+        // Whether depth should be written coded losslessly rather than raw ("depth-codec", above)
+        static bool encode_depth(const std::shared_ptr<context>& ctx);
+
+        // The time base of record_devices writing to one file (see multi_device_writer), set when the first of them
+        // starts recording, so their capture times are on one timeline
+        struct capture_clock
+        {
+            std::once_flag started;
+            std::chrono::high_resolution_clock::time_point base;
+        };
+
+        record_device(std::shared_ptr<device_interface> device, std::shared_ptr<device_serializer::writer> serializer,
+                      std::shared_ptr<capture_clock> clock = nullptr);
         virtual ~record_device();
 
         std::shared_ptr<context> get_context() const override;
@@ -59,6 +92,9 @@ namespace librealsense
         void write_data(size_t sensor_index, frame_holder f, std::function<void(std::string const&)> on_error);
         void write_sensor_extension_snapshot(size_t sensor_index, rs2_extension ext, std::shared_ptr<extension_snapshot> snapshot, std::function<void(std::string const&)> on_error);
         void write_notification(size_t sensor_index, const notification& n);
+        void write_next_frame();
+        void write_dropped_notification(const device_serializer::stream_identifier& stream_id, uint64_t n_dropped);
+        bool queue_has_room(uint64_t data_size) const;
         std::vector<std::shared_ptr<record_sensor>> create_record_sensors(std::shared_ptr<device_interface> m_device);
         template <typename T> device_serializer::snapshot_collection get_extensions_snapshots(T* extendable);
         template <typename T, typename Ext> void try_add_snapshot(T* extendable, device_serializer::snapshot_collection& snapshots);
@@ -69,6 +105,7 @@ namespace librealsense
         std::shared_ptr<device_serializer::writer> m_ros_writer;
 
         std::chrono::high_resolution_clock::time_point m_capture_time_base;
+        std::shared_ptr<capture_clock> m_clock;  // When shared with other devices
         std::chrono::high_resolution_clock::duration m_record_total_pause_duration;
         std::chrono::high_resolution_clock::time_point m_time_of_pause;
 
@@ -76,6 +113,20 @@ namespace librealsense
         bool m_is_recording;
         std::once_flag m_first_frame_flag;
         uint64_t m_cached_data_size;
+
+        struct pending_frame
+        {
+            device_serializer::stream_identifier stream_id;
+            std::chrono::nanoseconds capture_time;
+            uint64_t data_size;
+            frame_holder frame;
+            std::function<void(std::string const&)> on_error;  // Of the sensor it came from
+        };
+        queue_settings m_queue_settings;
+        std::deque<pending_frame> m_pending_frames;                        // Waiting for the writer, oldest first
+        std::map<device_serializer::stream_identifier, uint64_t> m_dropped;  // Since each stream was last written
+        std::condition_variable m_queue_cv;
+        bool m_stopping = false;
         std::once_flag m_first_call_flag;
         void initialize_recording();
     };
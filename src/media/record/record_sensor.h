@@ -50,6 +50,9 @@ namespace librealsense
         void set_frames_callback( rs2_frame_callback_sptr callback ) override;
         stream_profiles get_active_streams() const override;
         stream_profiles const & get_raw_stream_profiles() const override;
+        std::vector< rs2_stream_telemetry > get_stream_telemetry() const override { return m_sensor.get_stream_telemetry(); }
+        bool set_metadata_sink( std::shared_ptr< metadata_sink > sink ) override { return m_sensor.set_metadata_sink( std::move( sink ) ); }
+        bool flush_metadata_sink() override { return m_sensor.flush_metadata_sink(); }
         int register_before_streaming_changes_callback(std::function<void(bool)> callback) override;
         void unregister_before_start_callback(int token) override;
         void stop_with_error(const std::string& message);
@@ -229,6 +229,9 @@ namespace librealsense
     constexpr const char* FRAME_TIMESTAMP_MD_STR = "frame_timestamp";
     constexpr const char* TRACKER_CONFIDENCE_MD_STR = "Tracker Confidence";
 
+    // Image encoding of Z16 frames coded with depth_codec, which go in coded_frame_data_topic()
+    constexpr const char* RVL_DEPTH_ENCODING = "16UC1; rvl";
+
     class ros_topic
     {
     public:
@@ -354,6 +357,13 @@ namespace librealsense
             return create_from({ stream_full_prefix(stream_id), stream_to_ros_type(stream_id.stream_type), "data" });
         }
 
+        // Frames whose data is coded (see RVL_DEPTH_ENCODING) go in a topic of their own, next to the raw ones: readers
+        // from before would otherwise take the coded data for pixels, where this way they just don't see the frames
+        static std::string coded_frame_data_topic(const device_serializer::stream_identifier& stream_id)
+        {
+            return create_from({ stream_full_prefix(stream_id), stream_to_ros_type(stream_id.stream_type), "rvl" });
+        }
+
         static std::string frame_metadata_topic(const device_serializer::stream_identifier& stream_id)
         {
             return create_from({ stream_full_prefix(stream_id), stream_to_ros_type(stream_id.stream_type), "metadata" });
@@ -528,7 +538,7 @@ namespace librealsense
         //TODO: Improve readability and robustness of expressions
         FrameQuery()
             : RegexTopicQuery( rsutils::string::from() << R"RRR(/device_\d+/sensor_\d+/.*_\d+)RRR"
-                                                         << "/(" << data_msg_types() << ")/data" )
+                                                         << "/(" << data_msg_types() << ")/(data|rvl)" )
         {
         }
     };
@@ -538,7 +548,7 @@ namespace librealsense
     public:
         StreamQuery( const device_serializer::stream_identifier & stream_id )
             : RegexTopicQuery( rsutils::string::from()
-                               << stream_prefix( stream_id ) << "/(" << data_msg_types() << ")/data" )
+                               << stream_prefix( stream_id ) << "/(" << data_msg_types() << ")/(data|rvl)" )
         {
         }
     };
@@ -555,8 +565,9 @@ namespace librealsense
     class OptionsQuery : public RegexTopicQuery
     {
     public:
-        OptionsQuery()
-            : RegexTopicQuery( R"RRR(/device_\d+/sensor_\d+/option/.*/value)RRR" )
+        OptionsQuery( uint32_t device_index )
+            : RegexTopicQuery( rsutils::string::from()
+                               << "/device_" << device_index << R"RRR(/sensor_\d+/option/.*/value)RRR" )
         {
         }
     };
@@ -564,8 +575,9 @@ namespace librealsense
     class NotificationsQuery : public RegexTopicQuery
     {
     public:
-        NotificationsQuery()
-            : RegexTopicQuery( R"RRR(/device_\d+/sensor_\d+/notification/.*)RRR" )
+        NotificationsQuery( uint32_t device_index )
+            : RegexTopicQuery( rsutils::string::from()
+                               << "/device_" << device_index << R"RRR(/sensor_\d+/notification/.*)RRR" )
         {
         }
     };
@@ -583,9 +595,11 @@ namespace librealsense
         return ROS_FILE_VERSION_2;
     }
 
+    // The device of a file recorded from a single device; a file of several (see multi_device_writer) has the others
+    // after it, and the readers and writers of each have a get_device_index() of their own
     constexpr uint32_t get_device_index()
     {
-        return 0; //TODO: change once SDK file supports multiple devices
+        return 0;
     }
 
     constexpr device_serializer::nanoseconds get_static_file_info_timestamp()
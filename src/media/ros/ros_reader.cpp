@@ -10,8 +10,12 @@
 #include <src/core/motion-frame.h>
 #include <src/core/video-frame.h>
 #include <src/color-sensor.h>
+#include <src/context.h>
+#include <src/proc/processing-thread-pool.h>
+#include <src/media/depth-codec.h>
 
 #include <rsutils/string/from.h>
+#include <rsutils/json.h>
 #include <cstring>
 
 
@@ -19,13 +23,40 @@ namespace librealsense
 {
     using namespace device_serializer;
 
-    ros_reader::ros_reader(const std::string& file, const std::shared_ptr<context>& ctx) :
+    namespace
+    {
+        // Deserializes like IStream, except that byte arrays are only located, not copied out; messages with a single
+        // one (like an Image) are then read without touching their payload
+        struct in_place_stream : rs2rosinternal::serialization::IStream
+        {
+            in_place_stream( uint8_t * data, uint32_t count )
+                : IStream( data, count )
+            {
+            }
+
+            template< typename T > void next( T & t ) { rs2rosinternal::serialization::deserialize( *this, t ); }
+
+            void next( std::vector< uint8_t > & )
+            {
+                uint32_t size;
+                next( size );
+                bytes = advance( size );
+                bytes_size = size;
+            }
+
+            uint8_t * bytes = nullptr;
+            uint32_t bytes_size = 0;
+        };
+    }
+
+    ros_reader::ros_reader(const std::string& file, const std::shared_ptr<context>& ctx, uint32_t device_index) :
         m_metadata_parser_map(md_constant_parser::create_metadata_parser_map()),
         m_total_duration(0),
         m_file_path(file),
         m_context(ctx),
         m_version(0),
-        m_legacy_depth_units(0)
+        m_legacy_depth_units(0),
+        m_device_index(device_index)
     {
         try
         {
@@ -107,39 +138,36 @@ namespace librealsense
         //Using cached topics here and not querying them (before reseting) since a previous call to seek
         // could have changed the view and some streams that should be streaming were dropped.
         //E.g:  Recording Depth+Color, stopping Depth, starting IR, stopping IR and Color. Play IR+Depth: will play only depth, then only IR, then we seek to a point only IR was streaming, and then to 0.
-        for (auto topic : m_enabled_streams_topics)
-        {
-            m_samples_view->addQuery(m_file, rosbag::TopicQuery(topic), seek_time_as_rostime);
-        }
+        m_samples_view->addQuery(m_file, rosbag::TopicQuery(m_enabled_streams_topics), seek_time_as_rostime);
         m_samples_itrator = m_samples_view->begin();
     }
 
     std::vector<std::shared_ptr<serialized_data>> ros_reader::fetch_last_frames(const nanoseconds& seek_time)
     {
         std::vector<std::shared_ptr<serialized_data>> result;
-        rosbag::View view(m_file, FalseQuery());
         auto as_rostime = to_rostime(seek_time);
         auto start_time = to_rostime(get_static_file_info_timestamp());
 
+        // Each stream's last frame comes straight from the bag's index, rather than from going over everything that
+        // was recorded before the seek time
+        std::map<device_serializer::stream_identifier, std::shared_ptr<rosbag::MessageInstance>> last_frames;
         for (auto topic : m_enabled_streams_topics)
         {
-            view.addQuery(m_file, rosbag::TopicQuery(topic), start_time, as_rostime);
-        }
-        std::map<device_serializer::stream_identifier, rs2rosinternal::Time> last_frames;
-        for (auto&& m : view)
-        {
-            if (m.isType<sensor_msgs::Image>() || m.isType<sensor_msgs::Imu>())
-            {
-                auto id = ros_topic::get_stream_identifier(m.getTopic());
-                last_frames[id] = m.getTime();
-            }
+            auto msg = m_file.getLastMessage(
+                [&topic]( rosbag::ConnectionInfo const * connection )
+                {
+                    return connection->topic == topic
+                        && ( connection->datatype == rs2rosinternal::message_traits::datatype< sensor_msgs::Image >()
+                             || connection->datatype == rs2rosinternal::message_traits::datatype< sensor_msgs::Imu >() );
+                },
+                start_time,
+                as_rostime );
+            if (msg)
+                last_frames[ros_topic::get_stream_identifier(msg->getTopic())] = msg;
         }
         for (auto&& kvp : last_frames)
         {
-            auto topic = ros_topic::frame_data_topic(kvp.first);
-            rosbag::View view(m_file, rosbag::TopicQuery(topic), kvp.second, kvp.second);
-            auto msg = view.begin();
-            auto new_frame = create_frame(*msg);
+            auto new_frame = create_frame(*kvp.second);
             result.push_back(new_frame);
         }
         return result;
@@ -152,6 +180,20 @@ namespace librealsense
     void ros_reader::reset()
     {
         m_file.close();
+        rsutils::json settings;
+        if (m_context)
+            settings = m_context->get_settings().nested("playback");
+        m_file.setMemoryMapped(settings.nested("memory-map").default_value(true));
+
+        // Chunks ahead of the one being played get decompressed by the pool, so they're ready by the time we get to
+        // them; by default, enough to keep all the workers busy
+        auto pool = m_pool = processing_thread_pool::instance();
+        auto prefetch = settings.nested("prefetch-chunks").default_value(static_cast<int>(pool->size() + 1));
+        if (prefetch > 0 && pool->size())
+            m_file.setPrefetch([pool](std::function<void()> task) { pool->submit(std::move(task)); },
+                               static_cast<uint32_t>(prefetch));
+        else
+            m_file.setPrefetch(nullptr, 0);
         m_file.open(m_file_path, rosbag::BagMode::Read);
         m_version = read_file_version(m_file);
         m_samples_view = nullptr;
@@ -166,8 +208,8 @@ namespace librealsense
         if (m_samples_view == nullptr) //Starting to stream
         {
             m_samples_view = std::unique_ptr<rosbag::View>(new rosbag::View(m_file, FalseQuery()));
-            m_samples_view->addQuery(m_file, OptionsQuery(), start_time);
-            m_samples_view->addQuery(m_file, NotificationsQuery(), start_time);
+            m_samples_view->addQuery(m_file, OptionsQuery(get_device_index()), start_time);
+            m_samples_view->addQuery(m_file, NotificationsQuery(get_device_index()), start_time);
             m_samples_itrator = m_samples_view->begin();
         }
         else //Already streaming
@@ -408,7 +450,27 @@ namespace librealsense
     frame_holder ros_reader::create_image_from_message(const rosbag::MessageInstance &image_data) const
     {
         LOG_DEBUG("Trying to create an image frame from message");
-        auto msg = instantiate_msg<sensor_msgs::Image>(image_data);
+
+        // Uncompressed images are used right where they are in the mapped file, which the frame holds on to
+        sensor_msgs::ImageConstPtr msg;
+        std::shared_ptr<uint8_t> mapped_pixels;
+        size_t pixels_size;
+        uint32_t mapped_size = 0;
+        if (auto mapped = m_file.getMappedMessage(image_data, mapped_size))
+        {
+            auto image = std::make_shared<sensor_msgs::Image>();
+            in_place_stream stream(const_cast<uint8_t*>(mapped.get()), mapped_size);
+            rs2rosinternal::serialization::deserialize(stream, *image);
+            mapped_pixels = std::shared_ptr<uint8_t>(mapped, stream.bytes);
+            pixels_size = stream.bytes_size;
+            msg = image;
+        }
+        else
+        {
+            msg = instantiate_msg<sensor_msgs::Image>(image_data);
+            pixels_size = msg->data.size();
+        }
+
         frame_additional_data additional_data{};
         std::chrono::duration<double, std::milli> timestamp_ms(std::chrono::duration<double>(msg->header.stamp.toSec()));
         additional_data.timestamp = timestamp_ms.count();
@@ -434,11 +496,22 @@ namespace librealsense
             get_frame_metadata(m_file, info_topic, stream_id, image_data, additional_data);
         }
 
+        // Coded depth gets decoded into a frame of its own, wherever it's read from
+        bool const coded = msg->encoding == RVL_DEPTH_ENCODING;
+        uint8_t const * coded_data = nullptr;
+        size_t coded_size = 0;
+        if (coded)
+        {
+            coded_data = mapped_pixels ? mapped_pixels.get() : msg->data.data();
+            coded_size = pixels_size;
+            pixels_size = size_t(msg->step) * msg->height;
+        }
+
         frame_interface * frame = m_frame_source->alloc_frame(
             { stream_id.stream_type, stream_id.stream_index, frame_source::stream_to_frame_types( stream_id.stream_type ) },
-            msg->data.size(),
+            pixels_size,
             std::move( additional_data ),
-            true );
+            coded || ! mapped_pixels );
 
         if (frame == nullptr)
         {
@@ -447,14 +520,29 @@ namespace librealsense
         }
         librealsense::video_frame* video_frame = static_cast<librealsense::video_frame*>(frame);
         video_frame->assign(msg->width, msg->height, msg->step, msg->step / msg->width * 8);
-        rs2_format stream_format;
-        convert(msg->encoding, stream_format);
+        rs2_format stream_format = RS2_FORMAT_Z16;
+        if (!coded)
+            convert(msg->encoding, stream_format);
         //attaching a temp stream to the frame. Playback sensor should assign the real stream
         frame->set_stream( std::make_shared< video_stream_profile >() );
         frame->get_stream()->set_format(stream_format);
         frame->get_stream()->set_stream_index(int(stream_id.stream_index));
         frame->get_stream()->set_stream_type(stream_id.stream_type);
-        video_frame->data = std::move(msg->data);
+        if (coded)
+        {
+            auto pixels = video_frame->external_data ? video_frame->external_data.get() : video_frame->data.data();
+            if (!depth_codec::decode(coded_data, coded_size, reinterpret_cast<uint16_t*>(pixels),
+                                     pixels_size / sizeof(uint16_t), m_pool.get()))
+                throw io_exception( rsutils::string::from() << "Corrupt coded depth frame " << msg->header.seq
+                                                            << " in topic " << image_data.getTopic() );
+        }
+        else if (mapped_pixels)
+        {
+            video_frame->external_data = std::move(mapped_pixels);
+            video_frame->external_size = pixels_size;
+        }
+        else
+            video_frame->data = std::move(msg->data);
         librealsense::frame_holder fh{ video_frame };
         LOG_DEBUG("Created image frame: " << stream_id << " " << video_frame->get_width() << "x" << video_frame->get_height() << " " << stream_format);
 
@@ -1180,6 +1268,32 @@ namespace librealsense
         return infos;
     }
 
+    std::set<uint32_t> ros_reader::read_device_indices(const std::string& file)
+    {
+        std::set<uint32_t> device_indices;
+        try
+        {
+            rosbag::Bag bag;
+            bag.open(file, rosbag::BagMode::Read);
+            if (read_file_version(bag) == legacy_file_format::file_version())
+                device_indices.insert(0);
+            else
+            {
+                // Every device has the info of its sensors
+                rosbag::View sensor_infos(bag, RegexTopicQuery(R"RRR(/device_(\d)+/sensor_(\d)+/info)RRR"));
+                for (auto connection : sensor_infos.getConnections())
+                    device_indices.insert(ros_topic::get_device_index(connection->topic));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            throw io_exception(rsutils::string::from() << "Failed to read the devices of \"" << file << "\": " << e.what());
+        }
+        if (device_indices.empty())
+            device_indices.insert(0);
+        return device_indices;
+    }
+
     std::set<uint32_t> ros_reader::read_sensor_indices(uint32_t device_index) const
     {
         std::set<uint32_t> sensor_indices;
@@ -19,12 +19,16 @@ namespace librealsense
     class options_interface;
     class options_container;
     class processing_block_interface;
+    class processing_thread_pool;
     class recommended_proccesing_blocks_snapshot;
 
     class ros_reader: public device_serializer::reader
     {
     public:
-        ros_reader(const std::string& file, const std::shared_ptr<context>& ctx);
+        // Plays the device of the given index in the file: files recorded from several devices have one for each
+        ros_reader(const std::string& file, const std::shared_ptr<context>& ctx, uint32_t device_index = 0);
+        static std::set<uint32_t> read_device_indices(const std::string& file);
+        uint32_t get_device_index() const { return m_device_index; }
         device_snapshot query_device_description(const nanoseconds& time) override;
         std::shared_ptr<serialized_data> read_next_data() override;
         void seek_to_time(const nanoseconds& seek_time) override;
@@ -86,7 +90,7 @@ namespace librealsense
         static uint32_t read_file_version(const rosbag::Bag& file);
         bool try_read_legacy_stream_extrinsic(const stream_identifier& stream_id, uint32_t& group_id, rs2_extrinsics& extrinsic) const;
         bool try_read_stream_extrinsic(const stream_identifier& stream_id, uint32_t& group_id, rs2_extrinsics& extrinsic) const;
-        static void update_sensor_options(const rosbag::Bag& file, uint32_t sensor_index, const nanoseconds& time, uint32_t file_version, snapshot_collection& sensor_extensions, uint32_t version);
+        void update_sensor_options(const rosbag::Bag& file, uint32_t sensor_index, const nanoseconds& time, uint32_t file_version, snapshot_collection& sensor_extensions, uint32_t version);
         void update_proccesing_blocks(const rosbag::Bag& file, uint32_t sensor_index, const nanoseconds& time, uint32_t file_version, snapshot_collection& sensor_extensions, uint32_t version, std::string pid, std::string sensor_name);
         void add_sensor_extension(snapshot_collection & sensor_extensions, std::string sensor_name);
        
@@ -137,5 +141,7 @@ namespace librealsense
         std::shared_ptr<context>                m_context;
         uint32_t                                m_version;
         float                                   m_legacy_depth_units;
+        uint32_t                                m_device_index;
+        std::shared_ptr<processing_thread_pool> m_pool;  // decodes coded depth
     };
 }
@@ -12,6 +12,8 @@
 #include "ros_writer.h"
 #include "core/pose-frame.h"
 #include "core/motion-frame.h"
+#include "proc/processing-thread-pool.h"
+#include "media/depth-codec.h"
 #include <src/core/sensor-interface.h>
 #include <src/core/device-interface.h>
 
@@ -21,29 +23,42 @@ namespace librealsense
 {
     using namespace device_serializer;
 
-    ros_writer::ros_writer(const std::string& file, bool compress_while_record) : m_file_path(file)
+    ros_writer::ros_writer(const std::string& file, bool compress_while_record, bool direct_io, bool encode_depth) : m_file_path(file)
     {
         LOG_INFO("Compression while record is set to " << (compress_while_record ? "ON" : "OFF"));
+        if (encode_depth)
+            m_depth_codec_pool = processing_thread_pool::instance();
+        m_bag.setDirectIO(direct_io);
         m_bag.open(file, rosbag::BagMode::Write);
         if (compress_while_record)
         {
             m_bag.setCompression(rosbag::CompressionType::LZ4);
+            // Chunks get compressed by the pool while we go on writing, so only the writing itself is on our thread;
+            // allowing one more chunk than there are workers keeps them all busy without letting memory run away
+            auto pool = processing_thread_pool::instance();
+            m_bag.setCompressionExecutor( [pool]( std::function< void() > task ) { pool->submit( std::move( task ) ); },
+                                          static_cast< uint32_t >( pool->size() + 1 ) );
         }
         write_file_version();
     }
 
     void ros_writer::write_device_description(const librealsense::device_snapshot& device_description)
+    {
+        write_device_description(device_description, get_device_index());
+    }
+
+    void ros_writer::write_device_description(const librealsense::device_snapshot& device_description, uint32_t device_index)
     {
         for (auto&& device_extension_snapshot : device_description.get_device_extensions_snapshots().get_snapshots())
         {
-            write_extension_snapshot(get_device_index(), get_static_file_info_timestamp(), device_extension_snapshot.first, device_extension_snapshot.second);
+            write_extension_snapshot(device_index, get_static_file_info_timestamp(), device_extension_snapshot.first, device_extension_snapshot.second);
         }
 
         for (auto&& sensors_snapshot : device_description.get_sensors_snapshots())
         {
             for (auto&& sensor_extension_snapshot : sensors_snapshot.get_sensor_extensions_snapshots().get_snapshots())
             {
-                write_extension_snapshot(get_device_index(), sensors_snapshot.get_sensor_index(), get_static_file_info_timestamp(), sensor_extension_snapshot.first, sensor_extension_snapshot.second);
+                write_extension_snapshot(device_index, sensors_snapshot.get_sensor_index(), get_static_file_info_timestamp(), sensor_extension_snapshot.first, sensor_extension_snapshot.second);
             }
         }
     }
@@ -187,7 +202,6 @@ namespace librealsense
         image.is_bigendian = is_big_endian();
         auto size = vid_frame->get_stride() * vid_frame->get_height();
         auto p_data = vid_frame->get_frame_data();
-        image.data.assign(p_data, p_data + size);
         image.header.seq = static_cast<uint32_t>(vid_frame->get_frame_number());
         std::chrono::duration<double, std::milli> timestamp_ms(vid_frame->get_frame_timestamp());
         image.header.stamp = rs2rosinternal::Time(std::chrono::duration<double>(timestamp_ms).count());
@@ -196,7 +210,24 @@ namespace librealsense
         if(df)
             image.depth_units = df->get_units();
         auto image_topic = ros_topic::frame_data_topic(stream_id);
-        write_message(image_topic, timestamp, image);
+
+        // The pixels go into the bag (and its compressor) straight from the frame: they'd otherwise be copied into the
+        // message, then again into the record. With the data empty, only depth_units comes after it.
+        rosbag::Bag::ExternalBlock pixels;
+        pixels.data = p_data;
+        pixels.size = static_cast<uint32_t>(size);
+        if (m_depth_codec_pool && vid_frame->get_stream()->get_format() == RS2_FORMAT_Z16)
+        {
+            // The whole of each row, padding included, so the data read back is just what was written
+            depth_codec::encode(reinterpret_cast<const uint16_t*>(p_data), size / sizeof(uint16_t), m_coded_depth, m_depth_codec_pool.get());
+            image.encoding = RVL_DEPTH_ENCODING;
+            image_topic = ros_topic::coded_frame_data_topic(stream_id);
+            pixels.data = m_coded_depth.data();
+            pixels.size = static_cast<uint32_t>(m_coded_depth.size());
+        }
+        pixels.offset = rs2rosinternal::serialization::serializationLength(image)
+                      - rs2rosinternal::serialization::serializationLength(image.depth_units);
+        write_message(image_topic, timestamp, image, pixels);
         write_additional_frame_messages(stream_id, timestamp, frame);
     }
 
@@ -13,12 +13,16 @@ namespace librealsense
     using namespace device_serializer;
 
     class recommended_proccesing_blocks_interface;
+    class processing_thread_pool;
 
     class ros_writer: public writer
     {
     public:
-        explicit ros_writer(const std::string& file, bool compress_while_record);
+        // With encode_depth, Z16 frames are written coded with depth_codec rather than raw
+        explicit ros_writer(const std::string& file, bool compress_while_record, bool direct_io = false, bool encode_depth = false);
         void write_device_description(const librealsense::device_snapshot& device_description) override;
+        // Of one of the devices in a file of several
+        void write_device_description(const librealsense::device_snapshot& device_description, uint32_t device_index);
         void write_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame) override;
         void write_snapshot(uint32_t device_index, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot) override;
         void write_snapshot(const sensor_identifier& sensor_id, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot) override;
@@ -77,10 +81,27 @@ namespace librealsense
             }
         }
 
+        template <typename T>
+        void write_message(std::string const& topic, nanoseconds const& time, T const& msg, rosbag::Bag::ExternalBlock const& block)
+        {
+            try
+            {
+                m_bag.write(topic, to_rostime(time), msg, block);
+                LOG_DEBUG("Recorded: \"" << topic << "\" . TS: " << time.count());
+            }
+            catch (rosbag::BagIOException& e)
+            {
+                throw io_exception( rsutils::string::from() << "Ros Writer failed to write topic: \"" << topic
+                                                            << "\" to file. (Exception message: " << e.what() << ")" );
+            }
+        }
+
         static uint8_t is_big_endian();
         std::map<stream_identifier, geometry_msgs::Transform> m_extrinsics_msgs;
         std::string m_file_path;
         rosbag::Bag m_bag;
         std::map<uint32_t, std::set<rs2_option>> m_written_options_descriptions;
+        std::shared_ptr<processing_thread_pool> m_depth_codec_pool;  // Set when depth is coded
+        std::vector<uint8_t> m_coded_depth;
     };
 }
@@ -0,0 +1,92 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "memory-stats.h"
+
+#include <map>
+#include <mutex>
+
+
+namespace librealsense {
+namespace memory_stats {
+
+
+namespace {
+
+std::mutex & registry_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+// Never shrinks: the totals outlive the sources, so what's gone still counts
+std::map< std::string, std::shared_ptr< frame_pool_stats > > & registry()
+{
+    static std::map< std::string, std::shared_ptr< frame_pool_stats > > r;
+    return r;
+}
+
+subsystem to_subsystem( std::string const & name, frame_pool_stats const & s )
+{
+    subsystem sub;
+    sub.name = name;
+    sub.frames = s.frames;
+    sub.buffer_hits = s.hits;
+    sub.buffer_misses = s.misses;
+    sub.buffer_bytes = s.miss_bytes;
+    sub.new_objects = s.new_objects;
+    return sub;
+}
+
+}  // namespace
+
+
+subsystem subsystem::operator-( subsystem const & before ) const
+{
+    subsystem d;
+    d.name = name;
+    d.frames = frames - before.frames;
+    d.buffer_hits = buffer_hits - before.buffer_hits;
+    d.buffer_misses = buffer_misses - before.buffer_misses;
+    d.buffer_bytes = buffer_bytes - before.buffer_bytes;
+    d.new_objects = new_objects - before.new_objects;
+    return d;
+}
+
+
+std::shared_ptr< frame_pool_stats > get_totals( std::string const & name )
+{
+    std::lock_guard< std::mutex > lock( registry_mutex() );
+    auto & totals = registry()[name];
+    if( ! totals )
+        totals = std::make_shared< frame_pool_stats >();
+    return totals;
+}
+
+
+std::vector< subsystem > snapshot()
+{
+    std::lock_guard< std::mutex > lock( registry_mutex() );
+    std::vector< subsystem > subsystems;
+    for( auto & s : registry() )
+        subsystems.push_back( to_subsystem( s.first, *s.second ) );
+    return subsystems;
+}
+
+
+subsystem snapshot( std::string const & name )
+{
+    std::lock_guard< std::mutex > lock( registry_mutex() );
+    auto it = registry().find( name );
+    if( it == registry().end() )
+    {
+        subsystem none;
+        none.name = name;
+        return none;
+    }
+    return to_subsystem( name, *it->second );
+}
+
+
+}  // namespace memory_stats
+}  // namespace librealsense
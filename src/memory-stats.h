@@ -0,0 +1,78 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include "frame-buffer-pool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace librealsense {
+namespace memory_stats {
+
+
+// What the frame archives allocated, by subsystem: every sensor and processing block of the same name counts as one,
+// whether there's one of them or many, or they're gone. For memory profiling: e.g., a block whose buffer misses keep
+// up with its frames once it's past its first few allocates each frame anew.
+struct subsystem
+{
+    std::string name;
+    uint64_t frames = 0;
+    uint64_t buffer_hits = 0;     // Frame buffers reused from a pool
+    uint64_t buffer_misses = 0;   // Frame buffers newly allocated
+    uint64_t buffer_bytes = 0;    // Of the latter
+    uint64_t new_objects = 0;     // Frames that didn't fit in their archive's fixed heap
+
+    // For comparing snapshots: what was allocated since 'before'
+    subsystem operator-( subsystem const & before ) const;
+};
+
+
+// The totals every frame_source of the name adds to (see frame_source::set_subsystem)
+std::shared_ptr< frame_pool_stats > get_totals( std::string const & name );
+
+// All the subsystems so far, by name
+std::vector< subsystem > snapshot();
+
+// The counts of the subsystem, or all zeros if nothing of it was ever made
+subsystem snapshot( std::string const & name );
+
+
+}  // namespace memory_stats
+
+
+// The "memory-budget-mb" context setting: the frame memory all the sensors of the context should hold between them.
+// It's shared equally by the sensors that are open, each taking its part when it opens and giving it back when it
+// closes; so a sensor's share gets smaller as others open after it.
+class memory_budget
+{
+public:
+    explicit memory_budget( uint64_t bytes )
+        : _bytes( bytes )
+        , _sensors( 0 )
+    {
+    }
+
+    uint64_t get_total() const { return _bytes; }
+
+    void add_sensor() { ++_sensors; }
+    void remove_sensor() { --_sensors; }
+
+    // What each of the open sensors can hold
+    uint64_t get_share() const
+    {
+        int const n = _sensors;
+        return n > 1 ? _bytes / n : _bytes;
+    }
+
+private:
+    uint64_t const _bytes;
+    std::atomic< int > _sensors;
+};
+
+
+}  // namespace librealsense
@@ -0,0 +1,104 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "metadata-sink.h"
+#include "frame.h"
+#include "stream.h"
+
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace librealsense {
+
+
+metadata_sink::metadata_sink( int batch_size, callback cb )
+    : _batch_size( size_t( batch_size ) )
+    , _bitmap_size( ( _batch_size + 511 ) / 512 * 64 )
+    , _callback( std::move( cb ) )
+    , _stream( _batch_size )
+    , _index( _batch_size )
+    , _frame_number( _batch_size )
+    , _timestamp( _batch_size )
+    , _values( _batch_size * RS2_FRAME_METADATA_COUNT )
+    , _validity( _bitmap_size * RS2_FRAME_METADATA_COUNT )
+{
+    std::fill_n( _null_count, RS2_FRAME_METADATA_COUNT, 0 );
+}
+
+
+void metadata_sink::append( frame const & f )
+{
+    auto table = f.get_metadata_table();
+    auto profile = f.get_stream();
+
+    std::lock_guard< std::mutex > lock( _mutex );
+    auto const row = _rows;
+    _stream[row] = profile ? int( profile->get_stream_type() ) : int( RS2_STREAM_ANY );
+    _index[row] = profile ? profile->get_stream_index() : 0;
+    _frame_number[row] = f.get_frame_number();
+    _timestamp[row] = f.get_frame_timestamp();
+
+    // The bitmaps start out clear
+    auto const bit = uint8_t( 1 << ( row % 8 ) );
+    for( int md = 0; md < RS2_FRAME_METADATA_COUNT; ++md )
+    {
+        if( table->valid[md] )
+        {
+            _values[md * _batch_size + row] = table->values[md];
+            _validity[md * _bitmap_size + row / 8] |= bit;
+        }
+        else
+        {
+            _values[md * _batch_size + row] = 0;
+            ++_null_count[md];
+        }
+    }
+
+    if( ++_rows == _batch_size )
+        hand_on();
+}
+
+
+void metadata_sink::flush()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    if( _rows )
+        hand_on();
+}
+
+
+void metadata_sink::hand_on()
+{
+    rs2_metadata_batch batch;
+    batch.rows = int( _rows );
+    batch.stream = _stream.data();
+    batch.index = _index.data();
+    batch.frame_number = _frame_number.data();
+    batch.timestamp = _timestamp.data();
+    for( int md = 0; md < RS2_FRAME_METADATA_COUNT; ++md )
+    {
+        batch.values[md] = _values.data() + md * _batch_size;
+        batch.validity[md] = _null_count[md] ? _validity.data() + md * _bitmap_size : nullptr;
+        batch.null_count[md] = _null_count[md];
+    }
+
+    try
+    {
+        _callback( batch );
+    }
+    catch( std::exception const & e )
+    {
+        LOG_ERROR( "Exception was thrown during metadata sink callback: " << e.what() );
+    }
+
+    // Which also leaves the bits past the last row clear, as Arrow expects
+    _rows = 0;
+    std::fill_n( _null_count, RS2_FRAME_METADATA_COUNT, 0 );
+    std::memset( _validity.data(), 0, _validity.size() );
+}
+
+
+}  // namespace librealsense
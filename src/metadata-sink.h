@@ -0,0 +1,57 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <librealsense2/h/rs_frame.h>
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+
+namespace librealsense {
+
+
+class frame;
+
+
+// Appends the metadata of the frames of a sensor to columns, and hands them on in batches of 'batch_size' frames,
+// as an rs2_metadata_batch. The columns are allocated once, up front, and reused for every batch.
+//
+// Frames are appended by whatever threads the sensor's frames come on; a batch is handed on from the thread of the
+// frame that fills it, and frames from other threads wait meanwhile.
+//
+class metadata_sink
+{
+public:
+    typedef std::function< void( rs2_metadata_batch const & ) > callback;
+
+    metadata_sink( int batch_size, callback cb );
+
+    // The metadata of 'f', from its metadata table (see frame::get_metadata_table)
+    void append( frame const & f );
+
+    // Hands on what was appended since the last batch, if anything
+    void flush();
+
+private:
+    void hand_on();  // with _mutex held
+
+    size_t _batch_size;
+    size_t _bitmap_size;  // Bytes per validity bitmap: padded to 64, as Arrow recommends
+    callback _callback;
+
+    std::mutex _mutex;
+    size_t _rows = 0;
+    std::vector< int > _stream;
+    std::vector< int > _index;
+    std::vector< unsigned long long > _frame_number;
+    std::vector< double > _timestamp;
+    std::vector< rs2_metadata_type > _values;  // A column of _batch_size per metadata, one after the other
+    std::vector< uint8_t > _validity;          // A bitmap per metadata, likewise
+    int _null_count[RS2_FRAME_METADATA_COUNT];
+};
+
+
+}  // namespace librealsense
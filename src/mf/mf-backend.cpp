@@ -19,6 +19,7 @@
 #include <dbt.h>
 #include <cctype> // std::tolower
 #include <rsutils/time/timer.h>
+#include <rsutils/os/thread.h>
 
 namespace {
 
@@ -197,7 +198,10 @@ namespace librealsense
                 _last = backend_device_group( _backend->query_uvc_devices(),
                                               _backend->query_usb_devices(),
                                               _backend->query_hid_devices() );
-                _thread = std::thread([this]() { run(); });
+                _thread = std::thread([this]() {
+                    rsutils::os::init_thread("device-watcher");
+                    run();
+                });
             }
 
             void stop() override
@@ -187,6 +187,7 @@ namespace librealsense
                 }
                 owner->_has_started.set();
 
+                // A request for each one that completes, first thing, so the read-ahead holds whatever the callback does
                 LOG_HR(owner->_reader->ReadSample(dwStreamIndex, 0, nullptr, nullptr, nullptr, nullptr));
 
                 if (!owner->_is_started)
@@ -208,17 +209,26 @@ namespace librealsense
 #endif
                             try
                             {
-                                auto& stream = owner->_streams[dwStreamIndex];
-                                std::lock_guard<std::mutex> lock(owner->_streams_mutex);
-                                auto profile = stream.profile;
+                                std::shared_ptr<const profile_and_callback> stream;
+                                if (dwStreamIndex < owner->_deliveries.size())
+                                    stream = std::atomic_load(&owner->_deliveries[dwStreamIndex]);
+                                if (!stream || !stream->callback)
+                                {
+                                    buffer->Unlock();
+                                    return S_OK;
+                                }
                                 frame_object f{ current_length, metadata_size, byte_buffer, metadata, monotonic_to_realtime(llTimestamp/10000.f) };
 
-                                auto continuation = [buffer, this]()
+                                // The sample and its buffer stay referenced, and locked, until the continuation: with
+                                // zero-copy frames (see uvc_sensor), that's when the frame is released, its data
+                                // the buffer's own; otherwise it's right after the data is copied
+                                CComPtr<IMFSample> held_sample = sample;
+                                auto continuation = [buffer, held_sample]()
                                 {
                                     buffer->Unlock();
                                 };
 
-                                stream.callback(profile, f, continuation);
+                                stream->callback(stream->profile, f, continuation);
                             }
                             catch (...)
                             {
@@ -868,6 +878,7 @@ namespace librealsense
             if (!_reader_attrs)
                 _reader_attrs = create_reader_attrs();
             _streams.resize(_streamIndex);
+            _deliveries.resize(_streamIndex);
 
             //enable source
             CHECK_HR(MFCreateDeviceSource(_device_attrs, &_source));
@@ -894,6 +905,8 @@ namespace librealsense
             safe_release(_source);
             for (auto& elem : _streams)
                 elem.callback = nullptr;
+            for (size_t i = 0; i < _deliveries.size(); ++i)
+                publish_delivery(i);
             _power_state = D3;
         }
 
@@ -1014,10 +1027,12 @@ namespace librealsense
 
                                     _streams[mfp.index].profile = profile;
                                     _streams[mfp.index].callback = callback;
+                                    publish_delivery(mfp.index);
                                 }
 
                                 _readsample_result = S_OK;
-                                CHECK_HR(_reader->ReadSample(mfp.index, 0, nullptr, nullptr, nullptr, nullptr));
+                                for (int i = 0; i < _read_ahead; ++i)
+                                    CHECK_HR(_reader->ReadSample(mfp.index, 0, nullptr, nullptr, nullptr, nullptr));
 
                                 const auto timeout_ms = RS2_DEFAULT_TIMEOUT;
                                 if (_has_started.wait(timeout_ms))
@@ -1098,11 +1113,26 @@ namespace librealsense
             }
         }
 
+        void wmf_uvc_device::set_read_ahead(int count)
+        {
+            _read_ahead = std::max(1, std::min(count, int(MAX_READ_AHEAD)));
+        }
+
         void wmf_uvc_device::start_callbacks()
         {
             _is_started = true;
         }
 
+        void wmf_uvc_device::publish_delivery(size_t stream_index)
+        {
+            if (stream_index >= _deliveries.size())
+                return;
+            std::shared_ptr<const profile_and_callback> delivery;
+            if (stream_index < _streams.size() && _streams[stream_index].callback)
+                delivery = std::make_shared<const profile_and_callback>(_streams[stream_index]);
+            std::atomic_store(&_deliveries[stream_index], delivery);
+        }
+
         void wmf_uvc_device::stop_callbacks()
         {
             _is_started = false;
@@ -1117,6 +1147,7 @@ namespace librealsense
                 elem->profile.fps = 0;
                 elem->profile.width = 0;
                 elem->profile.height = 0;
+                publish_delivery(elem - _streams.begin());
             }
 
             auto pos = std::find(_profiles.begin(), _profiles.end(), profile) - _profiles.begin();
@@ -13,6 +13,7 @@
 #include <Ks.h>
 #include <ksproxy.h>
 #include <unordered_map>
+#include <memory>
 #include <mutex>
 #include <atomic>
 
@@ -38,6 +39,10 @@ namespace librealsense
     {
         class wmf_backend;
 
+        // ReadSample requests outstanding per stream, unless set otherwise (see set_read_ahead)
+        const int DEFAULT_READ_AHEAD = 2;
+        const int MAX_READ_AHEAD = 8;
+
         struct profile_and_callback
         {
             stream_profile profile;
@@ -72,6 +77,7 @@ namespace librealsense
             void start_callbacks() override;
             void stop_callbacks() override;
             void close(stream_profile profile) override;
+            void set_read_ahead(int count) override;
             void set_power_state(power_state state) override;
             power_state get_power_state() const override { return _power_state; }
             std::vector<stream_profile> get_profiles() const override;
@@ -132,10 +138,17 @@ namespace librealsense
             auto_reset_event                        _is_flushed;
             manual_reset_event                      _has_started;
             HRESULT                                 _readsample_result = S_OK;
+            // ReadSample requests a stream has outstanding: each sample that completes one issues the next, so they
+            // stay queued in the source reader while the callback of the last is running
+            int                                     _read_ahead = DEFAULT_READ_AHEAD;
 
             uint16_t                                _streamIndex;
             std::vector<profile_and_callback>       _streams;
             std::mutex                              _streams_mutex;
+            // What OnReadSample delivers samples of each stream to, without locking: a copy of the stream's
+            // profile_and_callback, replaced with std::atomic_store when streaming starts or stops (null when not)
+            std::vector<std::shared_ptr<const profile_and_callback>> _deliveries;
+            void publish_delivery(size_t stream_index);
 
             named_mutex                             _systemwide_lock;
             std::string                             _location;
@@ -0,0 +1,119 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "motion-history.h"
+#include "librealsense-exception.h"
+
+#include <rsutils/string/from.h>
+
+#include <algorithm>
+
+
+namespace librealsense {
+
+
+motion_history::motion_history()
+{
+    _gyro.samples.resize( capacity );
+    _accel.samples.resize( capacity );
+}
+
+
+motion_history::ring & motion_history::ring_of( rs2_stream stream )
+{
+    switch( stream )
+    {
+    case RS2_STREAM_GYRO: return _gyro;
+    case RS2_STREAM_ACCEL: return _accel;
+    default:
+        throw invalid_value_exception( rsutils::string::from() << "no motion history for "
+                                                               << rs2_stream_to_string( stream ) );
+    }
+}
+
+
+size_t motion_history::ring::find( double timestamp, bool inclusive ) const
+{
+    size_t lo = 0, hi = size;
+    while( lo < hi )
+    {
+        auto mid = lo + ( hi - lo ) / 2;
+        auto t = ( *this )[mid].timestamp;
+        if( t < timestamp || ( ! inclusive && t == timestamp ) )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+
+void motion_history::add( rs2_stream stream, double timestamp, rs2_timestamp_domain domain, const float xyz[3] )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    auto & r = ring_of( stream );
+    if( r.domain != domain || ( r.size && timestamp < r[r.size - 1].timestamp ) )
+    {
+        r.first = r.size = 0;
+        r.domain = domain;
+    }
+
+    rs2_motion_sample * s;
+    if( r.size < r.samples.size() )
+        s = &r.samples[( r.first + r.size++ ) % r.samples.size()];
+    else
+    {
+        s = &r.samples[r.first];
+        r.first = ( r.first + 1 ) % r.samples.size();
+    }
+    s->timestamp = timestamp;
+    std::copy( xyz, xyz + 3, s->xyz );
+}
+
+
+void motion_history::clear()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    _gyro.first = _gyro.size = 0;
+    _accel.first = _accel.size = 0;
+}
+
+
+bool motion_history::get_at( rs2_stream stream, double timestamp, rs2_motion_sample & sample,
+                             rs2_motion_sample & before, rs2_motion_sample & after ) const
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    auto & r = ring_of( stream );
+    auto i = r.find( timestamp, true );
+    if( i == r.size || ( i == 0 && r[0].timestamp != timestamp ) )
+        return false;
+
+    after = r[i];
+    before = after.timestamp == timestamp ? after : r[i - 1];
+    sample = before;
+    sample.timestamp = timestamp;
+    auto dt = after.timestamp - before.timestamp;
+    if( dt > 0 )
+    {
+        auto w = float( ( timestamp - before.timestamp ) / dt );
+        for( int k = 0; k < 3; ++k )
+            sample.xyz[k] = before.xyz[k] + w * ( after.xyz[k] - before.xyz[k] );
+    }
+    return true;
+}
+
+
+size_t motion_history::get_range( rs2_stream stream, double from, double to, rs2_motion_sample * samples,
+                                  size_t count ) const
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    auto & r = ring_of( stream );
+    auto begin = r.find( from, true );
+    auto end = std::max( begin, r.find( to, false ) );
+    for( size_t i = begin; i < end && i - begin < count; ++i )
+        samples[i - begin] = r[i];
+    return end - begin;
+}
+
+
+}  // namespace librealsense
@@ -0,0 +1,61 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <librealsense2/h/rs_sensor.h>
+
+#include <mutex>
+#include <vector>
+
+
+namespace librealsense {
+
+
+// The last samples of the gyro and accel streams of a motion sensor, as they were delivered (calibrated, in the
+// depth's axes), for querying by time (see rs2_get_motion_at). Each stream has a ring allocated once: adding a sample
+// allocates nothing, and the oldest make room for the new ones. The samples come in the order of their timestamps, so
+// queries are binary searches.
+//
+// A ring starts over when its timestamp domain changes or its timestamps go back, as when the stream restarts.
+//
+// Samples are added from the processing threads, queries come from anywhere.
+//
+class motion_history
+{
+public:
+    // Per stream: 4 seconds at 1 kHz
+    static const size_t capacity = 4096;
+
+    motion_history();
+
+    void add( rs2_stream, double timestamp, rs2_timestamp_domain, const float xyz[3] );
+    void clear();
+
+    // Linearly interpolated between the samples on either side of 'timestamp', which are also returned; false if the
+    // samples kept don't reach that far, either way
+    bool get_at( rs2_stream, double timestamp, rs2_motion_sample & sample, rs2_motion_sample & before,
+                 rs2_motion_sample & after ) const;
+
+    // The samples within [from, to], up to 'count' of them, oldest first; returns how many there are in all
+    size_t get_range( rs2_stream, double from, double to, rs2_motion_sample * samples, size_t count ) const;
+
+private:
+    struct ring
+    {
+        std::vector< rs2_motion_sample > samples;
+        size_t first = 0, size = 0;
+        rs2_timestamp_domain domain = RS2_TIMESTAMP_DOMAIN_COUNT;
+
+        const rs2_motion_sample & operator[]( size_t i ) const { return samples[( first + i ) % samples.size()]; }
+        // The first sample after 'timestamp' (or at it, if 'inclusive')
+        size_t find( double timestamp, bool inclusive ) const;
+    };
+    ring & ring_of( rs2_stream );
+    const ring & ring_of( rs2_stream stream ) const { return const_cast< motion_history * >( this )->ring_of( stream ); }
+
+    mutable std::mutex _mutex;
+    ring _gyro, _accel;
+};
+
+
+}  // namespace librealsense
@@ -0,0 +1,210 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_OPENCL
+
+#include "opencl-conversion.h"
+#include "opencl-device.h"
+
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <mutex>
+#include <string>
+
+
+namespace librealsense {
+namespace opencl {
+
+
+// One work item per pixel, with the integer math of the generic CPU code. The FORMAT_* are the rs2_format values,
+// defined when building.
+static char const * conversion_source = R"__(
+void write_pixel( global uchar * d, uint i, uint format, int y, int u, int v )
+{
+    if( format == FORMAT_Y8 )
+    {
+        d[i] = (uchar)y;
+        return;
+    }
+    if( format == FORMAT_Y16 )  // Y << 8
+    {
+        d[i * 2] = 0;
+        d[i * 2 + 1] = (uchar)y;
+        return;
+    }
+
+    int c = y - 16, dd = u - 128, e = v - 128;
+    uchar r = (uchar)clamp( ( 298 * c + 409 * e + 128 ) >> 8, 0, 255 );
+    uchar g = (uchar)clamp( ( 298 * c - 100 * dd - 208 * e + 128 ) >> 8, 0, 255 );
+    uchar b = (uchar)clamp( ( 298 * c + 516 * dd + 128 ) >> 8, 0, 255 );
+    if( format == FORMAT_BGR8 || format == FORMAT_BGRA8 )
+    {
+        uchar t = r;
+        r = b;
+        b = t;
+    }
+    if( format == FORMAT_RGB8 || format == FORMAT_BGR8 )
+    {
+        d[i * 3] = r;
+        d[i * 3 + 1] = g;
+        d[i * 3 + 2] = b;
+    }
+    else
+    {
+        d[i * 4] = r;
+        d[i * 4 + 1] = g;
+        d[i * 4 + 2] = b;
+        d[i * 4 + 3] = 255;
+    }
+}
+
+// Y0 U Y1 V
+kernel void unpack_yuy2( global const uchar * s, global uchar * d, uint format )
+{
+    uint i = get_global_id( 0 );
+    global const uchar * pair = s + ( i & ~1u ) * 2;
+    write_pixel( d, i, format, s[i * 2], pair[1], pair[3] );
+}
+
+// U Y0 V Y1
+kernel void unpack_uyvy( global const uchar * s, global uchar * d, uint format )
+{
+    uint i = get_global_id( 0 );
+    global const uchar * pair = s + ( i & ~1u ) * 2;
+    write_pixel( d, i, format, s[i * 2 + 1], pair[0], pair[2] );
+}
+
+// Two lines of Y, then a line of U,V pairs for both, each for two pixels across
+kernel void unpack_m420( global const uchar * s, global uchar * d, uint format )
+{
+    uint x = get_global_id( 0 ), y = get_global_id( 1 ), width = get_global_size( 0 );
+    global const uchar * lines = s + ( y / 2 ) * 3 * width;
+    global const uchar * uv = lines + 2 * width + ( x & ~1u );
+    write_pixel( d, y * width + x, format, lines[( y & 1 ) * width + x], uv[0], uv[1] );
+}
+)__";
+
+
+// Built once, for all the threads to make their kernels from; null if it couldn't be
+static cl_program conversion_program( std::shared_ptr< device > const & dev )
+{
+    static std::mutex mutex;
+    static cl_program the_program = nullptr;
+    static bool tried = false;
+
+    std::lock_guard< std::mutex > lock( mutex );
+    if( ! tried )
+    {
+        tried = true;
+        std::string options = "-DFORMAT_Y8=" + std::to_string( RS2_FORMAT_Y8 )
+                            + " -DFORMAT_Y16=" + std::to_string( RS2_FORMAT_Y16 )
+                            + " -DFORMAT_RGB8=" + std::to_string( RS2_FORMAT_RGB8 )
+                            + " -DFORMAT_BGR8=" + std::to_string( RS2_FORMAT_BGR8 )
+                            + " -DFORMAT_RGBA8=" + std::to_string( RS2_FORMAT_RGBA8 )
+                            + " -DFORMAT_BGRA8=" + std::to_string( RS2_FORMAT_BGRA8 );
+        try
+        {
+            the_program = dev->build( conversion_source, options );
+        }
+        catch( std::exception const & e )
+        {
+            LOG_ERROR( "OpenCL conversions unavailable; converting on the CPU: " << e.what() );
+        }
+    }
+    return the_program;
+}
+
+
+static size_t bytes_per_pixel( rs2_format format )
+{
+    switch( format )
+    {
+    case RS2_FORMAT_Y8: return 1;
+    case RS2_FORMAT_Y16: return 2;
+    case RS2_FORMAT_RGB8:
+    case RS2_FORMAT_BGR8: return 3;
+    case RS2_FORMAT_RGBA8:
+    case RS2_FORMAT_BGRA8: return 4;
+    default: return 0;
+    }
+}
+
+
+enum conversion
+{
+    YUY2,
+    UYVY,
+    M420,
+    CONVERSION_COUNT
+};
+
+
+static bool convert( conversion what, rs2_format format, uint8_t * const d[], const uint8_t * s, int width, int height )
+{
+    static char const * const names[CONVERSION_COUNT] = { "unpack_yuy2", "unpack_uyvy", "unpack_m420" };
+
+    auto bpp = bytes_per_pixel( format );
+    if( ! bpp )
+        return false;
+    auto dev = device::get();
+    if( ! dev )
+        return false;
+    auto program = conversion_program( dev );
+    if( ! program )
+        return false;
+
+    // The conversions run on the sensors' threads, each with kernels of its own
+    thread_local std::shared_ptr< kernel > the_kernels[CONVERSION_COUNT];
+    auto & k = the_kernels[what];
+
+    auto const n = size_t( width ) * height;
+    auto const source_size = what == M420 ? n * 3 / 2 : n * 2;
+    try
+    {
+        if( ! k )
+            k = std::make_shared< kernel >( dev, program, names[what] );
+
+        host_memory source( dev, s, source_size, false );
+        host_memory dest( dev, d[0], n * bpp, true );
+        source.set_as( *k, 0 );
+        dest.set_as( *k, 1 );
+        k->set( 2, cl_uint( format ) );
+        if( what == M420 )
+            k->run( { size_t( width ), size_t( height ) } );
+        else
+            k->run( { n } );
+        dest.sync();
+    }
+    catch( std::exception const & e )
+    {
+        LOG_ERROR( "OpenCL " << names[what] << " failed; converting on the CPU: " << e.what() );
+        return false;
+    }
+    return true;
+}
+
+
+bool unpack_yuy2( rs2_format format, uint8_t * const d[], const uint8_t * s, int width, int height )
+{
+    return convert( YUY2, format, d, s, width, height );
+}
+
+
+bool unpack_uyvy( rs2_format format, uint8_t * const d[], const uint8_t * s, int width, int height )
+{
+    if( format == RS2_FORMAT_Y8 || format == RS2_FORMAT_Y16 )
+        return false;
+    return convert( UYVY, format, d, s, width, height );
+}
+
+
+bool unpack_m420( rs2_format format, uint8_t * const d[], const uint8_t * s, int width, int height )
+{
+    return convert( M420, format, d, s, width, height );
+}
+
+
+}  // namespace opencl
+}  // namespace librealsense
+
+#endif  // RS2_USE_OPENCL
@@ -0,0 +1,26 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#ifdef RS2_USE_OPENCL
+
+#include <librealsense2/h/rs_sensor.h>
+
+#include <cstdint>
+
+
+namespace librealsense {
+namespace opencl {
+
+
+// The color conversions, on the OpenCL device, into 'format' (Y8, Y16, RGB8, BGR8, RGBA8 or BGRA8; UYVY has no Y8
+// or Y16). False when there's no device, or the format isn't one of those, for the CPU to do it.
+bool unpack_yuy2( rs2_format format, uint8_t * const d[], const uint8_t * s, int width, int height );
+bool unpack_uyvy( rs2_format format, uint8_t * const d[], const uint8_t * s, int width, int height );
+bool unpack_m420( rs2_format format, uint8_t * const d[], const uint8_t * s, int width, int height );
+
+
+}  // namespace opencl
+}  // namespace librealsense
+
+#endif  // RS2_USE_OPENCL
@@ -0,0 +1,273 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_OPENCL
+
+#include "opencl-device.h"
+
+#include <rsutils/easylogging/easyloggingpp.h>
+#include <rsutils/json.h>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+
+namespace librealsense {
+namespace opencl {
+
+
+static bool the_enabled = true;
+static int the_platform_index = -1;  // With the device, below
+static int the_device_index = -1;    // The first GPU that shares memory with the host, or else the first GPU
+
+
+void configure( rsutils::json const & settings )
+{
+    the_enabled = settings.nested( "enabled" ).default_value( true );
+    the_platform_index = settings.nested( "platform" ).default_value( -1 );
+    the_device_index = settings.nested( "device" ).default_value( -1 );
+}
+
+
+static void check( cl_int res, char const * what )
+{
+    if( res != CL_SUCCESS )
+        throw std::runtime_error( std::string( what ) + " failed: cl_int " + std::to_string( res ) );
+}
+
+
+static std::vector< cl_device_id > gpus_of( cl_platform_id platform )
+{
+    cl_uint count = 0;
+    if( clGetDeviceIDs( platform, CL_DEVICE_TYPE_GPU, 0, nullptr, &count ) != CL_SUCCESS )
+        return {};
+    std::vector< cl_device_id > ids( count );
+    clGetDeviceIDs( platform, CL_DEVICE_TYPE_GPU, count, ids.data(), nullptr );
+    return ids;
+}
+
+
+static std::shared_ptr< device > create_device()
+{
+    cl_uint count = 0;
+    if( clGetPlatformIDs( 0, nullptr, &count ) != CL_SUCCESS )
+        count = 0;
+    std::vector< cl_platform_id > platforms( count );
+    if( count )
+        clGetPlatformIDs( count, platforms.data(), nullptr );
+
+    if( the_platform_index >= 0 || the_device_index >= 0 )
+    {
+        int const p = std::max( the_platform_index, 0 );
+        int const d = std::max( the_device_index, 0 );
+        if( p < int( platforms.size() ) )
+        {
+            auto gpus = gpus_of( platforms[p] );
+            if( d < int( gpus.size() ) )
+                return std::make_shared< device >( platforms[p], gpus[d] );
+        }
+        LOG_ERROR( "invalid OpenCL platform " << p << " device " << d
+                                              << " in the context settings; converting on the CPU" );
+        return nullptr;
+    }
+
+    // An integrated GPU works on the frames' memory as is, so it's preferred
+    std::pair< cl_platform_id, cl_device_id > first( nullptr, nullptr );
+    for( auto platform : platforms )
+    {
+        for( auto id : gpus_of( platform ) )
+        {
+            cl_bool unified = CL_FALSE;
+            clGetDeviceInfo( id, CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof( unified ), &unified, nullptr );
+            if( unified )
+                return std::make_shared< device >( platform, id );
+            if( ! first.second )
+                first = { platform, id };
+        }
+    }
+    if( ! first.second )
+    {
+        LOG_INFO( "no OpenCL GPU; converting on the CPU" );
+        return nullptr;
+    }
+    return std::make_shared< device >( first.first, first.second );
+}
+
+
+/*static*/ std::shared_ptr< device > device::get()
+{
+    static std::mutex mutex;
+    static std::shared_ptr< device > the_device;
+    static bool tried = false;
+
+    std::lock_guard< std::mutex > lock( mutex );
+    if( ! tried && the_enabled )
+    {
+        tried = true;
+        try
+        {
+            the_device = create_device();
+        }
+        catch( std::exception const & e )
+        {
+            LOG_ERROR( "failed to initialize OpenCL; converting on the CPU: " << e.what() );
+        }
+    }
+    return the_device;
+}
+
+
+device::device( cl_platform_id platform, cl_device_id id )
+    : _id( id )
+{
+    cl_context_properties props[] = { CL_CONTEXT_PLATFORM, cl_context_properties( platform ), 0 };
+    cl_int res;
+    _context = clCreateContext( props, 1, &_id, nullptr, nullptr, &res );
+    check( res, "clCreateContext" );
+    _queue = clCreateCommandQueue( _context, _id, 0, &res );
+    if( res != CL_SUCCESS )
+    {
+        clReleaseContext( _context );
+        check( res, "clCreateCommandQueue" );
+    }
+
+#ifdef CL_VERSION_2_0
+    // Fails on 1.2 devices, which have no SVM
+    cl_device_svm_capabilities svm = 0;
+    if( clGetDeviceInfo( _id, CL_DEVICE_SVM_CAPABILITIES, sizeof( svm ), &svm, nullptr ) == CL_SUCCESS )
+        _system_svm = ( svm & CL_DEVICE_SVM_FINE_GRAIN_SYSTEM ) != 0;
+#endif
+
+    char name[256] = {};
+    clGetDeviceInfo( _id, CL_DEVICE_NAME, sizeof( name ) - 1, name, nullptr );
+    LOG_INFO( "OpenCL conversions on " << name << ( _system_svm ? ", with system SVM" : "" ) );
+}
+
+
+device::~device()
+{
+    clReleaseCommandQueue( _queue );
+    clReleaseContext( _context );
+}
+
+
+cl_program device::build( char const * source, std::string const & options ) const
+{
+    cl_int res;
+    auto program = clCreateProgramWithSource( _context, 1, &source, nullptr, &res );
+    check( res, "clCreateProgramWithSource" );
+    res = clBuildProgram( program, 1, &_id, options.c_str(), nullptr, nullptr );
+    if( res != CL_SUCCESS )
+    {
+        size_t size = 0;
+        clGetProgramBuildInfo( program, _id, CL_PROGRAM_BUILD_LOG, 0, nullptr, &size );
+        std::string log( size, '\0' );
+        clGetProgramBuildInfo( program, _id, CL_PROGRAM_BUILD_LOG, size, &log[0], nullptr );
+        clReleaseProgram( program );
+        throw std::runtime_error( "failed to build OpenCL program: " + log );
+    }
+    return program;
+}
+
+
+kernel::kernel( std::shared_ptr< device > const & dev, cl_program program, char const * name )
+    : _device( dev )
+{
+    cl_int res;
+    _kernel = clCreateKernel( program, name, &res );
+    check( res, "clCreateKernel" );
+}
+
+
+kernel::~kernel()
+{
+    clReleaseKernel( _kernel );
+}
+
+
+void kernel::set( cl_uint index, size_t size, void const * value )
+{
+    check( clSetKernelArg( _kernel, index, size, value ), "clSetKernelArg" );
+}
+
+
+void kernel::run( std::initializer_list< size_t > global )
+{
+    check( clEnqueueNDRangeKernel( _device->queue(),
+                                   _kernel,
+                                   cl_uint( global.size() ),
+                                   nullptr,
+                                   global.begin(),
+                                   nullptr,
+                                   0,
+                                   nullptr,
+                                   nullptr ),
+           "clEnqueueNDRangeKernel" );
+}
+
+
+host_memory::host_memory( std::shared_ptr< device > const & dev, void const * data, size_t size, bool written )
+    : _device( dev )
+    , _data( const_cast< void * >( data ) )
+    , _size( size )
+{
+    if( _device->shares_system_memory() )
+        return;
+
+    // The kernels only read the input, and only write the output: the driver has nothing to copy back and forth
+    cl_int res;
+    _buffer = clCreateBuffer( _device->context(),
+                              ( written ? CL_MEM_WRITE_ONLY : CL_MEM_READ_ONLY ) | CL_MEM_USE_HOST_PTR,
+                              _size,
+                              _data,
+                              &res );
+    check( res, "clCreateBuffer" );
+}
+
+
+host_memory::~host_memory()
+{
+    // Released once what's enqueued with it is done
+    if( _buffer )
+        clReleaseMemObject( _buffer );
+}
+
+
+void host_memory::set_as( kernel & k, cl_uint index )
+{
+#ifdef CL_VERSION_2_0
+    if( ! _buffer )
+    {
+        check( clSetKernelArgSVMPointer( k.handle(), index, _data ), "clSetKernelArgSVMPointer" );
+        return;
+    }
+#endif
+    k.set( index, _buffer );
+}
+
+
+void host_memory::sync()
+{
+    if( ! _buffer )
+    {
+        check( clFinish( _device->queue() ), "clFinish" );
+        return;
+    }
+
+    // Mapping a buffer over host memory is where the driver makes that memory current: a copy only when it didn't
+    // use it in place
+    cl_int res;
+    auto mapped
+        = clEnqueueMapBuffer( _device->queue(), _buffer, CL_TRUE, CL_MAP_READ, 0, _size, 0, nullptr, nullptr, &res );
+    check( res, "clEnqueueMapBuffer" );
+    check( clEnqueueUnmapMemObject( _device->queue(), _buffer, mapped, 0, nullptr, nullptr ),
+           "clEnqueueUnmapMemObject" );
+}
+
+
+}  // namespace opencl
+}  // namespace librealsense
+
+#endif  // RS2_USE_OPENCL
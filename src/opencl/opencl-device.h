@@ -0,0 +1,120 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#ifdef RS2_USE_OPENCL
+
+#include <rsutils/json-fwd.h>
+
+#ifdef __APPLE__
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+
+namespace librealsense {
+namespace opencl {
+
+
+// The "opencl" context settings:
+//     "opencl": { "enabled": true, "platform": 0, "device": 0 }
+// By default, the first GPU that shares memory with the host (an integrated one) is used, or else the first GPU
+void configure( rsutils::json const & settings );
+
+
+// An OpenCL device, with a context and an in-order queue of its own. Made when it's first asked for.
+class device
+{
+public:
+    // The device of the context settings, or null when there's none (or OpenCL is disabled), for the conversions to
+    // be done on the CPU
+    static std::shared_ptr< device > get();
+
+    device( cl_platform_id platform, cl_device_id id );
+    ~device();
+
+    device( device const & ) = delete;
+    device & operator=( device const & ) = delete;
+
+    cl_device_id id() const { return _id; }
+    cl_context context() const { return _context; }
+    cl_command_queue queue() const { return _queue; }
+
+    // Whether the device can use any host memory as is, with no buffer over it: fine-grained system SVM
+    bool shares_system_memory() const { return _system_svm; }
+
+    // Builds a program from its source; throws, with the build log, if it doesn't build
+    cl_program build( char const * source, std::string const & options ) const;
+
+private:
+    cl_device_id _id;
+    cl_context _context = nullptr;
+    cl_command_queue _queue = nullptr;
+    bool _system_svm = false;
+};
+
+
+// A kernel of a program; like any cl_kernel, its arguments are set per call, so it's not thread-safe
+class kernel
+{
+public:
+    kernel( std::shared_ptr< device > const & dev, cl_program program, char const * name );
+    ~kernel();
+
+    kernel( kernel const & ) = delete;
+    kernel & operator=( kernel const & ) = delete;
+
+    cl_kernel handle() const { return _kernel; }
+
+    template< class T >
+    void set( cl_uint index, T const & value )
+    {
+        set( index, sizeof( T ), &value );
+    }
+    void set( cl_uint index, size_t size, void const * value );
+
+    // Enqueues the kernel over 'global' work items, in one or more dimensions
+    void run( std::initializer_list< size_t > global );
+
+private:
+    std::shared_ptr< device > _device;
+    cl_kernel _kernel = nullptr;
+};
+
+
+// Host memory a kernel reads or writes, without copying it where the driver allows:
+//   - with fine-grained system SVM, the pointer itself is the argument
+//   - otherwise, a CL_MEM_USE_HOST_PTR buffer over it: on a GPU that shares memory with the host, the driver uses the
+//     memory in place (when suitably aligned, 4KB for Intel's)
+class host_memory
+{
+public:
+    host_memory( std::shared_ptr< device > const & dev, void const * data, size_t size, bool written );
+    ~host_memory();
+
+    host_memory( host_memory const & ) = delete;
+    host_memory & operator=( host_memory const & ) = delete;
+
+    void set_as( kernel & k, cl_uint index );
+
+    // Waits for the kernels before it, and makes what they wrote visible on the host
+    void sync();
+
+private:
+    std::shared_ptr< device > _device;
+    void * _data;
+    size_t _size;
+    cl_mem _buffer = nullptr;
+};
+
+
+}  // namespace opencl
+}  // namespace librealsense
+
+#endif  // RS2_USE_OPENCL
@@ -329,6 +329,11 @@ namespace librealsense
             return  _proxy->is_read_only();
         }
 
+        rsutils::subscription on_value_changed( std::function< void() > && cb ) override
+        {
+            return _proxy->on_value_changed( std::move( cb ) );
+        }
+
         void enable_recording(std::function<void(const option&)> record_action) override
         {
             _recording_function = record_action;
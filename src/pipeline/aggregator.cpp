@@ -6,23 +6,75 @@
 #include "aggregator.h"
 #include <src/composite-frame.h>
 #include <src/core/frame-processor-callback.h>
+#include <src/low-latency.h>
+#include <src/frame-trace.h>
 
 namespace librealsense
 {
     namespace pipeline
     {
-        aggregator::aggregator(const std::vector<int>& streams_to_aggregate, const std::vector<int>& streams_to_sync) :
+        aggregator::aggregator(const std::vector<int>& streams_to_aggregate, const std::vector<int>& streams_to_sync,
+                               unsigned queue_size, bool latest_only, unsigned imu_queue_size) :
             processing_block("aggregator"),
-            _queue(new single_consumer_frame_queue<frame_holder>(1)),
+            _queue(new single_consumer_frame_queue<frame_holder>(std::max(1u, queue_size), nullptr,
+                                                                 low_latency_settings::get().enabled,
+                                                                 low_latency_settings::get().busy_poll)),
             _streams_to_aggregate_ids(streams_to_aggregate),
             _streams_to_sync_ids(streams_to_sync),
-            _accepting(true)
+            _accepting(true),
+            _latest_only(latest_only),
+            _imu_queue_size(std::max(1u, imu_queue_size)),
+            _fresh(false),
+            _source(nullptr)
         {
             set_processing_callback(
                 make_frame_processor_callback( [&]( frame_holder && frame, synthetic_source_interface * source )
                                                { handle_frame( std::move( frame ), source ); } ) );
         }
 
+        static bool is_motion(const frame_holder& f)
+        {
+            auto type = f->peek_stream()->get_stream_type();
+            return type == RS2_STREAM_ACCEL || type == RS2_STREAM_GYRO;
+        }
+
+        void aggregator::keep_latest(frame_holder& f)
+        {
+            auto id = f->peek_stream()->get_unique_id();
+            if (_latest_only && is_motion(f))
+            {
+                auto& samples = _imu_samples[id];
+                if (samples.size() >= _imu_queue_size)
+                    samples.pop_front();
+                samples.push_back(f.clone());
+            }
+            _last_set[id] = std::move(f);
+        }
+
+        void aggregator::take_latest(frame_holder* item)
+        {
+            // The motion streams bring all their samples since the last set, in order, or their latest one
+            _sync_set.clear();
+            for (auto&& s : _last_set)
+            {
+                auto samples = _imu_samples.find(s.first);
+                if (samples != _imu_samples.end() && !samples->second.empty())
+                {
+                    for (auto&& sample : samples->second)
+                        _sync_set.push_back(std::move(sample));
+                    samples->second.clear();
+                }
+                else
+                    _sync_set.push_back(s.second.clone());
+            }
+            _fresh = false;
+
+            *item = _source->allocate_composite_frame(_sync_set.data(), _sync_set.size());
+            _sync_set.clear();
+            if (!*item)
+                LOG_ERROR("Failed to allocate composite frame");
+        }
+
         void aggregator::handle_frame(frame_holder frame, synthetic_source_interface* source)
         {
             if (!_accepting) {
@@ -32,7 +84,8 @@ namespace librealsense
 //                std::this_thread::sleep_for(std::chrono::milliseconds(10));
                 return;
             }
-            std::lock_guard<std::mutex> lock(_mutex);
+            std::unique_lock<std::mutex> lock(_mutex);
+            _source = source;
             auto comp = dynamic_cast<composite_frame*>(frame.frame);
             if (comp)
             {
@@ -40,7 +93,8 @@ namespace librealsense
                 {
                     auto f = comp->get_frame(i);
                     f->acquire();
-                    _last_set[f->get_stream()->get_unique_id()] = f;
+                    frame_holder fh(f);
+                    keep_latest(fh);
                 }
 
                 // in case not all required streams were aggregated don't publish the frame set
@@ -50,21 +104,39 @@ namespace librealsense
                         return;
                 }
 
+                if (_latest_only)
+                {
+                    // The set is made when it's asked for; the callback gets the synchronized frames as usual
+                    for (auto&& s : _last_set)
+                        if (std::find(_streams_to_sync_ids.begin(), _streams_to_sync_ids.end(), s.first) != _streams_to_sync_ids.end())
+                            _async_set.push_back(s.second.clone());
+                    frame_holder async_fref = source->allocate_composite_frame(_async_set.data(), _async_set.size());
+                    _async_set.clear();
+                    _fresh = true;
+                    lock.unlock();
+                    _fresh_cv.notify_one();
+                    if (async_fref)
+                        source->frame_ready(std::move(async_fref));
+                    return;
+                }
+
                 // prepare the output frame set for wait_for_frames/poll_frames calls
-                std::vector<frame_holder> sync_set;
+                _sync_set.clear();
                 // prepare the output frame set for the callbacks
-                std::vector<frame_holder> async_set;
+                _async_set.clear();
                 for (auto&& s : _last_set)
                 {
-                    sync_set.push_back(s.second.clone());
+                    _sync_set.push_back(s.second.clone());
                     // send only the synchronized frames to the user callback
                     if (std::find(_streams_to_sync_ids.begin(), _streams_to_sync_ids.end(),
-                        s.second->get_stream()->get_unique_id()) != _streams_to_sync_ids.end())
-                        async_set.push_back(s.second.clone());
+                        s.second->peek_stream()->get_unique_id()) != _streams_to_sync_ids.end())
+                        _async_set.push_back(s.second.clone());
                 }
 
-                frame_holder sync_fref = source->allocate_composite_frame(std::move(sync_set));
-                frame_holder async_fref = source->allocate_composite_frame(std::move(async_set));
+                frame_holder sync_fref = source->allocate_composite_frame(_sync_set.data(), _sync_set.size());
+                frame_holder async_fref = source->allocate_composite_frame(_async_set.data(), _async_set.size());
+                _sync_set.clear();
+                _async_set.clear();
 
                 if (!sync_fref || !async_fref)
                 {
@@ -80,15 +152,24 @@ namespace librealsense
             else
             {
                 source->frame_ready(frame.clone());
-                _last_set[frame->get_stream()->get_unique_id()] = frame.clone();
+                keep_latest(frame);
                 if (_streams_to_sync_ids.empty() && _last_set.size() == _streams_to_aggregate_ids.size())
                 {
+                    if (_latest_only)
+                    {
+                        _fresh = true;
+                        lock.unlock();
+                        _fresh_cv.notify_one();
+                        return;
+                    }
+
                     // prepare the output frame set for wait_for_frames/poll_frames calls
-                    std::vector<frame_holder> sync_set;
+                    _sync_set.clear();
                     for (auto&& s : _last_set)
-                        sync_set.push_back(s.second.clone());
+                        _sync_set.push_back(s.second.clone());
 
-                    frame_holder sync_fref = source->allocate_composite_frame(std::move(sync_set));
+                    frame_holder sync_fref = source->allocate_composite_frame(_sync_set.data(), _sync_set.size());
+                    _sync_set.clear();
                     if (!sync_fref)
                     {
                         LOG_ERROR("Failed to allocate composite frame");
@@ -102,12 +183,52 @@ namespace librealsense
 
         bool aggregator::dequeue(frame_holder* item, unsigned int timeout_ms)
         {
-            return _queue->dequeue(item, timeout_ms);
+            if (_latest_only)
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (!_fresh_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&] { return _fresh || !_accepting; })
+                    || !_fresh)
+                    return false;
+                take_latest(item);
+                if (!*item)
+                    return false;
+                frame_trace::stamp(item->frame, "dequeued");
+                return true;
+            }
+            if (!_queue->dequeue(item, timeout_ms))
+                return false;
+            frame_trace::stamp(item->frame, "dequeued");
+            return true;
         }
 
         bool aggregator::try_dequeue(frame_holder* item)
         {
-            return _queue->try_dequeue(item);
+            if (_latest_only)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_fresh)
+                    return false;
+                take_latest(item);
+                if (!*item)
+                    return false;
+                frame_trace::stamp(item->frame, "dequeued");
+                return true;
+            }
+            if (!_queue->try_dequeue(item))
+                return false;
+            frame_trace::stamp(item->frame, "dequeued");
+            return true;
+        }
+
+        size_t aggregator::try_dequeue_batch(frame_holder* items, size_t max)
+        {
+            // There's never more than the one set of the latest frames
+            if (_latest_only)
+                return max && try_dequeue(items) ? 1 : 0;
+            auto n = _queue->try_dequeue_batch(items, max);
+            for (size_t i = 0; i < n; ++i)
+                frame_trace::stamp(items[i].frame, "dequeued");
+            return n;
         }
 
         void aggregator::start()
@@ -117,7 +238,11 @@ namespace librealsense
 
         void aggregator::stop()
         {
-            _accepting = false;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _accepting = false;
+            }
+            _fresh_cv.notify_all();
             _queue->stop();
         }
     }
@@ -7,7 +7,9 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <deque>
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
 
 
@@ -22,15 +24,34 @@ namespace librealsense
         {
             std::mutex _mutex;
             std::map<int /*stream_id*/, frame_holder> _last_set;
+            std::vector<frame_holder> _sync_set, _async_set;  // Working storage for handle_frame(), under _mutex
             std::unique_ptr<single_consumer_frame_queue<frame_holder>> _queue;
             std::vector<int> _streams_to_aggregate_ids;
             std::vector<int> _streams_to_sync_ids;
             std::atomic<bool> _accepting;
+
+            // Latest-only mode: no queue; dequeue() assembles a set of the latest frame of each stream at the time,
+            // with the motion samples that arrived since the last set. All under _mutex.
+            bool _latest_only;
+            size_t _imu_queue_size;
+            std::map<int /*stream_id*/, std::deque<frame_holder>> _imu_samples;  // Oldest first
+            bool _fresh;                                    // A stream has a frame no set dequeued has had yet
+            synthetic_source_interface* _source;            // To allocate the sets with, once a frame came
+            std::condition_variable _fresh_cv;
+            void keep_latest(frame_holder& f);              // Into _last_set, and the motion samples' queue
+            void take_latest(frame_holder* item);
+
             void handle_frame(frame_holder frame, synthetic_source_interface* source);
         public:
-            aggregator(const std::vector<int>& streams_to_aggregate, const std::vector<int>& streams_to_sync);
+            // Keeps up to 'queue_size' framesets for dequeue(), dropping the oldest.
+            // With 'latest_only', keeps only the latest frame of each stream, and up to 'imu_queue_size' samples of
+            // each motion stream, from which dequeue() makes a set: whatever the pace of the consumer, it gets the
+            // freshest frames, the memory kept doesn't grow, and no motion sample is crowded out by the video.
+            aggregator(const std::vector<int>& streams_to_aggregate, const std::vector<int>& streams_to_sync,
+                       unsigned queue_size = 1, bool latest_only = false, unsigned imu_queue_size = 32);
             bool dequeue(frame_holder* item, unsigned int timeout_ms);
             bool try_dequeue(frame_holder* item);
+            size_t try_dequeue_batch(frame_holder* items, size_t max);
             void start();
             void stop();
         };
@@ -192,7 +192,13 @@ namespace librealsense
             }
 
             _syncer = std::unique_ptr<syncer_process_unit>(new syncer_process_unit());
-            _aggregator = std::unique_ptr<aggregator>(new aggregator(_streams_to_aggregate_ids, _streams_to_sync_ids));
+            // More than one only makes sense with poll_for_frames_batch(), otherwise we'd be returning stale framesets
+            auto queue_size = _ctx->get_settings().nested( "pipeline", "queue-size" ).default_value( 1u );
+            // Or no queue at all: the latest frame of each stream, and the motion samples since the last set
+            auto latest_only = _ctx->get_settings().nested( "pipeline", "latest-only" ).default_value( false );
+            auto imu_queue_size = _ctx->get_settings().nested( "pipeline", "imu-queue-size" ).default_value( 32u );
+            _aggregator = std::unique_ptr<aggregator>(new aggregator(_streams_to_aggregate_ids, _streams_to_sync_ids,
+                                                                     queue_size, latest_only, imu_queue_size));
 
             if (_streams_callback)
                 _aggregator->set_output_callback(_streams_callback);
@@ -282,6 +288,22 @@ namespace librealsense
             return false;
         }
 
+        size_t pipeline::poll_for_frames_batch(frame_holder* frames, size_t max)
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+
+            if (!_active_profile)
+            {
+                throw librealsense::wrong_api_call_sequence_exception("poll_for_frames_batch cannot be called before start()");
+            }
+            if (_streams_callback)
+            {
+                throw librealsense::wrong_api_call_sequence_exception("poll_for_frames_batch cannot be called if a callback was provided");
+            }
+
+            return _aggregator->try_dequeue_batch(frames, max);
+        }
+
         bool pipeline::try_wait_for_frames(frame_holder* frame, unsigned int timeout_ms)
         {
             std::lock_guard<std::mutex> lock(_mtx);
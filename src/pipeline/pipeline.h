@@ -30,6 +30,8 @@ namespace librealsense
             std::shared_ptr<profile> get_active_profile() const;
             frame_holder wait_for_frames(unsigned int timeout_ms);
             bool poll_for_frames(frame_holder* frame);
+            // Takes all the framesets available, up to 'max', oldest first
+            size_t poll_for_frames_batch(frame_holder* frames, size_t max);
             bool try_wait_for_frames(frame_holder* frame, unsigned int timeout_ms);
 
             //Non top level API
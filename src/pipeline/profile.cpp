@@ -19,7 +19,11 @@ namespace librealsense
                 if (!dev)
                     throw librealsense::invalid_value_exception("Failed to create a profile, device is null");
 
-                _dev = std::make_shared<record_device>(dev, std::make_shared<ros_writer>(to_file, dev->compress_while_record()));
+                _dev = std::make_shared< record_device >(
+                    dev,
+                    std::make_shared< ros_writer >( to_file,
+                                                    dev->compress_while_record(),
+                                                    record_device::direct_io( dev->get_context() ) ) );
             }
             _multistream = config.resolve(_dev.get());
         }
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <cmath>
 #include <set>
+#include <sstream>
 #include "sensor.h"
 #include "types.h"
 #include "stream.h"
@@ -432,10 +433,92 @@ namespace librealsense
                 return rv;
             }
 
+            // The profiles map_streams() chose for the same requests of a device of the same serial number and firmware,
+            // by sensor and profile unique id: pipelines restarted with the same config skip the search
+            struct resolved_streams
+            {
+                std::mutex mutex;
+                std::map<std::string, std::vector<std::pair<int, int>>> by_key;
+            };
+            static resolved_streams& resolved_streams_cache()
+            {
+                static resolved_streams cache;
+                return cache;
+            }
+
+            // Empty for a device that can't be told apart from others
+            std::string resolved_streams_key(const device_interface* dev) const
+            {
+                if (!dev->supports_info(RS2_CAMERA_INFO_SERIAL_NUMBER))
+                    return {};
+                std::ostringstream key;
+                key << dev->get_info(RS2_CAMERA_INFO_SERIAL_NUMBER) << '/';
+                if (dev->supports_info(RS2_CAMERA_INFO_FIRMWARE_VERSION))
+                    key << dev->get_info(RS2_CAMERA_INFO_FIRMWARE_VERSION);
+                for (auto&& kvp : _requests)
+                {
+                    auto& r = kvp.second;
+                    key << '/' << int(r.stream) << ',' << r.index << ',' << r.width << ',' << r.height << ','
+                        << int(r.format) << ',' << r.fps;
+                }
+                return key.str();
+            }
+
+            // False when there's none, or its profiles aren't of this device's sensors (another device of the serial)
+            static bool find_resolved_streams(const device_interface* dev, const std::string& key,
+                std::multimap<int, std::shared_ptr<stream_profile_interface>>& out)
+            {
+                std::vector<std::pair<int, int>> resolved;
+                {
+                    auto& cache = resolved_streams_cache();
+                    std::lock_guard<std::mutex> lock(cache.mutex);
+                    auto it = cache.by_key.find(key);
+                    if (it == cache.by_key.end())
+                        return false;
+                    resolved = it->second;
+                }
+
+                std::map<int, stream_profiles> sensor_profiles;
+                for (auto&& r : resolved)
+                {
+                    if (r.first >= int(dev->get_sensors_count()))
+                        return false;
+                    auto& profiles = sensor_profiles[r.first];
+                    if (profiles.empty())
+                        profiles = dev->get_sensor(r.first).get_stream_profiles(profile_tag::PROFILE_TAG_ANY);
+                    auto p = std::find_if(profiles.begin(), profiles.end(),
+                        [&](const std::shared_ptr<stream_profile_interface>& profile) { return profile->get_unique_id() == r.second; });
+                    if (p == profiles.end())
+                        return false;
+                    out.emplace(r.first, *p);
+                }
+                return true;
+            }
+
+            static void add_resolved_streams(const std::string& key,
+                const std::multimap<int, std::shared_ptr<stream_profile_interface>>& streams)
+            {
+                std::vector<std::pair<int, int>> resolved;
+                for (auto&& kvp : streams)
+                    resolved.emplace_back(kvp.first, kvp.second->get_unique_id());
+
+                auto& cache = resolved_streams_cache();
+                std::lock_guard<std::mutex> lock(cache.mutex);
+                // A handful of devices and modes at a time: this only keeps the cache from growing without end
+                if (cache.by_key.size() >= 256)
+                    cache.by_key.clear();
+                cache.by_key[key] = std::move(resolved);
+            }
+
             std::multimap<int, std::shared_ptr<stream_profile_interface>> map_streams(const device_interface* dev) const
             {
                 std::multimap<int, std::shared_ptr<stream_profile_interface>> out;
 
+                auto key = resolved_streams_key(dev);
+                if (!key.empty() && find_resolved_streams(dev, key, out))
+                    return out;
+                out.clear();
+
                 // Algorithm assumes get_adjacent_devices always
                 // returns the devices in the same order
                 for (size_t i = 0; i < dev->get_sensors_count(); ++i)
@@ -455,6 +538,8 @@ namespace librealsense
                 if(_requests.size() != out.size())
                     throw std::runtime_error(std::string("Couldn't resolve requests"));
 
+                if (!key.empty())
+                    add_resolved_streams(key, out);
                 return out;
             }
 
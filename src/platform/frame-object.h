@@ -20,6 +20,9 @@ struct frame_object
     const void * pixels;
     const void * metadata;
     rs2_time_t backend_time;
+    int dmabuf_fd = -1;  // DMABUF handle to 'pixels', if the backend could export one
+    // When the driver completed the frame, in system time, if the backend has it from the driver (V4L2); 0 otherwise
+    rs2_time_t arrival_time = 0;
 };
 
 
@@ -84,6 +84,9 @@ public:
                                                            custom_sensor_report_field report_field )
         = 0;
     virtual void set_gyro_scale_factor( double scale_factor ) = 0;
+    // How many samples to let the backend collect before it wakes up to read and dispatch them; where the backend has
+    // no such control, a no-op. Each sample is still handed to the callback with its own timestamp.
+    virtual void set_batch_size( uint32_t samples ) {}
 };
 
 
@@ -123,6 +126,12 @@ public:
 
     void set_gyro_scale_factor( double scale_factor ) override {};
 
+    void set_batch_size( uint32_t samples ) override
+    {
+        for( auto && dev : _dev )
+            dev->set_batch_size( samples );
+    }
+
 private:
     std::vector< std::shared_ptr< hid_device > > _dev;
     std::vector< hid_profile > _hid_profiles;
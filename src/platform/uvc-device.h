@@ -124,6 +124,25 @@ public:
     virtual void stop_callbacks() = 0;
     virtual void close( stream_profile profile ) = 0;
 
+    // For backends that stream straight over USB (RSUSB): the number of transfers each stream keeps in flight, for
+    // streams started after this; 0 (the default) starts small and adds more when frames are dropped
+    virtual void set_usb_request_count( int count ) {}
+
+    // For V4L2 devices with a separate metadata node: when a video buffer is ready, also try to dequeue its metadata
+    // right away rather than wait for the metadata node to be signalled on its own (one wake-up per frame, not two)
+    virtual void set_paired_metadata_capture( bool paired ) {}
+
+    // For Media Foundation devices: the number of ReadSample requests each stream keeps outstanding, for streams
+    // started after this, so the source reader always has somewhere to put a sample while the last one is processed
+    virtual void set_read_ahead( int count ) {}
+
+    // For backends that listen to the UVC status interrupts (RSUSB): called, from the USB thread, with the unit and
+    // selector of each control the device reports as changed while powered. False when there are no such reports.
+    virtual bool set_control_change_callback( std::function< void( uint8_t unit, uint8_t selector ) > callback )
+    {
+        return false;
+    }
+
     virtual void set_power_state( power_state state ) = 0;
     virtual power_state get_power_state() const = 0;
 
@@ -178,6 +197,17 @@ public:
 
     void close( stream_profile profile ) override { _dev->close( profile ); }
 
+    void set_usb_request_count( int count ) override { _dev->set_usb_request_count( count ); }
+
+    void set_paired_metadata_capture( bool paired ) override { _dev->set_paired_metadata_capture( paired ); }
+
+    void set_read_ahead( int count ) override { _dev->set_read_ahead( count ); }
+
+    bool set_control_change_callback( std::function< void( uint8_t unit, uint8_t selector ) > callback ) override
+    {
+        return _dev->set_control_change_callback( std::move( callback ) );
+    }
+
     void set_power_state( power_state state ) override { _dev->set_power_state( state ); }
 
     power_state get_power_state() const override { return _dev->get_power_state(); }
@@ -302,6 +332,32 @@ public:
         _configured_indexes.erase( dev_index );
     }
 
+    void set_usb_request_count( int count ) override
+    {
+        for( auto & elem : _dev )
+            elem->set_usb_request_count( count );
+    }
+
+    void set_paired_metadata_capture( bool paired ) override
+    {
+        for( auto & elem : _dev )
+            elem->set_paired_metadata_capture( paired );
+    }
+
+    void set_read_ahead( int count ) override
+    {
+        for( auto & elem : _dev )
+            elem->set_read_ahead( count );
+    }
+
+    bool set_control_change_callback( std::function< void( uint8_t unit, uint8_t selector ) > callback ) override
+    {
+        bool any = false;
+        for( auto & elem : _dev )
+            any = elem->set_control_change_callback( callback ) || any;
+        return any;
+    }
+
     void set_power_state( power_state state ) override
     {
         for( auto & elem : _dev )
@@ -92,7 +92,15 @@ public:
             } ) );
     }
 
+    // Queried from the device the first time it's needed, and not again
     option_range get_range() const override
+    {
+        if( ! _range.is_initialized() && _ep.expired() )
+            return option_range{ 0, 0, 1, 0 };
+        return *_range;
+    }
+
+    option_range query_range() const
     {
         auto uvc_range = platform::control_range();
         
@@ -158,6 +166,7 @@ public:
 
 protected:
     std::weak_ptr < uvc_sensor > _ep;
+    rsutils::lazy< option_range > _range{ [this]() { return query_range(); } };
     platform::extension_unit _xu;
     uint8_t _id;
     std::string _desciption;
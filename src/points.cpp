@@ -6,36 +6,71 @@
 #include "core/video-frame.h"
 #include "core/frame-holder.h"
 #include "librealsense-exception.h"
+#include "core/enum-helpers.h"
+#include "proc/processing-thread-pool.h"
+
+#include <rsutils/string/from.h>
+#include <algorithm>
 #include <fstream>
+#include <sstream>
+#include <cstring>
+#include <vector>
 #include <cmath>
 
 #define MIN_DISTANCE 1e-6
 
 namespace librealsense {
 
+static size_t packed_value_size( rs2_points_layout layout )
+{
+    return layout == RS2_POINTS_LAYOUT_PACKED_FLOAT ? sizeof( float ) : sizeof( uint16_t );
+}
+
+static void validate_interleaved( rs2_points_layout layout )
+{
+    if( layout != RS2_POINTS_LAYOUT_INTERLEAVED )
+        throw wrong_api_call_sequence_exception( rsutils::string::from()
+                                                 << "points are " << layout << ": read them from the frame data" );
+}
+
 float3 * points::get_vertices()
 {
+    validate_interleaved( _layout );
     get_frame_data();  // call GetData to ensure data is in main memory
     auto xyz = (float3 *)data.data();
     return xyz;
 }
 
-std::tuple< uint8_t, uint8_t, uint8_t >
-get_texcolor( const frame_holder & texture, float u, float v )
+static bool has_point( const float3 & v )
+{
+    return fabs( v.x ) >= MIN_DISTANCE || fabs( v.y ) >= MIN_DISTANCE || fabs( v.z ) >= MIN_DISTANCE;
+}
+
+// The texture's pixels, looked up once for all the points rather than through the frame for each
+struct texture_view
 {
-    auto ptr = dynamic_cast< video_frame * >( texture.frame );
-    if( ptr == nullptr )
+    const uint8_t * data = nullptr;
+    int width = 0, height = 0, bytes_per_pixel = 0, stride = 0;
+
+    explicit texture_view( const frame_holder & texture )
     {
-        throw librealsense::invalid_value_exception( "frame must be video frame" );
+        auto ptr = dynamic_cast< video_frame * >( texture.frame );
+        if( ptr == nullptr )
+            throw librealsense::invalid_value_exception( "frame must be video frame" );
+        data = reinterpret_cast< const uint8_t * >( ptr->get_frame_data() );
+        width = ptr->get_width();
+        height = ptr->get_height();
+        bytes_per_pixel = ptr->get_bpp() / 8;
+        stride = ptr->get_stride();
     }
-    const int w = ptr->get_width(), h = ptr->get_height();
-    int x = std::min( std::max( int( u * w + .5f ), 0 ), w - 1 );
-    int y = std::min( std::max( int( v * h + .5f ), 0 ), h - 1 );
-    int idx = x * ptr->get_bpp() / 8 + y * ptr->get_stride();
-    const auto texture_data = reinterpret_cast< const uint8_t * >( ptr->get_frame_data() );
-    return std::make_tuple( texture_data[idx], texture_data[idx + 1], texture_data[idx + 2] );
-}
 
+    const uint8_t * at( float u, float v ) const
+    {
+        int x = std::min( std::max( int( u * width + .5f ), 0 ), width - 1 );
+        int y = std::min( std::max( int( v * height + .5f ), 0 ), height - 1 );
+        return data + x * bytes_per_pixel + y * stride;
+    }
+};
 
 void points::export_to_ply( const std::string & fname, const frame_holder & texture )
 {
@@ -45,116 +80,182 @@ void points::export_to_ply( const std::string & fname, const frame_holder & text
         throw librealsense::invalid_value_exception( "stream must be video stream" );
     const auto vertices = get_vertices();
     const auto texcoords = get_texture_coordinates();
-    std::vector< float3 > new_vertices;
-    std::vector< std::tuple< uint8_t, uint8_t, uint8_t > > new_tex;
-    std::map< int, int > index2reducedIndex;
-
-    new_vertices.reserve( get_vertex_count() );
-    new_tex.reserve( get_vertex_count() );
-    assert( get_vertex_count() );
-    for( int i = 0; i < get_vertex_count(); ++i )
-        if( fabs( vertices[i].x ) >= MIN_DISTANCE || fabs( vertices[i].y ) >= MIN_DISTANCE
-            || fabs( vertices[i].z ) >= MIN_DISTANCE )
+    const size_t count = get_vertex_count();
+    assert( count );
+    const size_t width = video_stream_profile->get_width();
+    const size_t height = width ? count / width : 0;
+    std::unique_ptr< texture_view > colors;
+    if( texture )
+        colors.reset( new texture_view( texture ) );
+
+    // Everything is done over contiguous chunks of the points, then of the rows, on the shared workers
+    auto pool = processing_thread_pool::instance();
+    const size_t chunks = size_t( std::max( 1, std::min( processing_thread_pool::max_threads(), int( height ) ) ) );
+    auto for_each_chunk = [&]( std::function< void( size_t ) > const & fn )
+    {
+        pool->parallel_for( chunks, int( chunks ), [&]( size_t begin, size_t end )
         {
-            index2reducedIndex[i] = (int)new_vertices.size();
-            new_vertices.push_back( { vertices[i].x, -1 * vertices[i].y, -1 * vertices[i].z } );
-            if( texture )
-            {
-                auto color = get_texcolor( texture, texcoords[i].x, texcoords[i].y );
-                new_tex.push_back( color );
-            }
-        }
+            for( size_t c = begin; c < end; ++c )
+                fn( c );
+        } );
+    };
+    auto chunk_begin = [chunks]( size_t c, size_t n ) { return c * n / chunks; };
+
+    // The index of each point among those that are written, from the number of them in the chunks before it
+    std::vector< size_t > first_vertex( chunks + 1, 0 );
+    for_each_chunk( [&]( size_t c )
+    {
+        size_t n = 0;
+        for( size_t i = chunk_begin( c, count ); i < chunk_begin( c + 1, count ); ++i )
+            n += has_point( vertices[i] );
+        first_vertex[c + 1] = n;
+    } );
+    for( size_t c = 0; c < chunks; ++c )
+        first_vertex[c + 1] += first_vertex[c];
+    const size_t n_vertices = first_vertex[chunks];
+
+    std::vector< int > index2reducedIndex( count );
+    for_each_chunk( [&]( size_t c )
+    {
+        int next = int( first_vertex[c] );
+        for( size_t i = chunk_begin( c, count ); i < chunk_begin( c + 1, count ); ++i )
+            index2reducedIndex[i] = has_point( vertices[i] ) ? next++ : -1;
+    } );
 
+    // Two faces for each square of four neighboring points that are close in depth. Which squares qualify is
+    // decided for a whole row first, without branches, so that the loop can be vectorized.
     const auto threshold = 0.05f;
-    auto width = video_stream_profile->get_width();
-    std::vector< std::tuple< int, int, int > > faces;
-    for( uint32_t x = 0; x < width - 1; ++x )
+    const size_t face_size = sizeof( uint8_t ) + 3 * sizeof( int );
+    const size_t quad_rows = height ? height - 1 : 0;
+    std::vector< std::vector< uint8_t > > faces( chunks );
+    for_each_chunk( [&]( size_t chunk )
     {
-        for( uint32_t y = 0; y < video_stream_profile->get_height() - 1; ++y )
+        auto & out = faces[chunk];
+        std::vector< uint8_t > close( width );
+        for( size_t y = chunk_begin( chunk, quad_rows ); y < chunk_begin( chunk + 1, quad_rows ); ++y )
         {
-            auto a = y * width + x, b = y * width + x + 1, c = ( y + 1 ) * width + x,
-                 d = ( y + 1 ) * width + x + 1;
-            if( vertices[a].z && vertices[b].z && vertices[c].z && vertices[d].z
-                && std::abs( vertices[a].z - vertices[b].z ) < threshold
-                && std::abs( vertices[a].z - vertices[c].z ) < threshold
-                && std::abs( vertices[b].z - vertices[d].z ) < threshold
-                && std::abs( vertices[c].z - vertices[d].z ) < threshold )
+            const float3 * top = vertices + y * width;
+            const float3 * bottom = top + width;
+            for( size_t x = 0; x + 1 < width; ++x )
             {
-                if( index2reducedIndex.count( a ) == 0 || index2reducedIndex.count( b ) == 0
-                    || index2reducedIndex.count( c ) == 0 || index2reducedIndex.count( d ) == 0 )
+                const float za = top[x].z, zb = top[x + 1].z, zc = bottom[x].z, zd = bottom[x + 1].z;
+                close[x] = uint8_t( ( za != 0 ) & ( zb != 0 ) & ( zc != 0 ) & ( zd != 0 )
+                                    & ( std::abs( za - zb ) < threshold ) & ( std::abs( za - zc ) < threshold )
+                                    & ( std::abs( zb - zd ) < threshold ) & ( std::abs( zc - zd ) < threshold ) );
+            }
+            for( size_t x = 0; x + 1 < width; ++x )
+            {
+                if( ! close[x] )
                     continue;
-
-                faces.emplace_back( index2reducedIndex[a],
-                                    index2reducedIndex[d],
-                                    index2reducedIndex[b] );
-                faces.emplace_back( index2reducedIndex[d],
-                                    index2reducedIndex[a],
-                                    index2reducedIndex[c] );
+                const int * row = &index2reducedIndex[y * width + x];
+                int const a = row[0], b = row[1], c = row[width], d = row[width + 1];
+                if( a < 0 || b < 0 || c < 0 || d < 0 )
+                    continue;
+                int const indices[6] = { a, d, b, d, a, c };
+                size_t at = out.size();
+                out.resize( at + 2 * face_size );
+                for( int f = 0; f < 2; ++f, at += face_size )
+                {
+                    out[at] = 3;
+                    memcpy( &out[at + 1], indices + 3 * f, 3 * sizeof( int ) );
+                }
             }
         }
-    }
+    } );
+    std::vector< size_t > first_face_byte( chunks + 1, 0 );
+    for( size_t c = 0; c < chunks; ++c )
+        first_face_byte[c + 1] = first_face_byte[c] + faces[c].size();
 
-    std::ofstream out( fname );
-    out << "ply\n";
-    out << "format binary_little_endian 1.0\n";
-    out << "comment pointcloud saved from Realsense Viewer\n";
-    out << "element vertex " << new_vertices.size() << "\n";
-    out << "property float" << sizeof( float ) * 8 << " x\n";
-    out << "property float" << sizeof( float ) * 8 << " y\n";
-    out << "property float" << sizeof( float ) * 8 << " z\n";
-    if( texture )
+    std::ostringstream header;
+    header << "ply\n";
+    header << "format binary_little_endian 1.0\n";
+    header << "comment pointcloud saved from Realsense Viewer\n";
+    header << "element vertex " << n_vertices << "\n";
+    header << "property float" << sizeof( float ) * 8 << " x\n";
+    header << "property float" << sizeof( float ) * 8 << " y\n";
+    header << "property float" << sizeof( float ) * 8 << " z\n";
+    if( colors )
     {
-        out << "property uchar red\n";
-        out << "property uchar green\n";
-        out << "property uchar blue\n";
+        header << "property uchar red\n";
+        header << "property uchar green\n";
+        header << "property uchar blue\n";
     }
-    out << "element face " << faces.size() << "\n";
-    out << "property list uchar int vertex_indices\n";
-    out << "end_header\n";
-    out.close();
+    header << "element face " << first_face_byte[chunks] / face_size << "\n";
+    header << "property list uchar int vertex_indices\n";
+    header << "end_header\n";
+    const std::string header_text = header.str();
 
-    out.open( fname, std::ios_base::app | std::ios_base::binary );
-    for( int i = 0; i < new_vertices.size(); ++i )
+    // The whole file is laid out in one buffer, each chunk filling its own part of it, and written at once
+    // (we assume little endian architecture on your device)
+    const size_t vertex_size = 3 * sizeof( float ) + ( colors ? 3 : 0 );
+    const size_t vertices_offset = header_text.size();
+    const size_t faces_offset = vertices_offset + n_vertices * vertex_size;
+    std::vector< uint8_t > buffer( faces_offset + first_face_byte[chunks] );
+    memcpy( buffer.data(), header_text.data(), header_text.size() );
+    for_each_chunk( [&]( size_t c )
     {
-        // we assume little endian architecture on your device
-        out.write( reinterpret_cast< const char * >( &( new_vertices[i].x ) ), sizeof( float ) );
-        out.write( reinterpret_cast< const char * >( &( new_vertices[i].y ) ), sizeof( float ) );
-        out.write( reinterpret_cast< const char * >( &( new_vertices[i].z ) ), sizeof( float ) );
-
-        if( texture )
+        auto p = buffer.data() + vertices_offset + first_vertex[c] * vertex_size;
+        for( size_t i = chunk_begin( c, count ); i < chunk_begin( c + 1, count ); ++i )
         {
-            uint8_t x, y, z;
-            std::tie( x, y, z ) = new_tex[i];
-            out.write( reinterpret_cast< const char * >( &x ), sizeof( uint8_t ) );
-            out.write( reinterpret_cast< const char * >( &y ), sizeof( uint8_t ) );
-            out.write( reinterpret_cast< const char * >( &z ), sizeof( uint8_t ) );
+            if( index2reducedIndex[i] < 0 )
+                continue;
+            float const xyz[3] = { vertices[i].x, -1 * vertices[i].y, -1 * vertices[i].z };
+            memcpy( p, xyz, sizeof( xyz ) );
+            p += sizeof( xyz );
+            if( colors )
+            {
+                memcpy( p, colors->at( texcoords[i].x, texcoords[i].y ), 3 );
+                p += 3;
+            }
         }
-    }
-    auto size = faces.size();
-    for( int i = 0; i < size; ++i )
-    {
-        int three = 3;
-        out.write( reinterpret_cast< const char * >( &three ), sizeof( uint8_t ) );
-        out.write( reinterpret_cast< const char * >( &( std::get< 0 >( faces[i] ) ) ),
-                   sizeof( int ) );
-        out.write( reinterpret_cast< const char * >( &( std::get< 1 >( faces[i] ) ) ),
-                   sizeof( int ) );
-        out.write( reinterpret_cast< const char * >( &( std::get< 2 >( faces[i] ) ) ),
-                   sizeof( int ) );
-    }
+        if( ! faces[c].empty() )
+            memcpy( buffer.data() + faces_offset + first_face_byte[c], faces[c].data(), faces[c].size() );
+    } );
+
+    std::ofstream out( fname, std::ios_base::binary );
+    out.write( reinterpret_cast< const char * >( buffer.data() ), buffer.size() );
 }
 
 size_t points::get_vertex_count() const
 {
+    if( _layout != RS2_POINTS_LAYOUT_INTERLEAVED )
+        return _count;
     return data.size() / ( sizeof( float3 ) + sizeof( int2 ) );
 }
 
 float2 * points::get_texture_coordinates()
 {
+    validate_interleaved( _layout );
     get_frame_data();  // call GetData to ensure data is in main memory
     auto xyz = (float3 *)data.data();
     auto ijs = (float2 *)( xyz + get_vertex_count() );
     return ijs;
 }
 
+void points::set_layout( rs2_points_layout layout, size_t count )
+{
+    if( layout != RS2_POINTS_LAYOUT_INTERLEAVED && count * 5 * packed_value_size( layout ) > data.size() )
+        throw invalid_value_exception( "packed points do not fit the frame" );
+    _layout = layout;
+    _count = count;
+}
+
+int points::get_frame_data_size() const
+{
+    if( _layout != RS2_POINTS_LAYOUT_INTERLEAVED )
+        return int( _count * 5 * packed_value_size( _layout ) );
+    return frame::get_frame_data_size();
+}
+
+bool points::find_metadata( rs2_frame_metadata_value frame_metadata, rs2_metadata_type * p_value ) const
+{
+    if( frame_metadata == RS2_FRAME_METADATA_POINT_COUNT && _layout != RS2_POINTS_LAYOUT_INTERLEAVED )
+    {
+        if( p_value )
+            *p_value = rs2_metadata_type( _count );
+        return true;
+    }
+    return frame::find_metadata( frame_metadata, p_value );
+}
+
 }  // namespace librealsense
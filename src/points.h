@@ -6,6 +6,8 @@
 #include "core/extension.h"
 #include "float3.h"
 
+#include <librealsense2/h/rs_option.h>
+
 #include <string>
 
 
@@ -22,6 +24,17 @@ public:
     void export_to_ply( const std::string & fname, const frame_holder & texture );
     size_t get_vertex_count() const;
     float2 * get_texture_coordinates();
+
+    // After the data was rewritten in a packed layout (see rs2_points_layout), holding 'count' points
+    void set_layout( rs2_points_layout layout, size_t count );
+    rs2_points_layout get_layout() const { return _layout; }
+
+    int get_frame_data_size() const override;
+    bool find_metadata( rs2_frame_metadata_value, rs2_metadata_type * p_output_value ) const override;
+
+private:
+    rs2_points_layout _layout = RS2_POINTS_LAYOUT_INTERLEAVED;
+    size_t _count = 0;
 };
 
 MAP_EXTENSION( RS2_EXTENSION_POINTS, librealsense::points );
@@ -7,15 +7,22 @@
 #include "core/video.h"
 #include "core/depth-frame.h"
 #include "proc/synthetic-stream.h"
+#include "proc/output-profile-cache.h"
 #include "environment.h"
 #include "align.h"
+#include "option.h"
 #include "stream.h"
 
+#include <cmath>
+
 #if defined(RS2_USE_CUDA)
 #include "proc/cuda/cuda-align.h"
-#elif defined(__SSSE3__)
+#elif defined(__SSSE3__) || (defined(__aarch64__) && defined(__ARM_NEON))
 #include "proc/sse/sse-align.h"
 #endif
+#ifdef RS2_USE_VULKAN
+#include "proc/vulkan/vulkan-align.h"
+#endif
 
 namespace librealsense
 {
@@ -25,11 +32,19 @@ namespace librealsense
     {
         #if defined(RS2_USE_CUDA)
             return std::make_shared<librealsense::align_cuda>(align_to);
-        #elif defined(__SSSE3__)
+        #else
+        #ifdef RS2_USE_VULKAN
+            // Only when there's a device to run on; the CPU otherwise
+            if (vulkan::device::get())
+                return std::make_shared<librealsense::align_vulkan>(align_to);
+        #endif
+        #if defined(__SSSE3__) || (defined(__aarch64__) && defined(__ARM_NEON))
+            // SSE on x86, NEON on aarch64
             return std::make_shared<librealsense::align_sse>(align_to);
         #else
             return std::make_shared<librealsense::align>(align_to);
         #endif
+        #endif
     }
 
     template<class GET_DEPTH, class TRANSFER_PIXEL>
@@ -81,6 +96,53 @@ namespace librealsense
     align::align(rs2_stream to_stream) : align(to_stream, "Align")
     {}
 
+    align::align(rs2_stream to_stream, const char* name)
+        : generic_processing_block(name),
+          _to_stream_type(to_stream), _depth_scale(0), _output_scale(1.f), _frame_scale(1.f)
+    {
+        register_option(RS2_OPTION_ALIGN_OUTPUT_SCALE,
+            std::make_shared<ptr_option<float>>(0.1f, 1.f, 0.05f, 1.f, &_output_scale,
+                "The aligned frames are this fraction of the size of the stream aligned to, in each direction"));
+    }
+
+    rs2_intrinsics align::scale_intrinsics(const rs2_intrinsics& intrin, float scale)
+    {
+        auto scaled = intrin;
+        if (scale >= 1.f)
+            return scaled;
+        // A multiple of 8 pixels wide, as the vectorized implementations go over the rows 8 pixels at a time
+        scaled.width = std::min(intrin.width, std::max(8, int(std::lround(intrin.width * scale / 8)) * 8));
+        scaled.height = std::max(1, int(std::lround(intrin.height * scale)));
+
+        // Pixel centers are at the integers: the edges of the image, half a pixel out, are what stays in place
+        const float sx = float(scaled.width) / intrin.width, sy = float(scaled.height) / intrin.height;
+        scaled.fx = intrin.fx * sx;
+        scaled.fy = intrin.fy * sy;
+        scaled.ppx = (intrin.ppx + 0.5f) * sx - 0.5f;
+        scaled.ppy = (intrin.ppy + 0.5f) * sy - 0.5f;
+        return scaled;
+    }
+
+    const uint16_t* align::scaled_depth(const rs2::video_frame& depth, rs2_intrinsics& z_intrin)
+    {
+        auto full = depth.get_profile().as<rs2::video_stream_profile>().get_intrinsics();
+        auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
+        z_intrin = scale_intrinsics(full, _frame_scale);
+        if (z_intrin.width == full.width && z_intrin.height == full.height)
+            return z_pixels;
+
+        // The nearest pixel to each center: no averaging, which would make up depths between the edges of objects
+        _scaled_depth.resize(size_t(z_intrin.width) * z_intrin.height);
+        auto out = _scaled_depth.data();
+        for (int y = 0; y < z_intrin.height; ++y)
+        {
+            auto row = z_pixels + size_t(std::min(int((y + 0.5f) * full.height / z_intrin.height), full.height - 1)) * full.width;
+            for (int x = 0; x < z_intrin.width; ++x)
+                *out++ = row[std::min(int((x + 0.5f) * full.width / z_intrin.width), full.width - 1)];
+        }
+        return _scaled_depth.data();
+    }
+
     void align::align_z_to_other(rs2::video_frame& aligned, 
         const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale)
     {
@@ -90,11 +152,12 @@ namespace librealsense
 
         auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
 
-        auto z_intrin = depth_profile.get_intrinsics();
-        auto other_intrin = other_profile.get_intrinsics();
+        // Into the grid of the aligned frame, which may be smaller than the other's
+        rs2_intrinsics z_intrin;
+        auto z_pixels = scaled_depth(depth, z_intrin);
+        auto other_intrin = aligned_profile.get_intrinsics();
         auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
 
-        auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
         auto out_z = (uint16_t *)(aligned_data);
 
         align_images(z_intrin, z_to_other, other_intrin,
@@ -150,11 +213,11 @@ namespace librealsense
         auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
         auto other_profile = other.get_profile().as<rs2::video_stream_profile>();
 
-        auto z_intrin = depth_profile.get_intrinsics();
+        rs2_intrinsics z_intrin;
+        auto z_pixels = scaled_depth(depth, z_intrin);
         auto other_intrin = other_profile.get_intrinsics();
         auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
 
-        auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
         auto other_pixels = reinterpret_cast<const uint8_t *>(other.get_data());
 
         align_other_to_depth(aligned_data, [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
@@ -171,23 +234,29 @@ namespace librealsense
         {
             return it->second;
         }
-        auto aligned_profile = std::make_shared<rs2::video_stream_profile>(original_profile.clone(original_profile.stream_type(), original_profile.stream_index(), original_profile.format()));
-        aligned_profile->get()->profile->set_framerate(original_profile.fps());
-        if (auto original_video_profile = As<video_stream_profile_interface>(original_profile.get()->profile))
-        {
-            if (auto to_video_profile = As<video_stream_profile_interface>(to_profile.get()->profile))
-            {
-                if (auto aligned_video_profile = As<video_stream_profile_interface>(aligned_profile->get()->profile))
+        // Shared by every align of the same streams at the same scale, with its extrinsics registered once
+        output_profile_cache::key key(from_to.first, original_profile.stream_type(), original_profile.stream_index(),
+            original_profile.format(), "align");
+        key.other = from_to.second;
+        key.param = _frame_scale;
+        auto frame_scale = _frame_scale;
+        auto aligned_profile = std::make_shared<rs2::video_stream_profile>(
+            environment::get_instance().get_output_profile_cache().get_profile(key,
+                [&to_profile, frame_scale](stream_profile_interface& aligned)
                 {
-                    aligned_video_profile->set_dims(to_video_profile->get_width(), to_video_profile->get_height());
+                    auto to_video_profile = As<video_stream_profile_interface>(to_profile.get()->profile);
+                    auto aligned_video_profile = As<video_stream_profile_interface>(&aligned);
+                    if (!to_video_profile || !aligned_video_profile)
+                        return;
                     auto aligned_intrinsics = to_video_profile->get_intrinsics();
                     aligned_intrinsics.width = to_video_profile->get_width();
                     aligned_intrinsics.height = to_video_profile->get_height();
+                    aligned_intrinsics = scale_intrinsics(aligned_intrinsics, frame_scale);
+                    aligned_video_profile->set_dims(aligned_intrinsics.width, aligned_intrinsics.height);
                     aligned_video_profile->set_intrinsics([aligned_intrinsics]() { return aligned_intrinsics; });
-                    aligned_profile->register_extrinsics_to(to_profile, { { 1,0,0,0,1,0,0,0,1 },{ 0,0,0 } });
-                }
-            }
-        }
+                    environment::get_instance().get_extrinsics_graph().register_same_extrinsics(aligned,
+                        *to_profile.get()->profile);
+                }));
         _align_stream_unique_ids[from_to] = aligned_profile;
         reset_cache(original_profile.stream_type(), to_profile.stream_type());
         return aligned_profile;
@@ -233,6 +302,7 @@ namespace librealsense
         auto to_profile = to.get_profile().as<rs2::video_stream_profile>();
 
         auto aligned_profile = create_aligned_profile(from_profile, to_profile);
+        const int width = aligned_profile->width(), height = aligned_profile->height();
 
         auto ext = select_extension(from);
 
@@ -240,10 +310,13 @@ namespace librealsense
             *aligned_profile,
             from,
             from_bytes_per_pixel,
-            to.get_width(),
-            to.get_height(),
-            to.get_width() * from_bytes_per_pixel,
+            width,
+            height,
+            width * from_bytes_per_pixel,
             ext);
+
+        // A region of interest of 'from' means nothing in the geometry of 'to'
+        set_roi(rv, { 0, 0, width - 1, height - 1 }, width, height);
         return rv;
     }
 
@@ -275,6 +348,14 @@ namespace librealsense
 
         _depth_scale = ((librealsense::depth_frame*)depth.get())->get_units();
 
+        // The aligned profiles, and what the implementations keep for them, are for the grid they were made in
+        const float scale = _output_scale;
+        if (scale != _frame_scale)
+        {
+            _align_stream_unique_ids.clear();
+            _frame_scale = scale;
+        }
+
         if (_to_stream_type == RS2_STREAM_DEPTH)
             frames.foreach_rs([&other_frames](const rs2::frame& f) {if ((f.get_profile().stream_type() != RS2_STREAM_DEPTH) && f.is<rs2::video_frame>()) other_frames.push_back(f); });
         else
@@ -18,10 +18,7 @@ namespace librealsense
         static std::shared_ptr<align> create_align(rs2_stream align_to);
 
     protected:
-        align(rs2_stream to_stream, const char* name)
-            : generic_processing_block(name),
-              _to_stream_type(to_stream), _depth_scale(0)
-        {}
+        align(rs2_stream to_stream, const char* name);
 
         bool should_process(const rs2::frame& frame) override;
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
@@ -44,10 +41,20 @@ namespace librealsense
             rs2::video_stream_profile& original_profile,
             rs2::video_stream_profile& to_profile);
 
+        // The intrinsics of the grid 'scale' times the size of the given one, in each direction
+        static rs2_intrinsics scale_intrinsics(const rs2_intrinsics& intrin, float scale);
+
+        // The depth pixels, and their intrinsics, in the grid of the output scale: sampled down from the frame's
+        // when it's below 1, so the alignment goes over as many fewer pixels. Valid until the next call.
+        const uint16_t* scaled_depth(const rs2::video_frame& depth, rs2_intrinsics& z_intrin);
+
         rs2_stream _to_stream_type;
         std::map<std::pair<stream_profile_interface*, stream_profile_interface*>, std::shared_ptr<rs2::video_stream_profile>> _align_stream_unique_ids;
         rs2::stream_profile _source_stream_profile;
         float _depth_scale;
+        float _output_scale;            // RS2_OPTION_ALIGN_OUTPUT_SCALE
+        float _frame_scale;             // What it was when the frameset being aligned came in
+        std::vector<uint16_t> _scaled_depth;
 
     private:
         rs2::video_frame allocate_aligned_frame(const rs2::frame_source& source, const rs2::video_frame& from, const rs2::video_frame& to);
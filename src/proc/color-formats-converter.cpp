@@ -4,8 +4,14 @@
 #include "color-formats-converter.h"
 
 #include "option.h"
+#include "stream.h"
+#include "environment.h"
+#include "proc/output-profile-cache.h"
+#include <src/core/frame-processor-callback.h>
 #include "image-avx.h"
 #include "image.h"
+#include "image-neon.h"
+#include <rsutils/string/from.h>
 
 #define STB_IMAGE_STATIC
 #define STB_IMAGE_IMPLEMENTATION
@@ -14,6 +20,18 @@
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
 #endif
+#ifdef RS2_USE_VULKAN
+#include "vulkan/vulkan-conversion.h"
+#endif
+#ifdef RS2_USE_OPENCL
+#include "opencl/opencl-conversion.h"
+#endif
+#ifdef RS2_USE_NVJPEG
+#include "cuda/cuda-jpeg.h"
+#endif
+#ifdef RS2_USE_TURBOJPEG
+#include <turbojpeg.h>
+#endif
 #ifdef __SSSE3__
 #include <tmmintrin.h> // For SSSE3 intrinsics
 #endif
@@ -21,6 +39,8 @@
 #if defined (ANDROID) || (defined (__linux__) && !defined (__x86_64__)) || (defined (__APPLE__) && !defined (__x86_64__))
 
 bool has_avx() { return false; }
+bool has_avx2() { return false; }
+bool has_avx512bw() { return false; }
 
 #else
 
@@ -42,6 +62,44 @@ bool has_avx()
     return (info[2] & ((int)1 << 28)) != 0;
 }
 
+// Which of the AVX register states (XCR0 bits) the OS saves on context switches
+static unsigned long long os_saved_states()
+{
+    int info[4];
+    cpuid(info, 1);
+    if ((info[2] & ((int)1 << 27)) == 0)  // OSXSAVE
+        return 0;
+#ifdef _WIN32
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+#endif
+}
+
+bool has_avx2()
+{
+    int info[4];
+    cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    cpuid(info, 7);
+    bool const avx2 = (info[1] & ((int)1 << 5)) != 0;
+    return avx2 && (os_saved_states() & 0x6) == 0x6;  // XMM, YMM
+}
+
+bool has_avx512bw()
+{
+    int info[4];
+    cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    cpuid(info, 7);
+    bool const avx512 = (info[1] & ((int)1 << 16)) != 0 && (info[1] & ((int)1 << 30)) != 0;  // F, BW
+    return avx512 && has_avx2() && (os_saved_states() & 0xE6) == 0xE6;  // + opmask, ZMM
+}
+
 #endif
 
 namespace librealsense 
@@ -51,7 +109,8 @@ namespace librealsense
     /////////////////////////////
     // This templated function unpacks YUY2 into Y8/Y16/RGB8/RGBA8/BGR8/BGRA8, depending on the compile-time parameter FORMAT.
     // It is expected that all branching outside of the loop control variable will be removed due to constant-folding.
-    template<rs2_format FORMAT> void unpack_yuy2( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size)
+    // ISA is the instruction set to use beyond the one the build targets, as found by find_color_kernel().
+    template<rs2_format FORMAT, color_isa ISA> void unpack_yuy2( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size)
     {
         auto n = width * height;
         assert(n % 16 == 0); // All currently supported color resolutions are multiples of 16 pixels. Could easily extend support to other resolutions by copying final n<16 pixels into a zero-padded buffer and recursively calling self for final iteration.
@@ -59,11 +118,18 @@ namespace librealsense
         rscuda::unpack_yuy2_cuda<FORMAT>(d, s, n);
         return;
 #endif
+#ifdef RS2_USE_VULKAN
+        if (vulkan::unpack_yuy2(FORMAT, d, s, n))
+            return;
+#endif
+#ifdef RS2_USE_OPENCL
+        if (opencl::unpack_yuy2(FORMAT, d, s, width, height))
+            return;
+#endif
 #if defined __SSSE3__ && ! defined ANDROID
-        static bool do_avx = has_avx();
 #ifdef __AVX2__
 
-        if (do_avx)
+        if (ISA != color_isa::baseline)
         {
             if (FORMAT == RS2_FORMAT_Y8) unpack_yuy2_avx_y8(d, s, n);
             if (FORMAT == RS2_FORMAT_Y16) unpack_yuy2_avx_y16(d, s, n);
@@ -220,7 +286,9 @@ namespace librealsense
                 }
             }
         }
-#else  // Generic code for when SSSE3 is not available.
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        unpack_yuy2_neon<FORMAT>(d, s, n);
+#else  // Generic code for when neither SSSE3 nor NEON is available.
         auto src = reinterpret_cast<const uint8_t *>(s);
         auto dst = reinterpret_cast<uint8_t *>(d[0]);
         for (; n; n -= 16, src += 32)
@@ -615,13 +683,40 @@ namespace librealsense
     // The first pixel is (Y0, U0, V0), second pixel is (Y1, U0, V0)
     // The first pixel in the second line is (Yw, U0, V0) second pixel in second line is (Yw+1, U0, V0)
     // The third pixel in second line is (Yw+2, U1, V1)
-    template<rs2_format FORMAT> void unpack_m420( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size)
+    template<rs2_format FORMAT, color_isa ISA> void unpack_m420( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size)
     {
         auto n = width * height;
         assert(n % 16 == 0); // All currently supported color resolutions are multiples of 16 pixels. Could easily extend support to other resolutions by copying final n<16 pixels into a zero-padded buffer and recursively calling self for final iteration.
+#ifdef RS2_USE_OPENCL
+        if (opencl::unpack_m420(FORMAT, d, s, width, height))
+            return;
+#endif
 
 #if defined __SSSE3__ && ! defined ANDROID
-        static bool do_avx = has_avx();
+#ifdef RS2_USE_AVX
+        if (ISA != color_isa::baseline && width % 32 == 0)
+        {
+            if (ISA == color_isa::avx512)
+            {
+                if (FORMAT == RS2_FORMAT_Y8) unpack_m420_avx512_y8(d, s, width, height);
+                if (FORMAT == RS2_FORMAT_Y16) unpack_m420_avx512_y16(d, s, width, height);
+                if (FORMAT == RS2_FORMAT_RGB8) unpack_m420_avx512_rgb8(d, s, width, height);
+                if (FORMAT == RS2_FORMAT_RGBA8) unpack_m420_avx512_rgba8(d, s, width, height);
+                if (FORMAT == RS2_FORMAT_BGR8) unpack_m420_avx512_bgr8(d, s, width, height);
+                if (FORMAT == RS2_FORMAT_BGRA8) unpack_m420_avx512_bgra8(d, s, width, height);
+            }
+            else
+            {
+                if (FORMAT == RS2_FORMAT_Y8) unpack_m420_avx_y8(d, s, width, height);
+                if (FORMAT == RS2_FORMAT_Y16) unpack_m420_avx_y16(d, s, width, height);
+                if (FORMAT == RS2_FORMAT_RGB8) unpack_m420_avx_rgb8(d, s, width, height);
+                if (FORMAT == RS2_FORMAT_RGBA8) unpack_m420_avx_rgba8(d, s, width, height);
+                if (FORMAT == RS2_FORMAT_BGR8) unpack_m420_avx_bgr8(d, s, width, height);
+                if (FORMAT == RS2_FORMAT_BGRA8) unpack_m420_avx_bgra8(d, s, width, height);
+            }
+            return;
+        }
+#endif
 
         auto src = reinterpret_cast<const __m128i*>(s);
         auto dst = reinterpret_cast<__m128i*>(d[0]);
@@ -688,6 +783,8 @@ namespace librealsense
         delete[] source_chunks_y;
         delete[] source_chunks_uv;
 
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        unpack_m420_neon<FORMAT>(d, s, width, height);
 #else
         auto src = reinterpret_cast<const uint8_t*>(s);
         auto dst = reinterpret_cast<uint8_t*>(d[0]);
@@ -745,73 +842,40 @@ namespace librealsense
 #endif // __SSSE3__
     }
 
-    void unpack_yuy2(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size)
-    {
-        switch (dst_format)
-        {
-        case RS2_FORMAT_RGB8:
-            unpack_yuy2<RS2_FORMAT_RGB8>(d, s, w, h, actual_size);
-            break;
-        case RS2_FORMAT_Y8:
-            unpack_yuy2<RS2_FORMAT_Y8>(d, s, w, h, actual_size);
-            break;
-        case RS2_FORMAT_RGBA8:
-            unpack_yuy2<RS2_FORMAT_RGBA8>(d, s, w, h, actual_size);
-            break;
-        case RS2_FORMAT_BGR8:
-            unpack_yuy2<RS2_FORMAT_BGR8>(d, s, w, h, actual_size);
-            break;
-        case RS2_FORMAT_BGRA8:
-            unpack_yuy2<RS2_FORMAT_BGRA8>(d, s, w, h, actual_size);
-            break;
-        case RS2_FORMAT_Y16:
-            unpack_yuy2<RS2_FORMAT_Y16>( d, s, w, h, actual_size );
-            break;
-        default:
-            LOG_ERROR("Unsupported format for YUY2 conversion.");
-            break;
-        }
-    }
-
-    void unpack_m420(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size)
-    {
-        LOG_DEBUG("unpack m420 called with dst_format: " << rs2_format_to_string(dst_format));
-        switch (dst_format)
-        {
-        case RS2_FORMAT_Y8:
-            unpack_m420<RS2_FORMAT_Y8>(d, s, w, h, actual_size);
-            break;
-        case RS2_FORMAT_Y16:
-            unpack_m420<RS2_FORMAT_Y16>(d, s, w, h, actual_size);
-            break;
-        case RS2_FORMAT_RGB8:
-            unpack_m420<RS2_FORMAT_RGB8>(d, s, w, h, actual_size);
-            break;
-        case RS2_FORMAT_RGBA8:
-            unpack_m420<RS2_FORMAT_RGBA8>(d, s, w, h, actual_size);
-            break;
-        case RS2_FORMAT_BGR8:
-            unpack_m420<RS2_FORMAT_BGR8>(d, s, w, h, actual_size);
-            break;
-        case RS2_FORMAT_BGRA8:
-            unpack_m420<RS2_FORMAT_BGRA8>(d, s, w, h, actual_size);
-            break;
-        default:
-            LOG_ERROR("Unsupported format for M420 conversion.");
-            break;
-        }
-    }
-
     /////////////////////////////
     // UYVY unpacking routines //
     /////////////////////////////
     // This templated function unpacks UYVY into RGB8/RGBA8/BGR8/BGRA8, depending on the compile-time parameter FORMAT.
     // It is expected that all branching outside of the loop control variable will be removed due to constant-folding.
-    template<rs2_format FORMAT> void unpack_uyvy( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size)
+    template<rs2_format FORMAT, color_isa ISA> void unpack_uyvy( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size)
     {
         auto n = width * height;
         assert(n % 16 == 0); // All currently supported color resolutions are multiples of 16 pixels. Could easily extend support to other resolutions by copying final n<16 pixels into a zero-padded buffer and recursively calling self for final iteration.
+#ifdef RS2_USE_OPENCL
+        if (opencl::unpack_uyvy(FORMAT, d, s, width, height))
+            return;
+#endif
 #ifdef __SSSE3__
+#ifdef RS2_USE_AVX
+        if (ISA != color_isa::baseline && n % 32 == 0)
+        {
+            if (ISA == color_isa::avx512)
+            {
+                if (FORMAT == RS2_FORMAT_RGB8) unpack_uyvy_avx512_rgb8(d, s, n);
+                if (FORMAT == RS2_FORMAT_RGBA8) unpack_uyvy_avx512_rgba8(d, s, n);
+                if (FORMAT == RS2_FORMAT_BGR8) unpack_uyvy_avx512_bgr8(d, s, n);
+                if (FORMAT == RS2_FORMAT_BGRA8) unpack_uyvy_avx512_bgra8(d, s, n);
+            }
+            else
+            {
+                if (FORMAT == RS2_FORMAT_RGB8) unpack_uyvy_avx_rgb8(d, s, n);
+                if (FORMAT == RS2_FORMAT_RGBA8) unpack_uyvy_avx_rgba8(d, s, n);
+                if (FORMAT == RS2_FORMAT_BGR8) unpack_uyvy_avx_bgr8(d, s, n);
+                if (FORMAT == RS2_FORMAT_BGRA8) unpack_uyvy_avx_bgra8(d, s, n);
+            }
+            return;
+        }
+#endif
         auto src = reinterpret_cast<const __m128i *>(s);
         auto dst = reinterpret_cast<__m128i *>(d[0]);
         for (; n; n -= 16)
@@ -938,7 +1002,9 @@ namespace librealsense
                 }
             }
         }
-#else  // Generic code for when SSSE3 is not available.
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        unpack_uyvy_neon<FORMAT>(d, s, n);
+#else  // Generic code for when neither SSSE3 nor NEON is available.
         auto src = reinterpret_cast<const uint8_t *>(s);
         auto dst = reinterpret_cast<uint8_t *>(d[0]);
         for (; n; n -= 16, src += 32)
@@ -1046,35 +1112,194 @@ namespace librealsense
 #endif
     }
 
-    void unpack_uyvyc(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size)
+    // The unpackers of a source format for each target format, with the kernels of an instruction set
+    template< color_isa ISA >
+    color_unpack_function find_unpacker( rs2_format source, rs2_format target )
     {
-        switch (dst_format)
+#define UNPACKER( F, T ) case RS2_FORMAT_##T: return &unpack_##F< RS2_FORMAT_##T, ISA >
+        switch( source )
         {
-        case RS2_FORMAT_RGB8:
-            unpack_uyvy<RS2_FORMAT_RGB8>(d, s, w, h, actual_size);
+        case RS2_FORMAT_YUYV:
+            switch( target )
+            {
+                UNPACKER( yuy2, Y8 );
+                UNPACKER( yuy2, Y16 );
+                UNPACKER( yuy2, RGB8 );
+                UNPACKER( yuy2, RGBA8 );
+                UNPACKER( yuy2, BGR8 );
+                UNPACKER( yuy2, BGRA8 );
+            default: break;
+            }
             break;
-        case RS2_FORMAT_RGBA8:
-            unpack_uyvy<RS2_FORMAT_RGBA8>(d, s, w, h, actual_size);
+        case RS2_FORMAT_M420:
+            switch( target )
+            {
+                UNPACKER( m420, Y8 );
+                UNPACKER( m420, Y16 );
+                UNPACKER( m420, RGB8 );
+                UNPACKER( m420, RGBA8 );
+                UNPACKER( m420, BGR8 );
+                UNPACKER( m420, BGRA8 );
+            default: break;
+            }
             break;
-        case RS2_FORMAT_BGR8:
-            unpack_uyvy<RS2_FORMAT_BGR8>(d, s, w, h, actual_size);
+        case RS2_FORMAT_UYVY:
+            switch( target )
+            {
+                UNPACKER( uyvy, RGB8 );
+                UNPACKER( uyvy, RGBA8 );
+                UNPACKER( uyvy, BGR8 );
+                UNPACKER( uyvy, BGRA8 );
+            default: break;
+            }
             break;
-        case RS2_FORMAT_BGRA8:
-            unpack_uyvy<RS2_FORMAT_BGRA8>(d, s, w, h, actual_size);
+        default:
+            break;
+        }
+#undef UNPACKER
+        return nullptr;
+    }
+
+    color_kernel find_color_kernel( rs2_format source, rs2_format target )
+    {
+        // The best the CPU has, of the kernels built for the source: those of YUY2 are AVX2 only, and need the
+        // compiler to target it; the others are in image-avx.cpp
+        color_isa isa = color_isa::baseline;
+#if defined __SSSE3__ && ! defined ANDROID
+#ifdef __AVX2__
+        if( source == RS2_FORMAT_YUYV && has_avx() )
+            isa = color_isa::avx2;
+#endif
+#ifdef RS2_USE_AVX
+        if( source != RS2_FORMAT_YUYV )
+            isa = has_avx512bw() ? color_isa::avx512 : has_avx2() ? color_isa::avx2 : color_isa::baseline;
+#endif
+#endif
+
+        color_kernel kernel;
+        switch( isa )
+        {
+#if defined __SSSE3__ && ! defined ANDROID
+#ifdef RS2_USE_AVX
+        case color_isa::avx512:
+            kernel.unpack = find_unpacker< color_isa::avx512 >( source, target );
             break;
+#endif
+#if defined RS2_USE_AVX || defined __AVX2__
+        case color_isa::avx2:
+            kernel.unpack = find_unpacker< color_isa::avx2 >( source, target );
+            break;
+#endif
+#endif
         default:
-            LOG_ERROR("Unsupported format for UYVY conversion.");
+            isa = color_isa::baseline;
+            kernel.unpack = find_unpacker< color_isa::baseline >( source, target );
             break;
         }
+        if( ! kernel.unpack )
+            return kernel;
+
+        const char * isa_name = "C++";
+#if defined __SSSE3__
+        isa_name = "SSSE3";
+#elif defined( __aarch64__ ) && defined( __ARM_NEON )
+        isa_name = "NEON";
+#endif
+        if( isa == color_isa::avx2 )
+            isa_name = "AVX2";
+        else if( isa == color_isa::avx512 )
+            isa_name = "AVX-512BW";
+        kernel.description = rsutils::string::from() << rs2_format_to_string( source ) << " to "
+                                                     << rs2_format_to_string( target ) << ", " << isa_name;
+        return kernel;
+    }
+
+    bool can_fuse_color_conversion( rs2_format source_order, rs2_format target )
+    {
+        switch( target )
+        {
+        case RS2_FORMAT_RGB8:
+        case RS2_FORMAT_RGBA8:
+        case RS2_FORMAT_BGR8:
+        case RS2_FORMAT_BGRA8:
+            return source_order == RS2_FORMAT_YUYV || source_order == RS2_FORMAT_UYVY;
+        case RS2_FORMAT_Y8:
+        case RS2_FORMAT_Y16:
+            return source_order == RS2_FORMAT_YUYV;
+        default:
+            return false;
+        }
+    }
+
+    // Writes every target from one band of the source before moving on to the next, using the same per-format
+    // kernels as the single converters
+    static void unpack_fused( const std::vector< color_kernel > & kernels, const std::vector< int > & bpps,
+                              uint8_t * const d[], const uint8_t * s, int w, int h )
+    {
+#if defined( RS2_USE_CUDA ) || defined( RS2_USE_VULKAN ) || defined( RS2_USE_OPENCL )
+        // The GPU backends take whole frames
+        int band = h;
+#else
+        // About 64KB of source, which stays in L2 while all the targets are written from it; the kernels work on 16
+        // pixels at a time, so narrower widths that aren't a multiple of that are done whole
+        int band = std::max( 1, ( 64 * 1024 ) / std::max( 1, w * 2 ) );
+        if( w % 16 )
+            band = h;
+#endif
+        for( int y = 0; y < h; y += band )
+        {
+            int rows = std::min( band, h - y );
+            auto src = s + size_t( y ) * w * 2;
+            for( size_t i = 0; i < kernels.size(); ++i )
+            {
+                uint8_t * plane[1] = { d[i] + size_t( y ) * w * bpps[i] };
+                if( kernels[i].unpack )
+                    kernels[i].unpack( plane, src, w, rows, rows * w * bpps[i] );
+            }
+        }
     }
 
     /////////////////////////////
     // MJPEG unpacking routines //
     /////////////////////////////
+#ifdef RS2_USE_TURBOJPEG
+    // libjpeg-turbo's SIMD decoder, with a handle per thread so frames can be decoded at the same time. False when the
+    // image isn't 'width' x 'height', or is corrupt, for stb_image to have a go.
+    static bool decode_turbojpeg(uint8_t * rgb, const uint8_t * jpeg, int size, int width, int height)
+    {
+        struct decompressor
+        {
+            tjhandle handle = tjInitDecompress();
+            ~decompressor() { if (handle) tjDestroy(handle); }
+        };
+        thread_local decompressor the_decompressor;
+        auto handle = the_decompressor.handle;
+        if (!handle)
+            return false;
+
+        // Older versions take non-const buffers, but don't write to them
+        auto buf = const_cast<unsigned char *>(jpeg);
+        int w, h, subsampling, colorspace;
+        if (tjDecompressHeader3(handle, buf, size, &w, &h, &subsampling, &colorspace) != 0 || w != width || h != height)
+            return false;
+        return tjDecompress2(handle, buf, size, rgb, width, 0, height, TJPF_RGB, TJFLAG_FASTDCT) == 0;
+    }
+#endif
+
     void unpack_mjpeg( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
     {
+        // The compressed size, when we know it, rather than the uncompressed
+        auto size = input_size ? input_size : actual_size;
+#ifdef RS2_USE_NVJPEG
+        if (cuda::decode_jpeg(dest[0], source, size, width, height))
+            return;
+#endif
+#ifdef RS2_USE_TURBOJPEG
+        if (decode_turbojpeg(dest[0], source, size, width, height))
+            return;
+#endif
         int w, h, bpp;
-        auto uncompressed_rgb = stbi_load_from_memory(source, actual_size, &w, &h, &bpp, false);
+        auto uncompressed_rgb = stbi_load_from_memory(source, size, &w, &h, &bpp, false);
         if (uncompressed_rgb)
         {
             auto uncompressed_size = w * h * bpp;
@@ -1101,14 +1326,122 @@ namespace librealsense
         }
     }
 
-    void yuy2_converter::process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
+    void color_converter::set_kernel( rs2_format source_format )
+    {
+        _kernel = find_color_kernel( source_format, _target_format );
+        if( _kernel.unpack )
+            register_info( RS2_CAMERA_INFO_CONVERSION_KERNEL, _kernel.description );
+        else
+            LOG_ERROR( "Unsupported format for " << rs2_format_to_string( source_format )
+                                                 << " conversion: " << rs2_format_to_string( _target_format ) );
+    }
+
+    void color_converter::process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
+    {
+        if( _kernel.unpack )
+            _kernel.unpack( dest, source, width, height, actual_size );
+    }
+
+    fused_color_converter::fused_color_converter( rs2_format source_order, std::vector< rs2_format > target_formats, rs2_stream target_stream )
+        : processing_block( "Fused Color Converter" )
+        , _source_order( source_order )
+        , _target_formats( std::move( target_formats ) )
+        , _target_stream( target_stream )
+    {
+        std::string kernels;
+        for( auto format : _target_formats )
+        {
+            _target_bpps.push_back( get_image_bpp( format ) / 8 );
+            _kernels.push_back( find_color_kernel( source_order, format ) );
+            if( ! kernels.empty() )
+                kernels += "; ";
+            kernels += _kernels.back().description;
+        }
+        register_info( RS2_CAMERA_INFO_CONVERSION_KERNEL, kernels );
+        configure_processing_callback();
+    }
+
+    void fused_color_converter::configure_processing_callback()
+    {
+        auto process_callback = [&]( frame_holder && frame, synthetic_source_interface * source )
+        {
+            auto profile = As< video_stream_profile, stream_profile_interface >( frame.frame->get_stream() );
+            if( ! profile )
+            {
+                LOG_ERROR( "Fused color converter got a frame that isn't video" );
+                return;
+            }
+
+            if( profile.get() != _source_stream_profile.get() )
+            {
+                _source_stream_profile = profile;
+                _target_stream_profiles.clear();
+                auto & profiles = environment::get_instance().get_output_profile_cache();
+                for( auto format : _target_formats )
+                    _target_stream_profiles.push_back(
+                        profiles.get( { profile.get(), _target_stream, profile->get_stream_index(), format } ) );
+            }
+
+            auto w = profile->get_width();
+            auto h = profile->get_height();
+            std::vector< frame_holder > targets;
+            std::vector< uint8_t * > planes;
+            targets.reserve( _target_formats.size() );
+            for( size_t i = 0; i < _target_formats.size(); ++i )
+            {
+                targets.push_back( source->allocate_video_frame( _target_stream_profiles[i], frame, _target_bpps[i],
+                                                                 w, h, w * _target_bpps[i], RS2_EXTENSION_VIDEO_FRAME ) );
+                if( ! targets.back() )
+                    return;
+                planes.push_back( (uint8_t *)targets.back().frame->get_frame_data() );
+            }
+
+            // Each thread goes over its own rows a cache-sized band at a time
+            auto src = (const uint8_t *)frame->get_frame_data();
+            for_each_row_band( w, h, [&]( int first_row, int rows, size_t first_byte ) {
+                std::vector< uint8_t * > band( planes.size() );
+                for( size_t i = 0; i < planes.size(); ++i )
+                    band[i] = planes[i] + size_t( first_row ) * w * _target_bpps[i];
+                unpack_fused( _kernels, _target_bpps, band.data(), src + first_byte, w, rows );
+            } );
+
+            for( auto & target : targets )
+                source->frame_ready( std::move( target ) );
+        };
+
+        set_processing_callback( make_frame_processor_callback( std::move( process_callback ) ) );
+    }
+
+    mjpeg_converter::mjpeg_converter(const char* name, rs2_format target_format)
+        : color_converter(name, target_format)
+        , _thread_pool(processing_thread_pool::instance())
     {
-        unpack_yuy2(_target_format, _target_stream, dest, source, width, height, actual_size);
+        register_option(RS2_OPTION_FRAMES_IN_FLIGHT, std::make_shared<ptr_option<float>>(1.f, 8.f, 1.f, 1.f, &_frames_in_flight,
+            "Frames decoded at the same time, on the processing thread pool; 1 decodes each frame as it arrives"));
+
+        // Frames go through the generic block's processing unless decoded ahead
+        auto process = _callback;
+        auto on_frame = [this, process](rs2::frame f, const rs2::frame_source& source)
+        {
+            if (_frames_in_flight > 1.f && should_process(f))
+            {
+                decode_async(source, f);
+                return;
+            }
+
+            // What's still in flight first, to keep the order
+            wait_for_jobs();
+            auto ptr = (frame_interface*)f.get();
+            ptr->acquire();
+            process->on_frame((rs2_frame*)ptr, _source_wrapper.get_rs2_source());
+        };
+        auto callback = new rs2::frame_processor_callback<decltype(on_frame)>(on_frame);
+        processing_block::set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(callback));
     }
 
-    void uyvy_converter::process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
+    mjpeg_converter::~mjpeg_converter()
     {
-        unpack_uyvyc(_target_format, _target_stream, dest, source, width, height, actual_size);
+        wait_for_jobs();
     }
 
     void mjpeg_converter::process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
@@ -1116,13 +1449,91 @@ namespace librealsense
         unpack_mjpeg(dest, source, width, height, actual_size, input_size);
     }
 
-    void bgr_to_rgb::process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
+    void mjpeg_converter::decode_async(const rs2::frame_source& source, const rs2::frame& f)
     {
-        unpack_rgb_from_bgr(dest, source, width, height, actual_size);
+        auto job = std::make_shared<decode_job>();
+        job->input = f;
+        bool on_caller;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            job->output = prepare_frame(source, f);
+        }
+        {
+            std::lock_guard<std::mutex> lock(_jobs_mutex);
+            _jobs.push_back(job);
+            // With that many in flight already, the caller decodes this one itself, rather than waiting for a worker
+            // (which may be busy with what it's running itself)
+            on_caller = _jobs.size() > size_t(_frames_in_flight);
+        }
+
+        if (on_caller)
+        {
+            decode(*job);
+            emit_done_jobs();
+        }
+        else
+            _thread_pool->submit([this, job]() {
+                decode(*job);
+                emit_done_jobs();
+            });
+    }
+
+    void mjpeg_converter::decode(decode_job& job)
+    {
+        auto vf = job.output.as<rs2::video_frame>();
+        int width = vf.get_width();
+        int height = vf.get_height();
+        int raw_size = job.input.supports_frame_metadata(RS2_FRAME_METADATA_RAW_FRAME_SIZE)
+                     ? static_cast<int>(job.input.get_frame_metadata(RS2_FRAME_METADATA_RAW_FRAME_SIZE))
+                     : static_cast<int>(job.input.get_data_size());
+        uint8_t * planes[1] = { (uint8_t *)job.output.get_data() };
+        try
+        {
+            process_function(planes, static_cast<const uint8_t *>(job.input.get_data()), width, height, height * width * _target_bpp, raw_size);
+        }
+        catch (std::exception const & e)
+        {
+            LOG_ERROR("MJPEG decode failed: " << e.what());
+        }
+
+        std::lock_guard<std::mutex> lock(_jobs_mutex);
+        job.done = true;
+    }
+
+    void mjpeg_converter::emit_done_jobs()
+    {
+        // Only the oldest can go out; whoever's done with it sends out what's done after it too
+        std::lock_guard<std::mutex> emit(_emit_mutex);
+        while (true)
+        {
+            std::shared_ptr<decode_job> job;
+            {
+                std::lock_guard<std::mutex> lock(_jobs_mutex);
+                if (_jobs.empty() || !_jobs.front()->done)
+                    break;
+                job = _jobs.front();
+            }
+
+            auto ptr = (frame_interface*)job->output.get();
+            ptr->acquire();
+            _source_wrapper.frame_ready(frame_holder(ptr));
+
+            {
+                std::lock_guard<std::mutex> lock(_jobs_mutex);
+                _jobs.pop_front();
+            }
+            _jobs_done.notify_all();
+        }
+    }
+
+    void mjpeg_converter::wait_for_jobs()
+    {
+        std::unique_lock<std::mutex> lock(_jobs_mutex);
+        _jobs_done.wait(lock, [this] { return _jobs.empty(); });
     }
 
-    void m420_converter::process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
+    void bgr_to_rgb::process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
     {
-        unpack_m420(_target_format, _target_stream, dest, source, width, height, actual_size);
+        unpack_rgb_from_bgr(dest, source, width, height, actual_size);
     }
 }
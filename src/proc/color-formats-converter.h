@@ -4,14 +4,47 @@
 #pragma once
 
 #include "synthetic-stream.h"
+#include "processing-thread-pool.h"
+
+#include <condition_variable>
+#include <deque>
 
 namespace librealsense
 {
+    // The instruction sets the color unpackers have kernels for, beyond the one the build targets (SSSE3, NEON or
+    // plain C++)
+    enum class color_isa
+    {
+        baseline,
+        avx2,
+        avx512
+    };
+
+    typedef void ( *color_unpack_function )( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size );
+
+    struct color_kernel
+    {
+        color_unpack_function unpack = nullptr;
+        std::string description;    // The formats and the instruction set, e.g. "YUYV to RGB8, AVX2"
+    };
+
+    // The unpacker of a YUYV, UYVY or M420 source to a target format, specialized at compile time for the pair and for
+    // the best instruction set this CPU has; none if there's no such conversion
+    color_kernel find_color_kernel( rs2_format source, rs2_format target );
+
+    // Converters with a kernel, which is looked up once, when the converter is made, and then called for every frame
+    // (or band of rows) without looking at the formats or the CPU again. It's reported as the
+    // RS2_CAMERA_INFO_CONVERSION_KERNEL of the block.
     class LRS_EXTENSION_API color_converter : public functional_processing_block
     {
     protected:
         color_converter(const char* name, rs2_format target_format, rs2_stream target_stream = RS2_STREAM_COLOR) :
             functional_processing_block(name, target_format, target_stream, RS2_EXTENSION_VIDEO_FRAME) {};
+
+        void set_kernel( rs2_format source_format );
+        void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+
+        color_kernel _kernel;
     };
 
     class LRS_EXTENSION_API yuy2_converter : public color_converter
@@ -22,10 +55,49 @@ namespace librealsense
 
     protected:
         yuy2_converter(const char* name, rs2_format target_format) :
-            color_converter(name, target_format) {};
-        void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+            color_converter(name, target_format) { set_kernel( RS2_FORMAT_YUYV ); };
+        bool get_row_group( int width, int & rows, size_t & source_bytes ) const override
+        {
+            rows = 1;
+            source_bytes = size_t( width ) * 2;
+            return true;
+        }
+    };
+
+    // Converts a YUY2 (or UYVY, by its byte order) frame to several formats at once. The source is gone over a band
+    // of rows at a time, and every target is written from the band while it's still in cache, so the frame is read
+    // from memory once rather than once per target. formats_converter puts it in place of the separate converters
+    // when more than one format is asked for from the same raw stream.
+    class LRS_EXTENSION_API fused_color_converter : public processing_block, public row_band_splitter
+    {
+    public:
+        fused_color_converter( rs2_format source_order, std::vector< rs2_format > target_formats, rs2_stream target_stream );
+
+        const std::vector< rs2_format > & get_target_formats() const { return _target_formats; }
+
+    protected:
+        bool get_row_group( int width, int & rows, size_t & source_bytes ) const override
+        {
+            rows = 1;
+            source_bytes = size_t( width ) * 2;
+            return true;
+        }
+
+    private:
+        void configure_processing_callback();
+
+        rs2_format _source_order;
+        std::vector< rs2_format > _target_formats;
+        rs2_stream _target_stream;
+        std::shared_ptr< stream_profile_interface > _source_stream_profile;
+        std::vector< std::shared_ptr< stream_profile_interface > > _target_stream_profiles;
+        std::vector< int > _target_bpps;
+        std::vector< color_kernel > _kernels;   // Of each target
     };
 
+    // Whether fused_color_converter can produce 'target' from a frame in 'source_order' (YUYV or UYVY)
+    bool can_fuse_color_conversion( rs2_format source_order, rs2_format target );
+
     class LRS_EXTENSION_API uyvy_converter : public color_converter
     {
     public:
@@ -34,20 +106,47 @@ namespace librealsense
 
     protected:
         uyvy_converter(const char* name, rs2_format target_format, rs2_stream target_stream) :
-            color_converter(name, target_format, target_stream) {};
-        void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+            color_converter(name, target_format, target_stream) { set_kernel( RS2_FORMAT_UYVY ); };
+        bool get_row_group( int width, int & rows, size_t & source_bytes ) const override
+        {
+            rows = 1;
+            source_bytes = size_t( width ) * 2;
+            return true;
+        }
     };
 
+    // With RS2_OPTION_FRAMES_IN_FLIGHT above 1, frames are decoded on the shared thread pool, several at a time, and
+    // output in the order they came in: decoding one no longer holds up the next
     class LRS_EXTENSION_API mjpeg_converter : public color_converter
     {
     public:
         mjpeg_converter(rs2_format target_format) :
             mjpeg_converter("MJPEG Converter", target_format) {};
+        ~mjpeg_converter();
 
     protected:
-        mjpeg_converter(const char* name, rs2_format target_format) :
-            color_converter(name, target_format) {};
+        mjpeg_converter(const char* name, rs2_format target_format);
         void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+
+    private:
+        struct decode_job
+        {
+            rs2::frame input;
+            rs2::frame output;
+            bool done = false;
+        };
+
+        void decode_async(const rs2::frame_source& source, const rs2::frame& f);
+        void decode(decode_job& job);
+        void emit_done_jobs();
+        void wait_for_jobs();
+
+        float _frames_in_flight = 1.f;
+        std::deque<std::shared_ptr<decode_job>> _jobs;  // In flight, in order
+        std::mutex _jobs_mutex;
+        std::mutex _emit_mutex;                         // Keeps the output in order
+        std::condition_variable _jobs_done;
+        std::shared_ptr<processing_thread_pool> _thread_pool;
     };
 
     class LRS_EXTENSION_API bgr_to_rgb : public color_converter
@@ -60,6 +159,12 @@ namespace librealsense
         bgr_to_rgb(const char* name) :
             color_converter(name, RS2_FORMAT_RGB8, RS2_STREAM_INFRARED) {};
         void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+        bool get_row_group( int width, int & rows, size_t & source_bytes ) const override
+        {
+            rows = 1;
+            source_bytes = size_t( width ) * 3;
+            return true;
+        }
     };
 
     class LRS_EXTENSION_API m420_converter : public color_converter
@@ -70,7 +175,13 @@ namespace librealsense
 
     protected:
         m420_converter(const char* name, rs2_format target_format) :
-            color_converter(name, target_format) {};
-        void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+            color_converter(name, target_format) { set_kernel( RS2_FORMAT_M420 ); };
+        // Two lines of Y followed by one of interleaved U and V
+        bool get_row_group( int width, int & rows, size_t & source_bytes ) const override
+        {
+            rows = 2;
+            source_bytes = size_t( width ) * 3;
+            return true;
+        }
     };
 }
@@ -7,10 +7,21 @@
 #include "proc/synthetic-stream.h"
 #include "context.h"
 #include "environment.h"
+#include "proc/output-profile-cache.h"
 #include "option.h"
 #include "colorizer.h"
 #include "disparity-transform.h"
 
+#ifdef RS2_USE_CUDA
+#include "proc/cuda/cuda-colorizer.h"
+#endif
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace librealsense
 {
     static color_map hue{ {
@@ -134,6 +145,15 @@ namespace librealsense
         { 0, 0, 0 },
         } };
 
+    std::shared_ptr<colorizer> colorizer::create()
+    {
+        #ifdef RS2_USE_CUDA
+            return std::make_shared<librealsense::colorizer_cuda>();
+        #else
+            return std::make_shared<librealsense::colorizer>();
+        #endif
+    }
+
     colorizer::colorizer()
         : colorizer("Depth Visualization")
     {}
@@ -141,7 +161,7 @@ namespace librealsense
     colorizer::colorizer(const char* name)
         : stream_filter_processing_block(name),
          _min(0.f), _max(6.f), _equalize(true), 
-         _target_stream_profile(), _histogram()
+         _target_stream_profile(), _histogram(), _threads(1)
     {
         _histogram = std::vector<int>(MAX_DEPTH, 0);
         _hist_data = _histogram.data();
@@ -238,6 +258,148 @@ namespace librealsense
         register_option(RS2_OPTION_VISUAL_PRESET, preset_opt);
 
         register_option(RS2_OPTION_HISTOGRAM_EQUALIZATION_ENABLED, hist_opt);
+
+        auto threads = std::make_shared<ptr_option<uint8_t>>(
+            uint8_t(1),
+            uint8_t(std::min(processing_thread_pool::max_threads(), 255)),
+            uint8_t(1),
+            uint8_t(1),
+            &_threads, "Number of threads to split the colorization across");
+        register_option(RS2_OPTION_FILTER_THREADS, threads);
+
+        auto refresh_opt = std::make_shared<ptr_option<int>>(1, 300, 1, 1, &_hist_refresh_interval,
+                                                             "Recompute the equalization histogram every N frames, or sooner if the scene changes");
+        register_option(RS2_OPTION_HISTOGRAM_REFRESH_INTERVAL, refresh_opt);
+    }
+
+    void colorizer::for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn)
+    {
+        if (_threads <= 1)
+        {
+            fn(0, count);
+            return;
+        }
+        if (!_thread_pool)
+            _thread_pool = processing_thread_pool::instance();
+        _thread_pool->parallel_for(count, _threads, fn);
+    }
+
+    template<typename T>
+    void colorizer::update_histogram_parallel(const T* depth_data, int w, int h)
+    {
+        if (_threads <= 1)
+        {
+            update_histogram(_hist_data, depth_data, w, h);
+            return;
+        }
+
+        // One partial histogram per band, so that the bands don't contend on the counters
+        _partial_histograms.resize(_threads);
+        for_each_band(_threads, [&](size_t begin, size_t end)
+        {
+            for (auto b = begin; b < end; ++b)
+            {
+                auto& partial = _partial_histograms[b];
+                partial.assign(MAX_DEPTH, 0);
+                auto first = size_t(w) * h * b / _threads, last = size_t(w) * h * (b + 1) / _threads;
+                for (auto i = first; i < last; ++i)
+                    partial[static_cast< int >( depth_data[i] )] += 1;
+            }
+        });
+
+        memcpy(_hist_data, _partial_histograms[0].data(), MAX_DEPTH * sizeof(int));
+        for (size_t b = 1; b < _partial_histograms.size(); ++b)
+        {
+            auto partial = _partial_histograms[b].data();
+            for (auto i = 0; i < MAX_DEPTH; ++i)
+                _hist_data[i] += partial[i];
+        }
+
+        for (auto i = 2; i < MAX_DEPTH; ++i) _hist_data[i] += _hist_data[i - 1]; // Build a cumulative histogram for the indices in [1,0xFFFF]
+    }
+
+    // Every this many pixels are compared to decide if the histogram is still representative
+    static const size_t drift_sample_step = 64;
+    // A sampled pixel moved when it turned valid/invalid or changed by more than 1/32 (~3%)
+    static const int drift_tolerance_shift = 5;
+    // The histogram is recomputed when more than 1/20 of the samples moved
+    static const size_t drift_threshold_div = 20;
+
+    template<typename T>
+    bool colorizer::histogram_drifted(const T* depth_data, int w, int h)
+    {
+        auto n = (size_t(w) * h + drift_sample_step - 1) / drift_sample_step;
+        if (_drift_sample.size() != n)
+            return true;
+
+        size_t moved = 0;
+        for (size_t k = 0; k < n; ++k)
+        {
+            float was = _drift_sample[k];
+            float now = float(depth_data[k * drift_sample_step]);
+            if (std::fabs(now - was) > std::ldexp(was, -drift_tolerance_shift) || (!now != !was))
+                ++moved;
+        }
+        return moved * drift_threshold_div > n;
+    }
+
+    template<typename T>
+    bool colorizer::refresh_histogram(const T* depth_data, int w, int h)
+    {
+        if (_hist_valid && _hist_refresh_interval > 1 && ++_frames_since_refresh < _hist_refresh_interval
+            && !histogram_drifted(depth_data, w, h))
+            return false;
+
+        update_histogram_parallel(depth_data, w, h);
+        _hist_valid = true;
+        _frames_since_refresh = 0;
+
+        _drift_sample.clear();
+        if (_hist_refresh_interval > 1)
+        {
+            for (size_t i = 0; i < size_t(w) * h; i += drift_sample_step)
+                _drift_sample.push_back(float(depth_data[i]));
+        }
+        return true;
+    }
+
+    void colorizer::make_rgb_data_from_lut(const uint16_t* depth_data, uint8_t* rgb_data, int width, int height)
+    {
+        auto lut = _lut.data();
+        for_each_band(size_t(width) * height, [&](size_t begin, size_t end)
+        {
+            auto i = begin;
+#if defined(__SSSE3__)
+            // 16 pixels at a time: look up 4 entries per register, drop the 4th byte of each and store them as 48 bytes
+            const __m128i pack = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+            for (; i + 16 <= end; i += 16)
+            {
+                __m128i px[4];
+                for (int k = 0; k < 4; ++k)
+                {
+                    auto d = depth_data + i + 4 * k;
+                    px[k] = _mm_shuffle_epi8(_mm_setr_epi32(int(lut[d[0]]), int(lut[d[1]]), int(lut[d[2]]), int(lut[d[3]])), pack);
+                }
+                auto dst = reinterpret_cast<__m128i*>(rgb_data + i * 3);
+                _mm_storeu_si128(dst, _mm_or_si128(px[0], _mm_slli_si128(px[1], 12)));
+                _mm_storeu_si128(dst + 1, _mm_or_si128(_mm_srli_si128(px[1], 4), _mm_slli_si128(px[2], 8)));
+                _mm_storeu_si128(dst + 2, _mm_or_si128(_mm_srli_si128(px[2], 8), _mm_slli_si128(px[3], 4)));
+            }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+            // 16 pixels at a time: look up the entries, then drop their 4th byte with a de-interleaving load
+            for (; i + 16 <= end; i += 16)
+            {
+                uint32_t px[16];
+                for (int k = 0; k < 16; ++k)
+                    px[k] = lut[depth_data[i + k]];
+                uint8x16x4_t rgbx = vld4q_u8(reinterpret_cast<const uint8_t*>(px));
+                uint8x16x3_t rgb = { { rgbx.val[0], rgbx.val[1], rgbx.val[2] } };
+                vst3q_u8(rgb_data + i * 3, rgb);
+            }
+#endif
+            for (; i < end; ++i)
+                memcpy(rgb_data + i * 3, &lut[depth_data[i]], 3);
+        });
     }
 
     bool colorizer::should_process(const rs2::frame& frame)
@@ -251,20 +413,46 @@ namespace librealsense
         return true;
     }
 
-    rs2::frame colorizer::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    void colorizer::update_configuration(const rs2::frame& f)
     {
         if (f.as<rs2::depth_frame>())
             _depth_units = ((depth_frame*)f.get())->get_units();
         if (f.get_profile().get() != _source_stream_profile.get())
         {
             _source_stream_profile = f.get_profile();
-            _target_stream_profile = f.get_profile().clone(RS2_STREAM_DEPTH, f.get_profile().stream_index(), RS2_FORMAT_RGB8);
+            _hist_valid = false;
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(f.get_profile(), RS2_STREAM_DEPTH, f.get_profile().stream_index(), RS2_FORMAT_RGB8);
 
             // workaround for D457
             //auto info = disparity_info::update_info_from_frame(f);
             //_d2d_convert_factor = info.d2d_convert_factor;
             _d2d_convert_factor = 681678.625;
         }
+    }
+
+    bool colorizer::update_cropped_lut()
+    {
+        auto min = _min;
+        auto max = _max;
+        auto coloring_function = [&, this](float data) {
+            if (min >= max) return 0.f;
+            return (data * _depth_units - min) / (max - min);
+        };
+        if (!_lut_equalized && _lut_map_index == _map_index && _lut_min == min && _lut_max == max && _lut_depth_units == _depth_units)
+            return false;
+
+        update_lut(coloring_function);
+        _lut_equalized = false;
+        _lut_map_index = _map_index;
+        _lut_min = min;
+        _lut_max = max;
+        _lut_depth_units = _depth_units;
+        return true;
+    }
+
+    rs2::frame colorizer::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        update_configuration(f);
 
         auto make_equalized_histogram = [this](const rs2::video_frame& depth, rs2::video_frame rgb)
         {
@@ -280,19 +468,28 @@ namespace librealsense
             if (depth_format == RS2_FORMAT_DISPARITY32)
             {
                 auto depth_data = reinterpret_cast<const float*>(depth.get_data());
-                update_histogram(_hist_data, depth_data, w, h);
+                refresh_histogram(depth_data, w, h);
                 make_rgb_data<float>(depth_data, rgb_data, w, h, coloring_function);
             }
             else if (depth_format == RS2_FORMAT_Z16)
             {
                 auto depth_data = reinterpret_cast<const uint16_t*>(depth.get_data());
-                update_histogram(_hist_data, depth_data, w, h);
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+                // The LUT follows the histogram
+                if (refresh_histogram(depth_data, w, h) || !_lut_equalized || _lut_map_index != _map_index)
+                {
+                    update_lut(coloring_function);
+                    _lut_equalized = true;
+                    _lut_map_index = _map_index;
+                }
+                make_rgb_data_from_lut(depth_data, rgb_data, w, h);
             }
         };
 
         auto make_value_cropped_frame = [this](const rs2::video_frame& depth, rs2::video_frame rgb)
         {
+            // The histogram isn't kept up to date meanwhile
+            _hist_valid = false;
+
             auto depth_format = depth.get_profile().format();
             const auto w = depth.get_width(), h = depth.get_height();
             auto rgb_data = reinterpret_cast<uint8_t*>(const_cast<void *>(rgb.get_data()));
@@ -314,13 +511,8 @@ namespace librealsense
             else if (depth_format == RS2_FORMAT_Z16)
             {
                 auto depth_data = reinterpret_cast<const uint16_t*>(depth.get_data());
-                auto min = _min;
-                auto max = _max;
-                auto coloring_function = [&, this](float data) {
-                    if (min >= max) return 0.f;
-                    return (data * _depth_units - min) / (max - min);
-                };
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+                update_cropped_lut();
+                make_rgb_data_from_lut(depth_data, rgb_data, w, h);
             }
         };
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <src/float3.h>
+#include "processing-thread-pool.h"
 
 #include <map>
 #include <vector>
@@ -99,6 +100,9 @@ namespace librealsense {
     class LRS_EXTENSION_API colorizer : public stream_filter_processing_block
     {
     public:
+        // The CUDA implementation when there is one
+        static std::shared_ptr<colorizer> create();
+
         colorizer();
 
         template<typename T>
@@ -124,6 +128,52 @@ namespace librealsense {
         bool should_process(const rs2::frame& frame) override;
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
+        // Follows the input's stream profile and depth units
+        void update_configuration(const rs2::frame& f);
+
+        // The histogram of update_histogram(), computed over bands of the frame in parallel and then merged
+        template<typename T>
+        void update_histogram_parallel(const T* depth_data, int w, int h);
+
+        // Precomputes the color of every Z16 value, so that colorizing a pixel becomes a table lookup. Each entry
+        // holds R, G, B, 0 in memory order; 0 is always black.
+        template<typename F>
+        void update_lut(F coloring_func)
+        {
+            auto cm = _maps[_map_index];
+            _lut.resize(MAX_DEPTH);
+            _lut[0] = 0;
+            for_each_band(MAX_DEPTH - 1, [&](size_t begin, size_t end)
+            {
+                for (auto d = begin + 1; d <= end; ++d)
+                {
+                    auto c = cm->get(coloring_func(float(d)));
+                    auto entry = reinterpret_cast<uint8_t*>(&_lut[d]);
+                    entry[0] = (uint8_t)c.x;
+                    entry[1] = (uint8_t)c.y;
+                    entry[2] = (uint8_t)c.z;
+                    entry[3] = 0;
+                }
+            });
+        }
+
+        // Whether the histogram has to be recomputed for this frame, when it is only refreshed periodically: compares a
+        // sparse sample of the frame against the same pixels when it was last computed
+        template<typename T>
+        bool histogram_drifted(const T* depth_data, int w, int h);
+
+        // Recomputes the histogram unless it can still be reused; returns whether it did
+        template<typename T>
+        bool refresh_histogram(const T* depth_data, int w, int h);
+
+        // Rebuilds the LUT for the value-cropped (not equalized) coloring, unless it's already for the current options;
+        // returns whether it did
+        bool update_cropped_lut();
+
+        void make_rgb_data_from_lut(const uint16_t* depth_data, uint8_t* rgb_data, int width, int height);
+
+        void for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn);
+
         template<typename T, typename F>
         void make_rgb_data(const T* depth_data, uint8_t* rgb_data, int width, int height, F coloring_func)
         {
@@ -169,5 +219,20 @@ namespace librealsense {
 
         float   _depth_units = 0.f;
         float   _d2d_convert_factor = 0.f;
+
+        std::vector<uint32_t> _lut;
+        std::vector<std::vector<int>> _partial_histograms;
+        // What the LUT was built for; it is rebuilt on any change
+        bool    _lut_equalized = false;
+        int     _lut_map_index = -1;
+        float   _lut_min = 0.f, _lut_max = 0.f, _lut_depth_units = 0.f;
+
+        int     _hist_refresh_interval = 1;
+        int     _frames_since_refresh = 0;
+        bool    _hist_valid = false;            // _histogram matches the current stream, and may be reused
+        std::vector<float> _drift_sample;       // The sampled pixels when the histogram was last computed
+
+        uint8_t _threads;
+        std::shared_ptr<processing_thread_pool> _thread_pool;
     };
 }
@@ -19,11 +19,6 @@ using namespace rscuda;
 
 template<int N> struct bytes { unsigned char b[N]; };
 
-int calc_block_size(int pixel_count, int thread_count)
-{
-    return ((pixel_count % thread_count) == 0) ? (pixel_count / thread_count) : (pixel_count / thread_count + 1);
-}
-
 __device__ void kernel_transfer_pixels(int2* mapped_pixels, const rs2_intrinsics* depth_intrin,
     const rs2_intrinsics* other_intrin, const rs2_extrinsics* depth_to_other, float depth_val, int depth_x, int depth_y, int block_index)
 {
@@ -129,6 +124,8 @@ __global__  void kernel_replace_to_zero(uint16_t* aligned_out, const rs2_intrins
 {
     int x = blockIdx.x * blockDim.x + threadIdx.x;
     int y = blockIdx.y * blockDim.y + threadIdx.y;
+    if (x >= other_intrin->width || y >= other_intrin->height)
+        return;
 
     auto other_pixel_index = y * other_intrin->width + x;
     if (aligned_out[other_pixel_index] == 0xffff)
@@ -137,7 +134,8 @@ __global__  void kernel_replace_to_zero(uint16_t* aligned_out, const rs2_intrins
 
 void align_cuda_helper::align_other_to_depth(unsigned char* h_aligned_out, const uint16_t* h_depth_in,
     float depth_scale, const rs2_intrinsics& h_depth_intrin, const rs2_extrinsics& h_depth_to_other,
-    const rs2_intrinsics& h_other_intrin, const unsigned char* h_other_in, rs2_format other_format, int other_bytes_per_pixel)
+    const rs2_intrinsics& h_other_intrin, const unsigned char* h_other_in, rs2_format other_format, int other_bytes_per_pixel,
+    const uint16_t* d_depth_in, const unsigned char* d_other_in, unsigned char* d_aligned_out)
 {
     int depth_pixel_count = h_depth_intrin.width * h_depth_intrin.height;
     int other_pixel_count = h_other_intrin.width * h_other_intrin.height;
@@ -151,42 +149,76 @@ void align_cuda_helper::align_other_to_depth(unsigned char* h_aligned_out, const
     if (!_d_other_intrinsics) _d_other_intrinsics = make_device_copy(h_other_intrin);
     if (!_d_depth_other_extrinsics) _d_depth_other_extrinsics = make_device_copy(h_depth_to_other);
 
-    if (!_d_depth_in) _d_depth_in = alloc_dev<uint16_t>(aligned_pixel_count);
-    cudaMemcpy(_d_depth_in.get(), h_depth_in, depth_size, cudaMemcpyHostToDevice);
+    if (!_stream) _stream = create_stream();
+    if (!_copy_stream) _copy_stream = create_stream();
+    if (!_other_copied) _other_copied = create_event();
+    cudaStream_t stream = _stream.get();
+    cudaStream_t copy_stream = _copy_stream.get();
 
-    if (!_d_other_in) _d_other_in = alloc_dev<unsigned char>(other_size);
-    cudaMemcpy(_d_other_in.get(), h_other_in, other_size, cudaMemcpyHostToDevice);
+    if (!d_depth_in)
+    {
+        if (!_d_depth_in) _d_depth_in = alloc_dev<uint16_t>(aligned_pixel_count);
+        if (!_h_depth_in) _h_depth_in = alloc_host<uint16_t>(aligned_pixel_count);
+        memcpy(_h_depth_in.get(), h_depth_in, depth_size);
+        cudaMemcpyAsync(_d_depth_in.get(), _h_depth_in.get(), depth_size, cudaMemcpyHostToDevice, stream);
+        d_depth_in = _d_depth_in.get();
+    }
 
-    if (!_d_aligned_out)
-        _d_aligned_out = alloc_dev<unsigned char>(aligned_size);
-    cudaMemset(_d_aligned_out.get(), 0, aligned_size);
+    unsigned char* aligned_out = d_aligned_out;
+    if (!aligned_out)
+    {
+        if (!_d_aligned_out) _d_aligned_out = alloc_dev<unsigned char>(aligned_size);
+        if (!_h_aligned_out) _h_aligned_out = alloc_host<unsigned char>(aligned_size);
+        aligned_out = _d_aligned_out.get();
+    }
+    cudaMemsetAsync(aligned_out, 0, aligned_size, stream);
 
     if (!_d_pixel_map) _d_pixel_map = alloc_dev<int2>(depth_pixel_count * 2);
 
     // config threads
     dim3 threads(RS2_CUDA_THREADS_PER_BLOCK, RS2_CUDA_THREADS_PER_BLOCK);
-    dim3 depth_blocks(calc_block_size(h_depth_intrin.width, threads.x), calc_block_size(h_depth_intrin.height, threads.y));
+    dim3 depth_blocks(calc_blocks(h_depth_intrin.width, threads.x), calc_blocks(h_depth_intrin.height, threads.y));
     dim3 mapping_blocks(depth_blocks.x, depth_blocks.y, 2);
 
-    kernel_map_depth_to_other <<<mapping_blocks,threads>>> (_d_pixel_map.get(), _d_depth_in.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get(),
+    kernel_map_depth_to_other <<<mapping_blocks, threads, 0, stream>>> (_d_pixel_map.get(), d_depth_in, _d_depth_intrinsics.get(), _d_other_intrinsics.get(),
         _d_depth_other_extrinsics.get(), depth_scale);
 
+    // The other frame is staged and uploaded while the pixels are being mapped, and only needed from here on
+    if (!d_other_in)
+    {
+        if (!_d_other_in) _d_other_in = alloc_dev<unsigned char>(other_size);
+        if (!_h_other_in) _h_other_in = alloc_host<unsigned char>(other_size);
+        memcpy(_h_other_in.get(), h_other_in, other_size);
+        cudaMemcpyAsync(_d_other_in.get(), _h_other_in.get(), other_size, cudaMemcpyHostToDevice, copy_stream);
+        cudaEventRecord(_other_copied.get(), copy_stream);
+        cudaStreamWaitEvent(stream, _other_copied.get(), 0);
+        d_other_in = _d_other_in.get();
+    }
+
     switch (other_bytes_per_pixel)
     {
-    case 1: kernel_other_to_depth<1> <<<depth_blocks,threads>>> (_d_aligned_out.get(), _d_other_in.get(), _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
-    case 2: kernel_other_to_depth<2> <<<depth_blocks,threads>>> (_d_aligned_out.get(), _d_other_in.get(), _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
-    case 3: kernel_other_to_depth<3> <<<depth_blocks,threads>>> (_d_aligned_out.get(), _d_other_in.get(), _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
-    case 4: kernel_other_to_depth<4> <<<depth_blocks,threads>>> (_d_aligned_out.get(), _d_other_in.get(), _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
+    case 1: kernel_other_to_depth<1> <<<depth_blocks, threads, 0, stream>>> (aligned_out, d_other_in, _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
+    case 2: kernel_other_to_depth<2> <<<depth_blocks, threads, 0, stream>>> (aligned_out, d_other_in, _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
+    case 3: kernel_other_to_depth<3> <<<depth_blocks, threads, 0, stream>>> (aligned_out, d_other_in, _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
+    case 4: kernel_other_to_depth<4> <<<depth_blocks, threads, 0, stream>>> (aligned_out, d_other_in, _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
+    }
+
+    if (d_aligned_out)
+    {
+        cudaStreamSynchronize(stream);
+        return;
     }
 
-    cudaStreamSynchronize(0);
+    cudaMemcpyAsync(_h_aligned_out.get(), aligned_out, aligned_size, cudaMemcpyDeviceToHost, stream);
+    cudaStreamSynchronize(stream);
 
-    cudaMemcpy(h_aligned_out, _d_aligned_out.get(), aligned_size, cudaMemcpyDeviceToHost);
+    memcpy(h_aligned_out, _h_aligned_out.get(), aligned_size);
 }
 
 void align_cuda_helper::align_depth_to_other(unsigned char* h_aligned_out, const uint16_t* h_depth_in,
     float depth_scale, const rs2_intrinsics& h_depth_intrin, const rs2_extrinsics& h_depth_to_other,
-    const rs2_intrinsics& h_other_intrin)
+    const rs2_intrinsics& h_other_intrin,
+    const uint16_t* d_depth_in, unsigned char* d_aligned_out)
 {
     int depth_pixel_count = h_depth_intrin.width * h_depth_intrin.height;
     int other_pixel_count = h_other_intrin.width * h_other_intrin.height;
@@ -200,31 +232,53 @@ void align_cuda_helper::align_depth_to_other(unsigned char* h_aligned_out, const
     if (!_d_other_intrinsics) _d_other_intrinsics = make_device_copy(h_other_intrin);
     if (!_d_depth_other_extrinsics) _d_depth_other_extrinsics = make_device_copy(h_depth_to_other);
 
-    if (!_d_depth_in) _d_depth_in = alloc_dev<uint16_t>(depth_pixel_count);
-    cudaMemcpy(_d_depth_in.get(), h_depth_in, depth_byte_size, cudaMemcpyHostToDevice);
+    if (!_stream) _stream = create_stream();
+    cudaStream_t stream = _stream.get();
+
+    if (!d_depth_in)
+    {
+        if (!_d_depth_in) _d_depth_in = alloc_dev<uint16_t>(depth_pixel_count);
+        if (!_h_depth_in) _h_depth_in = alloc_host<uint16_t>(depth_pixel_count);
+        memcpy(_h_depth_in.get(), h_depth_in, depth_byte_size);
+        cudaMemcpyAsync(_d_depth_in.get(), _h_depth_in.get(), depth_byte_size, cudaMemcpyHostToDevice, stream);
+        d_depth_in = _d_depth_in.get();
+    }
 
-    if (!_d_aligned_out) _d_aligned_out = alloc_dev<unsigned char>(aligned_byte_size);
-    cudaMemset(_d_aligned_out.get(), 0xff, aligned_byte_size);
+    unsigned char* aligned_out = d_aligned_out;
+    if (!aligned_out)
+    {
+        if (!_d_aligned_out) _d_aligned_out = alloc_dev<unsigned char>(aligned_byte_size);
+        if (!_h_aligned_out) _h_aligned_out = alloc_host<unsigned char>(aligned_byte_size);
+        aligned_out = _d_aligned_out.get();
+    }
+    cudaMemsetAsync(aligned_out, 0xff, aligned_byte_size, stream);
 
     if (!_d_pixel_map) _d_pixel_map = alloc_dev<int2>(depth_pixel_count * 2);
 
     // config threads
     dim3 threads(RS2_CUDA_THREADS_PER_BLOCK, RS2_CUDA_THREADS_PER_BLOCK);
-    dim3 depth_blocks(calc_block_size(h_depth_intrin.width, threads.x), calc_block_size(h_depth_intrin.height, threads.y));
-    dim3 other_blocks(calc_block_size(h_other_intrin.width, threads.x), calc_block_size(h_other_intrin.height, threads.y));
+    dim3 depth_blocks(calc_blocks(h_depth_intrin.width, threads.x), calc_blocks(h_depth_intrin.height, threads.y));
+    dim3 other_blocks(calc_blocks(h_other_intrin.width, threads.x), calc_blocks(h_other_intrin.height, threads.y));
     dim3 mapping_blocks(depth_blocks.x, depth_blocks.y, 2);
 
-    kernel_map_depth_to_other <<<mapping_blocks,threads>>> (_d_pixel_map.get(), _d_depth_in.get(), _d_depth_intrinsics.get(),
+    kernel_map_depth_to_other <<<mapping_blocks, threads, 0, stream>>> (_d_pixel_map.get(), d_depth_in, _d_depth_intrinsics.get(),
         _d_other_intrinsics.get(), _d_depth_other_extrinsics.get(), depth_scale);
 
-    kernel_depth_to_other <<<depth_blocks,threads>>> ((uint16_t*)_d_aligned_out.get(), _d_depth_in.get(), _d_pixel_map.get(),
+    kernel_depth_to_other <<<depth_blocks, threads, 0, stream>>> ((uint16_t*)aligned_out, d_depth_in, _d_pixel_map.get(),
         _d_depth_intrinsics.get(), _d_other_intrinsics.get());
 
-    kernel_replace_to_zero <<<other_blocks, threads>>> ((uint16_t*)_d_aligned_out.get(), _d_other_intrinsics.get());
+    kernel_replace_to_zero <<<other_blocks, threads, 0, stream>>> ((uint16_t*)aligned_out, _d_other_intrinsics.get());
+
+    if (d_aligned_out)
+    {
+        cudaStreamSynchronize(stream);
+        return;
+    }
 
-    cudaStreamSynchronize(0);
+    cudaMemcpyAsync(_h_aligned_out.get(), aligned_out, aligned_byte_size, cudaMemcpyDeviceToHost, stream);
+    cudaStreamSynchronize(stream);
 
-    cudaMemcpy(h_aligned_out, _d_aligned_out.get(), aligned_pixel_count * 2, cudaMemcpyDeviceToHost);
+    memcpy(h_aligned_out, _h_aligned_out.get(), aligned_byte_size);
 }
 
 #endif //RS2_USE_CUDA
@@ -5,6 +5,9 @@
 #include <memory>
 #include <stdint.h>
 
+struct CUstream_st;
+struct CUevent_st;
+
 namespace librealsense
 {
     class align_cuda_helper
@@ -15,13 +18,17 @@ namespace librealsense
             _d_other_in(nullptr),
             _d_aligned_out(nullptr) {}
 
+        // Inputs that are already on the device (d_depth_in, d_other_in) are used from there, instead of the host ones.
+        // With d_aligned_out, the result is left there and h_aligned_out isn't touched.
         void align_other_to_depth(unsigned char* h_aligned_out, const uint16_t* h_depth_in,
             float depth_scale, const rs2_intrinsics& h_depth_intrin, const rs2_extrinsics& h_depth_to_other,
-            const rs2_intrinsics& h_other_intrin, const unsigned char* h_other_in, rs2_format other_format, int other_bytes_per_pixel);
+            const rs2_intrinsics& h_other_intrin, const unsigned char* h_other_in, rs2_format other_format, int other_bytes_per_pixel,
+            const uint16_t* d_depth_in = nullptr, const unsigned char* d_other_in = nullptr, unsigned char* d_aligned_out = nullptr);
 
         void align_depth_to_other(unsigned char* h_aligned_out, const uint16_t* h_depth_in,
             float depth_scale, const rs2_intrinsics& h_depth_intrin, const rs2_extrinsics& h_depth_to_other,
-            const rs2_intrinsics& h_other_intrin);
+            const rs2_intrinsics& h_other_intrin,
+            const uint16_t* d_depth_in = nullptr, unsigned char* d_aligned_out = nullptr);
 
     private:
         std::shared_ptr<uint16_t>       _d_depth_in;
@@ -32,6 +39,16 @@ namespace librealsense
         std::shared_ptr<rs2_intrinsics> _d_other_intrinsics;
         std::shared_ptr<rs2_intrinsics> _d_depth_intrinsics;
         std::shared_ptr<rs2_extrinsics> _d_depth_other_extrinsics;
+
+        // Frames go through pinned staging so the copies can be asynchronous; the other frame is uploaded on its own
+        // stream while the depth is being mapped
+        std::shared_ptr<uint16_t>       _h_depth_in;
+        std::shared_ptr<unsigned char>  _h_other_in;
+        std::shared_ptr<unsigned char>  _h_aligned_out;
+
+        std::shared_ptr<CUstream_st>    _stream;
+        std::shared_ptr<CUstream_st>    _copy_stream;
+        std::shared_ptr<CUevent_st>     _other_copied;
     };
 }
 #endif // RS2_USE_CUDA
@@ -5,6 +5,8 @@
 
 #include "proc/align.h"
 #include "cuda-align.cuh"
+#include "cuda/cuda-frame.h"
+#include "cuda/cuda-device.h"
 #include <memory>
 #include <stdint.h>
 
@@ -13,54 +15,111 @@ namespace librealsense
     class align_cuda : public align
     {
     public:
-        align_cuda(rs2_stream align_to) : align(align_to, "Align (CUDA)") {}
+        align_cuda(rs2_stream align_to) : align(align_to, "Align (CUDA)"), _cuda_device(*this)
+        {
+            // Aligned frames stay on the device, for whatever CUDA block comes next
+            _source.add_extension<cuda::cuda_video_frame>(RS2_EXTENSION_VIDEO_FRAME_CUDA);
+            _source.add_extension<cuda::cuda_depth_frame>(RS2_EXTENSION_DEPTH_FRAME_CUDA);
+        }
 
     protected:
+        // The aligners' buffers and streams are on the device they were made on: they're made again on another one
+        int select_device()
+        {
+            bool moved;
+            auto device = _cuda_device.select(moved);
+            if (moved)
+                aligners.clear();
+            return device;
+        }
+
         void reset_cache(rs2_stream from, rs2_stream to) override
         {
             aligners[std::tuple<rs2_stream, rs2_stream>(from, to)] = align_cuda_helper();
         }
 
-        void align_z_to_other(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale) override
+        rs2_extension select_extension(const rs2::frame& input) override
         {
-            uint8_t * aligned_data = reinterpret_cast<uint8_t *>(const_cast<void*>(aligned.get_data()));
+            return input.is<rs2::depth_frame>() ? RS2_EXTENSION_DEPTH_FRAME_CUDA : RS2_EXTENSION_VIDEO_FRAME_CUDA;
+        }
+
+        // The aligned frame is filled in on the device: its host data is only written when someone asks for it
+        static uint8_t * device_output(rs2::video_frame& aligned)
+        {
+            auto section = cuda::section_of((frame_interface*)aligned.get());
+            if (!section)
+                return nullptr;
             auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
-            memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
+            return section->output(aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
+        }
+
+        // Host data for what's only on the host; fetching the rest would defeat the purpose
+        template<class T>
+        static const T* host_input(const rs2::frame& f)
+        {
+            return cuda::device_data((frame_interface*)f.get()) ? nullptr : reinterpret_cast<const T*>(f.get_data());
+        }
+
+        // The depth in the grid of the output scale. Below 1 it's sampled down on the host, from the device if it's
+        // there, and goes in from the host; the buffers and the pixel map on the device are as much smaller.
+        const uint16_t* depth_input(const rs2::video_frame& depth, rs2_intrinsics& z_intrin, const uint16_t*& d_z_pixels)
+        {
+            d_z_pixels = reinterpret_cast<const uint16_t*>(cuda::device_data((frame_interface*)depth.get()));
+            if (_frame_scale >= 1.f)
+            {
+                z_intrin = depth.get_profile().as<rs2::video_stream_profile>().get_intrinsics();
+                return host_input<uint16_t>(depth);
+            }
+            d_z_pixels = nullptr;
+            return scaled_depth(depth, z_intrin);
+        }
+
+        void align_z_to_other(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale) override
+        {
+            cuda::device_scope scope(select_device());
+            auto d_aligned = device_output(aligned);
+            uint8_t * aligned_data = d_aligned ? nullptr : reinterpret_cast<uint8_t *>(const_cast<void*>(aligned.get_data()));
 
             auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
 
-            auto z_intrin = depth_profile.get_intrinsics();
-            auto other_intrin = other_profile.get_intrinsics();
+            // Into the grid of the aligned frame, which may be smaller than the other's
+            rs2_intrinsics z_intrin;
+            const uint16_t* d_z_pixels;
+            auto z_pixels = depth_input(depth, z_intrin, d_z_pixels);
+            auto other_intrin = aligned.get_profile().as<rs2::video_stream_profile>().get_intrinsics();
             auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
 
-            auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
             auto& aligner = aligners[std::tuple<rs2_stream, rs2_stream>(RS2_STREAM_DEPTH, other_profile.stream_type())];
-            aligner.align_depth_to_other(aligned_data, z_pixels, z_scale, z_intrin, z_to_other, other_intrin);
+            aligner.align_depth_to_other(aligned_data, z_pixels, z_scale, z_intrin, z_to_other, other_intrin, d_z_pixels, d_aligned);
         }
 
         void align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale) override
         {
-            uint8_t * aligned_data = reinterpret_cast<uint8_t *>(const_cast<void*>(aligned.get_data()));
-            auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
-            memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
-            
+            cuda::device_scope scope(select_device());
+            auto d_aligned = device_output(aligned);
+            uint8_t * aligned_data = d_aligned ? nullptr : reinterpret_cast<uint8_t *>(const_cast<void*>(aligned.get_data()));
+
             auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
             auto other_profile = other.get_profile().as<rs2::video_stream_profile>();
 
-            auto z_intrin = depth_profile.get_intrinsics();
+            rs2_intrinsics z_intrin;
+            const uint16_t* d_z_pixels;
+            auto z_pixels = depth_input(depth, z_intrin, d_z_pixels);
             auto other_intrin = other_profile.get_intrinsics();
             auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
 
-            auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
-            auto other_pixels = reinterpret_cast<const uint8_t *>(other.get_data());
+            auto other_pixels = host_input<uint8_t>(other);
+            auto d_other_pixels = cuda::device_data((frame_interface*)other.get());
 
             auto& aligner = aligners[std::tuple<rs2_stream, rs2_stream>(other_profile.stream_type(), RS2_STREAM_DEPTH)];
             aligner.align_other_to_depth(
-                aligned_data, z_pixels, z_scale, z_intrin, z_to_other, other_intrin, other_pixels, other_profile.format(), other.get_bytes_per_pixel());
+                aligned_data, z_pixels, z_scale, z_intrin, z_to_other, other_intrin, other_pixels, other_profile.format(), other.get_bytes_per_pixel(),
+                d_z_pixels, d_other_pixels, d_aligned);
         }
 
     private:
         std::map<std::tuple<rs2_stream, rs2_stream>, align_cuda_helper> aligners;
+        cuda::device_option _cuda_device;
     };
 }
 #endif // RS2_USE_CUDA
@@ -0,0 +1,83 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#include "proc/cuda/cuda-colorizer.h"
+
+#ifdef RS2_USE_CUDA
+#include "cuda-colorizer.cuh"
+#include "../../cuda/cuda-frame.h"
+
+namespace librealsense
+{
+    colorizer_cuda::colorizer_cuda()
+        : _cuda_device(*this)
+    {
+        // The colorized frames stay on the device until they're read
+        _source.add_extension<cuda::cuda_video_frame>(RS2_EXTENSION_VIDEO_FRAME_CUDA);
+    }
+
+    rs2::frame colorizer_cuda::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        if (f.get_profile().format() != RS2_FORMAT_Z16)
+            return colorizer::process_frame(source, f);
+
+        update_configuration(f);
+
+        bool moved;
+        cuda::device_scope scope(_cuda_device.select(moved));
+        if (moved)
+        {
+            _stage = cuda_filter_stage();
+            _d_hist = _d_lut = _d_cache = cuda_buffer();
+            _d_cache_map = -1;
+            _d_lut_cropped = false;
+        }
+
+        auto vf = f.as<rs2::video_frame>();
+        const auto w = vf.get_width(), h = vf.get_height();
+        const auto count = size_t(w) * h;
+        rs2::frame ret = source.allocate_video_frame(_target_stream_profile, f, 3, w, h, w * 3, RS2_EXTENSION_VIDEO_FRAME_CUDA);
+
+        auto d_depth = cuda::device_data((frame_interface*)f.get());
+        auto depth = static_cast<const uint16_t*>(_stage.input(d_depth ? nullptr : f.get_data(), d_depth, count * sizeof(uint16_t)));
+        auto section = cuda::section_of((frame_interface*)ret.get());
+        auto rgb = static_cast<uint8_t*>(_stage.output(section ? section->output(count * 3) : nullptr, count * 3));
+        auto lut = reinterpret_cast<uint32_t*>(_d_lut.reserve(MAX_DEPTH * sizeof(uint32_t)));
+
+        if (_equalize)
+        {
+            // Neither the CPU's histogram nor its LUT follow this
+            _hist_valid = false;
+            _lut_map_index = -1;
+            _d_lut_cropped = false;
+
+            auto cm = _maps[_map_index];
+            auto& cache = cm->get_cache();
+            auto d_cache = _d_cache.reserve(cache.size() * sizeof(float3));
+            if (_d_cache_map != _map_index)
+            {
+                _stage.upload(d_cache, cache.data(), cache.size() * sizeof(float3));
+                _d_cache_map = _map_index;
+            }
+
+            auto hist = reinterpret_cast<int*>(_d_hist.reserve(MAX_DEPTH * sizeof(int)));
+            cuda_colorizer::update_histogram(_stage.stream(), depth, count, hist);
+            cuda_colorizer::equalized_lut(_stage.stream(), hist, reinterpret_cast<const float*>(d_cache), int(cache.size()),
+                cm->min_key(), cm->max_key(), lut);
+        }
+        else
+        {
+            // The value-cropped LUT only changes with the options: it's built on the CPU, and uploaded when it does
+            _hist_valid = false;
+            if (update_cropped_lut() || !_d_lut_cropped)
+            {
+                _stage.upload(lut, _lut.data(), MAX_DEPTH * sizeof(uint32_t));
+                _d_lut_cropped = true;
+            }
+        }
+
+        cuda_colorizer::colorize(_stage.stream(), depth, lut, rgb, count);
+        _stage.finish(section ? nullptr : const_cast<void*>(ret.get_data()));
+        return ret;
+    }
+}
+#endif // RS2_USE_CUDA
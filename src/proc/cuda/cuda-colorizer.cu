@@ -0,0 +1,140 @@
+#ifdef RS2_USE_CUDA
+
+#include "cuda-colorizer.cuh"
+#include "../../cuda/rscuda_utils.cuh"
+
+// CUDA headers
+#include <cuda_runtime.h>
+
+#include <algorithm>
+
+#ifdef _MSC_VER
+// Add library dependencies if using VS
+#pragma comment(lib, "cudart_static")
+#endif
+
+#define RS2_CUDA_THREADS_PER_BLOCK 256
+#define RS2_CUDA_HISTOGRAM_BINS 0x10000
+#define RS2_CUDA_HISTOGRAM_SLICE 0x2000         // Bins counted in shared memory by each block: 32KB
+#define RS2_CUDA_HISTOGRAM_BLOCKS 64            // Blocks sharing the pixels, per slice
+#define RS2_CUDA_SCAN_THREADS 1024
+
+using namespace librealsense;
+using namespace rscuda;
+
+// Each block counts the pixels of its share that fall in its slice of the bins, in shared memory, then adds its counts
+// to the histogram: the atomics on global memory are one per bin rather than one per pixel
+__global__ void kernel_histogram(const uint16_t* depth, size_t count, int* hist)
+{
+    __shared__ int slice[RS2_CUDA_HISTOGRAM_SLICE];
+    const int first = blockIdx.y * RS2_CUDA_HISTOGRAM_SLICE;
+
+    for (int i = threadIdx.x; i < RS2_CUDA_HISTOGRAM_SLICE; i += blockDim.x)
+        slice[i] = 0;
+    __syncthreads();
+
+    for (size_t i = size_t(blockIdx.x) * blockDim.x + threadIdx.x; i < count; i += size_t(gridDim.x) * blockDim.x)
+    {
+        int bin = int(depth[i]) - first;
+        if (bin >= 0 && bin < RS2_CUDA_HISTOGRAM_SLICE)
+            atomicAdd(&slice[bin], 1);
+    }
+    __syncthreads();
+
+    for (int i = threadIdx.x; i < RS2_CUDA_HISTOGRAM_SLICE; i += blockDim.x)
+        if (slice[i])
+            atomicAdd(&hist[first + i], slice[i]);
+}
+
+// The cumulative histogram for the indices in [1,0xFFFF], in one block: each thread sums a run of bins, then the
+// runs' totals are scanned and added back
+__global__ void kernel_cumulative_histogram(int* hist)
+{
+    __shared__ int totals[RS2_CUDA_SCAN_THREADS];
+    const int per_thread = RS2_CUDA_HISTOGRAM_BINS / RS2_CUDA_SCAN_THREADS;
+    const int begin = threadIdx.x * per_thread;
+    const int first = begin ? begin : 1;
+
+    int sum = 0;
+    for (int i = first; i < begin + per_thread; ++i)
+    {
+        sum += hist[i];
+        hist[i] = sum;
+    }
+    totals[threadIdx.x] = sum;
+    __syncthreads();
+
+    for (int offset = 1; offset < RS2_CUDA_SCAN_THREADS; offset <<= 1)
+    {
+        int v = threadIdx.x >= offset ? totals[threadIdx.x - offset] : 0;
+        __syncthreads();
+        totals[threadIdx.x] += v;
+        __syncthreads();
+    }
+
+    int base = threadIdx.x ? totals[threadIdx.x - 1] : 0;
+    for (int i = first; i < begin + per_thread; ++i)
+        hist[i] += base;
+}
+
+// color_map::get() of the equalized coloring function, rounding each float operation on its own like the CPU does
+__global__ void kernel_equalized_lut(const int* hist, const float* cache, int cache_size, float min_key, float max_key, uint32_t* lut)
+{
+    int d = blockIdx.x * blockDim.x + threadIdx.x;
+    if (d >= RS2_CUDA_HISTOGRAM_BINS)
+        return;
+    if (!d)
+    {
+        lut[0] = 0;
+        return;
+    }
+
+    const float* c = cache;
+    if (max_key != min_key)
+    {
+        float value = __fdiv_rn(float(hist[d]), float(hist[RS2_CUDA_HISTOGRAM_BINS - 1]));
+        float t = __fdiv_rn(__fsub_rn(value, min_key), __fsub_rn(max_key, min_key));
+        t = (1.f < t) ? 1.f : t;  // std::min( t, 1.f )
+        t = (0.f < t) ? t : 0.f;  // std::max( 0.f, t ), NaN included
+        c += 3 * int(__fmul_rn(t, float(cache_size - 1)));
+    }
+    lut[d] = uint32_t(uint8_t(c[0])) | (uint32_t(uint8_t(c[1])) << 8) | (uint32_t(uint8_t(c[2])) << 16);
+}
+
+__global__ void kernel_colorize(const uint16_t* depth, const uint32_t* lut, uint8_t* rgb, size_t count)
+{
+    size_t i = size_t(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (i >= count)
+        return;
+    uint32_t entry = lut[depth[i]];
+    rgb[i * 3 + 0] = uint8_t(entry);
+    rgb[i * 3 + 1] = uint8_t(entry >> 8);
+    rgb[i * 3 + 2] = uint8_t(entry >> 16);
+}
+
+void cuda_colorizer::update_histogram(CUstream_st* stream, const uint16_t* depth, size_t count, int* hist)
+{
+    cudaMemsetAsync(hist, 0, RS2_CUDA_HISTOGRAM_BINS * sizeof(int), stream);
+
+    dim3 blocks(std::min(calc_blocks(int(count), RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_HISTOGRAM_BLOCKS),
+                RS2_CUDA_HISTOGRAM_BINS / RS2_CUDA_HISTOGRAM_SLICE);
+    if (count)
+        kernel_histogram<<<blocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(depth, count, hist);
+    kernel_cumulative_histogram<<<1, RS2_CUDA_SCAN_THREADS, 0, stream>>>(hist);
+}
+
+void cuda_colorizer::equalized_lut(CUstream_st* stream, const int* hist, const float* cache, int cache_size,
+    float min_key, float max_key, uint32_t* lut)
+{
+    kernel_equalized_lut<<<calc_blocks(RS2_CUDA_HISTOGRAM_BINS, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+        hist, cache, cache_size, min_key, max_key, lut);
+}
+
+void cuda_colorizer::colorize(CUstream_st* stream, const uint16_t* depth, const uint32_t* lut, uint8_t* rgb, size_t count)
+{
+    if (count)
+        kernel_colorize<<<calc_blocks(int(count), RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+            depth, lut, rgb, count);
+}
+
+#endif // RS2_USE_CUDA
@@ -0,0 +1,26 @@
+#pragma once
+#ifdef RS2_USE_CUDA
+
+#include <stdint.h>
+#include <stddef.h>
+
+struct CUstream_st;
+
+namespace librealsense
+{
+    // The colorizer's passes over Z16 depth, on device memory. They do what the CPU versions do, to the bit.
+    namespace cuda_colorizer
+    {
+        // colorizer::update_histogram(): the count of each of the 0x10000 values, cumulative from 1 on
+        void update_histogram(CUstream_st* stream, const uint16_t* depth, size_t count, int* hist);
+
+        // The equalized LUT of colorizer::update_lut(), from the histogram and a color map's cache (x, y, z floats
+        // per entry) and keys
+        void equalized_lut(CUstream_st* stream, const int* hist, const float* cache, int cache_size,
+            float min_key, float max_key, uint32_t* lut);
+
+        // colorizer::make_rgb_data_from_lut()
+        void colorize(CUstream_st* stream, const uint16_t* depth, const uint32_t* lut, uint8_t* rgb, size_t count);
+    }
+}
+#endif // RS2_USE_CUDA
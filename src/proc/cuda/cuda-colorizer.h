@@ -0,0 +1,35 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+#ifdef RS2_USE_CUDA
+
+#include "../synthetic-stream.h"
+#include "../colorizer.h"
+#include "cuda-depth-filters.cuh"
+#include "../../cuda/cuda-device.h"
+
+namespace librealsense
+{
+    // The colorizer on the GPU for Z16 depth: the histogram, the equalized LUT and the colorizing itself, with the
+    // same results as on the CPU. Depth that's already on the device is taken from there, and the colorized frame is
+    // left there until it's read. Disparity is still colorized on the CPU.
+    //
+    // The equalization histogram is recomputed for every frame: on the GPU that's cheaper than checking whether the
+    // last one can be reused, so the refresh interval option doesn't apply.
+    class colorizer_cuda : public colorizer
+    {
+    public:
+        colorizer_cuda();
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        cuda_filter_stage _stage;
+        cuda_buffer _d_hist, _d_lut, _d_cache;
+        int _d_cache_map = -1;          // The color map _d_cache holds
+        bool _d_lut_cropped = false;    // _d_lut holds the CPU's value-cropped _lut
+        cuda::device_option _cuda_device;
+    };
+}
+#endif // RS2_USE_CUDA
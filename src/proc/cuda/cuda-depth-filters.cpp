@@ -0,0 +1,257 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#include "proc/cuda/cuda-depth-filters.h"
+
+#ifdef RS2_USE_CUDA
+#include "../../cuda/cuda-frame.h"
+
+namespace librealsense
+{
+    // The input frame's content on the device: where a CUDA block left it, or else uploaded from the host
+    static const void* device_input(cuda_filter_stage& stage, const rs2::frame& f, size_t size)
+    {
+        auto d_in = cuda::device_data((frame_interface*)f.get());
+        return stage.input(d_in ? nullptr : f.get_data(), d_in, size);
+    }
+
+    // The target frame's content on the device, left there for whoever comes next
+    static void* device_output(cuda_filter_stage& stage, const rs2::frame& tgt, size_t size)
+    {
+        auto section = cuda::section_of((frame_interface*)tgt.get());
+        return stage.output(section ? section->output(size) : nullptr, size);
+    }
+
+    // Done when the stream is: a target that isn't a CUDA frame gets the output on the host
+    static void finish(cuda_filter_stage& stage, const rs2::frame& tgt)
+    {
+        auto section = cuda::section_of((frame_interface*)tgt.get());
+        stage.finish(section ? nullptr : const_cast<void*>(tgt.get_data()));
+    }
+
+    // The block's device, with the stage made again when it isn't the one it was on
+    static int select_device(cuda::device_option& option, cuda_filter_stage& stage)
+    {
+        bool moved;
+        auto device = option.select(moved);
+        if (moved)
+            stage = cuda_filter_stage();
+        return device;
+    }
+
+    static rs2_extension cuda_extension(rs2_extension type)
+    {
+        return type == RS2_EXTENSION_DISPARITY_FRAME ? RS2_EXTENSION_DISPARITY_FRAME_CUDA : RS2_EXTENSION_DEPTH_FRAME_CUDA;
+    }
+
+    // The filtered frames stay on the device, for whatever CUDA block comes next
+    static void add_cuda_extensions(frame_source& block_source)
+    {
+        block_source.add_extension<cuda::cuda_depth_frame>(RS2_EXTENSION_DEPTH_FRAME_CUDA);
+        block_source.add_extension<cuda::cuda_disparity_frame>(RS2_EXTENSION_DISPARITY_FRAME_CUDA);
+    }
+
+    disparity_transform_cuda::disparity_transform_cuda(bool transform_to_disparity)
+        : disparity_transform(transform_to_disparity), _cuda_device(*this)
+    {
+        add_cuda_extensions(_source);
+    }
+
+    rs2::frame disparity_transform_cuda::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        cuda::device_scope scope(select_device(_cuda_device, _stage));
+        rs2::frame tgt;
+
+        update_transformation_profile(f);
+
+        if (_stereoscopic_depth && (tgt = source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height),
+            int(_width * _bpp), _transform_to_disparity ? RS2_EXTENSION_DISPARITY_FRAME_CUDA : RS2_EXTENSION_DEPTH_FRAME_CUDA)))
+        {
+            auto count = _width * _height;
+            if (_transform_to_disparity)
+            {
+                auto in = static_cast<const uint16_t*>(device_input(_stage, f, count * sizeof(uint16_t)));
+                auto out = static_cast<float*>(device_output(_stage, tgt, count * sizeof(float)));
+                cuda_filters::depth_to_disparity(_stage.stream(), in, out, count, _d2d_convert_factor);
+            }
+            else
+            {
+                auto in = static_cast<const float*>(device_input(_stage, f, count * sizeof(float)));
+                auto out = static_cast<uint16_t*>(device_output(_stage, tgt, count * sizeof(uint16_t)));
+                cuda_filters::disparity_to_depth(_stage.stream(), in, out, count, _d2d_convert_factor);
+            }
+            finish(_stage, tgt);
+        }
+
+        return tgt;
+    }
+
+    decimation_filter_cuda::decimation_filter_cuda()
+        : _cuda_device(*this)
+    {
+        add_cuda_extensions(_source);
+        _source.add_extension<cuda::cuda_video_frame>(RS2_EXTENSION_VIDEO_FRAME_CUDA);
+    }
+
+    rs2::frame decimation_filter_cuda::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        cuda::device_scope scope(select_device(_cuda_device, _stage));
+        // Only depth has a kernel: the other formats are decimated on the CPU
+        if (f.get_profile().format() != RS2_FORMAT_Z16)
+            return decimation_filter::process_frame(source, f);
+
+        update_output_profile(f);
+
+        auto src = f.as<rs2::video_frame>();
+        rs2_stream type = f.get_profile().stream_type();
+        auto tgt_type = (type == RS2_STREAM_COLOR || type == RS2_STREAM_INFRARED) ? RS2_EXTENSION_VIDEO_FRAME_CUDA : RS2_EXTENSION_DEPTH_FRAME_CUDA;
+
+        if (auto tgt = prepare_target_frame(f, source, tgt_type))
+        {
+            auto roi = output_roi(f);
+            auto in = static_cast<const uint16_t*>(device_input(_stage, f, size_t(src.get_width()) * src.get_height() * sizeof(uint16_t)));
+            auto out = static_cast<uint16_t*>(device_output(_stage, tgt, size_t(_padded_width) * _padded_height * sizeof(uint16_t)));
+            cuda_filters::decimate_depth(_stage.stream(), in, out, src.get_width(), _patch_size, _padded_width, _padded_height,
+                roi.min_x, roi.min_x + roi_width(roi), roi.min_y, roi.min_y + roi_height(roi));
+            finish(_stage, tgt);
+            set_roi(tgt, roi, _padded_width, _padded_height);
+            return tgt;
+        }
+        return f;
+    }
+
+    spatial_filter_cuda::spatial_filter_cuda()
+        : _cuda_device(*this)
+    {
+        add_cuda_extensions(_source);
+    }
+
+    rs2::frame spatial_filter_cuda::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        cuda::device_scope scope(select_device(_cuda_device, _stage));
+        update_configuration(f);
+        auto roi = get_roi(f, int(_width), int(_height));
+        if (!is_full_roi(roi, int(_width), int(_height)))
+            return spatial_filter::process_frame(source, f);
+
+        rs2::frame tgt = source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height), int(_stride),
+            cuda_extension(_extension_type));
+
+        auto size = _current_frm_size_pixels * _bpp;
+        auto in = device_input(_stage, f, size);
+        auto out = device_output(_stage, tgt, size);
+        _stage.copy(out, in, size);
+
+        if (_width > 2 && _height > 2)
+        {
+            if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
+                cuda_filters::spatial_smooth(_stage.stream(), static_cast<float*>(out), int(_width), int(_height), _spatial_alpha_param,
+                    _spatial_edge_threshold, _spatial_iterations, _holes_filling_mode, _holes_filling_radius);
+            else
+                cuda_filters::spatial_smooth(_stage.stream(), static_cast<uint16_t*>(out), int(_width), int(_height), _spatial_alpha_param,
+                    _spatial_edge_threshold, _spatial_iterations, _holes_filling_mode, _holes_filling_radius);
+        }
+
+        finish(_stage, tgt);
+        set_roi(tgt, roi, int(_width), int(_height));
+        return tgt;
+    }
+
+    temporal_filter_cuda::temporal_filter_cuda()
+        : _cuda_device(*this)
+    {
+        add_cuda_extensions(_source);
+    }
+
+    rs2::frame temporal_filter_cuda::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        // The warp of motion compensation is of the CPU's history
+        if (_motion_compensation)
+            return temporal_filter::process_frame(source, f);
+
+        bool moved;
+        cuda::device_scope scope(_cuda_device.select(moved));
+        if (moved)
+        {
+            // The history is on the last device: start over
+            _stage = cuda_filter_stage();
+            _d_last_frame = cuda_buffer();
+            _d_history = cuda_buffer();
+            _last_frame.clear();
+        }
+
+        const bool new_profile = f.get_profile().get() != _source_stream_profile.get();
+        update_configuration(f);
+        auto roi = get_roi(f, int(_width), int(_height));
+        if (!is_full_roi(roi, int(_width), int(_height)))
+            return temporal_filter::process_frame(source, f);
+
+        rs2::frame tgt = source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height), int(_stride),
+            cuda_extension(_extension_type));
+
+        auto size = _current_frm_size_pixels * _bpp;
+        auto in = device_input(_stage, f, size);
+        auto out = device_output(_stage, tgt, size);
+        _stage.copy(out, in, size);
+
+        // The history lives on the device, and starts over whenever the CPU's would: _last_frame is only a marker here
+        auto last_frame = _d_last_frame.reserve(size);
+        auto history = _d_history.reserve(_current_frm_size_pixels);
+        if (new_profile || _last_frame.empty() || roi.min_x != _history_roi.min_x || roi.min_y != _history_roi.min_y
+            || roi.max_x != _history_roi.max_x || roi.max_y != _history_roi.max_y)
+        {
+            _history_roi = roi;
+            _last_frame.assign(size, 0);
+            _stage.zero(last_frame, size);
+            _stage.zero(history, _current_frm_size_pixels);
+        }
+
+        uint8_t mask = 1 << _cur_frame_index;
+        if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
+            cuda_filters::temporal_smooth(_stage.stream(), static_cast<float*>(out), reinterpret_cast<float*>(last_frame), history,
+                _current_frm_size_pixels, _alpha_param, _one_minus_alpha, _delta_param, mask, _persistence_map.data());
+        else
+            cuda_filters::temporal_smooth(_stage.stream(), static_cast<uint16_t*>(out), reinterpret_cast<uint16_t*>(last_frame), history,
+                _current_frm_size_pixels, _alpha_param, _one_minus_alpha, _delta_param, mask, _persistence_map.data());
+        _cur_frame_index = (_cur_frame_index + 1) % 8;  // at end of cycle
+
+        finish(_stage, tgt);
+        set_roi(tgt, roi, int(_width), int(_height));
+        return tgt;
+    }
+
+    hole_filling_filter_cuda::hole_filling_filter_cuda()
+        : _cuda_device(*this)
+    {
+        add_cuda_extensions(_source);
+    }
+
+    rs2::frame hole_filling_filter_cuda::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        cuda::device_scope scope(select_device(_cuda_device, _stage));
+        update_configuration(f);
+        auto roi = get_roi(f, int(_width), int(_height));
+        if (!is_full_roi(roi, int(_width), int(_height)))
+            return hole_filling_filter::process_frame(source, f);
+
+        rs2::frame tgt = source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height), int(_stride),
+            cuda_extension(_extension_type));
+
+        auto size = _current_frm_size_pixels * _bpp;
+        auto in = device_input(_stage, f, size);
+        auto out = device_output(_stage, tgt, size);
+        _stage.copy(out, in, size);
+
+        if (_width && _height)
+        {
+            if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
+                cuda_filters::hole_filling(_stage.stream(), static_cast<float*>(out), int(_width), int(_height), _hole_filling_mode);
+            else
+                cuda_filters::hole_filling(_stage.stream(), static_cast<uint16_t*>(out), int(_width), int(_height), _hole_filling_mode);
+        }
+
+        finish(_stage, tgt);
+        set_roi(tgt, roi, int(_width), int(_height));
+        return tgt;
+    }
+}
+#endif // RS2_USE_CUDA
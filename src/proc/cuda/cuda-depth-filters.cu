@@ -0,0 +1,640 @@
+#ifdef RS2_USE_CUDA
+
+#include "cuda-depth-filters.cuh"
+#include "../../cuda/rscuda_utils.cuh"
+
+// CUDA headers
+#include <cuda_runtime.h>
+
+#include <cstring>
+
+#ifdef _MSC_VER
+// Add library dependencies if using VS
+#pragma comment(lib, "cudart_static")
+#endif
+
+#define RS2_CUDA_THREADS_PER_BLOCK 256
+#define RS2_CUDA_THREADS_PER_BLOCK_2D 16
+
+using namespace librealsense;
+using namespace rscuda;
+
+// The CPU code rounds every float operation, with no fused multiply-adds: so do these, for the same bits
+__device__ inline float blend(float a, float wa, float b, float wb)
+{
+    return __fadd_rn(__fmul_rn(a, wa), __fmul_rn(b, wb));
+}
+
+// Float to 16-bit depth, truncating: values that don't fit are clamped, like the aarch64 conversion does
+__device__ inline uint16_t to_depth(float x)
+{
+    return static_cast<uint16_t>(__float2uint_rz(x));
+}
+
+template<typename T> __device__ inline T from_float(float x);
+template<> __device__ inline uint16_t from_float<uint16_t>(float x) { return to_depth(x); }
+template<> __device__ inline float from_float<float>(float x) { return x; }
+
+// A pixel is a hole when it is all zero bits
+__device__ inline bool empty(const uint16_t* p) { return !*p; }
+__device__ inline bool empty(const float* p) { return !__float_as_int(*p); }
+
+__device__ inline uint16_t abs_diff(uint16_t a, uint16_t b) { return static_cast<uint16_t>(abs(int(a) - int(b))); }
+__device__ inline float abs_diff(float a, float b) { return fabsf(__fsub_rn(a, b)); }
+
+uint8_t* cuda_buffer::reserve(size_t bytes)
+{
+    if (bytes > size)
+    {
+        data.reset();
+        size = 0;
+        data = alloc_dev<uint8_t>(int(bytes));
+        size = bytes;
+    }
+    return data.get();
+}
+
+CUstream_st* cuda_filter_stage::stream()
+{
+    if (!_stream)
+        _stream = create_stream();
+    return _stream.get();
+}
+
+const void* cuda_filter_stage::input(const void* h_in, const void* d_in, size_t size)
+{
+    if (d_in)
+        return d_in;
+
+    if (size > _d_in.size)
+        _h_in = alloc_host<uint8_t>(int(size));
+    _d_in.reserve(size);
+    memcpy(_h_in.get(), h_in, size);
+    cudaMemcpyAsync(_d_in.data.get(), _h_in.get(), size, cudaMemcpyHostToDevice, stream());
+    return _d_in.data.get();
+}
+
+void* cuda_filter_stage::output(void* d_out, size_t size)
+{
+    _out_size = size;
+    if (d_out)
+    {
+        _downloaded = nullptr;
+        return d_out;
+    }
+
+    if (size > _d_out.size)
+        _h_out = alloc_host<uint8_t>(int(size));
+    _downloaded = _d_out.reserve(size);
+    return _downloaded;
+}
+
+void cuda_filter_stage::copy(void* d_out, const void* d_in, size_t size)
+{
+    cudaMemcpyAsync(d_out, d_in, size, cudaMemcpyDeviceToDevice, stream());
+}
+
+void cuda_filter_stage::zero(void* d, size_t size)
+{
+    cudaMemsetAsync(d, 0, size, stream());
+}
+
+void cuda_filter_stage::upload(void* d, const void* h, size_t size)
+{
+    cudaMemcpyAsync(d, h, size, cudaMemcpyHostToDevice, stream());
+}
+
+void cuda_filter_stage::finish(void* h_out)
+{
+    if (_downloaded)
+        cudaMemcpyAsync(_h_out.get(), _downloaded, _out_size, cudaMemcpyDeviceToHost, stream());
+    cudaStreamSynchronize(stream());
+    if (_downloaded)
+        memcpy(h_out, _h_out.get(), _out_size);
+}
+
+//
+// Disparity transform
+//
+__global__ void kernel_depth_to_disparity(const uint16_t* in, float* out, size_t count, float factor)
+{
+    size_t i = size_t(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (i >= count)
+        return;
+    out[i] = in[i] ? __fdiv_rn(factor, float(in[i])) : 0.f;
+}
+
+__global__ void kernel_disparity_to_depth(const float* in, uint16_t* out, size_t count, float factor)
+{
+    size_t i = size_t(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (i >= count)
+        return;
+    // std::isnormal: neither zero/subnormal nor inf/nan
+    int exponent = __float_as_int(in[i]) & 0x7F800000;
+    out[i] = (exponent && exponent != 0x7F800000) ? to_depth(__fadd_rn(__fdiv_rn(factor, in[i]), 0.5f)) : 0;
+}
+
+void cuda_filters::depth_to_disparity(CUstream_st* stream, const uint16_t* in, float* out, size_t count, float d2d_convert_factor)
+{
+    kernel_depth_to_disparity<<<calc_blocks(int(count), RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+        in, out, count, d2d_convert_factor);
+}
+
+void cuda_filters::disparity_to_depth(CUstream_st* stream, const float* in, uint16_t* out, size_t count, float d2d_convert_factor)
+{
+    kernel_disparity_to_depth<<<calc_blocks(int(count), RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+        in, out, count, d2d_convert_factor);
+}
+
+//
+// Decimation
+//
+__global__ void kernel_decimate_depth(const uint16_t* in, uint16_t* out, int width_in, int scale,
+    int padded_width, int padded_height, int col_begin, int col_end, int row_begin, int row_end)
+{
+    int x = blockIdx.x * blockDim.x + threadIdx.x;
+    int y = blockIdx.y * blockDim.y + threadIdx.y;
+    if (x >= padded_width || y >= padded_height)
+        return;
+
+    uint16_t result = 0;
+    if (x >= col_begin && x < col_end && y >= row_begin && y < row_end)
+    {
+        const uint16_t* patch = in + size_t(y) * scale * width_in + size_t(x) * scale;
+        if (scale == 2 || scale == 3)
+        {
+            // The median of the valid values, the one below the middle for even counts: what opt_med*() pick
+            uint16_t v[9];
+            int k = 0;
+            for (int n = 0; n < scale; ++n)
+                for (int m = 0; m < scale; ++m)
+                    if (auto p = patch[n * width_in + m])
+                        v[k++] = p;
+            for (int i = 1; i < k; ++i)
+                for (int j = i; j > 0 && v[j - 1] > v[j]; --j)
+                {
+                    auto t = v[j];
+                    v[j] = v[j - 1];
+                    v[j - 1] = t;
+                }
+            if (k)
+                result = v[(k - 1) / 2];
+        }
+        else
+        {
+            int sum = 0;
+            int counter = 0;
+            for (int n = 0; n < scale; ++n)
+                for (int m = 0; m < scale; ++m)
+                    if (auto p = patch[n * width_in + m])
+                    {
+                        sum += p;
+                        ++counter;
+                    }
+            result = counter == 0 ? 0 : sum / counter;
+        }
+    }
+    out[size_t(y) * padded_width + x] = result;
+}
+
+void cuda_filters::decimate_depth(CUstream_st* stream, const uint16_t* in, uint16_t* out, int width_in, int scale,
+    int padded_width, int padded_height, int col_begin, int col_end, int row_begin, int row_end)
+{
+    dim3 threads(RS2_CUDA_THREADS_PER_BLOCK_2D, RS2_CUDA_THREADS_PER_BLOCK_2D);
+    dim3 blocks(calc_blocks(padded_width, threads.x), calc_blocks(padded_height, threads.y));
+    kernel_decimate_depth<<<blocks, threads, 0, stream>>>(in, out, width_in, scale, padded_width, padded_height,
+        col_begin, col_end, row_begin, row_end);
+}
+
+//
+// Spatial filter: each pass is sequential along a row or a column, so there's a thread per row or column
+//
+__global__ void kernel_spatial_horizontal(uint16_t* image, int width, int height, float alpha, float deltaZ, uint8_t holes_filling_radius)
+{
+    int v = blockIdx.x * blockDim.x + threadIdx.x;
+    if (v >= height)
+        return;
+
+    const float round = 0.5f;
+    const uint16_t valid_threshold = 1;
+    const uint16_t delta_z = static_cast<uint16_t>(deltaZ);
+    const float one_minus_alpha = __fsub_rn(1.0f, alpha);
+    size_t cur_fill = 0;
+
+    // left to right
+    uint16_t* im = image + size_t(v) * width;
+    uint16_t val0 = im[0];
+    for (int u = 1; u < width - 1; u++)
+    {
+        uint16_t val1 = im[1];
+        if (val0 >= valid_threshold)
+        {
+            if (val1 >= valid_threshold)
+            {
+                cur_fill = 0;
+                uint16_t diff = abs_diff(val1, val0);
+                if (diff >= valid_threshold && diff <= delta_z)
+                {
+                    float filtered = blend(float(val1), alpha, float(val0), one_minus_alpha);
+                    val1 = to_depth(__fadd_rn(filtered, round));
+                    im[1] = val1;
+                }
+            }
+            else if (holes_filling_radius)
+            {
+                if (++cur_fill < holes_filling_radius)
+                    im[1] = val1 = val0;
+            }
+        }
+        val0 = val1;
+        im += 1;
+    }
+
+    // right to left
+    im = image + size_t(v + 1) * width - 2;
+    uint16_t val1 = im[1];
+    cur_fill = 0;
+    for (int u = width - 1; u > 0; u--)
+    {
+        uint16_t val0 = im[0];
+        if (val1 >= valid_threshold)
+        {
+            if (val0 > valid_threshold)
+            {
+                cur_fill = 0;
+                uint16_t diff = abs_diff(val1, val0);
+                if (diff <= delta_z)
+                {
+                    float filtered = blend(float(val0), alpha, float(val1), one_minus_alpha);
+                    val0 = to_depth(__fadd_rn(filtered, round));
+                    im[0] = val0;
+                }
+            }
+            else if (holes_filling_radius)
+            {
+                if (++cur_fill < holes_filling_radius)
+                    im[0] = val0 = val1;
+            }
+        }
+        val1 = val0;
+        im -= 1;
+    }
+}
+
+__global__ void kernel_spatial_vertical(uint16_t* image, int width, int height, float alpha, float deltaZ)
+{
+    int u = blockIdx.x * blockDim.x + threadIdx.x;
+    if (u >= width)
+        return;
+
+    const float round = 0.5f;
+    const uint16_t valid_threshold = 1;
+    const uint16_t delta_z = static_cast<uint16_t>(deltaZ);
+    const float one_minus_alpha = __fsub_rn(1.f, alpha);
+
+    // top to bottom
+    for (int v = 1; v < height; v++)
+    {
+        uint16_t* im = image + size_t(v - 1) * width + u;
+        uint16_t im0 = im[0];
+        uint16_t imw = im[width];
+        if (abs_diff(im0, imw) < delta_z)
+            im[width] = to_depth(__fadd_rn(blend(float(imw), alpha, float(im0), one_minus_alpha), round));
+    }
+
+    // bottom to top
+    for (int v = 1; v < height; v++)
+    {
+        uint16_t* im = image + size_t(height - 1 - v) * width + u;
+        uint16_t im0 = im[0];
+        uint16_t imw = im[width];
+        if (im0 >= valid_threshold && imw >= valid_threshold && abs_diff(im0, imw) < delta_z)
+            im[0] = to_depth(__fadd_rn(blend(float(im0), alpha, float(imw), one_minus_alpha), round));
+    }
+}
+
+// Disparity: the domain transform both ways along 'n' pixels 'stride' apart, a row or a column alike
+__device__ void recursive_filter_fp(float* line, int n, int stride, float alpha, float deltaZ)
+{
+    const float one_minus_alpha = __fsub_rn(1.0f, alpha);
+
+    float* im = line;
+    float state = *im;
+    float previousInnovation = state;
+    im += stride;
+    float innovation = *im;
+    int u = n - 1;
+    if (!(__float_as_int(previousInnovation) > 0))
+        goto CurrentlyInvalidF;
+
+CurrentlyValidF:
+    for (;;) {
+        if (__float_as_int(innovation) > 0) {
+            float delta = previousInnovation - innovation;
+            bool smallDifference = delta < deltaZ && delta > -deltaZ;
+            if (smallDifference) {
+                float filtered = blend(innovation, alpha, state, one_minus_alpha);
+                *im = state = filtered;
+            }
+            else {
+                state = innovation;
+            }
+            u--;
+            if (u <= 0)
+                goto DoneF;
+            previousInnovation = innovation;
+            im += stride;
+            innovation = *im;
+        }
+        else {
+            u--;
+            if (u <= 0)
+                goto DoneF;
+            previousInnovation = innovation;
+            im += stride;
+            innovation = *im;
+            goto CurrentlyInvalidF;
+        }
+    }
+
+CurrentlyInvalidF:
+    for (;;) {
+        u--;
+        if (u <= 0)
+            goto DoneF;
+        if (__float_as_int(innovation) > 0) {
+            previousInnovation = state = innovation;
+            im += stride;
+            innovation = *im;
+            goto CurrentlyValidF;
+        }
+        else {
+            im += stride;
+            innovation = *im;
+        }
+    }
+DoneF:
+
+    im = line + (n - 2) * stride;
+    previousInnovation = state = im[stride];
+    u = n - 1;
+    innovation = *im;
+    if (!(__float_as_int(previousInnovation) > 0))
+        goto CurrentlyInvalidB;
+
+CurrentlyValidB:
+    for (;;) {
+        if (__float_as_int(innovation) > 0) {
+            float delta = previousInnovation - innovation;
+            bool smallDifference = delta < deltaZ && delta > -deltaZ;
+            if (smallDifference) {
+                float filtered = blend(innovation, alpha, state, one_minus_alpha);
+                *im = state = filtered;
+            }
+            else {
+                state = innovation;
+            }
+            u--;
+            if (u <= 0)
+                goto DoneB;
+            previousInnovation = innovation;
+            im -= stride;
+            innovation = *im;
+        }
+        else {
+            u--;
+            if (u <= 0)
+                goto DoneB;
+            previousInnovation = innovation;
+            im -= stride;
+            innovation = *im;
+            goto CurrentlyInvalidB;
+        }
+    }
+
+CurrentlyInvalidB:
+    for (;;) {
+        u--;
+        if (u <= 0)
+            goto DoneB;
+        if (__float_as_int(innovation) > 0) {
+            previousInnovation = state = innovation;
+            im -= stride;
+            innovation = *im;
+            goto CurrentlyValidB;
+        }
+        else {
+            im -= stride;
+            innovation = *im;
+        }
+    }
+DoneB:
+    return;
+}
+
+__global__ void kernel_spatial_horizontal_fp(float* image, int width, int height, float alpha, float deltaZ)
+{
+    int v = blockIdx.x * blockDim.x + threadIdx.x;
+    if (v < height)
+        recursive_filter_fp(image + size_t(v) * width, width, 1, alpha, deltaZ);
+}
+
+__global__ void kernel_spatial_vertical_fp(float* image, int width, int height, float alpha, float deltaZ)
+{
+    int u = blockIdx.x * blockDim.x + threadIdx.x;
+    if (u < width)
+        recursive_filter_fp(image + u, height, width, alpha, deltaZ);
+}
+
+__global__ void kernel_spatial_holes_fill_fp(float* image, int width, int height, uint8_t holes_filling_radius)
+{
+    int j = blockIdx.x * blockDim.x + threadIdx.x;
+    if (j >= height)
+        return;
+
+    float* p = image + size_t(j) * width + 1;
+    size_t cur_fill = 0;
+    for (int i = 1; i < width; ++i, ++p)
+    {
+        if (empty(p))
+        {
+            if (++cur_fill < holes_filling_radius)
+                *p = *(p - 1);
+        }
+        else
+            cur_fill = 0;
+    }
+
+    --p;
+    cur_fill = 0;
+    for (int i = 1; i < width; ++i, --p)
+    {
+        if (empty(p))
+        {
+            if (++cur_fill < holes_filling_radius)
+                *p = *(p + 1);
+        }
+        else
+            cur_fill = 0;
+    }
+}
+
+void cuda_filters::spatial_smooth(CUstream_st* stream, uint16_t* image, int width, int height, float alpha, float delta,
+    int iterations, uint8_t holes_filling_mode, uint8_t holes_filling_radius)
+{
+    for (int i = 0; i < iterations; i++)
+    {
+        kernel_spatial_horizontal<<<calc_blocks(height, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+            image, width, height, alpha, delta, holes_filling_radius);
+        kernel_spatial_vertical<<<calc_blocks(width, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+            image, width, height, alpha, delta);
+    }
+}
+
+void cuda_filters::spatial_smooth(CUstream_st* stream, float* image, int width, int height, float alpha, float delta,
+    int iterations, uint8_t holes_filling_mode, uint8_t holes_filling_radius)
+{
+    for (int i = 0; i < iterations; i++)
+    {
+        kernel_spatial_horizontal_fp<<<calc_blocks(height, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+            image, width, height, alpha, delta);
+        kernel_spatial_vertical_fp<<<calc_blocks(width, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+            image, width, height, alpha, delta);
+    }
+
+    // Disparity domain hole filling is a pass of its own
+    if (holes_filling_mode)
+        kernel_spatial_holes_fill_fp<<<calc_blocks(height, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+            image, width, height, holes_filling_radius);
+}
+
+//
+// Temporal filter: pixels are independent
+//
+struct persistence_table
+{
+    uint8_t credible[256];
+};
+
+template<typename T>
+__global__ void kernel_temporal_smooth(T* frame, T* last_frame, uint8_t* history, size_t count,
+    float alpha, float one_minus_alpha, T delta_z, uint8_t mask, persistence_table persistence)
+{
+    size_t i = size_t(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (i >= count)
+        return;
+
+    T cur_val = frame[i];
+    T prev_val = last_frame[i];
+
+    if (cur_val)
+    {
+        if (!prev_val)
+        {
+            last_frame[i] = cur_val;
+            history[i] = mask;
+        }
+        else if (abs_diff(cur_val, prev_val) < delta_z)
+        {
+            history[i] |= mask;
+            T result = from_float<T>(blend(alpha, float(cur_val), one_minus_alpha, float(prev_val)));
+            frame[i] = result;
+            last_frame[i] = result;
+        }
+        else
+        {
+            last_frame[i] = cur_val;
+            history[i] = mask;
+        }
+    }
+    else
+    {
+        if (prev_val && (persistence.credible[history[i]] & mask))
+            frame[i] = prev_val;
+        history[i] &= ~mask;
+    }
+}
+
+template<typename T>
+void cuda_filters::temporal_smooth(CUstream_st* stream, T* frame, T* last_frame, uint8_t* history, size_t count,
+    float alpha, float one_minus_alpha, uint8_t delta, uint8_t mask, const uint8_t* persistence_map)
+{
+    persistence_table persistence;
+    memcpy(persistence.credible, persistence_map, sizeof(persistence.credible));
+    kernel_temporal_smooth<T><<<calc_blocks(int(count), RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+        frame, last_frame, history, count, alpha, one_minus_alpha, static_cast<T>(delta), mask, persistence);
+}
+
+template void cuda_filters::temporal_smooth<uint16_t>(CUstream_st*, uint16_t*, uint16_t*, uint8_t*, size_t, float, float, uint8_t, uint8_t, const uint8_t*);
+template void cuda_filters::temporal_smooth<float>(CUstream_st*, float*, float*, uint8_t*, size_t, float, float, uint8_t, uint8_t, const uint8_t*);
+
+//
+// Hole filling
+//
+template<typename T>
+__global__ void kernel_holes_fill_left(T* image, int width, int height)
+{
+    int j = blockIdx.x * blockDim.x + threadIdx.x;
+    if (j >= height)
+        return;
+
+    T* row = image + size_t(j) * width;
+    for (int i = 1; i < width; ++i)
+        if (empty(row + i))
+            row[i] = row[i - 1];
+}
+
+// The "around" methods fill in place, left to right and top to bottom: a hole sees the pixel to its left and the row
+// above as already filled, and the row below as not yet. Holes (i, j) with the same i + 2j see none of each other, so
+// they're done together, one such step after the other, all in one block.
+template<typename T, bool Farest>
+__global__ void kernel_holes_fill_around(T* image, int width, int height)
+{
+    const int last_step = (width - 1) + 2 * (height - 2);
+    for (int s = 3; s <= last_step; ++s)
+    {
+        for (int j = 1 + threadIdx.x; j + 1 < height; j += blockDim.x)
+        {
+            int i = s - 2 * j;
+            if (i < 1 || i >= width)
+                continue;
+
+            T* p = image + size_t(j) * width + i;
+            if (!empty(p))
+                continue;
+
+            T tmp = *(p - width);
+            const T* around[] = { p - width - 1, p - 1, p + width - 1, p + width };
+            for (auto q : around)
+            {
+                if (Farest ? (*q > tmp) : (!empty(q) && (*q < tmp)))
+                    tmp = *q;
+            }
+            *p = tmp;
+        }
+        __syncthreads();
+    }
+}
+
+template<typename T>
+void cuda_filters::hole_filling(CUstream_st* stream, T* image, int width, int height, uint8_t mode)
+{
+    switch (mode)
+    {
+    case 0:  // hf_fill_from_left
+        kernel_holes_fill_left<T><<<calc_blocks(height, RS2_CUDA_THREADS_PER_BLOCK), RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(
+            image, width, height);
+        break;
+    case 1:  // hf_farest_from_around
+        kernel_holes_fill_around<T, true><<<1, 1024, 0, stream>>>(image, width, height);
+        break;
+    case 2:  // hf_nearest_from_around
+        kernel_holes_fill_around<T, false><<<1, 1024, 0, stream>>>(image, width, height);
+        break;
+    }
+}
+
+template void cuda_filters::hole_filling<uint16_t>(CUstream_st*, uint16_t*, int, int, uint8_t);
+template void cuda_filters::hole_filling<float>(CUstream_st*, float*, int, int, uint8_t);
+
+#endif // RS2_USE_CUDA
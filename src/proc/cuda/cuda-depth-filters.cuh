@@ -0,0 +1,77 @@
+#pragma once
+#ifdef RS2_USE_CUDA
+
+#include <memory>
+#include <stdint.h>
+
+struct CUstream_st;
+
+namespace librealsense
+{
+    // Device memory that only grows
+    struct cuda_buffer
+    {
+        std::shared_ptr<uint8_t> data;
+        size_t size = 0;
+
+        uint8_t* reserve(size_t bytes);
+    };
+
+    // Where a CUDA filter gets its input and puts its output, on a stream of its own: an input that's already on the
+    // device is used from there, and the output goes straight into the target frame's device memory when there's one
+    class cuda_filter_stage
+    {
+    public:
+        CUstream_st* stream();
+
+        // The input's 'size' bytes on the device: 'd_in' itself when not null, or else an upload of 'h_in'
+        const void* input(const void* h_in, const void* d_in, size_t size);
+
+        // Device memory for the output: 'd_out' when not null, or else our own, for finish() to download
+        void* output(void* d_out, size_t size);
+
+        // Copy 'size' bytes of the input to the output, for the filters that work in-place
+        void copy(void* d_out, const void* d_in, size_t size);
+
+        // Zero 'size' bytes of device memory, in order with the rest
+        void zero(void* d, size_t size);
+
+        // Copy 'size' bytes from the host to device memory, in order with the rest, for tables and the like
+        void upload(void* d, const void* h, size_t size);
+
+        // Waits for the stream, then copies the output to 'h_out' if it wasn't the target frame's
+        void finish(void* h_out);
+
+    private:
+        std::shared_ptr<CUstream_st> _stream;
+        std::shared_ptr<uint8_t> _h_in, _h_out;     // Pinned, as big as the device buffers
+        cuda_buffer _d_in, _d_out;
+        void* _downloaded = nullptr;                // Our own output, when it's used
+        size_t _out_size = 0;
+    };
+
+    // The filter passes, on device memory and the stage's stream. They do exactly what the CPU versions do, to the bit.
+    namespace cuda_filters
+    {
+        void depth_to_disparity(CUstream_st* stream, const uint16_t* in, float* out, size_t count, float d2d_convert_factor);
+        void disparity_to_depth(CUstream_st* stream, const float* in, uint16_t* out, size_t count, float d2d_convert_factor);
+
+        // Output pixels outside [col_begin, col_end) x [row_begin, row_end) are zeroed, as is the padding
+        void decimate_depth(CUstream_st* stream, const uint16_t* in, uint16_t* out, int width_in, int scale,
+            int padded_width, int padded_height, int col_begin, int col_end, int row_begin, int row_end);
+
+        void spatial_smooth(CUstream_st* stream, uint16_t* image, int width, int height, float alpha, float delta,
+            int iterations, uint8_t holes_filling_mode, uint8_t holes_filling_radius);
+        void spatial_smooth(CUstream_st* stream, float* image, int width, int height, float alpha, float delta,
+            int iterations, uint8_t holes_filling_mode, uint8_t holes_filling_radius);
+
+        // The persistence map is the temporal filter's 256 entries, classifying each history
+        template<typename T>
+        void temporal_smooth(CUstream_st* stream, T* frame, T* last_frame, uint8_t* history, size_t count,
+            float alpha, float one_minus_alpha, uint8_t delta, uint8_t mask, const uint8_t* persistence_map);
+
+        template<typename T>
+        void hole_filling(CUstream_st* stream, T* image, int width, int height, uint8_t mode);
+    }
+}
+#endif // RS2_USE_CUDA
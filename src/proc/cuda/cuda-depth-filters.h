@@ -0,0 +1,86 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+#ifdef RS2_USE_CUDA
+
+#include "../disparity-transform.h"
+#include "../decimation-filter.h"
+#include "../spatial-filter.h"
+#include "../temporal-filter.h"
+#include "../hole-filling-filter.h"
+#include "cuda-depth-filters.cuh"
+#include "../../cuda/cuda-device.h"
+
+namespace librealsense
+{
+    // The depth post-processing filters on the GPU, with the same results as on the CPU. A frame that's already on
+    // the device (from another CUDA block) is taken from there, and the output is left there for the next one.
+    // Regions of interest are still filtered on the CPU.
+    //
+    // Each runs on the device of its RS2_OPTION_CUDA_DEVICE; what it keeps on one is dropped when it's moved to another.
+
+    class disparity_transform_cuda : public disparity_transform
+    {
+    public:
+        disparity_transform_cuda(bool transform_to_disparity);
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        cuda_filter_stage _stage;
+        cuda::device_option _cuda_device;
+    };
+
+    class decimation_filter_cuda : public decimation_filter
+    {
+    public:
+        decimation_filter_cuda();
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        cuda_filter_stage _stage;
+        cuda::device_option _cuda_device;
+    };
+
+    class spatial_filter_cuda : public spatial_filter
+    {
+    public:
+        spatial_filter_cuda();
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        cuda_filter_stage _stage;
+        cuda::device_option _cuda_device;
+    };
+
+    class temporal_filter_cuda : public temporal_filter
+    {
+    public:
+        temporal_filter_cuda();
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        cuda_filter_stage _stage;
+        cuda::device_option _cuda_device;
+        cuda_buffer _d_last_frame, _d_history;      // The device's _last_frame and _history
+    };
+
+    class hole_filling_filter_cuda : public hole_filling_filter
+    {
+    public:
+        hole_filling_filter_cuda();
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        cuda_filter_stage _stage;
+        cuda::device_option _cuda_device;
+    };
+}
+#endif // RS2_USE_CUDA
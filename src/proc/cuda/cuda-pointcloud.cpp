@@ -4,22 +4,86 @@
 
 #ifdef RS2_USE_CUDA
 #include "../../cuda/cuda-pointcloud.cuh"
+#include "../../cuda/cuda-frame.h"
+#include "stream.h"
+#include "points.h"
+#include <algorithm>
 #endif
 
 namespace librealsense
 {
-    pointcloud_cuda::pointcloud_cuda() : pointcloud("Pointcloud (CUDA)") {}
+    pointcloud_cuda::pointcloud_cuda() : pointcloud("Pointcloud (CUDA)")
+#ifdef RS2_USE_CUDA
+        , _cuda_device(*this)
+#endif
+    {
+#ifdef RS2_USE_CUDA
+        // The points stay on the device, for whatever CUDA block comes next
+        _source.add_extension<cuda::cuda_points_frame>(RS2_EXTENSION_POINTS_CUDA);
+#endif
+    }
+
+    rs2::points pointcloud_cuda::allocate_points(const rs2::frame_source& source, const rs2::frame& f)
+    {
+#ifdef RS2_USE_CUDA
+        auto prof = std::dynamic_pointer_cast<librealsense::stream_profile_interface>(
+            _output_stream.get()->profile->shared_from_this());
+        auto frame_ref = _source_wrapper.allocate_points(prof, (frame_interface*)f.get(), RS2_EXTENSION_POINTS_CUDA);
+        rs2::frame res { (rs2_frame*)frame_ref };
+        return res.as<rs2::points>();
+#else
+        return pointcloud::allocate_points(source, f);
+#endif
+    }
 
     const float3 * pointcloud_cuda::depth_to_points(
         rs2::points output,
         const rs2_intrinsics &depth_intrinsics,
         const rs2::depth_frame& depth_frame)
     {
+        auto depth_scale = depth_frame.get_units();
+#ifdef RS2_USE_CUDA
+        // Nothing is kept across frames but per-thread streams, which follow the device along
+        bool moved;
+        cuda::device_scope scope(_cuda_device.select(moved));
+
+        rscuda::points_bounds bounds;
+        std::copy(std::begin(_bounds.min), std::end(_bounds.min), bounds.min);
+        std::copy(std::begin(_bounds.max), std::end(_bounds.max), bounds.max);
+        auto bounds_ptr = _bounds.active() ? &bounds : nullptr;
+
+        auto d_depth = reinterpret_cast<const uint16_t*>(cuda::device_data((frame_interface*)depth_frame.get()));
+        if (auto section = cuda::section_of((frame_interface*)output.get()))
+        {
+            auto count = depth_intrinsics.width * depth_intrinsics.height;
+            auto depth_data = d_depth ? d_depth : (const uint16_t*)depth_frame.get_data();
+            bool map_texture = _extrinsics && _other_intrinsics;
+
+            // Packed on the device, so that only the points that are left are ever copied back
+            if (!map_texture && _layout == RS2_POINTS_LAYOUT_PACKED_FLOAT)
+            {
+                auto d_points = cuda::memory_pool::current()->allocate(count * sizeof(float3));
+                rscuda::deproject_depth_cuda_to_device((float*)d_points.get(), depth_intrinsics, depth_data, d_depth != nullptr, depth_scale, bounds_ptr);
+                auto d_packed = reinterpret_cast<float*>(section->output(count * 5 * sizeof(float)));
+                auto valid = rscuda::pack_points_cuda(d_packed, (float*)d_points.get(), count);
+                section->output(valid * 5 * sizeof(float));
+                ((librealsense::points*)output.get())->set_layout(RS2_POINTS_LAYOUT_PACKED_FLOAT, valid);
+                return nullptr;
+            }
+
+            auto d_points = reinterpret_cast<float*>(section->output(count * sizeof(float3)));
+            rscuda::deproject_depth_cuda_to_device(d_points, depth_intrinsics, depth_data, d_depth != nullptr, depth_scale, bounds_ptr);
+
+            // Only texture mapping needs the points on the host, and gets them as it asks for them
+            if (!map_texture)
+                return nullptr;
+            return (float3*)output.get_vertices();
+        }
+#endif
         auto image = output.get_vertices();
         auto depth_data = (uint16_t*)depth_frame.get_data();
-        auto depth_scale = depth_frame.get_units();
 #ifdef RS2_USE_CUDA
-        rscuda::deproject_depth_cuda((float*)image, depth_intrinsics, depth_data, depth_scale);
+        rscuda::deproject_depth_cuda((float*)image, depth_intrinsics, depth_data, depth_scale, bounds_ptr);
 #endif
         return (float3*)image;
     }
@@ -3,6 +3,9 @@
 
 #pragma once
 #include "../pointcloud.h"
+#ifdef RS2_USE_CUDA
+#include "../../cuda/cuda-device.h"
+#endif
 
 namespace librealsense
 {
@@ -15,5 +18,13 @@ namespace librealsense
             rs2::points output,
             const rs2_intrinsics &depth_intrinsics,
             const rs2::depth_frame& depth_frame) override;
+        rs2::points allocate_points(const rs2::frame_source& source, const rs2::frame& f) override;
+#ifdef RS2_USE_CUDA
+        // The kernel leaves the points outside the bounds at zero
+        bool culls_points() const override { return true; }
+#endif
+#ifdef RS2_USE_CUDA
+        cuda::device_option _cuda_device;
+#endif
     };
 }
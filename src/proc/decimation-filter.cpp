@@ -12,9 +12,20 @@
 #include "core/video.h"
 #include "proc/synthetic-stream.h"
 #include "proc/decimation-filter.h"
+#include "proc/output-profile-cache.h"
+
+#ifdef RS2_USE_CUDA
+#include "proc/cuda/cuda-depth-filters.h"
+#endif
 
 #include <rsutils/string/from.h>
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 
 #define PIX_SORT(a,b) { if ((a)>(b)) PIX_SWAP((a),(b)); }
 #define PIX_SWAP(a,b) { pixelvalue temp=(a);(a)=(b);(b)=temp; }
@@ -201,6 +212,20 @@ namespace librealsense
     const uint8_t decimation_default_val = 2;
     const uint8_t decimation_step = 1;    // Linear decimation
 
+    // The number of threads the output rows are split across
+    const uint8_t threads_min = 1;
+    const uint8_t threads_step = 1;
+    const uint8_t threads_def = 1;
+
+    std::shared_ptr<decimation_filter> decimation_filter::create()
+    {
+        #ifdef RS2_USE_CUDA
+            return std::make_shared<librealsense::decimation_filter_cuda>();
+        #else
+            return std::make_shared<librealsense::decimation_filter>();
+        #endif
+    }
+
     decimation_filter::decimation_filter() :
         stream_filter_processing_block("Decimation Filter"),
         _decimation_factor(decimation_default_val),
@@ -211,8 +236,8 @@ namespace librealsense
         _real_height(0),
         _padded_width(0),
         _padded_height(0),
-        _recalc_profile(false),
-        _options_changed(false)
+        _options_changed(false),
+        _threads(threads_def)
     {
         _stream_filter.stream = RS2_STREAM_DEPTH;
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -246,6 +271,16 @@ namespace librealsense
         });
 
         register_option(RS2_OPTION_FILTER_MAGNITUDE, decimation_control);
+
+        auto threads = std::make_shared<ptr_option<uint8_t>>(
+            threads_min,
+            uint8_t(std::min(processing_thread_pool::max_threads(), 255)),
+            threads_step,
+            threads_def,
+            &_threads, "Number of threads to split the decimation across");
+        register_option(RS2_OPTION_FILTER_THREADS, threads);
+
+        register_roi_options();
     }
 
     rs2::frame decimation_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
@@ -267,9 +302,11 @@ namespace librealsense
         {
             if (format == RS2_FORMAT_Z16)
             {
+                auto roi = output_roi(f);
                 decimate_depth(static_cast<const uint16_t*>(src.get_data()),
                     static_cast<uint16_t*>(const_cast<void*>(tgt.get_data())),
-                    src.get_width(), src.get_height(), this->_patch_size);
+                    src.get_width(), src.get_height(), this->_patch_size, roi);
+                set_roi(tgt, roi, _padded_width, _padded_height);
             }
             else
             {
@@ -282,56 +319,29 @@ namespace librealsense
         return f;
     }
 
+    region_of_interest decimation_filter::output_roi(const rs2::frame& f) const
+    {
+        auto vf = f.as<rs2::video_frame>();
+        auto roi = get_roi(f, vf.get_width(), vf.get_height());
+        roi.min_x = std::min(int(_real_width), (roi.min_x + _patch_size - 1) / _patch_size);
+        roi.min_y = std::min(int(_real_height), (roi.min_y + _patch_size - 1) / _patch_size);
+        roi.max_x = std::min(int(_real_width), (roi.max_x + 1) / _patch_size) - 1;
+        roi.max_y = std::min(int(_real_height), (roi.max_y + 1) / _patch_size) - 1;
+        return roi;
+    }
+
     void  decimation_filter::update_output_profile(const rs2::frame& f)
     {
         if (_options_changed || f.get_profile().get() != _source_stream_profile.get())
         {
             _options_changed = false;
             _source_stream_profile = f.get_profile();
-            const auto pf = _registered_profiles.find(std::make_tuple(_source_stream_profile.get(), _decimation_factor));
-            if (_registered_profiles.end() != pf)
-            {
-                _target_stream_profile = pf->second;
-                auto tgt_vspi = dynamic_cast<video_stream_profile_interface*>(_target_stream_profile.get()->profile);
-                if (!tgt_vspi)
-                    throw std::runtime_error("Stream profile interface is not video stream profile interface");
-
-                auto f_pf = dynamic_cast<video_stream_profile_interface*>(_source_stream_profile.get()->profile);
-                if (!f_pf)
-                    throw std::runtime_error("Stream profile interface is not video stream profile interface");
-
-                rs2_intrinsics tgt_intrin = tgt_vspi->get_intrinsics();
-
-                // Update real/padded output frame size based on retrieved input properties
-                _real_width = f_pf->get_width() / _patch_size;
-                _real_height = f_pf->get_height() / _patch_size;
-                _padded_width = tgt_intrin.width;
-                _padded_height = tgt_intrin.height;
-            }
-            else
-            {
-                _recalc_profile = true;
-            }
-        }
-
-        // Buld a new target profile for every system/filter change
-        if (_recalc_profile)
-        {
-            auto vp = _source_stream_profile.as<rs2::video_stream_profile>();
 
-            auto tmp_profile = _source_stream_profile.clone(_source_stream_profile.stream_type(), _source_stream_profile.stream_index(), _source_stream_profile.format());
             auto src_vspi = dynamic_cast<video_stream_profile_interface*>(_source_stream_profile.get()->profile);
             if (!src_vspi)
                 throw std::runtime_error("Stream profile interface is not video stream profile interface");
 
-            auto tgt_vspi = dynamic_cast<video_stream_profile_interface*>(tmp_profile.get()->profile);
-            if( ! tgt_vspi )
-                throw std::runtime_error( "Profile is not video stream profile" );
-
-            rs2_intrinsics src_intrin = src_vspi->get_intrinsics();
-            rs2_intrinsics tgt_intrin = tgt_vspi->get_intrinsics();
-
-            // recalculate real/padded output frame size based on new input porperties
+            // Update real/padded output frame size based on new input properties
             _real_width = src_vspi->get_width() / _patch_size;
             _real_height = src_vspi->get_height() / _patch_size;
 
@@ -344,19 +354,30 @@ namespace librealsense
             _padded_height /= 4;
             _padded_height *= 4;
 
-            tgt_intrin.width = _padded_width;
-            tgt_intrin.height = _padded_height;
-            tgt_intrin.fx = src_intrin.fx / _patch_size;
-            tgt_intrin.fy = src_intrin.fy / _patch_size;
-            tgt_intrin.ppx = src_intrin.ppx / _patch_size;
-            tgt_intrin.ppy = src_intrin.ppy / _patch_size;
-
-            tgt_vspi->set_intrinsics([tgt_intrin]() { return tgt_intrin; });
-            tgt_vspi->set_dims(tgt_intrin.width, tgt_intrin.height);
-
-            _registered_profiles[std::make_tuple(_source_stream_profile.get(), _decimation_factor)] = _target_stream_profile = tmp_profile;
-
-            _recalc_profile = false;
+            // The same source and factor get the same target profile, whichever filter made it
+            output_profile_cache::key key(src_vspi, _source_stream_profile.stream_type(),
+                _source_stream_profile.stream_index(), _source_stream_profile.format(), "decimation");
+            key.width = _padded_width;
+            key.height = _padded_height;
+            key.param = _decimation_factor;
+            auto patch_size = _patch_size;
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(key,
+                [src_vspi, patch_size](stream_profile_interface& p)
+                {
+                    auto tgt_vspi = dynamic_cast<video_stream_profile_interface*>(&p);
+                    if (!tgt_vspi)
+                        throw std::runtime_error("Profile is not video stream profile");
+
+                    rs2_intrinsics tgt_intrin = src_vspi->get_intrinsics();
+                    tgt_intrin.width = tgt_vspi->get_width();
+                    tgt_intrin.height = tgt_vspi->get_height();
+                    tgt_intrin.fx /= patch_size;
+                    tgt_intrin.fy /= patch_size;
+                    tgt_intrin.ppx /= patch_size;
+                    tgt_intrin.ppy /= patch_size;
+
+                    tgt_vspi->set_intrinsics([tgt_intrin]() { return tgt_intrin; });
+                });
         }
     }
 
@@ -373,26 +394,218 @@ namespace librealsense
         return ret;
     }
 
+#if defined(__SSSE3__) || (defined(__aarch64__) && defined(__ARM_NEON))
+    // Sorting networks for the 2x2 and 3x3 kernels: comparator pairs, applied in order
+    static const uint8_t sort_network_4[][2] = { { 0, 1 }, { 2, 3 }, { 0, 2 }, { 1, 3 }, { 1, 2 } };
+    static const uint8_t sort_network_9[][2] = { { 0, 3 }, { 1, 7 }, { 2, 5 }, { 4, 8 }, { 0, 7 }, { 2, 4 }, { 3, 8 }, { 5, 6 },
+                                                 { 0, 2 }, { 1, 3 }, { 4, 5 }, { 7, 8 }, { 1, 4 }, { 3, 6 }, { 5, 7 }, { 0, 1 },
+                                                 { 2, 4 }, { 3, 5 }, { 6, 8 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 1, 2 }, { 3, 4 },
+                                                 { 5, 6 } };
+#endif
+
+#if defined(__SSSE3__)
+    // The median of the non-zero values among N kernel pixels, for 8 output pixels at once: picks the same member
+    // as the scalar opt_med*() (the one below the middle for even counts), and 0 when all are zero.
+    //
+    // Values are mapped to (v - 1) ^ 0x8000, so that zeros sort last and the signed min/max of SSE2 order them like
+    // unsigned. After sorting, the k non-zero values come first and the answer is member (k - 1) / 2.
+    template<int N, size_t C>
+    static inline __m128i sse_median_of_valid(__m128i* v, const uint8_t (&network)[C][2])
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i flip = _mm_set1_epi16(-32768);
+        const __m128i one = _mm_set1_epi16(1);
+
+        __m128i valid = _mm_set1_epi16(N);
+        for (int i = 0; i < N; i++)
+        {
+            valid = _mm_add_epi16(valid, _mm_cmpeq_epi16(v[i], zero));
+            v[i] = _mm_xor_si128(_mm_sub_epi16(v[i], one), flip);
+        }
+
+        for (auto& c : network)
+        {
+            __m128i lo = _mm_min_epi16(v[c[0]], v[c[1]]);
+            v[c[1]] = _mm_max_epi16(v[c[0]], v[c[1]]);
+            v[c[0]] = lo;
+        }
+
+        __m128i median = v[0];
+        for (int i = 1; i <= (N - 1) / 2; i++)
+        {
+            __m128i pick = _mm_cmpgt_epi16(valid, _mm_set1_epi16(2 * i));
+            median = _mm_or_si128(_mm_and_si128(pick, v[i]), _mm_andnot_si128(pick, median));
+        }
+        return _mm_add_epi16(_mm_xor_si128(median, flip), one);
+    }
+
+    // Decimates as many pixels of one output row as it can, 8 at a time, and returns their number.
+    // Only the median kernels (scale 2 and 3) are vectorized.
+    static size_t decimate_row_median_simd(const uint16_t* in, size_t width_in, size_t scale, uint16_t* out, size_t real_width)
+    {
+        size_t i = 0;
+        if (scale == 2)
+        {
+            // Even pixels to the low half, odd ones to the high half
+            const __m128i split = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+            for (; i + 8 <= real_width; i += 8)
+            {
+                __m128i v[4];
+                for (int n = 0; n < 2; n++)
+                {
+                    auto row = reinterpret_cast<const __m128i*>(in + n * width_in + 2 * i);
+                    __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(row), split);
+                    __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(row + 1), split);
+                    v[2 * n] = _mm_unpacklo_epi64(a, b);
+                    v[2 * n + 1] = _mm_unpackhi_epi64(a, b);
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), sse_median_of_valid<4>(v, sort_network_4));
+            }
+        }
+        else if (scale == 3)
+        {
+            // Gathers every 3rd pixel, starting at pixel 0/1/2, out of 24 pixels held in 3 registers
+            const __m128i gather[3][3] = {
+                { _mm_setr_epi8(0, 1, 6, 7, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1),
+                  _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 3, 8, 9, 14, 15, -1, -1, -1, -1),
+                  _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 5, 10, 11) },
+                { _mm_setr_epi8(2, 3, 8, 9, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1),
+                  _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 4, 5, 10, 11, -1, -1, -1, -1, -1, -1),
+                  _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, 6, 7, 12, 13) },
+                { _mm_setr_epi8(4, 5, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1),
+                  _mm_setr_epi8(-1, -1, -1, -1, 0, 1, 6, 7, 12, 13, -1, -1, -1, -1, -1, -1),
+                  _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 3, 8, 9, 14, 15) } };
+            for (; i + 8 <= real_width; i += 8)
+            {
+                __m128i v[9];
+                for (int n = 0; n < 3; n++)
+                {
+                    auto row = reinterpret_cast<const __m128i*>(in + n * width_in + 3 * i);
+                    __m128i a = _mm_loadu_si128(row);
+                    __m128i b = _mm_loadu_si128(row + 1);
+                    __m128i c = _mm_loadu_si128(row + 2);
+                    for (int m = 0; m < 3; m++)
+                        v[3 * n + m] = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, gather[m][0]), _mm_shuffle_epi8(b, gather[m][1])),
+                                                    _mm_shuffle_epi8(c, gather[m][2]));
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), sse_median_of_valid<9>(v, sort_network_9));
+            }
+        }
+        return i;
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    // See the SSE version above. NEON has unsigned min/max, so zeros only need to wrap around to sort last.
+    template<int N, size_t C>
+    static inline uint16x8_t neon_median_of_valid(uint16x8_t* v, const uint8_t (&network)[C][2])
+    {
+        const uint16x8_t one = vdupq_n_u16(1);
+
+        int16x8_t valid = vdupq_n_s16(N);
+        for (int i = 0; i < N; i++)
+        {
+            valid = vaddq_s16(valid, vreinterpretq_s16_u16(vceqq_u16(v[i], vdupq_n_u16(0))));
+            v[i] = vsubq_u16(v[i], one);
+        }
+
+        for (auto& c : network)
+        {
+            uint16x8_t lo = vminq_u16(v[c[0]], v[c[1]]);
+            v[c[1]] = vmaxq_u16(v[c[0]], v[c[1]]);
+            v[c[0]] = lo;
+        }
+
+        uint16x8_t median = v[0];
+        for (int i = 1; i <= (N - 1) / 2; i++)
+            median = vbslq_u16(vcgtq_s16(valid, vdupq_n_s16(2 * i)), v[i], median);
+        return vaddq_u16(median, one);
+    }
+
+    static size_t decimate_row_median_simd(const uint16_t* in, size_t width_in, size_t scale, uint16_t* out, size_t real_width)
+    {
+        size_t i = 0;
+        if (scale == 2)
+        {
+            for (; i + 8 <= real_width; i += 8)
+            {
+                uint16x8_t v[4];
+                for (int n = 0; n < 2; n++)
+                {
+                    uint16x8x2_t row = vld2q_u16(in + n * width_in + 2 * i);
+                    v[2 * n] = row.val[0];
+                    v[2 * n + 1] = row.val[1];
+                }
+                vst1q_u16(out + i, neon_median_of_valid<4>(v, sort_network_4));
+            }
+        }
+        else if (scale == 3)
+        {
+            for (; i + 8 <= real_width; i += 8)
+            {
+                uint16x8_t v[9];
+                for (int n = 0; n < 3; n++)
+                {
+                    uint16x8x3_t row = vld3q_u16(in + n * width_in + 3 * i);
+                    for (int m = 0; m < 3; m++)
+                        v[3 * n + m] = row.val[m];
+                }
+                vst1q_u16(out + i, neon_median_of_valid<9>(v, sort_network_9));
+            }
+        }
+        return i;
+    }
+#else
+    static size_t decimate_row_median_simd(const uint16_t*, size_t, size_t, uint16_t*, size_t)
+    {
+        return 0;
+    }
+#endif
+
     void decimation_filter::decimate_depth(const uint16_t * frame_data_in, uint16_t * frame_data_out,
-        size_t width_in, size_t height_in, size_t scale)
+        size_t width_in, size_t height_in, size_t scale, const region_of_interest& roi)
+    {
+        const size_t row_begin = roi.min_y, row_end = roi.min_y + roi_height(roi);
+        const size_t col_begin = roi.min_x, col_end = roi.min_x + roi_width(roi);
+
+        // Output rows are independent, so they can be split across threads
+        for_each_band(row_end - row_begin, [&](size_t begin, size_t end)
+        {
+            decimate_depth_rows(frame_data_in, frame_data_out, width_in, scale, row_begin + begin, row_begin + end, col_begin, col_end);
+        });
+
+        // Fill-in the rows outside the region of interest and the padded rows with zeros
+        memset(frame_data_out, 0, row_begin * _padded_width * sizeof(uint16_t));
+        memset(frame_data_out + row_end * _padded_width, 0, (_padded_height - row_end) * _padded_width * sizeof(uint16_t));
+    }
+
+    void decimation_filter::decimate_depth_rows(const uint16_t * frame_data_in, uint16_t * frame_data_out,
+        size_t width_in, size_t scale, size_t row_begin, size_t row_end, size_t col_begin, size_t col_end)
     {
         // Use median filtering
         std::vector<uint16_t> working_kernel(_kernel_size);
         auto wk_begin = working_kernel.data();
         auto wk_itr = wk_begin;
         std::vector<uint16_t*> pixel_raws(scale);
-        uint16_t* block_start = const_cast<uint16_t*>(frame_data_in);
+        uint16_t* block_start = const_cast<uint16_t*>(frame_data_in) + row_begin * width_in * scale;
+        frame_data_out += row_begin * _padded_width;
 
         if (scale == 2 || scale == 3)
         {
-            for (int j = 0; j < _real_height; j++)
+            for (size_t j = row_begin; j < row_end; j++)
             {
                 uint16_t *p{};
                 // Mark the beginning of each of the N lines that the filter will run upon
                 for (size_t i = 0; i < pixel_raws.size(); i++)
                     pixel_raws[i] = block_start + (width_in*i);
 
-                for (size_t i = 0, chunk_offset = 0; i < _real_width; i++)
+                // Fill-in the colums left of the region of interest with zeros
+                for (size_t i = 0; i < col_begin; i++)
+                    *frame_data_out++ = 0;
+
+                // The vectorized pass takes the bulk of the row, the loop below whatever it leaves
+                size_t first = col_begin + decimate_row_median_simd(block_start + col_begin * scale, width_in, scale, frame_data_out, col_end - col_begin);
+                frame_data_out += first - col_begin;
+
+                for (size_t i = first, chunk_offset = first * scale; i < col_end; i++)
                 {
                     wk_itr = wk_begin;
                     // extract data the kernel to process
@@ -447,8 +660,8 @@ namespace librealsense
                     chunk_offset += scale;
                 }
 
-                // Fill-in the padded colums with zeros
-                for (int j = _real_width; j < _padded_width; j++)
+                // Fill-in the colums right of the region of interest and the padded ones with zeros
+                for (size_t i = col_end; i < size_t(_padded_width); i++)
                     *frame_data_out++ = 0;
 
                 // Skip N lines to the beginnig of the next processing segment
@@ -457,14 +670,18 @@ namespace librealsense
         }
         else
         {
-            for (int j = 0; j < _real_height; j++)
+            for (size_t j = row_begin; j < row_end; j++)
             {
                 uint16_t *p{};
                 // Mark the beginning of each of the N lines that the filter will run upon
                 for (size_t i = 0; i < pixel_raws.size(); i++)
                     pixel_raws[i] = block_start + (width_in*i);
 
-                for (size_t i = 0, chunk_offset = 0; i < _real_width; i++)
+                // Fill-in the colums left of the region of interest with zeros
+                for (size_t i = 0; i < col_begin; i++)
+                    *frame_data_out++ = 0;
+
+                for (size_t i = col_begin, chunk_offset = col_begin * scale; i < col_end; i++)
                 {
                     int sum = 0;
                     int counter = 0;
@@ -487,21 +704,26 @@ namespace librealsense
                     chunk_offset += scale;
                 }
 
-                // Fill-in the padded colums with zeros
-                for (int j = _real_width; j < _padded_width; j++)
+                // Fill-in the colums right of the region of interest and the padded ones with zeros
+                for (size_t i = col_end; i < size_t(_padded_width); i++)
                     *frame_data_out++ = 0;
 
                 // Skip N lines to the beginnig of the next processing segment
                 block_start += width_in * scale;
             }
         }
+    }
 
-        // Fill-in the padded rows with zeros
-        for (auto v = _real_height; v < _padded_height; ++v)
+    void decimation_filter::for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn)
+    {
+        if (_threads <= 1)
         {
-            for (auto u = 0; u < _padded_width; ++u)
-                *frame_data_out++ = 0;
+            fn(0, count);
+            return;
         }
+        if (!_thread_pool)
+            _thread_pool = processing_thread_pool::instance();
+        _thread_pool->parallel_for(count, _threads, fn);
     }
 
     void decimation_filter::decimate_others(rs2_format format, const void * frame_data_in, void * frame_data_out,
@@ -6,6 +6,7 @@
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
 #include "proc/synthetic-stream.h"
+#include "processing-thread-pool.h"
 
 namespace librealsense
 {
@@ -13,20 +14,33 @@ namespace librealsense
     class decimation_filter : public stream_filter_processing_block
     {
     public:
+        // The CUDA implementation when there is one
+        static std::shared_ptr<decimation_filter> create();
+
         decimation_filter();
 
     protected:
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source, rs2_extension tgt_type);
 
+        // roi is in output pixels; the rest of the output is zeroed
         void decimate_depth(const uint16_t * frame_data_in, uint16_t * frame_data_out,
-            size_t width_in, size_t height_in, size_t scale);
+            size_t width_in, size_t height_in, size_t scale, const region_of_interest& roi);
+        void decimate_depth_rows(const uint16_t * frame_data_in, uint16_t * frame_data_out,
+            size_t width_in, size_t scale, size_t row_begin, size_t row_end, size_t col_begin, size_t col_end);
+
+        // The output pixels whose patches are entirely inside the frame's region of interest
+        region_of_interest output_roi(const rs2::frame& f) const;
 
         void decimate_others(rs2_format format, const void * frame_data_in, void * frame_data_out,
             size_t width_in, size_t height_in, size_t scale);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
     private:
+        friend class depth_pipeline;
+        friend class decimation_filter_cuda;
+
         void    update_output_profile(const rs2::frame& f);
+        void    for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn);
 
         uint8_t                 _decimation_factor;
         uint8_t                 _control_val;
@@ -34,13 +48,13 @@ namespace librealsense
         uint8_t                 _kernel_size;
         rs2::stream_profile     _source_stream_profile;
         rs2::stream_profile     _target_stream_profile;
-        std::map<std::tuple<const rs2_stream_profile*, uint8_t>, rs2::stream_profile> _registered_profiles;
         uint16_t                _real_width;        // Number of rows/columns with real datain the decimated image
         uint16_t                _real_height;       // Correspond to w,h in the reference code
         uint16_t                _padded_width;      // Corresponds to w4/h4 in the reference code
         uint16_t                _padded_height;
-        bool                    _recalc_profile;
         bool                    _options_changed;   // Tracking changes imposed by user
+        uint8_t                 _threads;           // Output rows are split across this many threads
+        std::shared_ptr<processing_thread_pool> _thread_pool;
     };
     MAP_EXTENSION(RS2_EXTENSION_DECIMATION_FILTER, librealsense::decimation_filter);
 }
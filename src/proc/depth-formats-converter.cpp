@@ -4,13 +4,123 @@
 #include "depth-formats-converter.h"
 
 #include "stream.h"
+#include "media/depth-codec.h"
+#include <rsutils/sparse-depth.h>
+#include "image-avx.h"
 
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
 #endif
+#if defined __SSSE3__ && ! defined ANDROID
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined __SSSE3__ && ! defined ANDROID && defined RS2_USE_AVX
+// Defined in color-formats-converter.cpp
+bool has_avx2();
+#endif
 
 namespace librealsense
 {
+    // The bit-unpacking kernels shared by the INZI, INVI and W10 converters. Each takes the AVX2 version when the CPU
+    // has it (see RS2_USE_AVX), then SSSE3 or NEON, and finishes whatever is left with the scalar code; all of them
+    // give exactly the scalar output.
+
+    // 10-bit samples to their 8 msb (the low byte of pixel >> 2)
+    static void unpack_y8_from_10bit( uint8_t * out, const uint16_t * in, int count )
+    {
+        int i = 0;
+#if defined __SSSE3__ && ! defined ANDROID
+#ifdef RS2_USE_AVX
+        static bool do_avx2 = has_avx2();
+        if( do_avx2 )
+            i = unpack_y8_from_y16_10_avx( out, in, count );
+#endif
+        const __m128i low_byte = _mm_set1_epi16( 0xff );
+        for( ; i + 16 <= count; i += 16 )
+        {
+            __m128i a = _mm_and_si128( _mm_srli_epi16( _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + i ) ), 2 ), low_byte );
+            __m128i b = _mm_and_si128( _mm_srli_epi16( _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + i + 8 ) ), 2 ), low_byte );
+            _mm_storeu_si128( reinterpret_cast< __m128i * >( out + i ), _mm_packus_epi16( a, b ) );
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        for( ; i + 8 <= count; i += 8 )
+            vst1_u8( out + i, vshrn_n_u16( vld1q_u16( in + i ), 2 ) );
+#endif
+        for( ; i < count; ++i )
+            out[i] = uint8_t( in[i] >> 2 );
+    }
+
+    // 10-bit samples moved to the msb of 16 bits
+    static void unpack_y16_from_10bit( uint16_t * out, const uint16_t * in, int count )
+    {
+        int i = 0;
+#if defined __SSSE3__ && ! defined ANDROID
+#ifdef RS2_USE_AVX
+        static bool do_avx2 = has_avx2();
+        if( do_avx2 )
+            i = unpack_y16_from_y16_10_avx( out, in, count );
+#endif
+        for( ; i + 8 <= count; i += 8 )
+            _mm_storeu_si128( reinterpret_cast< __m128i * >( out + i ),
+                              _mm_slli_epi16( _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + i ) ), 6 ) );
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        for( ; i + 8 <= count; i += 8 )
+            vst1q_u16( out + i, vshlq_n_u16( vld1q_u16( in + i ), 6 ) );
+#endif
+        for( ; i < count; ++i )
+            out[i] = uint16_t( in[i] << 6 );
+    }
+
+    // Y10BPACK macro-pixels (4 msb bytes, then a byte with the 2 lsb of each) to 16 bits with the 10 in the msb.
+    // Two macro-pixels at a time: the msb go to the high byte of each pixel, and the lsb byte is multiplied by
+    // 64/16/4/1 so that pixel k's bits land at 6-7.
+    static void unpack_y10bpack_pixels( uint16_t * out, const uint8_t * in, int count )
+    {
+        int i = 0;
+#if defined __SSSE3__ && ! defined ANDROID
+#ifdef RS2_USE_AVX
+        static bool do_avx2 = has_avx2();
+        if( do_avx2 )
+            i = unpack_y10bpack_avx( out, in, count );
+#endif
+        const __m128i msb = _mm_setr_epi8( -1, 0, -1, 1, -1, 2, -1, 3, -1, 5, -1, 6, -1, 7, -1, 8 );
+        const __m128i lsb = _mm_setr_epi8( 4, -1, 4, -1, 4, -1, 4, -1, 9, -1, 9, -1, 9, -1, 9, -1 );
+        const __m128i lsb_shift = _mm_setr_epi16( 64, 16, 4, 1, 64, 16, 4, 1 );
+        const __m128i lsb_mask = _mm_set1_epi16( 0xc0 );
+        // Each iteration reads 16 bytes for the 10 it converts
+        for( ; i + 4 <= count; i += 2 )
+        {
+            __m128i v = _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + i * 5 ) );
+            __m128i lo = _mm_and_si128( _mm_mullo_epi16( _mm_shuffle_epi8( v, lsb ), lsb_shift ), lsb_mask );
+            _mm_storeu_si128( reinterpret_cast< __m128i * >( out + i * 4 ), _mm_or_si128( _mm_shuffle_epi8( v, msb ), lo ) );
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        static const uint8_t msb_idx[16] = { 0xff, 0, 0xff, 1, 0xff, 2, 0xff, 3, 0xff, 5, 0xff, 6, 0xff, 7, 0xff, 8 };
+        static const uint8_t lsb_idx[16] = { 4, 0xff, 4, 0xff, 4, 0xff, 4, 0xff, 9, 0xff, 9, 0xff, 9, 0xff, 9, 0xff };
+        static const uint16_t shift[8] = { 64, 16, 4, 1, 64, 16, 4, 1 };
+        const uint8x16_t msb = vld1q_u8( msb_idx ), lsb = vld1q_u8( lsb_idx );
+        const uint16x8_t lsb_shift = vld1q_u16( shift ), lsb_mask = vdupq_n_u16( 0xc0 );
+        for( ; i + 4 <= count; i += 2 )
+        {
+            uint8x16_t v = vld1q_u8( in + i * 5 );
+            uint16x8_t lo = vandq_u16( vmulq_u16( vreinterpretq_u16_u8( vqtbl1q_u8( v, lsb ) ), lsb_shift ), lsb_mask );
+            vst1q_u16( out + i * 4, vorrq_u16( vreinterpretq_u16_u8( vqtbl1q_u8( v, msb ) ), lo ) );
+        }
+#endif
+        for( ; i < count; ++i )
+        {
+            auto from = in + i * 5;
+            auto to = out + i * 4;
+            to[0] = uint16_t( ( ( from[0] << 2 ) | ( from[4] & 3 ) ) << 6 );
+            to[1] = uint16_t( ( ( from[1] << 2 ) | ( ( from[4] >> 2 ) & 3 ) ) << 6 );
+            to[2] = uint16_t( ( ( from[2] << 2 ) | ( ( from[4] >> 4 ) & 3 ) ) << 6 );
+            to[3] = uint16_t( ( ( from[3] << 2 ) | ( ( from[4] >> 6 ) & 3 ) ) << 6 );
+        }
+    }
+
     void unpack_z16_y8_from_sr300_inzi( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size)
     {
         auto count = width * height;
@@ -18,11 +128,10 @@ namespace librealsense
         auto out_ir = reinterpret_cast<uint8_t *>(dest[1]);
 #ifdef RS2_USE_CUDA
         rscuda::unpack_z16_y8_from_sr300_inzi_cuda(out_ir, in, count);
-        in += count;
 #else
-        for (int i = 0; i < count; ++i) *out_ir++ = *in++ >> 2;
+        unpack_y8_from_10bit(out_ir, in, count);
 #endif
-        std::memcpy( dest[0], in, count * 2 );
+        std::memcpy( dest[0], in + count, count * 2 );
     }
 
     void unpack_z16_y16_from_sr300_inzi( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size)
@@ -32,11 +141,10 @@ namespace librealsense
         auto out_ir = reinterpret_cast<uint16_t*>(dest[1]);
 #ifdef RS2_USE_CUDA
         rscuda::unpack_z16_y16_from_sr300_inzi_cuda(out_ir, in, count);
-        in += count;
 #else
-        for (int i = 0; i < count; ++i) *out_ir++ = *in++ << 6;
+        unpack_y16_from_10bit(out_ir, in, count);
 #endif
-        std::memcpy( dest[0], in, count * 2 );
+        std::memcpy( dest[0], in + count, count * 2 );
     }
 
     void unpack_inzi(rs2_format dst_ir_format, uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size)
@@ -55,14 +163,8 @@ namespace librealsense
         }
     }
 
-    template<class SOURCE, class UNPACK> void unpack_pixels( uint8_t * const dest[], int count, const SOURCE * source, UNPACK unpack, int actual_size)
-    {
-        auto out = reinterpret_cast<decltype(unpack(SOURCE())) *>(dest[0]);
-        for (int i = 0; i < count; ++i) *out++ = unpack(*source++);
-    }
-
-    void unpack_y16_from_y16_10( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size) { unpack_pixels(d, width * height, reinterpret_cast<const uint16_t*>(s), [](uint16_t pixel) -> uint16_t { return pixel << 6; }, actual_size); }
-    void unpack_y8_from_y16_10( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size) { unpack_pixels(d, width * height, reinterpret_cast<const uint16_t*>(s), [](uint16_t pixel) -> uint8_t { return pixel >> 2; }, actual_size); }
+    void unpack_y16_from_y16_10( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size) { unpack_y16_from_10bit(reinterpret_cast<uint16_t*>(d[0]), reinterpret_cast<const uint16_t*>(s), width * height); }
+    void unpack_y8_from_y16_10( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size) { unpack_y8_from_10bit(d[0], reinterpret_cast<const uint16_t*>(s), width * height); }
 
     void unpack_invi(rs2_format dst_format, uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size)
     {
@@ -88,18 +190,10 @@ namespace librealsense
 
     void unpack_y10bpack( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size)
     {
-        auto count = width * height / 4; // num of pixels
-        uint8_t  * from = (uint8_t*)(source);
-        uint16_t * to = (uint16_t*)(dest[0]);
+        auto count = width * height / 4; // num of macro-pixels
 
         // Put the 10 bit into the msb of uint16_t
-        for (int i = 0; i < count; i++, from += 5) // traverse macro-pixels
-        {
-            *to++ = ((from[0] << 2) | (from[4] & 3)) << 6;
-            *to++ = ((from[1] << 2) | ((from[4] >> 2) & 3)) << 6;
-            *to++ = ((from[2] << 2) | ((from[4] >> 4) & 3)) << 6;
-            *to++ = ((from[3] << 2) | ((from[4] >> 6) & 3)) << 6;
-        }
+        unpack_y10bpack_pixels(reinterpret_cast<uint16_t*>(dest[0]), source, count);
     }
 
     void unpack_w10(rs2_format dst_format, uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size)
@@ -143,4 +237,20 @@ namespace librealsense
     {
         unpack_w10(_target_format, dest, source, width, height, actual_size);
     }
+
+    z16rvl_converter::z16rvl_converter(const char * name) :
+        functional_processing_block(name, RS2_FORMAT_Z16, RS2_STREAM_DEPTH, RS2_EXTENSION_DEPTH_FRAME),
+        _thread_pool(processing_thread_pool::instance()) {}
+
+    void z16rvl_converter::process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
+    {
+        if (!depth_codec::decode(source, input_size, reinterpret_cast<uint16_t *>(dest[0]), size_t(width) * height, _thread_pool.get()))
+            LOG_ERROR("Z16RVL decode failed");
+    }
+
+    void z16_sparse_converter::process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size)
+    {
+        if (!rsutils::sparse_depth::decode(source, input_size, reinterpret_cast<uint16_t *>(dest[0]), uint32_t(width), uint32_t(height)))
+            LOG_ERROR("Z16_SPARSE decode failed");
+    }
 }
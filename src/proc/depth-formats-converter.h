@@ -6,6 +6,7 @@
 #include "synthetic-stream.h"
 #include "option.h"
 #include "image.h"
+#include "processing-thread-pool.h"
 
 namespace librealsense
 {
@@ -42,4 +43,32 @@ namespace librealsense
         w10_converter(const char* name, const rs2_format& target_format);
         void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
     };
+
+    // Losslessly compressed depth (see rsutils/depth-codec.h) back to Z16, decoded on the processing pool
+    class z16rvl_converter : public functional_processing_block
+    {
+    public:
+        z16rvl_converter() :
+            z16rvl_converter("Z16RVL to Z16 Transform") {};
+
+    protected:
+        z16rvl_converter(const char* name);
+        void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+
+    private:
+        std::shared_ptr< processing_thread_pool > _thread_pool;
+    };
+
+    // The valid pixels only (see rsutils/sparse-depth.h) back to Z16
+    class z16_sparse_converter : public functional_processing_block
+    {
+    public:
+        z16_sparse_converter() :
+            z16_sparse_converter("Z16_SPARSE to Z16 Transform") {};
+
+    protected:
+        z16_sparse_converter(const char* name) :
+            functional_processing_block(name, RS2_FORMAT_Z16, RS2_STREAM_DEPTH, RS2_EXTENSION_DEPTH_FRAME) {};
+        void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+    };
 }
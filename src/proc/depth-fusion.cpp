@@ -0,0 +1,315 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/hpp/rs_sensor.hpp>
+#include <librealsense2/hpp/rs_processing.hpp>
+
+#include <src/core/depth-frame.h>
+#include <src/environment.h>
+#include <src/points.h>
+#include "option.h"
+#include "stream.h"
+#include "core/video.h"
+#include "projection.h"
+#include "proc/synthetic-stream.h"
+#include "proc/processing-thread-pool.h"
+#include "proc/output-profile-cache.h"
+#include "depth-fusion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace librealsense
+{
+    // The number of threads the rows are split across
+    const uint8_t threads_min = 1;
+    const uint8_t threads_step = 1;
+    const uint8_t threads_def = 1;
+
+    // A camera whose latest frame is older than this many frames of the reference is left out
+    const uint64_t max_age = 30;
+
+    depth_fusion::depth_fusion()
+        : generic_processing_block("Depth Fusion")
+        , _reference_frames(0)
+        , _target_output(df_max_value)
+        , _target_points(0)
+        , _target_cell_size(0)
+        , _target_map_size(0)
+        , _output(df_points)
+        , _cell_size(0.01f)
+        , _map_size(512)
+        , _threads(threads_def)
+    {
+        auto output_opt = std::make_shared<ptr_option<uint8_t>>(
+            uint8_t(df_points), uint8_t(df_max_value - 1), uint8_t(1), uint8_t(df_points),
+            &_output, "Output the points of all the cameras, or a height map of them");
+        output_opt->set_description(df_points, "Points");
+        output_opt->set_description(df_height_map, "Height Map");
+        register_option(RS2_OPTION_DEPTH_FUSION_OUTPUT, output_opt);
+
+        register_option(RS2_OPTION_DEPTH_FUSION_CELL_SIZE,
+            std::make_shared<ptr_option<float>>(0.001f, 1.f, 0.001f, 0.01f, &_cell_size,
+                "Size of the cells of the height map, in meters"));
+
+        register_option(RS2_OPTION_DEPTH_FUSION_MAP_SIZE,
+            std::make_shared<ptr_option<uint16_t>>(uint16_t(16), uint16_t(4096), uint16_t(1), uint16_t(512), &_map_size,
+                "Number of cells on a side of the height map, centered on the reference camera's axis"));
+
+        register_option(RS2_OPTION_FILTER_THREADS,
+            std::make_shared<ptr_option<uint8_t>>(threads_min,
+                uint8_t(std::min(processing_thread_pool::max_threads(), 255)), threads_step, threads_def, &_threads,
+                "Number of threads to split the rows of the cameras across"));
+    }
+
+    static bool is_fused(const rs2::frame& f)
+    {
+        return f.is<rs2::depth_frame>() && f.get_profile().format() == RS2_FORMAT_Z16;
+    }
+
+    bool depth_fusion::should_process(const rs2::frame& frame)
+    {
+        if (!frame)
+            return false;
+        if (auto set = frame.as<rs2::frameset>())
+        {
+            for (auto f : set)
+                if (is_fused(f))
+                    return true;
+            return false;
+        }
+        return is_fused(frame);
+    }
+
+    void depth_fusion::update_camera(camera& c, const rs2::frame& f)
+    {
+        auto profile = f.get_profile();
+        if (profile.get() == c.profile.get() && c.placed)
+            return;
+        c.profile = profile;
+
+        // The extrinsics may be registered after the stream started
+        rs2_extrinsics to_reference = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0, 0, 0 } };
+        bool placed = profile.unique_id() == _reference.unique_id()
+            || environment::get_instance().get_extrinsics_graph().try_fetch_extrinsics(
+                *profile.get()->profile, *_reference.get()->profile, &to_reference);
+        auto intrinsics = profile.as<rs2::video_stream_profile>().get_intrinsics();
+        if (!placed)
+        {
+            c.placed = false;
+            return;
+        }
+
+        bool rays_changed = c.rays.empty() || memcmp(&intrinsics, &c.intrinsics, sizeof(intrinsics))
+                         || memcmp(&to_reference, &c.to_reference, sizeof(to_reference));
+        c.placed = true;
+        c.intrinsics = intrinsics;
+        c.to_reference = to_reference;
+        if (!rays_changed)
+            return;
+
+        int w = intrinsics.width, h = intrinsics.height;
+        c.rays.resize(3 * size_t(w) * h);
+        std::vector<float> row(2 * size_t(w));
+        for (int x = 0; x < w; ++x)
+            row[2 * x] = float(x);
+        for (int y = 0; y < h; ++y)
+        {
+            for (int x = 0; x < w; ++x)
+                row[2 * x + 1] = float(y);
+            deproject_pixels_to_points(&c.rays[3 * size_t(y) * w], intrinsics, row.data(), nullptr, w);
+        }
+
+        auto r = to_reference.rotation;
+        for (size_t i = 0; i < c.rays.size(); i += 3)
+        {
+            float ray[3] = { c.rays[i], c.rays[i + 1], c.rays[i + 2] };
+            for (int k = 0; k < 3; ++k)
+                c.rays[i + k] = r[k] * ray[0] + r[k + 3] * ray[1] + r[k + 6] * ray[2];
+        }
+    }
+
+    void depth_fusion::add_frame(const rs2::frame& f)
+    {
+        auto& c = _cameras[f.get_profile().unique_id()];
+        c.frame = f;
+        c.updated = _reference_frames;
+        update_camera(c, f);
+    }
+
+    void depth_fusion::camera_rows(const std::vector<const camera*>& cameras, float3* points, size_t begin, size_t end) const
+    {
+        size_t row0 = 0;
+        for (auto c : cameras)
+        {
+            const size_t w = c->intrinsics.width, h = c->intrinsics.height;
+            const size_t b = std::max(begin, row0), e = std::min(end, row0 + h);
+            if (b < e)
+            {
+                auto depth = reinterpret_cast<const uint16_t*>(c->frame.get_data());
+                const float units = ((depth_frame*)c->frame.get())->get_units();
+                const float* t = c->to_reference.translation;
+                for (size_t i = (b - row0) * w; i < (e - row0) * w; ++i)
+                {
+                    if (!depth[i])
+                    {
+                        points[i] = {};
+                        continue;
+                    }
+                    const float z = depth[i] * units;
+                    const float* ray = &c->rays[3 * i];
+                    points[i] = { z * ray[0] + t[0], z * ray[1] + t[1], z * ray[2] + t[2] };
+                }
+            }
+            row0 += h;
+            points += w * h;
+        }
+    }
+
+    void depth_fusion::parallel_rows(size_t rows, const std::function<void(size_t, size_t)>& f)
+    {
+        if (_threads <= 1)
+            f(0, rows);
+        else
+        {
+            if (!_thread_pool)
+                _thread_pool = processing_thread_pool::instance();
+            _thread_pool->parallel_for(rows, _threads, f);
+        }
+    }
+
+    void depth_fusion::update_target_profile(size_t points)
+    {
+        bool same = _target_stream_profile && _target_output == _output
+            && (_output == df_points ? _target_points == points
+                                     : _target_cell_size == _cell_size && _target_map_size == _map_size);
+        if (same)
+            return;
+
+        _target_output = _output;
+        _target_points = points;
+        _target_cell_size = _cell_size;
+        _target_map_size = _map_size;
+
+        output_profile_cache::key key(_reference.get()->profile, RS2_STREAM_DEPTH, _reference.stream_index(),
+            _output == df_points ? RS2_FORMAT_XYZ32F : RS2_FORMAT_DISTANCE, "fusion");
+        output_profile_cache::setup_callback setup;
+        if (_output == df_points)
+        {
+            key.width = uint32_t(points);
+            key.height = 1;
+        }
+        else
+        {
+            key.width = key.height = _map_size;
+            key.param = _cell_size;
+
+            // Orthographic: the focal lengths are the cells in a meter, and the principal point the reference's axis
+            rs2_intrinsics intrinsics = {};
+            intrinsics.width = intrinsics.height = _map_size;
+            intrinsics.ppx = intrinsics.ppy = float(_map_size / 2);
+            intrinsics.fx = intrinsics.fy = 1.f / _cell_size;
+            intrinsics.model = RS2_DISTORTION_NONE;
+            setup = [intrinsics](stream_profile_interface& p)
+            {
+                auto tgt_vspi = dynamic_cast<video_stream_profile_interface*>(&p);
+                if (!tgt_vspi)
+                    throw std::runtime_error("Profile is not video stream profile");
+                tgt_vspi->set_intrinsics([intrinsics]() { return intrinsics; });
+            };
+        }
+        _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(key, setup);
+    }
+
+    rs2::frame depth_fusion::fuse(const rs2::frame_source& source, const rs2::frame& reference)
+    {
+        // The reference first, then the others of recent frames that it has extrinsics for
+        std::vector<const camera*> cameras;
+        size_t points = 0, rows = 0;
+        auto add = [&](const camera& c)
+        {
+            auto vf = c.frame.as<rs2::video_frame>();
+            if (!c.placed || c.updated + max_age < _reference_frames
+                || vf.get_width() != c.intrinsics.width || vf.get_height() != c.intrinsics.height)
+                return;
+            cameras.push_back(&c);
+            points += size_t(c.intrinsics.width) * c.intrinsics.height;
+            rows += c.intrinsics.height;
+        };
+        add(_cameras[_reference.unique_id()]);
+        for (auto& kv : _cameras)
+            if (kv.first != _reference.unique_id())
+                add(kv.second);
+        if (cameras.empty())
+            return {};
+
+        update_target_profile(points);
+
+        if (_target_output == df_points)
+        {
+            auto res = source.allocate_points(_target_stream_profile, reference);
+            // A recycled frame may still have the layout it was packed in
+            ((librealsense::points*)res.get())->set_layout(RS2_POINTS_LAYOUT_INTERLEAVED, 0);
+            auto pts = res.as<rs2::points>();
+            auto vertices = reinterpret_cast<float3*>(const_cast<rs2::vertex*>(pts.get_vertices()));
+            memset(const_cast<rs2::texture_coordinate*>(pts.get_texture_coordinates()), 0, points * sizeof(float2));
+            parallel_rows(rows, [&](size_t begin, size_t end) { camera_rows(cameras, vertices, begin, end); });
+            return res;
+        }
+
+        _points.resize(points);
+        parallel_rows(rows, [&](size_t begin, size_t end) { camera_rows(cameras, _points.data(), begin, end); });
+
+        const int size = _target_map_size;
+        auto res = source.allocate_video_frame(_target_stream_profile, reference, sizeof(float), size, size,
+            size * sizeof(float), RS2_EXTENSION_DEPTH_FRAME);
+        if (!res)
+            return {};
+        auto map = reinterpret_cast<float*>(const_cast<void*>(res.get_data()));
+        std::fill(map, map + size_t(size) * size, 0.f);
+
+        const float scale = 1.f / _target_cell_size;
+        const int half = size / 2;
+        for (auto& p : _points)
+        {
+            if (p.z <= 0)
+                continue;
+            int x = int(std::floor(p.x * scale)) + half, y = int(std::floor(p.y * scale)) + half;
+            if (x < 0 || y < 0 || x >= size || y >= size)
+                continue;
+            float& cell = map[y * size + x];
+            if (!cell || p.z < cell)
+                cell = p.z;
+        }
+        return res;
+    }
+
+    rs2::frame depth_fusion::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        rs2::frame reference;
+        auto take = [&](const rs2::frame& depth)
+        {
+            if (!is_fused(depth))
+                return;
+            if (!_reference)
+                _reference = depth.get_profile();
+            if (depth.get_profile().unique_id() == _reference.unique_id())
+            {
+                ++_reference_frames;
+                reference = depth;
+            }
+            add_frame(depth);
+        };
+        if (auto set = f.as<rs2::frameset>())
+            for (auto depth : set)
+                take(depth);
+        else
+            take(f);
+
+        // Frames of the other cameras wait for the reference's
+        if (!reference)
+            return {};
+        return fuse(source, reference);
+    }
+}
@@ -0,0 +1,81 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+// The depth of several cameras, in the coordinates of one of them: one point cloud of all their points, or an
+// orthographic height map of the nearest of them.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include <src/float3.h>
+
+#include <map>
+
+namespace librealsense
+{
+    class processing_thread_pool;
+
+    enum depth_fusion_output : uint8_t
+    {
+        df_points,      // RS2_FORMAT_XYZ32F points of every pixel of every camera, one camera after the other
+        df_height_map,  // RS2_FORMAT_DISTANCE, the nearest Z of the points in each cell of a grid across X and Y
+        df_max_value
+    };
+
+    // The first depth stream the block sees is the reference; the others are placed relative to it by the extrinsics
+    // registered between their profiles and its profile (rs2_register_extrinsics), and the streams it has none for are
+    // left out. Depth frames, and framesets of them, are kept as the latest of their stream, and the reference's
+    // frames are output fused with the latest of the others; a camera that stops sending frames drops out.
+    // The rays of each camera's pixels, turned to the reference, are tabulated once per intrinsics and extrinsics, so
+    // a point is a multiplication and addition per coordinate; cameras' rows are split across
+    // RS2_OPTION_FILTER_THREADS threads. In the height map, the nearer point of a cell hides the farther, as seen along
+    // the reference's Z axis.
+    class depth_fusion : public generic_processing_block
+    {
+    public:
+        depth_fusion();
+
+    protected:
+        bool should_process(const rs2::frame& frame) override;
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        struct camera
+        {
+            rs2::frame          frame;          // The latest
+            uint64_t            updated = 0;    // The reference's frame count at the latest
+            rs2::stream_profile profile;        // What the extrinsics were looked for, and the rays made, for
+            bool                placed = false; // Whether there are extrinsics to the reference
+            rs2_intrinsics      intrinsics = {};
+            rs2_extrinsics      to_reference = {};
+            std::vector<float>  rays;           // 3 per pixel: its point at a depth of 1, turned to the reference
+        };
+
+        void add_frame(const rs2::frame& f);
+        void update_camera(camera& c, const rs2::frame& f);
+
+        // The points of rows [begin, end) of all the cameras' rows, one camera after the other
+        void camera_rows(const std::vector<const camera*>& cameras, float3* points, size_t begin, size_t end) const;
+        void parallel_rows(size_t rows, const std::function<void(size_t, size_t)>& f);
+
+        rs2::frame fuse(const rs2::frame_source& source, const rs2::frame& reference);
+        void update_target_profile(size_t points);
+
+        std::map<int, camera>               _cameras;       // By the unique id of their profile
+        rs2::stream_profile                 _reference;
+        uint64_t                            _reference_frames;
+
+        rs2::stream_profile                 _target_stream_profile;
+        uint8_t                             _target_output;
+        size_t                              _target_points;
+        float                               _target_cell_size;
+        int                                 _target_map_size;
+
+        uint8_t                             _output;
+        float                               _cell_size;     // Of the height map, in meters
+        uint16_t                            _map_size;      // Of the height map, in cells on a side
+        uint8_t                             _threads;
+        std::shared_ptr<processing_thread_pool> _thread_pool;
+        std::vector<float3>                 _points;        // Scratch, for the height map
+    };
+    MAP_EXTENSION(RS2_EXTENSION_DEPTH_FUSION, librealsense::depth_fusion);
+}
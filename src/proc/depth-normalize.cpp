@@ -0,0 +1,212 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/hpp/rs_sensor.hpp>
+#include <librealsense2/hpp/rs_processing.hpp>
+
+#include <src/core/depth-frame.h>
+#include "proc/synthetic-stream.h"
+#include "proc/disparity-transform.h"
+#include "proc/output-profile-cache.h"
+#include "environment.h"
+#include "option.h"
+#include "depth-normalize.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace librealsense
+{
+    depth_normalize::depth_normalize()
+        : stream_filter_processing_block("Depth Normalize")
+        , _target_output(dn_max_value)
+        , _min(0.1f), _max(4.f)
+        , _output(dn_distance)
+        , _stereoscopic_depth(false)
+        , _d2d_convert_factor(0), _depth_units(0)
+        , _raw_min(1), _raw_max(0)
+        , _range_min(0), _range_max(0), _range_units(0)
+    {
+        _stream_filter.format = RS2_FORMAT_Z16;
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+
+        // The same options as the threshold filter's
+        auto min_opt = std::make_shared<ptr_option<float>>(0.f, 16.f, 0.1f, 0.1f, &_min, "Min range in meters");
+
+        auto max_opt = std::make_shared<ptr_option<float>>(0.f, 16.f, 0.1f, 4.f, &_max, "Max range in meters");
+
+        register_option(RS2_OPTION_MAX_DISTANCE,
+            std::make_shared<max_distance_option>(
+                max_opt,
+                min_opt));
+
+        register_option(RS2_OPTION_MIN_DISTANCE,
+            std::make_shared<min_distance_option>(
+                min_opt,
+                max_opt));
+
+        register_roi_options();
+
+        auto output_opt = std::make_shared<ptr_option<uint8_t>>(
+            uint8_t(dn_distance), uint8_t(dn_max_value - 1), uint8_t(1), uint8_t(dn_distance),
+            &_output, "Output distance in meters or disparity");
+        output_opt->set_description(dn_distance, "Distance");
+        output_opt->set_description(dn_disparity, "Disparity");
+        register_option(RS2_OPTION_DEPTH_NORMALIZE_OUTPUT, output_opt);
+    }
+
+    void depth_normalize::update_configuration(const rs2::frame& f)
+    {
+        auto du = ((depth_frame*)f.get())->get_units();
+
+        bool profile_changed = f.get_profile().get() != _source_stream_profile.get();
+        if (profile_changed || _output != _target_output)
+        {
+            _source_stream_profile = f.get_profile();
+            _target_output = _output;
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(_source_stream_profile, RS2_STREAM_DEPTH, 0,
+                _output == dn_disparity ? RS2_FORMAT_DISPARITY32 : RS2_FORMAT_DISTANCE);
+        }
+
+        // The disparity factor is in depth units, which may change within a stream
+        if (profile_changed || du != _depth_units)
+        {
+            auto info = disparity_info::update_info_from_frame(f);
+            _stereoscopic_depth = info.stereoscopic_depth;
+            _d2d_convert_factor = info.d2d_convert_factor;
+            _depth_units = du;
+        }
+
+        // The threshold filter keeps the pixels whose du * depth is in [min, max]. The product grows with the raw
+        // value, so those are a range of raw values: 0 is left out, as it's 0 in the output anyway.
+        if (_range_min != _min || _range_max != _max || _range_units != du)
+        {
+            int lo = 1;
+            while (lo <= 0xffff && du * lo < _min)
+                ++lo;
+            int hi = 0xffff;
+            while (hi >= lo && du * hi > _max)
+                --hi;
+            if (hi < lo)
+                _raw_min = 1, _raw_max = 0;     // Nothing is in range
+            else
+                _raw_min = uint16_t(lo), _raw_max = uint16_t(hi);
+            _range_min = _min;
+            _range_max = _max;
+            _range_units = du;
+        }
+    }
+
+    void depth_normalize::normalize_pixels(const uint16_t* in, float* out, size_t count) const
+    {
+        const bool disparity = _target_output == dn_disparity;
+        const uint16_t raw_min = _raw_min, raw_max = _raw_max;
+        // The scale of the units transform, or the numerator of the disparity lookup table
+        const float k = disparity ? _d2d_convert_factor : _depth_units;
+
+        size_t i = 0;
+#if defined(__SSSE3__)
+        // No unsigned 16-bit comparisons before SSE4.1: the values are offset into the signed range instead
+        const __m128i offset = _mm_set1_epi16(short(0x8000));
+        const __m128i lo = _mm_set1_epi16(short(raw_min ^ 0x8000));
+        const __m128i hi = _mm_set1_epi16(short(raw_max ^ 0x8000));
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 factor = _mm_set1_ps(k);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i z = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            __m128i zs = _mm_xor_si128(z, offset);
+            __m128i outside = _mm_or_si128(_mm_cmplt_epi16(zs, lo), _mm_cmpgt_epi16(zs, hi));
+            z = _mm_andnot_si128(outside, z);
+
+            __m128 v[2] = { _mm_cvtepi32_ps(_mm_unpacklo_epi16(z, zero)), _mm_cvtepi32_ps(_mm_unpackhi_epi16(z, zero)) };
+            for (int n = 0; n < 2; n++)
+            {
+                __m128 r;
+                if (disparity)  // 0 where there's no depth, instead of the division's infinity
+                    r = _mm_and_ps(_mm_div_ps(factor, v[n]), _mm_cmpneq_ps(v[n], _mm_setzero_ps()));
+                else
+                    r = _mm_mul_ps(v[n], factor);
+                _mm_storeu_ps(out + i + 4 * n, r);
+            }
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        const uint16x8_t lo = vdupq_n_u16(raw_min);
+        const uint16x8_t hi = vdupq_n_u16(raw_max);
+        const float32x4_t factor = vdupq_n_f32(k);
+        for (; i + 8 <= count; i += 8)
+        {
+            uint16x8_t z = vld1q_u16(in + i);
+            z = vandq_u16(z, vandq_u16(vcgeq_u16(z, lo), vcleq_u16(z, hi)));
+
+            uint32x4_t w[2] = { vmovl_u16(vget_low_u16(z)), vmovl_u16(vget_high_u16(z)) };
+            for (int n = 0; n < 2; n++)
+            {
+                float32x4_t v = vcvtq_f32_u32(w[n]);
+                float32x4_t r;
+                if (disparity)
+                    r = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vdivq_f32(factor, v)), vtstq_u32(w[n], w[n])));
+                else
+                    r = vmulq_f32(v, factor);
+                vst1q_f32(out + i + 4 * n, r);
+            }
+        }
+#endif
+        for (; i < count; i++)
+        {
+            auto z = in[i];
+            if (z < raw_min || z > raw_max)
+                out[i] = 0;
+            else
+                out[i] = disparity ? k / float(z) : k * z;
+        }
+    }
+
+    rs2::frame depth_normalize::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        if (!f.is<rs2::depth_frame>()) return f;
+
+        update_configuration(f);
+
+        // Like depth to disparity, there's no disparity without a stereo baseline
+        if (_target_output == dn_disparity && !_stereoscopic_depth)
+            return f;
+
+        auto vf = f.as<rs2::depth_frame>();
+        auto width = vf.get_width();
+        auto height = vf.get_height();
+        auto new_f = source.allocate_video_frame(_target_stream_profile, f,
+            sizeof(float), width, height, width * sizeof(float),
+            _target_output == dn_disparity ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME);
+
+        if (new_f)
+        {
+            auto ptr = reinterpret_cast<librealsense::frame_interface*>(new_f.get());
+            auto orig = reinterpret_cast<librealsense::frame_interface*>(f.get());
+
+            auto depth_data = (const uint16_t*)orig->get_frame_data();
+            auto new_data = (float*)ptr->get_frame_data();
+
+            ptr->set_sensor(orig->get_sensor());
+
+            auto roi = get_roi(f, width, height);
+            if (is_full_roi(roi, width, height))
+                normalize_pixels(depth_data, new_data, size_t(width) * height);
+            else
+            {
+                memset(new_data, 0, width * height * sizeof(float));
+                for (int y = roi.min_y; y <= roi.max_y; y++)
+                    normalize_pixels(depth_data + y * width + roi.min_x, new_data + y * width + roi.min_x,
+                                     roi_width(roi));
+            }
+            set_roi(new_f, roi, width, height);
+
+            return new_f;
+        }
+
+        return f;
+    }
+}
@@ -0,0 +1,53 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+// The threshold filter, the units transform and depth to disparity as a single block: Z16 depth in, float distance in
+// meters or float disparity out, in one pass and with one output frame.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+namespace librealsense
+{
+    enum depth_normalize_output : uint8_t
+    {
+        dn_distance,    // RS2_FORMAT_DISTANCE, as the units transform outputs
+        dn_disparity,   // RS2_FORMAT_DISPARITY32, as depth to disparity outputs
+        dn_max_value
+    };
+
+    // Has the options of the threshold filter (min/max distance and the region of interest), so it can stand in for
+    // it. The output is what the threshold filter followed by the units transform, or by depth to disparity, make of
+    // the frame: the depth range of the options is found once per setting as a range of raw values, and each pixel is
+    // then one comparison and one multiplication (or division) of SIMD lanes.
+    class depth_normalize : public stream_filter_processing_block
+    {
+    public:
+        depth_normalize();
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        void update_configuration(const rs2::frame& f);
+
+        // Pixels [0, count) of a row, those of raw depth outside [_raw_min, _raw_max] to 0
+        void normalize_pixels(const uint16_t* in, float* out, size_t count) const;
+
+        rs2::stream_profile     _source_stream_profile;
+        rs2::stream_profile     _target_stream_profile;
+        uint8_t                 _target_output;         // Of _target_stream_profile
+
+        float                   _min, _max;             // In meters
+        uint8_t                 _output;
+
+        bool                    _stereoscopic_depth;
+        float                   _d2d_convert_factor;    // As in disparity_transform, for the frame's depth units
+        float                   _depth_units;
+
+        // The raw values that are in [_min, _max] meters for _depth_units, when _raw_min <= _raw_max
+        uint16_t                _raw_min, _raw_max;
+        float                   _range_min, _range_max, _range_units;   // What the raw range was found for
+    };
+    MAP_EXTENSION(RS2_EXTENSION_DEPTH_NORMALIZE, librealsense::depth_normalize);
+}
@@ -0,0 +1,161 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "option.h"
+#include "proc/synthetic-stream.h"
+#include "proc/depth-pipeline.h"
+
+#include <librealsense2/hpp/rs_sensor.hpp>
+#include <librealsense2/hpp/rs_processing.hpp>
+
+#include <rsutils/string/from.h>
+
+
+namespace librealsense
+{
+    depth_pipeline::depth_pipeline() :
+        stream_filter_processing_block("Depth Pipeline"),
+        _decimation(std::make_shared<decimation_filter>()),
+        _disparity(std::make_shared<disparity_transform>(true)),
+        _spatial(std::make_shared<spatial_filter>()),
+        _temporal(std::make_shared<temporal_filter>()),
+        _hole_filling(std::make_shared<hole_filling_filter>()),
+        _stage(dp_decimation),
+        _width(0), _height(0)
+    {
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+        _stream_filter.format = RS2_FORMAT_Z16;
+
+        auto stage = std::make_shared<ptr_option<uint8_t>>(
+            dp_decimation,
+            dp_max_value - 1,
+            1,
+            dp_decimation,
+            &_stage, "The stage the magnitude, smooth alpha, smooth delta, holes fill and threads options are of");
+        stage->set_description(dp_decimation, "Decimation");
+        stage->set_description(dp_spatial, "Spatial");
+        stage->set_description(dp_temporal, "Temporal");
+        stage->set_description(dp_hole_filling, "Hole Filling");
+        register_option(RS2_OPTION_PIPELINE_STAGE, stage);
+
+        for (auto opt : { RS2_OPTION_FILTER_MAGNITUDE, RS2_OPTION_FILTER_SMOOTH_ALPHA, RS2_OPTION_FILTER_SMOOTH_DELTA,
+                          RS2_OPTION_HOLES_FILL, RS2_OPTION_FILTER_THREADS })
+            register_option(opt, std::make_shared<stage_option>(this, opt));
+    }
+
+    processing_block& depth_pipeline::selected_stage() const
+    {
+        switch (_stage)
+        {
+        case dp_decimation: return *_decimation;
+        case dp_spatial: return *_spatial;
+        case dp_temporal: return *_temporal;
+        case dp_hole_filling: return *_hole_filling;
+        default:
+            throw invalid_value_exception( rsutils::string::from() << "Unsupported depth pipeline stage: "
+                                                                   << int(_stage) << " is out of range." );
+        }
+    }
+
+    option& depth_pipeline::stage_option::get() const
+    {
+        auto & stage = _parent->selected_stage();
+        if (!stage.supports_option(_opt))
+            throw invalid_value_exception( rsutils::string::from() << rs2_option_to_string(_opt) << " is not an option of the "
+                                                                   << stage.get_info(RS2_CAMERA_INFO_NAME) );
+        return stage.get_option(_opt);
+    }
+
+    rs2::frame depth_pipeline::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        _decimation->update_output_profile(f);
+
+        auto tgt = source.allocate_video_frame(_decimation->_target_stream_profile, f,
+            sizeof(uint16_t),
+            _decimation->_padded_width,
+            _decimation->_padded_height,
+            _decimation->_padded_width * sizeof(uint16_t),
+            RS2_EXTENSION_DEPTH_FRAME);
+        if (!tgt)
+            return f;
+
+        // Each stage is configured as it would be by the decimated frame
+        if (tgt.get_profile().get() != _stages_profile.get())
+        {
+            _stages_profile = tgt.get_profile();
+            _width = _decimation->_padded_width;
+            _height = _decimation->_padded_height;
+            _disparity->update_transformation_profile(tgt);
+            _spatial->_spatial_edge_threshold = float(_spatial->_spatial_delta_param);
+            _temporal->_last_frame.clear();
+        }
+
+        // The temporal history starts over with the profile, and when the temporal options change
+        const size_t bpp = _disparity->_stereoscopic_depth ? sizeof(float) : sizeof(uint16_t);
+        if (_temporal->_last_frame.empty())
+        {
+            _temporal->_last_frame.assign(_width * _height * bpp, 0);
+            _temporal->_history.assign(_width * _height, 0);
+        }
+
+        // Without a stereo baseline there's no disparity, and the stages run on the depth itself, as in the chain
+        auto out = static_cast<uint16_t*>(const_cast<void*>(tgt.get_data()));
+        if (_disparity->_stereoscopic_depth)
+        {
+            _disparity_image.resize(_width * _height);
+            run_stages<float>(f.as<rs2::video_frame>(), out, _disparity_image.data());
+        }
+        else
+            run_stages<uint16_t>(f.as<rs2::video_frame>(), out, out);
+
+        return tgt;
+    }
+
+    template<typename T>
+    void depth_pipeline::run_stages(const rs2::video_frame& in, uint16_t* out, T* work)
+    {
+        const bool fp = std::is_floating_point<T>::value;
+        auto depth = static_cast<const uint16_t*>(in.get_data());
+        const size_t real_height = _decimation->_real_height;
+
+        // Decimation, with the padding, then the conversion of the decimated rows to disparity while they're cached
+        _decimation->for_each_band(_height, [&](size_t begin, size_t end)
+        {
+            const size_t real_end = std::min(end, real_height);
+            if (begin < real_end)
+                _decimation->decimate_depth_rows(depth, out, in.get_width(), _decimation->_patch_size, begin, real_end,
+                    0, _decimation->_real_width);
+            for (size_t j = std::max(begin, real_end); j < end; ++j)
+                memset(out + j * _width, 0, _width * sizeof(uint16_t));
+            if (fp)
+                _disparity->convert_rows<uint16_t, float>(out, work, begin, end);
+        });
+
+        // The spatial passes go over whole rows and columns, several times
+        if (_width > 2 && _height > 2)
+            _spatial->dxf_smooth<T>(work, _width, _height, _spatial->_spatial_alpha_param,
+                _spatial->_spatial_edge_threshold, _spatial->_spatial_iterations);
+
+        // Then temporal filter, hole filling and back to depth, a row at a time. The "around" hole filling methods
+        // look at the row below before it's filled, so they're a row behind the temporal filter.
+        auto last_frame = reinterpret_cast<T*>(_temporal->_last_frame.data());
+        auto history = _temporal->_history.data();
+        const size_t lag = (_hole_filling->_hole_filling_mode == hf_fill_from_left) ? 0 : 1;
+        auto fill_row = [&](size_t j)
+        {
+            _hole_filling->apply_hole_filling_rows<T>(work, _width, _height, j, j + 1);
+            if (fp)
+                _disparity->convert_rows<float, uint16_t>(work, out, j, j + 1);
+        };
+
+        for (size_t j = 0; j < _height; ++j)
+        {
+            _temporal->temp_jw_smooth_pixels<T>(work + j * _width, last_frame + j * _width, history + j * _width, _width);
+            if (j >= lag)
+                fill_row(j - lag);
+        }
+        if (lag && _height)
+            fill_row(_height - 1);
+        _temporal->_cur_frame_index = (_temporal->_cur_frame_index + 1) % 8;
+    }
+}
@@ -0,0 +1,82 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+// The recommended depth post-processing chain as a single block: decimation, depth to disparity, spatial, temporal,
+// hole filling and disparity to depth, with one output frame and no intermediate ones.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "decimation-filter.h"
+#include "disparity-transform.h"
+#include "spatial-filter.h"
+#include "temporal-filter.h"
+#include "hole-filling-filter.h"
+
+namespace librealsense
+{
+    enum depth_pipeline_stages : uint8_t
+    {
+        dp_decimation,
+        dp_spatial,
+        dp_temporal,
+        dp_hole_filling,
+        dp_max_value
+    };
+
+    // The output is bit-exact with the chain of separate blocks. The stages are those blocks, and run their own
+    // code, but on buffers of the pipeline: after decimating (and converting to disparity) and the spatial passes,
+    // the temporal filter, the hole filling and the conversion back to depth are done row by row, while the row is
+    // in the cache.
+    //
+    // Several stages have options with the same id (magnitude, smooth alpha and delta, holes fill, threads), so
+    // RS2_OPTION_PIPELINE_STAGE selects the stage that these options are read from and set on.
+    class depth_pipeline : public stream_filter_processing_block
+    {
+    public:
+        depth_pipeline();
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        // Forwards to the option of the selected stage
+        class stage_option : public option
+        {
+        public:
+            stage_option(depth_pipeline* parent, rs2_option opt)
+                : _parent(parent), _opt(opt) {}
+
+            void set(float value) override { get().set(value); }
+            float query() const override { return get().query(); }
+            option_range get_range() const override { return get().get_range(); }
+            bool is_enabled() const override { return _parent->selected_stage().supports_option(_opt); }
+            bool is_read_only() const override { return get().is_read_only(); }
+            const char* get_description() const override { return get().get_description(); }
+            const char* get_value_description(float v) const override { return get().get_value_description(v); }
+            void enable_recording(std::function<void(const option &)> record_action) override {}
+
+        private:
+            option& get() const;
+
+            depth_pipeline* _parent;
+            rs2_option _opt;
+        };
+
+        processing_block& selected_stage() const;
+
+        template<typename T>
+        void run_stages(const rs2::video_frame& in, uint16_t* out, T* work);
+
+        std::shared_ptr<decimation_filter>      _decimation;
+        std::shared_ptr<disparity_transform>    _disparity;
+        std::shared_ptr<spatial_filter>         _spatial;
+        std::shared_ptr<temporal_filter>        _temporal;
+        std::shared_ptr<hole_filling_filter>    _hole_filling;
+
+        uint8_t                 _stage;
+        rs2::stream_profile     _stages_profile;            // The decimated profile the stages are configured for
+        size_t                  _width, _height;            // Of the decimated frame
+        std::vector<float>      _disparity_image;
+    };
+    MAP_EXTENSION(RS2_EXTENSION_DEPTH_PIPELINE, librealsense::depth_pipeline);
+}
@@ -0,0 +1,361 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/hpp/rs_sensor.hpp>
+#include <librealsense2/hpp/rs_processing.hpp>
+#include <librealsense2/rsutil.h>
+
+#include <src/core/depth-frame.h>
+#include "proc/synthetic-stream.h"
+#include "proc/processing-thread-pool.h"
+#include "depth-quality-metrics.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace librealsense
+{
+    // The number of threads the rows are split across
+    const uint8_t threads_min = 1;
+    const uint8_t threads_step = 1;
+    const uint8_t threads_def = 1;
+
+    // The frames the metrics are over
+    const uint16_t window_min = 1;
+    const uint16_t window_max = 300;
+    const uint16_t window_step = 1;
+    const uint16_t window_def = 30;
+
+    void point_moments::add(const point_moments& other)
+    {
+        if (other.n == 0)
+            return;
+        if (n == 0)
+        {
+            *this = other;
+            return;
+        }
+
+        double total = n + other.n;
+        double d[3] = { other.mean[0] - mean[0], other.mean[1] - mean[1], other.mean[2] - mean[2] };
+        double w = n * other.n / total;
+        xx += other.xx + d[0] * d[0] * w;
+        xy += other.xy + d[0] * d[1] * w;
+        xz += other.xz + d[0] * d[2] * w;
+        yy += other.yy + d[1] * d[1] * w;
+        yz += other.yz + d[1] * d[2] * w;
+        zz += other.zz + d[2] * d[2] * w;
+        for (int i = 0; i < 3; ++i)
+            mean[i] += d[i] * other.n / total;
+        n = total;
+    }
+
+    depth_quality_metrics::depth_quality_metrics()
+        : stream_filter_processing_block("Depth Quality Metrics")
+        , _intrinsics{}
+        , _depth_units(0)
+        , _roi{}
+        , _window(window_def)
+        , _threads(threads_def)
+        , _fill_rate(0)
+        , _plane_fit_rms(0)
+        , _distance(0)
+    {
+        _stream_filter.format = RS2_FORMAT_Z16;
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+
+        register_option(RS2_OPTION_DEPTH_QUALITY_WINDOW,
+            std::make_shared<ptr_option<uint16_t>>(window_min, window_max, window_step, window_def, &_window,
+                "Number of frames the metrics are over"));
+
+        register_option(RS2_OPTION_FILTER_THREADS,
+            std::make_shared<ptr_option<uint8_t>>(threads_min,
+                uint8_t(std::min(processing_thread_pool::max_threads(), 255)), threads_step, threads_def, &_threads,
+                "Number of threads to split the rows of each frame across"));
+
+        register_option(RS2_OPTION_DEPTH_QUALITY_FILL_RATE,
+            std::make_shared<depth_quality_metric_option>(_fill_rate, 100.f,
+                "Percentage of the pixels of the region of interest with depth"));
+        register_option(RS2_OPTION_DEPTH_QUALITY_PLANE_FIT_RMS_ERROR,
+            std::make_shared<depth_quality_metric_option>(_plane_fit_rms, 65535.f,
+                "RMS of the distances, in mm, of the points of the region of interest from the plane fitted to them"));
+        register_option(RS2_OPTION_DEPTH_QUALITY_DISTANCE,
+            std::make_shared<depth_quality_metric_option>(_distance, 65535.f,
+                "Distance, in mm, of the camera from the plane fitted to the region of interest"));
+
+        register_roi_options();
+    }
+
+    void depth_quality_metrics::update_configuration(const rs2::frame& f, const region_of_interest& roi)
+    {
+        auto intrinsics = f.get_profile().as<rs2::video_stream_profile>().get_intrinsics();
+        auto du = ((depth_frame*)f.get())->get_units();
+
+        // The points of frames of anything else than what the window has don't go with them
+        bool profile_changed = f.get_profile().get() != _source_stream_profile.get();
+        bool rays_changed = memcmp(&intrinsics, &_intrinsics, sizeof(intrinsics)) != 0
+                         || roi.min_x != _roi.min_x || roi.min_y != _roi.min_y
+                         || roi.max_x != _roi.max_x || roi.max_y != _roi.max_y;
+        if (profile_changed || rays_changed || du != _depth_units)
+            _frames.clear();
+
+        _source_stream_profile = f.get_profile();
+        _depth_units = du;
+
+        if (rays_changed || _rays_x.empty())
+        {
+            _intrinsics = intrinsics;
+            _roi = roi;
+
+            int rw = roi_width(roi), rh = roi_height(roi);
+            _rays_x.resize(size_t(rw) * rh);
+            _rays_y.resize(_rays_x.size());
+            _rows.resize(rh);
+            for (int y = 0; y < rh; ++y)
+                for (int x = 0; x < rw; ++x)
+                {
+                    float pixel[2] = { float(roi.min_x + x), float(roi.min_y + y) };
+                    float point[3];
+                    rs2_deproject_pixel_to_point(point, &_intrinsics, pixel, 1.f);
+                    _rays_x[y * rw + x] = point[0];
+                    _rays_y[y * rw + x] = point[1];
+                }
+        }
+    }
+
+    void depth_quality_metrics::row_moments(const uint16_t* depth, int y, point_moments& m) const
+    {
+        const int rw = roi_width(_roi);
+        const float* rx = _rays_x.data() + size_t(y) * rw;
+        const float* ry = _rays_y.data() + size_t(y) * rw;
+        const float units = _depth_units;
+
+        // The centroid of the row first, then the products of the offsets from it: they're small, so the sums of
+        // many of them lose nothing in floats
+        double n = 0, sx = 0, sy = 0, sz = 0;
+        int i = 0;
+#if defined(__SSSE3__)
+        const __m128i zero_i = _mm_setzero_si128();
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.f);
+        const __m128 vunits = _mm_set1_ps(units);
+        auto load_depth = [&](int k) {
+            __m128i raw = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(depth + k));
+            return _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(raw, zero_i)), vunits);
+        };
+        auto lanes_sum = [](__m128 v) {
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, v);
+            return double(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        };
+
+        __m128 vn = zero, vx = zero, vy = zero, vz = zero;
+        for (; i + 4 <= rw; i += 4)
+        {
+            __m128 z = load_depth(i);
+            vn = _mm_add_ps(vn, _mm_and_ps(_mm_cmpneq_ps(z, zero), one));
+            vx = _mm_add_ps(vx, _mm_mul_ps(_mm_loadu_ps(rx + i), z));
+            vy = _mm_add_ps(vy, _mm_mul_ps(_mm_loadu_ps(ry + i), z));
+            vz = _mm_add_ps(vz, z);
+        }
+        n = lanes_sum(vn), sx = lanes_sum(vx), sy = lanes_sum(vy), sz = lanes_sum(vz);
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        auto load_depth = [&](int k) {
+            return vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vld1_u16(depth + k))), units);
+        };
+
+        uint32x4_t vn = vdupq_n_u32(0);
+        float32x4_t vx = vdupq_n_f32(0), vy = vdupq_n_f32(0), vz = vdupq_n_f32(0);
+        for (; i + 4 <= rw; i += 4)
+        {
+            float32x4_t z = load_depth(i);
+            vn = vsubq_u32(vn, vmvnq_u32(vceqq_f32(z, vdupq_n_f32(0))));
+            vx = vmlaq_f32(vx, vld1q_f32(rx + i), z);
+            vy = vmlaq_f32(vy, vld1q_f32(ry + i), z);
+            vz = vaddq_f32(vz, z);
+        }
+        n = vaddvq_u32(vn), sx = vaddvq_f32(vx), sy = vaddvq_f32(vy), sz = vaddvq_f32(vz);
+#endif
+        for (; i < rw; ++i)
+        {
+            if (!depth[i])
+                continue;
+            float z = depth[i] * units;
+            n += 1;
+            sx += rx[i] * z;
+            sy += ry[i] * z;
+            sz += z;
+        }
+
+        m = point_moments();
+        if (n == 0)
+            return;
+
+        m.n = n;
+        m.mean[0] = sx / n;
+        m.mean[1] = sy / n;
+        m.mean[2] = sz / n;
+        const float cx = float(m.mean[0]), cy = float(m.mean[1]), cz = float(m.mean[2]);
+
+        i = 0;
+#if defined(__SSSE3__)
+        const __m128 vcx = _mm_set1_ps(cx), vcy = _mm_set1_ps(cy), vcz = _mm_set1_ps(cz);
+        __m128 vxx = zero, vxy = zero, vxz = zero, vyy = zero, vyz = zero, vzz = zero;
+        for (; i + 4 <= rw; i += 4)
+        {
+            __m128 z = load_depth(i);
+            __m128 valid = _mm_cmpneq_ps(z, zero);
+            __m128 dx = _mm_and_ps(valid, _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(rx + i), z), vcx));
+            __m128 dy = _mm_and_ps(valid, _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(ry + i), z), vcy));
+            __m128 dz = _mm_and_ps(valid, _mm_sub_ps(z, vcz));
+            vxx = _mm_add_ps(vxx, _mm_mul_ps(dx, dx));
+            vxy = _mm_add_ps(vxy, _mm_mul_ps(dx, dy));
+            vxz = _mm_add_ps(vxz, _mm_mul_ps(dx, dz));
+            vyy = _mm_add_ps(vyy, _mm_mul_ps(dy, dy));
+            vyz = _mm_add_ps(vyz, _mm_mul_ps(dy, dz));
+            vzz = _mm_add_ps(vzz, _mm_mul_ps(dz, dz));
+        }
+        m.xx = lanes_sum(vxx), m.xy = lanes_sum(vxy), m.xz = lanes_sum(vxz);
+        m.yy = lanes_sum(vyy), m.yz = lanes_sum(vyz), m.zz = lanes_sum(vzz);
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        const float32x4_t vcx = vdupq_n_f32(cx), vcy = vdupq_n_f32(cy), vcz = vdupq_n_f32(cz);
+        float32x4_t vxx = vdupq_n_f32(0), vxy = vxx, vxz = vxx, vyy = vxx, vyz = vxx, vzz = vxx;
+        for (; i + 4 <= rw; i += 4)
+        {
+            float32x4_t z = load_depth(i);
+            uint32x4_t valid = vmvnq_u32(vceqq_f32(z, vdupq_n_f32(0)));
+            auto offset = [&](float32x4_t v, float32x4_t c) {
+                return vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(vsubq_f32(v, c))));
+            };
+            float32x4_t dx = offset(vmulq_f32(vld1q_f32(rx + i), z), vcx);
+            float32x4_t dy = offset(vmulq_f32(vld1q_f32(ry + i), z), vcy);
+            float32x4_t dz = offset(z, vcz);
+            vxx = vmlaq_f32(vxx, dx, dx);
+            vxy = vmlaq_f32(vxy, dx, dy);
+            vxz = vmlaq_f32(vxz, dx, dz);
+            vyy = vmlaq_f32(vyy, dy, dy);
+            vyz = vmlaq_f32(vyz, dy, dz);
+            vzz = vmlaq_f32(vzz, dz, dz);
+        }
+        m.xx = vaddvq_f32(vxx), m.xy = vaddvq_f32(vxy), m.xz = vaddvq_f32(vxz);
+        m.yy = vaddvq_f32(vyy), m.yz = vaddvq_f32(vyz), m.zz = vaddvq_f32(vzz);
+#endif
+        for (; i < rw; ++i)
+        {
+            if (!depth[i])
+                continue;
+            float z = depth[i] * units;
+            float dx = rx[i] * z - cx, dy = ry[i] * z - cy, dz = z - cz;
+            m.xx += dx * dx;
+            m.xy += dx * dy;
+            m.xz += dx * dz;
+            m.yy += dy * dy;
+            m.yz += dy * dz;
+            m.zz += dz * dz;
+        }
+    }
+
+    void depth_quality_metrics::update_metrics()
+    {
+        frame_metrics total;
+        for (auto& fm : _frames)
+        {
+            total.pixels += fm.pixels;
+            total.points.add(fm.points);
+        }
+        auto const& m = total.points;
+
+        _fill_rate = total.pixels > 0 ? float(100. * m.n / total.pixels) : 0.f;
+
+        // As plane_from_points does it
+        double det_x = m.yy * m.zz - m.yz * m.yz;
+        double det_y = m.xx * m.zz - m.xz * m.xz;
+        double det_z = m.xx * m.yy - m.xy * m.xy;
+        double det_max = std::max({ det_x, det_y, det_z });
+        if (m.n < 3 || det_max <= 0)
+        {
+            _plane_fit_rms = 0.f;
+            _distance = 0.f;
+            return;
+        }
+
+        double dir[3];
+        if (det_max == det_x)
+        {
+            dir[0] = 1;
+            dir[1] = (m.xz * m.yz - m.xy * m.zz) / det_x;
+            dir[2] = (m.xy * m.yz - m.xz * m.yy) / det_x;
+        }
+        else if (det_max == det_y)
+        {
+            dir[0] = (m.yz * m.xz - m.xy * m.zz) / det_y;
+            dir[1] = 1;
+            dir[2] = (m.xy * m.xz - m.yz * m.xx) / det_y;
+        }
+        else
+        {
+            dir[0] = (m.yz * m.xy - m.xz * m.yy) / det_z;
+            dir[1] = (m.xz * m.xy - m.yz * m.xx) / det_z;
+            dir[2] = 1;
+        }
+        double length = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+        for (auto& d : dir)
+            d /= length;
+
+        // The plane goes through the centroid: the mean square distance from it is that of the offsets along the
+        // normal
+        double ms = (dir[0] * dir[0] * m.xx + dir[1] * dir[1] * m.yy + dir[2] * dir[2] * m.zz
+                     + 2 * (dir[0] * dir[1] * m.xy + dir[0] * dir[2] * m.xz + dir[1] * dir[2] * m.yz)) / m.n;
+        _plane_fit_rms = float(std::sqrt(std::max(0., ms)) * 1000);
+        _distance = float((dir[0] * m.mean[0] + dir[1] * m.mean[1] + dir[2] * m.mean[2]) * 1000);
+    }
+
+    rs2::frame depth_quality_metrics::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        if (!f.is<rs2::depth_frame>())
+            return f;
+
+        auto vf = f.as<rs2::depth_frame>();
+        auto width = vf.get_width();
+        auto height = vf.get_height();
+        auto roi = get_roi(f, width, height);
+        if (roi_width(roi) == 0 || roi_height(roi) == 0)
+            return f;
+
+        update_configuration(f, roi);
+
+        auto depth = reinterpret_cast<const uint16_t*>(f.get_data());
+        auto rows = [&](size_t begin, size_t end)
+        {
+            for (auto y = begin; y < end; ++y)
+                row_moments(depth + (roi.min_y + y) * width + roi.min_x, int(y), _rows[y]);
+        };
+        if (_threads <= 1)
+            rows(0, _rows.size());
+        else
+        {
+            if (!_thread_pool)
+                _thread_pool = processing_thread_pool::instance();
+            _thread_pool->parallel_for(_rows.size(), _threads, rows);
+        }
+
+        frame_metrics fm;
+        fm.pixels = double(roi_width(roi)) * roi_height(roi);
+        for (auto& m : _rows)
+            fm.points.add(m);
+
+        _frames.push_back(fm);
+        while (_frames.size() > _window)
+            _frames.pop_front();
+        update_metrics();
+
+        return f;
+    }
+}
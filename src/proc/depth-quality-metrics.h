@@ -0,0 +1,91 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+// The metrics of the depth-quality tool, as a block for health checks: fill rate, plane fit RMS error and distance to
+// the plane fitted to the region of interest, over a sliding window of frames.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "option.h"
+
+#include <deque>
+
+namespace librealsense
+{
+    class processing_thread_pool;
+
+    // Points, as the sums plane_from_points (tools/depth-quality/depth-metrics.h) fits a plane from: their count,
+    // centroid and the sums of the products of their offsets from it. Sets of points combine without going back to
+    // the points (Chan et al.), so rows are reduced independently and frames come in and out of the window as sums.
+    struct point_moments
+    {
+        double n = 0;
+        double mean[3] = {};
+        double xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+
+        void add(const point_moments& other);
+    };
+
+    // A metric of the block, as a read-only option
+    class depth_quality_metric_option : public readonly_option
+    {
+    public:
+        depth_quality_metric_option(const std::atomic<float>& value, float max, const char* description)
+            : _value(value), _max(max), _description(description) {}
+
+        float query() const override { return _value; }
+        option_range get_range() const override { return { 0.f, _max, 0.f, 0.f }; }
+        bool is_enabled() const override { return true; }
+        const char* get_description() const override { return _description; }
+
+    private:
+        const std::atomic<float>& _value;
+        float _max;
+        const char* _description;
+    };
+
+    // Passes depth frames through unchanged. The pixels of depth in the region of interest are deprojected, with the
+    // frame's intrinsics, and a plane is fitted to those of the last RS2_OPTION_DEPTH_QUALITY_WINDOW frames; the
+    // results are read from the RS2_OPTION_DEPTH_QUALITY_* options.
+    class depth_quality_metrics : public stream_filter_processing_block
+    {
+    public:
+        depth_quality_metrics();
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        struct frame_metrics
+        {
+            double pixels = 0;      // In the region of interest
+            point_moments points;   // Of those with depth
+        };
+
+        void update_configuration(const rs2::frame& f, const region_of_interest& roi);
+        void update_metrics();
+
+        // The moments of row y of the region (of the rays' table), from the frame's depth in meters
+        void row_moments(const uint16_t* depth, int y, point_moments& m) const;
+
+        rs2::stream_profile                 _source_stream_profile;
+        rs2_intrinsics                      _intrinsics;
+        float                               _depth_units;
+        region_of_interest                  _roi;
+
+        // The ray of each pixel of the region: its point at a depth of 1 meter is (x, y, 1)
+        std::vector<float>                  _rays_x;
+        std::vector<float>                  _rays_y;
+        std::vector<point_moments>          _rows;
+
+        uint16_t                            _window;        // In frames
+        uint8_t                             _threads;       // Rows are split across this many threads
+        std::shared_ptr<processing_thread_pool> _thread_pool;
+        std::deque<frame_metrics>           _frames;
+
+        std::atomic<float>                  _fill_rate;     // %
+        std::atomic<float>                  _plane_fit_rms; // mm
+        std::atomic<float>                  _distance;      // mm
+    };
+    MAP_EXTENSION(RS2_EXTENSION_DEPTH_QUALITY_METRICS, librealsense::depth_quality_metrics);
+}
@@ -10,15 +10,36 @@
 #include "core/video.h"
 #include "proc/synthetic-stream.h"
 #include "proc/disparity-transform.h"
+
+#ifdef RS2_USE_CUDA
+#include "proc/cuda/cuda-depth-filters.h"
+#endif
 #include "software-device.h"
 #include "environment.h"
+#include "proc/output-profile-cache.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace librealsense
 {
+    std::shared_ptr<disparity_transform> disparity_transform::create(bool transform_to_disparity)
+    {
+        #ifdef RS2_USE_CUDA
+            return std::make_shared<librealsense::disparity_transform_cuda>(transform_to_disparity);
+        #else
+            return std::make_shared<librealsense::disparity_transform>(transform_to_disparity);
+        #endif
+    }
+
     disparity_transform::disparity_transform(bool transform_to_disparity):
         generic_processing_block(transform_to_disparity ? "Depth to Disparity" : "Disparity to Depth"),
         _transform_to_disparity(transform_to_disparity),
         _update_target(false),
+        _d2d_convert_factor(0), _disparity_lut_factor(0),
         _width(0), _height(0), _bpp(0)
     {
         unregister_option(RS2_OPTION_FRAMES_QUEUE_SIZE);
@@ -89,24 +110,38 @@ namespace librealsense
             _update_target = true;
         }
 
+        // The lookup table depends on the depth units, the baseline and the focal length, all in the factor
+        if (_transform_to_disparity && _stereoscopic_depth
+            && (_disparity_lut.empty() || _disparity_lut_factor != _d2d_convert_factor))
+        {
+            _disparity_lut.resize(size_t(std::numeric_limits<uint16_t>::max()) + 1);
+            _disparity_lut[0] = 0;
+            for (size_t i = 1; i < _disparity_lut.size(); i++)
+                _disparity_lut[i] = static_cast<float>((_d2d_convert_factor / float(i)) + 0.f);
+            _disparity_lut_factor = _d2d_convert_factor;
+        }
+
         // Adjust the target profile
         if (_update_target)
         {
             auto tgt_format = _transform_to_disparity ? RS2_FORMAT_DISPARITY32 : RS2_FORMAT_Z16;
-            _target_stream_profile = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, tgt_format);
-
             auto src_vspi = dynamic_cast<video_stream_profile_interface*>(_source_stream_profile.get()->profile);
             if (!src_vspi)
                 throw std::runtime_error("Stream profile is not video stream profile");
 
-            auto tgt_vspi = dynamic_cast<video_stream_profile_interface*>(_target_stream_profile.get()->profile);
-            if (!tgt_vspi)
-                throw std::runtime_error("Stream profile is not video stream profile");
-
             rs2_intrinsics src_intrin   = src_vspi->get_intrinsics();
 
-            tgt_vspi->set_intrinsics([src_intrin]() { return src_intrin; });
-            tgt_vspi->set_dims(src_intrin.width, src_intrin.height);
+            output_profile_cache::key key(src_vspi, RS2_STREAM_DEPTH, 0, tgt_format, "disparity");
+            key.width = src_intrin.width;
+            key.height = src_intrin.height;
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(key,
+                [src_intrin](stream_profile_interface& p)
+                {
+                    auto tgt_vspi = dynamic_cast<video_stream_profile_interface*>(&p);
+                    if (!tgt_vspi)
+                        throw std::runtime_error("Stream profile is not video stream profile");
+                    tgt_vspi->set_intrinsics([src_intrin]() { return src_intrin; });
+                });
 
             _update_target = false;
         }
@@ -117,4 +152,62 @@ namespace librealsense
         return source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height), int(_width*_bpp),
             _transform_to_disparity ? RS2_EXTENSION_DISPARITY_FRAME :RS2_EXTENSION_DEPTH_FRAME);
     }
+
+    void disparity_transform::convert_pixels(const uint16_t* in, float* out, size_t count)
+    {
+        if (_disparity_lut.empty())
+            return convert_pixels<uint16_t, float>(in, out, count);
+
+        auto lut = _disparity_lut.data();
+        for (size_t i = 0; i < count; i++)
+            out[i] = lut[in[i]];
+    }
+
+    // A reciprocal estimate refined by a Newton step is not always the correctly rounded quotient, and a last bit
+    // off is enough to round some depths the other way, so this divides like the scalar code: only the branch on
+    // std::isnormal and the conversions are made vector.
+    void disparity_transform::convert_pixels(const float* in, uint16_t* out, size_t count)
+    {
+        size_t i = 0;
+#if defined(__SSSE3__)
+        const __m128 factor = _mm_set1_ps(_d2d_convert_factor);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128i exponent = _mm_set1_epi32(0x7F800000);
+        const __m128i zero = _mm_setzero_si128();
+        // The low 16 bits of each 32-bit integer, as the scalar conversion keeps them
+        const __m128i low_words = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i packed[2];
+            for (int k = 0; k < 2; k++)
+            {
+                __m128 x = _mm_loadu_ps(in + i + 4 * k);
+                __m128i e = _mm_and_si128(_mm_castps_si128(x), exponent);
+                __m128i normal = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi32(e, zero), _mm_cmpeq_epi32(e, exponent)),
+                                                  _mm_set1_epi32(-1));
+                __m128i depth = _mm_cvttps_epi32(_mm_add_ps(_mm_div_ps(factor, x), half));
+                packed[k] = _mm_shuffle_epi8(_mm_and_si128(depth, normal), low_words);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi64(packed[0], packed[1]));
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        const float32x4_t factor = vdupq_n_f32(_d2d_convert_factor);
+        const float32x4_t half = vdupq_n_f32(0.5f);
+        const uint32x4_t exponent = vdupq_n_u32(0x7F800000);
+        for (; i + 8 <= count; i += 8)
+        {
+            uint16x4_t packed[2];
+            for (int k = 0; k < 2; k++)
+            {
+                float32x4_t x = vld1q_f32(in + i + 4 * k);
+                uint32x4_t e = vandq_u32(vreinterpretq_u32_f32(x), exponent);
+                uint32x4_t normal = vmvnq_u32(vorrq_u32(vceqq_u32(e, vdupq_n_u32(0)), vceqq_u32(e, exponent)));
+                uint32x4_t depth = vcvtq_u32_f32(vaddq_f32(vdivq_f32(factor, x), half));
+                packed[k] = vmovn_u32(vandq_u32(depth, normal));
+            }
+            vst1q_u16(out + i, vcombine_u16(packed[0], packed[1]));
+        }
+#endif
+        convert_pixels<float, uint16_t>(in + i, out + i, count - i);
+    }
 }
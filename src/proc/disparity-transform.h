@@ -17,6 +17,9 @@ namespace librealsense
     class disparity_transform : public generic_processing_block
     {
     public:
+        // The CUDA implementation when there is one
+        static std::shared_ptr<disparity_transform> create(bool transform_to_disparity);
+
         disparity_transform(bool transform_to_disparity);
         bool should_process(const rs2::frame& frame) override;
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
@@ -26,31 +29,50 @@ namespace librealsense
 
         template<typename Tin, typename Tout>
         void convert(const void* in_data, void* out_data)
+        {
+            convert_rows<Tin, Tout>(in_data, out_data, 0, _height);
+        }
+
+        // convert() for rows [row_begin, row_end) of the frames only
+        template<typename Tin, typename Tout>
+        void convert_rows(const void* in_data, void* out_data, size_t row_begin, size_t row_end)
         {
             static_assert((std::is_arithmetic<Tin>::value), "disparity transform requires numeric type for input data");
             static_assert((std::is_arithmetic<Tout>::value), "disparity transform requires numeric type for output data");
 
-            auto in = reinterpret_cast<const Tin*>(in_data);
-            auto out = reinterpret_cast<Tout*>(out_data);
+            auto in = reinterpret_cast<const Tin*>(in_data) + row_begin * _width;
+            auto out = reinterpret_cast<Tout*>(out_data) + row_begin * _width;
+
+            convert_pixels(in, out, (row_end - row_begin) * _width);
+        }
 
+        template<typename Tin, typename Tout>
+        void convert_pixels(const Tin* in, Tout* out, size_t count)
+        {
             const bool fp = (std::is_floating_point<Tin>::value);
             const float round = fp ? 0.5f : 0.f;
 
             float input{};
-            //TODO SSE optimize
-            for (size_t i = 0; i < _height; i++)
-                for (size_t j = 0; j < _width; j++)
-                {
-                    input = *in;
-                    if (std::isnormal(input))
-                        *out++ = static_cast<Tout>((_d2d_convert_factor / input)+round);
-                    else
-                        *out++ = 0;
-                    in++;
-                }
+            for (size_t i = 0; i < count; i++)
+            {
+                input = *in;
+                if (std::isnormal(input))
+                    *out++ = static_cast<Tout>((_d2d_convert_factor / input)+round);
+                else
+                    *out++ = 0;
+                in++;
+            }
         }
 
+        // Depth to disparity: a lookup in _disparity_lut, with the scalar loop's values
+        void convert_pixels(const uint16_t* in, float* out, size_t count);
+        // Disparity to depth: vectorized division where there is SIMD, bit-exact with the scalar loop
+        void convert_pixels(const float* in, uint16_t* out, size_t count);
+
     private:
+        friend class depth_pipeline;
+        friend class disparity_transform_cuda;
+
         void    update_transformation_profile(const rs2::frame& f);
 
         void    on_set_mode(bool to_disparity);
@@ -62,6 +84,8 @@ namespace librealsense
         bool                    _stereoscopic_depth;
         float                   _stereo_baseline_meter; // in meters
         float                   _d2d_convert_factor;
+        std::vector<float>      _disparity_lut;             // The disparity of each 16-bit depth value
+        float                   _disparity_lut_factor;      // The _d2d_convert_factor of _disparity_lut
         size_t                  _width, _height;
         size_t                  _bpp;
     };
@@ -2,10 +2,12 @@
 // Copyright(c) 2023 Intel Corporation. All Rights Reserved.
 
 #include "proc/formats-converter.h"
+#include "proc/color-formats-converter.h"
 #include "stream.h"
 #include <src/composite-frame.h>
 #include <src/core/frame-callback.h>
 
+#include <algorithm>
 #include <ostream>
 
 namespace librealsense
@@ -31,11 +33,13 @@ void formats_converter::register_converters( const std::vector< processing_block
 
 void formats_converter::clear_registered_converters()
 {
+    _idle_converters.clear();
     _pb_factories.clear();
 }
 
 void formats_converter::drop_non_basic_formats()
 {
+    _idle_converters.clear();
     for( size_t i = 0; i < _pb_factories.size(); ++i )
     {
         const auto & source = _pb_factories[i]->get_source_info();
@@ -60,6 +64,8 @@ void formats_converter::drop_non_basic_formats()
 
         if( source[0].format == RS2_FORMAT_Y8I || source[0].format == RS2_FORMAT_Y12I )
             continue; // Convert interleaved formats.
+        if( source[0].format == RS2_FORMAT_Z16RVL || source[0].format == RS2_FORMAT_Z16_SPARSE )
+            continue; // Only compressed for the wire: there's nothing basic to show instead
 
         // Remove unwanted converters. Move to last element in vector and pop it out.
         if( i != ( _pb_factories.size() -1 ) )
@@ -247,7 +253,7 @@ void formats_converter::prepare_to_convert( stream_profiles from_profiles )
 
         // Retrieve source profile from cached map and generate the relevant processing block.
         std::unordered_set< std::shared_ptr< stream_profile_interface > > current_resolved_reqs;
-        auto best_pb = factory_of_best_match->generate();
+        auto best_pb = take_converter( factory_of_best_match, from_profiles_of_best_match );
         for( const auto & from_profile : from_profiles_of_best_match )
         {
             auto & mapped_raw_profiles = _target_profiles_to_raw_profiles[to_profile( from_profile.get() )];
@@ -266,6 +272,88 @@ void formats_converter::prepare_to_convert( stream_profiles from_profiles )
         const stream_profiles & print_current_resolved_reqs = { current_resolved_reqs.begin(), current_resolved_reqs.end() };
         LOG_INFO( "Request: " << from_profiles_of_best_match << "\nResolved to: " << print_current_resolved_reqs );
     }
+
+    fuse_converters();
+}
+
+std::shared_ptr< processing_block >
+formats_converter::take_converter( const std::shared_ptr< processing_block_factory > & factory,
+                                   const stream_profiles & from_profiles )
+{
+    // The requests' profiles are the sensor's, that stay the same: their ids tell the same configuration
+    converter_key key{ factory.get(), {} };
+    for( auto & profile : from_profiles )
+        key.second.push_back( profile->get_unique_id() );
+    std::sort( key.second.begin(), key.second.end() );
+
+    std::shared_ptr< processing_block > pb;
+    auto idle = _idle_converters.find( key );
+    if( idle != _idle_converters.end() )
+    {
+        pb = idle->second;
+        _idle_converters.erase( idle );
+    }
+    else
+    {
+        pb = factory->generate();
+        if( auto splitter = std::dynamic_pointer_cast< row_band_splitter >( pb ) )
+            splitter->set_thread_budget( _thread_budget );
+        if( auto interleaved = std::dynamic_pointer_cast< interleaved_functional_processing_block >( pb ) )
+            interleaved->set_lazy_conversion( _lazy_conversion );
+    }
+    _active_converter_keys[pb.get()] = std::move( key );
+    return pb;
+}
+
+void formats_converter::fuse_converters()
+{
+    // Each converter makes its own pass over the raw frame, so the color converters that share a raw profile are
+    // replaced by one that writes all their outputs in a single pass. Converters that also serve other raw profiles
+    // are left alone.
+    std::unordered_map< processing_block *, int > uses;
+    for( auto & entry : _raw_profile_to_converters )
+        for( auto & converter : entry.second )
+            ++uses[converter.get()];
+
+    for( auto & entry : _raw_profile_to_converters )
+    {
+        std::vector< std::shared_ptr< processing_block > > fusable;
+        std::vector< rs2_format > targets;
+        rs2_format source_order = RS2_FORMAT_ANY;
+        rs2_stream stream = RS2_STREAM_ANY;
+        for( auto & converter : entry.second )
+        {
+            if( uses[converter.get()] != 1 )
+                continue;
+            // Some cameras label UYVY as YUYV, so the byte order comes from the converter and not the profile
+            rs2_format order = RS2_FORMAT_ANY;
+            color_converter * cc = dynamic_cast< yuy2_converter * >( converter.get() );
+            if( cc )
+                order = RS2_FORMAT_YUYV;
+            else if( ( cc = dynamic_cast< uyvy_converter * >( converter.get() ) ) )
+                order = RS2_FORMAT_UYVY;
+            if( ! cc || ! can_fuse_color_conversion( order, cc->get_target_format() ) )
+                continue;
+            if( source_order == RS2_FORMAT_ANY )
+            {
+                source_order = order;
+                stream = cc->get_target_stream();
+            }
+            else if( order != source_order || cc->get_target_stream() != stream )
+                continue;
+            fusable.push_back( converter );
+            targets.push_back( cc->get_target_format() );
+        }
+        if( fusable.size() < 2 )
+            continue;
+
+        for( auto & converter : fusable )
+            entry.second.erase( converter );
+        auto fused_converter = std::make_shared< fused_color_converter >( source_order, targets, stream );
+        fused_converter->set_thread_budget( _thread_budget );
+        entry.second.insert( fused_converter );
+        LOG_DEBUG( "Fused " << fusable.size() << " converters from " << entry.first );
+    }
 }
 
 void formats_converter::update_target_profiles_data( const stream_profiles & from_profiles )
@@ -307,6 +395,24 @@ void formats_converter::cache_from_profiles( const stream_profiles & from_profil
 
 void formats_converter::clear_active_cache()
 {
+    // Frames of the converters may still be out there, not converted yet
+    for( auto & entry : _raw_profile_to_converters )
+        for( auto & converter : entry.second )
+            if( auto interleaved = dynamic_cast< interleaved_functional_processing_block * >( converter.get() ) )
+                interleaved->run_deferred();
+
+    // Kept for the next configuration (fused converters are made afresh, and not kept); the few modes a sensor is
+    // switched between are what's kept, not every one it ever had
+    if( _idle_converters.size() > 32 )
+        _idle_converters.clear();
+    for( auto & entry : _raw_profile_to_converters )
+        for( auto & converter : entry.second )
+        {
+            auto key = _active_converter_keys.find( converter.get() );
+            if( key != _active_converter_keys.end() )
+                _idle_converters[key->second] = converter;
+        }
+    _active_converter_keys.clear();
     _raw_profile_to_converters.clear();
     _format_mapping_to_from_profiles.clear();
 }
@@ -438,7 +544,7 @@ void formats_converter::convert_frame( frame_holder & f )
 
 std::shared_ptr< stream_profile_interface > formats_converter::find_cached_profile_for_frame( const frame_interface * f )
 {
-    const auto & iter = _format_mapping_to_from_profiles.find( f->get_stream()->get_format() );
+    const auto & iter = _format_mapping_to_from_profiles.find( f->peek_stream()->get_format() );
     if( iter == _format_mapping_to_from_profiles.end() )
         return nullptr;
 
@@ -446,8 +552,8 @@ std::shared_ptr< stream_profile_interface > formats_converter::find_cached_profi
     auto from_profile = std::find_if( begin( from_profiles ),
                                       end( from_profiles ),
                                       [&f]( const std::shared_ptr< stream_profile_interface > & prof ) {
-                                          return ( prof->get_stream_index() == f->get_stream()->get_stream_index() &&
-                                                   prof->get_stream_type() == f->get_stream()->get_stream_type() );
+                                          return ( prof->get_stream_index() == f->peek_stream()->get_stream_index() &&
+                                                   prof->get_stream_type() == f->peek_stream()->get_stream_type() );
                                       } );
 
     return from_profile != end( from_profiles ) ? *from_profile : nullptr;
@@ -5,6 +5,8 @@
 
 #include "processing-blocks-factory.h"
 
+#include <atomic>
+#include <map>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -22,6 +24,8 @@ namespace librealsense
     class formats_converter
     {
     public:
+        ~formats_converter() { clear_active_cache(); }
+
         void register_converter( const std::vector< stream_profile > & source,
                                         const std::vector< stream_profile > & target,
                                         std::function< std::shared_ptr< processing_block >( void ) > generate_func );
@@ -39,6 +43,15 @@ namespace librealsense
         stream_profiles get_active_source_profiles() const;
         std::vector< std::shared_ptr< processing_block > > get_active_converters() const;
 
+        // Threads each frame's conversion may be split across, by the converters that can (see row_band_splitter)
+        void set_thread_budget( int threads ) { *_thread_budget = threads; }
+        int get_thread_budget() const { return *_thread_budget; }
+
+        // Interleaved formats are converted when the data of a frame is first asked for, and not when it arrives
+        // (see interleaved_functional_processing_block::set_lazy_conversion)
+        void set_lazy_conversion( bool lazy ) { *_lazy_conversion = lazy; }
+        bool get_lazy_conversion() const { return *_lazy_conversion; }
+
         void set_frames_callback( rs2_frame_callback_sptr callback );
         rs2_frame_callback_sptr get_frames_callback() const { return _converted_frames_callback; }
         void convert_frame( frame_holder & f );
@@ -47,6 +60,7 @@ namespace librealsense
         void clear_active_cache();
         void update_target_profiles_data( const stream_profiles & from_profiles );
         void cache_from_profiles( const stream_profiles & from_profiles );
+        void fuse_converters();
 
         std::shared_ptr< stream_profile_interface > clone_profile( const std::shared_ptr< stream_profile_interface > & from_profile ) const;
         bool is_profile_in_list( const std::shared_ptr< stream_profile_interface > & profile, const stream_profiles & profiles ) const;
@@ -56,6 +70,11 @@ namespace librealsense
 
         std::shared_ptr< stream_profile_interface > find_cached_profile_for_frame( const frame_interface * f );
 
+        // A converter of the factory for these requests: the one an earlier prepare_to_convert made for the same,
+        // with the frame pool it already has, or a new one
+        std::shared_ptr< processing_block > take_converter( const std::shared_ptr< processing_block_factory > & factory,
+                                                            const stream_profiles & from_profiles );
+
         std::vector< std::shared_ptr< processing_block_factory > > _pb_factories;
         std::unordered_map< processing_block_factory *, stream_profiles > _pbf_supported_profiles;
         std::unordered_map< stream_profile, stream_profiles > _target_profiles_to_raw_profiles;
@@ -64,6 +83,14 @@ namespace librealsense
                             std::unordered_set< std::shared_ptr< processing_block > > > _raw_profile_to_converters;
         std::unordered_map< rs2_format, stream_profiles > _format_mapping_to_from_profiles;
 
+        // The converters of the last configurations, by factory and requests, so switching between modes doesn't
+        // make them (and their frame pools) anew each time
+        using converter_key = std::pair< processing_block_factory *, std::vector< int > >;
+        std::map< converter_key, std::shared_ptr< processing_block > > _idle_converters;
+        std::unordered_map< processing_block *, converter_key > _active_converter_keys;
+
         rs2_frame_callback_sptr _converted_frames_callback;
+        std::shared_ptr< std::atomic< int > > _thread_budget = std::make_shared< std::atomic< int > >( 1 );
+        std::shared_ptr< std::atomic< bool > > _lazy_conversion = std::make_shared< std::atomic< bool > >( false );
     };
 }
@@ -4,13 +4,34 @@
 #include "hdr-merge.h"
 #include <src/core/depth-frame.h>
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace librealsense
 {
+    // The number of threads the rows are split across
+    const uint8_t threads_min = 1;
+    const uint8_t threads_step = 1;
+    const uint8_t threads_def = 1;
+
     hdr_merge::hdr_merge()
         : generic_processing_block("HDR Merge"),
         _previous_depth_frame_counter(0),
-        _frames_without_requested_metadata_counter(0)
-    {}
+        _frames_without_requested_metadata_counter(0),
+        _framesets_count(0),
+        _threads(threads_def)
+    {
+        auto threads = std::make_shared<ptr_option<uint8_t>>(
+            threads_min,
+            uint8_t(std::min(processing_thread_pool::max_threads(), 255)),
+            threads_step,
+            threads_def,
+            &_threads, "Number of threads to split the merge across");
+        register_option(RS2_OPTION_FILTER_THREADS, threads);
+    }
 
     // processing only framesets
     bool hdr_merge::should_process(const rs2::frame& frame)
@@ -83,21 +104,21 @@ namespace librealsense
         // saving frame of sequence id 0
         // so that the merging with be deterministic - always done with frame n and n+1
         // with frame n as basis
-        if (_framesets.size() == depth_seq_id)
+        if (_framesets_count == depth_seq_id)
         {
-            _framesets[(int)depth_seq_id] = fs;
+            _framesets[_framesets_count++] = fs;
         }
 
         // discard merged frame if not relevant
         discard_depth_merged_frame_if_needed(depth_frame);
 
         // 3. check if size of this vector is at least 2 (if not - return latest merge frame)
-        if (_framesets.size() >= 2)
+        if (_framesets_count >= 2)
         {
             // 4. pop out both framesets from the vector
-            rs2::frameset fs_0 = _framesets[0];
-            rs2::frameset fs_1 = _framesets[1];
-            _framesets.clear();
+            rs2::frameset fs_0 = std::move(_framesets[0]);
+            rs2::frameset fs_1 = std::move(_framesets[1]);
+            _framesets_count = 0;
 
             bool use_ir = false;
             if (check_frames_mergeability(fs_0, fs_1, use_ir))
@@ -170,7 +191,7 @@ namespace librealsense
         return true;
     }
 
-    rs2::frame hdr_merge::merging_algorithm(const rs2::frame_source& source, const rs2::frameset first_fs, const rs2::frameset second_fs, const bool use_ir) const
+    rs2::frame hdr_merge::merging_algorithm(const rs2::frame_source& source, const rs2::frameset first_fs, const rs2::frameset second_fs, const bool use_ir)
     {
         auto first = first_fs;
         auto second = second_fs;
@@ -204,28 +225,24 @@ namespace librealsense
 
             ptr->set_sensor(orig->get_sensor());
 
-            memset(new_data, 0, width * height * sizeof(uint16_t));
-
-            int width_height_product = width * height;
-
             if (use_ir)
             {
                 if (first_ir.get_profile().format() == RS2_FORMAT_Y8)
                 {
-                    merge_frames_using_ir<uint8_t>(new_data, d0, d1, first_ir, second_ir, width_height_product);
+                    merge_frames_using_ir<uint8_t>(new_data, d0, d1, first_ir, second_ir, width, height);
                 }
                 else if (first_ir.get_profile().format() == RS2_FORMAT_Y16)
                 {
-                    merge_frames_using_ir<uint16_t>(new_data, d0, d1, first_ir, second_ir, width_height_product);
+                    merge_frames_using_ir<uint16_t>(new_data, d0, d1, first_ir, second_ir, width, height);
                 }
                 else
                 {
-                    merge_frames_using_only_depth(new_data, d0, d1, width_height_product);
+                    merge_frames_using_only_depth(new_data, d0, d1, width, height);
                 }
             }
             else
             {
-                merge_frames_using_only_depth(new_data, d0, d1, width_height_product);
+                merge_frames_using_only_depth(new_data, d0, d1, width, height);
             }
 
             return new_f;
@@ -233,17 +250,149 @@ namespace librealsense
         return first_fs;
     }
 
-    void hdr_merge::merge_frames_using_only_depth(uint16_t* new_data, uint16_t* d0, uint16_t* d1, int width_height_prod) const
+    void hdr_merge::merge_frames_using_only_depth(uint16_t* new_data, uint16_t* d0, uint16_t* d1, int width, int height)
     {
-        for (int i = 0; i < width_height_prod; i++)
+        for_each_band(height, [&](size_t begin, size_t end)
         {
-            if (d0[i])
-                new_data[i] = d0[i];
-            else if (d1[i])
-                new_data[i] = d1[i];
-            else
-                new_data[i] = 0;
+            const size_t first = begin * width;
+            const size_t count = (end - begin) * width;
+            for (size_t i = first + merge_pixels_using_only_depth_simd(new_data + first, d0 + first, d1 + first, count);
+                 i < first + count; i++)
+            {
+                if (d0[i])
+                    new_data[i] = d0[i];
+                else if (d1[i])
+                    new_data[i] = d1[i];
+                else
+                    new_data[i] = 0;
+            }
+        });
+    }
+
+    void hdr_merge::for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn)
+    {
+        if (_threads <= 1)
+        {
+            fn(0, count);
+            return;
+        }
+        if (!_thread_pool)
+            _thread_pool = processing_thread_pool::instance();
+        _thread_pool->parallel_for(count, _threads, fn);
+    }
+
+#if defined(__SSSE3__)
+    // 0xFFFF where lo <= v < hi, for 16-bit v: an unsigned range check, done as a signed one with the sign bit flipped
+    static inline __m128i sse_in_range(__m128i v, uint16_t lo, uint16_t hi)
+    {
+        const __m128i sign = _mm_set1_epi16(short(0x8000));
+        __m128i offset = _mm_xor_si128(_mm_sub_epi16(v, _mm_set1_epi16(short(lo))), sign);
+        return _mm_cmplt_epi16(offset, _mm_xor_si128(_mm_set1_epi16(short(hi - lo)), sign));
+    }
+
+    // d0 where m0 and d0 are set, else d1 where m1 and d1 are set, else 0, as in the scalar loops
+    static inline __m128i sse_merge(__m128i d0, __m128i d1, __m128i m0, __m128i m1)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        m0 = _mm_andnot_si128(_mm_cmpeq_epi16(d0, zero), m0);
+        m1 = _mm_andnot_si128(m0, m1);
+        return _mm_or_si128(_mm_and_si128(m0, d0), _mm_and_si128(m1, d1));
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    static inline uint16x8_t neon_in_range(uint16x8_t v, uint16_t lo, uint16_t hi)
+    {
+        return vandq_u16(vcgeq_u16(v, vdupq_n_u16(lo)), vcltq_u16(v, vdupq_n_u16(hi)));
+    }
+
+    static inline uint16x8_t neon_merge(uint16x8_t d0, uint16x8_t d1, uint16x8_t m0, uint16x8_t m1)
+    {
+        m0 = vandq_u16(m0, vtstq_u16(d0, d0));
+        return vbslq_u16(m0, d0, vandq_u16(m1, d1));
+    }
+#endif
+
+    size_t hdr_merge::merge_pixels_using_ir_simd(uint16_t* new_data, const uint16_t* d0, const uint16_t* d1,
+        const uint8_t* i0, const uint8_t* i1, size_t count) const
+    {
+        const size_t n = count & ~size_t(7);
+        const uint16_t lo = uint16_t(IR_UNDER_SATURATED_VALUE_Y8 + 1), hi = uint16_t(IR_OVER_SATURATED_VALUE_Y8);
+#if defined(__SSSE3__)
+        const __m128i zero = _mm_setzero_si128();
+        for (size_t i = 0; i < n; i += 8)
+        {
+            __m128i ir0 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(i0 + i)), zero);
+            __m128i ir1 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(i1 + i)), zero);
+            __m128i merged = sse_merge(_mm_loadu_si128(reinterpret_cast<const __m128i*>(d0 + i)),
+                                       _mm_loadu_si128(reinterpret_cast<const __m128i*>(d1 + i)),
+                                       sse_in_range(ir0, lo, hi), sse_in_range(ir1, lo, hi));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(new_data + i), merged);
+        }
+        return n;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        for (size_t i = 0; i < n; i += 8)
+        {
+            uint16x8_t merged = neon_merge(vld1q_u16(d0 + i), vld1q_u16(d1 + i),
+                                           neon_in_range(vmovl_u8(vld1_u8(i0 + i)), lo, hi),
+                                           neon_in_range(vmovl_u8(vld1_u8(i1 + i)), lo, hi));
+            vst1q_u16(new_data + i, merged);
+        }
+        return n;
+#else
+        return 0;
+#endif
+    }
+
+    size_t hdr_merge::merge_pixels_using_ir_simd(uint16_t* new_data, const uint16_t* d0, const uint16_t* d1,
+        const uint16_t* i0, const uint16_t* i1, size_t count) const
+    {
+        const size_t n = count & ~size_t(7);
+        const uint16_t lo = uint16_t(IR_UNDER_SATURATED_VALUE_Y16 + 1), hi = uint16_t(IR_OVER_SATURATED_VALUE_Y16);
+#if defined(__SSSE3__)
+        for (size_t i = 0; i < n; i += 8)
+        {
+            __m128i ir0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i0 + i));
+            __m128i ir1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i1 + i));
+            __m128i merged = sse_merge(_mm_loadu_si128(reinterpret_cast<const __m128i*>(d0 + i)),
+                                       _mm_loadu_si128(reinterpret_cast<const __m128i*>(d1 + i)),
+                                       sse_in_range(ir0, lo, hi), sse_in_range(ir1, lo, hi));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(new_data + i), merged);
+        }
+        return n;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        for (size_t i = 0; i < n; i += 8)
+        {
+            uint16x8_t merged = neon_merge(vld1q_u16(d0 + i), vld1q_u16(d1 + i),
+                                           neon_in_range(vld1q_u16(i0 + i), lo, hi),
+                                           neon_in_range(vld1q_u16(i1 + i), lo, hi));
+            vst1q_u16(new_data + i, merged);
+        }
+        return n;
+#else
+        return 0;
+#endif
+    }
+
+    size_t hdr_merge::merge_pixels_using_only_depth_simd(uint16_t* new_data, const uint16_t* d0, const uint16_t* d1,
+        size_t count) const
+    {
+        const size_t n = count & ~size_t(7);
+#if defined(__SSSE3__)
+        const __m128i all = _mm_set1_epi16(-1);
+        for (size_t i = 0; i < n; i += 8)
+        {
+            __m128i merged = sse_merge(_mm_loadu_si128(reinterpret_cast<const __m128i*>(d0 + i)),
+                                       _mm_loadu_si128(reinterpret_cast<const __m128i*>(d1 + i)), all, all);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(new_data + i), merged);
         }
+        return n;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        const uint16x8_t all = vdupq_n_u16(0xFFFF);
+        for (size_t i = 0; i < n; i += 8)
+            vst1q_u16(new_data + i, neon_merge(vld1q_u16(d0 + i), vld1q_u16(d1 + i), all, all));
+        return n;
+#else
+        return 0;
+#endif
     }
 
     bool hdr_merge::should_ir_be_used_for_merging(const rs2::depth_frame& first_depth, const rs2::video_frame& first_ir,
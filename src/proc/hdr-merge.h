@@ -6,6 +6,9 @@ Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
 
 #include "synthetic-stream.h"
 #include "option.h"
+#include "processing-thread-pool.h"
+
+#include <array>
 
 namespace librealsense
 {
@@ -37,39 +40,61 @@ namespace librealsense
         bool should_ir_be_used_for_merging(const rs2::depth_frame& first_depth, const rs2::video_frame& first_ir,
             const rs2::depth_frame& second_depth, const rs2::video_frame& second_ir) const;
         rs2::frame merging_algorithm(const rs2::frame_source& source, const rs2::frameset first_fs,
-            const rs2::frameset second_fs, const bool use_ir) const;
+            const rs2::frameset second_fs, const bool use_ir);
         template <typename T>
         bool is_infrared_valid(T ir_value, rs2_format ir_format) const;
         template <typename T>
         void merge_frames_using_ir(uint16_t* new_data, uint16_t* d0, uint16_t* d1,
-            const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width_height_prod) const;
-        void merge_frames_using_only_depth(uint16_t* new_data, uint16_t* d0, uint16_t* d1, int width_height_prod) const;
+            const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width, int height);
+        void merge_frames_using_only_depth(uint16_t* new_data, uint16_t* d0, uint16_t* d1, int width, int height);
+
+        // Vectorized merges of the first pixels of 'count', from the start. Return the number of pixels merged:
+        // 0 when there's no SIMD implementation for the platform.
+        size_t merge_pixels_using_ir_simd(uint16_t* new_data, const uint16_t* d0, const uint16_t* d1,
+            const uint8_t* i0, const uint8_t* i1, size_t count) const;
+        size_t merge_pixels_using_ir_simd(uint16_t* new_data, const uint16_t* d0, const uint16_t* d1,
+            const uint16_t* i0, const uint16_t* i1, size_t count) const;
+        size_t merge_pixels_using_only_depth_simd(uint16_t* new_data, const uint16_t* d0, const uint16_t* d1,
+            size_t count) const;
+
+        // Pixels are merged independently, so the frame is split into bands of rows across threads
+        void for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn);
 
         unsigned long long _previous_depth_frame_counter;
         int _frames_without_requested_metadata_counter;
-        std::map<int, rs2::frameset> _framesets;
+        std::array<rs2::frameset, 2> _framesets;    // The framesets of sequence ids 0 and 1, in order
+        size_t _framesets_count;                    // How many of _framesets are set
         rs2::frame _depth_merged_frame;
+        uint8_t _threads;
+        std::shared_ptr<processing_thread_pool> _thread_pool;
     };
     MAP_EXTENSION(RS2_EXTENSION_HDR_MERGE, librealsense::hdr_merge);
 
     template <typename T>
     void hdr_merge::merge_frames_using_ir(uint16_t* new_data, uint16_t* d0, uint16_t* d1,
-        const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width_height_prod) const
+        const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width, int height)
     {
         auto i0 = (T*)first_ir.get_data();
         auto i1 = (T*)second_ir.get_data();
 
         auto format = first_ir.get_profile().format();
 
-        for (int i = 0; i < width_height_prod; i++)
+        for_each_band(height, [&](size_t begin, size_t end)
         {
-            if (is_infrared_valid<T>(i0[i], format) && d0[i])
-                new_data[i] = d0[i];
-            else if (is_infrared_valid<T>(i1[i], format) && d1[i])
-                new_data[i] = d1[i];
-            else
-                new_data[i] = 0;
-        }
+            const size_t first = begin * width;
+            const size_t count = (end - begin) * width;
+            for (size_t i = first + merge_pixels_using_ir_simd(new_data + first, d0 + first, d1 + first,
+                                                               i0 + first, i1 + first, count);
+                 i < first + count; i++)
+            {
+                if (is_infrared_valid<T>(i0[i], format) && d0[i])
+                    new_data[i] = d0[i];
+                else if (is_infrared_valid<T>(i1[i], format) && d1[i])
+                    new_data[i] = d1[i];
+                else
+                    new_data[i] = 0;
+            }
+        });
     }
 
     template <typename T>
@@ -9,9 +9,19 @@
 #include "software-device.h"
 #include "proc/synthetic-stream.h"
 #include "proc/hole-filling-filter.h"
+#include "proc/output-profile-cache.h"
+
+#ifdef RS2_USE_CUDA
+#include "proc/cuda/cuda-depth-filters.h"
+#endif
 
 #include <rsutils/string/from.h>
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace librealsense
 {
@@ -21,12 +31,27 @@ namespace librealsense
     const uint8_t hole_fill_step = 1;
     const uint8_t hole_fill_def = hf_farest_from_around;
 
+    // The number of threads the rows are split across
+    const uint8_t threads_min = 1;
+    const uint8_t threads_step = 1;
+    const uint8_t threads_def = 1;
+
+    std::shared_ptr<hole_filling_filter> hole_filling_filter::create()
+    {
+        #ifdef RS2_USE_CUDA
+            return std::make_shared<librealsense::hole_filling_filter_cuda>();
+        #else
+            return std::make_shared<librealsense::hole_filling_filter>();
+        #endif
+    }
+
     hole_filling_filter::hole_filling_filter() :
         depth_processing_block("Hole Filling Filter"),
         _width(0), _height(0), _stride(0), _bpp(0),
         _extension_type(RS2_EXTENSION_DEPTH_FRAME),
         _current_frm_size_pixels(0),
-        _hole_filling_mode(hole_fill_def)
+        _hole_filling_mode(hole_fill_def),
+        _threads(threads_def)
     {
         _stream_filter.stream = RS2_STREAM_DEPTH;
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -58,19 +83,42 @@ namespace librealsense
         });
 
         register_option(RS2_OPTION_HOLES_FILL, hole_filling_mode);
+
+        auto threads = std::make_shared<ptr_option<uint8_t>>(
+            threads_min,
+            uint8_t(std::min(processing_thread_pool::max_threads(), 255)),
+            threads_step,
+            threads_def,
+            &_threads, "Number of threads to split the hole filling across (fill from left only)");
+        register_option(RS2_OPTION_FILTER_THREADS, threads);
+
+        register_roi_options();
     }
 
     rs2::frame hole_filling_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
     {
         update_configuration(f);
-        auto tgt = prepare_target_frame(f, source);
+        auto roi = get_roi(f, int(_width), int(_height));
+        auto tgt = prepare_target_frame(f, source, roi);
+
+        // With a region of interest, the holes are filled in a compact copy of it
+        const bool full = is_full_roi(roi, int(_width), int(_height));
+        void* data = full ? const_cast<void*>(tgt.get_data()) : _roi_image.data();
+        size_t width = full ? _width : roi_width(roi);
+        size_t height = full ? _height : roi_height(roi);
 
         // Hole filling pass
-        if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
-            apply_hole_filling<float>(const_cast<void*>(tgt.get_data()));
-        else
-            apply_hole_filling<uint16_t>(const_cast<void*>(tgt.get_data()));
+        if (width && height)
+        {
+            if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
+                apply_hole_filling<float>(data, width, height);
+            else
+                apply_hole_filling<uint16_t>(data, width, height);
+        }
 
+        if (!full)
+            insert_roi(const_cast<void*>(tgt.get_data()), data, int(_width), int(_height), int(_bpp), roi);
+        set_roi(tgt, roi, int(_width), int(_height));
         return tgt;
     }
 
@@ -79,7 +127,8 @@ namespace librealsense
         if (f.get_profile().get() != _source_stream_profile.get())
         {
             _source_stream_profile = f.get_profile();
-            _target_stream_profile = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(
+                _source_stream_profile, RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
 
             _extension_type = f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
             _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
@@ -92,13 +141,77 @@ namespace librealsense
         }
     }
 
-    rs2::frame hole_filling_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source)
+    rs2::frame hole_filling_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source, const region_of_interest& roi)
     {
-        // Allocate and copy the content of the input data to the target
+        // Allocate and copy the content of the input data to the target, or only the region of interest aside
         rs2::frame tgt = source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height), int(_stride), _extension_type);
 
-        memmove(const_cast<void*>(tgt.get_data()), f.get_data(), _current_frm_size_pixels * _bpp);
+        if (is_full_roi(roi, int(_width), int(_height)))
+            memmove(const_cast<void*>(tgt.get_data()), f.get_data(), _current_frm_size_pixels * _bpp);
+        else
+        {
+            _roi_image.resize(size_t(roi_width(roi)) * roi_height(roi) * _bpp);
+            extract_roi(_roi_image.data(), f.get_data(), int(_width), int(_bpp), roi);
+        }
         return tgt;
     }
 
+    void hole_filling_filter::for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn)
+    {
+        if (_threads <= 1)
+        {
+            fn(0, count);
+            return;
+        }
+        if (!_thread_pool)
+            _thread_pool = processing_thread_pool::instance();
+        _thread_pool->parallel_for(count, _threads, fn);
+    }
+
+    size_t hole_filling_filter::next_hole(const uint16_t* row, size_t i, size_t width)
+    {
+        // Skip 8 pixels at a time while there's no hole among them; the scalar loop finds which one it is
+#if defined(__SSSE3__)
+        for (; i + 8 <= width; i += 8)
+        {
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(px, _mm_setzero_si128())))
+                break;
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        for (; i + 8 <= width; i += 8)
+        {
+            if (vminvq_u16(vld1q_u16(row + i)) == 0)
+                break;
+        }
+#endif
+        for (; i < width; ++i)
+            if (empty(row + i))
+                return i;
+        return width;
+    }
+
+    size_t hole_filling_filter::next_hole(const float* row, size_t i, size_t width)
+    {
+        // Holes are all-zero bit patterns, so compare the bits rather than the floats
+#if defined(__SSSE3__)
+        for (; i + 4 <= width; i += 4)
+        {
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(px, _mm_setzero_si128())))
+                break;
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        for (; i + 4 <= width; i += 4)
+        {
+            if (vminvq_u32(vld1q_u32(reinterpret_cast<const uint32_t*>(row + i))) == 0)
+                break;
+        }
+#endif
+        for (; i < width; ++i)
+            if (empty(row + i))
+                return i;
+        return width;
+    }
+
 }
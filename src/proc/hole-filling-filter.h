@@ -3,6 +3,8 @@
 // Enhancing the input video frame by filling missing data.
 #pragma once
 
+#include "processing-thread-pool.h"
+
 #include <rsutils/string/from.h>
 
 namespace librealsense
@@ -18,31 +20,41 @@ namespace librealsense
     class hole_filling_filter : public depth_processing_block
     {
     public:
+        // The CUDA implementation when there is one
+        static std::shared_ptr<hole_filling_filter> create();
+
         hole_filling_filter();
 
     protected:
         void update_configuration(const rs2::frame& f);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
-        rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
+        rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source, const region_of_interest& roi);
+
+        template<typename T>
+        void apply_hole_filling(void * image_data, size_t width, size_t height)
+        {
+            apply_hole_filling_rows<T>(image_data, width, height, 0, height);
+        }
 
+        // Fills the holes of rows [row_begin, row_end) only. The rows above are expected to be filled already, as
+        // the "around" methods look at them.
         template<typename T>
-        void apply_hole_filling(void * image_data)
+        void apply_hole_filling_rows(void * image_data, size_t width, size_t height, size_t row_begin, size_t row_end)
         {
-            bool fp = (std::is_floating_point<T>::value);
             T* data = reinterpret_cast<T*>(image_data);
 
             // Select and apply the appropriate hole filling method
             switch (_hole_filling_mode)
             {
             case hf_fill_from_left:
-                holes_fill_left(data, _width, _height, _stride);
+                holes_fill_left(data, width, row_begin, row_end);
                 break;
             case hf_farest_from_around:
-                holes_fill_farest(data, _width, _height, _stride);
+                holes_fill_farest(data, width, height, row_begin, row_end);
                 break;
             case hf_nearest_from_around:
-                holes_fill_nearest(data, _width, _height, _stride);
+                holes_fill_nearest(data, width, height, row_begin, row_end);
                 break;
             default:
                 throw invalid_value_exception( rsutils::string::from() << "Unsupported hole filling mode: "
@@ -51,114 +63,107 @@ namespace librealsense
         }
 
         // Implementations of the hole-filling methods
-        template<typename T>
-        inline void holes_fill_left(T* image_data, size_t width, size_t height, size_t stride)
-        {
-            std::function<bool(T*)> fp_oper = [](T* ptr) { return !*((int *)ptr); };
-            std::function<bool(T*)> uint_oper = [](T* ptr) { return !(*ptr); };
-            auto empty = (std::is_floating_point<T>::value) ? fp_oper : uint_oper;
+        // A pixel is a hole when it is all zero bits (so -0.f is not disparity hole, same as before)
+        static inline bool empty(const uint16_t* p) { return !*p; }
+        static inline bool empty(const float* p) { return !*reinterpret_cast<const int32_t*>(p); }
 
-            T* p = image_data;
+        // The index of the first hole in row[i, width), or width when there's none. Vectorized, since most of the
+        // pixels are usually not holes.
+        static size_t next_hole(const uint16_t* row, size_t i, size_t width);
+        static size_t next_hole(const float* row, size_t i, size_t width);
 
-            for (size_t j = 0; j < height; ++j)
+        // Rows are independent, so the frame is split into bands of rows across threads
+        template<typename T>
+        inline void holes_fill_left(T* image_data, size_t width, size_t row_begin, size_t row_end)
+        {
+            for_each_band(row_end - row_begin, [&](size_t begin, size_t end)
             {
-                ++p;
-                for (size_t i = 1; i < width; ++i)
+                for (size_t j = row_begin + begin; j < row_begin + end; ++j)
                 {
-                    if (empty(p))
-                        *p = *(p - 1);
-                    ++p;
+                    T* row = image_data + j * width;
+                    for (size_t i = next_hole(row, 1, width); i < width; i = next_hole(row, i, width))
+                    {
+                        // Fill the whole run of holes from its left
+                        for (; i < width && empty(row + i); ++i)
+                            row[i] = row[i - 1];
+                    }
                 }
-            }
+            });
         }
 
+        // The "around" methods fill in place, and each hole looks at the row above as already filled: the output
+        // depends on the order rows are done in, so these stay on one thread.
         template<typename T>
-        inline void holes_fill_farest(T* image_data, size_t width, size_t height, size_t stride)
+        inline void holes_fill_farest(T* image_data, size_t width, size_t height, size_t row_begin, size_t row_end)
         {
-            std::function<bool(T*)> fp_oper = [](T* ptr) { return !*((int *)ptr); };
-            std::function<bool(T*)> uint_oper = [](T* ptr) { return !(*ptr); };
-            auto empty = (std::is_floating_point<T>::value) ? fp_oper : uint_oper;
-
-            T tmp = 0;
-            T * p = image_data + width;
-            T * q = nullptr;
-            for (int j = 1; j < height - 1; ++j)
+            for (size_t j = std::max<size_t>(row_begin, 1); j + 1 < height && j < row_end; ++j)
             {
-                ++p;
-                for (size_t i = 1; i < width; ++i)
+                T* row = image_data + j * width;
+                for (size_t i = next_hole(row, 1, width); i < width; i = next_hole(row, i + 1, width))
                 {
-                    if (empty(p))
-                    {
-                        tmp = *(p - width);
-
-                        q = p - width - 1;
-                        if (*q > tmp)
-                            tmp = *q;
+                    T* p = row + i;
+                    T tmp = *(p - width);
+                    T * q = nullptr;
 
-                        q = p - 1;
-                        if (*q > tmp)
-                            tmp = *q;
+                    q = p - width - 1;
+                    if (*q > tmp)
+                        tmp = *q;
 
-                        q = p + width - 1;
-                        if (*q > tmp)
-                            tmp = *q;
+                    q = p - 1;
+                    if (*q > tmp)
+                        tmp = *q;
 
-                        q = p + width;
-                        if (*q > tmp)
-                            tmp = *q;
+                    q = p + width - 1;
+                    if (*q > tmp)
+                        tmp = *q;
 
-                        *p = tmp;
-                    }
+                    q = p + width;
+                    if (*q > tmp)
+                        tmp = *q;
 
-                    p++;
+                    *p = tmp;
                 }
             }
         }
 
         template<typename T>
-        inline void holes_fill_nearest(T* image_data, size_t width, size_t height, size_t stride)
+        inline void holes_fill_nearest(T* image_data, size_t width, size_t height, size_t row_begin, size_t row_end)
         {
-            std::function<bool(T*)> fp_oper = [](T* ptr) { return !*((int *)ptr); };
-            std::function<bool(T*)> uint_oper = [](T* ptr) { return !(*ptr); };
-            auto empty = (std::is_floating_point<T>::value) ? fp_oper : uint_oper;
-
-            T tmp = 0;
-            T * p = image_data + width;
-            T * q = nullptr;
-            for (int j = 1; j < height - 1; ++j)
+            for (size_t j = std::max<size_t>(row_begin, 1); j + 1 < height && j < row_end; ++j)
             {
-                ++p;
-                for (size_t i = 1; i < width; ++i)
+                T* row = image_data + j * width;
+                for (size_t i = next_hole(row, 1, width); i < width; i = next_hole(row, i + 1, width))
                 {
-                    if (empty(p))
-                    {
-                        tmp = *(p - width);
+                    T* p = row + i;
+                    T tmp = *(p - width);
+                    T * q = nullptr;
 
-                        q = p - width - 1;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
+                    q = p - width - 1;
+                    if (!empty(q) && (*q < tmp))
+                        tmp = *q;
 
-                        q = p - 1;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
+                    q = p - 1;
+                    if (!empty(q) && (*q < tmp))
+                        tmp = *q;
 
-                        q = p + width - 1;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
+                    q = p + width - 1;
+                    if (!empty(q) && (*q < tmp))
+                        tmp = *q;
 
-                        q = p + width;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
+                    q = p + width;
+                    if (!empty(q) && (*q < tmp))
+                        tmp = *q;
 
-                        *p = tmp;
-                    }
-
-                    p++;
+                    *p = tmp;
                 }
             }
         }
 
+        void for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn);
+
     private:
+        friend class depth_pipeline;
+        friend class hole_filling_filter_cuda;
 
         size_t                  _width, _height, _stride;
         size_t                  _bpp;
@@ -167,6 +172,9 @@ namespace librealsense
         rs2::stream_profile     _source_stream_profile;
         rs2::stream_profile     _target_stream_profile;
         uint8_t                 _hole_filling_mode;
+        uint8_t                 _threads;                   // Rows are split across this many threads, when possible
+        std::shared_ptr<processing_thread_pool> _thread_pool;
+        std::vector<uint8_t>    _roi_image;                 // The region of interest, when there's one
     };
     MAP_EXTENSION(RS2_EXTENSION_HOLE_FILLING_FILTER, librealsense::hole_filling_filter);
 }
@@ -6,6 +6,7 @@
 #include "synthetic-stream.h"
 #include "motion-transform.h"
 #include "stream.h"
+#include <src/motion-history.h>
 #include <src/platform/hid-data.h>
 #include <src/core/frame-processor-callback.h>
 
@@ -99,6 +100,16 @@ namespace librealsense
         {
             _imu2depth_cs_alignment_matrix = { {1,0,0},{0,1,0}, {0,0,1} };
         }
+
+        // Composed once here, so that each sample takes a single matrix multiply
+        _aligned = { _imu2depth_cs_alignment_matrix, float3{ 0, 0, 0 } };
+        if (mm_calib && _mm_correct_opt)
+        {
+            _accel_corrected = { _accel_sensitivity * _imu2depth_cs_alignment_matrix, float3{ 0, 0, 0 } - _accel_bias };
+            _gyro_corrected = { _gyro_sensitivity * _imu2depth_cs_alignment_matrix, float3{ 0, 0, 0 } - _gyro_bias };
+        }
+        else
+            _accel_corrected = _gyro_corrected = _aligned;
     }
 
     rs2::frame motion_transform::process_frame(const rs2::frame_source& source, const rs2::frame& f)
@@ -111,28 +122,37 @@ namespace librealsense
 
     void motion_transform::correct_motion_helper(float3* xyz, rs2_stream stream_type) const
     {
-        // The IMU sensor orientation shall be aligned with depth sensor's coordinate system
-        *xyz = _imu2depth_cs_alignment_matrix * (*xyz);
-
+        // The IMU sensor orientation shall be aligned with depth sensor's coordinate system.
         // IMU calibration is done with data in depth sensor's coordinate system, so calibration parameters should be applied for motion correction
-        // in the same coordinate system
-        if (_mm_correct_opt)
+        // in the same coordinate system; both are in the one transform.
+        auto t = &_aligned;
+        if (_mm_correct_opt && _mm_correct_opt->query() > 0.f) // TBD resolve duality of is_enabled/is_active
         {
-            if ((_mm_correct_opt->query() > 0.f)) // TBD resolve duality of is_enabled/is_active
-            {
-                if (stream_type == RS2_STREAM_ACCEL)
-                    *xyz = (_accel_sensitivity * (*xyz)) - _accel_bias;
-
-                if (stream_type == RS2_STREAM_GYRO)
-                    *xyz = _gyro_sensitivity * (*xyz) - _gyro_bias;
-            }
+            if (stream_type == RS2_STREAM_ACCEL)
+                t = &_accel_corrected;
+            else if (stream_type == RS2_STREAM_GYRO)
+                t = &_gyro_corrected;
         }
+        *xyz = t->m * (*xyz) + t->offset;
     }
     void motion_transform::correct_motion(rs2::frame* f) const
     {
         auto xyz = (float3*)(f->get_data());
 
-        correct_motion_helper(xyz, f->get_profile().stream_type());
+        // Accel and gyro transforms know their stream; only a generic one has to look at the frame's profile
+        auto stream_type = (_target_stream == RS2_STREAM_ACCEL || _target_stream == RS2_STREAM_GYRO)
+                               ? _target_stream
+                               : f->get_profile().stream_type();
+        correct_motion_helper(xyz, stream_type);
+        add_to_history(stream_type, (const frame_interface*)f->get(), *xyz);
+    }
+
+    void motion_transform::add_to_history(rs2_stream stream, const frame_interface* f, const float3& xyz) const
+    {
+        if (!_history || (stream != RS2_STREAM_ACCEL && stream != RS2_STREAM_GYRO))
+            return;
+        const float values[3] = { xyz.x, xyz.y, xyz.z };
+        _history->add(stream, f->get_frame_timestamp(), f->get_frame_timestamp_domain(), values);
     }
 
     void motion_to_accel_gyro::correct_motion(float3* xyz) const
@@ -201,6 +221,7 @@ namespace librealsense
 
             // correct the axes values according to the device's data
             correct_motion((float3*)(frame_data[0]));
+            add_to_history(_accel_gyro_target_profile->get_stream_type(), agf.frame, *(float3*)(frame_data[0]));
 
             source->frame_ready(std::move(agf));
         };
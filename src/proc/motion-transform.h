@@ -9,6 +9,7 @@ namespace librealsense
     class enable_motion_correction;
     class mm_calib_handler;
     class functional_processing_block;
+    class motion_history;
 
     class motion_transform : public functional_processing_block
     {
@@ -17,6 +18,9 @@ namespace librealsense
             std::shared_ptr<mm_calib_handler> mm_calib = nullptr,
             std::shared_ptr<enable_motion_correction> mm_correct_opt = nullptr);
 
+        // Where the samples go as they're delivered, if anywhere
+        void set_motion_history(std::shared_ptr<motion_history> history) { _history = std::move(history); }
+
     protected:
         motion_transform(const char* name, rs2_format target_format, rs2_stream target_stream,
             std::shared_ptr<mm_calib_handler> mm_calib,
@@ -26,13 +30,26 @@ namespace librealsense
     protected:
         void correct_motion(rs2::frame* f) const;
         void correct_motion_helper(float3* xyz, rs2_stream stream_type) const;
+        void add_to_history(rs2_stream stream, const frame_interface* f, const float3& xyz) const;
+
+        // The axis alignment, and the calibration while motion correction is on, as a single affine transform:
+        // sensitivity * (alignment * xyz) - bias = (sensitivity * alignment) * xyz - bias
+        struct affine_transform
+        {
+            float3x3 m;
+            float3 offset;
+        };
 
         std::shared_ptr<enable_motion_correction> _mm_correct_opt = nullptr;
+        std::shared_ptr<motion_history> _history;
         float3x3            _accel_sensitivity;
         float3              _accel_bias;
         float3x3            _gyro_sensitivity;
         float3              _gyro_bias;
         float3x3            _imu2depth_cs_alignment_matrix;     // Transform and align raw IMU axis [x,y,z] to be consistent with the Depth frame CS
+        affine_transform    _aligned;                           // Without correction
+        affine_transform    _accel_corrected;
+        affine_transform    _gyro_corrected;
     };
 
     class motion_to_accel_gyro : public motion_transform
@@ -6,10 +6,15 @@
 #include "proc/occlusion-filter.h"
 
 #include <rsutils/string/from.h>
+#include <rsutils/sparse-depth.h>
 
 #include <vector>
 #include <cmath>
 
+#if defined __SSSE3__ && ! defined ANDROID
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+
 
 namespace librealsense
 {
@@ -115,68 +120,144 @@ namespace librealsense
     // -  The occlusion is designated as U coordinate for a given pixel is less than the U coordinate of the predecessing pixel.
     // -  The UV mapping for the occluded pixel is reset to (0,0). Later on the (0,0) coordinate in the texture map is overwritten
     //    with a invalidation color such as black/magenta according to the purpose (production/debugging)
+   // Horizontal scan of rows [first_row, last_row). With decimation, only the first row of every group of
+   // _decimation rows is scanned, and the points it invalidated are invalidated in the rest of the group as well:
+   // the shadows the scan finds are vertical bands that hardly change from one row to the next.
+   void occlusion_filter::monotonic_scan_rows(float3* points, const float2* pixels, int first_row, int last_row) const
+   {
+       const float occZTh = 0.1f; //meters
+       const int occDilationSz = 1;
+       const int points_width = _depth_intrinsics->width;
+       const int step = std::max(1, int(_decimation));
+       std::vector<uint8_t> invalidated(step > 1 ? points_width : 0);
+
+       for( int y = first_row; y < last_row; y += step )
+       {
+           auto points_ptr = points + size_t(y) * points_width;
+           auto pixels_ptr = pixels + size_t(y) * points_width;
+           float maxInLine = -1;
+           float maxZ = 0;
+           int occDilationLeft = 0;
+           std::fill(invalidated.begin(), invalidated.end(), uint8_t(0));
+
+           auto invalidate = [&](int x) {
+               points_ptr[x] = { 0, 0, 0 };
+               if (step > 1)
+                   invalidated[x] = 1;
+           };
+           auto scan = [&](int x) {
+               if( ! points_ptr[x].z )
+                   return;
+               // Occlusion detection
+               if( pixels_ptr[x].x < maxInLine
+                   || ( pixels_ptr[x].x == maxInLine && ( points_ptr[x].z - maxZ ) > occZTh ) )
+               {
+                   invalidate(x);
+                   occDilationLeft = occDilationSz;
+               }
+               else
+               {
+                   maxInLine = pixels_ptr[x].x;
+                   maxZ = points_ptr[x].z;
+                   if( occDilationLeft > 0 )
+                   {
+                       invalidate(x);
+                       occDilationLeft--;
+                   }
+               }
+           };
+
+           int x = 0;
+#if defined __SSSE3__ && ! defined ANDROID
+           // The common cases are runs of pixels without depth, and of pixels whose U keeps rising: neither changes
+           // anything but the running maximum, so 4 pixels at a time are checked for them and only the others are
+           // scanned one by one
+           for( ; x + 4 <= points_width; x += 4 )
+           {
+               auto q = &points_ptr[x].x;
+               __m128 q0 = _mm_loadu_ps(q), q1 = _mm_loadu_ps(q + 4), q2 = _mm_loadu_ps(q + 8);
+               __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(q0, q1, _MM_SHUFFLE(1, 1, 2, 2)),
+                                         _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+               int no_depth = _mm_movemask_ps(_mm_cmpeq_ps(z, _mm_setzero_ps()));
+               if( no_depth == 0xf )
+                   continue;
+               if( ! no_depth && ! occDilationLeft )
+               {
+                   __m128 u = _mm_shuffle_ps(_mm_loadu_ps(&pixels_ptr[x].x), _mm_loadu_ps(&pixels_ptr[x + 2].x), _MM_SHUFFLE(2, 0, 2, 0));
+                   __m128 prev = _mm_move_ss(_mm_shuffle_ps(u, u, _MM_SHUFFLE(2, 1, 0, 0)), _mm_set_ss(maxInLine));
+                   if( _mm_movemask_ps(_mm_cmpgt_ps(u, prev)) == 0xf )
+                   {
+                       maxInLine = pixels_ptr[x + 3].x;
+                       maxZ = points_ptr[x + 3].z;
+                       continue;
+                   }
+               }
+               for( int i = x; i < x + 4; ++i )
+                   scan(i);
+           }
+#endif
+           for( ; x < points_width; ++x )
+               scan(x);
+
+           for( int r = y + 1; r < std::min(y + step, last_row); ++r )
+           {
+               auto row = points + size_t(r) * points_width;
+               for( int i = 0; i < points_width; ++i )
+                   if( invalidated[i] )
+                       row[i] = { 0, 0, 0 };
+           }
+       }
+   }
+
    void occlusion_filter::monotonic_heuristic_invalidation(float3* points, float2* uv_map, const std::vector<float2>& pix_coord, const rs2::depth_frame& depth) const
    {
-       float occZTh = 0.1f; //meters
-       int occDilationSz = 1;
        auto points_width = _depth_intrinsics->width;
        auto points_height = _depth_intrinsics->height;
-       auto pixels_ptr = pix_coord.data();
        auto points_ptr = points;
        auto uv_map_ptr = uv_map;
        float maxInLine = -1;
-       float maxZ = 0;
 
        if (_occlusion_scanning == horizontal)
        {
-           for( int y = 0; y < points_height; ++y )
+           // Rows are independent: split them, in whole groups of decimated rows, across the threads
+           const int step = std::max(1, int(_decimation));
+           const auto groups = size_t((points_height + step - 1) / step);
+           if (_threads <= 1 || groups < 2)
            {
-               maxInLine = -1;
-               maxZ = 0;
-               int occDilationLeft = 0;
-
-               for(int x = 0; x < points_width; ++x )
-               {
-                   if( points_ptr->z )
-                   {
-                       // Occlusion detection
-                       if( pixels_ptr->x < maxInLine
-                           || ( pixels_ptr->x == maxInLine && ( points_ptr->z - maxZ ) > occZTh ) )
-                       {
-                           *points_ptr = { 0, 0, 0 };
-                           occDilationLeft = occDilationSz;
-                       }
-                       else
-                       {
-                           maxInLine = pixels_ptr->x;
-                           maxZ = points_ptr->z;
-                           if( occDilationLeft > 0 )
-                           {
-                               *points_ptr = { 0, 0, 0 };
-                               occDilationLeft--;
-                           }
-                       }
-                   }
-                   ++points_ptr;
-                   ++uv_map_ptr;
-                   ++pixels_ptr;
-               }
+               monotonic_scan_rows(points, pix_coord.data(), 0, points_height);
+               return;
            }
+           if (!_thread_pool)
+               _thread_pool = processing_thread_pool::instance();
+           _thread_pool->parallel_for(groups, _threads, [&](size_t begin, size_t end) {
+               monotonic_scan_rows(points, pix_coord.data(), int(begin) * step, std::min(int(end) * step, points_height));
+           });
        }
        else if (_occlusion_scanning == vertical)
        {
            auto rotated_depth_width = _depth_intrinsics->height;
            auto rotated_depth_height = _depth_intrinsics->width;
-           auto depth_ptr = (uint8_t *)(depth.get_data());
-           std::vector< uint8_t > alloc( depth.get_bytes_per_pixel() * points_width * points_height );
+           auto depth_ptr = (const uint8_t *)(depth.get_data());
+           // The rotation needs the whole image
+           std::vector< uint16_t > dense;
+           if (depth.get_profile().format() == RS2_FORMAT_Z16_SPARSE)
+           {
+               dense.resize(size_t(points_width) * points_height);
+               if (!rsutils::sparse_depth::decode(depth_ptr, depth.get_data_size(), dense.data(), points_width, points_height))
+                   return;
+               depth_ptr = (const uint8_t *)dense.data();
+           }
+           std::vector< uint8_t > alloc( sizeof( uint16_t ) * points_width * points_height );
            uint8_t * depth_planes[1];
            depth_planes[0] = alloc.data();
 
-           rotate_image_optimized<2>(depth_planes, (const uint8_t *)(depth.get_data()), points_width, points_height);
+           rotate_image_optimized<2>(depth_planes, depth_ptr, points_width, points_height);
 
            // scan depth frame after rotation: check if there is a noticed jump between adjacen pixels in Z-axis (depth), it means there could be occlusion.
            // save suspected points and run occlusion-invalidation vertical scan only on them
            // after rotation : height = points_width , width = points_height
+           const float scaled_threshold = DEPTH_OCCLUSION_THRESHOLD / _depth_units;
+           const auto scan_win_size = maxDivisorRange(rotated_depth_height, rotated_depth_width, 1, VERTICAL_SCAN_WINDOW_SIZE);
            for (int i = 0; i < rotated_depth_height; i++)
            {
                for (int j = 0; j < rotated_depth_width; j++)
@@ -190,12 +271,10 @@ namespace librealsense
                    uint16_t* diff_depth_ptr = (uint16_t*)depth_planes[0];
                    uint16_t diff_right = std::abs( (uint16_t)( *( diff_depth_ptr + index ) )
                                                    - (uint16_t)( *( diff_depth_ptr + index_right ) ) );
-                   float scaled_threshold = DEPTH_OCCLUSION_THRESHOLD / _depth_units;
                    if (diff_right > scaled_threshold)
                    {
                        points_ptr = points + uv_index;
                        uv_map_ptr = uv_map + uv_index;
-                       auto scan_win_size = maxDivisorRange(rotated_depth_height, rotated_depth_width, 1, VERTICAL_SCAN_WINDOW_SIZE);
 
                        if (j >= scan_win_size) {
                            maxInLine = (uv_map_ptr - 1 * points_width)->y;
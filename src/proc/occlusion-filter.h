@@ -4,6 +4,7 @@
 #pragma once
 #include <librealsense2/hpp/rs_frame.hpp>
 #include "rotation-transform.h"
+#include "processing-thread-pool.h"
 #include <src/pose.h>
 
 #define ROTATION_BUFFER_SIZE 32 // minimum limit that could be divided by all resolutions
@@ -59,6 +60,7 @@ namespace librealsense
         friend class pointcloud;
 
         void monotonic_heuristic_invalidation(float3* points, float2* uv_map, const std::vector<float2> & pix_coord, const rs2::depth_frame& depth) const;
+        void monotonic_scan_rows(float3* points, const float2* pixels, int first_row, int last_row) const;
         void comprehensive_invalidation(float3* points, float2* uv_map, const std::vector<float2> & pix_coord) const;
 
         optional_value<rs2_intrinsics>              _depth_intrinsics;
@@ -67,5 +69,8 @@ namespace librealsense
         occlusion_rect_type                         _occlusion_filter;
         occlusion_scanning_type                     _occlusion_scanning;
         float                                       _depth_units;
+        uint8_t                                     _threads = 1;     // Rows scanned at the same time (RS2_OPTION_FILTER_THREADS)
+        uint8_t                                     _decimation = 1;  // Scan every Nth row only (RS2_OPTION_OCCLUSION_DECIMATION)
+        mutable std::shared_ptr<processing_thread_pool> _thread_pool;
     };
 }
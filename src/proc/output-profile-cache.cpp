@@ -0,0 +1,173 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "output-profile-cache.h"
+#include "stream.h"
+#include "core/video.h"
+#include "librealsense-exception.h"
+
+#include <cstring>
+
+
+namespace librealsense {
+
+
+namespace {
+
+
+// Like what rs2::stream_profile::clone() returns: one that holds on to its profile
+struct held_profile : rs2::stream_profile
+{
+    explicit held_profile( const std::shared_ptr< rs2_stream_profile > & profile )
+        : rs2::stream_profile( profile.get() )
+    {
+        _clone = profile;
+    }
+};
+
+
+template< class T >
+void hash_combine( size_t & seed, const T & value )
+{
+    seed ^= std::hash< T >()( value ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+}
+
+
+}  // namespace
+
+
+output_profile_cache::key::key( const stream_profile_interface * source, rs2_stream stream, int index,
+                                rs2_format format, const char * transform )
+    : source( source )
+    , stream( stream )
+    , index( index )
+    , format( format )
+    , transform( transform )
+    , other( nullptr )
+    , width( 0 )
+    , height( 0 )
+    , param( 0 )
+{
+}
+
+
+bool output_profile_cache::key::operator==( const key & k ) const
+{
+    return source == k.source && stream == k.stream && index == k.index && format == k.format
+        && ( transform == k.transform || ( transform && k.transform && ! strcmp( transform, k.transform ) ) )
+        && other == k.other && width == k.width && height == k.height && param == k.param;
+}
+
+
+size_t output_profile_cache::key_hash::operator()( const key & k ) const
+{
+    size_t h = std::hash< const void * >()( k.source );
+    hash_combine( h, int( k.stream ) );
+    hash_combine( h, k.index );
+    hash_combine( h, int( k.format ) );
+    // The name of the transform is left to ==
+    hash_combine( h, static_cast< const void * >( k.other ) );
+    hash_combine( h, k.width );
+    hash_combine( h, k.height );
+    hash_combine( h, k.param );
+    return h;
+}
+
+
+std::shared_ptr< stream_profile_interface > output_profile_cache::get( const key & k, const setup_callback & setup )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    return find( k, setup )->clone;
+}
+
+
+rs2::stream_profile output_profile_cache::get_profile( const key & k, const setup_callback & setup )
+{
+    std::shared_ptr< rs2_stream_profile > profile;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        profile = find( k, setup );
+    }
+    return held_profile( profile );
+}
+
+
+rs2::stream_profile output_profile_cache::get_profile( const rs2::stream_profile & source, rs2_stream stream, int index,
+                                                      rs2_format format )
+{
+    return get_profile( key( source.get()->profile, stream, index, format ) );
+}
+
+
+size_t output_profile_cache::size() const
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    return _entries.size();
+}
+
+
+std::shared_ptr< rs2_stream_profile > output_profile_cache::find( const key & k, const setup_callback & setup )
+{
+    if( ! k.source )
+        throw invalid_value_exception( "no source profile to make an output profile of" );
+
+    auto it = _entries.find( k );
+    if( it != _entries.end() && it->second.source.lock().get() == k.source
+        && it->second.other.lock().get() == k.other )
+        return it->second.profile;
+
+    // Only when there's a new one do we look for the ones that are gone
+    erase_expired();
+
+    auto profile = k.source->clone();
+    profile->set_stream_type( k.stream );
+    profile->set_stream_index( k.index );
+    profile->set_format( k.format );
+    if( k.width || k.height )
+    {
+        auto video = dynamic_cast< video_stream_profile_interface * >( profile.get() );
+        if( ! video )
+            throw invalid_value_exception( "dimensions given for an output profile that is not video" );
+        video->set_dims( k.width ? k.width : video->get_width(), k.height ? k.height : video->get_height() );
+    }
+    if( setup )
+        setup( *profile );
+
+    entry e;
+    e.source = k.source->shared_from_this();
+    if( k.other )
+        e.other = k.other->shared_from_this();
+    e.profile = std::make_shared< rs2_stream_profile >( rs2_stream_profile{ profile.get(), profile } );
+    _entries[k] = e;
+    return e.profile;
+}
+
+
+void output_profile_cache::erase_expired()
+{
+    // The outputs of a block may be the sources of another: once the former are no longer held, the latter go too
+    bool erased;
+    do
+    {
+        erased = false;
+        for( auto it = _entries.begin(); it != _entries.end(); )
+        {
+            if( it->second.source.expired() || ( it->first.other && it->second.other.expired() ) )
+            {
+                it = _entries.erase( it );
+                erased = true;
+            }
+            else
+                ++it;
+        }
+    }
+    while( erased );
+
+    // Otherwise, begins over: a transform whose parameters keep changing (e.g., the points of depth_fusion) would have
+    // them all kept for as long as its source lives
+    if( _entries.size() >= 4096 )
+        _entries.clear();
+}
+
+
+}  // namespace librealsense
@@ -0,0 +1,87 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/hpp/rs_frame.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace librealsense {
+
+
+class stream_interface;
+class stream_profile_interface;
+
+
+// The profiles of the frames that the processing blocks output, shared by all of them (see
+// environment::get_output_profile_cache): a block asks for the output of a source profile, as it transforms it, and
+// gets the same one every time, whichever block (or camera, or thread) asked first. An output profile is made once,
+// by cloning the source (which registers it with the source's extrinsics) and setting it up, which is therefore also
+// the only time its extrinsics are registered.
+//
+// The blocks still keep the last one they got, and only come here when their source changes.
+//
+// An entry goes once its source (or other) profile does; the output profile lives on as long as its frames do.
+//
+class output_profile_cache
+{
+public:
+    // What a block makes of a source profile: the stream, index and format of its output, and whatever else sets it
+    // apart from a plain clone of the source with those
+    struct key
+    {
+        const stream_profile_interface * source;
+        rs2_stream stream;
+        int index;
+        rs2_format format;
+        // A literal naming what the block does to the profile beyond the above (e.g., "decimation"), if anything; the
+        // transforms are told apart by name
+        const char * transform;
+        const stream_profile_interface * other;  // What the transform depends on, if anything (e.g., the align target)
+        uint32_t width, height;                  // Of video profiles; 0 for the source's
+        double param;                            // Of the transform (e.g., the decimation factor)
+
+        key( const stream_profile_interface * source, rs2_stream stream, int index, rs2_format format,
+             const char * transform = nullptr );
+
+        bool operator==( const key & ) const;
+    };
+
+    // Given the new profile, cloned from the source with the stream, index, format and dimensions of the key, to set up
+    // the rest of it (intrinsics, extrinsics, ...); called once per key, under the cache's lock
+    typedef std::function< void( stream_profile_interface & ) > setup_callback;
+
+    std::shared_ptr< stream_profile_interface > get( const key &, const setup_callback & setup = nullptr );
+    // The same, held by an rs2::stream_profile, for the blocks that deal in those
+    rs2::stream_profile get_profile( const key &, const setup_callback & setup = nullptr );
+    // A plain clone of the source, with the stream, index and format changed
+    rs2::stream_profile get_profile( const rs2::stream_profile & source, rs2_stream stream, int index, rs2_format format );
+
+    size_t size() const;
+
+private:
+    struct key_hash
+    {
+        size_t operator()( const key & ) const;
+    };
+    struct entry
+    {
+        // To tell the profiles of the key from any later at the same addresses
+        std::weak_ptr< const stream_interface > source, other;
+        std::shared_ptr< rs2_stream_profile > profile;
+    };
+
+    std::shared_ptr< rs2_stream_profile > find( const key &, const setup_callback & );
+    void erase_expired();
+
+    mutable std::mutex _mutex;
+    std::unordered_map< key, entry, key_hash > _entries;
+};
+
+
+}  // namespace librealsense
@@ -3,6 +3,8 @@
 
 #include "pointcloud.h"
 #include "occlusion-filter.h"
+#include "voxel-grid.h"
+#include "output-profile-cache.h"
 #include <src/environment.h>
 #include <src/core/depth-frame.h>
 #include <src/option.h>
@@ -15,12 +17,17 @@
 #include <librealsense2/rs.hpp>
 
 #include <rsutils/string/from.h>
+#include <rsutils/sparse-depth.h>
+
+#include <cmath>
+#include <cstring>
 
 #ifdef RS2_USE_CUDA
 #include "proc/cuda/cuda-pointcloud.h"
 #endif
-#ifdef __SSSE3__
+#if defined(__SSSE3__) || (defined(__aarch64__) && defined(__ARM_NEON))
 #include "proc/sse/sse-pointcloud.h"
+#include "proc/vulkan/vulkan-pointcloud.h"
 #endif
 
 namespace librealsense
@@ -47,6 +54,65 @@ namespace librealsense
         return (float3*)image;
     }
 
+    const float3 * pointcloud::depth_to_points_in_roi(rs2::points output,
+        const rs2_intrinsics &depth_intrinsics, const rs2::depth_frame& depth_frame, const region_of_interest& roi)
+    {
+        auto image = (float3*)output.get_vertices();
+        auto depth = (const uint16_t*)depth_frame.get_data();
+        auto depth_scale = depth_frame.get_units();
+        const int width = depth_intrinsics.width;
+
+        memset(image, 0, sizeof(float3) * width * depth_intrinsics.height);
+        for (int y = roi.min_y; y <= roi.max_y; ++y)
+        {
+            for (int x = roi.min_x; x <= roi.max_x; ++x)
+            {
+                const float pixel[] = { (float)x, (float)y };
+                rs2_deproject_pixel_to_point(&image[y * width + x].x, &depth_intrinsics, pixel, depth_scale * depth[y * width + x]);
+            }
+        }
+        return image;
+    }
+
+    const float3 * pointcloud::sparse_depth_to_points(rs2::points output,
+        const rs2_intrinsics &depth_intrinsics, const rs2::depth_frame& depth_frame, const region_of_interest& roi)
+    {
+        rsutils::sparse_depth::image sparse;
+        if (!sparse.parse(static_cast<const uint8_t*>(depth_frame.get_data()), depth_frame.get_data_size())
+            || int(sparse.width()) != depth_intrinsics.width || int(sparse.height()) != depth_intrinsics.height)
+            throw invalid_value_exception("corrupt sparse depth frame");
+
+        auto image = (float3*)output.get_vertices();
+        auto depth_scale = depth_frame.get_units();
+        const int width = depth_intrinsics.width;
+        const bool cull = _bounds.active();
+
+        memset(image, 0, sizeof(float3) * width * depth_intrinsics.height);
+        for (int y = roi.min_y; y <= roi.max_y; ++y)
+        {
+            for (size_t i = sparse.begin(y), end = sparse.end(y); i < end; ++i)
+            {
+                int x = sparse.x(i);
+                if (x < roi.min_x || x > roi.max_x)
+                    continue;
+                const float pixel[] = { (float)x, (float)y };
+                float3 p;
+                rs2_deproject_pixel_to_point(&p.x, &depth_intrinsics, pixel, depth_scale * sparse.depth(i));
+                if (!cull || _bounds.contains(p))
+                    image[y * width + x] = p;
+            }
+        }
+        return image;
+    }
+
+    bool pointcloud::points_bounds::active() const
+    {
+        for (int i = 0; i < 3; ++i)
+            if (min[i] > -100.f || max[i] < 100.f)
+                return true;
+        return false;
+    }
+
     float3 transform(const rs2_extrinsics *extrin, const float3 &point) { float3 p = {}; rs2_transform_point_to_point(&p.x, extrin, &point.x); return p; }
     float2 project(const rs2_intrinsics *intrin, const float3 & point) { float2 pixel = {}; rs2_project_point_to_pixel(&pixel.x, intrin, &point.x); return pixel; }
     float2 pixel_to_texcoord(const rs2_intrinsics *intrin, const float2 & pixel) { return{ pixel.x / (intrin->width), pixel.y / (intrin->height) }; }
@@ -71,8 +137,8 @@ namespace librealsense
     {
         if (!_output_stream || _depth_stream.get_profile().get() != depth.get_profile().get())
         {
-            _output_stream = depth.get_profile().as<rs2::video_stream_profile>().clone(
-                RS2_STREAM_DEPTH, depth.get_profile().stream_index(), RS2_FORMAT_XYZ32F);
+            _output_stream = environment::get_instance().get_output_profile_cache().get_profile(
+                depth.get_profile(), RS2_STREAM_DEPTH, depth.get_profile().stream_index(), RS2_FORMAT_XYZ32F);
             _depth_stream = depth;
             _depth_intrinsics = optional_value<rs2_intrinsics>();
             _depth_units = ((depth_frame*)depth.get())->get_units();
@@ -249,9 +315,29 @@ namespace librealsense
     {
         auto res = allocate_points(source, depth);
         auto pframe = (librealsense::points*)(res.get());
-        const float3* points = depth_to_points(res, *_depth_intrinsics, depth);
-
         auto vid_frame = depth.as<rs2::video_frame>();
+        // A recycled frame may still have the layout it was packed in
+        pframe->set_layout(RS2_POINTS_LAYOUT_INTERLEAVED, 0);
+
+        // Outside the region of interest, the points are left at zero like where there's no depth
+        auto roi = get_roi(depth, vid_frame.get_width(), vid_frame.get_height());
+        bool full_roi = is_full_roi(roi, vid_frame.get_width(), vid_frame.get_height());
+        bool sparse = depth.get_profile().format() == RS2_FORMAT_Z16_SPARSE;
+        const float3* points = sparse
+            ? sparse_depth_to_points(res, *_depth_intrinsics, depth, roi)
+            : full_roi
+            ? depth_to_points(res, *_depth_intrinsics, depth)
+            : depth_to_points_in_roi(res, *_depth_intrinsics, depth, roi);
+        set_roi(res, roi, vid_frame.get_width(), vid_frame.get_height());
+
+        // And so are the points outside the bounds, which the packed layouts then leave out
+        if (points && _bounds.active() && !sparse && !(full_roi && culls_points()))
+        {
+            auto vertices = const_cast<float3*>(points);
+            for (size_t i = 0, n = pframe->get_vertex_count(); i < n; ++i)
+                if (vertices[i].z && !_bounds.contains(vertices[i]))
+                    vertices[i] = {};
+        }
 
         // Pixels calculated in the mapped texture. Used in post-processing filters
         float2* pixels_ptr = _pixels_map.data();
@@ -284,9 +370,111 @@ namespace librealsense
                 _occlusion_filter->process(pframe->get_vertices(), pframe->get_texture_coordinates(), _pixels_map, depth);
             }
         }
+        // Before packing, which leaves out the points the voxels' centroids took the place of
+        if (_voxel_size > 0 && pframe->get_layout() == RS2_POINTS_LAYOUT_INTERLEAVED)
+        {
+            if (!_voxel_grid)
+                _voxel_grid = std::make_shared<voxel_grid>();
+            _voxel_grid->reduce(pframe->get_vertices(), pframe->get_texture_coordinates(), pframe->get_vertex_count(),
+                _voxel_size, _occlusion_filter->_threads);
+        }
+
+        // Unless depth_to_points() already packed them
+        if (_layout != RS2_POINTS_LAYOUT_INTERLEAVED && pframe->get_layout() == RS2_POINTS_LAYOUT_INTERLEAVED)
+            pack_points(*pframe);
         return res;
     }
 
+    // IEEE 754 half precision, rounding to nearest even
+    static uint16_t float_to_half(float value)
+    {
+        uint32_t f;
+        std::memcpy(&f, &value, sizeof(f));
+        uint16_t sign = uint16_t((f >> 16) & 0x8000);
+        uint32_t exponent = (f >> 23) & 0xff;
+        uint32_t mantissa = f & 0x7fffff;
+
+        if (exponent == 0xff)
+            return uint16_t(sign | 0x7c00 | (mantissa ? 0x200 : 0));  // inf, nan
+        int e = int(exponent) - 127 + 15;
+        if (e >= 31)
+            return uint16_t(sign | 0x7c00);                 // too large: inf
+        int shift = 13;
+        uint32_t half;
+        if (e <= 0)
+        {
+            if (e < -10)
+                return sign;                                // too small: 0
+            mantissa |= 0x800000;                           // subnormal: the implicit 1 becomes explicit
+            shift = 14 - e;
+            half = mantissa >> shift;
+        }
+        else
+            half = (uint32_t(e) << 10) | (mantissa >> shift);
+
+        // A carry from the mantissa goes into the exponent, which is what rounding up needs
+        uint32_t rest = mantissa & ((1u << shift) - 1), halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1)))
+            ++half;
+        return uint16_t(sign | half);
+    }
+
+    static int16_t to_millimeters(float meters)
+    {
+        return int16_t(std::max(-32768.f, std::min(32767.f, std::round(meters * 1000.f))));
+    }
+
+    template<class T, class X, class U>
+    static void pack_arrays(const float3* vertices, const float2* texcoords, size_t n, size_t count, T* out, X coord, U texcoord)
+    {
+        auto x = out, y = x + count, z = y + count;
+        auto u = reinterpret_cast<decltype(texcoord(0.f))*>(z + count), v = u + count;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (!vertices[i].z)
+                continue;
+            *x++ = coord(vertices[i].x);
+            *y++ = coord(vertices[i].y);
+            *z++ = coord(vertices[i].z);
+            *u++ = texcoord(texcoords[i].x);
+            *v++ = texcoord(texcoords[i].y);
+        }
+    }
+
+    void pointcloud::pack_points(points& frame)
+    {
+        auto layout = rs2_points_layout(_layout);
+        const auto vertices = frame.get_vertices();
+        const auto texcoords = frame.get_texture_coordinates();
+        const auto n = frame.get_vertex_count();
+
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i)
+            count += vertices[i].z != 0;
+
+        // The arrays are built aside: packing in place would overwrite points that weren't read yet
+        const auto value_size = layout == RS2_POINTS_LAYOUT_PACKED_FLOAT ? sizeof(float) : sizeof(uint16_t);
+        _packed.resize(count * 5 * value_size);
+        switch (layout)
+        {
+        case RS2_POINTS_LAYOUT_PACKED_FLOAT:
+            pack_arrays(vertices, texcoords, n, count, reinterpret_cast<float*>(_packed.data()),
+                [](float m) { return m; }, [](float t) { return t; });
+            break;
+        case RS2_POINTS_LAYOUT_PACKED_HALF:
+            pack_arrays(vertices, texcoords, n, count, reinterpret_cast<uint16_t*>(_packed.data()), float_to_half, float_to_half);
+            break;
+        case RS2_POINTS_LAYOUT_PACKED_MILLIMETERS:
+            pack_arrays(vertices, texcoords, n, count, reinterpret_cast<int16_t*>(_packed.data()), to_millimeters, float_to_half);
+            break;
+        default:
+            return;
+        }
+
+        std::memcpy(vertices, _packed.data(), _packed.size());
+        frame.set_layout(layout, count);
+    }
+
     pointcloud::pointcloud()
         : pointcloud("Pointcloud")
     {}
@@ -321,6 +509,44 @@ namespace librealsense
         occlusion_invalidation->set_description(1.f, "Off");
         occlusion_invalidation->set_description(2.f, "On");
         register_option(RS2_OPTION_FILTER_MAGNITUDE, occlusion_invalidation);
+
+        auto occlusion_threads = std::make_shared<ptr_option<uint8_t>>(
+            uint8_t(1),
+            uint8_t(std::min(processing_thread_pool::max_threads(), 255)),
+            uint8_t(1),
+            uint8_t(1),
+            &_occlusion_filter->_threads, "Number of threads to split the occlusion removal and the voxel downsampling across");
+        register_option(RS2_OPTION_FILTER_THREADS, occlusion_threads);
+
+        register_option(RS2_OPTION_OCCLUSION_DECIMATION, std::make_shared<ptr_option<uint8_t>>(
+            uint8_t(1), uint8_t(8), uint8_t(1), uint8_t(1),
+            &_occlusion_filter->_decimation, "Scan every Nth row of depth for occlusions, applying what was found to the rows in between"));
+
+        auto layout = std::make_shared<ptr_option<uint8_t>>(
+            uint8_t(RS2_POINTS_LAYOUT_INTERLEAVED),
+            uint8_t(RS2_POINTS_LAYOUT_COUNT - 1), uint8_t(1),
+            uint8_t(RS2_POINTS_LAYOUT_INTERLEAVED),
+            &_layout,
+            "Layout of the output points: the packed layouts hold the valid points only, with their count in the frame metadata");
+        for (int i = 0; i < RS2_POINTS_LAYOUT_COUNT; ++i)
+            layout->set_description(float(i), rs2_points_layout_to_string(rs2_points_layout(i)));
+        register_option(RS2_OPTION_POINTS_LAYOUT, layout);
+
+        const rs2_option bounds_options[2][3] = {
+            { RS2_OPTION_POINTS_MIN_X, RS2_OPTION_POINTS_MIN_Y, RS2_OPTION_POINTS_MIN_Z },
+            { RS2_OPTION_POINTS_MAX_X, RS2_OPTION_POINTS_MAX_Y, RS2_OPTION_POINTS_MAX_Z } };
+        for (int i = 0; i < 3; ++i)
+        {
+            register_option(bounds_options[0][i], std::make_shared<ptr_option<float>>(-100.f, 100.f, 0.001f, -100.f,
+                &_bounds.min[i], "Points below this coordinate, in meters, are dropped"));
+            register_option(bounds_options[1][i], std::make_shared<ptr_option<float>>(-100.f, 100.f, 0.001f, 100.f,
+                &_bounds.max[i], "Points above this coordinate, in meters, are dropped"));
+        }
+
+        register_option(RS2_OPTION_POINTS_VOXEL_SIZE, std::make_shared<ptr_option<float>>(0.f, 1.f, 0.001f, 0.f,
+            &_voxel_size, "Side of the voxels the points are downsampled to the centroids of, in meters; 0 keeps every point"));
+
+        register_roi_options();
     }
 
     bool pointcloud::should_process(const rs2::frame& frame)
@@ -340,13 +566,15 @@ namespace librealsense
             if (!tex)
                 return false;
             auto depth = set.first_or_default(RS2_STREAM_DEPTH, RS2_FORMAT_Z16);
+            if (!depth)
+                depth = set.first_or_default(RS2_STREAM_DEPTH, RS2_FORMAT_Z16_SPARSE);
             if (!depth)
                 return false;
         }
         else
         {
             auto p = frame.get_profile();
-            if (p.stream_type() == RS2_STREAM_DEPTH && p.format() == RS2_FORMAT_Z16)
+            if (p.stream_type() == RS2_STREAM_DEPTH && (p.format() == RS2_FORMAT_Z16 || p.format() == RS2_FORMAT_Z16_SPARSE))
                 return true;
 
             if (p.stream_type() == _stream_filter.stream && p.format() == _stream_filter.format && p.stream_index() == _stream_filter.index)
@@ -372,7 +600,9 @@ namespace librealsense
             auto texture = composite.first(_stream_filter.stream);
             inspect_other_frame(texture);
 
-            auto depth = composite.first(RS2_STREAM_DEPTH, RS2_FORMAT_Z16);
+            auto depth = composite.first_or_default(RS2_STREAM_DEPTH, RS2_FORMAT_Z16);
+            if (!depth)
+                depth = composite.first(RS2_STREAM_DEPTH, RS2_FORMAT_Z16_SPARSE);
             inspect_depth_frame(depth);
             rv = process_depth_frame(source, depth);
         }
@@ -396,7 +626,13 @@ namespace librealsense
         #ifdef RS2_USE_CUDA
             return std::make_shared<librealsense::pointcloud_cuda>();
         #else
-        #ifdef __SSSE3__
+        #ifdef RS2_USE_VULKAN
+            // Only when there's a device to run on; the CPU otherwise
+            if (vulkan::device::get())
+                return std::make_shared<librealsense::pointcloud_vulkan>();
+        #endif
+        #if defined(__SSSE3__) || (defined(__aarch64__) && defined(__ARM_NEON))
+            // SSE on x86, NEON on aarch64
             return std::make_shared<librealsense::pointcloud_sse>();
         #else
             return std::make_shared<librealsense::pointcloud>();
@@ -9,6 +9,8 @@
 namespace librealsense
 {
     class occlusion_filter;
+    class voxel_grid;
+    class points;
 
     class LRS_EXTENSION_API pointcloud : public stream_filter_processing_block
     {
@@ -33,6 +35,20 @@ namespace librealsense
         virtual void preprocess() {}
         virtual bool run__occlusion_filter(const rs2_extrinsics& extr);
 
+        // The box of RS2_OPTION_POINTS_MIN_X..MAX_Z, in meters in the depth camera's frame
+        struct points_bounds
+        {
+            float min[3] = { -100.f, -100.f, -100.f };
+            float max[3] = { 100.f, 100.f, 100.f };
+
+            // With the defaults, nothing is ever outside
+            bool active() const;
+            bool contains(const float3& p) const
+            {
+                return p.x >= min[0] && p.x <= max[0] && p.y >= min[1] && p.y <= max[1] && p.z >= min[2] && p.z <= max[2];
+            }
+        };
+
     protected:
         pointcloud(const char* name);
 
@@ -52,11 +68,31 @@ namespace librealsense
         rs2::frame _other_stream;
         rs2::frame _depth_stream;
 
+        // depth_to_points() for the pixels of roi only, leaving the other points at zero
+        const float3 * depth_to_points_in_roi(rs2::points output, const rs2_intrinsics &depth_intrinsics,
+            const rs2::depth_frame& depth_frame, const region_of_interest& roi);
+        // The same for RS2_FORMAT_Z16_SPARSE depth, read in place: only its valid pixels are deprojected, and those
+        // outside _bounds are left at zero as well
+        const float3 * sparse_depth_to_points(rs2::points output, const rs2_intrinsics &depth_intrinsics,
+            const rs2::depth_frame& depth_frame, const region_of_interest& roi);
+
         void inspect_depth_frame(const rs2::frame& depth);
         void inspect_other_frame(const rs2::frame& other);
         rs2::frame process_depth_frame(const rs2::frame_source& source, const rs2::depth_frame& depth);
         void set_extrinsics();
 
+        // Whether depth_to_points() already zeroes the points outside _bounds; otherwise they're culled after it
+        virtual bool culls_points() const { return false; }
+
+        // Rewrites the points in the packed layout selected with RS2_OPTION_POINTS_LAYOUT
+        void pack_points(points& frame);
+
+        uint8_t _layout = RS2_POINTS_LAYOUT_INTERLEAVED;
+        points_bounds _bounds;
+        float _voxel_size = 0.f;    // RS2_OPTION_POINTS_VOXEL_SIZE
+        std::shared_ptr<voxel_grid> _voxel_grid;
+        std::vector<uint8_t> _packed;
+
         stream_filter _prev_stream_filter;
         std::shared_ptr< pointcloud > _registered_auto_calib_cb;
     };
@@ -0,0 +1,355 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "proc/processing-graph.h"
+
+#include <src/composite-frame.h>
+#include <src/core/frame-callback.h>
+#include <src/core/frame-processor-callback.h>
+#include <src/core/stream-profile-interface.h>
+
+#include <rsutils/string/from.h>
+#include <rsutils/json.h>
+
+#include <algorithm>
+
+
+namespace librealsense
+{
+    // The load is judged over this many frames, and the policy changes by at most one step each time
+    static const int load_window_frames = 30;
+    // Of the time, the busiest block is busy above which the graph can't be kept up, and below which it can afford
+    // more: far enough apart that undoing a step doesn't bring it right back over
+    static const float overloaded = 0.9f;
+    static const float underloaded = 0.6f;
+
+    processing_graph::processing_graph(int max_in_flight)
+        : processing_block("Processing Graph")
+        , _max_in_flight(size_t(std::max(1, max_in_flight)))
+        , _thread_pool(processing_thread_pool::instance())
+    {
+        auto process_callback = [&](frame_holder&& frame, synthetic_source_interface* source)
+        {
+            std::vector< std::pair< size_t, unsigned long long > > ready;
+            int load_change = 0;
+            {
+                std::unique_lock< std::mutex > lock(_graph_mutex);
+                bool waited = _jobs.size() >= _max_in_flight;
+                _cv.wait(lock, [this]() { return _jobs.size() < _max_in_flight; });
+
+                std::unique_ptr< job > j(new job);
+                j->input = std::move(frame);
+                j->outputs.resize(_nodes.size());
+                j->done.resize(_nodes.size(), false);
+                j->remaining = _nodes.size();
+                _jobs.push_back(std::move(j));
+                if (!_load_steps.empty())
+                    load_change = evaluate_load(waited);
+                ready = take_ready_nodes();
+            }
+            if (load_change)
+                change_load_level(load_change);
+            schedule(ready);
+
+            // Without blocks, there's nothing that would get the frame out otherwise
+            if (_nodes.empty())
+                emit_done_jobs();
+        };
+
+        set_processing_callback(make_frame_processor_callback(std::move(process_callback)));
+    }
+
+    processing_graph::~processing_graph()
+    {
+        {
+            std::unique_lock< std::mutex > lock(_graph_mutex);
+            _cv.wait(lock, [this]() { return _jobs.empty() && !_running; });
+        }
+        // The blocks may be shared, and outlive us
+        for (auto& n : _nodes)
+            n->block->set_output_callback(nullptr);
+    }
+
+    int processing_graph::add_node(std::shared_ptr< processing_block_interface > const & block, int parent)
+    {
+        if (!block)
+            throw invalid_value_exception("null block");
+
+        std::lock_guard< std::mutex > lock(_graph_mutex);
+        if (_first_seq || !_jobs.empty())
+            throw wrong_api_call_sequence_exception("blocks can only be added to a processing graph before its first frame");
+        if (parent < -1 || parent >= int(_nodes.size()))
+            throw invalid_value_exception(rsutils::string::from() << "invalid parent " << parent << " for a graph of "
+                                                                  << _nodes.size() << " blocks");
+
+        std::unique_ptr< node > n(new node);
+        n->block = block;
+        n->parent = parent;
+        // Only ever called by the block from within its invoke(), while the node is busy
+        auto raw = n.get();
+        block->set_output_callback(make_frame_callback([raw](frame_interface* f) { raw->output = frame_holder(f); }));
+
+        if (parent >= 0)
+            _nodes[parent]->is_leaf = false;
+        _nodes.push_back(std::move(n));
+        return int(_nodes.size() - 1);
+    }
+
+    int processing_graph::add_load_step(int node, rs2_option option, float value)
+    {
+        load_step step;
+        step.node = node;
+        step.bypass = false;
+        step.option = option;
+        step.value = value;
+        return add_step(step);
+    }
+
+    int processing_graph::add_bypass_step(int node)
+    {
+        load_step step;
+        step.node = node;
+        step.bypass = true;
+        step.option = RS2_OPTION_COUNT;
+        step.value = 0;
+        return add_step(step);
+    }
+
+    int processing_graph::add_step(load_step const & step)
+    {
+        std::lock_guard< std::mutex > lock(_graph_mutex);
+        if (_first_seq || !_jobs.empty())
+            throw wrong_api_call_sequence_exception("load steps can only be added to a processing graph before its first frame");
+        if (step.node < 0 || step.node >= int(_nodes.size()))
+            throw invalid_value_exception(rsutils::string::from() << "invalid block " << step.node << " for a graph of "
+                                                                  << _nodes.size() << " blocks");
+        if (!step.bypass && !_nodes[step.node]->block->supports_option(step.option))
+            throw invalid_value_exception(rsutils::string::from()
+                                          << _nodes[step.node]->block->get_info(RS2_CAMERA_INFO_NAME) << " has no "
+                                          << rs2_option_to_string(step.option) << " option");
+        _load_steps.push_back(step);
+        return int(_load_steps.size() - 1);
+    }
+
+    int processing_graph::evaluate_load(bool waited)
+    {
+        auto now = std::chrono::steady_clock::now();
+        _window_waited = _window_waited || waited;
+        if (!_window_frames++)
+        {
+            _window_start = now;
+            return 0;
+        }
+        if (_window_frames < load_window_frames || now <= _window_start)
+            return 0;
+
+        // Each block sees one frame at a time, so one that's busy all the time holds everything up
+        std::chrono::steady_clock::duration busiest{};
+        for (auto& n : _nodes)
+        {
+            busiest = std::max(busiest, n->busy_time);
+            n->busy_time = {};
+        }
+        _load = std::chrono::duration< float >(busiest).count()
+              / std::chrono::duration< float >(now - _window_start).count();
+        bool behind = _window_waited || _load > overloaded;
+        _window_start = now;
+        _window_frames = 1;
+        _window_waited = false;
+
+        if (behind && _load_level < _load_steps.size())
+            return int(++_load_level);
+        if (!behind && _load < underloaded && _load_level)
+            return -int(_load_level--);
+        return 0;
+    }
+
+    void processing_graph::change_load_level(int change)
+    {
+        // The step taken or undone, counting from 1
+        bool take = change > 0;
+        auto& step = _load_steps[size_t(take ? change : -change) - 1];
+        auto& n = *_nodes[step.node];
+        std::string what = n.block->get_info(RS2_CAMERA_INFO_NAME);
+        try
+        {
+            if (step.bypass)
+            {
+                std::lock_guard< std::mutex > lock(_graph_mutex);
+                n.bypassed = take;
+                what += take ? " skipped" : " no longer skipped";
+            }
+            else
+            {
+                auto& opt = n.block->get_option(step.option);
+                if (take)
+                    step.previous = opt.query();
+                opt.set(take ? step.value : step.previous);
+                what += rsutils::string::from() << " " << rs2_option_to_string(step.option) << " set to "
+                                                << (take ? step.value : step.previous);
+            }
+        }
+        catch (std::exception const& e)
+        {
+            what += rsutils::string::from() << " could not be changed: " << e.what();
+        }
+
+        auto level = take ? change : -change - 1;
+        notification note(RS2_NOTIFICATION_CATEGORY_PROCESSING_LOAD,
+            level,
+            take ? RS2_LOG_SEVERITY_WARN : RS2_LOG_SEVERITY_INFO,
+            rsutils::string::from() << (take ? "Processing is falling behind" : "Processing is keeping up")
+                                    << " (busiest block " << int(_load * 100) << "% busy): step "
+                                    << (take ? change : -change) << " of " << _load_steps.size()
+                                    << (take ? " taken, " : " undone, ") << what);
+        note.serialized_data = rsutils::json::object(
+            { { "steps-taken", level }, { "steps", _load_steps.size() }, { "load", _load } }).dump();
+        _notifications.raise_notification(note);
+    }
+
+    std::vector< std::pair< size_t, unsigned long long > > processing_graph::take_ready_nodes()
+    {
+        std::vector< std::pair< size_t, unsigned long long > > ready;
+        // Parents come before their children, so a child sees what its parent was just found to be done with
+        for (size_t i = 0; i < _nodes.size(); ++i)
+        {
+            auto& n = *_nodes[i];
+            while (!n.busy && n.next < _first_seq + _jobs.size())
+            {
+                auto& j = *_jobs[size_t(n.next - _first_seq)];
+                if (n.parent >= 0 && !j.done[n.parent])
+                    break;
+                if (n.parent >= 0 && !j.outputs[n.parent])
+                {
+                    // Nothing came out of the parent, so there's nothing for this one to do either
+                    j.done[i] = true;
+                    --j.remaining;
+                    ++n.next;
+                    continue;
+                }
+                n.busy = true;
+                ready.emplace_back(i, n.next);
+            }
+        }
+        return ready;
+    }
+
+    void processing_graph::schedule(std::vector< std::pair< size_t, unsigned long long > > const & ready)
+    {
+        for (auto& r : ready)
+        {
+            {
+                std::lock_guard< std::mutex > lock(_graph_mutex);
+                ++_running;
+            }
+            _thread_pool->submit([this, r]()
+            {
+                run_node(r.first, r.second);
+
+                std::lock_guard< std::mutex > lock(_graph_mutex);
+                --_running;
+                _cv.notify_all();
+            });
+        }
+    }
+
+    void processing_graph::run_node(size_t index, unsigned long long seq)
+    {
+        auto& n = *_nodes[index];
+        frame_holder input;
+        bool bypass;
+        {
+            // The job stays until all its nodes are done, this one included
+            std::lock_guard< std::mutex > lock(_graph_mutex);
+            auto& j = *_jobs[size_t(seq - _first_seq)];
+            input = (n.parent < 0 ? j.input : j.outputs[n.parent]).clone();
+            bypass = n.bypassed;
+        }
+
+        std::chrono::steady_clock::duration busy{};
+        if (bypass)
+            n.output = std::move(input);
+        else if (_load_steps.empty())
+            n.block->invoke(std::move(input));
+        else
+        {
+            auto start = std::chrono::steady_clock::now();
+            n.block->invoke(std::move(input));
+            busy = std::chrono::steady_clock::now() - start;
+        }
+
+        std::vector< std::pair< size_t, unsigned long long > > ready;
+        {
+            std::lock_guard< std::mutex > lock(_graph_mutex);
+            n.busy_time += busy;
+            auto& j = *_jobs[size_t(seq - _first_seq)];
+            j.outputs[index] = std::move(n.output);
+            j.done[index] = true;
+            --j.remaining;
+            n.busy = false;
+            ++n.next;
+            ready = take_ready_nodes();
+        }
+        schedule(ready);
+        emit_done_jobs();
+    }
+
+    void processing_graph::emit_done_jobs()
+    {
+        // Whoever holds this takes the jobs off the front and outputs them, so they come out in order
+        std::lock_guard< std::mutex > emit_lock(_emit_mutex);
+        while (true)
+        {
+            std::unique_ptr< job > j;
+            {
+                std::lock_guard< std::mutex > lock(_graph_mutex);
+                if (_jobs.empty() || _jobs.front()->remaining)
+                    return;
+                j = std::move(_jobs.front());
+                _jobs.pop_front();
+                ++_first_seq;
+            }
+            _cv.notify_all();
+
+            if (auto output = make_output(*j))
+                get_source().frame_ready(std::move(output));
+        }
+    }
+
+    frame_holder processing_graph::make_output(job& j)
+    {
+        if (_nodes.empty())
+            return std::move(j.input);
+
+        std::vector< size_t > outputs;
+        for (size_t i = 0; i < _nodes.size(); ++i)
+            if (_nodes[i]->is_leaf && j.outputs[i])
+                outputs.push_back(i);
+        if (outputs.empty())
+            return {};
+        if (outputs.size() == 1)
+            return std::move(j.outputs[outputs.front()]);
+
+        // Frames the branches passed through untouched come out of several of them: keep one of each stream
+        std::vector< frame_holder > frames;
+        std::vector< int > streams;
+        auto add = [&](frame_interface* f)
+        {
+            auto uid = f->peek_stream()->get_unique_id();
+            if (std::find(streams.begin(), streams.end(), uid) != streams.end())
+                return;
+            streams.push_back(uid);
+            frames.push_back(frame_holder::acquire(f));
+        };
+        for (auto i : outputs)
+        {
+            auto f = j.outputs[i].frame;
+            if (auto composite = dynamic_cast< composite_frame* >(f))
+                for (size_t k = 0; k < composite->get_embedded_frames_count(); ++k)
+                    add(composite->get_frame(int(k)));
+            else
+                add(f);
+        }
+        return get_source().allocate_composite_frame(std::move(frames));
+    }
+}
@@ -0,0 +1,111 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "processing-thread-pool.h"
+#include "core/notification.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+
+
+namespace librealsense
+{
+    // Runs a tree of processing blocks on the shared thread pool: blocks on different branches, and successive frames
+    // through the same branch, are processed concurrently. Each block still sees one frame at a time, in order.
+    //
+    // The output for each input frame is the outputs of the leaf blocks, in one frameset when there are several, and
+    // comes out in the order of the input. Once 'max_in_flight' frames are being processed, invoke() waits for the
+    // oldest to come out.
+    //
+    // The blocks must output what they make of a frame from within their invoke(), as filters do (a syncer won't
+    // work), and are owned by the graph once added: their output goes to it.
+    //
+    // A load policy can be given as steps, each an option of a block to set or a block to skip: while the graph falls
+    // behind (frames wait for room, or a block is busy most of the time), the steps are taken one at a time, in order,
+    // and once it keeps up again they're undone in reverse. Each change is reported as a notification.
+    //
+    class processing_graph : public processing_block
+    {
+    public:
+        explicit processing_graph(int max_in_flight = 2);
+        ~processing_graph();
+
+        // Add a block fed by the output of 'parent', a previously returned index, or by the input of the graph with
+        // -1. Returns the index of the block. Blocks can only be added before the first frame.
+        int add_node(std::shared_ptr< processing_block_interface > const & block, int parent);
+
+        // Add a step to the load policy, before the first frame: set an option of a block (as returned by add_node)
+        // to a value, or pass the block's input on as its output. Returns the index of the step.
+        int add_load_step(int node, rs2_option option, float value);
+        int add_bypass_step(int node);
+
+        void set_notifications_callback(rs2_notifications_callback_sptr callback)
+        {
+            _notifications.set_callback(std::move(callback));
+        }
+
+    private:
+        struct node
+        {
+            std::shared_ptr< processing_block_interface > block;
+            int parent;
+            bool is_leaf = true;
+            bool busy = false;                  // Processing frame 'next'
+            unsigned long long next = 0;        // The sequence number of the next frame for it to process
+            frame_holder output;                // What the block output from within its invoke()
+            bool bypassed = false;              // By the load policy
+            std::chrono::steady_clock::duration busy_time{};  // Spent in invoke() in the current load window
+        };
+
+        struct load_step
+        {
+            int node;
+            bool bypass;
+            rs2_option option;
+            float value;
+            float previous = 0;                 // The option's value before the step was taken
+        };
+
+        struct job
+        {
+            frame_holder input;
+            std::vector< frame_holder > outputs;  // Per node
+            std::vector< bool > done;             // Per node
+            size_t remaining;                     // Nodes not yet done
+        };
+
+        // Marks the nodes that can run now as busy and returns them, with the sequence number of their frame
+        std::vector< std::pair< size_t, unsigned long long > > take_ready_nodes();
+        void run_node(size_t index, unsigned long long seq);
+        void schedule(std::vector< std::pair< size_t, unsigned long long > > const & ready);
+        void emit_done_jobs();
+        frame_holder make_output(job & j);
+        int add_step(load_step const & step);
+        // Called with each input frame, under the lock: the change in the number of steps taken, if any
+        int evaluate_load(bool waited);
+        void change_load_level(int change);
+
+        std::vector< std::unique_ptr< node > > _nodes;
+        std::deque< std::unique_ptr< job > > _jobs;       // In flight, in order
+        unsigned long long _first_seq = 0;               // Of _jobs.front()
+        size_t _max_in_flight;
+        int _running = 0;                                 // Nodes being run on the pool
+        std::mutex _graph_mutex;
+        std::mutex _emit_mutex;                           // Keeps the output in order
+        std::condition_variable _cv;
+        std::shared_ptr< processing_thread_pool > _thread_pool;
+
+        std::vector< load_step > _load_steps;
+        size_t _load_level = 0;                           // Steps taken
+        std::chrono::steady_clock::time_point _window_start;
+        int _window_frames = 0;
+        bool _window_waited = false;                      // A frame of the window had to wait for room
+        float _load = 0;                                  // Of the busiest block, over the last window
+        notifications_processor _notifications;
+    };
+    MAP_EXTENSION(RS2_EXTENSION_PROCESSING_GRAPH, librealsense::processing_graph);
+}
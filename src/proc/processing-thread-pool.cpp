@@ -0,0 +1,248 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "processing-thread-pool.h"
+
+#include <rsutils/shared-ptr-singleton.h>
+#include <rsutils/easylogging/easyloggingpp.h>
+#include <rsutils/json.h>
+#include <rsutils/os/thread.h>
+
+
+
+namespace librealsense {
+
+
+namespace {
+
+
+// The pool and index of the worker the current thread is, if any
+thread_local processing_thread_pool const * this_thread_pool = nullptr;
+thread_local size_t this_thread_index = 0;
+
+
+std::mutex & shared_config_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+
+processing_thread_pool::configuration & shared_config()
+{
+    static processing_thread_pool::configuration config;
+    return config;
+}
+
+
+}  // namespace
+
+
+struct processing_thread_pool::parallel_job
+{
+    size_t count;
+    int n_chunks;
+    std::function< void( size_t, size_t ) > const & fn;  // only used while parallel_for() waits
+    std::atomic< int > next{ 0 };
+    int done = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    parallel_job( size_t count_, int n_chunks_, std::function< void( size_t, size_t ) > const & fn_ )
+        : count( count_ )
+        , n_chunks( n_chunks_ )
+        , fn( fn_ )
+    {
+    }
+
+    // Take chunks until there are none left. Once 'next' runs past n_chunks, nothing touches 'fn' again, so a
+    // queued copy of the job that gets to run late is harmless.
+    void run()
+    {
+        for( int i = next++; i < n_chunks; i = next++ )
+        {
+            fn( count * i / n_chunks, count * ( i + 1 ) / n_chunks );
+            std::lock_guard< std::mutex > lock( mutex );
+            if( ++done == n_chunks )
+                cv.notify_all();
+        }
+    }
+};
+
+
+/*static*/ std::shared_ptr< processing_thread_pool > processing_thread_pool::instance()
+{
+    static rsutils::shared_ptr_singleton< processing_thread_pool > the_pool;
+    configuration config;
+    {
+        std::lock_guard< std::mutex > lock( shared_config_mutex() );
+        config = shared_config();
+    }
+    return the_pool.instance( config );
+}
+
+
+/*static*/ void processing_thread_pool::configure( rsutils::json const & settings )
+{
+    configuration config;
+    config.n_workers = settings.nested( "threads" ).default_value( config.n_workers );
+    config.cpus = settings.nested( "cpus" ).default_value( config.cpus );
+    auto priority = settings.nested( "priority" ).default_value< std::string >( "normal" );
+    if( priority == "low" )
+        config.priority = -1;
+    else if( priority == "high" )
+        config.priority = 1;
+    else if( priority != "normal" )
+        LOG_WARNING( "thread-pool: invalid priority '" << priority << "'; using 'normal'" );
+
+    std::lock_guard< std::mutex > lock( shared_config_mutex() );
+    shared_config() = config;
+}
+
+
+processing_thread_pool::processing_thread_pool( int n_workers )
+    : processing_thread_pool( [n_workers]() {
+        configuration config;
+        config.n_workers = n_workers;
+        return config;
+    }() )
+{
+}
+
+
+processing_thread_pool::processing_thread_pool( configuration const & config )
+{
+    auto n_workers = config.n_workers < 0 ? max_threads() - 1 : config.n_workers;
+    for( int i = 0; i < n_workers; ++i )
+        _queues.emplace_back( new worker_queue );
+    for( int i = 0; i < n_workers; ++i )
+        _workers.emplace_back( [this, i, config]() { work( i, config ); } );
+}
+
+
+processing_thread_pool::~processing_thread_pool()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _stopping = true;
+    }
+    _cv.notify_all();
+    for( auto & t : _workers )
+        t.join();
+}
+
+
+void processing_thread_pool::submit( std::function< void() > && task )
+{
+    if( _workers.empty() )
+        task();
+    else if( this_thread_pool == this )
+        push( this_thread_index, std::move( task ) );
+    else
+        push( _next_queue++ % _queues.size(), std::move( task ) );
+}
+
+
+void processing_thread_pool::parallel_for( size_t count, int n_chunks,
+                                           std::function< void( size_t, size_t ) > const & fn )
+{
+    n_chunks = int( std::min< size_t >( std::max( n_chunks, 1 ), count ) );
+    if( n_chunks <= 1 || _workers.empty() )
+    {
+        if( count )
+            fn( 0, count );
+        return;
+    }
+
+    // Spread over the queues, so each worker starts on its own chunk rather than stealing
+    auto job = std::make_shared< parallel_job >( count, n_chunks, fn );
+    for( int i = 1; i < n_chunks; ++i )
+        push( _next_queue++ % _queues.size(), [job]() { job->run(); } );
+
+    job->run();
+    std::unique_lock< std::mutex > lock( job->mutex );
+    job->cv.wait( lock, [&]() { return job->done == job->n_chunks; } );
+}
+
+
+void processing_thread_pool::push( size_t queue_index, std::function< void() > && task )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        ++_pending;
+    }
+    {
+        auto & q = *_queues[queue_index];
+        std::lock_guard< std::mutex > lock( q.mutex );
+        q.tasks.push_back( std::move( task ) );
+    }
+    _cv.notify_one();
+}
+
+
+bool processing_thread_pool::pop( size_t queue_index, std::function< void() > & task )
+{
+    // Our own newest task first: whatever it needs is the likeliest to still be in the cache
+    {
+        auto & q = *_queues[queue_index];
+        std::lock_guard< std::mutex > lock( q.mutex );
+        if( ! q.tasks.empty() )
+        {
+            task = std::move( q.tasks.back() );
+            q.tasks.pop_back();
+            return true;
+        }
+    }
+    // Otherwise steal the oldest of someone else's
+    for( size_t i = 1; i < _queues.size(); ++i )
+    {
+        auto & q = *_queues[( queue_index + i ) % _queues.size()];
+        std::lock_guard< std::mutex > lock( q.mutex );
+        if( ! q.tasks.empty() )
+        {
+            task = std::move( q.tasks.front() );
+            q.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void processing_thread_pool::work( size_t index, configuration const & config )
+{
+    this_thread_pool = this;
+    this_thread_index = index;
+
+    auto settings = rsutils::os::get_thread_settings( "processing" );
+    if( ! config.cpus.empty() )
+        settings.cpus = config.cpus;
+    if( config.priority )
+        settings.priority = config.priority;
+    if( settings.name.empty() )
+        settings.name = "rs-processing";
+    rsutils::os::apply_thread_settings( settings );
+
+    while( true )
+    {
+        std::function< void() > task;
+        if( pop( index, task ) )
+        {
+            {
+                std::lock_guard< std::mutex > lock( _mutex );
+                --_pending;
+            }
+            task();
+            continue;
+        }
+
+        // A task may be counted before it's in its queue, so we can wake up to find nothing and go around again
+        std::unique_lock< std::mutex > lock( _mutex );
+        if( _stopping && ! _pending )
+            return;
+        _cv.wait( lock, [this]() { return _stopping || _pending > 0; } );
+    }
+}
+
+
+}  // namespace librealsense
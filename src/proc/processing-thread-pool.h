@@ -0,0 +1,94 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <rsutils/json-fwd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace librealsense {
+
+
+// Worker threads shared by the processing blocks and anything else that has short, independent tasks to run,
+// rather than each owning threads of its own.
+//
+// Every worker has its own queue: tasks submitted from a worker go to the back of its queue and it takes them from
+// there, newest first, while idle workers steal the oldest tasks from the queues of the others.
+//
+// parallel_for() never depends on the workers being available: the calling thread keeps taking chunks itself until
+// none are left, so a busy (or even nested) pool only costs parallelism, never a deadlock.
+//
+class processing_thread_pool
+{
+public:
+    // How the workers are set up; the shared pool takes it from the "thread-pool" context settings. Whatever isn't set
+    // here comes from the settings of the "processing" thread role (see rsutils::os::init_thread).
+    struct configuration
+    {
+        int n_workers = -1;       // < 0 for one per hardware thread beyond the caller's
+        std::vector< int > cpus;  // The CPUs the workers may run on; empty for any
+        int priority = 0;         // < 0 below normal, > 0 above normal
+    };
+
+    // Process-wide pool. It goes away when the last one holding it lets go.
+    static std::shared_ptr< processing_thread_pool > instance();
+
+    // Set up the shared pool from settings of the form:
+    //     { "threads": 3, "cpus": [ 4, 5, 6, 7 ], "priority": "low" | "normal" | "high" }
+    // Takes effect when the pool is next created, i.e. not while anyone is holding it.
+    static void configure( rsutils::json const & settings );
+
+    static int max_threads() { return std::max( 1, int( std::thread::hardware_concurrency() ) ); }
+
+    explicit processing_thread_pool( int n_workers );
+    explicit processing_thread_pool( configuration const & );
+    ~processing_thread_pool();
+
+    processing_thread_pool( processing_thread_pool const & ) = delete;
+    processing_thread_pool & operator=( processing_thread_pool const & ) = delete;
+
+    size_t size() const { return _workers.size(); }
+
+    // Run the task on one of the workers, some time later. Tasks still queued when the pool is destroyed are run
+    // before it goes away. Without workers, the task is run right away by the caller.
+    void submit( std::function< void() > && task );
+
+    // Split [0, count) into 'n_chunks' contiguous ranges of about the same size and call fn( begin, end ) for each,
+    // returning once all are done. fn must be safe to call concurrently for distinct ranges.
+    void parallel_for( size_t count, int n_chunks, std::function< void( size_t, size_t ) > const & fn );
+
+private:
+    struct parallel_job;
+
+    struct worker_queue
+    {
+        std::mutex mutex;
+        std::deque< std::function< void() > > tasks;
+    };
+
+    void push( size_t queue_index, std::function< void() > && task );
+    bool pop( size_t queue_index, std::function< void() > & task );
+    void work( size_t index, configuration const & config );
+
+    std::vector< std::unique_ptr< worker_queue > > _queues;  // One per worker
+    std::vector< std::thread > _workers;
+    std::atomic< unsigned > _next_queue{ 0 };                // For spreading tasks from outside the pool
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    int _pending = 0;  // Tasks pushed and not yet taken; never less than what's actually in the queues
+    bool _stopping = false;
+};
+
+
+}  // namespace librealsense
@@ -6,61 +6,134 @@
 #include "../include/librealsense2/hpp/rs_sensor.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
 #include "context.h"
+#include "environment.h"
+#include "proc/output-profile-cache.h"
 #include "image.h"
 #include "stream.h"
 
+#if defined __SSSE3__ && ! defined ANDROID
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+
 namespace librealsense
 {
     //// Unpacking routines ////
+
+    // Source pixel (r, c) of a width x height image goes to row (width - 1 - c), column (height - 1 - r) of the
+    // output: it's a transpose with both axes flipped. The image is rotated in 8x8 tiles, transposed in registers
+    // where SSE is available, so that each tile's source and output rows are read and written whole.
+
+    // The 8x8 tile whose top-left source pixel is (r, c)
     template<size_t SIZE>
-    void rotate_image_optimized( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size)
+    static void rotate_tile( uint8_t * out, const uint8_t * source, int width, int height, int r, int c )
     {
-        auto width_out = height;
-        auto height_out = width;
-
-        auto out = dest[0];
-        uint8_t buffer[8][8 * SIZE]; // = { 0 };
-        for (int i = 0; i <= height - 8; i = i + 8)
+        // Source rows bottom-up, so that each transposed row comes out in output order
+        const uint8_t * in[8];
+        for( int k = 0; k < 8; ++k )
+            in[k] = source + ( size_t( r + 7 - k ) * width + c ) * SIZE;
+        uint8_t * to[8];
+        for( int q = 0; q < 8; ++q )
+            to[q] = out + ( size_t( width - 1 - c - q ) * height + ( height - 8 - r ) ) * SIZE;
+
+#if defined __SSSE3__ && ! defined ANDROID
+        if( SIZE == 1 )
         {
-            for (int j = 0; j <= width - 8; j = j + 8)
+            __m128i a[8];
+            for( int k = 0; k < 8; ++k )
+                a[k] = _mm_loadl_epi64( reinterpret_cast< const __m128i * >( in[k] ) );
+            __m128i b0 = _mm_unpacklo_epi8( a[0], a[1] ), b1 = _mm_unpacklo_epi8( a[2], a[3] );
+            __m128i b2 = _mm_unpacklo_epi8( a[4], a[5] ), b3 = _mm_unpacklo_epi8( a[6], a[7] );
+            __m128i c0 = _mm_unpacklo_epi16( b0, b1 ), c1 = _mm_unpackhi_epi16( b0, b1 );
+            __m128i c2 = _mm_unpacklo_epi16( b2, b3 ), c3 = _mm_unpackhi_epi16( b2, b3 );
+            // Two output rows in each
+            __m128i d[4] = { _mm_unpacklo_epi32( c0, c2 ), _mm_unpackhi_epi32( c0, c2 ),
+                             _mm_unpacklo_epi32( c1, c3 ), _mm_unpackhi_epi32( c1, c3 ) };
+            for( int q = 0; q < 4; ++q )
+            {
+                _mm_storel_epi64( reinterpret_cast< __m128i * >( to[2 * q] ), d[q] );
+                _mm_storel_epi64( reinterpret_cast< __m128i * >( to[2 * q + 1] ), _mm_unpackhi_epi64( d[q], d[q] ) );
+            }
+            return;
+        }
+        if( SIZE == 2 )
+        {
+            __m128i a[8];
+            for( int k = 0; k < 8; ++k )
+                a[k] = _mm_loadu_si128( reinterpret_cast< const __m128i * >( in[k] ) );
+            __m128i b[8];
+            for( int k = 0; k < 8; k += 2 )
+            {
+                b[k] = _mm_unpacklo_epi16( a[k], a[k + 1] );
+                b[k + 1] = _mm_unpackhi_epi16( a[k], a[k + 1] );
+            }
+            // Output rows q and q + 1 of the top half of the tile, then of the bottom half
+            __m128i c[8] = { _mm_unpacklo_epi32( b[0], b[2] ), _mm_unpackhi_epi32( b[0], b[2] ),
+                             _mm_unpacklo_epi32( b[1], b[3] ), _mm_unpackhi_epi32( b[1], b[3] ),
+                             _mm_unpacklo_epi32( b[4], b[6] ), _mm_unpackhi_epi32( b[4], b[6] ),
+                             _mm_unpacklo_epi32( b[5], b[7] ), _mm_unpackhi_epi32( b[5], b[7] ) };
+            for( int q = 0; q < 4; ++q )
             {
-                for (int ii = 0; ii < 8; ++ii)
-                {
-                    for (int jj = 0; jj < 8; ++jj)
-                    {
-                        auto source_index = ((j + jj) + (width * (i + ii))) * SIZE;
-                        memcpy((void*)(&buffer[7 - jj][(7 - ii) * SIZE]), &source[source_index], SIZE);
-                    }
-                }
-
-                for (int ii = 0; ii < 8; ++ii)
-                {
-                    auto out_index = (((height_out - 8 - j + 1) * width_out) - i - 8 + (ii)* width_out);
-                    memcpy(&out[(out_index)* SIZE], &(buffer[ii]), 8 * SIZE);
-                }
+                _mm_storeu_si128( reinterpret_cast< __m128i * >( to[2 * q] ), _mm_unpacklo_epi64( c[q], c[q + 4] ) );
+                _mm_storeu_si128( reinterpret_cast< __m128i * >( to[2 * q + 1] ), _mm_unpackhi_epi64( c[q], c[q + 4] ) );
             }
+            return;
         }
+#endif
+        uint8_t buffer[8][8 * SIZE];
+        for( int k = 0; k < 8; ++k )
+            for( int q = 0; q < 8; ++q )
+                std::memcpy( &buffer[q][k * SIZE], in[k] + q * SIZE, SIZE );
+        for( int q = 0; q < 8; ++q )
+            std::memcpy( to[q], buffer[q], 8 * SIZE );
     }
 
+    // Rotates source rows [first_row, last_row), first_row being a multiple of 8. The tiles are taken in blocks of
+    // 64x64 pixels, small enough for both their source and output rows to stay in cache, and whatever doesn't make a
+    // whole tile at the right and bottom edges is done pixel by pixel.
     template<size_t SIZE>
-    void rotate_image( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size)
+    static void rotate_rows( uint8_t * out, const uint8_t * source, int width, int height, int first_row, int last_row )
     {
-        auto width_out = height;
-        auto height_out = width;
+        const int block = 64;
+        const int tiled_rows = first_row + ( last_row - first_row ) / 8 * 8;
+        const int tiled_cols = width / 8 * 8;
+        for( int br = first_row; br < tiled_rows; br += block )
+            for( int bc = 0; bc < tiled_cols; bc += block )
+                for( int r = br; r < std::min( br + block, tiled_rows ); r += 8 )
+                    for( int c = bc; c < std::min( bc + block, tiled_cols ); c += 8 )
+                        rotate_tile< SIZE >( out, source, width, height, r, c );
+
+        auto rotate_pixel = [&]( int r, int c ) {
+            std::memcpy( out + ( size_t( width - 1 - c ) * height + ( height - 1 - r ) ) * SIZE,
+                         source + ( size_t( r ) * width + c ) * SIZE, SIZE );
+        };
+        for( int r = first_row; r < tiled_rows; ++r )
+            for( int c = tiled_cols; c < width; ++c )
+                rotate_pixel( r, c );
+        for( int r = tiled_rows; r < last_row; ++r )
+            for( int c = 0; c < width; ++c )
+                rotate_pixel( r, c );
+    }
 
-        auto out = dest[0];
-        for (int i = 0; i < height; ++i)
+    // With a pool and more than one thread, strips of source rows (i.e. of output columns) are rotated at the same
+    // time
+    template<size_t SIZE>
+    void rotate_image_optimized( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size,
+                                 processing_thread_pool * pool = nullptr, int threads = 1 )
+    {
+        auto strips = size_t( height / 8 );
+        if( ! pool || threads <= 1 || strips < 2 )
         {
-            auto row_offset = i * width;
-            for (int j = 0; j < width; ++j)
-            {
-                auto out_index = (((height_out - j) * width_out) - i - 1) * SIZE;
-                std::memcpy( &out[out_index], &( source[( row_offset + j ) * SIZE] ), SIZE );
-            }
+            rotate_rows< SIZE >( dest[0], source, width, height, 0, height );
+            return;
         }
+        pool->parallel_for( strips, threads, [&]( size_t begin, size_t end ) {
+            int last = end == strips ? height : int( end ) * 8;  // The last strip takes the rows that don't make a tile
+            rotate_rows< SIZE >( dest[0], source, width, height, int( begin ) * 8, last );
+        } );
     }
 
-    void rotate_confidence( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size)
+    void rotate_confidence( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size,
+                            processing_thread_pool * pool = nullptr, int threads = 1 )
     {
 #pragma pack (push, 1)
         struct lsb_msb
@@ -70,7 +143,7 @@ namespace librealsense
         };
 #pragma pack(pop)
 
-        rotate_image<1>(dest, source, width, height, actual_size);
+        rotate_image_optimized<1>(dest, source, width, height, actual_size, pool, threads);
         auto out = dest[0];
         for (int i = (width - 1), out_i = ((width - 1) * 2); i >= 0; --i, out_i -= 2)
         {
@@ -92,6 +165,7 @@ namespace librealsense
 
     rotation_transform::rotation_transform(const char* name, rs2_format target_format, rs2_stream target_stream, rs2_extension extension_type)
         : functional_processing_block(name, target_format, target_stream, extension_type)
+        , _thread_pool(processing_thread_pool::instance())
     {
         _stream_filter.format = _target_format;
         _stream_filter.stream = _target_stream;
@@ -103,13 +177,13 @@ namespace librealsense
         if (p.get() != _source_stream_profile.get())
         {
             _source_stream_profile = p;
-            _target_stream_profile = p.clone(p.stream_type(), p.stream_index(), _target_format);
-            _target_bpp = get_image_bpp(_target_format) / 8;
-
             // Set the unique ID as the original frame.
             // The frames are piped through a syncer and must have the origin UID.
-            auto target_spi = (stream_profile_interface*)_target_stream_profile.get()->profile;
-            target_spi->set_unique_id(p.unique_id());
+            auto uid = p.unique_id();
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(
+                { p.get()->profile, p.stream_type(), p.stream_index(), _target_format, "rotation" },
+                [uid](stream_profile_interface& target) { target.set_unique_id(uid); });
+            _target_bpp = get_image_bpp(_target_format) / 8;
         }
     }
 
@@ -120,10 +194,10 @@ namespace librealsense
         switch (_target_bpp)
         {
         case 1:
-            rotate_image_optimized<1>(dest, source, rotated_width, rotated_height, actual_size);
+            rotate_image_optimized<1>(dest, source, rotated_width, rotated_height, actual_size, _thread_pool.get(), get_thread_budget());
             break;
         case 2:
-            rotate_image_optimized<2>(dest, source, rotated_width, rotated_height, actual_size);
+            rotate_image_optimized<2>(dest, source, rotated_width, rotated_height, actual_size, _thread_pool.get(), get_thread_budget());
             break;
         default:
             LOG_ERROR("Rotation transform does not support format: " + std::string(rs2_format_to_string(_target_format)));
@@ -144,6 +218,6 @@ namespace librealsense
         int rotated_height = width;
 
         // Workaround: the height is given by bytes and not by pixels.
-        rotate_confidence(dest, source, rotated_width / 2, rotated_height, actual_size);
+        rotate_confidence(dest, source, rotated_width / 2, rotated_height, actual_size, _thread_pool.get(), get_thread_budget());
     }
 }
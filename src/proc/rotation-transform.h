@@ -4,6 +4,7 @@
 #pragma once
 
 #include "synthetic-stream.h"
+#include "processing-thread-pool.h"
 
 namespace librealsense
 {
@@ -17,6 +18,9 @@ namespace librealsense
     protected:
         void init_profiles_info(const rs2::frame* f) override;
         void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+
+        // Large frames are rotated on the processing pool, as many threads at a time as the conversion budget allows
+        std::shared_ptr< processing_thread_pool > _thread_pool;
     };
 
     class confidence_rotation_transform : public rotation_transform
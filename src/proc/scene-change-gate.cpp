@@ -0,0 +1,187 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "scene-change-gate.h"
+#include "option.h"
+#include <src/frame.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace librealsense
+{
+    // The grid of the compared pixels
+    const uint8_t step_min = 1;
+    const uint8_t step_max = 32;
+    const uint8_t step_default = 4;
+
+    // What a sample has to move by to count as changed: one 50th of the depth, or levels of 8-bit luminance
+    const int depth_ratio = 50;
+    const int luminance_levels = 12;
+
+    typedef uint16_t (*sample_reader)(const uint8_t* pixel);
+
+    static uint16_t read_z16(const uint8_t* p) { uint16_t z; memcpy(&z, p, sizeof(z)); return z; }
+    static uint16_t read_y16(const uint8_t* p) { return uint16_t(read_z16(p) >> 8); }
+    static uint16_t read_y8(const uint8_t* p) { return p[0]; }
+    static uint16_t read_uyvy(const uint8_t* p) { return p[1]; }
+    static uint16_t read_rgb(const uint8_t* p) { return uint16_t((p[0] + 2 * p[1] + p[2]) / 4); }
+
+    // How the samples of a format are read, and their size; no reader for the formats that can't be compared
+    static sample_reader reader_of(rs2_format format, int& bpp)
+    {
+        switch (format)
+        {
+        case RS2_FORMAT_Z16: bpp = 2; return read_z16;
+        case RS2_FORMAT_Y16: bpp = 2; return read_y16;
+        case RS2_FORMAT_Y8: bpp = 1; return read_y8;
+        case RS2_FORMAT_YUYV: bpp = 2; return read_y8;
+        case RS2_FORMAT_UYVY: bpp = 2; return read_uyvy;
+        case RS2_FORMAT_RGB8:
+        case RS2_FORMAT_BGR8: bpp = 3; return read_rgb;
+        case RS2_FORMAT_RGBA8:
+        case RS2_FORMAT_BGRA8: bpp = 4; return read_rgb;
+        default: return nullptr;
+        }
+    }
+
+    // Records what the gate found on a frame it let through, for find_metadata
+    static void mark(const rs2::frame& f, int change, uint32_t skipped)
+    {
+        if (auto fr = dynamic_cast<frame*>((frame_interface*)f.get()))
+        {
+            fr->additional_data.scene_change = change;
+            fr->additional_data.skipped_frames = skipped;
+        }
+    }
+
+    scene_change_gate::scene_change_gate()
+        : processing_block("Scene Change Gate")
+        , _threshold(1.f)
+        , _keep_alive(1000.f)
+        , _step(step_default)
+    {
+        register_option(RS2_OPTION_SCENE_CHANGE_THRESHOLD,
+            std::make_shared<ptr_option<float>>(0.f, 100.f, 0.1f, 1.f, &_threshold,
+                "Percentage of the compared pixels that must have changed for a frame to go through"));
+        register_option(RS2_OPTION_SCENE_CHANGE_KEEP_ALIVE,
+            std::make_shared<ptr_option<float>>(0.f, 60000.f, 1.f, 1000.f, &_keep_alive,
+                "A frame goes through after this many ms without one, changed or not; 0 for never"));
+        register_option(RS2_OPTION_FILTER_MAGNITUDE,
+            std::make_shared<ptr_option<uint8_t>>(step_min, step_max, uint8_t(1), step_default, &_step,
+                "Pixels are compared every this many in each direction"));
+
+        auto on_frame = [this](rs2::frame f, const rs2::frame_source& source)
+        {
+            auto gated = find_gated(f);
+            if (gated)
+            {
+                int change = 0;
+                uint32_t skipped = 0;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (!pass(gated, change, skipped))
+                        return;
+                }
+                if (auto set = f.as<rs2::frameset>())
+                    set.foreach_rs([&](const rs2::frame& sf) { mark(sf, change, skipped); });
+                else
+                    mark(f, change, skipped);
+            }
+            source.frame_ready(f);
+        };
+        auto callback = new rs2::frame_processor_callback<decltype(on_frame)>(on_frame);
+        processing_block::set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(callback));
+    }
+
+    rs2::frame scene_change_gate::find_gated(const rs2::frame& f)
+    {
+        int bpp;
+        auto comparable = [&](const rs2::frame& sf)
+        {
+            return sf.is<rs2::video_frame>() && reader_of(sf.get_profile().format(), bpp);
+        };
+
+        auto set = f.as<rs2::frameset>();
+        if (!set)
+            return comparable(f) ? f : rs2::frame();
+
+        rs2::frame first;
+        for (auto sf : set)
+        {
+            if (!comparable(sf))
+                continue;
+            if (sf.get_profile().format() == RS2_FORMAT_Z16)
+                return sf;
+            if (!first)
+                first = sf;
+        }
+        return first;
+    }
+
+    bool scene_change_gate::pass(const rs2::video_frame& f, int& change, uint32_t& skipped)
+    {
+        const auto format = f.get_profile().format();
+        int bpp = 0;
+        auto read = reader_of(format, bpp);
+
+        const int w = f.get_width(), h = f.get_height(), stride = f.get_stride_in_bytes();
+        const int step = std::max(int(_step), 1);
+        auto data = reinterpret_cast<const uint8_t*>(f.get_data());
+        _samples.clear();
+        for (int y = 0; y < h; y += step)
+        {
+            auto row = data + size_t(y) * stride;
+            for (int x = 0; x < w; x += step)
+                _samples.push_back(read(row + size_t(x) * bpp));
+        }
+
+        auto& s = _streams[f.get_profile().unique_id()];
+        const double timestamp = f.get_timestamp();
+        bool restart = s.width != w || s.height != h || s.format != format || s.reference.size() != _samples.size()
+                    || timestamp < s.last_passed;
+
+        change = 1000;
+        if (!restart)
+        {
+            size_t compared = 0, changed = 0;
+            if (format == RS2_FORMAT_Z16)
+            {
+                for (size_t i = 0; i < _samples.size(); ++i)
+                {
+                    const int was = s.reference[i], is = _samples[i];
+                    if (!was || !is)
+                        continue;
+                    ++compared;
+                    if (std::abs(is - was) * depth_ratio > was)
+                        ++changed;
+                }
+            }
+            else
+            {
+                compared = _samples.size();
+                for (size_t i = 0; i < _samples.size(); ++i)
+                    if (std::abs(int(_samples[i]) - int(s.reference[i])) > luminance_levels)
+                        ++changed;
+            }
+            change = compared ? int(changed * 1000 / compared) : 0;
+
+            bool due = _keep_alive > 0 && timestamp - s.last_passed >= _keep_alive;
+            if (change < _threshold * 10 && !due)
+            {
+                ++s.skipped;
+                return false;
+            }
+        }
+
+        s.width = w;
+        s.height = h;
+        s.format = format;
+        s.reference.swap(_samples);
+        s.last_passed = timestamp;
+        skipped = restart ? 0 : s.skipped;
+        s.skipped = 0;
+        return true;
+    }
+}
@@ -0,0 +1,51 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+// Holds back the frames that show nothing new, so the blocks after it don't redo the work of the last one.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+#include <map>
+
+namespace librealsense
+{
+    // A frame is let through when enough of the pixels of a sparse grid (every RS2_OPTION_FILTER_MAGNITUDE pixels in
+    // each direction) changed since the last frame of its stream that was let through: more than 2% of the depth, for
+    // depth, or more than 12 levels of the luminance, for the other formats. Pixels without depth, in either frame,
+    // are left out of the count. A frame is let through regardless once RS2_OPTION_SCENE_CHANGE_KEEP_ALIVE ms passed
+    // since the last, and when the stream or its resolution changes.
+    // The frames let through carry what the gate measured and the frames it held back before them, as the
+    // RS2_FRAME_METADATA_SCENE_CHANGE and RS2_FRAME_METADATA_SKIPPED_FRAMES metadata. A frameset goes through or is held
+    // back whole, by the first depth frame in it, or the first other video frame it can be compared by. Frames of
+    // other kinds are let through as they are.
+    class scene_change_gate : public processing_block
+    {
+    public:
+        scene_change_gate();
+
+    private:
+        struct stream_state
+        {
+            int width = 0, height = 0;
+            rs2_format format = RS2_FORMAT_ANY;
+            std::vector<uint16_t> reference;    // The samples of the last frame let through
+            double last_passed = 0;             // Its timestamp, in ms
+            uint32_t skipped = 0;               // The frames held back since
+        };
+
+        // The frame the set is let through or held back by, if there's one
+        static rs2::frame find_gated(const rs2::frame& f);
+
+        // Whether f, a frame find_gated() chose, is to go through; if so, also the thousandths of the samples that
+        // changed and the frames skipped before it, for its metadata
+        bool pass(const rs2::video_frame& f, int& change, uint32_t& skipped);
+
+        float _threshold;       // In percent of the compared samples
+        float _keep_alive;      // In ms; 0 to never let a frame through for the time alone
+        uint8_t _step;          // Between the samples, in pixels
+        std::vector<uint16_t> _samples;
+        std::map<int, stream_state> _streams;   // By unique id
+    };
+    MAP_EXTENSION(RS2_EXTENSION_SCENE_CHANGE_GATE, librealsense::scene_change_gate);
+}
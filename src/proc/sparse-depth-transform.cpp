@@ -0,0 +1,72 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "proc/sparse-depth-transform.h"
+#include "proc/output-profile-cache.h"
+#include "core/depth-frame.h"
+#include "environment.h"
+
+#include <rsutils/sparse-depth.h>
+
+namespace librealsense
+{
+    sparse_depth_transform::sparse_depth_transform(bool transform_to_sparse)
+        : generic_processing_block(transform_to_sparse ? "Depth to Sparse Depth" : "Sparse Depth to Depth"),
+        _transform_to_sparse(transform_to_sparse)
+    {
+        unregister_option(RS2_OPTION_FRAMES_QUEUE_SIZE);
+    }
+
+    bool sparse_depth_transform::should_process(const rs2::frame& frame)
+    {
+        if (!frame || frame.is<rs2::frameset>() || !frame.is<rs2::depth_frame>())
+            return false;
+
+        return frame.get_profile().format() == (_transform_to_sparse ? RS2_FORMAT_Z16 : RS2_FORMAT_Z16_SPARSE);
+    }
+
+    rs2::frame sparse_depth_transform::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        if (f.get_profile().get() != _source_stream_profile.get())
+        {
+            _source_stream_profile = f.get_profile();
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(
+                _source_stream_profile, RS2_STREAM_DEPTH, _source_stream_profile.stream_index(),
+                _transform_to_sparse ? RS2_FORMAT_Z16_SPARSE : RS2_FORMAT_Z16);
+        }
+
+        auto src = f.as<rs2::video_frame>();
+        auto width = uint32_t(src.get_width());
+        auto height = uint32_t(src.get_height());
+        if (!width || !height)
+            return f;
+
+        rs2::frame tgt;
+        if (_transform_to_sparse)
+        {
+            auto pixels = static_cast<const uint16_t*>(src.get_data());
+            size_t stride = src.get_stride_in_bytes();
+            auto size = rsutils::sparse_depth::encoded_size(pixels, width, height, stride);
+            tgt = source.allocate_video_frame(_target_stream_profile, f, 2, int(width), int(height),
+                int((size + height - 1) / height), RS2_EXTENSION_DEPTH_FRAME);
+            if (!tgt)
+                return tgt;
+            // Otherwise, holding on to the sparse frame would hold on to the dense one
+            ((depth_frame*)tgt.get())->set_original({});
+            auto out = static_cast<uint8_t*>(const_cast<void*>(tgt.get_data()));
+            auto written = rsutils::sparse_depth::encode(pixels, width, height, stride, out);
+            std::fill(out + written, out + size_t(tgt.as<rs2::video_frame>().get_stride_in_bytes()) * height, uint8_t(0));
+        }
+        else
+        {
+            tgt = source.allocate_video_frame(_target_stream_profile, f, 2, int(width), int(height), int(width * 2),
+                RS2_EXTENSION_DEPTH_FRAME);
+            if (!tgt)
+                return tgt;
+            if (!rsutils::sparse_depth::decode(static_cast<const uint8_t*>(src.get_data()), src.get_data_size(),
+                    static_cast<uint16_t*>(const_cast<void*>(tgt.get_data())), width, height))
+                throw invalid_value_exception("corrupt sparse depth frame");
+        }
+        return tgt;
+    }
+}
@@ -0,0 +1,28 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+// Converts Z16 depth to sparse depth, only its valid pixels, and back.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+namespace librealsense
+{
+    // The sparse frames are RS2_FORMAT_Z16_SPARSE depth frames of the same dimensions and intrinsics, coded as in
+    // rsutils/sparse-depth.h: their stride is whatever makes room for the valid pixels, and they don't hold on to the
+    // dense frame they were made of. get_distance() and the pointcloud read them in place.
+    class sparse_depth_transform : public generic_processing_block
+    {
+    public:
+        sparse_depth_transform(bool transform_to_sparse);
+
+        bool should_process(const rs2::frame& frame) override;
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        bool                    _transform_to_sparse;
+        rs2::stream_profile     _source_stream_profile;
+        rs2::stream_profile     _target_stream_profile;
+    };
+    MAP_EXTENSION(RS2_EXTENSION_SPARSE_DEPTH_TRANSFORM, librealsense::sparse_depth_transform);
+}
@@ -8,6 +8,11 @@
 #include "proc/synthetic-stream.h"
 #include "proc/hole-filling-filter.h"
 #include "proc/spatial-filter.h"
+#include "proc/output-profile-cache.h"
+
+#ifdef RS2_USE_CUDA
+#include "proc/cuda/cuda-depth-filters.h"
+#endif
 
 #include <librealsense2/hpp/rs_sensor.hpp>
 #include <librealsense2/hpp/rs_processing.hpp>
@@ -52,6 +57,20 @@ namespace librealsense
     const uint8_t holes_fill_step = 1;
     const uint8_t holes_fill_def = sp_hf_disabled;
 
+    // The number of threads the passes are split across
+    const uint8_t threads_min = 1;
+    const uint8_t threads_step = 1;
+    const uint8_t threads_def = 1;
+
+    std::shared_ptr<spatial_filter> spatial_filter::create()
+    {
+        #ifdef RS2_USE_CUDA
+            return std::make_shared<librealsense::spatial_filter_cuda>();
+        #else
+            return std::make_shared<librealsense::spatial_filter>();
+        #endif
+    }
+
     spatial_filter::spatial_filter() :
         depth_processing_block("Spatial Filter"),
         _spatial_alpha_param(alpha_default_val),
@@ -64,7 +83,8 @@ namespace librealsense
         _focal_lenght_mm(0.f),
         _stereo_baseline_mm(0.f),
         _holes_filling_mode(holes_fill_def),
-        _holes_filling_radius(0)
+        _holes_filling_radius(0),
+        _threads(threads_def)
     {
         _stream_filter.stream = RS2_STREAM_DEPTH;
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -157,6 +177,16 @@ namespace librealsense
         register_option(RS2_OPTION_FILTER_SMOOTH_DELTA, spatial_filter_delta);
         register_option(RS2_OPTION_FILTER_MAGNITUDE, spatial_filter_iterations);
         register_option(RS2_OPTION_HOLES_FILL, holes_filling_mode);
+
+        auto threads = std::make_shared<ptr_option<uint8_t>>(
+            threads_min,
+            uint8_t(std::min(processing_thread_pool::max_threads(), 255)),
+            threads_step,
+            threads_def,
+            &_threads, "Number of threads to split the filter passes across");
+        register_option(RS2_OPTION_FILTER_THREADS, threads);
+
+        register_roi_options();
     }
 
     rs2::frame spatial_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
@@ -164,14 +194,27 @@ namespace librealsense
         rs2::frame tgt;
 
         update_configuration(f);
-        tgt = prepare_target_frame(f, source);
+        auto roi = get_roi(f, int(_width), int(_height));
+        tgt = prepare_target_frame(f, source, roi);
 
-        // Spatial domain transform edge-preserving filter
-        if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
-            dxf_smooth<float>(const_cast<void*>(tgt.get_data()), _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
-        else
-            dxf_smooth<uint16_t>(const_cast<void*>(tgt.get_data()), _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+        // With a region of interest, the filter runs on a compact copy of it
+        const bool full = is_full_roi(roi, int(_width), int(_height));
+        void* data = full ? const_cast<void*>(tgt.get_data()) : _roi_image.data();
+        size_t width = full ? _width : roi_width(roi);
+        size_t height = full ? _height : roi_height(roi);
 
+        // Spatial domain transform edge-preserving filter; the passes need a couple of pixels each way
+        if (width > 2 && height > 2)
+        {
+            if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
+                dxf_smooth<float>(data, width, height, _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+            else
+                dxf_smooth<uint16_t>(data, width, height, _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+        }
+
+        if (!full)
+            insert_roi(const_cast<void*>(tgt.get_data()), data, int(_width), int(_height), int(_bpp), roi);
+        set_roi(tgt, roi, int(_width), int(_height));
         return tgt;
     }
 
@@ -180,7 +223,8 @@ namespace librealsense
         if (f.get_profile().get() != _source_stream_profile.get())
         {
             _source_stream_profile = f.get_profile();
-            _target_stream_profile = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(
+                _source_stream_profile, RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
 
             _extension_type = f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
             _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
@@ -229,30 +273,48 @@ namespace librealsense
         }
     }
 
-    rs2::frame spatial_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source)
+    rs2::frame spatial_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source, const region_of_interest& roi)
     {
-        // Allocate and copy the content of the original Depth data to the target
+        // Allocate and copy the content of the original Depth data to the target, or only the region of interest aside
         rs2::frame tgt = source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height), int(_stride), _extension_type);
 
-        memmove(const_cast<void*>(tgt.get_data()), f.get_data(), _current_frm_size_pixels * _bpp);
+        if (is_full_roi(roi, int(_width), int(_height)))
+            memmove(const_cast<void*>(tgt.get_data()), f.get_data(), _current_frm_size_pixels * _bpp);
+        else
+        {
+            _roi_image.resize(size_t(roi_width(roi)) * roi_height(roi) * _bpp);
+            extract_roi(_roi_image.data(), f.get_data(), int(_width), int(_bpp), roi);
+        }
         return tgt;
     }
 
-    void spatial_filter::recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ)
+    void spatial_filter::for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn)
+    {
+        if (_threads <= 1)
+        {
+            fn(0, count);
+            return;
+        }
+        if (!_thread_pool)
+            _thread_pool = processing_thread_pool::instance();
+        _thread_pool->parallel_for(count, _threads, fn);
+    }
+
+    void spatial_filter::recursive_filter_horizontal_fp(void * image_data, size_t width, float alpha, float deltaZ, size_t row_begin, size_t row_end)
     {
         float *image = reinterpret_cast<float*>(image_data);
 
         int v, u;
 
-        for (v = 0; v < _height;) {
+        for (v = int(row_begin); v < int(row_end);) {
             // left to right
-            float *im = image + v * _width;
+            float *im = image + v * width;
             float state = *im;
             float previousInnovation = state;
 
             im++;
             float innovation = *im;
-            u = int(_width) - 1;
+            u = int(width) - 1;
             if (!(*(int*)&previousInnovation > 0))
                 goto CurrentlyInvalidLR;
             // else fall through
@@ -307,9 +369,9 @@ namespace librealsense
         DoneLR:
 
             // right to left
-            im = image + (v + 1) * _width - 2;  // end of row - two pixels
+            im = image + (v + 1) * width - 2;  // end of row - two pixels
             previousInnovation = state = im[1];
-            u = int(_width) - 1;
+            u = int(width) - 1;
             innovation = *im;
             if (!(*(int*)&previousInnovation > 0))
                 goto CurrentlyInvalidRL;
@@ -366,7 +428,7 @@ namespace librealsense
         }
     }
 
-    void spatial_filter::recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ)
+    void spatial_filter::recursive_filter_vertical_fp(void * image_data, size_t width, size_t height, float alpha, float deltaZ, size_t col_begin, size_t col_end)
     {
         float *image = reinterpret_cast<float*>(image_data);
 
@@ -374,14 +436,14 @@ namespace librealsense
 
         // we'll do one column at a time, top to bottom, bottom to top, left to right,
 
-        for (u = 0; u < _width;) {
+        for (u = int(col_begin); u < int(col_end);) {
 
             float *im = image + u;
             float state = im[0];
             float previousInnovation = state;
 
-            v = int(_height) - 1;
-            im += _width;
+            v = int(height) - 1;
+            im += width;
             float innovation = *im;
 
             if (!(*(int*)&previousInnovation > 0))
@@ -405,7 +467,7 @@ namespace librealsense
                     if (v <= 0)
                         goto DoneTB;
                     previousInnovation = innovation;
-                    im += _width;
+                    im += width;
                     innovation = *im;
                 }
                 else {  // switch to CurrentlyInvalid state
@@ -413,7 +475,7 @@ namespace librealsense
                     if (v <= 0)
                         goto DoneTB;
                     previousInnovation = innovation;
-                    im += _width;
+                    im += width;
                     innovation = *im;
                     goto CurrentlyInvalidTB;
                 }
@@ -426,22 +488,22 @@ namespace librealsense
                     goto DoneTB;
                 if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
                     previousInnovation = state = innovation;
-                    im += _width;
+                    im += width;
                     innovation = *im;
                     goto CurrentlyValidTB;
                 }
                 else {
-                    im += _width;
+                    im += width;
                     innovation = *im;
                 }
             }
         DoneTB:
 
-            im = image + u + (_height - 2) * _width;
-            state = im[_width];
+            im = image + u + (height - 2) * width;
+            state = im[width];
             previousInnovation = state;
             innovation = *im;
-            v = int(_height) - 1;
+            v = int(height) - 1;
             if (!(*(int*)&previousInnovation > 0))
                 goto CurrentlyInvalidBT;
             // else fall through
@@ -462,7 +524,7 @@ namespace librealsense
                     if (v <= 0)
                         goto DoneBT;
                     previousInnovation = innovation;
-                    im -= _width;
+                    im -= width;
                     innovation = *im;
                 }
                 else {  // switch to CurrentlyInvalid state
@@ -470,7 +532,7 @@ namespace librealsense
                     if (v <= 0)
                         goto DoneBT;
                     previousInnovation = innovation;
-                    im -= _width;
+                    im -= width;
                     innovation = *im;
                     goto CurrentlyInvalidBT;
                 }
@@ -483,12 +545,12 @@ namespace librealsense
                     goto DoneBT;
                 if (*(int*)&innovation > 0) { // switch to CurrentlyValid state
                     previousInnovation = state = innovation;
-                    im -= _width;
+                    im -= width;
                     innovation = *im;
                     goto CurrentlyValidBT;
                 }
                 else {
-                    im -= _width;
+                    im -= width;
                     innovation = *im;
                 }
             }
@@ -12,51 +12,60 @@
 
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
+#include "processing-thread-pool.h"
 
 namespace librealsense
 {
     class spatial_filter : public depth_processing_block
     {
     public:
+        // The CUDA implementation when there is one
+        static std::shared_ptr<spatial_filter> create();
+
         spatial_filter();
 
     protected:
         void    update_configuration(const rs2::frame& f);
 
-        rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
+        rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source, const region_of_interest& roi);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
         template <typename T>
-        void dxf_smooth(void *frame_data, float alpha, float delta, int iterations)
+        void dxf_smooth(void *frame_data, size_t width, size_t height, float alpha, float delta, int iterations)
         {
             static_assert((std::is_arithmetic<T>::value), "Spatial filter assumes numeric types");
             const bool fp = (std::is_floating_point<T>::value);
 
+            // Each horizontal pass is independent per row and each vertical pass per column, so they're split
+            // into bands of rows/columns across the threads
             for (int i = 0; i < iterations; i++)
             {
                 if (fp)
                 {
-                    recursive_filter_horizontal_fp(frame_data, alpha, delta);
-                    recursive_filter_vertical_fp(frame_data, alpha, delta);
+                    for_each_band(height, [&](size_t begin, size_t end) { recursive_filter_horizontal_fp(frame_data, width, alpha, delta, begin, end); });
+                    for_each_band(width, [&](size_t begin, size_t end) { recursive_filter_vertical_fp(frame_data, width, height, alpha, delta, begin, end); });
                 }
                 else
                 {
-                    recursive_filter_horizontal<T>(frame_data, alpha, delta);
-                    recursive_filter_vertical<T>(frame_data, alpha, delta);
+                    for_each_band(height, [&](size_t begin, size_t end) { recursive_filter_horizontal<T>(frame_data, width, alpha, delta, begin, end); });
+                    for_each_band(width, [&](size_t begin, size_t end) { recursive_filter_vertical<T>(frame_data, width, height, alpha, delta, begin, end); });
                 }
             }
 
             // Disparity domain hole filling requires a second pass over the frame data
             // For depth domain a more efficient in-place hole filling is performed
             if (_holes_filling_mode && fp)
-                intertial_holes_fill<T>(static_cast<T*>(frame_data));
+                for_each_band(height, [&](size_t begin, size_t end) { intertial_holes_fill<T>(static_cast<T*>(frame_data), width, begin, end); });
         }
 
-        void recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ);
-        void recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ);
+        // Calls fn(begin, end) over bands of [0, count), on as many threads as the threads option allows
+        void for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn);
+
+        void recursive_filter_horizontal_fp(void * image_data, size_t width, float alpha, float deltaZ, size_t row_begin, size_t row_end);
+        void recursive_filter_vertical_fp(void * image_data, size_t width, size_t height, float alpha, float deltaZ, size_t col_begin, size_t col_end);
 
         template <typename T>
-        void  recursive_filter_horizontal(void * image_data, float alpha, float deltaZ)
+        void  recursive_filter_horizontal(void * image_data, size_t width, float alpha, float deltaZ, size_t row_begin, size_t row_end)
         {
             size_t v{}, u{};
 
@@ -72,14 +81,14 @@ namespace librealsense
             auto image = reinterpret_cast<T*>(image_data);
             size_t cur_fill = 0;
 
-            for (v = 0; v < _height; v++)
+            for (v = row_begin; v < row_end; v++)
             {
                 // left to right
-                T *im = image + v * _width;
+                T *im = image + v * width;
                 T val0 = im[0];
                 cur_fill = 0;
 
-                for (u = 1; u < _width - 1; u++)
+                for (u = 1; u < width - 1; u++)
                 {
                     T val1 = im[1];
 
@@ -112,11 +121,11 @@ namespace librealsense
                 }
 
                 // right to left
-                im = image + (v + 1) * _width - 2;  // end of row - two pixels
+                im = image + (v + 1) * width - 2;  // end of row - two pixels
                 T val1 = im[1];
                 cur_fill = 0;
 
-                for (u = _width - 1; u > 0; u--)
+                for (u = width - 1; u > 0; u--)
                 {
                     T val0 = im[0];
 
@@ -151,7 +160,7 @@ namespace librealsense
         }
 
         template <typename T>
-        void recursive_filter_vertical(void * image_data, float alpha, float deltaZ)
+        void recursive_filter_vertical(void * image_data, size_t width, size_t height, float alpha, float deltaZ, size_t col_begin, size_t col_end)
         {
             size_t v{}, u{};
 
@@ -170,15 +179,16 @@ namespace librealsense
 
             // top to bottom
 
-            T *im = image;
+            T *im;
             T im0{};
             T imw{};
-            for (v = 1; v < _height; v++)
+            for (v = 1; v < height; v++)
             {
-                for (u = 0; u < _width; u++)
+                im = image + (v - 1) * width + col_begin;
+                for (u = col_begin; u < col_end; u++)
                 {
                     im0 = im[0];
-                    imw = im[_width];
+                    imw = im[width];
 
                     //if ((fabs(im0) >= valid_threshold) && (fabs(imw) >= valid_threshold))
                     {
@@ -186,7 +196,7 @@ namespace librealsense
                         if (diff < delta_z)
                         {
                             float filtered = imw * alpha + im0 * (1.f - alpha);
-                            im[_width] = static_cast<T>(filtered + round);
+                            im[width] = static_cast<T>(filtered + round);
                         }
                     }
                     im += 1;
@@ -194,13 +204,13 @@ namespace librealsense
             }
 
             // bottom to top
-            im = image + (_height - 2) * _width;
-            for (v = 1; v < _height; v++, im -= (_width * 2))
+            for (v = 1; v < height; v++)
             {
-                for (u = 0; u < _width; u++)
+                im = image + (height - 1 - v) * width + col_begin;
+                for (u = col_begin; u < col_end; u++)
                 {
                     im0 = im[0];
-                    imw = im[_width];
+                    imw = im[width];
 
                     if ((fabs(im0) >= valid_threshold) && (fabs(imw) >= valid_threshold))
                     {
@@ -217,7 +227,7 @@ namespace librealsense
         }
 
         template<typename T>
-        inline void intertial_holes_fill(T* image_data)
+        inline void intertial_holes_fill(T* image_data, size_t width, size_t row_begin, size_t row_end)
         {
             std::function<bool(T*)> fp_oper = [](T* ptr) { return !*((int *)ptr); };
             std::function<bool(T*)> uint_oper = [](T* ptr) { return !(*ptr); };
@@ -225,14 +235,14 @@ namespace librealsense
 
             size_t cur_fill = 0;
 
-            T* p = image_data;
-            for (int j = 0; j < _height; ++j)
+            T* p = image_data + row_begin * width;
+            for (size_t j = row_begin; j < row_end; ++j)
             {
                 ++p;
                 cur_fill = 0;
 
                 //Left to Right
-                for (size_t i = 1; i < _width; ++i)
+                for (size_t i = 1; i < width; ++i)
                 {
                     if (empty(p))
                     {
@@ -248,7 +258,7 @@ namespace librealsense
                 --p;
                 cur_fill = 0;
                 //Right to left
-                for (size_t i = 1; i < _width; ++i)
+                for (size_t i = 1; i < width; ++i)
                 {
                     if (empty(p))
                     {
@@ -259,11 +269,13 @@ namespace librealsense
                         cur_fill = 0;
                     --p;
                 }
-                p += _width;
+                p += width;
             }
         }
 
     private:
+        friend class depth_pipeline;
+        friend class spatial_filter_cuda;
 
         float                   _spatial_alpha_param;
         uint8_t                 _spatial_delta_param;
@@ -280,6 +292,9 @@ namespace librealsense
         float                   _stereo_baseline_mm;
         uint8_t                 _holes_filling_mode;
         uint8_t                 _holes_filling_radius;
+        uint8_t                 _threads;
+        std::shared_ptr<processing_thread_pool> _thread_pool;
+        std::vector<uint8_t>    _roi_image;                 // The region of interest, when there's one
     };
     MAP_EXTENSION(RS2_EXTENSION_SPATIAL_FILTER, librealsense::spatial_filter);
 }
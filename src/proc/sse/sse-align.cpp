@@ -1,16 +1,25 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2019 Intel Corporation. All Rights Reserved.
-#ifdef __SSSE3__
+#if defined(__SSSE3__) || (defined(__aarch64__) && defined(__ARM_NEON))
 
 #include "sse-align.h"
+#include "sse-avx.h"
+#ifdef __SSSE3__
 #include <tmmintrin.h> // For SSE3 intrinsic used in unpack_yuy2_sse
+#else
+#include <arm_neon.h>
+#endif
 #include "../include/librealsense2/hpp/rs_sensor.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
 
 #include "core/video.h"
 #include "proc/synthetic-stream.h"
 #include "environment.h"
+#include "option.h"
 #include "stream.h"
+#include <src/pose.h>
+
+#include <limits>
 
 using namespace librealsense;
 
@@ -24,6 +33,8 @@ bool is_special_resolution(const rs2_intrinsics& depth, const rs2_intrinsics& to
     return false;
 }
 
+#ifdef __SSSE3__
+
 template<rs2_distortion dist>
 inline void distorte_x_y(const __m128 & x, const __m128 & y, __m128 * distorted_x, __m128 * distorted_y, const rs2_intrinsics& to)
 {
@@ -52,7 +63,35 @@ inline void distorte_x_y<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(const __m128& x,
     auto d_x0 = _mm_add_ps(x_f0, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[2], _mm_mul_ps(x_f0, y_f0))), r4_0));
 
     auto r5_0 = _mm_mul_ps(c[2], _mm_add_ps(r2_0, _mm_mul_ps(two, _mm_mul_ps(y_f0, y_f0))));
-    auto d_y0 = _mm_add_ps(y_f0, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[3], _mm_mul_ps(x_f0, y_f0))), r4_0));
+    auto d_y0 = _mm_add_ps(y_f0, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[3], _mm_mul_ps(x_f0, y_f0))), r5_0));
+
+    *distorted_x = d_x0;
+    *distorted_y = d_y0;
+}
+template<>
+inline void distorte_x_y<RS2_DISTORTION_BROWN_CONRADY>(const __m128& x, const __m128& y, __m128* distorted_x, __m128* distorted_y, const rs2_intrinsics& to)
+{
+    __m128 c[5];
+    auto one = _mm_set_ps1(1);
+    auto two = _mm_set_ps1(2);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        c[i] = _mm_set_ps1(to.coeffs[i]);
+    }
+    auto r2_0 = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+    auto r3_0 = _mm_add_ps(_mm_mul_ps(c[1], _mm_mul_ps(r2_0, r2_0)), _mm_mul_ps(c[4], _mm_mul_ps(r2_0, _mm_mul_ps(r2_0, r2_0))));
+    auto f_0 = _mm_add_ps(one, _mm_add_ps(_mm_mul_ps(c[0], r2_0), r3_0));
+
+    auto x_f0 = _mm_mul_ps(x, f_0);
+    auto y_f0 = _mm_mul_ps(y, f_0);
+
+    // Unlike the modified model, the tangential part is based on the undistorted point
+    auto r4_0 = _mm_mul_ps(c[3], _mm_add_ps(r2_0, _mm_mul_ps(two, _mm_mul_ps(x, x))));
+    auto d_x0 = _mm_add_ps(x_f0, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[2], _mm_mul_ps(x, y))), r4_0));
+
+    auto r5_0 = _mm_mul_ps(c[2], _mm_add_ps(r2_0, _mm_mul_ps(two, _mm_mul_ps(y, y))));
+    auto d_y0 = _mm_add_ps(y_f0, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[3], _mm_mul_ps(x, y))), r5_0));
 
     *distorted_x = d_x0;
     *distorted_y = d_y0;
@@ -191,8 +230,142 @@ inline void get_texture_map_sse(const uint16_t * depth,
         _mm_stream_si128(&res[1], res2_int1);
         res += 2;
     }
+    // The stores above are non-temporal: make sure they are done before another thread reads the map
+    _mm_sfence();
+}
+
+#else // NEON
+
+template<rs2_distortion dist>
+inline void distorte_x_y(const float32x4_t & x, const float32x4_t & y, float32x4_t * distorted_x, float32x4_t * distorted_y, const rs2_intrinsics& to)
+{
+    *distorted_x = x;
+    *distorted_y = y;
+}
+template<>
+inline void distorte_x_y<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(const float32x4_t& x, const float32x4_t& y, float32x4_t* distorted_x, float32x4_t* distorted_y, const rs2_intrinsics& to)
+{
+    float32x4_t c[5];
+    auto one = vdupq_n_f32(1);
+    auto two = vdupq_n_f32(2);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        c[i] = vdupq_n_f32(to.coeffs[i]);
+    }
+    auto r2 = vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y));
+    auto r3 = vaddq_f32(vmulq_f32(c[1], vmulq_f32(r2, r2)), vmulq_f32(c[4], vmulq_f32(r2, vmulq_f32(r2, r2))));
+    auto f = vaddq_f32(one, vaddq_f32(vmulq_f32(c[0], r2), r3));
+
+    auto x_f = vmulq_f32(x, f);
+    auto y_f = vmulq_f32(y, f);
+
+    auto r4 = vmulq_f32(c[3], vaddq_f32(r2, vmulq_f32(two, vmulq_f32(x_f, x_f))));
+    auto d_x = vaddq_f32(x_f, vaddq_f32(vmulq_f32(two, vmulq_f32(c[2], vmulq_f32(x_f, y_f))), r4));
+
+    auto r5 = vmulq_f32(c[2], vaddq_f32(r2, vmulq_f32(two, vmulq_f32(y_f, y_f))));
+    auto d_y = vaddq_f32(y_f, vaddq_f32(vmulq_f32(two, vmulq_f32(c[3], vmulq_f32(x_f, y_f))), r5));
+
+    *distorted_x = d_x;
+    *distorted_y = d_y;
+}
+template<>
+inline void distorte_x_y<RS2_DISTORTION_BROWN_CONRADY>(const float32x4_t& x, const float32x4_t& y, float32x4_t* distorted_x, float32x4_t* distorted_y, const rs2_intrinsics& to)
+{
+    float32x4_t c[5];
+    auto one = vdupq_n_f32(1);
+    auto two = vdupq_n_f32(2);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        c[i] = vdupq_n_f32(to.coeffs[i]);
+    }
+    auto r2 = vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y));
+    auto r3 = vaddq_f32(vmulq_f32(c[1], vmulq_f32(r2, r2)), vmulq_f32(c[4], vmulq_f32(r2, vmulq_f32(r2, r2))));
+    auto f = vaddq_f32(one, vaddq_f32(vmulq_f32(c[0], r2), r3));
+
+    auto x_f = vmulq_f32(x, f);
+    auto y_f = vmulq_f32(y, f);
+
+    // Unlike the modified model, the tangential part is based on the undistorted point
+    auto r4 = vmulq_f32(c[3], vaddq_f32(r2, vmulq_f32(two, vmulq_f32(x, x))));
+    auto d_x = vaddq_f32(x_f, vaddq_f32(vmulq_f32(two, vmulq_f32(c[2], vmulq_f32(x, y))), r4));
+
+    auto r5 = vmulq_f32(c[2], vaddq_f32(r2, vmulq_f32(two, vmulq_f32(y, y))));
+    auto d_y = vaddq_f32(y_f, vaddq_f32(vmulq_f32(two, vmulq_f32(c[3], vmulq_f32(x, y))), r5));
+
+    *distorted_x = d_x;
+    *distorted_y = d_y;
+}
+
+// Same as the SSE version: outputs the rounded (u, v) pixel of each depth pixel as int2, or (0, 0) where there's no
+// depth. NEON needs no alignment, so this goes 4 pixels at a time.
+template<rs2_distortion dist>
+inline void get_texture_map_sse(const uint16_t * depth,
+    float depth_scale,
+    const unsigned int size,
+    const float * pre_compute_x, const float * pre_compute_y,
+    uint8_t * pixels_ptr_int,
+    const rs2_intrinsics& to,
+    const rs2_extrinsics& from_to_other)
+{
+    auto scale = vdupq_n_f32(depth_scale);
+
+    auto mapx = pre_compute_x;
+    auto mapy = pre_compute_y;
+
+    auto res = reinterpret_cast<int32_t*>(pixels_ptr_int);
+
+    float32x4_t r[9];
+    float32x4_t t[3];
+
+    for (int i = 0; i < 9; ++i)
+    {
+        r[i] = vdupq_n_f32(from_to_other.rotation[i]);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        t[i] = vdupq_n_f32(from_to_other.translation[i]);
+    }
+    auto zero = vdupq_n_f32(0);
+    auto half = vdupq_n_f32(0.5);
+    auto fx = vdupq_n_f32(to.fx);
+    auto fy = vdupq_n_f32(to.fy);
+    auto ppx = vdupq_n_f32(to.ppx);
+    auto ppy = vdupq_n_f32(to.ppy);
+
+    for (unsigned int i = 0; i < size; i += 4)
+    {
+        auto x = vld1q_f32(mapx + i);
+        auto y = vld1q_f32(mapy + i);
+
+        auto z = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vld1_u16(depth + i))), scale);
+
+        auto px = vmulq_f32(z, x);
+        auto py = vmulq_f32(z, y);
+
+        auto p_x = vaddq_f32(vmulq_f32(r[0], px), vaddq_f32(vmulq_f32(r[3], py), vaddq_f32(vmulq_f32(r[6], z), t[0])));
+        auto p_y = vaddq_f32(vmulq_f32(r[1], px), vaddq_f32(vmulq_f32(r[4], py), vaddq_f32(vmulq_f32(r[7], z), t[1])));
+        auto p_z = vaddq_f32(vmulq_f32(r[2], px), vaddq_f32(vmulq_f32(r[5], py), vaddq_f32(vmulq_f32(r[8], z), t[2])));
+
+        p_x = vdivq_f32(p_x, p_z);
+        p_y = vdivq_f32(p_y, p_z);
+
+        distorte_x_y<dist>(p_x, p_y, &p_x, &p_y, to);
+
+        //zero the u and v if z is zero; round to nearest, like _mm_cvtps_epi32
+        auto valid = vmvnq_u32(vceqq_f32(z, zero));
+        int32x4x2_t uv;
+        uv.val[0] = vcvtnq_s32_f32(vbslq_f32(valid, vaddq_f32(vaddq_f32(vmulq_f32(p_x, fx), ppx), half), zero));
+        uv.val[1] = vcvtnq_s32_f32(vbslq_f32(valid, vaddq_f32(vaddq_f32(vmulq_f32(p_y, fy), ppy), half), zero));
+
+        vst2q_s32(res, uv);
+        res += 8;
+    }
 }
 
+#endif // __SSSE3__
+
 image_transform::image_transform(const rs2_intrinsics& from, float depth_scale)
     :_depth(from),
     _depth_scale(depth_scale),
@@ -232,6 +405,15 @@ void image_transform::pre_compute_x_y_map(std::vector<float>& pre_compute_map_x,
                 x = ux;
                 y = uy;
             }
+            else if (_depth.model == RS2_DISTORTION_BROWN_CONRADY || _depth.model == RS2_DISTORTION_KANNALA_BRANDT4
+                || _depth.model == RS2_DISTORTION_FTHETA)
+            {
+                // These are only undistorted iteratively: do it once here, so each frame is a plain multiplication
+                float point[3];
+                rs2_deproject_pixel_to_point(point, &_depth, pixel, 1.f);
+                x = point[0];
+                y = point[1];
+            }
 
             pre_compute_map_x[h*_depth.width + w] = x;
             pre_compute_map_y[h*_depth.width + w] = y;
@@ -245,40 +427,153 @@ void image_transform::align_depth_to_other(const uint16_t* z_pixels, uint16_t* d
     switch (to.model)
     {
     case RS2_DISTORTION_MODIFIED_BROWN_CONRADY:
+    case RS2_DISTORTION_INVERSE_BROWN_CONRADY:
         align_depth_to_other_sse<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, dest, depth, to, from_to_other);
         break;
+    case RS2_DISTORTION_BROWN_CONRADY:
+        align_depth_to_other_sse<RS2_DISTORTION_BROWN_CONRADY>(z_pixels, dest, depth, to, from_to_other);
+        break;
     default:
         align_depth_to_other_sse(z_pixels, dest, depth, to, from_to_other);
         break;
     }
 }
 
+void image_transform::for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn)
+{
+    if (_threads <= 1)
+    {
+        fn(0, count);
+        return;
+    }
+    if (!_thread_pool)
+        _thread_pool = processing_thread_pool::instance();
+    _thread_pool->parallel_for(count, _threads, fn);
+}
+
+template<rs2_distortion dist>
+void image_transform::get_texture_map(const uint16_t * depth, const float * pre_compute_x, const float * pre_compute_y,
+    std::vector<int2>& pixels, const rs2_intrinsics& to, const rs2_extrinsics& from_to_other)
+{
+    // Split in multiples of 8 pixels, so that the aligned loads stay aligned
+    const size_t size = size_t(_depth.height) * _depth.width;
+#if defined(__SSSE3__) && defined(RS2_USE_AVX)
+    static bool do_avx2 = has_avx2();
+#endif
+    for_each_band((size + 7) / 8, [&](size_t begin, size_t end)
+    {
+        auto first = begin * 8;
+        auto count = std::min(end * 8, size) - first;
+#if defined(__SSSE3__) && defined(RS2_USE_AVX)
+        if (do_avx2)
+        {
+            align_texture_map_avx<dist>(depth + first, _depth_scale, (unsigned int)count, pre_compute_x + first, pre_compute_y + first,
+                pixels.data() + first, to, from_to_other);
+            return;
+        }
+#endif
+        get_texture_map_sse<dist>(depth + first, _depth_scale, (unsigned int)count, pre_compute_x + first, pre_compute_y + first,
+            (uint8_t *)(pixels.data() + first), to, from_to_other);
+    });
+}
+
+// Writes z over [left, right] of a row of the aligned depth, keeping the closest depth where there's already one.
+// z is never 0, so both cases are a single unsigned minimum with the values offset by 1: 0 wraps around to the highest.
+static inline void write_min_depth(uint16_t * row, int left, int right, uint16_t z)
+{
+    int x = left;
+#ifdef __SSSE3__
+    // _mm_min_epu16 is SSE4.1: flip the sign bit to get the same order from the signed minimum
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i sign = _mm_set1_epi16(short(0x8000));
+    const __m128i z_1 = _mm_set1_epi16(short((z - 1) ^ 0x8000));
+    for (; x + 8 <= right + 1; x += 8)
+    {
+        auto d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x));
+        auto closest = _mm_min_epi16(_mm_xor_si128(_mm_sub_epi16(d, one), sign), z_1);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(row + x), _mm_add_epi16(_mm_xor_si128(closest, sign), one));
+    }
+#else
+    const uint16x8_t one = vdupq_n_u16(1);
+    const uint16x8_t z_1 = vdupq_n_u16(uint16_t(z - 1));
+    for (; x + 8 <= right + 1; x += 8)
+        vst1q_u16(row + x, vaddq_u16(vminq_u16(vsubq_u16(vld1q_u16(row + x), one), z_1), one));
+#endif
+    for (; x <= right; ++x)
+        row[x] = row[x] ? std::min(row[x], z) : z;
+}
+
 inline void image_transform::move_depth_to_other(const uint16_t* z_pixels, uint16_t* dest, const rs2_intrinsics& to,
     const std::vector<librealsense::int2>& pixel_top_left_int,
     const std::vector<librealsense::int2>& pixel_bottom_right_int)
 {
-    for (int y = 0; y < _depth.height; ++y)
+    if (_threads <= 1 || to.height <= 1)
     {
-        for (int x = 0; x < _depth.width; ++x)
+        for (int y = 0; y < _depth.height; ++y)
         {
-            auto depth_pixel_index = y * _depth.width + x;
-            // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
-            if (z_pixels[depth_pixel_index])
+            for (int x = 0; x < _depth.width; ++x)
             {
-                for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
+                auto depth_pixel_index = y * _depth.width + x;
+                // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
+                if (z_pixels[depth_pixel_index])
                 {
-                    for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
-                    {
-                        if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
-                            continue;
-                        auto other_ind = other_y * to.width + other_x;
-
-                        dest[other_ind] = dest[other_ind] ? std::min(dest[other_ind], z_pixels[depth_pixel_index]) : z_pixels[depth_pixel_index];
-                    }
+                    auto top = std::max(pixel_top_left_int[depth_pixel_index].y, 0);
+                    auto bottom = std::min(pixel_bottom_right_int[depth_pixel_index].y, to.height - 1);
+                    auto left = std::max(pixel_top_left_int[depth_pixel_index].x, 0);
+                    auto right = std::min(pixel_bottom_right_int[depth_pixel_index].x, to.width - 1);
+                    for (int other_y = top; other_y <= bottom; ++other_y)
+                        write_min_depth(dest + other_y * to.width, left, right, z_pixels[depth_pixel_index]);
                 }
             }
         }
+        return;
     }
+
+    // Depth pixels map to overlapping rectangles, so bands of depth rows can't be written independently. Instead each
+    // thread owns a band of target rows, and only looks at the depth rows that reach into it. The result is the same
+    // as in one pass, since the minimum doesn't depend on the order of the writes.
+    _depth_row_span.resize(_depth.height);
+    for_each_band(_depth.height, [&](size_t begin, size_t end)
+    {
+        for (size_t y = begin; y < end; ++y)
+        {
+            int2 span = { std::numeric_limits<int>::max(), std::numeric_limits<int>::min() };
+            for (int x = 0; x < _depth.width; ++x)
+            {
+                auto depth_pixel_index = y * _depth.width + x;
+                if (z_pixels[depth_pixel_index])
+                {
+                    span.x = std::min(span.x, pixel_top_left_int[depth_pixel_index].y);
+                    span.y = std::max(span.y, pixel_bottom_right_int[depth_pixel_index].y);
+                }
+            }
+            _depth_row_span[y] = span;
+        }
+    });
+
+    for_each_band(to.height, [&](size_t begin, size_t end)
+    {
+        const int band_top = int(begin), band_bottom = int(end) - 1;
+        for (int y = 0; y < _depth.height; ++y)
+        {
+            if (_depth_row_span[y].y < band_top || _depth_row_span[y].x > band_bottom)
+                continue;
+
+            for (int x = 0; x < _depth.width; ++x)
+            {
+                auto depth_pixel_index = y * _depth.width + x;
+                if (z_pixels[depth_pixel_index])
+                {
+                    auto top = std::max(pixel_top_left_int[depth_pixel_index].y, band_top);
+                    auto bottom = std::min(pixel_bottom_right_int[depth_pixel_index].y, band_bottom);
+                    auto left = std::max(pixel_top_left_int[depth_pixel_index].x, 0);
+                    auto right = std::min(pixel_bottom_right_int[depth_pixel_index].x, to.width - 1);
+                    for (int other_y = top; other_y <= bottom; ++other_y)
+                        write_min_depth(dest + other_y * to.width, left, right, z_pixels[depth_pixel_index]);
+                }
+            }
+        }
+    });
 }
 
 void image_transform::align_other_to_depth(const uint16_t* z_pixels, const uint8_t * source, uint8_t * dest, int bpp, const rs2_intrinsics& to,
@@ -290,6 +585,9 @@ void image_transform::align_other_to_depth(const uint16_t* z_pixels, const uint8
     case RS2_DISTORTION_INVERSE_BROWN_CONRADY:
         align_other_to_depth_sse<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, source, dest, bpp, to, from_to_other);
         break;
+    case RS2_DISTORTION_BROWN_CONRADY:
+        align_other_to_depth_sse<RS2_DISTORTION_BROWN_CONRADY>(z_pixels, source, dest, bpp, to, from_to_other);
+        break;
     default:
         align_other_to_depth_sse(z_pixels, source, dest, bpp, to, from_to_other);
         break;
@@ -301,8 +599,7 @@ template<rs2_distortion dist>
 inline void image_transform::align_depth_to_other_sse(const uint16_t * z_pixels, uint16_t * dest, const rs2_intrinsics& depth, const rs2_intrinsics& to,
     const rs2_extrinsics& from_to_other)
 {
-    get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
-        _pre_compute_map_y_top_left.data(), (uint8_t *)_pixel_top_left_int.data(), to, from_to_other);
+    get_texture_map<dist>(z_pixels, _pre_compute_map_x_top_left.data(), _pre_compute_map_y_top_left.data(), _pixel_top_left_int, to, from_to_other);
 
     float fov[2];
     rs2_fov(&depth, fov);
@@ -313,8 +610,7 @@ inline void image_transform::align_depth_to_other_sse(const uint16_t * z_pixels,
 
     if (pixels_per_angle_depth.x < pixels_per_angle_target.x || pixels_per_angle_depth.y < pixels_per_angle_target.y || is_special_resolution(depth, to))
     {
-        get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
-            _pre_compute_map_y_bottom_right.data(), (uint8_t *)_pixel_bottom_right_int.data(), to, from_to_other);
+        get_texture_map<dist>(z_pixels, _pre_compute_map_x_bottom_right.data(), _pre_compute_map_y_bottom_right.data(), _pixel_bottom_right_int, to, from_to_other);
 
         move_depth_to_other(z_pixels, dest, to, _pixel_top_left_int, _pixel_bottom_right_int);
     }
@@ -329,14 +625,12 @@ template<rs2_distortion dist>
 inline void image_transform::align_other_to_depth_sse(const uint16_t * z_pixels, const uint8_t * source, uint8_t * dest, int bpp, const rs2_intrinsics& to,
     const rs2_extrinsics& from_to_other)
 {
-    get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
-        _pre_compute_map_y_top_left.data(), (uint8_t *)_pixel_top_left_int.data(), to, from_to_other);
+    get_texture_map<dist>(z_pixels, _pre_compute_map_x_top_left.data(), _pre_compute_map_y_top_left.data(), _pixel_top_left_int, to, from_to_other);
 
     std::vector<int2>& bottom_right = _pixel_top_left_int;
     if (to.height < _depth.height && to.width < _depth.width)
     {
-        get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
-            _pre_compute_map_y_bottom_right.data(), (uint8_t *)_pixel_bottom_right_int.data(), to, from_to_other);
+        get_texture_map<dist>(z_pixels, _pre_compute_map_x_bottom_right.data(), _pre_compute_map_y_bottom_right.data(), _pixel_bottom_right_int, to, from_to_other);
 
         bottom_right = _pixel_bottom_right_int;
     }
@@ -371,29 +665,42 @@ void image_transform::move_other_to_depth(const uint16_t* z_pixels,
     const std::vector<librealsense::int2>& pixel_top_left_int,
     const std::vector<librealsense::int2>& pixel_bottom_right_int)
 {
-    // Iterate over the pixels of the depth image
-    for (int y = 0; y < _depth.height; ++y)
+    // Iterate over the pixels of the depth image. Each writes its own output pixel only, so bands of rows are
+    // independent.
+    for_each_band(_depth.height, [&](size_t begin, size_t end)
     {
-        for (int x = 0; x < _depth.width; ++x)
+        for (int y = int(begin); y < int(end); ++y)
         {
-            auto depth_pixel_index = y * _depth.width + x;
-            // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
-            if (z_pixels[depth_pixel_index])
+            for (int x = 0; x < _depth.width; ++x)
             {
-                for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
+                auto depth_pixel_index = y * _depth.width + x;
+                // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
+                if (z_pixels[depth_pixel_index])
                 {
-                    for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
-                    {
-                        if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
-                            continue;
-                        auto other_ind = other_y * to.width + other_x;
-
-                        dest[depth_pixel_index] = source[other_ind];
-                    }
+                    // Of all the pixels of the rectangle that are inside the other image, the last one (bottom-right
+                    // most) is the one that's kept
+                    auto other_y = std::min(pixel_bottom_right_int[depth_pixel_index].y, to.height - 1);
+                    auto other_x = std::min(pixel_bottom_right_int[depth_pixel_index].x, to.width - 1);
+                    if (other_y >= std::max(pixel_top_left_int[depth_pixel_index].y, 0)
+                        && other_x >= std::max(pixel_top_left_int[depth_pixel_index].x, 0))
+                        dest[depth_pixel_index] = source[other_y * to.width + other_x];
                 }
             }
         }
-    }
+    });
+}
+
+align_sse::align_sse(rs2_stream to_stream, const char* name)
+    : align(to_stream, name)
+    , _threads(1)
+{
+    auto threads = std::make_shared<ptr_option<uint8_t>>(
+        uint8_t(1),
+        uint8_t(std::min(processing_thread_pool::max_threads(), 255)),
+        uint8_t(1),
+        uint8_t(1),
+        &_threads, "Number of threads to split the alignment across");
+    register_option(RS2_OPTION_FILTER_THREADS, threads);
 }
 
 void align_sse::reset_cache(rs2_stream from, rs2_stream to)
@@ -401,50 +708,71 @@ void align_sse::reset_cache(rs2_stream from, rs2_stream to)
     _stream_transform = nullptr;
 }
 
+image_transform& align_sse::get_transform(const rs2_intrinsics& z_intrin, float z_scale)
+{
+    // The precomputed maps only depend on the depth intrinsics: keep them for as long as those don't change, even
+    // when profiles that were already seen (and so don't reset the cache) come back
+    if (_stream_transform == nullptr || !(_stream_transform->depth_intrinsics() == z_intrin) || _stream_transform->depth_scale() != z_scale)
+    {
+        _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale);
+        _stream_transform->pre_compute_x_y_map_corners();
+    }
+    _stream_transform->set_threads(_threads);
+    return *_stream_transform;
+}
+
+// Projecting to these needs arctangents, which the vectorized kernels don't have: they go through the generic align
+static bool needs_generic_projection(const rs2_intrinsics& other)
+{
+    return other.model == RS2_DISTORTION_KANNALA_BRANDT4 || other.model == RS2_DISTORTION_FTHETA;
+}
+
 void align_sse::align_z_to_other(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale)
 {
-    uint8_t * aligned_data = reinterpret_cast<uint8_t *>(const_cast<void*>(aligned.get_data()));
+    // The grid of the aligned frame, which may be smaller than the other's
     auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
+    auto other_intrin = aligned_profile.get_intrinsics();
+    if (needs_generic_projection(other_intrin))
+    {
+        align::align_z_to_other(aligned, depth, other_profile, z_scale);
+        return;
+    }
+
+    uint8_t * aligned_data = reinterpret_cast<uint8_t *>(const_cast<void*>(aligned.get_data()));
     memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
 
     auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
 
-    auto z_intrin = depth_profile.get_intrinsics();
-    auto other_intrin = other_profile.get_intrinsics();
+    // The maps are precomputed for the scaled depth grid, so a smaller output is as much less work
+    rs2_intrinsics z_intrin;
+    auto z_pixels = scaled_depth(depth, z_intrin);
     auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
 
-    auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
-
-    if (_stream_transform == nullptr)
-    {
-        _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale);
-        _stream_transform->pre_compute_x_y_map_corners();
-    }
-    _stream_transform->align_depth_to_other(z_pixels, reinterpret_cast<uint16_t*>(aligned_data), 2, z_intrin, other_intrin, z_to_other);
+    get_transform(z_intrin, z_scale).align_depth_to_other(z_pixels, reinterpret_cast<uint16_t*>(aligned_data), 2, z_intrin, other_intrin, z_to_other);
 }
 
 void align_sse::align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale)
 {
+    auto other_profile = other.get_profile().as<rs2::video_stream_profile>();
+    auto other_intrin = other_profile.get_intrinsics();
+    if (needs_generic_projection(other_intrin))
+    {
+        align::align_other_to_z(aligned, depth, other, z_scale);
+        return;
+    }
+
     uint8_t * aligned_data = reinterpret_cast<uint8_t *>(const_cast<void*>(aligned.get_data()));
     auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
     memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
 
     auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
-    auto other_profile = other.get_profile().as<rs2::video_stream_profile>();
 
-    auto z_intrin = depth_profile.get_intrinsics();
-    auto other_intrin = other_profile.get_intrinsics();
+    rs2_intrinsics z_intrin;
+    auto z_pixels = scaled_depth(depth, z_intrin);
     auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
 
-    auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
     auto other_pixels = reinterpret_cast<const uint8_t *>(other.get_data());
 
-    if (_stream_transform == nullptr)
-    {
-        _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale);
-        _stream_transform->pre_compute_x_y_map_corners();
-    }
-
-    _stream_transform->align_other_to_depth(z_pixels, other_pixels, aligned_data, other.get_bytes_per_pixel(), other_intrin, z_to_other);
+    get_transform(z_intrin, z_scale).align_other_to_depth(z_pixels, other_pixels, aligned_data, other.get_bytes_per_pixel(), other_intrin, z_to_other);
 }
 #endif
@@ -1,9 +1,10 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2024 Intel Corporation. All Rights Reserved.
 #pragma once
-#ifdef __SSSE3__
+#if defined(__SSSE3__) || (defined(__aarch64__) && defined(__ARM_NEON))
 
 #include "proc/align.h"
+#include "proc/processing-thread-pool.h"
 #include <src/float3.h>
 
 namespace librealsense
@@ -28,6 +29,12 @@ namespace librealsense
 
         void pre_compute_x_y_map_corners();
 
+        const rs2_intrinsics& depth_intrinsics() const { return _depth; }
+        float depth_scale() const { return _depth_scale; }
+
+        // Number of threads the texture maps and the pixel transfers are split across
+        void set_threads(uint8_t threads) { _threads = threads; }
+
     private:
 
         const rs2_intrinsics _depth;
@@ -40,6 +47,16 @@ namespace librealsense
 
         std::vector<int2> _pixel_top_left_int;
         std::vector<int2> _pixel_bottom_right_int;
+        std::vector<int2> _depth_row_span;      // First and last target row reached by each depth row
+
+        uint8_t _threads = 1;
+        std::shared_ptr<processing_thread_pool> _thread_pool;
+
+        void for_each_band(size_t count, std::function<void(size_t, size_t)> const & fn);
+
+        template<rs2_distortion dist>
+        void get_texture_map(const uint16_t * depth, const float * pre_compute_x, const float * pre_compute_y,
+            std::vector<int2>& pixels, const rs2_intrinsics& to, const rs2_extrinsics& from_to_other);
 
         void pre_compute_x_y_map(std::vector<float>& pre_compute_map_x,
             std::vector<float>& pre_compute_map_y,
@@ -74,9 +91,15 @@ namespace librealsense
     class align_sse : public align
     {
     public:
-        align_sse(rs2_stream to_stream) : align(to_stream, "Align (SSE3)") {}
+#ifdef __SSSE3__
+        align_sse(rs2_stream to_stream) : align_sse(to_stream, "Align (SSE3)") {}
+#else
+        align_sse(rs2_stream to_stream) : align_sse(to_stream, "Align (NEON)") {}
+#endif
 
     protected:
+        align_sse(rs2_stream to_stream, const char* name);
+
         void reset_cache(rs2_stream from, rs2_stream to) override;
 
         void align_z_to_other(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale) override;
@@ -84,7 +107,11 @@ namespace librealsense
         void align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale) override;
 
     private:
+        // The transform, with its precomputed maps, for the given depth intrinsics and scale
+        image_transform& get_transform(const rs2_intrinsics& z_intrin, float z_scale);
+
         std::shared_ptr<image_transform> _stream_transform;
+        uint8_t _threads;
     };
 }
-#endif // __SSSE3__
+#endif // __SSSE3__ || NEON
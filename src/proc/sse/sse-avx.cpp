@@ -0,0 +1,246 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "sse-avx.h"
+
+#if defined(__SSSE3__) && defined(__AVX2__) && defined(RS2_USE_AVX)
+#include <immintrin.h>
+
+namespace librealsense
+{
+    // See distorte_x_y in sse-align.cpp
+    template<rs2_distortion dist>
+    static inline void avx_distort_x_y(__m256 & x, __m256 & y, const __m256 c[5])
+    {
+        if (dist == RS2_DISTORTION_NONE)
+            return;
+
+        auto one = _mm256_set1_ps(1);
+        auto two = _mm256_set1_ps(2);
+
+        auto r2 = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+        auto r3 = _mm256_add_ps(_mm256_mul_ps(c[1], _mm256_mul_ps(r2, r2)), _mm256_mul_ps(c[4], _mm256_mul_ps(r2, _mm256_mul_ps(r2, r2))));
+        auto f = _mm256_add_ps(one, _mm256_add_ps(_mm256_mul_ps(c[0], r2), r3));
+
+        auto x_f = _mm256_mul_ps(x, f);
+        auto y_f = _mm256_mul_ps(y, f);
+
+        // Brown-Conrady applies the tangential part to the undistorted point, modified Brown-Conrady to the scaled one
+        auto x_t = dist == RS2_DISTORTION_BROWN_CONRADY ? x : x_f;
+        auto y_t = dist == RS2_DISTORTION_BROWN_CONRADY ? y : y_f;
+
+        auto r4 = _mm256_mul_ps(c[3], _mm256_add_ps(r2, _mm256_mul_ps(two, _mm256_mul_ps(x_t, x_t))));
+        auto d_x = _mm256_add_ps(x_f, _mm256_add_ps(_mm256_mul_ps(two, _mm256_mul_ps(c[2], _mm256_mul_ps(x_t, y_t))), r4));
+
+        auto r5 = _mm256_mul_ps(c[2], _mm256_add_ps(r2, _mm256_mul_ps(two, _mm256_mul_ps(y_t, y_t))));
+        auto d_y = _mm256_add_ps(y_f, _mm256_add_ps(_mm256_mul_ps(two, _mm256_mul_ps(c[3], _mm256_mul_ps(x_t, y_t))), r5));
+
+        x = d_x;
+        y = d_y;
+    }
+
+    template<rs2_distortion dist>
+    void align_texture_map_avx(const uint16_t * depth, float depth_scale, unsigned int size,
+        const float * pre_compute_x, const float * pre_compute_y, int2 * pixels,
+        const rs2_intrinsics & to, const rs2_extrinsics & from_to_other)
+    {
+        auto scale = _mm256_set1_ps(depth_scale);
+        auto res = reinterpret_cast<__m256i *>(pixels);
+
+        __m256 r[9];
+        __m256 t[3];
+        __m256 c[5];
+
+        for (int i = 0; i < 9; ++i)
+            r[i] = _mm256_set1_ps(from_to_other.rotation[i]);
+        for (int i = 0; i < 3; ++i)
+            t[i] = _mm256_set1_ps(from_to_other.translation[i]);
+        for (int i = 0; i < 5; ++i)
+            c[i] = _mm256_set1_ps(to.coeffs[i]);
+
+        auto zero = _mm256_setzero_ps();
+        auto half = _mm256_set1_ps(0.5);
+        auto fx = _mm256_set1_ps(to.fx);
+        auto fy = _mm256_set1_ps(to.fy);
+        auto ppx = _mm256_set1_ps(to.ppx);
+        auto ppy = _mm256_set1_ps(to.ppy);
+
+        for (unsigned int i = 0; i < size; i += 8)
+        {
+            auto x = _mm256_loadu_ps(pre_compute_x + i);
+            auto y = _mm256_loadu_ps(pre_compute_y + i);
+
+            auto d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(depth + i));
+            auto z = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(d)), scale);
+
+            auto px = _mm256_mul_ps(z, x);
+            auto py = _mm256_mul_ps(z, y);
+
+            auto p_x = _mm256_add_ps(_mm256_mul_ps(r[0], px), _mm256_add_ps(_mm256_mul_ps(r[3], py), _mm256_add_ps(_mm256_mul_ps(r[6], z), t[0])));
+            auto p_y = _mm256_add_ps(_mm256_mul_ps(r[1], px), _mm256_add_ps(_mm256_mul_ps(r[4], py), _mm256_add_ps(_mm256_mul_ps(r[7], z), t[1])));
+            auto p_z = _mm256_add_ps(_mm256_mul_ps(r[2], px), _mm256_add_ps(_mm256_mul_ps(r[5], py), _mm256_add_ps(_mm256_mul_ps(r[8], z), t[2])));
+
+            p_x = _mm256_div_ps(p_x, p_z);
+            p_y = _mm256_div_ps(p_y, p_z);
+
+            avx_distort_x_y<dist>(p_x, p_y, c);
+
+            //zero the u and v if z is zero
+            auto valid = _mm256_cmp_ps(z, zero, _CMP_NEQ_UQ);
+            auto u = _mm256_cvtps_epi32(_mm256_and_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p_x, fx), ppx), half), valid));
+            auto v = _mm256_cvtps_epi32(_mm256_and_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p_y, fy), ppy), half), valid));
+
+            // Interleaving works within 128-bit lanes: the low lanes hold pixels 0-3, the high lanes 4-7
+            auto uv_0 = _mm256_unpacklo_epi32(u, v);    // pixels 0, 1, 4, 5
+            auto uv_2 = _mm256_unpackhi_epi32(u, v);    // pixels 2, 3, 6, 7
+            _mm256_storeu_si256(&res[0], _mm256_permute2x128_si256(uv_0, uv_2, 0x20));
+            _mm256_storeu_si256(&res[1], _mm256_permute2x128_si256(uv_0, uv_2, 0x31));
+            res += 2;
+        }
+    }
+
+    template void align_texture_map_avx<RS2_DISTORTION_NONE>(const uint16_t *, float, unsigned int,
+        const float *, const float *, int2 *, const rs2_intrinsics &, const rs2_extrinsics &);
+    template void align_texture_map_avx<RS2_DISTORTION_BROWN_CONRADY>(const uint16_t *, float, unsigned int,
+        const float *, const float *, int2 *, const rs2_intrinsics &, const rs2_extrinsics &);
+    template void align_texture_map_avx<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(const uint16_t *, float, unsigned int,
+        const float *, const float *, int2 *, const rs2_intrinsics &, const rs2_extrinsics &);
+
+    void pointcloud_depth_to_points_avx(const uint16_t * depth, float depth_scale, unsigned int size,
+        const float * pre_compute_x, const float * pre_compute_y, float3 * points)
+    {
+        auto scale = _mm256_set1_ps(depth_scale);
+        auto point = reinterpret_cast<float *>(points);
+
+        for (unsigned int i = 0; i < size; i += 8)
+        {
+            auto x = _mm256_loadu_ps(pre_compute_x + i);
+            auto y = _mm256_loadu_ps(pre_compute_y + i);
+
+            auto d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(depth + i));
+            auto z = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(d)), scale);
+
+            auto px = _mm256_mul_ps(z, x);
+            auto py = _mm256_mul_ps(z, y);
+
+            // The same scattering as the SSE version, done in each 128-bit lane: the low lanes hold points 0-3 and
+            // the high lanes points 4-7
+            auto x_y = _mm256_shuffle_ps(px, py, _MM_SHUFFLE(2, 0, 2, 0));
+            auto z_x = _mm256_shuffle_ps(z, px, _MM_SHUFFLE(3, 1, 2, 0));
+            auto y_z = _mm256_shuffle_ps(py, z, _MM_SHUFFLE(3, 1, 3, 1));
+
+            auto xyz1 = _mm256_shuffle_ps(x_y, z_x, _MM_SHUFFLE(2, 0, 2, 0));
+            auto xyz2 = _mm256_shuffle_ps(y_z, x_y, _MM_SHUFFLE(3, 1, 2, 0));
+            auto xyz3 = _mm256_shuffle_ps(z_x, y_z, _MM_SHUFFLE(3, 1, 3, 1));
+
+            //store 8 points of x y z
+            _mm256_storeu_ps(point, _mm256_permute2f128_ps(xyz1, xyz2, 0x20));
+            _mm256_storeu_ps(point + 8, _mm256_permute2f128_ps(xyz3, xyz1, 0x30));
+            _mm256_storeu_ps(point + 16, _mm256_permute2f128_ps(xyz2, xyz3, 0x31));
+            point += 24;
+        }
+    }
+
+    void pointcloud_texture_map_avx(const float3 * points, unsigned int size, float2 * texture_map, float2 * pixels,
+        const rs2_intrinsics & other_intrinsics, const rs2_extrinsics & extr)
+    {
+        auto point = reinterpret_cast<const float *>(points);
+        auto res = reinterpret_cast<float *>(texture_map);
+        auto res1 = reinterpret_cast<float *>(pixels);
+
+        __m256 r[9];
+        __m256 t[3];
+        __m256 c[5];
+
+        for (int i = 0; i < 9; ++i)
+            r[i] = _mm256_set1_ps(extr.rotation[i]);
+        for (int i = 0; i < 3; ++i)
+            t[i] = _mm256_set1_ps(extr.translation[i]);
+        for (int i = 0; i < 5; ++i)
+            c[i] = _mm256_set1_ps(other_intrinsics.coeffs[i]);
+
+        auto fx = _mm256_set1_ps(other_intrinsics.fx);
+        auto fy = _mm256_set1_ps(other_intrinsics.fy);
+        auto ppx = _mm256_set1_ps(other_intrinsics.ppx);
+        auto ppy = _mm256_set1_ps(other_intrinsics.ppy);
+        auto w = _mm256_set1_ps(float(other_intrinsics.width));
+        auto h = _mm256_set1_ps(float(other_intrinsics.height));
+        auto zero = _mm256_setzero_ps();
+        auto one = _mm256_set1_ps(1);
+        auto two = _mm256_set1_ps(2);
+
+        auto dist = _mm256_set1_ps((float)other_intrinsics.model);
+        auto brown = _mm256_cmp_ps(_mm256_set1_ps(RS2_DISTORTION_BROWN_CONRADY), dist, _CMP_EQ_OQ);
+        auto distortion_none = _mm256_cmp_ps(_mm256_set1_ps(RS2_DISTORTION_NONE), dist, _CMP_EQ_OQ);
+
+        for (unsigned int i = 0; i < size * 3; i += 24)
+        {
+            // Load 8 points, and move them so each 128-bit lane holds the 4 points (12 floats) of the SSE version
+            auto m0 = _mm256_loadu_ps(point + i);
+            auto m1 = _mm256_loadu_ps(point + i + 8);
+            auto m2 = _mm256_loadu_ps(point + i + 16);
+
+            auto xyz1 = _mm256_permute2f128_ps(m0, m1, 0x30);   // points 0-1.x, 4-5.x
+            auto xyz2 = _mm256_permute2f128_ps(m0, m2, 0x21);   // points 1.y-2.y, 5.y-6.y
+            auto xyz3 = _mm256_permute2f128_ps(m1, m2, 0x30);   // points 2.z-3, 6.z-7
+
+            //gather x,y,z
+            auto yz = _mm256_shuffle_ps(xyz1, xyz2, _MM_SHUFFLE(1, 0, 2, 1));
+            auto xy = _mm256_shuffle_ps(xyz2, xyz3, _MM_SHUFFLE(2, 1, 3, 2));
+
+            auto x = _mm256_shuffle_ps(xyz1, xy, _MM_SHUFFLE(2, 0, 3, 0));
+            auto y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+            auto z = _mm256_shuffle_ps(yz, xyz3, _MM_SHUFFLE(3, 0, 3, 1));
+
+            auto p_x = _mm256_add_ps(_mm256_mul_ps(r[0], x), _mm256_add_ps(_mm256_mul_ps(r[3], y), _mm256_add_ps(_mm256_mul_ps(r[6], z), t[0])));
+            auto p_y = _mm256_add_ps(_mm256_mul_ps(r[1], x), _mm256_add_ps(_mm256_mul_ps(r[4], y), _mm256_add_ps(_mm256_mul_ps(r[7], z), t[1])));
+            auto p_z = _mm256_add_ps(_mm256_mul_ps(r[2], x), _mm256_add_ps(_mm256_mul_ps(r[5], y), _mm256_add_ps(_mm256_mul_ps(r[8], z), t[2])));
+
+            p_x = _mm256_div_ps(p_x, p_z);
+            p_y = _mm256_div_ps(p_y, p_z);
+
+            auto r2 = _mm256_add_ps(_mm256_mul_ps(p_x, p_x), _mm256_mul_ps(p_y, p_y));
+            auto r3 = _mm256_add_ps(_mm256_mul_ps(c[1], _mm256_mul_ps(r2, r2)), _mm256_mul_ps(c[4], _mm256_mul_ps(r2, _mm256_mul_ps(r2, r2))));
+            auto f = _mm256_add_ps(one, _mm256_add_ps(_mm256_mul_ps(c[0], r2), r3));
+
+            auto x_f = _mm256_mul_ps(p_x, f);
+            auto y_f = _mm256_mul_ps(p_y, f);
+
+            auto x_f_dist = _mm256_blendv_ps(x_f, p_x, brown);
+            auto y_f_dist = _mm256_blendv_ps(y_f, p_y, brown);
+
+            auto r4 = _mm256_mul_ps(c[3], _mm256_add_ps(r2, _mm256_mul_ps(two, _mm256_mul_ps(x_f_dist, x_f_dist))));
+            auto d_x = _mm256_add_ps(x_f, _mm256_add_ps(_mm256_mul_ps(two, _mm256_mul_ps(c[2], _mm256_mul_ps(x_f_dist, y_f_dist))), r4));
+
+            auto r5 = _mm256_mul_ps(c[2], _mm256_add_ps(r2, _mm256_mul_ps(two, _mm256_mul_ps(y_f_dist, y_f_dist))));
+            auto d_y = _mm256_add_ps(y_f, _mm256_add_ps(_mm256_mul_ps(two, _mm256_mul_ps(c[3], _mm256_mul_ps(x_f_dist, y_f_dist))), r5));
+
+            p_x = _mm256_blendv_ps(d_x, p_x, distortion_none);
+            p_y = _mm256_blendv_ps(d_y, p_y, distortion_none);
+
+            //zero the x and y if z is zero
+            auto cmp = _mm256_cmp_ps(z, zero, _CMP_NEQ_UQ);
+            p_x = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(p_x, fx), ppx), cmp);
+            p_y = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(p_y, fy), ppy), cmp);
+
+            //interleave the x y before normalize and store in pixels
+            auto xy_0 = _mm256_unpacklo_ps(p_x, p_y);   // points 0, 1, 4, 5
+            auto xy_2 = _mm256_unpackhi_ps(p_x, p_y);   // points 2, 3, 6, 7
+            _mm256_storeu_ps(res1, _mm256_permute2f128_ps(xy_0, xy_2, 0x20));
+            _mm256_storeu_ps(res1 + 8, _mm256_permute2f128_ps(xy_0, xy_2, 0x31));
+            res1 += 16;
+
+            //normalize x and y
+            p_x = _mm256_div_ps(p_x, w);
+            p_y = _mm256_div_ps(p_y, h);
+
+            xy_0 = _mm256_unpacklo_ps(p_x, p_y);
+            xy_2 = _mm256_unpackhi_ps(p_x, p_y);
+            _mm256_storeu_ps(res, _mm256_permute2f128_ps(xy_0, xy_2, 0x20));
+            _mm256_storeu_ps(res + 8, _mm256_permute2f128_ps(xy_0, xy_2, 0x31));
+            res += 16;
+        }
+    }
+}
+
+#endif
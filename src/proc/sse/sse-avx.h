@@ -0,0 +1,38 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// AVX2 versions of the align_sse and pointcloud_sse kernels, 8 pixels per iteration. They are built in their own unit
+// (see RS2_USE_AVX) and picked at runtime according to the CPU. The arithmetic is the SSE one operation for operation
+// (and no FMA), so both produce identical output.
+
+#pragma once
+
+#include <src/float3.h>
+#include <librealsense2/h/rs_sensor.h>
+
+#include <cstdint>
+
+#if defined(__SSSE3__) && defined(RS2_USE_AVX)
+
+// Defined in color-formats-converter.cpp
+bool has_avx2();
+
+namespace librealsense
+{
+    // Rounded (u, v) pixel of each depth pixel, or (0, 0) where there's no depth. dist is one of RS2_DISTORTION_NONE,
+    // RS2_DISTORTION_BROWN_CONRADY or RS2_DISTORTION_MODIFIED_BROWN_CONRADY.
+    template<rs2_distortion dist>
+    void align_texture_map_avx(const uint16_t * depth, float depth_scale, unsigned int size,
+        const float * pre_compute_x, const float * pre_compute_y, int2 * pixels,
+        const rs2_intrinsics & to, const rs2_extrinsics & from_to_other);
+
+    // Interleaved (x, y, z) of each depth pixel; size is a multiple of 8
+    void pointcloud_depth_to_points_avx(const uint16_t * depth, float depth_scale, unsigned int size,
+        const float * pre_compute_x, const float * pre_compute_y, float3 * points);
+
+    // Texture coordinates and pixels of each point in 'other'; size is a multiple of 8
+    void pointcloud_texture_map_avx(const float3 * points, unsigned int size, float2 * texture_map, float2 * pixels,
+        const rs2_intrinsics & other_intrinsics, const rs2_extrinsics & extr);
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "../../environment.h"
 #include "../occlusion-filter.h"
 #include "sse-pointcloud.h"
+#include "sse-avx.h"
 #include "../../option.h"
 
 #include <iostream>
@@ -15,11 +16,19 @@
 
 #include <tmmintrin.h> // For SSSE3 intrinsics
 
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
 #endif
 
 namespace librealsense
 {
+#if defined(__aarch64__) && defined(__ARM_NEON)
+    pointcloud_sse::pointcloud_sse() : pointcloud("Pointcloud (NEON)") {}
+#else
     pointcloud_sse::pointcloud_sse() : pointcloud("Pointcloud (SSE3)") {}
+#endif
 
     void pointcloud_sse::preprocess()
     {
@@ -45,6 +54,16 @@ namespace librealsense
                     x = ux;
                     y = uy;
                 }
+                else if (_depth_intrinsics->model == RS2_DISTORTION_BROWN_CONRADY
+                    || _depth_intrinsics->model == RS2_DISTORTION_KANNALA_BRANDT4
+                    || _depth_intrinsics->model == RS2_DISTORTION_FTHETA)
+                {
+                    // These are only undistorted iteratively: do it once here, so each frame is a plain multiplication
+                    float point[3];
+                    rs2_deproject_pixel_to_point(point, &*_depth_intrinsics, pixel, 1.f);
+                    x = point[0];
+                    y = point[1];
+                }
 
                 _pre_compute_map_x[h*_depth_intrinsics->width + w] = x;
                 _pre_compute_map_y[h*_depth_intrinsics->width + w] = y;
@@ -67,6 +86,15 @@ namespace librealsense
 
         auto point = (float*)output.get_vertices();
 
+#ifdef RS2_USE_AVX
+        static bool do_avx2 = has_avx2();
+        if (do_avx2)
+        {
+            pointcloud_depth_to_points_avx(depth_image, depth_frame.get_units(), size, pre_compute_x, pre_compute_y, (float3*)point);
+            return (float3*)output.get_vertices();
+        }
+#endif
+
         //mask for shuffle
         const __m128i mask0 = _mm_set_epi8((char)0xff, (char)0xff, (char)7, (char)6, (char)0xff, (char)0xff, (char)5, (char)4,
             (char)0xff, (char)0xff, (char)3, (char)2, (char)0xff, (char)0xff, (char)1, (char)0);
@@ -131,6 +159,32 @@ namespace librealsense
             _mm_stream_ps(&point[20], xyz13);
             point += 24;
         }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+        auto depth_image = (const uint16_t*)depth_frame.get_data();
+
+        uint32_t size = depth_intrinsics.height * depth_intrinsics.width;
+
+        auto point = (float*)output.get_vertices();
+
+        auto scale = vdupq_n_f32(depth_frame.get_units());
+
+        auto mapx = _pre_compute_map_x.data();
+        auto mapy = _pre_compute_map_y.data();
+
+        for (unsigned int i = 0; i < size; i += 4)
+        {
+            auto depth = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vld1_u16(depth_image + i))), scale);
+
+            float32x4x3_t xyz;
+            xyz.val[0] = vmulq_f32(depth, vld1q_f32(mapx + i));
+            xyz.val[1] = vmulq_f32(depth, vld1q_f32(mapy + i));
+            xyz.val[2] = depth;
+
+            //store 4 points of x y z, interleaved
+            vst3q_f32(point, xyz);
+            point += 12;
+        }
 #endif
         return (float3*)output.get_vertices();
     }
@@ -228,8 +282,6 @@ namespace librealsense
             p_x = _mm_or_ps(_mm_and_ps(distortion_none, p_x ), _mm_andnot_ps(distortion_none, d_x));
             p_y = _mm_or_ps(_mm_and_ps(distortion_none, p_y ), _mm_andnot_ps(distortion_none, d_y));
 
-            //TODO: add handle to RS2_DISTORTION_FTHETA
-
             //zero the x and y if z is zero
             auto cmp = _mm_cmpneq_ps(z, zero);
             p_x = _mm_and_ps(_mm_add_ps(_mm_mul_ps(p_x, fx), ppx), cmp);
@@ -261,6 +313,95 @@ namespace librealsense
             _mm_stream_ps(res + 4, xyxy2);
             res += 8;
         }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        auto point = reinterpret_cast<const float*>(points);
+        auto res = reinterpret_cast<float*>(tex_ptr);
+        auto res1 = reinterpret_cast<float*>(pixels_ptr);
+
+        float32x4_t r[9];
+        float32x4_t t[3];
+        float32x4_t c[5];
+
+        for (int i = 0; i < 9; ++i)
+        {
+            r[i] = vdupq_n_f32(extr.rotation[i]);
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            t[i] = vdupq_n_f32(extr.translation[i]);
+        }
+        for (int i = 0; i < 5; ++i)
+        {
+            c[i] = vdupq_n_f32(other_intrinsics.coeffs[i]);
+        }
+
+        auto fx = vdupq_n_f32(other_intrinsics.fx);
+        auto fy = vdupq_n_f32(other_intrinsics.fy);
+        auto ppx = vdupq_n_f32(other_intrinsics.ppx);
+        auto ppy = vdupq_n_f32(other_intrinsics.ppy);
+        auto w = vdupq_n_f32(float(other_intrinsics.width));
+        auto h = vdupq_n_f32(float(other_intrinsics.height));
+        auto zero = vdupq_n_f32(0);
+        auto one = vdupq_n_f32(1);
+        auto two = vdupq_n_f32(2);
+
+        // Same distortion handling as the SSE path above, except that the model is known up front so there's no
+        // need to compute both and blend
+        const bool brown = other_intrinsics.model == RS2_DISTORTION_BROWN_CONRADY;
+        const bool distortion_none = other_intrinsics.model == RS2_DISTORTION_NONE;
+
+        for (auto i = 0UL; i < height*width * 3; i += 12)
+        {
+            //load 4 points, deinterleaving x,y,z
+            auto xyz = vld3q_f32(point + i);
+            auto x = xyz.val[0];
+            auto y = xyz.val[1];
+            auto z = xyz.val[2];
+
+            auto p_x = vaddq_f32(vmulq_f32(r[0], x), vaddq_f32(vmulq_f32(r[3], y), vaddq_f32(vmulq_f32(r[6], z), t[0])));
+            auto p_y = vaddq_f32(vmulq_f32(r[1], x), vaddq_f32(vmulq_f32(r[4], y), vaddq_f32(vmulq_f32(r[7], z), t[1])));
+            auto p_z = vaddq_f32(vmulq_f32(r[2], x), vaddq_f32(vmulq_f32(r[5], y), vaddq_f32(vmulq_f32(r[8], z), t[2])));
+
+            p_x = vdivq_f32(p_x, p_z);
+            p_y = vdivq_f32(p_y, p_z);
+
+            if (!distortion_none)
+            {
+                auto r2 = vaddq_f32(vmulq_f32(p_x, p_x), vmulq_f32(p_y, p_y));
+                auto r3 = vaddq_f32(vmulq_f32(c[1], vmulq_f32(r2, r2)), vmulq_f32(c[4], vmulq_f32(r2, vmulq_f32(r2, r2))));
+                auto f = vaddq_f32(one, vaddq_f32(vmulq_f32(c[0], r2), r3));
+
+                auto x_f = vmulq_f32(p_x, f);
+                auto y_f = vmulq_f32(p_y, f);
+
+                auto x_f_dist = brown ? p_x : x_f;
+                auto y_f_dist = brown ? p_y : y_f;
+
+                auto r4 = vmulq_f32(c[3], vaddq_f32(r2, vmulq_f32(two, vmulq_f32(x_f_dist, x_f_dist))));
+                auto d_x = vaddq_f32(x_f, vaddq_f32(vmulq_f32(two, vmulq_f32(c[2], vmulq_f32(x_f_dist, y_f_dist))), r4));
+
+                auto r5 = vmulq_f32(c[2], vaddq_f32(r2, vmulq_f32(two, vmulq_f32(y_f_dist, y_f_dist))));
+                auto d_y = vaddq_f32(y_f, vaddq_f32(vmulq_f32(two, vmulq_f32(c[3], vmulq_f32(x_f_dist, y_f_dist))), r5));
+
+                p_x = d_x;
+                p_y = d_y;
+            }
+
+            //zero the x and y if z is zero
+            auto valid = vmvnq_u32(vceqq_f32(z, zero));
+            p_x = vbslq_f32(valid, vaddq_f32(vmulq_f32(p_x, fx), ppx), zero);
+            p_y = vbslq_f32(valid, vaddq_f32(vmulq_f32(p_y, fy), ppy), zero);
+
+            //store x y interleaved in pixels_ptr, then normalized in tex_ptr
+            float32x4x2_t xy = { { p_x, p_y } };
+            vst2q_f32(res1, xy);
+            res1 += 8;
+
+            xy.val[0] = vdivq_f32(p_x, w);
+            xy.val[1] = vdivq_f32(p_y, h);
+            vst2q_f32(res, xy);
+            res += 8;
+        }
 #endif
 
     }
@@ -273,6 +414,26 @@ namespace librealsense
                                           const rs2_extrinsics & extr,
                                           float2 * pixels_ptr )
     {
+        // Projecting to these needs arctangents, which the vectorized kernels don't have
+        if( other_intrinsics.model == RS2_DISTORTION_KANNALA_BRANDT4 || other_intrinsics.model == RS2_DISTORTION_FTHETA )
+        {
+            pointcloud::get_texture_map( output, points, width, height, other_intrinsics, extr, pixels_ptr );
+            return;
+        }
+
+#if defined( __SSSE3__ ) && defined( RS2_USE_AVX )
+        static bool do_avx2 = has_avx2();
+        if( do_avx2 )
+        {
+            pointcloud_texture_map_avx( points,
+                                        width * height,
+                                        (float2 *)output.get_texture_coordinates(),
+                                        pixels_ptr,
+                                        other_intrinsics,
+                                        extr );
+            return;
+        }
+#endif
 
         get_texture_map_sse( (float2 *)output.get_texture_coordinates(),
                          points,
@@ -11,10 +11,60 @@
 
 namespace librealsense
 {
+    // Reports one of the counters of a sync_policy
+    class sync_counter_option : public readonly_option
+    {
+    public:
+        sync_counter_option(std::shared_ptr< sync_policy > policy,
+                            std::atomic< unsigned long long > sync_policy::*counter, std::string const & desc)
+            : _policy(std::move(policy)), _counter(counter), _desc(desc)
+        {
+        }
+
+        float query() const override { return static_cast< float >(((*_policy).*_counter).load()); }
+        option_range get_range() const override { return { 0, std::numeric_limits< float >::max(), 1, 0 }; }
+        bool is_enabled() const override { return true; }
+
+        const char* get_description() const override { return _desc.c_str(); }
+
+    private:
+        std::shared_ptr< sync_policy > _policy;
+        std::atomic< unsigned long long > sync_policy::*_counter;
+        std::string _desc;
+    };
+
     syncer_process_unit::syncer_process_unit(std::initializer_list< bool_option::ptr > enable_opts, bool log)
-        : processing_block("syncer"), _matcher((new composite_identity_matcher({})))
+        : syncer_process_unit(std::make_shared< composite_identity_matcher >(std::vector< std::shared_ptr< matcher > >()),
+                              enable_opts, log)
+    {
+    }
+
+    syncer_process_unit::syncer_process_unit(std::shared_ptr< matcher > top_matcher,
+                                             std::initializer_list< bool_option::ptr > enable_opts, bool log)
+        : processing_block("syncer"), _matcher(std::move(top_matcher))
+        , _policy(std::make_shared< sync_policy >())
+        , _log(log)
         , _enable_opts(enable_opts.begin(), enable_opts.end())
     {
+        _matcher->set_policy(_policy);
+
+        auto deadline = std::make_shared< ptr_option< float > >(0.f, 1000.f, 1.f, 0.f, &_policy->deadline_ms,
+            "Milliseconds from the arrival of a set's first frame after which the set is released without the "
+            "frames still missing from it; 0 to wait for them as long as they are expected");
+        deadline->on_set([this](float value) { update_deadline_poll(value); });
+        register_option(RS2_OPTION_SYNC_DEADLINE, deadline);
+
+        register_option(RS2_OPTION_SYNC_DROP_LATE_FRAMES,
+            std::make_shared< ptr_option< bool > >(false, true, true, false, &_policy->drop_late,
+                "Drop frames that arrive after the set they belong to was released by the deadline, rather "
+                "than releasing them alone"));
+        register_option(RS2_OPTION_SYNC_LATE_FRAMES,
+            std::make_shared< sync_counter_option >(_policy, &sync_policy::late_frames,
+                "Number of frames that missed the deadline of their set"));
+        register_option(RS2_OPTION_SYNC_DROPPED_FRAMES,
+            std::make_shared< sync_counter_option >(_policy, &sync_policy::dropped_frames,
+                "Number of late frames dropped"));
+
         _matcher->set_callback( []( frame_holder f, syncronization_environment const & env ) {
             if( env.log )
             {
@@ -61,33 +111,64 @@ namespace librealsense
                     LOG_DEBUG( "matcher was stopped: NOT DISPATCHING FRAME!" );
                     return;
                 }
+                _source = source;
                 _matcher->dispatch(std::move(frame), { source, _matches, log });
             }
 
-            frame_holder f;
+            deliver_matches();
+        };
+
+        set_processing_callback( make_frame_processor_callback( std::move( f ) ) );
+    }
+
+    void syncer_process_unit::deliver_matches()
+    {
+        // Another thread has the lock, meaning will get into the following loop and dequeue all
+        // the frames. So there's nothing for us to do...
+        std::unique_lock< std::mutex > lock(_callback_mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+            return;
+
+        frame_holder f;
+        while (_matches.try_dequeue(&f))
+        {
+            LOG_DEBUG( "--> frame ready: " << *f.frame );
+            get_source().frame_ready(std::move(f));
+        }
+    }
+
+    void syncer_process_unit::update_deadline_poll(float deadline_ms)
+    {
+        if (deadline_ms <= 0)
+        {
+            _deadline_poll.reset();
+            return;
+        }
+        if (_deadline_poll)
+            return;  // Picks up the new deadline on its next round
+
+        _deadline_poll.reset(new active_object<>(
+            [this](dispatcher::cancellable_timer cancellable_timer)
             {
-                // Another thread has the lock, meaning will get into the following loop and dequeue all
-                // the frames. So there's nothing for us to do...
-                std::unique_lock< std::mutex > lock(_callback_mutex, std::try_to_lock);
-                if (!lock.owns_lock())
+                auto period = std::max(1, int(_policy->deadline_ms / 4));
+                if (!cancellable_timer.try_sleep(std::chrono::milliseconds(period)))
                     return;
-
-                while (_matches.try_dequeue(&f))
                 {
-                    LOG_DEBUG( "--> frame ready: " << *f.frame );
-                    get_source().frame_ready(std::move(f));
+                    std::lock_guard< std::mutex > lock(_mutex);
+                    if (!_source || !_matcher || !_matcher->get_active())
+                        return;
+                    _matcher->flush({ _source, _matches, _log });
                 }
-            }
-
-        };
-
-        set_processing_callback( make_frame_processor_callback( std::move( f ) ) );
+                deliver_matches();
+            }));
+        _deadline_poll->start();
     }
 
     // Stopping the syncer means no more frames will be enqueued, and any existing frames
     // pending dispatch will be lost!
     void syncer_process_unit::stop()
     {
+        _deadline_poll.reset();
         _matcher->stop();
     }
 }
@@ -14,15 +14,22 @@
 #include "archive.h"
 #include "option.h"
 
+#include <rsutils/concurrency/concurrency.h>
+
 namespace librealsense
 {
     class processing_block;
     class timestamp_composite_matcher;
+    struct sync_policy;
     class syncer_process_unit : public processing_block
     {
     public:
         syncer_process_unit(std::initializer_list< bool_option::ptr > enable_opts, bool log = true);
 
+        // Syncing with the given top-level matcher, rather than one that just wraps what each device's matchers output
+        syncer_process_unit(std::shared_ptr< matcher > top_matcher, std::initializer_list< bool_option::ptr > enable_opts,
+                            bool log = true);
+
         syncer_process_unit( bool_option::ptr is_enabled_opt = nullptr, bool log = true)
             : syncer_process_unit( { is_enabled_opt }, log) {}
 
@@ -37,10 +44,21 @@ namespace librealsense
 
         ~syncer_process_unit()
         {
+            _deadline_poll.reset();
             _matcher.reset();
         }
     private:
+        // Hands whatever the matchers released over to the next block
+        void deliver_matches();
+
+        // With a deadline, matches are due even when no new frame arrives to release them
+        void update_deadline_poll(float deadline_ms);
+
         std::shared_ptr<matcher> _matcher;
+        std::shared_ptr<sync_policy> _policy;
+        synthetic_source_interface* _source = nullptr;  // Of the last frame dispatched, under _mutex
+        bool _log;
+        std::unique_ptr< active_object<> > _deadline_poll;
         std::vector< std::weak_ptr<bool_option> > _enable_opts;
 
         single_consumer_frame_queue<frame_holder> _matches;
@@ -2,6 +2,8 @@
 // Copyright(c) 2017 Intel Corporation. All Rights Reserved.
 
 #include "proc/synthetic-stream.h"
+#include "proc/processing-thread-pool.h"
+#include "proc/output-profile-cache.h"
 
 #include "core/video.h"
 #include "core/motion-frame.h"
@@ -11,8 +13,11 @@
 #include <src/core/frame-processor-callback.h>
 #include "option.h"
 #include "stream.h"
+#include "environment.h"
 #include "types.h"
 #include <src/core/time-service.h>
+#include <src/frame-trace.h>
+#include <src/deferred-conversion.h>
 
 #include <rsutils/string/from.h>
 
@@ -35,18 +40,87 @@ namespace librealsense
     {
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
         register_info(RS2_CAMERA_INFO_NAME, name);
+        _trace_name = frame_trace::intern(name);
+        _source.set_subsystem(name);
         _source.init(std::shared_ptr<metadata_parser_map>());
     }
 
+    void processing_block::register_roi_options()
+    {
+        register_option(RS2_OPTION_FILTER_ROI_LEFT, std::make_shared<ptr_option<float>>(0.f, 1.f, 0.01f, 0.f, &_roi.left,
+            "Left edge of the region of interest, as a fraction of the frame width"));
+        register_option(RS2_OPTION_FILTER_ROI_TOP, std::make_shared<ptr_option<float>>(0.f, 1.f, 0.01f, 0.f, &_roi.top,
+            "Top edge of the region of interest, as a fraction of the frame height"));
+        register_option(RS2_OPTION_FILTER_ROI_RIGHT, std::make_shared<ptr_option<float>>(0.f, 1.f, 0.01f, 1.f, &_roi.right,
+            "Right edge of the region of interest, as a fraction of the frame width"));
+        register_option(RS2_OPTION_FILTER_ROI_BOTTOM, std::make_shared<ptr_option<float>>(0.f, 1.f, 0.01f, 1.f, &_roi.bottom,
+            "Bottom edge of the region of interest, as a fraction of the frame height"));
+    }
+
+    region_of_interest processing_block::get_roi(const rs2::frame& f, int width, int height) const
+    {
+        normalized_roi roi = _roi;
+        if (auto fr = dynamic_cast<frame*>((frame_interface*)f.get()))
+        {
+            auto const & in = fr->additional_data.roi;
+            roi.left = std::max(roi.left, in.left);
+            roi.top = std::max(roi.top, in.top);
+            roi.right = std::min(roi.right, in.right);
+            roi.bottom = std::min(roi.bottom, in.bottom);
+        }
+
+        // Pixels whose centers are inside; the tolerance lets set_roi() edges map back to the same pixels
+        const float eps = 1e-3f;
+        region_of_interest res;
+        res.min_x = std::max(0, int(std::ceil(roi.left * width - eps)));
+        res.min_y = std::max(0, int(std::ceil(roi.top * height - eps)));
+        res.max_x = std::min(width, int(std::floor(roi.right * width + eps))) - 1;
+        res.max_y = std::min(height, int(std::floor(roi.bottom * height + eps))) - 1;
+        return res;
+    }
+
+    void processing_block::set_roi(const rs2::frame& f, const region_of_interest& roi, int width, int height)
+    {
+        auto fr = dynamic_cast<frame*>((frame_interface*)f.get());
+        if (!fr || width <= 0 || height <= 0)
+            return;
+
+        auto & out = fr->additional_data.roi;
+        out.left = float(roi.min_x) / width;
+        out.top = float(roi.min_y) / height;
+        out.right = std::max(out.left, float(roi.max_x + 1) / width);
+        out.bottom = std::max(out.top, float(roi.max_y + 1) / height);
+    }
+
+    void processing_block::extract_roi(void* dst, const void* src, int width, int bpp, const region_of_interest& roi)
+    {
+        auto out = static_cast<uint8_t*>(dst);
+        auto in = static_cast<const uint8_t*>(src);
+        const size_t row_size = size_t(roi_width(roi)) * bpp;
+        for (int y = roi.min_y; y <= roi.max_y && row_size; ++y, out += row_size)
+            memcpy(out, in + (size_t(y) * width + roi.min_x) * bpp, row_size);
+    }
+
+    void processing_block::insert_roi(void* dst, const void* src, int width, int height, int bpp, const region_of_interest& roi)
+    {
+        auto out = static_cast<uint8_t*>(dst);
+        auto in = static_cast<const uint8_t*>(src);
+        memset(out, 0, size_t(width) * height * bpp);
+        const size_t row_size = size_t(roi_width(roi)) * bpp;
+        for (int y = roi.min_y; y <= roi.max_y && row_size; ++y, in += row_size)
+            memcpy(out + (size_t(y) * width + roi.min_x) * bpp, in, row_size);
+    }
+
     void processing_block::invoke(frame_holder f)
     {
         frame_source::archive_id id
-            = { f->get_stream()->get_stream_type(), f->get_stream()->get_stream_index(), RS2_EXTENSION_VIDEO_FRAME };
+            = { f->peek_stream()->get_stream_type(), f->peek_stream()->get_stream_index(), RS2_EXTENSION_VIDEO_FRAME };
         auto callback = _source.begin_callback( id );
         try
         {
             if (_callback)
             {
+                frame_trace::scope trace( f.frame, _trace_name );
                 frame_interface* ptr = nullptr;
                 std::swap(f.frame, ptr);
 
@@ -116,7 +190,7 @@ namespace librealsense
         // in case the input frame is a frameset, create an output frameset from the input frameset and the processed frame by the following heuristic:
         // if one of the input frames has the same stream type and format as the processed frame,
         //     remove the input frame from the output frameset (i.e. temporal filter), otherwise keep the input frame (i.e. colorizer).
-        // the exception is in case one of the input frames is z16/z16h or disparity and the result frame is disparity or z16 respectively,
+        // the exception is in case one of the input frames is z16/z16h/z16_sparse or disparity and the result frame is disparity/z16_sparse or z16 respectively,
         // in this case the input frame will be removed.
 
         if (results.empty())
@@ -126,6 +200,7 @@ namespace librealsense
 
         bool disparity_result_frame = false;
         bool depth_result_frame = false;
+        bool sparse_result_frame = false;
 
         for (auto f : results)
         {
@@ -134,6 +209,8 @@ namespace librealsense
                 disparity_result_frame = true;
             if (format == RS2_FORMAT_Z16)
                 depth_result_frame = true;
+            if (format == RS2_FORMAT_Z16_SPARSE)
+                sparse_result_frame = true;
         }
 
         std::vector<rs2::frame> original_set;
@@ -141,9 +218,9 @@ namespace librealsense
             composite.foreach_rs([&](const rs2::frame& frame)
             {
                 auto format = frame.get_profile().format();
-                if (depth_result_frame &&  val_in_range(format, { RS2_FORMAT_DISPARITY32, RS2_FORMAT_DISPARITY16, RS2_FORMAT_Z16H }))
+                if (depth_result_frame &&  val_in_range(format, { RS2_FORMAT_DISPARITY32, RS2_FORMAT_DISPARITY16, RS2_FORMAT_Z16H, RS2_FORMAT_Z16_SPARSE }))
                     return;
-                if (disparity_result_frame && format == RS2_FORMAT_Z16)
+                if ((disparity_result_frame || sparse_result_frame) && format == RS2_FORMAT_Z16)
                     return;
                 original_set.push_back(frame);
             });
@@ -242,11 +319,57 @@ namespace librealsense
         if (p.get() != _source_stream_profile.get())
         {
             _source_stream_profile = p;
-            _target_stream_profile = p.clone(p.stream_type(), p.stream_index(), _target_format);
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(
+                p, p.stream_type(), p.stream_index(), _target_format);
             _target_bpp = get_image_bpp(_target_format) / 8;
         }
     }
 
+    void row_band_splitter::set_thread_budget( std::shared_ptr< std::atomic< int > > const & budget )
+    {
+        _thread_budget = budget;
+        // Lazy conversions split frames from whatever thread asks for the data, so the pool isn't left to the first
+        if( ! _thread_pool )
+            _thread_pool = processing_thread_pool::instance();
+    }
+
+    void row_band_splitter::for_each_row_band( int width, int height, std::function< void( int, int, size_t ) > const & fn )
+    {
+        int threads = _thread_budget ? _thread_budget->load() : 1;
+        int rows = 0;
+        size_t source_bytes = 0;
+#if defined( RS2_USE_CUDA ) || defined( RS2_USE_VULKAN ) || defined( RS2_USE_OPENCL )
+        // The GPU backends take whole frames
+        threads = 1;
+#endif
+        if( threads <= 1 || width <= 0 || ! get_row_group( width, rows, source_bytes ) || rows <= 0 )
+        {
+            fn( 0, height, 0 );
+            return;
+        }
+
+        // The SIMD kernels work on up to 32 pixels at a time, which every band has to be a multiple of
+        while( ( size_t( rows ) * width ) % 32 )
+        {
+            rows *= 2;
+            source_bytes *= 2;
+        }
+        auto groups = size_t( height / rows );
+        if( groups < 2 )
+        {
+            fn( 0, height, 0 );
+            return;
+        }
+
+        if( ! _thread_pool )
+            _thread_pool = processing_thread_pool::instance();
+        _thread_pool->parallel_for( groups, threads, [&]( size_t begin, size_t end ) {
+            int first = int( begin ) * rows;
+            int last = end == groups ? height : int( end ) * rows;  // The last band takes whatever doesn't make a group
+            fn( first, last - first, begin * source_bytes );
+        } );
+    }
+
     rs2::frame functional_processing_block::process_frame(const rs2::frame_source & source, const rs2::frame & f)
     {
         auto&& ret = prepare_frame(source, f);
@@ -260,11 +383,20 @@ namespace librealsense
             height = vf.get_height();
             if (f.supports_frame_metadata(RS2_FRAME_METADATA_RAW_FRAME_SIZE))
                 raw_size = static_cast<int>(f.get_frame_metadata(RS2_FRAME_METADATA_RAW_FRAME_SIZE));
+            else
+                raw_size = f.get_data_size();  // Compressed formats need to know where the data ends
         }
-        uint8_t * planes[1];
-        planes[0] = (uint8_t *)ret.get_data();
+        auto dst = (uint8_t *)ret.get_data();
+        auto src = static_cast<const uint8_t *>(f.get_data());
+        auto row_size = width * _target_bpp;
 
-        process_function(planes, static_cast<const uint8_t *>(f.get_data()), width, height, height * width * _target_bpp, raw_size);
+        for_each_row_band(width, height, [&](int first_row, int rows, size_t first_byte)
+        {
+            uint8_t * planes[1];
+            planes[0] = dst + size_t(first_row) * row_size;
+            auto band_raw_size = rows == height ? raw_size : int(raw_size - first_byte);
+            process_function(planes, src + first_byte, width, rows, rows * row_size, band_raw_size);
+        });
 
         return ret;
     }
@@ -503,30 +635,38 @@ namespace librealsense
     }
 
     frame_interface* synthetic_source::allocate_composite_frame(std::vector<frame_holder> holders)
+    {
+        return allocate_composite_frame(holders.data(), holders.size());
+    }
+
+    frame_interface* synthetic_source::allocate_composite_frame(frame_holder* holders, size_t count)
     {
         frame_additional_data d{};
 
         auto req_size = 0;
-        for (auto&& f : holders)
-            req_size += get_embeded_frames_size(f.frame);
+        for (size_t i = 0; i < count; ++i)
+            req_size += get_embeded_frames_size(holders[i].frame);
 
+        // Small framesets are kept inline, and need no memory but the frame itself
+        bool const is_inline = size_t(req_size) <= composite_frame::INLINE_FRAMES;
         auto res = _actual_source.alloc_frame( { RS2_STREAM_ANY, 0, RS2_EXTENSION_COMPOSITE_FRAME }, // Special case for composite frames
-                                               req_size * sizeof( rs2_frame * ),
+                                               is_inline ? 0 : req_size * sizeof( rs2_frame * ),
                                                std::move( d ),
-                                               true );
+                                               ! is_inline );
         if (!res) return nullptr;
 
         auto cf = static_cast<composite_frame*>(res);
+        cf->set_embedded_frames_count(req_size);
 
-        for (auto&& f : holders)
+        for (size_t i = 0; i < count; ++i)
         {
-            if (f->is_blocking())
+            if (holders[i]->is_blocking())
                 res->set_blocking(true);
         }
 
         auto frames = cf->get_frames();
-        for (auto&& f : holders)
-            copy_frames(std::move(f), frames);
+        for (size_t i = 0; i < count; ++i)
+            copy_frames(std::move(holders[i]), frames);
         frames -= req_size;
 
         auto releaser = [frames, req_size]()
@@ -648,20 +788,17 @@ namespace librealsense
             if (profile.get() != _source_stream_profile.get())
             {
                 _source_stream_profile = profile;
-                _right_target_stream_profile = profile->clone();
-                _left_target_stream_profile = profile->clone();
+                auto & profiles = environment::get_instance().get_output_profile_cache();
+                auto left_idx = _left_target_profile_idx, right_idx = _right_target_profile_idx;
+                _left_target_stream_profile = profiles.get(
+                    { profile.get(), _left_target_stream, left_idx, _left_target_format, "interleaved" },
+                    [left_idx](stream_profile_interface& p) { p.set_unique_id(left_idx); });
+                _right_target_stream_profile = profiles.get(
+                    { profile.get(), _right_target_stream, right_idx, _right_target_format, "interleaved" },
+                    [right_idx](stream_profile_interface& p) { p.set_unique_id(right_idx); });
 
                 _left_target_bpp = get_image_bpp(_left_target_format) / 8;
                 _right_target_bpp = get_image_bpp(_right_target_format) / 8;
-
-                _left_target_stream_profile->set_format(_left_target_format);
-                _right_target_stream_profile->set_format(_right_target_format);
-                _left_target_stream_profile->set_stream_type(_left_target_stream);
-                _right_target_stream_profile->set_stream_type(_right_target_stream);
-                _left_target_stream_profile->set_stream_index(_left_target_profile_idx);
-                _left_target_stream_profile->set_unique_id(_left_target_profile_idx);
-                _right_target_stream_profile->set_stream_index(_right_target_profile_idx);
-                _right_target_stream_profile->set_unique_id(_right_target_profile_idx);
             }
 
             // passthrough the frame if we don't need to process it.
@@ -679,12 +816,53 @@ namespace librealsense
             rf = source->allocate_video_frame(_right_target_stream_profile, frame, _right_target_bpp,
                 w, h, w * _right_target_bpp, _right_extension_type);
 
-            // process the frame
-            uint8_t * planes[2];
-            planes[0] = (uint8_t *)lf.frame->get_frame_data();
-            planes[1] = (uint8_t *)rf.frame->get_frame_data();
-
-            process_function(planes, (const uint8_t *)frame->get_frame_data(), w, h, 0, 0);
+            auto left = (uint8_t *)lf.frame->get_frame_data();
+            auto right = (uint8_t *)rf.frame->get_frame_data();
+            auto left_bpp = _left_target_bpp;
+            auto right_bpp = _right_target_bpp;
+            auto convert = [this, w, h, left_bpp, right_bpp]( uint8_t * const dest[], const uint8_t * src )
+            {
+                for_each_row_band(w, h, [&](int first_row, int rows, size_t first_byte)
+                {
+                    uint8_t * planes[2];
+                    planes[0] = dest[0] + size_t(first_row) * w * left_bpp;
+                    planes[1] = dest[1] + size_t(first_row) * w * right_bpp;
+                    process_function(planes, src + first_byte, w, rows, 0, 0);
+                });
+            };
+
+            auto lazy_left = dynamic_cast< librealsense::frame * >( lf.frame );
+            auto lazy_right = dynamic_cast< librealsense::frame * >( rf.frame );
+            if( _lazy && *_lazy && lazy_left && lazy_right )
+            {
+                // The raw frame goes with the conversion, until it runs or both frames are released
+                auto raw = std::make_shared< frame_holder >( std::move( frame ) );
+                auto deferred = std::make_shared< deferred_conversion >(
+                    [convert, raw]( uint8_t * const planes[] )
+                    { convert( planes, (const uint8_t *)raw->frame->get_frame_data() ); },
+                    std::vector< uint8_t * >{ left, right },
+                    std::vector< size_t >{ size_t( w ) * h * left_bpp, size_t( w ) * h * right_bpp } );
+                lazy_left->deferred = deferred;
+                lazy_left->deferred_plane = 0;
+                lazy_right->deferred = deferred;
+                lazy_right->deferred_plane = 1;
+                {
+                    std::lock_guard< std::mutex > lock( _deferred_mutex );
+                    _deferred.erase( std::remove_if( _deferred.begin(), _deferred.end(),
+                                                     []( std::weak_ptr< deferred_conversion > const & d )
+                                                     {
+                                                         auto p = d.lock();
+                                                         return ! p || p->is_done();
+                                                     } ),
+                                     _deferred.end() );
+                    _deferred.push_back( deferred );
+                }
+            }
+            else
+            {
+                uint8_t * const planes[2] = { left, right };
+                convert( planes, (const uint8_t *)frame->get_frame_data() );
+            }
 
             source->frame_ready(std::move(lf));
             source->frame_ready(std::move(rf));
@@ -692,4 +870,16 @@ namespace librealsense
 
         set_processing_callback( make_frame_processor_callback( std::move( process_callback ) ) );
     }
+
+    void interleaved_functional_processing_block::run_deferred()
+    {
+        std::vector< std::weak_ptr< deferred_conversion > > pending;
+        {
+            std::lock_guard< std::mutex > lock( _deferred_mutex );
+            pending.swap( _deferred );
+        }
+        for( auto & d : pending )
+            if( auto p = d.lock() )
+                p->run();
+    }
 }
@@ -9,12 +9,19 @@
 
 #include <src/core/info.h>
 #include <src/core/options-container.h>
+#include <src/core/roi.h>
+#include <src/core/frame-additional-data.h>
 
 #include <librealsense2/hpp/rs_frame.hpp>
 #include <librealsense2/hpp/rs_processing.hpp>
 
+#include <algorithm>
+#include <atomic>
+
 namespace librealsense
 {
+    class processing_thread_pool;
+    class deferred_conversion;
 
 
     // A synthetic source is simply a wrapper around a new frame_source and its exposure thru the rs2_source APIs
@@ -37,6 +44,7 @@ namespace librealsense
             rs2_extension frame_type = RS2_EXTENSION_MOTION_FRAME) override;
 
         frame_interface* allocate_composite_frame(std::vector<frame_holder> frames) override;
+        frame_interface* allocate_composite_frame(frame_holder* frames, size_t count) override;
 
         frame_interface* allocate_points(std::shared_ptr<stream_profile_interface> stream, 
             frame_interface* original, rs2_extension frame_type = RS2_EXTENSION_POINTS) override;
@@ -60,12 +68,41 @@ namespace librealsense
         void invoke(frame_holder frames) override;
         synthetic_source_interface& get_source() override { return _source_wrapper; }
 
+        void set_frame_allocator( std::shared_ptr< frame_allocator > const & allocator ) { _source.set_frame_allocator( allocator ); }
+
         virtual ~processing_block() { _source.flush(); }
     protected:
+        // Region of interest, for the blocks that register the RS2_OPTION_FILTER_ROI_* options: they compute inside
+        // it only and output no data outside it. The region a frame was restricted to goes with it to the frames
+        // derived from it, so the next block in a chain works inside both.
+        void register_roi_options();
+
+        // The pixels of the width x height frame f to work on: the options' region, within the one f was already
+        // restricted to. max_x/max_y are inclusive, and less than min_x/min_y when there's nothing to do.
+        region_of_interest get_roi(const rs2::frame& f, int width, int height) const;
+
+        // Records on f, a width x height frame, the region it was restricted to
+        static void set_roi(const rs2::frame& f, const region_of_interest& roi, int width, int height);
+
+        static bool is_full_roi(const region_of_interest& roi, int width, int height)
+        {
+            return roi.min_x <= 0 && roi.min_y <= 0 && roi.max_x >= width - 1 && roi.max_y >= height - 1;
+        }
+
+        static int roi_width(const region_of_interest& roi) { return std::max(0, roi.max_x - roi.min_x + 1); }
+        static int roi_height(const region_of_interest& roi) { return std::max(0, roi.max_y - roi.min_y + 1); }
+
+        // Copies the region of a frame 'width' pixels wide into the contiguous dst, or back from the contiguous src
+        // into a width x height frame, zeroing the rest of it
+        static void extract_roi(void* dst, const void* src, int width, int bpp, const region_of_interest& roi);
+        static void insert_roi(void* dst, const void* src, int width, int height, int bpp, const region_of_interest& roi);
+
         frame_source _source;
         std::mutex _mutex;
         rs2_frame_processor_callback_sptr _callback;
         synthetic_source _source_wrapper;
+        normalized_roi _roi;
+        char const * _trace_name;  // Our name, for frame_trace
     };
 
     class LRS_EXTENSION_API generic_processing_block : public processing_block
@@ -143,12 +180,42 @@ namespace librealsense
         bool should_process(const rs2::frame& frame) override;
     };
 
+    // Splits frames into bands of rows, converted at the same time on the shared processing pool, for converters whose
+    // rows don't depend on each other. How many threads is a budget shared by all of a sensor's converters (see
+    // RS2_OPTION_CONVERSION_THREADS); without one, frames are converted whole on the calling thread.
+    class row_band_splitter
+    {
+    public:
+        virtual ~row_band_splitter() = default;
+
+        void set_thread_budget( std::shared_ptr< std::atomic< int > > const & budget );
+
+    protected:
+        // Converters whose rows are independent override this: 'rows' rows of output come from 'source_bytes' bytes
+        // of source, and bands are made of whole groups of them. False (the default) converts each frame whole.
+        virtual bool get_row_group( int width, int & rows, size_t & source_bytes ) const { return false; }
+
+        // Calls fn( first_row, n_rows, first_source_byte ) for bands that together cover [0, height), or once for the
+        // whole frame if it isn't to be split
+        void for_each_row_band( int width, int height, std::function< void( int, int, size_t ) > const & fn );
+
+        // How many threads the budget allows right now, for converters that split their frames some other way
+        int get_thread_budget() const { return _thread_budget ? std::max( 1, _thread_budget->load() ) : 1; }
+
+    private:
+        std::shared_ptr< std::atomic< int > > _thread_budget;
+        std::shared_ptr< processing_thread_pool > _thread_pool;
+    };
+
     // process frames with a given function
-    class LRS_EXTENSION_API functional_processing_block : public stream_filter_processing_block
+    class LRS_EXTENSION_API functional_processing_block : public stream_filter_processing_block, public row_band_splitter
     {
     public:
         functional_processing_block(const char* name, rs2_format target_format, rs2_stream target_stream = RS2_STREAM_ANY, rs2_extension extension_type = RS2_EXTENSION_VIDEO_FRAME);
 
+        rs2_format get_target_format() const { return _target_format; }
+        rs2_stream get_target_stream() const { return _target_stream; }
+
     protected:
         virtual void init_profiles_info(const rs2::frame* f);
         rs2::frame process_frame(const rs2::frame_source & source, const rs2::frame & f) override;
@@ -164,7 +231,7 @@ namespace librealsense
     };
 
     // process interleaved frames with a given function
-    class interleaved_functional_processing_block : public processing_block
+    class interleaved_functional_processing_block : public processing_block, public row_band_splitter
     {
     public:
         interleaved_functional_processing_block(const char* name,
@@ -178,6 +245,15 @@ namespace librealsense
             rs2_extension right_extension_type,
             int right_idx);
 
+        // When set, both frames are put out as soon as they're allocated, and converted when the data of either is
+        // first asked for (see deferred_conversion): an output nobody looks at isn't converted. Shared by all the
+        // converters of a sensor, like the thread budget.
+        void set_lazy_conversion( std::shared_ptr< std::atomic< bool > > const & lazy ) { _lazy = lazy; }
+
+        // Lazy conversions call the block when they run, so those of the frames still out there are run before it's
+        // destroyed
+        void run_deferred();
+
     protected:
         virtual void process_function(uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) = 0;
         void configure_processing_callback();
@@ -196,6 +272,10 @@ namespace librealsense
         int _right_target_bpp = 0;
         int _left_target_profile_idx = 1;
         int _right_target_profile_idx = 2;
+
+        std::shared_ptr< std::atomic< bool > > _lazy;
+        std::mutex _deferred_mutex;
+        std::vector< std::weak_ptr< deferred_conversion > > _deferred;     // Those that may not have run yet
     };
 
     class depth_processing_block : public stream_filter_processing_block
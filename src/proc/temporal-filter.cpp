@@ -6,11 +6,25 @@
 #include "source.h"
 #include "option.h"
 #include "environment.h"
+#include "stream.h"
 #include "proc/synthetic-stream.h"
 #include "proc/temporal-filter.h"
+#include "proc/output-profile-cache.h"
+
+#ifdef RS2_USE_CUDA
+#include "proc/cuda/cuda-depth-filters.h"
+#endif
 
 #include <rsutils/string/from.h>
 
+#include <cmath>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 
 namespace librealsense
 {
@@ -34,6 +48,20 @@ namespace librealsense
     const uint8_t temp_delta_default = 20;
     const uint8_t temp_delta_step = 1;
 
+    // A warp moving no pixel by this much is left out
+    const float min_warp_pixels = 0.25f;
+    // Gyro samples kept while no depth frame comes
+    const size_t max_gyro_samples = 1000;
+
+    std::shared_ptr<temporal_filter> temporal_filter::create()
+    {
+        #ifdef RS2_USE_CUDA
+            return std::make_shared<librealsense::temporal_filter_cuda>();
+        #else
+            return std::make_shared<librealsense::temporal_filter>();
+        #endif
+    }
+
     temporal_filter::temporal_filter() :
         depth_processing_block("Temporal Filter"),
         _persistence_param(persistence_default),
@@ -42,7 +70,14 @@ namespace librealsense
         _delta_param(temp_delta_default),
         _width(0), _height(0), _stride(0), _bpp(0),
         _extension_type(RS2_EXTENSION_DEPTH_FRAME),
-        _current_frm_size_pixels(0)
+        _current_frm_size_pixels(0),
+        _history_roi{ 0, 0, -1, -1 },
+        _motion_compensation(0),
+        _intrinsics{},
+        _has_intrinsics(false),
+        _gyro_domain(RS2_TIMESTAMP_DOMAIN_COUNT),
+        _last_timestamp(0),
+        _last_domain(RS2_TIMESTAMP_DOMAIN_COUNT)
     {
         _stream_filter.stream = RS2_STREAM_DEPTH;
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -113,26 +148,228 @@ namespace librealsense
         register_option(RS2_OPTION_FILTER_SMOOTH_ALPHA, temporal_filter_alpha);
         register_option(RS2_OPTION_FILTER_SMOOTH_DELTA, temporal_filter_delta);
 
+        auto motion_compensation = std::make_shared<ptr_option<uint8_t>>(uint8_t(0), uint8_t(1), uint8_t(1), uint8_t(0),
+            &_motion_compensation,
+            "Warp the history by the rotation since the last frame, measured by the gyro frames of the same device "
+            "passed through the filter");
+        motion_compensation->on_set([this](float val)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _motion_compensation = static_cast<uint8_t>(val);
+            _gyro.clear();
+            _last_domain = RS2_TIMESTAMP_DOMAIN_COUNT;
+            _last_frame.clear();
+            _history.clear();
+        });
+        register_option(RS2_OPTION_TEMPORAL_MOTION_COMPENSATION, motion_compensation);
+
         on_set_persistence_control(_persistence_param);
         on_set_delta(_delta_param);
         on_set_alpha(_alpha_param);
+
+        register_roi_options();
+    }
+
+    static bool is_gyro(const rs2::frame& f)
+    {
+        return f.is<rs2::motion_frame>() && f.get_profile().stream_type() == RS2_STREAM_GYRO;
+    }
+
+    bool temporal_filter::should_process(const rs2::frame& frame)
+    {
+        if (_motion_compensation && frame && !frame.is<rs2::frameset>() && is_gyro(frame))
+            return true;
+        return depth_processing_block::should_process(frame);
     }
 
     rs2::frame temporal_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
     {
+        // Gyro frames go through as they are
+        if (is_gyro(f))
+        {
+            add_gyro(f);
+            return f;
+        }
+
         update_configuration(f);
-        auto tgt = prepare_target_frame(f, source);
+        auto roi = get_roi(f, int(_width), int(_height));
+        auto tgt = prepare_target_frame(f, source, roi);
+
+        // With a region of interest, the filter runs on a compact copy of it, and the history is of the region's
+        // pixels: when the region changes, the history of the pixels it still has is kept, and the others start over
+        const bool full = is_full_roi(roi, int(_width), int(_height));
+        void* data = full ? const_cast<void*>(tgt.get_data()) : _roi_image.data();
+        size_t count = full ? _current_frm_size_pixels : size_t(roi_width(roi)) * roi_height(roi);
+        if (!_last_frame.empty() && (roi.min_x != _history_roi.min_x || roi.min_y != _history_roi.min_y
+            || roi.max_x != _history_roi.max_x || roi.max_y != _history_roi.max_y))
+            move_history(roi);
+        // None yet, or the CUDA filter's marker
+        if (_last_frame.size() != count * _bpp || _history.size() != count)
+        {
+            _history_roi = roi;
+            _last_frame.assign(count * _bpp, 0);
+            _history.assign(count, 0);
+        }
+
+        // The rotation is measured for every frame, but the history of a region of interest isn't warped
+        float rotation[9];
+        if (_motion_compensation && rotation_since_last(f, rotation) && full && _has_intrinsics)
+        {
+            if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
+                warp_history<float>(rotation);
+            else
+                warp_history<uint16_t>(rotation);
+        }
 
         // Temporal filter execution
         if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
-            temp_jw_smooth<float>(const_cast<void*>(tgt.get_data()), _last_frame.data(), _history.data());
+            temp_jw_smooth<float>(data, _last_frame.data(), _history.data(), count);
         else
-            temp_jw_smooth<uint16_t>(const_cast<void*>(tgt.get_data()), _last_frame.data(), _history.data());
+            temp_jw_smooth<uint16_t>(data, _last_frame.data(), _history.data(), count);
 
+        if (!full)
+            insert_roi(const_cast<void*>(tgt.get_data()), data, int(_width), int(_height), int(_bpp), roi);
+        set_roi(tgt, roi, int(_width), int(_height));
         return tgt;
     }
 
 
+    void temporal_filter::move_history(const region_of_interest& roi)
+    {
+        const size_t old_width = roi_width(_history_roi), new_width = roi_width(roi);
+        const size_t old_count = old_width * roi_height(_history_roi);
+        const size_t new_count = new_width * roi_height(roi);
+
+        std::vector<uint8_t> last_frame(new_count * _bpp, 0), history(new_count, 0);
+        // A history that isn't of the last region (the CUDA filter keeps its own) has nothing to keep
+        if (_last_frame.size() == old_count * _bpp && _history.size() == old_count)
+        {
+            int x0 = std::max(roi.min_x, _history_roi.min_x), x1 = std::min(roi.max_x, _history_roi.max_x);
+            int y0 = std::max(roi.min_y, _history_roi.min_y), y1 = std::min(roi.max_y, _history_roi.max_y);
+            for (int y = y0; x0 <= x1 && y <= y1; ++y)
+            {
+                size_t from = (y - _history_roi.min_y) * old_width + (x0 - _history_roi.min_x);
+                size_t to = (y - roi.min_y) * new_width + (x0 - roi.min_x);
+                size_t n = size_t(x1 - x0 + 1);
+                memcpy(last_frame.data() + to * _bpp, _last_frame.data() + from * _bpp, n * _bpp);
+                memcpy(history.data() + to, _history.data() + from, n);
+            }
+        }
+        _last_frame.swap(last_frame);
+        _history.swap(history);
+        _history_roi = roi;
+    }
+
+    void temporal_filter::add_gyro(const rs2::frame& f)
+    {
+        auto domain = f.get_frame_timestamp_domain();
+        if (domain != _gyro_domain || f.get_profile().get() != _gyro_profile.get())
+        {
+            _gyro.clear();
+            _gyro_domain = domain;
+            _gyro_profile = f.get_profile();
+        }
+
+        const double timestamp = f.get_timestamp();
+        if (!_gyro.empty() && timestamp <= _gyro.back().timestamp)
+            return;
+        if (_gyro.size() >= max_gyro_samples)
+            _gyro.pop_front();
+
+        auto rate = f.as<rs2::motion_frame>().get_motion_data();
+        _gyro.push_back({ timestamp, { rate.x, rate.y, rate.z } });
+    }
+
+    bool temporal_filter::rotation_since_last(const rs2::frame& f, float rotation[9])
+    {
+        const double t0 = _last_timestamp, t1 = f.get_timestamp();
+        const auto domain = f.get_frame_timestamp_domain();
+        const bool has_last = _last_domain == domain && t0 < t1;
+        _last_timestamp = t1;
+        _last_domain = domain;
+        if (!has_last || _gyro.empty() || _gyro_domain != domain)
+            return false;
+
+        // Each sample holds until the next; a sample that comes after the depth frame it precedes is left out
+        float angle[3] = {};
+        for (size_t i = 0; i < _gyro.size(); ++i)
+        {
+            double from = std::max(t0, _gyro[i].timestamp);
+            double to = std::min(t1, i + 1 < _gyro.size() ? _gyro[i + 1].timestamp : t1);
+            if (to <= from)
+                continue;
+            const float dt = float((to - from) / 1000.);
+            for (int k = 0; k < 3; ++k)
+                angle[k] += _gyro[i].rate[k] * dt;
+        }
+        while (_gyro.size() > 1 && _gyro[1].timestamp <= t1)
+            _gyro.pop_front();
+
+        // To the depth's axes; without extrinsics, the gyro's data is taken to be aligned with them already
+        rs2_extrinsics to_depth = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0, 0, 0 } };
+        environment::get_instance().get_extrinsics_graph().try_fetch_extrinsics(
+            *_gyro_profile.get()->profile, *f.get_profile().get()->profile, &to_depth);
+        auto r = to_depth.rotation;
+        float axis[3];
+        for (int k = 0; k < 3; ++k)
+            axis[k] = r[k] * angle[0] + r[k + 3] * angle[1] + r[k + 6] * angle[2];
+
+        // The camera turns by the angle, so the points it sees turn back by it
+        const float a = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        if (!_has_intrinsics || a * std::max(_intrinsics.fx, _intrinsics.fy) < min_warp_pixels)
+            return false;
+        const float x = -axis[0] / a, y = -axis[1] / a, z = -axis[2] / a;
+        const float c = std::cos(a), s = std::sin(a), t = 1 - c;
+        const float rot[9] = { c + x * x * t,     x * y * t - z * s, x * z * t + y * s,
+                               y * x * t + z * s, c + y * y * t,     y * z * t - x * s,
+                               z * x * t - y * s, z * y * t + x * s, c + z * z * t };
+        std::copy(rot, rot + 9, rotation);
+        return true;
+    }
+
+    template<typename T>
+    void temporal_filter::warp_history(const float r[9])
+    {
+        const int w = int(_width), h = int(_height);
+        const float fx = _intrinsics.fx, fy = _intrinsics.fy, ppx = _intrinsics.ppx, ppy = _intrinsics.ppy;
+        auto last = reinterpret_cast<const T*>(_last_frame.data());
+        _warped_frame.assign(_last_frame.size(), 0);
+        _warped_history.assign(_history.size(), 0);
+        auto warped = reinterpret_cast<T*>(_warped_frame.data());
+
+        // Each pixel takes the nearest of the last frame along its ray turned back, v = R^T (x, y, 1): the point there,
+        // at Z in the last camera, is at Z / v.z in this one. Disparity is the inverse.
+        for (int y = 0; y < h; ++y)
+        {
+            const float ry = (y - ppy) / fy;
+            float base[3];
+            for (int k = 0; k < 3; ++k)
+                base[k] = r[3 + k] * ry + r[6 + k];
+            for (int x = 0; x < w; ++x)
+            {
+                const float rx = (x - ppx) / fx;
+                const float vx = base[0] + r[0] * rx, vy = base[1] + r[1] * rx, vz = base[2] + r[2] * rx;
+                if (vz <= 0)
+                    continue;
+                const int sx = int(std::floor(fx * vx / vz + ppx + 0.5f));
+                const int sy = int(std::floor(fy * vy / vz + ppy + 0.5f));
+                if (sx < 0 || sy < 0 || sx >= w || sy >= h)
+                    continue;
+                const size_t from = size_t(sy) * w + sx, to = size_t(y) * w + x;
+                const T val = last[from];
+                if (!val)
+                    continue;
+                if (std::is_floating_point<T>::value)
+                    warped[to] = static_cast<T>(val * vz);
+                else
+                    warped[to] = static_cast<T>(std::min(65535.f, val / vz + 0.5f));
+                _warped_history[to] = _history[from];
+            }
+        }
+        _last_frame.swap(_warped_frame);
+        _history.swap(_warped_history);
+    }
+
     void temporal_filter::on_set_persistence_control(uint8_t val)
     {
         std::lock_guard<std::mutex> lock(_mutex);
@@ -166,35 +403,324 @@ namespace librealsense
         if (f.get_profile().get() != _source_stream_profile.get())
         {
             _source_stream_profile = f.get_profile();
-            _target_stream_profile = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(
+                _source_stream_profile, RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
 
             //TODO - reject any frame other than depth/disparity
-            _extension_type = f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
-            _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
+            auto extension_type = f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
             auto vp = _target_stream_profile.as<rs2::video_stream_profile>();
+
+            // A new profile of the same frames (a stream restarted, say) goes on from the history of the last one
+            if (extension_type != _extension_type || size_t(vp.width()) != _width || size_t(vp.height()) != _height)
+            {
+                _last_frame.clear();
+                _history.clear();
+            }
+
+            _extension_type = extension_type;
+            _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
             _width = vp.width();
             _height = vp.height();
             _stride = _width*_bpp;
             _current_frm_size_pixels = _width * _height;
 
-            _last_frame.clear();
-            _last_frame.resize(_current_frm_size_pixels*_bpp);
-
-            _history.clear();
-            _history.resize(_current_frm_size_pixels*_bpp);
-
+            // Distortion aside: the warp is of small turns, by the pinhole model
+            try
+            {
+                _intrinsics = _source_stream_profile.as<rs2::video_stream_profile>().get_intrinsics();
+                _has_intrinsics = _intrinsics.fx > 0 && _intrinsics.fy > 0;
+            }
+            catch (...)
+            {
+                _has_intrinsics = false;
+            }
         }
     }
 
-    rs2::frame temporal_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source)
+    rs2::frame temporal_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source, const region_of_interest& roi)
     {
-        // Allocate and copy the content of the original Depth data to the target
+        // Allocate and copy the content of the original Depth data to the target, or only the region of interest aside
         rs2::frame tgt = source.allocate_video_frame(_target_stream_profile, f, (int)_bpp, (int)_width, (int)_height, (int)_stride, _extension_type);
 
-        memmove(const_cast<void*>(tgt.get_data()), f.get_data(), _current_frm_size_pixels * _bpp);
+        if (is_full_roi(roi, int(_width), int(_height)))
+            memmove(const_cast<void*>(tgt.get_data()), f.get_data(), _current_frm_size_pixels * _bpp);
+        else
+        {
+            _roi_image.resize(size_t(roi_width(roi)) * roi_height(roi) * _bpp);
+            extract_roi(_roi_image.data(), f.get_data(), (int)_width, (int)_bpp, roi);
+        }
         return tgt;
     }
 
+#if defined(__SSSE3__) || (defined(__aarch64__) && defined(__ARM_NEON))
+    // The persistence map for one phase as a 256-bit set: bit h is on when a pixel with history h is credible
+    // enough to be filled from the last frame. 32 bytes, so that it can be looked up 16 pixels at a time with byte
+    // shuffles/table lookups.
+    static void persistence_bits(const std::array<uint8_t, PRESISTENCY_LUT_SIZE>& persistence_map, uint8_t mask, uint8_t* bits)
+    {
+        std::fill(bits, bits + 32, 0);
+        for (int h = 0; h < 256; h++)
+            if (persistence_map[h] & mask)
+                bits[h >> 3] |= 1 << (h & 7);
+    }
+#endif
+
+#if defined(__SSSE3__)
+    static inline __m128i sse_select(__m128i m, __m128i a, __m128i b)
+    {
+        return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+    }
+
+    // Updates 16 history bytes, given per-pixel 0xFF masks of where the current value is valid, where it agrees
+    // with the last one, and where only the last one is valid. Returns where the hole is filled from the last frame.
+    static inline __m128i sse_update_history(uint8_t* history, __m128i cur, __m128i agree, __m128i hole, uint8_t mask,
+                                             __m128i bits_lo, __m128i bits_hi)
+    {
+        const __m128i m = _mm_set1_epi8(char(mask));
+        const __m128i bit_of = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+        __m128i hist = _mm_loadu_si128(reinterpret_cast<const __m128i*>(history));
+
+        // _persistence_map[hist] & mask: pick byte hist >> 3 of the 32-byte set, then bit hist & 7 in it
+        __m128i byte_index = _mm_and_si128(_mm_srli_epi16(hist, 3), _mm_set1_epi8(0x1F));
+        __m128i high_half = _mm_cmpeq_epi8(_mm_and_si128(byte_index, _mm_set1_epi8(0x10)), _mm_set1_epi8(0x10));
+        __m128i byte = sse_select(high_half, _mm_shuffle_epi8(bits_hi, byte_index), _mm_shuffle_epi8(bits_lo, byte_index));
+        __m128i bit = _mm_shuffle_epi8(bit_of, _mm_and_si128(hist, _mm_set1_epi8(7)));
+        __m128i credible = _mm_cmpeq_epi8(_mm_and_si128(byte, bit), bit);
+
+        __m128i updated = sse_select(cur, sse_select(agree, _mm_or_si128(hist, m), m), _mm_andnot_si128(m, hist));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(history), updated);
+
+        return _mm_and_si128(hole, credible);
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    // See the SSE version above
+    static inline uint8x16_t neon_update_history(uint8_t* history, uint8x16_t cur, uint8x16_t agree, uint8x16_t hole, uint8_t mask,
+                                                 uint8x16x2_t bits)
+    {
+        const uint8x16_t m = vdupq_n_u8(mask);
+
+        uint8x16_t hist = vld1q_u8(history);
+
+        uint8x16_t byte = vqtbl2q_u8(bits, vshrq_n_u8(hist, 3));
+        uint8x16_t bit = vshlq_u8(vdupq_n_u8(1), vreinterpretq_s8_u8(vandq_u8(hist, vdupq_n_u8(7))));
+        uint8x16_t credible = vtstq_u8(byte, bit);
+
+        vst1q_u8(history, vbslq_u8(cur, vbslq_u8(agree, vorrq_u8(hist, m), m), vbicq_u8(hist, m)));
+
+        return vandq_u8(hole, credible);
+    }
+#endif
+
+    size_t temporal_filter::temp_jw_smooth_simd(uint16_t* frame, uint16_t* last_frame, uint8_t* history, uint8_t mask, size_t count)
+    {
+        const size_t n = count & ~size_t(15);
+#if defined(__SSSE3__)
+        uint8_t bits[32];
+        persistence_bits(_persistence_map, mask, bits);
+        const __m128i bits_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits));
+        const __m128i bits_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + 16));
+
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i delta = _mm_set1_epi16(_delta_param);
+        const __m128 alpha = _mm_set1_ps(_alpha_param);
+        const __m128 one_minus_alpha = _mm_set1_ps(_one_minus_alpha);
+        const __m128i low_words = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+
+        for (size_t i = 0; i < n; i += 16)
+        {
+            __m128i cur[2], prev[2], cur_invalid[2], agree[2], hole[2], result[2];
+            for (int k = 0; k < 2; k++)
+            {
+                cur[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frame + i + 8 * k));
+                prev[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last_frame + i + 8 * k));
+
+                cur_invalid[k] = _mm_cmpeq_epi16(cur[k], zero);
+                __m128i prev_invalid = _mm_cmpeq_epi16(prev[k], zero);
+                __m128i diff = _mm_or_si128(_mm_subs_epu16(cur[k], prev[k]), _mm_subs_epu16(prev[k], cur[k]));
+                __m128i not_below_delta = _mm_cmpeq_epi16(_mm_subs_epu16(delta, diff), zero);
+                agree[k] = _mm_andnot_si128(_mm_or_si128(cur_invalid[k], _mm_or_si128(prev_invalid, not_below_delta)), _mm_set1_epi8(-1));
+                hole[k] = _mm_andnot_si128(prev_invalid, cur_invalid[k]);
+
+                // Same float arithmetic and truncation as the scalar code
+                __m128 lo = _mm_add_ps(_mm_mul_ps(alpha, _mm_cvtepi32_ps(_mm_unpacklo_epi16(cur[k], zero))),
+                                       _mm_mul_ps(one_minus_alpha, _mm_cvtepi32_ps(_mm_unpacklo_epi16(prev[k], zero))));
+                __m128 hi = _mm_add_ps(_mm_mul_ps(alpha, _mm_cvtepi32_ps(_mm_unpackhi_epi16(cur[k], zero))),
+                                       _mm_mul_ps(one_minus_alpha, _mm_cvtepi32_ps(_mm_unpackhi_epi16(prev[k], zero))));
+                result[k] = _mm_unpacklo_epi64(_mm_shuffle_epi8(_mm_cvttps_epi32(lo), low_words),
+                                               _mm_shuffle_epi8(_mm_cvttps_epi32(hi), low_words));
+            }
+
+            __m128i cur_valid8 = _mm_xor_si128(_mm_packs_epi16(cur_invalid[0], cur_invalid[1]), _mm_set1_epi8(-1));
+            __m128i fill = sse_update_history(history + i, cur_valid8, _mm_packs_epi16(agree[0], agree[1]),
+                                              _mm_packs_epi16(hole[0], hole[1]), mask, bits_lo, bits_hi);
+            __m128i fill16[2] = { _mm_unpacklo_epi8(fill, fill), _mm_unpackhi_epi8(fill, fill) };
+
+            for (int k = 0; k < 2; k++)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(frame + i + 8 * k),
+                                 sse_select(agree[k], result[k], sse_select(fill16[k], prev[k], cur[k])));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(last_frame + i + 8 * k),
+                                 sse_select(agree[k], result[k], sse_select(cur_invalid[k], prev[k], cur[k])));
+            }
+        }
+        return n;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        uint8_t bits[32];
+        persistence_bits(_persistence_map, mask, bits);
+        const uint8x16x2_t bits_tbl = { { vld1q_u8(bits), vld1q_u8(bits + 16) } };
+
+        const uint16x8_t delta = vdupq_n_u16(_delta_param);
+        const float32x4_t alpha = vdupq_n_f32(_alpha_param);
+        const float32x4_t one_minus_alpha = vdupq_n_f32(_one_minus_alpha);
+
+        for (size_t i = 0; i < n; i += 16)
+        {
+            uint16x8_t cur[2], prev[2], cur_valid[2], agree[2], hole[2], result[2];
+            for (int k = 0; k < 2; k++)
+            {
+                cur[k] = vld1q_u16(frame + i + 8 * k);
+                prev[k] = vld1q_u16(last_frame + i + 8 * k);
+
+                cur_valid[k] = vtstq_u16(cur[k], cur[k]);
+                uint16x8_t prev_valid = vtstq_u16(prev[k], prev[k]);
+                agree[k] = vandq_u16(vandq_u16(cur_valid[k], prev_valid), vcltq_u16(vabdq_u16(cur[k], prev[k]), delta));
+                hole[k] = vbicq_u16(prev_valid, cur_valid[k]);
+
+                // Same float arithmetic and truncation as the scalar code
+                float32x4_t lo = vaddq_f32(vmulq_f32(alpha, vcvtq_f32_u32(vmovl_u16(vget_low_u16(cur[k])))),
+                                           vmulq_f32(one_minus_alpha, vcvtq_f32_u32(vmovl_u16(vget_low_u16(prev[k])))));
+                float32x4_t hi = vaddq_f32(vmulq_f32(alpha, vcvtq_f32_u32(vmovl_u16(vget_high_u16(cur[k])))),
+                                           vmulq_f32(one_minus_alpha, vcvtq_f32_u32(vmovl_u16(vget_high_u16(prev[k])))));
+                result[k] = vcombine_u16(vmovn_u32(vcvtq_u32_f32(lo)), vmovn_u32(vcvtq_u32_f32(hi)));
+            }
+
+            uint8x16_t fill = neon_update_history(history + i,
+                                                  vcombine_u8(vmovn_u16(cur_valid[0]), vmovn_u16(cur_valid[1])),
+                                                  vcombine_u8(vmovn_u16(agree[0]), vmovn_u16(agree[1])),
+                                                  vcombine_u8(vmovn_u16(hole[0]), vmovn_u16(hole[1])),
+                                                  mask, bits_tbl);
+            uint16x8_t fill16[2] = { vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vget_low_u8(fill)))),
+                                     vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vget_high_u8(fill)))) };
+
+            for (int k = 0; k < 2; k++)
+            {
+                vst1q_u16(frame + i + 8 * k, vbslq_u16(agree[k], result[k], vbslq_u16(fill16[k], prev[k], cur[k])));
+                vst1q_u16(last_frame + i + 8 * k, vbslq_u16(agree[k], result[k], vbslq_u16(cur_valid[k], cur[k], prev[k])));
+            }
+        }
+        return n;
+#else
+        return 0;
+#endif
+    }
+
+    size_t temporal_filter::temp_jw_smooth_simd(float* frame, float* last_frame, uint8_t* history, uint8_t mask, size_t count)
+    {
+        const size_t n = count & ~size_t(15);
+#if defined(__SSSE3__)
+        uint8_t bits[32];
+        persistence_bits(_persistence_map, mask, bits);
+        const __m128i bits_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits));
+        const __m128i bits_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + 16));
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 delta = _mm_set1_ps(float(_delta_param));
+        const __m128 alpha = _mm_set1_ps(_alpha_param);
+        const __m128 one_minus_alpha = _mm_set1_ps(_one_minus_alpha);
+
+        for (size_t i = 0; i < n; i += 16)
+        {
+            __m128 cur[4], prev[4], cur_valid[4], agree[4], hole[4], result[4];
+            for (int k = 0; k < 4; k++)
+            {
+                cur[k] = _mm_loadu_ps(frame + i + 4 * k);
+                prev[k] = _mm_loadu_ps(last_frame + i + 4 * k);
+
+                // NaNs count as valid values, and never agree, just like in the scalar code
+                cur_valid[k] = _mm_cmpneq_ps(cur[k], zero);
+                __m128 prev_valid = _mm_cmpneq_ps(prev[k], zero);
+                __m128 diff = _mm_and_ps(_mm_sub_ps(cur[k], prev[k]), abs_mask);
+                agree[k] = _mm_and_ps(_mm_and_ps(cur_valid[k], prev_valid), _mm_cmplt_ps(diff, delta));
+                hole[k] = _mm_andnot_ps(cur_valid[k], prev_valid);
+                result[k] = _mm_add_ps(_mm_mul_ps(alpha, cur[k]), _mm_mul_ps(one_minus_alpha, prev[k]));
+            }
+
+            auto pack = [](const __m128* m)
+            {
+                return _mm_packs_epi16(_mm_packs_epi32(_mm_castps_si128(m[0]), _mm_castps_si128(m[1])),
+                                       _mm_packs_epi32(_mm_castps_si128(m[2]), _mm_castps_si128(m[3])));
+            };
+            __m128i fill = sse_update_history(history + i, pack(cur_valid), pack(agree), pack(hole), mask, bits_lo, bits_hi);
+            __m128i fill16_lo = _mm_unpacklo_epi8(fill, fill);
+            __m128i fill16_hi = _mm_unpackhi_epi8(fill, fill);
+            __m128 fill32[4] = { _mm_castsi128_ps(_mm_unpacklo_epi16(fill16_lo, fill16_lo)),
+                                 _mm_castsi128_ps(_mm_unpackhi_epi16(fill16_lo, fill16_lo)),
+                                 _mm_castsi128_ps(_mm_unpacklo_epi16(fill16_hi, fill16_hi)),
+                                 _mm_castsi128_ps(_mm_unpackhi_epi16(fill16_hi, fill16_hi)) };
+
+            for (int k = 0; k < 4; k++)
+            {
+                __m128 filled = _mm_or_ps(_mm_and_ps(fill32[k], prev[k]), _mm_andnot_ps(fill32[k], cur[k]));
+                __m128 last = _mm_or_ps(_mm_and_ps(cur_valid[k], cur[k]), _mm_andnot_ps(cur_valid[k], prev[k]));
+                _mm_storeu_ps(frame + i + 4 * k, _mm_or_ps(_mm_and_ps(agree[k], result[k]), _mm_andnot_ps(agree[k], filled)));
+                _mm_storeu_ps(last_frame + i + 4 * k, _mm_or_ps(_mm_and_ps(agree[k], result[k]), _mm_andnot_ps(agree[k], last)));
+            }
+        }
+        return n;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        uint8_t bits[32];
+        persistence_bits(_persistence_map, mask, bits);
+        const uint8x16x2_t bits_tbl = { { vld1q_u8(bits), vld1q_u8(bits + 16) } };
+
+        const float32x4_t zero = vdupq_n_f32(0);
+        const float32x4_t delta = vdupq_n_f32(float(_delta_param));
+        const float32x4_t alpha = vdupq_n_f32(_alpha_param);
+        const float32x4_t one_minus_alpha = vdupq_n_f32(_one_minus_alpha);
+
+        for (size_t i = 0; i < n; i += 16)
+        {
+            float32x4_t cur[4], prev[4], result[4];
+            uint32x4_t cur_valid[4], agree[4], hole[4];
+            for (int k = 0; k < 4; k++)
+            {
+                cur[k] = vld1q_f32(frame + i + 4 * k);
+                prev[k] = vld1q_f32(last_frame + i + 4 * k);
+
+                // NaNs count as valid values, and never agree, just like in the scalar code
+                cur_valid[k] = vmvnq_u32(vceqq_f32(cur[k], zero));
+                uint32x4_t prev_valid = vmvnq_u32(vceqq_f32(prev[k], zero));
+                agree[k] = vandq_u32(vandq_u32(cur_valid[k], prev_valid), vcltq_f32(vabdq_f32(cur[k], prev[k]), delta));
+                hole[k] = vbicq_u32(prev_valid, cur_valid[k]);
+                result[k] = vaddq_f32(vmulq_f32(alpha, cur[k]), vmulq_f32(one_minus_alpha, prev[k]));
+            }
+
+            auto pack = [](const uint32x4_t* m)
+            {
+                return vcombine_u8(vmovn_u16(vcombine_u16(vmovn_u32(m[0]), vmovn_u32(m[1]))),
+                                   vmovn_u16(vcombine_u16(vmovn_u32(m[2]), vmovn_u32(m[3]))));
+            };
+            uint8x16_t fill = neon_update_history(history + i, pack(cur_valid), pack(agree), pack(hole), mask, bits_tbl);
+            int16x8_t fill16_lo = vmovl_s8(vreinterpret_s8_u8(vget_low_u8(fill)));
+            int16x8_t fill16_hi = vmovl_s8(vreinterpret_s8_u8(vget_high_u8(fill)));
+            uint32x4_t fill32[4] = { vreinterpretq_u32_s32(vmovl_s16(vget_low_s16(fill16_lo))),
+                                     vreinterpretq_u32_s32(vmovl_s16(vget_high_s16(fill16_lo))),
+                                     vreinterpretq_u32_s32(vmovl_s16(vget_low_s16(fill16_hi))),
+                                     vreinterpretq_u32_s32(vmovl_s16(vget_high_s16(fill16_hi))) };
+
+            for (int k = 0; k < 4; k++)
+            {
+                vst1q_f32(frame + i + 4 * k, vbslq_f32(agree[k], result[k], vbslq_f32(fill32[k], prev[k], cur[k])));
+                vst1q_f32(last_frame + i + 4 * k, vbslq_f32(agree[k], result[k], vbslq_f32(cur_valid[k], cur[k], prev[k])));
+            }
+        }
+        return n;
+#else
+        return 0;
+#endif
+    }
+
     void temporal_filter::recalc_persistence_map()
     {
         _persistence_map.fill(0);
@@ -4,6 +4,8 @@
 #pragma once
 #include "types.h"
 
+#include <deque>
+
 namespace librealsense
 {
     const size_t PRESISTENCY_LUT_SIZE = 256;
@@ -11,16 +13,30 @@ namespace librealsense
     class temporal_filter : public depth_processing_block
     {
     public:
+        // The CUDA implementation when there is one
+        static std::shared_ptr<temporal_filter> create();
+
         temporal_filter();
 
     protected:
+        bool    should_process(const rs2::frame& frame) override;
         void    update_configuration(const rs2::frame& f);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
-        rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
+        rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source, const region_of_interest& roi);
+
+        // Smooths the first 'count' pixels of frame_data: the whole frame, or the compact copy of the region of interest
+        template<typename T>
+        void temp_jw_smooth(void* frame_data, void * _last_frame_data, uint8_t *history, size_t count)
+        {
+            temp_jw_smooth_pixels<T>(frame_data, _last_frame_data, history, count);
+            _cur_frame_index = (_cur_frame_index + 1) % 8;  // at end of cycle
+        }
 
+        // The pass of temp_jw_smooth over 'count' pixels, without moving on to the next frame: pixels are
+        // independent, so a frame can be done in several parts
         template<typename T>
-        void temp_jw_smooth(void* frame_data, void * _last_frame_data, uint8_t *history)
+        void temp_jw_smooth_pixels(void* frame_data, void * _last_frame_data, uint8_t *history, size_t count)
         {
             static_assert((std::is_arithmetic<T>::value), "temporal filter assumes numeric types");
 
@@ -34,7 +50,8 @@ namespace librealsense
             unsigned char mask = 1 << _cur_frame_index;
 
             // pass one -- go through image and update all
-            for (size_t i = 0; i < _current_frm_size_pixels; i++)
+            // (the vectorized pass does the same, 16 pixels at a time; the scalar loop takes whatever it leaves)
+            for (size_t i = temp_jw_smooth_simd(frame, _last_frame, history, mask, count); i < count; i++)
             {
                 T cur_val = frame[i];
                 T prev_val = _last_frame[i];
@@ -79,16 +96,38 @@ namespace librealsense
                     history[i] &= ~mask;
                 }
             }
-
-            _cur_frame_index = (_cur_frame_index + 1) % 8;  // at end of cycle
         }
 
+        // Vectorized equivalent of the temp_jw_smooth pass, for a multiple of 16 of the 'count' pixels from the start.
+        // Returns the number of pixels processed: 0 when there's no SIMD implementation for the platform.
+        size_t temp_jw_smooth_simd(uint16_t* frame, uint16_t* last_frame, uint8_t* history, uint8_t mask, size_t count);
+        size_t temp_jw_smooth_simd(float* frame, float* last_frame, uint8_t* history, uint8_t mask, size_t count);
+
     private:
+        friend class depth_pipeline;
+        friend class temporal_filter_cuda;
+
         void on_set_persistence_control(uint8_t val);
         void on_set_alpha(float val);
         void on_set_delta(float val);
 
         void recalc_persistence_map();
+
+        // The history of the pixels of both _history_roi and roi to where they are in roi; the others start over
+        void move_history(const region_of_interest& roi);
+
+        // Motion compensation: gyro frames passed through the filter are kept until the depth frame they precede,
+        // and the rotation they add up to since the last depth frame turns the history to the current one's view
+        struct gyro_sample
+        {
+            double timestamp;   // In ms
+            float rate[3];      // In rad/s, about the gyro's axes
+        };
+        void add_gyro(const rs2::frame& f);
+        // The rotation of the points of the last frame into the camera of f, row-major; false when there's none to do
+        bool rotation_since_last(const rs2::frame& f, float rotation[9]);
+        template<typename T> void warp_history(const float rotation[9]);
+
         uint8_t                 _persistence_param;
 
         float                   _alpha_param;               // The normalized weight of the current pixel
@@ -101,8 +140,19 @@ namespace librealsense
         rs2::stream_profile     _source_stream_profile;
         rs2::stream_profile     _target_stream_profile;
         std::vector<uint8_t>    _last_frame;                // Hold the last frame received for the current profile
-        std::vector<uint8_t>    _history;                   // represents the history over the last 8 frames, 1 bit per frame
+        std::vector<uint8_t>    _history;                   // represents the history over the last 8 frames, 1 bit per frame, a byte per pixel
+        std::vector<uint8_t>    _roi_image;                 // The region of interest, when there's one
+        region_of_interest      _history_roi;               // The region _last_frame and _history are for
         uint8_t                 _cur_frame_index;
+        uint8_t                 _motion_compensation;
+        rs2_intrinsics          _intrinsics;                // Of the source, for the warp
+        bool                    _has_intrinsics;
+        std::deque<gyro_sample> _gyro;
+        rs2::stream_profile     _gyro_profile;              // Of the samples in _gyro
+        rs2_timestamp_domain    _gyro_domain;
+        double                  _last_timestamp;            // Of the last depth frame
+        rs2_timestamp_domain    _last_domain;               // RS2_TIMESTAMP_DOMAIN_COUNT before any
+        std::vector<uint8_t>    _warped_frame, _warped_history;
         // encodes whether a particular 8 bit history is good enough for all 8 phases of storage
         std::array<uint8_t, PRESISTENCY_LUT_SIZE> _persistence_map;
     };
@@ -8,6 +8,7 @@
 #include "proc/synthetic-stream.h"
 #include "context.h"
 #include "environment.h"
+#include "proc/output-profile-cache.h"
 #include "option.h"
 #include "threshold.h"
 #include "image.h"
@@ -32,6 +33,8 @@ namespace librealsense
             std::make_shared<min_distance_option>(
                 min_opt,
                 max_opt));
+
+        register_roi_options();
     }
 
     rs2::frame threshold::process_frame(const rs2::frame_source& source, const rs2::frame& f)
@@ -41,7 +44,7 @@ namespace librealsense
         if (f.get_profile().get() != _source_stream_profile.get())
         {
             _source_stream_profile = f.get_profile();
-            _target_stream_profile = f.get_profile().clone(RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16);
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(f.get_profile(), RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16);
         }
 
         auto vf = f.as<rs2::depth_frame>();
@@ -67,11 +70,16 @@ namespace librealsense
             auto du = orig->get_units();
 
             memset(new_data, 0, width * height * sizeof(uint16_t));
-            for (int i = 0; i < width * height; i++)
+            auto roi = get_roi(f, width, height);
+            for (int y = roi.min_y; y <= roi.max_y; y++)
             {
-                auto dist = du * depth_data[i];
-                if (dist >= _min && dist <= _max) new_data[i] = depth_data[i];
+                for (int i = y * width + roi.min_x; i <= y * width + roi.max_x; i++)
+                {
+                    auto dist = du * depth_data[i];
+                    if (dist >= _min && dist <= _max) new_data[i] = depth_data[i];
+                }
             }
+            set_roi(new_f, roi, width, height);
 
             return new_f;
         }
@@ -0,0 +1,268 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/hpp/rs_sensor.hpp>
+#include <librealsense2/hpp/rs_processing.hpp>
+
+#include "option.h"
+#include "stream.h"
+#include "core/video.h"
+#include "projection.h"
+#include "environment.h"
+#include "proc/synthetic-stream.h"
+#include "proc/processing-thread-pool.h"
+#include "proc/output-profile-cache.h"
+#include "undistort-filter.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace librealsense
+{
+    // The number of threads the rows are split across
+    const uint8_t threads_min = 1;
+    const uint8_t threads_step = 1;
+    const uint8_t threads_def = 1;
+
+    namespace
+    {
+        // A pixel of the output from the 2x2 pixels p (the top ones) and p + stride (the bottom ones) of the frame
+        template<class T, int channels>
+        struct bilinear
+        {
+            static void pixel(const T* p, size_t stride, uint32_t w00, uint32_t w01, uint32_t w10, uint32_t w11, T* out)
+            {
+                const T* q = p + stride * channels;
+                for (int c = 0; c < channels; ++c)
+                    out[c] = T((p[c] * w00 + p[c + channels] * w01 + q[c] * w10 + q[c + channels] * w11 + 8192) >> 14);
+            }
+        };
+
+#if defined(__SSSE3__)
+        // The two pixels of a row are 8 bytes, interleaved by channel so that each pair is multiplied by its weights
+        // and added with one madd
+        template<>
+        struct bilinear<uint8_t, 4>
+        {
+            static void pixel(const uint8_t* p, size_t stride, uint32_t w00, uint32_t w01, uint32_t w10, uint32_t w11, uint8_t* out)
+            {
+                const __m128i interleave = _mm_setr_epi8(0, -1, 4, -1, 1, -1, 5, -1, 2, -1, 6, -1, 3, -1, 7, -1);
+                __m128i top = _mm_shuffle_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), interleave);
+                __m128i bottom = _mm_shuffle_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + stride * 4)), interleave);
+                __m128i sum = _mm_add_epi32(_mm_madd_epi16(top, _mm_set1_epi32(int(w00 | (w01 << 16)))),
+                                            _mm_madd_epi16(bottom, _mm_set1_epi32(int(w10 | (w11 << 16)))));
+                sum = _mm_srli_epi32(_mm_add_epi32(sum, _mm_set1_epi32(8192)), 14);
+                __m128i packed = _mm_packus_epi16(_mm_packs_epi32(sum, sum), sum);
+                int v = _mm_cvtsi128_si32(packed);
+                memcpy(out, &v, 4);
+            }
+        };
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        template<>
+        struct bilinear<uint8_t, 4>
+        {
+            static void pixel(const uint8_t* p, size_t stride, uint32_t w00, uint32_t w01, uint32_t w10, uint32_t w11, uint8_t* out)
+            {
+                uint16x8_t top = vmovl_u8(vld1_u8(p));
+                uint16x8_t bottom = vmovl_u8(vld1_u8(p + stride * 4));
+                uint32x4_t sum = vmull_n_u16(vget_low_u16(top), uint16_t(w00));
+                sum = vmlal_n_u16(sum, vget_high_u16(top), uint16_t(w01));
+                sum = vmlal_n_u16(sum, vget_low_u16(bottom), uint16_t(w10));
+                sum = vmlal_n_u16(sum, vget_high_u16(bottom), uint16_t(w11));
+                uint16x4_t narrow = vrshrn_n_u32(sum, 14);
+                uint8x8_t packed = vmovn_u16(vcombine_u16(narrow, narrow));
+                uint32_t v = vget_lane_u32(vreinterpret_u32_u8(packed), 0);
+                memcpy(out, &v, 4);
+            }
+        };
+#endif
+
+        template<class T, int channels>
+        void remap_row(const T* in, T* out, size_t stride, const int32_t* offsets, const uint16_t* weights, int width)
+        {
+            for (int x = 0; x < width; ++x, out += channels)
+            {
+                if (offsets[x] < 0)
+                {
+                    std::fill(out, out + channels, T(0));
+                    continue;
+                }
+                uint32_t fx = weights[x] & 0xff, fy = weights[x] >> 8;
+                bilinear<T, channels>::pixel(in + size_t(offsets[x]) * channels, stride,
+                    (128 - fx) * (128 - fy), fx * (128 - fy), (128 - fx) * fy, fx * fy, out);
+            }
+        }
+
+        bool is_remapped(rs2_format format)
+        {
+            switch (format)
+            {
+            case RS2_FORMAT_Y8:
+            case RS2_FORMAT_Y16:
+            case RS2_FORMAT_RGB8:
+            case RS2_FORMAT_BGR8:
+            case RS2_FORMAT_RGBA8:
+            case RS2_FORMAT_BGRA8:
+                return true;
+            default:
+                return false;
+            }
+        }
+    }
+
+    undistort_filter::undistort_filter()
+        : stream_filter_processing_block("Undistort")
+        , _intrinsics{}
+        , _stride(0)
+        , _format(RS2_FORMAT_ANY)
+        , _threads(threads_def)
+    {
+        register_option(RS2_OPTION_FILTER_THREADS,
+            std::make_shared<ptr_option<uint8_t>>(threads_min,
+                uint8_t(std::min(processing_thread_pool::max_threads(), 255)), threads_step, threads_def, &_threads,
+                "Number of threads to split the rows of each frame across"));
+    }
+
+    void undistort_filter::update_configuration(const rs2::frame& f)
+    {
+        auto vf = f.as<rs2::video_frame>();
+        auto intrinsics = f.get_profile().as<rs2::video_stream_profile>().get_intrinsics();
+        int stride = vf.get_stride_in_bytes() / vf.get_bytes_per_pixel();
+        bool profile_changed = f.get_profile().get() != _source_stream_profile.get();
+
+        if (profile_changed)
+        {
+            _source_stream_profile = f.get_profile();
+            _format = _source_stream_profile.format();
+
+            // The same camera, without the distortion
+            rs2_intrinsics target_intrinsics = intrinsics;
+            target_intrinsics.model = RS2_DISTORTION_NONE;
+            std::fill(std::begin(target_intrinsics.coeffs), std::end(target_intrinsics.coeffs), 0.f);
+            output_profile_cache::key key(_source_stream_profile.get()->profile, _source_stream_profile.stream_type(),
+                _source_stream_profile.stream_index(), _format, "undistort");
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(key,
+                [target_intrinsics](stream_profile_interface& p)
+                {
+                    auto tgt_vspi = dynamic_cast<video_stream_profile_interface*>(&p);
+                    if (!tgt_vspi)
+                        throw std::runtime_error("Profile is not video stream profile");
+                    tgt_vspi->set_intrinsics([target_intrinsics]() { return target_intrinsics; });
+                });
+        }
+
+        if (!_offsets.empty() && stride == _stride && !memcmp(&intrinsics, &_intrinsics, sizeof(intrinsics)))
+            return;
+        _intrinsics = intrinsics;
+        _stride = stride;
+
+        int w = intrinsics.width, h = intrinsics.height;
+        if (intrinsics.model == RS2_DISTORTION_NONE || w < 2 || h < 2 || w != vf.get_width() || h != vf.get_height())
+        {
+            _offsets.clear();
+            _weights.clear();
+            return;
+        }
+
+        _offsets.resize(size_t(w) * h);
+        _weights.resize(_offsets.size());
+        std::vector<float> rays(3 * size_t(w)), pixels(2 * size_t(w));
+        for (int x = 0; x < w; ++x)
+        {
+            rays[3 * x] = (x - intrinsics.ppx) / intrinsics.fx;
+            rays[3 * x + 2] = 1.f;
+        }
+        for (int y = 0; y < h; ++y)
+        {
+            float ray_y = (y - intrinsics.ppy) / intrinsics.fy;
+            for (int x = 0; x < w; ++x)
+                rays[3 * x + 1] = ray_y;
+            project_points_to_pixels(pixels.data(), intrinsics, rays.data(), w);
+
+            auto offsets = &_offsets[size_t(y) * w];
+            auto weights = &_weights[size_t(y) * w];
+            for (int x = 0; x < w; ++x)
+            {
+                float sx = pixels[2 * x], sy = pixels[2 * x + 1];
+                if (!(sx >= 0 && sx <= w - 1 && sy >= 0 && sy <= h - 1))
+                {
+                    offsets[x] = -1;
+                    weights[x] = 0;
+                    continue;
+                }
+                // The last column and row are the right and bottom of the pixels before them
+                int x0 = std::min(int(sx), w - 2), y0 = std::min(int(sy), h - 2);
+                int fx = int((sx - x0) * 128 + 0.5f), fy = int((sy - y0) * 128 + 0.5f);
+                offsets[x] = y0 * stride + x0;
+                weights[x] = uint16_t(fx | (fy << 8));
+            }
+        }
+    }
+
+    void undistort_filter::remap_rows(const void* in, void* out, size_t begin, size_t end) const
+    {
+        int w = _intrinsics.width;
+        for (auto y = begin; y < end; ++y)
+        {
+            auto offsets = &_offsets[y * w];
+            auto weights = &_weights[y * w];
+            switch (_format)
+            {
+            case RS2_FORMAT_Y8:
+                remap_row<uint8_t, 1>(static_cast<const uint8_t*>(in), static_cast<uint8_t*>(out) + y * w,
+                    _stride, offsets, weights, w);
+                break;
+            case RS2_FORMAT_Y16:
+                remap_row<uint16_t, 1>(static_cast<const uint16_t*>(in), static_cast<uint16_t*>(out) + y * w,
+                    _stride, offsets, weights, w);
+                break;
+            case RS2_FORMAT_RGB8:
+            case RS2_FORMAT_BGR8:
+                remap_row<uint8_t, 3>(static_cast<const uint8_t*>(in), static_cast<uint8_t*>(out) + y * w * 3,
+                    _stride, offsets, weights, w);
+                break;
+            default:
+                remap_row<uint8_t, 4>(static_cast<const uint8_t*>(in), static_cast<uint8_t*>(out) + y * w * 4,
+                    _stride, offsets, weights, w);
+                break;
+            }
+        }
+    }
+
+    rs2::frame undistort_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        if (!f.is<rs2::video_frame>() || f.is<rs2::depth_frame>() || !is_remapped(f.get_profile().format()))
+            return f;
+
+        update_configuration(f);
+        if (_offsets.empty())
+            return f;
+
+        auto vf = f.as<rs2::video_frame>();
+        int width = _intrinsics.width, height = _intrinsics.height;
+        int bpp = vf.get_bytes_per_pixel();
+        auto ret = source.allocate_video_frame(_target_stream_profile, f, bpp, width, height, width * bpp,
+            RS2_EXTENSION_VIDEO_FRAME);
+        if (!ret)
+            return f;
+
+        auto in = f.get_data();
+        auto out = const_cast<void*>(ret.get_data());
+        auto rows = [&](size_t begin, size_t end) { remap_rows(in, out, begin, end); };
+        if (_threads <= 1)
+            rows(0, height);
+        else
+        {
+            if (!_thread_pool)
+                _thread_pool = processing_thread_pool::instance();
+            _thread_pool->parallel_for(height, _threads, rows);
+        }
+        return ret;
+    }
+}
@@ -0,0 +1,48 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+// Removes the lens distortion of color and infrared frames: their pixels are remapped to an image with the same focal
+// lengths and principal point, and no distortion model.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+namespace librealsense
+{
+    class processing_thread_pool;
+
+    // Each pixel of the output is where its ray projects to in the frame, with the frame's intrinsics and distortion
+    // model. Those don't change from frame to frame, so they're taken to a table once per intrinsics: the offset of
+    // the 2x2 pixels of the frame around it, and their bilinear weights in fixed point. A frame is then one pass over
+    // the table, its rows split across RS2_OPTION_FILTER_THREADS threads.
+    // Y8, Y16, RGB8, BGR8, RGBA8 and BGRA8 are remapped; other formats, and frames with no distortion, pass through.
+    class undistort_filter : public stream_filter_processing_block
+    {
+    public:
+        undistort_filter();
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        void update_configuration(const rs2::frame& f);
+
+        // Rows [begin, end) of the output
+        void remap_rows(const void* in, void* out, size_t begin, size_t end) const;
+
+        rs2::stream_profile                 _source_stream_profile;
+        rs2::stream_profile                 _target_stream_profile;
+        rs2_intrinsics                      _intrinsics;    // Of the source, that the table is for
+        int                                 _stride;        // Of the source, in pixels
+        rs2_format                          _format;
+
+        // For each pixel of the output: the offset, in pixels, of the top-left of the 2x2 pixels of the frame it's
+        // between (-1 when it's outside the frame), and their weights in 1/128ths across (low byte) and down
+        std::vector<int32_t>                _offsets;
+        std::vector<uint16_t>               _weights;
+
+        uint8_t                             _threads;
+        std::shared_ptr<processing_thread_pool> _thread_pool;
+    };
+    MAP_EXTENSION(RS2_EXTENSION_UNDISTORT_FILTER, librealsense::undistort_filter);
+}
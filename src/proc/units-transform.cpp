@@ -8,6 +8,7 @@
 #include "core/sensor-interface.h"
 #include "proc/synthetic-stream.h"
 #include "environment.h"
+#include "proc/output-profile-cache.h"
 #include "units-transform.h"
 
 namespace librealsense
@@ -23,7 +24,7 @@ namespace librealsense
         if (f.get_profile().get() != _source_stream_profile.get())
         {
             _source_stream_profile = f.get_profile();
-            _target_stream_profile = f.get_profile().clone(RS2_STREAM_DEPTH, 0, RS2_FORMAT_DISTANCE);
+            _target_stream_profile = environment::get_instance().get_output_profile_cache().get_profile(f.get_profile(), RS2_STREAM_DEPTH, 0, RS2_FORMAT_DISTANCE);
 
             if (!_depth_units)
             {
@@ -0,0 +1,146 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "voxel-grid.h"
+#include "proc/processing-thread-pool.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace librealsense
+{
+    static const uint64_t no_voxel = ~uint64_t(0);
+    static const size_t min_slots = 4096;
+
+    // 21 bits a coordinate, centered on the camera: +-10 km with voxels of 1 cm
+    static uint64_t voxel_key(const float3& p, float scale)
+    {
+        auto coord = [scale](float v)
+        {
+            int64_t c = int64_t(std::floor(v * scale)) + (int64_t(1) << 20);
+            return uint64_t(std::max(int64_t(0), std::min(c, (int64_t(1) << 21) - 1)));
+        };
+        return coord(p.x) | (coord(p.y) << 21) | (coord(p.z) << 42);
+    }
+
+    // The finalizer of MurmurHash3: neighboring voxels land far apart
+    static uint64_t mix(uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return key;
+    }
+
+    size_t voxel_grid::find_slot(const std::vector<voxel>& slots, uint64_t key, uint64_t hash)
+    {
+        const size_t mask = slots.size() - 1;
+        size_t slot = size_t(hash) & mask;
+        while (slots[slot].key != no_voxel && slots[slot].key != key)
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void voxel_grid::reduce_partition(float3* vertices, float2* texcoords, size_t count, size_t partition, size_t partitions)
+    {
+        auto& t = _tables[partition];
+
+        // Only the slots the last frame used need clearing
+        if (t.slots.size() < min_slots)
+            t.slots.assign(min_slots, voxel{ no_voxel });
+        for (auto s : t.used)
+            t.slots[s].key = no_voxel;
+        t.used.clear();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint64_t key = _keys[i];
+            if (key == no_voxel)
+                continue;
+            const uint64_t hash = mix(key);
+            if ((hash >> 40) % partitions != partition)
+                continue;
+
+            size_t slot = find_slot(t.slots, key, hash);
+            auto& v = t.slots[slot];
+            if (v.key == key)
+            {
+                v.sum[0] += vertices[i].x;
+                v.sum[1] += vertices[i].y;
+                v.sum[2] += vertices[i].z;
+                v.sum[3] += texcoords[i].x;
+                v.sum[4] += texcoords[i].y;
+                ++v.count;
+                vertices[i] = {};
+                texcoords[i] = {};
+                continue;
+            }
+
+            // At half full, the table grows, and keeps its size for the frames after
+            if (2 * (t.used.size() + 1) > t.slots.size())
+            {
+                std::vector<voxel> slots(2 * t.slots.size(), voxel{ no_voxel });
+                for (auto& s : t.used)
+                {
+                    auto const& old = t.slots[s];
+                    size_t moved = find_slot(slots, old.key, mix(old.key));
+                    slots[moved] = old;
+                    s = uint32_t(moved);
+                }
+                t.slots.swap(slots);
+                slot = find_slot(t.slots, key, hash);
+            }
+            t.slots[slot] = { key,
+                              { vertices[i].x, vertices[i].y, vertices[i].z, texcoords[i].x, texcoords[i].y },
+                              1,
+                              uint32_t(i) };
+            t.used.push_back(uint32_t(slot));
+        }
+
+        for (auto s : t.used)
+        {
+            auto const& v = t.slots[s];
+            if (v.count == 1)
+                continue;
+            const float n = float(v.count);
+            vertices[v.first] = { v.sum[0] / n, v.sum[1] / n, v.sum[2] / n };
+            texcoords[v.first] = { v.sum[3] / n, v.sum[4] / n };
+        }
+    }
+
+    size_t voxel_grid::reduce(float3* vertices, float2* texcoords, size_t count, float size, int threads)
+    {
+        const float scale = 1.f / size;
+        _keys.resize(count);
+        auto keys = [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                _keys[i] = vertices[i].z ? voxel_key(vertices[i], scale) : no_voxel;
+        };
+
+        const size_t partitions = size_t(std::max(1, threads));
+        if (_tables.size() < partitions)
+            _tables.resize(partitions);
+        if (partitions == 1)
+        {
+            keys(0, count);
+            reduce_partition(vertices, texcoords, count, 0, 1);
+        }
+        else
+        {
+            if (!_thread_pool)
+                _thread_pool = processing_thread_pool::instance();
+            _thread_pool->parallel_for(count, int(partitions), keys);
+            _thread_pool->parallel_for(partitions, int(partitions), [&](size_t begin, size_t end)
+            {
+                for (size_t p = begin; p < end; ++p)
+                    reduce_partition(vertices, texcoords, count, p, partitions);
+            });
+        }
+
+        size_t left = 0;
+        for (size_t p = 0; p < partitions; ++p)
+            left += _tables[p].used.size();
+        return left;
+    }
+}
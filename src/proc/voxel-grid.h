@@ -0,0 +1,50 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <src/float3.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace librealsense
+{
+    class processing_thread_pool;
+
+    // Downsamples points to one per voxel (cube of a side of 'size' meters): the centroid of the points in it, and the
+    // mean of their texture coordinates, take the place of the first of them and the others are zeroed, as points
+    // without depth are -- the packed layouts then leave them out.
+    // The voxels are in hash tables that stay allocated from frame to frame. With several threads, the voxel of each
+    // point is found over ranges of the points, and the voxels are then split across the threads by their hash, each
+    // thread with its own table, so none waits for another.
+    class voxel_grid
+    {
+    public:
+        // Returns the number of points left
+        size_t reduce(float3* vertices, float2* texcoords, size_t count, float size, int threads);
+
+    private:
+        struct voxel
+        {
+            uint64_t key;
+            float sum[5];       // x, y, z, u, v
+            uint32_t count;
+            uint32_t first;     // The point it's written to
+        };
+
+        struct table
+        {
+            std::vector<voxel> slots;   // Open addressing; a power of 2 of them
+            std::vector<uint32_t> used; // The slots of the voxels, in the order they were found
+        };
+
+        static size_t find_slot(const std::vector<voxel>& slots, uint64_t key, uint64_t hash);
+        void reduce_partition(float3* vertices, float2* texcoords, size_t count, size_t partition, size_t partitions);
+
+        std::vector<uint64_t> _keys;    // Of every point
+        std::vector<table> _tables;     // One per thread
+        std::shared_ptr<processing_thread_pool> _thread_pool;
+    };
+}
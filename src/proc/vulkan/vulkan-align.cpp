@@ -0,0 +1,121 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_VULKAN
+#include "proc/vulkan/vulkan-align.h"
+
+#include <cstring>
+
+namespace librealsense
+{
+    static const uint32_t align_z_to_other_spirv[] =
+#include "align-z-to-other.comp.inc"
+    ;
+    static const uint32_t align_z_finish_spirv[] =
+#include "align-z-finish.comp.inc"
+    ;
+    static const uint32_t align_other_map_spirv[] =
+#include "align-other-map.comp.inc"
+    ;
+    static const uint32_t align_other_gather_spirv[] =
+#include "align-other-gather.comp.inc"
+    ;
+
+    // Like align.glsl's, in std430
+    struct align_params
+    {
+        rs2_intrinsics depth_intrin;
+        rs2_extrinsics depth_to_other;
+        rs2_intrinsics other_intrin;
+        float depth_scale;
+    };
+    static_assert(sizeof(rs2_intrinsics) == 48 && sizeof(rs2_extrinsics) == 48,
+        "the shaders expect rs2_intrinsics and rs2_extrinsics as 48 bytes each");
+
+    struct gather_params
+    {
+        uint32_t count;
+        uint32_t bpp;
+    };
+
+    align_vulkan::align_vulkan(rs2_stream align_to)
+        : align(align_to, "Align (Vulkan)")
+        , _device(vulkan::device::get())
+    {
+        if (!_device)
+            throw std::runtime_error("no Vulkan device");
+        _z_to_other = std::make_shared<vulkan::kernel>(_device, align_z_to_other_spirv, sizeof(align_z_to_other_spirv), 3, 16, 16);
+        _z_finish = std::make_shared<vulkan::kernel>(_device, align_z_finish_spirv, sizeof(align_z_finish_spirv), 3, 256);
+        _other_map = std::make_shared<vulkan::kernel>(_device, align_other_map_spirv, sizeof(align_other_map_spirv), 3, 16, 16);
+        _other_gather = std::make_shared<vulkan::kernel>(_device, align_other_gather_spirv, sizeof(align_other_gather_spirv), 4, 256);
+    }
+
+    void align_vulkan::align_z_to_other(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale)
+    {
+        // Into the grid of the aligned frame, which may be smaller than the other's
+        auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
+        align_params params{ {}, depth_profile.get_extrinsics_to(other_profile), aligned.get_profile().as<rs2::video_stream_profile>().get_intrinsics(), z_scale };
+        auto z_pixels = scaled_depth(depth, params.depth_intrin);
+        auto z_count = size_t(params.depth_intrin.width) * params.depth_intrin.height;
+        auto other_count = size_t(params.other_intrin.width) * params.other_intrin.height;
+
+        auto& p = vulkan::buffer::reserve(_params, _device, sizeof(params));
+        std::memcpy(p.data(), &params, sizeof(params));
+        uint32_t count = uint32_t(other_count);
+        auto& c = vulkan::buffer::reserve(_count_params, _device, sizeof(gather_params));
+        std::memcpy(c.data(), &count, sizeof(count));
+        auto& z = vulkan::buffer::reserve(_depth, _device, z_count * sizeof(uint16_t));
+        std::memcpy(z.data(), z_pixels, z_count * sizeof(uint16_t));
+        auto& nearest = vulkan::buffer::reserve(_nearest, _device, other_count * sizeof(uint32_t));
+        auto& out = vulkan::buffer::reserve(_aligned, _device, other_count * sizeof(uint16_t));
+
+        // The nearest depth of each other pixel, then as Z16, where 0 is none
+        _device->run([&](VkCommandBuffer commands) {
+            vulkan::fill(commands, nearest, 0xFFFFFFFF);
+            _z_to_other->dispatch(commands, { &p, &z, &nearest }, params.depth_intrin.width, params.depth_intrin.height);
+            vulkan::barrier(commands);
+            _z_finish->dispatch(commands, { &c, &nearest, &out }, uint32_t((other_count + 1) / 2));
+        });
+
+        std::memcpy(const_cast<void*>(aligned.get_data()), out.data(), other_count * sizeof(uint16_t));
+    }
+
+    void align_vulkan::align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale)
+    {
+        // Same formats as the CPU: YUYV and such can't be aligned pixel by pixel; leave the rest to it
+        uint32_t bpp = other.get_bytes_per_pixel();
+        if (bpp < 1 || bpp > 4)
+            return align::align_other_to_z(aligned, depth, other, z_scale);
+
+        auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
+        auto other_profile = other.get_profile().as<rs2::video_stream_profile>();
+        align_params params{ {}, depth_profile.get_extrinsics_to(other_profile), other_profile.get_intrinsics(), z_scale };
+        auto z_pixels = scaled_depth(depth, params.depth_intrin);
+        auto z_count = size_t(params.depth_intrin.width) * params.depth_intrin.height;
+        auto other_size = size_t(other.get_stride_in_bytes()) * other.get_height();
+        auto aligned_size = z_count * bpp;
+
+        auto& p = vulkan::buffer::reserve(_params, _device, sizeof(params));
+        std::memcpy(p.data(), &params, sizeof(params));
+        gather_params gather{ uint32_t(z_count), bpp };
+        auto& g = vulkan::buffer::reserve(_count_params, _device, sizeof(gather));
+        std::memcpy(g.data(), &gather, sizeof(gather));
+        auto& z = vulkan::buffer::reserve(_depth, _device, z_count * sizeof(uint16_t));
+        std::memcpy(z.data(), z_pixels, z_count * sizeof(uint16_t));
+        auto& source = vulkan::buffer::reserve(_nearest, _device, z_count * sizeof(int32_t));
+        auto& in = vulkan::buffer::reserve(_other, _device, other_size);
+        std::memcpy(in.data(), other.get_data(), other_size);
+        auto& out = vulkan::buffer::reserve(_aligned, _device, aligned_size);
+
+        // The other pixel each depth pixel takes, if any, then the pixels themselves
+        _device->run([&](VkCommandBuffer commands) {
+            _other_map->dispatch(commands, { &p, &z, &source }, params.depth_intrin.width, params.depth_intrin.height);
+            vulkan::barrier(commands);
+            _other_gather->dispatch(commands, { &g, &source, &in, &out }, uint32_t((aligned_size + 3) / 4));
+        });
+
+        std::memcpy(const_cast<void*>(aligned.get_data()), out.data(), aligned_size);
+    }
+}
+
+#endif // RS2_USE_VULKAN
@@ -0,0 +1,30 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#ifdef RS2_USE_VULKAN
+
+#include "proc/align.h"
+#include "vulkan/vulkan-device.h"
+#include <memory>
+
+namespace librealsense
+{
+    // Aligns on the Vulkan device; aligned frames are read back right away, for any block to use
+    class align_vulkan : public align
+    {
+    public:
+        align_vulkan(rs2_stream align_to);
+
+    protected:
+        void align_z_to_other(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale) override;
+        void align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale) override;
+
+    private:
+        std::shared_ptr<vulkan::device> _device;
+        std::shared_ptr<vulkan::kernel> _z_to_other, _z_finish, _other_map, _other_gather;
+        std::shared_ptr<vulkan::buffer> _params, _count_params, _depth, _nearest, _other, _aligned;
+    };
+}
+
+#endif // RS2_USE_VULKAN
@@ -0,0 +1,56 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_VULKAN
+#include "proc/vulkan/vulkan-pointcloud.h"
+
+#include <cstring>
+
+namespace librealsense
+{
+    static const uint32_t deproject_spirv[] =
+#include "deproject.comp.inc"
+    ;
+
+    // Like the shader's, in std430
+    struct deproject_params
+    {
+        rs2_intrinsics depth_intrin;
+        float depth_scale;
+    };
+    static_assert(sizeof(rs2_intrinsics) == 48, "the shaders expect rs2_intrinsics as 48 bytes");
+
+    pointcloud_vulkan::pointcloud_vulkan()
+        : pointcloud("Pointcloud (Vulkan)")
+        , _device(vulkan::device::get())
+    {
+        if (!_device)
+            throw std::runtime_error("no Vulkan device");
+        _deproject = std::make_shared<vulkan::kernel>(_device, deproject_spirv, sizeof(deproject_spirv), 3, 16, 16);
+    }
+
+    const float3 * pointcloud_vulkan::depth_to_points(
+        rs2::points output,
+        const rs2_intrinsics &depth_intrinsics,
+        const rs2::depth_frame& depth_frame)
+    {
+        auto count = size_t(depth_intrinsics.width) * depth_intrinsics.height;
+
+        deproject_params params{ depth_intrinsics, depth_frame.get_units() };
+        auto& p = vulkan::buffer::reserve(_params, _device, sizeof(params));
+        std::memcpy(p.data(), &params, sizeof(params));
+        auto& depth = vulkan::buffer::reserve(_depth, _device, count * sizeof(uint16_t));
+        std::memcpy(depth.data(), depth_frame.get_data(), count * sizeof(uint16_t));
+        auto& points = vulkan::buffer::reserve(_points, _device, count * sizeof(float3));
+
+        _device->run([&](VkCommandBuffer commands) {
+            _deproject->dispatch(commands, { &p, &depth, &points }, depth_intrinsics.width, depth_intrinsics.height);
+        });
+
+        auto image = (float3*)output.get_vertices();
+        std::memcpy(image, points.data(), count * sizeof(float3));
+        return image;
+    }
+}
+
+#endif // RS2_USE_VULKAN
@@ -0,0 +1,29 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#ifdef RS2_USE_VULKAN
+
+#include "../pointcloud.h"
+#include "../../vulkan/vulkan-device.h"
+
+namespace librealsense
+{
+    // Deprojects on the Vulkan device; the points are read back into the frame right away, for any block to use
+    class pointcloud_vulkan : public pointcloud
+    {
+    public:
+        pointcloud_vulkan();
+    private:
+        const float3 * depth_to_points(
+            rs2::points output,
+            const rs2_intrinsics &depth_intrinsics,
+            const rs2::depth_frame& depth_frame) override;
+
+        std::shared_ptr<vulkan::device> _device;
+        std::shared_ptr<vulkan::kernel> _deproject;
+        std::shared_ptr<vulkan::buffer> _params, _depth, _points;
+    };
+}
+
+#endif // RS2_USE_VULKAN
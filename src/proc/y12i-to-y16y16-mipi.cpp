@@ -3,9 +3,20 @@
 
 #include "y12i-to-y16y16-mipi.h"
 #include "stream.h"
+#include "image-avx.h"
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
 #endif
+#if defined __SSSE3__ && ! defined ANDROID
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined __SSSE3__ && ! defined ANDROID && defined RS2_USE_AVX
+// Defined in color-formats-converter.cpp
+bool has_avx2();
+#endif
 
 namespace librealsense
 {
@@ -18,7 +29,45 @@ namespace librealsense
 #ifdef RS2_USE_CUDA
         rscuda::split_frame_y16_y16_from_y12i_cuda(dest, count, reinterpret_cast<const y12i_pixel_mipi *>(source));
 #else
-        split_frame(dest, count, reinterpret_cast<const y12i_pixel_mipi*>(source),
+        // Whole vectors of pixels first (AVX2 when the CPU has it, then SSSE3 or NEON), the rest pixel by pixel
+        auto left = reinterpret_cast<uint16_t *>(dest[0]);
+        auto right = reinterpret_cast<uint16_t *>(dest[1]);
+        int i = 0;
+#if defined __SSSE3__ && ! defined ANDROID
+#ifdef RS2_USE_AVX
+        static bool do_avx2 = has_avx2();
+        if (do_avx2)
+            i = split_y12i_mipi_avx(left, right, source, count);
+#endif
+        // 4 pixels per 16 bytes, to their right then their left pixels
+        const __m128i split = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 1, 2, 5, 6, 9, 10, 13, 14);
+        const __m128i low_12 = _mm_set1_epi16(0x0fff);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i * 4)), split);
+            __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i * 4 + 16)), split);
+            __m128i r = _mm_and_si128(_mm_unpacklo_epi64(a, b), low_12);
+            __m128i l = _mm_srli_epi16(_mm_unpackhi_epi64(a, b), 4);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(left + i), _mm_or_si128(_mm_slli_epi16(l, 6), _mm_srli_epi16(l, 4)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(right + i), _mm_or_si128(_mm_slli_epi16(r, 6), _mm_srli_epi16(r, 4)));
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x4_t p = vld4q_u8(source + i * 4);
+            uint8x16_t rh = vandq_u8(p.val[1], vdupq_n_u8(0x0f)), ll = vshrq_n_u8(p.val[1], 4);
+            uint16x8_t r0 = vorrq_u16(vmovl_u8(vget_low_u8(p.val[0])), vshll_n_u8(vget_low_u8(rh), 8));
+            uint16x8_t r1 = vorrq_u16(vmovl_u8(vget_high_u8(p.val[0])), vshll_n_u8(vget_high_u8(rh), 8));
+            uint16x8_t l0 = vorrq_u16(vshll_n_u8(vget_low_u8(p.val[2]), 4), vmovl_u8(vget_low_u8(ll)));
+            uint16x8_t l1 = vorrq_u16(vshll_n_u8(vget_high_u8(p.val[2]), 4), vmovl_u8(vget_high_u8(ll)));
+            vst1q_u16(left + i, vorrq_u16(vshlq_n_u16(l0, 6), vshrq_n_u16(l0, 4)));
+            vst1q_u16(left + i + 8, vorrq_u16(vshlq_n_u16(l1, 6), vshrq_n_u16(l1, 4)));
+            vst1q_u16(right + i, vorrq_u16(vshlq_n_u16(r0, 6), vshrq_n_u16(r0, 4)));
+            vst1q_u16(right + i + 8, vorrq_u16(vshlq_n_u16(r1, 6), vshrq_n_u16(r1, 4)));
+        }
+#endif
+        uint8_t * const rest[] = { reinterpret_cast<uint8_t *>(left + i), reinterpret_cast<uint8_t *>(right + i) };
+        split_frame(rest, count - i, reinterpret_cast<const y12i_pixel_mipi*>(source) + i,
             [](const y12i_pixel_mipi& p) -> uint16_t { return p.l() << 6 | p.l() >> 4; },  // We want to convert 10-bit data to 16-bit data
             [](const y12i_pixel_mipi& p) -> uint16_t { return p.r() << 6 | p.r() >> 4; }); // Multiply by 64 1/16 to efficiently approximate 65535/1023
 #endif
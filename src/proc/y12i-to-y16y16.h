@@ -17,5 +17,11 @@ namespace librealsense
     protected:
         y12i_to_y16y16(const char* name, int left_idx, int right_idx);
         void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+        bool get_row_group( int width, int & rows, size_t & source_bytes ) const override
+        {
+            rows = 1;
+            source_bytes = size_t( width ) * 3;
+            return true;
+        }
     };
 }
@@ -3,6 +3,17 @@
 
 #include "y16i-to-y10msby10msb.h"
 #include "stream.h"
+#include "image-avx.h"
+#if defined __SSSE3__ && ! defined ANDROID
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined __SSSE3__ && ! defined ANDROID && defined RS2_USE_AVX
+// Defined in color-formats-converter.cpp
+bool has_avx2();
+#endif
 // CUDA TODO
 //#ifdef RS2_USE_CUDA
 //#include "cuda/cuda-conversion.cuh"
@@ -27,7 +38,36 @@ namespace librealsense
 //#ifdef RS2_USE_CUDA
 //        rscuda::split_frame_y10msb_y10msb_from_y16i_cuda(dest, count, reinterpret_cast<const y12i_pixel*>(source));
 //#else
-        split_frame(dest, count, reinterpret_cast<const y16i_pixel*>(source),
+        // Whole vectors of pixels first (AVX2 when the CPU has it, then SSSE3 or NEON), the rest pixel by pixel
+        auto left = reinterpret_cast<uint16_t *>(dest[0]);
+        auto right = reinterpret_cast<uint16_t *>(dest[1]);
+        int i = 0;
+#if defined __SSSE3__ && ! defined ANDROID
+#ifdef RS2_USE_AVX
+        static bool do_avx2 = has_avx2();
+        if (do_avx2)
+            i = split_y16i_avx(left, right, source, count);
+#endif
+        // 4 left then 4 right pixels out of each 16 bytes
+        const __m128i split = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i * 4)), split);
+            __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i * 4 + 16)), split);
+            __m128i l = _mm_unpacklo_epi64(a, b), r = _mm_unpackhi_epi64(a, b);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(left + i), _mm_or_si128(_mm_slli_epi16(l, 6), _mm_srli_epi16(l, 4)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(right + i), _mm_or_si128(_mm_slli_epi16(r, 6), _mm_srli_epi16(r, 4)));
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        for (; i + 8 <= count; i += 8)
+        {
+            uint16x8x2_t lr = vld2q_u16(reinterpret_cast<const uint16_t *>(source + i * 4));
+            vst1q_u16(left + i, vorrq_u16(vshlq_n_u16(lr.val[0], 6), vshrq_n_u16(lr.val[0], 4)));
+            vst1q_u16(right + i, vorrq_u16(vshlq_n_u16(lr.val[1], 6), vshrq_n_u16(lr.val[1], 4)));
+        }
+#endif
+        uint8_t * const rest[] = { reinterpret_cast<uint8_t *>(left + i), reinterpret_cast<uint8_t *>(right + i) };
+        split_frame(rest, count - i, reinterpret_cast<const y16i_pixel*>(source) + i,
             [](const y16i_pixel& p) -> uint16_t { return (p.l()); },
             [](const y16i_pixel& p) -> uint16_t { return (p.r()); });
 //#endif
@@ -20,6 +20,13 @@ namespace librealsense
             int height,
             int actual_size,
             int input_size) override;
+        // [u y0 y1 v y2 y3] for every 2x2 pixels
+        bool get_row_group( int width, int & rows, size_t & source_bytes ) const override
+        {
+            rows = 2;
+            source_bytes = size_t( width ) * 3;
+            return true;
+        }
     };
 
     void unpack_y411( uint8_t * const dest[], const uint8_t * const s, int w, int h, int actual_size);
@@ -5,9 +5,20 @@
 
 #include "stream.h"
 
+#include "image-avx.h"
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
 #endif
+#if defined __SSSE3__ && ! defined ANDROID
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined __SSSE3__ && ! defined ANDROID && defined RS2_USE_AVX
+// Defined in color-formats-converter.cpp
+bool has_avx2();
+#endif
 
 namespace librealsense
 {
@@ -18,7 +29,33 @@ namespace librealsense
 #ifdef RS2_USE_CUDA
         rscuda::split_frame_y8_y8_from_y8i_cuda(dest, count, reinterpret_cast<const y8i_pixel *>(source));
 #else
-        split_frame(dest, count, reinterpret_cast<const y8i_pixel*>(source),
+        // Whole vectors of pixels first (AVX2 when the CPU has it, then SSSE3 or NEON), the rest pixel by pixel
+        int i = 0;
+#if defined __SSSE3__ && ! defined ANDROID
+#ifdef RS2_USE_AVX
+        static bool do_avx2 = has_avx2();
+        if (do_avx2)
+            i = split_y8i_avx(dest[0], dest[1], source, count);
+#endif
+        // 8 left then 8 right pixels out of each 16 bytes
+        const __m128i split = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i * 2)), split);
+            __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i * 2 + 16)), split);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest[0] + i), _mm_unpacklo_epi64(a, b));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest[1] + i), _mm_unpackhi_epi64(a, b));
+        }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x2_t lr = vld2q_u8(source + i * 2);
+            vst1q_u8(dest[0] + i, lr.val[0]);
+            vst1q_u8(dest[1] + i, lr.val[1]);
+        }
+#endif
+        uint8_t * const rest[] = { dest[0] + i, dest[1] + i };
+        split_frame(rest, count - i, reinterpret_cast<const y8i_pixel*>(source) + i,
             [](const y8i_pixel & p) -> uint8_t { return p.l; },
             [](const y8i_pixel & p) -> uint8_t { return p.r; });
 #endif
@@ -15,5 +15,11 @@ namespace librealsense
     protected:
         y8i_to_y8y8(const char* name, int left_idx, int right_idx);
         void process_function( uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) override;
+        bool get_row_group( int width, int & rows, size_t & source_bytes ) const override
+        {
+            rows = 1;
+            source_bytes = size_t( width ) * 2;
+            return true;
+        }
     };
 }
@@ -0,0 +1,371 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "projection.h"
+
+#include <librealsense2/rsutil.h>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace librealsense {
+
+
+namespace {
+
+
+#if defined(__SSSE3__) || ( defined(__aarch64__) && defined(__ARM_NEON) )
+#define RS2_PROJECTION_LANES
+
+// 4 floats, so that the formulas of rs.cpp read the same for 4 points at a time
+struct lanes
+{
+#if defined(__SSSE3__)
+    __m128 v;
+    lanes( __m128 v ) : v( v ) {}
+    lanes( float f ) : v( _mm_set1_ps( f ) ) {}
+    static lanes load( const float * p ) { return _mm_loadu_ps( p ); }
+    void store( float * p ) const { _mm_storeu_ps( p, v ); }
+#else
+    float32x4_t v;
+    lanes( float32x4_t v ) : v( v ) {}
+    lanes( float f ) : v( vdupq_n_f32( f ) ) {}
+    static lanes load( const float * p ) { return vld1q_f32( p ); }
+    void store( float * p ) const { vst1q_f32( p, v ); }
+#endif
+};
+
+#if defined(__SSSE3__)
+inline lanes operator+( lanes a, lanes b ) { return _mm_add_ps( a.v, b.v ); }
+inline lanes operator-( lanes a, lanes b ) { return _mm_sub_ps( a.v, b.v ); }
+inline lanes operator*( lanes a, lanes b ) { return _mm_mul_ps( a.v, b.v ); }
+inline lanes operator/( lanes a, lanes b ) { return _mm_div_ps( a.v, b.v ); }
+#else
+inline lanes operator+( lanes a, lanes b ) { return vaddq_f32( a.v, b.v ); }
+inline lanes operator-( lanes a, lanes b ) { return vsubq_f32( a.v, b.v ); }
+inline lanes operator*( lanes a, lanes b ) { return vmulq_f32( a.v, b.v ); }
+inline lanes operator/( lanes a, lanes b ) { return vdivq_f32( a.v, b.v ); }
+#endif
+
+
+// Points (or pixels) come interleaved; the lanes are of one coordinate of 4 of them
+template< int N >
+void load( lanes * to, const float * from )
+{
+    alignas( 16 ) float v[N][4];
+    for( int k = 0; k < 4; ++k )
+        for( int c = 0; c < N; ++c )
+            v[c][k] = from[N * k + c];
+    for( int c = 0; c < N; ++c )
+        to[c] = lanes::load( v[c] );
+}
+
+template< int N >
+void store( float * to, const lanes * from )
+{
+    alignas( 16 ) float v[N][4];
+    for( int c = 0; c < N; ++c )
+        from[c].store( v[c] );
+    for( int k = 0; k < 4; ++k )
+        for( int c = 0; c < N; ++c )
+            to[N * k + c] = v[c][k];
+}
+
+
+void project_4( float * pixels, const rs2_intrinsics & intrin, const float * points )
+{
+    lanes point[3] = { 0.f, 0.f, 0.f };
+    load< 3 >( point, points );
+    lanes x = point[0] / point[2], y = point[1] / point[2];
+    const float * c = intrin.coeffs;
+
+    if( intrin.model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY || intrin.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY )
+    {
+        lanes r2 = x * x + y * y;
+        lanes f = 1.f + c[0] * r2 + c[1] * r2 * r2 + c[4] * r2 * r2 * r2;
+        x = x * f;
+        y = y * f;
+        lanes dx = x + 2 * c[2] * x * y + c[3] * ( r2 + 2.f * x * x );
+        lanes dy = y + 2 * c[3] * x * y + c[2] * ( r2 + 2.f * y * y );
+        x = dx;
+        y = dy;
+    }
+    else if( intrin.model == RS2_DISTORTION_BROWN_CONRADY )
+    {
+        lanes r2 = x * x + y * y;
+        lanes f = 1.f + c[0] * r2 + c[1] * r2 * r2 + c[4] * r2 * r2 * r2;
+        lanes dx = x * f + 2 * c[2] * x * y + c[3] * ( r2 + 2.f * x * x );
+        lanes dy = y * f + 2 * c[3] * x * y + c[2] * ( r2 + 2.f * y * y );
+        x = dx;
+        y = dy;
+    }
+
+    lanes pixel[2] = { x * intrin.fx + intrin.ppx, y * intrin.fy + intrin.ppy };
+    store< 2 >( pixels, pixel );
+}
+
+
+void deproject_4( float * points, const rs2_intrinsics & intrin, const float * pixels, const float * depths )
+{
+    lanes pixel[2] = { 0.f, 0.f };
+    load< 2 >( pixel, pixels );
+    lanes x = ( pixel[0] - intrin.ppx ) / intrin.fx;
+    lanes y = ( pixel[1] - intrin.ppy ) / intrin.fy;
+    lanes xo = x, yo = y;
+    const float * c = intrin.coeffs;
+
+    if( intrin.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY )
+    {
+        for( int i = 0; i < 10; i++ )
+        {
+            lanes r2 = x * x + y * y;
+            lanes icdist = 1.f / ( 1.f + ( ( c[4] * r2 + c[1] ) * r2 + c[0] ) * r2 );
+            lanes xq = x / icdist;
+            lanes yq = y / icdist;
+            lanes delta_x = 2 * c[2] * xq * yq + c[3] * ( r2 + 2.f * xq * xq );
+            lanes delta_y = 2 * c[3] * xq * yq + c[2] * ( r2 + 2.f * yq * yq );
+            x = ( xo - delta_x ) * icdist;
+            y = ( yo - delta_y ) * icdist;
+        }
+    }
+    else if( intrin.model == RS2_DISTORTION_BROWN_CONRADY )
+    {
+        for( int i = 0; i < 10; i++ )
+        {
+            lanes r2 = x * x + y * y;
+            lanes icdist = 1.f / ( 1.f + ( ( c[4] * r2 + c[1] ) * r2 + c[0] ) * r2 );
+            lanes delta_x = 2 * c[2] * x * y + c[3] * ( r2 + 2.f * x * x );
+            lanes delta_y = 2 * c[3] * x * y + c[2] * ( r2 + 2.f * y * y );
+            x = ( xo - delta_x ) * icdist;
+            y = ( yo - delta_y ) * icdist;
+        }
+    }
+
+    if( depths )
+    {
+        lanes depth = lanes::load( depths );
+        lanes point[3] = { depth * x, depth * y, depth };
+        store< 3 >( points, point );
+    }
+    else
+    {
+        lanes point[3] = { x, y, 1.f };
+        store< 3 >( points, point );
+    }
+}
+
+#endif  // lanes
+
+
+bool is_polynomial( rs2_distortion model )
+{
+    return model == RS2_DISTORTION_NONE || model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY
+        || model == RS2_DISTORTION_INVERSE_BROWN_CONRADY || model == RS2_DISTORTION_BROWN_CONRADY;
+}
+
+
+}  // namespace
+
+
+void project_points_to_pixels( float * pixels, const rs2_intrinsics & intrin, const float * points, size_t count )
+{
+    size_t i = 0;
+#ifdef RS2_PROJECTION_LANES
+    if( is_polynomial( intrin.model ) )
+        for( ; i + 4 <= count; i += 4 )
+            project_4( pixels + 2 * i, intrin, points + 3 * i );
+#endif
+    for( ; i < count; ++i )
+        rs2_project_point_to_pixel( pixels + 2 * i, &intrin, points + 3 * i );
+}
+
+
+void deproject_pixels_to_points( float * points, const rs2_intrinsics & intrin, const float * pixels,
+                                 const float * depths, size_t count )
+{
+    size_t i = 0;
+#ifdef RS2_PROJECTION_LANES
+    // A forward-distorted image can't be deprojected; rs2_deproject_pixel_to_point asserts it
+    if( is_polynomial( intrin.model ) && intrin.model != RS2_DISTORTION_MODIFIED_BROWN_CONRADY )
+        for( ; i + 4 <= count; i += 4 )
+            deproject_4( points + 3 * i, intrin, pixels + 2 * i, depths ? depths + i : nullptr );
+#endif
+    for( ; i < count; ++i )
+        rs2_deproject_pixel_to_point( points + 3 * i, &intrin, pixels + 2 * i, depths ? depths[i] : 1.f );
+}
+
+
+void next_pixel_in_line( float curr[2], const float start[2], const float end[2] )
+{
+    float line_slope = ( end[1] - start[1] ) / ( end[0] - start[0] );
+    if( fabs( end[0] - curr[0] ) > fabs( end[1] - curr[1] ) )
+    {
+        curr[0] = end[0] > curr[0] ? curr[0] + 1 : curr[0] - 1;
+        curr[1] = end[1] - line_slope * ( end[0] - curr[0] );
+    }
+    else
+    {
+        curr[1] = end[1] > curr[1] ? curr[1] + 1 : curr[1] - 1;
+        curr[0] = end[0] - ( ( end[1] - curr[1] ) / line_slope );
+    }
+}
+
+
+bool is_pixel_in_line( const float curr[2], const float start[2], const float end[2] )
+{
+    return ( ( end[0] >= start[0] && end[0] >= curr[0] && curr[0] >= start[0] )
+             || ( end[0] <= start[0] && end[0] <= curr[0] && curr[0] <= start[0] ) )
+        && ( ( end[1] >= start[1] && end[1] >= curr[1] && curr[1] >= start[1] )
+             || ( end[1] <= start[1] && end[1] <= curr[1] && curr[1] <= start[1] ) );
+}
+
+
+void adjust_2D_point_to_boundary( float p[2], int width, int height )
+{
+    if( p[0] < 0 ) p[0] = 0;
+    if( p[0] > width ) p[0] = (float)width;
+    if( p[1] < 0 ) p[1] = 0;
+    if( p[1] > height ) p[1] = (float)height;
+}
+
+
+void color_to_depth_map::update( const rs2_intrinsics & depth_intrin, const rs2_extrinsics & depth_to_color )
+{
+    if( ! _rays.empty() && ! memcmp( &_depth_intrin, &depth_intrin, sizeof( depth_intrin ) )
+        && ! memcmp( &_depth_to_color, &depth_to_color, sizeof( depth_to_color ) ) )
+        return;
+    _depth_intrin = depth_intrin;
+    _depth_to_color = depth_to_color;
+
+    // Interpolating takes a pixel on either side
+    int w = depth_intrin.width, h = depth_intrin.height;
+    if( w < 2 || h < 2 )
+    {
+        _rays.clear();
+        return;
+    }
+
+    _rays.resize( 3 * size_t( w ) * h );
+    std::vector< float > row( 2 * w );
+    for( int x = 0; x < w; ++x )
+        row[2 * x] = float( x );
+    for( int y = 0; y < h; ++y )
+    {
+        for( int x = 0; x < w; ++x )
+            row[2 * x + 1] = float( y );
+        deproject_pixels_to_points( &_rays[3 * size_t( y ) * w], depth_intrin, row.data(), nullptr, w );
+    }
+
+    auto r = depth_to_color.rotation;
+    for( size_t i = 0; i < _rays.size(); i += 3 )
+    {
+        float ray[3] = { _rays[i], _rays[i + 1], _rays[i + 2] };
+        for( int c = 0; c < 3; ++c )
+            _rays[i + c] = r[c] * ray[0] + r[c + 3] * ray[1] + r[c + 6] * ray[2];
+    }
+}
+
+
+void color_to_depth_map::map( float * to_pixels,
+                              const uint16_t * data,
+                              float depth_scale,
+                              float depth_min,
+                              float depth_max,
+                              const rs2_intrinsics & depth_intrin,
+                              const rs2_intrinsics & color_intrin,
+                              const rs2_extrinsics & color_to_depth,
+                              const rs2_extrinsics & depth_to_color,
+                              const float * from_pixels,
+                              size_t count )
+{
+    update( depth_intrin, depth_to_color );
+
+    // The rays of the color pixels, their points at the nearest and farthest depths in the depth sensor's
+    // coordinates, and the depth pixels those are at: the ends of the lines
+    _lines.resize( 3 * count + 6 * count + 4 * count );
+    float * rays = _lines.data();
+    float * points = rays + 3 * count;
+    float * ends = points + 6 * count;
+
+    deproject_pixels_to_points( rays, color_intrin, from_pixels, nullptr, count );
+    for( size_t i = 0; i < count; ++i )
+    {
+        const float * ray = rays + 3 * i;
+        for( int k = 0; k < 2; ++k )
+        {
+            float depth = k ? depth_max : depth_min;
+            float point[3] = { depth * ray[0], depth * ray[1], depth * ray[2] };
+            rs2_transform_point_to_point( points + 6 * i + 3 * k, &color_to_depth, point );
+        }
+    }
+    project_points_to_pixels( ends, depth_intrin, points, 2 * count );
+
+    int w = depth_intrin.width, h = depth_intrin.height;
+    auto t = depth_to_color.translation;
+    for( size_t i = 0; i < count; ++i )
+    {
+        float * start_pixel = ends + 4 * i;
+        float * end_pixel = start_pixel + 2;
+        adjust_2D_point_to_boundary( start_pixel, w, h );
+        adjust_2D_point_to_boundary( end_pixel, w, h );
+        const float * from_pixel = from_pixels + 2 * i;
+
+        // Search along the line for the depth pixel whose projection is closest to the color pixel
+        float min_dist = -1;
+        for( float p[2] = { start_pixel[0], start_pixel[1] }; is_pixel_in_line( p, start_pixel, end_pixel );
+             next_pixel_in_line( p, start_pixel, end_pixel ) )
+        {
+            // The line ends at the far edges
+            int ix = (int)p[0], iy = (int)p[1];
+            if( ix < 0 || iy < 0 || ix >= w || iy >= h )
+                continue;
+            float depth = depth_scale * data[iy * w + ix];
+            if( depth == 0 )
+                continue;
+
+            float transformed_point[3];
+            if( _rays.empty() )
+            {
+                float point[3];
+                rs2_deproject_pixel_to_point( point, &depth_intrin, p, depth );
+                rs2_transform_point_to_point( transformed_point, &depth_to_color, point );
+            }
+            else
+            {
+                int x0 = std::min( ix, w - 2 ), y0 = std::min( iy, h - 2 );
+                float fx = p[0] - x0, fy = p[1] - y0;
+                const float * r00 = &_rays[3 * ( size_t( y0 ) * w + x0 )];
+                const float * r10 = r00 + 3 * w;
+                for( int c = 0; c < 3; ++c )
+                {
+                    float ray = ( 1 - fy ) * ( ( 1 - fx ) * r00[c] + fx * r00[c + 3] )
+                              + fy * ( ( 1 - fx ) * r10[c] + fx * r10[c + 3] );
+                    transformed_point[c] = depth * ray + t[c];
+                }
+            }
+
+            float projected_pixel[2];
+            rs2_project_point_to_pixel( projected_pixel, &color_intrin, transformed_point );
+
+            float dx = projected_pixel[0] - from_pixel[0], dy = projected_pixel[1] - from_pixel[1];
+            float new_dist = dy * dy + dx * dx;
+            if( new_dist < min_dist || min_dist < 0 )
+            {
+                min_dist = new_dist;
+                to_pixels[2 * i] = p[0];
+                to_pixels[2 * i + 1] = p[1];
+            }
+        }
+    }
+}
+
+
+}  // namespace librealsense
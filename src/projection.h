@@ -0,0 +1,62 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/h/rs_types.h>
+#include <librealsense2/h/rs_sensor.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace librealsense {
+
+
+// rs2_project_point_to_pixel and rs2_deproject_pixel_to_point for batches: points are 3 floats and pixels 2, one
+// after the other. The models that are polynomials (none and the Brown-Conrady ones) are computed 4 points at a time
+// with SSE or NEON, the same operations in the same order; the others, and what's left over, one at a time.
+// Without depths, pixels are deprojected at a depth of 1.
+void project_points_to_pixels( float * pixels, const rs2_intrinsics & intrin, const float * points, size_t count );
+void deproject_pixels_to_points( float * points, const rs2_intrinsics & intrin, const float * pixels,
+                                 const float * depths, size_t count );
+
+
+// The search along a line of depth pixels of rs2_project_color_pixel_to_depth_pixel
+void next_pixel_in_line( float curr[2], const float start[2], const float end[2] );
+bool is_pixel_in_line( const float curr[2], const float start[2], const float end[2] );
+void adjust_2D_point_to_boundary( float p[2], int width, int height );
+
+
+// rs2_project_color_pixel_to_depth_pixel for batches of color pixels. The search along the line of depth pixels a
+// color pixel could be at takes every depth pixel on it to the color image; their rays (deprojected at a depth of 1
+// meter and turned by the depth to color extrinsics) are the same for every frame, and are kept in a table while the
+// depth intrinsics and extrinsics stay the same. The rays of pixels between those of the table are interpolated.
+class color_to_depth_map
+{
+public:
+    // to_pixels[2 * i] and up is left as it is when no depth pixel is found for from_pixels[2 * i]
+    void map( float * to_pixels,
+              const uint16_t * data,
+              float depth_scale,
+              float depth_min,
+              float depth_max,
+              const rs2_intrinsics & depth_intrin,
+              const rs2_intrinsics & color_intrin,
+              const rs2_extrinsics & color_to_depth,
+              const rs2_extrinsics & depth_to_color,
+              const float * from_pixels,
+              size_t count );
+
+private:
+    void update( const rs2_intrinsics & depth_intrin, const rs2_extrinsics & depth_to_color );
+
+    rs2_intrinsics _depth_intrin = {};
+    rs2_extrinsics _depth_to_color = {};
+    std::vector< float > _rays;  // 3 per depth pixel
+    std::vector< float > _lines;  // Scratch: the rays of the color pixels, then the ends of their lines
+};
+
+
+}  // namespace librealsense
@@ -5,6 +5,7 @@
 
 #include "api.h"
 #include "log.h"
+#include "frame-trace.h"
 #include "context.h"
 #include "device.h"
 #include "algo.h"
@@ -13,6 +14,7 @@
 #include "core/extension.h"
 #include "media/playback/playback-device-info.h"
 #include "media/record/record_device.h"
+#include "media/record/multi_device_writer.h"
 #include <media/ros/ros_writer.h>
 #include <media/ros/ros_reader.h>
 #include "core/advanced_mode.h"
@@ -29,6 +31,7 @@
 #include "proc/units-transform.h"
 #include "proc/disparity-transform.h"
 #include "proc/syncer-processing-block.h"
+#include "sync.h"
 #include "proc/decimation-filter.h"
 #include "proc/spatial-filter.h"
 #include "proc/hole-filling-filter.h"
@@ -37,11 +40,21 @@
 #include "proc/rates-printer.h"
 #include "proc/hdr-merge.h"
 #include "proc/sequence-id-filter.h"
+#include "proc/depth-pipeline.h"
+#include "proc/depth-normalize.h"
+#include "proc/depth-quality-metrics.h"
+#include "proc/undistort-filter.h"
+#include "proc/depth-fusion.h"
+#include "proc/scene-change-gate.h"
+#include "proc/sparse-depth-transform.h"
+#include "proc/processing-graph.h"
 #include "media/playback/playback_device.h"
 #include "stream.h"
+#include "motion-history.h"
 #include <librealsense2/h/rs_types.h>
 #include "pipeline/pipeline.h"
 #include "environment.h"
+#include "low-latency.h"
 #include "proc/temporal-filter.h"
 #include "software-device.h"
 #include "software-device-info.h"
@@ -55,10 +68,16 @@
 #include "debug-stream-sensor.h"
 #include "max-usable-range-sensor.h"
 #include "fw-update/fw-update-device-interface.h"
+#include "fw-update/fw-update-devices.h"
 #include "core/frame-callback.h"
+#include "core/frame-allocator.h"
+#include "core/numa-frame-allocator.h"
+#include "core/options-writer.h"
 #include "color-sensor.h"
 #include "composite-frame.h"
+#include "cuda/cuda-frame.h"
 #include "points.h"
+#include "projection.h"
 
 #include <src/core/time-service.h>
 #include <rsutils/string/from.h>
@@ -164,6 +183,10 @@ struct rs2_sensor : public rs2_options
     rs2_sensor(const rs2_sensor&) = delete;
 
     rsutils::subscription subscription;
+
+    // The device's, once rs2_set_options_async is called
+    mutable std::mutex writer_mutex;
+    mutable std::shared_ptr< librealsense::options_writer > writer;
 };
 
 struct rs2_context
@@ -194,10 +217,10 @@ struct rs2_pipeline_profile
 
 struct rs2_frame_queue
 {
-    explicit rs2_frame_queue(int cap)
+    explicit rs2_frame_queue(int cap, bool lock_free = false, std::chrono::microseconds busy_poll = std::chrono::microseconds(0))
         : queue( cap, [cap]( librealsense::frame_holder const & fh ) {
             LOG_DEBUG( "DROPPED queue (capacity= " << cap << ") frame " << fh );
-        } )
+        }, lock_free, busy_poll )
     {
     }
 
@@ -239,14 +262,10 @@ rs2_error *rs2_create_error(const char* what, const char* name, const char* args
 }
 NOEXCEPT_RETURN(nullptr, what, name, args, type)
 
-void notifications_processor::raise_notification(const notification n)
+/*static*/ void notifications_processor::notify(rs2_notifications_callback& callback, const notification& n)
 {
-    _dispatcher.invoke([this, n](dispatcher::cancellable_timer ct)
-    {
-        std::lock_guard<std::mutex> lock(_callback_mutex);
-        rs2_notification noti(&n);
-        if (_callback)_callback->on_notification(&noti);
-    });
+    rs2_notification noti(&n);
+    callback.on_notification(&noti);
 }
 
 rs2_context* rs2_create_context(int api_version, rs2_error** error) BEGIN_API_CALL
@@ -365,6 +384,17 @@ rs2_device* rs2_create_device(const rs2_device_list* info_list, int index, rs2_e
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, info_list, index)
 
+void rs2_create_devices(const rs2_device_list* info_list, rs2_device** devices, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(info_list);
+    VALIDATE_NOT_NULL(devices);
+
+    auto created = info_list->ctx->create_devices( info_list->list );
+    for( size_t i = 0; i < created.size(); ++i )
+        devices[i] = new rs2_device{ created[i] };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, info_list, devices)
+
 void rs2_delete_device(rs2_device* device) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -423,6 +453,58 @@ rs2_stream_profile_list* rs2_get_active_streams(rs2_sensor* sensor, rs2_error**
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, sensor)
 
+int rs2_get_stream_telemetry(const rs2_sensor* sensor, rs2_stream_telemetry* telemetry, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_GT(count, -1);
+    if (count)
+        VALIDATE_NOT_NULL(telemetry);
+    auto streams = sensor->sensor->get_stream_telemetry();
+    std::copy_n(streams.begin(), std::min(streams.size(), size_t(count)), telemetry);
+    return static_cast<int>(streams.size());
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, sensor, telemetry, count)
+
+static void set_metadata_sink( const rs2_sensor* sensor, std::shared_ptr< metadata_sink > sink )
+{
+    if( ! sensor->sensor->set_metadata_sink( std::move( sink ) ) )
+        throw not_implemented_exception( "sensor does not support a metadata sink" );
+}
+
+void rs2_set_metadata_sink(const rs2_sensor* sensor, int batch_size, rs2_metadata_batch_callback_ptr callback, void* user, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    if( ! callback )
+        return set_metadata_sink( sensor, nullptr );
+    VALIDATE_GT(batch_size, 0);
+    set_metadata_sink( sensor, std::make_shared< metadata_sink >( batch_size,
+        [callback, user]( rs2_metadata_batch const & batch ) { callback( &batch, user ); } ) );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, batch_size, callback, user)
+
+void rs2_set_metadata_sink_cpp(const rs2_sensor* sensor, int batch_size, rs2_metadata_batch_callback* callback, rs2_error** error) BEGIN_API_CALL
+{
+    // Take ownership of the callback ASAP or else memory leaks could result if we throw! (the caller usually does a 'new' when calling us)
+    rs2_metadata_batch_callback_sptr cb;
+    if( callback )
+        cb.reset( callback, []( rs2_metadata_batch_callback* p ) { p->release(); } );
+    VALIDATE_NOT_NULL(sensor);
+    if( ! cb )
+        return set_metadata_sink( sensor, nullptr );
+    VALIDATE_GT(batch_size, 0);
+    set_metadata_sink( sensor, std::make_shared< metadata_sink >( batch_size,
+        [cb]( rs2_metadata_batch const & batch ) { cb->on_batch( &batch ); } ) );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, batch_size, callback)
+
+void rs2_flush_metadata_sink(const rs2_sensor* sensor, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    if( ! sensor->sensor->flush_metadata_sink() )
+        throw not_implemented_exception( "sensor does not support a metadata sink" );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor)
+
 const rs2_stream_profile* rs2_get_stream_profile(const rs2_stream_profile_list* list, int index, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(list);
@@ -774,6 +856,66 @@ void rs2_delete_option_value( rs2_option_value const * p_value ) BEGIN_API_CALL
 }
 NOEXCEPT_RETURN( , p_value )
 
+void rs2_set_options_async(const rs2_options* options, const rs2_option* option_ids, const float* values, int count,
+                           rs2_options_set_callback_ptr callback, void* user, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(options);
+    VALIDATE_GT(count, -1);
+    if (count)
+    {
+        VALIDATE_NOT_NULL(option_ids);
+        VALIDATE_NOT_NULL(values);
+    }
+    auto sens = dynamic_cast< const rs2_sensor * >( options );
+    VALIDATE_NOT_NULL(sens);
+
+    // Checked as rs2_set_option would, before anything is queued
+    std::vector< std::pair< librealsense::option *, float > > writes;
+    for (int i = 0; i < count; ++i)
+    {
+        VALIDATE_OPTION_ENABLED(options, option_ids[i]);
+        auto& option_ref = options->options->get_option(option_ids[i]);
+        auto type = option_ref.get_value_type();
+        if (type != RS2_OPTION_TYPE_FLOAT && type != RS2_OPTION_TYPE_INTEGER)
+            throw invalid_value_exception(rsutils::string::from() << librealsense::get_string(option_ids[i])
+                                                                  << " cannot be set asynchronously");
+        auto range = option_ref.get_range();
+        if (range.min != range.max && range.step)
+            VALIDATE_RANGE(values[i], range.min, range.max);
+        if (type == RS2_OPTION_TYPE_INTEGER && (int)values[i] != values[i])
+            throw invalid_value_exception(rsutils::string::from() << "not an integer: " << values[i]);
+        writes.emplace_back(&option_ref, values[i]);
+    }
+
+    std::shared_ptr< librealsense::options_writer > writer;
+    {
+        std::lock_guard< std::mutex > lock(sens->writer_mutex);
+        if (!sens->writer)
+            sens->writer = librealsense::options_writer::for_device(sens->parent);
+        writer = sens->writer;
+    }
+    writer->write(writes, sens->parent,
+        [callback, user](std::exception_ptr ex)
+        {
+            if (!callback)
+                return;
+            rs2_error* e = nullptr;
+            if (ex)
+            {
+                try
+                {
+                    std::rethrow_exception(ex);
+                }
+                catch (...)
+                {
+                    librealsense::translate_exception("rs2_set_options_async", "", &e);
+                }
+            }
+            callback(e, user);
+        });
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, options, option_ids, values, count, callback, user)
+
 void rs2_set_option(const rs2_options* options, rs2_option option, float value, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(options);
@@ -1066,6 +1208,36 @@ void rs2_set_notifications_callback(const rs2_sensor* sensor, rs2_notification_c
 HANDLE_EXCEPTIONS_AND_RETURN(, sensor, on_notification, user)
 
 
+void rs2_set_frame_allocator(const rs2_sensor* sensor, rs2_frame_allocate_ptr on_allocate, rs2_frame_deallocate_ptr on_deallocate, void* user, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    if (on_allocate)
+        VALIDATE_NOT_NULL(on_deallocate);
+    auto sb = dynamic_cast< librealsense::sensor_base * >( sensor->sensor );
+    if( ! sb )
+        throw not_implemented_exception( "Frame allocators are not supported by this sensor" );
+    std::shared_ptr< librealsense::frame_allocator > allocator;
+    if( on_allocate )
+        allocator = std::make_shared< librealsense::frame_allocator_ptr >( on_allocate, on_deallocate, user );
+    sb->set_frame_allocator( allocator );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, on_allocate, on_deallocate, user)
+
+void rs2_set_frame_memory_policy(const rs2_sensor* sensor, int numa_node, int huge_pages, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_RANGE(numa_node, -1, 1023);
+    auto sb = dynamic_cast< librealsense::sensor_base * >( sensor->sensor );
+    if( ! sb )
+        throw not_implemented_exception( "Frame allocators are not supported by this sensor" );
+    std::shared_ptr< librealsense::frame_allocator > allocator;
+    if( numa_node >= 0 || huge_pages )
+        allocator = std::make_shared< librealsense::numa_frame_allocator >( numa_node, huge_pages != 0 );
+    sb->set_frame_allocator( allocator );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, numa_node, huge_pages)
+
+
 class software_device_destruction_callback : public rs2_software_device_destruction_callback
 {
     rs2_software_device_destruction_callback_ptr nptr;
@@ -1237,11 +1409,31 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
     if( frame_ifc->find_metadata( frame_metadata, &value ) )
         return value;
     throw invalid_value_exception( rsutils::string::from()
-                                   << get_string( frame_ifc->get_stream()->get_stream_type() )
+                                   << get_string( frame_ifc->peek_stream()->get_stream_type() )
                                    << " frame does not support metadata \"" << get_string( frame_metadata ) << "\"" );
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame, frame_metadata)
 
+int rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_metadata_type* values, int* supported, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(values);
+    VALIDATE_RANGE(count, 0, RS2_FRAME_METADATA_COUNT);
+    // Each lookup is into the frame's metadata table, decoded on the first one
+    auto frame_ifc = (frame_interface *)frame;
+    int n_supported = 0;
+    for( int i = 0; i < count; ++i )
+    {
+        values[i] = 0;
+        bool found = frame_ifc->find_metadata( rs2_frame_metadata_value( i ), &values[i] );
+        if( supported )
+            supported[i] = found;
+        n_supported += found;
+    }
+    return n_supported;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame, values, supported, count)
+
 const char* rs2_get_notification_description(rs2_notification* notification, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(notification);
@@ -1296,19 +1488,19 @@ int rs2_device_list_contains(const rs2_device_list* info_list, const rs2_device*
 }
 HANDLE_EXCEPTIONS_AND_RETURN(false, info_list, device)
 
-rs2_time_t rs2_get_frame_timestamp(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+rs2_time_t rs2_get_frame_timestamp(const rs2_frame* frame_ref, rs2_error** error) BEGIN_FAST_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
     return ((frame_interface*)frame_ref)->get_frame_timestamp();
 }
-HANDLE_EXCEPTIONS_AND_RETURN(0, frame_ref)
+FAST_API_RETURN(0, frame_ref)
 
-rs2_timestamp_domain rs2_get_frame_timestamp_domain(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+rs2_timestamp_domain rs2_get_frame_timestamp_domain(const rs2_frame* frame_ref, rs2_error** error) BEGIN_FAST_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
     return ((frame_interface*)frame_ref)->get_frame_timestamp_domain();
 }
-HANDLE_EXCEPTIONS_AND_RETURN(RS2_TIMESTAMP_DOMAIN_COUNT, frame_ref)
+FAST_API_RETURN(RS2_TIMESTAMP_DOMAIN_COUNT, frame_ref)
 
 rs2_sensor* rs2_get_frame_sensor(const rs2_frame* frame, rs2_error** error) BEGIN_API_CALL
 {
@@ -1319,65 +1511,110 @@ rs2_sensor* rs2_get_frame_sensor(const rs2_frame* frame, rs2_error** error) BEGI
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frame)
 
-int rs2_get_frame_data_size(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+int rs2_get_frame_data_size(const rs2_frame* frame_ref, rs2_error** error) BEGIN_FAST_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
     return ((frame_interface*)frame_ref)->get_frame_data_size();
 }
-HANDLE_EXCEPTIONS_AND_RETURN(0, frame_ref)
+FAST_API_RETURN(0, frame_ref)
 
-const void* rs2_get_frame_data(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+const void* rs2_get_frame_data(const rs2_frame* frame_ref, rs2_error** error) BEGIN_FAST_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
     return ((frame_interface*)frame_ref)->get_frame_data();
 }
-HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frame_ref)
+FAST_API_RETURN(nullptr, frame_ref)
 
-int rs2_get_frame_width(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+int rs2_get_frame_dmabuf_fd(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame_ref);
+    auto f = dynamic_cast< librealsense::frame * >( (frame_interface *)frame_ref );
+    return f && f->external_data ? f->external_fd : -1;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(-1, frame_ref)
+
+const void* rs2_get_frame_cuda_data(const rs2_frame* frame_ref, int* device, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame_ref);
+    int index = -1;
+    const void* data = nullptr;
+#ifdef RS2_USE_CUDA
+    if (auto section = librealsense::cuda::section_of((frame_interface*)frame_ref))
+        data = section->device_content(index);
+#endif
+    if (device)
+        *device = index;
+    return data;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frame_ref, device)
+
+int rs2_get_frame_width(const rs2_frame* frame_ref, rs2_error** error) BEGIN_FAST_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
     auto vf = VALIDATE_INTERFACE(((frame_interface*)frame_ref), librealsense::video_frame);
     return vf->get_width();
 }
-HANDLE_EXCEPTIONS_AND_RETURN(0, frame_ref)
+FAST_API_RETURN(0, frame_ref)
 
-int rs2_get_frame_height(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+int rs2_get_frame_height(const rs2_frame* frame_ref, rs2_error** error) BEGIN_FAST_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
     auto vf = VALIDATE_INTERFACE(((frame_interface*)frame_ref), librealsense::video_frame);
     return vf->get_height();
 }
-HANDLE_EXCEPTIONS_AND_RETURN(0, frame_ref)
+FAST_API_RETURN(0, frame_ref)
 
-int rs2_get_frame_stride_in_bytes(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+int rs2_get_frame_stride_in_bytes(const rs2_frame* frame_ref, rs2_error** error) BEGIN_FAST_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
     auto vf = VALIDATE_INTERFACE(((frame_interface*)frame_ref), librealsense::video_frame);
     return vf->get_stride();
 }
-HANDLE_EXCEPTIONS_AND_RETURN(0, frame_ref)
+FAST_API_RETURN(0, frame_ref)
 
 const rs2_stream_profile* rs2_get_frame_stream_profile(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
-    return ((frame_interface*)frame_ref)->get_stream()->get_c_wrapper();
+    return ((frame_interface*)frame_ref)->peek_stream()->get_c_wrapper();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frame_ref)
 
-int rs2_get_frame_bits_per_pixel(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+int rs2_get_frame_bits_per_pixel(const rs2_frame* frame_ref, rs2_error** error) BEGIN_FAST_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
     auto vf = VALIDATE_INTERFACE(((frame_interface*)frame_ref), librealsense::video_frame);
     return vf->get_bpp();
 }
-HANDLE_EXCEPTIONS_AND_RETURN(0, frame_ref)
+FAST_API_RETURN(0, frame_ref)
 
-unsigned long long rs2_get_frame_number(const rs2_frame* frame, rs2_error** error) BEGIN_API_CALL
+unsigned long long rs2_get_frame_number(const rs2_frame* frame, rs2_error** error) BEGIN_FAST_API_CALL
 {
     VALIDATE_NOT_NULL(frame);
     return ((frame_interface*)frame)->get_frame_number();
 }
-HANDLE_EXCEPTIONS_AND_RETURN(0, frame)
+FAST_API_RETURN(0, frame)
+
+void rs2_get_frame_info(const rs2_frame* frame, rs2_frame_info* info, rs2_error** error) BEGIN_FAST_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(info);
+    auto f = (frame_interface*)frame;
+    info->data = f->get_frame_data();
+    info->data_size = f->get_frame_data_size();
+    info->timestamp = f->get_frame_timestamp();
+    info->timestamp_domain = f->get_frame_timestamp_domain();
+    info->frame_number = f->get_frame_number();
+    if (auto vf = dynamic_cast<librealsense::video_frame*>(f))
+    {
+        info->width = vf->get_width();
+        info->height = vf->get_height();
+        info->stride = vf->get_stride();
+        info->bpp = vf->get_bpp();
+    }
+    else
+        info->width = info->height = info->stride = info->bpp = 0;
+}
+FAST_API_RETURN(, frame, info)
 
 void rs2_release_frame(rs2_frame* frame) BEGIN_API_CALL
 {
@@ -1400,12 +1637,12 @@ const char* rs2_get_option_description(const rs2_options* options, rs2_option op
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, options, option)
 
-void rs2_frame_add_ref(rs2_frame* frame, rs2_error** error) BEGIN_API_CALL
+void rs2_frame_add_ref(rs2_frame* frame, rs2_error** error) BEGIN_FAST_API_CALL
 {
     VALIDATE_NOT_NULL(frame);
     ((frame_interface*)frame)->acquire();
 }
-HANDLE_EXCEPTIONS_AND_RETURN(, frame)
+FAST_API_RETURN(, frame)
 
 const char* rs2_get_option_value_description(const rs2_options* options, rs2_option option, float value, rs2_error** error) BEGIN_API_CALL
 {
@@ -1471,10 +1708,22 @@ HANDLE_EXCEPTIONS_AND_RETURN( , options, callback )
 
 rs2_frame_queue* rs2_create_frame_queue(int capacity, rs2_error** error) BEGIN_API_CALL
 {
+    // In low-latency mode, whoever waits on the queue polls it rather than sleeping until woken
+    auto low_latency = low_latency_settings::get();
+    if (low_latency.enabled && capacity > 0)
+        return new rs2_frame_queue(capacity, true, low_latency.busy_poll);
     return new rs2_frame_queue(capacity);
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, capacity)
 
+rs2_frame_queue* rs2_create_lock_free_frame_queue(int capacity, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_GT(capacity, 0);
+    auto low_latency = low_latency_settings::get();
+    return new rs2_frame_queue(capacity, true, low_latency.enabled ? low_latency.busy_poll : std::chrono::microseconds(0));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, capacity)
+
 void rs2_delete_frame_queue(rs2_frame_queue* queue) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
@@ -1514,6 +1763,34 @@ int rs2_poll_for_frame(rs2_frame_queue* queue, rs2_frame** output_frame, rs2_err
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, queue, output_frame)
 
+namespace {
+
+// Moves the frames out of the holders, leaving them empty for the next batch
+int release_batch(std::vector<librealsense::frame_holder>& batch, size_t n, rs2_frame** output_frames)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        frame_interface* result = nullptr;
+        std::swap(result, batch[i].frame);
+        output_frames[i] = (rs2_frame*)result;
+    }
+    return int(n);
+}
+
+}
+
+int rs2_frame_queue_poll_batch(rs2_frame_queue* queue, rs2_frame** output_frames, int max_frames, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(queue);
+    VALIDATE_NOT_NULL(output_frames);
+    VALIDATE_GT(max_frames, 0);
+    static thread_local std::vector<librealsense::frame_holder> batch;
+    if (batch.size() < size_t(max_frames))
+        batch.resize(max_frames);
+    return release_batch(batch, queue->queue.try_dequeue_batch(batch.data(), max_frames), output_frames);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, queue, output_frames, max_frames)
+
 int rs2_try_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, rs2_frame** output_frame, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
@@ -1602,6 +1879,15 @@ void rs2_hardware_reset(const rs2_device* device, rs2_error** error) BEGIN_API_C
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, device)
 
+void rs2_get_global_time_telemetry(const rs2_device* device, rs2_global_time_telemetry* telemetry, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(telemetry);
+    auto timer = VALIDATE_INTERFACE(device->device, librealsense::global_time_interface);
+    *telemetry = timer->get_global_time_telemetry();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, telemetry)
+
 // Verify  and provide API version encoded as integer value
 int rs2_get_api_version(rs2_error** error) BEGIN_API_CALL
 {
@@ -1681,6 +1967,25 @@ void rs2_log_to_file(rs2_log_severity min_severity, const char* file_path, rs2_e
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, min_severity, file_path)
 
+void rs2_log_to_binary_file(rs2_log_severity min_severity, const char* file_path, rs2_error** error) BEGIN_API_CALL
+{
+    librealsense::binary_log::log_to_file(min_severity, file_path);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, min_severity, file_path)
+
+void rs2_enable_frame_tracing(int enable, rs2_error** error) BEGIN_API_CALL
+{
+    librealsense::frame_trace::enable(enable != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, enable)
+
+void rs2_export_frame_trace(const char* file_path, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(file_path);
+    librealsense::frame_trace::export_trace(file_path);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, file_path)
+
 void rs2_log_to_callback_cpp( rs2_log_severity min_severity, rs2_log_callback * callback, rs2_error** error ) BEGIN_API_CALL
 {
     // Take ownership of the callback ASAP or else memory leaks could result if we throw! (the caller usually does a
@@ -1885,6 +2190,14 @@ int rs2_is_processing_block_extendable_to(const rs2_processing_block* f, rs2_ext
     case RS2_EXTENSION_DEPTH_HUFFMAN_DECODER: throw not_implemented_exception( "deprecated" );
     case RS2_EXTENSION_HDR_MERGE: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::hdr_merge) != nullptr;
     case RS2_EXTENSION_SEQUENCE_ID_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::sequence_id_filter) != nullptr;
+    case RS2_EXTENSION_DEPTH_PIPELINE: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::depth_pipeline) != nullptr;
+    case RS2_EXTENSION_PROCESSING_GRAPH: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::processing_graph) != nullptr;
+    case RS2_EXTENSION_DEPTH_NORMALIZE: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::depth_normalize) != nullptr;
+    case RS2_EXTENSION_DEPTH_QUALITY_METRICS: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::depth_quality_metrics) != nullptr;
+    case RS2_EXTENSION_UNDISTORT_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::undistort_filter) != nullptr;
+    case RS2_EXTENSION_DEPTH_FUSION: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::depth_fusion) != nullptr;
+    case RS2_EXTENSION_SCENE_CHANGE_GATE: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::scene_change_gate) != nullptr;
+    case RS2_EXTENSION_SPARSE_DEPTH_TRANSFORM: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::sparse_depth_transform) != nullptr;
   
     default:
         return false;
@@ -1912,9 +2225,17 @@ rs2_device* rs2_context_add_device(rs2_context* ctx, const char* file, rs2_error
     VALIDATE_NOT_NULL(ctx);
     VALIDATE_NOT_NULL(file);
 
-    auto dev_info = std::make_shared< playback_device_info >( ctx->ctx, file );
-    ctx->ctx->add_device( dev_info );
-    return new rs2_device{ dev_info->create_device() };
+    // A file recorded from several devices gets a playback device for each; the first is returned, the others are
+    // found through the context
+    std::shared_ptr< playback_device_info > first;
+    for( auto index : ros_reader::read_device_indices( file ) )
+    {
+        auto dev_info = std::make_shared< playback_device_info >( ctx->ctx, file, index );
+        ctx->ctx->add_device( dev_info );
+        if( ! first )
+            first = dev_info;
+    }
+    return new rs2_device{ first->create_device() };
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, ctx, file)
 
@@ -1936,8 +2257,17 @@ void rs2_context_remove_device(rs2_context* ctx, const char* file, rs2_error** e
     VALIDATE_NOT_NULL(file);
     // The context uses the address from the device-info to maintain the list of devices. I.e., we need a device-info
     // that uses a device-info that is_same_as() the one created above, in rs2_context_add_device:
-    auto dev_info = std::make_shared< playback_device_info >( ctx->ctx, file );
-    ctx->ctx->remove_device( dev_info );
+    std::set< uint32_t > indices{ 0 };
+    try
+    {
+        indices = ros_reader::read_device_indices( file );
+    }
+    catch( ... )
+    {
+        // The file may be gone by now; then only a single device is removed
+    }
+    for( auto index : indices )
+        ctx->ctx->remove_device( std::make_shared< playback_device_info >( ctx->ctx, file, index ) );
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, ctx, file)
 
@@ -2003,6 +2333,25 @@ void rs2_playback_device_set_real_time(const rs2_device* device, int real_time,
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, device)
 
+void rs2_playback_device_set_offline(const rs2_device* device, int max_frames_in_flight, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_RANGE(max_frames_in_flight, 0, std::numeric_limits<int>::max());
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->set_offline(max_frames_in_flight);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, max_frames_in_flight)
+
+void rs2_playback_device_set_range(const rs2_device* device, unsigned long long int start, unsigned long long int end, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    if (end && end <= start)
+        throw librealsense::invalid_value_exception("playback range must end after it starts");
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->set_range(std::chrono::nanoseconds(start), std::chrono::nanoseconds(end));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, start, end)
+
 int rs2_playback_device_is_real_time(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -2072,11 +2421,35 @@ rs2_device* rs2_create_record_device_ex(const rs2_device* device, const char* fi
     VALIDATE_NOT_NULL(file);
 
     return new rs2_device({
-        std::make_shared<record_device>(device->device, std::make_shared<ros_writer>(file, compression_enabled != 0))
+        std::make_shared<record_device>(device->device, std::make_shared<ros_writer>(file, compression_enabled != 0,
+                                                                                     record_device::direct_io(device->device->get_context()),
+                                                                                     record_device::encode_depth(device->device->get_context())))
         });
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, file)
 
+void rs2_create_multi_record_device(const rs2_device* const* devices, int count, const char* file, int compression_enabled,
+                                    rs2_device** record_devices, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(devices);
+    VALIDATE_RANGE(count, 1, 0xffff);
+    VALIDATE_NOT_NULL(file);
+    VALIDATE_NOT_NULL(record_devices);
+
+    std::vector< std::shared_ptr< device_interface > > recorded;
+    for (int i = 0; i < count; ++i)
+    {
+        VALIDATE_NOT_NULL(devices[i]);
+        recorded.push_back(devices[i]->device);
+    }
+    auto ctx = recorded.front()->get_context();
+    auto recorders = multi_device_writer::record(recorded,
+        std::make_shared<ros_writer>(file, compression_enabled != 0, record_device::direct_io(ctx), record_device::encode_depth(ctx)));
+    for (int i = 0; i < count; ++i)
+        record_devices[i] = new rs2_device{ recorders[i] };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, devices, count, file, compression_enabled, record_devices)
+
 void rs2_record_device_pause(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -2200,6 +2573,18 @@ int rs2_pipeline_poll_for_frames(rs2_pipeline * pipe, rs2_frame** output_frame,
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, pipe, output_frame)
 
+int rs2_pipeline_poll_for_frames_batch(rs2_pipeline* pipe, rs2_frame** output_frames, int max_frames, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(pipe);
+    VALIDATE_NOT_NULL(output_frames);
+    VALIDATE_GT(max_frames, 0);
+    static thread_local std::vector<librealsense::frame_holder> batch;
+    if (batch.size() < size_t(max_frames))
+        batch.resize(max_frames);
+    return release_batch(batch, pipe->pipeline->poll_for_frames_batch(batch.data(), max_frames), output_frames);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, pipe, output_frames, max_frames)
+
 int rs2_pipeline_try_wait_for_frames(rs2_pipeline* pipe, rs2_frame** output_frame, unsigned int timeout_ms, rs2_error ** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(pipe);
@@ -2518,6 +2903,19 @@ rs2_processing_block* rs2_create_sync_processing_block(rs2_error** error) BEGIN_
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_multi_device_sync_processing_block(float max_jitter_ms, rs2_error** error) BEGIN_API_CALL
+{
+    if (max_jitter_ms < 0)
+        throw librealsense::invalid_value_exception("max_jitter_ms must not be negative");
+
+    auto block = std::make_shared<librealsense::syncer_process_unit>(
+        std::make_shared<librealsense::global_timestamp_composite_matcher>(max_jitter_ms),
+        std::initializer_list< librealsense::bool_option::ptr >{});
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, max_jitter_ms)
+
 void rs2_start_processing(rs2_processing_block* block, rs2_frame_callback* on_frame, rs2_error** error) BEGIN_API_CALL
 {
     // Take ownership of the callback ASAP or else memory leaks could result if we throw! (the caller usually does a
@@ -2685,7 +3083,7 @@ HANDLE_EXCEPTIONS_AND_RETURN(nullptr, align_to)
 
 rs2_processing_block* rs2_create_colorizer(rs2_error** error) BEGIN_API_CALL
 {
-    auto block = std::make_shared<librealsense::colorizer>();
+    auto block = librealsense::colorizer::create();
 
     auto res = new rs2_processing_block{ block };
 
@@ -2696,7 +3094,7 @@ NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
 rs2_processing_block* rs2_create_decimation_filter_block(rs2_error** error) BEGIN_API_CALL
 {
-    auto block = std::make_shared<librealsense::decimation_filter>();
+    auto block = librealsense::decimation_filter::create();
 
     return new rs2_processing_block{ block };
 }
@@ -2704,7 +3102,7 @@ NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
 rs2_processing_block* rs2_create_temporal_filter_block(rs2_error** error) BEGIN_API_CALL
 {
-    auto block = std::make_shared<librealsense::temporal_filter>();
+    auto block = librealsense::temporal_filter::create();
 
     return new rs2_processing_block{ block };
 }
@@ -2712,7 +3110,7 @@ NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
 rs2_processing_block* rs2_create_spatial_filter_block(rs2_error** error) BEGIN_API_CALL
 {
-    auto block = std::make_shared<librealsense::spatial_filter>();
+    auto block = librealsense::spatial_filter::create();
 
     return new rs2_processing_block{ block };
 }
@@ -2720,7 +3118,7 @@ NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
 rs2_processing_block* rs2_create_disparity_transform_block(unsigned char transform_to_disparity, rs2_error** error) BEGIN_API_CALL
 {
-    auto block = std::make_shared<librealsense::disparity_transform>(transform_to_disparity > 0);
+    auto block = librealsense::disparity_transform::create(transform_to_disparity > 0);
 
     return new rs2_processing_block{ block };
 }
@@ -2728,7 +3126,7 @@ HANDLE_EXCEPTIONS_AND_RETURN(nullptr, transform_to_disparity)
 
 rs2_processing_block* rs2_create_hole_filling_filter_block(rs2_error** error) BEGIN_API_CALL
 {
-    auto block = std::make_shared<librealsense::hole_filling_filter>();
+    auto block = librealsense::hole_filling_filter::create();
 
     return new rs2_processing_block{ block };
 }
@@ -2770,6 +3168,130 @@ rs2_processing_block* rs2_create_sequence_id_filter(rs2_error** error) BEGIN_API
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_depth_pipeline_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::depth_pipeline>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_depth_normalize_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::depth_normalize>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_depth_quality_metrics_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::depth_quality_metrics>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_undistort_filter_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::undistort_filter>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_depth_fusion_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::depth_fusion>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_scene_change_gate_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::scene_change_gate>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_sparse_depth_transform_block(unsigned char transform_to_sparse, rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::sparse_depth_transform>(transform_to_sparse > 0);
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, transform_to_sparse)
+
+rs2_processing_block* rs2_create_processing_graph(int max_in_flight, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_RANGE(max_in_flight, 1, 32);
+
+    auto block = std::make_shared<librealsense::processing_graph>(max_in_flight);
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, max_in_flight)
+
+int rs2_processing_graph_add_block(rs2_processing_block* graph, rs2_processing_block* block, int parent, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+    VALIDATE_NOT_NULL(block);
+    auto g = VALIDATE_INTERFACE(graph->block.get(), librealsense::processing_graph);
+
+    return g->add_node(block->block, parent);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(-1, graph, block, parent)
+
+int rs2_processing_graph_add_load_step(rs2_processing_block* graph, int block, rs2_option option, float value, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+    VALIDATE_ENUM(option);
+    auto g = VALIDATE_INTERFACE(graph->block.get(), librealsense::processing_graph);
+
+    return g->add_load_step(block, option, value);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(-1, graph, block, option, value)
+
+int rs2_processing_graph_add_bypass_step(rs2_processing_block* graph, int block, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+    auto g = VALIDATE_INTERFACE(graph->block.get(), librealsense::processing_graph);
+
+    return g->add_bypass_step(block);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(-1, graph, block)
+
+void rs2_processing_graph_set_notifications_callback(rs2_processing_block* graph, rs2_notification_callback_ptr on_notification, void* user, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+    VALIDATE_NOT_NULL(on_notification);
+    auto g = VALIDATE_INTERFACE(graph->block.get(), librealsense::processing_graph);
+    rs2_notifications_callback_sptr callback(
+        new notifications_callback(on_notification, user),
+        [](rs2_notifications_callback* p) { delete p; });
+    g->set_notifications_callback(std::move(callback));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, graph, on_notification, user)
+
+void rs2_processing_graph_set_notifications_callback_cpp(rs2_processing_block* graph, rs2_notifications_callback* callback, rs2_error** error) BEGIN_API_CALL
+{
+    // Take ownership of the callback ASAP or else memory leaks could result if we throw! (the caller usually does a
+    // 'new' when calling us)
+    VALIDATE_NOT_NULL( callback );
+    rs2_notifications_callback_sptr callback_ptr{ callback,
+                                                  []( rs2_notifications_callback * p )
+                                                  {
+                                                      p->release();
+                                                  } };
+
+    VALIDATE_NOT_NULL(graph);
+    auto g = VALIDATE_INTERFACE(graph->block.get(), librealsense::processing_graph);
+    g->set_notifications_callback( callback_ptr );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, graph, callback)
+
 float rs2_get_depth_scale(rs2_sensor* sensor, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -2788,6 +3310,41 @@ float rs2_get_max_usable_depth_range(rs2_sensor const * sensor, rs2_error** erro
 
 HANDLE_EXCEPTIONS_AND_RETURN(0.f, sensor)
 
+static std::shared_ptr< motion_history > get_motion_history( const rs2_sensor * sensor )
+{
+    auto motion = VALIDATE_INTERFACE( sensor->sensor, librealsense::motion_sensor );
+    auto history = motion->get_motion_history();
+    if( ! history )
+        throw not_implemented_exception( "sensor does not keep a motion history" );
+    return history;
+}
+
+int rs2_get_motion_at(const rs2_sensor* sensor, rs2_stream stream, double timestamp, rs2_motion_sample* sample, rs2_motion_sample* before, rs2_motion_sample* after, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_NOT_NULL(sample);
+    rs2_motion_sample s, b, a;
+    if( ! get_motion_history( sensor )->get_at( stream, timestamp, s, b, a ) )
+        return 0;
+    *sample = s;
+    if( before )
+        *before = b;
+    if( after )
+        *after = a;
+    return 1;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, sensor, stream, timestamp, sample, before, after)
+
+int rs2_get_motion_in_range(const rs2_sensor* sensor, rs2_stream stream, double from, double to, rs2_motion_sample* samples, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_GT(count, -1);
+    if (count)
+        VALIDATE_NOT_NULL(samples);
+    return static_cast<int>(get_motion_history( sensor )->get_range( stream, from, to, samples, size_t( count ) ));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, sensor, stream, from, to, samples, count)
+
 float rs2_get_stereo_baseline(rs2_sensor* sensor, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -2868,7 +3425,7 @@ void rs2_extract_target_dimensions(const rs2_frame* frame_ref, rs2_calib_target_
     auto vf = VALIDATE_INTERFACE(((frame_interface*)frame_ref), librealsense::video_frame);
     int width = vf->get_width();
     int height = vf->get_height();
-    auto fmt = vf->get_stream()->get_format();
+    auto fmt = vf->peek_stream()->get_format();
 
     std::shared_ptr<target_calculator_interface> target_calculator;
     if (calib_type == RS2_CALIB_TARGET_RECT_GAUSSIAN_DOT_VERTICES)
@@ -2975,6 +3532,25 @@ void rs2_software_sensor_on_video_frame(rs2_sensor* sensor, rs2_software_video_f
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, sensor, frame.pixels)
 
+rs2_frame* rs2_software_sensor_allocate_video_frame(rs2_sensor* sensor, rs2_software_video_frame frame, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_NOT_NULL(frame.profile);
+    auto bs = VALIDATE_INTERFACE(sensor->sensor, librealsense::software_sensor);
+    return (rs2_frame*)bs->allocate_video_frame(frame);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, sensor, frame.profile)
+
+void rs2_software_sensor_submit_frame(rs2_sensor* sensor, rs2_frame* frame, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    librealsense::frame_holder holder((librealsense::frame_interface*)frame);
+    VALIDATE_NOT_NULL(sensor);
+    auto bs = VALIDATE_INTERFACE(sensor->sensor, librealsense::software_sensor);
+    bs->submit_frame(std::move(holder));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, frame)
+
 void rs2_software_sensor_on_motion_frame(rs2_sensor* sensor, rs2_software_motion_frame frame, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -3415,6 +3991,27 @@ void rs2_update_firmware(const rs2_device* device, const void* fw_image, int fw_
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, device, fw_image)
 
+void rs2_update_firmware_devices(const rs2_device* const* devices, int count, const void* fw_image, int fw_image_size, rs2_update_progress_callback_ptr callback, void* const* client_data, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(devices);
+    VALIDATE_GT(count, 0);
+    VALIDATE_NOT_NULL(fw_image);
+
+    std::vector< std::shared_ptr< librealsense::device_interface > > devs;
+    std::vector< rs2_update_progress_callback_sptr > callbacks;
+    for( int i = 0; i < count; ++i )
+    {
+        VALIDATE_NOT_NULL(devices[i]);
+        VALIDATE_NOT_NULL(devices[i]->device);
+        devs.push_back( devices[i]->device );
+        if( callback )
+            callbacks.emplace_back( new update_progress_callback( callback, client_data ? client_data[i] : nullptr ),
+                                    []( update_progress_callback * p ) { delete p; } );
+    }
+    librealsense::update_devices( devs, fw_image, fw_image_size, callbacks );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, devices, count, fw_image)
+
 const rs2_raw_data_buffer* rs2_create_flash_backup_cpp(const rs2_device* device, rs2_update_progress_callback* callback, rs2_error** error) BEGIN_API_CALL
 {
     // Take ownership of the callback ASAP or else memory leaks could result if we throw! (the caller usually does a
@@ -3699,6 +4296,24 @@ void rs2_load_json(rs2_device* dev, const void* json_content, unsigned content_s
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, dev, json_content, content_size)
 
+rs2_raw_data_buffer* rs2_serialize_snapshot(rs2_device* dev, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(dev);
+    auto serializable = VALIDATE_INTERFACE(dev->device, librealsense::serializable_interface);
+    return new rs2_raw_data_buffer{ serializable->serialize_snapshot() };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, dev)
+
+void rs2_load_snapshot(rs2_device* dev, const void* snapshot, unsigned snapshot_size, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(dev);
+    VALIDATE_NOT_NULL(snapshot);
+    auto serializable = VALIDATE_INTERFACE(dev->device, librealsense::serializable_interface);
+    auto bytes = static_cast<const uint8_t*>(snapshot);
+    serializable->load_snapshot(std::vector<uint8_t>(bytes, bytes + snapshot_size));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, dev, snapshot, snapshot_size)
+
 rs2_firmware_log_message* rs2_create_fw_log_message(rs2_device* dev, rs2_error** error)BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(dev);
@@ -4088,39 +4703,6 @@ void rs2_fov(const struct rs2_intrinsics* intrin, float to_fov[2]) BEGIN_API_CAL
 }
 NOEXCEPT_RETURN(, to_fov)
 
-/* Helper inner function (not part of the API) */
-void next_pixel_in_line(float curr[2], const float start[2], const float end[2])
-{
-    float line_slope = (end[1] - start[1]) / (end[0] - start[0]);
-    if (fabs(end[0] - curr[0]) > fabs(end[1] - curr[1]))
-    {
-        curr[0] = end[0] > curr[0] ? curr[0] + 1 : curr[0] - 1;
-        curr[1] = end[1] - line_slope * (end[0] - curr[0]);
-    }
-    else
-    {
-        curr[1] = end[1] > curr[1] ? curr[1] + 1 : curr[1] - 1;
-        curr[0] = end[0] - ((end[1] - curr[1]) / line_slope);
-    }
-}
-
-/* Helper inner function (not part of the API) */
-bool is_pixel_in_line(const float curr[2], const float start[2], const float end[2])
-{
-    return ((end[0] >= start[0] && end[0] >= curr[0] && curr[0] >= start[0]) || (end[0] <= start[0] && end[0] <= curr[0] && curr[0] <= start[0])) &&
-        ((end[1] >= start[1] && end[1] >= curr[1] && curr[1] >= start[1]) || (end[1] <= start[1] && end[1] <= curr[1] && curr[1] <= start[1]));
-}
-
-/* Helper inner function (not part of the API) */
-void adjust_2D_point_to_boundary(float p[2], int width, int height)
-{
-    if (p[0] < 0) p[0] = 0;
-    if (p[0] > width) p[0] = (float)width;
-    if (p[1] < 0) p[1] = 0;
-    if (p[1] > height) p[1] = (float)height;
-}
-
-
 void rs2_project_color_pixel_to_depth_pixel(float to_pixel[2],
     const uint16_t* data, float depth_scale,
     float depth_min, float depth_max,
@@ -4168,6 +4750,56 @@ void rs2_project_color_pixel_to_depth_pixel(float to_pixel[2],
 }
 NOEXCEPT_RETURN(, to_pixel)
 
+void rs2_project_points_to_pixels(float* pixels, const struct rs2_intrinsics* intrin, const float* points, int count) BEGIN_API_CALL
+{
+    project_points_to_pixels(pixels, *intrin, points, count);
+}
+NOEXCEPT_RETURN(, pixels)
+
+void rs2_deproject_pixels_to_points(float* points, const struct rs2_intrinsics* intrin, const float* pixels, const float* depths, int count) BEGIN_API_CALL
+{
+    deproject_pixels_to_points(points, *intrin, pixels, depths, count);
+}
+NOEXCEPT_RETURN(, points)
+
+struct rs2_color_to_depth_cache
+{
+    color_to_depth_map map;
+};
+
+rs2_color_to_depth_cache* rs2_create_color_to_depth_cache(rs2_error** error) BEGIN_API_CALL
+{
+    return new rs2_color_to_depth_cache();
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+void rs2_delete_color_to_depth_cache(rs2_color_to_depth_cache* cache) BEGIN_API_CALL
+{
+    delete cache;
+}
+NOEXCEPT_RETURN(, cache)
+
+void rs2_project_color_pixels_to_depth_pixels(float* to_pixels,
+    rs2_color_to_depth_cache* cache,
+    const uint16_t* data, float depth_scale,
+    float depth_min, float depth_max,
+    const struct rs2_intrinsics* depth_intrin,
+    const struct rs2_intrinsics* color_intrin,
+    const struct rs2_extrinsics* color_to_depth,
+    const struct rs2_extrinsics* depth_to_color,
+    const float* from_pixels, int count) BEGIN_API_CALL
+{
+    if (cache)
+        cache->map.map(to_pixels, data, depth_scale, depth_min, depth_max, *depth_intrin, *color_intrin,
+                       *color_to_depth, *depth_to_color, from_pixels, count);
+    else
+        for (int i = 0; i < count; ++i)
+            rs2_project_color_pixel_to_depth_pixel(to_pixels + 2 * i, data, depth_scale, depth_min, depth_max,
+                                                   depth_intrin, color_intrin, color_to_depth, depth_to_color,
+                                                   from_pixels + 2 * i);
+}
+NOEXCEPT_RETURN(, to_pixels)
+
 const rs2_raw_data_buffer* rs2_run_focal_length_calibration_cpp(rs2_device* device, rs2_frame_queue* left, rs2_frame_queue* right, float target_w, float target_h, 
     int adjust_both_sides, float* ratio, float* angle, rs2_update_progress_callback * progress_callback, rs2_error** error) BEGIN_API_CALL
 {
@@ -4,7 +4,14 @@
 #include "rscore-pp-block-factory.h"
 
 #include "proc/decimation-filter.h"
+#include "proc/depth-pipeline.h"
+#include "proc/depth-normalize.h"
+#include "proc/depth-quality-metrics.h"
+#include "proc/undistort-filter.h"
+#include "proc/depth-fusion.h"
+#include "proc/scene-change-gate.h"
 #include "proc/disparity-transform.h"
+#include "proc/sparse-depth-transform.h"
 #include "proc/hdr-merge.h"
 #include "proc/hole-filling-filter.h"
 #include "proc/sequence-id-filter.h"
@@ -26,7 +33,7 @@ rscore_pp_block_factory::create_pp_block( std::string const & name, rsutils::jso
     (void *)&settings;
 
     if( rsutils::string::nocase_equal( name, "Decimation Filter" ) )
-        return std::make_shared< decimation_filter >();
+        return decimation_filter::create();
     if( rsutils::string::nocase_equal( name, "HDR Merge" ) )  // and Hdr Merge
         return std::make_shared< hdr_merge >();
     if( rsutils::string::nocase_equal( name, "Filter By Sequence id" )    // name
@@ -36,15 +43,32 @@ rscore_pp_block_factory::create_pp_block( std::string const & name, rsutils::jso
         return std::make_shared< threshold >();
     if( rsutils::string::nocase_equal( name, "Depth to Disparity" )     // name
         || rsutils::string::nocase_equal( name, "Disparity Filter" ) )  // extension
-        return std::make_shared< disparity_transform >( true );
+        return disparity_transform::create( true );
     if( rsutils::string::nocase_equal( name, "Disparity to Depth" ) )
-        return std::make_shared< disparity_transform >( false );
+        return disparity_transform::create( false );
     if( rsutils::string::nocase_equal( name, "Spatial Filter" ) )
-        return std::make_shared< spatial_filter >();
+        return spatial_filter::create();
     if( rsutils::string::nocase_equal( name, "Temporal Filter" ) )
-        return std::make_shared< temporal_filter >();
+        return temporal_filter::create();
     if( rsutils::string::nocase_equal( name, "Hole Filling Filter" ) )
-        return std::make_shared< hole_filling_filter >();
+        return hole_filling_filter::create();
+    if( rsutils::string::nocase_equal( name, "Depth Pipeline" ) )
+        return std::make_shared< depth_pipeline >();
+    if( rsutils::string::nocase_equal( name, "Depth Normalize" ) )
+        return std::make_shared< depth_normalize >();
+    if( rsutils::string::nocase_equal( name, "Depth Quality Metrics" ) )
+        return std::make_shared< depth_quality_metrics >();
+    if( rsutils::string::nocase_equal( name, "Undistort" ) )
+        return std::make_shared< undistort_filter >();
+    if( rsutils::string::nocase_equal( name, "Depth Fusion" ) )
+        return std::make_shared< depth_fusion >();
+    if( rsutils::string::nocase_equal( name, "Scene Change Gate" ) )
+        return std::make_shared< scene_change_gate >();
+    if( rsutils::string::nocase_equal( name, "Depth to Sparse Depth" )             // name
+        || rsutils::string::nocase_equal( name, "Sparse Depth Transform" ) )      // extension
+        return std::make_shared< sparse_depth_transform >( true );
+    if( rsutils::string::nocase_equal( name, "Sparse Depth to Depth" ) )
+        return std::make_shared< sparse_depth_transform >( false );
 
     return {};
 }
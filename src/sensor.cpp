@@ -8,6 +8,7 @@
 #include "stream.h"
 #include "proc/synthetic-stream.h"
 #include "proc/decimation-filter.h"
+#include "proc/processing-thread-pool.h"
 #include "global_timestamp_reader.h"
 #include "device-calibration.h"
 #include "core/notification.h"
@@ -71,7 +72,12 @@ void log_callback_end( uint32_t fps,
               return profiles;
           } )
     {
+        _source.enable_telemetry();
+        _source.set_subsystem( name );
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
+        register_option(RS2_OPTION_FRAME_POOL_HITS, _source.get_pool_hits_option());
+        register_option(RS2_OPTION_FRAME_POOL_MISSES, _source.get_pool_misses_option());
+        register_option(RS2_OPTION_MEMORY_USAGE, _source.get_memory_usage_option());
 
         register_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL, std::make_shared<librealsense::md_time_of_arrival_parser>());
 
@@ -252,7 +258,7 @@ void log_callback_end( uint32_t fps,
     {
         processing_blocks res;
 
-        auto dec = std::make_shared<decimation_filter>();
+        auto dec = decimation_filter::create();
         if (dec->supports_option(RS2_OPTION_STREAM_FILTER))
         {
             dec->get_option(RS2_OPTION_STREAM_FILTER).set(RS2_STREAM_DEPTH);
@@ -416,6 +422,34 @@ void log_callback_end( uint32_t fps,
 
         auto& raw_fourcc_to_rs2_stream_map = _raw_sensor->get_fourcc_to_rs2_stream_map();
         raw_fourcc_to_rs2_stream_map = std::make_shared<std::map<uint32_t, rs2_stream>>(fourcc_to_rs2_stream_map);
+
+        // Frame buffers are allocated by the raw sensor; report its pool rather than our own
+        sensor_base::register_option( RS2_OPTION_FRAME_POOL_HITS, _raw_sensor->get_option_handler( RS2_OPTION_FRAME_POOL_HITS ) );
+        sensor_base::register_option( RS2_OPTION_FRAME_POOL_MISSES, _raw_sensor->get_option_handler( RS2_OPTION_FRAME_POOL_MISSES ) );
+        sensor_base::register_option( RS2_OPTION_MEMORY_USAGE, _raw_sensor->get_option_handler( RS2_OPTION_MEMORY_USAGE ) );
+
+        // Shared by all the converters of this sensor, and read as each frame is converted
+        auto conversion_threads = std::make_shared< ptr_option< int > >(
+            1,
+            processing_thread_pool::max_threads(),
+            1,
+            1,
+            &_conversion_threads,
+            "Threads each frame's format conversion may be split across, on the processing thread pool" );
+        conversion_threads->on_set( [this]( float value ) { _formats_converter.set_thread_budget( int( value ) ); } );
+        sensor_base::register_option( RS2_OPTION_CONVERSION_THREADS, conversion_threads );
+
+        // Off by default: the raw frames are held until the conversions run, which a user holding frames without
+        // looking at them can run the raw sensor out of
+        auto lazy_conversion = std::make_shared< ptr_option< bool > >(
+            false,
+            true,
+            true,
+            false,
+            &_lazy_conversion,
+            "Convert interleaved formats only when the data of a frame is first asked for" );
+        lazy_conversion->on_set( [this]( float value ) { _formats_converter.set_lazy_conversion( value != 0 ); } );
+        sensor_base::register_option( RS2_OPTION_LAZY_CONVERSION, lazy_conversion );
     }
 
     synthetic_sensor::~synthetic_sensor()
@@ -594,7 +628,10 @@ void log_callback_end( uint32_t fps,
         const auto & resolved_req = _formats_converter.get_active_source_profiles();
         std::vector< std::shared_ptr< processing_block > > active_pbs = _formats_converter.get_active_converters();
         for( auto & pb : active_pbs )
+        {
             register_processing_block_options( *pb );
+            pb->set_frame_allocator( _frame_allocator );
+        }
 
         _raw_sensor->set_source_owner(this);
         try
@@ -718,6 +755,16 @@ void log_callback_end( uint32_t fps,
         return _raw_sensor->is_opened();
     }
 
+    // Both the raw frames and the converted ones we output should come from the user's allocator
+    void synthetic_sensor::set_frame_allocator( std::shared_ptr< frame_allocator > const & allocator )
+    {
+        std::lock_guard< std::mutex > lock( _synthetic_configure_lock );
+        _frame_allocator = allocator;
+        _raw_sensor->set_frame_allocator( allocator );
+        for( auto & pb : _formats_converter.get_active_converters() )
+            pb->set_frame_allocator( allocator );
+    }
+
     format_conversion sensor_base::get_format_conversion() const
     {
         return _owner->get_format_conversion();
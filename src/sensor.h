@@ -79,8 +79,23 @@ namespace librealsense
             _on_open = callback;
         }
         virtual void set_frame_metadata_modifier(on_frame_md callback) { _metadata_modifier = callback; }
+        // Frame data will be taken from 'allocator' rather than the heap; null restores the default
+        virtual void set_frame_allocator( std::shared_ptr< frame_allocator > const & allocator ) { _source.set_frame_allocator( allocator ); }
         device_interface& get_device() override;
 
+        std::vector< rs2_stream_telemetry > get_stream_telemetry() const override { return _source.get_telemetry(); }
+        bool set_metadata_sink( std::shared_ptr< metadata_sink > sink ) override
+        {
+            _source.set_metadata_sink( std::move( sink ) );
+            return true;
+        }
+        bool flush_metadata_sink() override
+        {
+            if( auto sink = _source.get_metadata_sink() )
+                sink->flush();
+            return true;
+        }
+
         // Make sensor inherit its owning device info by default
         const std::string& get_info(rs2_camera_info info) const override;
         bool supports_info(rs2_camera_info info) const override;
@@ -153,11 +168,15 @@ namespace librealsense
     };
 
     class processing_block;
+    class motion_history;
 
     class motion_sensor
     {
     public:
         virtual ~motion_sensor() = default;
+
+        // The samples it delivered lately, if it keeps them (see rs2_get_motion_at)
+        virtual std::shared_ptr< motion_history > get_motion_history() const { return nullptr; }
     };
 
     MAP_EXTENSION(RS2_EXTENSION_MOTION_SENSOR, librealsense::motion_sensor);
@@ -249,6 +268,11 @@ namespace librealsense
         void register_metadata(rs2_frame_metadata_value metadata, std::shared_ptr<md_attribute_parser_base> metadata_parser) const override;
         bool is_streaming() const override;
         bool is_opened() const override;
+        void set_frame_allocator( std::shared_ptr< frame_allocator > const & allocator ) override;
+        // The frames come from the raw sensor
+        std::vector< rs2_stream_telemetry > get_stream_telemetry() const override { return _raw_sensor->get_stream_telemetry(); }
+        bool set_metadata_sink( std::shared_ptr< metadata_sink > sink ) override { return _raw_sensor->set_metadata_sink( std::move( sink ) ); }
+        bool flush_metadata_sink() override { return _raw_sensor->flush_metadata_sink(); }
 
         rsutils::subscription register_options_changed_callback( options_watcher::callback && cb ) override;
         virtual void register_option_to_update( rs2_option id, std::shared_ptr< option > option );
@@ -263,7 +287,10 @@ namespace librealsense
         rs2_frame_callback_sptr _post_process_callback;
         std::shared_ptr<raw_sensor_base> _raw_sensor;
         formats_converter _formats_converter;
+        int _conversion_threads = 1;
+        bool _lazy_conversion = false;
         std::vector<rs2_option> _cached_processing_blocks_options;
+        std::shared_ptr< frame_allocator > _frame_allocator;
 
         synthetic_options_watcher _options_watcher;
     };
@@ -12,6 +12,11 @@ namespace librealsense
     public:
         virtual std::vector<uint8_t> serialize_json() const = 0;
         virtual void load_json(const std::string& json_content) = 0;
+
+        // The same settings as a compact binary snapshot, with the device's options and calibration table; loading
+        // one writes only what differs from the device
+        virtual std::vector<uint8_t> serialize_snapshot() const = 0;
+        virtual void load_snapshot(const std::vector<uint8_t>& snapshot) = 0;
     };
     MAP_EXTENSION(RS2_EXTENSION_SERIALIZABLE, serializable_interface);
 }
@@ -13,7 +13,7 @@ static const int SCHEMA_VERSION = 1;
 
 json_preset_reader::json_preset_reader( const std::string & json_content ) : _parameters(nullptr), _schema_version(0)
 {
-    _root = json::parse( json_content );
+    _root = rsutils::parse_json_or_binary( json_content.data(), json_content.size() );
     if (init_schema())
     {
         _device_info = read_device_info();
@@ -49,7 +49,7 @@ namespace librealsense
             json::const_iterator end() const;
 
             // return only the parameters section
-            json get_params() const { return *_parameters; };
+            json const & get_params() const { return *_parameters; };
                 
         protected:
             device_info read_device_info() const;
@@ -7,49 +7,86 @@
 
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <cstdint>
 
 
 namespace librealsense {
 
 
+// Fixed-capacity object pool.
+//
+// Free slots are kept on a lock-free stack of indices (a Treiber stack, with a generation tag next to the top
+// index to avoid ABA), so allocate() and deallocate() are O(1) and take no lock. The mutex/cv are only used by
+// wait_until_empty(), and only touched by deallocate() when the heap actually becomes empty.
+//
 template < class T, int C >
 class small_heap
 {
+    static const int32_t NIL = -1;
+
     T buffer[C];
-    bool is_free[C];
+    std::atomic< int32_t > next_free[C];    // next index down the free stack, for free slots
+    std::atomic< uint64_t > free_top;       // generation << 32 | top index
+    std::atomic< bool > keep_allocating;
+    std::atomic< int > size;
     std::mutex mutex;
-    bool keep_allocating = true;
     std::condition_variable cv;
-    int size = 0;
+
+    static int32_t index_of( uint64_t top ) { return static_cast< int32_t >( top & 0xFFFFFFFF ); }
+    static uint64_t make_top( uint64_t prev, int32_t index )
+    {
+        return ( ( ( prev >> 32 ) + 1 ) << 32 ) | static_cast< uint32_t >( index );
+    }
+
+    void release_size()
+    {
+        if( size.fetch_sub( 1 ) == 1 )
+        {
+            // Lock so we can't signal between wait_until_empty()'s check and its wait
+            std::lock_guard< std::mutex > lock( mutex );
+            cv.notify_all();
+        }
+    }
 
 public:
     static const int CAPACITY = C;
 
     small_heap()
+        : keep_allocating( true )
+        , size( 0 )
     {
         for( auto i = 0; i < C; i++ )
-        {
-            is_free[i] = true;
-            buffer[i] = std::move( T() );
-        }
+            next_free[i] = i + 1 < C ? i + 1 : NIL;
+        free_top = make_top( 0, 0 );
     }
 
     T * allocate()
     {
-        std::unique_lock< std::mutex > lock( mutex );
+        // Count ourselves in before looking at keep_allocating: either stop_allocation() comes first and we back
+        // off, or wait_until_empty() sees us and waits for our deallocate()
+        size.fetch_add( 1 );
         if( ! keep_allocating )
+        {
+            release_size();
             return nullptr;
+        }
 
-        for( auto i = 0; i < C; i++ )
+        auto top = free_top.load( std::memory_order_acquire );
+        int32_t i;
+        do
         {
-            if( is_free[i] )
+            i = index_of( top );
+            if( i == NIL )
             {
-                is_free[i] = false;
-                size++;
-                return &buffer[i];
+                release_size();
+                return nullptr;
             }
         }
-        return nullptr;
+        while( ! free_top.compare_exchange_weak( top,
+                                                 make_top( top, next_free[i].load( std::memory_order_relaxed ) ),
+                                                 std::memory_order_acquire ) );
+        return &buffer[i];
     }
 
     void deallocate( T * item )
@@ -58,27 +95,24 @@ public:
         {
             throw invalid_value_exception( "Trying to return item to a heap that didn't allocate it!" );
         }
-        auto i = item - buffer;
-        auto old_value = std::move( buffer[i] );
+        auto i = static_cast< int32_t >( item - buffer );
+
+        // Reset the slot before it's visible on the free stack; the release below publishes it to the next
+        // allocate()
         buffer[i] = std::move( T() );
 
+        auto top = free_top.load( std::memory_order_relaxed );
+        do
         {
-            std::unique_lock< std::mutex > lock( mutex );
-
-            is_free[i] = true;
-            size--;
-
-            if( size == 0 )
-            {
-                lock.unlock();
-                cv.notify_one();
-            }
+            next_free[i].store( index_of( top ), std::memory_order_relaxed );
         }
+        while( ! free_top.compare_exchange_weak( top, make_top( top, i ), std::memory_order_release ) );
+
+        release_size();
     }
 
     void stop_allocation()
     {
-        std::unique_lock< std::mutex > lock( mutex );
         keep_allocating = false;
     }
 
@@ -216,13 +216,14 @@ void software_sensor::erase_metadata( rs2_frame_metadata_value key )
 
 frame_interface * software_sensor::allocate_new_frame( rs2_extension extension,
                                                        stream_profile_interface * profile,
-                                                       frame_additional_data && data )
+                                                       frame_additional_data && data,
+                                                       size_t size )
 {
     auto frame_number = data.frame_number; // For logging
     auto frame = _source.alloc_frame( { profile->get_stream_type(), profile->get_stream_index(), extension },
-                                      0,
+                                      size,
                                       std::move( data ),
-                                      false );
+                                      size > 0 );
     if( ! frame )
     {
         LOG_WARNING( "Failed to allocate frame " << frame_number << " type " << profile->get_stream_type() );
@@ -238,12 +239,14 @@ frame_interface * software_sensor::allocate_new_frame( rs2_extension extension,
 frame_interface * software_sensor::allocate_new_video_frame( video_stream_profile_interface * profile,
                                                              int stride,
                                                              int bpp,
-                                                             frame_additional_data && data )
+                                                             frame_additional_data && data,
+                                                             size_t size )
 {
     auto frame = allocate_new_frame( profile->get_stream_type() == RS2_STREAM_DEPTH ? RS2_EXTENSION_DEPTH_FRAME
                                                                                     : RS2_EXTENSION_VIDEO_FRAME,
                                      profile,
-                                     std::move( data ) );
+                                     std::move( data ),
+                                     size );
     if( frame )
     {
         auto vid_frame = dynamic_cast< video_frame * >( frame );
@@ -280,6 +283,18 @@ void software_sensor::on_video_frame( rs2_software_video_frame const & software_
     if( ! _is_streaming )
         return;
 
+    auto frame = allocate_new_video_frame( vid_profile,
+                                           software_frame.stride,
+                                           software_frame.bpp,
+                                           video_frame_data( software_frame, vid_profile ) );
+    if( frame )
+        invoke_new_frame( frame, software_frame.pixels, on_release.detach() );
+}
+
+
+frame_additional_data software_sensor::video_frame_data( rs2_software_video_frame const & software_frame,
+                                                         video_stream_profile_interface * vid_profile )
+{
     frame_additional_data data( _metadata_map );
     data.timestamp = software_frame.timestamp;
     data.timestamp_domain = software_frame.domain;
@@ -294,10 +309,37 @@ void software_sensor::on_video_frame( rs2_software_video_frame const & software_
         data.depth_units = opt->query();
     else
         data.depth_units = 0.f;
+    return data;
+}
 
-    auto frame = allocate_new_video_frame( vid_profile, software_frame.stride, software_frame.bpp, std::move( data ) );
-    if( frame )
-        invoke_new_frame( frame, software_frame.pixels, on_release.detach() );
+
+frame_interface * software_sensor::allocate_video_frame( rs2_software_video_frame const & software_frame )
+{
+    auto vid_profile = dynamic_cast< video_stream_profile_interface * >( software_frame.profile->profile );
+    if( ! vid_profile )
+        throw invalid_value_exception( "Non-video profile provided to allocate_video_frame" );
+    if( software_frame.stride < vid_profile->get_width() * software_frame.bpp )
+        throw invalid_value_exception( "Stride is less than a row of pixels" );
+
+    if( ! _is_streaming )
+        return nullptr;
+
+    // The data is kept with the frame when it's released to the pool, for the next one of the stream
+    return allocate_new_video_frame( vid_profile,
+                                     software_frame.stride,
+                                     software_frame.bpp,
+                                     video_frame_data( software_frame, vid_profile ),
+                                     size_t( software_frame.stride ) * vid_profile->get_height() );
+}
+
+
+void software_sensor::submit_frame( frame_holder && frame )
+{
+    if( frame->get_sensor().get() != this )
+        throw invalid_value_exception( "Frame was not allocated by this sensor" );
+    if( ! _is_streaming )
+        return;
+    _source.invoke_callback( std::move( frame ) );
 }
 
 
@@ -44,6 +44,10 @@ public:
     void stop() override;
 
     void on_video_frame( rs2_software_video_frame const & );
+    // A frame of the sensor's pool for the pixels to be written to, then submitted; the pixels and deleter aren't used.
+    // Null when not streaming.
+    frame_interface * allocate_video_frame( rs2_software_video_frame const & );
+    void submit_frame( frame_holder && );
     void on_motion_frame( rs2_software_motion_frame const & );
     void on_pose_frame( rs2_software_pose_frame const & );
     void on_notification( rs2_software_notification const & );
@@ -54,9 +58,13 @@ public:
     void erase_metadata( rs2_frame_metadata_value key );
 
 protected:
-    frame_interface * allocate_new_frame( rs2_extension, stream_profile_interface *, frame_additional_data && );
-    frame_interface * allocate_new_video_frame( video_stream_profile_interface *, int stride, int bpp, frame_additional_data && );
+    // With a size, the frame gets that much data to fill in, from the frame pool or allocator
+    frame_interface * allocate_new_frame( rs2_extension, stream_profile_interface *, frame_additional_data &&,
+                                          size_t size = 0 );
+    frame_interface * allocate_new_video_frame( video_stream_profile_interface *, int stride, int bpp,
+                                                frame_additional_data &&, size_t size = 0 );
     void invoke_new_frame( frame_holder &&, void const * pixels, std::function< void() > on_release );
+    frame_additional_data video_frame_data( rs2_software_video_frame const &, video_stream_profile_interface * );
 
     metadata_array _metadata_map;
 
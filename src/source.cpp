@@ -5,11 +5,17 @@
 
 #include <src/option.h>
 #include <src/core/frame-holder.h>
+#include <src/core/time-service.h>
+#include <src/composite-frame.h>
 #include <src/core/enum-helpers.h>
+#include <src/frame-trace.h>
+#include <src/memory-stats.h>
 
 #include <rsutils/string/from.h>
 #include <src/core/stream-profile-interface.h>
 
+#include <limits>
+
 namespace librealsense
 {
     class frame_queue_size : public option_base
@@ -42,14 +48,80 @@ namespace librealsense
         std::atomic<uint32_t>* _ptr;
     };
 
+    class frame_pool_counter : public readonly_option
+    {
+    public:
+        frame_pool_counter( std::shared_ptr< frame_pool_stats > const & stats,
+                            std::atomic< uint64_t > frame_pool_stats::*counter,
+                            const char * description )
+            : _stats( stats )
+            , _counter( counter )
+            , _description( description )
+        {}
+
+        float query() const override { return static_cast< float >( ( ( *_stats ).*_counter ).load() ); }
+        option_range get_range() const override { return { 0, std::numeric_limits< float >::max(), 1, 0 }; }
+        bool is_enabled() const override { return true; }
+        const char * get_description() const override { return _description; }
+
+    private:
+        std::shared_ptr< frame_pool_stats > _stats;
+        std::atomic< uint64_t > frame_pool_stats::*_counter;
+        const char * _description;
+    };
+
     std::shared_ptr<option> frame_source::get_published_size_option()
     {
         return std::make_shared<frame_queue_size>(&_max_publish_list_size, option_range{ 0, 32, 1, 16 });
     }
 
+    std::shared_ptr< option > frame_source::get_pool_hits_option()
+    {
+        return std::make_shared< frame_pool_counter >( _pool_stats,
+                                                       &frame_pool_stats::hits,
+                                                       "Number of frame buffers reused from the frame pool" );
+    }
+
+    std::shared_ptr< option > frame_source::get_pool_misses_option()
+    {
+        return std::make_shared< frame_pool_counter >( _pool_stats,
+                                                       &frame_pool_stats::misses,
+                                                       "Number of frame buffers that had to be newly allocated" );
+    }
+
+    class frame_memory_usage : public readonly_option
+    {
+    public:
+        frame_memory_usage( std::shared_ptr< frame_pool_stats > const & stats )
+            : _stats( stats )
+        {}
+
+        float query() const override { return static_cast< float >( _stats->memory_usage() / 1024 ); }
+        option_range get_range() const override { return { 0, std::numeric_limits< float >::max(), 1, 0 }; }
+        bool is_enabled() const override { return true; }
+        const char * get_description() const override
+        {
+            return "KB of frame memory the sensor holds right now, in frames and pooled for reuse";
+        }
+
+    private:
+        std::shared_ptr< frame_pool_stats > _stats;
+    };
+
+    std::shared_ptr< option > frame_source::get_memory_usage_option()
+    {
+        return std::make_shared< frame_memory_usage >( _pool_stats );
+    }
+
+    void frame_source::set_subsystem( std::string const & name )
+    {
+        _pool_stats->totals = memory_stats::get_totals( name );
+    }
+
     frame_source::frame_source( uint32_t max_publish_list_size )
         : _callback( nullptr, []( rs2_frame_callback * ) {} )
         , _max_publish_list_size( max_publish_list_size )
+        , _pool_stats( std::make_shared< frame_pool_stats >() )
     {}
 
     void frame_source::init(std::shared_ptr<metadata_parser_map> metadata_parsers)
@@ -65,6 +137,60 @@ namespace librealsense
                                   RS2_EXTENSION_POSE_FRAME };
 
         _metadata_parsers = metadata_parsers;
+        if( _telemetry )
+            _telemetry->reset();
+    }
+
+    void frame_source::enable_telemetry()
+    {
+        if( ! _telemetry )
+            _telemetry = std::make_shared< stream_telemetry >();
+    }
+
+    std::vector< rs2_stream_telemetry > frame_source::get_telemetry() const
+    {
+        if( ! _telemetry )
+            return {};
+        auto streams = _telemetry->get();
+
+        std::lock_guard< std::recursive_mutex > lock( _mutex );
+        for( auto & s : streams )
+            for( auto & a : _archive )
+                if( std::get< rs2_stream >( a.first ) == s.stream && std::get< int >( a.first ) == s.index )
+                    s.queue_depth += a.second->get_published_count();
+        return streams;
+    }
+
+    void frame_source::set_metadata_sink( std::shared_ptr< metadata_sink > sink )
+    {
+        std::shared_ptr< metadata_sink > previous;
+        {
+            std::lock_guard< std::recursive_mutex > lock( _mutex );
+            previous = std::move( _metadata_sink );
+            _metadata_sink = std::move( sink );
+        }
+        if( previous )
+            previous->flush();
+    }
+
+    std::shared_ptr< metadata_sink > frame_source::get_metadata_sink() const
+    {
+        std::lock_guard< std::recursive_mutex > lock( _mutex );
+        return _metadata_sink;
+    }
+
+    static bool supports_frame_allocator( rs2_extension ex )
+    {
+        switch( ex )
+        {
+        case RS2_EXTENSION_VIDEO_FRAME:
+        case RS2_EXTENSION_DEPTH_FRAME:
+        case RS2_EXTENSION_DISPARITY_FRAME:
+            return true;
+        default:
+            // Composite, motion, pose and points frames access their 'data' directly
+            return false;
+        }
     }
 
     std::map< frame_source::archive_id, std::shared_ptr< archive_interface > >::iterator
@@ -77,11 +203,13 @@ namespace librealsense
         if( it == _supported_extensions.end() )
             throw wrong_api_call_sequence_exception( "Requested frame type is not supported!" );
 
-        auto ret = _archive.insert( { id, make_archive( ex, &_max_publish_list_size, _metadata_parsers ) } );
+        auto ret = _archive.insert( { id, make_archive( ex, &_max_publish_list_size, _metadata_parsers, _pool_stats ) } );
         if( ! ret.second || ! ret.first->second ) // Check insertion success and allocation success
             throw std::runtime_error( rsutils::string::from() << "Failed to create archive of type " << get_string( ex ) );
 
         ret.first->second->set_sensor( _sensor );
+        if( supports_frame_allocator( ex ) )
+            ret.first->second->set_frame_allocator( _allocator );
 
         return ret.first;
     }
@@ -125,7 +253,16 @@ namespace librealsense
         if( it == _archive.end() )
             it = create_archive( id );
 
-        return it->second->alloc_and_track( size, std::move( additional_data ), requires_memory );
+        auto frame = it->second->alloc_and_track( size, std::move( additional_data ), requires_memory );
+        if( frame && frame_trace::is_enabled() && std::get< rs2_extension >( id ) != RS2_EXTENSION_COMPOSITE_FRAME )
+            if( auto f = dynamic_cast< librealsense::frame * >( frame ) )
+                frame_trace::begin( *f, std::get< rs2_stream >( id ), std::get< int >( id ) );
+        if( _telemetry && std::get< rs2_stream >( id ) != RS2_STREAM_COUNT )
+            _telemetry->on_received( std::get< rs2_stream >( id ),
+                                     std::get< int >( id ),
+                                     ! frame,
+                                     it->second->get_published_count() );
+        return frame;
     }
 
     void frame_source::set_sensor( const std::weak_ptr< sensor_interface > & s )
@@ -140,6 +277,18 @@ namespace librealsense
         }
     }
 
+    void frame_source::set_frame_allocator( std::shared_ptr< frame_allocator > const & allocator )
+    {
+        std::lock_guard< std::recursive_mutex > lock( _mutex );
+
+        _allocator = allocator;
+        for( auto & a : _archive )
+        {
+            if( supports_frame_allocator( std::get< rs2_extension >( a.first ) ) )
+                a.second->set_frame_allocator( _allocator );
+        }
+    }
+
     void frame_source::set_callback( rs2_frame_callback_sptr callback )
     {
         std::lock_guard< std::recursive_mutex > lock( _mutex );
@@ -160,6 +309,33 @@ namespace librealsense
             {
                 if (_callback)
                 {
+                    // For RS2_FRAME_METADATA_DELIVERY_LATENCY
+                    auto now = time_service::get_time();
+                    if (auto f = dynamic_cast< librealsense::frame * >(frame.frame))
+                        f->additional_data.delivery_time = now;
+                    if (auto composite = dynamic_cast< composite_frame * >(frame.frame))
+                        for (size_t i = 0; i < composite->get_embedded_frames_count(); ++i)
+                            if (auto f = dynamic_cast< librealsense::frame * >(composite->get_frame(int(i))))
+                                f->additional_data.delivery_time = now;
+
+                    if (_telemetry)
+                        if (auto f = dynamic_cast< librealsense::frame * >(frame.frame))
+                            if (auto profile = f->get_stream())
+                            {
+                                // From when the backend got it, or when it got to us if the backend doesn't say
+                                auto & header = f->additional_data;
+                                auto arrival = header.backend_timestamp ? header.backend_timestamp : header.system_time;
+                                _telemetry->on_delivered(profile->get_stream_type(),
+                                                         profile->get_stream_index(),
+                                                         header.frame_number,
+                                                         arrival ? now - arrival : 0);
+                            }
+
+                    if (auto sink = get_metadata_sink())
+                        if (auto f = dynamic_cast< librealsense::frame * >(frame.frame))
+                            sink->append(*f);
+
+                    frame_trace::scope trace(frame.frame, "callback");
                     frame_interface* ref = nullptr;
                     std::swap(frame.frame, ref);
                     _callback->on_frame((rs2_frame*)ref);
@@ -6,6 +6,8 @@
 
 #include <librealsense2/hpp/rs_types.hpp>
 #include <src/frame-archive.h>
+#include <src/stream-telemetry.h>
+#include <src/metadata-sink.h>
 
 #include <tuple>
 
@@ -30,11 +32,39 @@ namespace librealsense
 
         std::shared_ptr< option > get_published_size_option();
 
+        // Read-only counters of frame-buffer allocations served from (hits) or missing (misses) the archives' pools
+        std::shared_ptr< option > get_pool_hits_option();
+        std::shared_ptr< option > get_pool_misses_option();
+
+        // Read-only: the frame memory held right now, in KB (see get_memory_usage)
+        std::shared_ptr< option > get_memory_usage_option();
+
+        // The bytes held in the frames the archives published, and in their pools
+        uint64_t get_memory_usage() const { return _pool_stats->memory_usage(); }
+
+        // What get_memory_usage() should stay within, or 0 for no limit: the pools hold on to less, for less long.
+        // The frames themselves aren't held back: it's up to the owner to size the queue, and to warn when over
+        void set_memory_budget( uint64_t bytes ) { _pool_stats->budget = bytes; }
+        uint64_t get_memory_budget() const { return _pool_stats->budget; }
+
+        // What the archives allocate also counts towards the named subsystem's totals (see memory_stats); before
+        // any frame is allocated
+        void set_subsystem( std::string const & name );
+
         frame_interface * alloc_frame( archive_id id,
                                        size_t size,
                                        frame_additional_data && additional_data,
                                        bool requires_memory );
 
+        // Count what goes through alloc_frame() and invoke_callback(), per stream; reset by init()
+        void enable_telemetry();
+        std::shared_ptr< stream_telemetry > const & telemetry() const { return _telemetry; }
+        std::vector< rs2_stream_telemetry > get_telemetry() const;
+
+        // Appends the metadata of every frame invoke_callback() hands on; null for none, after flushing the last one
+        void set_metadata_sink( std::shared_ptr< metadata_sink > sink );
+        std::shared_ptr< metadata_sink > get_metadata_sink() const;
+
         void set_callback( rs2_frame_callback_sptr callback );
         rs2_frame_callback_sptr get_callback() const;
 
@@ -46,6 +76,9 @@ namespace librealsense
 
         void set_sensor( const std::weak_ptr< sensor_interface > & s );
 
+        // Applies to video, depth and disparity archives, whose frame data is plain pixels
+        void set_frame_allocator( std::shared_ptr< frame_allocator > const & allocator );
+
         template<class T>
         void add_extension( rs2_extension ex )
         {
@@ -60,10 +93,13 @@ namespace librealsense
             // We use a special index for extensions since we don't know the stream type here.
             // We can't wait with the allocation because we need the type T in the creation.
             archive_id special_index = { RS2_STREAM_COUNT, 0, ex };
-            _archive[special_index] = std::make_shared< frame_archive< T > >( &_max_publish_list_size, _metadata_parsers );
+            _archive[special_index] = std::make_shared< frame_archive< T > >( &_max_publish_list_size,
+                                                                          _metadata_parsers,
+                                                                          _pool_stats );
         }
 
         void set_max_publish_list_size( int qsize ) { _max_publish_list_size = qsize; }
+        uint32_t get_max_publish_list_size() const { return _max_publish_list_size; }
 
         static rs2_extension stream_to_frame_types( rs2_stream stream );
 
@@ -78,8 +114,12 @@ namespace librealsense
         std::vector< rs2_extension > _supported_extensions;
 
         std::atomic< uint32_t > _max_publish_list_size;
+        std::shared_ptr< frame_pool_stats > _pool_stats;
         rs2_frame_callback_sptr _callback;
         std::shared_ptr< metadata_parser_map > _metadata_parsers;
         std::weak_ptr< sensor_interface > _sensor;
+        std::shared_ptr< frame_allocator > _allocator;
+        std::shared_ptr< stream_telemetry > _telemetry;
+        std::shared_ptr< metadata_sink > _metadata_sink;
     };
 }
@@ -0,0 +1,86 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "stream-telemetry.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace librealsense {
+
+
+void stream_telemetry::reset()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    _streams.clear();
+    _backend_errors = 0;
+}
+
+
+stream_telemetry::counters & stream_telemetry::at( rs2_stream stream, int index )
+{
+    auto it = _streams.find( { stream, index } );
+    if( it == _streams.end() )
+    {
+        it = _streams.emplace( std::make_pair( stream, index ), counters() ).first;
+        memset( &it->second.values, 0, sizeof( it->second.values ) );
+        it->second.values.stream = stream;
+        it->second.values.index = index;
+    }
+    return it->second;
+}
+
+
+void stream_telemetry::on_received( rs2_stream stream, int index, bool discarded, uint32_t queue_depth )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    auto & v = at( stream, index ).values;
+    ++v.frames_received;
+    if( discarded )
+        ++v.frames_discarded;
+    v.queue_depth_max = std::max( v.queue_depth_max, queue_depth );
+}
+
+
+void stream_telemetry::on_delivered( rs2_stream stream, int index, unsigned long long frame_number, double latency_ms )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    auto & c = at( stream, index );
+    auto & v = c.values;
+    // A frame number that doesn't go up is a reset, not a drop
+    if( v.frames_delivered && frame_number > c.last_frame_number + 1 )
+        v.frames_dropped += frame_number - c.last_frame_number - 1;
+    c.last_frame_number = frame_number;
+    ++v.frames_delivered;
+
+    latency_ms = std::max( latency_ms, 0. );  // Backend and system clocks may not quite agree
+    v.latency_last_ms = latency_ms;
+    v.latency_max_ms = std::max( v.latency_max_ms, latency_ms );
+    c.latency_total_ms += latency_ms;
+    v.latency_avg_ms = c.latency_total_ms / v.frames_delivered;
+}
+
+
+void stream_telemetry::on_size_anomaly( rs2_stream stream, int index )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    ++at( stream, index ).values.size_anomalies;
+}
+
+
+std::vector< rs2_stream_telemetry > stream_telemetry::get() const
+{
+    std::vector< rs2_stream_telemetry > result;
+    std::lock_guard< std::mutex > lock( _mutex );
+    result.reserve( _streams.size() );
+    for( auto & s : _streams )
+    {
+        result.push_back( s.second.values );
+        result.back().backend_errors = _backend_errors;
+    }
+    return result;
+}
+
+
+}  // namespace librealsense
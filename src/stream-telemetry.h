@@ -0,0 +1,53 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <librealsense2/h/rs_sensor.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+
+namespace librealsense {
+
+
+// Per-stream counts of what a sensor got from its backend and what it handed on to its callback, whatever the
+// backend (see rs2_stream_telemetry). Kept by the sensor's frame_source, which all raw frames go through.
+//
+// Updates come from the backend threads, queries from anywhere.
+//
+class stream_telemetry
+{
+public:
+    void reset();
+
+    // A frame came from the backend; it's 'discarded' if no frame could be allocated for it
+    void on_received( rs2_stream, int index, bool discarded, uint32_t queue_depth );
+    // A frame was handed to the callback: gaps in the frame numbers count as drops
+    void on_delivered( rs2_stream, int index, unsigned long long frame_number, double latency_ms );
+    void on_size_anomaly( rs2_stream, int index );
+    // Applies to all the streams
+    void on_backend_error() { ++_backend_errors; }
+
+    // Without the current queue depths, which only the frame_source knows
+    std::vector< rs2_stream_telemetry > get() const;
+
+private:
+    struct counters
+    {
+        rs2_stream_telemetry values;
+        double latency_total_ms = 0;
+        unsigned long long last_frame_number = 0;
+    };
+    counters & at( rs2_stream, int index );
+
+    mutable std::mutex _mutex;
+    std::map< std::pair< rs2_stream, int >, counters > _streams;
+    std::atomic< unsigned long long > _backend_errors{ 0 };
+};
+
+
+}  // namespace librealsense
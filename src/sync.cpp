@@ -9,6 +9,8 @@
 #include "core/sensor-interface.h"
 #include "composite-frame.h"
 #include "core/time-service.h"
+#include "log.h"
+#include "frame-trace.h"
 
 #include <rsutils/string/from.h>
 
@@ -130,14 +132,15 @@ namespace librealsense
     {
         for (auto&& matcher : matchers)
         {
+            matcher->set_callback(
+                [&]( frame_holder f, const syncronization_environment & env ) {
+                    LOG_IF_ENABLE( "<-- " << *f.frame << "  " << _name, env );
+                    sync( std::move( f ), env );
+                } );
+            auto & slot = add_slot( matcher );
             for (auto&& stream : matcher->get_streams())
             {
-                matcher->set_callback(
-                    [&]( frame_holder f, const syncronization_environment & env ) {
-                        LOG_IF_ENABLE( "<-- " << *f.frame << "  " << _name, env );
-                        sync( std::move( f ), env );
-                    } );
-                _matchers[stream] = matcher;
+                set_slot_of_stream( stream, slot );
                 _streams_id.push_back(stream);
             }
             for (auto&& stream : matcher->get_streams_types())
@@ -154,23 +157,97 @@ namespace librealsense
              []( frame_holder const & fh )
              {
                  // If queues are overrun, we'll get here
-                 LOG_DEBUG( "DROPPED frame " << fh );
+                 LOG_DEBUG_FMT( "DROPPED frame {}", fh );
              } )
     {
     }
 
 
+    composite_matcher::matcher_slot & composite_matcher::add_slot( std::shared_ptr< matcher > const & m )
+    {
+        _slots.emplace_back();
+        _slots.back().m = m;
+        if( _policy )
+            m->set_policy( _policy );
+        return _slots.back();
+    }
+
+    void composite_matcher::set_policy( std::shared_ptr< sync_policy > const & policy )
+    {
+        _policy = policy;
+        for( auto & slot : _slots )
+            slot.m->set_policy( policy );
+    }
+
+    void composite_matcher::flush( const syncronization_environment & env )
+    {
+        // What the children release now gets queued here, so they go first. (By index: their frames may add slots.)
+        for( size_t i = 0; i < _slots.size(); ++i )
+            _slots[i].m->flush( env );
+
+        if( _policy && _policy->deadline_ms > 0 )
+            release_matches( _last_arrived_header, env );
+    }
+
+    // Whether the frames we'd release (the synced ones of those arrived) have waited past the policy's deadline
+    bool composite_matcher::deadline_passed() const
+    {
+        if( ! _policy || _policy->deadline_ms <= 0 || _synced_frames.empty() )
+            return false;
+
+        auto first_arrival = _frames_arrived[_synced_frames[0]]->frame->get_frame_system_time();
+        for( auto index : _synced_frames )
+            first_arrival = std::min( first_arrival, _frames_arrived[index]->frame->get_frame_system_time() );
+        return time_service::get_time() - first_arrival >= _policy->deadline_ms;
+    }
+
+    composite_matcher::matcher_slot * composite_matcher::slot_of_stream( stream_id stream )
+    {
+        for( auto & ss : _slot_of_stream )
+            if( ss.first == stream )
+                return ss.second;
+        return nullptr;
+    }
+
+    void composite_matcher::set_slot_of_stream( stream_id stream, matcher_slot & slot )
+    {
+        for( auto & ss : _slot_of_stream )
+        {
+            if( ss.first == stream )
+            {
+                ss.second = &slot;
+                return;
+            }
+        }
+        _slot_of_stream.emplace_back( stream, &slot );
+    }
+
+    void composite_matcher::start_syncing( matcher_slot & slot )
+    {
+        if( ! slot.synced )
+        {
+            slot.queue.q.start();
+            slot.synced = true;
+        }
+    }
+
+    void composite_matcher::stop_syncing( matcher_slot & slot )
+    {
+        slot.queue.q.clear();
+        slot.synced = false;
+    }
+
     void composite_matcher::dispatch(frame_holder f, const syncronization_environment& env)
     {
         clean_inactive_streams(f);
-        auto matcher = find_matcher(f);
+        auto slot = find_slot(f);
 
         //LOG_IF_ENABLE( "--> composite_matcher: " << _name, env );
 
-        if (matcher)
+        if (slot)
         {
-            update_last_arrived(f, matcher.get());
-            matcher->dispatch(std::move(f), env);
+            update_last_arrived(f, *slot);
+            slot->m->dispatch(std::move(f), env);
         }
         else
         {
@@ -181,30 +258,31 @@ namespace librealsense
 
     std::shared_ptr<matcher> composite_matcher::find_matcher(const frame_holder& frame)
     {
-        auto stream_profile = frame.frame->get_stream();
+        auto slot = find_slot( frame );
+        return slot ? slot->m : nullptr;
+    }
+
+    composite_matcher::matcher_slot * composite_matcher::find_slot( const frame_holder & frame )
+    {
+        auto stream_profile = frame.frame->peek_stream();
         auto stream_id = stream_profile->get_unique_id();
         auto stream_type = stream_profile->get_stream_type();
 
-        std::shared_ptr<matcher> matcher;
-        auto it = _matchers.find( stream_id );
-        if( it != _matchers.end() )
+        if( auto slot = slot_of_stream( stream_id ) )
         {
-            matcher = it->second;
-            if( matcher )
+            if( ! slot->m->get_active() )
             {
-                if( ! matcher->get_active() )
-                {
-                    matcher->set_active( true );
-                    _frames_queue[matcher.get()].q.start();
-                }
-                return matcher;
+                slot->m->set_active( true );
+                start_syncing( *slot );
+                slot->queue.q.start();
             }
+            return slot;
         }
         LOG_DEBUG( "no matcher found for " << get_abbr_string( stream_type ) << stream_id
                                            << "; creating matcher from device..." );
 
         auto sensor = frame.frame->get_sensor().get(); //TODO: Potential deadlock if get_sensor() gets a hold of the last reference of that sensor
-        auto dev_exist = false;
+        matcher_slot * slot = nullptr;
         if (sensor)
         {
             const device_interface* dev = nullptr;
@@ -218,8 +296,7 @@ namespace librealsense
             }
             if (dev)
             {
-                dev_exist = true;
-                matcher = dev->create_matcher(frame);
+                auto matcher = dev->create_matcher(frame);
                 LOG_DEBUG( "... created " << matcher->get_name() );
 
                 matcher->set_callback(
@@ -228,13 +305,12 @@ namespace librealsense
                         sync( std::move( f ), env );
                     } );
 
+                slot = &add_slot( matcher );
                 for (auto stream : matcher->get_streams())
                 {
-                    if (_matchers[stream])
-                    {
-                        _frames_queue.erase(_matchers[stream].get());
-                    }
-                    _matchers[stream] = matcher;
+                    if( auto replaced = slot_of_stream( stream ) )
+                        stop_syncing( *replaced );
+                    set_slot_of_stream( stream, *slot );
                     _streams_id.push_back(stream);
                 }
                 for (auto stream : matcher->get_streams_types())
@@ -258,25 +334,21 @@ namespace librealsense
             LOG_DEBUG("sensor does not exist");
         }
 
-        if (!dev_exist)
+        if (!slot)
         {
-            matcher = _matchers[stream_id];
             // We don't know what device this frame came from, so just store it under device NULL with ID matcher
-            if (!matcher)
-            {
-                _matchers[stream_id] = std::make_shared<identity_matcher>(stream_id, stream_type);
-                _streams_id.push_back(stream_id);
-                _streams_type.push_back(stream_type);
-                matcher = _matchers[stream_id];
-
-                matcher->set_callback(
-                    [&]( frame_holder f, syncronization_environment const & env ) {
-                        LOG_IF_ENABLE( "<-- " << *f.frame << "  " << _name, env );
-                        sync( std::move( f ), env );
-                    } );
-            }
+            slot = &add_slot( std::make_shared<identity_matcher>(stream_id, stream_type) );
+            set_slot_of_stream( stream_id, *slot );
+            _streams_id.push_back(stream_id);
+            _streams_type.push_back(stream_type);
+
+            slot->m->set_callback(
+                [&]( frame_holder f, syncronization_environment const & env ) {
+                    LOG_IF_ENABLE( "<-- " << *f.frame << "  " << _name, env );
+                    sync( std::move( f ), env );
+                } );
         }
-        return matcher;
+        return slot;
     }
 
     void composite_matcher::stop()
@@ -288,12 +360,13 @@ namespace librealsense
         set_active( false );
 
         // Stop all our queues to wake up anyone waiting on them
-        for( auto & fq : _frames_queue )
-            fq.second.q.stop();
+        for( auto & slot : _slots )
+            if( slot.synced )
+                slot.queue.q.stop();
 
         // Trickle the stop down to any children
-        for( auto m : _matchers )
-            m.second->stop();
+        for( auto & ss : _slot_of_stream )
+            ss.second->m->stop();
     }
 
     std::string
@@ -306,13 +379,13 @@ namespace librealsense
     }
 
     std::string
-        composite_matcher::matchers_to_string( std::vector< librealsense::matcher* > const& matchers )
+        composite_matcher::matchers_to_string( std::vector< matcher_slot* > const& slots )
     {
         std::ostringstream os;
         os << '[';
-        for( auto m : matchers )
+        for( auto slot : slots )
         {
-            auto const & q = _frames_queue[m].q;
+            auto const & q = slot->queue.q;
             q.peek( [&os]( frame_holder const & fh ) {
                 os << fh;
                 } );
@@ -323,57 +396,80 @@ namespace librealsense
 
     void composite_matcher::sync(frame_holder f, const syncronization_environment& env)
     {
-        auto matcher = find_matcher(f);
-        if (!matcher)
+        auto slot = find_slot(f);
+        if (!slot)
         {
             LOG_ERROR("didn't find any matcher for " << f << " will not be synchronized");
             _callback(std::move(f), env);
             return;
         }
-        update_next_expected( matcher, f );
+        update_next_expected( *slot, f );
+
+        // The first frame after its frameset went out without it
+        if( slot->late )
+        {
+            slot->late = false;
+            if( _policy && _policy->drop_late && is_late( f, slot->missed ) )
+            {
+                ++slot->dropped_frames;
+                ++_policy->dropped_frames;
+                LOG_IF_ENABLE( "... dropping late " << *f.frame << " (" << slot->dropped_frames << " dropped, "
+                                                    << slot->late_frames << " late in " << slot->m->get_name() << ")",
+                               env );
+                return;
+            }
+        }
 
         // We want to keep track of a "last-arrived" frame which is our current equivalent of "now" -- it contains the
         // latest timestamp/frame-number/etc. that we can compare to.
         auto const last_arrived = f->get_header();
+        _last_arrived_header = last_arrived;
 
-        if( ! _frames_queue[matcher.get()].q.enqueue( std::move( f ) ) )
+        start_syncing( *slot );
+        if( ! slot->queue.q.enqueue( std::move( f ) ) )
             // If we get stopped, nothing to do!
             return;
 
+        release_matches( last_arrived, env );
+    }
+
+    void composite_matcher::release_matches( frame_header const & last_arrived, const syncronization_environment & env )
+    {
         // We have a queue for each known stream we want to sync.
         // E.g., for (Depth Color), we need to sync two frames, one from each.
         // If we have a Color frame but not Depth, then Depth is "missing" and needs to be
         // waited-for...
 
-        std::vector< frame_holder * > frames_arrived;
-        std::vector< librealsense::matcher * > frames_arrived_matchers;
-        std::vector< int > synced_frames;
-        std::vector< int > unsynced_frames;
-        std::vector< librealsense::matcher * > missing_streams;
+        auto & frames_arrived = _frames_arrived;
+        auto & frames_arrived_slots = _frames_arrived_slots;
+        auto & synced_frames = _synced_frames;
+        auto & unsynced_frames = _unsynced_frames;
+        auto & missing_streams = _missing_streams;
+        auto & match = _match;
 
         while( true )
         {
             missing_streams.clear();
-            frames_arrived_matchers.clear();
+            frames_arrived_slots.clear();
             frames_arrived.clear();
-
-            std::vector< frame_holder > match;
+            match.clear();
             {
                 // We don't want to stop while syncing!
                 std::lock_guard< std::mutex > lock( _mutex );
 
                 // We want to release one frame from each matcher. If a matcher has nothing queued, it is "missing" and
                 // we need to consider waiting for it:
-                for( auto s = _frames_queue.begin(); s != _frames_queue.end(); s++ )
+                for( auto & s : _slots )
                 {
-                    librealsense::matcher * const m = s->first;
-                    if( ! s->second.q.peek( [&]( frame_holder & fh ) {
+                    if( ! s.synced )
+                        continue;
+                    if( ! s.queue.q.peek( [&]( frame_holder & fh ) {
                             LOG_IF_ENABLE( "... have " << *fh.frame, env );
                             frames_arrived.push_back( &fh );
-                            frames_arrived_matchers.push_back( m );
+                            frames_arrived_slots.push_back( &s );
                         } ) )
                     {
-                        missing_streams.push_back( m );
+                        missing_streams.push_back( &s );
                     }
                 }
                 if( frames_arrived.empty() )
@@ -416,13 +512,14 @@ namespace librealsense
                 {
                     // Everything (could be only one!) matches together... but if we also have
                     // something missing, we can't release anything yet...
+                    _waited_streams.clear();
                     for( auto i : missing_streams )
                     {
-                        LOG_IF_ENABLE( "... missing " << i->get_name() << ", next expected @"
-                                                      << rsutils::string::from( _next_expected[i].value ) << " (from "
-                                                      << rsutils::string::from( _next_expected[i].fps ) << " fps)",
+                        LOG_IF_ENABLE( "... missing " << i->m->get_name() << ", next expected @"
+                                                      << rsutils::string::from( i->next_expected.value ) << " (from "
+                                                      << rsutils::string::from( i->next_expected.fps ) << " fps)",
                                        env );
-                        if( skip_missing_stream( *curr_sync, i, last_arrived, env ) )
+                        if( skip_missing_stream( *curr_sync, *i, last_arrived, env ) )
                         {
                             LOG_IF_ENABLE( "...     cannot be synced; not waiting for it", env );
                             continue;
@@ -430,6 +527,23 @@ namespace librealsense
 
                         LOG_IF_ENABLE( "...     waiting for it", env );
                         release_synced_frames = false;
+                        _waited_streams.push_back( i );
+                    }
+
+                    // ... unless it's been too long since the first of them arrived
+                    if( ! release_synced_frames && deadline_passed() )
+                    {
+                        for( auto i : _waited_streams )
+                        {
+                            i->late = true;
+                            i->missed = i->next_expected;
+                            ++i->late_frames;
+                            ++_policy->late_frames;
+                            LOG_IF_ENABLE( "... deadline passed; releasing without " << i->m->get_name() << " ("
+                                                                                     << i->late_frames << " late)",
+                                           env );
+                        }
+                        release_synced_frames = true;
                     }
                 }
                 else
@@ -442,14 +556,11 @@ namespace librealsense
                 if( ! release_synced_frames )
                     break;
 
-                match.reserve( synced_frames.size() );
-
                 for( auto index : synced_frames )
                 {
                     frame_holder frame;
                     int const timeout_ms = 5000;
-                    librealsense::matcher * m = frames_arrived_matchers[index];
-                    _frames_queue[m].q.dequeue( &frame, timeout_ms );
+                    frames_arrived_slots[index]->queue.q.dequeue( &frame, timeout_ms );
                     match.push_back( std::move( frame ) );
                 }
             }
@@ -459,14 +570,16 @@ namespace librealsense
             std::sort( match.begin(),
                        match.end(),
                        []( const frame_holder & f1, const frame_holder & f2 ) {
-                           return f1.frame->get_stream()->get_unique_id()
-                                > f2.frame->get_stream()->get_unique_id();
+                           return f1.frame->peek_stream()->get_unique_id()
+                                > f2.frame->peek_stream()->get_unique_id();
                        } );
 
 
-            frame_holder composite = env.source->allocate_composite_frame(std::move(match));
+            frame_holder composite = env.source->allocate_composite_frame( match.data(), match.size() );
+            match.clear();
             if (composite.frame)
             {
+                frame_trace::stamp( composite.frame, "synced" );
                 auto cb = begin_callback();
                 _callback(std::move(composite), env);
             }
@@ -479,9 +592,9 @@ namespace librealsense
     {
     }
 
-    void frame_number_composite_matcher::update_last_arrived(frame_holder& f, matcher* m)
+    void frame_number_composite_matcher::update_last_arrived(frame_holder& f, matcher_slot& slot)
     {
-        _last_arrived[m] =f->get_frame_number();
+        slot.last_arrived = double( f->get_frame_number() );
     }
 
     bool frame_number_composite_matcher::are_equivalent(frame_holder& a, frame_holder& b)
@@ -494,41 +607,43 @@ namespace librealsense
     }
     void frame_number_composite_matcher::clean_inactive_streams(frame_holder& f)
     {
-        std::vector<stream_id> inactive_matchers;
-        for(auto m: _matchers)
+        std::vector<matcher_slot*> inactive_matchers;
+        for(auto & ss: _slot_of_stream)
         {
-            if( _last_arrived[m.second.get()]
-                && ( std::abs( (long long)f->get_frame_number() - (long long)_last_arrived[m.second.get()] ) ) > 5 )
+            auto & slot = *ss.second;
+            if( slot.last_arrived
+                && ( std::abs( (long long)f->get_frame_number() - (long long)slot.last_arrived ) ) > 5 )
             {
                 std::stringstream s;
                 s << "clean inactive stream in "<<_name;
-                for (auto stream : m.second->get_streams_types())
+                for (auto stream : slot.m->get_streams_types())
                 {
                     s << stream << " ";
                 }
                 LOG_DEBUG(s.str());
 
-                inactive_matchers.push_back(m.first);
-                m.second->set_active(false);
+                inactive_matchers.push_back(&slot);
+                slot.m->set_active(false);
             }
         }
 
-        for(auto id: inactive_matchers)
+        for(auto slot: inactive_matchers)
         {
-            _frames_queue[_matchers[id].get()].q.clear();
+            start_syncing(*slot);
+            slot->queue.q.clear();
         }
     }
 
     bool
     frame_number_composite_matcher::skip_missing_stream( frame_interface const * const synced_frame,
-                                                         matcher * missing,
+                                                         matcher_slot & missing,
                                                          frame_header const & last_arrived,
                                                          const syncronization_environment & env )
     {
-         if(!missing->get_active())
+         if(!missing.m->get_active())
              return true;
 
-        auto const & next_expected = _next_expected[missing];
+        auto const & next_expected = missing.next_expected;
 
         if( synced_frame->get_frame_number() - next_expected.value > 4
             || synced_frame->get_frame_number() < next_expected.value )
@@ -538,10 +653,14 @@ namespace librealsense
         return false;
     }
 
-    void frame_number_composite_matcher::update_next_expected(
-        std::shared_ptr< matcher > const & matcher, const frame_holder & f )
+    void frame_number_composite_matcher::update_next_expected( matcher_slot & slot, const frame_holder & f )
+    {
+        slot.next_expected.value = f.frame->get_frame_number()+1.;
+    }
+
+    bool frame_number_composite_matcher::is_late( const frame_holder & f, next_expected_t const & missed )
     {
-        _next_expected[matcher.get()].value = f.frame->get_frame_number()+1.;
+        return f->get_frame_number() <= missed.value;
     }
 
     std::pair<double, double> extract_timestamps(frame_holder & a, frame_holder & b)
@@ -581,14 +700,14 @@ namespace librealsense
         return ts.first < ts.second;
     }
 
-    void timestamp_composite_matcher::update_last_arrived(frame_holder& f, matcher* m)
+    void timestamp_composite_matcher::update_last_arrived(frame_holder& f, matcher_slot& slot)
     {
         auto const now = time_service::get_time();
-        //LOG_DEBUG( _name << ": _last_arrived[" << m->get_name() << "] = " << now );
-        _last_arrived[m] = now;
+        //LOG_DEBUG( _name << ": _last_arrived[" << slot.m->get_name() << "] = " << now );
+        slot.last_arrived = now;
     }
 
-    double timestamp_composite_matcher::get_fps( frame_interface const * f )
+    static double get_frame_fps( frame_interface const * f )
     {
         double fps = 0.;
         rs2_metadata_type fps_md;
@@ -600,15 +719,19 @@ namespace librealsense
         }
         else
         {
-            fps = f->get_stream()->get_framerate();
+            fps = f->peek_stream()->get_framerate();
             //LOG_DEBUG( "fps " << rsutils::string::from( fps ) << " from stream framerate " << *f );
         }
         return fps;
     }
 
+    double timestamp_composite_matcher::get_fps( frame_interface const * f )
+    {
+        return get_frame_fps( f );
+    }
+
     void
-    timestamp_composite_matcher::update_next_expected( std::shared_ptr< matcher > const & matcher,
-                                                       const frame_holder & f )
+    timestamp_composite_matcher::update_next_expected( matcher_slot & slot, const frame_holder & f )
     {
         auto fps = get_fps( f );
         auto gap = 1000. / fps;
@@ -618,31 +741,37 @@ namespace librealsense
         //LOG_DEBUG( "... next_expected = {timestamp}" << rsutils::string::from( ts ) << " + {gap}(1000/{fps}"
         //                                             << rsutils::string::from( fps )
         //                                             << ") = " << rsutils::string::from( ne ) );
-        auto & next_expected = _next_expected[matcher.get()];
+        auto & next_expected = slot.next_expected;
         next_expected.value = ne;
         next_expected.fps = fps;
         next_expected.domain = f.frame->get_frame_timestamp_domain();
     }
 
+    bool timestamp_composite_matcher::is_late( const frame_holder & f, next_expected_t const & missed )
+    {
+        // Within half a frame of when it was expected, or before
+        return f->get_frame_timestamp() < missed.value + 1000. / missed.fps / 2;
+    }
+
     void timestamp_composite_matcher::clean_inactive_streams(frame_holder& f)
     {
         // We let skip_missing_stream clean any inactive missing streams
     }
 
     bool timestamp_composite_matcher::skip_missing_stream( frame_interface const * waiting_to_be_released,
-                                                           matcher * missing,
+                                                           matcher_slot & missing,
                                                            frame_header const & last_arrived,
                                                            const syncronization_environment & env )
     {
         // true : frameset is ready despite the missing stream (no use waiting) -- "skip" it
         // false: the missing stream is relevant and our frameset isn't ready yet!
 
-        if(!missing->get_active())
+        if(!missing.m->get_active())
             return true;
 
         //LOG_IF_ENABLE( "...     matcher " << synced[0]->get_name(), env );
 
-        auto const & next_expected = _next_expected[missing];
+        auto const & next_expected = missing.next_expected;
         // LOG_IF_ENABLE( "...     next    " << std::fixed << next_expected, env );
 
         if( next_expected.domain != last_arrived.timestamp_domain )
@@ -717,13 +846,9 @@ namespace librealsense
                                << rsutils::string::from( next_expected.value + threshold ) << "; deactivating matcher!",
                            env );
 
-            auto const q_it = _frames_queue.find( missing );
-            if( q_it != _frames_queue.end() )
-            {
-                if( q_it->second.q.empty() )
-                    _frames_queue.erase( q_it );
-            }
-            missing->set_active( false );
+            if( missing.synced && missing.queue.q.empty() )
+                stop_syncing( missing );
+            missing.m->set_active( false );
             return true;
         }
 
@@ -760,12 +885,10 @@ namespace librealsense
         // Syncer have to output composite frame 
         if (!composite)
         {
-            std::vector<frame_holder> match;
             std::ostringstream frame_string_for_logging;
             frame_string_for_logging << f; // Saving frame holder string before moving frame
 
-            match.push_back(std::move(f));
-            frame_holder composite = env.source->allocate_composite_frame(std::move(match));
+            frame_holder composite = env.source->allocate_composite_frame(&f, 1);
             if (composite.frame)
             {
                 auto cb = begin_callback();
@@ -784,4 +907,122 @@ namespace librealsense
             _callback( std::move( f ), env );
         }
     }
+
+    // Global timestamps where there are, otherwise the host's clock at arrival: both are common to all devices
+    static rs2_timestamp_domain global_domain( rs2_timestamp_domain domain )
+    {
+        return domain == RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME ? RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME
+                                                          : RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME;
+    }
+
+    static double global_time( frame_header const & h )
+    {
+        return h.timestamp_domain == RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME ? h.timestamp : h.system_time;
+    }
+
+    global_timestamp_composite_matcher::global_timestamp_composite_matcher( double max_jitter_ms )
+        : composite_matcher( {}, "GTS: " )
+        , _max_jitter_ms( max_jitter_ms )
+    {
+    }
+
+    double global_timestamp_composite_matcher::jitter_window( double fps ) const
+    {
+        auto const half_gap = 1000. / fps / 2;
+        return _max_jitter_ms > 0 ? std::min( _max_jitter_ms, half_gap ) : half_gap;
+    }
+
+    bool global_timestamp_composite_matcher::are_equivalent( frame_holder & a, frame_holder & b )
+    {
+        auto const & ha = a->get_header();
+        auto const & hb = b->get_header();
+        if( global_domain( ha.timestamp_domain ) != global_domain( hb.timestamp_domain ) )
+            return false;
+
+        auto const min_fps = std::min( get_frame_fps( a ), get_frame_fps( b ) );
+        return std::abs( global_time( ha ) - global_time( hb ) ) < jitter_window( min_fps );
+    }
+
+    bool global_timestamp_composite_matcher::is_smaller_than( frame_holder & a, frame_holder & b )
+    {
+        if( ! a || ! b )
+            return false;
+
+        auto const & ha = a->get_header();
+        auto const & hb = b->get_header();
+        if( global_domain( ha.timestamp_domain ) != global_domain( hb.timestamp_domain ) )
+            return ha.system_time < hb.system_time;
+        return global_time( ha ) < global_time( hb );
+    }
+
+    void global_timestamp_composite_matcher::update_last_arrived( frame_holder & f, matcher_slot & slot )
+    {
+        slot.last_arrived = time_service::get_time();
+    }
+
+    void global_timestamp_composite_matcher::clean_inactive_streams( frame_holder & f )
+    {
+        // We let skip_missing_stream clean any inactive missing devices
+    }
+
+    void global_timestamp_composite_matcher::update_next_expected( matcher_slot & slot, const frame_holder & f )
+    {
+        auto const & h = f->get_header();
+        auto const fps = get_frame_fps( f );
+
+        auto & next_expected = slot.next_expected;
+        next_expected.value = global_time( h ) + 1000. / fps;
+        next_expected.fps = fps;
+        next_expected.domain = global_domain( h.timestamp_domain );
+    }
+
+    bool global_timestamp_composite_matcher::is_late( const frame_holder & f, next_expected_t const & missed )
+    {
+        auto const & h = f->get_header();
+        return global_domain( h.timestamp_domain ) == missed.domain
+            && global_time( h ) < missed.value + jitter_window( missed.fps );
+    }
+
+    bool global_timestamp_composite_matcher::skip_missing_stream( frame_interface const * waiting_to_be_released,
+                                                                  matcher_slot & missing,
+                                                                  frame_header const & last_arrived,
+                                                                  const syncronization_environment & env )
+    {
+        // true : frameset is ready despite the missing device (no use waiting) -- "skip" it
+        // false: the missing device is relevant and our frameset isn't ready yet!
+
+        if( ! missing.m->get_active() )
+            return true;
+
+        auto const & next_expected = missing.next_expected;
+        auto const & waiting = waiting_to_be_released->get_header();
+        // Nothing to compare to -- don't hold the other devices back
+        if( next_expected.domain != global_domain( waiting.timestamp_domain )
+            || next_expected.domain != global_domain( last_arrived.timestamp_domain ) )
+            return true;
+
+        auto const fps = get_frame_fps( waiting_to_be_released );
+        auto const gap = 1000. / fps;
+
+        // Its next frameset is for a later one than ours
+        if( next_expected.value - global_time( waiting ) >= jitter_window( fps ) )
+            return true;
+
+        // With hardware sync, the frameset is due with ours: it's only worth waiting until the other devices are a
+        // frame ahead. After 7 frames, as in timestamp_composite_matcher, the device isn't streaming anymore.
+        auto const late = global_time( last_arrived ) - next_expected.value;
+        if( late < gap )
+            return false;
+
+        if( late >= 7 * gap )
+        {
+            LOG_IF_ENABLE( "...     " << missing.m->get_name() << " is "
+                                      << rsutils::string::from( late ) << " ms late; deactivating matcher!",
+                           env );
+            if( missing.synced && missing.queue.q.empty() )
+                stop_syncing( missing );
+            missing.m->set_active( false );
+        }
+        return true;
+    }
 }  // namespace librealsense
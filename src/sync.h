@@ -4,6 +4,7 @@
 
 #include "callback-invocation.h"
 #include "core/frame-holder.h"
+#include "core/frame-header.h"
 
 #include <librealsense2/h/rs_sensor.h>
 #include <rsutils/concurrency/concurrency.h>
@@ -11,7 +12,8 @@
 #include <vector>
 #include <mutex>
 #include <memory>
-#include <map>
+#include <deque>
+#include <atomic>
 
 
 namespace librealsense {
@@ -37,6 +39,17 @@ namespace librealsense {
     typedef int stream_id;
     typedef std::function<void(frame_holder, const syncronization_environment&)> sync_callback;
 
+    // How long a syncer may hold frames waiting for the rest of their frameset (see RS2_OPTION_SYNC_DEADLINE), shared
+    // by all its matchers, with what it costs
+    struct sync_policy
+    {
+        float deadline_ms = 0;  // After the first frame of a frameset arrives; 0 for waiting as long as the matchers do
+        bool drop_late = false; // Drop a frame that arrives after its frameset went out without it, rather than pass it on alone
+
+        std::atomic< unsigned long long > late_frames{ 0 };     // Times a frameset went out without a stream
+        std::atomic< unsigned long long > dropped_frames{ 0 };  // Late frames dropped
+    };
+
     class matcher_interface
     {
     public:
@@ -66,6 +79,11 @@ namespace librealsense {
         void set_active(const bool active);
         virtual void stop() override {}
 
+        // Shares the syncer's sync_policy with this matcher and any it's made of
+        virtual void set_policy( std::shared_ptr< sync_policy > const & policy ) {}
+        // Releases whatever framesets the deadline of the sync_policy no longer lets us wait for
+        virtual void flush( const syncronization_environment & env ) {}
+
     protected:
        std::vector<stream_id> _streams_id;
        std::vector<rs2_stream> _streams_type;
@@ -86,6 +104,9 @@ namespace librealsense {
 
     class composite_matcher : public matcher
     {
+    protected:
+        struct matcher_slot;
+
     public:
         composite_matcher(std::vector<std::shared_ptr<matcher>> const & matchers, std::string const & name);
 
@@ -93,25 +114,25 @@ namespace librealsense {
         virtual bool are_equivalent(frame_holder& a, frame_holder& b) = 0;
         virtual bool is_smaller_than(frame_holder& a, frame_holder& b) = 0;
         virtual bool skip_missing_stream( frame_interface const * waiting_to_be_released,
-                                          matcher * missing,
+                                          matcher_slot & missing,
                                           frame_header const & last_arrived,
                                           const syncronization_environment & env )
             = 0;
         virtual void clean_inactive_streams(frame_holder& f) = 0;
-        virtual void update_last_arrived(frame_holder& f, matcher* m) = 0;
+        virtual void update_last_arrived(frame_holder& f, matcher_slot& slot) = 0;
 
         void dispatch(frame_holder f, const syncronization_environment& env) override;
         void sync(frame_holder f, const syncronization_environment& env) override;
         std::shared_ptr<matcher> find_matcher(const frame_holder& f);
         virtual void stop() override;
+        void set_policy( std::shared_ptr< sync_policy > const & policy ) override;
+        void flush( const syncronization_environment & env ) override;
 
         static std::string frames_to_string( std::vector< frame_holder* > const& );
-        std::string matchers_to_string( std::vector< matcher* > const& );
+        std::string matchers_to_string( std::vector< matcher_slot* > const& );
 
     protected:
-        virtual void update_next_expected( std::shared_ptr< matcher > const & matcher,
-                                           const frame_holder & f )
-            = 0;
+        virtual void update_next_expected( matcher_slot & slot, const frame_holder & f ) = 0;
 
         struct matcher_queue
         {
@@ -120,17 +141,62 @@ namespace librealsense {
             matcher_queue();
         };
 
-        std::map< matcher *, matcher_queue > _frames_queue;
-        std::map<stream_id, std::shared_ptr<matcher>> _matchers;
         struct next_expected_t
         {
             double value;  // timestamp/frame-number/etc.
             double fps;
             rs2_timestamp_domain domain;
         };
-        std::map< matcher *, next_expected_t > _next_expected;
+
+        // Whether f belongs to a frameset no later than the one that was missing it, when it was expected as 'missed'
+        virtual bool is_late( const frame_holder & f, next_expected_t const & missed ) { return false; }
+
+        // Everything we keep per matcher. Each one gets a slot when it's added, and a frame gets to it from its
+        // stream id through _slot_of_stream, with no other lookup.
+        struct matcher_slot
+        {
+            std::shared_ptr< matcher > m;
+            matcher_queue queue;
+            bool synced = false;  // Whether the queue takes part in sync(): from the first frame until it's dropped
+            next_expected_t next_expected{};
+            double last_arrived = 0;  // timestamp/frame-number/etc.
+            bool late = false;        // A frameset went out without it, when it was next expected as 'missed'
+            next_expected_t missed{};
+            unsigned long long late_frames = 0;
+            unsigned long long dropped_frames = 0;
+        };
+
+        matcher_slot * find_slot( const frame_holder & f );
+        matcher_slot & add_slot( std::shared_ptr< matcher > const & m );
+        matcher_slot * slot_of_stream( stream_id stream );
+        void set_slot_of_stream( stream_id stream, matcher_slot & slot );
+        // A queue needs to be started when it joins the sync, and emptied when it leaves
+        void start_syncing( matcher_slot & slot );
+        void stop_syncing( matcher_slot & slot );
+
+        // Releases the framesets that are ready, given the latest frame to arrive
+        void release_matches( frame_header const & last_arrived, const syncronization_environment & env );
+        bool deadline_passed() const;
+
+        // A deque, so that slots don't move (the queues can't) when more are added, and the pointers to them stay valid
+        std::deque< matcher_slot > _slots;
+        // The slot of each stream; only a few, so searched rather than mapped
+        std::vector< std::pair< stream_id, matcher_slot * > > _slot_of_stream;
 
         std::mutex _mutex;
+        std::shared_ptr< sync_policy > _policy;
+        frame_header _last_arrived_header;
+
+    private:
+        // Working storage for sync(), kept so that the vectors aren't allocated for each frame. A composite matcher
+        // is never re-entered from its own callback, so there's only one sync() at a time using them.
+        std::vector< frame_holder * > _frames_arrived;
+        std::vector< matcher_slot * > _frames_arrived_slots;
+        std::vector< int > _synced_frames;
+        std::vector< int > _unsynced_frames;
+        std::vector< matcher_slot * > _missing_streams;
+        std::vector< matcher_slot * > _waited_streams;
+        std::vector< frame_holder > _match;
     };
 
     // composite matcher that does not synchronize between any frames, and instead just passes them on to callback
@@ -143,18 +209,17 @@ namespace librealsense {
         virtual bool are_equivalent(frame_holder& a, frame_holder& b) override { return false; }
         virtual bool is_smaller_than(frame_holder& a, frame_holder& b) override { return false; }
         virtual bool skip_missing_stream( frame_interface const * waiting_to_be_released,
-                                          matcher * missing,
+                                          matcher_slot & missing,
                                           frame_header const & last_arrived,
                                           const syncronization_environment & env ) override
         {
             return false;
         }
         virtual void clean_inactive_streams(frame_holder& f) override {}
-        virtual void update_last_arrived(frame_holder& f, matcher* m) override {}
+        virtual void update_last_arrived(frame_holder& f, matcher_slot& slot) override {}
 
     protected:
-        void update_next_expected( std::shared_ptr< matcher > const & matcher,
-                                   const frame_holder & f ) override
+        void update_next_expected( matcher_slot & slot, const frame_holder & f ) override
         {
         }
     };
@@ -164,19 +229,16 @@ namespace librealsense {
     public:
         frame_number_composite_matcher(
             std::vector< std::shared_ptr< matcher > > const & matchers );
-        virtual void update_last_arrived(frame_holder& f, matcher* m) override;
+        virtual void update_last_arrived(frame_holder& f, matcher_slot& slot) override;
         bool are_equivalent(frame_holder& a, frame_holder& b) override;
         bool is_smaller_than(frame_holder& a, frame_holder& b) override;
         bool skip_missing_stream( frame_interface const * waiting_to_be_released,
-                                  matcher * missing,
+                                  matcher_slot & missing,
                                   frame_header const & last_arrived,
                                   const syncronization_environment & env ) override;
         void clean_inactive_streams(frame_holder& f) override;
-        void update_next_expected( std::shared_ptr< matcher > const & matcher,
-                                   const frame_holder & f ) override;
-
-    private:
-         std::map<matcher*,unsigned long long> _last_arrived;
+        void update_next_expected( matcher_slot & slot, const frame_holder & f ) override;
+        bool is_late( const frame_holder & f, next_expected_t const & missed ) override;
     };
 
     class timestamp_composite_matcher : public composite_matcher
@@ -185,19 +247,44 @@ namespace librealsense {
         timestamp_composite_matcher( std::vector< std::shared_ptr< matcher > > const & matchers );
         bool are_equivalent(frame_holder& a, frame_holder& b) override;
         bool is_smaller_than(frame_holder& a, frame_holder& b) override;
-        virtual void update_last_arrived(frame_holder& f, matcher* m) override;
+        virtual void update_last_arrived(frame_holder& f, matcher_slot& slot) override;
         void clean_inactive_streams(frame_holder& f) override;
         bool skip_missing_stream( frame_interface const * waiting_to_be_released,
-                                  matcher * missing,
+                                  matcher_slot & missing,
                                   frame_header const & last_arrived,
                                   const syncronization_environment & env ) override;
-        void update_next_expected( std::shared_ptr< matcher > const & matcher,
-                                   const frame_holder & f ) override;
+        void update_next_expected( matcher_slot & slot, const frame_holder & f ) override;
+        bool is_late( const frame_holder & f, next_expected_t const & missed ) override;
 
     private:
         double get_fps( frame_interface const * f );
         bool are_equivalent( double a, double b, double fps );
-        std::map<matcher*, double> _last_arrived;
+    };
+
+    // Matches the framesets of several hardware-synchronized devices (see RS2_OPTION_INTER_CAM_SYNC_MODE): each
+    // device's frames still go through the device's own matchers, and what comes out of those is matched on the
+    // global timestamps (RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME), which are comparable across devices. Frames without a
+    // global timestamp are matched on their system time instead.
+    class global_timestamp_composite_matcher : public composite_matcher
+    {
+    public:
+        // Framesets are matched when less than max_jitter_ms apart, and never more than half a frame; 0 for only
+        // the latter
+        global_timestamp_composite_matcher( double max_jitter_ms = 0 );
+        bool are_equivalent(frame_holder& a, frame_holder& b) override;
+        bool is_smaller_than(frame_holder& a, frame_holder& b) override;
+        virtual void update_last_arrived(frame_holder& f, matcher_slot& slot) override;
+        void clean_inactive_streams(frame_holder& f) override;
+        bool skip_missing_stream( frame_interface const * waiting_to_be_released,
+                                  matcher_slot & missing,
+                                  frame_header const & last_arrived,
+                                  const syncronization_environment & env ) override;
+        void update_next_expected( matcher_slot & slot, const frame_holder & f ) override;
+        bool is_late( const frame_holder & f, next_expected_t const & missed ) override;
+
+    private:
+        double jitter_window( double fps ) const;
+        double _max_jitter_ms;
     };
 
 
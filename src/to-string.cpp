@@ -252,6 +252,22 @@ const char * get_string( rs2_gyro_sensitivity value )
 #undef CASE
 }
 
+const char * get_string( rs2_points_layout value )
+{
+#define CASE( X ) STRCASE( POINTS_LAYOUT, X )
+    switch( value )
+    {
+        CASE( INTERLEAVED )
+        CASE( PACKED_FLOAT )
+        CASE( PACKED_HALF )
+        CASE( PACKED_MILLIMETERS )
+    default:
+        assert( ! is_valid( value ) );
+        return UNKNOWN_VALUE;
+    }
+#undef CASE
+}
+
 const char * get_string( rs2_extension value )
 {
 #define CASE( X ) STRCASE( EXTENSION, X )
@@ -313,6 +329,14 @@ const char * get_string( rs2_extension value )
     CASE( MAX_USABLE_RANGE_SENSOR )
     CASE( DEBUG_STREAM_SENSOR )
     CASE( CALIBRATION_CHANGE_DEVICE )
+    CASE( DEPTH_PIPELINE )
+    CASE( PROCESSING_GRAPH )
+    CASE( DEPTH_NORMALIZE )
+    CASE( DEPTH_QUALITY_METRICS )
+    CASE( UNDISTORT_FILTER )
+    CASE( DEPTH_FUSION )
+    CASE( SCENE_CHANGE_GATE )
+    CASE( SPARSE_DEPTH_TRANSFORM )
     default:
         assert( ! is_valid( value ) );
         return UNKNOWN_VALUE;
@@ -459,6 +483,47 @@ std::string const & get_string_( rs2_option value )
         CASE( OHM_TEMPERATURE )
         CASE( SOC_PVT_TEMPERATURE )
         CASE( GYRO_SENSITIVITY )
+        CASE( FRAME_POOL_HITS )
+        CASE( FRAME_POOL_MISSES )
+        CASE( FILTER_THREADS )
+        CASE( HISTOGRAM_REFRESH_INTERVAL )
+        CASE( POINTS_LAYOUT )
+        CASE( FILTER_ROI_LEFT )
+        CASE( FILTER_ROI_TOP )
+        CASE( FILTER_ROI_RIGHT )
+        CASE( FILTER_ROI_BOTTOM )
+        CASE( PIPELINE_STAGE )
+        CASE( SYNC_DEADLINE )
+        CASE( SYNC_DROP_LATE_FRAMES )
+        CASE( SYNC_LATE_FRAMES )
+        CASE( SYNC_DROPPED_FRAMES )
+        CASE( CUDA_DEVICE )
+        CASE( READBACK_LATENCY )
+        CASE( FRAMES_IN_FLIGHT )
+        CASE( POINTS_MIN_X )
+        CASE( POINTS_MAX_X )
+        CASE( POINTS_MIN_Y )
+        CASE( POINTS_MAX_Y )
+        CASE( POINTS_MIN_Z )
+        CASE( POINTS_MAX_Z )
+        CASE( CONVERSION_THREADS )
+        CASE( OCCLUSION_DECIMATION )
+        CASE( DEPTH_NORMALIZE_OUTPUT )
+        CASE( LAZY_CONVERSION )
+        CASE( AUTO_EXPOSURE_SUBSAMPLING )
+        CASE( DEPTH_QUALITY_WINDOW )
+        CASE( DEPTH_QUALITY_FILL_RATE )
+        CASE( DEPTH_QUALITY_PLANE_FIT_RMS_ERROR )
+        CASE( DEPTH_QUALITY_DISTANCE )
+        CASE( DEPTH_FUSION_OUTPUT )
+        CASE( DEPTH_FUSION_CELL_SIZE )
+        CASE( DEPTH_FUSION_MAP_SIZE )
+        CASE( POINTS_VOXEL_SIZE )
+        CASE( TEMPORAL_MOTION_COMPENSATION )
+        CASE( SCENE_CHANGE_THRESHOLD )
+        CASE( SCENE_CHANGE_KEEP_ALIVE )
+        CASE( MEMORY_USAGE )
+        CASE( ALIGN_OUTPUT_SCALE )
 #undef CASE
         return arr;
     }();
@@ -543,6 +608,8 @@ const char * get_string( rs2_format value )
     CASE( Y411 )
     CASE( Y16I )
     CASE( M420 )
+    CASE( Z16RVL )
+    CASE( Z16_SPARSE )
     default:
         assert( ! is_valid( value ) );
         return UNKNOWN_VALUE;
@@ -588,6 +655,7 @@ const char * get_string( rs2_camera_info value )
     CASE( FIRMWARE_UPDATE_ID )
     CASE( IP_ADDRESS )
     CASE( DFU_DEVICE_PATH )
+    CASE( CONVERSION_KERNEL )
     default:
         assert( ! is_valid( value ) );
         return UNKNOWN_VALUE;
@@ -644,6 +712,11 @@ std::string const & get_string( rs2_frame_metadata_value value )
         CASE( SUB_PRESET_INFO )
         CASE( CALIB_INFO )
         CASE( CRC )
+        CASE( POINT_COUNT )
+        CASE( DELIVERY_LATENCY )
+        CASE( SCENE_CHANGE )
+        CASE( SKIPPED_FRAMES )
+        CASE( DEQUEUE_LATENCY )
 #undef CASE
             return arr;
     }();
@@ -694,6 +767,9 @@ const char * get_string( rs2_notification_category value )
     CASE( UNKNOWN_ERROR )
     CASE( FIRMWARE_UPDATE_RECOMMENDED )
     CASE( POSE_RELOCALIZATION )
+    CASE( FRAMES_DROPPED )
+    CASE( PROCESSING_LOAD )
+    CASE( MEMORY_BUDGET )
     default:
         assert( ! is_valid( value ) );
         return UNKNOWN_VALUE;
@@ -804,3 +880,4 @@ const char * rs2_host_perf_mode_to_string( rs2_host_perf_mode mode ) { return li
 const char * rs2_emitter_frequency_mode_to_string( rs2_emitter_frequency_mode mode ) { return librealsense::get_string( mode ); }
 const char * rs2_depth_auto_exposure_mode_to_string( rs2_depth_auto_exposure_mode mode ) { return librealsense::get_string( mode ); }
 const char * rs2_gyro_sensitivity_to_string( rs2_gyro_sensitivity mode ){return librealsense::get_string( mode );}
+const char * rs2_points_layout_to_string( rs2_points_layout layout ) { return librealsense::get_string( layout ); }
@@ -3,14 +3,17 @@
 
 #include "uvc-sensor.h"
 #include "device.h"
+#include "context.h"
 #include "stream.h"
 #include "global_timestamp_reader.h"
 #include "core/video-frame.h"
 #include "core/notification.h"
+#include "memory-stats.h"
 #include "platform/uvc-option.h"
 #include "platform/stream-profile-impl.h"
 #include <src/metadata-parser.h>
 #include <src/core/time-service.h>
+#include <rsutils/string/from.h>
 
 
 namespace librealsense {
@@ -32,7 +35,23 @@ uvc_sensor::uvc_sensor( std::string const & name,
     , _device( std::move( uvc_device ) )
     , _user_count( 0 )
     , _timestamp_reader( std::move( timestamp_reader ) )
+    , _zero_copy_frames( std::make_shared< std::atomic< int > >( 0 ) )
 {
+    if( auto context = dev->get_context() )
+    {
+        _zero_copy = context->get_settings().nested( std::string( "zero-copy-frames", 16 ) ).default_value( false );
+        // RSUSB only: how many USB transfers each stream keeps in flight; by default, adapted to the frames dropped
+        if( auto count = context->get_settings().nested( std::string( "usb-request-count", 17 ) ) )
+            _device->set_usb_request_count( count.get< int >() );
+        // V4L2 only: pick up the metadata of each video frame in the same wake-up
+        if( context->get_settings().nested( std::string( "v4l2-paired-metadata", 20 ) ).default_value( false ) )
+            _device->set_paired_metadata_capture( true );
+        // Media Foundation only: how many samples each stream has requested ahead of the one being processed
+        if( auto count = context->get_settings().nested( std::string( "mf-read-ahead", 13 ) ) )
+            _device->set_read_ahead( count.get< int >() );
+        _memory_budget = context->get_memory_budget();
+    }
+
     register_metadata( RS2_FRAME_METADATA_BACKEND_TIMESTAMP,
                        make_additional_data_parser( &frame_additional_data::backend_timestamp ) );
     register_metadata( RS2_FRAME_METADATA_RAW_FRAME_SIZE,
@@ -103,11 +122,19 @@ void uvc_sensor::open( const stream_profiles & requests )
 
     _source.init( _metadata_parsers );
     _source.set_sensor( _source_owner->shared_from_this() );
+    _low_latency = low_latency_settings::get();
 
     std::vector< platform::stream_profile > commited;
 
     verify_supported_requests( requests );
 
+    int buffers = DEFAULT_V4L2_FRAME_BUFFERS;
+    if( _memory_budget )
+    {
+        _memory_budget->add_sensor();
+        buffers = apply_memory_budget( requests );
+    }
+
     for( auto && req_profile : requests )
     {
         auto && req_profile_base = std::dynamic_pointer_cast< stream_profile_base >( req_profile );
@@ -122,7 +149,14 @@ void uvc_sensor::open( const stream_profiles & requests )
                     platform::frame_object f,
                     std::function< void() > continuation ) mutable
                 {
-                    const auto system_time = time_service::get_time();  // time frame was received from the backend
+                    const auto dequeue_time = time_service::get_time();  // time frame was received from the backend
+                    // Where the driver timestamps its buffers, the frame's time of arrival is the driver's, without
+                    // the scheduling delays of our getting it; those are kept apart, as RS2_FRAME_METADATA_DEQUEUE_LATENCY
+                    const bool driver_arrival = f.arrival_time > 0 && f.arrival_time <= dequeue_time
+                                             && dequeue_time - f.arrival_time < 1000;
+                    const auto system_time = driver_arrival ? f.arrival_time : dequeue_time;
+                    if( _low_latency.enabled )
+                        _low_latency.apply_to_delivery_thread();
 
                     if( ! this->is_streaming() )
                     {
@@ -139,6 +173,8 @@ void uvc_sensor::open( const stream_profiles & requests )
                                                                  last_timestamp,
                                                                  last_frame_number,
                                                                  req_profile_base );
+                    if( driver_arrival )
+                        fr->additional_data.dequeue_time = dequeue_time;
                     const auto && timestamp_domain = _timestamp_reader->get_frame_timestamp_domain( fr );
                     auto bpp = get_image_bpp( req_profile_base->get_format() );
                     auto && frame_counter = fr->additional_data.frame_number;
@@ -181,18 +217,48 @@ void uvc_sensor::open( const stream_profiles & requests )
                     // For compressed formats copy the raw data as is
                     if( val_in_range( req_profile_base->get_format(), { RS2_FORMAT_MJPEG, RS2_FORMAT_Z16H } ) )
                         expected_size = static_cast< int >( f.frame_size );
+                    // Bigger frames are padded to 64-byte lines (MIPI), or 32-bit Y12I (see below)
+                    else if( ! msp && f.frame_size < expected_size )
+                        _source.telemetry()->on_size_anomaly( req_profile_base->get_stream_type(),
+                                                              req_profile_base->get_stream_index() );
+
+                    // Frames that need no reshaping can wrap the backend buffer directly
+                    bool zero_copy = _zero_copy && f.frame_size == expected_size
+                                  && _zero_copy_frames->load() < MAX_ZERO_COPY_FRAMES;
 
                     auto extension = frame_source::stream_to_frame_types( req_profile_base->get_stream_type() );
                     frame_holder fh = _source.alloc_frame(
                         { req_profile_base->get_stream_type(), req_profile_base->get_stream_index(), extension },
                         expected_size,
                         std::move( fr->additional_data ),
-                        true );
-                    auto diff = time_service::get_time() - system_time;
+                        ! zero_copy );
+                    auto diff = time_service::get_time() - dequeue_time;
                     if( diff > 10 )
                         LOG_DEBUG( "!! Frame allocation took " << diff << " msec" );
 
-                    if( fh.frame )
+                    auto wrapped = zero_copy ? dynamic_cast< frame * >( fh.frame ) : nullptr;
+                    if( wrapped )
+                    {
+                        // The continuation now runs (and re-queues the kernel buffer) when the frame is released
+                        auto outstanding = _zero_copy_frames;
+                        ++*outstanding;
+                        wrapped->external_data.reset( (uint8_t *)f.pixels,
+                                                      [continuation, outstanding]( uint8_t * )
+                                                      {
+                                                          continuation();
+                                                          --*outstanding;
+                                                      } );
+                        wrapped->external_size = expected_size;
+                        wrapped->external_fd = f.dmabuf_fd;
+
+                        auto && video = dynamic_cast< video_frame * >( fh.frame );
+                        if( video )
+                            video->assign( width, height, width * bpp / 8, bpp );
+
+                        fh->set_timestamp_domain( timestamp_domain );
+                        fh->set_stream( req_profile_base );
+                    }
+                    else if( fh.frame )
                     {
                         // method should be limited to use of MIPI - not for USB
                         // the aim is to grab the data from a bigger buffer, which is aligned to 64 bytes,
@@ -226,26 +292,28 @@ void uvc_sensor::open( const stream_profiles & requests )
                         fh->set_timestamp_domain( timestamp_domain );
                         fh->set_stream( req_profile_base );
 
-                        diff = time_service::get_time() - system_time;
+                        diff = time_service::get_time() - dequeue_time;
                         if (diff > 10)
                             LOG_DEBUG("!! Frame memcpy took " << diff << " msec");
                     }
 
                     // calling the continuation method, and releasing the backend frame buffer
                     // since the content of the OS frame buffer has been copied, it can released ASAP
-                    continuation();
+                    if( ! wrapped )
+                        continuation();
 
                     if (!fh.frame)
                     {
                         LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
                         return;
                     }
+                    check_memory_budget();
 
-                    if( fh->get_stream().get() )
+                    if( fh->peek_stream() )
                     {
                         // Gather info for logging the callback ended
-                        auto fps = fh->get_stream()->get_framerate();
-                        auto stream_type = fh->get_stream()->get_stream_type();
+                        auto fps = fh->peek_stream()->get_framerate();
+                        auto stream_type = fh->peek_stream()->get_stream_type();
                         auto frame_number = fh->get_frame_number();
 
                         // Invoke first callback
@@ -256,7 +324,8 @@ void uvc_sensor::open( const stream_profiles & requests )
                         // Log callback ended
                         log_callback_end( fps, callback_start_time, time_service::get_time(), stream_type, frame_number );
                     }
-                } );
+                },
+                buffers );
         }
         catch( ... )
         {
@@ -264,6 +333,8 @@ void uvc_sensor::open( const stream_profiles & requests )
             {
                 _device->close( commited_profile );
             }
+            if( _memory_budget )
+                _memory_budget->remove_sensor();
             throw;
         }
         commited.push_back( req_profile_base->get_backend_profile() );
@@ -279,7 +350,12 @@ void uvc_sensor::open( const stream_profiles & requests )
 
     try
     {
-        _device->stream_on( [&]( const notification & n ) { _notifications_processor->raise_notification( n ); } );
+        _device->stream_on(
+            [&]( const notification & n )
+            {
+                _source.telemetry()->on_backend_error();
+                _notifications_processor->raise_notification( n );
+            } );
     }
     catch( ... )
     {
@@ -301,6 +377,8 @@ void uvc_sensor::open( const stream_profiles & requests )
         reset_streaming();
         _power.reset();
         _is_opened = false;
+        if( _memory_budget )
+            _memory_budget->remove_sensor();
 
         throw std::runtime_error( error_msg.str() );
     }
@@ -336,10 +414,69 @@ void uvc_sensor::close()
     }
     _power.reset();
     _is_opened = false;
+    if( _memory_budget )
+    {
+        _memory_budget->remove_sensor();
+        _over_budget = false;
+    }
     set_active_streams( {} );
 }
 
 
+int uvc_sensor::apply_memory_budget( const stream_profiles & requests )
+{
+    // Enough for a few frames of each stream to be out at once, as the budget allows: in the user's hands, queued for
+    // them, pooled, and in the driver's buffers
+    uint64_t const share = _memory_budget->get_share();
+    uint64_t set_bytes = 0;
+    for( auto && req : requests )
+    {
+        if( auto vsp = As< video_stream_profile, stream_profile_interface >( req ) )
+            set_bytes += uint64_t( vsp->get_width() ) * vsp->get_height() * get_image_bpp( req->get_format() ) / 8;
+        else
+            set_bytes += 64;  // Motion
+    }
+    uint64_t const frames = std::max< uint64_t >( 2, std::min< uint64_t >( 16, set_bytes ? share / set_bytes : 16 ) );
+
+    _source.set_memory_budget( share );
+    if( _source.get_max_publish_list_size() > frames )
+        _source.set_max_publish_list_size( int( frames ) );
+
+    // Zero-copy frames hold on to the driver's buffers themselves, so those aren't cut down
+    int buffers = DEFAULT_V4L2_FRAME_BUFFERS;
+    if( ! _zero_copy )
+        buffers = std::max( 2, std::min( buffers, int( frames / 2 ) ) );
+
+    LOG_DEBUG( get_info( RS2_CAMERA_INFO_NAME ) << ": memory budget " << ( share >> 10 ) << " KB for " << set_bytes
+                                                << " bytes a set; queue " << _source.get_max_publish_list_size()
+                                                << ", " << buffers << " driver buffers" );
+    return buffers;
+}
+
+
+void uvc_sensor::check_memory_budget()
+{
+    if( ! _memory_budget )
+        return;
+
+    // Other sensors may have opened or closed since: the pools keep to what the share is now
+    uint64_t const share = _memory_budget->get_share();
+    _source.set_memory_budget( share );
+    uint64_t const usage = _source.get_memory_usage();
+    bool const over = usage > share;
+    if( over == _over_budget.exchange( over ) )
+        return;
+
+    notification n( RS2_NOTIFICATION_CATEGORY_MEMORY_BUDGET,
+                    over ? 1 : 0,
+                    over ? RS2_LOG_SEVERITY_WARN : RS2_LOG_SEVERITY_INFO,
+                    rsutils::string::from() << get_info( RS2_CAMERA_INFO_NAME )
+                                            << ( over ? " is over its memory budget: " : " is back within its memory budget: " )
+                                            << ( usage >> 10 ) << " KB of " << ( share >> 10 ) << " KB" );
+    _notifications_processor->raise_notification( n );
+}
+
+
 void uvc_sensor::register_pu( rs2_option id )
 {
     register_option( id, std::make_shared< uvc_pu_option >( std::dynamic_pointer_cast< uvc_sensor >( shared_from_this() ), id ) );
@@ -5,11 +5,15 @@
 
 #include "sensor.h"
 #include "platform/uvc-device.h"
+#include "low-latency.h"
 
 
 namespace librealsense {
 
 
+class memory_budget;
+
+
 class uvc_sensor : public raw_sensor_base
 {
     typedef raw_sensor_base super;
@@ -51,6 +55,10 @@ private:
     void acquire_power();
     void release_power();
     void reset_streaming();
+    // Sizes the frame queue and the pools to the sensor's share of the memory budget; returns the V4L2 buffers to ask
+    // for each stream
+    int apply_memory_budget( const stream_profiles & requests );
+    void check_memory_budget();
 
     struct power
     {
@@ -90,6 +98,21 @@ private:
     std::vector< platform::extension_unit > _xus;
     std::unique_ptr< power > _power;
     std::unique_ptr< frame_timestamp_reader > _timestamp_reader;
+
+    // With "zero-copy-frames" in the context settings, frames wrap the backend buffer rather than copy it, and the
+    // buffer is given back to the backend (re-queued to V4L2, or the Media Foundation sample unlocked) when the frame
+    // is released. At most MAX_ZERO_COPY_FRAMES are outstanding at any time, so the driver always has buffers left
+    // to fill.
+    static const int MAX_ZERO_COPY_FRAMES = DEFAULT_V4L2_FRAME_BUFFERS / 2;
+    bool _zero_copy = false;
+    std::shared_ptr< std::atomic< int > > _zero_copy_frames;
+
+    low_latency_settings _low_latency;  // As when the sensor was opened
+
+    // With "memory-budget-mb" in the context settings; see apply_memory_budget(). Going over the sensor's share, and
+    // back within it, raises a RS2_NOTIFICATION_CATEGORY_MEMORY_BUDGET notification.
+    std::shared_ptr< memory_budget > _memory_budget;
+    std::atomic< bool > _over_budget{ false };
 };
 
 
@@ -109,6 +109,18 @@ namespace librealsense
             _frame_callbacks.push_back(callback);
         }
 
+        void rs_uvc_device::set_usb_request_count(int count)
+        {
+            _fixed_request_count = uint8_t(std::max(0, std::min(count, 255)));
+        }
+
+        bool rs_uvc_device::set_control_change_callback(std::function<void(uint8_t unit, uint8_t selector)> callback)
+        {
+            std::lock_guard<std::mutex> lock(_control_change_mutex);
+            _control_change_callback = std::move(callback);
+            return true;
+        }
+
         void rs_uvc_device::stream_on(std::function<void(const notification& n)> error_handler)
         {
             if (_profiles.empty())
@@ -455,7 +467,11 @@ namespace librealsense
             if(sts != RS2_USB_STATUS_SUCCESS)
                 throw std::runtime_error("Failed to start streaming!");
 
-            uvc_streamer_context usc = { profile, callback, ctrl, _usb_device, _messenger, _usb_request_count };
+            // A fixed number of requests if asked for, otherwise we start small and add more as frames get dropped
+            uint8_t count = _usb_request_count, max_count = MAX_USB_REQUEST_COUNT;
+            if (_fixed_request_count)
+                count = max_count = _fixed_request_count;
+            uvc_streamer_context usc = { profile, callback, ctrl, _usb_device, _messenger, count, std::max(count, max_count) };
 
             auto streamer = std::make_shared<uvc_streamer>(usc);
             _streamers.push_back(streamer);
@@ -664,7 +680,6 @@ namespace librealsense
             _interrupt_callback = std::make_shared<usb_request_callback>
                     ([&](rs_usb_request response)
                      {
-                         //TODO:MK Should call the sensor to handle via callback
                          if (response->get_actual_length() > 0)
                          {
                              std::string buff = "";
@@ -673,6 +688,16 @@ namespace librealsense
                              LOG_DEBUG("interrupt event received: " << buff.c_str());
                          }
 
+                         // A VideoControl status packet: bStatusType, bOriginator (the unit), bEvent (0 for a
+                         // control change), bSelector, ...
+                         auto status = response->get_buffer().data();
+                         if (response->get_actual_length() >= 4 && (status[0] & 0x0f) == 1 && status[2] == 0)
+                         {
+                             std::lock_guard<std::mutex> lock(_control_change_mutex);
+                             if (_control_change_callback)
+                                 _control_change_callback(status[1], status[3]);
+                         }
+
                          _action_dispatcher.invoke([this](dispatcher::cancellable_timer c)
                          {
                              if (!_messenger)
@@ -42,8 +42,13 @@ namespace librealsense
             rs_uvc_device(const rs_usb_device& usb_device, const uvc_device_info &info, uint8_t usb_request_count = 2);
             virtual ~rs_uvc_device();
 
+            // Frames dropped for lack of a waiting request get more requests queued, up to this
+            static const uint8_t MAX_USB_REQUEST_COUNT = 8;
+
             virtual void probe_and_commit(stream_profile profile, frame_callback callback, int buffers = DEFAULT_V4L2_FRAME_BUFFERS) override;
             virtual void stream_on(std::function<void(const notification& n)> error_handler = [](const notification& n){}) override;
+            virtual void set_usb_request_count(int count) override;
+            virtual bool set_control_change_callback(std::function<void(uint8_t unit, uint8_t selector)> callback) override;
             virtual void start_callbacks() override;
             virtual void stop_callbacks() override;
             virtual void close(stream_profile profile) override;
@@ -107,7 +112,10 @@ namespace librealsense
             rs_usb_messenger                        _messenger;
             rs_usb_request                          _interrupt_request;
             rs_usb_request_callback                 _interrupt_callback;
+            std::mutex                              _control_change_mutex;
+            std::function<void(uint8_t unit, uint8_t selector)> _control_change_callback;
             uint8_t                                 _usb_request_count;
+            uint8_t                                 _fixed_request_count = 0;
 
             mutable dispatcher                      _action_dispatcher;
             // uvc internal
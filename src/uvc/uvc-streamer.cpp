@@ -3,6 +3,8 @@
 
 #include "uvc-streamer.h"
 
+#include <sstream>
+
 const int UVC_PAYLOAD_MAX_HEADER_LENGTH         = 1024;
 const int DEQUEUE_MILLISECONDS_TIMEOUT          = 50;
 const int ENDPOINT_RESET_MILLISECONDS_TIMEOUT   = 100;
@@ -110,41 +112,103 @@ namespace librealsense
 
             _watchdog->start();
 
+            // Completions are handled right on the thread they're delivered on (the USB event thread): there's no
+            // copy to make, and the frame goes to the publishing thread anyway. The callback itself won't be called
+            // once it's been cancelled, in stop().
             _request_callback = std::make_shared<usb_request_callback>([this](platform::rs_usb_request r)
             {
-                _action_dispatcher.invoke([this, r](dispatcher::cancellable_timer)
+                if(!_running)
+                  return;
+
+                std::lock_guard<std::mutex> lock(_requests_mutex);
+                auto it = _submit_times.find(r.get());
+                if(it != _submit_times.end())
                 {
-                    if(!_running)
-                      return;
+                    static const int64_t bucket_ms[] = { 1, 2, 5, 10, 20, 50, 100 };
+                    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - it->second).count();
+                    size_t bucket = 0;
+                    while(bucket < _latency_histogram.size() - 1 && ms >= bucket_ms[bucket])
+                        ++bucket;
+                    ++_latency_histogram[bucket];
+                }
 
-                    auto al = r->get_actual_length();
-                    // Relax the frame size constrain for compressed streams
-                    bool is_compressed = val_in_range(_context.profile.format, { 0x4d4a5047U , 0x5a313648U}); // MJPEG, Z16H
-                    if(al > 0L && ((al == r->get_buffer().data()[0] + _context.control->dwMaxVideoFrameSize) || is_compressed ))
+                auto al = r->get_actual_length();
+                // Relax the frame size constrain for compressed streams
+                bool is_compressed = val_in_range(_context.profile.format, { 0x4d4a5047U , 0x5a313648U}); // MJPEG, Z16H
+                if(al > 0L && ((al == r->get_buffer().data()[0] + _context.control->dwMaxVideoFrameSize) || is_compressed ))
+                {
+                    auto f = backend_frame_ptr(_frames_archive->allocate(), &cleanup_frame);
+                    if(f)
                     {
-                        auto f = backend_frame_ptr(_frames_archive->allocate(), &cleanup_frame);
-                        if(f)
-                        {
-                            _frame_arrived = true;
-                            _watchdog->kick();
-                            memcpy(f->pixels.data(), r->get_buffer().data(), r->get_buffer().size());
-                            uvc_process_bulk_payload(std::move(f), r->get_actual_length(), _queue);
-                        }
+                        _frame_arrived = true;
+                        _watchdog->kick();
+                        // The filled buffer becomes the frame, and the frame's (from the same pool, so the
+                        // same size) goes to the request for its next transfer
+                        if (f->pixels.size() == r->get_buffer().size())
+                            r->swap_buffer(f->pixels);
+                        else
+                            memcpy(f->pixels.data(), r->get_buffer().data(), al);
+                        uvc_process_bulk_payload(std::move(f), r->get_actual_length(), _queue);
                     }
+                    else
+                        ++_drops; // All the frames are still with the user: more requests won't help
+                }
+                else if(al > 0L)
+                    on_drop(); // Incomplete frame: we didn't have a request waiting for all of it
 
-                    auto sts = _context.messenger->submit_request(r);
-                    if(sts != platform::RS2_USB_STATUS_SUCCESS)
-                        LOG_ERROR("failed to submit UVC request, error: " << sts);
-                });
+                auto sts = submit(r);
+                if(sts != platform::RS2_USB_STATUS_SUCCESS)
+                    LOG_ERROR("failed to submit UVC request, error: " << sts);
             });
 
             _requests = std::vector<rs_usb_request>(_context.request_count);
             for(auto&& r : _requests)
+                r = create_request();
+        }
+
+        rs_usb_request uvc_streamer::create_request()
+        {
+            auto r = _context.messenger->create_request(_read_endpoint);
+            r->set_buffer(std::vector<uint8_t>(_read_buff_length));
+            r->set_callback(_request_callback);
+            return r;
+        }
+
+        usb_status uvc_streamer::submit(const rs_usb_request& r)
+        {
+            _submit_times[r.get()] = std::chrono::steady_clock::now();
+            return _context.messenger->submit_request(r);
+        }
+
+        void uvc_streamer::on_drop()
+        {
+            ++_drops;
+
+            // Host scheduling hiccups (e.g., several cameras on one hub) leave the device with nowhere to put its data:
+            // queue another request, but no more than once a second so one hiccup doesn't take us all the way up
+            auto now = std::chrono::steady_clock::now();
+            if(_requests.size() >= _context.max_request_count || now - _last_growth < std::chrono::seconds(1))
+                return;
+            _last_growth = now;
+
+            auto r = create_request();
+            auto sts = submit(r);
+            if(sts != platform::RS2_USB_STATUS_SUCCESS)
             {
-                r = _context.messenger->create_request(_read_endpoint);
-                r->set_buffer(std::vector<uint8_t>(_read_buff_length));
-                r->set_callback(_request_callback);
+                LOG_ERROR("failed to submit additional UVC request, error: " << sts);
+                return;
             }
+            _requests.push_back(r);
+            LOG_DEBUG("endpoint " << (int)_read_endpoint->get_address() << " dropped a frame; now with " << _requests.size() << " requests");
+        }
+
+        std::string uvc_streamer::latency_histogram_to_string() const
+        {
+            static const char * const buckets[] = { "<1", "<2", "<5", "<10", "<20", "<50", "<100", ">=100" };
+            std::ostringstream os;
+            for(size_t i = 0; i < _latency_histogram.size(); ++i)
+                os << (i ? " " : "") << buckets[i] << "ms:" << _latency_histogram[i];
+            return os.str();
         }
 
         void uvc_streamer::start()
@@ -161,16 +225,17 @@ namespace librealsense
                     _running = true;
                 }
 
+                std::lock_guard<std::mutex> lock(_requests_mutex);
                 for(auto&& r : _requests)
                 {
-                    auto sts = _context.messenger->submit_request(r);
+                    auto sts = submit(r);
                     if(sts != platform::RS2_USB_STATUS_SUCCESS)
                         throw std::runtime_error("failed to submit UVC request while start streaming");
                 }
 
                 _publish_frame_thread->start();
 
-            }, [this](){ return _running; });
+            }, [this](){ return _running.load(); });
         }
 
         void uvc_streamer::stop()
@@ -188,10 +253,14 @@ namespace librealsense
 
                 _queue.clear();
 
+                std::lock_guard<std::mutex> lock(_requests_mutex);
                 for(auto&& r : _requests)
                   _context.messenger->cancel_request(r);
 
+                LOG_INFO("endpoint " << (int)_read_endpoint->get_address() << " stopped with " << _requests.size()
+                         << " requests, " << _drops << " drops; completion latency " << latency_histogram_to_string());
                 _requests.clear();
+                _submit_times.clear();
 
                 _frames_archive->wait_until_empty();
 
@@ -11,6 +11,10 @@
 #include <string>
 #include <chrono>
 #include <thread>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <map>
 
 typedef void(uvc_frame_callback_t)(struct librealsense::platform::frame_object *frame, void *user_ptr);
 
@@ -26,6 +30,7 @@ namespace librealsense
             rs_usb_device usb_device;
             rs_usb_messenger messenger;
             uint8_t request_count;
+            uint8_t max_request_count;  // More requests get queued, up to this, when frames are dropped
         };
 
         class uvc_streamer
@@ -46,8 +51,8 @@ namespace librealsense
         private:
             std::mutex _running_mutex;
             std::condition_variable _stopped_cv;
-            bool _running = false;
-            bool _frame_arrived = false;
+            std::atomic<bool> _running { false };
+            std::atomic<bool> _frame_arrived { false };
             bool _publish_frames = true;
 
             int64_t _watchdog_timeout;
@@ -64,8 +69,19 @@ namespace librealsense
             std::shared_ptr<active_object<>> _publish_frame_thread;
             std::shared_ptr<platform::usb_request_callback> _request_callback;
 
+            // Completions, from submit to callback, in buckets of up to 1, 2, 5, 10, 20, 50, 100 ms and beyond
+            std::array<uint64_t, 8> _latency_histogram = {};
+            std::map<usb_request*, std::chrono::steady_clock::time_point> _submit_times;
+            std::mutex _requests_mutex;  // For all the above, and _requests
+            std::chrono::steady_clock::time_point _last_growth;
+            uint64_t _drops = 0;
+
             void init();
             void flush();
+            usb_status submit(const rs_usb_request& r);
+            rs_usb_request create_request();
+            void on_drop();
+            std::string latency_histogram_to_string() const;
         };
     }
 }
@@ -0,0 +1,30 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// What align_images() in align.cpp does for each depth pixel
+
+struct align_params
+{
+    intrinsics depth_intrin;
+    extrinsics depth_to_other;
+    intrinsics other_intrin;
+    float depth_scale;
+};
+
+// The rectangle (x0, y0, x1, y1) of the other image that a depth pixel's corners map to; x0 is -1 when the pixel has
+// no depth, or the rectangle isn't all within the other image
+ivec4 map_depth_pixel(align_params p, int x, int y, float depth)
+{
+    if (depth == 0)
+        return ivec4(-1);
+
+    vec2 p0 = project_point_to_pixel(p.other_intrin,
+        transform_point_to_point(p.depth_to_other, deproject_pixel_to_point(p.depth_intrin, vec2(x - 0.5f, y - 0.5f), depth)));
+    vec2 p1 = project_point_to_pixel(p.other_intrin,
+        transform_point_to_point(p.depth_to_other, deproject_pixel_to_point(p.depth_intrin, vec2(x + 0.5f, y + 0.5f), depth)));
+    ivec4 r = ivec4(int(p0.x + 0.5f), int(p0.y + 0.5f), int(p1.x + 0.5f), int(p1.y + 0.5f));
+
+    if (r.x < 0 || r.y < 0 || r.z >= p.other_intrin.width || r.w >= p.other_intrin.height)
+        return ivec4(-1);
+    return r;
+}
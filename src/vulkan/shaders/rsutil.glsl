@@ -0,0 +1,154 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// rsutil's projection functions: as rs2_project_point_to_pixel(), rs2_deproject_pixel_to_point() and
+// rs2_transform_point_to_point() in rs.cpp, for all distortion models. The structures are laid out like their C
+// counterparts, in std430 buffers.
+
+struct intrinsics
+{
+    int width;
+    int height;
+    float ppx;
+    float ppy;
+    float fx;
+    float fy;
+    int model;
+    float coeffs[5];
+};
+
+struct extrinsics
+{
+    float rotation[9];
+    float translation[3];
+};
+
+#define RS2_DISTORTION_NONE                     0
+#define RS2_DISTORTION_MODIFIED_BROWN_CONRADY   1
+#define RS2_DISTORTION_INVERSE_BROWN_CONRADY    2
+#define RS2_DISTORTION_FTHETA                   3
+#define RS2_DISTORTION_BROWN_CONRADY            4
+#define RS2_DISTORTION_KANNALA_BRANDT4          5
+
+#define FLT_EPSILON 1.192092896e-07
+
+vec2 project_point_to_pixel(intrinsics intrin, vec3 point)
+{
+    float x = point.x / point.z, y = point.y / point.z;
+
+    if (intrin.model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY || intrin.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY)
+    {
+        float r2 = x * x + y * y;
+        float f = 1 + intrin.coeffs[0] * r2 + intrin.coeffs[1] * r2 * r2 + intrin.coeffs[4] * r2 * r2 * r2;
+        x *= f;
+        y *= f;
+        float dx = x + 2 * intrin.coeffs[2] * x * y + intrin.coeffs[3] * (r2 + 2 * x * x);
+        float dy = y + 2 * intrin.coeffs[3] * x * y + intrin.coeffs[2] * (r2 + 2 * y * y);
+        x = dx;
+        y = dy;
+    }
+    if (intrin.model == RS2_DISTORTION_BROWN_CONRADY)
+    {
+        float r2 = x * x + y * y;
+        float f = 1 + intrin.coeffs[0] * r2 + intrin.coeffs[1] * r2 * r2 + intrin.coeffs[4] * r2 * r2 * r2;
+        float dx = x * f + 2 * intrin.coeffs[2] * x * y + intrin.coeffs[3] * (r2 + 2 * x * x);
+        float dy = y * f + 2 * intrin.coeffs[3] * x * y + intrin.coeffs[2] * (r2 + 2 * y * y);
+        x = dx;
+        y = dy;
+    }
+    if (intrin.model == RS2_DISTORTION_FTHETA)
+    {
+        float r = max(sqrt(x * x + y * y), FLT_EPSILON);
+        float rd = 1.0f / intrin.coeffs[0] * atan(2 * r * tan(intrin.coeffs[0] / 2.0f));
+        x *= rd / r;
+        y *= rd / r;
+    }
+    if (intrin.model == RS2_DISTORTION_KANNALA_BRANDT4)
+    {
+        float r = max(sqrt(x * x + y * y), FLT_EPSILON);
+        float theta = atan(r);
+        float theta2 = theta * theta;
+        float series = 1 + theta2 * (intrin.coeffs[0] + theta2 * (intrin.coeffs[1] + theta2 * (intrin.coeffs[2] + theta2 * intrin.coeffs[3])));
+        float rd = theta * series;
+        x *= rd / r;
+        y *= rd / r;
+    }
+
+    return vec2(x * intrin.fx + intrin.ppx, y * intrin.fy + intrin.ppy);
+}
+
+vec3 deproject_pixel_to_point(intrinsics intrin, vec2 pixel, float depth)
+{
+    float x = (pixel.x - intrin.ppx) / intrin.fx;
+    float y = (pixel.y - intrin.ppy) / intrin.fy;
+    float xo = x;
+    float yo = y;
+
+    if (intrin.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY)
+    {
+        for (int i = 0; i < 10; i++)
+        {
+            float r2 = x * x + y * y;
+            float icdist = 1 / (1 + ((intrin.coeffs[4] * r2 + intrin.coeffs[1]) * r2 + intrin.coeffs[0]) * r2);
+            float xq = x / icdist;
+            float yq = y / icdist;
+            float delta_x = 2 * intrin.coeffs[2] * xq * yq + intrin.coeffs[3] * (r2 + 2 * xq * xq);
+            float delta_y = 2 * intrin.coeffs[3] * xq * yq + intrin.coeffs[2] * (r2 + 2 * yq * yq);
+            x = (xo - delta_x) * icdist;
+            y = (yo - delta_y) * icdist;
+        }
+    }
+    if (intrin.model == RS2_DISTORTION_BROWN_CONRADY)
+    {
+        for (int i = 0; i < 10; i++)
+        {
+            float r2 = x * x + y * y;
+            float icdist = 1 / (1 + ((intrin.coeffs[4] * r2 + intrin.coeffs[1]) * r2 + intrin.coeffs[0]) * r2);
+            float delta_x = 2 * intrin.coeffs[2] * x * y + intrin.coeffs[3] * (r2 + 2 * x * x);
+            float delta_y = 2 * intrin.coeffs[3] * x * y + intrin.coeffs[2] * (r2 + 2 * y * y);
+            x = (xo - delta_x) * icdist;
+            y = (yo - delta_y) * icdist;
+        }
+    }
+    if (intrin.model == RS2_DISTORTION_KANNALA_BRANDT4)
+    {
+        float rd = max(sqrt(x * x + y * y), FLT_EPSILON);
+        float theta = rd;
+        float theta2 = rd * rd;
+        for (int i = 0; i < 4; i++)
+        {
+            float f = theta * (1 + theta2 * (intrin.coeffs[0] + theta2 * (intrin.coeffs[1] + theta2 * (intrin.coeffs[2] + theta2 * intrin.coeffs[3])))) - rd;
+            if (abs(f) < FLT_EPSILON)
+                break;
+            float df = 1 + theta2 * (3 * intrin.coeffs[0] + theta2 * (5 * intrin.coeffs[1] + theta2 * (7 * intrin.coeffs[2] + 9 * theta2 * intrin.coeffs[3])));
+            theta -= f / df;
+            theta2 = theta * theta;
+        }
+        float r = tan(theta);
+        x *= r / rd;
+        y *= r / rd;
+    }
+    if (intrin.model == RS2_DISTORTION_FTHETA)
+    {
+        float rd = max(sqrt(x * x + y * y), FLT_EPSILON);
+        float r = tan(intrin.coeffs[0] * rd) / atan(2 * tan(intrin.coeffs[0] / 2.0f));
+        x *= r / rd;
+        y *= r / rd;
+    }
+
+    return vec3(depth * x, depth * y, depth);
+}
+
+vec3 transform_point_to_point(extrinsics extrin, vec3 from)
+{
+    return vec3(
+        extrin.rotation[0] * from.x + extrin.rotation[3] * from.y + extrin.rotation[6] * from.z + extrin.translation[0],
+        extrin.rotation[1] * from.x + extrin.rotation[4] * from.y + extrin.rotation[7] * from.z + extrin.translation[1],
+        extrin.rotation[2] * from.x + extrin.rotation[5] * from.y + extrin.rotation[8] * from.z + extrin.translation[2]);
+}
+
+// 16-bit values, two to a word, in buffers of words: Vulkan 1.0 doesn't have 16-bit storage
+#define GET_UINT16(words, i) ((words[(i) >> 1] >> (((i) & 1) << 4)) & 0xFFFFu)
+
+// Bytes, four to a word
+#define GET_UINT8(words, i) ((words[(i) >> 2] >> (((i) & 3) << 3)) & 0xFFu)
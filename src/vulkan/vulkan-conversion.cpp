@@ -0,0 +1,99 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_VULKAN
+
+#include "vulkan-conversion.h"
+#include "vulkan-device.h"
+
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <cstring>
+
+
+namespace librealsense {
+namespace vulkan {
+
+
+static const uint32_t unpack_yuy2_spirv[] =
+#include "unpack-yuy2.comp.inc"
+;
+
+
+// Like the shader's
+enum yuy2_target : uint32_t
+{
+    TARGET_Y8,
+    TARGET_Y16,
+    TARGET_RGB8,
+    TARGET_BGR8,
+    TARGET_RGBA8,
+    TARGET_BGRA8,
+};
+
+
+bool unpack_yuy2( rs2_format format, uint8_t * const d[], const uint8_t * s, int n )
+{
+    struct
+    {
+        uint32_t count;
+        uint32_t format;
+        uint32_t bpp;
+    } params;
+
+    switch( format )
+    {
+    case RS2_FORMAT_Y8: params.format = TARGET_Y8; params.bpp = 1; break;
+    case RS2_FORMAT_Y16: params.format = TARGET_Y16; params.bpp = 2; break;
+    case RS2_FORMAT_RGB8: params.format = TARGET_RGB8; params.bpp = 3; break;
+    case RS2_FORMAT_BGR8: params.format = TARGET_BGR8; params.bpp = 3; break;
+    case RS2_FORMAT_RGBA8: params.format = TARGET_RGBA8; params.bpp = 4; break;
+    case RS2_FORMAT_BGRA8: params.format = TARGET_BGRA8; params.bpp = 4; break;
+    default:
+        return false;
+    }
+    params.count = uint32_t( n );
+
+    auto dev = device::get();
+    if( ! dev )
+        return false;
+
+    // Conversions run on the sensors' threads: each has its own kernel and buffers
+    struct state
+    {
+        std::shared_ptr< kernel > unpack;
+        std::shared_ptr< buffer > params, src, dst;
+    };
+    thread_local state the_state;
+    auto & st = the_state;
+
+    try
+    {
+        if( ! st.unpack )
+            st.unpack = std::make_shared< kernel >( dev, unpack_yuy2_spirv, sizeof( unpack_yuy2_spirv ), 3, 256 );
+
+        auto & p = buffer::reserve( st.params, dev, sizeof( params ) );
+        std::memcpy( p.data(), &params, sizeof( params ) );
+        auto & src = buffer::reserve( st.src, dev, size_t( n ) * 2 );
+        std::memcpy( src.data(), s, size_t( n ) * 2 );
+        size_t const dst_size = size_t( n ) * params.bpp;
+        auto & dst = buffer::reserve( st.dst, dev, dst_size );
+
+        dev->run( [&]( VkCommandBuffer commands ) {
+            st.unpack->dispatch( commands, { &p, &src, &dst }, uint32_t( ( dst_size + 3 ) / 4 ) );
+        } );
+        std::memcpy( d[0], dst.data(), dst_size );
+    }
+    catch( std::exception const & e )
+    {
+        LOG_ERROR( "Vulkan YUY2 conversion failed; converting on the CPU: " << e.what() );
+        return false;
+    }
+    return true;
+}
+
+
+}  // namespace vulkan
+}  // namespace librealsense
+
+#endif  // RS2_USE_VULKAN
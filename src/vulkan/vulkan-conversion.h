@@ -0,0 +1,24 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#ifdef RS2_USE_VULKAN
+
+#include <librealsense2/h/rs_sensor.h>
+
+#include <cstdint>
+
+
+namespace librealsense {
+namespace vulkan {
+
+
+// unpack_yuy2() of 'n' pixels into 'format' (Y8, Y16, RGB8, BGR8, RGBA8 or BGRA8), on the Vulkan device. False when
+// there's no device, or the format isn't one of those, for the CPU to do it.
+bool unpack_yuy2( rs2_format format, uint8_t * const d[], const uint8_t * s, int n );
+
+
+}  // namespace vulkan
+}  // namespace librealsense
+
+#endif  // RS2_USE_VULKAN
@@ -0,0 +1,447 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_VULKAN
+
+#include "vulkan-device.h"
+
+#include <rsutils/easylogging/easyloggingpp.h>
+#include <rsutils/json.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace librealsense {
+namespace vulkan {
+
+
+static bool the_enabled = true;
+static int the_device_index = -1;  // The first discrete GPU, or else the first device
+
+
+void configure( rsutils::json const & settings )
+{
+    the_enabled = settings.nested( "enabled" ).default_value( true );
+    the_device_index = settings.nested( "device" ).default_value( -1 );
+}
+
+
+static void check( VkResult res, char const * what )
+{
+    if( res != VK_SUCCESS )
+        throw std::runtime_error( std::string( what ) + " failed: VkResult " + std::to_string( int( res ) ) );
+}
+
+
+static std::shared_ptr< device > create_device()
+{
+    VkApplicationInfo app = {};
+    app.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    app.pApplicationName = "librealsense";
+    app.apiVersion = VK_API_VERSION_1_0;
+
+    // No extensions: there's no surface to present to
+    VkInstanceCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    info.pApplicationInfo = &app;
+
+    VkInstance instance;
+    check( vkCreateInstance( &info, nullptr, &instance ), "vkCreateInstance" );
+
+    uint32_t count = 0;
+    vkEnumeratePhysicalDevices( instance, &count, nullptr );
+    std::vector< VkPhysicalDevice > physicals( count );
+    vkEnumeratePhysicalDevices( instance, &count, physicals.data() );
+
+    // The devices that can compute, and the queue family each does it with
+    std::vector< std::pair< VkPhysicalDevice, uint32_t > > candidates;
+    for( auto physical : physicals )
+    {
+        uint32_t families = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties( physical, &families, nullptr );
+        std::vector< VkQueueFamilyProperties > props( families );
+        vkGetPhysicalDeviceQueueFamilyProperties( physical, &families, props.data() );
+        for( uint32_t f = 0; f < families; ++f )
+        {
+            if( props[f].queueFlags & VK_QUEUE_COMPUTE_BIT )
+            {
+                candidates.emplace_back( physical, f );
+                break;
+            }
+        }
+    }
+
+    int index = the_device_index;
+    if( index < 0 )
+    {
+        index = 0;
+        for( int i = 0; i < int( candidates.size() ); ++i )
+        {
+            VkPhysicalDeviceProperties props;
+            vkGetPhysicalDeviceProperties( candidates[i].first, &props );
+            if( props.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU )
+            {
+                index = i;
+                break;
+            }
+        }
+    }
+    if( index >= int( candidates.size() ) )
+    {
+        vkDestroyInstance( instance, nullptr );
+        if( candidates.empty() )
+            LOG_INFO( "no Vulkan device to compute on; processing on the CPU" );
+        else
+            LOG_ERROR( "invalid Vulkan device " << index << " in the context settings; processing on the CPU" );
+        return nullptr;
+    }
+
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties( candidates[index].first, &props );
+    LOG_INFO( "Vulkan processing on " << props.deviceName );
+    try
+    {
+        return std::make_shared< device >( instance, candidates[index].first, candidates[index].second );
+    }
+    catch( ... )
+    {
+        vkDestroyInstance( instance, nullptr );
+        throw;
+    }
+}
+
+
+/*static*/ std::shared_ptr< device > device::get()
+{
+    static std::mutex mutex;
+    static std::shared_ptr< device > the_device;
+    static bool tried = false;
+
+    std::lock_guard< std::mutex > lock( mutex );
+    if( ! tried && the_enabled )
+    {
+        tried = true;
+        try
+        {
+            the_device = create_device();
+        }
+        catch( std::exception const & e )
+        {
+            LOG_ERROR( "failed to initialize Vulkan; processing on the CPU: " << e.what() );
+        }
+    }
+    return the_device;
+}
+
+
+device::device( VkInstance instance, VkPhysicalDevice physical, uint32_t queue_family )
+    : _instance( instance )
+    , _physical( physical )
+{
+    float const priority = 1.f;
+    VkDeviceQueueCreateInfo queue = {};
+    queue.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue.queueFamilyIndex = queue_family;
+    queue.queueCount = 1;
+    queue.pQueuePriorities = &priority;
+
+    VkDeviceCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    info.queueCreateInfoCount = 1;
+    info.pQueueCreateInfos = &queue;
+    check( vkCreateDevice( physical, &info, nullptr, &_device ), "vkCreateDevice" );
+    vkGetDeviceQueue( _device, queue_family, 0, &_queue );
+
+    VkCommandPoolCreateInfo pool = {};
+    pool.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    pool.queueFamilyIndex = queue_family;
+    check( vkCreateCommandPool( _device, &pool, nullptr, &_pool ), "vkCreateCommandPool" );
+
+    VkCommandBufferAllocateInfo alloc = {};
+    alloc.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    alloc.commandPool = _pool;
+    alloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    alloc.commandBufferCount = 1;
+    check( vkAllocateCommandBuffers( _device, &alloc, &_commands ), "vkAllocateCommandBuffers" );
+
+    VkFenceCreateInfo fence = {};
+    fence.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    check( vkCreateFence( _device, &fence, nullptr, &_done ), "vkCreateFence" );
+}
+
+
+device::~device()
+{
+    if( _device )
+    {
+        vkDeviceWaitIdle( _device );
+        if( _done )
+            vkDestroyFence( _device, _done, nullptr );
+        if( _pool )
+            vkDestroyCommandPool( _device, _pool, nullptr );
+        vkDestroyDevice( _device, nullptr );
+    }
+    vkDestroyInstance( _instance, nullptr );
+}
+
+
+void device::run( std::function< void( VkCommandBuffer ) > const & record )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    VkCommandBufferBeginInfo begin = {};
+    begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    check( vkBeginCommandBuffer( _commands, &begin ), "vkBeginCommandBuffer" );
+    record( _commands );
+
+    // What was written is for the host to read once we're done
+    VkMemoryBarrier b = {};
+    b.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    b.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    b.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier( _commands,
+                          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                          VK_PIPELINE_STAGE_HOST_BIT,
+                          0, 1, &b, 0, nullptr, 0, nullptr );
+
+    check( vkEndCommandBuffer( _commands ), "vkEndCommandBuffer" );
+
+    VkSubmitInfo submit = {};
+    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &_commands;
+    check( vkQueueSubmit( _queue, 1, &submit, _done ), "vkQueueSubmit" );
+    auto res = vkWaitForFences( _device, 1, &_done, VK_TRUE, UINT64_MAX );
+    vkResetFences( _device, 1, &_done );
+    check( res, "vkWaitForFences" );
+}
+
+
+buffer::buffer( std::shared_ptr< device > const & dev, size_t size )
+    : _device( dev )
+    , _size( size )
+{
+    auto vk = _device->handle();
+
+    VkBufferCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    info.size = size;
+    info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    check( vkCreateBuffer( vk, &info, nullptr, &_buffer ), "vkCreateBuffer" );
+
+    VkMemoryRequirements needs;
+    vkGetBufferMemoryRequirements( vk, _buffer, &needs );
+    VkPhysicalDeviceMemoryProperties props;
+    vkGetPhysicalDeviceMemoryProperties( _device->physical(), &props );
+
+    // Coherent, so there's nothing to flush; cached too if there's such, for the host to read the output faster
+    VkMemoryPropertyFlags const required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    int type = -1;
+    for( uint32_t i = 0; i < props.memoryTypeCount; ++i )
+    {
+        if( ! ( needs.memoryTypeBits & ( 1u << i ) ) || ( props.memoryTypes[i].propertyFlags & required ) != required )
+            continue;
+        if( type < 0 || ( props.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT ) )
+            type = int( i );
+    }
+    if( type < 0 )
+    {
+        vkDestroyBuffer( vk, _buffer, nullptr );
+        throw std::runtime_error( "no Vulkan memory visible to the host" );
+    }
+
+    VkMemoryAllocateInfo alloc = {};
+    alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc.allocationSize = needs.size;
+    alloc.memoryTypeIndex = uint32_t( type );
+    auto res = vkAllocateMemory( vk, &alloc, nullptr, &_memory );
+    if( res == VK_SUCCESS )
+    {
+        vkBindBufferMemory( vk, _buffer, _memory, 0 );
+        res = vkMapMemory( vk, _memory, 0, VK_WHOLE_SIZE, 0, &_data );
+    }
+    if( res != VK_SUCCESS )
+    {
+        if( _memory )
+            vkFreeMemory( vk, _memory, nullptr );
+        vkDestroyBuffer( vk, _buffer, nullptr );
+        check( res, "vkAllocateMemory" );
+    }
+}
+
+
+buffer::~buffer()
+{
+    auto vk = _device->handle();
+    vkUnmapMemory( vk, _memory );
+    vkFreeMemory( vk, _memory, nullptr );
+    vkDestroyBuffer( vk, _buffer, nullptr );
+}
+
+
+/*static*/ buffer & buffer::reserve( std::shared_ptr< buffer > & b, std::shared_ptr< device > const & dev, size_t size )
+{
+    // Shaders see the memory as words
+    size = ( std::max< size_t >( size, 1 ) + 3 ) / 4 * 4;
+    if( ! b || b->size() < size )
+    {
+        b.reset();
+        b = std::make_shared< buffer >( dev, size );
+    }
+    return *b;
+}
+
+
+kernel::kernel( std::shared_ptr< device > const & dev,
+                uint32_t const * spirv,
+                size_t spirv_size,
+                uint32_t bindings,
+                uint32_t group_x,
+                uint32_t group_y )
+    : _device( dev )
+    , _bindings( bindings )
+    , _group_x( group_x )
+    , _group_y( group_y )
+{
+    auto vk = _device->handle();
+
+    VkShaderModuleCreateInfo module = {};
+    module.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    module.codeSize = spirv_size;
+    module.pCode = spirv;
+    check( vkCreateShaderModule( vk, &module, nullptr, &_shader ), "vkCreateShaderModule" );
+
+    std::vector< VkDescriptorSetLayoutBinding > layout_bindings( bindings );
+    for( uint32_t i = 0; i < bindings; ++i )
+    {
+        auto & b = layout_bindings[i];
+        b = {};
+        b.binding = i;
+        b.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        b.descriptorCount = 1;
+        b.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+    VkDescriptorSetLayoutCreateInfo set_layout = {};
+    set_layout.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    set_layout.bindingCount = bindings;
+    set_layout.pBindings = layout_bindings.data();
+    check( vkCreateDescriptorSetLayout( vk, &set_layout, nullptr, &_set_layout ), "vkCreateDescriptorSetLayout" );
+
+    VkPipelineLayoutCreateInfo layout = {};
+    layout.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layout.setLayoutCount = 1;
+    layout.pSetLayouts = &_set_layout;
+    check( vkCreatePipelineLayout( vk, &layout, nullptr, &_layout ), "vkCreatePipelineLayout" );
+
+    VkComputePipelineCreateInfo pipeline = {};
+    pipeline.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipeline.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipeline.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipeline.stage.module = _shader;
+    pipeline.stage.pName = "main";
+    pipeline.layout = _layout;
+    check( vkCreateComputePipelines( vk, VK_NULL_HANDLE, 1, &pipeline, nullptr, &_pipeline ),
+           "vkCreateComputePipelines" );
+
+    VkDescriptorPoolSize pool_size = {};
+    pool_size.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    pool_size.descriptorCount = bindings;
+    VkDescriptorPoolCreateInfo pool = {};
+    pool.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool.maxSets = 1;
+    pool.poolSizeCount = 1;
+    pool.pPoolSizes = &pool_size;
+    check( vkCreateDescriptorPool( vk, &pool, nullptr, &_pool ), "vkCreateDescriptorPool" );
+
+    VkDescriptorSetAllocateInfo alloc = {};
+    alloc.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc.descriptorPool = _pool;
+    alloc.descriptorSetCount = 1;
+    alloc.pSetLayouts = &_set_layout;
+    check( vkAllocateDescriptorSets( vk, &alloc, &_set ), "vkAllocateDescriptorSets" );
+}
+
+
+kernel::~kernel()
+{
+    auto vk = _device->handle();
+    vkDestroyDescriptorPool( vk, _pool, nullptr );
+    vkDestroyPipeline( vk, _pipeline, nullptr );
+    vkDestroyPipelineLayout( vk, _layout, nullptr );
+    vkDestroyDescriptorSetLayout( vk, _set_layout, nullptr );
+    vkDestroyShaderModule( vk, _shader, nullptr );
+}
+
+
+void kernel::dispatch( VkCommandBuffer commands,
+                       std::initializer_list< buffer * > buffers,
+                       uint32_t width,
+                       uint32_t height )
+{
+    if( buffers.size() != _bindings )
+        throw std::runtime_error( "kernel has " + std::to_string( _bindings ) + " bindings, not "
+                                  + std::to_string( buffers.size() ) );
+
+    // The command buffer isn't pending: run() waited for the last submission
+    std::vector< VkDescriptorBufferInfo > infos;
+    std::vector< VkWriteDescriptorSet > writes;
+    infos.reserve( _bindings );
+    for( auto b : buffers )
+        infos.push_back( { b->handle(), 0, VK_WHOLE_SIZE } );
+    for( uint32_t i = 0; i < _bindings; ++i )
+    {
+        VkWriteDescriptorSet write = {};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = _set;
+        write.dstBinding = i;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = &infos[i];
+        writes.push_back( write );
+    }
+    vkUpdateDescriptorSets( _device->handle(), _bindings, writes.data(), 0, nullptr );
+
+    vkCmdBindPipeline( commands, VK_PIPELINE_BIND_POINT_COMPUTE, _pipeline );
+    vkCmdBindDescriptorSets( commands, VK_PIPELINE_BIND_POINT_COMPUTE, _layout, 0, 1, &_set, 0, nullptr );
+    vkCmdDispatch( commands, ( width + _group_x - 1 ) / _group_x, ( height + _group_y - 1 ) / _group_y, 1 );
+}
+
+
+void barrier( VkCommandBuffer commands )
+{
+    VkMemoryBarrier b = {};
+    b.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    b.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    b.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier( commands,
+                          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                          0, 1, &b, 0, nullptr, 0, nullptr );
+}
+
+
+void fill( VkCommandBuffer commands, buffer & buf, uint32_t value )
+{
+    vkCmdFillBuffer( commands, buf.handle(), 0, VK_WHOLE_SIZE, value );
+
+    VkMemoryBarrier b = {};
+    b.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    b.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    b.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier( commands,
+                          VK_PIPELINE_STAGE_TRANSFER_BIT,
+                          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                          0, 1, &b, 0, nullptr, 0, nullptr );
+}
+
+
+}  // namespace vulkan
+}  // namespace librealsense
+
+#endif  // RS2_USE_VULKAN
@@ -0,0 +1,139 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#ifdef RS2_USE_VULKAN
+
+#include <rsutils/json-fwd.h>
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+
+
+namespace librealsense {
+namespace vulkan {
+
+
+// The "vulkan" context settings:
+//     "vulkan": { "enabled": true, "device": 0 }
+// 'device' is an index among the devices that can compute; by default, the first discrete GPU is used, if any
+void configure( rsutils::json const & settings );
+
+
+class buffer;
+
+
+// A Vulkan device to compute on, through a queue of its own: nothing is ever presented, so there's no need for a
+// window or a display, as there is with GL. Made when it's first asked for.
+class device : public std::enable_shared_from_this< device >
+{
+public:
+    // The device of the context settings, or null when there's none (or Vulkan is disabled), for the processing
+    // blocks to do their work on the CPU
+    static std::shared_ptr< device > get();
+
+    device( VkInstance instance, VkPhysicalDevice physical, uint32_t queue_family );
+    ~device();
+
+    device( device const & ) = delete;
+    device & operator=( device const & ) = delete;
+
+    VkDevice handle() const { return _device; }
+    VkPhysicalDevice physical() const { return _physical; }
+
+    // Records the commands, submits them and waits for them to be done. Submissions are one at a time, whoever
+    // they're from.
+    void run( std::function< void( VkCommandBuffer ) > const & record );
+
+private:
+    VkInstance _instance;
+    VkPhysicalDevice _physical;
+    VkDevice _device = VK_NULL_HANDLE;
+    VkQueue _queue = VK_NULL_HANDLE;
+    VkCommandPool _pool = VK_NULL_HANDLE;
+    VkCommandBuffer _commands = VK_NULL_HANDLE;
+    VkFence _done = VK_NULL_HANDLE;
+    std::mutex _mutex;
+};
+
+
+// Memory that's visible to both the host and the device, and stays mapped: the host writes the input and reads the
+// output in place
+class buffer
+{
+public:
+    buffer( std::shared_ptr< device > const & dev, size_t size );
+    ~buffer();
+
+    buffer( buffer const & ) = delete;
+    buffer & operator=( buffer const & ) = delete;
+
+    VkBuffer handle() const { return _buffer; }
+    size_t size() const { return _size; }
+    void * data() const { return _data; }
+
+    // Makes sure 'b' has at least 'size' bytes, making it again when it doesn't
+    static buffer & reserve( std::shared_ptr< buffer > & b, std::shared_ptr< device > const & dev, size_t size );
+
+private:
+    std::shared_ptr< device > _device;
+    VkBuffer _buffer = VK_NULL_HANDLE;
+    VkDeviceMemory _memory = VK_NULL_HANDLE;
+    size_t _size;
+    void * _data = nullptr;
+};
+
+
+// A compute shader's pipeline, from its SPIR-V, with storage buffers for all its bindings. Its groups are 'group_x'
+// by 'group_y' invocations: the shader's local size.
+//
+// Like the descriptors it binds, a kernel can only be dispatched once per submission; not thread-safe.
+class kernel
+{
+public:
+    kernel( std::shared_ptr< device > const & dev,
+            uint32_t const * spirv,
+            size_t spirv_size,
+            uint32_t bindings,
+            uint32_t group_x,
+            uint32_t group_y = 1 );
+    ~kernel();
+
+    kernel( kernel const & ) = delete;
+    kernel & operator=( kernel const & ) = delete;
+
+    // Binds the buffers, in order, and dispatches enough groups for 'width' by 'height' invocations
+    void dispatch( VkCommandBuffer commands,
+                   std::initializer_list< buffer * > buffers,
+                   uint32_t width,
+                   uint32_t height = 1 );
+
+private:
+    std::shared_ptr< device > _device;
+    uint32_t _bindings;
+    uint32_t _group_x, _group_y;
+    VkShaderModule _shader = VK_NULL_HANDLE;
+    VkDescriptorSetLayout _set_layout = VK_NULL_HANDLE;
+    VkPipelineLayout _layout = VK_NULL_HANDLE;
+    VkPipeline _pipeline = VK_NULL_HANDLE;
+    VkDescriptorPool _pool = VK_NULL_HANDLE;
+    VkDescriptorSet _set = VK_NULL_HANDLE;
+};
+
+
+// Between the dispatches of a submission: what the shaders wrote before it is what they read after it
+void barrier( VkCommandBuffer commands );
+
+// Fills a buffer with a 32-bit value, as something for the shaders after it to read
+void fill( VkCommandBuffer commands, buffer & b, uint32_t value );
+
+
+}  // namespace vulkan
+}  // namespace librealsense
+
+#endif  // RS2_USE_VULKAN
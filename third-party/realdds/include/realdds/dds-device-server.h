@@ -33,6 +33,7 @@ namespace realdds {
 // Forward declaration
 namespace topics {
 class flexible_msg;
+class metadata_msg;
 class device_info;
 namespace raw {
 class device_info;
@@ -97,6 +98,7 @@ public:
 
     void publish_notification( topics::flexible_msg && );
     void publish_metadata( rsutils::json && );
+    void publish_metadata( topics::metadata_msg && );  // Binary, for when JSON is too costly
 
     bool has_metadata_readers() const;
 
@@ -112,12 +114,14 @@ public:
     std::shared_ptr< dds_option > find_option( std::string const & option_name, std::string const & stream_name ) const;
     // Same as find_options, except throws if not found
     std::shared_ptr< dds_option > get_option( std::string const & option_name, std::string const & stream_name ) const;
+    rsutils::json set_option( std::shared_ptr< dds_option > const &, rsutils::json value );
 
 private:
     struct control_sample;
 
     void on_control_message_received();
     void on_set_option( control_sample const &, rsutils::json & reply );
+    void on_set_options( control_sample const &, rsutils::json & reply );
     void on_query_option( control_sample const &, rsutils::json & reply );
     void on_query_options( control_sample const &, rsutils::json & reply );
 
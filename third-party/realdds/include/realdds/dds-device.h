@@ -56,6 +56,11 @@ public:
     // Wait until ready. Will throw if not ready within the timeout!
     void wait_until_ready( size_t timeout_ms = 5000 );
 
+    // Once ready, how long each phase of the initialization (see docs/initialization.md) took, in milliseconds, e.g.:
+    //     { "device-header": 250.1, "device-options": 1.2, "stream-header": 10.5, "stream-options": 8.3,
+    //       "total": 270.1, "from-cache": false }
+    rsutils::json const & init_timing() const;
+
     // A device is offline when discovery is lost, and assumed online otherwise
     bool is_online() const;
     bool is_offline() const { return ! is_online(); }
@@ -76,9 +81,19 @@ public:
     size_t foreach_stream( std::function< void( std::shared_ptr< dds_stream > stream ) > fn ) const;
     size_t foreach_option( std::function< void( std::shared_ptr< dds_option > option ) > fn ) const;
 
+    // What's been received by each open stream and the metadata and notification readers (see dds_reader_statistics):
+    //     { "streams": { "Depth": { "received": 300, ... }, ... }, "metadata": { ... }, "notification": { ... } }
+    rsutils::json get_statistics() const;
+
     void open( const dds_stream_profiles & profiles );
 
     void set_option_value( const std::shared_ptr< dds_option > & option, rsutils::json new_value );
+    // Many options in a single round trip ("set-options"), set in order. The reply updates the local values, same as
+    // set_option_value(), with the values actually set; if any failed, the rest are still set and this throws.
+    // Without waiting for the reply, calls can be pipelined: the values update (and errors are only logged) as the
+    // replies come in.
+    void set_option_values( std::vector< std::pair< std::shared_ptr< dds_option >, rsutils::json > > const &,
+                            bool wait_for_reply = true );
     rsutils::json query_option_value( const std::shared_ptr< dds_option > & option );
 
     void send_control( topics::flexible_msg &&, rsutils::json * reply = nullptr );
@@ -88,6 +103,7 @@ public:
 
     bool supports_metadata() const;
 
+    // Metadata is either JSON or, if the server sends it binary, a JSON binary value holding a topics::metadata_msg
     typedef std::function< void( std::shared_ptr< const rsutils::json > const & md ) > on_metadata_available_callback;
     rsutils::subscription on_metadata_available( on_metadata_available_callback && );
 
@@ -4,10 +4,11 @@
 
 #include <rsutils/json.h>
 
-#include <deque>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <functional>
+#include <type_traits>
 
 
 namespace realdds {
@@ -30,14 +31,18 @@ namespace realdds {
 //          - else no guarantee is made to callback ordering!
 //     - metadata is likely to arrive first because the messages are much smaller
 //
+// Both queues are fixed-size rings, so nothing is allocated (or freed) under the lock, which is only ever held for a
+// few pointer moves: the callbacks are all called outside it. It cannot go away entirely, since both threads consume
+// both queues and the frames must still come out in order.
+//
 class dds_metadata_syncer
 {
 public:
     // We don't want the queue to get large, it means lots of drops and data that we store to (probably) throw later
-    static const size_t max_md_queue_size;
+    static constexpr size_t max_md_queue_size = 8;
     // If a metadata is lost we wait for it until the next frame arrives, causing a small delay but we prefer passing
     // the frame late and without metadata over losing it.
-    static const size_t max_frame_queue_size;
+    static constexpr size_t max_frame_queue_size = 2;
 
     // We synchronize using some abstract "key" used to identify each frame and its metadata. We don't need to know
     // the nature of the key; only that it is increasing in value over time so that, given key1 > key2, then key1
@@ -61,14 +66,62 @@ public:
     // And we provide other callbacks, for control, testing, etc.
     typedef std::function< void( key_type, metadata_type const & ) > on_metadata_dropped_callback;
 
+    // Counts since construction, to see how well the queue sizes fit the actual streams
+    struct statistics
+    {
+        uint64_t matched = 0;                  // Frames issued with their metadata
+        uint64_t frames_without_metadata = 0;  // Frames issued without
+        uint64_t metadata_dropped = 0;         // Metadata that never matched: too many queued, or its frame is gone
+    };
+
 private:
     using key_frame = std::pair< key_type, frame_holder >;
     using key_metadata = std::pair< key_type, metadata_type >;
 
-    std::deque< key_frame > _frame_queue;
-    std::deque< key_metadata > _metadata_queue;
+    // Room for one more than the maximum: we push before we get rid of the extra
+    template< class T, size_t N >
+    class ring
+    {
+        typename std::aligned_storage< sizeof( T ), alignof( T ) >::type _items[N];
+        size_t _begin = 0;
+        size_t _size = 0;
+
+        T * at( size_t i ) { return reinterpret_cast< T * >( &_items[( _begin + i ) % N] ); }
+
+    public:
+        ring() = default;
+        ring( ring const & ) = delete;
+        ~ring() { clear(); }
+
+        bool empty() const { return ! _size; }
+        size_t size() const { return _size; }
+
+        T & front() { return *at( 0 ); }
+        T & back() { return *at( _size - 1 ); }
+
+        // Callers make sure there's room
+        void push_back( T && item ) { new( at( _size++ ) ) T( std::move( item ) ); }
+        void pop_front()
+        {
+            at( 0 )->~T();
+            _begin = ( _begin + 1 ) % N;
+            --_size;
+        }
+        void clear()
+        {
+            while( _size )
+                pop_front();
+        }
+    };
+
+    ring< key_frame, max_frame_queue_size + 1 > _frame_queue;
+    ring< key_metadata, max_md_queue_size + 1 > _metadata_queue;
     std::mutex _queues_lock;
 
+    std::atomic< uint64_t > _n_matched{ 0 };
+    std::atomic< uint64_t > _n_frames_without_metadata{ 0 };
+    std::atomic< uint64_t > _n_metadata_dropped{ 0 };
+
     on_frame_release_callback _on_frame_release;
     on_frame_ready_callback _on_frame_ready;
     on_metadata_dropped_callback _on_metadata_dropped;
@@ -86,6 +139,8 @@ public:
     void on_frame_ready( on_frame_ready_callback cb ) { _on_frame_ready = cb; }
     void on_metadata_dropped( on_metadata_dropped_callback cb ) { _on_metadata_dropped = cb; }
 
+    statistics get_statistics() const;
+
     // Helper to create frame_holder
     template< class Frame >
     inline frame_holder hold( Frame * frame ) const
@@ -32,7 +32,9 @@ public:
 
     dds_guid const & guid() const;
 
-    // By default we're not running, to avoid on-discovery before all discovery messages have been collected
+    // By default we're not running, to avoid on-discovery before all discovery messages have been collected. Once they
+    // are, they're batched into as few messages as possible unless the 'device/notification/batch-discovery' setting
+    // is false.
     void run();
     bool is_running() const { return _active; }
 
@@ -45,6 +47,7 @@ public:
     void trigger_discovery_notifications();
 
 private:
+    void batch_discovery_notifications();
     void send_discovery_notifications();
 
     std::shared_ptr< dds_publisher > _publisher;
@@ -4,6 +4,7 @@
 
 #include <rsutils/json.h>
 #include <rsutils/string/ip-address.h>
+#include <rsutils/signal.h>
 
 #include <string>
 #include <vector>
@@ -51,6 +52,8 @@ protected:
     rsutils::json _maximum_value;
     rsutils::json _stepping;
 
+    rsutils::signal< rsutils::json const & > _on_value_changed;
+
 private:
     friend class dds_stream_base;
     std::weak_ptr< dds_stream_base > _stream;
@@ -90,6 +93,14 @@ public:
     virtual void check_value( rsutils::json & ) const;
     virtual void check_type( rsutils::json & ) const = 0;
 
+    // Called with the new value whenever set_value() changes it: as the device replies or notifies of it, on the
+    // client side. Not for init_value().
+    typedef std::function< void( rsutils::json const & value ) > on_value_changed_callback;
+    rsutils::subscription on_value_changed( on_value_changed_callback && cb )
+    {
+        return _on_value_changed.subscribe( std::move( cb ) );
+    }
+
     rsutils::json const & get_default_value() const { return _default_value; }
     bool is_default_valid() const { return ! get_default_value().is_null(); }
 
@@ -0,0 +1,63 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include "dds-defines.h"
+
+#include <rsutils/json-fwd.h>
+#include <mutex>
+
+
+namespace eprosima {
+namespace fastdds {
+namespace dds {
+struct SampleInfo;
+}  // namespace dds
+}  // namespace fastdds
+}  // namespace eprosima
+
+
+namespace realdds {
+
+
+// What a reader got, for telling where samples are lost or delayed: the network (lost, latency), the writer (the
+// samples per second it sends) or the reader itself (queue depth, time spent in callbacks).
+//
+// Samples are recorded by whoever takes them, with their size and their latency: the time between the writer's
+// source-timestamp and our reception-timestamp. Between hosts this includes any difference between their clocks!
+//
+// Updates and queries can come from different threads.
+//
+class dds_reader_statistics
+{
+public:
+    struct values
+    {
+        uint64_t received = 0;
+        uint64_t lost = 0;  // As reported by DDS, from gaps in the sequence numbers
+        uint64_t bytes = 0;
+        dds_nsec latency_min = 0, latency_max = 0, latency_total = 0;  // Over 'received'
+        uint64_t callbacks = 0;
+        dds_nsec callback_max = 0, callback_total = 0;
+        uint64_t queue_max = 0;  // Samples waiting at the start of a callback
+
+        // E.g., { "received": 300, "lost": 2, "bytes": 276480000, "latency-ms": { "min": ..., "avg": ..., "max": ... },
+        //         "callbacks": 290, "callback-ms": { "avg": ..., "max": ... }, "queue-max": 3 }
+        rsutils::json to_json() const;
+    };
+
+    void on_sample( size_t bytes, dds_nsec latency );
+    void on_sample( size_t bytes, eprosima::fastdds::dds::SampleInfo const & );  // Latency from the timestamps
+    void on_lost( uint64_t count );
+    void on_callback( dds_nsec duration, uint64_t queue_depth );
+
+    values get() const;
+    void reset();
+
+private:
+    mutable std::mutex _mutex;
+    values _values;
+};
+
+
+}  // namespace realdds
@@ -6,6 +6,7 @@
 
 #include <rsutils/json-fwd.h>
 #include <iosfwd>
+#include <string>
 
 
 namespace eprosima {
@@ -101,21 +102,57 @@ void override_liveliness_qos_from_json( eprosima::fastdds::dds::LivelinessQosPol
 //
 void override_data_sharing_qos_from_json( eprosima::fastdds::dds::DataSharingQosPolicy & qos, rsutils::json const & );
 
+// Override QoS time-based filter from a JSON source.
+// The JSON is the minimum separation between samples, in seconds:
+//      "time-based-filter": 0.2  // <-- at most 5 samples per second
+//
+void override_time_based_filter_qos_from_json( eprosima::fastdds::dds::TimeBasedFilterQosPolicy & qos,
+                                               rsutils::json const & );
+
 // Override QoS endpoint from a JSON source.
 // The JSON is an object:
 //      {
-//          "history-memory-policy": "preallocated-with-realloc"
+//          "history-memory-policy": "preallocated-with-realloc",
+//          "multicast": "239.255.0.1:7900"  // or an array of them
 //      }
+// Readers that share a multicast locator get each sample from a writer in a single send.
 //
 void override_endpoint_qos_from_json( eprosima::fastdds::dds::RTPSEndpointQos & qos, rsutils::json const & );
 
+// Override QoS publish-mode (writers only) from a JSON source.
+// The JSON can be a simple string indicating the kind:
+//      "publish-mode": "asynchronous"
+// If an object, a flow controller (registered with the participant; see below) can be named:
+//      "publish-mode": {
+//          "kind": "asynchronous",
+//          "flow-controller": "large-data"
+//          }
+// A flow controller implies asynchronous publishing.
+//
+void override_publish_mode_qos_from_json( eprosima::fastdds::dds::PublishModeQosPolicy & qos, rsutils::json const & );
+
+// Built-in QoS presets, selected with a "profile" key alongside the other QoS settings (which then override it):
+//      "default"              // Nothing changes
+//      "large-data"           // Asynchronous publishing through the "large-data" flow controller
+//      "large-data-reliable"  // Same, but reliable with a history of 1: lost fragments are resent
+//      "auto"                 // Like "default"; for streams, the server picks "large-data" for big images
+// Throws for an unknown profile.
+//
+rsutils::json const & qos_profile( std::string const & name );
+
 
 // Override participant QoS from a JSON source.
 // The JSON is an object:
 //      {
 //          "participant-id": -1,
 //          "lease-duration": 10,  // seconds
+//          "flow-controllers": {
+//              "large-data": { "max-bytes-per-period": 1000000, "period-ms": 10, "scheduler": "fifo" }
+//              },
+//          "shm": true,           // or { "segment-size": 4194304 }: add the FastDDS shared-memory transport
+//          "tcp": { "port": 7400, "peers": [ "192.168.1.10:7400" ] }  // add a TCPv4 transport
 //      }
+// Flow controllers are updated by name, or added. None of these transports replace UDP: they're in addition to it.
 //
 void override_participant_qos_from_json( eprosima::fastdds::dds::DomainParticipantQos & qos, rsutils::json const & );
 
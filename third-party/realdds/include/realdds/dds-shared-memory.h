@@ -0,0 +1,86 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+namespace realdds {
+
+
+// Frames handed to readers on the same host through shared memory, rather than inside the messages.
+//
+// The writer keeps a ring of slots in a named segment, one frame per slot. The message only carries a reference to
+// the slot (a dds_shm_ref) and the reader maps the segment and uses the frame right where it is, for as long as it
+// holds on to it. Slots are reference-counted in the segment itself: the writer only reuses slots nobody holds, and a
+// reader that gets to a slot after it's been reused can tell from its sequence number, and drops the frame.
+//
+// The frames can also be produced right in the slots (see allocate()), for instance by a frame allocator, so they're
+// published without any copy at all.
+//
+// A reader that dies holding a frame leaves its slot taken for the life of the segment; the writer just has one slot
+// less to go around. Where shared memory isn't available (Windows, for now), the writer can't be created and the
+// reader never gets anything.
+//
+struct dds_shm_ref
+{
+    static constexpr uint64_t MAGIC = 0x316d68732d736472ull;  // "rds-shm1"
+
+    uint64_t magic = MAGIC;
+    uint64_t segment_id = 0;  // Unique to each segment, so a reader notices a writer that's been restarted
+    uint64_t sequence = 0;    // Of the frame in the slot
+    uint32_t slot = 0;
+    uint32_t size = 0;
+    char segment_name[48] = {};
+
+    // Returns false if the bytes aren't a reference
+    bool from_bytes( uint8_t const * data, size_t size );
+};
+
+
+class dds_shm_writer
+{
+    struct impl;
+    std::unique_ptr< impl > _impl;
+
+public:
+    // Throws if the segment can't be created
+    dds_shm_writer( uint32_t n_slots, size_t slot_size );
+    ~dds_shm_writer();
+
+    size_t slot_size() const;
+
+    // Copy a frame into the next free slot; returns false, without writing anything, if it's too big or all the slots
+    // are still held by readers.
+    // A frame that's already in a slot of ours, from allocate(), isn't copied: the slot is just handed to the readers.
+    bool write( void const * data, size_t size, dds_shm_ref & ref );
+
+    // Take a free slot to produce a frame in, until release(): null if the frame is too big or there's none free.
+    // The frame can then be written only once.
+    void * allocate( size_t size );
+    void release( void const * data );
+
+    // Whether the data is in one of our slots
+    bool owns( void const * data ) const;
+};
+
+
+class dds_shm_reader
+{
+    struct segment;
+    std::shared_ptr< segment > _segment;  // The last one we got a frame from
+    std::mutex _mutex;
+
+public:
+    // The frame a reference is to, held until the pointer (and all copies) goes away. Returns null if the frame's
+    // since been overwritten or its segment can't be mapped.
+    std::shared_ptr< uint8_t const > retain( dds_shm_ref const & ref );
+};
+
+
+}  // namespace realdds
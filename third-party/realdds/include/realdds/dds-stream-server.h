@@ -6,7 +6,10 @@
 #include <realdds/dds-stream-profile.h>
 #include <realdds/dds-stream-base.h>
 #include <realdds/dds-trinsics.h>
+#include <realdds/dds-defines.h>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <set>
@@ -24,6 +27,8 @@ class dds_topic;
 class dds_topic_writer;
 class dds_publisher;
 class dds_stream_profile;
+class dds_shm_writer;
+class dds_video_encoder;
 
 
 struct image_header
@@ -72,6 +77,9 @@ protected:
     // Called at the end of open(), when the _writer has been initialized. Override to provide custom QOS etc...
     virtual void run_stream();
 
+    // The biggest sample any of our profiles could make (at least), for picking the "auto" QoS profile; 0 if unknown
+    virtual size_t max_sample_size() const { return 0; }
+
     void start_streaming();
 };
 
@@ -88,17 +96,53 @@ public:
     void set_intrinsics( const std::set< video_intrinsics > & intrinsics ) { _intrinsics = intrinsics; }
     const std::set< video_intrinsics > & get_intrinsics() const { return _intrinsics; }
 
+    // With compression enabled, profiles in a compressed encoding (see dds_video_encoder) are streamed from raw
+    // images: publish_image() still takes the raw pixels, and they're compressed on the way out. The owner is then
+    // expected to also offer, for each compressed profile, the raw one it comes from.
+    void enable_compression() { _compression = true; }
+    bool is_compression_enabled() const { return _compression; }
+
     void start_streaming( const image_header & );
+    // Same, with the images published raw, in an encoding other than the header's: they get compressed to the
+    // header's encoding on the way out; throws if there's no such compression
+    void start_streaming( const image_header &, dds_video_encoding const & raw_encoding );
     void stop_streaming() override;
     image_header const & get_image_header() const { return _image_header; }
 
+    // Megabits per second published over the last second or so: after compression, but not counting what went through
+    // shared memory
+    float get_bandwidth() const { return _bandwidth; }
+
     virtual void publish_image( topics::image_msg && );
 
+    // Same, straight from the pixels: with "shared-memory" in the participant's "device" settings, they're copied into
+    // shared memory for readers on the same host (see dds_shm_writer), and only a reference to them is published.
+    // Readers elsewhere must then not be expecting the pixels!
+    void publish_image( dds_time const & timestamp, uint8_t const * data, size_t size );
+
+    // Publish through the given segment rather than one of our own, whatever the settings: it can be shared with the
+    // other streams of a sensor, and frames produced right in it (see dds_shm_writer::allocate) go out without a copy.
+    // Null to go back to the settings.
+    void use_shared_memory( std::shared_ptr< dds_shm_writer > const & shm ) { std::atomic_store( &_given_shm, shm ); }
+
+protected:
+    size_t max_sample_size() const override;
+
 private:
     void check_profile( std::shared_ptr< dds_stream_profile > const & ) const override;
+    void publish( dds_time const & timestamp, std::vector< uint8_t > && data, uint32_t step );
 
     std::set< video_intrinsics > _intrinsics;
     image_header _image_header;
+    uint32_t _shm_slots = 0;              // From the settings; 0 when not using shared memory
+    std::shared_ptr< dds_shm_writer > _shm;  // Created with the first frame, since it's sized for it
+    std::shared_ptr< dds_shm_writer > _given_shm;
+    bool _compression = false;
+    std::shared_ptr< dds_video_encoder > _encoder;  // When compressing
+
+    std::atomic< float > _bandwidth{ 0 };
+    size_t _bandwidth_bytes = 0;  // Since _bandwidth_start
+    std::chrono::steady_clock::time_point _bandwidth_start;
 };
 
 
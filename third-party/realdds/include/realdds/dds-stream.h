@@ -5,6 +5,8 @@
 
 #include "dds-stream-base.h"
 #include "dds-trinsics.h"
+#include "dds-shared-memory.h"
+#include "dds-reader-statistics.h"
 
 #include <string>
 #include <vector>
@@ -48,6 +50,9 @@ public:
 
     std::shared_ptr< dds_topic > const & get_topic() const override;
 
+    // What's been received since the stream was opened (see dds_reader_statistics); all zeros when not open
+    dds_reader_statistics::values get_statistics() const;
+
 protected:
     virtual void handle_data() = 0;
     virtual bool can_start_streaming() const = 0;
@@ -65,6 +70,8 @@ public:
 
     void open( std::string const & topic_name, std::shared_ptr< dds_subscriber > const & ) override;
 
+    // Whatever buffer the callback leaves in the image's raw_data, the next image is taken into: swapping in one from a
+    // frame pool (rather than moving out of it) makes for streaming without allocations
     typedef std::function< void( topics::image_msg && f ) > on_data_available_callback;
     void on_data_available( on_data_available_callback cb ) { _on_data_available = cb; }
 
@@ -77,6 +84,10 @@ protected:
 
     std::set< video_intrinsics > _intrinsics;
     on_data_available_callback _on_data_available = nullptr;
+    dds_shm_reader _shm;  // For frames the server put in shared memory
+    std::vector< uint8_t > _spare_buffer;  // For the next image, between handle_data() calls
+    dds_nsec _min_separation = 0;  // From the time-based filter; frames closer than this to the last are dropped
+    dds_nsec _last_timestamp = 0;
 };
 
 class dds_depth_stream : public dds_video_stream
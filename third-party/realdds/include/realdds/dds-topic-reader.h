@@ -2,6 +2,8 @@
 // Copyright(c) 2022 Intel Corporation. All Rights Reserved.
 #pragma once
 
+#include "dds-reader-statistics.h"
+
 #include <fastdds/dds/subscriber/DataReaderListener.hpp>
 #include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
 
@@ -41,6 +43,8 @@ protected:
 
     int _n_writers = 0;
 
+    dds_reader_statistics _statistics;
+
 public:
     dds_topic_reader( std::shared_ptr< dds_topic > const & topic );
     dds_topic_reader( std::shared_ptr< dds_topic > const & topic, std::shared_ptr< dds_subscriber > const & subscriber );
@@ -54,6 +58,10 @@ public:
 
     std::shared_ptr< dds_topic > const & topic() const { return _topic; }
 
+    // Lost samples, callbacks and the queue are counted here; whoever takes the samples should record them
+    dds_reader_statistics & statistics() { return _statistics; }
+    dds_reader_statistics const & statistics() const { return _statistics; }
+
     typedef std::function< void() > on_data_available_callback;
     typedef std::function< void( eprosima::fastdds::dds::SubscriptionMatchedStatus const & ) >
         on_subscription_matched_callback;
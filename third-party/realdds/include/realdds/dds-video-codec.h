@@ -0,0 +1,53 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <realdds/dds-stream-profile.h>
+
+#include <rsutils/json-fwd.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace realdds {
+
+
+// Compression of images on their way out, for links that cannot take the raw pixels (several cameras over Wi-Fi,
+// say). A server advertises compressed profiles next to the raw ones they come from; a client that opens one gets
+// every image compressed, in the profile's encoding, and decodes it itself (librealsense does, through its format
+// converters).
+//
+// What can be compressed to what:
+//     rgb8  -> MJPG          JPEG; lossy, with the "jpeg-quality" from the device settings (default 90)
+//     16UC1 -> 16UC1; rvl    Lossless depth: see rsutils/depth-codec.h
+//     16UC1 -> 16UC1; sparse The valid depth pixels only, if the "depth-compression" device setting is "sparse" (the
+//                            default is "rvl"): see rsutils/sparse-depth.h
+//
+class dds_video_encoder
+{
+public:
+    virtual ~dds_video_encoder() = default;
+
+    // The compressed encoding 'raw' images can be sent in, or an invalid one if none; the device settings choose between
+    // the encodings where there's more than one
+    static dds_video_encoding compressed( dds_video_encoding const & raw );
+    static dds_video_encoding compressed( dds_video_encoding const & raw, rsutils::json const & settings );
+
+    // The raw encoding a compressed one is made from, or an invalid one if it isn't one of ours
+    static dds_video_encoding raw( dds_video_encoding const & compressed );
+
+    // Returns null if 'raw' images cannot be compressed to 'compressed'
+    static std::shared_ptr< dds_video_encoder > create( dds_video_encoding const & raw,
+                                                        dds_video_encoding const & compressed,
+                                                        rsutils::json const & settings );
+
+    // Compress one image into 'out', replacing whatever was in it
+    virtual void encode( uint8_t const * pixels, size_t size, int width, int height, std::vector< uint8_t > & out )
+        = 0;
+};
+
+
+}  // namespace realdds
@@ -121,6 +121,12 @@ namespace control {
             extern std::string const sensor_name;
         }
     }
+    namespace set_options {
+        extern std::string const id;
+        namespace key {
+            using notification::query_options::key::option_values;
+        }
+    }
     namespace open_streams {
         extern std::string const id;
         namespace key {
@@ -184,6 +190,12 @@ namespace reply {
             using notification::query_options::key::option_values;
         }
     }
+    namespace set_options {
+        using control::set_options::id;
+        namespace key {
+            using control::set_options::key::option_values;
+        }
+    }
     namespace open_streams {
         using control::open_streams::id;
         namespace key {
@@ -81,6 +81,7 @@ public:
     flexible_msg( raw::flexible && );
     flexible_msg( rsutils::json const &, uint32_t version = 0 );
     flexible_msg( data_format format, rsutils::json const &, uint32_t version = 0 );
+    flexible_msg( data_format format, std::vector< uint8_t > && data, uint32_t version = 0 );
 
     rsutils::json json_data() const;
 
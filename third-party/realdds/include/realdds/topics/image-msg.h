@@ -5,6 +5,7 @@
 
 
 #include <realdds/dds-defines.h>
+#include <realdds/dds-shared-memory.h>
 #include <fastdds/rtps/common/Time_t.h>
 
 #include <string>
@@ -67,13 +68,23 @@ public:
     // Returns false if no more data is available.
     // Will throw if an unexpected error occurs.
     //
-    //Note - copies the data.
+    // The data is taken into the output's raw_data; whatever buffer is there is reused (and kept when there's no more
+    // data), so a reader holding on to the same output needn't allocate for every image.
     //TODO - add an API for a function that loans the data and enables the user to free it later.
     static bool take_next( dds_topic_reader &,
                            image_msg * output,
                            eprosima::fastdds::dds::SampleInfo * optional_info = nullptr );
 
+    // The pixels are either in raw_data or, when the writer put them in shared memory (see dds_shm_writer), the
+    // message only carries shm_ref and the reader fills in shared_data to point at them
     std::vector< uint8_t > raw_data;
+    dds_shm_ref shm_ref;
+    bool has_shm_ref = false;
+    std::shared_ptr< uint8_t const > shared_data;
+
+    uint8_t const * data() const { return shared_data ? shared_data.get() : raw_data.data(); }
+    size_t data_size() const { return shared_data ? shm_ref.size : raw_data.size(); }
+
     int width = -1;
     int height = -1;
     dds_time timestamp;
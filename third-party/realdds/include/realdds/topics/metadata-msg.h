@@ -0,0 +1,82 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <realdds/dds-defines.h>
+
+#include <rsutils/json-fwd.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace realdds {
+namespace topics {
+
+
+// Frame metadata in a fixed binary layout, rather than JSON which is costly to generate and parse for every frame of
+// every stream. It's sent as CUSTOM-format flexible messages on the same metadata topic, and carries the same
+// information as the JSON (see doc/metadata.md), except that metadata values are keyed by number rather than by name.
+// For librealsense, the keys are rs2_frame_metadata_value.
+//
+// The layout is a header, then the stream name (padded to 8 bytes), then the values. It's in host byte order: a
+// reader with the other order won't recognize the magic.
+//
+class metadata_msg
+{
+public:
+    static constexpr uint32_t MAGIC = 0x31646d72;  // "rmd1"
+
+    enum : uint8_t
+    {
+        HAS_FRAME_NUMBER = 1,
+        HAS_TIMESTAMP_DOMAIN = 2,
+        HAS_DEPTH_UNITS = 4,
+    };
+
+    struct header
+    {
+        uint32_t magic;
+        uint16_t n_values;
+        uint8_t name_length;
+        uint8_t flags;
+        dds_nsec timestamp;  // Must match the image timestamp, bit-for-bit
+        uint64_t frame_number;
+        int32_t timestamp_domain;
+        float depth_units;
+    };
+
+    struct value
+    {
+        int32_t key;
+        int32_t reserved;
+        int64_t value;
+    };
+
+    // Writing
+    metadata_msg( std::string const & stream_name, dds_nsec timestamp );
+    void set_frame_number( uint64_t );
+    void set_timestamp_domain( int32_t );
+    void set_depth_units( float );
+    void add( int32_t key, int64_t value );
+    std::vector< uint8_t > const & data() const { return _data; }
+    std::vector< uint8_t > && detach() { return std::move( _data ); }
+
+    // Reading, straight from the bytes (which must be 8-byte aligned, as vector storage is): returns null if they
+    // aren't a metadata_msg
+    static header const * parse( void const * data, size_t size );
+    static std::string stream_name( header const * );
+    static value const * values( header const * );
+
+    // The same content, in the JSON form; metadata keys are written as numbers
+    static rsutils::json to_json( header const * );
+
+private:
+    header * get_header() { return reinterpret_cast< header * >( _data.data() ); }
+
+    std::vector< uint8_t > _data;
+};
+
+
+}  // namespace topics
+}  // namespace realdds
@@ -8,6 +8,7 @@
 #include <realdds/topics/flexible/flexiblePubSubTypes.h>
 #include <realdds/topics/image-msg.h>
 #include <realdds/topics/imu-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/topics/blob-msg.h>
 #include <realdds/topics/blob/blobPubSubTypes.h>
 #include <realdds/topics/ros2/ros2imagePubSubTypes.h>
@@ -862,7 +863,9 @@ PYBIND11_MODULE(NAME, m) {
             "publish_notification",
             []( dds_device_server & self, json const & j ) { self.publish_notification( j ); },
             py::call_guard< py::gil_scoped_release >() )
-        .def( "publish_metadata", &dds_device_server::publish_metadata, py::call_guard< py::gil_scoped_release >() )
+        .def( "publish_metadata",
+              []( dds_device_server & self, json && md ) { self.publish_metadata( std::move( md ) ); },
+              py::call_guard< py::gil_scoped_release >() )
         .def( "broadcast", &dds_device_server::broadcast )
         .def( "broadcast_disconnect", &dds_device_server::broadcast_disconnect, py::arg( "ack-timeout" ) = dds_time() )
         .def( FN_FWD_R( dds_device_server, on_control,
@@ -879,6 +882,7 @@ PYBIND11_MODULE(NAME, m) {
         .def( "is_open", &dds_stream::is_open )
         .def( "start_streaming", &dds_stream::start_streaming )
         .def( "stop_streaming", &dds_stream::stop_streaming )
+        .def( "get_statistics", []( dds_stream const & self ) { return self.get_statistics().to_json(); } )
         .def( "__repr__", []( dds_stream const & self ) {
             std::ostringstream os;
             os << "<" SNAME "." << self.type_string() << "_stream \"" << self.name() << "\"";
@@ -950,6 +954,7 @@ PYBIND11_MODULE(NAME, m) {
         .def( "server_guid", &dds_device::server_guid )
         .def( "guid", &dds_device::guid )
         .def( "is_ready", &dds_device::is_ready )
+        .def( "init_timing", &dds_device::init_timing )
         .def( "is_online", &dds_device::is_online )
         .def( "is_offline", &dds_device::is_offline )
         .def( "wait_until_ready",
@@ -969,7 +974,19 @@ PYBIND11_MODULE(NAME, m) {
               {
                   return std::make_shared< subscription >( self.on_metadata_available(
                       [&self, callback]( std::shared_ptr< const json > const & pj )
-                      { FN_FWD_CALL( dds_device, "on_metadata_available", callback( self, json_to_py( *pj ) ); ) } ) );
+                      {
+                          using realdds::topics::metadata_msg;
+                          if( pj->is_binary() )  // Python gets binary metadata in its JSON form
+                          {
+                              auto & bytes = pj->get_binary();
+                              auto j = metadata_msg::to_json( metadata_msg::parse( bytes.data(), bytes.size() ) );
+                              FN_FWD_CALL( dds_device, "on_metadata_available", callback( self, json_to_py( j ) ); )
+                          }
+                          else
+                          {
+                              FN_FWD_CALL( dds_device, "on_metadata_available", callback( self, json_to_py( *pj ) ); )
+                          }
+                      } ) );
               } )
         .def( "on_device_log",
               []( dds_device & self, std::function< void( dds_device &, dds_nsec, char, std::string const &, py::object && ) > callback )
@@ -999,7 +1016,13 @@ PYBIND11_MODULE(NAME, m) {
                   self.foreach_option( [&]( std::shared_ptr< dds_option > const & option ) { options.push_back( option ); } );
                   return options;
               } )
+        .def( "get_statistics", &dds_device::get_statistics )
         .def( "set_option_value", &dds_device::set_option_value )
+        .def( "set_option_values",
+              &dds_device::set_option_values,
+              py::arg( "values" ),
+              py::arg( "wait-for-reply" ) = true,
+              py::call_guard< py::gil_scoped_release >() )
         .def( "query_option_value", &dds_device::query_option_value )
         .def(
             "send_control",
@@ -1133,7 +1156,15 @@ PYBIND11_MODULE(NAME, m) {
         .def( "enqueue_frame", &dds_metadata_syncer::enqueue_frame )
         .def( "enqueue_metadata",
               []( dds_metadata_syncer & self, dds_metadata_syncer::key_type key, json const & j )
-              { self.enqueue_metadata( key, std::make_shared< const json >( j ) ); } );
+              { self.enqueue_metadata( key, std::make_shared< const json >( j ) ); } )
+        .def( "get_statistics",
+              []( dds_metadata_syncer const & self )
+              {
+                  auto const stats = self.get_statistics();
+                  return json::object( { { "matched", stats.matched },
+                                         { "frames-without-metadata", stats.frames_without_metadata },
+                                         { "metadata-dropped", stats.metadata_dropped } } );
+              } );
     metadata_syncer.attr( "max_frame_queue_size" ) = dds_metadata_syncer::max_frame_queue_size;
     metadata_syncer.attr( "max_md_queue_size" ) = dds_metadata_syncer::max_md_queue_size;
 }
@@ -10,6 +10,7 @@
 #include <realdds/dds-option.h>
 #include <realdds/topics/dds-topic-names.h>
 #include <realdds/topics/flexible-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/dds-guid.h>
 #include <realdds/dds-time.h>
 
@@ -21,6 +22,7 @@
 #include <rsutils/json.h>
 
 #include <cassert>
+#include <map>
 
 using rsutils::json;
 
@@ -41,6 +43,25 @@ json device_settings( std::shared_ptr< realdds::dds_participant > const & partic
 }
 
 
+// The initialization payloads of devices we've been initialized by, for 'device/init-cache', by init_cache_key()
+std::map< std::string, std::vector< json > > init_cache;
+std::mutex init_cache_mutex;
+
+
+char const * state_name( realdds::dds_device::impl::state_t state )
+{
+    using state_t = realdds::dds_device::impl::state_t;
+    switch( state )
+    {
+    case state_t::ONLINE: return "device-header";
+    case state_t::WAIT_FOR_DEVICE_OPTIONS: return "device-options";
+    case state_t::WAIT_FOR_STREAM_HEADER: return "stream-header";
+    case state_t::WAIT_FOR_STREAM_OPTIONS: return "stream-options";
+    default: return nullptr;
+    }
+}
+
+
 }
 
 
@@ -52,6 +73,19 @@ void dds_device::impl::set_state( state_t new_state )
     if( new_state == _state )
         return;
 
+    // Each state (but OFFLINE and READY) waits on the next message: add up how long each took
+    if( state_t::ONLINE == new_state )
+    {
+        _init_timing = json::object();
+        _from_cache = false;
+    }
+    else if( auto phase = state_name( _state ) )
+    {
+        auto & ms = _init_timing[phase];  // Stream phases repeat, once per stream
+        ms = ( ms.is_number() ? ms.get< double >() : 0. ) + _state_stopwatch.get_elapsed_ms();
+    }
+    _state_stopwatch.reset();
+
     if( state_t::READY == new_state )
     {
         if( _metadata_reader )
@@ -71,10 +105,30 @@ void dds_device::impl::set_state( state_t new_state )
                 _metadata_reader->run( rqos );
             }
         }
-        LOG_DEBUG( "[" << debug_name() << "] device is ready" );
+
+        if( _use_init_cache && ! _from_cache )
+        {
+            auto key = init_cache_key();
+            if( ! key.empty() )
+            {
+                std::lock_guard< std::mutex > lock( init_cache_mutex );
+                init_cache[key] = _init_payload;
+            }
+        }
+
+        double total = 0;
+        for( auto & phase : _init_timing )
+            total += phase.get< double >();
+        _init_timing["total"] = total;
+        _init_timing["from-cache"] = _from_cache;
+        LOG_DEBUG( "[" << debug_name() << "] device is ready: " << _init_timing );
     }
 
-    _state = new_state;
+    {
+        std::lock_guard< std::mutex > lock( _state_mutex );
+        _state = new_state;
+    }
+    _state_cv.notify_all();
 }
 
 
@@ -86,9 +140,11 @@ dds_device::impl::impl( std::shared_ptr< dds_participant > const & participant,
     , _device_settings( device_settings( participant ) )
     , _reply_timeout_ms(
           _device_settings.nested( "control", "reply-timeout-ms" ).default_value< size_t >( 2000 ) )
+    , _use_init_cache( participant->settings().nested( "device", "init-cache" ).default_value( false ) )
 {
     create_control_writer();
     create_notifications_reader();
+    init_from_cache();
 }
 
 
@@ -108,6 +164,56 @@ void dds_device::impl::reset()
     _options.clear();
     _extrinsics_map.clear();
     _metadata_reader.reset();
+    _init_payload.clear();
+    _live_init.clear();
+}
+
+
+std::string dds_device::impl::init_cache_key() const
+{
+    // The server GUID changes every time it starts, so can't be used; the device is identified by its device-info
+    // and the cache is only good for the same firmware
+    auto fw_version = _info.to_json().nested( "fw-version" );
+    if( ! fw_version.is_string() )
+        return {};
+    return rsutils::string::from() << _info.topic_root() << '/' << _info.serial_number() << '/'
+                                   << fw_version.string_ref();
+}
+
+
+bool dds_device::impl::init_from_cache()
+{
+    if( ! _use_init_cache )
+        return false;
+
+    std::vector< json > payload;
+    {
+        auto key = init_cache_key();
+        std::lock_guard< std::mutex > lock( init_cache_mutex );
+        auto it = init_cache.find( key );
+        if( it == init_cache.end() )
+            return false;
+        payload = it->second;
+    }
+
+    std::lock_guard< std::mutex > lock( _notifications_mutex );
+    if( _state != state_t::ONLINE )
+        return false;  // The live initialization beat us to it
+
+    LOG_DEBUG( "[" << debug_name() << "] initializing from cache" );
+    _from_cache = true;  // Any check against the live initialization waits until we're ready
+    eprosima::fastdds::dds::SampleInfo no_sample;  // No server GUID until the live device-header
+    for( auto & j : payload )
+        on_notification( std::move( j ), no_sample );
+    if( ! is_ready() )
+    {
+        LOG_DEBUG( "[" << debug_name() << "] cached initialization failed; waiting for the live one" );
+        reset();
+        _from_cache = false;
+        set_state( state_t::ONLINE );
+        return false;
+    }
+    return true;
 }
 
 
@@ -133,6 +239,7 @@ void dds_device::impl::on_notification( json && j, eprosima::fastdds::dds::Sampl
         { topics::reply::set_option::id, &dds_device::impl::on_set_option },
         { topics::reply::query_option::id, &dds_device::impl::on_set_option },  // Same handling as on_set_option
         { topics::reply::query_options::id, &dds_device::impl::on_query_options },
+        { topics::reply::set_options::id, &dds_device::impl::on_set_options },
         { topics::notification::device_header::id, &dds_device::impl::on_device_header },
         { topics::notification::device_options::id, &dds_device::impl::on_device_options },
         { topics::notification::stream_header::id, &dds_device::impl::on_stream_header },
@@ -148,6 +255,8 @@ void dds_device::impl::on_notification( json && j, eprosima::fastdds::dds::Sampl
         // First handle the notification
         // An 'id' is mandatory, but if it's a response to a control it can be contained there
         auto id = ( control_sample ? control.get_json() : j ).nested( topics::notification::key::id ).string_ref();
+        if( _from_cache && is_ready() )
+            check_cached_init( id, j, notification_sample );
         auto it = _notification_handlers.find( id );
         if( it != _notification_handlers.end() )
             ( this->*( it->second ) )( j, notification_sample );
@@ -276,6 +385,34 @@ void dds_device::impl::on_query_options( json const & j, eprosima::fastdds::dds:
 
     dds_device::check_reply( j );  // throws
 
+    auto option_values = j.nested( topics::reply::query_options::key::option_values );
+    if( ! option_values.is_object() )
+        throw std::runtime_error( "missing option-values" );
+
+    //LOG_DEBUG( "[" << debug_name() << "] got query-options: " << option_values.dump(4) );
+    update_option_values( option_values );
+}
+
+
+void dds_device::impl::on_set_options( json const & j, eprosima::fastdds::dds::SampleInfo const & )
+{
+    if( ! is_ready() )
+        return;
+
+    // This is the reply to "set-options": the values actually set are in the same form as with "query-options", and
+    // are there even if some of the options failed (and the reply is an error)
+    std::string explanation;
+    if( ! dds_device::check_reply( j, &explanation ) )
+        LOG_DEBUG( "[" << debug_name() << "] set-options: " << explanation );
+
+    auto option_values = j.nested( topics::reply::set_options::key::option_values );
+    if( option_values.is_object() )
+        update_option_values( option_values );
+}
+
+
+void dds_device::impl::update_option_values( json const & option_values )
+{
     // This little function is used either for device or stream options
     auto update_option = [this]( dds_options const & options, std::string const & option_name, json const & new_value )
     {
@@ -292,11 +429,6 @@ void dds_device::impl::on_query_options( json const & j, eprosima::fastdds::dds:
         throw std::runtime_error( "option '" + option_name + "' not found" );
     };
 
-    auto option_values = j.nested( topics::reply::query_options::key::option_values );
-    if( ! option_values.is_object() )
-        throw std::runtime_error( "missing option-values" );
-
-    //LOG_DEBUG( "[" << debug_name() << "] got query-options: " << option_values.dump(4) );
     for( auto it = option_values.begin(); it != option_values.end(); ++it )
     {
         if( it->is_object() )
@@ -415,6 +547,35 @@ void dds_device::impl::set_option_value( const std::shared_ptr< dds_option > & o
 }
 
 
+void dds_device::impl::set_option_values( std::vector< std::pair< std::shared_ptr< dds_option >, json > > const & values,
+                                          bool wait_for_reply )
+{
+    if( values.empty() )
+        return;
+
+    json option_values = json::object();
+    for( auto & option_value : values )
+    {
+        auto & option = option_value.first;
+        if( ! option )
+            DDS_THROW( runtime_error, "must provide an option to set" );
+        if( auto stream = option->stream() )
+            option_values[stream->name()][option->get_name()] = option_value.second;
+        else
+            option_values[option->get_name()] = option_value.second;
+    }
+
+    json j = json::object( {
+        { topics::control::key::id, topics::control::set_options::id },
+        { topics::control::set_options::key::option_values, std::move( option_values ) }
+    } );
+
+    // Either way, the reply will update the cached values
+    json reply;
+    write_control_message( j, wait_for_reply ? &reply : nullptr );
+}
+
+
 json dds_device::impl::query_option_value( const std::shared_ptr< dds_option > & option )
 {
     if( ! option )
@@ -489,7 +650,9 @@ void dds_device::impl::create_notifications_reader()
             {
                 if( ! notification.is_valid() )
                     continue;
+                _notifications_reader->statistics().on_sample( notification._data.size(), sample );
                 auto j = notification.json_data();
+                std::lock_guard< std::mutex > lock( _notifications_mutex );
                 if( j.is_array() )
                 {
                     for( unsigned x = 0; x < j.size(); ++x )
@@ -516,14 +679,28 @@ void dds_device::impl::create_metadata_reader()
         [this]()
         {
             topics::flexible_msg message;
-            while( topics::flexible_msg::take_next( *_metadata_reader, &message ) )
+            eprosima::fastdds::dds::SampleInfo sample;
+            while( topics::flexible_msg::take_next( *_metadata_reader, &message, &sample ) )
             {
+                if( message.is_valid() )
+                    _metadata_reader->statistics().on_sample( message._data.size(), sample );
                 if( message.is_valid() && _on_metadata_available.size() )
                 {
                     try
                     {
-                        auto sptr = std::make_shared< const json >( message.json_data() );
-                        _on_metadata_available.raise( sptr );
+                        if( message._data_format == topics::flexible_msg::data_format::CUSTOM )
+                        {
+                            // Binary metadata is passed on as-is, without parsing, for the client to read in place
+                            if( ! topics::metadata_msg::parse( message._data.data(), message._data.size() ) )
+                                DDS_THROW( runtime_error, "unrecognized binary metadata" );
+                            auto sptr = std::make_shared< const json >( json::binary( std::move( message._data ) ) );
+                            _on_metadata_available.raise( sptr );
+                        }
+                        else
+                        {
+                            auto sptr = std::make_shared< const json >( message.json_data() );
+                            _on_metadata_available.raise( sptr );
+                        }
                     }
                     catch( std::exception const & e )
                     {
@@ -577,6 +754,7 @@ void dds_device::impl::on_device_header( json const & j, eprosima::fastdds::dds:
         }
     }
 
+    _init_payload.push_back( j );
     set_state( state_t::WAIT_FOR_DEVICE_OPTIONS );
 }
 
@@ -597,6 +775,7 @@ void dds_device::impl::on_device_options( json const & j, eprosima::fastdds::dds
         }
     }
 
+    _init_payload.push_back( j );
     if( _n_streams_expected )
         set_state( state_t::WAIT_FOR_STREAM_HEADER );
     else
@@ -661,6 +840,7 @@ void dds_device::impl::on_stream_header( json const & j, eprosima::fastdds::dds:
                              << "' received with " << profiles.size() << " profiles"
                              << ( stream->metadata_enabled() ? " and metadata" : "" ) );
 
+    _init_payload.push_back( j );
     set_state( state_t::WAIT_FOR_STREAM_OPTIONS );
 }
 
@@ -718,6 +898,7 @@ void dds_device::impl::on_stream_options( json const & j, eprosima::fastdds::dds
         stream_it->second->set_recommended_filters( std::move( filter_names ) );
     }
 
+    _init_payload.push_back( j );
     if( _streams.size() >= _n_streams_expected )
         set_state( state_t::READY );
     else
@@ -725,4 +906,85 @@ void dds_device::impl::on_stream_options( json const & j, eprosima::fastdds::dds
 }
 
 
+void dds_device::impl::check_cached_init( std::string const & id,
+                                          json const & j,
+                                          eprosima::fastdds::dds::SampleInfo const & sample )
+{
+    // Initialized from the cache, the live initialization still comes in after: it gives us the server GUID, and any
+    // difference means the cache was stale
+    if( id == topics::notification::device_header::id )
+    {
+        eprosima::fastrtps::rtps::iHandle2GUID( _server_guid, sample.publication_handle );
+        _live_streams_expected = j.at( topics::notification::device_header::key::n_streams ).get< size_t >();
+        _live_init.clear();
+    }
+    else if( _live_init.empty()
+             || ( id != topics::notification::device_options::id && id != topics::notification::stream_header::id
+                  && id != topics::notification::stream_options::id ) )
+    {
+        return;
+    }
+    _live_init.push_back( j );
+
+    size_t n_streams = 0;
+    for( auto & notification : _live_init )
+        if( notification.nested( topics::notification::key::id ).string_ref() == topics::notification::stream_options::id )
+            ++n_streams;
+    if( n_streams < _live_streams_expected
+        || ( ! _live_streams_expected && id != topics::notification::device_options::id ) )
+        return;
+
+    _from_cache = false;
+    if( _live_init == _init_payload )
+    {
+        LOG_DEBUG( "[" << debug_name() << "] cached initialization matches the device" );
+    }
+    else
+    {
+        // Option values are the likely difference; those we can update. Anything else will have to wait until the
+        // next initialization, which will no longer be from this (stale) cache.
+        LOG_WARNING( "[" << debug_name() << "] cached initialization differs from the device; updating" );
+        for( auto & notification : _live_init )
+        {
+            auto & notification_id = notification.nested( topics::notification::key::id ).string_ref();
+            if( notification_id == topics::notification::device_options::id )
+            {
+                refresh_option_values( _options, notification.nested( topics::notification::device_options::key::options ) );
+            }
+            else if( notification_id == topics::notification::stream_options::id )
+            {
+                auto stream_it = _streams.find(
+                    notification.nested( topics::notification::stream_options::key::stream_name ).string_ref_or_empty() );
+                if( stream_it != _streams.end() )
+                    refresh_option_values( stream_it->second->options(),
+                                           notification.nested( topics::notification::stream_options::key::options ) );
+            }
+        }
+        std::lock_guard< std::mutex > lock( init_cache_mutex );
+        init_cache[init_cache_key()] = _live_init;
+    }
+    _init_payload = std::move( _live_init );
+    _live_init.clear();
+}
+
+
+void dds_device::impl::refresh_option_values( dds_options const & options, json const & options_j )
+{
+    for( auto & option_j : options_j )
+    {
+        try
+        {
+            auto live = dds_option::from_json( option_j );
+            for( auto & option : options )
+                if( option->get_name() == live->get_name() && option->get_value() != live->get_value() )
+                    option->set_value( live->get_value() );
+        }
+        catch( std::exception const & e )
+        {
+            LOG_DEBUG( "[" << debug_name() << "] failed to refresh option: " << e.what() << "\n    " << option_j );
+        }
+    }
+}
+
+
 }  // namespace realdds
@@ -13,6 +13,7 @@
 
 #include <rsutils/signal.h>
 #include <rsutils/json.h>
+#include <rsutils/time/stopwatch.h>
 
 #include <map>
 #include <memory>
@@ -48,8 +49,23 @@ public:
     void set_state( state_t );
 
     state_t _state = state_t::ONLINE;
+    std::mutex _state_mutex;
+    std::condition_variable _state_cv;  // Notified on every state change
     size_t _n_streams_expected = 0;  // needed only until ready
 
+    // How long each phase of the initialization took, in milliseconds, once ready; see set_state()
+    rsutils::json _init_timing;
+    rsutils::time::stopwatch _state_stopwatch;
+
+    // With 'device/init-cache', the initialization notifications are kept for the next time the same device (and
+    // firmware) comes online, and it's ready as soon as it does. The live ones are still checked against the cache.
+    bool const _use_init_cache;
+    std::vector< rsutils::json > _init_payload;  // What we were initialized with
+    std::vector< rsutils::json > _live_init;     // What's come in since, when initialized from cache
+    size_t _live_streams_expected = 0;
+    bool _from_cache = false;
+    std::mutex _notifications_mutex;  // The cache is replayed from outside the notifications thread
+
     topics::device_info _info;
     rsutils::json const _device_settings;
     dds_guid _server_guid;
@@ -76,6 +92,9 @@ public:
 
     void reset();
 
+    std::string init_cache_key() const;
+    bool init_from_cache();
+
     dds_guid const & guid() const;
     std::string debug_name() const;
 
@@ -88,6 +107,8 @@ public:
     void write_control_message( topics::flexible_msg &&, rsutils::json * reply = nullptr );
 
     void set_option_value( const std::shared_ptr< dds_option > & option, rsutils::json new_value );
+    void set_option_values( std::vector< std::pair< std::shared_ptr< dds_option >, rsutils::json > > const &,
+                            bool wait_for_reply );
     rsutils::json query_option_value( const std::shared_ptr< dds_option > & option );
 
     using on_metadata_available_signal = rsutils::signal< std::shared_ptr< const rsutils::json > const & >;
@@ -122,6 +143,7 @@ private:
     // notification handlers
     void on_set_option( rsutils::json const &, eprosima::fastdds::dds::SampleInfo const & );
     void on_query_options( rsutils::json const &, eprosima::fastdds::dds::SampleInfo const & );
+    void on_set_options( rsutils::json const &, eprosima::fastdds::dds::SampleInfo const & );
     void on_known_notification( rsutils::json const &, eprosima::fastdds::dds::SampleInfo const & );
     void on_log( rsutils::json const &, eprosima::fastdds::dds::SampleInfo const & );
     void on_device_header( rsutils::json const &, eprosima::fastdds::dds::SampleInfo const & );
@@ -130,6 +152,9 @@ private:
     void on_stream_options( rsutils::json const &, eprosima::fastdds::dds::SampleInfo const & );
 
     void on_notification( rsutils::json &&, eprosima::fastdds::dds::SampleInfo const & );
+    void check_cached_init( std::string const & id, rsutils::json const &, eprosima::fastdds::dds::SampleInfo const & );
+    void refresh_option_values( dds_options const &, rsutils::json const & options_j );
+    void update_option_values( rsutils::json const & option_values );  // As in "query-options"; throws
 
     on_metadata_available_signal _on_metadata_available;
     on_device_log_signal _on_device_log;
@@ -15,6 +15,7 @@
 #include <realdds/topics/dds-topic-names.h>
 #include <realdds/topics/device-info-msg.h>
 #include <realdds/topics/flexible-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/dds-topic.h>
 #include <realdds/dds-topic-writer.h>
 #include <realdds/dds-option.h>
@@ -288,6 +289,15 @@ void dds_device_server::publish_metadata( json && md )
 }
 
 
+void dds_device_server::publish_metadata( topics::metadata_msg && md )
+{
+    if( ! _metadata_writer )
+        DDS_THROW( runtime_error, "device '" + _topic_root + "' has no stream with enabled metadata" );
+
+    topics::flexible_msg( topics::flexible_msg::data_format::CUSTOM, md.detach() ).write_to( *_metadata_writer );
+}
+
+
 bool dds_device_server::has_metadata_readers() const
 {
     return _metadata_writer && _metadata_writer->has_readers();
@@ -307,6 +317,7 @@ void dds_device_server::on_control_message_received()
         control_handlers;
     static control_handlers const _control_handlers{
         { topics::control::set_option::id, &dds_device_server::on_set_option },
+        { topics::control::set_options::id, &dds_device_server::on_set_options },
         { topics::control::query_option::id, &dds_device_server::on_query_option },
         { topics::control::query_options::id, &dds_device_server::on_query_options },
         // These are the ones handle internally -- our owner may handle application-dependent controls
@@ -374,11 +385,66 @@ void dds_device_server::on_set_option( control_sample const & control, json & re
     std::shared_ptr< dds_option > option = get_option( option_name, stream_name );
 
     json value = control.json.at( topics::control::set_option::key::value );  // mandatory; throws
+    reply[topics::reply::set_option::key::value] = set_option( option, std::move( value ) );
+}
+
+
+json dds_device_server::set_option( std::shared_ptr< dds_option > const & option, json value )
+{
     if( _set_option_callback )
         _set_option_callback( option, value );  // Let our owner have final say
     // Ensure realdds option is up to date with actual value from callback
     option->set_value( std::move( value ) );
-    reply[topics::reply::set_option::key::value] = option->get_value();
+    return option->get_value();
+}
+
+
+void dds_device_server::on_set_options( control_sample const & control, json & reply )
+{
+    // Same stream->option->value mapping as query-options: we set them all in order, and reply with the values that
+    // were actually set. Failures don't stop the rest, but do make the reply an error.
+    auto option_values_j = control.json.nested( topics::control::set_options::key::option_values );
+    if( ! option_values_j.is_object() )
+        DDS_THROW( runtime_error, "option-values expected as an object" );
+
+    json & option_values = reply[topics::reply::set_options::key::option_values] = json::object();
+    std::vector< std::string > errors;
+    auto try_set = [&]( std::string const & option_name, std::string const & stream_name, json const & value )
+    {
+        try
+        {
+            auto actual = set_option( get_option( option_name, stream_name ), value );
+            if( stream_name.empty() )
+                option_values[option_name] = std::move( actual );
+            else
+                option_values[stream_name][option_name] = std::move( actual );
+        }
+        catch( std::exception const & e )
+        {
+            errors.push_back( e.what() );
+        }
+    };
+
+    for( auto it = option_values_j.begin(); it != option_values_j.end(); ++it )
+    {
+        if( it->is_object() )
+        {
+            for( auto option_it = it->begin(); option_it != it->end(); ++option_it )
+                try_set( option_it.key(), it.key(), option_it.value() );
+        }
+        else
+        {
+            try_set( it.key(), std::string(), it.value() );
+        }
+    }
+
+    if( ! errors.empty() )
+    {
+        std::string explanation = std::to_string( errors.size() ) + " of the options failed: " + errors.front();
+        for( size_t i = 1; i < errors.size(); ++i )
+            explanation += "; " + errors[i];
+        DDS_THROW( runtime_error, explanation );
+    }
 }
 
 
@@ -8,7 +8,6 @@
 #include <realdds/topics/dds-topic-names.h>
 #include "dds-device-impl.h"
 
-#include <rsutils/time/timer.h>
 #include <rsutils/json.h>
 
 using rsutils::json;
@@ -45,22 +44,21 @@ void dds_device::wait_until_ready( size_t timeout_ms )
         DDS_THROW( runtime_error, "device is " << ( is_online() ? "not ready" : "offline" ) );
 
     LOG_DEBUG( "[" << debug_name() << "] waiting until ready ..." );
-    rsutils::time::timer timer{ std::chrono::milliseconds( timeout_ms ) };
     bool was_online = is_online();
-    do
-    {
-        if( timer.has_expired() )
-            DDS_THROW( runtime_error, "[" << debug_name() << "] timeout waiting to get ready" );
-        std::this_thread::sleep_for( std::chrono::milliseconds( 500 ) );
-        if( was_online )
-        {
-            if( ! is_online() )
-                DDS_THROW( runtime_error, "[" << debug_name() << "] device went offline" );
-        }
-        else
-            was_online = is_online();
-    }
-    while( ! is_ready() );
+    bool went_offline = false;
+    std::unique_lock< std::mutex > lock( _impl->_state_mutex );
+    if( ! _impl->_state_cv.wait_for( lock,
+                                     std::chrono::milliseconds( timeout_ms ),
+                                     [&]()
+                                     {
+                                         if( was_online && ! is_online() )
+                                             went_offline = true;
+                                         was_online = is_online();
+                                         return went_offline || is_ready();
+                                     } ) )
+        DDS_THROW( runtime_error, "[" << debug_name() << "] timeout waiting to get ready" );
+    if( went_offline )
+        DDS_THROW( runtime_error, "[" << debug_name() << "] device went offline" );
 }
 
 
@@ -73,14 +71,9 @@ void dds_device::wait_until_online( size_t timeout_ms )
         DDS_THROW( runtime_error, "device is offline" );
 
     LOG_DEBUG( "[" << debug_name() << "] waiting until online ..." );
-    rsutils::time::timer timer{ std::chrono::milliseconds( timeout_ms ) };
-    do
-    {
-        if( timer.has_expired() )
-            DDS_THROW( runtime_error, "[" << debug_name() << "] timeout waiting to come online" );
-        std::this_thread::sleep_for( std::chrono::milliseconds( 500 ) );
-    }
-    while( ! is_online() );
+    std::unique_lock< std::mutex > lock( _impl->_state_mutex );
+    if( ! _impl->_state_cv.wait_for( lock, std::chrono::milliseconds( timeout_ms ), [this] { return is_online(); } ) )
+        DDS_THROW( runtime_error, "[" << debug_name() << "] timeout waiting to come online" );
 }
 
 
@@ -93,14 +86,9 @@ void dds_device::wait_until_offline( size_t timeout_ms )
         DDS_THROW( runtime_error, "device is online" );
 
     LOG_DEBUG( "[" << debug_name() << "] waiting until offline ..." );
-    rsutils::time::timer timer{ std::chrono::milliseconds( timeout_ms ) };
-    do
-    {
-        if( timer.has_expired() )
-            DDS_THROW( runtime_error, "[" << debug_name() << "] timeout waiting to go offline" );
-        std::this_thread::sleep_for( std::chrono::milliseconds( 500 ) );
-    }
-    while( ! is_offline() );
+    std::unique_lock< std::mutex > lock( _impl->_state_mutex );
+    if( ! _impl->_state_cv.wait_for( lock, std::chrono::milliseconds( timeout_ms ), [this] { return is_offline(); } ) )
+        DDS_THROW( runtime_error, "[" << debug_name() << "] timeout waiting to go offline" );
 }
 
 
@@ -126,7 +114,8 @@ void dds_device::on_discovery_restored( topics::device_info const & new_info )
 
     _impl->_info = new_info;
     _impl->set_state( impl::state_t::ONLINE );
-    // NOTE: still not ready - pending handshake/reinitialization
+    // NOTE: still not ready - pending handshake/reinitialization, unless we've seen its like before
+    _impl->init_from_cache();
 }
 
 
@@ -155,6 +144,11 @@ dds_guid const & dds_device::server_guid() const
     return _impl->_server_guid;
 }
 
+rsutils::json const & dds_device::init_timing() const
+{
+    return _impl->_init_timing;
+}
+
 dds_guid const & dds_device::guid() const
 {
     return _impl->guid();
@@ -175,6 +169,20 @@ size_t dds_device::foreach_stream( std::function< void( std::shared_ptr< dds_str
     return _impl->_streams.size();
 }
 
+json dds_device::get_statistics() const
+{
+    json streams = json::object();
+    for( auto const & stream : _impl->_streams )
+        if( stream.second->is_open() )
+            streams[stream.first] = stream.second->get_statistics().to_json();
+    json j = json::object( { { "streams", std::move( streams ) } } );
+    if( auto reader = _impl->_metadata_reader )
+        j["metadata"] = reader->statistics().get().to_json();
+    if( auto reader = _impl->_notifications_reader )
+        j["notification"] = reader->statistics().get().to_json();
+    return j;
+}
+
 size_t dds_device::foreach_option( std::function< void( std::shared_ptr< dds_option > option ) > fn ) const
 {
     for( auto const & option : _impl->_options)
@@ -197,6 +205,13 @@ void dds_device::set_option_value( const std::shared_ptr< dds_option > & option,
     _impl->set_option_value( option, std::move( new_value ) );
 }
 
+void dds_device::set_option_values( std::vector< std::pair< std::shared_ptr< dds_option >, json > > const & values,
+                                    bool wait_for_reply )
+{
+    wait_until_ready( 0 );  // throw if not
+    _impl->set_option_values( values, wait_for_reply );
+}
+
 json dds_device::query_option_value( const std::shared_ptr< dds_option > & option )
 {
     wait_until_ready( 0 );  // throw if not
@@ -8,8 +8,8 @@
 namespace realdds {
 
 
-const size_t dds_metadata_syncer::max_md_queue_size = 8;
-const size_t dds_metadata_syncer::max_frame_queue_size = 2;
+constexpr size_t dds_metadata_syncer::max_md_queue_size;
+constexpr size_t dds_metadata_syncer::max_frame_queue_size;
 
 
 dds_metadata_syncer::dds_metadata_syncer()
@@ -29,6 +29,16 @@ dds_metadata_syncer::~dds_metadata_syncer()
 }
 
 
+dds_metadata_syncer::statistics dds_metadata_syncer::get_statistics() const
+{
+    statistics stats;
+    stats.matched = _n_matched.load( std::memory_order_relaxed );
+    stats.frames_without_metadata = _n_frames_without_metadata.load( std::memory_order_relaxed );
+    stats.metadata_dropped = _n_metadata_dropped.load( std::memory_order_relaxed );
+    return stats;
+}
+
+
 void dds_metadata_syncer::enqueue_frame( key_type id, frame_holder && frame )
 {
     std::weak_ptr< bool > alive = _is_alive;
@@ -39,6 +49,9 @@ void dds_metadata_syncer::enqueue_frame( key_type id, frame_holder && frame )
     // Expect increasing order
     if( ! _frame_queue.empty() && _frame_queue.back().first >= id )
         DDS_THROW( runtime_error, "frame " << id << " cannot be enqueued after " << _frame_queue.back().first );
+    // Frames come from the one thread, which trims the queue before it's back: there's always room for one more
+    if( _frame_queue.size() > max_frame_queue_size )
+        DDS_THROW( runtime_error, "frame " << id << " enqueued concurrently with another" );
 
     // We must push the new one before releasing the lock, else someone else may push theirs ahead of ours
     _frame_queue.push_back( key_frame{ id, std::move( frame ) } );
@@ -61,6 +74,8 @@ void dds_metadata_syncer::enqueue_metadata( key_type id, metadata_type const & m
     // Expect increasing order
     if( ! _metadata_queue.empty() && _metadata_queue.back().first >= id )
         DDS_THROW( runtime_error, "metadata " << id << " cannot be enqueued after " << _metadata_queue.back().first );
+    if( _metadata_queue.size() > max_md_queue_size )
+        DDS_THROW( runtime_error, "metadata " << id << " enqueued concurrently with another" );
 
     // We must push the new one before releasing the lock, else someone else may push theirs ahead of ours
     _metadata_queue.push_back( key_metadata{ id, md } );
@@ -111,6 +126,7 @@ bool dds_metadata_syncer::handle_match( std::unique_lock< std::mutex > & lock )
     metadata_type md = std::move( _metadata_queue.front().second );
     _metadata_queue.pop_front();
     _frame_queue.pop_front();
+    _n_matched.fetch_add( 1, std::memory_order_relaxed );
 
     if( _on_frame_ready )
     {
@@ -131,6 +147,7 @@ bool dds_metadata_syncer::handle_frame_without_metadata( std::unique_lock< std::
 
     frame_holder fh = std::move( _frame_queue.front().second );
     _frame_queue.pop_front();
+    _n_frames_without_metadata.fetch_add( 1, std::memory_order_relaxed );
 
     if( _on_frame_ready )
     {
@@ -152,6 +169,7 @@ bool dds_metadata_syncer::drop_metadata( std::unique_lock< std::mutex > & lock )
     auto key = _metadata_queue.front().first;
     auto md = std::move( _metadata_queue.front().second );
     _metadata_queue.pop_front();  // Throw oldest
+    _n_metadata_dropped.fetch_add( 1, std::memory_order_relaxed );
     if( _on_metadata_dropped )
     {
         lock.unlock();
@@ -102,6 +102,12 @@ void dds_notification_server::run()
 {
     if( ! _active )
     {
+        if( _discovery_notifications.size() > 1
+            && _publisher->get_participant()
+                   ->settings()
+                   .nested( "device", "notification", "batch-discovery" )
+                   .default_value( true ) )
+            batch_discovery_notifications();
         _active = true;
         _notifications_loop.start();
         // if any discovery happened before we started, _send_init_msgs will be true and we shouldn't even wait...
@@ -155,6 +161,44 @@ void dds_notification_server::add_discovery_notification( topics::flexible_msg &
 }
 
 
+void dds_notification_server::batch_discovery_notifications()
+{
+    // Clients take an array of notifications as if they were sent one by one; sending them together saves a round of
+    // reliable writes (and acknowledgements) per message, which adds up with many streams and many clients
+    for( auto & notification : _discovery_notifications )
+        if( notification.data_format() != topics::raw::FLEXIBLE_DATA_JSON )
+            return;  // Only JSON can be batched
+
+    // Messages are bound in size (see flexible.idl), so each batch is filled up to that; a notification that's too
+    // big to share goes out on its own, as before
+    size_t const max_size = 4096;
+    std::vector< topics::raw::flexible > batches;
+    rsutils::json batch = rsutils::json::array();
+    size_t batch_size = 2;  // []
+    auto flush = [&]()
+    {
+        if( batch.size() == 1 )
+            batches.push_back( topics::flexible_msg( batch[0] ).to_raw() );
+        else if( batch.size() )
+            batches.push_back( topics::flexible_msg( batch ).to_raw() );
+        batch = rsutils::json::array();
+        batch_size = 2;
+    };
+    for( auto & notification : _discovery_notifications )
+    {
+        auto const size = notification.data().size();
+        if( batch.size() && batch_size + 1 + size > max_size )
+            flush();
+        batch_size += size + ( batch.size() ? 1 : 0 );  // With a comma
+        batch.push_back( topics::flexible_msg( std::move( notification ) ).json_data() );
+    }
+    flush();
+
+    LOG_DEBUG( _discovery_notifications.size() << " discovery notifications batched into " << batches.size() );
+    _discovery_notifications = std::move( batches );
+}
+
+
 void dds_notification_server::send_discovery_notifications()
 {
     // Send all initialization notifications
@@ -148,7 +148,10 @@ void dds_option::init_stream( std::shared_ptr< dds_stream_base > const & stream
 void dds_option::set_value( rsutils::json value )
 {
     check_value( value );
+    if( value == _value )
+        return;
     _value = std::move( value );
+    _on_value_changed.raise( _value );
 }
 
 
@@ -13,6 +13,7 @@
 #include <fastrtps/types/DynamicDataFactory.h>
 #include <fastdds/dds/core/status/SubscriptionMatchedStatus.hpp>
 #include <fastdds/rtps/transport/UDPv4TransportDescriptor.h>
+#include <fastdds/rtps/flowcontrol/FlowControllerDescriptor.hpp>
 
 #include <rsutils/string/slice.h>
 #include <rsutils/json.h>
@@ -224,6 +225,15 @@ void dds_participant::init( dds_domain_id domain_id, std::string const & partici
     pqos.transport().use_builtin_transports = false;
     pqos.transport().user_transports.push_back( udp_transport );
 
+    // Big samples (images) get split into many fragments that, all sent at once, overflow switches and receive buffers
+    // and one lost fragment loses the sample. Writers with the "large-data" profile are throttled through this instead
+    // (about 800 Mbps).
+    auto large_data = std::make_shared< eprosima::fastdds::rtps::FlowControllerDescriptor >();
+    large_data->name = "large-data";
+    large_data->max_bytes_per_period = 1000000;
+    large_data->period_ms = 10;
+    pqos.flow_controllers().push_back( large_data );
+
     // Above are defaults
     override_participant_qos_from_json( pqos, settings );
 
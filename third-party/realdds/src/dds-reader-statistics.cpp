@@ -0,0 +1,82 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <realdds/dds-reader-statistics.h>
+
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+
+#include <rsutils/json.h>
+
+
+namespace realdds {
+
+
+void dds_reader_statistics::on_sample( size_t bytes, dds_nsec latency )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    if( ! _values.received++ || latency < _values.latency_min )
+        _values.latency_min = latency;
+    if( latency > _values.latency_max )
+        _values.latency_max = latency;
+    _values.latency_total += latency;
+    _values.bytes += bytes;
+}
+
+
+void dds_reader_statistics::on_sample( size_t bytes, eprosima::fastdds::dds::SampleInfo const & info )
+{
+    on_sample( bytes, info.reception_timestamp.to_ns() - info.source_timestamp.to_ns() );
+}
+
+
+void dds_reader_statistics::on_lost( uint64_t count )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    _values.lost += count;
+}
+
+
+void dds_reader_statistics::on_callback( dds_nsec duration, uint64_t queue_depth )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    ++_values.callbacks;
+    if( duration > _values.callback_max )
+        _values.callback_max = duration;
+    _values.callback_total += duration;
+    if( queue_depth > _values.queue_max )
+        _values.queue_max = queue_depth;
+}
+
+
+dds_reader_statistics::values dds_reader_statistics::get() const
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    return _values;
+}
+
+
+void dds_reader_statistics::reset()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    _values = values();
+}
+
+
+rsutils::json dds_reader_statistics::values::to_json() const
+{
+    auto ms = []( double ns ) { return ns / 1e6; };
+    rsutils::json j = rsutils::json::object( { { "received", received }, { "lost", lost }, { "bytes", bytes } } );
+    if( received )
+        j["latency-ms"] = rsutils::json::object( { { "min", ms( double( latency_min ) ) },
+                                                   { "avg", ms( double( latency_total ) / received ) },
+                                                   { "max", ms( double( latency_max ) ) } } );
+    j["callbacks"] = callbacks;
+    if( callbacks )
+        j["callback-ms"] = rsutils::json::object(
+            { { "avg", ms( double( callback_total ) / callbacks ) }, { "max", ms( double( callback_max ) ) } } );
+    j["queue-max"] = queue_max;
+    return j;
+}
+
+
+}  // namespace realdds
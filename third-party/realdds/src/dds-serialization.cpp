@@ -10,11 +10,18 @@
 
 #include <fastdds/dds/domain/qos/DomainParticipantQos.hpp>
 #include <fastdds/rtps/transport/UDPTransportDescriptor.h>
+#include <fastdds/rtps/transport/TCPv4TransportDescriptor.h>
+#include <fastdds/rtps/transport/shared_mem/SharedMemTransportDescriptor.h>
+#include <fastrtps/utils/IPLocator.h>
 
 #include <rsutils/string/from.h>
 #include <rsutils/string/nocase.h>
+#include <rsutils/string/string-utilities.h>
 #include <rsutils/json.h>
 
+#include <mutex>
+#include <set>
+
 
 namespace eprosima {
 namespace fastdds {
@@ -328,12 +335,169 @@ void override_data_sharing_qos_from_json( eprosima::fastdds::dds::DataSharingQos
 }
 
 
+void override_time_based_filter_qos_from_json( eprosima::fastdds::dds::TimeBasedFilterQosPolicy & qos,
+                                               rsutils::json const & j )
+{
+    if( j.is_number() )
+        j.get_to( qos.minimum_separation );
+    else if( j.exists() )
+        DDS_THROW( runtime_error, "time-based-filter must be a number of seconds; got " << j );
+}
+
+
+static eprosima::fastrtps::rtps::Locator_t locator_from_string( std::string const & str, int32_t kind )
+{
+    // "192.168.1.10:7400"
+    auto colon = str.find( ':' );
+    int port = 0;
+    eprosima::fastrtps::rtps::Locator_t locator;
+    locator.kind = kind;
+    if( colon == std::string::npos || ! rsutils::string::string_to_value( str.substr( colon + 1 ), port )
+        || port <= 0 || port > 65535
+        || ! eprosima::fastrtps::rtps::IPLocator::setIPv4( locator, str.substr( 0, colon ) ) )
+        DDS_THROW( runtime_error, "invalid locator '" << str << "'; expecting \"<ip>:<port>\"" );
+    locator.port = uint32_t( port );
+    return locator;
+}
+
+
+static eprosima::fastrtps::rtps::Locator_t multicast_locator_from_string( std::string const & str )
+{
+    // "239.255.0.1:7900"
+    auto locator = locator_from_string( str, LOCATOR_KIND_UDPv4 );
+    if( ! eprosima::fastrtps::rtps::IPLocator::isMulticast( locator ) )
+        DDS_THROW( runtime_error, "invalid multicast locator '" << str << "'; expecting \"<multicast-ip>:<port>\"" );
+    return locator;
+}
+
+
 void override_endpoint_qos_from_json( eprosima::fastdds::dds::RTPSEndpointQos & qos, rsutils::json const & j )
 {
     if( j.is_object() )
     {
         if( auto policy_j = j.nested( "history-memory-policy", &rsutils::json::is_string ) )
             qos.history_memory_policy = history_memory_policy_from_string( policy_j.string_ref() );
+        if( auto multicast_j = j.nested( "multicast" ) )
+        {
+            if( multicast_j.is_string() )
+                qos.multicast_locator_list.push_back( multicast_locator_from_string( multicast_j.string_ref() ) );
+            else if( multicast_j.is_array() )
+            {
+                for( auto & locator_j : multicast_j )
+                {
+                    if( ! locator_j.is_string() )
+                        DDS_THROW( runtime_error, "multicast locators must be strings; got " << locator_j );
+                    qos.multicast_locator_list.push_back( multicast_locator_from_string( locator_j.string_ref() ) );
+                }
+            }
+            else
+                DDS_THROW( runtime_error, "multicast must be a locator or an array of them; got " << multicast_j );
+        }
+    }
+}
+
+
+// FastDDS keeps flow-controller names as raw pointers, in both the participant and the writer QoS, so they have to
+// outlive both
+static char const * flow_controller_name( std::string const & name )
+{
+    static std::set< std::string > names;
+    static std::mutex mutex;
+    std::lock_guard< std::mutex > lock( mutex );
+    return names.insert( name ).first->c_str();
+}
+
+
+void override_publish_mode_qos_from_json( eprosima::fastdds::dds::PublishModeQosPolicy & qos, rsutils::json const & j )
+{
+    auto kind_from_string = []( std::string const & s )
+    {
+        if( s == "synchronous" )
+            return eprosima::fastdds::dds::SYNCHRONOUS_PUBLISH_MODE;
+        if( s == "asynchronous" )
+            return eprosima::fastdds::dds::ASYNCHRONOUS_PUBLISH_MODE;
+        DDS_THROW( runtime_error, "invalid publish mode '" << s << "'" );
+    };
+
+    if( j.is_string() )
+        qos.kind = kind_from_string( j.string_ref() );
+    else if( j.is_object() )
+    {
+        if( auto kind_j = j.nested( "kind", &rsutils::json::is_string ) )
+            qos.kind = kind_from_string( kind_j.string_ref() );
+        if( auto controller_j = j.nested( "flow-controller", &rsutils::json::is_string ) )
+        {
+            qos.kind = eprosima::fastdds::dds::ASYNCHRONOUS_PUBLISH_MODE;
+            qos.flow_controller_name = flow_controller_name( controller_j.string_ref() );
+        }
+    }
+    else if( j.exists() )
+        DDS_THROW( runtime_error, "publish-mode must be a string or an object; got " << j );
+}
+
+
+rsutils::json const & qos_profile( std::string const & name )
+{
+    static rsutils::json const none = rsutils::json::object();
+    static rsutils::json const large_data = rsutils::json::parse( R"({
+        "publish-mode": { "kind": "asynchronous", "flow-controller": "large-data" }
+        })" );
+    static rsutils::json const large_data_reliable = rsutils::json::parse( R"({
+        "publish-mode": { "kind": "asynchronous", "flow-controller": "large-data" },
+        "reliability": "reliable",
+        "history": 1
+        })" );
+
+    if( name == "default" || name == "auto" )
+        return none;
+    if( name == "large-data" )
+        return large_data;
+    if( name == "large-data-reliable" )
+        return large_data_reliable;
+    DDS_THROW( runtime_error, "invalid QoS profile '" << name << "'" );
+}
+
+
+static eprosima::fastdds::rtps::FlowControllerSchedulerPolicy scheduler_from_string( std::string const & s )
+{
+    if( s == "fifo" )
+        return eprosima::fastdds::rtps::FlowControllerSchedulerPolicy::FIFO;
+    if( s == "round-robin" )
+        return eprosima::fastdds::rtps::FlowControllerSchedulerPolicy::ROUND_ROBIN;
+    if( s == "high-priority" )
+        return eprosima::fastdds::rtps::FlowControllerSchedulerPolicy::HIGH_PRIORITY;
+    if( s == "priority-with-reservation" )
+        return eprosima::fastdds::rtps::FlowControllerSchedulerPolicy::PRIORITY_WITH_RESERVATION;
+    DDS_THROW( runtime_error, "invalid flow-controller scheduler '" << s << "'" );
+}
+
+
+static void override_flow_controllers( eprosima::fastdds::dds::DomainParticipantQos & qos, rsutils::json const & j )
+{
+    if( ! j.is_object() )
+        DDS_THROW( runtime_error, "flow-controllers must be an object of name:settings; got " << j );
+    for( auto it = j.begin(); it != j.end(); ++it )
+    {
+        auto name = flow_controller_name( it.key() );
+        std::shared_ptr< eprosima::fastdds::rtps::FlowControllerDescriptor > controller;
+        for( auto & fc : qos.flow_controllers() )
+            if( fc->name && it.key() == fc->name )
+            {
+                controller = fc;
+                break;
+            }
+        if( ! controller )
+        {
+            controller = std::make_shared< eprosima::fastdds::rtps::FlowControllerDescriptor >();
+            qos.flow_controllers().push_back( controller );
+        }
+        controller->name = name;
+
+        rsutils::json const & fc_j = it.value();
+        fc_j.nested( "max-bytes-per-period" ).get_ex( controller->max_bytes_per_period );
+        fc_j.nested( "period-ms" ).get_ex( controller->period_ms );
+        if( auto scheduler_j = fc_j.nested( "scheduler", &rsutils::json::is_string ) )
+            controller->scheduler = scheduler_from_string( scheduler_j.string_ref() );
     }
 }
 
@@ -382,6 +546,52 @@ void override_participant_qos_from_json( eprosima::fastdds::dds::DomainParticipa
                 break;
             }
     }
+
+    if( auto controllers_j = j.nested( "flow-controllers" ) )
+        override_flow_controllers( qos, controllers_j );
+
+    // Shared memory is off by default; see dds_participant::init()
+    if( auto shm_j = j.nested( "shm" ) )
+    {
+        if( shm_j.is_object() || ( shm_j.is_boolean() && shm_j.get< bool >() ) )
+        {
+            auto shm_t = std::make_shared< eprosima::fastdds::rtps::SharedMemTransportDescriptor >();
+            uint32_t segment_size;
+            if( shm_j.nested( "segment-size" ).get_ex( segment_size ) )
+                shm_t->segment_size( segment_size );
+            qos.transport().user_transports.push_back( shm_t );
+        }
+        else if( ! shm_j.is_boolean() )
+            DDS_THROW( runtime_error, "shm must be a boolean or an object; got " << shm_j );
+    }
+
+    // TCP goes where multicast discovery doesn't, and lets the network (rather than us) deal with lost fragments
+    if( auto tcp_j = j.nested( "tcp" ) )
+    {
+        if( ! tcp_j.is_object() )
+            DDS_THROW( runtime_error, "tcp must be an object; got " << tcp_j );
+        auto tcp_t = std::make_shared< eprosima::fastdds::rtps::TCPv4TransportDescriptor >();
+        uint16_t port;
+        if( tcp_j.nested( "port" ).get_ex( port ) )
+            tcp_t->add_listener_port( port );
+        tcp_j.nested( "send-buffer-size" ).get_ex( tcp_t->sendBufferSize );
+        tcp_j.nested( "receive-buffer-size" ).get_ex( tcp_t->receiveBufferSize );
+        if( ! parse_ip_list( tcp_j, "whitelist", &tcp_t->interfaceWhiteList ) )
+            LOG_WARNING( "invalid TCP whitelist in settings" );
+        if( auto peers_j = tcp_j.nested( "peers" ) )
+        {
+            if( ! peers_j.is_array() )
+                DDS_THROW( runtime_error, "tcp peers must be an array of \"<ip>:<port>\"; got " << peers_j );
+            for( auto & peer_j : peers_j )
+            {
+                if( ! peer_j.is_string() )
+                    DDS_THROW( runtime_error, "tcp peers must be strings; got " << peer_j );
+                qos.wire_protocol().builtin.initialPeersList.push_back(
+                    locator_from_string( peer_j.string_ref(), LOCATOR_KIND_TCPv4 ) );
+            }
+        }
+        qos.transport().user_transports.push_back( tcp_t );
+    }
 }
 
 
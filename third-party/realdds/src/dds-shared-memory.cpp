@@ -0,0 +1,367 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <realdds/dds-shared-memory.h>
+#include <realdds/dds-exceptions.h>
+
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace realdds {
+
+
+namespace {
+
+
+// The segment starts with a header, then all the slot headers, then the slots themselves; all on cache lines of their
+// own so readers and the writer don't fight over them
+size_t const LINE = 64;
+
+struct segment_header
+{
+    uint64_t magic;
+    uint64_t id;
+    uint32_t n_slots;
+    uint32_t slot_size;
+};
+
+struct slot_header
+{
+    // Readers holding the slot, plus WRITING while the writer has it (readers that find it set let go right away) and
+    // ALLOCATED while the frame in it, from allocate(), is still held on our side
+    std::atomic< uint32_t > refs;
+    std::atomic< uint64_t > sequence;
+};
+
+uint32_t const WRITING = 0x80000000u;
+uint32_t const ALLOCATED = 0x40000000u;
+
+static_assert( sizeof( segment_header ) <= LINE && sizeof( slot_header ) <= LINE, "headers must fit a line" );
+
+
+size_t round_up( size_t size )
+{
+    return ( size + LINE - 1 ) / LINE * LINE;
+}
+
+
+size_t segment_size( uint32_t n_slots, size_t slot_size )
+{
+    return LINE * ( 1 + n_slots ) + n_slots * slot_size;
+}
+
+
+slot_header * slot_header_at( uint8_t * base, uint32_t slot )
+{
+    return reinterpret_cast< slot_header * >( base + LINE * ( 1 + slot ) );
+}
+
+
+uint8_t * slot_data_at( uint8_t * base, uint32_t n_slots, size_t slot_size, uint32_t slot )
+{
+    return base + LINE * ( 1 + n_slots ) + slot * slot_size;
+}
+
+
+}  // namespace
+
+
+bool dds_shm_ref::from_bytes( uint8_t const * data, size_t n )
+{
+    if( n != sizeof( dds_shm_ref ) )
+        return false;
+    memcpy( this, data, n );
+    segment_name[sizeof( segment_name ) - 1] = 0;
+    return magic == MAGIC;
+}
+
+
+#ifndef _WIN32
+
+
+struct dds_shm_writer::impl
+{
+    std::string name;
+    uint64_t id;
+    uint32_t n_slots;
+    size_t slot_size;
+    size_t size;
+    uint8_t * base = nullptr;
+    uint32_t next = 0;
+    uint64_t sequence = 0;
+    std::mutex mutex;  // Frames are allocated and written from different threads
+};
+
+
+dds_shm_writer::dds_shm_writer( uint32_t n_slots, size_t slot_size )
+    : _impl( new impl )
+{
+    static std::atomic< unsigned > counter( 0 );
+    _impl->name = "/realdds-" + std::to_string( getpid() ) + "-" + std::to_string( counter++ );
+    std::random_device rd;
+    _impl->id = ( uint64_t( rd() ) << 32 ) ^ rd()
+              ^ uint64_t( std::chrono::steady_clock::now().time_since_epoch().count() );
+    _impl->n_slots = n_slots;
+    _impl->slot_size = round_up( slot_size );
+    _impl->size = segment_size( n_slots, _impl->slot_size );
+
+    int fd = shm_open( _impl->name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600 );
+    if( fd < 0 )
+        DDS_THROW( runtime_error, "failed to create shared memory '" << _impl->name << "': " << strerror( errno ) );
+    bool ok = ftruncate( fd, off_t( _impl->size ) ) == 0;
+    void * p = ok ? mmap( nullptr, _impl->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 ) : MAP_FAILED;
+    int error = errno;
+    close( fd );
+    if( p == MAP_FAILED )
+    {
+        shm_unlink( _impl->name.c_str() );
+        DDS_THROW( runtime_error, "failed to map shared memory '" << _impl->name << "': " << strerror( error ) );
+    }
+    _impl->base = static_cast< uint8_t * >( p );
+
+    // Fresh from ftruncate, it's all zeros: no slot is held and none has a frame
+    auto header = reinterpret_cast< segment_header * >( _impl->base );
+    header->n_slots = n_slots;
+    header->slot_size = uint32_t( _impl->slot_size );
+    header->id = _impl->id;
+    std::atomic_thread_fence( std::memory_order_release );
+    header->magic = dds_shm_ref::MAGIC;
+}
+
+
+dds_shm_writer::~dds_shm_writer()
+{
+    // Readers that have it mapped keep it until they let go
+    munmap( _impl->base, _impl->size );
+    shm_unlink( _impl->name.c_str() );
+}
+
+
+// The slot the data starts, or n_slots if it's not one
+static uint32_t slot_of( uint8_t const * base, uint32_t n_slots, size_t slot_size, void const * data )
+{
+    auto first = slot_data_at( const_cast< uint8_t * >( base ), n_slots, slot_size, 0 );
+    auto p = static_cast< uint8_t const * >( data );
+    if( p < first || p >= first + n_slots * slot_size || ( p - first ) % slot_size )
+        return n_slots;
+    return uint32_t( ( p - first ) / slot_size );
+}
+
+
+bool dds_shm_writer::write( void const * data, size_t size, dds_shm_ref & ref )
+{
+    if( size > _impl->slot_size )
+        return false;
+
+    std::lock_guard< std::mutex > lock( _impl->mutex );
+    uint32_t slot = slot_of( _impl->base, _impl->n_slots, _impl->slot_size, data );
+    if( slot < _impl->n_slots )
+    {
+        // Already in place; it's ours only if it was allocated and not yet written
+        auto header = slot_header_at( _impl->base, slot );
+        if( ! ( header->refs.load( std::memory_order_relaxed ) & WRITING ) )
+            return false;
+        header->sequence.store( ++_impl->sequence, std::memory_order_relaxed );
+        header->refs.fetch_sub( WRITING, std::memory_order_release );
+    }
+    else
+    {
+        for( uint32_t i = 0; i < _impl->n_slots && slot == _impl->n_slots; ++i )
+        {
+            uint32_t candidate = ( _impl->next + i ) % _impl->n_slots;
+            uint32_t free = 0;
+            if( slot_header_at( _impl->base, candidate )
+                    ->refs.compare_exchange_strong( free, WRITING, std::memory_order_acquire ) )
+                slot = candidate;
+        }
+        if( slot == _impl->n_slots )
+            return false;
+
+        auto header = slot_header_at( _impl->base, slot );
+        memcpy( slot_data_at( _impl->base, _impl->n_slots, _impl->slot_size, slot ), data, size );
+        header->sequence.store( ++_impl->sequence, std::memory_order_relaxed );
+        header->refs.fetch_sub( WRITING, std::memory_order_release );  // Not a store: readers may have come and gone
+        _impl->next = slot + 1;
+    }
+
+    ref = dds_shm_ref();
+    ref.segment_id = _impl->id;
+    ref.sequence = _impl->sequence;
+    ref.slot = slot;
+    ref.size = uint32_t( size );
+    strncpy( ref.segment_name, _impl->name.c_str(), sizeof( ref.segment_name ) - 1 );
+    return true;
+}
+
+
+void * dds_shm_writer::allocate( size_t size )
+{
+    if( size > _impl->slot_size )
+        return nullptr;
+
+    std::lock_guard< std::mutex > lock( _impl->mutex );
+    for( uint32_t i = 0; i < _impl->n_slots; ++i )
+    {
+        uint32_t slot = ( _impl->next + i ) % _impl->n_slots;
+        uint32_t free = 0;
+        if( ! slot_header_at( _impl->base, slot )
+                  ->refs.compare_exchange_strong( free, WRITING | ALLOCATED, std::memory_order_acquire ) )
+            continue;
+        _impl->next = slot + 1;
+        return slot_data_at( _impl->base, _impl->n_slots, _impl->slot_size, slot );
+    }
+    return nullptr;
+}
+
+
+void dds_shm_writer::release( void const * data )
+{
+    uint32_t slot = slot_of( _impl->base, _impl->n_slots, _impl->slot_size, data );
+    if( slot < _impl->n_slots )
+        // Written or not; readers may still be holding it
+        slot_header_at( _impl->base, slot )->refs.fetch_and( ~( WRITING | ALLOCATED ), std::memory_order_release );
+}
+
+
+bool dds_shm_writer::owns( void const * data ) const
+{
+    return slot_of( _impl->base, _impl->n_slots, _impl->slot_size, data ) < _impl->n_slots;
+}
+
+
+size_t dds_shm_writer::slot_size() const
+{
+    return _impl->slot_size;
+}
+
+
+struct dds_shm_reader::segment
+{
+    std::string name;
+    uint64_t id = 0;
+    uint32_t n_slots = 0;
+    size_t slot_size = 0;
+    size_t size = 0;
+    uint8_t * base = nullptr;
+
+    ~segment()
+    {
+        if( base )
+            munmap( base, size );
+    }
+
+    bool map( dds_shm_ref const & ref )
+    {
+        name = ref.segment_name;
+        int fd = shm_open( name.c_str(), O_RDWR, 0 );
+        if( fd < 0 )
+            return false;
+        struct stat st;
+        void * p = MAP_FAILED;
+        if( fstat( fd, &st ) == 0 && size_t( st.st_size ) >= LINE )
+        {
+            size = size_t( st.st_size );
+            p = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        }
+        close( fd );
+        if( p == MAP_FAILED )
+            return false;
+        base = static_cast< uint8_t * >( p );
+
+        auto header = reinterpret_cast< segment_header const * >( base );
+        if( header->magic != dds_shm_ref::MAGIC )
+            return false;
+        std::atomic_thread_fence( std::memory_order_acquire );
+        id = header->id;
+        n_slots = header->n_slots;
+        slot_size = header->slot_size;
+        return id == ref.segment_id && segment_size( n_slots, slot_size ) <= size;
+    }
+};
+
+
+std::shared_ptr< uint8_t const > dds_shm_reader::retain( dds_shm_ref const & ref )
+{
+    std::shared_ptr< segment > seg;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        if( ! _segment || _segment->id != ref.segment_id || _segment->name != ref.segment_name )
+        {
+            auto mapped = std::make_shared< segment >();
+            if( ! mapped->map( ref ) )
+            {
+                LOG_DEBUG( "failed to map shared memory '" << ref.segment_name << "'" );
+                return nullptr;
+            }
+            _segment = mapped;
+        }
+        seg = _segment;
+    }
+    if( ref.slot >= seg->n_slots || ref.size > seg->slot_size )
+        return nullptr;
+
+    auto header = slot_header_at( seg->base, ref.slot );
+    if( header->refs.fetch_add( 1, std::memory_order_acquire ) & WRITING
+        || header->sequence.load( std::memory_order_relaxed ) != ref.sequence )
+    {
+        header->refs.fetch_sub( 1, std::memory_order_relaxed );
+        return nullptr;  // Already taken for a newer frame
+    }
+
+    // The segment stays mapped for as long as any of its frames is held
+    return std::shared_ptr< uint8_t const >( slot_data_at( seg->base, seg->n_slots, seg->slot_size, ref.slot ),
+                                             [seg, header]( uint8_t const * )
+                                             { header->refs.fetch_sub( 1, std::memory_order_release ); } );
+}
+
+
+#else  // _WIN32
+
+
+struct dds_shm_writer::impl
+{
+};
+
+
+dds_shm_writer::dds_shm_writer( uint32_t, size_t )
+{
+    DDS_THROW( runtime_error, "shared memory is not supported on this platform" );
+}
+
+
+dds_shm_writer::~dds_shm_writer() {}
+bool dds_shm_writer::write( void const *, size_t, dds_shm_ref & ) { return false; }
+size_t dds_shm_writer::slot_size() const { return 0; }
+void * dds_shm_writer::allocate( size_t ) { return nullptr; }
+void dds_shm_writer::release( void const * ) {}
+bool dds_shm_writer::owns( void const * ) const { return false; }
+
+
+struct dds_shm_reader::segment
+{
+    uint64_t id = 0;
+};
+
+
+std::shared_ptr< uint8_t const > dds_shm_reader::retain( dds_shm_ref const & )
+{
+    return nullptr;
+}
+
+
+#endif
+
+
+}  // namespace realdds
@@ -67,7 +67,11 @@ enum rs2_format  // copy from rs2_sensor.h
     RS2_FORMAT_Z16H,  /**< Variable-length Huffman-compressed 16-bit depth values. */
     RS2_FORMAT_FG,    /**< 16-bit per-pixel frame grabber format. */
     RS2_FORMAT_Y411,  /**< 12-bit per-pixel. */
+    RS2_FORMAT_Y16I,
+    RS2_FORMAT_M420,
     RS2_FORMAT_COMBINED_MOTION,
+    RS2_FORMAT_Z16RVL,
+    RS2_FORMAT_Z16_SPARSE,
     RS2_FORMAT_COUNT  /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
 };
 
@@ -94,6 +98,8 @@ int dds_video_encoding::to_rs2() const
         { "BYR2", RS2_FORMAT_RAW16 },
         { "R10", RS2_FORMAT_RAW10 },
         { "Y10B", RS2_FORMAT_Y10BPACK },
+        { "16UC1; rvl", RS2_FORMAT_Z16RVL },  // Depth compressed for the wire; see dds_video_stream_server
+        { "16UC1; sparse", RS2_FORMAT_Z16_SPARSE },  // Likewise, the valid pixels only
     };
 
     std::string s = to_string();
@@ -128,6 +134,8 @@ dds_video_encoding dds_video_encoding::from_rs2( int rs2_format )
     case RS2_FORMAT_RAW10: encoding = "R10"; break;
     case RS2_FORMAT_UYVY: encoding = "uyvy"; break;
     case RS2_FORMAT_Y10BPACK: encoding = "Y10B"; break;
+    case RS2_FORMAT_Z16RVL: encoding = "16UC1; rvl"; break;
+    case RS2_FORMAT_Z16_SPARSE: encoding = "16UC1; sparse"; break;
     default:
         DDS_THROW( runtime_error, "cannot translate rs2_format " + std::to_string( rs2_format ) + " to any known dds_video_encoding" );
     };
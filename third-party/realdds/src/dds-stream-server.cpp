@@ -8,12 +8,17 @@
 #include <realdds/dds-participant.h>
 #include <realdds/dds-publisher.h>
 #include <realdds/dds-utilities.h>
+#include <realdds/dds-serialization.h>
 #include <realdds/topics/image-msg.h>
 #include <realdds/topics/imu-msg.h>
 #include <realdds/topics/flexible-msg.h>
 #include <realdds/topics/ros2/ros2imagePubSubTypes.h>
 #include <realdds/topics/ros2/ros2imuPubSubTypes.h>
 #include <realdds/dds-time.h>
+#include <realdds/dds-shared-memory.h>
+#include <realdds/dds-video-codec.h>
+
+#include <rsutils/json.h>
 
 #include <fastdds/dds/topic/Topic.hpp>
 #include <fastdds/dds/publisher/DataWriter.hpp>
@@ -94,7 +99,7 @@ void dds_video_stream_server::open( std::string const & topic_name, std::shared_
 
     auto topic = topics::image_msg::create_topic( publisher->get_participant(), topic_name.c_str() );
     _writer = std::make_shared< dds_topic_writer >( topic, publisher );
-
+    _shm_slots = publisher->get_participant()->settings().nested( "device", "shared-memory" ).default_value( 0u );
 
     run_stream();
 }
@@ -125,7 +130,39 @@ void dds_stream_server::run_stream()
             } );
     }
     
-    _writer->run( dds_topic_writer::qos( eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS ) );  // no retries
+    // Settings for all streams, then for this one by name
+    auto stream_settings = _writer->topic()->get_participant()->settings().nested( "device", "stream" );
+    auto own_settings = stream_settings.nested( name() );
+    std::string profile = own_settings.nested( "profile" ).default_value(
+        stream_settings.nested( "profile" ).default_value( std::string() ) );
+
+    dds_topic_writer::qos wqos( eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS );  // no retries
+    if( profile == "auto" )
+    {
+        // Samples bigger than a datagram get fragmented: those we throttle
+        size_t const threshold = own_settings.nested( "large-data-threshold" )
+                                     .default_value( stream_settings.nested( "large-data-threshold" )
+                                                         .default_value( size_t( 65000 ) ) );
+        if( max_sample_size() > threshold )
+        {
+            LOG_DEBUG( "'" << name() << "' samples of up to " << max_sample_size() << " bytes; using 'large-data'" );
+            wqos.override_from_json( qos_profile( "large-data" ) );
+        }
+    }
+    wqos.override_from_json( stream_settings );
+    wqos.override_from_json( own_settings );
+    _writer->run( wqos );
+}
+
+
+size_t dds_video_stream_server::max_sample_size() const
+{
+    // At least a byte per pixel, compression aside
+    size_t max_size = 0;
+    for( auto & profile : profiles() )
+        if( auto vp = std::dynamic_pointer_cast< dds_video_stream_profile >( profile ) )
+            max_size = std::max( max_size, size_t( vp->width() ) * vp->height() );
+    return max_size;
 }
 
 
@@ -165,8 +202,29 @@ void dds_stream_server::start_streaming()
 
 void dds_video_stream_server::start_streaming( const image_header & header )
 {
+    auto raw_encoding = _compression ? dds_video_encoder::raw( header.encoding ) : dds_video_encoding();
+    start_streaming( header, raw_encoding.is_valid() ? raw_encoding : header.encoding );
+}
+
+
+void dds_video_stream_server::start_streaming( const image_header & header, dds_video_encoding const & raw_encoding )
+{
+    std::shared_ptr< dds_video_encoder > encoder;
+    if( raw_encoding != header.encoding )
+    {
+        if( ! is_open() )
+            DDS_THROW( runtime_error, "stream '" + name() + "' must be open before start_streaming()" );
+        auto settings = _writer->topic()->get_participant()->settings().nested( "device" );
+        encoder = dds_video_encoder::create( raw_encoding, header.encoding, settings );
+        if( ! encoder )
+            DDS_THROW( runtime_error,
+                       "stream '" + name() + "' cannot compress " + raw_encoding.to_string() + " images to "
+                           + header.encoding.to_string() );
+    }
     super::start_streaming();
     _image_header = header;
+    _encoder = std::move( encoder );
+    _bandwidth_start = std::chrono::steady_clock::now();
 }
 
 
@@ -189,6 +247,10 @@ void dds_video_stream_server::stop_streaming()
 {
     super::stop_streaming();
     _image_header.invalidate();
+    _shm.reset();
+    _encoder.reset();
+    _bandwidth = 0;
+    _bandwidth_bytes = 0;
 }
 
 
@@ -211,6 +273,64 @@ void dds_video_stream_server::publish_image( topics::image_msg && image )
                    "image width (" + std::to_string( image.width ) + ") does not match stream header ("
                        + std::to_string( _image_header.width ) + ")" );
 
+    if( _encoder )
+        publish_image( image.timestamp, image.raw_data.data(), image.raw_data.size() );
+    else
+    {
+        auto step = uint32_t( image.raw_data.size() / _image_header.height );
+        publish( image.timestamp, std::move( image.raw_data ), step );
+    }
+}
+
+
+void dds_video_stream_server::publish_image( dds_time const & timestamp, uint8_t const * data, size_t size )
+{
+    if( ! is_streaming() )
+        DDS_THROW( runtime_error, "stream '" + name() + "' cannot publish before start_streaming()" );
+
+    if( _encoder )
+    {
+        // Compressed images are for readers elsewhere, so never go through shared memory
+        std::vector< uint8_t > compressed;
+        _encoder->encode( data, size, _image_header.width, _image_header.height, compressed );
+        // Rows don't mean much here, but the step must not be 0, which would make it a shared-memory reference
+        auto step = uint32_t( ( compressed.size() + _image_header.height - 1 ) / _image_header.height );
+        publish( timestamp, std::move( compressed ), step );
+        return;
+    }
+
+    auto shm = std::atomic_load( &_given_shm );
+    if( ! shm && _shm_slots && ! _shm )
+    {
+        try
+        {
+            _shm = std::make_shared< dds_shm_writer >( _shm_slots, size );
+        }
+        catch( std::exception const & )
+        {
+            _shm_slots = 0;  // Already logged; we won't try again
+        }
+    }
+
+    // The reference goes in the data, with a step of 0 to tell it from pixels
+    if( ! shm )
+        shm = _shm;
+    dds_shm_ref ref;
+    if( shm && shm->write( data, size, ref ) )
+    {
+        auto bytes = reinterpret_cast< uint8_t const * >( &ref );
+        publish( timestamp, std::vector< uint8_t >( bytes, bytes + sizeof( ref ) ), 0 );
+    }
+    else
+    {
+        // Without shared memory, or when the frame doesn't fit or readers are still holding all the slots
+        publish( timestamp, std::vector< uint8_t >( data, data + size ), uint32_t( size / _image_header.height ) );
+    }
+}
+
+
+void dds_video_stream_server::publish( dds_time const & timestamp, std::vector< uint8_t > && data, uint32_t step )
+{
     // LOG_DEBUG( "publishing a DDS video frame for topic: " << _writer->topic()->get()->get_name() );
     sensor_msgs::msg::Image raw_image;
     
@@ -225,19 +345,31 @@ void dds_video_stream_server::publish_image( topics::image_msg && image )
     //
     raw_image.header().frame_id() = sensor_name();
 
-    raw_image.header().stamp().sec() = image.timestamp.seconds;
-    raw_image.header().stamp().nanosec() = image.timestamp.nanosec;
+    raw_image.header().stamp().sec() = timestamp.seconds;
+    raw_image.header().stamp().nanosec() = timestamp.nanosec;
 
     raw_image.encoding() = _image_header.encoding.to_string();
     raw_image.height() = _image_header.height;
     raw_image.width() = _image_header.width;
-    raw_image.step() = uint32_t( image.raw_data.size() / _image_header.height );
+    raw_image.step() = step;
 
     raw_image.is_bigendian() = false;
 
-    raw_image.data() = std::move( image.raw_data );
+    // Only what actually goes over the wire counts: a shared-memory reference is all but free
+    if( step )
+        _bandwidth_bytes += data.size();
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration< float >( now - _bandwidth_start ).count();
+    if( elapsed >= 1.f )
+    {
+        _bandwidth = _bandwidth_bytes * 8 / elapsed / 1e6f;
+        _bandwidth_bytes = 0;
+        _bandwidth_start = now;
+    }
+
+    raw_image.data() = std::move( data );
 
-    LOG_DEBUG( "publishing '" << name() << "' " << raw_image.encoding() << " frame @ " << time_to_string( image.timestamp ) );
+    LOG_DEBUG( "publishing '" << name() << "' " << raw_image.encoding() << " frame @ " << time_to_string( timestamp ) );
     DDS_API_CALL( _writer->get()->write( &raw_image ) );
 }
 
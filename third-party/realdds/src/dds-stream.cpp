@@ -6,6 +6,7 @@
 #include <realdds/dds-topic.h>
 #include <realdds/dds-topic-reader-thread.h>
 #include <realdds/dds-subscriber.h>
+#include <realdds/dds-participant.h>
 #include <realdds/topics/image-msg.h>
 #include <realdds/topics/imu-msg.h>
 #include <realdds/topics/flexible-msg.h>
@@ -39,7 +40,14 @@ void dds_video_stream::open( std::string const & topic_name, std::shared_ptr< dd
     // here and destroyed on close()
     _reader = std::make_shared< dds_topic_reader_thread >( topic, subscriber );
     _reader->on_data_available( [this]() { handle_data(); } );
-    _reader->run( dds_topic_reader::qos( eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS ) );  // no retries
+    dds_topic_reader::qos rqos( eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS );  // no retries
+    auto stream_settings = subscriber->get_participant()->settings().nested( "device", "stream" );
+    rqos.override_from_json( stream_settings );
+    rqos.override_from_json( stream_settings.nested( name() ) );  // Then for this stream by name
+    // FastDDS takes a time-based filter but doesn't apply it, so we do: the samples still arrive
+    _min_separation = rqos.time_based_filter().minimum_separation.to_ns();
+    _last_timestamp = 0;
+    _reader->run( rqos );
 }
 
 
@@ -57,7 +65,11 @@ void dds_motion_stream::open( std::string const & topic_name, std::shared_ptr< d
     // here and destroyed on close()
     _reader = std::make_shared< dds_topic_reader_thread >( topic, subscriber );
     _reader->on_data_available( [this]() { handle_data(); } );
-    _reader->run( dds_topic_reader::qos( eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS ) );  // no retries
+    dds_topic_reader::qos rqos( eprosima::fastdds::dds::BEST_EFFORT_RELIABILITY_QOS );  // no retries
+    auto stream_settings = subscriber->get_participant()->settings().nested( "device", "stream" );
+    rqos.override_from_json( stream_settings );
+    rqos.override_from_json( stream_settings.nested( name() ) );  // Then for this stream by name
+    _reader->run( rqos );
 }
 
 
@@ -83,15 +95,38 @@ void dds_stream::start_streaming()
 void dds_video_stream::handle_data()
 {
     topics::image_msg frame;
+    frame.raw_data.swap( _spare_buffer );
     eprosima::fastdds::dds::SampleInfo info;
     while( _reader && topics::image_msg::take_next( *_reader, &frame, &info ) )
     {
         if( ! frame.is_valid() )
             continue;
 
+        // Before retaining from shared memory: we want what went over the network
+        _reader->statistics().on_sample( frame.raw_data.size(), info );
+
         if( is_streaming() && _on_data_available )
+        {
+            if( _min_separation > 0 )
+            {
+                auto const timestamp = frame.timestamp.to_ns();
+                if( _last_timestamp && timestamp > _last_timestamp && timestamp - _last_timestamp < _min_separation )
+                    continue;
+                _last_timestamp = timestamp;
+            }
+            if( frame.has_shm_ref )
+            {
+                frame.shared_data = _shm.retain( frame.shm_ref );
+                if( ! frame.shared_data )
+                {
+                    LOG_DEBUG( "[" << name() << "] frame no longer in shared memory; dropped" );
+                    continue;
+                }
+            }
             _on_data_available( std::move( frame ) );
+        }
     }
+    _spare_buffer.swap( frame.raw_data );
 }
 
 
@@ -101,6 +136,9 @@ void dds_motion_stream::handle_data()
     eprosima::fastdds::dds::SampleInfo info;
     while( _reader && topics::imu_msg::take_next( *_reader, &imu, &info ) )
     {
+        if( imu.is_valid() )
+            _reader->statistics().on_sample( sensor_msgs::msg::Imu::getCdrSerializedSize( imu.imu_data() ),
+                                             info );
         if( is_streaming() && _on_data_available )
             _on_data_available( std::move( imu ) );
     }
@@ -116,6 +154,14 @@ void dds_stream::stop_streaming()
 }
 
 
+dds_reader_statistics::values dds_stream::get_statistics() const
+{
+    if( ! _reader )
+        return {};
+    return _reader->statistics().get();
+}
+
+
 std::shared_ptr< dds_topic > const & dds_stream::get_topic() const
 {
     DDS_THROW( runtime_error, "stream '" + name() + "' must be open to get_topic()" );
@@ -92,13 +92,16 @@ dds_topic_reader::qos::qos( eprosima::fastdds::dds::ReliabilityQosPolicyKind rel
 void dds_topic_reader::qos::override_from_json( rsutils::json const & qos_settings )
 {
     // Default values should be set before we're called:
-    // All we do here is override those - if specified!
+    // All we do here is override those - if specified! Profiles may carry writer-only settings, which we ignore.
+    if( auto profile_j = qos_settings.nested( "profile", &rsutils::json::is_string ) )
+        override_from_json( qos_profile( profile_j.string_ref() ) );
     override_reliability_qos_from_json( reliability(), qos_settings.nested( "reliability" ) );
     override_durability_qos_from_json( durability(), qos_settings.nested( "durability" ) );
     override_history_qos_from_json( history(), qos_settings.nested( "history" ) );
     override_liveliness_qos_from_json( liveliness(), qos_settings.nested( "liveliness" ) );
     override_data_sharing_qos_from_json( data_sharing(), qos_settings.nested( "data-sharing" ) );
     override_endpoint_qos_from_json( endpoint(), qos_settings.nested( "endpoint" ) );
+    override_time_based_filter_qos_from_json( time_based_filter(), qos_settings.nested( "time-based-filter" ) );
 }
 
 
@@ -144,9 +147,13 @@ void dds_topic_reader::on_data_available( eprosima::fastdds::dds::DataReader * )
     {
         try
         {
+            auto const queue_depth = _reader->get_unread_count();
             rsutils::time::stopwatch stopwatch;
             _on_data_available();
-            if( stopwatch.get_elapsed() > std::chrono::milliseconds( 500 ) )
+            auto const elapsed = stopwatch.get_elapsed();
+            _statistics.on_callback( std::chrono::duration_cast< std::chrono::nanoseconds >( elapsed ).count(),
+                                     queue_depth );
+            if( elapsed > std::chrono::milliseconds( 500 ) )
                 LOG_WARNING( _topic->get()->get_name() << "' callback took too long!" );
         }
         catch( std::exception const & e )
@@ -161,6 +168,7 @@ void dds_topic_reader::on_sample_lost( eprosima::fastdds::dds::DataReader *, con
 {
     // Called when a sample is lost: i.e., when a fragment is received that is a jump in sequence number
     // If such a jump in sequence number (sample) isn't received then we never get here!
+    _statistics.on_lost( status.total_count_change );
     if( _on_sample_lost )
         _on_sample_lost( status );
     else
@@ -91,12 +91,15 @@ void dds_topic_writer::qos::override_from_json( rsutils::json const & qos_settin
 {
     // Default values should be set before we're called:
     // All we do here is override those - if specified!
+    if( auto profile_j = qos_settings.nested( "profile", &rsutils::json::is_string ) )
+        override_from_json( qos_profile( profile_j.string_ref() ) );
     override_reliability_qos_from_json( reliability(), qos_settings.nested( "reliability" ) );
     override_durability_qos_from_json( durability(), qos_settings.nested( "durability" ) );
     override_history_qos_from_json( history(), qos_settings.nested( "history" ) );
     override_liveliness_qos_from_json( liveliness(), qos_settings.nested( "liveliness" ) );
     override_data_sharing_qos_from_json( data_sharing(), qos_settings.nested( "data-sharing" ) );
     override_endpoint_qos_from_json( endpoint(), qos_settings.nested( "endpoint" ) );
+    override_publish_mode_qos_from_json( publish_mode(), qos_settings.nested( "publish-mode" ) );
 }
 
 
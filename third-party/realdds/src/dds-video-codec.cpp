@@ -0,0 +1,137 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <realdds/dds-video-codec.h>
+#include <realdds/dds-exceptions.h>
+
+#include <rsutils/depth-codec.h>
+#include <rsutils/sparse-depth.h>
+#include <rsutils/json.h>
+
+#include <algorithm>
+
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "../../stb_image_write.h"
+
+
+namespace realdds {
+
+
+namespace {
+
+
+dds_video_encoding const RGB8( "rgb8" );
+dds_video_encoding const MJPG( "MJPG" );
+dds_video_encoding const Z16( "16UC1" );
+dds_video_encoding const Z16_RVL( "16UC1; rvl" );
+dds_video_encoding const Z16_SPARSE( "16UC1; sparse" );
+
+
+class jpeg_encoder : public dds_video_encoder
+{
+    int _quality;
+
+public:
+    jpeg_encoder( int quality )
+        : _quality( quality )
+    {
+    }
+
+    void encode( uint8_t const * pixels, size_t size, int width, int height, std::vector< uint8_t > & out ) override
+    {
+        if( size < size_t( width ) * height * 3 )
+            DDS_THROW( runtime_error, "rgb8 image is too small (" << size << " bytes) for " << width << 'x' << height );
+        out.clear();
+        auto append = []( void * context, void * data, int n )
+        {
+            auto & out = *static_cast< std::vector< uint8_t > * >( context );
+            auto bytes = static_cast< uint8_t const * >( data );
+            out.insert( out.end(), bytes, bytes + n );
+        };
+        if( ! stbi_write_jpg_to_func( append, &out, width, height, 3, pixels, _quality ) )
+            DDS_THROW( runtime_error, "failed to compress " << width << 'x' << height << " image to JPEG" );
+    }
+};
+
+
+class rvl_encoder : public dds_video_encoder
+{
+public:
+    void encode( uint8_t const * pixels, size_t size, int width, int height, std::vector< uint8_t > & out ) override
+    {
+        if( size < size_t( width ) * height * 2 )
+            DDS_THROW( runtime_error, "depth image is too small (" << size << " bytes) for " << width << 'x' << height );
+        rsutils::depth_codec::encode( reinterpret_cast< uint16_t const * >( pixels ), size_t( width ) * height, out );
+    }
+};
+
+
+class sparse_encoder : public dds_video_encoder
+{
+public:
+    void encode( uint8_t const * pixels, size_t size, int width, int height, std::vector< uint8_t > & out ) override
+    {
+        if( size < size_t( width ) * height * 2 )
+            DDS_THROW( runtime_error, "depth image is too small (" << size << " bytes) for " << width << 'x' << height );
+        rsutils::sparse_depth::encode( reinterpret_cast< uint16_t const * >( pixels ), uint32_t( width ),
+                                       uint32_t( height ), size_t( width ) * 2, out );
+    }
+};
+
+
+}  // namespace
+
+
+dds_video_encoding dds_video_encoder::compressed( dds_video_encoding const & raw )
+{
+    if( raw == RGB8 )
+        return MJPG;
+    if( raw == Z16 )
+        return Z16_RVL;
+    return {};
+}
+
+
+dds_video_encoding dds_video_encoder::compressed( dds_video_encoding const & raw, rsutils::json const & settings )
+{
+    if( raw == Z16 )
+    {
+        std::string depth = settings.nested( "depth-compression" ).default_value( std::string( "rvl" ) );
+        if( depth == "sparse" )
+            return Z16_SPARSE;
+        if( depth != "rvl" )
+            DDS_THROW( runtime_error, "invalid depth-compression '" << depth << "'; expecting 'rvl' or 'sparse'" );
+    }
+    return compressed( raw );
+}
+
+
+dds_video_encoding dds_video_encoder::raw( dds_video_encoding const & compressed )
+{
+    if( compressed == MJPG )
+        return RGB8;
+    if( compressed == Z16_RVL || compressed == Z16_SPARSE )
+        return Z16;
+    return {};
+}
+
+
+std::shared_ptr< dds_video_encoder > dds_video_encoder::create( dds_video_encoding const & raw,
+                                                                dds_video_encoding const & compressed,
+                                                                rsutils::json const & settings )
+{
+    if( raw == RGB8 && compressed == MJPG )
+    {
+        int quality = settings.nested( "jpeg-quality" ).default_value( 90 );
+        return std::make_shared< jpeg_encoder >( std::max( 1, std::min( 100, quality ) ) );
+    }
+    if( raw == Z16 && compressed == Z16_RVL )
+        return std::make_shared< rvl_encoder >();
+    if( raw == Z16 && compressed == Z16_SPARSE )
+        return std::make_shared< sparse_encoder >();
+    return {};
+}
+
+
+}  // namespace realdds
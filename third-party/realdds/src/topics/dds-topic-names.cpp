@@ -104,6 +104,12 @@ namespace control {
             std::string const sensor_name( "sensor-name", 11 );
         }
     }
+    namespace set_options {
+        std::string const id( "set-options", 11 );
+        namespace key {
+            //using notification::query_options::key::option_values;
+        }
+    }
     namespace open_streams {
         std::string const id( "open-streams", 12 );
         namespace key {
@@ -167,6 +173,12 @@ namespace reply {
             //using notification::query_options::key::option_values;
         }
     }
+    namespace set_options {
+        //using control::set_options::id;
+        namespace key {
+            //using control::set_options::key::option_values;
+        }
+    }
     namespace open_streams {
         //using control::open_streams::id;
         namespace key {
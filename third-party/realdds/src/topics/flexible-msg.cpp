@@ -59,6 +59,14 @@ flexible_msg::flexible_msg( data_format format, rsutils::json const & j, uint32_
 }
 
 
+flexible_msg::flexible_msg( data_format format, std::vector< uint8_t > && data, uint32_t version )
+    : _data_format( format )
+    , _version( version )
+    , _data( std::move( data ) )
+{
+}
+
+
 /*static*/ std::shared_ptr< dds_topic >
 flexible_msg::create_topic( std::shared_ptr< dds_participant > const & participant, char const * topic_name )
 {
@@ -19,16 +19,18 @@ namespace topics {
 
 image_msg::image_msg( sensor_msgs::msg::Image && rhs )
 {
-    raw_data = std::move( rhs.data() );
-    width    = std::move( rhs.width() );
-    height   = std::move( rhs.height() );
-    timestamp = dds_time( rhs.header().stamp().sec(), rhs.header().stamp().nanosec() );
+    *this = std::move( rhs );
 }
 
 
 image_msg & image_msg::operator=( sensor_msgs::msg::Image && rhs )
 {
+    // A step of 0 is never a real image: it says the data is a reference to shared memory
+    has_shm_ref = ! rhs.step() && shm_ref.from_bytes( rhs.data().data(), rhs.data().size() );
     raw_data = std::move( rhs.data() );
+    if( has_shm_ref )
+        raw_data.clear();  // Keeps its capacity, for the next take_next()
+    shared_data.reset();
     width    = std::move( rhs.width() );
     height   = std::move( rhs.height() );
     timestamp = dds_time( rhs.header().stamp().sec(), rhs.header().stamp().nanosec() );
@@ -53,7 +55,12 @@ image_msg::take_next( dds_topic_reader & reader, image_msg * output, eprosima::f
     eprosima::fastdds::dds::SampleInfo info_;
     if ( !info )
         info = &info_;  // use the local copy if the user hasn't provided their own
+    // Deserialize into the output's buffer, if it has one: no allocation needed if it's big enough
+    if( output )
+        raw_data.data().swap( output->raw_data );
     auto status = reader->take_next_sample( &raw_data, info );
+    if( status != ReturnCode_t::RETCODE_OK && output )
+        output->raw_data.swap( raw_data.data() );  // Keep it for next time
     if ( status == ReturnCode_t::RETCODE_OK )
     {
         // We have data
@@ -63,7 +70,10 @@ image_msg::take_next( dds_topic_reader & reader, image_msg * output, eprosima::f
             // valid_data indicates that the instance is still ALIVE and the `take` return an
             // updated sample
             if ( !info->valid_data )
+            {
+                output->raw_data.swap( raw_data.data() );
                 output->invalidate();
+            }
             else
                 *output = std::move( raw_data ); //TODO - optimize copy, use dds loans
         }
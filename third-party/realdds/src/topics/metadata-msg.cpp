@@ -0,0 +1,127 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <realdds/topics/metadata-msg.h>
+#include <realdds/topics/dds-topic-names.h>
+#include <realdds/dds-exceptions.h>
+
+#include <rsutils/json.h>
+
+#include <cstring>
+
+
+namespace realdds {
+namespace topics {
+
+
+namespace {
+
+
+size_t name_size( size_t length )
+{
+    return ( length + 7 ) / 8 * 8;
+}
+
+
+}  // namespace
+
+
+constexpr uint32_t metadata_msg::MAGIC;
+
+
+metadata_msg::metadata_msg( std::string const & stream_name, dds_nsec timestamp )
+{
+    if( stream_name.length() > 255 )
+        DDS_THROW( runtime_error, "stream name '" << stream_name << "' is too long for metadata" );
+
+    _data.resize( sizeof( header ) + name_size( stream_name.length() ) );
+    auto h = get_header();
+    h->magic = MAGIC;
+    h->name_length = uint8_t( stream_name.length() );
+    h->timestamp = timestamp;
+    memcpy( h + 1, stream_name.data(), stream_name.length() );
+}
+
+
+void metadata_msg::set_frame_number( uint64_t frame_number )
+{
+    get_header()->frame_number = frame_number;
+    get_header()->flags |= HAS_FRAME_NUMBER;
+}
+
+
+void metadata_msg::set_timestamp_domain( int32_t domain )
+{
+    get_header()->timestamp_domain = domain;
+    get_header()->flags |= HAS_TIMESTAMP_DOMAIN;
+}
+
+
+void metadata_msg::set_depth_units( float units )
+{
+    get_header()->depth_units = units;
+    get_header()->flags |= HAS_DEPTH_UNITS;
+}
+
+
+void metadata_msg::add( int32_t key, int64_t v )
+{
+    if( get_header()->n_values == UINT16_MAX )
+        DDS_THROW( runtime_error, "too many metadata values" );
+
+    value x = { key, 0, v };
+    auto const offset = _data.size();
+    _data.resize( offset + sizeof( value ) );
+    memcpy( _data.data() + offset, &x, sizeof( value ) );
+    ++get_header()->n_values;
+}
+
+
+/*static*/ metadata_msg::header const * metadata_msg::parse( void const * data, size_t size )
+{
+    if( size < sizeof( header ) )
+        return nullptr;
+    auto h = static_cast< header const * >( data );
+    if( h->magic != MAGIC
+        || size != sizeof( header ) + name_size( h->name_length ) + h->n_values * sizeof( value ) )
+        return nullptr;
+    return h;
+}
+
+
+/*static*/ std::string metadata_msg::stream_name( header const * h )
+{
+    return std::string( reinterpret_cast< char const * >( h + 1 ), h->name_length );
+}
+
+
+/*static*/ metadata_msg::value const * metadata_msg::values( header const * h )
+{
+    return reinterpret_cast< value const * >( reinterpret_cast< uint8_t const * >( h + 1 )
+                                              + name_size( h->name_length ) );
+}
+
+
+/*static*/ rsutils::json metadata_msg::to_json( header const * h )
+{
+    rsutils::json md_header = rsutils::json::object( { { metadata::header::key::timestamp, h->timestamp } } );
+    if( h->flags & HAS_FRAME_NUMBER )
+        md_header[metadata::header::key::frame_number] = h->frame_number;
+    if( h->flags & HAS_TIMESTAMP_DOMAIN )
+        md_header[metadata::header::key::timestamp_domain] = h->timestamp_domain;
+    if( h->flags & HAS_DEPTH_UNITS )
+        md_header[metadata::header::key::depth_units] = h->depth_units;
+
+    rsutils::json md = rsutils::json::object();
+    auto v = values( h );
+    for( uint16_t i = 0; i < h->n_values; ++i )
+        md[std::to_string( v[i].key )] = v[i].value;
+
+    return rsutils::json::object( { { metadata::key::stream_name, stream_name( h ) },
+                                    { metadata::key::header, std::move( md_header ) },
+                                    { metadata::key::metadata, std::move( md ) } } );
+}
+
+
+}  // namespace topics
+}  // namespace realdds
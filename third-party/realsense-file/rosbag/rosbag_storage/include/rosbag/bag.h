@@ -42,6 +42,7 @@
 #include "chunked_file.h"
 #include "constants.h"
 #include "exceptions.h"
+#include "mapped_file.h"
 #include "structures.h"
 
 #include "ros/header.h"
@@ -50,8 +51,13 @@
 #include "ros/message_event.h"
 #include "ros/serialization.h"
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <ios>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <set>
 #include <stdexcept>
@@ -114,11 +120,35 @@ public:
     uint64_t        getSize()         const;                      //!< Get the current size of the bag file (a lower bound)
 
     void            setCompression(CompressionType compression);  //!< Set the compression method to use for writing chunks
+    void            setDirectIO(bool direct_io);                  //!< Write with direct I/O, around the page cache, where possible (Linux); set before opening for writing
+    void            setMemoryMapped(bool mapped);                 //!< Map the file into memory where possible, for getMappedMessage(); set before opening for reading
     CompressionType getCompression() const;                       //!< Get the compression method to use for writing chunks
     std::tuple<std::string, uint64_t, uint64_t> getCompressionInfo() const;
     void            setChunkThreshold(uint32_t chunk_threshold);  //!< Set the threshold for creating new chunks
     uint32_t        getChunkThreshold() const;                    //!< Get the threshold for creating new chunks
 
+    //! Get the last message in a time range, on the connections a query accepts
+    /*!
+     * \param query      Which connections to look at (e.g., a TopicQuery)
+     * \param start_time The beginning of the range
+     * \param end_time   The end of the range, the message may be at
+     *
+     * Found through the index, without going over the other messages in the range. Returns nullptr if there's none.
+     */
+    std::shared_ptr<MessageInstance> getLastMessage(std::function<bool(ConnectionInfo const*)> query,
+                                                    rs2rosinternal::Time const& start_time,
+                                                    rs2rosinternal::Time const& end_time) const;
+
+    //! Get the serialized data of a message right out of the mapped file, without copying it
+    /*!
+     * \param m    The message, from this bag
+     * \param size Set to the size of the data
+     *
+     * Only for messages in uncompressed chunks of a mapped bag: returns nullptr otherwise, and the message has to be
+     * read the usual way. The pointer holds on to the mapping, which can outlive the bag.
+     */
+    std::shared_ptr<uint8_t const> getMappedMessage(MessageInstance const& m, uint32_t& size) const;
+
     //! Write a message into the bag file
     /*!
      * \param topic The topic name
@@ -168,10 +198,90 @@ public:
     void write(std::string const& topic, rs2rosinternal::Time const& time, std::shared_ptr<T> const& msg,
 		std::shared_ptr<rs2rosinternal::M_string> connection_header = std::shared_ptr<rs2rosinternal::M_string>());
 
+    //! The contents of an array of bytes in a message, kept outside of it (see below)
+    struct ExternalBlock
+    {
+        uint8_t const* data;
+        uint32_t       size;
+        uint32_t       offset;  //!< Where the contents go in the serialized message: just after the array's length
+    };
+
+    //! Write a message into the bag file, with the contents of one of its byte arrays written straight from where
+    //! they are rather than copied into the message and then again into the record
+    /*!
+     * \param topic The topic name
+     * \param time  Timestamp of the message
+     * \param msg   The message to be added, with the array empty
+     * \param block The contents of the array
+     *
+     * Can throw BagIOException
+     */
+    template<class T>
+    void write(std::string const& topic, rs2rosinternal::Time const& time, T const& msg, ExternalBlock const& block);
+
+    //! Runs a task some time later, on whatever thread
+    typedef std::function<void(std::function<void()>)> Executor;
+
+    //! Compress chunks off the writing thread
+    /*!
+     * \param executor             Runs the compression of each finished chunk, e.g. on a pool of workers
+     * \param max_chunks_in_flight How many finished chunks may be waiting to be compressed and written; writing
+     *                             blocks beyond that, rather than letting memory grow
+     *
+     * Chunks are still written in order, and the file is the same as when compressing synchronously. Only applies
+     * to LZ4, and only to bags that are just written: others compress on the writing thread.
+     */
+    void setCompressionExecutor(Executor executor, uint32_t max_chunks_in_flight = 4);
+
+    //! Decompress chunks off the reading thread, ahead of reading them
+    /*!
+     * \param executor Runs the decompression of each chunk, e.g. on a pool of workers
+     * \param window   How many chunks past the one last read, in file order, to get ready
+     *
+     * For reading a bag in about the order it was written, as in playback. The compressed data comes straight from
+     * the mapped file when there's one (see setMemoryMapped), and is read on the reading thread otherwise. Only
+     * applies to LZ4 chunks, and to uncompressed ones of a mapped file.
+     */
+    void setPrefetch(Executor executor, uint32_t window);
+
 private:
+    //! A chunk that's complete in memory, waiting to be compressed and then written
+    struct PendingChunk
+    {
+        ChunkInfo                                      info;
+        std::map<uint32_t, std::multiset<IndexEntry> > connection_indexes;
+        Buffer                                         data;
+        Buffer                                         compressed;
+        bool                                           done   = false;
+        bool                                           failed = false;
+    };
+
+    //! A chunk being decompressed ahead of reading it
+    struct PrefetchedChunk
+    {
+        Buffer compressed;  //!< unless it's read from the mapped file
+        Buffer data;
+        bool   done   = false;
+        bool   failed = false;
+    };
+
+    //! Shared with the compression and prefetching tasks, which may outlive the bag
+    struct CompressionSync
+    {
+        std::mutex              mutex;
+        std::condition_variable cv;
+    };
+
     // This helper function actually does the write with an arbitrary serializable message
     template<class T>
-    void doWrite(std::string const& topic, rs2rosinternal::Time const& time, T const& msg, std::shared_ptr<rs2rosinternal::M_string> const& connection_header);
+    void doWrite(std::string const& topic, rs2rosinternal::Time const& time, T const& msg, std::shared_ptr<rs2rosinternal::M_string> const& connection_header,
+                 ExternalBlock const* block = nullptr);
+
+    //! The open chunk is kept in memory too, for reading it back, unless the bag is only written to
+    bool mirrorsChunk() const { return mode_ != bagmode::Write; }
+
+    //! Chunks are then kept in memory and compressed by the executor, rather than through the file
+    bool compressesAsync() const { return executor_ && compression_ == compression::LZ4 && ! mirrorsChunk(); }
 
     void openRead  (std::string const& filename);
     void openWrite (std::string const& filename);
@@ -195,13 +305,16 @@ private:
     void writeConnectionRecord(ConnectionInfo const* connection_info);
     void appendConnectionRecordToBuffer(Buffer& buf, ConnectionInfo const* connection_info);
     template<class T>
-    void writeMessageDataRecord(uint32_t conn_id, rs2rosinternal::Time const& time, T const& msg);
-    void writeIndexRecords();
+    void writeMessageDataRecord(uint32_t conn_id, rs2rosinternal::Time const& time, T const& msg, ExternalBlock const* block);
+    void writeIndexRecords(std::map<uint32_t, std::multiset<IndexEntry> > const& connection_indexes);
     void writeConnectionRecords();
     void writeChunkInfoRecords();
     void startWritingChunk(rs2rosinternal::Time time);
     void writeChunkHeader(CompressionType compression, uint32_t compressed_size, uint32_t uncompressed_size);
     void stopWritingChunk();
+    void submitPendingChunk();
+    void writePendingChunks(size_t max_in_flight);  //!< those compressed, in order, waiting for more than max_in_flight
+    void writePendingChunk(PendingChunk& chunk);
 
     // Reading
 
@@ -223,6 +336,9 @@ private:
     void readMessageDataIntoStream(IndexEntry const& index_entry, Stream& stream) const;
 
     void     decompressChunk(uint64_t chunk_pos) const;
+    bool     takePrefetchedChunk(uint64_t chunk_pos) const;  //!< into the decompress buffer, if it was prefetched
+    void     prefetchChunks(uint64_t chunk_pos) const;       //!< those following it, within the window
+    void     prefetchChunk(uint64_t chunk_pos) const;
     void     decompressRawChunk(ChunkHeader const& chunk_header) const;
     void     decompressBz2Chunk(ChunkHeader const& chunk_header) const;
     void     decompressLz4Chunk(ChunkHeader const& chunk_header) const;
@@ -236,6 +352,7 @@ private:
     void appendDataLengthToBuffer(Buffer& buf, uint32_t data_len);
 
     void readHeaderFromBuffer(Buffer& buffer, uint32_t offset, rs2rosinternal::Header& header, uint32_t& data_size, uint32_t& bytes_read) const;
+    bool readMappedRecord(uint64_t pos, rs2rosinternal::Header& header, uint64_t& data_pos, uint32_t& data_size) const;
     void readMessageDataHeaderFromBuffer(Buffer& buffer, uint32_t offset, rs2rosinternal::Header& header, uint32_t& data_size, uint32_t& bytes_read) const;
     bool readHeader(rs2rosinternal::Header& header) const;
     bool readDataLength(uint32_t& data_size) const;
@@ -273,6 +390,8 @@ private:
     CompressionType     compression_;
     uint32_t            chunk_threshold_;
     uint32_t            bag_revision_;
+    bool                direct_io_;
+    bool                memory_mapped_;
 
     uint64_t file_size_;
     uint64_t file_header_pos_;
@@ -285,6 +404,18 @@ private:
     ChunkInfo curr_chunk_info_;
     uint64_t  curr_chunk_data_pos_;
 
+    // Asynchronous compression
+    Executor                                    executor_;
+    uint32_t                                    max_chunks_in_flight_;
+    std::shared_ptr<CompressionSync>            compression_sync_;
+    std::shared_ptr<PendingChunk>               curr_pending_chunk_;  //!< the open chunk, when kept in memory
+    std::deque<std::shared_ptr<PendingChunk> >  pending_chunks_;      //!< submitted, in file order
+
+    // Prefetching
+    Executor                                                       prefetch_executor_;
+    uint32_t                                                       prefetch_window_;
+    mutable std::map<uint64_t, std::shared_ptr<PrefetchedChunk> >  prefetched_chunks_;  //!< by chunk position
+
     std::map<std::string, uint32_t>                topic_connection_ids_;
     std::map<rs2rosinternal::M_string, uint32_t>              header_connection_ids_;
     std::map<uint32_t, ConnectionInfo*>            connections_;
@@ -305,6 +436,10 @@ private:
     mutable Buffer*  current_buffer_;
 
     mutable uint64_t decompressed_chunk_;      //!< position of decompressed chunk
+
+    std::shared_ptr<MappedFile> mapped_file_;  //!< the whole file, when reading it mapped
+    mutable uint64_t mapped_chunk_pos_;        //!< position of the last chunk looked up in the mapping
+    mutable uint64_t mapped_chunk_data_;       //!< position of its data, or 0 if it's compressed
 };
 
 } // namespace rosbag
@@ -335,6 +470,11 @@ void Bag::write(std::string const& topic, rs2rosinternal::Time const& time, std:
     doWrite(topic, time, *msg, connection_header);
 }
 
+template<class T>
+void Bag::write(std::string const& topic, rs2rosinternal::Time const& time, T const& msg, ExternalBlock const& block) {
+    doWrite(topic, time, msg, std::shared_ptr<rs2rosinternal::M_string>(), &block);
+}
+
 template<typename T>
 std::string Bag::toHeaderString(T const* field) const {
     return std::string((char*) field, sizeof(T));
@@ -463,7 +603,8 @@ std::shared_ptr<T> Bag::instantiateBuffer(IndexEntry const& index_entry) const {
 }
 
 template<class T>
-void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T const& msg, std::shared_ptr<rs2rosinternal::M_string> const& connection_header) {
+void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T const& msg, std::shared_ptr<rs2rosinternal::M_string> const& connection_header,
+                  ExternalBlock const* block) {
 
     if (time < rs2rosinternal::TIME_MIN)
     {
@@ -539,7 +680,8 @@ void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T
             connections_[conn_id] = connection_info;
 
             writeConnectionRecord(connection_info);
-            appendConnectionRecordToBuffer(outgoing_chunk_buffer_, connection_info);
+            if (mirrorsChunk())
+                appendConnectionRecordToBuffer(outgoing_chunk_buffer_, connection_info);
         }
 
         // Add to topic indexes
@@ -550,14 +692,17 @@ void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T
 
         std::multiset<IndexEntry>& chunk_connection_index = curr_chunk_connection_indexes_[connection_info->id];
         chunk_connection_index.insert(chunk_connection_index.end(), index_entry);
-        std::multiset<IndexEntry>& connection_index = connection_indexes_[connection_info->id];
-        connection_index.insert(connection_index.end(), index_entry);
+        // Where a chunk kept in memory goes is only known once it's written
+        if (!curr_pending_chunk_) {
+            std::multiset<IndexEntry>& connection_index = connection_indexes_[connection_info->id];
+            connection_index.insert(connection_index.end(), index_entry);
+        }
 
         // Increment the connection count
         curr_chunk_info_.connection_counts[connection_info->id]++;
 
         // Write the message data
-        writeMessageDataRecord(conn_id, time, msg);
+        writeMessageDataRecord(conn_id, time, msg, block);
 
         // Check if we want to stop this chunk
         uint32_t chunk_size = getChunkOffset();
@@ -574,7 +719,7 @@ void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T
 }
 
 template<class T>
-void Bag::writeMessageDataRecord(uint32_t conn_id, rs2rosinternal::Time const& time, T const& msg) {
+void Bag::writeMessageDataRecord(uint32_t conn_id, rs2rosinternal::Time const& time, T const& msg, ExternalBlock const* block) {
     rs2rosinternal::M_string header;
     header[OP_FIELD_NAME]         = toHeaderString(&OP_MSG_DATA);
     header[CONNECTION_FIELD_NAME] = toHeaderString(&conn_id);
@@ -590,6 +735,16 @@ void Bag::writeMessageDataRecord(uint32_t conn_id, rs2rosinternal::Time const& t
     // todo: serialize into the outgoing_chunk_buffer & remove record_buffer_
     rs2rosinternal::serialization::serialize(s, msg);
 
+    // An external block goes in at its offset, after the (empty) array's length, which we make its own
+    uint32_t const block_size = block ? block->size : 0;
+    uint32_t const head_len = block ? block->offset : msg_ser_len;
+    if (block)
+    {
+        if (block->offset < 4 || block->offset > msg_ser_len)
+            throw BagException("Invalid offset for an external block");
+        memcpy(record_buffer_.getData() + block->offset - 4, &block->size, 4);
+    }
+
     // We do an extra seek here since writing our data record may
     // have indirectly moved our file-pointer if it was a
     // MessageInstance for our own bag
@@ -600,16 +755,30 @@ void Bag::writeMessageDataRecord(uint32_t conn_id, rs2rosinternal::Time const& t
               (unsigned long long) file_.getOffset(), getChunkOffset(), conn_id, time.sec, time.nsec, msg_ser_len);
 
     writeHeader(header);
-    writeDataLength(msg_ser_len);
-    write((char*) record_buffer_.getData(), msg_ser_len);
-
-    // todo: use better abstraction than appendHeaderToBuffer
-    appendHeaderToBuffer(outgoing_chunk_buffer_, header);
-    appendDataLengthToBuffer(outgoing_chunk_buffer_, msg_ser_len);
+    writeDataLength(msg_ser_len + block_size);
+    write((char*) record_buffer_.getData(), head_len);
+    if (block)
+    {
+        write((char*) block->data, block_size);
+        write((char*) record_buffer_.getData() + head_len, msg_ser_len - head_len);
+    }
 
-    uint32_t offset = outgoing_chunk_buffer_.getSize();
-    outgoing_chunk_buffer_.setSize(outgoing_chunk_buffer_.getSize() + msg_ser_len);
-    memcpy(outgoing_chunk_buffer_.getData() + offset, record_buffer_.getData(), msg_ser_len);
+    if (mirrorsChunk())
+    {
+        // todo: use better abstraction than appendHeaderToBuffer
+        appendHeaderToBuffer(outgoing_chunk_buffer_, header);
+        appendDataLengthToBuffer(outgoing_chunk_buffer_, msg_ser_len + block_size);
+
+        uint32_t offset = outgoing_chunk_buffer_.getSize();
+        outgoing_chunk_buffer_.setSize(outgoing_chunk_buffer_.getSize() + msg_ser_len + block_size);
+        memcpy(outgoing_chunk_buffer_.getData() + offset, record_buffer_.getData(), head_len);
+        if (block)
+        {
+            memcpy(outgoing_chunk_buffer_.getData() + offset + head_len, block->data, block_size);
+            memcpy(outgoing_chunk_buffer_.getData() + offset + head_len + block_size,
+                   record_buffer_.getData() + head_len, msg_ser_len - head_len);
+        }
+    }
 
     // Update the current chunk time range
     if (time > curr_chunk_info_.end_time)
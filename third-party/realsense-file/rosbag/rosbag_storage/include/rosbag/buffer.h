@@ -51,6 +51,7 @@ public:
     uint32_t getSize()     const;
 
     void setSize(uint32_t size);
+    void swap(Buffer& other);
 
 private:
     void ensureCapacity(uint32_t capacity);
@@ -41,6 +41,7 @@
 #include "macros.h"
 
 #include "../../../rosbag_storage/include/rosbag/stream.h"
+#include "direct_file.h"
 
 namespace rosbag {
 
@@ -56,6 +57,7 @@ public:
     void openWrite    (std::string const& filename);            //!< open file for writing
     void openRead     (std::string const& filename);            //!< open file for reading
     void openReadWrite(std::string const& filename);            //!< open file for reading & writing
+    bool openWriteDirect(std::string const& filename);          //!< open file for writing with direct I/O, if possible; buffered otherwise
 
     void close();                                               //!< close the file
 
@@ -80,10 +82,12 @@ public:
 private:
     void open(std::string const& filename, std::string const& mode);
     void clearUnused();
+    size_t writeToFile(void* ptr, size_t size);                 //!< write through to the file at the current offset
 
 private:
     std::string filename_;       //!< path to file
     FILE*       file_;           //!< file pointer
+    DirectFile  direct_;         //!< used instead of file_ when writing with direct I/O
     uint64_t    offset_;         //!< current position in the file
     uint64_t    compressed_in_;  //!< number of bytes written to current compressed stream
     char*       unused_;         //!< extra data read by compressed stream
@@ -0,0 +1,70 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifndef ROSBAG_DIRECT_FILE_H
+#define ROSBAG_DIRECT_FILE_H
+
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "macros.h"
+
+namespace rosbag {
+
+//! DirectFile writes a file with direct I/O (O_DIRECT), around the page cache, so that recording a large file
+//! doesn't evict everyone else's pages nor end up in a long flush.
+/*!
+ * Writes go into one of two aligned buffers; once full, the buffer is written out by a thread of our own while
+ * the other one fills up. Data that's already been written out can still be overwritten (as the bag does with
+ * record headers), at the cost of reading back the blocks around it.
+ *
+ * The file can only be written: reading it back needs reopening it.
+ */
+class ROSBAG_DECL DirectFile
+{
+public:
+    DirectFile();
+    ~DirectFile();
+
+    //! Returns false, without throwing, where direct I/O isn't available (the platform or the file system)
+    bool open(std::string const& filename);
+    void close();  //!< write out what's left and close the file
+
+    bool     isOpen()  const { return fd_ >= 0; }
+    uint64_t getSize() const { return size_;    }  //!< bytes written so far
+
+    //! Write at the given offset, anywhere up to the end of the file
+    void write(uint64_t offset, void const* ptr, size_t size);
+
+private:
+    void submit();                                    //!< start writing out the active buffer, which is full
+    void wait();                                      //!< until the buffer being written out is done
+    void patch(uint64_t offset, uint8_t const* ptr, size_t size);  //!< overwrite data already written out
+    void writer();
+
+private:
+    int      fd_;
+    size_t   alignment_;
+    size_t   capacity_;      //!< of each buffer
+    uint8_t* buffers_[2];
+    int      active_;        //!< the buffer being filled
+    uint64_t active_start_;  //!< file offset of the active buffer; everything before it was submitted
+    size_t   active_size_;
+    uint64_t size_;
+
+    std::mutex              mutex_;
+    std::condition_variable cv_;
+    std::thread             thread_;
+    bool                    pending_;  //!< the other buffer is being written out
+    uint8_t const*          pending_buffer_;
+    uint64_t                pending_offset_;
+    bool                    stopping_;
+    int                     error_;    //!< errno of the first failed write, if any
+};
+
+} // namespace rosbag
+
+#endif
@@ -0,0 +1,43 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#ifndef ROSBAG_MAPPED_FILE_H
+#define ROSBAG_MAPPED_FILE_H
+
+#include <stdint.h>
+#include <string>
+
+#include "macros.h"
+
+namespace rosbag {
+
+//! MappedFile maps a whole file into memory, for reading it without copying it out first.
+/*!
+ * The mapping is private: the pages can be written to, but that only ever changes our copy of them, never the file.
+ * It stays valid until the MappedFile is destroyed, whether or not the file is still open elsewhere.
+ */
+class ROSBAG_DECL MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    //! Returns false, without throwing, where the file can't be mapped (the platform, or not enough address space)
+    bool open(std::string const& filename);
+    void close();
+
+    bool           isOpen()  const { return data_ != NULL; }
+    uint8_t const* getData() const { return data_; }
+    uint64_t       getSize() const { return size_; }
+
+private:
+    uint8_t* data_;
+    uint64_t size_;
+};
+
+} // namespace rosbag
+
+#endif
@@ -59,6 +59,7 @@ class Bag;
 class ROSBAG_DECL MessageInstance
 {
     friend class View;
+    friend class Bag;
   
 public:
     rs2rosinternal::Time   const& getTime()              const;
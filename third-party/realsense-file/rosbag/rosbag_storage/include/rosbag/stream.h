@@ -81,6 +81,7 @@ public:
 
 protected:
     FILE*    getFilePointer();
+    size_t   writeToFile(void* ptr, size_t size);
     uint64_t getCompressedIn();
     void     setCompressedIn(uint64_t nbytes);
     void     advanceOffset(uint64_t nbytes);
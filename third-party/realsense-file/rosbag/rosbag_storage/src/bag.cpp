@@ -37,7 +37,9 @@
 #endif
 #include <signal.h>
 #include <assert.h>
+#include <algorithm>
 #include <iomanip>
+#include <limits>
 #include <map>
 #include <tuple>
 #include <tuple>
@@ -61,6 +63,8 @@ Bag::Bag() :
     compression_(compression::Uncompressed),
     chunk_threshold_(768 * 1024),  // 768KB chunks
     bag_revision_(0),
+    direct_io_(false),
+    memory_mapped_(false),
     file_size_(0),
     file_header_pos_(0),
     index_data_pos_(0),
@@ -68,8 +72,13 @@ Bag::Bag() :
     chunk_count_(0),
     chunk_open_(false),
     curr_chunk_data_pos_(0),
+    max_chunks_in_flight_(0),
+    compression_sync_(std::make_shared<CompressionSync>()),
+    prefetch_window_(0),
     current_buffer_(0),
-    decompressed_chunk_(0)
+    decompressed_chunk_(0),
+    mapped_chunk_pos_(0),
+    mapped_chunk_data_(0)
 {
 }
 
@@ -77,6 +86,8 @@ Bag::Bag(string const& filename, uint32_t mode) :
     compression_(compression::Uncompressed),
     chunk_threshold_(768 * 1024),  // 768KB chunks
     bag_revision_(0),
+    direct_io_(false),
+    memory_mapped_(false),
     file_size_(0),
     file_header_pos_(0),
     index_data_pos_(0),
@@ -84,8 +95,13 @@ Bag::Bag(string const& filename, uint32_t mode) :
     chunk_count_(0),
     chunk_open_(false),
     curr_chunk_data_pos_(0),
+    max_chunks_in_flight_(0),
+    compression_sync_(std::make_shared<CompressionSync>()),
+    prefetch_window_(0),
     current_buffer_(0),
-    decompressed_chunk_(0)
+    decompressed_chunk_(0),
+    mapped_chunk_pos_(0),
+    mapped_chunk_data_(0)
 {
     open(filename, mode);
 }
@@ -116,6 +132,14 @@ void Bag::open(string const& filename, uint32_t mode) {
 void Bag::openRead(string const& filename) {
     file_.openRead(filename);
 
+    if (memory_mapped_) {
+        std::shared_ptr<MappedFile> mapped = std::make_shared<MappedFile>();
+        if (mapped->open(filename))
+            mapped_file_ = mapped;
+        else
+            CONSOLE_BRIDGE_logDebug("Can't map %s into memory; reading it through the file", filename.c_str());
+    }
+
     readVersion();
 
     switch (version_) {
@@ -128,7 +152,10 @@ void Bag::openRead(string const& filename) {
 }
 
 void Bag::openWrite(string const& filename) {
-    file_.openWrite(filename);
+    if (!direct_io_)
+        file_.openWrite(filename);
+    else if (!file_.openWriteDirect(filename))
+        CONSOLE_BRIDGE_logWarn("Direct I/O isn't available for %s; writing it buffered", filename.c_str());
 
     startWriting();
 }
@@ -164,6 +191,8 @@ void Bag::close() {
         closeWrite();
 
     file_.close();
+    mapped_file_.reset();  // frames still using it hold on to it
+    mapped_chunk_pos_ = mapped_chunk_data_ = 0;
 
     topic_connection_ids_.clear();
     header_connection_ids_.clear();
@@ -173,6 +202,9 @@ void Bag::close() {
     chunks_.clear();
     connection_indexes_.clear();
     curr_chunk_connection_indexes_.clear();
+    curr_pending_chunk_.reset();
+    pending_chunks_.clear();
+    prefetched_chunks_.clear();  // those still in flight hold on to what they need
 }
 
 void Bag::closeWrite() {
@@ -194,6 +226,42 @@ void Bag::setChunkThreshold(uint32_t chunk_threshold) {
 
 CompressionType Bag::getCompression() const { return compression_; }
 
+void Bag::setMemoryMapped(bool mapped) { memory_mapped_ = mapped; }
+
+std::shared_ptr<MessageInstance> Bag::getLastMessage(std::function<bool(ConnectionInfo const*)> query,
+                                                     Time const& start_time, Time const& end_time) const {
+    if ((mode_ & bagmode::Read) != bagmode::Read)
+        throw BagException("Bag not opened for reading");
+
+    ConnectionInfo const* last_connection = NULL;
+    IndexEntry const*     last            = NULL;
+    for (map<uint32_t, ConnectionInfo*>::const_iterator i = connections_.begin(); i != connections_.end(); i++) {
+        if (!query(i->second))
+            continue;
+
+        map<uint32_t, multiset<IndexEntry> >::const_iterator j = connection_indexes_.find(i->first);
+        if (j == connection_indexes_.end())
+            continue;
+
+        // The entry just before the first one past the end is the last one up to it
+        multiset<IndexEntry>::const_iterator k = j->second.upper_bound({ end_time, 0, 0 });
+        if (k == j->second.begin())
+            continue;
+        --k;
+        if (k->time < start_time)
+            continue;
+
+        if (!last || last->time < k->time) {
+            last            = &*k;
+            last_connection = i->second;
+        }
+    }
+
+    if (!last)
+        return nullptr;
+    return std::shared_ptr<MessageInstance>(new MessageInstance(last_connection, *last, *this));
+}
+
 std::tuple<std::string, uint64_t, uint64_t> Bag::getCompressionInfo() const
 {
     std::map<std::string, uint64_t> compression_counts;
@@ -234,6 +302,24 @@ std::tuple<std::string, uint64_t, uint64_t> Bag::getCompressionInfo() const
     //auto main_compression_count = compression_counts.begin()->second;
     return std::make_tuple(main_compression, compressed, uncompressed);
 }
+void Bag::setDirectIO(bool direct_io) { direct_io_ = direct_io; }
+
+void Bag::setCompressionExecutor(Executor executor, uint32_t max_chunks_in_flight) {
+    if (file_.isOpen() && chunk_open_)
+        stopWritingChunk();
+    writePendingChunks(0);
+
+    executor_             = std::move(executor);
+    max_chunks_in_flight_ = max_chunks_in_flight;
+}
+
+void Bag::setPrefetch(Executor executor, uint32_t window) {
+    prefetch_executor_ = std::move(executor);
+    prefetch_window_   = window;
+    if (!prefetch_window_)
+        prefetched_chunks_.clear();
+}
+
 void Bag::setCompression(CompressionType compression) {
     if (file_.isOpen() && chunk_open_)
         stopWritingChunk();
@@ -292,6 +378,7 @@ void Bag::startWriting() {
 void Bag::stopWriting() {
     if (chunk_open_)
         stopWritingChunk();
+    writePendingChunks(0);
 
     seek(0, std::ios::end);
 
@@ -438,7 +525,9 @@ void Bag::readFileHeaderRecord() {
 }
 
 uint32_t Bag::getChunkOffset() const {
-    if (compression_ == compression::Uncompressed)
+    if (curr_pending_chunk_)
+        return curr_pending_chunk_->data.getSize();
+    else if (compression_ == compression::Uncompressed)
         return static_cast<uint32_t>(file_.getOffset() - curr_chunk_data_pos_);
     else
         return file_.getCompressedBytesIn();
@@ -450,6 +539,13 @@ void Bag::startWritingChunk(Time time) {
     curr_chunk_info_.start_time = time;
     curr_chunk_info_.end_time   = time;
 
+    if (compressesAsync()) {
+        // The chunk is written whole once compressed, header and all
+        curr_pending_chunk_ = std::make_shared<PendingChunk>();
+        chunk_open_ = true;
+        return;
+    }
+
     // Write the chunk header, with a place-holder for the data sizes (we'll fill in when the chunk is finished)
     writeChunkHeader(compression_, 0, 0);
 
@@ -463,6 +559,11 @@ void Bag::startWritingChunk(Time time) {
 }
 
 void Bag::stopWritingChunk() {
+    if (curr_pending_chunk_) {
+        submitPendingChunk();
+        return;
+    }
+
     // Add this chunk to the index
     chunks_.push_back(curr_chunk_info_);
 
@@ -479,7 +580,7 @@ void Bag::stopWritingChunk() {
 
     // Write out the indexes and clear them
     seek(end_of_chunk_pos);
-    writeIndexRecords();
+    writeIndexRecords(curr_chunk_connection_indexes_);
     curr_chunk_connection_indexes_.clear();
 
     // Clear the connection counts
@@ -489,6 +590,73 @@ void Bag::stopWritingChunk() {
     chunk_open_ = false;
 }
 
+void Bag::submitPendingChunk() {
+    std::shared_ptr<PendingChunk> chunk = std::move(curr_pending_chunk_);
+    curr_pending_chunk_.reset();
+    chunk->info = curr_chunk_info_;
+    chunk->connection_indexes.swap(curr_chunk_connection_indexes_);
+    curr_chunk_connection_indexes_.clear();
+    curr_chunk_info_.connection_counts.clear();
+    chunk_open_ = false;
+
+    pending_chunks_.push_back(chunk);
+    std::shared_ptr<CompressionSync> sync = compression_sync_;
+    executor_([chunk, sync]() {
+        // Same as LZ4Stream writes it (a frame with 4MB blocks), with room for data that doesn't compress
+        uint32_t size = chunk->data.getSize();
+        chunk->compressed.setSize(size + size / 255 + 1024);
+        unsigned int compressed_size = chunk->compressed.getSize();
+        bool ok = roslz4_buffToBuffCompress((char*) chunk->data.getData(), size,
+                                            (char*) chunk->compressed.getData(), &compressed_size, 6) == ROSLZ4_OK;
+        if (ok)
+            chunk->compressed.setSize(compressed_size);
+
+        std::lock_guard<std::mutex> lock(sync->mutex);
+        chunk->failed = !ok;
+        chunk->done   = true;
+        sync->cv.notify_all();
+    });
+
+    writePendingChunks(max_chunks_in_flight_);
+}
+
+void Bag::writePendingChunks(size_t max_in_flight) {
+    while (!pending_chunks_.empty()) {
+        std::shared_ptr<PendingChunk> chunk = pending_chunks_.front();
+        {
+            std::unique_lock<std::mutex> lock(compression_sync_->mutex);
+            if (pending_chunks_.size() > max_in_flight)
+                compression_sync_->cv.wait(lock, [&]() { return chunk->done; });
+            else if (!chunk->done)
+                break;
+        }
+        pending_chunks_.pop_front();
+        if (chunk->failed)
+            throw BagIOException("Error compressing chunk");
+        writePendingChunk(*chunk);
+    }
+}
+
+void Bag::writePendingChunk(PendingChunk& chunk) {
+    seek(0, std::ios::end);
+    chunk.info.pos = file_.getOffset();
+
+    writeChunkHeader(compression::LZ4, chunk.compressed.getSize(), chunk.data.getSize());
+    write((char*) chunk.compressed.getData(), chunk.compressed.getSize());
+    writeIndexRecords(chunk.connection_indexes);
+    file_size_ = file_.getOffset();
+
+    // Now the messages can be indexed
+    for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = chunk.connection_indexes.begin(); i != chunk.connection_indexes.end(); i++) {
+        std::multiset<IndexEntry>& connection_index = connection_indexes_[i->first];
+        for (IndexEntry index_entry : i->second) {
+            index_entry.chunk_pos = chunk.info.pos;
+            connection_index.insert(connection_index.end(), index_entry);
+        }
+    }
+    chunks_.push_back(chunk.info);
+}
+
 void Bag::writeChunkHeader(CompressionType compression, uint32_t compressed_size, uint32_t uncompressed_size) {
     ChunkHeader chunk_header;
     switch (compression) {
@@ -528,10 +696,75 @@ void Bag::readChunkHeader(ChunkHeader& chunk_header) const {
     CONSOLE_BRIDGE_logDebug("Read CHUNK: compression=%s size=%d uncompressed=%d (%f)", chunk_header.compression.c_str(), chunk_header.compressed_size, chunk_header.uncompressed_size, 100 * ((double) chunk_header.compressed_size) / chunk_header.uncompressed_size);
 }
 
+std::shared_ptr<uint8_t const> Bag::getMappedMessage(MessageInstance const& m, uint32_t& size) const {
+    if (!mapped_file_ || version_ != 200)
+        return nullptr;
+
+    IndexEntry const& entry = m.index_entry_;
+    if (mapped_chunk_pos_ != entry.chunk_pos) {
+        rs2rosinternal::Header header;
+        uint64_t data_pos;
+        uint32_t data_size;
+        if (!readMappedRecord(entry.chunk_pos, header, data_pos, data_size))
+            throw BagFormatException("Error reading CHUNK record");
+
+        M_string& fields = *header.getValues();
+        if (!isOp(fields, OP_CHUNK))
+            throw BagFormatException("Expected CHUNK op not found");
+        string compression;
+        readField(fields, COMPRESSION_FIELD_NAME, true, compression);
+
+        mapped_chunk_pos_  = entry.chunk_pos;
+        mapped_chunk_data_ = compression == COMPRESSION_NONE ? data_pos : 0;
+    }
+    if (!mapped_chunk_data_)
+        return nullptr;
+
+    // The index points right at the message, past the connection record written ahead of it, if any
+    rs2rosinternal::Header header;
+    uint64_t data_pos;
+    uint32_t data_size;
+    if (!readMappedRecord(mapped_chunk_data_ + entry.offset, header, data_pos, data_size))
+        throw BagFormatException("Error reading MSG_DATA record");
+    uint8_t op;
+    readField(*header.getValues(), OP_FIELD_NAME, true, &op);
+    if (op != OP_MSG_DATA)
+        throw BagFormatException("Expected MSG_DATA op not found");
+
+    size = data_size;
+    return std::shared_ptr<uint8_t const>(mapped_file_, mapped_file_->getData() + data_pos);
+}
+
+bool Bag::readMappedRecord(uint64_t pos, rs2rosinternal::Header& header, uint64_t& data_pos, uint32_t& data_size) const {
+    uint8_t const* data = mapped_file_->getData();
+    uint64_t       size = mapped_file_->getSize();
+
+    uint32_t header_len;
+    if (pos + 4 > size)
+        return false;
+    memcpy(&header_len, data + pos, 4);
+    pos += 4;
+
+    if (pos + header_len + 4 > size)
+        return false;
+    string error_msg;
+    if (!header.parse(data + pos, header_len, error_msg))
+        return false;
+    pos += header_len;
+
+    memcpy(&data_size, data + pos, 4);
+    pos += 4;
+    if (pos + data_size > size)
+        return false;
+
+    data_pos = pos;
+    return true;
+}
+
 // Index records
 
-void Bag::writeIndexRecords() {
-    for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = curr_chunk_connection_indexes_.begin(); i != curr_chunk_connection_indexes_.end(); i++) {
+void Bag::writeIndexRecords(map<uint32_t, multiset<IndexEntry> > const& connection_indexes) {
+    for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = connection_indexes.begin(); i != connection_indexes.end(); i++) {
         uint32_t                    connection_id = i->first;
         multiset<IndexEntry> const& index         = i->second;
 
@@ -784,6 +1017,8 @@ void Bag::readMessageDefinitionRecord102() {
 
 void Bag::decompressChunk(uint64_t chunk_pos) const {
     if (curr_chunk_info_.pos == chunk_pos) {
+        if (!mirrorsChunk())
+            throw BagException("The chunk being written cannot be read from a bag opened only for writing");
         current_buffer_ = &outgoing_chunk_buffer_;
         return;
     }
@@ -793,6 +1028,12 @@ void Bag::decompressChunk(uint64_t chunk_pos) const {
     if (decompressed_chunk_ == chunk_pos)
         return;
 
+    if (takePrefetchedChunk(chunk_pos)) {
+        decompressed_chunk_ = chunk_pos;
+        prefetchChunks(chunk_pos);
+        return;
+    }
+
     // Seek to the start of the chunk
     seek(chunk_pos);
 
@@ -811,6 +1052,107 @@ void Bag::decompressChunk(uint64_t chunk_pos) const {
         throw BagFormatException("Unknown compression: " + chunk_header.compression);
 
     decompressed_chunk_ = chunk_pos;
+    prefetchChunks(chunk_pos);
+}
+
+bool Bag::takePrefetchedChunk(uint64_t chunk_pos) const {
+    map<uint64_t, std::shared_ptr<PrefetchedChunk> >::iterator i = prefetched_chunks_.find(chunk_pos);
+    if (i == prefetched_chunks_.end())
+        return false;
+
+    std::shared_ptr<PrefetchedChunk> chunk = i->second;
+    prefetched_chunks_.erase(i);
+    {
+        std::unique_lock<std::mutex> lock(compression_sync_->mutex);
+        compression_sync_->cv.wait(lock, [&]() { return chunk->done; });
+    }
+    if (chunk->failed)
+        return false;  // read it again, to fail the usual way
+
+    decompress_buffer_.swap(chunk->data);
+    return true;
+}
+
+void Bag::prefetchChunks(uint64_t chunk_pos) const {
+    if (!prefetch_executor_ || !prefetch_window_ || mode_ != bagmode::Read)
+        return;
+
+    // The chunk infos are in file order, as the chunks were written
+    vector<ChunkInfo>::const_iterator i = std::lower_bound(chunks_.begin(), chunks_.end(), chunk_pos,
+        [](ChunkInfo const& info, uint64_t pos) { return info.pos < pos; });
+    if (i == chunks_.end() || i->pos != chunk_pos)
+        return;
+    ++i;
+    vector<ChunkInfo>::const_iterator last = i + std::min<ptrdiff_t>(prefetch_window_, chunks_.end() - i);
+    uint64_t end_pos = last == chunks_.end() ? std::numeric_limits<uint64_t>::max() : last->pos;
+
+    // Whatever isn't ahead anymore (e.g., after seeking) goes
+    for (map<uint64_t, std::shared_ptr<PrefetchedChunk> >::iterator j = prefetched_chunks_.begin(); j != prefetched_chunks_.end();) {
+        if (j->first <= chunk_pos || j->first >= end_pos)
+            j = prefetched_chunks_.erase(j);
+        else
+            ++j;
+    }
+
+    for (; i != last; ++i)
+        if (prefetched_chunks_.find(i->pos) == prefetched_chunks_.end())
+            prefetchChunk(i->pos);
+}
+
+void Bag::prefetchChunk(uint64_t chunk_pos) const {
+    std::shared_ptr<PrefetchedChunk> chunk = std::make_shared<PrefetchedChunk>();
+    std::shared_ptr<MappedFile>      mapped = mapped_file_;
+
+    ChunkHeader    chunk_header;
+    uint8_t const* source;
+    if (mapped) {
+        rs2rosinternal::Header header;
+        uint64_t data_pos;
+        if (!readMappedRecord(chunk_pos, header, data_pos, chunk_header.compressed_size))
+            return;
+        M_string& fields = *header.getValues();
+        if (!isOp(fields, OP_CHUNK))
+            return;
+        readField(fields, COMPRESSION_FIELD_NAME, true, chunk_header.compression);
+        readField(fields, SIZE_FIELD_NAME,        true, &chunk_header.uncompressed_size);
+        if (chunk_header.compression != COMPRESSION_LZ4 && chunk_header.compression != COMPRESSION_NONE)
+            return;
+        source = mapped->getData() + data_pos;
+    }
+    else {
+        seek(chunk_pos);
+        readChunkHeader(chunk_header);
+        if (chunk_header.compression != COMPRESSION_LZ4)
+            return;
+        chunk->compressed.setSize(chunk_header.compressed_size);
+        read((char*) chunk->compressed.getData(), chunk_header.compressed_size);
+        source = chunk->compressed.getData();
+    }
+
+    prefetched_chunks_[chunk_pos] = chunk;
+    std::shared_ptr<CompressionSync> sync = compression_sync_;
+    bool     compressed        = chunk_header.compression == COMPRESSION_LZ4;
+    uint32_t compressed_size   = chunk_header.compressed_size;
+    uint32_t uncompressed_size = chunk_header.uncompressed_size;
+    prefetch_executor_([chunk, mapped, sync, source, compressed, compressed_size, uncompressed_size]() {
+        chunk->data.setSize(uncompressed_size);
+        bool ok;
+        if (compressed) {
+            unsigned int size = uncompressed_size;
+            ok = roslz4_buffToBuffDecompress((char*) source, compressed_size, (char*) chunk->data.getData(), &size) == ROSLZ4_OK
+                 && size == uncompressed_size;
+        }
+        else {
+            ok = compressed_size == uncompressed_size;
+            if (ok)
+                memcpy(chunk->data.getData(), source, uncompressed_size);
+        }
+
+        std::lock_guard<std::mutex> lock(sync->mutex);
+        chunk->failed = !ok;
+        chunk->done   = true;
+        sync->cv.notify_all();
+    });
 }
 
 void Bag::readMessageDataRecord102(uint64_t offset, rs2rosinternal::Header& header) const {
@@ -1155,7 +1497,16 @@ std::string Bag::toHeaderString(Time const* field) const {
 // Low-level I/O
 
 void Bag::write(string const& s)                  { write(s.c_str(), s.length()); }
-void Bag::write(char const* s, std::streamsize n) { file_.write((char*) s, n);    }
+void Bag::write(char const* s, std::streamsize n) {
+    if (curr_pending_chunk_) {
+        Buffer& data = curr_pending_chunk_->data;
+        uint32_t offset = data.getSize();
+        data.setSize(offset + static_cast<uint32_t>(n));
+        memcpy(data.getData() + offset, s, n);
+    }
+    else
+        file_.write((char*) s, n);
+}
 
 void Bag::read(char* b, std::streamsize n) const  { file_.read(b, n);             }
 void Bag::seek(uint64_t pos, int origin) const    { file_.seek(pos, origin);      }
@@ -77,6 +77,22 @@ void ChunkedFile::openReadWrite(string const& filename) { open(filename, "r+b");
 void ChunkedFile::openWrite    (string const& filename) { open(filename, "w+b");  }
 void ChunkedFile::openRead     (string const& filename) { open(filename, "rb");  }
 
+bool ChunkedFile::openWriteDirect(string const& filename) {
+    if (isOpen())
+        throw BagIOException( "File already open: " + filename );
+
+    if (!direct_.open(filename)) {
+        openWrite(filename);
+        return false;
+    }
+
+    read_stream_  = std::make_shared<UncompressedStream>(this);
+    write_stream_ = std::make_shared<UncompressedStream>(this);
+    filename_     = filename;
+    offset_       = 0;
+    return true;
+}
+
 void ChunkedFile::open(string const& filename, string const& mode) {
     // Check if file is already open
     if (file_)
@@ -124,22 +140,25 @@ void ChunkedFile::open(string const& filename, string const& mode) {
 }
 
 bool ChunkedFile::good() const {
+    if (direct_.isOpen())
+        return true;
     return feof(file_) == 0 && ferror(file_) == 0;
 }
 
-bool   ChunkedFile::isOpen()      const { return file_ != NULL; }
+bool   ChunkedFile::isOpen()      const { return file_ != NULL || direct_.isOpen(); }
 string ChunkedFile::getFileName() const { return filename_;     }
 
 void ChunkedFile::close() {
-    if (!file_)
+    if (!isOpen())
         return;
 
     // Close any compressed stream by changing to uncompressed mode
     setWriteMode(compression::Uncompressed);
 
     // Close the file
-    int success = fclose(file_);
-    if (success != 0)
+    if (direct_.isOpen())
+        direct_.close();
+    else if (fclose(file_) != 0)
         throw BagIOException( "Error closing file: " + filename_ );
 
     file_ = NULL;
@@ -151,7 +170,7 @@ void ChunkedFile::close() {
 // Read/write modes
 
 void ChunkedFile::setWriteMode(CompressionType type) {
-    if (!file_)
+    if (!isOpen())
         throw BagIOException("Can't set compression mode before opening a file");
 
     if (type != write_stream_->getCompressionType()) {
@@ -163,7 +182,7 @@ void ChunkedFile::setWriteMode(CompressionType type) {
 }
 
 void ChunkedFile::setReadMode(CompressionType type) {
-    if (!file_)
+    if (!isOpen())
         throw BagIOException("Can't set compression mode before opening a file");
 
     if (type != read_stream_->getCompressionType()) {
@@ -175,11 +194,21 @@ void ChunkedFile::setReadMode(CompressionType type) {
 }
 
 void ChunkedFile::seek(uint64_t offset, int origin) {
-    if (!file_)
+    if (!isOpen())
         throw BagIOException("Can't seek - file not open");
 
     setReadMode(compression::Uncompressed);
 
+    if (direct_.isOpen()) {
+        // Nothing to move: the offset is where we'll write next
+        switch (origin) {
+        case std::ios_base::beg: offset_ = offset;                      break;
+        case std::ios_base::cur: offset_ += offset;                     break;
+        case std::ios_base::end: offset_ = direct_.getSize() + offset; break;
+        }
+        return;
+    }
+
     int success = fseeko(file_, offset, origin);
     if (success != 0)
         throw BagIOException("Error seeking");
@@ -192,7 +221,18 @@ uint32_t ChunkedFile::getCompressedBytesIn() const { return static_cast<uint32_t
 
 void ChunkedFile::write(string const& s)        { write((void*) s.c_str(), s.size()); }
 void ChunkedFile::write(void* ptr, size_t size) { write_stream_->write(ptr, size);    }
-void ChunkedFile::read(void* ptr, size_t size)  { read_stream_->read(ptr, size);      }
+void ChunkedFile::read(void* ptr, size_t size)  {
+    if (direct_.isOpen())
+        throw BagIOException("Can't read - file open for writing with direct I/O");
+    read_stream_->read(ptr, size);
+}
+
+size_t ChunkedFile::writeToFile(void* ptr, size_t size) {
+    if (!direct_.isOpen())
+        return fwrite(ptr, 1, size, file_);
+    direct_.write(offset_, ptr, size);
+    return size;
+}
 
 bool ChunkedFile::truncate(uint64_t length) {
     int fd = fileno(file_);
@@ -0,0 +1,233 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "rosbag/direct_file.h"
+#include "rosbag/exceptions.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace rosbag {
+
+DirectFile::DirectFile() :
+    fd_(-1),
+    alignment_(4096),             // the logical block size of about anything nowadays
+    capacity_(4 * 1024 * 1024),
+    active_(0),
+    active_start_(0),
+    active_size_(0),
+    size_(0),
+    pending_(false),
+    pending_buffer_(NULL),
+    pending_offset_(0),
+    stopping_(false),
+    error_(0)
+{
+    buffers_[0] = buffers_[1] = NULL;
+}
+
+DirectFile::~DirectFile() {
+    try {
+        close();
+    }
+    catch (...) {
+    }
+}
+
+#ifdef __linux__
+
+namespace {
+
+// Returns the errno of the failure, or 0
+int writeAll(int fd, uint8_t const* ptr, size_t size, uint64_t offset) {
+    while (size) {
+        ssize_t n = pwrite(fd, ptr, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return errno;
+        }
+        ptr    += n;
+        size   -= n;
+        offset += n;
+    }
+    return 0;
+}
+
+std::string errorString(int error) { return strerror(error); }
+
+}  // namespace
+
+bool DirectFile::open(std::string const& filename) {
+    if (fd_ >= 0)
+        throw BagIOException("File already open: " + filename);
+
+    fd_ = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    if (fd_ < 0)
+        return false;
+
+    for (uint8_t*& buffer : buffers_) {
+        void* p = NULL;
+        if (posix_memalign(&p, alignment_, capacity_) != 0) {
+            close();
+            throw BagIOException("Out of memory for direct I/O buffers");
+        }
+        buffer = static_cast<uint8_t*>(p);
+    }
+    active_ = 0;
+    active_start_ = active_size_ = size_ = 0;
+    pending_ = stopping_ = false;
+    error_ = 0;
+    thread_ = std::thread([this]() { writer(); });
+    return true;
+}
+
+void DirectFile::close() {
+    if (fd_ < 0)
+        return;
+
+    int error = 0;
+    if (thread_.joinable()) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return !pending_; });
+            stopping_ = true;
+            error = error_;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    // The last of it still goes in whole blocks, with the file cut to size afterwards
+    if (!error && active_size_) {
+        size_t size = (active_size_ + alignment_ - 1) & ~(alignment_ - 1);
+        memset(buffers_[active_] + active_size_, 0, size - active_size_);
+        error = writeAll(fd_, buffers_[active_], size, active_start_);
+    }
+    if (!error && ftruncate(fd_, static_cast<off_t>(size_)) != 0)
+        error = errno;
+
+    ::close(fd_);
+    fd_ = -1;
+    for (uint8_t*& buffer : buffers_) {
+        free(buffer);
+        buffer = NULL;
+    }
+
+    if (error)
+        throw BagIOException("Error writing to file: " + errorString(error));
+}
+
+void DirectFile::write(uint64_t offset, void const* ptr, size_t size) {
+    if (fd_ < 0)
+        throw BagIOException("Can't write - file not open");
+    if (offset > size_)
+        throw BagIOException("Can't write past the end of the file");
+
+    uint8_t const* p = static_cast<uint8_t const*>(ptr);
+    if (offset < active_start_) {
+        size_t n = static_cast<size_t>(std::min<uint64_t>(size, active_start_ - offset));
+        patch(offset, p, n);
+        offset += n;
+        p      += n;
+        size   -= n;
+    }
+    while (size) {
+        size_t pos = static_cast<size_t>(offset - active_start_);
+        size_t n   = std::min(size, capacity_ - pos);
+        memcpy(buffers_[active_] + pos, p, n);
+        active_size_ = std::max(active_size_, pos + n);
+        offset += n;
+        p      += n;
+        size   -= n;
+        if (active_size_ == capacity_)
+            submit();
+    }
+    size_ = std::max(size_, offset);
+}
+
+void DirectFile::submit() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_        = true;
+        pending_buffer_ = buffers_[active_];
+        pending_offset_ = active_start_;
+    }
+    cv_.notify_all();
+
+    active_ ^= 1;
+    active_start_ += capacity_;
+    active_size_ = 0;
+}
+
+void DirectFile::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return !pending_; });
+    if (error_)
+        throw BagIOException("Error writing to file: " + errorString(error_));
+}
+
+void DirectFile::patch(uint64_t offset, uint8_t const* ptr, size_t size) {
+    // Whole blocks only: read back those around it, then write them again. They all end before the active buffer,
+    // which starts on a block.
+    wait();
+    uint64_t begin = offset & ~static_cast<uint64_t>(alignment_ - 1);
+    uint64_t end   = (offset + size + alignment_ - 1) & ~static_cast<uint64_t>(alignment_ - 1);
+    size_t length  = static_cast<size_t>(end - begin);
+
+    void* p = NULL;
+    if (posix_memalign(&p, alignment_, length) != 0)
+        throw BagIOException("Out of memory for direct I/O buffers");
+    std::unique_ptr<uint8_t, decltype(&free)> blocks(static_cast<uint8_t*>(p), &free);
+
+    if (pread(fd_, blocks.get(), length, static_cast<off_t>(begin)) != static_cast<ssize_t>(length))
+        throw BagIOException("Error reading back from file: " + errorString(errno));
+    memcpy(blocks.get() + (offset - begin), ptr, size);
+    int error = writeAll(fd_, blocks.get(), length, begin);
+    if (error)
+        throw BagIOException("Error writing to file: " + errorString(error));
+}
+
+void DirectFile::writer() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this]() { return pending_ || stopping_; });
+        if (!pending_)
+            return;
+
+        // The buffer is ours until we say we're done
+        uint8_t const* buffer = pending_buffer_;
+        uint64_t offset = pending_offset_;
+        lock.unlock();
+        int error = writeAll(fd_, buffer, capacity_, offset);
+        lock.lock();
+
+        if (error && !error_)
+            error_ = error;
+        pending_ = false;
+        cv_.notify_all();
+    }
+}
+
+#else
+
+bool DirectFile::open(std::string const&)              { return false; }
+void DirectFile::close()                               { }
+void DirectFile::write(uint64_t, void const*, size_t)  { throw BagIOException("Direct I/O is not supported"); }
+void DirectFile::submit()                              { }
+void DirectFile::wait()                                { }
+void DirectFile::patch(uint64_t, uint8_t const*, size_t) { }
+void DirectFile::writer()                              { }
+
+#endif
+
+} // namespace rosbag
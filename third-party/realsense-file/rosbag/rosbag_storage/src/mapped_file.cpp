@@ -0,0 +1,99 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "rosbag/mapped_file.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace rosbag {
+
+MappedFile::MappedFile() : data_(NULL), size_(0) { }
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::open(std::string const& filename) {
+    close();
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0
+        && static_cast<unsigned long long>(size.QuadPart) <= static_cast<SIZE_T>(-1))
+        mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping)
+        return false;
+
+    // The view keeps the mapping alive by itself
+    void* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view)
+        return false;
+
+    data_ = static_cast<uint8_t*>(view);
+    size_ = static_cast<uint64_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_)
+        UnmapViewOfFile(data_);
+    data_ = NULL;
+    size_ = 0;
+}
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+bool MappedFile::open(std::string const& filename) {
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    void* p = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0 && static_cast<uint64_t>(st.st_size) <= static_cast<size_t>(-1))
+        p = mmap(NULL, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // the mapping keeps its own reference to the file
+    if (p == MAP_FAILED)
+        return false;
+
+    data_ = static_cast<uint8_t*>(p);
+    size_ = static_cast<uint64_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_)
+        munmap(data_, static_cast<size_t>(size_));
+    data_ = NULL;
+    size_ = 0;
+}
+
+#else
+
+bool MappedFile::open(std::string const&) { return false; }
+void MappedFile::close()                  { }
+
+#endif
+
+} // namespace rosbag
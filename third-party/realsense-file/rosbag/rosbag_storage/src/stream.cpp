@@ -69,6 +69,7 @@ void Stream::startRead()  { }
 void Stream::stopRead()   { }
 
 FILE*    Stream::getFilePointer()                 { return file_->file_;            }
+size_t   Stream::writeToFile(void* ptr, size_t size) { return file_->writeToFile(ptr, size); }
 uint64_t Stream::getCompressedIn()                { return file_->compressed_in_;   }
 void     Stream::setCompressedIn(uint64_t nbytes) { file_->compressed_in_ = nbytes; }
 void     Stream::advanceOffset(uint64_t nbytes)   { file_->offset_ += nbytes;       }
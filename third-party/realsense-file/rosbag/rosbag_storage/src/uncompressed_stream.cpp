@@ -49,7 +49,7 @@ CompressionType UncompressedStream::getCompressionType() const {
 }
 
 void UncompressedStream::write(void* ptr, size_t size) {
-    size_t result = fwrite(ptr, 1, size, getFilePointer());
+    size_t result = writeToFile(ptr, size);
     if (result != size)
         throw BagIOException( "Error writing to file: writing " + std::to_string( size ) + " bytes, wrote "
                               + std::to_string( result ) + " bytes" );
@@ -9,6 +9,10 @@
 #include <atomic>
 #include <functional>
 #include <cassert>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <string>
 
 const int QUEUE_MAX_SIZE = 10;
 // Simplest implementation of a blocking concurrent queue for thread messaging
@@ -128,6 +132,22 @@ public:
         return true;
     }
 
+    // Remove up to 'max' of the items available, in order, under a single lock; do not wait for any
+    // Return the number of items removed
+    size_t try_dequeue_batch( T * items, size_t max )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        size_t const n = std::min( max, _queue.size() );
+        for( size_t i = 0; i < n; ++i )
+        {
+            items[i] = std::move( _queue.front() );
+            _queue.pop_front();
+        }
+        if( n )
+            _enq_cv.notify_all();
+        return n;
+    }
+
     template< class Fn >
     bool peek( Fn fn ) const
     {
@@ -193,21 +213,298 @@ public:
     bool empty() const { return ! size(); }
 };
 
+// A bounded queue with the same semantics as single_consumer_queue, but without a lock on the way in or out: a ring
+// of slots, each with a sequence number saying whose turn it is to fill or empty it. A dequeue() that finds nothing
+// spins for a while before going to sleep, and an enqueue() only pays for a wake-up when someone is asleep.
+//
+// When full, enqueue() dequeues the oldest item itself to make room, so several threads may be taking items out at
+// once and there's no peek().
+//
+// With 'busy_poll', waiting keeps spinning for that long before sleeping: a CPU is spent on the waiting thread, but no
+// wake-up is needed when an item arrives within it.
+//
+template< class T >
+class lock_free_queue
+{
+    struct slot
+    {
+        std::atomic< size_t > seq;
+        T item;
+    };
+
+    std::unique_ptr< slot[] > _slots;
+    size_t const _cap;
+    size_t const _n_slots;        // A slot's sequence number can't tell full from empty with just one
+    std::atomic< size_t > _head;  // Next to dequeue
+    std::atomic< size_t > _tail;  // Next to enqueue
+    std::atomic< bool > _accepting;
+
+    // Sleeping is only for when spinning didn't do it
+    static int const SPINS = 64;
+    std::chrono::microseconds const _busy_poll;
+    std::mutex _mutex;
+    std::condition_variable _deq_cv;  // not empty signal
+    std::condition_variable _enq_cv;  // not full signal
+    std::atomic< int > _deq_waiters;
+    std::atomic< int > _enq_waiters;
+
+    std::function< void( T const & ) > const _on_drop_callback;
+
+    bool try_push( T & item )
+    {
+        size_t pos = _tail.load( std::memory_order_relaxed );
+        while( true )
+        {
+            slot & s = _slots[pos % _n_slots];
+            size_t seq = s.seq.load( std::memory_order_acquire );
+            if( seq == pos )
+            {
+                if( _n_slots > _cap && pos - _head.load( std::memory_order_acquire ) >= _cap )
+                    return false;
+                // Empty, and the turn of whoever gets 'pos'
+                if( _tail.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                {
+                    s.item = std::move( item );
+                    s.seq.store( pos + 1, std::memory_order_release );
+                    return true;
+                }
+            }
+            else if( seq < pos )
+                return false;  // Still holding what was put there a round ago: full
+            else
+                pos = _tail.load( std::memory_order_relaxed );
+        }
+    }
+
+    bool try_pop( T & item )
+    {
+        size_t pos = _head.load( std::memory_order_relaxed );
+        while( true )
+        {
+            slot & s = _slots[pos % _n_slots];
+            size_t seq = s.seq.load( std::memory_order_acquire );
+            if( seq == pos + 1 )
+            {
+                if( _head.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                {
+                    item = std::move( s.item );
+                    s.item = T();
+                    s.seq.store( pos + _n_slots, std::memory_order_release );
+                    return true;
+                }
+            }
+            else if( seq < pos + 1 )
+                return false;  // Not filled yet: empty
+            else
+                pos = _head.load( std::memory_order_relaxed );
+        }
+    }
+
+    // Whoever's asleep checks under the mutex, after letting us know it's there; we check for them after making the
+    // change they're waiting for: one of us is bound to see the other
+    void wake( std::atomic< int > & waiters, std::condition_variable & cv, bool all = false )
+    {
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        if( waiters.load( std::memory_order_relaxed ) )
+        {
+            {
+                std::lock_guard< std::mutex > lock( _mutex );
+            }
+            if( all )
+                cv.notify_all();
+            else
+                cv.notify_one();
+        }
+    }
+
+    template< class Pred >
+    bool spin_then_wait( std::atomic< int > & waiters, std::condition_variable & cv, unsigned int timeout_ms,
+                         Pred pred )
+    {
+        for( int i = 0; i < SPINS; ++i )
+        {
+            if( pred() )
+                return true;
+            std::this_thread::yield();
+        }
+        if( _busy_poll.count() )
+        {
+            auto const until = std::chrono::steady_clock::now()
+                             + std::min< std::chrono::microseconds >( _busy_poll,
+                                                                      std::chrono::milliseconds( timeout_ms ) );
+            while( std::chrono::steady_clock::now() < until )
+                if( pred() )
+                    return true;
+        }
+        std::unique_lock< std::mutex > lock( _mutex );
+        waiters.fetch_add( 1 );
+        bool const done = cv.wait_for( lock, std::chrono::milliseconds( timeout_ms ), pred );
+        waiters.fetch_sub( 1 );
+        return done;
+    }
+
+public:
+    explicit lock_free_queue< T >( unsigned int cap = QUEUE_MAX_SIZE,
+                                   std::function< void( T const & ) > on_drop_callback = nullptr,
+                                   std::chrono::microseconds busy_poll = std::chrono::microseconds( 0 ) )
+        : _slots( new slot[std::max( cap, 2u )] )
+        , _cap( cap ? cap : 1 )
+        , _n_slots( std::max( cap, 2u ) )
+        , _head( 0 )
+        , _tail( 0 )
+        , _accepting( true )
+        , _busy_poll( busy_poll )
+        , _deq_waiters( 0 )
+        , _enq_waiters( 0 )
+        , _on_drop_callback( on_drop_callback )
+    {
+        for( size_t i = 0; i < _n_slots; ++i )
+            _slots[i].seq.store( i, std::memory_order_relaxed );
+    }
+
+    // Enqueue an item onto the queue.
+    // If the queue is full, the front will be removed, losing whatever was there!
+    bool enqueue( T && item )
+    {
+        if( ! _accepting )
+        {
+            if( _on_drop_callback )
+                _on_drop_callback( item );
+            return false;
+        }
+
+        while( ! try_push( item ) )
+        {
+            T oldest;
+            if( try_pop( oldest ) && _on_drop_callback )
+                _on_drop_callback( oldest );
+        }
+
+        // We pushed something -- let others know there's something to dequeue
+        wake( _deq_waiters, _deq_cv );
+        return true;
+    }
+
+    // Enqueue an item, but wait for room if there isn't any
+    // Returns true if the enqueue succeeded
+    bool blocking_enqueue( T && item )
+    {
+        bool pushed = false;
+        while( ! pushed && _accepting )
+            spin_then_wait( _enq_waiters, _enq_cv, 100,
+                            [&]() { return ( pushed = try_push( item ) ) || ! _accepting; } );
+        if( ! pushed )
+        {
+            // We shouldn't be adding anything to the queue when we're stopping
+            if( _on_drop_callback )
+                _on_drop_callback( item );
+            return false;
+        }
+
+        wake( _deq_waiters, _deq_cv );
+        return true;
+    }
+
+    // Remove one item; if unavailable, wait for it
+    // Return true if an item was removed -- otherwise, false
+    bool dequeue( T * item, unsigned int timeout_ms )
+    {
+        bool popped = false;
+        spin_then_wait( _deq_waiters, _deq_cv, timeout_ms,
+                        [&]() { return ( popped = try_pop( *item ) ) || ! _accepting; } );
+        if( popped )
+            // We've made room -- let whoever is waiting for room know about it
+            wake( _enq_waiters, _enq_cv );
+        return popped;
+    }
+
+    // Remove one item if available; do not wait for one
+    // Return true if an item was removed -- otherwise, false
+    bool try_dequeue( T * item )
+    {
+        if( ! try_pop( *item ) )
+            return false;
+        wake( _enq_waiters, _enq_cv );
+        return true;
+    }
+
+    // Remove up to 'max' of the items available, in order; do not wait for any
+    // Return the number of items removed
+    size_t try_dequeue_batch( T * items, size_t max )
+    {
+        size_t n = 0;
+        while( n < max && try_pop( items[n] ) )
+            ++n;
+        if( n )
+            wake( _enq_waiters, _enq_cv, n > 1 );
+        return n;
+    }
+
+    void stop()
+    {
+        // We no longer accept any more items!
+        _accepting = false;
+        clear();
+    }
+
+    void clear()
+    {
+        T item;
+        while( try_pop( item ) )
+            item = T();
+
+        // Wake up anyone who is waiting for room to enqueue, or waiting for something to dequeue -- there's nothing now
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+        }
+        _enq_cv.notify_all();
+        _deq_cv.notify_all();
+    }
+
+    void start() { _accepting = true; }
+
+    bool started() const { return _accepting; }
+    bool stopped() const { return ! started(); }
+
+    // Only a snapshot while others are enqueuing/dequeuing
+    size_t size() const
+    {
+        size_t const head = _head.load( std::memory_order_relaxed );
+        size_t const tail = _tail.load( std::memory_order_relaxed );
+        return tail > head ? std::min( tail - head, _cap ) : 0;
+    }
+
+    bool empty() const { return ! size(); }
+};
+
 // A single_consumer_queue meant to hold frame_holder objects
+// With 'lock_free', a lock_free_queue is used instead, busy-polling for 'busy_poll' (and peek() is not available)
 template<class T>
 class single_consumer_frame_queue
 {
     single_consumer_queue<T> _queue;
+    std::unique_ptr< lock_free_queue< T > > _lock_free;
 
 public:
     single_consumer_frame_queue< T >( unsigned int cap = QUEUE_MAX_SIZE,
-                                      std::function< void( T const & ) > on_drop_callback = nullptr )
+                                      std::function< void( T const & ) > on_drop_callback = nullptr,
+                                      bool lock_free = false,
+                                      std::chrono::microseconds busy_poll = std::chrono::microseconds( 0 ) )
         : _queue( cap, on_drop_callback )
+        , _lock_free( lock_free ? new lock_free_queue< T >( cap, on_drop_callback, busy_poll ) : nullptr )
     {
     }
 
+    bool is_lock_free() const { return _lock_free != nullptr; }
+
     bool enqueue( T && item )
     {
+        if( _lock_free )
+        {
+            if( item->is_blocking() )
+                return _lock_free->blocking_enqueue( std::move( item ) );
+            return _lock_free->enqueue( std::move( item ) );
+        }
         if( item->is_blocking() )
             return _queue.blocking_enqueue( std::move( item ) );
         else
@@ -216,53 +513,74 @@ public:
 
     bool dequeue(T* item, unsigned int timeout_ms)
     {
+        if( _lock_free )
+            return _lock_free->dequeue( item, timeout_ms );
         return _queue.dequeue(item, timeout_ms);
     }
 
     bool try_dequeue(T* item)
     {
+        if( _lock_free )
+            return _lock_free->try_dequeue( item );
         return _queue.try_dequeue(item);
     }
 
+    size_t try_dequeue_batch( T * items, size_t max )
+    {
+        if( _lock_free )
+            return _lock_free->try_dequeue_batch( items, max );
+        return _queue.try_dequeue_batch( items, max );
+    }
+
     template< class Fn >
     bool peek( Fn fn ) const
     {
+        assert( ! _lock_free );
         return _queue.peek( fn );
     }
 
     template< class Fn >
     bool peek( Fn fn )
     {
+        assert( ! _lock_free );
         return _queue.peek( fn );
     }
 
     void clear()
     {
+        if( _lock_free )
+            return _lock_free->clear();
         _queue.clear();
     }
 
     void stop()
     {
+        if( _lock_free )
+            return _lock_free->stop();
         _queue.stop();
     }
 
     void start()
     {
+        if( _lock_free )
+            return _lock_free->start();
         _queue.start();
     }
 
     size_t size() const
     {
+        if( _lock_free )
+            return _lock_free->size();
         return _queue.size();
     }
 
     bool empty() const
     {
-        return _queue.empty();
+        return ! size();
     }
 
-    bool started() const { return _queue.started(); }
-    bool stopped() const { return _queue.stopped(); }
+    bool started() const { return _lock_free ? _lock_free->started() : _queue.started(); }
+    bool stopped() const { return ! started(); }
 };
 
 // The dispatcher is responsible for dispatching generic 'actions': any thread can queue an action
@@ -314,8 +632,11 @@ public:
     // and we're non-blocking. The on_drop_callback allows caputring of these instances, if we
     // want...
     //
+    // The dispatching thread is set up for its role (see rsutils::os::init_thread).
+    //
     dispatcher( unsigned int queue_capacity,
-                std::function< void( action ) > on_drop_callback = nullptr );
+                std::function< void( action ) > on_drop_callback = nullptr,
+                std::string const & thread_role = "dispatcher" );
 
     ~dispatcher();
 
@@ -406,8 +727,8 @@ template<class T = std::function<void(dispatcher::cancellable_timer)>>
 class active_object
 {
 public:
-    active_object(T operation)
-        : _operation(std::move(operation)), _dispatcher(1), _stopped(true)
+    active_object(T operation, std::string const & thread_role = "dispatcher")
+        : _operation(std::move(operation)), _dispatcher(1, nullptr, thread_role), _stopped(true)
     {
     }
 
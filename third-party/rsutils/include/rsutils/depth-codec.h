@@ -0,0 +1,48 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+
+namespace rsutils {
+
+
+// Lossless coding of 16-bit depth images, after RVL (A. Wilson, "Fast Lossless Depth Image Compression", 2017):
+// every run of zeros (invalid pixels) and of non-zeros is coded by its length, and the non-zero pixels by their
+// difference from the previous one, in variable-length nibbles. Depth is smooth enough that most pixels take a
+// nibble or two, and the result is typically several times smaller than the raw image, where LZ4 hardly gets
+// anywhere with the noise in the low bits.
+//
+// Coding a run is inherently serial, so the image is cut into bands coded independently, to spread the work over
+// however many threads the caller has. The result, all numbers little-endian:
+//     uint32 pixel count, uint32 band count, uint32 size of each band in bytes, then the bands one after the other
+// where band i covers pixels [count * i / n, count * (i + 1) / n).
+//
+namespace depth_codec {
+
+
+// Calls fn( i ) for each band i in [0, n), in parallel if it likes, and returns once they're all done
+typedef std::function< void( size_t n, std::function< void( size_t i ) > const & fn ) > for_each_band_fn;
+
+
+// Code 'count' pixels into 'out', replacing whatever was in it. Without for_each_band, the bands are coded one after
+// the other; the result is the same either way.
+void encode( uint16_t const * pixels, size_t count, std::vector< uint8_t > & out,
+             for_each_band_fn const & for_each_band = nullptr );
+
+// Returns the pixel count 'data' holds, or 0 if it isn't coded data
+size_t decoded_count( uint8_t const * data, size_t size );
+
+// Decode into 'pixels', which has room for exactly 'count' of them. Returns false, with 'pixels' in an unknown
+// state, if the data is corrupt or not for as many pixels.
+bool decode( uint8_t const * data, size_t size, uint16_t * pixels, size_t count,
+             for_each_band_fn const & for_each_band = nullptr );
+
+
+}  // namespace depth_codec
+}  // namespace rsutils
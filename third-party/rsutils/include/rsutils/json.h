@@ -238,4 +238,12 @@ inline json_ref json_base::nested( Rest... rest ) const
 }
 
 
+// Parse JSON text or, when the content starts like an object in one of them, a binary encoding: CBOR or MessagePack.
+// Binary content (which is smaller and parses faster) must be an object: its first byte then tells which encoding it
+// is, and can't be the start of any JSON text.
+// Throws on invalid content, as json::parse() does.
+//
+json parse_json_or_binary( void const * data, size_t size );
+
+
 }  // namespace rsutils
@@ -0,0 +1,51 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <rsutils/json-fwd.h>
+
+#include <string>
+#include <vector>
+
+
+namespace rsutils {
+namespace os {
+
+
+// How a thread should be scheduled. Threads are set up by role ("capture", "dispatcher", ...) when they start, each
+// with the settings of its role or, if it has none, those of the "default" role.
+//
+struct thread_settings
+{
+    std::vector< int > cpus;    // The CPUs the thread may run on; empty for any
+    int priority = 0;           // < 0 below normal, > 0 above normal
+    int realtime_priority = 0;  // > 0 for real-time scheduling (SCHED_FIFO on Linux) at that priority, 1-99
+    std::string name;           // Empty for the role; Linux keeps only the first 15 characters
+};
+
+
+// Set up the roles from settings of the form:
+//     {
+//         "default": { "cpus": [ 2, 3 ] },
+//         "capture": { "cpus": [ 4 ], "priority": "low" | "normal" | "high", "realtime-priority": 50, "name": "rs-uvc" },
+//         ...
+//     }
+// Replaces whatever was set before. Takes effect for threads started afterwards.
+//
+void configure_threads( rsutils::json const & settings );
+
+void set_thread_settings( std::string const & role, thread_settings const & );
+thread_settings get_thread_settings( std::string const & role );  // With the default for roles without any
+
+// Apply the settings to the calling thread. Best effort: failing (e.g., for real-time scheduling without the
+// privileges) only logs a warning and returns false.
+//
+bool apply_thread_settings( thread_settings const & );
+
+// For a thread to call when it starts: applies the settings of its role
+//
+void init_thread( std::string const & role );
+
+
+}  // namespace os
+}  // namespace rsutils
@@ -0,0 +1,79 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace rsutils {
+
+
+// 16-bit depth images that are mostly zeros (invalid pixels), e.g. after a threshold or ROI, as only their valid pixels:
+// the column and depth of each, row after row, after a table of where each row ends so that rows (and pixels, by a
+// binary search within the row) can be read in place, without decoding. All numbers little-endian:
+//     uint32 width, uint32 height, uint32 end of each row, then { uint16 x, uint16 depth } for each valid pixel
+// where the end of a row is the count of valid pixels up to and including it, and the pixels of a row are in
+// increasing x. Anything past the last pixel (e.g., the padding of a frame) is ignored.
+//
+// This is smaller than the image itself once less than about half its pixels are valid.
+//
+namespace sparse_depth {
+
+
+namespace detail {
+
+inline uint32_t load_le16( uint8_t const * p ) { return uint32_t( p[0] ) | uint32_t( p[1] ) << 8; }
+inline uint32_t load_le32( uint8_t const * p ) { return load_le16( p ) | load_le16( p + 2 ) << 16; }
+
+}  // namespace detail
+
+
+size_t const header_size = 8;
+
+
+// The size of the coded image, which 'encode' needs room for; 'stride' is in bytes
+size_t encoded_size( uint16_t const * pixels, uint32_t width, uint32_t height, size_t stride );
+
+// Code the image into 'out', which has room for encoded_size() of it; returns the size written
+size_t encode( uint16_t const * pixels, uint32_t width, uint32_t height, size_t stride, uint8_t * out );
+void encode( uint16_t const * pixels, uint32_t width, uint32_t height, size_t stride, std::vector< uint8_t > & out );
+
+// Decode into 'pixels', a packed image of 'width' x 'height'. Returns false, with 'pixels' in an unknown state, if the
+// data is corrupt or not of those dimensions.
+bool decode( uint8_t const * data, size_t size, uint16_t * pixels, uint32_t width, uint32_t height );
+
+
+// Coded data, read in place
+class image
+{
+    uint8_t const * _data = nullptr;
+    uint32_t _width = 0, _height = 0;
+
+    uint8_t const * pixel( size_t i ) const { return _data + header_size + 4 * size_t( _height ) + 4 * i; }
+
+public:
+    // Returns false if the data is not a coded image. Only the table of the rows is checked, so that this takes no
+    // longer than the height: the x of a pixel is as coded, for the reader to check against the width.
+    bool parse( uint8_t const * data, size_t size );
+
+    uint32_t width() const { return _width; }
+    uint32_t height() const { return _height; }
+    // Of valid pixels
+    size_t count() const { return _height ? end( _height - 1 ) : 0; }
+
+    // The valid pixels of row y are [begin( y ), end( y ))
+    size_t begin( uint32_t y ) const { return y ? end( y - 1 ) : 0; }
+    size_t end( uint32_t y ) const { return detail::load_le32( _data + header_size + 4 * size_t( y ) ); }
+    uint16_t x( size_t i ) const { return uint16_t( detail::load_le16( pixel( i ) ) ); }
+    uint16_t depth( size_t i ) const { return uint16_t( detail::load_le16( pixel( i ) + 2 ) ); }
+
+    // The depth at (x, y), 0 if invalid
+    uint16_t at( uint32_t x, uint32_t y ) const;
+};
+
+
+}  // namespace sparse_depth
+}  // namespace rsutils
@@ -0,0 +1,273 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <rsutils/depth-codec.h>
+
+#include <algorithm>
+
+
+namespace rsutils {
+namespace depth_codec {
+
+
+namespace {
+
+
+// Bands are about this many pixels, so the result doesn't depend on how many threads it was coded with
+size_t const band_pixels = 64 * 1024;
+size_t const max_bands = 256;
+
+
+void store_le32( uint8_t * p, uint32_t value )
+{
+    p[0] = uint8_t( value );
+    p[1] = uint8_t( value >> 8 );
+    p[2] = uint8_t( value >> 16 );
+    p[3] = uint8_t( value >> 24 );
+}
+
+
+uint32_t load_le32( uint8_t const * p )
+{
+    return uint32_t( p[0] ) | uint32_t( p[1] ) << 8 | uint32_t( p[2] ) << 16 | uint32_t( p[3] ) << 24;
+}
+
+
+// Values go out 3 bits per nibble, lowest first, the top bit of the nibble saying whether more follow. Nibbles fill
+// up 32-bit words from the top.
+class nibble_writer
+{
+    std::vector< uint32_t > & _words;
+    uint32_t _word = 0;
+    int _nibbles = 0;
+
+public:
+    explicit nibble_writer( std::vector< uint32_t > & words )
+        : _words( words )
+    {
+    }
+
+    void put( uint32_t value )
+    {
+        do
+        {
+            uint32_t nibble = value & 0x7;
+            value >>= 3;
+            if( value )
+                nibble |= 0x8;
+            _word = ( _word << 4 ) | nibble;
+            if( ++_nibbles == 8 )
+            {
+                _words.push_back( _word );
+                _word = 0;
+                _nibbles = 0;
+            }
+        }
+        while( value );
+    }
+
+    void flush()
+    {
+        if( _nibbles )
+            _words.push_back( _word << 4 * ( 8 - _nibbles ) );
+    }
+};
+
+
+class nibble_reader
+{
+    uint8_t const * _data;
+    size_t _n_words;
+    size_t _next = 0;
+    uint32_t _word = 0;
+    int _nibbles = 0;
+
+public:
+    nibble_reader( uint8_t const * data, size_t n_words )
+        : _data( data )
+        , _n_words( n_words )
+    {
+    }
+
+    bool get( uint32_t & value )
+    {
+        value = 0;
+        for( int shift = 0; shift < 32; shift += 3 )
+        {
+            if( ! _nibbles )
+            {
+                if( _next == _n_words )
+                    return false;
+                _word = load_le32( _data + 4 * _next++ );
+                _nibbles = 8;
+            }
+            uint32_t nibble = _word >> 28;
+            _word <<= 4;
+            --_nibbles;
+            value |= ( nibble & 0x7 ) << shift;
+            if( ! ( nibble & 0x8 ) )
+                return true;
+        }
+        return false;  // No value we write is this long
+    }
+};
+
+
+void encode_band( uint16_t const * p, uint16_t const * end, std::vector< uint32_t > & words )
+{
+    nibble_writer out( words );
+    int previous = 0;
+    while( p != end )
+    {
+        auto run = p;
+        while( p != end && ! *p )
+            ++p;
+        out.put( uint32_t( p - run ) );
+
+        run = p;
+        while( p != end && *p )
+            ++p;
+        out.put( uint32_t( p - run ) );
+
+        for( ; run != p; ++run )
+        {
+            int delta = int( *run ) - previous;
+            previous = *run;
+            out.put( ( uint32_t( delta ) << 1 ) ^ uint32_t( delta >> 31 ) );  // zigzag: small either way
+        }
+    }
+    out.flush();
+}
+
+
+bool decode_band( uint8_t const * data, size_t size, uint16_t * out, uint16_t * end )
+{
+    if( size % 4 )
+        return false;
+    nibble_reader in( data, size / 4 );
+    int previous = 0;
+    while( out != end )
+    {
+        uint32_t zeros, nonzeros;
+        if( ! in.get( zeros ) || zeros > size_t( end - out ) )
+            return false;
+        std::fill_n( out, zeros, uint16_t( 0 ) );
+        out += zeros;
+
+        if( ! in.get( nonzeros ) || nonzeros > size_t( end - out ) )
+            return false;
+        for( uint32_t i = 0; i < nonzeros; ++i )
+        {
+            uint32_t value;
+            if( ! in.get( value ) )
+                return false;
+            previous += int( value >> 1 ) ^ -int( value & 1 );
+            *out++ = uint16_t( previous );
+        }
+    }
+    return true;
+}
+
+
+size_t band_count( size_t count )
+{
+    return std::max< size_t >( 1, std::min( max_bands, ( count + band_pixels - 1 ) / band_pixels ) );
+}
+
+
+void run_bands( size_t n_bands, for_each_band_fn const & for_each_band, std::function< void( size_t ) > const & fn )
+{
+    if( for_each_band )
+        for_each_band( n_bands, fn );
+    else
+        for( size_t i = 0; i < n_bands; ++i )
+            fn( i );
+}
+
+
+bool read_header( uint8_t const * data, size_t size, size_t & count, size_t & n_bands )
+{
+    if( size < 8 )
+        return false;
+    count = load_le32( data );
+    n_bands = load_le32( data + 4 );
+    return n_bands && n_bands <= max_bands && size >= 4 * ( 2 + n_bands );
+}
+
+
+}  // namespace
+
+
+void encode( uint16_t const * pixels, size_t count, std::vector< uint8_t > & out, for_each_band_fn const & for_each_band )
+{
+    auto const n_bands = band_count( count );
+    std::vector< std::vector< uint32_t > > bands( n_bands );
+    run_bands( n_bands, for_each_band, [&]( size_t i ) {
+        auto begin = count * i / n_bands;
+        auto end = count * ( i + 1 ) / n_bands;
+        bands[i].reserve( ( end - begin ) / 2 );
+        encode_band( pixels + begin, pixels + end, bands[i] );
+    } );
+
+    size_t size = 4 * ( 2 + n_bands );
+    for( auto const & band : bands )
+        size += 4 * band.size();
+    out.resize( size );
+
+    auto p = out.data();
+    store_le32( p, uint32_t( count ) );
+    store_le32( p + 4, uint32_t( n_bands ) );
+    p += 8;
+    for( auto const & band : bands )
+    {
+        store_le32( p, uint32_t( 4 * band.size() ) );
+        p += 4;
+    }
+    for( auto const & band : bands )
+        for( auto word : band )
+        {
+            store_le32( p, word );
+            p += 4;
+        }
+}
+
+
+size_t decoded_count( uint8_t const * data, size_t size )
+{
+    size_t count, n_bands;
+    return read_header( data, size, count, n_bands ) ? count : 0;
+}
+
+
+bool decode( uint8_t const * data,
+             size_t size,
+             uint16_t * pixels,
+             size_t count,
+             for_each_band_fn const & for_each_band )
+{
+    size_t coded_count, n_bands;
+    if( ! read_header( data, size, coded_count, n_bands ) || coded_count != count )
+        return false;
+
+    std::vector< size_t > offsets( n_bands + 1 );
+    offsets[0] = 4 * ( 2 + n_bands );
+    for( size_t i = 0; i < n_bands; ++i )
+    {
+        offsets[i + 1] = offsets[i] + load_le32( data + 8 + 4 * i );
+        if( offsets[i + 1] > size )
+            return false;
+    }
+
+    std::vector< char > ok( n_bands, false );  // Not vector< bool >: the bands are written concurrently
+    run_bands( n_bands, for_each_band, [&]( size_t i ) {
+        ok[i] = decode_band( data + offsets[i],
+                             offsets[i + 1] - offsets[i],
+                             pixels + count * i / n_bands,
+                             pixels + count * ( i + 1 ) / n_bands );
+    } );
+    return std::all_of( ok.begin(), ok.end(), []( char b ) { return b != 0; } );
+}
+
+
+}  // namespace depth_codec
+}  // namespace rsutils
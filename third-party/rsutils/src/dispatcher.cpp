@@ -4,15 +4,19 @@
 #include <rsutils/concurrency/concurrency.h>
 #include <rsutils/easylogging/easyloggingpp.h>
 #include <rsutils/time/waiting-on.h>
+#include <rsutils/os/thread.h>
 
-dispatcher::dispatcher( unsigned int cap, std::function< void( action ) > on_drop_callback )
+dispatcher::dispatcher( unsigned int cap,
+                        std::function< void( action ) > on_drop_callback,
+                        std::string const & thread_role )
     : _queue( cap, on_drop_callback )
     , _was_stopped( true )
     , _is_alive( true )
 {
     // We keep a running thread that takes stuff off our queue and dispatches them
-    _thread = std::thread([&]()
+    _thread = std::thread([&, thread_role]()
     {
+        rsutils::os::init_thread( thread_role );
         int timeout_ms = 5000;
         while( _is_alive )
         {
@@ -17,6 +17,24 @@ json const empty_json_string = json::value_t::string;
 json const empty_json_object = json::object();
 
 
+json parse_json_or_binary( void const * data, size_t size )
+{
+    auto begin = static_cast< uint8_t const * >( data );
+    auto end = begin + size;
+    if( size )
+    {
+        uint8_t const first = *begin;
+        // CBOR: a map (major type 5), or the self-describe tag 55799 (0xd9d9f7) in front of one
+        if( ( first >= 0xa0 && first <= 0xbb ) || first == 0xbf || first == 0xd9 )
+            return json::from_cbor( begin, end );
+        // MessagePack: fixmap, map 16 or map 32
+        if( ( first >= 0x80 && first <= 0x8f ) || first == 0xde || first == 0xdf )
+            return json::from_msgpack( begin, end );
+    }
+    return json::parse( begin, end );
+}
+
+
 // Recursively patches existing JSON with contents of 'overrides', which must be a JSON object.
 // A 'null' value inside erases previous contents. Any other value overrides.
 // See: https://json.nlohmann.me/api/basic_json/merge_patch/
@@ -0,0 +1,197 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <rsutils/sparse-depth.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RSUTILS_SPARSE_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RSUTILS_SPARSE_NEON
+#endif
+
+
+namespace rsutils {
+namespace sparse_depth {
+
+
+namespace {
+
+
+void store_le16( uint8_t * p, uint32_t value )
+{
+    p[0] = uint8_t( value );
+    p[1] = uint8_t( value >> 8 );
+}
+
+
+void store_le32( uint8_t * p, uint32_t value )
+{
+    store_le16( p, value );
+    store_le16( p + 2, value >> 16 );
+}
+
+
+// Whether the 8 pixels at p are all zero, which most are in the images this is for
+inline bool all_zero8( uint16_t const * p )
+{
+#if defined( RSUTILS_SPARSE_SSE2 )
+    __m128i v = _mm_loadu_si128( reinterpret_cast< __m128i const * >( p ) );
+    return _mm_movemask_epi8( _mm_cmpeq_epi16( v, _mm_setzero_si128() ) ) == 0xFFFF;
+#elif defined( RSUTILS_SPARSE_NEON )
+    return vmaxvq_u16( vld1q_u16( p ) ) == 0;
+#else
+    uint64_t a, b;
+    memcpy( &a, p, 8 );
+    memcpy( &b, p + 4, 8 );
+    return ! ( a | b );
+#endif
+}
+
+
+// Calls fn( x ) for each valid pixel of the row, in increasing x
+template< class Fn >
+void for_each_valid( uint16_t const * row, uint32_t width, Fn && fn )
+{
+    uint32_t x = 0;
+    for( ; x + 8 <= width; x += 8 )
+    {
+        if( all_zero8( row + x ) )
+            continue;
+        for( uint32_t i = x; i < x + 8; ++i )
+            if( row[i] )
+                fn( i );
+    }
+    for( ; x < width; ++x )
+        if( row[x] )
+            fn( x );
+}
+
+
+uint16_t const * row_of( uint16_t const * pixels, size_t stride, uint32_t y )
+{
+    return reinterpret_cast< uint16_t const * >( reinterpret_cast< uint8_t const * >( pixels ) + stride * y );
+}
+
+
+}  // namespace
+
+
+size_t encoded_size( uint16_t const * pixels, uint32_t width, uint32_t height, size_t stride )
+{
+    size_t count = 0;
+    for( uint32_t y = 0; y < height; ++y )
+        for_each_valid( row_of( pixels, stride, y ), width, [&]( uint32_t ) { ++count; } );
+    return header_size + 4 * size_t( height ) + 4 * count;
+}
+
+
+size_t encode( uint16_t const * pixels, uint32_t width, uint32_t height, size_t stride, uint8_t * out )
+{
+    store_le32( out, width );
+    store_le32( out + 4, height );
+    auto ends = out + header_size;
+    // Where the pixels go doesn't depend on how many there are, so it's all in one pass
+    auto p = ends + 4 * size_t( height );
+    uint32_t count = 0;
+    for( uint32_t y = 0; y < height; ++y )
+    {
+        auto row = row_of( pixels, stride, y );
+        for_each_valid( row, width, [&]( uint32_t x )
+        {
+            store_le16( p, x );
+            store_le16( p + 2, row[x] );
+            p += 4;
+            ++count;
+        } );
+        store_le32( ends + 4 * size_t( y ), count );
+    }
+    return p - out;
+}
+
+
+void encode( uint16_t const * pixels, uint32_t width, uint32_t height, size_t stride, std::vector< uint8_t > & out )
+{
+    out.resize( encoded_size( pixels, width, height, stride ) );
+    encode( pixels, width, height, stride, out.data() );
+}
+
+
+bool decode( uint8_t const * data, size_t size, uint16_t * pixels, uint32_t width, uint32_t height )
+{
+    image im;
+    if( ! im.parse( data, size ) || im.width() != width || im.height() != height )
+        return false;
+
+    std::fill_n( pixels, size_t( width ) * height, uint16_t( 0 ) );
+    for( uint32_t y = 0; y < height; ++y )
+    {
+        auto row = pixels + size_t( width ) * y;
+        for( size_t i = im.begin( y ), end = im.end( y ); i < end; ++i )
+        {
+            auto const x = im.x( i );
+            if( x >= width )
+                return false;
+            row[x] = im.depth( i );
+        }
+    }
+    return true;
+}
+
+
+bool image::parse( uint8_t const * data, size_t size )
+{
+    _data = nullptr;
+    _width = _height = 0;
+    if( ! data || size < header_size )
+        return false;
+
+    uint32_t const width = detail::load_le32( data );
+    uint32_t const height = detail::load_le32( data + 4 );
+    if( ! width || width > 65536 || ! height || ( size - header_size ) / 4 < height )
+        return false;
+
+    _data = data;
+    _width = width;
+    _height = height;
+    size_t const room = ( size - header_size ) / 4 - height;  // for pixels
+    size_t begin = 0;
+    for( uint32_t y = 0; y < height; ++y )
+    {
+        size_t const end = this->end( y );
+        if( end < begin || end > room )
+        {
+            _data = nullptr;
+            _width = _height = 0;
+            return false;
+        }
+        begin = end;
+    }
+    return true;
+}
+
+
+uint16_t image::at( uint32_t x, uint32_t y ) const
+{
+    if( x >= _width || y >= _height )
+        return 0;
+
+    size_t lo = begin( y ), hi = end( y );
+    while( lo < hi )
+    {
+        auto mid = lo + ( hi - lo ) / 2;
+        if( this->x( mid ) < x )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo < end( y ) && this->x( lo ) == x ? depth( lo ) : 0;
+}
+
+
+}  // namespace sparse_depth
+}  // namespace rsutils
@@ -0,0 +1,209 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <rsutils/os/thread.h>
+#include <rsutils/easylogging/easyloggingpp.h>
+#include <rsutils/json.h>
+
+#include <map>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined( __linux__ )
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined( __APPLE__ )
+#include <pthread.h>
+#endif
+
+
+namespace rsutils {
+namespace os {
+
+
+namespace {
+
+
+std::mutex & roles_mutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+
+std::map< std::string, thread_settings > & roles()
+{
+    static std::map< std::string, thread_settings > the_roles;
+    return the_roles;
+}
+
+
+thread_settings parse_thread_settings( std::string const & role, rsutils::json const & j )
+{
+    thread_settings settings;
+    settings.cpus = j.nested( "cpus" ).default_value( settings.cpus );
+    auto priority = j.nested( "priority" ).default_value< std::string >( "normal" );
+    if( priority == "low" )
+        settings.priority = -1;
+    else if( priority == "high" )
+        settings.priority = 1;
+    else if( priority != "normal" )
+        LOG_WARNING( "threads: invalid priority '" << priority << "' for '" << role << "'; using 'normal'" );
+    settings.realtime_priority = j.nested( "realtime-priority" ).default_value( settings.realtime_priority );
+    if( settings.realtime_priority < 0 || settings.realtime_priority > 99 )
+    {
+        LOG_WARNING( "threads: invalid realtime-priority " << settings.realtime_priority << " for '" << role << "'" );
+        settings.realtime_priority = 0;
+    }
+    settings.name = j.nested( "name" ).default_value( settings.name );
+    return settings;
+}
+
+
+#ifdef _WIN32
+void set_thread_name( std::string const & name )
+{
+    // Only available since Windows 10 1607
+    typedef HRESULT( WINAPI * set_thread_description_fn )( HANDLE, PCWSTR );
+    static auto set_thread_description = reinterpret_cast< set_thread_description_fn >(
+        GetProcAddress( GetModuleHandleA( "kernel32.dll" ), "SetThreadDescription" ) );
+    if( set_thread_description )
+        set_thread_description( GetCurrentThread(), std::wstring( name.begin(), name.end() ).c_str() );
+}
+#elif defined( __linux__ )
+void set_thread_name( std::string const & name )
+{
+    pthread_setname_np( pthread_self(), name.substr( 0, 15 ).c_str() );
+}
+#elif defined( __APPLE__ )
+void set_thread_name( std::string const & name )
+{
+    pthread_setname_np( name.c_str() );
+}
+#else
+void set_thread_name( std::string const & ) {}
+#endif
+
+
+}  // namespace
+
+
+void configure_threads( rsutils::json const & settings )
+{
+    std::map< std::string, thread_settings > new_roles;
+    if( settings.is_object() )
+        for( auto it = settings.begin(); it != settings.end(); ++it )
+            new_roles[it.key()] = parse_thread_settings( it.key(), it.value() );
+    else
+        LOG_WARNING( "threads: expecting an object of roles; got " << settings );
+
+    std::lock_guard< std::mutex > lock( roles_mutex() );
+    roles() = std::move( new_roles );
+}
+
+
+void set_thread_settings( std::string const & role, thread_settings const & settings )
+{
+    std::lock_guard< std::mutex > lock( roles_mutex() );
+    roles()[role] = settings;
+}
+
+
+thread_settings get_thread_settings( std::string const & role )
+{
+    std::lock_guard< std::mutex > lock( roles_mutex() );
+    auto it = roles().find( role );
+    if( it == roles().end() )
+        it = roles().find( "default" );
+    if( it == roles().end() )
+        return {};
+    return it->second;
+}
+
+
+bool apply_thread_settings( thread_settings const & settings )
+{
+    bool ok = true;
+    if( ! settings.name.empty() )
+        set_thread_name( settings.name );
+
+#ifdef _WIN32
+    if( ! settings.cpus.empty() )
+    {
+        DWORD_PTR mask = 0;
+        for( int cpu : settings.cpus )
+            if( cpu >= 0 && cpu < int( sizeof( mask ) * 8 ) )
+                mask |= DWORD_PTR( 1 ) << cpu;
+        if( ! mask || ! SetThreadAffinityMask( GetCurrentThread(), mask ) )
+        {
+            LOG_WARNING( "failed to set thread affinity" );
+            ok = false;
+        }
+    }
+    // Windows has no real-time scheduling for threads; time-critical is the nearest
+    int priority = settings.realtime_priority > 0 ? THREAD_PRIORITY_TIME_CRITICAL
+                 : settings.priority < 0          ? THREAD_PRIORITY_BELOW_NORMAL
+                 : settings.priority > 0          ? THREAD_PRIORITY_ABOVE_NORMAL
+                                                  : THREAD_PRIORITY_NORMAL;
+    if( priority != THREAD_PRIORITY_NORMAL && ! SetThreadPriority( GetCurrentThread(), priority ) )
+    {
+        LOG_WARNING( "failed to set thread priority" );
+        ok = false;
+    }
+#elif defined( __linux__ )
+    if( ! settings.cpus.empty() )
+    {
+        cpu_set_t set;
+        CPU_ZERO( &set );
+        for( int cpu : settings.cpus )
+            if( cpu >= 0 && cpu < CPU_SETSIZE )
+                CPU_SET( cpu, &set );
+        if( sched_setaffinity( 0, sizeof( set ), &set ) )  // 0 = the calling thread
+        {
+            LOG_WARNING( "failed to set thread affinity" );
+            ok = false;
+        }
+    }
+    if( settings.realtime_priority > 0 )
+    {
+        sched_param param = {};
+        param.sched_priority = settings.realtime_priority;
+        if( pthread_setschedparam( pthread_self(), SCHED_FIFO, &param ) )
+        {
+            LOG_WARNING( "failed to set real-time thread priority " << settings.realtime_priority );
+            ok = false;
+        }
+    }
+    // Linux threads have a niceness of their own
+    else if( settings.priority
+             && setpriority( PRIO_PROCESS, id_t( syscall( SYS_gettid ) ), settings.priority < 0 ? 10 : -10 ) )
+    {
+        LOG_WARNING( "failed to set thread priority" );
+        ok = false;
+    }
+#else
+    if( ! settings.cpus.empty() || settings.priority || settings.realtime_priority )
+    {
+        LOG_WARNING( "thread affinity and priority are not supported on this platform" );
+        ok = false;
+    }
+#endif
+    return ok;
+}
+
+
+void init_thread( std::string const & role )
+{
+    auto settings = get_thread_settings( role );
+    if( settings.name.empty() )
+        settings.name = "rs-" + role;
+    apply_thread_settings( settings );
+}
+
+
+}  // namespace os
+}  // namespace rsutils
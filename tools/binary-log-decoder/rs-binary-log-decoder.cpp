@@ -0,0 +1,254 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// Puts the files of rs2_log_to_binary_file() into words: one line per message, as the other logs would have it.
+// See src/binary-log.h for what's in them.
+
+#include "tclap/CmdLine.h"
+
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+
+using namespace std;
+using namespace TCLAP;
+
+
+static uint32_t const supported_version = 1;
+
+
+struct site
+{
+    int severity;
+    uint32_t line;
+    string file;
+    string format;
+};
+
+
+class reader
+{
+    istream & _in;
+
+public:
+    reader( istream & in ) : _in( in ) {}
+
+    template< class T >
+    bool get( T & v )
+    {
+        return bool( _in.read( reinterpret_cast< char * >( &v ), sizeof( v ) ) );
+    }
+    bool get_string( string & s )
+    {
+        uint16_t n;
+        if( ! get( n ) )
+            return false;
+        s.resize( n );
+        return n == 0 || bool( _in.read( &s[0], n ) );
+    }
+};
+
+
+static char const * severity_name( int severity )
+{
+    switch( severity )
+    {
+    case 0: return "DEBUG";
+    case 1: return "INFO";
+    case 2: return "WARN";
+    case 3: return "ERROR";
+    case 4: return "FATAL";
+    default: return "?";
+    }
+}
+
+
+// The next argument, as the logs would show it; false when there's none left
+static bool format_argument( ostream & os, uint8_t const *& p, uint8_t const * end )
+{
+    if( p >= end )
+        return false;
+    char type = char( *p++ );
+    auto take = [&]( void * v, size_t n ) {
+        if( p + n > end )
+            return false;
+        memcpy( v, p, n );
+        p += n;
+        return true;
+    };
+    switch( type )
+    {
+    case 'i': { int64_t i; if( ! take( &i, 8 ) ) return false; os << i; break; }
+    case 'u': { uint64_t u; if( ! take( &u, 8 ) ) return false; os << u; break; }
+    case 'f': { double d; if( ! take( &d, 8 ) ) return false; os << d; break; }
+    case 'c': { char c; if( ! take( &c, 1 ) ) return false; os << c; break; }
+    case 'p': { uint64_t u; if( ! take( &u, 8 ) ) return false; os << "0x" << hex << u << dec; break; }
+    case 's':
+    {
+        uint16_t n;
+        if( ! take( &n, 2 ) || p + n > end )
+            return false;
+        os.write( reinterpret_cast< char const * >( p ), n );
+        p += n;
+        break;
+    }
+    default:
+        p = end;
+        return false;
+    }
+    return true;
+}
+
+
+static string format_message( string const & format, string const & args )
+{
+    ostringstream os;
+    auto p = reinterpret_cast< uint8_t const * >( args.data() );
+    auto end = p + args.size();
+    size_t start = 0;
+    while( true )
+    {
+        auto placeholder = format.find( "{}", start );
+        if( placeholder == string::npos )
+            break;
+        os << format.substr( start, placeholder - start );
+        if( ! format_argument( os, p, end ) )
+            os << "{?}";  // Truncated when it was recorded
+        start = placeholder + 2;
+    }
+    os << format.substr( start );
+    return os.str();
+}
+
+
+static string time_string( int64_t ns )
+{
+    time_t t = time_t( ns / 1000000000 );
+    char buffer[20] = {};
+    if( tm const * local = localtime( &t ) )
+        strftime( buffer, sizeof( buffer ), "%Y-%m-%d %H:%M:%S", local );
+    ostringstream os;
+    os << buffer << '.' << setw( 6 ) << setfill( '0' ) << ( ns % 1000000000 ) / 1000;
+    return os.str();
+}
+
+
+int main( int argc, char * argv[] ) try
+{
+    CmdLine cmd( "librealsense rs-binary-log-decoder tool", ' ' );
+    UnlabeledValueArg< string > input_arg( "input", "Binary log file, from rs2_log_to_binary_file()", true, "", "path" );
+    ValueArg< string > output_arg( "o", "output", "Text file to write to, instead of the console", false, "", "path" );
+    SwitchArg relative_arg( "r", "relative", "Show times in seconds since the log started" );
+    cmd.add( input_arg );
+    cmd.add( output_arg );
+    cmd.add( relative_arg );
+    cmd.parse( argc, argv );
+
+    ifstream file( input_arg.getValue(), ios::binary );
+    if( ! file )
+        throw runtime_error( "failed to open " + input_arg.getValue() );
+    ofstream output_file;
+    if( output_arg.isSet() )
+    {
+        output_file.open( output_arg.getValue() );
+        if( ! output_file )
+            throw runtime_error( "failed to open " + output_arg.getValue() );
+    }
+    ostream & out = output_file.is_open() ? output_file : cout;
+
+    reader in( file );
+    char magic[8];
+    uint32_t version;
+    int64_t system_ns, steady_ns;
+    if( ! in.get( magic ) || memcmp( magic, "RS2BLOG", 8 ) != 0 )
+        throw runtime_error( "not a binary log: " + input_arg.getValue() );
+    if( ! in.get( version ) || ! in.get( system_ns ) || ! in.get( steady_ns ) )
+        throw runtime_error( "truncated header" );
+    if( version > supported_version )
+        throw runtime_error( "unsupported binary log version " + to_string( version ) );
+
+    map< uint32_t, site > sites;
+    size_t messages = 0;
+    uint64_t dropped = 0;
+    bool truncated = false;
+    char kind;
+    while( in.get( kind ) )
+    {
+        if( kind == 'S' )
+        {
+            uint32_t id;
+            uint8_t severity;
+            site s;
+            if( ! in.get( id ) || ! in.get( severity ) || ! in.get( s.line ) || ! in.get_string( s.file )
+                || ! in.get_string( s.format ) )
+            {
+                truncated = true;
+                break;
+            }
+            s.severity = severity;
+            sites[id] = std::move( s );
+        }
+        else if( kind == 'M' )
+        {
+            uint32_t id, thread;
+            int64_t ns;
+            string args;
+            if( ! in.get( id ) || ! in.get( ns ) || ! in.get( thread ) || ! in.get_string( args ) )
+            {
+                truncated = true;
+                break;
+            }
+            auto it = sites.find( id );
+            if( it == sites.end() )
+                throw runtime_error( "message from unknown site " + to_string( id ) );
+            site const & s = it->second;
+
+            // Messages are timed with the steady clock: the header tells what it was at a known system time
+            int64_t since_start = ns - steady_ns;
+            if( relative_arg.getValue() )
+                out << fixed << setprecision( 6 ) << setw( 14 ) << since_start / 1e9;
+            else
+                out << time_string( system_ns + since_start );
+            auto slash = s.file.find_last_of( "/\\" );
+            out << " [" << hex << setw( 8 ) << setfill( '0' ) << thread << dec << setfill( ' ' ) << "] "
+                << setw( 5 ) << left << severity_name( s.severity ) << right << " ("
+                << ( slash == string::npos ? s.file : s.file.substr( slash + 1 ) ) << ':' << s.line << ") "
+                << format_message( s.format, args ) << '\n';
+            ++messages;
+        }
+        else if( kind == 'D' )
+        {
+            uint64_t count;
+            if( ! in.get( count ) )
+            {
+                truncated = true;
+                break;
+            }
+            out << "... " << count << " messages lost: the log could not keep up\n";
+            dropped += count;
+        }
+        else
+            throw runtime_error( string( "unknown record '" ) + kind + "'" );
+    }
+    out.flush();
+
+    cerr << messages << " messages";
+    if( dropped )
+        cerr << ", " << dropped << " lost";
+    if( truncated )
+        cerr << " (the file ends mid-record)";
+    cerr << endl;
+    return EXIT_SUCCESS;
+}
+catch( const exception & e )
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
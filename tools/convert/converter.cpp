@@ -2,17 +2,16 @@
 // Copyright(c) 2021 Intel Corporation. All Rights Reserved.
 
 #include <fstream>
+#include <iostream>
 #include "converter.hpp"
 
 using namespace rs2::tools::converter;
 
-void rs2::tools::converter::metadata_to_txtfile(const rs2::frame& frm, const std::string& filename)
+std::string rs2::tools::converter::metadata_to_string(const rs2::frame& frm)
 {
-    std::ofstream file;
-
-    file.open(filename);
+    std::stringstream text;
 
-    file << "Stream: " << rs2_stream_to_string(frm.get_profile().stream_type()) << "\n";
+    text << "Stream: " << rs2_stream_to_string(frm.get_profile().stream_type()) << "\n";
 
     // Record all the available metadata attributes
     for (size_t i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
@@ -20,16 +19,116 @@ void rs2::tools::converter::metadata_to_txtfile(const rs2::frame& frm, const std
         rs2_frame_metadata_value metadata_val = (rs2_frame_metadata_value)i;
         if (frm.supports_frame_metadata(metadata_val))
         {
-            file << rs2_frame_metadata_to_string(metadata_val) << ": "
+            text << rs2_frame_metadata_to_string(metadata_val) << ": "
                 << frm.get_frame_metadata(metadata_val) << "\n";
         }
     }
 
-    file.close();
+    return text.str();
+}
+
+void rs2::tools::converter::string_to_txtfile(const std::string& text, const std::string& filename)
+{
+    std::ofstream file(filename);
+    file << text;
+}
+
+void rs2::tools::converter::metadata_to_txtfile(const rs2::frame& frm, const std::string& filename)
+{
+    string_to_txtfile(metadata_to_string(frm), filename);
+}
+
+std::shared_ptr<std::vector<float>> rs2::tools::converter::get_distances(const rs2::depth_frame& frame)
+{
+    auto width = frame.get_width();
+    auto height = frame.get_height();
+    auto distances = std::make_shared<std::vector<float>>(size_t(width) * height);
+    auto out = distances->data();
+
+    if (frame.get_profile().format() == RS2_FORMAT_Z16)
+    {
+        // What get_distance() does, without a call per pixel
+        auto units = frame.get_units();
+        auto depth = static_cast<const uint16_t*>(frame.get_data());
+        for (size_t i = 0; i < distances->size(); i++)
+            out[i] = depth[i] * units;
+    }
+    else
+    {
+        for (int y = 0; y < height; y++)
+            for (int x = 0; x < width; x++)
+                *out++ = frame.get_distance(x, y);
+    }
+
+    return distances;
+}
+
+worker_pool::worker_pool(size_t n_workers)
+    : _stopping(false)
+{
+    for (size_t i = 0; i < n_workers; i++)
+        _workers.emplace_back([this] { work(); });
+}
+
+worker_pool::~worker_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _cv.notify_all();
+    for_each(_workers.begin(), _workers.end(),
+        [](std::thread& t) {
+            t.join();
+        });
+}
+
+void worker_pool::submit(std::function<void()> task)
+{
+    if (_workers.empty())
+    {
+        task();
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this] { return _tasks.size() < _workers.size(); });
+        _tasks.push_back(std::move(task));
+    }
+    _cv.notify_all();
+}
+
+void worker_pool::work()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+            if (_tasks.empty())
+                return;
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        _cv.notify_all();  // there's room for another
+
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to convert a frame: " << e.what() << std::endl;
+        }
+    }
 }
 
 bool converter_base::frames_map_get_and_set(rs2_stream streamType, frame_number_t frameNumber)
 {
+    std::lock_guard<std::mutex> lock(_mutex);
+
     if (_framesMap.find(streamType) == _framesMap.end()) {
         _framesMap.emplace(streamType, std::unordered_set<frame_number_t>());
     }
@@ -44,23 +143,46 @@ bool converter_base::frames_map_get_and_set(rs2_stream streamType, frame_number_
     return result;
 }
 
-void converter_base::wait_sub_workers()
+void converter_base::start_worker(std::function<void()> f)
 {
-    for_each(_subWorkers.begin(), _subWorkers.end(),
-        [](std::thread& t) {
-            t.join();
-        });
+    if (!_pool)
+    {
+        f();
+        return;
+    }
 
-    _subWorkers.clear();
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this] { return !_max_in_flight || _in_flight < _max_in_flight; });
+        ++_in_flight;
+    }
+    _pool->submit([this, f] {
+        struct done_guard
+        {
+            converter_base* self;
+            ~done_guard()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(self->_mutex);
+                    --self->_in_flight;
+                }
+                self->_cv.notify_all();
+            }
+        } done{ this };
+        f();
+    });
 }
 
 void converter_base::wait()
 {
-    _worker.join();
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait(lock, [this] { return _in_flight == 0; });
 }
 
 std::string converter_base::get_statistics()
 {
+    std::lock_guard<std::mutex> lock(_mutex);
+
     std::stringstream result;
     result << name() << '\n';
 
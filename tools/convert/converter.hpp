@@ -6,10 +6,17 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <string>
 #include <sstream>
 #include <algorithm>
+#include <iomanip>
+#include <vector>
 
 #include "librealsense2/rs.hpp"
 
@@ -19,36 +26,62 @@ namespace rs2 {
         namespace converter {
 
             void metadata_to_txtfile(const rs2::frame& frm, const std::string& filename);
+            std::string metadata_to_string(const rs2::frame& frm);
+            void string_to_txtfile(const std::string& text, const std::string& filename);
+
+            // The distance of every pixel of a depth frame, row after row
+            std::shared_ptr<std::vector<float>> get_distances(const rs2::depth_frame& frame);
 
             typedef unsigned long long frame_number_t;
 
+            // Threads shared by the converters for encoding and writing out frames. Submitting blocks while there
+            // are as many tasks waiting as there are workers, so frames don't pile up faster than they're written.
+            class worker_pool {
+                std::vector<std::thread> _workers;
+                std::deque<std::function<void()>> _tasks;
+                std::mutex _mutex;
+                std::condition_variable _cv;
+                bool _stopping;
+
+                void work();
+
+            public:
+                explicit worker_pool(size_t n_workers);
+                ~worker_pool();  // after running whatever is still waiting
+
+                void submit(std::function<void()> task);
+            };
+
             class converter_base {
             protected:
-                std::thread _worker;
-                std::vector<std::thread> _subWorkers;
                 std::unordered_map<int, std::unordered_set<frame_number_t>> _framesMap;
+                std::shared_ptr<worker_pool> _pool;
+                size_t _max_in_flight;  // tasks of ours, queued or running; 0 for as many as the pool takes
+                size_t _in_flight;
+                std::mutex _mutex;
+                std::condition_variable _cv;
 
             protected:
                 bool frames_map_get_and_set(rs2_stream streamType, frame_number_t frameNumber);
-                void wait_sub_workers();
-
-                template <typename F> void start_worker(const F& f)
-                {
-                    _worker = std::thread(f);
-                }
 
-                template <typename F> void add_sub_worker(const F& f)
-                {
-                    _subWorkers.emplace_back(f);
-                }
+                // Runs f on the pool, or right away without one. Tasks of a converter may run in any order, and
+                // concurrently: f must only use what it captured by value.
+                void start_worker(std::function<void()> f);
 
             public:
+                converter_base() : _max_in_flight(0), _in_flight(0) {}
+                virtual ~converter_base() = default;
+
+                void set_worker_pool(std::shared_ptr<worker_pool> pool) { _pool = pool; }
+
+                // Frames are given one at a time, in order
                 virtual void convert(rs2::frame& frame) = 0;
                 virtual std::string name() const = 0;
 
                 virtual std::string get_statistics();
 
-                void wait();
+                void wait();  // until all frames given so far are converted
+                virtual void finish() { wait(); }  // once there are no more frames
             };
 
         }
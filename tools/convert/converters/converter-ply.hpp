@@ -20,6 +20,8 @@ namespace rs2 {
                 converter_ply(const std::string& filePath)
                     : _filePath(filePath)
                 {
+                    // Each task holds on to a frameset until it's written, and the playback only has so many frames
+                    _max_in_flight = 8;
                 }
 
                 std::string name() const override
@@ -29,36 +31,42 @@ namespace rs2 {
 
                 void convert(rs2::frame& frame) override
                 {
-                    rs2::pointcloud pc;
-                    start_worker(
-                        [this, &frame, pc]() mutable {
-                            auto frameset = frame.as<rs2::frameset>();
-                            auto frameDepth = frameset.get_depth_frame();
-                            auto frameColor = frameset.get_color_frame();
+                    auto frameset = frame.as<rs2::frameset>();
+                    auto frameDepth = frameset.get_depth_frame();
+                    auto frameColor = frameset.get_color_frame();
+
+                    if (!frameDepth || !frameColor) {
+                        return;
+                    }
 
-                            if (frameDepth && frameColor) {
-                                if (frames_map_get_and_set(rs2_stream::RS2_STREAM_ANY, frameDepth.get_frame_number())) {
-                                    return;
-                                }
+                    if (frames_map_get_and_set(rs2_stream::RS2_STREAM_ANY, frameDepth.get_frame_number())) {
+                        return;
+                    }
 
-                                pc.map_to(frameColor);
+                    std::stringstream filename;
+                    filename << _filePath
+                        << "_" << std::setprecision(14) << std::fixed << frameDepth.get_timestamp()
+                        << ".ply";
 
-                                auto points = pc.calculate(frameDepth);
+                    std::stringstream metadata_file;
+                    metadata_file << _filePath
+                        << "_metadata_" << std::setprecision(14) << std::fixed << frameDepth.get_timestamp()
+                        << ".txt";
 
-                                std::stringstream filename;
-                                filename << _filePath
-                                    << "_" << std::setprecision(14) << std::fixed << frameDepth.get_timestamp()
-                                    << ".ply";
+                    std::string filenameS = filename.str();
+                    std::string metadataS = metadata_file.str();
+                    std::string metadata = metadata_to_string(frameDepth);
 
-                                points.export_to_ply(filename.str(), frameColor);
+                    start_worker(
+                        [filenameS, metadataS, metadata, frameDepth, frameColor]() {
+                            // A point cloud of its own, as tasks run concurrently
+                            rs2::pointcloud pc;
+                            pc.map_to(frameColor);
 
-                                std::stringstream metadata_file;
-                                metadata_file << _filePath
-                                    << "_metadata_" << std::setprecision(14) << std::fixed << frameDepth.get_timestamp()
-                                    << ".txt";
+                            auto points = pc.calculate(frameDepth);
+                            points.export_to_ply(filenameS, frameColor);
 
-                                metadata_to_txtfile(frameDepth, metadata_file.str());
-                            }
+                            string_to_txtfile(metadata, metadataS);
                     });
                 }
             };
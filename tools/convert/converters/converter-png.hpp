@@ -45,44 +45,38 @@ namespace rs2 {
                         return;
                     }
 
+                    // Colorizing goes in order, here; the rest works off copies, so the frame goes back right away
+                    if (videoframe.get_profile().stream_type() == rs2_stream::RS2_STREAM_DEPTH) {
+                        videoframe = _colorizer.process(videoframe);
+                    }
+
+                    std::stringstream filename;
+                    filename << _filePath
+                        << "_" << videoframe.get_profile().stream_name()
+                        << "_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
+                        << ".png";
+
+                    std::stringstream metadata_file;
+                    metadata_file << _filePath
+                        << "_" << videoframe.get_profile().stream_name()
+                        << "_metadata_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
+                        << ".txt";
+
+                    std::string filenameS = filename.str();
+                    std::string metadataS = metadata_file.str();
+                    std::string metadata = metadata_to_string(videoframe);
+
+                    int width = videoframe.get_width();
+                    int height = videoframe.get_height();
+                    int bpp = videoframe.get_bytes_per_pixel();
+                    int stride = videoframe.get_stride_in_bytes();
+                    auto data = static_cast<const uint8_t*>(videoframe.get_data());
+                    auto pixels = std::make_shared<std::vector<uint8_t>>(data, data + size_t(stride) * height);
+
                     start_worker(
-                        [this, &frame] {
-                            rs2::video_frame videoframe = frame.as<rs2::video_frame>();
-
-                            if (videoframe.get_profile().stream_type() == rs2_stream::RS2_STREAM_DEPTH) {
-                                videoframe = _colorizer.process(videoframe);
-                            }
-
-                            std::stringstream filename;
-                            filename << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".png";
-
-                            std::stringstream metadata_file;
-                            metadata_file << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_metadata_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".txt";
-
-                            std::string filenameS = filename.str();
-                            std::string metadataS = metadata_file.str();
-
-                            add_sub_worker(
-                                [filenameS, metadataS, videoframe] {
-                                    stbi_write_png(
-                                        filenameS.c_str()
-                                        , videoframe.get_width()
-                                        , videoframe.get_height()
-                                        , videoframe.get_bytes_per_pixel()
-                                        , videoframe.get_data()
-                                        , videoframe.get_stride_in_bytes()
-                                    );
-
-                                    metadata_to_txtfile(videoframe, metadataS);
-                            });
-
-                            wait_sub_workers();
+                        [filenameS, metadataS, metadata, width, height, bpp, stride, pixels] {
+                            stbi_write_png(filenameS.c_str(), width, height, bpp, pixels->data(), stride);
+                            string_to_txtfile(metadata, metadataS);
                     });
                 }
             };
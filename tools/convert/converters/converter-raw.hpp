@@ -42,41 +42,36 @@ namespace rs2 {
                         return;
                     }
 
-                    start_worker(
-                        [this, &frame] {
-                            rs2::video_frame videoframe = frame.as<rs2::video_frame>();
-
-                            std::stringstream filename;
-                            filename << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".raw";
-
-                            std::stringstream metadata_file;
-                            metadata_file << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_metadata_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".txt";
-
-                            std::string filenameS = filename.str();
-                            std::string metadataS = metadata_file.str();
+                    std::stringstream filename;
+                    filename << _filePath
+                        << "_" << videoframe.get_profile().stream_name()
+                        << "_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
+                        << ".raw";
+
+                    std::stringstream metadata_file;
+                    metadata_file << _filePath
+                        << "_" << videoframe.get_profile().stream_name()
+                        << "_metadata_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
+                        << ".txt";
+
+                    std::string filenameS = filename.str();
+                    std::string metadataS = metadata_file.str();
+                    std::string metadata = metadata_to_string(videoframe);
+
+                    auto data = static_cast<const char*>(videoframe.get_data());
+                    auto pixels = std::make_shared<std::vector<char>>(
+                        data, data + size_t(videoframe.get_stride_in_bytes()) * videoframe.get_height());
 
-                            add_sub_worker(
-                                [filenameS, metadataS, videoframe] {
-                                    std::ofstream fs(filenameS, std::ios::binary | std::ios::trunc);
-
-                                    if (fs) {
-                                        fs.write(
-                                            static_cast<const char *>(videoframe.get_data())
-                                            , videoframe.get_stride_in_bytes() * videoframe.get_height());
-
-                                        fs.flush();
-                                    }
+                    start_worker(
+                        [filenameS, metadataS, metadata, pixels] {
+                            std::ofstream fs(filenameS, std::ios::binary | std::ios::trunc);
 
-                                    metadata_to_txtfile(videoframe, metadataS);
-                            });
+                            if (fs) {
+                                fs.write(pixels->data(), pixels->size());
+                                fs.flush();
+                            }
 
-                            wait_sub_workers();
+                            string_to_txtfile(metadata, metadataS);
                     });
                 }
             };
@@ -43,6 +43,7 @@ int main(int argc, char** argv) try
     ValueArg <string> frameNumberEnd("t", "last-framenumber", "ignore frames whose frame number is greater than this value", false, "", "last-framenumber");
     ValueArg <string> startTime("s", "start-time", "ignore frames whose timestamp is less than this value (the first frame is at time 0)", false, "", "start-time");
     ValueArg <string> endTime("e", "end-time", "ignore frames whose timestamp is greater than this value (the first frame is at time 0)", false, "", "end-time");
+    ValueArg <int> jobs("j", "jobs", "number of threads converting frames (0 - on the reading thread, default - one per hardware thread)", false, 0, "jobs");
 
 
     cmd.add(inputFilename);
@@ -50,6 +51,7 @@ int main(int argc, char** argv) try
     cmd.add(frameNumberStart);
     cmd.add(endTime);
     cmd.add(startTime);
+    cmd.add(jobs);
     cmd.add(outputFilenamePng);
     cmd.add(outputFilenameCsv);
     cmd.add(outputFilenameRaw);
@@ -108,6 +110,14 @@ int main(int argc, char** argv) try
         throw runtime_error("output not defined");
     }
 
+    // Frames are handed out in order; encoding and writing them out is spread over the workers
+    auto n_workers = jobs.isSet() ? jobs.getValue() : int(thread::hardware_concurrency());
+    auto pool = make_shared<rs2::tools::converter::worker_pool>(size_t(max(n_workers, 0)));
+    for (auto& converter : converters)
+    {
+        converter->set_worker_pool(pool);
+    }
+
     unsigned long long first_frame = 0;
     unsigned long long last_frame = 0;
     uint64_t start_time = 0;
@@ -142,6 +152,7 @@ int main(int argc, char** argv) try
 
         plyconverter = make_shared<rs2::tools::converter::converter_ply>(
             outputFilenamePly.getValue());
+        plyconverter->set_worker_pool(pool);
 
         rs2::config cfg;
         cfg.enable_device_from_file(inputFilename.getValue());
@@ -184,7 +195,6 @@ int main(int argc, char** argv) try
             if( process_frame )
             {
                 plyconverter->convert(frameset);
-                plyconverter->wait();
             }
 
             auto posNext = playback.get_position();
@@ -195,6 +205,8 @@ int main(int argc, char** argv) try
 
             posCurr = posNext;
         }
+
+        plyconverter->finish();
     }
 
     // for every converter other than ply,
@@ -239,11 +251,6 @@ int main(int argc, char** argv) try
                     [&frame](shared_ptr<rs2::tools::converter::converter_base>& converter) {
                     converter->convert(frame);
                 });
-
-                for_each(converters.begin(), converters.end(),
-                    [](shared_ptr<rs2::tools::converter::converter_base>& converter) {
-                    converter->wait();
-                });
             });
 
         }
@@ -270,6 +277,11 @@ int main(int argc, char** argv) try
             posCurr = posNext;
         }
 
+        for_each(converters.begin(), converters.end(),
+            [](shared_ptr<rs2::tools::converter::converter_base>& converter) {
+            converter->finish();
+        });
+
         for (auto sensor : sensors)
         {
             if (!sensor.get_stream_profiles().size())
@@ -13,6 +13,16 @@
 #include <regex>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 using namespace TCLAP;
@@ -113,16 +123,19 @@ void data_collector::save_data_to_file(const string& out_filename)
         << "] frames recorded per stream\nSerializing captured results to "
         << out_filename << std::endl;
 
+    write_csv(out_filename, configuration_description(), data_collection);
+}
+
+void data_collector::write_csv(const string& out_filename, const string& configuration, const stream_records& data)
+{
     // Serialize and store data into csv-like format
     ofstream csv(out_filename);
     if (!csv.is_open())
         throw runtime_error(stringify() << "Cannot open the requested output file " << out_filename << ", please check permissions");
 
-    csv << "Configuration:\nStream Type,Stream Name,Format,FPS,Width,Height\n";
-    for (const auto& elem : selected_stream_profiles)
-        csv << get_profile_description(elem);
+    csv << "Configuration:\nStream Type,Stream Name,Format,FPS,Width,Height\n" << configuration;
 
-    for (const auto& elem : data_collection)
+    for (const auto& elem : data)
     {
         csv << "\n\nStream Type,Index,F#,HW Timestamp (ms),Host Timestamp(ms)"
             << (val_in_range(elem.first.first, { RS2_STREAM_GYRO,RS2_STREAM_ACCEL }) ? ",3DOF_x,3DOF_y,3DOF_z" : "")
@@ -134,9 +147,90 @@ void data_collector::save_data_to_file(const string& out_filename)
     }
 }
 
+std::string data_collector::configuration_description() const
+{
+    std::string configuration;
+    for (const auto& elem : selected_stream_profiles)
+        configuration += get_profile_description(elem);
+    return configuration;
+}
+
+int data_collector::profile_position(rs2_stream type, int index) const
+{
+    for (size_t i = 0; i < selected_stream_profiles.size(); ++i)
+        if (selected_stream_profiles[i].stream_type() == type && selected_stream_profiles[i].stream_index() == index)
+            return int(i);
+    return -1;
+}
+
+void data_collector::open_binary_log(const string& out_filename)
+{
+    // Room for what the stopping conditions let in, with a margin for the rates the devices actually keep
+    uint64_t capacity = 0;
+    for (auto&& profile : selected_stream_profiles)
+    {
+        uint64_t frames = _max_frames;
+        if (_time_out_sec > 0)
+            frames = std::min<uint64_t>(frames, uint64_t(profile.fps()) * (_time_out_sec + 2));
+        capacity += frames + frames / 4 + 16;
+    }
+
+    _log_counts.reset(new std::atomic<uint64_t>[selected_stream_profiles.size()]);
+    for (size_t i = 0; i < selected_stream_profiles.size(); ++i)
+        _log_counts[i] = 0;
+
+    std::string configuration = configuration_description();
+    if (configuration.size() >= LOG_CONFIGURATION_SIZE)
+        configuration.resize(LOG_CONFIGURATION_SIZE - 1);
+    _log.reset(new binary_log(out_filename, capacity, configuration));
+}
+
+void data_collector::close_binary_log()
+{
+    if (!_log)
+        return;
+
+    std::cout << "\nData collection accomplished with " << _log->written() << " frames recorded into the binary log";
+    if (_log->dropped())
+        std::cout << "; " << _log->dropped() << " more found the file full";
+    std::cout << std::endl;
+    _log.reset();
+}
+
 void data_collector::collect_frame_attributes(rs2::frame f, std::chrono::time_point<std::chrono::high_resolution_clock> start_time)
 {
     auto arrival_time = std::chrono::duration<double, std::milli>(chrono::high_resolution_clock::now() - start_time);
+
+    if (_log)
+    {
+        auto profile = f.get_profile();
+        int pos = profile_position(profile.stream_type(), profile.stream_index());
+        if (pos < 0 || _log_counts[pos].fetch_add(1) >= _max_frames)
+            return;
+
+        log_record rec = {};
+        rec.stream_type = uint8_t(profile.stream_type());
+        rec.stream_index = uint8_t(profile.stream_index());
+        rec.domain = uint8_t(f.get_frame_timestamp_domain());
+        rec.frame_number = f.get_frame_number();
+        rec.ts = f.get_timestamp();
+        rec.arrival_time = arrival_time.count();
+        if (auto motion = f.as<rs2::motion_frame>())
+        {
+            auto axes = motion.get_motion_data();
+            rec.params[0] = axes.x; rec.params[1] = axes.y; rec.params[2] = axes.z;
+        }
+        if (auto pf = f.as<rs2::pose_frame>())
+        {
+            auto pose = pf.get_pose_data();
+            double params[7] = { pose.translation.x, pose.translation.y, pose.translation.z,
+                    pose.rotation.x, pose.rotation.y, pose.rotation.z, pose.rotation.w };
+            std::copy(params, params + 7, rec.params);
+        }
+        _log->append(rec);
+        return;
+    }
+
     auto stream_uid = std::make_pair(f.get_profile().stream_type(), f.get_profile().stream_index());
 
     if (data_collection[stream_uid].size() < _max_frames)
@@ -178,17 +272,26 @@ bool data_collector::collecting(std::chrono::time_point<std::chrono::high_resolu
             return !timed_out;
     }
 
+    // Streams that haven't produced a frame yet aren't waited for, once any has
+    bool any_frames = false;
     bool collected_enough_frames = true;
-    for (auto&& profile : selected_stream_profiles)
+    for (size_t i = 0; i < selected_stream_profiles.size(); ++i)
     {
-        auto key = std::make_pair(profile.stream_type(), profile.stream_index());
-        if (!data_collection.size() || (data_collection.find(key) != data_collection.end() &&
-            (data_collection[key].size() && data_collection[key].size() < _max_frames)))
+        uint64_t frames = 0;
+        if (_log)
+            frames = _log_counts[i];
+        else
         {
-            collected_enough_frames = false;
-            break;
+            auto it = data_collection.find(std::make_pair(selected_stream_profiles[i].stream_type(),
+                                                          selected_stream_profiles[i].stream_index()));
+            if (it != data_collection.end())
+                frames = it->second.size();
         }
+        any_frames = any_frames || frames;
+        if (frames && frames < _max_frames)
+            collected_enough_frames = false;
     }
+    collected_enough_frames = collected_enough_frames && any_frames;
 
     return !(timed_out || collected_enough_frames);
 
@@ -281,6 +384,149 @@ bool data_collector::configure_sensors()
     return succeed;
 }
 
+binary_log::binary_log(const std::string& filename, uint64_t capacity, const std::string& configuration)
+    : _filename(filename), _capacity(capacity), _next(0), _dropped(0)
+    , _header(nullptr), _records(nullptr), _file(nullptr), _mapping(nullptr)
+{
+    const uint64_t size = sizeof(log_header) + capacity * sizeof(log_record);
+    void* data = nullptr;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw runtime_error(stringify() << "Cannot open the requested output file " << filename << ", please check permissions");
+    _file = file;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, DWORD(size >> 32), DWORD(size), nullptr);
+    if (mapping)
+    {
+        _mapping = mapping;
+        data = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, SIZE_T(size));
+    }
+#else
+    int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw runtime_error(stringify() << "Cannot open the requested output file " << filename << ", please check permissions");
+    _file = reinterpret_cast<void*>(intptr_t(fd));
+    if (!ftruncate(fd, off_t(size)))
+    {
+        data = mmap(nullptr, size_t(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED)
+            data = nullptr;
+    }
+#endif
+    if (!data)
+    {
+        close_file();
+        throw runtime_error(stringify() << "Cannot map " << size << " bytes of " << filename);
+    }
+
+    _header = static_cast<log_header*>(data);
+    _records = reinterpret_cast<log_record*>(_header + 1);
+    memcpy(_header->magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+    _header->record_size = sizeof(log_record);
+    _header->capacity = capacity;
+    strncpy(_header->configuration, configuration.c_str(), LOG_CONFIGURATION_SIZE - 1);
+}
+
+binary_log::~binary_log()
+{
+    close_file();
+}
+
+void binary_log::close_file()
+{
+    const uint64_t count = written();
+    if (_header)
+    {
+        _header->count = count;
+        _header->dropped = _dropped;
+    }
+    const uint64_t size = sizeof(log_header) + count * sizeof(log_record);
+#ifdef _WIN32
+    if (_header)
+        UnmapViewOfFile(_header);
+    if (_mapping)
+        CloseHandle(_mapping);
+    if (_file)
+    {
+        LARGE_INTEGER end;
+        end.QuadPart = LONGLONG(size);
+        if (_header && SetFilePointerEx(_file, end, nullptr, FILE_BEGIN))
+            SetEndOfFile(_file);
+        CloseHandle(_file);
+    }
+#else
+    if (_header)
+        munmap(_header, size_t(sizeof(log_header) + _capacity * sizeof(log_record)));
+    if (_file)
+    {
+        int fd = int(reinterpret_cast<intptr_t>(_file));
+        if (_header && ftruncate(fd, off_t(size)))
+            std::cerr << "Failed to trim " << _filename << std::endl;
+        close(fd);
+    }
+#endif
+    _header = nullptr;
+    _file = _mapping = nullptr;
+}
+
+void binary_log::append(const log_record& rec)
+{
+    uint64_t slot = _next.fetch_add(1);
+    if (slot >= _capacity)
+    {
+        ++_dropped;
+        return;
+    }
+    _records[slot] = rec;
+}
+
+void binary_log::convert(const std::string& log_filename, const std::string& csv_filename)
+{
+    ifstream log(log_filename, ios::binary);
+    if (!log.is_open())
+        throw runtime_error(stringify() << "Cannot open " << log_filename);
+
+    std::unique_ptr<log_header> header(new log_header);
+    if (!log.read(reinterpret_cast<char*>(header.get()), sizeof(log_header))
+        || memcmp(header->magic, LOG_MAGIC, sizeof(LOG_MAGIC)) || header->record_size != sizeof(log_record))
+        throw runtime_error(stringify() << log_filename << " is not a binary log of rs-data-collect");
+    header->configuration[LOG_CONFIGURATION_SIZE - 1] = 0;
+
+    // A log that wasn't closed (e.g., the tool was killed) has no count: it's read to the end, without the slots
+    // that were never written
+    data_collector::stream_records data;
+    uint64_t records = 0;
+    log_record rec;
+    while ((!header->count || records < header->count) && log.read(reinterpret_cast<char*>(&rec), sizeof(rec)))
+    {
+        ++records;
+        if (rec.stream_type == RS2_STREAM_ANY)
+            continue;
+        auto type = rs2_stream(rec.stream_type);
+        data_collector::frame_record fr{ rec.frame_number, rec.ts, rec.arrival_time, rs2_timestamp_domain(rec.domain),
+            type, rec.stream_index,
+            rec.params[0], rec.params[1], rec.params[2], rec.params[3], rec.params[4], rec.params[5], rec.params[6] };
+        data[std::make_pair(type, int(rec.stream_index))].emplace_back(fr);
+    }
+
+    std::cout << "Converting " << records << " records of " << log_filename << " to " << csv_filename;
+    if (header->dropped)
+        std::cout << " (" << header->dropped << " frames were dropped for the file being full)";
+    std::cout << std::endl;
+    data_collector::write_csv(csv_filename, header->configuration, data);
+}
+
+// The file of a device when collecting from several: <name>_<serial>.<ext>
+static std::string device_file_name(const std::string& filename, const rs2::device& dev)
+{
+    std::string serial = dev.supports(RS2_CAMERA_INFO_SERIAL_NUMBER) ? dev.get_info(RS2_CAMERA_INFO_SERIAL_NUMBER) : "";
+    auto dot = filename.find_last_of('.');
+    auto slash = filename.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return filename + "_" + serial;
+    return filename.substr(0, dot) + "_" + serial + filename.substr(dot);
+}
+
 int main(int argc, char** argv) try
 {
 
@@ -294,20 +540,40 @@ int main(int argc, char** argv) try
     ValueArg<int>    max_frames("m", "MaxFrames_Number", "Maximum number of frames-per-stream to receive", false, 100, "");
     ValueArg<string> out_file("f", "FullFilePath", "the file where the data will be saved to", false, "", "");
     ValueArg<string> config_file("c", "ConfigurationFile", "Specify file path with the requested configuration", false, "", "");
+    SwitchArg        binary("b", "Binary", "Stream fixed-size records into a memory-mapped binary file as the frames arrive, rather than write a csv at the end");
+    SwitchArg        all_devices("a", "AllDevices", "Collect from all the connected devices, each into its own file, named after its serial number");
+    ValueArg<string> convert("x", "Convert", "Convert a binary file of -b into csv, to the file of -f (or the same name, .csv), and exit", false, "", "");
 
     cmd.add(timeout);
     cmd.add(max_frames);
     cmd.add(out_file);
     cmd.add(config_file);
+    cmd.add(binary);
+    cmd.add(all_devices);
+    cmd.add(convert);
     cmd.parse(argc, argv);
 
+    if (convert.isSet())
+    {
+        std::string csv_file = out_file.getValue();
+        if (!out_file.isSet())
+        {
+            csv_file = convert.getValue();
+            auto dot = csv_file.find_last_of('.');
+            csv_file = (dot == std::string::npos ? csv_file : csv_file.substr(0, dot)) + ".csv";
+        }
+        binary_log::convert(convert.getValue(), csv_file);
+        return EXIT_SUCCESS;
+    }
+
     std::cout << "Running rs-data-collect: ";
     for (auto i=1; i < argc; ++i)
         std::cout << argv[i] << " ";
     std::cout << std::endl << std::endl;
 
-    auto output_file       = out_file.isSet() ? out_file.getValue() : DEF_OUTPUT_FILE_NAME;
+    auto output_file       = out_file.isSet() ? out_file.getValue() : binary.getValue() ? DEF_BINARY_FILE_NAME : DEF_OUTPUT_FILE_NAME;
 
+    if (!binary.getValue() && !all_devices.getValue())
     {
         ofstream csv(output_file);
         if (!csv.is_open())
@@ -329,25 +595,43 @@ int main(int argc, char** argv) try
             continue;
         }
 
-        auto dev = std::make_shared<rs2::device>(list.front());
-
-        data_collector  dc(dev,timeout,max_frames);         // Parser and the data aggregator
-
-        dc.parse_and_configure(config_file);
+        // Parsers and data aggregators, one per device, that share nothing
+        std::vector<std::unique_ptr<data_collector>> collectors;
+        std::vector<std::string> output_files;
+        for (uint32_t i = 0; i < (all_devices.getValue() ? list.size() : 1); ++i)
+        {
+            auto dev = std::make_shared<rs2::device>(list[i]);
+            collectors.emplace_back(new data_collector(dev, timeout, max_frames));
+            collectors.back()->parse_and_configure(config_file);
+            output_files.push_back(all_devices.getValue() ? device_file_name(output_file, *dev) : output_file);
+            if (binary.getValue())
+                collectors.back()->open_binary_log(output_files.back());
+        }
 
         //data_collection buffer;
         auto start_time = chrono::high_resolution_clock::now();
 
         // Start streaming
-        for (auto&& sensor : dc.selected_sensors())
-            sensor.start([&dc,&start_time](rs2::frame f)
-        {
-            dc.collect_frame_attributes(f,start_time);
-        });
+        for (auto&& dc : collectors)
+            for (auto&& sensor : dc->selected_sensors())
+            {
+                auto collector = dc.get();
+                sensor.start([collector,&start_time](rs2::frame f)
+                {
+                    collector->collect_frame_attributes(f,start_time);
+                });
+            }
 
         std::cout << "\nData collection started.... \n" << std::endl;
 
-        while (dc.collecting(start_time))
+        auto collecting = [&]()
+        {
+            bool any = false;
+            for (auto&& dc : collectors)
+                any = dc->collecting(start_time) || any;
+            return any;
+        };
+        while (collecting())
         {
             std::this_thread::sleep_for(std::chrono::seconds(1));
             std::cout << "Collecting data for "
@@ -356,14 +640,21 @@ int main(int argc, char** argv) try
         }
 
         // Stop & flush all active sensors
-        for (auto&& sensor : dc.selected_sensors())
+        for (auto&& dc : collectors)
+            for (auto&& sensor : dc->selected_sensors())
+            {
+                sensor.stop();
+                sensor.close();
+            }
+
+        for (size_t i = 0; i < collectors.size(); ++i)
         {
-            sensor.stop();
-            sensor.close();
+            if (binary.getValue())
+                collectors[i]->close_binary_log();
+            else
+                collectors[i]->save_data_to_file(output_files[i]);
         }
 
-        dc.save_data_to_file(output_file);
-
         succeed = true;
     }
 
@@ -29,6 +29,9 @@ GYRO,1,1,200,MOTION_XYZ32F
 #include <fstream>
 #include <sstream>
 #include <map>
+#include <atomic>
+#include <memory>
+#include <algorithm>
 
 
 using namespace std;
@@ -38,6 +41,7 @@ namespace rs_data_collect
 {
     const uint64_t  DEF_FRAMES_NUMBER = 100;
     const std::string DEF_OUTPUT_FILE_NAME("frames_data.csv");
+    const std::string DEF_BINARY_FILE_NAME("frames_data.bin");
 
     // Split string into token,  trim unreadable characters
     inline std::vector<std::string> tokenize(std::string line, char separator)
@@ -174,6 +178,74 @@ namespace rs_data_collect
         stop_on_any
     };
 
+    // The binary log, for long and high-rate captures: a fixed-size record per frame, written into a memory-mapped
+    // file from the frame callbacks as the frames arrive, instead of kept in memory and serialized at the end.
+    // A file holds one device; it's converted to the same csv after the fact, with --convert.
+    const char LOG_MAGIC[8] = { 'R', 'S', 'D', 'C', 'L', 'O', 'G', '1' };
+    const size_t LOG_CONFIGURATION_SIZE = 4096 - 64;
+
+#pragma pack(push, 1)
+    struct log_header
+    {
+        char        magic[8];
+        uint32_t    record_size;
+        uint32_t    reserved0;
+        uint64_t    capacity;       // Records the file was made for
+        uint64_t    count;          // Records written; set when the log is closed
+        uint64_t    dropped;        // Frames that arrived once the file was full
+        uint8_t     reserved[24];
+        char        configuration[LOG_CONFIGURATION_SIZE];  // The csv's configuration section, null-terminated
+    };
+
+    struct log_record
+    {
+        uint8_t     stream_type;    // RS2_STREAM_ANY in a slot that was never written
+        uint8_t     stream_index;
+        uint8_t     domain;
+        uint8_t     reserved[5];
+        uint64_t    frame_number;
+        double      ts;             // Device-based timestamp (msec)
+        double      arrival_time;   // Host arrival timestamp, relative to start streaming (msec)
+        double      params[7];      // As in data_collector::frame_record
+    };
+#pragma pack(pop)
+    static_assert(sizeof(log_header) == 4096, "the records of the binary log start at 4K");
+    static_assert(sizeof(log_record) == 88, "the binary log records are of fixed size");
+
+    class binary_log
+    {
+    public:
+        // Makes a file with room for 'capacity' records
+        binary_log(const std::string& filename, uint64_t capacity, const std::string& configuration);
+        // Trims the file to the records written
+        ~binary_log();
+
+        // Called from any number of threads at once: each record gets its own slot with an atomic increment
+        void append(const log_record& rec);
+
+        uint64_t written() const { return std::min<uint64_t>(_next, _capacity); }
+        uint64_t dropped() const { return _dropped; }
+
+        // Writes the csv of a binary log
+        static void convert(const std::string& log_filename, const std::string& csv_filename);
+
+    private:
+        binary_log(const binary_log&) = delete;
+        binary_log& operator=(const binary_log&) = delete;
+
+        // Unmaps the records, and trims the file to those written
+        void close_file();
+
+        std::string             _filename;
+        uint64_t                _capacity;
+        std::atomic<uint64_t>   _next;
+        std::atomic<uint64_t>   _dropped;
+        log_header*             _header;
+        log_record*             _records;
+        void*                   _file;      // The platform's handle: a HANDLE, or the descriptor
+        void*                   _mapping;
+    };
+
     class data_collector
     {
     public:
@@ -184,6 +256,9 @@ namespace rs_data_collect
 
         void parse_and_configure(ValueArg<string>& config_file);
         void save_data_to_file(const string& out_filename);
+        // Streams the frames into a binary log from now on, rather than keeping them for save_data_to_file()
+        void open_binary_log(const string& out_filename);
+        void close_binary_log();
         void collect_frame_attributes(rs2::frame f, std::chrono::time_point<std::chrono::high_resolution_clock> start_time);
         bool collecting(std::chrono::time_point<std::chrono::high_resolution_clock> start_time);
 
@@ -234,10 +309,15 @@ namespace rs_data_collect
             std::array<double,7>    _params;            // |The parameters are optional and sensor specific
         };
 
+        typedef std::map<std::pair<rs2_stream, int>, std::vector<frame_record>> stream_records;
+
+        // The csv, of the configuration section given and the records of each stream
+        static void write_csv(const string& out_filename, const string& configuration, const stream_records& data);
+
     private:
 
         std::shared_ptr<rs2::device>        _dev;
-        std::map<std::pair<rs2_stream, int>, std::vector<frame_record>> data_collection;
+        stream_records                      data_collection;
         std::vector<stream_request>         requests_to_go, user_requests;
         std::vector<rs2::sensor>            active_sensors;
         std::vector<rs2::stream_profile>    selected_stream_profiles;
@@ -245,6 +325,14 @@ namespace rs_data_collect
         int64_t                             _time_out_sec;
         application_stop                    _stop_cond;
 
+        // With a binary log, the frames of each stream are counted here, by their position in selected_stream_profiles,
+        // so the callbacks share nothing that needs a lock
+        std::unique_ptr<binary_log>         _log;
+        std::unique_ptr<std::atomic<uint64_t>[]> _log_counts;
+
+        std::string configuration_description() const;
+        int profile_position(rs2_stream type, int index) const;
+
         bool parse_configuration(const std::string& line, const std::vector<std::string>& tokens,
             rs2_stream& type, int& width, int& height, rs2_format& format, int& fps, int& index);
 
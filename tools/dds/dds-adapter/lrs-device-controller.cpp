@@ -11,9 +11,12 @@
 #include <realdds/topics/dds-topic-names.h>
 #include <realdds/topics/ros2/ros2vector3.h>
 #include <realdds/topics/flexible-msg.h>
+#include <realdds/topics/metadata-msg.h>
 #include <realdds/topics/dds-topic-names.h>
 #include <realdds/dds-device-server.h>
 #include <realdds/dds-stream-server.h>
+#include <realdds/dds-video-codec.h>
+#include <realdds/dds-shared-memory.h>
 #include <realdds/dds-topic-reader-thread.h>
 #include <realdds/dds-participant.h>
 #include <realdds/dds-guid.h>
@@ -29,6 +32,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <mutex>
 
 using rsutils::string::hexarray;
 using rsutils::json;
@@ -126,6 +130,34 @@ static std::string stream_name_from_rs2( rs2::sensor const & sensor )
 }
 
 
+// Compressed twins of the profiles that have one (see realdds::dds_video_encoder), for clients on links too slow for
+// the raw images. Not for streams the device already compresses itself: returns false if nothing was added.
+static bool add_compressed_profiles( realdds::dds_stream_profiles & profiles, rsutils::json const & settings )
+{
+    realdds::dds_stream_profiles compressed;
+    for( auto & profile : profiles )
+    {
+        auto vp = std::dynamic_pointer_cast< realdds::dds_video_stream_profile >( profile );
+        if( ! vp || realdds::dds_video_encoder::raw( vp->encoding() ).is_valid() )
+            return false;
+        auto encoding = realdds::dds_video_encoder::compressed( vp->encoding(), settings );
+        if( encoding.is_valid() )
+            compressed.push_back( std::make_shared< realdds::dds_video_stream_profile >( vp->frequency(),
+                                                                                         encoding,
+                                                                                         vp->width(),
+                                                                                         vp->height() ) );
+    }
+    profiles.insert( profiles.end(), compressed.begin(), compressed.end() );
+    return ! compressed.empty();
+}
+
+
+static std::string bandwidth_option_name( std::string const & stream_name )
+{
+    return stream_name + " Bandwidth";
+}
+
+
 std::vector< std::shared_ptr< realdds::dds_stream_server > > lrs_device_controller::get_supported_streams()
 {
     std::map< std::string, realdds::dds_stream_profiles > stream_name_to_profiles;
@@ -209,6 +241,8 @@ std::vector< std::shared_ptr< realdds::dds_stream_server > > lrs_device_controll
     }
 
     override_default_profiles( stream_name_to_profiles, stream_name_to_default_profile );
+    auto const device_settings = _dds_device_server->participant()->settings().nested( "device" );
+    bool const compression = device_settings.nested( "compression" ).default_value( false );
 
     // Iterate over the mapped streams and initialize
     std::vector< std::shared_ptr< realdds::dds_stream_server > > servers;
@@ -224,7 +258,7 @@ std::vector< std::shared_ptr< realdds::dds_stream_server > > lrs_device_controll
         else
             LOG_ERROR( "no default profile found; using first available in " << stream_name );
 
-        auto const & profiles = it.second;
+        auto & profiles = it.second;
         if( profiles.empty() )
         {
             LOG_ERROR( "ignoring stream '" << stream_name << "' with no profiles" );
@@ -244,10 +278,24 @@ std::vector< std::shared_ptr< realdds::dds_stream_server > > lrs_device_controll
             // Must be done before calling init_profiles()
             if( _md_enabled )
                 server->enable_metadata();
+            // The compressed profiles go after the rest, so don't change the default
+            if( compression && add_compressed_profiles( profiles, device_settings ) )
+                video_server->enable_compression();
         }
 
         server->init_profiles( profiles, default_profile_index );
 
+        realdds::dds_options stream_options;
+        if( std::dynamic_pointer_cast< dds_video_stream_server >( server ) )
+        {
+            // Read-only (no default), and a name of its own in each stream: a sensor's streams share its options
+            stream_options.push_back( realdds::dds_option::from_json( json::array( {
+                bandwidth_option_name( stream_name ),
+                0.f,
+                "Megabits per second sent over the network, after any compression",
+            } ) ) );
+        }
+
         // Get supported options and recommended filters for this stream
         for( auto & sensor : _rs_dev.query_sensors() )
         {
@@ -259,7 +307,6 @@ std::vector< std::shared_ptr< realdds::dds_stream_server > > lrs_device_controll
             // only need to do this once per sensor!
             if( sensors_handled.emplace( sensor_name ).second )
             {
-                realdds::dds_options stream_options;
                 auto supported_options = sensor.get_supported_options();
                 for( auto option_id : supported_options )
                 {
@@ -313,10 +360,11 @@ std::vector< std::shared_ptr< realdds::dds_stream_server > > lrs_device_controll
                 for( auto const & filter : recommended_filters )
                     filter_names.push_back( filter.get_info( RS2_CAMERA_INFO_NAME ) );
 
-                server->init_options( stream_options );
                 server->set_recommended_filters( std::move( filter_names ) );
             }
         }
+        if( ! stream_options.empty() )
+            server->init_options( stream_options );
 
         servers.push_back( server );
     }
@@ -459,15 +507,30 @@ rs2::stream_profile get_required_profile( const rs2::sensor & sensor,
     auto const stream_type = stream_name_to_type( stream_name );
     auto const stream_index = stream_name_to_index( stream_name );
 
+    auto dds_vp = std::dynamic_pointer_cast< dds_video_stream_profile >( profile );
+    int format = 0;
+    if( dds_vp )
+    {
+        // A compressed profile is streamed from its raw one
+        auto encoding = dds_vp->encoding();
+        auto video_server = std::dynamic_pointer_cast< dds_video_stream_server >( profile->stream() );
+        if( video_server && video_server->is_compression_enabled() )
+        {
+            auto raw_encoding = realdds::dds_video_encoder::raw( encoding );
+            if( raw_encoding.is_valid() )
+                encoding = raw_encoding;
+        }
+        format = encoding.to_rs2();
+    }
+
     auto profile_iter = std::find_if( sensor_stream_profiles.begin(),
                                       sensor_stream_profiles.end(),
                                       [&]( rs2::stream_profile const & sp ) {
                                           auto vp = sp.as< rs2::video_stream_profile >();
-                                          auto dds_vp = std::dynamic_pointer_cast< dds_video_stream_profile >( profile );
                                           bool video_params_match = ( vp && dds_vp )
                                                                       ? vp.width() == dds_vp->width()
                                                                             && vp.height() == dds_vp->height()
-                                                                            && vp.format() == dds_vp->encoding().to_rs2()
+                                                                            && vp.format() == format
                                                                       : true;
                                           return sp.stream_type() == stream_type
                                               && sp.stream_index() == stream_index
@@ -564,6 +627,14 @@ lrs_device_controller::lrs_device_controller( rs2::device dev, std::shared_ptr<
     // is_enabled will return current state. If one of the conditions is false we cannot get metadata from the device.
     _md_enabled = rs2::metadata_helper::instance().can_support_metadata( _rs_dev.get_info( RS2_CAMERA_INFO_PRODUCT_LINE ) )
                && rs2::metadata_helper::instance().is_enabled( _rs_dev.get_info( RS2_CAMERA_INFO_PHYSICAL_PORT ) );
+    // JSON metadata is easier to debug, but binary is much cheaper at frame rates
+    if( auto format = _dds_device_server->participant()->settings().nested( "device", "metadata-format" ) )
+    {
+        if( format.is_string() && format.string_ref() == "binary" )
+            _binary_md = true;
+        else if( ! format.is_string() || format.string_ref() != "json" )
+            LOG_WARNING( "Invalid 'device/metadata-format' value " << format );
+    }
 
     // Create a supported streams list for initializing the relevant DDS topics
     supported_streams = get_supported_streams();
@@ -574,6 +645,8 @@ lrs_device_controller::lrs_device_controller( rs2::device dev, std::shared_ptr<
             auto & sensor = _rs_sensors[sensor_name];
             auto rs2_profiles = get_rs2_profiles( active_profiles );
             sensor.open( rs2_profiles );
+            if( ! sensor.is< rs2::motion_sensor >() )
+                produce_in_shared_memory( sensor_name, active_profiles, rs2_profiles );
             if( sensor.is< rs2::motion_sensor >() )
             {
                 struct imu_context
@@ -625,13 +698,10 @@ lrs_device_controller::lrs_device_controller( rs2::device dev, std::shared_ptr<
                         dds_time const timestamp  // in sec.nsec
                             ( static_cast< long double >( f.get_timestamp() ) / 1e3 );
 
-                        realdds::topics::image_msg image;
-                        auto data = static_cast< const uint8_t * >( f.get_data() );
-                        image.raw_data.assign( data, data + f.get_data_size() );
-                        image.height = video->get_image_header().height;
-                        image.width = video->get_image_header().width;
-                        image.timestamp = timestamp;
-                        video->publish_image( std::move( image ) );
+                        video->publish_image( timestamp,
+                                              static_cast< const uint8_t * >( f.get_data() ),
+                                              f.get_data_size() );
+                        update_bandwidth( video );
 
                         publish_frame_metadata( f, timestamp );
                     } );
@@ -741,6 +811,130 @@ lrs_device_controller::~lrs_device_controller()
 }
 
 
+// The slots of a sensor's shared memory, handed to it as its frame allocator: its frames are then published right from
+// where they were produced. A segment is replaced when the sensor is opened again, and kept until its frames are gone.
+struct lrs_device_controller::frame_memory
+{
+    struct segment
+    {
+        std::shared_ptr< realdds::dds_shm_writer > writer;
+        size_t frames;  // Allocated and not yet released
+    };
+    std::mutex mutex;
+    std::vector< segment > segments;  // The last is the one frames are allocated from
+
+    static void * allocate( int size, void * user )
+    {
+        auto self = static_cast< frame_memory * >( user );
+        std::lock_guard< std::mutex > lock( self->mutex );
+        if( self->segments.empty() )
+            return nullptr;
+        auto & current = self->segments.back();
+        auto data = current.writer->allocate( size_t( size ) );
+        if( data )
+            ++current.frames;
+        return data;  // Or, when it's all taken, the library's own heap
+    }
+
+    static void deallocate( void * data, int, void * user )
+    {
+        auto self = static_cast< frame_memory * >( user );
+        std::lock_guard< std::mutex > lock( self->mutex );
+        for( auto it = self->segments.begin(); it != self->segments.end(); ++it )
+        {
+            if( ! it->writer->owns( data ) )
+                continue;
+            it->writer->release( data );
+            if( ! --it->frames && it + 1 != self->segments.end() )
+                self->segments.erase( it );
+            return;
+        }
+    }
+};
+
+
+static size_t bytes_per_pixel( rs2_format format )
+{
+    switch( format )
+    {
+    case RS2_FORMAT_Y8:
+    case RS2_FORMAT_RAW8:
+        return 1;
+    case RS2_FORMAT_RGB8:
+    case RS2_FORMAT_BGR8:
+    case RS2_FORMAT_Y12I:
+        return 3;
+    case RS2_FORMAT_RGBA8:
+    case RS2_FORMAT_BGRA8:
+    case RS2_FORMAT_DISPARITY32:
+    case RS2_FORMAT_DISTANCE:
+        return 4;
+    default:
+        return 2;  // Z16, Y16, YUYV, UYVY, ...
+    }
+}
+
+
+void lrs_device_controller::produce_in_shared_memory( std::string const & sensor_name,
+                                                      dds_stream_profiles const & active_profiles,
+                                                      std::vector< rs2::stream_profile > const & rs2_profiles )
+{
+    auto slots = _dds_device_server->participant()->settings().nested( "device", "shared-memory" ).default_value( 0u );
+    if( ! slots )
+        return;
+
+    // Until we know otherwise, as it was before the sensor was last opened
+    auto & sensor = _rs_sensors[sensor_name];
+    sensor.set_frame_allocator( nullptr, nullptr, nullptr );
+    std::vector< std::shared_ptr< dds_video_stream_server > > servers;
+    bool compressed = false;
+    for( auto & profile : active_profiles )
+    {
+        auto video = std::dynamic_pointer_cast< dds_video_stream_server >( profile->stream() );
+        if( ! video )
+            continue;
+        video->use_shared_memory( nullptr );
+        compressed = compressed || video->is_compression_enabled();
+        servers.push_back( video );
+    }
+    size_t slot_size = 0;
+    for( auto & profile : rs2_profiles )
+        if( auto video = profile.as< rs2::video_stream_profile >() )
+            slot_size = std::max( slot_size, size_t( video.width() ) * video.height() * bytes_per_pixel( video.format() ) );
+    // Compressed frames are for readers elsewhere, so it's all left to the stream servers
+    if( servers.empty() || ! slot_size || compressed )
+        return;
+
+    // The streams of the sensor share the slots, so frames don't have to be told apart when allocated
+    std::shared_ptr< dds_shm_writer > writer;
+    try
+    {
+        writer = std::make_shared< dds_shm_writer >( slots * uint32_t( servers.size() ), slot_size );
+    }
+    catch( std::exception const & e )
+    {
+        LOG_DEBUG( "frames of '" << sensor_name << "' won't be produced in shared memory: " << e.what() );
+        return;
+    }
+    for( auto & video : servers )
+        video->use_shared_memory( writer );
+
+    auto & memory = _frame_memory[sensor_name];
+    if( ! memory )
+        memory = std::make_shared< frame_memory >();
+    {
+        std::lock_guard< std::mutex > lock( memory->mutex );
+        auto & segments = memory->segments;
+        segments.erase( std::remove_if( segments.begin(),
+                                        segments.end(),
+                                        []( frame_memory::segment const & s ) { return ! s.frames; } ),
+                        segments.end() );
+        segments.push_back( { writer, 0 } );
+    }
+    sensor.set_frame_allocator( &frame_memory::allocate, &frame_memory::deallocate, memory.get() );
+}
+
+
 bool lrs_device_controller::is_recovery() const
 {
     auto update_device = rs2::update_device( _rs_dev );
@@ -792,6 +986,23 @@ void lrs_device_controller::publish_frame_metadata( const rs2::frame & f, realdd
     if( ! _dds_device_server->has_metadata_readers() )
         return;
 
+    if( _binary_md )
+    {
+        realdds::topics::metadata_msg md( stream_name_from_rs2( f.get_profile() ), timestamp.to_ns() );
+        md.set_frame_number( f.get_frame_number() );
+        md.set_timestamp_domain( f.get_frame_timestamp_domain() );
+        if( f.is< rs2::depth_frame >() )
+            md.set_depth_units( f.as< rs2::depth_frame >().get_units() );
+        for( int i = 0; i < static_cast< int >( RS2_FRAME_METADATA_COUNT ); ++i )
+        {
+            rs2_frame_metadata_value val = static_cast< rs2_frame_metadata_value >( i );
+            if( f.supports_frame_metadata( val ) )
+                md.add( i, f.get_frame_metadata( val ) );
+        }
+        _dds_device_server->publish_metadata( std::move( md ) );
+        return;
+    }
+
     json md_header = json::object( {
         { topics::metadata::header::key::frame_number, f.get_frame_number() },               // communicated; up to client to pick up
         { topics::metadata::header::key::timestamp, timestamp.to_ns() },                     // syncer key: needs to match the image timestamp, bit-for-bit!
@@ -817,6 +1028,30 @@ void lrs_device_controller::publish_frame_metadata( const rs2::frame & f, realdd
 }
 
 
+void lrs_device_controller::update_bandwidth( std::shared_ptr< realdds::dds_video_stream_server > const & video )
+{
+    auto const name = bandwidth_option_name( video->name() );
+    for( auto & option : video->options() )
+    {
+        if( option->get_name() != name )
+            continue;
+        // The server only updates it about once a second
+        json value = video->get_bandwidth();
+        if( option->get_value() == value )
+            return;
+        option->set_value( value );
+
+        json option_values;
+        option_values[video->name()][name] = std::move( value );
+        _dds_device_server->publish_notification( json::object( {
+            { realdds::topics::notification::key::id, realdds::topics::reply::query_options::id },
+            { realdds::topics::reply::query_options::key::option_values, std::move( option_values ) },
+        } ) );
+        return;
+    }
+}
+
+
 std::vector< rs2::stream_profile >
 lrs_device_controller::get_rs2_profiles( realdds::dds_stream_profiles const & dds_profiles ) const
 {
@@ -887,6 +1122,8 @@ json lrs_device_controller::query_option( const std::shared_ptr< realdds::dds_op
     if( it == _stream_name_to_server.end() )
         throw std::runtime_error( "no stream '" + stream->name() + "' in device" );
     auto server = it->second;
+    if( option->get_name() == bandwidth_option_name( stream->name() ) )
+        return std::dynamic_pointer_cast< dds_video_stream_server >( server )->get_bandwidth();
     auto & sensor = _rs_sensors[server->sensor_name()];
     try
     {
@@ -18,6 +18,8 @@ namespace realdds {
 
 class dds_device_server;
 class dds_stream_server;
+class dds_video_stream_server;
+class dds_shm_writer;
 class dds_option;
 
 } // namespace realdds
@@ -41,6 +43,7 @@ private:
     std::vector< std::shared_ptr< realdds::dds_stream_server > > get_supported_streams();
 
     void publish_frame_metadata( const rs2::frame & f, realdds::dds_time const & );
+    void update_bandwidth( std::shared_ptr< realdds::dds_video_stream_server > const & );
 
     bool on_control( std::string const & id, rsutils::json const & control, rsutils::json & reply );
     bool on_hardware_reset( rsutils::json const &, rsutils::json & );
@@ -61,6 +64,10 @@ private:
 
 
     rs2::device _rs_dev;
+    // With "shared-memory", where each video sensor produces its frames: outlives the sensors, which may still have
+    // frames in it when they're destroyed
+    struct frame_memory;
+    std::map< std::string, std::shared_ptr< frame_memory > > _frame_memory;
     std::map< std::string, rs2::sensor > _rs_sensors;
     std::string _device_sn;
     realdds::dds_stream_sensor_bridge _bridge;
@@ -71,9 +78,13 @@ private:
     std::map< std::string, std::shared_ptr< realdds::dds_stream_server > > _stream_name_to_server;
 
     std::vector< rs2::stream_profile > get_rs2_profiles( realdds::dds_stream_profiles const & dds_profiles ) const;
+    void produce_in_shared_memory( std::string const & sensor_name,
+                                   realdds::dds_stream_profiles const & active_profiles,
+                                   std::vector< rs2::stream_profile > const & rs2_profiles );
 
     std::shared_ptr< realdds::dds_device_server > _dds_device_server;
     bool _md_enabled;
+    bool _binary_md = false;  // Publish metadata as metadata_msg rather than JSON
 };  // class lrs_device_controller
 
 }  // namespace tools
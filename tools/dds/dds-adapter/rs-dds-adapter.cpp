@@ -173,10 +173,23 @@ try
     
     std::cout << "Start listening to RS devices.." << std::endl;
 
+    // Streams go out in the formats the camera produces them in (e.g., YUYV rather than RGB8, at 2 bytes a pixel
+    // instead of 3), and are converted by the receiver; only interleaved formats are split here, as each of their
+    // halves is a stream of its own. Clients that don't convert (e.g., ROS nodes) can have the adapter do it instead
+    // with "full".
+    std::string format_conversion( "basic" );
+    if( auto setting = participant->settings().nested( "device", "format-conversion" ) )
+    {
+        if( setting.is_string() && ( setting.string_ref() == "basic" || setting.string_ref() == "full" ) )
+            format_conversion = setting.string_ref();
+        else
+            LOG_WARNING( "Invalid 'device/format-conversion' value " << setting << "; using 'basic'" );
+    }
+
     // Create a RealSense context
     rsutils::json j = {
-        { "dds",               false   }, // Don't discover DDS devices from the network, we want local devices only 
-        { "format-conversion", "basic" }  // Don't convert raw sensor formats (except interleaved) will be done by receiver
+        { "dds",               false             }, // Don't discover DDS devices from the network, we want local devices only
+        { "format-conversion", format_conversion }
     };
     rs2::context ctx( j.dump() );
 
@@ -5,6 +5,8 @@
 
 #include <thread>
 #include <memory>
+#include <atomic>
+#include <chrono>
 
 #include <fastdds/dds/domain/DomainParticipant.hpp>
 #include <fastdds/dds/subscriber/DataReader.hpp>
@@ -65,6 +67,7 @@ int main( int argc, char ** argv ) try
     SwitchArg snapshot_arg( "s", "snapshot", "run momentarily taking a snapshot of the domain" );
     SwitchArg machine_readable_arg( "m", "machine-readable", "output entities in a way more suitable for automatic parsing" );
     SwitchArg topic_samples_arg( "t", "topic-samples", "register to topics that send TypeObject and print their samples" );
+    SwitchArg topic_statistics_arg( "", "topic-statistics", "like --topic-samples, but print statistics every second instead of the samples" );
     SwitchArg debug_arg( "", "debug", "Enable debug logging", false );
     SwitchArg participants_arg( "", "participants", "Show participants and quit; implies --snapshot", false );
     ValueArg< realdds::dds_domain_id > domain_arg( "d", "domain", "select domain ID to listen on", false, 0, "0-232" );
@@ -72,6 +75,7 @@ int main( int argc, char ** argv ) try
     cmd.add( snapshot_arg );
     cmd.add( machine_readable_arg );
     cmd.add( topic_samples_arg );
+    cmd.add( topic_statistics_arg );
     cmd.add( domain_arg );
     cmd.add( debug_arg );
     cmd.add( participants_arg );
@@ -80,7 +84,8 @@ int main( int argc, char ** argv ) try
 
     bool participants = participants_arg.isSet();
     bool machine_readable = machine_readable_arg.isSet();
-    bool topic_samples = topic_samples_arg.isSet();
+    bool topic_statistics = topic_statistics_arg.isSet();
+    bool topic_samples = topic_samples_arg.isSet() || topic_statistics;
     bool snapshot = snapshot_arg.isSet() || participants;
 
     // Intercept DDS messages and redirect them to our own logging mechanism
@@ -109,6 +114,7 @@ int main( int argc, char ** argv ) try
     sniffer.print_by_topics( snapshot && ! participants );
     sniffer.print_machine_readable( machine_readable );
     sniffer.print_topic_samples( topic_samples && ! snapshot );
+    sniffer.count_topic_samples( topic_statistics );
 
     sniffer.set_root( root_arg.getValue() );
 
@@ -130,8 +136,27 @@ int main( int argc, char ** argv ) try
 
     if( ! snapshot )
     {
+        std::atomic_bool done( false );
+        std::thread statistics_thread;
+        if( topic_statistics )
+        {
+            statistics_thread = std::thread(
+                [&]()
+                {
+                    while( ! done )
+                    {
+                        std::this_thread::sleep_for( std::chrono::seconds( 1 ) );
+                        sniffer.print_topic_statistics();
+                    }
+                } );
+        }
+
         // Wait until user presses Ctrl+C
         std::cin.ignore( std::numeric_limits< std::streamsize >::max() );
+
+        done = true;
+        if( statistics_thread.joinable() )
+            statistics_thread.join();
     }
     else
     {
@@ -173,7 +198,7 @@ catch( const std::exception & e )
 
 dds_sniffer::dds_sniffer()
     : _participant()
-    , _reader_listener( _discovered_types_datas )
+    , _reader_listener( *this )
 {
 }
 
@@ -192,6 +217,7 @@ dds_sniffer::~dds_sniffer()
 
     _discovered_types_readers.clear();
     _discovered_types_datas.clear();
+    _discovered_types_statistics.clear();
 }
 
 
@@ -359,7 +385,8 @@ void dds_sniffer::on_type_discovery( char const * topic_name, DynamicType_ptr dy
                 return;
             }
 
-            StatusMask sub_mask = StatusMask::subscription_matched() << StatusMask::data_available();
+            StatusMask sub_mask = StatusMask::subscription_matched() << StatusMask::data_available()
+                               << StatusMask::sample_lost();
             DataReaderQos rqos = DATAREADER_QOS_DEFAULT;
             rqos.endpoint().history_memory_policy = eprosima::fastrtps::rtps::PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
             DataReader * reader = DDS_API_CALL( _discovered_types_subscriber->create_datareader( topic,
@@ -376,37 +403,78 @@ void dds_sniffer::on_type_discovery( char const * topic_name, DynamicType_ptr dy
 
             DynamicData_ptr data( DDS_API_CALL( DynamicDataFactory::get_instance()->create_data( dyn_type ) ) );
             _discovered_types_datas[reader] = data;
+
+            if( _count_topic_samples )
+            {
+                std::shared_ptr< topic_statistics > statistics( new topic_statistics );
+                statistics->topic_name = topic_name;
+                statistics->type_support = type_support;
+                std::lock_guard< std::mutex > lock( _statistics_lock );
+                _discovered_types_statistics[reader] = statistics;
+            }
         }
     }
 }
 
-dds_sniffer::dds_reader_listener::dds_reader_listener( std::map< DataReader *, DynamicData_ptr > & datas )
-    : _datas( datas )
+dds_sniffer::dds_reader_listener::dds_reader_listener( dds_sniffer & sniffer )
+    : _sniffer( sniffer )
+{
+}
+
+std::shared_ptr< dds_sniffer::topic_statistics >
+dds_sniffer::dds_reader_listener::statistics_of( DataReader * reader ) const
 {
+    std::lock_guard< std::mutex > lock( _sniffer._statistics_lock );
+    auto it = _sniffer._discovered_types_statistics.find( reader );
+    if( it == _sniffer._discovered_types_statistics.end() )
+        return nullptr;
+    return it->second;
 }
 
 void dds_sniffer::dds_reader_listener::on_data_available( DataReader * reader )
 {
-    const TopicDescription * topic_desc = DDS_API_CALL( reader->get_topicdescription() );
-    std::cout << "Received topic " << topic_desc->get_name() << " of type " 
-              << topic_desc->get_type_name() << std::endl;
+    auto statistics = statistics_of( reader );
+    if( ! statistics )
+    {
+        const TopicDescription * topic_desc = DDS_API_CALL( reader->get_topicdescription() );
+        std::cout << "Received topic " << topic_desc->get_name() << " of type "
+                  << topic_desc->get_type_name() << std::endl;
+    }
 
-    auto dit = _datas.find( reader );
+    auto dit = _sniffer._discovered_types_datas.find( reader );
 
-    if( dit != _datas.end() )
+    if( dit != _sniffer._discovered_types_datas.end() )
     {
         DynamicData_ptr data = dit->second;
         SampleInfo info;
+        auto const queue_depth = reader->get_unread_count();
+        auto const start = std::chrono::steady_clock::now();
         if( DDS_API_CALL( reader->take_next_sample( data.get(), &info ) ) == ReturnCode_t::RETCODE_OK )
         {
             if( info.valid_data )
             {
-                DynamicDataHelper::print( data );
+                if( statistics )
+                    statistics->statistics.on_sample(
+                        statistics->type_support->getSerializedSizeProvider( data.get() )(),
+                        info );
+                else
+                    DynamicDataHelper::print( data );
             }
         }
+        if( statistics )
+            statistics->statistics.on_callback(
+                std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - start )
+                    .count(),
+                queue_depth );
     }
 }
 
+void dds_sniffer::dds_reader_listener::on_sample_lost( DataReader * reader, const SampleLostStatus & status )
+{
+    if( auto statistics = statistics_of( reader ) )
+        statistics->statistics.on_lost( status.total_count_change );
+}
+
 void dds_sniffer::dds_reader_listener::on_subscription_matched( DataReader * reader, const SubscriptionMatchedStatus & info )
 {
     if( info.current_count_change == 1 )
@@ -627,6 +695,23 @@ void dds_sniffer::print_topics() const
     }
 }
 
+void dds_sniffer::print_topic_statistics() const
+{
+    std::lock_guard< std::mutex > lock( _statistics_lock );
+    for( auto & reader_statistics : _discovered_types_statistics )
+    {
+        auto & statistics = *reader_statistics.second;
+        if( filter_topic( statistics.topic_name, _root ) )
+            continue;
+        if( _print_machine_readable )
+            std::cout << rsutils::json::object(
+                { { "topic", statistics.topic_name }, { "statistics", statistics.statistics.get().to_json() } } )
+                      << std::endl;
+        else
+            std::cout << statistics.topic_name << ": " << statistics.statistics.get().to_json() << std::endl;
+    }
+}
+
 void dds_sniffer::print_participants( bool with_guids ) const
 {
     for( auto & guid2name : _discovered_participants )
@@ -9,9 +9,11 @@
 #include <set>
 
 #include <realdds/dds-participant.h>
+#include <realdds/dds-reader-statistics.h>
 
 #include <fastdds/dds/subscriber/Subscriber.hpp>
 #include <fastdds/dds/topic/Topic.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
 #include <fastdds/dds/core/status/SubscriptionMatchedStatus.hpp>
 
 class dds_sniffer
@@ -24,6 +26,7 @@ public:
     void print_by_topics( bool enable ) { _print_by_topics = enable; }
     void print_machine_readable( bool enable ) { _print_machine_readable = enable; }
     void print_topic_samples( bool enable ) { _print_topic_samples = enable; }
+    void count_topic_samples( bool enable ) { _count_topic_samples = enable; }
 
     void set_root( std::string const & root ) { _root = root; }
 
@@ -34,6 +37,7 @@ public:
     void print_participants( bool with_guids = false ) const;
     void print_topics() const;
     void print_topics_machine_readable() const;
+    void print_topic_statistics() const;
 
 private:
     std::shared_ptr< realdds::dds_participant::listener > _listener;
@@ -52,6 +56,7 @@ private:
     bool _print_by_topics = false;
     bool _print_machine_readable = false;
     bool _print_topic_samples = false;
+    bool _count_topic_samples = false;
 
     std::string _root;
 
@@ -64,17 +69,30 @@ private:
     std::map< eprosima::fastdds::dds::DataReader *,
               eprosima::fastrtps::types::DynamicData_ptr > _discovered_types_datas; // Save allocated data buffer for sample read
 
+    // With count_topic_samples(), samples are counted rather than printed
+    struct topic_statistics
+    {
+        std::string topic_name;
+        eprosima::fastdds::dds::TypeSupport type_support;  // For the sample sizes
+        realdds::dds_reader_statistics statistics;
+    };
+    std::map< eprosima::fastdds::dds::DataReader *, std::shared_ptr< topic_statistics > > _discovered_types_statistics;
+    mutable std::mutex _statistics_lock;
+
     struct dds_reader_listener : public eprosima::fastdds::dds::DataReaderListener
     {
-        dds_reader_listener( std::map< eprosima::fastdds::dds::DataReader *,
-                             eprosima::fastrtps::types::DynamicData_ptr > & datas );
+        dds_reader_listener( dds_sniffer & sniffer );
 
         void on_data_available( eprosima::fastdds::dds::DataReader * reader ) override;
         void on_subscription_matched( eprosima::fastdds::dds::DataReader *,
                                       const eprosima::fastdds::dds::SubscriptionMatchedStatus & info ) override;
+        void on_sample_lost( eprosima::fastdds::dds::DataReader *,
+                             const eprosima::fastdds::dds::SampleLostStatus & status ) override;
 
     private:
-        std::map< eprosima::fastdds::dds::DataReader *, eprosima::fastrtps::types::DynamicData_ptr > & _datas;
+        std::shared_ptr< topic_statistics > statistics_of( eprosima::fastdds::dds::DataReader * ) const;
+
+        dds_sniffer & _sniffer;
     };
 
     dds_reader_listener _reader_listener;  // define only after _discovered_types_datas (creation order matters)
@@ -68,7 +68,7 @@ namespace rs2
         }
 
         //Based on: http://www.ilikebigbits.com/blog/2015/3/2/plane-from-points
-        inline plane plane_from_points(const std::vector<rs2::float3> points)
+        inline plane plane_from_points(const std::vector<rs2::float3>& points)
         {
             if (points.size() < 3) throw std::runtime_error("Not enough points to calculate plane");
 
@@ -164,6 +164,7 @@ namespace rs2
             std::mutex m;
 
             std::vector<rs2::float3> roi_pixels;
+            roi_pixels.reserve(size_t(std::max(0, roi.max_x - roi.min_x)) * std::max(0, roi.max_y - roi.min_y));
 
 //#pragma omp parallel for - TODO optimization envisaged
             for (int y = roi.min_y; y < roi.max_y; ++y)
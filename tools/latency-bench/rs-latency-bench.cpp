@@ -0,0 +1,460 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// Streams from one camera or more (or recordings), for as long as asked -- hours, for a soak test -- and measures
+// how long frames take to reach the application, how many are dropped, and what it costs in CPU and memory. The
+// summaries are the same from one build to the next, to compare them; the frame trace, if asked for, breaks the
+// latency down by stage.
+
+#include <librealsense2/rs.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+#include "tclap/CmdLine.h"
+
+using namespace std;
+using namespace TCLAP;
+
+
+// Latencies, in a fixed number of buckets so hours of them take no more memory than seconds do
+class histogram
+{
+    static constexpr double bucket_ms = 0.1;
+    static constexpr size_t n_buckets = 20000;  // Up to 2 seconds; anything longer counts as that
+
+    vector< uint64_t > _counts = vector< uint64_t >( n_buckets, 0 );
+    uint64_t _total = 0;
+    double _max = 0;
+
+public:
+    void add( double ms )
+    {
+        auto i = size_t( max( 0., ms ) / bucket_ms );
+        ++_counts[min( i, n_buckets - 1 )];
+        ++_total;
+        _max = max( _max, ms );
+    }
+
+    uint64_t count() const { return _total; }
+    double maximum() const { return _max; }
+
+    double percentile( double p ) const
+    {
+        if( ! _total )
+            return 0;
+        auto rank = uint64_t( p / 100. * ( _total - 1 ) );
+        uint64_t seen = 0;
+        for( size_t i = 0; i < n_buckets; ++i )
+        {
+            seen += _counts[i];
+            if( seen > rank )
+                return ( i + 0.5 ) * bucket_ms;
+        }
+        return _max;
+    }
+};
+
+
+static double system_time_ms()
+{
+    return chrono::duration< double, milli >( chrono::system_clock::now().time_since_epoch() ).count();
+}
+
+
+struct stream_stats
+{
+    uint64_t frames = 0;
+    uint64_t drops = 0;
+    unsigned long long last_number = 0;
+    histogram capture;   // From the frame's timestamp, in the host's clock, to its arrival at the host
+    histogram delivery;  // From its arrival to the callback
+    histogram total;     // From the frame's timestamp to the callback
+};
+
+
+class collector
+{
+    mutable mutex _mutex;
+    map< string, stream_stats > _streams;
+
+public:
+    void on_frame( string const & source, rs2::frame const & f )
+    {
+        auto now = system_time_ms();
+        // Only a timestamp in the host's clock can be compared with it
+        auto domain = f.get_frame_timestamp_domain();
+        bool host_clock = domain == RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME || domain == RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME;
+        double arrival = f.supports_frame_metadata( RS2_FRAME_METADATA_TIME_OF_ARRIVAL )
+                           ? double( f.get_frame_metadata( RS2_FRAME_METADATA_TIME_OF_ARRIVAL ) )
+                           : 0;
+        auto name = source + '/' + f.get_profile().stream_name() + '/' + rs2_format_to_string( f.get_profile().format() );
+
+        lock_guard< mutex > lock( _mutex );
+        auto & s = _streams[name];
+        auto number = f.get_frame_number();
+        if( s.frames && number > s.last_number + 1 )
+            s.drops += number - s.last_number - 1;
+        s.last_number = number;
+        ++s.frames;
+        if( arrival )
+            s.delivery.add( now - arrival );
+        if( host_clock )
+        {
+            s.total.add( now - f.get_timestamp() );
+            if( arrival )
+                s.capture.add( arrival - f.get_timestamp() );
+        }
+    }
+
+    map< string, stream_stats > snapshot() const
+    {
+        lock_guard< mutex > lock( _mutex );
+        return _streams;
+    }
+};
+
+
+struct thread_cpu
+{
+    string name;
+    double seconds;  // User + system, since the thread started
+};
+
+
+// Per thread, where the OS tells (Linux)
+static map< int, thread_cpu > sample_threads()
+{
+    map< int, thread_cpu > threads;
+#ifdef __linux__
+    static long const ticks = sysconf( _SC_CLK_TCK );
+    if( auto dir = opendir( "/proc/self/task" ) )
+    {
+        while( auto entry = readdir( dir ) )
+        {
+            int tid = atoi( entry->d_name );
+            if( ! tid )
+                continue;
+            ifstream stat( string( "/proc/self/task/" ) + entry->d_name + "/stat" );
+            string line;
+            if( ! getline( stat, line ) )
+                continue;
+            // pid (name) state ...: the name may have spaces or parentheses of its own
+            auto open = line.find( '(' ), close = line.rfind( ')' );
+            if( open == string::npos || close == string::npos )
+                continue;
+            istringstream rest( line.substr( close + 2 ) );
+            string field;
+            unsigned long long utime = 0, stime = 0;
+            for( int i = 3; i <= 15 && rest >> field; ++i )
+                if( i == 14 )
+                    utime = stoull( field );
+                else if( i == 15 )
+                    stime = stoull( field );
+            threads[tid] = { line.substr( open + 1, close - open - 1 ), double( utime + stime ) / ticks };
+        }
+        closedir( dir );
+    }
+#endif
+    return threads;
+}
+
+
+// The most memory the process has had, in KB, or 0 where the OS doesn't tell (only Linux, for now)
+static long memory_high_water_kb()
+{
+#ifdef __linux__
+    ifstream status( "/proc/self/status" );
+    string line;
+    while( getline( status, line ) )
+        if( line.compare( 0, 6, "VmHWM:" ) == 0 )
+            return atol( line.c_str() + 6 );
+#endif
+    return 0;
+}
+
+
+static double cpu_seconds( map< int, thread_cpu > const & threads )
+{
+    double total = 0;
+    for( auto & t : threads )
+        total += t.second.seconds;
+    return total;
+}
+
+
+// CPU per thread name, as a % of one core, over 'seconds'; threads of the same name are summed up
+static map< string, double > cpu_usage( map< int, thread_cpu > const & before, map< int, thread_cpu > const & after,
+                                        double seconds )
+{
+    map< string, double > usage;
+    for( auto & t : after )
+    {
+        auto it = before.find( t.first );
+        auto used = t.second.seconds - ( it == before.end() ? 0. : it->second.seconds );
+        usage[t.second.name] += seconds > 0 ? 100. * used / seconds : 0.;
+    }
+    return usage;
+}
+
+
+static void print_summary( ostream & os, map< string, stream_stats > const & streams, double seconds )
+{
+    os << left << setw( 40 ) << "stream" << right << setw( 10 ) << "frames" << setw( 8 ) << "drops" << setw( 8 )
+       << "fps" << setw( 12 ) << "p50 ms" << setw( 10 ) << "p99 ms" << setw( 10 ) << "max ms" << endl;
+    for( auto & s : streams )
+    {
+        // The total latency, where the timestamps allow it; otherwise from the arrival only
+        auto & h = s.second.total.count() ? s.second.total : s.second.delivery;
+        os << left << setw( 40 ) << s.first.substr( 0, 39 ) << right << setw( 10 ) << s.second.frames << setw( 8 )
+           << s.second.drops << fixed << setprecision( 1 ) << setw( 8 ) << ( seconds > 0 ? s.second.frames / seconds : 0 )
+           << setprecision( 2 ) << setw( 12 ) << h.percentile( 50 ) << setw( 10 ) << h.percentile( 99 ) << setw( 10 )
+           << h.maximum() << endl;
+    }
+}
+
+
+static string json_string( string const & s )
+{
+    ostringstream os;
+    os << '"';
+    for( char c : s )
+        if( c == '"' || c == '\\' )
+            os << '\\' << c;
+        else
+            os << c;
+    os << '"';
+    return os.str();
+}
+
+
+static void write_json( ostream & os, map< string, stream_stats > const & streams, map< string, double > const & cpu,
+                        double cpu_total, long memory_kb, double seconds )
+{
+    auto latency = []( histogram const & h )
+    {
+        ostringstream os;
+        os << "{ \"count\": " << h.count() << ", \"p50_ms\": " << h.percentile( 50 )
+           << ", \"p99_ms\": " << h.percentile( 99 ) << ", \"max_ms\": " << h.maximum() << " }";
+        return os.str();
+    };
+    os << "{\n  \"version\": " << json_string( RS2_API_FULL_VERSION_STR ) << ",\n  \"seconds\": " << seconds
+       << ",\n  \"streams\": [";
+    bool first = true;
+    for( auto & s : streams )
+    {
+        os << ( first ? "" : "," ) << "\n    { \"name\": " << json_string( s.first ) << ", \"frames\": " << s.second.frames
+           << ", \"drops\": " << s.second.drops << ", \"fps\": " << ( seconds > 0 ? s.second.frames / seconds : 0 )
+           << ",\n      \"capture\": " << latency( s.second.capture ) << ",\n      \"delivery\": "
+           << latency( s.second.delivery ) << ",\n      \"total\": " << latency( s.second.total ) << " }";
+        first = false;
+    }
+    os << "\n  ],\n  \"cpu_percent\": " << cpu_total << ",\n  \"threads\": {";
+    first = true;
+    for( auto & t : cpu )
+    {
+        os << ( first ? "" : "," ) << "\n    " << json_string( t.first ) << ": " << t.second;
+        first = false;
+    }
+    os << "\n  },\n  \"memory_high_water_kb\": " << memory_kb << "\n}\n";
+}
+
+
+static string lower( string s )
+{
+    transform( s.begin(), s.end(), s.begin(), []( char c ) { return char( tolower( c ) ); } );
+    return s;
+}
+
+
+// "depth,640,480,30,z16": any of the trailing values may be left out, or be 0, for whatever the device has
+static void enable_stream( rs2::config & cfg, string const & spec )
+{
+    vector< string > parts;
+    stringstream ss( spec );
+    string part;
+    while( getline( ss, part, ',' ) )
+        parts.push_back( part );
+    if( parts.empty() )
+        throw runtime_error( "invalid stream: " + spec );
+
+    auto stream = RS2_STREAM_COUNT;
+    for( int i = 0; i < RS2_STREAM_COUNT; ++i )
+        if( lower( rs2_stream_to_string( rs2_stream( i ) ) ) == lower( parts[0] ) )
+            stream = rs2_stream( i );
+    if( stream == RS2_STREAM_COUNT )
+        throw runtime_error( "unknown stream: " + parts[0] );
+
+    auto format = RS2_FORMAT_ANY;
+    if( parts.size() > 4 )
+    {
+        for( int i = 0; i < RS2_FORMAT_COUNT; ++i )
+            if( lower( rs2_format_to_string( rs2_format( i ) ) ) == lower( parts[4] ) )
+                format = rs2_format( i );
+        if( format == RS2_FORMAT_ANY )
+            throw runtime_error( "unknown format: " + parts[4] );
+    }
+    auto value = [&]( size_t i ) { return parts.size() > i ? stoi( parts[i] ) : 0; };
+    cfg.enable_stream( stream, -1, value( 1 ), value( 2 ), format, value( 3 ) );
+}
+
+
+static atomic< bool > stopping( false );
+
+
+int main( int argc, char * argv[] ) try
+{
+    CmdLine cmd( "librealsense rs-latency-bench tool: end-to-end latency and throughput", ' ', RS2_API_VERSION_STR );
+    ValueArg< int > devices_arg( "d", "devices", "How many of the connected devices to stream from (0 for all)", false,
+                                 0, "count" );
+    MultiArg< string > file_arg( "f", "file", "Recording to play back, in a loop, instead of a device (repeatable)",
+                                 false, "path" );
+    MultiArg< string > stream_arg( "s", "stream",
+                                   "Stream to enable, as 'depth,640,480,30,z16' (repeatable; default: the device's)",
+                                   false, "spec" );
+    ValueArg< double > time_arg( "t", "time", "Seconds to stream for (for a soak test: hours of them)", false, 10,
+                                 "seconds" );
+    ValueArg< double > interval_arg( "i", "interval", "Seconds between the summaries shown while streaming", false, 10,
+                                     "seconds" );
+    ValueArg< string > output_arg( "o", "output", "JSON file to write the final summary to", false, "", "path" );
+    ValueArg< string > trace_arg( "x", "trace", "Trace the frames through the pipeline, and write the trace here "
+                                  "(Chrome/Perfetto format)", false, "", "path" );
+    cmd.add( devices_arg );
+    cmd.add( file_arg );
+    cmd.add( stream_arg );
+    cmd.add( time_arg );
+    cmd.add( interval_arg );
+    cmd.add( output_arg );
+    cmd.add( trace_arg );
+    cmd.parse( argc, argv );
+
+    if( trace_arg.isSet() )
+        rs2::enable_frame_tracing();
+
+    rs2::context ctx;
+    collector stats;
+    vector< pair< string, rs2::config > > sources;
+    for( auto & path : file_arg.getValue() )
+    {
+        rs2::config cfg;
+        cfg.enable_device_from_file( path, true );
+        sources.emplace_back( path, cfg );
+    }
+    if( sources.empty() )
+    {
+        auto devices = ctx.query_devices();
+        size_t n = devices_arg.getValue() > 0 ? size_t( devices_arg.getValue() ) : devices.size();
+        for( size_t i = 0; i < devices.size() && sources.size() < n; ++i )
+        {
+            auto dev = devices[uint32_t( i )];
+            if( ! dev.supports( RS2_CAMERA_INFO_SERIAL_NUMBER ) )
+                continue;
+            string serial = dev.get_info( RS2_CAMERA_INFO_SERIAL_NUMBER );
+            rs2::config cfg;
+            cfg.enable_device( serial );
+            sources.emplace_back( serial, cfg );
+        }
+        if( sources.size() < n )
+            throw runtime_error( "only " + to_string( sources.size() ) + " devices connected" );
+    }
+    if( sources.empty() )
+        throw runtime_error( "no device connected" );
+
+    vector< rs2::pipeline > pipelines;
+    for( auto & source : sources )
+    {
+        auto & cfg = source.second;
+        for( auto & spec : stream_arg.getValue() )
+            enable_stream( cfg, spec );
+        string name = source.first;
+        pipelines.emplace_back( ctx );
+        pipelines.back().start( cfg,
+                                [name, &stats]( rs2::frame f )
+                                {
+                                    if( auto fs = f.as< rs2::frameset >() )
+                                        for( auto sf : fs )
+                                            stats.on_frame( name, sf );
+                                    else
+                                        stats.on_frame( name, f );
+                                } );
+        cout << "Streaming from " << name << endl;
+    }
+
+    signal( SIGINT, []( int ) { stopping = true; } );
+    auto cpu_start = sample_threads();
+    auto start = chrono::steady_clock::now();
+    auto elapsed = [&]() { return chrono::duration< double >( chrono::steady_clock::now() - start ).count(); };
+    auto next_summary = interval_arg.getValue();
+    while( ! stopping && elapsed() < time_arg.getValue() )
+    {
+        this_thread::sleep_for( chrono::milliseconds( 100 ) );
+        if( interval_arg.getValue() > 0 && elapsed() >= next_summary && elapsed() < time_arg.getValue() )
+        {
+            cout << "\n-- " << fixed << setprecision( 0 ) << elapsed() << " s, memory high-water "
+                 << memory_high_water_kb() << " KB" << endl;
+            print_summary( cout, stats.snapshot(), elapsed() );
+            next_summary += interval_arg.getValue();
+        }
+    }
+    auto seconds = elapsed();
+    auto cpu_end = sample_threads();
+    auto streams = stats.snapshot();
+    for( auto & p : pipelines )
+        p.stop();
+
+    auto cpu = cpu_usage( cpu_start, cpu_end, seconds );
+    double cpu_total = seconds > 0 ? 100. * ( cpu_seconds( cpu_end ) - cpu_seconds( cpu_start ) ) / seconds : 0;
+    auto memory_kb = memory_high_water_kb();
+    cout << "\n== " << fixed << setprecision( 0 ) << seconds << " s" << endl;
+    print_summary( cout, streams, seconds );
+    if( ! cpu.empty() )
+    {
+        cout << "\nCPU " << fixed << setprecision( 1 ) << cpu_total << "% of a core; by thread:" << endl;
+        for( auto & t : cpu )
+            if( t.second >= 0.1 )
+                cout << "    " << left << setw( 20 ) << t.first << right << setw( 8 ) << t.second << "%" << endl;
+    }
+    if( memory_kb )
+        cout << "Memory high-water: " << memory_kb << " KB" << endl;
+
+    if( output_arg.isSet() )
+    {
+        ofstream file( output_arg.getValue() );
+        if( ! file )
+            throw runtime_error( "failed to open " + output_arg.getValue() );
+        write_json( file, streams, cpu, cpu_total, memory_kb, seconds );
+    }
+    if( trace_arg.isSet() )
+        rs2::export_frame_trace( trace_arg.getValue().c_str() );
+    return EXIT_SUCCESS;
+}
+catch( const rs2::error & e )
+{
+    cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what()
+         << endl;
+    return EXIT_FAILURE;
+}
+catch( const exception & e )
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
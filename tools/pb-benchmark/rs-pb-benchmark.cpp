@@ -0,0 +1,503 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// Benchmarks the processing blocks on frames that need no camera: synthetic ones, made the same way every run, or
+// those of a recording. Each block is timed frame by frame, for every resolution and thread count asked for, and
+// the results can be written as JSON, to compare across releases.
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+
+using namespace std;
+using namespace TCLAP;
+
+
+// Every allocation in the process, ours or the library's (where the platform lets us replace operator new for it,
+// as it does with ELF shared objects and static builds; on Windows, a DLL's allocations aren't seen)
+static atomic< size_t > n_allocations( 0 );
+
+void * operator new( size_t size )
+{
+    ++n_allocations;
+    if( void * p = malloc( size ? size : 1 ) )
+        return p;
+    throw bad_alloc();
+}
+void * operator new[]( size_t size ) { return operator new( size ); }
+void operator delete( void * p ) noexcept { free( p ); }
+void operator delete[]( void * p ) noexcept { free( p ); }
+
+
+struct resolution
+{
+    int width, height;
+};
+
+
+// What the blocks work on, for one resolution
+struct inputs
+{
+    vector< rs2::frame > depth, ir, color, yuyv;
+    vector< rs2::frameset > depth_color;  // For align
+    vector< rs2::frameset > hdr;          // Pairs of depth + IR, with the sequence metadata HDR merge looks for
+};
+
+
+// A set of frames as one, the way a syncer would hand them out
+static rs2::frameset bundle( vector< rs2::frame > const & frames )
+{
+    rs2::frame_queue q( 1 );
+    rs2::processing_block pb( [&]( rs2::frame, rs2::frame_source & src )
+                              { src.frame_ready( src.allocate_composite_frame( frames ) ); } );
+    pb.start( q );
+    pb.invoke( frames.front() );
+    return q.wait_for_frame();
+}
+
+
+// A software device with depth + IR, color, and raw YUYV, each frame sent as it's asked for: what comes out is
+// reproducible, as nothing's random but for a fixed seed
+class synthetic_camera
+{
+    rs2::software_device _dev;
+    rs2::software_sensor _depth_sensor, _color_sensor, _raw_sensor;
+    rs2::stream_profile _depth, _ir, _color, _yuyv;
+    resolution _res;
+    mt19937 _rng{ 1234 };
+
+    mutex _mutex;
+    condition_variable _cv;
+    vector< rs2::frame > _received;
+
+    static void release( void * pixels ) { delete[] static_cast< uint8_t * >( pixels ); }
+
+    rs2_intrinsics intrinsics() const
+    {
+        rs2_intrinsics i = {};
+        i.width = _res.width;
+        i.height = _res.height;
+        i.ppx = _res.width / 2.f;
+        i.ppy = _res.height / 2.f;
+        i.fx = i.fy = _res.width * 0.9f;
+        i.model = RS2_DISTORTION_BROWN_CONRADY;
+        return i;
+    }
+
+    rs2::frame send( rs2::software_sensor & sensor, rs2::stream_profile const & profile, vector< uint8_t > const & pixels,
+                     int bpp, int number, float depth_units = 0.f )
+    {
+        // The frame owns a copy, so it can outlive the vector
+        auto data = new uint8_t[pixels.size()];
+        copy( pixels.begin(), pixels.end(), data );
+        size_t before;
+        {
+            lock_guard< mutex > lock( _mutex );
+            before = _received.size();
+        }
+        sensor.on_video_frame( { data, &release, _res.width * bpp, bpp,
+                                 number * 33.3, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, number, profile.get(), depth_units } );
+        unique_lock< mutex > lock( _mutex );
+        if( ! _cv.wait_for( lock, chrono::seconds( 1 ), [&]() { return _received.size() > before; } ) )
+            throw runtime_error( "the software device did not deliver a frame" );
+        return _received.back();
+    }
+
+    vector< uint8_t > depth_pixels( int number )
+    {
+        // A slanted plane with bumps, some noise, and holes where the stereo would have found nothing
+        vector< uint8_t > pixels( size_t( _res.width ) * _res.height * 2 );
+        auto z = reinterpret_cast< uint16_t * >( pixels.data() );
+        uniform_int_distribution< int > noise( -8, 8 ), hole( 0, 99 );
+        for( int y = 0; y < _res.height; ++y )
+            for( int x = 0; x < _res.width; ++x )
+            {
+                int v = 1000 + x * 2000 / _res.width + ( ( x / 40 + y / 40 + number ) % 3 ) * 50 + noise( _rng );
+                *z++ = uint16_t( hole( _rng ) < 3 ? 0 : v );
+            }
+        return pixels;
+    }
+
+    vector< uint8_t > pattern( int bpp, int number )
+    {
+        vector< uint8_t > pixels( size_t( _res.width ) * _res.height * bpp );
+        for( size_t i = 0; i < pixels.size(); ++i )
+            pixels[i] = uint8_t( i * 7 + i / _res.width * 3 + number );
+        return pixels;
+    }
+
+public:
+    explicit synthetic_camera( resolution res )
+        : _depth_sensor( _dev.add_sensor( "Depth" ) )
+        , _color_sensor( _dev.add_sensor( "Color" ) )
+        , _raw_sensor( _dev.add_sensor( "Raw" ) )
+        , _res( res )
+    {
+        auto in = intrinsics();
+        _depth = _depth_sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, res.width, res.height, 30, 2, RS2_FORMAT_Z16, in } );
+        _ir = _depth_sensor.add_video_stream( { RS2_STREAM_INFRARED, 1, 1, res.width, res.height, 30, 1, RS2_FORMAT_Y8, in } );
+        _color = _color_sensor.add_video_stream( { RS2_STREAM_COLOR, 0, 2, res.width, res.height, 30, 3, RS2_FORMAT_RGB8, in } );
+        _yuyv = _raw_sensor.add_video_stream( { RS2_STREAM_COLOR, 1, 3, res.width, res.height, 30, 2, RS2_FORMAT_YUYV, in } );
+        _depth_sensor.add_read_only_option( RS2_OPTION_DEPTH_UNITS, 0.001f );
+        _depth_sensor.add_read_only_option( RS2_OPTION_STEREO_BASELINE, 50.f );
+        _depth.register_extrinsics_to( _color, { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0.015f, 0, 0 } } );
+        _depth.register_extrinsics_to( _ir, { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0, 0, 0 } } );
+
+        auto on_frame = [this]( rs2::frame f )
+        {
+            lock_guard< mutex > lock( _mutex );
+            _received.push_back( f );
+            _cv.notify_all();
+        };
+        _depth_sensor.open( { _depth, _ir } );
+        _color_sensor.open( _color );
+        _raw_sensor.open( _yuyv );
+        _depth_sensor.start( on_frame );
+        _color_sensor.start( on_frame );
+        _raw_sensor.start( on_frame );
+    }
+
+    ~synthetic_camera()
+    {
+        for( auto s : { &_depth_sensor, &_color_sensor, &_raw_sensor } )
+        {
+            s->stop();
+            s->close();
+        }
+    }
+
+    inputs make( int n )
+    {
+        inputs in;
+        for( int i = 0; i < n; ++i )
+        {
+            // Alternating between the two exposures of an HDR sequence, as a camera would
+            _depth_sensor.set_metadata( RS2_FRAME_METADATA_FRAME_COUNTER, i );
+            _depth_sensor.set_metadata( RS2_FRAME_METADATA_SEQUENCE_SIZE, 2 );
+            _depth_sensor.set_metadata( RS2_FRAME_METADATA_SEQUENCE_ID, i % 2 );
+            in.depth.push_back( send( _depth_sensor, _depth, depth_pixels( i ), 2, i, 0.001f ) );
+            in.ir.push_back( send( _depth_sensor, _ir, pattern( 1, i ), 1, i ) );
+            in.color.push_back( send( _color_sensor, _color, pattern( 3, i ), 3, i ) );
+            in.yuyv.push_back( send( _raw_sensor, _yuyv, pattern( 2, i ), 2, i ) );
+            in.depth_color.push_back( bundle( { in.depth.back(), in.color.back() } ) );
+            in.hdr.push_back( bundle( { in.depth.back(), in.ir.back() } ) );
+        }
+        return in;
+    }
+};
+
+
+// The frames of a recording, as fast as they can be read
+static inputs from_recording( string const & path, int n, resolution & res )
+{
+    rs2::config cfg;
+    cfg.enable_device_from_file( path, false );
+    rs2::pipeline pipe;
+    auto profile = pipe.start( cfg );
+    profile.get_device().as< rs2::playback >().set_real_time( false );
+
+    inputs in;
+    rs2::frameset fs;
+    for( int i = 0; i < n && pipe.try_wait_for_frames( &fs, 5000 ); ++i )
+    {
+        auto depth = fs.first_or_default( RS2_STREAM_DEPTH, RS2_FORMAT_Z16 );
+        auto color = fs.first_or_default( RS2_STREAM_COLOR, RS2_FORMAT_RGB8 );
+        auto ir = fs.first_or_default( RS2_STREAM_INFRARED );
+        auto yuyv = fs.first_or_default( RS2_STREAM_COLOR, RS2_FORMAT_YUYV );
+        if( depth )
+        {
+            in.depth.push_back( depth );
+            auto vf = depth.as< rs2::video_frame >();
+            res = { vf.get_width(), vf.get_height() };
+        }
+        if( ir )
+            in.ir.push_back( ir );
+        if( color )
+            in.color.push_back( color );
+        if( yuyv )
+            in.yuyv.push_back( yuyv );
+        if( depth && color )
+            in.depth_color.push_back( bundle( { depth, color } ) );
+        if( depth && depth.supports_frame_metadata( RS2_FRAME_METADATA_SEQUENCE_ID ) )
+            in.hdr.push_back( fs );
+    }
+    pipe.stop();
+    if( in.depth.empty() && in.color.empty() )
+        throw runtime_error( "no depth or color frames in " + path );
+    return in;
+}
+
+
+struct result
+{
+    string block;
+    string implementation;  // The block's own name: which of its versions (e.g., SSE or CUDA) the build picked
+    resolution res;
+    int threads;
+    size_t frames;
+    double fps, mean_ms, p50_ms, p99_ms, allocations_per_frame;
+};
+
+
+struct benchmark
+{
+    string name;
+    function< shared_ptr< rs2::filter >() > make;
+    function< vector< rs2::frame >( inputs const & ) > frames;
+};
+
+
+static vector< rs2::frame > as_frames( vector< rs2::frameset > const & sets )
+{
+    return vector< rs2::frame >( sets.begin(), sets.end() );
+}
+
+
+static vector< benchmark > all_benchmarks()
+{
+    auto depth = []( inputs const & in ) { return in.depth; };
+    auto block = []( function< rs2::filter * () > make )
+    { return [make]() { return shared_ptr< rs2::filter >( make() ); }; };
+    return {
+        { "yuy-decoder", block( [] { return new rs2::yuy_decoder(); } ), []( inputs const & in ) { return in.yuyv; } },
+        { "align-to-color", block( [] { return new rs2::align( RS2_STREAM_COLOR ); } ),
+          []( inputs const & in ) { return as_frames( in.depth_color ); } },
+        { "align-to-depth", block( [] { return new rs2::align( RS2_STREAM_DEPTH ); } ),
+          []( inputs const & in ) { return as_frames( in.depth_color ); } },
+        { "pointcloud", block( [] { return new rs2::pointcloud(); } ), depth },
+        { "decimation", block( [] { return new rs2::decimation_filter(); } ), depth },
+        { "threshold", block( [] { return new rs2::threshold_filter(); } ), depth },
+        { "disparity", block( [] { return new rs2::disparity_transform( true ); } ), depth },
+        { "spatial", block( [] { return new rs2::spatial_filter(); } ), depth },
+        { "temporal", block( [] { return new rs2::temporal_filter(); } ), depth },
+        { "hole-filling", block( [] { return new rs2::hole_filling_filter(); } ), depth },
+        { "colorizer", block( [] { return new rs2::colorizer(); } ), depth },
+        { "units-transform", block( [] { return new rs2::units_transform(); } ), depth },
+        { "hdr-merge", block( [] { return new rs2::hdr_merge(); } ), []( inputs const & in ) { return as_frames( in.hdr ); } },
+    };
+}
+
+
+static result run( benchmark const & b, vector< rs2::frame > const & frames, resolution res, int threads, size_t n,
+                   size_t warmup )
+{
+    auto block = b.make();
+    if( block->supports( RS2_OPTION_FILTER_THREADS ) )
+        block->set_option( RS2_OPTION_FILTER_THREADS, float( threads ) );
+
+    for( size_t i = 0; i < warmup; ++i )
+        block->process( frames[i % frames.size()] );
+
+    vector< double > latencies;
+    latencies.reserve( n );
+    auto allocations = n_allocations.load();
+    auto start = chrono::steady_clock::now();
+    for( size_t i = 0; i < n; ++i )
+    {
+        auto t0 = chrono::steady_clock::now();
+        auto out = block->process( frames[i % frames.size()] );
+        auto t1 = chrono::steady_clock::now();
+        latencies.push_back( chrono::duration< double, milli >( t1 - t0 ).count() );
+    }
+    auto total = chrono::duration< double >( chrono::steady_clock::now() - start ).count();
+    allocations = n_allocations.load() - allocations;
+
+    result r;
+    r.block = b.name;
+    r.implementation = block->supports( RS2_CAMERA_INFO_NAME ) ? block->get_info( RS2_CAMERA_INFO_NAME ) : b.name;
+    r.res = res;
+    r.threads = threads;
+    r.frames = n;
+    r.fps = total > 0 ? n / total : 0;
+    r.mean_ms = 0;
+    for( auto l : latencies )
+        r.mean_ms += l / n;
+    sort( latencies.begin(), latencies.end() );
+    r.p50_ms = latencies[n / 2];
+    r.p99_ms = latencies[min( n - 1, n * 99 / 100 )];
+    r.allocations_per_frame = double( allocations ) / n;
+    return r;
+}
+
+
+static string json_string( string const & s )
+{
+    ostringstream os;
+    os << '"';
+    for( char c : s )
+        if( c == '"' || c == '\\' )
+            os << '\\' << c;
+        else
+            os << c;
+    os << '"';
+    return os.str();
+}
+
+
+static void write_json( ostream & os, vector< result > const & results, string const & source )
+{
+    os << "{\n  \"version\": " << json_string( RS2_API_FULL_VERSION_STR ) << ",\n  \"source\": " << json_string( source )
+       << ",\n  \"results\": [";
+    for( size_t i = 0; i < results.size(); ++i )
+    {
+        auto & r = results[i];
+        os << ( i ? "," : "" ) << "\n    { \"block\": " << json_string( r.block )
+           << ", \"implementation\": " << json_string( r.implementation ) << ", \"width\": " << r.res.width
+           << ", \"height\": " << r.res.height << ", \"threads\": " << r.threads << ", \"frames\": " << r.frames
+           << ", \"fps\": " << r.fps << ", \"mean_ms\": " << r.mean_ms << ", \"p50_ms\": " << r.p50_ms
+           << ", \"p99_ms\": " << r.p99_ms << ", \"allocations_per_frame\": " << r.allocations_per_frame << " }";
+    }
+    os << "\n  ]\n}\n";
+}
+
+
+template< class T >
+static vector< T > parse_list( string const & s, function< T( string const & ) > parse )
+{
+    vector< T > result;
+    stringstream ss( s );
+    string item;
+    while( getline( ss, item, ',' ) )
+        if( ! item.empty() )
+            result.push_back( parse( item ) );
+    return result;
+}
+
+
+int main( int argc, char * argv[] ) try
+{
+    CmdLine cmd( "librealsense rs-pb-benchmark tool: processing blocks, without a camera", ' ', RS2_API_VERSION_STR );
+    ValueArg< string > resolutions_arg( "r", "resolutions", "Synthetic frame sizes, e.g. 640x480,1280x720", false,
+                                        "640x480,1280x720", "WxH,..." );
+    ValueArg< string > threads_arg( "t", "threads", "Thread counts, for the blocks that can split a frame", false,
+                                    "1,2,4", "N,..." );
+    ValueArg< int > frames_arg( "n", "frames", "Frames to time, per block and setting", false, 300, "count" );
+    ValueArg< int > warmup_arg( "w", "warmup", "Frames to process before timing", false, 30, "count" );
+    ValueArg< string > blocks_arg( "b", "blocks", "Only the blocks whose names have any of these", false, "", "name,..." );
+    ValueArg< string > bag_arg( "f", "file", "Recording to take the frames from, instead of synthetic ones", false, "",
+                                "path" );
+    ValueArg< string > output_arg( "o", "output", "JSON file to write the results to", false, "", "path" );
+    SwitchArg list_arg( "l", "list", "List the blocks, and exit" );
+    cmd.add( resolutions_arg );
+    cmd.add( threads_arg );
+    cmd.add( frames_arg );
+    cmd.add( warmup_arg );
+    cmd.add( blocks_arg );
+    cmd.add( bag_arg );
+    cmd.add( output_arg );
+    cmd.add( list_arg );
+    cmd.parse( argc, argv );
+
+    auto benchmarks = all_benchmarks();
+    if( list_arg.getValue() )
+    {
+        for( auto & b : benchmarks )
+            cout << b.name << endl;
+        return EXIT_SUCCESS;
+    }
+    auto filters = parse_list< string >( blocks_arg.getValue(), []( string const & s ) { return s; } );
+    auto wanted = [&]( benchmark const & b )
+    {
+        return filters.empty()
+            || any_of( filters.begin(), filters.end(), [&]( string const & f ) { return b.name.find( f ) != string::npos; } );
+    };
+    auto thread_counts = parse_list< int >( threads_arg.getValue(), []( string const & s ) { return max( 1, stoi( s ) ); } );
+    auto resolutions = parse_list< resolution >( resolutions_arg.getValue(),
+                                                 []( string const & s )
+                                                 {
+                                                     resolution r;
+                                                     char x;
+                                                     istringstream is( s );
+                                                     if( ! ( is >> r.width >> x >> r.height ) || x != 'x'
+                                                         || r.width <= 0 || r.height <= 0 )
+                                                         throw runtime_error( "invalid resolution: " + s );
+                                                     return r;
+                                                 } );
+    size_t const n = size_t( max( 1, frames_arg.getValue() ) );
+    size_t const warmup = size_t( max( 0, warmup_arg.getValue() ) );
+
+    // Distinct frames to cycle through, so the blocks with history see it change
+    int const n_inputs = 8;
+    vector< pair< resolution, inputs > > sets;
+    vector< unique_ptr< synthetic_camera > > cameras;  // Kept alive while their frames are
+    string source = "synthetic";
+    if( bag_arg.isSet() )
+    {
+        source = bag_arg.getValue();
+        resolution res = { 0, 0 };
+        auto in = from_recording( source, n_inputs, res );
+        sets.emplace_back( res, move( in ) );
+    }
+    else
+        for( auto res : resolutions )
+        {
+            cameras.emplace_back( new synthetic_camera( res ) );
+            sets.emplace_back( res, cameras.back()->make( n_inputs ) );
+        }
+
+    cout << left << setw( 16 ) << "block" << setw( 28 ) << "implementation" << setw( 11 ) << "resolution" << right
+         << setw( 8 ) << "threads" << setw( 10 ) << "fps" << setw( 10 ) << "p50 ms" << setw( 10 ) << "p99 ms"
+         << setw( 10 ) << "allocs" << endl;
+    vector< result > results;
+    for( auto & set : sets )
+        for( auto & b : benchmarks )
+        {
+            if( ! wanted( b ) )
+                continue;
+            auto frames = b.frames( set.second );
+            if( frames.empty() )
+                continue;  // Not in the recording
+            bool threaded = b.make()->supports( RS2_OPTION_FILTER_THREADS );
+            for( auto threads : thread_counts )
+            {
+                if( threads > 1 && ! threaded )
+                    continue;
+                auto r = run( b, frames, set.first, threads, n, warmup );
+                ostringstream res;
+                res << r.res.width << 'x' << r.res.height;
+                cout << left << setw( 16 ) << r.block << setw( 28 ) << r.implementation.substr( 0, 27 ) << setw( 11 )
+                     << res.str() << right << setw( 8 ) << r.threads << fixed << setprecision( 1 ) << setw( 10 )
+                     << r.fps << setprecision( 3 ) << setw( 10 ) << r.p50_ms << setw( 10 ) << r.p99_ms
+                     << setprecision( 1 ) << setw( 10 ) << r.allocations_per_frame << endl;
+                results.push_back( r );
+            }
+        }
+
+    if( output_arg.isSet() )
+    {
+        ofstream file( output_arg.getValue() );
+        if( ! file )
+            throw runtime_error( "failed to open " + output_arg.getValue() );
+        write_json( file, results, source );
+    }
+    return EXIT_SUCCESS;
+}
+catch( const rs2::error & e )
+{
+    cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what()
+         << endl;
+    return EXIT_FAILURE;
+}
+catch( const exception & e )
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
@@ -7,6 +7,7 @@
 #include "post-processing-worker-filter.h"
 
 #include <rs-vino/object-detection.h>
+#include <rs-vino/inference-scheduler.h>
 #include <rs-vino/age-gender-detection.h>
 #include <rs-vino/detected-object.h>
 #include <cv-helpers.hpp>
@@ -66,7 +67,8 @@ public:
 class openvino_face_detection : public post_processing_worker_filter
 {
     InferenceEngine::Core _ie;
-    openvino_helpers::object_detection _face_detector;
+    std::shared_ptr< openvino_helpers::inference_scheduler > _face_detector;
+    size_t _camera = 0;
     openvino_helpers::age_gender_detection _age_detector;
     openvino_helpers::detected_objects _faces;
     size_t _id = 0;
@@ -76,16 +78,6 @@ class openvino_face_detection : public post_processing_worker_filter
 public:
     openvino_face_detection( std::string const & name )
         : post_processing_worker_filter( name )
-        /*
-            This face detector is from the OpenCV Model Zoo:
-            https://github.com/opencv/open_model_zoo/blob/master/models/intel/face-detection-adas-0001/description/face-detection-adas-0001.md
-        */
-        , _face_detector(
-            "face-detection-adas-0001.xml",
-            0.5,    // Probability threshold
-            false ) // Not async
-        /*
-        */
         , _age_detector(
             "age-gender-recognition-retail-0013.xml",
             false ) // Not async
@@ -116,10 +108,44 @@ private:
         _ie.AddExtension(std::make_shared< openvino::Extensions::Cpu::CpuExtensions >(), device_name);
 #endif
 
-        _face_detector.load_into( _ie, device_name);
+        _face_detector = shared_face_detector( device_name );
+        _camera = _face_detector->add_camera( std::chrono::milliseconds( 15 ) );
         _age_detector.load_into( _ie, device_name);
     }
 
+    void worker_end() override
+    {
+        if( _face_detector )
+            _face_detector->remove_camera( _camera );
+    }
+
+    /*
+        All the cameras share the face detector, so their frames are inferred in the same batches
+    */
+    static std::shared_ptr< openvino_helpers::inference_scheduler > shared_face_detector( std::string const & device_name )
+    {
+        static std::mutex mutex;
+        static std::weak_ptr< openvino_helpers::inference_scheduler > instance;
+
+        std::lock_guard< std::mutex > lock( mutex );
+        auto detector = instance.lock();
+        if( !detector )
+        {
+            /*
+                This face detector is from the OpenCV Model Zoo:
+                https://github.com/opencv/open_model_zoo/blob/master/models/intel/face-detection-adas-0001/description/face-detection-adas-0001.md
+            */
+            detector = std::make_shared< openvino_helpers::inference_scheduler >(
+                "face-detection-adas-0001.xml",
+                0.5,    // Probability threshold
+                device_name,
+                8,      // Cameras in a batch
+                2 );    // Batches in flight
+            instance = detector;
+        }
+        return detector;
+    }
+
     /*
         Returns the "intensity" of the face in the picture, and calculates the distance to it, ignoring
         Invalid depth pixels or those outside a range that would be appropriate for a face.
@@ -242,10 +268,8 @@ private:
 
             objects_in_frame objects;
 
+            auto results = _face_detector->submit( _camera, cf ).get();
             cv::Mat image( color_intrin.height, color_intrin.width, CV_8UC3, const_cast<void *>(cf.get_data()), cv::Mat::AUTO_STEP );
-            _face_detector.enqueue( image );
-            _face_detector.submit_request();
-            auto results = _face_detector.fetch_results();
 
             openvino_helpers::detected_objects prev_faces { std::move( _faces ) };
             _faces.clear();
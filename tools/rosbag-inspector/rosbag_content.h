@@ -5,6 +5,8 @@
 
 #include <string>
 #include <regex>
+#include <memory>
+#include <vector>
 
 #include <realsense-file/rosbag/rosbag_storage/include/rosbag/bag.h>
 #include <realsense-file/rosbag/rosbag_storage/include/rosbag/view.h>
@@ -27,18 +29,61 @@ namespace rosbag_inspector
         uint64_t uncompressed;
     };
 
+    struct topic_info
+    {
+        std::string data_type;      // Of its first connection
+        uint32_t messages = 0;
+    };
+
+    // The messages of a topic, in the order of their time. They are taken off the bag's index as far as they're asked
+    // for, and nothing is read from the file until their contents are.
+    class topic_messages
+    {
+    public:
+        topic_messages(const rosbag::Bag& bag, const std::string& topic)
+            : _view(new rosbag::View(bag, rosbag::TopicQuery(topic)))
+            , _next(_view->begin())
+            , _end(_view->end())
+            , _count(_view->size())
+        {}
+
+        size_t size() const { return _count; }
+
+        const rosbag::MessageInstance& operator[](size_t index)
+        {
+            while (_messages.size() <= index && _next != _end)
+            {
+                _messages.push_back(*_next);
+                ++_next;
+            }
+            if (index >= _messages.size())
+                throw std::out_of_range(std::string("message: ") + std::to_string(index));
+            return _messages[index];
+        }
+
+    private:
+        std::unique_ptr<rosbag::View> _view;    // Its iterators point to it
+        rosbag::View::iterator _next, _end;
+        size_t _count;
+        std::vector<rosbag::MessageInstance> _messages;
+    };
+
     struct rosbag_content
     {
         rosbag_content(const std::string& file)
         {
+            // Only the connections and the chunks' indices are read, not the messages
             bag.open(file);
 
             rosbag::View entire_bag_view(bag);
-
-            for (auto&& m : entire_bag_view)
+            for (auto connection : entire_bag_view.getConnections())
             {
-                topics_to_message_types[m.getTopic()].push_back(m.getDataType());
+                auto& topic = topics[connection->topic];
+                if (topic.data_type.empty())
+                    topic.data_type = connection->datatype;
             }
+            for (auto&& topic : topics)
+                topic.second.messages = rosbag::View(bag, rosbag::TopicQuery(topic.first)).size();
 
             path = bag.getFileName();
             for (auto rit = path.rbegin(); rit != path.rend(); ++rit)
@@ -55,32 +100,32 @@ namespace rosbag_inspector
             compression_info = bag.getCompressionInfo();
         }
 
+        // The messages and the selection are for the bag they were taken off, and are taken again as needed
         rosbag_content(const rosbag_content& other)
         {
             bag.open(other.path);
-            cache = other.cache;
             file_duration = other.file_duration;
             file_name = other.file_name;
             path = other.path;
             version = other.version;
             size = other.size;
             compression_info = other.compression_info;
-            topics_to_message_types = other.topics_to_message_types;
+            topics = other.topics;
         }
         rosbag_content(rosbag_content&& other)
         {
+            other.messages.clear();
             other.bag.close();
             bag.open(other.path);
-            cache = other.cache;
             file_duration = other.file_duration;
             file_name = other.file_name;
             path = other.path;
             version = other.version;
             size = other.size;
             compression_info = other.compression_info;
-            topics_to_message_types = other.topics_to_message_types;
+            topics = other.topics;
 
-            other.cache.clear();
+            other.clear_selection();
             other.file_duration = std::chrono::nanoseconds::zero();
             other.file_name.clear();
             other.path.clear();
@@ -89,19 +134,47 @@ namespace rosbag_inspector
             other.compression_info.compressed = 0;
             other.compression_info.uncompressed = 0;
             other.compression_info.compression_type = "";
-            other.topics_to_message_types.clear();
+            other.topics.clear();
+        }
+
+        topic_messages& messages_of(const std::string& topic)
+        {
+            auto it = messages.find(topic);
+            if (it == messages.end())
+                it = messages.emplace(topic, std::unique_ptr<topic_messages>(new topic_messages(bag, topic))).first;
+            return *it->second;
+        }
+
+        bool is_selected(const std::string& topic, size_t index) const
+        {
+            return has_selection && selected_topic == topic && selected_index == index;
         }
-        std::string instanciate_and_cache(const rosbag::MessageInstance& m, uint64_t count)
+        bool has_selected(const std::string& topic) const { return has_selection && selected_topic == topic; }
+
+        // Only the selected message is read and decoded, once
+        void select(const std::string& topic, size_t index)
         {
-            auto key = std::make_tuple(m.getCallerId(), m.getDataType(), m.getMD5Sum(), m.getTopic(), m.getTime(), count);
-            if (cache.find(key) != cache.end())
+            if (is_selected(topic, index))
+                return;
+            try
+            {
+                std::ostringstream oss;
+                oss << messages_of(topic)[index];
+                selected_content = oss.str();
+            }
+            catch (const std::exception& e)
             {
-                return cache[key];
+                selected_content = tmpstringstream() << "Failed to read the message: " << e.what();
             }
-            std::ostringstream oss;
-            oss << m;
-            cache[key] = oss.str();
-            return oss.str();
+            selected_topic = topic;
+            selected_index = index;
+            has_selection = true;
+        }
+        void clear_selection()
+        {
+            has_selection = false;
+            selected_topic.clear();
+            selected_content.clear();
         }
 
         std::chrono::nanoseconds get_duration(const rosbag::Bag& bag)
@@ -113,14 +186,18 @@ namespace rosbag_inspector
             return std::chrono::nanoseconds((only_frames.getEndTime() - only_frames.getBeginTime()).toNSec());
         }
 
-        std::map<std::tuple<std::string, std::string, std::string, std::string, rs2rosinternal::Time, uint64_t>, std::string> cache;
         std::chrono::nanoseconds file_duration;
         std::string file_name;
         std::string path;
         std::string version;
         double size;
         rosbag_inspector::compression_info compression_info;
-        std::map<std::string, std::vector<std::string>> topics_to_message_types;
+        std::map<std::string, topic_info> topics;
         rosbag::Bag bag;
+        std::map<std::string, std::unique_ptr<topic_messages>> messages;  // Of the topics opened so far; after the bag they're of
+        bool has_selection = false;
+        std::string selected_topic;
+        size_t selected_index = 0;
+        std::string selected_content;
     };
 }
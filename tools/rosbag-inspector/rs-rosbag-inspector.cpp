@@ -35,7 +35,6 @@
 using namespace rosbag_inspector;
 
 files_container files; // Container of loaded files
-std::map<std::string, uint64_t> num_topics_to_show;
 
 class gui_window
 {
@@ -174,7 +173,6 @@ int draw_files_left_panel(int flags)
         if (ImGui::Selectable(files[i].file_name.c_str(), selected == i, 0, ImVec2(100, 0)))
         {
             selected = i;
-            num_topics_to_show.clear();
         }
         ImGui::PopStyleColor(4);
         if (ImGui::IsItemHovered())
@@ -227,6 +225,36 @@ int draw_files_left_panel(int flags)
 
     return selected;
 }
+// The messages of a topic are listed by their timestamp, and only those in sight are taken off the index. The one
+// clicked is the only one read and decoded.
+void draw_topic_messages(rosbag_content& bag, const std::string& topic)
+{
+    constexpr size_t max_rows_in_sight = 12;
+    auto& messages = bag.messages_of(topic);
+    const float row_height = ImGui::GetTextLineHeightWithSpacing();
+
+    ImGui::Indent(20);
+    ImGui::PushStyleColor(ImGuiCol_Header, grey);
+    ImGui::PushStyleColor(ImGuiCol_HeaderHovered, light_grey);
+    std::string list_id = "##messages " + topic;
+    auto rows = std::min(messages.size(), max_rows_in_sight);
+    ImGui::BeginChild(list_id.c_str(), ImVec2(0, rows * row_height + 2 * ImGui::GetStyle().WindowPadding.y), true);
+    ImGuiListClipper clipper(int(messages.size()), row_height);
+    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+    {
+        std::string label = tmpstringstream() << pretty_time(std::chrono::nanoseconds(messages[i].getTime().toNSec())) << "##" << i;
+        if (ImGui::Selectable(label.c_str(), bag.is_selected(topic, i)))
+            bag.select(topic, i);
+    }
+    clipper.End();
+    ImGui::EndChild();
+    ImGui::PopStyleColor(2);
+
+    if (bag.has_selected(topic))
+        ImGui::TextWrapped("%s", bag.selected_content.c_str());
+    ImGui::Unindent(20);
+}
+
 void draw_bag_content(rosbag_content& bag, int flags)
 {
     ImGui::BeginChild("Bag Content", ImVec2(0, 0), false, flags);
@@ -241,59 +269,21 @@ void draw_bag_content(rosbag_content& bag, int flags)
     ImGui::Text("\t%s", std::string(tmpstringstream() << std::left << std::setw(20) << "compressed: " << bag.compression_info.compressed).c_str());
     if (ImGui::CollapsingHeader("Topics"))
     {
-        for (auto&& topic_to_message_type : bag.topics_to_message_types)
+        for (auto&& topic_to_info : bag.topics)
         {
-            std::string topic = topic_to_message_type.first;
-            std::vector<std::string> messages_types = topic_to_message_type.second;
+            std::string topic = topic_to_info.first;
+            auto& info = topic_to_info.second;
             std::ostringstream oss;
             int max_topic_len = 100;
             oss << std::left << std::setw(max_topic_len) << topic
-                << " " << std::left << std::setw(10) << messages_types.size() << std::setw(6) << std::string(" msg") + (messages_types.size() > 1 ? "s" : "")
-                << ": " << std::left << std::setw(40) << messages_types.front() << std::endl;
+                << " " << std::left << std::setw(10) << info.messages << std::setw(6) << std::string(" msg") + (info.messages > 1 ? "s" : "")
+                << ": " << std::left << std::setw(40) << info.data_type << std::endl;
             std::string line = oss.str();
             auto pos = ImGui::GetCursorPos();
             ImGui::SetCursorPos({ pos.x + 20, pos.y });
             if (ImGui::CollapsingHeader(line.c_str()))
             {
-                rosbag::View messages(bag.bag, rosbag::TopicQuery(topic));
-                uint64_t count = 0;
-                constexpr uint64_t num_next_items_to_show = 10;
-                num_topics_to_show[topic] = std::max(num_topics_to_show[topic], num_next_items_to_show);
-                uint64_t max = num_topics_to_show[topic];
-                auto win_pos = ImGui::GetWindowPos();
-                ImGui::SetWindowPos({ win_pos.x + 20, win_pos.y });
-                for (auto&& m : messages)
-                {
-                    count++;
-                    ImGui::Columns(2, "Message", true);
-                    ImGui::Separator();
-                    ImGui::Text("Timestamp"); ImGui::NextColumn();
-                    ImGui::Text("Content"); ImGui::NextColumn();
-                    ImGui::Separator();
-                    ImGui::Text("%s", pretty_time(std::chrono::nanoseconds(m.getTime().toNSec())).c_str()); ImGui::NextColumn();
-                    ImGui::Text("%s", bag.instanciate_and_cache(m, count).c_str());
-                    ImGui::Columns(1);
-                    ImGui::Separator();
-                    if (count >= max)
-                    {
-                        int left = messages.size() - max;
-                        if (left > 0)
-                        {
-                            ImGui::Text("... %d more messages", left);
-                            ImGui::SameLine();
-                            std::string label = tmpstringstream() << "Show More ##" << topic;
-                            if (ImGui::Button(label.c_str()))
-                            {
-                                num_topics_to_show[topic] += 10;
-                            }
-                            else
-                            {
-                                break;
-                            }
-                        }
-                    }
-                }
-                ImGui::SetWindowPos(win_pos);
+                draw_topic_messages(bag, topic);
             }
 
             if (ImGui::IsItemHovered())
@@ -0,0 +1,439 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// Benchmarks the syncer without a camera: software devices, with streams of any frame rate, send frames as fast as
+// the syncer takes them, with the jitter, drops and reordering asked for. Which frames are sent, and in what order,
+// is decided by a fixed seed, so runs can be compared across builds -- of matcher changes, to begin with. The
+// results are the framesets per second, the latency of the frames through the syncer, and the memory used.
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+
+using namespace std;
+using namespace TCLAP;
+
+
+// Latencies, in a fixed number of buckets: the syncer's are mostly well under a millisecond
+class histogram
+{
+    static constexpr double bucket_ms = 0.01;
+    static constexpr size_t n_buckets = 200000;  // Up to 2 seconds; anything longer counts as that
+
+    vector< uint64_t > _counts = vector< uint64_t >( n_buckets, 0 );
+    uint64_t _total = 0;
+    double _max = 0;
+
+public:
+    void add( double ms )
+    {
+        auto i = size_t( max( 0., ms ) / bucket_ms );
+        ++_counts[min( i, n_buckets - 1 )];
+        ++_total;
+        _max = max( _max, ms );
+    }
+
+    uint64_t count() const { return _total; }
+    double maximum() const { return _max; }
+
+    double percentile( double p ) const
+    {
+        if( ! _total )
+            return 0;
+        auto rank = uint64_t( p / 100. * ( _total - 1 ) );
+        uint64_t seen = 0;
+        for( size_t i = 0; i < n_buckets; ++i )
+        {
+            seen += _counts[i];
+            if( seen > rank )
+                return ( i + 0.5 ) * bucket_ms;
+        }
+        return _max;
+    }
+};
+
+
+static double now_ms()
+{
+    return chrono::duration< double, milli >( chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+// The most memory the process has had, in KB, or 0 where the OS doesn't tell (only Linux, for now)
+static long memory_high_water_kb()
+{
+#ifdef __linux__
+    ifstream status( "/proc/self/status" );
+    string line;
+    while( getline( status, line ) )
+        if( line.compare( 0, 6, "VmHWM:" ) == 0 )
+            return atol( line.c_str() + 6 );
+#endif
+    return 0;
+}
+
+
+struct settings
+{
+    int devices = 2;
+    int streams = 2;            // Per device
+    vector< int > fps;          // Taken by the streams in turn
+    int width = 64, height = 48;
+    double seconds = 60;        // Of the streams' time, not the benchmark's
+    double jitter_ms = 0;       // Timestamps are off by up to this much, either way
+    double drop_percent = 0;    // Frames never sent
+    double reorder_percent = 0; // Frames sent after the one that should have followed them
+    int queue_size = 16;        // Of the syncer's output
+    unsigned seed = 1234;
+};
+
+
+// A stream of one of the software devices
+struct stream
+{
+    rs2::software_sensor * sensor;
+    rs2::stream_profile profile;
+    int fps, bpp;
+    vector< uint8_t > pixels;   // The same for all the frames: the syncer doesn't look at them
+    vector< double > sent_ms;   // By frame number
+    uint64_t sent = 0;
+};
+
+
+// A frame, when it's to be sent
+struct event
+{
+    size_t stream;
+    int number;
+    double timestamp;
+};
+
+
+static void keep( void * ) {}
+
+
+class benchmark
+{
+    settings _settings;
+    vector< unique_ptr< rs2::software_device > > _devices;
+    vector< unique_ptr< rs2::software_sensor > > _sensors;
+    vector< stream > _streams;
+    map< int, size_t > _by_uid;
+    vector< event > _events;
+
+    rs2_intrinsics intrinsics() const
+    {
+        rs2_intrinsics i = {};
+        i.width = _settings.width;
+        i.height = _settings.height;
+        i.ppx = i.width / 2.f;
+        i.ppy = i.height / 2.f;
+        i.fx = i.fy = i.width * 0.9f;
+        return i;
+    }
+
+    void add_devices()
+    {
+        // Depth first, then the infrared and color streams that a camera would have with it
+        static const rs2_stream types[] = { RS2_STREAM_DEPTH, RS2_STREAM_INFRARED, RS2_STREAM_COLOR };
+        static const rs2_format formats[] = { RS2_FORMAT_Z16, RS2_FORMAT_Y8, RS2_FORMAT_RGB8 };
+        static const int bpps[] = { 2, 1, 3 };
+
+        int uid = 0;
+        for( int d = 0; d < _settings.devices; ++d )
+        {
+            _devices.emplace_back( new rs2::software_device() );
+            auto & dev = *_devices.back();
+            dev.register_info( RS2_CAMERA_INFO_NAME, "Sync Benchmark Device" );
+            dev.register_info( RS2_CAMERA_INFO_SERIAL_NUMBER, to_string( d ) );
+            dev.create_matcher( RS2_MATCHER_DEFAULT );
+            _sensors.emplace_back( new rs2::software_sensor( dev.add_sensor( "Sensor " + to_string( d ) ) ) );
+            auto & sensor = *_sensors.back();
+            sensor.add_read_only_option( RS2_OPTION_DEPTH_UNITS, 0.001f );
+
+            vector< rs2::stream_profile > profiles;
+            for( int s = 0; s < _settings.streams; ++s )
+            {
+                const int kind = s == 0 ? 0 : 1 + ( s - 1 ) % 2;
+                const int fps = _settings.fps[_streams.size() % _settings.fps.size()];
+                stream st;
+                st.sensor = &sensor;
+                st.fps = fps;
+                st.bpp = bpps[kind];
+                st.profile = sensor.add_video_stream( { types[kind], s, uid, _settings.width, _settings.height, fps,
+                                                        st.bpp, formats[kind], intrinsics() } );
+                st.pixels.assign( size_t( _settings.width ) * _settings.height * st.bpp, uint8_t( s ) );
+                _by_uid[uid++] = _streams.size();
+                profiles.push_back( st.profile );
+                _streams.push_back( move( st ) );
+            }
+            sensor.open( profiles );
+        }
+    }
+
+    // What's sent when: the same for the same settings, every run
+    void schedule()
+    {
+        mt19937 rng( _settings.seed );
+        uniform_real_distribution< double > jitter( -_settings.jitter_ms, _settings.jitter_ms );
+        uniform_real_distribution< double > percent( 0, 100 );
+        for( size_t s = 0; s < _streams.size(); ++s )
+        {
+            auto & st = _streams[s];
+            const int frames = max( 1, int( _settings.seconds * st.fps ) );
+            st.sent_ms.assign( size_t( frames ) + 1, 0. );
+            // Not all of the devices' clocks start together
+            const double start = 1000. + 3.7 * double( s / size_t( _settings.streams ) );
+            for( int n = 1; n <= frames; ++n )
+            {
+                double timestamp = start + ( n - 1 ) * 1000. / st.fps + ( _settings.jitter_ms ? jitter( rng ) : 0. );
+                if( _settings.drop_percent && percent( rng ) < _settings.drop_percent )
+                    continue;
+                _events.push_back( { s, n, timestamp } );
+            }
+        }
+        stable_sort( _events.begin(), _events.end(),
+                     []( event const & a, event const & b ) { return a.timestamp < b.timestamp; } );
+        if( _settings.reorder_percent )
+            for( size_t i = 0; i + 1 < _events.size(); ++i )
+                if( percent( rng ) < _settings.reorder_percent )
+                {
+                    swap( _events[i], _events[i + 1] );
+                    ++i;  // Not again, or the frame could keep moving back
+                }
+    }
+
+public:
+    explicit benchmark( settings const & s )
+        : _settings( s )
+    {
+        add_devices();
+        schedule();
+    }
+
+    size_t n_streams() const { return _streams.size(); }
+    size_t n_events() const { return _events.size(); }
+
+    struct result
+    {
+        double seconds = 0;
+        uint64_t frames_sent = 0, frames_out = 0;
+        uint64_t framesets = 0, complete_framesets = 0;
+        histogram latency;
+        long memory_kb = 0;
+    };
+
+    void run( result & r )
+    {
+        rs2::syncer sync( _settings.queue_size );
+        for( auto & sensor : _sensors )
+            sensor->start( sync );
+
+        atomic< bool > sending( true );
+        double first_sent = 0, last_out = 0;
+
+        // Frames are taken out of the syncer as soon as they come out, on a thread of their own, as an application
+        // would; the latency is from the frame being handed to the software sensor
+        thread consumer( [&]()
+        {
+            rs2::frameset fs;
+            auto idle_since = now_ms();
+            while( true )
+            {
+                if( ! sync.try_wait_for_frames( &fs, 100 ) )
+                {
+                    if( ! sending && now_ms() - idle_since > 500 )
+                        break;
+                    continue;
+                }
+                auto now = now_ms();
+                idle_since = now;
+                last_out = now;
+                ++r.framesets;
+                if( fs.size() == _streams.size() )
+                    ++r.complete_framesets;
+                for( auto f : fs )
+                {
+                    auto it = _by_uid.find( f.get_profile().unique_id() );
+                    if( it == _by_uid.end() )
+                        continue;
+                    auto & st = _streams[it->second];
+                    auto number = size_t( f.get_frame_number() );
+                    if( number < st.sent_ms.size() && st.sent_ms[number] )
+                        r.latency.add( now - st.sent_ms[number] );
+                    ++r.frames_out;
+                }
+            }
+        } );
+
+        first_sent = now_ms();
+        for( auto & e : _events )
+        {
+            auto & st = _streams[e.stream];
+            st.sent_ms[size_t( e.number )] = now_ms();
+            st.sensor->on_video_frame( { st.pixels.data(), &keep, _settings.width * st.bpp, st.bpp, e.timestamp,
+                                         RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, e.number, st.profile.get(), 0.001f } );
+            ++st.sent;
+            ++r.frames_sent;
+        }
+        sending = false;
+        consumer.join();
+
+        for( auto & sensor : _sensors )
+        {
+            sensor->stop();
+            sensor->close();
+        }
+        r.seconds = max( 0., last_out - first_sent ) / 1000.;
+        r.memory_kb = memory_high_water_kb();
+    }
+};
+
+
+static string json_string( string const & s )
+{
+    ostringstream os;
+    os << '"';
+    for( char c : s )
+        if( c == '"' || c == '\\' )
+            os << '\\' << c;
+        else
+            os << c;
+    os << '"';
+    return os.str();
+}
+
+
+static void write_json( ostream & os, settings const & s, benchmark::result const & r )
+{
+    os << "{\n  \"version\": " << json_string( RS2_API_FULL_VERSION_STR ) << ",\n  \"settings\": { \"devices\": "
+       << s.devices << ", \"streams\": " << s.streams << ", \"fps\": [";
+    for( size_t i = 0; i < s.fps.size(); ++i )
+        os << ( i ? ", " : "" ) << s.fps[i];
+    os << "], \"width\": " << s.width << ", \"height\": " << s.height << ", \"seconds\": " << s.seconds
+       << ", \"jitter_ms\": " << s.jitter_ms << ", \"drop_percent\": " << s.drop_percent
+       << ", \"reorder_percent\": " << s.reorder_percent << ", \"queue_size\": " << s.queue_size
+       << ", \"seed\": " << s.seed << " },\n  \"seconds\": " << r.seconds << ",\n  \"frames_sent\": " << r.frames_sent
+       << ",\n  \"frames_out\": " << r.frames_out << ",\n  \"framesets\": " << r.framesets
+       << ",\n  \"complete_framesets\": " << r.complete_framesets << ",\n  \"framesets_per_second\": "
+       << ( r.seconds > 0 ? r.framesets / r.seconds : 0 ) << ",\n  \"latency\": { \"count\": " << r.latency.count()
+       << ", \"p50_ms\": " << r.latency.percentile( 50 ) << ", \"p90_ms\": " << r.latency.percentile( 90 )
+       << ", \"p99_ms\": " << r.latency.percentile( 99 ) << ", \"max_ms\": " << r.latency.maximum()
+       << " },\n  \"memory_high_water_kb\": " << r.memory_kb << "\n}\n";
+}
+
+
+template< class T >
+static vector< T > parse_list( string const & s, function< T( string const & ) > parse )
+{
+    vector< T > result;
+    stringstream ss( s );
+    string item;
+    while( getline( ss, item, ',' ) )
+        if( ! item.empty() )
+            result.push_back( parse( item ) );
+    return result;
+}
+
+
+int main( int argc, char * argv[] ) try
+{
+    CmdLine cmd( "librealsense rs-sync-benchmark tool: the syncer, on software devices", ' ', RS2_API_VERSION_STR );
+    ValueArg< int > devices_arg( "k", "devices", "Software devices", false, 2, "count" );
+    ValueArg< int > streams_arg( "s", "streams", "Streams per device", false, 2, "count" );
+    ValueArg< string > fps_arg( "r", "fps", "Frame rates, taken by the streams in turn", false, "30", "fps,..." );
+    ValueArg< string > resolution_arg( "z", "resolution", "Frame size", false, "64x48", "WxH" );
+    ValueArg< double > seconds_arg( "t", "time", "Seconds of the streams' time to send the frames of", false, 60,
+                                    "seconds" );
+    ValueArg< double > jitter_arg( "j", "jitter", "Timestamps are off by up to this much, either way", false, 0, "ms" );
+    ValueArg< double > drops_arg( "d", "drops", "Percentage of the frames never sent", false, 0, "percent" );
+    ValueArg< double > reorder_arg( "x", "reorder", "Percentage of the frames sent after the next one", false, 0,
+                                    "percent" );
+    ValueArg< int > queue_arg( "q", "queue", "Size of the syncer's output queue", false, 16, "framesets" );
+    ValueArg< unsigned > seed_arg( "e", "seed", "Seed of the jitter, drops and reordering", false, 1234, "number" );
+    ValueArg< string > output_arg( "o", "output", "JSON file to write the results to", false, "", "path" );
+    cmd.add( devices_arg );
+    cmd.add( streams_arg );
+    cmd.add( fps_arg );
+    cmd.add( resolution_arg );
+    cmd.add( seconds_arg );
+    cmd.add( jitter_arg );
+    cmd.add( drops_arg );
+    cmd.add( reorder_arg );
+    cmd.add( queue_arg );
+    cmd.add( seed_arg );
+    cmd.add( output_arg );
+    cmd.parse( argc, argv );
+
+    settings s;
+    s.devices = max( 1, devices_arg.getValue() );
+    s.streams = max( 1, streams_arg.getValue() );
+    s.fps = parse_list< int >( fps_arg.getValue(), []( string const & v ) { return max( 1, stoi( v ) ); } );
+    if( s.fps.empty() )
+        throw runtime_error( "no frame rate given" );
+    {
+        char x;
+        istringstream is( resolution_arg.getValue() );
+        if( ! ( is >> s.width >> x >> s.height ) || x != 'x' || s.width <= 0 || s.height <= 0 )
+            throw runtime_error( "invalid resolution: " + resolution_arg.getValue() );
+    }
+    s.seconds = max( 0., seconds_arg.getValue() );
+    s.jitter_ms = max( 0., jitter_arg.getValue() );
+    s.drop_percent = min( 100., max( 0., drops_arg.getValue() ) );
+    s.reorder_percent = min( 100., max( 0., reorder_arg.getValue() ) );
+    s.queue_size = max( 1, queue_arg.getValue() );
+    s.seed = seed_arg.getValue();
+
+    benchmark b( s );
+    cout << "Sending " << b.n_events() << " frames of " << b.n_streams() << " streams, as fast as they're taken..."
+         << endl;
+    benchmark::result r;
+    b.run( r );
+
+    cout << fixed << setprecision( 1 );
+    cout << "Framesets:        " << r.framesets << " (" << r.complete_framesets << " with all the streams), "
+         << ( r.seconds > 0 ? r.framesets / r.seconds : 0 ) << " per second" << endl;
+    cout << "Frames:           " << r.frames_out << " out of " << r.frames_sent << " sent" << endl;
+    cout << setprecision( 3 );
+    cout << "Latency ms:       p50 " << r.latency.percentile( 50 ) << ", p90 " << r.latency.percentile( 90 )
+         << ", p99 " << r.latency.percentile( 99 ) << ", max " << r.latency.maximum() << endl;
+    if( r.memory_kb )
+        cout << "Memory high-water: " << r.memory_kb << " KB" << endl;
+
+    if( output_arg.isSet() )
+    {
+        ofstream file( output_arg.getValue() );
+        if( ! file )
+            throw runtime_error( "failed to open " + output_arg.getValue() );
+        write_json( file, s, r );
+    }
+    return EXIT_SUCCESS;
+}
+catch( const rs2::error & e )
+{
+    cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what()
+         << endl;
+    return EXIT_FAILURE;
+}
+catch( const exception & e )
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
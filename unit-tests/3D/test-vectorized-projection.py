@@ -0,0 +1,45 @@
+# License: Apache 2.0. See LICENSE file in root directory.
+# Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+import pyrealsense2 as rs
+from rspy import test
+import numpy as np
+
+
+intrin = rs.intrinsics()
+intrin.width, intrin.height = 64, 48
+intrin.ppx, intrin.ppy = 31.5, 23.5
+intrin.fx, intrin.fy = 60., 61.
+intrin.model = rs.distortion.brown_conrady
+intrin.coeffs = [0.1, -0.05, 0.001, 0.002, 0.01]
+
+rng = np.random.default_rng( 1 )
+pixels = rng.uniform( 0, 48, ( 100, 2 )).astype( np.float32 )
+depths = rng.uniform( 0.2, 5, 100 ).astype( np.float32 )
+
+with test.closure( "Deprojecting arrays is deprojecting each" ):
+    points = rs.rs2_deproject_pixels_to_points( intrin, pixels, depths )
+    test.check_equal( points.shape, ( 100, 3 ) )
+    for i in range( len( pixels )):
+        test.check_float_lists( list( points[i] ), rs.rs2_deproject_pixel_to_point( intrin, list( pixels[i] ), float( depths[i] )))
+
+with test.closure( "Projecting arrays is projecting each" ):
+    projected = rs.rs2_project_points_to_pixels( intrin, points )
+    test.check_equal( projected.shape, ( 100, 2 ))
+    for i in range( len( points )):
+        test.check_float_lists( list( projected[i] ), rs.rs2_project_point_to_pixel( intrin, list( points[i] )), 1e-4 )
+
+with test.closure( "A whole depth image" ):
+    depth = rng.integers( 0, 5000, ( intrin.height, intrin.width ), dtype=np.uint16 )
+    image = rs.rs2_deproject_depth_image( intrin, depth, 0.001 )
+    test.check_equal( image.shape, ( intrin.height, intrin.width, 3 ))
+    test.check_float_lists( list( image[10, 20] ), rs.rs2_deproject_pixel_to_point( intrin, [20., 10.], depth[10, 20] * 0.001 ))
+
+with test.closure( "Shapes are checked" ):
+    test.check_throws( lambda: rs.rs2_deproject_pixels_to_points( intrin, pixels, depths[:10] ), ValueError )
+    test.check_throws( lambda: rs.rs2_project_points_to_pixels( intrin, pixels ), ValueError )
+
+
+#
+#############################################################################################
+test.print_results_and_exit()
@@ -191,6 +191,15 @@ with test.closure( 'Enqueue 2 images then matching metadata for the second -> bo
         test.check_equal( md_id( last_metadata() ), 2 )
     test.check_equal( len(dropped_metadata), 0 )
 
+with test.closure( 'Statistics count matches, frames without metadata, and drops' ):
+    syncer = new_syncer()
+    syncer.enqueue_metadata( 0, new_metadata( 0 ) )
+    syncer.enqueue_frame( 1, new_image( 1 ) )   # drops md 0
+    syncer.enqueue_metadata( 2, new_metadata( 2 ) )  # image 1 out w/o md
+    syncer.enqueue_frame( 2, new_image( 2 ) )   # match
+    test.check_equal( syncer.get_statistics(),
+                      { 'matched': 1, 'frames-without-metadata': 1, 'metadata-dropped': 1 } )
+
 with test.closure( 'Enqueue during callback' ):
     def enqueue_during_callback( image, metadata ):
         on_frame_ready( image, metadata )
@@ -228,6 +228,19 @@ with test.remote( remote_script, nested_indent="  S" ) as remote:
     #
     #############################################################################################
     #
+    with test.closure( "Statistics count the images and metadata received" ):
+        stats = stream_direct.get_statistics()
+        log.d( '---->', stats )
+        test.check_equal( stats['received'], 2 )
+        test.check_equal( stats['bytes'], 2 * profile.width() * profile.height() * profile.bytes_per_pixel() )
+        test.check( stats['latency-ms']['max'] >= stats['latency-ms']['min'] )
+        test.check( stats['callbacks'] > 0 )
+        stats = device_direct.get_statistics()
+        test.check_equal( stats['streams'][stream_direct.name()]['received'], 2 )
+        test.check( stats['metadata']['received'] >= 23 )
+    #
+    #############################################################################################
+    #
     with test.closure( "Stop streaming" ):
         remote.run( 'color_stream.stop_streaming()', on_fail='log' )
     #
@@ -130,6 +130,29 @@ with test.remote.fork( nested_indent=None ) as remote:
         test.check_equal( len( values.get( 's1' )), 3 )
         test.check_equal( len( values.get( 's2' )), 1 )
 
+    with test.closure( 'Set many options at once' ):
+        s1_options = { o.get_name(): o for o in next( s for s in device.streams() if s.name() == 's1' ).options() }
+        ip = next( o for o in device.options() if o.get_name() == 'IP Address' )
+        device.set_option_values( [
+            ( s1_options['Option 3'], 30. ),
+            ( s1_options['Custom Option'], 0.2 ),
+            ( ip, '1.2.3.5' ) ] )
+        test.check_equal( s1_options['Option 3'].get_value(), 30. )
+        test.check_approx_abs( s1_options['Custom Option'].get_value(), 0.2, 0.0001 )
+        test.check_equal( ip.get_value(), '1.2.3.5' )
+
+    with test.closure( 'One bad option fails the reply, but not the others' ):
+        test.check_throws( lambda:
+            device.send_control( {
+                'id': 'set-options',
+                'option-values': {
+                    's1': { 'Option 3': 40., 'No Such Option': 1 }
+                    }
+                }, True ),  # Wait for reply
+            RuntimeError,
+            '["set-options" error] 1 of the options failed: \'s1\' option \'No Such Option\' not found' )
+        test.check_equal( s1_options['Option 3'].get_value(), 40. )
+
     device = None
 
 test.print_results()
@@ -0,0 +1,75 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/log.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace librealsense;
+
+
+TEST_CASE( "binary_log::format", "[log]" )
+{
+    CHECK( binary_log::format( "none" ) == "none" );
+    CHECK( binary_log::format( "{} and {}", 1, "two" ) == "1 and two" );
+    CHECK( binary_log::format( "{} too many", 1, 2 ) == "1 too many" );
+    CHECK( binary_log::format( "{} too few {}", 1 ) == "1 too few {}" );
+}
+
+
+TEST_CASE( "binary_log::record", "[log]" )
+{
+    binary_log::record r;
+    r.add( int16_t( -5 ) );
+    r.add( 'c' );
+    r.add( "abc" );
+    CHECK( r.size == 1 + 8 + 1 + 1 + 1 + 2 + 3 );
+    CHECK( r.data[0] == 'i' );
+    CHECK( r.data[9] == 'c' );
+    CHECK( r.data[11] == 's' );
+
+    // Whatever doesn't fit is left out
+    std::string const big( 500, 'x' );
+    r.add( big );
+    CHECK( r.size == binary_log::record::max_size );
+    r.add( 1 );
+    CHECK( r.size == binary_log::record::max_size );
+}
+
+
+TEST_CASE( "binary log file", "[log]" )
+{
+    std::string const path = "test-binary-log.bin";
+    binary_log::log_to_file( RS2_LOG_SEVERITY_INFO, path.c_str() );
+    CHECK( binary_log::is_logging( RS2_LOG_SEVERITY_WARN ) );
+    CHECK_FALSE( binary_log::is_logging( RS2_LOG_SEVERITY_DEBUG ) );
+    for( int i = 0; i < 3; ++i )
+        LOG_INFO_FMT( "message {}", i );
+    LOG_DEBUG_FMT( "not in the file" );
+    binary_log::log_to_file( RS2_LOG_SEVERITY_NONE, nullptr );  // Waits for it to be written
+    CHECK_FALSE( binary_log::is_logging( RS2_LOG_SEVERITY_ERROR ) );
+
+    std::ifstream f( path, std::ios::binary );
+    std::string const contents( ( std::istreambuf_iterator< char >( f ) ), std::istreambuf_iterator< char >() );
+    f.close();
+    std::remove( path.c_str() );
+
+    REQUIRE( contents.size() > 28 );
+    CHECK( contents.compare( 0, 8, std::string( "RS2BLOG\0", 8 ) ) == 0 );
+    // One site, then its three messages, each with one i64 argument
+    size_t const header = 8 + 4 + 8 + 8;
+    size_t const format = std::string( "message {}" ).size();
+    size_t const file = strlen( __FILE__ );
+    size_t const site = 1 + 4 + 1 + 4 + 2 + file + 2 + format;
+    size_t const message = 1 + 4 + 8 + 4 + 2 + 1 + 8;
+    CHECK( contents.size() == header + site + 3 * message );
+    CHECK( contents[header] == 'S' );
+    CHECK( contents[header + site] == 'M' );
+    CHECK( contents.find( "not in the file" ) == std::string::npos );
+}
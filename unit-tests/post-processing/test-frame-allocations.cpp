@@ -0,0 +1,88 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/memory-stats.h>
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+using namespace librealsense;
+
+
+// Once past their first frames, the blocks of a typical post-processing chain should reuse their frame buffers
+// rather than allocate each frame anew
+TEST_CASE( "post-processing reuses its frame buffers", "[memory-stats]" )
+{
+    int const w = 640, h = 480;
+    rs2_intrinsics intrinsics = { w, h, w / 2.f, h / 2.f, 580.f, 580.f, RS2_DISTORTION_BROWN_CONRADY, { 0 } };
+
+    rs2::software_device dev;
+    auto sensor = dev.add_sensor( "Depth" );
+    auto profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, w, h, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+    sensor.add_read_only_option( RS2_OPTION_DEPTH_UNITS, 0.001f );
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::vector< rs2::frame > received;
+    sensor.open( profile );
+    sensor.start( [&]( rs2::frame f ) {
+        std::lock_guard< std::mutex > lock( m );
+        received.push_back( f );
+        cv.notify_all();
+    } );
+
+    std::vector< uint16_t > pixels( w * h );
+    for( int i = 0; i < w * h; ++i )
+        pixels[i] = uint16_t( i % 7 ? 1000 + i % w : 0 );  // With holes
+    auto next_depth = [&]( int number ) {
+        sensor.on_video_frame( { pixels.data(), []( void * ) {}, w * 2, 2, number * 33.3,
+                                 RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, number, profile.get(), 0.001f } );
+        std::unique_lock< std::mutex > lock( m );
+        REQUIRE( cv.wait_for( lock, std::chrono::seconds( 1 ), [&] { return ! received.empty(); } ) );
+        auto f = received.back();
+        received.clear();
+        return f;
+    };
+
+    rs2::decimation_filter decimation;
+    rs2::spatial_filter spatial;
+    rs2::temporal_filter temporal;
+    rs2::hole_filling_filter hole_filling;
+    rs2::colorizer colorizer;
+    std::vector< rs2::filter * > chain = { &decimation, &spatial, &temporal, &hole_filling, &colorizer };
+    auto process = [&]( rs2::frame f ) {
+        for( auto block : chain )
+            f = block->process( f );
+    };
+
+    int const warmup = 10, n = 30;
+    int number = 0;
+    while( number < warmup )
+        process( next_depth( ++number ) );
+
+    std::vector< memory_stats::subsystem > before;
+    for( auto block : chain )
+        before.push_back( memory_stats::snapshot( block->get_info( RS2_CAMERA_INFO_NAME ) ) );
+    while( number < warmup + n )
+        process( next_depth( ++number ) );
+
+    for( size_t i = 0; i < chain.size(); ++i )
+    {
+        auto d = memory_stats::snapshot( before[i].name ) - before[i];
+        INFO( d.name << ": " << d.frames << " frames, " << d.buffer_misses << " buffers (" << d.buffer_bytes
+                     << " bytes) and " << d.new_objects << " frame objects allocated" );
+        CHECK( d.frames >= n );
+        CHECK( d.buffer_misses == 0 );
+        CHECK( d.new_objects == 0 );
+    }
+
+    sensor.stop();
+    sensor.close();
+}
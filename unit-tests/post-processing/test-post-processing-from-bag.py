@@ -5,9 +5,11 @@
 #test:donotrun:dds
 
 import pyrealsense2 as rs
-from rspy import test, repo
+from rspy import test, repo, log
 import os.path
 import time
+import json
+import platform
 ################################################################################################
 
 
@@ -35,7 +37,9 @@ def process_frame(frame, frame_source):
 
     if len(pre_processed_frames_map[sensor_name]) == 2:
         frameset = frame_source.allocate_composite_frame(pre_processed_frames_map[sensor_name])
+        start = time.perf_counter()
         fs_processed = process_frame_callback(frameset.as_frameset())
+        processing_seconds.append(time.perf_counter() - start)
         fs_processed_data = bytearray(fs_processed.get_data())
         fs_processed_profile = fs_processed.get_profile().as_video_stream_profile()
         frames_data_map[sensor_name] = (fs_processed_data, fs_processed_profile)
@@ -82,10 +86,11 @@ def playback_file(file, callback):
 def compare_processed_frames_vs_recorded_frames(file):
     # we need processing_block in order to have frame_source.
     # frame_source is used to composite frames (by calling allocate_composite_frames function).
-    global frames_data_map, pre_processed_frames_map, sensors
+    global frames_data_map, pre_processed_frames_map, sensors, processing_seconds
     frame_processor = rs.processing_block(process_frame)
     frames_data_map = {}
     pre_processed_frames_map = {}
+    processing_seconds = []
     sensors = []
     playback_file('all_combinations_depth_color.bag', lambda frame: (frame_processor.invoke(frame)))
     processed_frames_data_list = []
@@ -103,23 +108,59 @@ def compare_processed_frames_vs_recorded_frames(file):
     for i in range(len(processed_frames_data_list)):
         validate_ppf_results(processed_frames_data_list[i], ref_frame_data_list[i])
 
+
+# How long each configuration takes, compared with what it took before on the same platform. The baselines are
+# recorded (or re-recorded, after an intended change) by running with RS2_PP_BASELINES=update;
+# RS2_PP_TOLERANCE is the slowdown allowed, as a fraction (default 0.3, for 30%).
+baselines_path = os.path.join(repo.root, 'unit-tests', 'post-processing', 'post-processing-baselines.json')
+platform_name = f'{platform.system()}-{platform.machine()}'
+tolerance = float(os.environ.get('RS2_PP_TOLERANCE', '0.3'))
+update_baselines = os.environ.get('RS2_PP_BASELINES') == 'update'
+try:
+    with open(baselines_path) as f:
+        baselines = json.load(f)
+except FileNotFoundError:
+    baselines = {}
+
+
+def check_speed(configuration):
+    # The same frames every run, so the total is what's compared: the median frame would hide the large resolutions
+    total_ms = sum(processing_seconds) * 1000.
+    log.i(f'{configuration}: {total_ms:.1f} ms for {len(processing_seconds)} framesets')
+    if update_baselines:
+        baselines.setdefault(platform_name, {})[configuration] = round(total_ms, 1)
+        with open(baselines_path, 'w') as f:
+            json.dump(baselines, f, indent=4, sort_keys=True)
+        return
+    baseline_ms = baselines.get(platform_name, {}).get(configuration)
+    if baseline_ms is None:
+        log.d(f'no {platform_name} baseline for {configuration}')
+        return
+    test.info('baseline ms', baseline_ms)
+    test.info('tolerance', tolerance)
+    test.check(total_ms <= baseline_ms * (1. + tolerance),
+               description=f'{configuration} took {total_ms:.1f} ms; {(total_ms / baseline_ms - 1.) * 100.:.0f}% slower than its baseline')
+
 ################################################################################################
 with test.closure("Test align depth to color from recording"):
     align = rs.align(rs.stream.color)
     process_frame_callback = lambda fs: align.process(fs).first_or_default(rs.stream.depth)
 
     compare_processed_frames_vs_recorded_frames("[aligned_2c]_all_combinations_depth_color.bag")
+    check_speed("align-to-color")
 ################################################################################################
 with test.closure("Test align color to depth from recording"):
     align = rs.align(rs.stream.depth)
     process_frame_callback = lambda fs: align.process(fs).first_or_default(rs.stream.color)
 
     compare_processed_frames_vs_recorded_frames("[aligned_2d]_all_combinations_depth_color.bag")
+    check_speed("align-to-depth")
 ################################################################################################
 with test.closure("Test point cloud from recording"):
     pc = rs.pointcloud()
     process_frame_callback = lambda fs: pc.calculate(fs.get_depth_frame())
 
     compare_processed_frames_vs_recorded_frames("[pointcloud]_all_combinations_depth_color.bag")
+    check_speed("pointcloud")
 ################################################################################################
 test.print_results_and_exit()
@@ -3,7 +3,11 @@
 #ifdef _WIN32
 #include "windows.h"
 #include "psapi.h"
+#elif defined( __APPLE__ )
+#include <mach/mach.h>
 #else
+#include <fstream>
+#include <unistd.h>
 #endif
 
 
@@ -15,7 +19,17 @@ float mb_in_use()
     GetProcessMemoryInfo( GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS *)&pmc, sizeof( pmc ) );
 
     mem = float( pmc.WorkingSetSize / (1024. * 1024.) );
+#elif defined( __APPLE__ )
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if( task_info( mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count ) == KERN_SUCCESS )
+        mem = float( info.resident_size / (1024. * 1024.) );
 #else
+    // statm: total and resident sizes, in pages
+    std::ifstream statm( "/proc/self/statm" );
+    size_t total = 0, resident = 0;
+    if( statm >> total >> resident )
+        mem = float( resident * sysconf( _SC_PAGESIZE ) / (1024. * 1024.) );
 #endif
     return mem;
 }
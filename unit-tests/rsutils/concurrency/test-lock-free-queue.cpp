@@ -0,0 +1,137 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:dependencies rsutils
+
+#include <unit-tests/test.h>
+#include <rsutils/time/timer.h>
+#include <rsutils/concurrency/concurrency.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace rsutils::time;
+
+
+TEST_CASE( "lock-free: enqueue drops the oldest when full" )
+{
+    std::vector< int > dropped;
+    lock_free_queue< int > q( 3, [&]( int const & i ) { dropped.push_back( i ); } );
+    for( int i = 0; i < 5; ++i )
+        REQUIRE( q.enqueue( std::move( i ) ) );
+    REQUIRE( q.size() == 3 );
+    REQUIRE( dropped == std::vector< int >{ 0, 1 } );
+
+    int i;
+    for( int expected : { 2, 3, 4 } )
+    {
+        REQUIRE( q.try_dequeue( &i ) );
+        REQUIRE( i == expected );
+    }
+    REQUIRE_FALSE( q.try_dequeue( &i ) );
+    REQUIRE( q.empty() );
+}
+
+TEST_CASE( "lock-free: capacity of one keeps the latest" )
+{
+    lock_free_queue< int > q( 1 );
+    for( int i = 0; i < 4; ++i )
+        q.enqueue( std::move( i ) );
+    REQUIRE( q.size() == 1 );
+    int i;
+    REQUIRE( q.try_dequeue( &i ) );
+    REQUIRE( i == 3 );
+    REQUIRE_FALSE( q.try_dequeue( &i ) );
+}
+
+TEST_CASE( "lock-free: dequeue doesn't wait after stop" )
+{
+    lock_free_queue< int > q;
+    q.enqueue( 1 );
+    q.stop();
+    REQUIRE( q.stopped() );
+    REQUIRE( q.empty() );
+    REQUIRE_FALSE( q.enqueue( 2 ) );
+
+    timer t( std::chrono::seconds( 1 ) );
+    t.start();
+    int i;
+    REQUIRE_FALSE( q.dequeue( &i, 2000 ) );
+    REQUIRE_FALSE( t.has_expired() );
+}
+
+TEST_CASE( "lock-free: dequeue wakes up on enqueue" )
+{
+    lock_free_queue< int > q;
+    stopwatch sw;
+    std::thread enqueue_thread( [&]() {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 500 ) );
+        q.enqueue( 7 );
+    } );
+    int i = 0;
+    REQUIRE( q.dequeue( &i, 5000 ) );
+    REQUIRE( i == 7 );
+    REQUIRE( sw.get_elapsed_ms() < 2000 );
+    enqueue_thread.join();
+}
+
+TEST_CASE( "lock-free: blocking enqueue waits for room" )
+{
+    lock_free_queue< int > q( 2 );
+    stopwatch sw;
+    std::thread dequeue_thread( [&]() {
+        std::this_thread::sleep_for( std::chrono::seconds( 1 ) );
+        int i;
+        q.dequeue( &i, 1000 );
+    } );
+    q.blocking_enqueue( 1 );
+    q.blocking_enqueue( 2 );
+    REQUIRE( sw.get_elapsed_ms() < 500 );
+    q.blocking_enqueue( 3 );
+    REQUIRE( sw.get_elapsed_ms() > 900 );
+    REQUIRE( q.size() == 2 );
+    dequeue_thread.join();
+}
+
+TEST_CASE( "lock-free: every item is either dequeued or dropped" )
+{
+    std::atomic< int > dropped( 0 );
+    lock_free_queue< int > q( 8, [&]( int const & ) { ++dropped; } );
+
+    const int PER_PRODUCER = 20000;
+    std::vector< std::thread > producers;
+    for( int p = 0; p < 3; ++p )
+        producers.emplace_back( [&, p]() {
+            for( int i = 0; i < PER_PRODUCER; ++i )
+                q.enqueue( p * PER_PRODUCER + i );
+        } );
+
+    std::vector< int > all_values;
+    int val;
+    while( all_values.size() + dropped < 3 * PER_PRODUCER )
+        if( q.dequeue( &val, 100 ) )
+            all_values.push_back( val );
+    for( auto & t : producers )
+        t.join();
+    while( q.try_dequeue( &val ) )
+        all_values.push_back( val );
+
+    REQUIRE( all_values.size() + dropped == 3 * PER_PRODUCER );
+    std::sort( all_values.begin(), all_values.end() );
+    REQUIRE( std::unique( all_values.begin(), all_values.end() ) == all_values.end() );
+}
+
+TEST_CASE( "lock-free: dequeue a batch" )
+{
+    lock_free_queue< int > q( 10 );
+    for( int i = 0; i < 5; ++i )
+        q.enqueue( std::move( i ) );
+
+    int values[3];
+    REQUIRE( q.try_dequeue_batch( values, 3 ) == 3 );
+    REQUIRE( std::vector< int >( values, values + 3 ) == std::vector< int >{ 0, 1, 2 } );
+    REQUIRE( q.try_dequeue_batch( values, 3 ) == 2 );
+    REQUIRE( values[0] == 3 );
+    REQUIRE( values[1] == 4 );
+    REQUIRE( q.try_dequeue_batch( values, 3 ) == 0 );
+}
@@ -148,3 +148,18 @@ TEST_CASE("verify mutex protection")
     enqueue_thread1.join();
     enqueue_thread2.join();
 }
+
+TEST_CASE( "dequeue a batch" )
+{
+    single_consumer_queue< int > scq( 10 );
+    for( int i = 0; i < 5; ++i )
+        scq.enqueue( std::move( i ) );
+
+    int values[3];
+    REQUIRE( scq.try_dequeue_batch( values, 3 ) == 3 );
+    REQUIRE( std::vector< int >( values, values + 3 ) == std::vector< int >{ 0, 1, 2 } );
+    REQUIRE( scq.try_dequeue_batch( values, 3 ) == 2 );
+    REQUIRE( values[0] == 3 );
+    REQUIRE( values[1] == 4 );
+    REQUIRE( scq.try_dequeue_batch( values, 3 ) == 0 );
+}
@@ -0,0 +1,38 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:dependencies rsutils
+
+#include <unit-tests/test.h>
+#include <rsutils/json.h>
+
+using rsutils::json;
+
+
+namespace {
+
+
+template< class B >
+json parse( B const & bytes )
+{
+    return rsutils::parse_json_or_binary( bytes.data(), bytes.size() );
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "text" )
+{
+    std::string const text = R"( { "controls-laserstate": "on", "param-disparitymode": 0 } )";
+    CHECK( parse( text ) == json::parse( text ) );
+    CHECK_THROWS( parse( std::string( "{ nope" ) ) );
+}
+
+TEST_CASE( "binary" )
+{
+    json const j = { { "controls-laserstate", "on" }, { "param-disparitymode", 0 }, { "param-depthunits", 1000 } };
+    CHECK( parse( json::to_cbor( j ) ) == j );
+    CHECK( parse( json::to_msgpack( j ) ) == j );
+    CHECK( parse( json::to_cbor( json::object() ) ) == json::object() );
+}
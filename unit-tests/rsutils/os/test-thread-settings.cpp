@@ -0,0 +1,55 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:dependencies rsutils
+
+#include <unit-tests/test.h>
+#include <rsutils/os/thread.h>
+#include <rsutils/json.h>
+
+#include <thread>
+
+using namespace rsutils::os;
+
+
+TEST_CASE( "thread roles fall back to the default" )
+{
+    configure_threads( rsutils::json::parse( R"({
+        "default": { "cpus": [ 0 ] },
+        "capture": { "cpus": [ 0 ], "priority": "high", "realtime-priority": 50, "name": "rs-uvc" }
+    })" ) );
+
+    auto capture = get_thread_settings( "capture" );
+    REQUIRE( capture.cpus == std::vector< int >{ 0 } );
+    REQUIRE( capture.priority == 1 );
+    REQUIRE( capture.realtime_priority == 50 );
+    REQUIRE( capture.name == "rs-uvc" );
+
+    auto hid = get_thread_settings( "hid" );
+    REQUIRE( hid.cpus == std::vector< int >{ 0 } );
+    REQUIRE( hid.priority == 0 );
+    REQUIRE( hid.realtime_priority == 0 );
+    REQUIRE( hid.name.empty() );
+
+    configure_threads( rsutils::json::object() );
+    REQUIRE( get_thread_settings( "capture" ).cpus.empty() );
+}
+
+TEST_CASE( "invalid thread settings are ignored" )
+{
+    configure_threads( rsutils::json::parse( R"({ "capture": { "priority": "highest", "realtime-priority": 200 } })" ) );
+    auto capture = get_thread_settings( "capture" );
+    REQUIRE( capture.priority == 0 );
+    REQUIRE( capture.realtime_priority == 0 );
+    configure_threads( rsutils::json::object() );
+}
+
+TEST_CASE( "thread settings can be applied" )
+{
+    thread_settings settings;
+    settings.cpus = { 0 };
+    settings.name = "rs-test";
+    bool applied = false;
+    std::thread( [&]() { applied = apply_thread_settings( settings ); } ).join();
+    REQUIRE( applied );
+}
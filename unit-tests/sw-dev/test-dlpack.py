@@ -0,0 +1,44 @@
+# License: Apache 2.0. See LICENSE file in root directory.
+# Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+import pyrealsense2 as rs
+from rspy import log, test
+import numpy as np
+import gc
+import sw
+
+
+with sw.sensor( "Stereo Module" ) as sensor:
+    depth = sensor.video_stream( "Depth", rs.stream.depth, rs.format.z16 )
+    sensor.start( depth )
+
+    with test.closure( "Arrays keep their frame alive" ):
+        f = sensor.publish( depth.frame() )
+        a = np.asanyarray( f.get_data() )
+        del f
+        gc.collect()
+        test.check_equal( a.shape, ( sw.h, sw.w ) )
+        test.check_equal( int( a[0, 0] ), 0x6969 )  # sw.py fills the buffer with 0x69
+
+    with test.closure( "Frames are on the host" ):
+        f = sensor.publish( depth.frame() )
+        test.check_equal( f.__dlpack_device__(), ( 1, 0 ) )  # kDLCPU
+        test.check_false( hasattr( f, '__cuda_array_interface__' ) )
+
+    if hasattr( np, 'from_dlpack' ):
+        with test.closure( "DLPack, without copying" ):
+            a = np.from_dlpack( f )
+            test.check_equal( a.shape, ( sw.h, sw.w ) )
+            test.check_equal( a.dtype, np.uint16 )
+            test.check_equal( int( a[sw.h - 1, sw.w - 1] ), 0x6969 )
+            test.check_equal( a.ctypes.data, np.asanyarray( f.get_data() ).ctypes.data )
+            del f
+            gc.collect()
+            test.check_equal( int( a[0, 0] ), 0x6969 )
+    else:
+        log.d( 'numpy', np.__version__, 'has no from_dlpack' )
+
+
+#
+#############################################################################################
+test.print_results_and_exit()
@@ -0,0 +1,34 @@
+# License: Apache 2.0. See LICENSE file in root directory.
+# Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+import pyrealsense2 as rs
+from rspy import log, test
+import sw
+
+
+with sw.sensor( "Stereo Module" ) as sensor:
+    depth = sensor.video_stream( "Depth", rs.stream.depth, rs.format.z16 )
+    sensor.start( depth )
+    q = sensor._q  # What the sensor streams into
+
+    with test.closure( "Nothing to poll" ):
+        test.check_equal( q.poll_batch(), [] )
+        test.check_equal( q.poll_batch( timeout_ms=10 ), [] )
+
+    with test.closure( "All that's there, in order" ):
+        for n in range( 1, 6 ):
+            sensor._handle.on_video_frame( depth.frame( frame_number=n ))
+        frames = q.poll_batch( timeout_ms=1000 )
+        test.check_equal( [f.get_frame_number() for f in frames], [1, 2, 3, 4, 5] )
+        test.check_equal( q.size(), 0 )
+
+    with test.closure( "Up to max_frames" ):
+        for n in range( 6, 11 ):
+            sensor._handle.on_video_frame( depth.frame( frame_number=n ))
+        test.check_equal( [f.get_frame_number() for f in q.poll_batch( 2, 1000 )], [6, 7] )
+        test.check_equal( [f.get_frame_number() for f in q.poll_batch()], [8, 9, 10] )
+
+
+#
+#############################################################################################
+test.print_results_and_exit()
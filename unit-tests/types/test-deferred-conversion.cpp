@@ -0,0 +1,68 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/deferred-conversion.h>
+
+#include <memory>
+
+using namespace librealsense;
+
+
+TEST_CASE( "deferred_conversion", "[frame]" )
+{
+    uint8_t left[4] = {}, right[2] = {};
+    int runs = 0;
+    auto source = std::make_shared< int >( 7 );  // Stands for the raw frame
+
+    auto make = [&]()
+    {
+        return std::make_shared< deferred_conversion >(
+            [&runs, source]( uint8_t * const planes[] )
+            {
+                ++runs;
+                for( int i = 0; i < 4; ++i )
+                    planes[0][i] = uint8_t( *source );
+                for( int i = 0; i < 2; ++i )
+                    planes[1][i] = uint8_t( *source + 1 );
+            },
+            std::vector< uint8_t * >{ left, right },
+            std::vector< size_t >{ sizeof( left ), sizeof( right ) } );
+    };
+
+    SECTION( "runs once" )
+    {
+        auto d = make();
+        CHECK( runs == 0 );
+        d->run();
+        d->run();
+        CHECK( runs == 1 );
+        CHECK( d->is_done() );
+        CHECK( left[3] == 7 );
+        CHECK( right[1] == 8 );
+        CHECK( source.use_count() == 1 );  // What it converted from was let go
+    }
+
+    SECTION( "released planes aren't written" )
+    {
+        auto d = make();
+        d->detach( 1 );
+        d->run();
+        CHECK( runs == 1 );
+        CHECK( left[0] == 7 );
+        CHECK( right[0] == 0 );
+    }
+
+    SECTION( "nothing to convert for" )
+    {
+        auto d = make();
+        d->detach( 0 );
+        CHECK( source.use_count() == 2 );
+        d->detach( 1 );
+        CHECK( source.use_count() == 1 );
+        d->run();
+        CHECK( runs == 0 );
+    }
+}
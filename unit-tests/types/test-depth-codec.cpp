@@ -0,0 +1,70 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/media/depth-codec.h>
+#include <src/proc/processing-thread-pool.h>
+
+#include <random>
+
+using namespace librealsense;
+
+
+namespace {
+
+// Smooth-ish depth with holes, and the odd extreme value
+std::vector< uint16_t > make_depth( size_t count )
+{
+    std::mt19937 rng( 1 );
+    std::vector< uint16_t > depth( count );
+    int z = 1000;
+    for( auto & d : depth )
+    {
+        z = std::max( 1, z + int( rng() % 21 ) - 10 );
+        if( rng() % 10 == 0 )
+            d = 0;
+        else if( rng() % 1000 == 0 )
+            d = rng() % 2 ? 65535 : 1;
+        else
+            d = uint16_t( z );
+    }
+    return depth;
+}
+
+}  // namespace
+
+
+TEST_CASE( "depth codec is lossless", "[depth-codec]" )
+{
+    processing_thread_pool pool( 3 );
+    for( size_t count : { 0, 1, 7, 640 * 480, 1280 * 720 + 3 } )
+    {
+        auto depth = make_depth( count );
+        std::vector< uint8_t > coded;
+        depth_codec::encode( depth.data(), count, coded, &pool );
+        CHECK( depth_codec::decoded_count( coded.data(), coded.size() ) == count );
+
+        std::vector< uint8_t > coded_serially;
+        depth_codec::encode( depth.data(), count, coded_serially );
+        CHECK( coded == coded_serially );
+
+        std::vector< uint16_t > decoded( count, 42 );
+        REQUIRE( depth_codec::decode( coded.data(), coded.size(), decoded.data(), count, &pool ) );
+        CHECK( decoded == depth );
+    }
+}
+
+TEST_CASE( "depth codec rejects corrupt data", "[depth-codec]" )
+{
+    auto depth = make_depth( 640 * 480 );
+    std::vector< uint8_t > coded;
+    depth_codec::encode( depth.data(), depth.size(), coded );
+    std::vector< uint16_t > decoded( depth.size() );
+
+    CHECK_FALSE( depth_codec::decode( coded.data(), coded.size() / 2, decoded.data(), decoded.size() ) );
+    CHECK_FALSE( depth_codec::decode( coded.data(), coded.size(), decoded.data(), decoded.size() - 1 ) );
+    CHECK_FALSE( depth_codec::decode( coded.data(), 4, decoded.data(), decoded.size() ) );
+    CHECK( depth_codec::decoded_count( coded.data(), 4 ) == 0 );
+}
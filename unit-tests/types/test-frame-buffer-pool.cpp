@@ -0,0 +1,111 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <src/frame-buffer-pool.h>
+
+#include <thread>
+
+using namespace librealsense;
+
+
+TEST_CASE( "pool recycles same-size buffers", "[frame-buffer-pool]" )
+{
+    frame_buffer_pool pool;
+    frame_buffer_pool::buffer b;
+
+    CHECK_FALSE( pool.acquire( 100, 0., b ) );
+
+    pool.release( frame_buffer_pool::buffer( 100, 7 ), 0. );
+    CHECK_FALSE( pool.acquire( 50, 0., b ) );  // wrong size
+    REQUIRE( pool.acquire( 100, 10., b ) );
+    CHECK( b.size() == 100 );
+    CHECK( b[0] == 7 );
+    CHECK_FALSE( pool.acquire( 100, 10., b ) );  // already taken
+}
+
+TEST_CASE( "pool discards stale buffers", "[frame-buffer-pool]" )
+{
+    frame_buffer_pool pool;
+    frame_buffer_pool::buffer b;
+
+    pool.release( frame_buffer_pool::buffer( 100 ), 0. );
+    CHECK_FALSE( pool.acquire( 100, frame_buffer_pool::MAX_AGE + 1, b ) );
+    // and it's gone for good
+    CHECK_FALSE( pool.acquire( 100, 0., b ) );
+}
+
+TEST_CASE( "pool ignores releases after clear", "[frame-buffer-pool]" )
+{
+    frame_buffer_pool pool;
+    frame_buffer_pool::buffer b;
+
+    pool.release( frame_buffer_pool::buffer( 100 ), 0. );
+    pool.clear();
+    CHECK_FALSE( pool.acquire( 100, 0., b ) );
+    pool.release( frame_buffer_pool::buffer( 100 ), 0. );
+    CHECK_FALSE( pool.acquire( 100, 0., b ) );
+}
+
+TEST_CASE( "pool buckets are bounded", "[frame-buffer-pool]" )
+{
+    frame_buffer_pool pool;
+    frame_buffer_pool::buffer b;
+
+    // More sizes than buckets: the extra ones just don't get pooled
+    for( size_t size = 1; size <= frame_buffer_pool::BUCKETS + 1; ++size )
+        pool.release( frame_buffer_pool::buffer( size ), 0. );
+    int hits = 0;
+    for( size_t size = 1; size <= frame_buffer_pool::BUCKETS + 1; ++size )
+        hits += pool.acquire( size, 0., b );
+    CHECK( hits == int( frame_buffer_pool::BUCKETS ) );
+}
+
+TEST_CASE( "pool keeps within the memory budget", "[frame-buffer-pool]" )
+{
+    auto stats = std::make_shared< frame_pool_stats >();
+    frame_buffer_pool pool( stats );
+    frame_buffer_pool::buffer b;
+
+    pool.release( frame_buffer_pool::buffer( 100 ), 0. );
+    CHECK( stats->pooled_bytes == 100 );
+    CHECK( pool.acquire( 100, 0., b ) );
+    CHECK( stats->pooled_bytes == 0 );
+
+    // What's in the frames counts too: a buffer that would take us past the budget is freed instead
+    stats->budget = 250;
+    stats->in_use_bytes = 100;
+    pool.release( frame_buffer_pool::buffer( 100 ), 0. );
+    pool.release( frame_buffer_pool::buffer( 100 ), 0. );
+    CHECK( stats->pooled_bytes == 100 );
+
+    // And buffers are kept for less long
+    CHECK( ! pool.acquire( 100, frame_buffer_pool::LOW_MEMORY_MAX_AGE + 1, b ) );
+    CHECK( stats->pooled_bytes == 0 );
+}
+
+TEST_CASE( "pool is safe across threads", "[frame-buffer-pool]" )
+{
+    frame_buffer_pool pool;
+    std::atomic< int > wrong_size{ 0 };
+    std::vector< std::thread > threads;
+    for( int t = 0; t < 4; ++t )
+    {
+        threads.emplace_back( [&pool, &wrong_size, t]()
+        {
+            for( int i = 0; i < 10000; ++i )
+            {
+                frame_buffer_pool::buffer b;
+                size_t const size = 64 * ( 1 + ( i + t ) % 2 );
+                if( pool.acquire( size, 0., b ) )
+                    wrong_size += b.size() != size;
+                else
+                    b.resize( size );
+                pool.release( std::move( b ), 0. );
+            }
+        } );
+    }
+    for( auto & t : threads )
+        t.join();
+    CHECK( wrong_size == 0 );
+}
@@ -0,0 +1,64 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/frame-trace.h>
+#include <src/frame.h>
+
+#include <rsutils/json.h>
+
+#include <sstream>
+
+using namespace librealsense;
+
+
+TEST_CASE( "frame_trace", "[frame-trace]" )
+{
+    frame f;
+    f.additional_data.frame_number = 7;
+
+    // Nothing when off
+    frame_trace::begin( f, RS2_STREAM_DEPTH, 0 );
+    CHECK_FALSE( f.additional_data.trace_id );
+
+    frame_trace::enable( true );
+    frame untraced;
+    frame_trace::stamp( &untraced, "ignored" );  // Frames without an id aren't traced
+    frame_trace::begin( f, RS2_STREAM_DEPTH, 0 );
+    CHECK( f.additional_data.trace_id );
+    {
+        frame_trace::scope block( &f, "block" );
+        frame_trace::stamp( &f, "queued" );
+    }
+    frame_trace::enable( false );
+    frame_trace::stamp( &f, "ignored" );
+
+    std::ostringstream ss;
+    frame_trace::export_trace( ss );
+    auto j = rsutils::json::parse( ss.str() );
+    auto & events = j["traceEvents"];
+    REQUIRE( events.is_array() );
+
+    int frame_slices = 0, thread_events = 0;
+    for( auto & e : events )
+    {
+        auto name = e["name"].get< std::string >();
+        CHECK( name != "ignored" );
+        if( name == "Depth #7" )
+            ++frame_slices;
+        if( e["ph"] == "X" )
+        {
+            CHECK( name != "queued" );
+            ++thread_events;
+        }
+    }
+    CHECK( frame_slices == 2 );   // Its begin and end
+    CHECK( thread_events == 2 );  // The arrival and the block
+
+    // Exporting clears it
+    std::ostringstream again;
+    frame_trace::export_trace( again );
+    CHECK( rsutils::json::parse( again.str() )["traceEvents"].empty() );
+}
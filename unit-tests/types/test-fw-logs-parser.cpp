@@ -0,0 +1,100 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/fw-logs/fw-logs-parser.h>
+
+#include <cstring>
+
+using namespace librealsense::fw_logs;
+
+
+namespace {
+
+
+char const * const xml = R"(<Format>
+    <Event id="1" numberOfArguments="3" format="a={0} b=0x{1:x} c={2:f}"/>
+    <Event id="2" numberOfArguments="1" format="{0,Color} {0} {1} {x}"/>
+    <File id="3" Name="main.c"/>
+    <Thread id="4" Name="worker"/>
+    <Enums>
+        <Enum Name="Color">
+            <EnumValue Key="0" Value="red"/>
+            <EnumValue Key="1" Value="green"/>
+        </Enum>
+    </Enums>
+</Format>)";
+
+
+std::vector< uint8_t > make_log( uint16_t event_id, uint16_t p1, uint16_t p2, uint32_t p3, uint32_t timestamp )
+{
+    fw_log_binary b = {};
+    b.dword1.bits.severity = 3;
+    b.dword1.bits.thread_id = 4;
+    b.dword1.bits.file_id = 3;
+    b.dword2.bits.event_id = event_id;
+    b.dword2.bits.line_id = 42;
+    b.dword3.p1 = p1;
+    b.dword3.p2 = p2;
+    b.dword4.p3 = p3;
+    b.dword5.timestamp = timestamp;
+    std::vector< uint8_t > bytes( BINARY_DATA_SIZE );
+    memcpy( bytes.data(), &b, sizeof( b ) );
+    return bytes;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "fw log formats", "[fw-logs]" )
+{
+    fw_logs_parser parser( xml );
+    float const f = 1.5f;
+    uint32_t p3;
+    memcpy( &p3, &f, sizeof( p3 ) );
+
+    fw_logs_binary_data data;
+    data.logs_buffer = make_log( 1, 7, 255, p3, 1000 );
+    auto log = parser.parse_fw_log( &data );
+    CHECK( log.get_message() == "a=7 b=0xff c=1.5" );
+    CHECK( log.get_file_name() == "main.c" );
+    CHECK( log.get_thread_name() == "worker" );
+    CHECK( log.get_line() == 42 );
+    CHECK( log.get_severity() == RS2_LOG_SEVERITY_ERROR );
+
+    // Enums by name; parameters past the event's, and anything else in braces, stay as they are
+    data.logs_buffer = make_log( 2, 1, 0, 0, 2000 );
+    CHECK( parser.parse_fw_log( &data ).get_message() == "green 1 {1} {x}" );
+
+    data.logs_buffer = make_log( 9, 1, 2, 3, 3000 );
+    CHECK( parser.parse_fw_log( &data ).get_message() == "*** Unrecognized Log Id: 9! P1 = 0x01, P2 = 0x02, P3 = 0x03" );
+}
+
+
+TEST_CASE( "fw log batch", "[fw-logs]" )
+{
+    fw_logs_parser parser( xml );
+    std::vector< uint8_t > buffer;
+    for( uint32_t i = 0; i < 3; ++i )
+    {
+        auto log = make_log( 1, uint16_t( i ), 0, 0, 100000 * ( i + 1 ) );
+        buffer.insert( buffer.end(), log.begin(), log.end() );
+    }
+    buffer.push_back( 0 );  // Not a whole log
+
+    std::vector< fw_log_record > records;
+    REQUIRE( parser.parse_fw_logs( buffer.data(), buffer.size(), records ) == 3 );
+    REQUIRE( records.size() == 3 );
+    CHECK( records[2].params[0] == 2 );
+    CHECK( records[0].delta == 0 );
+    CHECK( records[1].delta == Approx( 1. ) );
+    CHECK( parser.get_file_name( records[0].file_id ) == "main.c" );
+    CHECK( parser.get_file_name( 5 ) == "Unknown" );
+
+    std::string message;
+    parser.format_message( records[1], &message );
+    CHECK( message == "a=1 b=0x00 c=0" );
+}
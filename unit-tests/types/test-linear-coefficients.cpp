@@ -0,0 +1,46 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/global_timestamp_reader.h>
+
+using namespace librealsense;
+
+
+TEST_CASE( "regression follows the last samples", "[global-time]" )
+{
+    CLinearCoefficients coefs( 15 );
+    // More than the ring holds, so the oldest are taken off the sums; the first ones are off the line
+    for( int i = 0; i < 40; ++i )
+    {
+        double x = 100. * i;
+        coefs.add_value( CSample( x, i < 10 ? 0 : 2 * x + 5 ) );
+    }
+    CHECK( coefs.is_full() );
+    CHECK( coefs.calc_value( 10000 ) == Approx( 20005 ) );
+
+    coefs.add_const_y_coefs( -3 );
+    coefs.add_value( CSample( 4000, 8002 ) );
+    CHECK( coefs.calc_value( 10000 ) == Approx( 20002 ) );
+}
+
+TEST_CASE( "device time wrapping around", "[global-time]" )
+{
+    double const max_device_time = pow( 2, 32 ) * TIMESTAMP_USEC_TO_MSEC;
+    CLinearCoefficients coefs( 15 );
+    for( int i = 0; i < 5; ++i )
+    {
+        double x = max_device_time - 1000 + 100. * i;
+        coefs.add_value( CSample( x, x + 7 ) );
+    }
+    coefs.update_last_sample_time( 0 );
+
+    // Read before the samples are moved along, and after: the same
+    auto y = coefs.calc_value( 50 );
+    CHECK( y == Approx( max_device_time + 57 ) );
+    CHECK( coefs.update_samples_base( 50 ) );
+    CHECK( coefs.calc_value( 50 ) == Approx( y ) );
+    CHECK_FALSE( coefs.update_samples_base( 60 ) );
+}
@@ -0,0 +1,90 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/metadata-sink.h>
+#include <src/metadata-parser.h>
+#include <src/frame.h>
+
+using namespace librealsense;
+
+
+static std::shared_ptr< metadata_parser_map > array_parsers()
+{
+    auto parsers = std::make_shared< metadata_parser_map >();
+    for( int i = 0; i < RS2_FRAME_METADATA_COUNT; ++i )
+        parsers->emplace( rs2_frame_metadata_value( i ),
+                          std::make_shared< md_array_parser >( rs2_frame_metadata_value( i ) ) );
+    return parsers;
+}
+
+
+static void set_metadata( frame & f, unsigned long long number, rs2_metadata_type exposure, bool with_gain )
+{
+    metadata_array md = {};
+    md[RS2_FRAME_METADATA_ACTUAL_EXPOSURE] = { true, exposure };
+    md[RS2_FRAME_METADATA_GAIN_LEVEL] = { with_gain, 16 };
+    f.additional_data = frame_additional_data( md );
+    f.additional_data.frame_number = number;
+}
+
+
+TEST_CASE( "batches are in columns, with validity bitmaps", "[metadata-sink]" )
+{
+    frame f;
+    f.metadata_parsers = array_parsers();
+
+    std::vector< unsigned long long > numbers;
+    std::vector< rs2_metadata_type > exposures;
+    std::vector< int > gain_nulls;
+    std::vector< uint8_t > gain_validity;
+    bool exposure_has_bitmap = true;
+    metadata_sink sink( 3, [&]( rs2_metadata_batch const & batch ) {
+        for( int i = 0; i < batch.rows; ++i )
+        {
+            numbers.push_back( batch.frame_number[i] );
+            exposures.push_back( batch.values[RS2_FRAME_METADATA_ACTUAL_EXPOSURE][i] );
+        }
+        gain_nulls.push_back( batch.null_count[RS2_FRAME_METADATA_GAIN_LEVEL] );
+        gain_validity.push_back( batch.validity[RS2_FRAME_METADATA_GAIN_LEVEL]
+                                     ? batch.validity[RS2_FRAME_METADATA_GAIN_LEVEL][0]
+                                     : uint8_t( 0xff ) );
+        exposure_has_bitmap = batch.validity[RS2_FRAME_METADATA_ACTUAL_EXPOSURE] != nullptr;
+    } );
+
+    for( unsigned long long n = 1; n <= 4; ++n )
+    {
+        set_metadata( f, n, rs2_metadata_type( n * 100 ), n != 2 );
+        sink.append( f );
+    }
+    CHECK( numbers.size() == 3 );
+    sink.flush();
+    sink.flush();  // nothing left
+
+    CHECK( numbers == std::vector< unsigned long long >{ 1, 2, 3, 4 } );
+    CHECK( exposures == std::vector< rs2_metadata_type >{ 100, 200, 300, 400 } );
+    CHECK( gain_nulls == std::vector< int >{ 1, 0 } );
+    CHECK( gain_validity == std::vector< uint8_t >{ 0x05, 0xff } );
+    CHECK_FALSE( exposure_has_bitmap );
+}
+
+TEST_CASE( "the metadata table follows the additional data", "[metadata-sink]" )
+{
+    frame f;
+    f.metadata_parsers = array_parsers();
+    set_metadata( f, 1, 100, false );
+
+    rs2_metadata_type value = 0;
+    CHECK( f.find_metadata( RS2_FRAME_METADATA_ACTUAL_EXPOSURE, &value ) );
+    CHECK( value == 100 );
+    CHECK_FALSE( f.find_metadata( RS2_FRAME_METADATA_GAIN_LEVEL, nullptr ) );
+
+    // Assigning the additional data again decodes it again
+    set_metadata( f, 2, 200, true );
+    CHECK( f.find_metadata( RS2_FRAME_METADATA_ACTUAL_EXPOSURE, &value ) );
+    CHECK( value == 200 );
+    CHECK( f.find_metadata( RS2_FRAME_METADATA_GAIN_LEVEL, &value ) );
+    CHECK( value == 16 );
+}
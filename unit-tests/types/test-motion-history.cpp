@@ -0,0 +1,91 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/motion-history.h>
+
+using namespace librealsense;
+
+
+static void add( motion_history & h, double timestamp, float x, rs2_timestamp_domain domain = RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK )
+{
+    float xyz[3] = { x, 2 * x, -x };
+    h.add( RS2_STREAM_GYRO, timestamp, domain, xyz );
+}
+
+
+TEST_CASE( "interpolated between samples", "[motion-history]" )
+{
+    motion_history h;
+    add( h, 10., 1.f );
+    add( h, 20., 3.f );
+
+    rs2_motion_sample s, before, after;
+    REQUIRE( h.get_at( RS2_STREAM_GYRO, 15., s, before, after ) );
+    CHECK( s.timestamp == 15. );
+    CHECK( s.xyz[0] == Approx( 2.f ) );
+    CHECK( s.xyz[1] == Approx( 4.f ) );
+    CHECK( s.xyz[2] == Approx( -2.f ) );
+    CHECK( before.timestamp == 10. );
+    CHECK( after.timestamp == 20. );
+
+    REQUIRE( h.get_at( RS2_STREAM_GYRO, 10., s, before, after ) );
+    CHECK( s.xyz[0] == 1.f );
+    CHECK( before.timestamp == 10. );
+    CHECK( after.timestamp == 10. );
+
+    CHECK_FALSE( h.get_at( RS2_STREAM_GYRO, 9., s, before, after ) );
+    CHECK_FALSE( h.get_at( RS2_STREAM_GYRO, 21., s, before, after ) );
+    CHECK_FALSE( h.get_at( RS2_STREAM_ACCEL, 15., s, before, after ) );
+    CHECK_THROWS( h.get_at( RS2_STREAM_DEPTH, 15., s, before, after ) );
+}
+
+
+TEST_CASE( "range", "[motion-history]" )
+{
+    motion_history h;
+    for( int i = 0; i < 10; ++i )
+        add( h, i, float( i ) );
+
+    rs2_motion_sample samples[3];
+    CHECK( h.get_range( RS2_STREAM_GYRO, 2., 6., samples, 3 ) == 5 );
+    CHECK( samples[0].timestamp == 2. );
+    CHECK( samples[2].timestamp == 4. );
+    CHECK( h.get_range( RS2_STREAM_GYRO, 2.5, 2.7, samples, 3 ) == 0 );
+    CHECK( h.get_range( RS2_STREAM_GYRO, 6., 2., samples, 3 ) == 0 );
+    CHECK( h.get_range( RS2_STREAM_GYRO, -1., 100., nullptr, 0 ) == 10 );
+}
+
+
+TEST_CASE( "oldest samples make room", "[motion-history]" )
+{
+    motion_history h;
+    auto n = motion_history::capacity + 10;
+    for( size_t i = 0; i < n; ++i )
+        add( h, double( i ), float( i ) );
+
+    rs2_motion_sample s, before, after;
+    CHECK_FALSE( h.get_at( RS2_STREAM_GYRO, 5., s, before, after ) );
+    CHECK( h.get_at( RS2_STREAM_GYRO, 10., s, before, after ) );
+    CHECK( h.get_at( RS2_STREAM_GYRO, n - 1.5, s, before, after ) );
+    CHECK( s.xyz[0] == Approx( n - 1.5 ) );
+    CHECK( h.get_range( RS2_STREAM_GYRO, 0., double( n ), nullptr, 0 ) == motion_history::capacity );
+}
+
+
+TEST_CASE( "starts over", "[motion-history]" )
+{
+    motion_history h;
+    add( h, 10., 1.f );
+    add( h, 20., 1.f );
+    add( h, 5., 1.f );  // back in time
+    CHECK( h.get_range( RS2_STREAM_GYRO, 0., 100., nullptr, 0 ) == 1 );
+
+    add( h, 30., 1.f, RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME );
+    CHECK( h.get_range( RS2_STREAM_GYRO, 0., 100., nullptr, 0 ) == 1 );
+
+    h.clear();
+    CHECK( h.get_range( RS2_STREAM_GYRO, 0., 100., nullptr, 0 ) == 0 );
+}
@@ -0,0 +1,92 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/core/options-watcher.h>
+#include <src/option.h>
+
+#include <rsutils/json.h>
+#include <rsutils/signal.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+// As the DDS options do: tells when its value changes
+class notifying_option : public float_option
+{
+    rsutils::signal<> _changed;
+
+public:
+    notifying_option() : float_option( { 0, 10, 1, 0 } ) {}
+
+    void set( float value ) override
+    {
+        float_option::set( value );
+        _changed.raise();
+    }
+
+    rsutils::subscription on_value_changed( std::function< void() > && cb ) override
+    {
+        return _changed.subscribe( std::move( cb ) );
+    }
+};
+
+
+}  // namespace
+
+
+TEST_CASE( "notifying options are not polled", "[options-watcher]" )
+{
+    options_watcher watcher( std::chrono::milliseconds( 10 ) );
+    auto opt = std::make_shared< notifying_option >();
+    watcher.register_option( RS2_OPTION_EXPOSURE, opt );
+
+    float last = -1;
+    int calls = 0;
+    auto subscription = watcher.subscribe(
+        [&]( options_watcher::options_and_values const & updated )
+        {
+            ++calls;
+            REQUIRE( updated.count( RS2_OPTION_EXPOSURE ) );
+            last = updated.at( RS2_OPTION_EXPOSURE ).p_last_known_value->get< float >();
+        } );
+
+    // Notified right away, on the thread that set it
+    opt->set( 5 );
+    CHECK( calls == 1 );
+    CHECK( last == 5 );
+    opt->set( 5 );
+    CHECK( calls == 1 );
+    opt->set( 7 );
+    CHECK( calls == 2 );
+    CHECK( last == 7 );
+
+    watcher.unregister_option( RS2_OPTION_EXPOSURE );
+    opt->set( 3 );
+    CHECK( calls == 2 );
+}
+
+TEST_CASE( "other options are polled", "[options-watcher]" )
+{
+    options_watcher watcher( std::chrono::milliseconds( 10 ) );
+    auto opt = std::make_shared< float_option >( option_range{ 0, 10, 1, 0 } );
+    watcher.register_option( RS2_OPTION_GAIN, opt );
+
+    std::atomic< int > calls( 0 );
+    auto subscription = watcher.subscribe( [&]( options_watcher::options_and_values const & ) { ++calls; } );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    opt->set( 4 );
+    for( int i = 0; i < 100 && ! calls; ++i )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    CHECK( calls == 1 );
+}
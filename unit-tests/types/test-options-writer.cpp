@@ -0,0 +1,86 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/core/options-writer.h>
+#include <src/option.h>
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+// Counts its writes; the first one waits to be let through, so the next ones queue up behind it
+class blocking_option : public float_option
+{
+    std::mutex _m;
+    std::condition_variable _cv;
+    bool _open = false;
+
+public:
+    int sets = 0;
+
+    blocking_option() : float_option( { 0, 100, 1, 0 } ) {}
+
+    void open()
+    {
+        std::lock_guard< std::mutex > lock( _m );
+        _open = true;
+        _cv.notify_all();
+    }
+
+    void set( float value ) override
+    {
+        std::unique_lock< std::mutex > lock( _m );
+        _cv.wait( lock, [this] { return _open; } );
+        ++sets;
+        float_option::set( value );
+    }
+};
+
+
+std::future< std::exception_ptr > queue( options_writer & writer, std::vector< std::pair< option *, float > > values )
+{
+    auto promise = std::make_shared< std::promise< std::exception_ptr > >();
+    writer.write( values, nullptr, [promise]( std::exception_ptr ex ) { promise->set_value( ex ); } );
+    return promise->get_future();
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "queued writes to the same option are coalesced", "[options-writer]" )
+{
+    blocking_option blocker, exposure;
+    exposure.open();
+    options_writer writer;
+    auto a = queue( writer, { { &blocker, 1 } } );
+    // While the blocker is being set, these queue up
+    auto b = queue( writer, { { &exposure, 10 } } );
+    auto c = queue( writer, { { &exposure, 20 }, { &exposure, 30 } } );
+    blocker.open();
+
+    CHECK( a.get() == nullptr );
+    CHECK( b.get() == nullptr );
+    CHECK( c.get() == nullptr );
+    CHECK( exposure.sets <= 2 );
+    CHECK( exposure.query() == 30 );
+}
+
+TEST_CASE( "errors are reported", "[options-writer]" )
+{
+    options_writer writer;
+    readonly_float_option ro( { 0, 1, 1, 0 } );
+    float_option rw( { 0, 1, 1, 0 } );
+    auto f = queue( writer, { { &rw, 1 }, { &ro, 1 } } );
+    CHECK( f.get() != nullptr );
+    CHECK( rw.query() == 1 );
+}
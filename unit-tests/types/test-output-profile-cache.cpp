@@ -0,0 +1,75 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/proc/output-profile-cache.h>
+#include <src/environment.h>
+#include <src/stream.h>
+
+using namespace librealsense;
+
+
+static std::shared_ptr< video_stream_profile > make_source()
+{
+    auto p = std::make_shared< video_stream_profile >();
+    p->set_stream_type( RS2_STREAM_DEPTH );
+    p->set_format( RS2_FORMAT_Z16 );
+    p->set_dims( 640, 480 );
+    p->set_unique_id( environment::get_instance().generate_stream_id() );
+    return p;
+}
+
+
+TEST_CASE( "same key, same profile", "[output-profile-cache]" )
+{
+    output_profile_cache cache;
+    auto source = make_source();
+
+    int setups = 0;
+    auto setup = [&]( stream_profile_interface & ) { ++setups; };
+    output_profile_cache::key key( source.get(), RS2_STREAM_DEPTH, 0, RS2_FORMAT_DISPARITY32, "test" );
+    key.width = 320;
+    auto a = cache.get( key, setup );
+    auto b = cache.get( key, setup );
+    CHECK( a == b );
+    CHECK( setups == 1 );
+    CHECK( a->get_format() == RS2_FORMAT_DISPARITY32 );
+    auto video = std::dynamic_pointer_cast< video_stream_profile_interface >( a );
+    REQUIRE( video );
+    CHECK( video->get_width() == 320 );
+    CHECK( video->get_height() == 480 );
+
+    // The name, not the literal
+    std::string name( "test" );
+    output_profile_cache::key same( key );
+    same.transform = name.c_str();
+    CHECK( cache.get( same ) == a );
+
+    key.param = 2;
+    CHECK( cache.get( key ) != a );
+    CHECK( cache.get( { source.get(), RS2_STREAM_DEPTH, 0, RS2_FORMAT_DISPARITY32 } ) != a );
+    CHECK( cache.size() == 3 );
+
+    auto profile = cache.get_profile( key );
+    CHECK( profile.get()->profile == cache.get( key ).get() );
+    CHECK( profile.format() == RS2_FORMAT_DISPARITY32 );
+}
+
+
+TEST_CASE( "entries go with their sources", "[output-profile-cache]" )
+{
+    output_profile_cache cache;
+    auto source = make_source();
+    auto first = cache.get( { source.get(), RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16 } );
+    // The output of one block as the source of another
+    cache.get( { first.get(), RS2_STREAM_DEPTH, 0, RS2_FORMAT_DISTANCE } );
+    CHECK( cache.size() == 2 );
+
+    first.reset();
+    source.reset();
+    auto other = make_source();
+    cache.get( { other.get(), RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16 } );
+    CHECK( cache.size() == 1 );
+}
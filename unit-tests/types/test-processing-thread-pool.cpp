@@ -0,0 +1,100 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <unit-tests/test.h>
+#include <src/proc/processing-thread-pool.h>
+
+#include <set>
+
+using namespace librealsense;
+
+
+TEST_CASE( "parallel_for covers every item once", "[processing-thread-pool]" )
+{
+    processing_thread_pool pool( 3 );
+    for( size_t count : { 0, 1, 5, 720, 1281 } )
+    {
+        for( int chunks : { 1, 2, 4, 16 } )
+        {
+            std::vector< std::atomic< int > > hits( count );
+            pool.parallel_for( count, chunks, [&]( size_t begin, size_t end )
+            {
+                for( auto i = begin; i < end; ++i )
+                    ++hits[i];
+            } );
+            int wrong = 0;
+            for( auto & h : hits )
+                wrong += h != 1;
+            CHECK( wrong == 0 );
+        }
+    }
+}
+
+TEST_CASE( "parallel_for without workers runs on the caller", "[processing-thread-pool]" )
+{
+    processing_thread_pool pool( 0 );
+    auto const caller = std::this_thread::get_id();
+    bool same_thread = true;
+    size_t covered = 0;
+    pool.parallel_for( 100, 4, [&]( size_t begin, size_t end )
+    {
+        same_thread = same_thread && std::this_thread::get_id() == caller;
+        covered += end - begin;
+    } );
+    CHECK( same_thread );
+    CHECK( covered == 100 );
+}
+
+TEST_CASE( "nested parallel_for does not deadlock", "[processing-thread-pool]" )
+{
+    processing_thread_pool pool( 2 );
+    std::atomic< size_t > covered{ 0 };
+    pool.parallel_for( 8, 8, [&]( size_t, size_t )
+    {
+        pool.parallel_for( 10, 4, [&]( size_t begin, size_t end ) { covered += end - begin; } );
+    } );
+    CHECK( covered == 80 );
+}
+
+TEST_CASE( "submitted tasks all run, including ones submitted by tasks", "[processing-thread-pool]" )
+{
+    std::atomic< int > ran{ 0 };
+    {
+        processing_thread_pool pool( 3 );
+        for( int i = 0; i < 100; ++i )
+            pool.submit( [&]()
+            {
+                ++ran;
+                pool.submit( [&]() { ++ran; } );
+            } );
+    }  // Waits for whatever's still queued
+    CHECK( ran == 200 );
+}
+
+TEST_CASE( "idle workers steal from a busy one", "[processing-thread-pool]" )
+{
+    processing_thread_pool pool( 4 );
+    std::mutex m;
+    std::set< std::thread::id > threads;
+    std::atomic< int > ran{ 0 };
+    // One task queues the rest on its own worker, then is kept busy: anything that runs meanwhile was stolen
+    pool.submit( [&]()
+    {
+        for( int i = 0; i < 8; ++i )
+            pool.submit( [&]()
+            {
+                std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+                std::lock_guard< std::mutex > lock( m );
+                threads.insert( std::this_thread::get_id() );
+                ++ran;
+            } );
+        auto const give_up = std::chrono::steady_clock::now() + std::chrono::seconds( 5 );
+        while( ran < 8 && std::chrono::steady_clock::now() < give_up )
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    } );
+    auto const give_up = std::chrono::steady_clock::now() + std::chrono::seconds( 10 );
+    while( ran < 8 && std::chrono::steady_clock::now() < give_up )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    CHECK( ran == 8 );
+    CHECK( threads.size() > 1 );
+}
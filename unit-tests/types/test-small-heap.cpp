@@ -0,0 +1,96 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/small-heap.h>
+
+#include <thread>
+#include <set>
+
+using namespace librealsense;
+
+
+TEST_CASE( "small_heap allocates up to capacity", "[small-heap]" )
+{
+    small_heap< int, 4 > heap;
+    std::set< int * > items;
+    for( int i = 0; i < 4; ++i )
+    {
+        auto p = heap.allocate();
+        REQUIRE( p );
+        items.insert( p );
+    }
+    CHECK( items.size() == 4 );
+    CHECK( heap.get_size() == 4 );
+    CHECK_FALSE( heap.allocate() );
+    CHECK( heap.get_size() == 4 );
+
+    for( auto p : items )
+        heap.deallocate( p );
+    CHECK( heap.is_empty() );
+}
+
+TEST_CASE( "small_heap resets released items", "[small-heap]" )
+{
+    small_heap< int, 1 > heap;
+    auto p = heap.allocate();
+    *p = 5;
+    heap.deallocate( p );
+    p = heap.allocate();
+    CHECK( *p == 0 );
+    heap.deallocate( p );
+}
+
+TEST_CASE( "small_heap rejects foreign items", "[small-heap]" )
+{
+    small_heap< int, 1 > heap;
+    int x;
+    CHECK_THROWS( heap.deallocate( &x ) );
+}
+
+TEST_CASE( "small_heap stop and wait", "[small-heap]" )
+{
+    small_heap< int, 2 > heap;
+    auto p = heap.allocate();
+    heap.stop_allocation();
+    CHECK_FALSE( heap.allocate() );
+    CHECK( heap.get_size() == 1 );
+
+    std::thread t( [&]() {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+        heap.deallocate( p );
+    } );
+    heap.wait_until_empty();
+    CHECK( heap.is_empty() );
+    t.join();
+}
+
+TEST_CASE( "small_heap concurrent allocate/deallocate", "[small-heap]" )
+{
+    small_heap< int, 8 > heap;
+    std::atomic< int > collisions{ 0 };
+    std::vector< std::thread > threads;
+    for( int t = 0; t < 4; ++t )
+    {
+        threads.emplace_back( [&]() {
+            for( int i = 0; i < 20000; ++i )
+            {
+                if( auto p = heap.allocate() )
+                {
+                    // Nobody else should own this slot while we do
+                    if( *p != 0 )
+                        ++collisions;
+                    *p = 1;
+                    *p = 0;
+                    heap.deallocate( p );
+                }
+            }
+        } );
+    }
+    for( auto & t : threads )
+        t.join();
+    CHECK( collisions == 0 );
+    CHECK( heap.is_empty() );
+}
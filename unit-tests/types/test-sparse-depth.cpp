@@ -0,0 +1,99 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <rsutils/sparse-depth.h>
+
+#include <random>
+
+using namespace rsutils;
+
+
+namespace {
+
+// Mostly holes, as after a threshold; rows of 'stride' pixels
+std::vector< uint16_t > make_depth( uint32_t stride, uint32_t height )
+{
+    std::mt19937 rng( 1 );
+    std::vector< uint16_t > depth( size_t( stride ) * height );
+    for( auto & d : depth )
+        d = rng() % 5 ? 0 : uint16_t( 1 + rng() % 65535 );
+    return depth;
+}
+
+}  // namespace
+
+
+TEST_CASE( "sparse depth is lossless", "[sparse-depth]" )
+{
+    for( uint32_t width : { 1, 7, 8, 13, 640 } )
+    {
+        uint32_t const height = 30, stride = width + 3;
+        auto depth = make_depth( stride, height );
+        std::vector< uint8_t > coded;
+        sparse_depth::encode( depth.data(), width, height, stride * 2, coded );
+        CHECK( coded.size() == sparse_depth::encoded_size( depth.data(), width, height, stride * 2 ) );
+
+        // With the padding of a frame after it
+        coded.resize( coded.size() + 5, 0xFF );
+        std::vector< uint16_t > decoded( size_t( width ) * height, 42 );
+        REQUIRE( sparse_depth::decode( coded.data(), coded.size(), decoded.data(), width, height ) );
+
+        sparse_depth::image image;
+        REQUIRE( image.parse( coded.data(), coded.size() ) );
+        size_t valid = 0;
+        for( uint32_t y = 0; y < height; ++y )
+            for( uint32_t x = 0; x < width; ++x )
+            {
+                auto d = depth[y * stride + x];
+                CHECK( decoded[y * width + x] == d );
+                CHECK( image.at( x, y ) == d );
+                valid += d != 0;
+            }
+        CHECK( image.count() == valid );
+        CHECK( image.at( width, 0 ) == 0 );
+    }
+}
+
+
+TEST_CASE( "sparse depth of nothing", "[sparse-depth]" )
+{
+    std::vector< uint16_t > depth( 64 * 4, 0 );
+    std::vector< uint8_t > coded;
+    sparse_depth::encode( depth.data(), 64, 4, 64 * 2, coded );
+    CHECK( coded.size() == sparse_depth::header_size + 4 * 4 );
+
+    sparse_depth::image image;
+    REQUIRE( image.parse( coded.data(), coded.size() ) );
+    CHECK( image.count() == 0 );
+    CHECK( image.begin( 3 ) == image.end( 3 ) );
+}
+
+
+TEST_CASE( "sparse depth rejects corrupt data", "[sparse-depth]" )
+{
+    uint32_t const width = 640, height = 480;
+    auto depth = make_depth( width, height );
+    std::vector< uint8_t > coded;
+    sparse_depth::encode( depth.data(), width, height, width * 2, coded );
+    std::vector< uint16_t > decoded( depth.size() );
+
+    CHECK_FALSE( sparse_depth::decode( coded.data(), coded.size() - 1, decoded.data(), width, height ) );
+    CHECK_FALSE( sparse_depth::decode( coded.data(), coded.size(), decoded.data(), width, height - 1 ) );
+    CHECK_FALSE( sparse_depth::decode( coded.data(), 4, decoded.data(), width, height ) );
+
+    // The end of a row before that of the one above it
+    auto bad = coded;
+    bad[sparse_depth::header_size + 4 * 10] = bad[sparse_depth::header_size + 4 * 10 + 1] = 0;
+    sparse_depth::image image;
+    CHECK_FALSE( image.parse( bad.data(), bad.size() ) );
+
+    // A pixel beyond the width
+    bad = coded;
+    auto first = sparse_depth::header_size + 4 * height;
+    bad[first] = bad[first + 1] = 0xFF;
+    CHECK( image.parse( bad.data(), bad.size() ) );
+    CHECK_FALSE( sparse_depth::decode( bad.data(), bad.size(), decoded.data(), width, height ) );
+}
@@ -0,0 +1,56 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <unit-tests/test.h>
+#include <src/stream-telemetry.h>
+
+using namespace librealsense;
+
+
+TEST_CASE( "drops from frame-number gaps", "[stream-telemetry]" )
+{
+    stream_telemetry t;
+    t.on_received( RS2_STREAM_DEPTH, 0, false, 1 );
+    t.on_delivered( RS2_STREAM_DEPTH, 0, 10, 2. );
+    t.on_received( RS2_STREAM_DEPTH, 0, true, 16 );  // 11, discarded
+    t.on_received( RS2_STREAM_DEPTH, 0, false, 3 );
+    t.on_delivered( RS2_STREAM_DEPTH, 0, 12, 4. );
+    t.on_delivered( RS2_STREAM_DEPTH, 0, 1, 0. );  // reset: not a drop
+    t.on_backend_error();
+
+    auto streams = t.get();
+    REQUIRE( streams.size() == 1 );
+    auto & s = streams[0];
+    CHECK( s.stream == RS2_STREAM_DEPTH );
+    CHECK( s.frames_received == 3 );
+    CHECK( s.frames_delivered == 3 );
+    CHECK( s.frames_dropped == 1 );
+    CHECK( s.frames_discarded == 1 );
+    CHECK( s.queue_depth_max == 16 );
+    CHECK( s.backend_errors == 1 );
+    CHECK( s.latency_last_ms == 0. );
+    CHECK( s.latency_max_ms == 4. );
+    CHECK( s.latency_avg_ms == 2. );
+}
+
+TEST_CASE( "streams are kept apart, and reset", "[stream-telemetry]" )
+{
+    stream_telemetry t;
+    t.on_delivered( RS2_STREAM_INFRARED, 1, 1, 1. );
+    t.on_delivered( RS2_STREAM_INFRARED, 2, 5, 1. );
+    t.on_delivered( RS2_STREAM_INFRARED, 1, 2, 1. );
+    t.on_size_anomaly( RS2_STREAM_INFRARED, 2 );
+
+    auto streams = t.get();
+    REQUIRE( streams.size() == 2 );
+    CHECK( streams[0].index == 1 );
+    CHECK( streams[0].frames_delivered == 2 );
+    CHECK( streams[0].frames_dropped == 0 );
+    CHECK( streams[1].index == 2 );
+    CHECK( streams[1].size_anomalies == 1 );
+
+    t.reset();
+    CHECK( t.get().empty() );
+}
@@ -1,6 +1,10 @@
 package com.intel.realsense.librealsense;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
 public class Frame extends LrsClass implements Cloneable{
+    private ByteBuffer mDataBuffer;
 
     Frame(long handle){
         mHandle = handle;
@@ -33,6 +37,19 @@ public class Frame extends LrsClass implements Cloneable{
         nGetData(mHandle, data);
     }
 
+    /**
+     * The frame's data, without copying it: a direct buffer over the native memory of the frame, which stays in
+     * the frame pool of the sensor. Nothing is allocated per frame on the Java heap.
+     * The buffer is valid only as long as the frame it came from (or the frame this one was made 'as') isn't
+     * closed: don't keep it past close(), and don't write to it.
+     */
+    public ByteBuffer getDataBuffer() {
+        if(mDataBuffer == null)
+            mDataBuffer = nGetDataBuffer(mHandle).order(ByteOrder.LITTLE_ENDIAN);
+        mDataBuffer.rewind();
+        return mDataBuffer;
+    }
+
     public int getNumber(){
         return nGetNumber(mHandle);
     }
@@ -61,6 +78,7 @@ public class Frame extends LrsClass implements Cloneable{
 
     @Override
     public void close() {
+        mDataBuffer = null;
         if(mOwner)
             nRelease(mHandle);
     }
@@ -78,6 +96,7 @@ public class Frame extends LrsClass implements Cloneable{
     protected static native long nGetStreamProfile(long handle);
     private static native int nGetDataSize(long handle);
     private static native void nGetData(long handle, byte[] data);
+    private static native ByteBuffer nGetDataBuffer(long handle);
     private static native int nGetNumber(long handle);
     private static native double nGetTimestamp(long handle);
     private static native int nGetTimestampDomain(long handle);
@@ -92,14 +92,12 @@ public class GLPointsFrame extends GLFrame {
             return null;
 
         VideoFrame vf = mTexture.as(Extension.VIDEO_FRAME);
-        int textureSize = vf.getWidth() * vf.getHeight();
         int pointCount = points.getCount();
         float[] pointsData = points.getVertices();
-        byte[] textureData = new byte[textureSize * 3];
+        ByteBuffer textureData = vf.getDataBuffer();
         byte[] texture = new byte[pointCount * 4];
         float[] textureCoordinates = points.getTextureCoordinates();
 
-        vf.getData(textureData);
         int w = vf.getWidth();
         int h = vf.getHeight();
         for(int i = 0; i < pointCount; i++){
@@ -111,7 +109,7 @@ public class GLPointsFrame extends GLFrame {
                 continue;
             long texIndex = (long) (x + y * w);
             for(int j = 0; j < 3; j++)
-                texture[i*4+j] = textureData[(int) (texIndex * 3 + j)];
+                texture[i*4+j] = textureData.get((int) (texIndex * 3 + j));
             texture[i*4+3] = (byte) 255;
         }
         return texture;
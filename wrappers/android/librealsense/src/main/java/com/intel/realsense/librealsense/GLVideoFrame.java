@@ -47,15 +47,8 @@ public class GLVideoFrame extends GLFrame {
             return;
 
         try(VideoFrame vf = mFrame.as(Extension.VIDEO_FRAME)) {
-            int size = vf.getStride() * vf.getHeight();
-            if(mBuffer == null || mBuffer.array().length != size){
-                mBuffer = ByteBuffer.allocate(size);
-                mBuffer.order(ByteOrder.LITTLE_ENDIAN);
-            }
-            mFrame.getData(mBuffer.array());
-            mBuffer.rewind();
-
-            upload(vf, mBuffer, mGlTexture.get(0));
+            // Uploaded straight from the frame's memory, which mFrame holds until the next frame
+            upload(vf, vf.getDataBuffer(), mGlTexture.get(0));
             Rect r = adjustRatio(rect);
             draw(r, mGlTexture.get(0));
         }
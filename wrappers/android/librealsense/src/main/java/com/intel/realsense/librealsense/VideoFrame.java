@@ -1,5 +1,9 @@
 package com.intel.realsense.librealsense;
 
+import android.annotation.TargetApi;
+import android.hardware.HardwareBuffer;
+import android.os.Build;
+
 public class VideoFrame extends Frame {
     private int mWidth = -1;
     private int mHeight = -1;
@@ -30,6 +34,17 @@ public class VideoFrame extends Frame {
         return mBitsPerPixel;
     }
 
+    /**
+     * Copies the frame into a HardwareBuffer, e.g. to bind it as a texture without one more copy by GL.
+     * The buffer must be able to hold the frame's rows: at least its height, and rows of at least its width of
+     * pixels of its format's size (any of the RGB formats, R5G6B5, or BLOB for the data as it is).
+     * The buffer has to be allocated with USAGE_CPU_WRITE_OFTEN.
+     */
+    @TargetApi(Build.VERSION_CODES.O)
+    public void copyTo(HardwareBuffer buffer) {
+        nCopyToHardwareBuffer(mHandle, buffer);
+    }
+
     public VideoStreamProfile getProfile() {
         return new VideoStreamProfile(nGetStreamProfile(mHandle));
     }
@@ -43,4 +58,5 @@ public class VideoFrame extends Frame {
     private static native int nGetHeight(long handle);
     private static native int nGetStride(long handle);
     private static native int nGetBitsPerPixel(long handle);
+    private static native void nCopyToHardwareBuffer(long handle, Object buffer);
 }
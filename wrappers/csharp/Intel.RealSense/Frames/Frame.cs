@@ -151,6 +151,16 @@ namespace Intel.RealSense
             }
         }
 
+        /// <summary>
+        /// Get a view of the frame data that keeps its own reference to the frame
+        /// </summary>
+        /// <remarks>The view must be disposed to release the frame</remarks>
+        /// <returns>zero-copy view of the frame data</returns>
+        public FrameData GetData()
+        {
+            return new FrameData(Handle);
+        }
+
         /// <summary>
         /// Returns the stream profile that was used to start the stream of this frame
         /// </summary>
@@ -0,0 +1,86 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+namespace Intel.RealSense
+{
+    using System;
+
+    /// <summary>
+    /// View of the native frame buffer, without copying it
+    /// </summary>
+    /// <remarks>
+    /// Holds its own reference to the frame, so the buffer stays valid after the <see cref="Frame"/> is disposed
+    /// and until this view is; always dispose it, or the frame is never returned to its pool
+    /// </remarks>
+    public sealed class FrameData : IDisposable
+    {
+        private IntPtr frame;
+
+        internal FrameData(IntPtr frameHandle)
+        {
+            object error;
+            NativeMethods.rs2_frame_add_ref(frameHandle, out error);
+            frame = frameHandle;
+            Pointer = NativeMethods.rs2_get_frame_data(frame, out error);
+            Size = NativeMethods.rs2_get_frame_data_size(frame, out error);
+        }
+
+        ~FrameData()
+        {
+            Release();
+        }
+
+        /// <summary>Gets a pointer to the start of the frame data, valid until disposed</summary>
+        public IntPtr Pointer { get; private set; }
+
+        /// <summary>Gets the size of the frame data, in bytes</summary>
+        public int Size { get; private set; }
+
+        /// <summary>
+        /// Copy the data into a pinned array
+        /// </summary>
+        /// <typeparam name="T">array element type</typeparam>
+        /// <param name="array">array to copy into, at least <see cref="Size"/> bytes</param>
+        /// <exception cref="ArgumentNullException">Thrown when <paramref name="array"/> is null</exception>
+        /// <exception cref="ArgumentException">Thrown when <paramref name="array"/> is too small</exception>
+        public void CopyTo<T>(PinnedArray<T> array)
+        {
+            if (array == null)
+            {
+                throw new ArgumentNullException(nameof(array));
+            }
+
+            if (array.SizeInBytes < Size)
+            {
+                throw new ArgumentException("array is smaller than the frame data", nameof(array));
+            }
+
+            if (Pointer == IntPtr.Zero)
+            {
+                throw new ObjectDisposedException(nameof(FrameData));
+            }
+
+            NativeMethods.Memcpy(array.Address, Pointer, Size);
+        }
+
+        /// <summary>
+        /// Release the frame reference; <see cref="Pointer"/> must not be used after that
+        /// </summary>
+        public void Dispose()
+        {
+            Release();
+            GC.SuppressFinalize(this);
+        }
+
+        private void Release()
+        {
+            if (frame != IntPtr.Zero)
+            {
+                NativeMethods.rs2_release_frame(frame);
+                frame = IntPtr.Zero;
+                Pointer = IntPtr.Zero;
+                Size = 0;
+            }
+        }
+    }
+}
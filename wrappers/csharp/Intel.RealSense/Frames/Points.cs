@@ -74,6 +74,23 @@ namespace Intel.RealSense
             }
         }
 
+        /// <summary>
+        /// Copy vertex data to a pinned array, without pinning it again
+        /// </summary>
+        /// <typeparam name="T">array element type</typeparam>
+        /// <param name="vertices">Array to copy into</param>
+        /// <exception cref="ArgumentNullException">Thrown when <paramref name="vertices"/> is null</exception>
+        public void CopyVertices<T>(PinnedArray<T> vertices)
+        {
+            if (vertices == null)
+            {
+                throw new ArgumentNullException(nameof(vertices));
+            }
+
+            Debug.Assert(vertices.SizeInBytes == Count * 3 * sizeof(float));
+            Copy<T>(VertexData, vertices.Address, Count * 3 * sizeof(float));
+        }
+
         /// <summary>Gets a pointer to an array of texture coordinates per vertex</summary>
         /// <remarks>
         /// Each coordinate represent a (u,v) pair within [0,1] range, to be mapped to texture image
@@ -93,6 +93,23 @@ namespace Intel.RealSense
             }
         }
 
+        /// <summary>
+        /// Copy frame data to a pinned array, without pinning it again
+        /// </summary>
+        /// <typeparam name="T">array element type</typeparam>
+        /// <param name="array">array to copy into</param>
+        /// <exception cref="ArgumentNullException">Thrown when <paramref name="array"/> is null</exception>
+        public void CopyTo<T>(PinnedArray<T> array)
+        {
+            if (array == null)
+            {
+                throw new ArgumentNullException(nameof(array));
+            }
+
+            Debug.Assert(array.SizeInBytes >= Stride * Height);
+            CopyTo(array.Address);
+        }
+
         /// <summary>
         /// Copy frame data to pointer
         /// </summary>
@@ -133,6 +150,23 @@ namespace Intel.RealSense
             }
         }
 
+        /// <summary>
+        /// Copy data from a pinned array, without pinning it again
+        /// </summary>
+        /// <typeparam name="T">array element type</typeparam>
+        /// <param name="array">array to copy from</param>
+        /// <exception cref="ArgumentNullException">Thrown when <paramref name="array"/> is null</exception>
+        public void CopyFrom<T>(PinnedArray<T> array)
+        {
+            if (array == null)
+            {
+                throw new ArgumentNullException(nameof(array));
+            }
+
+            Debug.Assert(array.SizeInBytes >= Stride * Height);
+            CopyFrom(array.Address);
+        }
+
         /// <summary>
         /// Copy data from pointer
         /// </summary>
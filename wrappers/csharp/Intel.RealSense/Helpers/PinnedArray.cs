@@ -0,0 +1,176 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+namespace Intel.RealSense
+{
+    using System;
+    using System.Collections.Generic;
+    using System.Runtime.InteropServices;
+
+    /// <summary>
+    /// Managed array that stays pinned until disposed, so frame data can be copied into it
+    /// without pinning on every call
+    /// </summary>
+    /// <typeparam name="T">array element type, must be blittable</typeparam>
+    public sealed class PinnedArray<T> : IDisposable
+    {
+        private GCHandle handle;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="PinnedArray{T}"/> class.
+        /// </summary>
+        /// <param name="length">number of elements</param>
+        public PinnedArray(int length)
+            : this(new T[length])
+        {
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="PinnedArray{T}"/> class, pinning an existing array
+        /// </summary>
+        /// <param name="array">array to pin</param>
+        /// <exception cref="ArgumentNullException">Thrown when <paramref name="array"/> is null</exception>
+        public PinnedArray(T[] array)
+        {
+            if (array == null)
+            {
+                throw new ArgumentNullException(nameof(array));
+            }
+
+            Array = array;
+            handle = GCHandle.Alloc(array, GCHandleType.Pinned);
+            Address = handle.AddrOfPinnedObject();
+        }
+
+        /// <summary>Gets the pinned array</summary>
+        public T[] Array { get; private set; }
+
+        /// <summary>Gets the address of the first element, valid until disposed</summary>
+        public IntPtr Address { get; private set; }
+
+        /// <summary>Gets the number of elements</summary>
+        public int Length
+        {
+            get
+            {
+                return Array == null ? 0 : Array.Length;
+            }
+        }
+
+        /// <summary>Gets the size of the array, in bytes</summary>
+        public int SizeInBytes
+        {
+            get
+            {
+                return Length * Marshal.SizeOf(typeof(T));
+            }
+        }
+
+        /// <summary>
+        /// Unpins the array; <see cref="Array"/> stays usable as a regular managed array
+        /// </summary>
+        public void Dispose()
+        {
+            if (handle.IsAllocated)
+            {
+                handle.Free();
+            }
+
+            Address = IntPtr.Zero;
+        }
+    }
+
+    /// <summary>
+    /// Recycles pinned arrays, avoids allocation and GC pauses when copying frames into managed memory
+    /// </summary>
+    /// <typeparam name="T">array element type, must be blittable</typeparam>
+    public sealed class PinnedArrayPool<T>
+    {
+        private static readonly PinnedArrayPool<T> SharedPool = new PinnedArrayPool<T>();
+
+        private readonly Stack<PinnedArray<T>> free = new Stack<PinnedArray<T>>();
+        private readonly object sync = new object();
+
+        /// <summary>Gets a process-wide pool</summary>
+        public static PinnedArrayPool<T> Shared
+        {
+            get
+            {
+                return SharedPool;
+            }
+        }
+
+        /// <summary>Gets the number of arrays waiting to be reused</summary>
+        public int Count
+        {
+            get
+            {
+                lock (sync)
+                {
+                    return free.Count;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Get a pinned array of exactly <paramref name="length"/> elements, should be returned with <see cref="Return"/>
+        /// </summary>
+        /// <param name="length">number of elements</param>
+        /// <returns>a pinned array</returns>
+        public PinnedArray<T> Rent(int length)
+        {
+            if (length < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(length));
+            }
+
+            lock (sync)
+            {
+                // Frames of a stream all have the same size, so arrays of other sizes are just dropped
+                while (free.Count > 0)
+                {
+                    var a = free.Pop();
+                    if (a.Length == length)
+                    {
+                        return a;
+                    }
+
+                    a.Dispose();
+                }
+            }
+
+            return new PinnedArray<T>(length);
+        }
+
+        /// <summary>
+        /// Return an array to the pool; it must not be used after that
+        /// </summary>
+        /// <param name="array">array to return</param>
+        public void Return(PinnedArray<T> array)
+        {
+            if (array == null || array.Address == IntPtr.Zero)
+            {
+                return;
+            }
+
+            lock (sync)
+            {
+                free.Push(array);
+            }
+        }
+
+        /// <summary>
+        /// Unpin and drop every array in the pool
+        /// </summary>
+        public void Clear()
+        {
+            lock (sync)
+            {
+                while (free.Count > 0)
+                {
+                    free.Pop().Dispose();
+                }
+            }
+        }
+    }
+}
@@ -32,5 +32,11 @@ namespace Intel.RealSense
 
         /// <summary> A relocalization event has updated the pose provided by a pose sensor</summary>
         PoseRelocalization = 6,
+
+        /// <summary> Frames were dropped by the recorder and are missing from the file</summary>
+        FramesDropped = 7,
+
+        /// <summary> A processing graph lowered its quality to keep up with the frames, or restored it</summary>
+        ProcessingLoad = 8,
     }
 }
@@ -0,0 +1,90 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/rs.hpp>
+
+#include <open3d/core/Tensor.h>
+#include <open3d/t/geometry/PointCloud.h>
+
+#include <stdexcept>
+
+namespace rs2
+{
+    namespace open3d_interop
+    {
+        // Returns true, with the number of points, if the points are in RS2_POINTS_LAYOUT_PACKED_FLOAT
+        inline bool packed_point_count( const rs2::points & points, int64_t & count )
+        {
+            if( ! points.supports_frame_metadata( RS2_FRAME_METADATA_POINT_COUNT ) )
+                return false;
+            count = int64_t( points.get_frame_metadata( RS2_FRAME_METADATA_POINT_COUNT ) );
+            if( int64_t( points.get_data_size() ) != count * 5 * int64_t( sizeof( float ) ) )
+                throw std::runtime_error( "only RS2_POINTS_LAYOUT_PACKED_FLOAT can be converted to Open3D; "
+                                          "the half-precision and millimeter layouts need unpacking" );
+            return true;
+        }
+
+        // A tensor over the frame's own memory, which keeps the frame alive for as long as it's referenced
+        inline open3d::core::Tensor wrap( const rs2::frame & f, const void * data, int device,
+                                          const open3d::core::SizeVector & shape,
+                                          const open3d::core::SizeVector & strides )
+        {
+            using open3d::core::Device;
+            auto where = device < 0 ? Device( Device::DeviceType::CPU, 0 ) : Device( Device::DeviceType::CUDA, device );
+            auto ptr = const_cast< void * >( data );
+            auto blob = std::make_shared< open3d::core::Blob >( where, ptr, [f]( void * ) {} );
+            return open3d::core::Tensor( shape, strides, ptr, open3d::core::Dtype::Float32, blob );
+        }
+    }
+
+    /**
+    * View the valid points (the ones with depth, inside the pointcloud's bounds) as an Nx3 Float32 tensor.
+    * With RS2_POINTS_LAYOUT_PACKED_FLOAT nothing is copied: the tensor is a strided view of the x, y and z
+    * arrays, on the GPU if a CUDA pointcloud left them there; Contiguous() makes a dense copy in one pass.
+    * With the interleaved layout the points without depth have to be gathered out, which copies the rest.
+    * \param[in] points   a points frame
+    * \return             the points, in meters
+    */
+    inline open3d::core::Tensor points_to_tensor( const rs2::points & points )
+    {
+        int device = -1;
+        auto data = points.get_cuda_data( &device );
+        if( ! data )
+            device = -1;
+
+        int64_t count;
+        if( open3d_interop::packed_point_count( points, count ) )
+        {
+            if( ! data )
+                data = points.get_data();
+            // x[count], y[count], z[count]: point i is at i, with a stride of count between coordinates
+            return open3d_interop::wrap( points, data, device, { count, 3 }, { 1, count ? count : 1 } );
+        }
+
+        auto n = int64_t( points.size() );
+        if( ! data )
+            data = points.get_vertices();
+        auto all = open3d_interop::wrap( points, data, device, { n, 3 }, { 3, 1 } );
+        auto valid = all.Slice( 1, 2, 3 ).Reshape( { n } ).Ne( 0.f );
+        return all.IndexGet( { valid } );
+    }
+
+    /**
+    * Build an Open3D point cloud from the valid points, without copying them where possible (see
+    * points_to_tensor); the cloud then holds on to the frame.
+    * \param[in] points   a points frame
+    * \param[in] device   where the cloud should be; the points are copied there, in one block, if they're elsewhere
+    * \return             the cloud
+    */
+    inline open3d::t::geometry::PointCloud points_to_open3d( const rs2::points & points,
+                                                             const open3d::core::Device & device
+                                                             = open3d::core::Device( "CPU:0" ) )
+    {
+        auto positions = points_to_tensor( points );
+        if( positions.GetDevice() != device )
+            positions = positions.Contiguous().To( device );
+        return open3d::t::geometry::PointCloud( positions );
+    }
+}
@@ -5,43 +5,185 @@
 
 #include <librealsense2/rs.hpp> // Include RealSense Cross Platform API
 #include <opencv2/opencv.hpp>   // Include OpenCV API
+#include <opencv2/core/cuda.hpp>
 #include <exception>
 
-// Convert rs2::frame to cv::Mat
-static cv::Mat frame_to_mat(const rs2::frame& f)
+// OpenCV element type of a rs2_format, or -1 for the formats that are packed or compressed (and need converting first)
+static int format_to_cv_type(rs2_format format)
 {
-    using namespace cv;
-    using namespace rs2;
+    switch (format)
+    {
+    case RS2_FORMAT_Z16:
+    case RS2_FORMAT_DISPARITY16:
+    case RS2_FORMAT_Y16:
+    case RS2_FORMAT_Y10BPACK:
+    case RS2_FORMAT_RAW16:
+    case RS2_FORMAT_FG:         return CV_16UC1;
+    case RS2_FORMAT_Y8:
+    case RS2_FORMAT_RAW8:
+    case RS2_FORMAT_INVI:       return CV_8UC1;
+    case RS2_FORMAT_Y8I:
+    case RS2_FORMAT_YUYV:
+    case RS2_FORMAT_UYVY:       return CV_8UC2;
+    case RS2_FORMAT_Y16I:       return CV_16UC2;
+    case RS2_FORMAT_RGB8:
+    case RS2_FORMAT_BGR8:       return CV_8UC3;
+    case RS2_FORMAT_RGBA8:
+    case RS2_FORMAT_BGRA8:      return CV_8UC4;
+    case RS2_FORMAT_DISPARITY32:
+    case RS2_FORMAT_DISTANCE:   return CV_32FC1;
+    case RS2_FORMAT_XYZ32F:     return CV_32FC3;
+    default:                    return -1;
+    }
+}
 
-    auto vf = f.as<video_frame>();
-    const int w = vf.get_width();
-    const int h = vf.get_height();
+// Lets cv::Mat reference-count a frame's own buffer: the frame is released with the last Mat that shares it
+class frame_mat_allocator : public cv::MatAllocator
+{
+public:
+#if CV_VERSION_MAJOR >= 4
+    typedef cv::AccessFlag access_flags;
+#else
+    typedef int access_flags;
+#endif
 
-    if (f.get_profile().format() == RS2_FORMAT_BGR8)
+    static frame_mat_allocator& instance()
     {
-        return Mat(Size(w, h), CV_8UC3, (void*)f.get_data(), Mat::AUTO_STEP);
+        static frame_mat_allocator allocator;
+        return allocator;
     }
-    else if (f.get_profile().format() == RS2_FORMAT_RGB8)
+
+    cv::UMatData* wrap(const rs2::frame& f, size_t size) const
     {
-        auto r_rgb = Mat(Size(w, h), CV_8UC3, (void*)f.get_data(), Mat::AUTO_STEP);
-        Mat r_bgr;
-        cvtColor(r_rgb, r_bgr, COLOR_RGB2BGR);
-        return r_bgr;
+        auto u = new cv::UMatData(this);
+        u->data = u->origdata = (uchar*)f.get_data();
+        u->size = size;
+        u->userdata = new rs2::frame(f);
+        return u;
     }
-    else if (f.get_profile().format() == RS2_FORMAT_Z16)
+
+    // Mats that get re-created (e.g. as the output of an operation) get regular memory
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                           access_flags flags, cv::UMatUsageFlags usage) const override
     {
-        return Mat(Size(w, h), CV_16UC1, (void*)f.get_data(), Mat::AUTO_STEP);
+        return cv::Mat::getDefaultAllocator()->allocate(dims, sizes, type, data, step, flags, usage);
     }
-    else if (f.get_profile().format() == RS2_FORMAT_Y8)
+
+    bool allocate(cv::UMatData*, access_flags, cv::UMatUsageFlags) const override { return false; }
+
+    void deallocate(cv::UMatData* u) const override
     {
-        return Mat(Size(w, h), CV_8UC1, (void*)f.get_data(), Mat::AUTO_STEP);
+        if (!u)
+            return;
+        delete static_cast<rs2::frame*>(u->userdata);
+        delete u;
     }
-    else if (f.get_profile().format() == RS2_FORMAT_DISPARITY32)
+};
+
+// Same for cv::cuda::GpuMat, which keeps its reference count separately
+class frame_gpumat_allocator : public cv::cuda::GpuMat::Allocator
+{
+    struct holder
+    {
+        int refcount;
+        rs2::frame* frame;
+    };
+
+public:
+    static frame_gpumat_allocator& instance()
+    {
+        static frame_gpumat_allocator allocator;
+        return allocator;
+    }
+
+    void wrap(cv::cuda::GpuMat& m, const rs2::frame& f) const
     {
-        return Mat(Size(w, h), CV_32FC1, (void*)f.get_data(), Mat::AUTO_STEP);
+        auto h = new holder{ 1, new rs2::frame(f) };
+        m.refcount = &h->refcount;
+        m.allocator = const_cast<frame_gpumat_allocator*>(this);
     }
 
-    throw std::runtime_error("Frame format is not supported yet!");
+    // Falls back to the default allocator when the GpuMat is re-created
+    bool allocate(cv::cuda::GpuMat*, int, int, size_t) override { return false; }
+
+    void free(cv::cuda::GpuMat* m) override
+    {
+        auto h = reinterpret_cast<holder*>(m->refcount);
+        delete h->frame;
+        delete h;
+    }
+};
+
+// View a video frame as a cv::Mat, without copying it; the Mat (and the Mats that share its data) hold on to the frame
+static cv::Mat frame_as_mat(const rs2::frame& f)
+{
+    auto vf = f.as<rs2::video_frame>();
+    if (!vf)
+        throw std::runtime_error("Only video frames can be viewed as cv::Mat");
+    auto type = format_to_cv_type(f.get_profile().format());
+    if (type < 0)
+        throw std::runtime_error(std::string("Frame format ") + rs2_format_to_string(f.get_profile().format())
+                                 + " has no cv::Mat equivalent; convert it first");
+
+    auto step = size_t(vf.get_stride_in_bytes());
+    cv::Mat m(vf.get_height(), vf.get_width(), type, (void*)f.get_data(), step);
+    auto& allocator = frame_mat_allocator::instance();
+    m.allocator = &allocator;
+    m.u = allocator.wrap(f, step * vf.get_height());
+    m.addref();
+    return m;
+}
+
+// View a video frame as a cv::cuda::GpuMat: without copying when a CUDA processing block left it on the GPU, and
+// uploaded to the current device otherwise
+static cv::cuda::GpuMat frame_as_gpumat(const rs2::frame& f)
+{
+    auto vf = f.as<rs2::video_frame>();
+    if (!vf)
+        throw std::runtime_error("Only video frames can be viewed as cv::cuda::GpuMat");
+
+    int device = -1;
+    auto data = f.get_cuda_data(&device);
+    if (!data)
+    {
+        cv::cuda::GpuMat m;
+        m.upload(frame_as_mat(f));
+        return m;
+    }
+
+    auto type = format_to_cv_type(f.get_profile().format());
+    if (type < 0)
+        throw std::runtime_error(std::string("Frame format ") + rs2_format_to_string(f.get_profile().format())
+                                 + " has no cv::cuda::GpuMat equivalent; convert it first");
+
+    // The data is on the frame's device, which the caller has to be using
+    cv::cuda::GpuMat m(vf.get_height(), vf.get_width(), type, const_cast<void*>(data), size_t(vf.get_stride_in_bytes()));
+    frame_gpumat_allocator::instance().wrap(m, f);
+    return m;
+}
+
+// Convert rs2::frame to cv::Mat, in BGR for color frames
+static cv::Mat frame_to_mat(const rs2::frame& f)
+{
+    using namespace cv;
+
+    switch (f.get_profile().format())
+    {
+    case RS2_FORMAT_RGB8:
+    {
+        Mat r_bgr;
+        cvtColor(frame_as_mat(f), r_bgr, COLOR_RGB2BGR);
+        return r_bgr;
+    }
+    case RS2_FORMAT_RGBA8:
+    {
+        Mat r_bgr;
+        cvtColor(frame_as_mat(f), r_bgr, COLOR_RGBA2BGR);
+        return r_bgr;
+    }
+    default:
+        return frame_as_mat(f);
+    }
 }
 
 // Converts depth frame to a matrix of doubles with distances in meters
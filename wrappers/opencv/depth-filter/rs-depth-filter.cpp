@@ -4,6 +4,7 @@
 #include <librealsense2/rs.hpp> // Include RealSense Cross Platform API
 #include <librealsense2/rs_advanced_mode.hpp>
 #include <opencv2/opencv.hpp>   // Include OpenCV API
+#include "../cv-helpers.hpp"    // Helper functions for conversions between RealSense and OpenCV
 
 #include <fstream>
 
@@ -96,8 +97,8 @@ private:
                 p.width() / DOWNSAMPLE_FACTOR, p.height() / DOWNSAMPLE_FACTOR, intr);
         }
 
-        cv::Mat matDepth(cv::Size(depth_frame.get_width(), depth_frame.get_height()), CV_16U, (void*)depth_frame.get_data(), cv::Mat::AUTO_STEP);
-        cv::Mat matGray(cv::Size(ir_frame.get_width(), ir_frame.get_height()), CV_8U, (void*)ir_frame.get_data(), cv::Mat::AUTO_STEP);
+        cv::Mat matDepth = frame_as_mat(depth_frame);
+        cv::Mat matGray = frame_as_mat(ir_frame);
         
         downsample(matDepth, matGray);
 
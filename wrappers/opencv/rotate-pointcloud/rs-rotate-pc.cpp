@@ -1,6 +1,7 @@
 
 #include <librealsense2/rs.hpp> // Include RealSense Cross Platform API
 #include <opencv2/opencv.hpp>   // Include OpenCV API
+#include "../cv-helpers.hpp"    // Helper functions for conversions between RealSense and OpenCV
 
 using namespace cv;
 
@@ -74,10 +75,7 @@ int main(int argc, char * argv[]) try
 
     rs2::processing_block procBlock( [&](rs2::frame f, rs2::frame_source& src )
     {
-        const int origWidth = f.as<rs2::video_frame>().get_width();
-        const int origHeight = f.as<rs2::video_frame>().get_height();
-
-        cv::Mat image(cv::Size(origWidth, origHeight), CV_16UC1, (void*)f.get_data(), cv::Mat::AUTO_STEP);
+        cv::Mat image = frame_as_mat(f);
         cv::Mat rotated;
 
         if ( !is_yaw && !is_roll )
@@ -135,12 +133,8 @@ int main(int argc, char * argv[]) try
         procBlock.invoke( depthFrame );
         depthFrame = frame_queue.wait_for_frame();
 
-        // Query frame size (width and height)
-        const int w = depthFrame.as<rs2::video_frame>().get_width();
-        const int h = depthFrame.as<rs2::video_frame>().get_height();
-
-        // Create OpenCV matrix of size (w,h) from the colorized depth data
-        cv::Mat image(cv::Size(w, h), CV_8UC3, (void*)depthFrame.apply_filter(color_map).get_data());
+        // Create OpenCV matrix of size (w,h) from the colorized depth data, which it holds on to
+        cv::Mat image = frame_as_mat(depthFrame.apply_filter(color_map));
 
         // Rescale image for convenience
         if ( ( image.size().width > 1000 ) || (image.size().height > 1000) )
@@ -68,6 +68,8 @@ namespace openvino_helpers
                 deviceName.find( "GPU" ) != std::string::npos;
             if( isPossibleDynBatch )
                 config[PluginConfigParams::KEY_DYN_BATCH_ENABLED] = PluginConfigParams::YES;
+            else
+                isBatchDynamic = false;     // So the users know to always fill the whole batch
         }
 
         //LOG(INFO) << "Loading " << topoName << " model to the " << deviceName << " device";
@@ -0,0 +1,213 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <rs-vino/inference-scheduler.h>
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <algorithm>
+
+
+using namespace InferenceEngine;
+
+
+namespace openvino_helpers
+{
+    inference_scheduler::inference_scheduler(
+        const std::string & pathToModel,
+        double detectionThreshold,
+        const std::string & deviceName,
+        size_t max_batch,
+        size_t n_requests
+    )
+        : _detector( pathToModel, detectionThreshold, true, static_cast< int >( max_batch ), true )
+        , _max_batch( std::max< size_t >( max_batch, 1 ) )
+        , _n_active( 0 )
+        , _stopping( false )
+    {
+        // Cpu extensions library was removed in OpenVINO >= 2020.1, extensions were merged into the cpu plugin.
+#ifdef OPENVINO2019
+        if( deviceName.find( "CPU" ) != std::string::npos )
+            _ie.AddExtension( std::make_shared< Extensions::Cpu::CpuExtensions >(), "CPU" );
+#endif
+        _detector.load_into( _ie, deviceName );
+        if( _detector.enabled() )
+        {
+            for( size_t i = 0; i < std::max< size_t >( n_requests, 1 ); ++i )
+            {
+                _requests.push_back( _detector->CreateInferRequestPtr() );
+                _free.push_back( i );
+            }
+        }
+        _thread = std::thread( [this]() { run(); } );
+    }
+
+
+    inference_scheduler::~inference_scheduler()
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _stopping = true;
+        }
+        _cv.notify_all();
+        _thread.join();
+
+        // The completion callbacks use us: wait for those in flight
+        std::unique_lock< std::mutex > lock( _mutex );
+        _cv.wait( lock, [this]() { return _free.size() == _requests.size(); } );
+        for( auto & cam : _cameras )
+            if( cam.pending )
+                cam.pending->promise.set_value( results() );
+    }
+
+
+    size_t inference_scheduler::add_camera( std::chrono::milliseconds deadline )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _cameras.push_back( camera{ deadline, nullptr, true } );
+        ++_n_active;
+        return _cameras.size() - 1;
+    }
+
+
+    void inference_scheduler::remove_camera( size_t camera )
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            if( camera >= _cameras.size() || !_cameras[camera].active )
+                return;
+            auto & cam = _cameras[camera];
+            cam.active = false;
+            --_n_active;
+            if( cam.pending )
+            {
+                cam.pending->promise.set_value( results() );
+                cam.pending.reset();
+            }
+        }
+        _cv.notify_all();
+    }
+
+
+    std::future< inference_scheduler::results > inference_scheduler::submit( size_t camera, rs2::video_frame frame )
+    {
+        std::unique_ptr< job > j( new job );
+        j->width = static_cast< float >( frame.get_width() );
+        j->height = static_cast< float >( frame.get_height() );
+        j->frame = std::move( frame );
+        auto future = j->promise.get_future();
+        if( !_detector.enabled() )
+        {
+            j->promise.set_value( results() );
+            return future;
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            if( camera >= _cameras.size() || !_cameras[camera].active )
+                throw std::logic_error( "invalid camera " + std::to_string( camera ) );
+            auto & cam = _cameras[camera];
+            j->due = clock::now() + cam.deadline;
+            if( cam.pending )
+            {
+                // Still waiting for a batch: the newer frame goes instead, by the old one's deadline
+                j->due = std::min( j->due, cam.pending->due );
+                cam.pending->promise.set_value( results() );
+            }
+            cam.pending = std::move( j );
+        }
+        _cv.notify_all();
+        return future;
+    }
+
+
+    void inference_scheduler::run()
+    {
+        std::unique_lock< std::mutex > lock( _mutex );
+        while( !_stopping )
+        {
+            std::vector< camera * > waiting;
+            for( auto & cam : _cameras )
+                if( cam.pending )
+                    waiting.push_back( &cam );
+            if( waiting.empty() || _free.empty() )
+            {
+                _cv.wait( lock );
+                continue;
+            }
+
+            // Oldest deadlines first
+            std::sort( waiting.begin(), waiting.end(),
+                       []( camera * a, camera * b ) { return a->pending->due < b->pending->due; } );
+            bool full = waiting.size() >= std::min( _max_batch, _n_active );
+            auto due = waiting.front()->pending->due;
+            if( !full && clock::now() < due )
+            {
+                _cv.wait_until( lock, due );
+                continue;
+            }
+
+            std::vector< std::unique_ptr< job > > jobs;
+            for( size_t i = 0; i < waiting.size() && i < _max_batch; ++i )
+                jobs.push_back( std::move( waiting[i]->pending ) );
+            size_t request = _free.back();
+            _free.pop_back();
+
+            lock.unlock();
+            start( request, std::move( jobs ) );
+            lock.lock();
+        }
+    }
+
+
+    void inference_scheduler::start( size_t request, std::vector< std::unique_ptr< job > > jobs )
+    {
+        auto shared_jobs = std::make_shared< std::vector< std::unique_ptr< job > > >( std::move( jobs ) );
+        try
+        {
+            auto & r = *_requests[request];
+            for( size_t i = 0; i < shared_jobs->size(); ++i )
+            {
+                auto & j = *( *shared_jobs )[i];
+                _detector.enqueue( r, j.frame, i );
+                j.frame = rs2::frame{};
+            }
+            // Without a dynamic batch the whole of it is inferred: the images past ours are left from before, and
+            // their results are ignored
+            if( _detector.isBatchDynamic )
+                r.SetBatch( static_cast< int >( shared_jobs->size() ) );
+
+            r.SetCompletionCallback( [this, request, shared_jobs]() { complete( request, *shared_jobs ); } );
+            r.StartAsync();
+        }
+        catch( ... )
+        {
+            for( auto & j : *shared_jobs )
+                j->promise.set_exception( std::current_exception() );
+            std::lock_guard< std::mutex > lock( _mutex );
+            _free.push_back( request );
+            _cv.notify_all();
+        }
+    }
+
+
+    void inference_scheduler::complete( size_t request, std::vector< std::unique_ptr< job > > & jobs )
+    {
+        auto & r = *_requests[request];
+        for( size_t i = 0; i < jobs.size(); ++i )
+        {
+            try
+            {
+                jobs[i]->promise.set_value( _detector.fetch_results( r, i, jobs[i]->width, jobs[i]->height ) );
+            }
+            catch( ... )
+            {
+                jobs[i]->promise.set_exception( std::current_exception() );
+            }
+        }
+
+        // Notified under the lock: once it's released, the destructor may go on
+        std::lock_guard< std::mutex > lock( _mutex );
+        _free.push_back( request );
+        _cv.notify_all();
+    }
+}
@@ -0,0 +1,91 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "object-detection.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace openvino_helpers
+{
+    /*
+        Runs one object detection network for several cameras at once.
+
+        Each camera submits its frames and gets a future for their results. The frames of the cameras are gathered
+        into a single batched request, which is sent when it has a frame from each camera (or max_batch of them), or
+        when the deadline of the oldest frame in it is up, whichever comes first. A frame that a camera submits while
+        its previous one is still waiting takes the place of the latter, whose results are empty: a camera that is
+        running late doesn't delay the others.
+
+        Up to n_requests batches are in flight at once, asynchronously. The frames are read into the requests
+        directly (resizing them and converting them to BGR on the way) and released as soon as they are, so they
+        return to their pool before the inference completes.
+    */
+    class inference_scheduler
+    {
+    public:
+        typedef std::vector< object_detection::Result > results;
+        typedef std::chrono::steady_clock clock;
+
+        inference_scheduler( const std::string & pathToModel,
+            double detectionThreshold,
+            const std::string & deviceName = "CPU",
+            size_t max_batch = 8,
+            size_t n_requests = 2 );
+        ~inference_scheduler();
+
+        // Returns the id of a new camera, whose frames are sent no more than 'deadline' after they're submitted
+        size_t add_camera( std::chrono::milliseconds deadline );
+        // So the batches stop waiting for its frames; the results of the one it still has waiting are empty
+        void remove_camera( size_t camera );
+
+        // The results are located in the frame as it is, whatever the size of the network's input
+        std::future< results > submit( size_t camera, rs2::video_frame frame );
+
+        size_t max_batch() const { return _max_batch; }
+
+    private:
+        struct job
+        {
+            rs2::video_frame frame;
+            float width, height;
+            clock::time_point due;
+            std::promise< results > promise;
+
+            job() : frame( rs2::frame{} ), width( 0 ), height( 0 ) {}
+        };
+
+        struct camera
+        {
+            std::chrono::milliseconds deadline;
+            std::unique_ptr< job > pending;
+            bool active;
+        };
+
+        void run();
+        // Fills a request with the jobs and starts it; it is back among the free ones once the results are out
+        void start( size_t request, std::vector< std::unique_ptr< job > > jobs );
+        void complete( size_t request, std::vector< std::unique_ptr< job > > & jobs );
+
+        InferenceEngine::Core _ie;
+        object_detection _detector;
+        const size_t _max_batch;
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::vector< camera > _cameras;
+        size_t _n_active;                   // Of _cameras
+        std::vector< InferenceEngine::InferRequest::Ptr > _requests;
+        std::vector< size_t > _free;        // Indices of the requests not in flight
+        bool _stopping;
+        std::thread _thread;
+    };
+}
@@ -51,23 +51,42 @@ namespace openvino_helpers
 
         Blob::Ptr  inputBlob = _request->GetBlob( _input_layer_name );
         matU8ToBlob<uint8_t>( frame, inputBlob );
-
-        if( ! _im_info_name.empty() )
-        {
-            Blob::Ptr infoBlob = _request->GetBlob( _im_info_name );
-
-            // (height, width, image_scale)
-            float * p = infoBlob->buffer().as< PrecisionTrait< Precision::FP32 >::value_type * >();
-            p[0] = static_cast< float >( _input_width );
-            p[1] = static_cast< float >( _input_height );
-            for( size_t k = 2; k < _im_info_size; k++ )
-                p[k] = 1.f;  // all scale factors are set to 1.0
-        }
+        set_im_info( *_request, 0 );
 
         _n_enqued_frames = 1;
     }
 
 
+    void object_detection::enqueue( InferRequest & request, const rs2::video_frame & frame, size_t batch_index ) const
+    {
+        if( !enabled() )
+            return;
+
+        Blob::Ptr inputBlob = request.GetBlob( _input_layer_name );
+        frameToBlob< uint8_t >( frame, inputBlob, static_cast< int >( batch_index ) );
+        set_im_info( request, batch_index );
+    }
+
+
+    void object_detection::set_im_info( InferRequest & request, size_t batch_index ) const
+    {
+        if( _im_info_name.empty() )
+            return;
+
+        Blob::Ptr infoBlob = request.GetBlob( _im_info_name );
+        // One row per image, unless the network shares a single one between them all
+        if( batch_index >= infoBlob->getTensorDesc().getDims()[0] )
+            batch_index = 0;
+
+        // (height, width, image_scale)
+        float * p = infoBlob->buffer().as< PrecisionTrait< Precision::FP32 >::value_type * >() + batch_index * _im_info_size;
+        p[0] = static_cast< float >( _input_width );
+        p[1] = static_cast< float >( _input_height );
+        for( size_t k = 2; k < _im_info_size; k++ )
+            p[k] = 1.f;  // all scale factors are set to 1.0
+    }
+
+
     CNNNetwork object_detection::read_network()
     {
         LOG(INFO) << "Loading " << topoName << " model from: " << pathToModel;
@@ -113,7 +132,7 @@ namespace openvino_helpers
                 // Blob "im_info" is optional: 1x3 (height, width, image_scale)
                 _im_info_name = item.first;
                 auto const & dims = item.second->getTensorDesc().getDims();
-                if( dims[0] != 1 )
+                if( dims[0] != 1  &&  dims[0] != maxBatch )
                     throw std::logic_error( "Invalid input info: layer \"" + _im_info_name + "\" should be 1x3 or 1x6" );
                 _im_info_size = dims[1];
                 item.second->setPrecision( Precision::FP32 );
@@ -190,15 +209,25 @@ namespace openvino_helpers
 
 
     std::vector< object_detection::Result > object_detection::fetch_results()
+    {
+        return fetch_results( *_request, 0, _width, _height );
+    }
+
+
+    std::vector< object_detection::Result > object_detection::fetch_results( InferRequest & request, size_t batch_index,
+                                                                             float width, float height ) const
     {
         std::vector< Result > results;
-        const float *detections = _request->GetBlob( _output_layer_name )->buffer().as<float *>();
+        const float *detections = request.GetBlob( _output_layer_name )->buffer().as<float *>();
 
+        // The detections of all the images of a batch are in the same list, by image_id
         for( size_t i = 0; i < _max_results; i++ )
         {
             float image_id = detections[i * DETECTED_OBJECT_SIZE + 0];
             if( image_id < 0 )
                 break;
+            if( static_cast< size_t >( image_id ) != batch_index )
+                continue;
 
             // [image_id, label, confidence, x_min, y_min, x_max, y_max]
             Result r;
@@ -206,10 +235,10 @@ namespace openvino_helpers
             r.confidence = detections[i * DETECTED_OBJECT_SIZE + 2];
             if( r.confidence <= _detection_threshold && !doRawOutputMessages )
                 continue;
-            r.location.x = static_cast<int>(detections[i * DETECTED_OBJECT_SIZE + 3] * _width);
-            r.location.y = static_cast<int>(detections[i * DETECTED_OBJECT_SIZE + 4] * _height);
-            r.location.width = static_cast<int>(detections[i * DETECTED_OBJECT_SIZE + 5] * _width - r.location.x);
-            r.location.height = static_cast<int>(detections[i * DETECTED_OBJECT_SIZE + 6] * _height - r.location.y);
+            r.location.x = static_cast<int>(detections[i * DETECTED_OBJECT_SIZE + 3] * width);
+            r.location.y = static_cast<int>(detections[i * DETECTED_OBJECT_SIZE + 4] * height);
+            r.location.width = static_cast<int>(detections[i * DETECTED_OBJECT_SIZE + 5] * width - r.location.x);
+            r.location.height = static_cast<int>(detections[i * DETECTED_OBJECT_SIZE + 6] * height - r.location.y);
 
             if( doRawOutputMessages )
             {
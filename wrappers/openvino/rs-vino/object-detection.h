@@ -40,6 +40,9 @@ namespace openvino_helpers
         float _width;                     // of the queued image
         float _height;
 
+        // Fills the image info of an image in the batch, if the network has one
+        void set_im_info( InferenceEngine::InferRequest & request, size_t batch_index ) const;
+
     public:
         object_detection( const std::string &pathToModel,
             double detectionThreshold,
@@ -53,6 +56,13 @@ namespace openvino_helpers
         void enqueue( const cv::Mat &frame );
         std::vector< Result > fetch_results();
 
+        // The same, on a request of the caller's rather than our own, for one of the images of a batch: the frame is
+        // read directly into the input blob (see frameToBlob), and the results are located in an image of the given
+        // size. These don't touch the detector's state, so several requests can be in flight at once.
+        void enqueue( InferenceEngine::InferRequest & request, const rs2::video_frame & frame, size_t batch_index ) const;
+        std::vector< Result > fetch_results( InferenceEngine::InferRequest & request, size_t batch_index,
+                                             float width, float height ) const;
+
         float get_width() const { return _width; }
         float get_height() const { return _height; }
     };
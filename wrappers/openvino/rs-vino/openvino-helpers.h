@@ -24,6 +24,7 @@
 
 #pragma warning(pop)
 
+#include <librealsense2/rs.hpp>
 #include <opencv2/opencv.hpp>
 #include <rsutils/easylogging/easyloggingpp.h>
 
@@ -83,6 +84,73 @@ namespace openvino_helpers
     }
 
 
+    /*
+        Sets the image of a librealsense video frame to a given Blob object, resized (bilinear) to the blob's size
+        and with the channels in the BGR order the networks take, straight from the frame's data: no cv::Mat is made
+        of it, and the frame is read as it is, whatever its stride.
+        Takes RGB8, BGR8, RGBA8, BGRA8 and Y8 frames.
+    */
+    template <typename T>
+    void frameToBlob( const rs2::video_frame & frame, InferenceEngine::Blob::Ptr & blob, int batchIndex = 0 )
+    {
+        InferenceEngine::SizeVector blobSize = blob->getTensorDesc().getDims();
+        const int width = int( blobSize[3] );
+        const int height = int( blobSize[2] );
+        const size_t channels = blobSize[1];
+        if( channels != 1 && channels != 3 )
+            THROW_IE_EXCEPTION << "Unsupported number of channels";
+
+        // Where each of the blob's channels (as BGR, or gray) is in a pixel of the frame
+        int order[3];
+        switch( frame.get_profile().format() )
+        {
+        case RS2_FORMAT_RGB8:
+        case RS2_FORMAT_RGBA8: order[0] = 2; order[1] = 1; order[2] = 0; break;
+        case RS2_FORMAT_BGR8:
+        case RS2_FORMAT_BGRA8: order[0] = 0; order[1] = 1; order[2] = 2; break;
+        case RS2_FORMAT_Y8: order[0] = order[1] = order[2] = 0; break;
+        default: THROW_IE_EXCEPTION << "Unsupported frame format " << rs2_format_to_string( frame.get_profile().format() );
+        }
+
+        const int src_width = frame.get_width(), src_height = frame.get_height();
+        const int bpp = frame.get_bytes_per_pixel(), stride = frame.get_stride_in_bytes();
+        const uint8_t * src = reinterpret_cast< const uint8_t * >( frame.get_data() );
+        T * blob_data = blob->buffer().as< T * >() + size_t( batchIndex ) * width * height * channels;
+
+        // The source columns, and their weights, are the same for every row
+        std::vector< int > x0( width ), x1( width );
+        std::vector< float > fx( width );
+        const float sx = float( src_width ) / width, sy = float( src_height ) / height;
+        for( int x = 0; x < width; ++x )
+        {
+            float c = std::max( 0.f, ( x + 0.5f ) * sx - 0.5f );
+            x0[x] = std::min( int( c ), src_width - 1 );
+            x1[x] = std::min( x0[x] + 1, src_width - 1 );
+            fx[x] = c - x0[x];
+        }
+        for( int y = 0; y < height; ++y )
+        {
+            float r = std::max( 0.f, ( y + 0.5f ) * sy - 0.5f );
+            const int y0 = std::min( int( r ), src_height - 1 ), y1 = std::min( y0 + 1, src_height - 1 );
+            const float fy = r - y0;
+            const uint8_t * row0 = src + size_t( y0 ) * stride;
+            const uint8_t * row1 = src + size_t( y1 ) * stride;
+            for( size_t c = 0; c < channels; ++c )
+            {
+                const int offset = channels == 1 ? order[1] : order[c];
+                T * out = blob_data + c * width * height + size_t( y ) * width;
+                for( int x = 0; x < width; ++x )
+                {
+                    const int a = x0[x] * bpp + offset, b = x1[x] * bpp + offset;
+                    const float top = row0[a] + fx[x] * ( row0[b] - row0[a] );
+                    const float bottom = row1[a] + fx[x] * ( row1[b] - row1[a] );
+                    out[x] = static_cast< T >( top + fy * ( bottom - top ) + 0.5f );
+                }
+            }
+        }
+    }
+
+
     /*
         Wraps data stored inside of a passed cv::Mat object by new Blob pointer.
         No memory allocation occurs. The blob just points to existing cv::Mat data.
@@ -3,6 +3,7 @@
 
 #include <librealsense2/rs.hpp> // Include RealSense Cross Platform API
 #include "../../../examples/example.hpp" // Include short list of convenience functions for rendering
+#include "../rs_pcl.hpp"                 // rs2::points to PCL conversion
 
 #include <pcl/point_types.h>
 #include <pcl/filters/passthrough.h>
@@ -20,27 +21,6 @@ using pcl_ptr = pcl::PointCloud<pcl::PointXYZ>::Ptr;
 void register_glfw_callbacks(window& app, state& app_state);
 void draw_pointcloud(window& app, state& app_state, const std::vector<pcl_ptr>& points);
 
-pcl_ptr points_to_pcl(const rs2::points& points)
-{
-    pcl_ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
-
-    auto sp = points.get_profile().as<rs2::video_stream_profile>();
-    cloud->width = sp.width();
-    cloud->height = sp.height();
-    cloud->is_dense = false;
-    cloud->points.resize(points.size());
-    auto ptr = points.get_vertices();
-    for (auto& p : cloud->points)
-    {
-        p.x = ptr->x;
-        p.y = ptr->y;
-        p.z = ptr->z;
-        ptr++;
-    }
-
-    return cloud;
-}
-
 float3 colors[] { { 0.8f, 0.1f, 0.3f }, 
                   { 0.1f, 0.9f, 0.5f },
                 };
@@ -56,6 +36,8 @@ int main(int argc, char * argv[]) try
 
     // Declare pointcloud object, for calculating pointclouds and texture mappings
     rs2::pointcloud pc;
+    // Output only the points that have depth, so that they can be copied to PCL in one block
+    pc.set_option(RS2_OPTION_POINTS_LAYOUT, RS2_POINTS_LAYOUT_PACKED_FLOAT);
     // We want the points object to be persistent so we can display the last cloud when a frame drops
     rs2::points points;
 
@@ -72,7 +54,7 @@ int main(int argc, char * argv[]) try
     // Generate the pointcloud and texture mappings
     points = pc.calculate(depth);
 
-    auto pcl_points = points_to_pcl(points);
+    auto pcl_points = rs2::points_to_pcl(points);
 
     pcl_ptr cloud_filtered(new pcl::PointCloud<pcl::PointXYZ>);
     pcl::PassThrough<pcl::PointXYZ> pass;
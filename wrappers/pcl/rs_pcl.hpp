@@ -0,0 +1,76 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/rs.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <stdexcept>
+
+namespace rs2
+{
+    namespace pcl_interop
+    {
+        // Returns true, with the number of points, if the points are in RS2_POINTS_LAYOUT_PACKED_FLOAT
+        inline bool packed_point_count( const rs2::points & points, size_t & count )
+        {
+            if( ! points.supports_frame_metadata( RS2_FRAME_METADATA_POINT_COUNT ) )
+                return false;
+            count = size_t( points.get_frame_metadata( RS2_FRAME_METADATA_POINT_COUNT ) );
+            if( size_t( points.get_data_size() ) != count * 5 * sizeof( float ) )
+                throw std::runtime_error( "only RS2_POINTS_LAYOUT_PACKED_FLOAT can be converted to PCL; "
+                                          "the half-precision and millimeter layouts need unpacking" );
+            return true;
+        }
+    }
+
+    /**
+    * Build a PCL cloud from the valid points only (the ones with depth, inside the pointcloud's bounds).
+    * With RS2_POINTS_LAYOUT_PACKED_FLOAT the x, y and z arrays go into the cloud in a single strided copy;
+    * with the interleaved layout the points without depth are skipped as they're copied.
+    * PCL points are padded to 16 bytes, so they can't alias the frame data, and this always copies.
+    * \param[in] points   a points frame
+    * \return             an unorganized, dense cloud; PointT has to start with PCL_ADD_POINT4D (x, y, z first)
+    */
+    template< class PointT = pcl::PointXYZ >
+    typename pcl::PointCloud< PointT >::Ptr points_to_pcl( const rs2::points & points )
+    {
+        static_assert( sizeof( PointT ) % sizeof( float ) == 0, "PointT must be made of floats" );
+        typename pcl::PointCloud< PointT >::Ptr cloud( new pcl::PointCloud< PointT > );
+
+        size_t count;
+        if( pcl_interop::packed_point_count( points, count ) )
+        {
+            cloud->resize( count );
+            if( count )
+            {
+                auto xyz = static_cast< const float * >( points.get_data() );
+                cloud->getMatrixXfMap( 3, sizeof( PointT ) / sizeof( float ), 0 )
+                    = Eigen::Map< const Eigen::Matrix< float, 3, Eigen::Dynamic, Eigen::RowMajor > >( xyz, 3, count );
+            }
+        }
+        else
+        {
+            auto v = points.get_vertices();
+            cloud->reserve( points.size() );
+            for( size_t i = 0; i < points.size(); ++i, ++v )
+            {
+                if( ! v->z )
+                    continue;
+                PointT p;
+                p.x = v->x;
+                p.y = v->y;
+                p.z = v->z;
+                cloud->push_back( p );
+            }
+        }
+
+        cloud->width = uint32_t( cloud->size() );
+        cloud->height = 1;
+        cloud->is_dense = true;
+        return cloud;
+    }
+}
@@ -155,5 +155,47 @@ void init_c_files(py::module &m) {
             ss << "\ntranslation: " << array_to_string(e.translation);
             return ss.str();
         });
+
+    py::class_<rs2_stream_telemetry> stream_telemetry(m, "stream_telemetry", "What a sensor got from its backend for one of its streams, and what it handed on to its callback.");
+    stream_telemetry.def(py::init<>())
+        .def_readonly("stream", &rs2_stream_telemetry::stream)
+        .def_readonly("index", &rs2_stream_telemetry::index)
+        .def_readonly("frames_received", &rs2_stream_telemetry::frames_received, "Frames that came from the backend")
+        .def_readonly("frames_delivered", &rs2_stream_telemetry::frames_delivered, "Frames handed to the sensor's callback")
+        .def_readonly("frames_dropped", &rs2_stream_telemetry::frames_dropped, "Frames missing between delivered ones, going by their frame numbers")
+        .def_readonly("frames_discarded", &rs2_stream_telemetry::frames_discarded, "Of the dropped ones: received, but no frame was available because too many were still held")
+        .def_readonly("size_anomalies", &rs2_stream_telemetry::size_anomalies, "Frames received with a size other than their stream profile calls for")
+        .def_readonly("backend_errors", &rs2_stream_telemetry::backend_errors, "Errors the backend reported for the sensor, the same for all its streams")
+        .def_readonly("latency_last_ms", &rs2_stream_telemetry::latency_last_ms, "From the arrival of a frame in the backend until it was handed to the callback")
+        .def_readonly("latency_avg_ms", &rs2_stream_telemetry::latency_avg_ms)
+        .def_readonly("latency_max_ms", &rs2_stream_telemetry::latency_max_ms)
+        .def_readonly("queue_depth", &rs2_stream_telemetry::queue_depth, "Frames of the stream currently held downstream")
+        .def_readonly("queue_depth_max", &rs2_stream_telemetry::queue_depth_max)
+        .def("__repr__", [](const rs2_stream_telemetry &t) {
+            std::stringstream ss;
+            ss << rs2_stream_to_string(t.stream) << " " << t.index << ": " << t.frames_delivered << "/" << t.frames_received
+               << " delivered, " << t.frames_dropped << " dropped, latency " << t.latency_avg_ms << " ms";
+            return ss.str();
+        });
     /** end rs_sensor.h **/
+
+    /** rs_device.h **/
+    py::class_<rs2_global_time_telemetry> global_time_telemetry(m, "global_time_telemetry", "What it costs a device to keep its global time.");
+    global_time_telemetry.def(py::init<>())
+        .def_readonly("polls", &rs2_global_time_telemetry::polls, "Reads of the device clock")
+        .def_readonly("failed_polls", &rs2_global_time_telemetry::failed_polls)
+        .def_readonly("command_last_ms", &rs2_global_time_telemetry::command_last_ms, "From sending a read of the device clock until it was answered")
+        .def_readonly("command_avg_ms", &rs2_global_time_telemetry::command_avg_ms)
+        .def_readonly("command_max_ms", &rs2_global_time_telemetry::command_max_ms)
+        .def_readonly("residual_ms", &rs2_global_time_telemetry::residual_ms, "RMS of the samples' distance from the fit")
+        .def_readonly("drift_ms", &rs2_global_time_telemetry::drift_ms, "How far the last sample was from the fit before it")
+        .def_readonly("interval_ms", &rs2_global_time_telemetry::interval_ms, "Until the next read of the device clock")
+        .def_readonly("users", &rs2_global_time_telemetry::users, "Sensors streaming with global time")
+        .def("__repr__", [](const rs2_global_time_telemetry &t) {
+            std::stringstream ss;
+            ss << t.polls << " polls (" << t.failed_polls << " failed), " << t.command_avg_ms << " ms each, every "
+               << t.interval_ms << " ms";
+            return ss.str();
+        });
+    /** end rs_device.h **/
 }
@@ -42,6 +42,9 @@ PYBIND11_MODULE(NAME, m) {
 
     m.def("log_to_console", &rs2::log_to_console, "min_severity"_a);
     m.def("log_to_file", &rs2::log_to_file, "min_severity"_a, "file_path"_a);
+    m.def("log_to_binary_file", &rs2::log_to_binary_file, "min_severity"_a, "file_path"_a);
+    m.def("enable_frame_tracing", &rs2::enable_frame_tracing, "enable"_a = true);
+    m.def("export_frame_trace", &rs2::export_frame_trace, "file_path"_a);
     m.def("reset_logger", &rs2::reset_logger);
     m.def("enable_rolling_log_file", &rs2::enable_rolling_log_file, "max_size"_a);
 
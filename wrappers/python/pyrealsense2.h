@@ -186,6 +186,7 @@ public:
     size_t _ndim = 0;             // Number of dimensions
     std::vector<size_t> _shape;   // Shape of the tensor (1 entry per dimension)
     std::vector<size_t> _strides; // Number of entries between adjacent entries (for each per dimension)
+    std::shared_ptr<void> _owner; // What the storage belongs to (e.g., the frame), for arrays to keep it alive
 public:
     BufData(void *ptr, size_t itemsize, const std::string& format, size_t ndim, const std::vector<size_t> &shape, const std::vector<size_t> &strides)
         : _ptr(ptr), _itemsize(itemsize), _format(format), _ndim(ndim), _shape(shape), _strides(strides) {}
@@ -197,6 +198,9 @@ public:
         size_t dim, // number of data elements per group (e.g. 3 for float xyz)
         size_t count) // Number of groups
         : BufData(ptr, itemsize, format, 2, std::vector<size_t> { count, dim }, std::vector<size_t> { itemsize*dim, itemsize }) { }
+
+    template<class T>
+    BufData owned_by(const T& owner) && { _owner = std::make_shared<T>(owner); return std::move(*this); }
 };
 
 /*PYBIND11_MAKE_OPAQUE(std::vector<rs2::stream_profile>)*/
@@ -259,5 +259,7 @@ void init_serializable_device(py::module& m) {
     py::class_<rs2::serializable_device> serializable_device(m, "serializable_device");
     serializable_device.def(py::init<rs2::device>(), "device"_a)
         .def("serialize_json", &rs2::serializable_device::serialize_json)
-        .def("load_json", &rs2::serializable_device::load_json, "json_content"_a);
+        .def("load_json", &rs2::serializable_device::load_json, "json_content"_a)
+        .def("serialize_snapshot", &rs2::serializable_device::serialize_snapshot)
+        .def("load_snapshot", &rs2::serializable_device::load_snapshot, "snapshot"_a);
 }
@@ -26,6 +26,7 @@ void init_device(py::module &m) {
         .def("get_info", &rs2::device::get_info, "Retrieve camera specific information, "
              "like versions of various internal components", "info"_a)
         .def("hardware_reset", &rs2::device::hardware_reset, "Send hardware reset request to the device")
+        .def("get_global_time_telemetry", &rs2::device::get_global_time_telemetry, "What it costs the device to keep its global time; the device must be a global timer")
         .def(py::init<>())
         .def("__nonzero__", &rs2::device::operator bool) // Called to implement truth value testing in Python 2
         .def("__bool__", &rs2::device::operator bool) // Called to implement truth value testing in Python 3
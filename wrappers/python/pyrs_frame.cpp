@@ -20,6 +20,154 @@ namespace {
     }
 
 
+    // The DLPack ABI (see dlpack.h, of which this is all we need), for other libraries to take frames without copying
+    enum { kDLCPU = 1, kDLCUDA = 2 };
+    enum { kDLInt = 0, kDLUInt = 1, kDLFloat = 2 };
+    struct DLDevice { int32_t device_type; int32_t device_id; };
+    struct DLDataType { uint8_t code; uint8_t bits; uint16_t lanes; };
+    struct DLTensor
+    {
+        void * data;
+        DLDevice device;
+        int32_t ndim;
+        DLDataType dtype;
+        int64_t * shape;
+        int64_t * strides;  // In elements
+        uint64_t byte_offset;
+    };
+    struct DLManagedTensor
+    {
+        DLTensor dl_tensor;
+        void * manager_ctx;
+        void ( *deleter )( DLManagedTensor * );
+    };
+
+
+    // A frame as a tensor, keeping the frame alive for as long as the tensor is
+    struct frame_tensor
+    {
+        rs2::frame frame;
+        std::vector< int64_t > shape, strides;
+        DLManagedTensor managed;
+    };
+
+
+    // Frame data is laid out as in get_data(), but for points, which are their vertices (N x 3 floats). Video frames
+    // that a CUDA processing block left on the GPU stay there.
+    std::unique_ptr< frame_tensor > make_tensor( rs2::frame const & f )
+    {
+        std::unique_ptr< frame_tensor > t( new frame_tensor() );
+        t->frame = f;
+        auto & dl = t->managed.dl_tensor;
+        dl = {};
+        dl.device = { kDLCPU, 0 };
+        dl.dtype = { kDLUInt, 8, 1 };
+
+        if( auto pts = f.as< rs2::points >() )
+        {
+            dl.data = const_cast< rs2::vertex * >( pts.get_vertices() );
+            dl.dtype = { kDLFloat, 32, 1 };
+            t->shape = { int64_t( pts.size() ), 3 };
+            t->strides = { 3, 1 };
+        }
+        else if( auto vf = f.as< rs2::video_frame >() )
+        {
+            int device = -1;
+            if( auto cuda = vf.get_cuda_data( &device ) )
+            {
+                dl.data = const_cast< void * >( cuda );
+                dl.device = { kDLCUDA, device };
+            }
+            else
+                dl.data = const_cast< void * >( vf.get_data() );
+
+            int64_t h = vf.get_height(), w = vf.get_width(), bpp = vf.get_bytes_per_pixel();
+            int64_t stride = vf.get_stride_in_bytes();
+            auto format = vf.get_profile().format();
+            int channels = 1;
+            switch( format )
+            {
+            case RS2_FORMAT_RGB8: case RS2_FORMAT_BGR8: channels = 3; break;
+            case RS2_FORMAT_RGBA8: case RS2_FORMAT_BGRA8: channels = 4; break;
+            case RS2_FORMAT_DISPARITY32: case RS2_FORMAT_DISTANCE: dl.dtype = { kDLFloat, 32, 1 }; break;
+            default:
+                if( bpp == 2 || bpp == 4 )
+                    dl.dtype = { kDLUInt, uint8_t( bpp * 8 ), 1 };
+                else
+                    channels = int( bpp );  // As bytes
+            }
+            auto item = dl.dtype.bits / 8;
+            if( channels > 1 )
+            {
+                t->shape = { h, w, channels };
+                t->strides = { stride / item, channels, 1 };
+            }
+            else
+            {
+                t->shape = { h, w };
+                t->strides = { stride / item, 1 };
+            }
+        }
+        else
+        {
+            dl.data = const_cast< void * >( f.get_data() );
+            t->shape = { int64_t( f.get_data_size() ) };
+            t->strides = { 1 };
+        }
+
+        dl.ndim = int32_t( t->shape.size() );
+        dl.shape = t->shape.data();
+        dl.strides = t->strides.data();
+        t->managed.manager_ctx = t.get();
+        t->managed.deleter = []( DLManagedTensor * m ) { delete static_cast< frame_tensor * >( m->manager_ctx ); };
+        return t;
+    }
+
+
+    // The capsule is the consumer's to rename once it takes the tensor, and delete; until then, it's ours
+    py::object to_dlpack( rs2::frame const & f )
+    {
+        auto t = make_tensor( f );
+        auto capsule = PyCapsule_New( &t->managed, "dltensor", []( PyObject * capsule ) {
+            if( ! PyCapsule_IsValid( capsule, "dltensor" ) )
+                return;  // Consumed
+            auto m = static_cast< DLManagedTensor * >( PyCapsule_GetPointer( capsule, "dltensor" ) );
+            m->deleter( m );
+        } );
+        if( ! capsule )
+            throw py::error_already_set();
+        t.release();
+        return py::reinterpret_steal< py::object >( capsule );
+    }
+
+
+    // For CuPy, Numba and the likes: only where the frame is on the GPU (otherwise there's no such attribute), and only
+    // as long as the frame object is around
+    py::dict cuda_array_interface( rs2::frame const & f )
+    {
+        auto t = make_tensor( f );
+        auto & dl = t->managed.dl_tensor;
+        if( dl.device.device_type != kDLCUDA )
+            throw py::attribute_error( "frame data is not on the GPU" );
+
+        std::string typestr = std::string( "<" ) + ( dl.dtype.code == kDLFloat ? 'f' : 'u' ) + std::to_string( dl.dtype.bits / 8 );
+        py::list shape, strides;
+        for( int i = 0; i < dl.ndim; ++i )
+        {
+            shape.append( dl.shape[i] );
+            strides.append( dl.strides[i] * dl.dtype.bits / 8 );
+        }
+        py::dict d;
+        d["shape"] = py::tuple( shape );
+        d["strides"] = py::tuple( strides );
+        d["typestr"] = typestr;
+        d["data"] = py::make_tuple( reinterpret_cast< uintptr_t >( dl.data ), true );  // Read only
+        d["version"] = 3;
+        d["stream"] = py::none();  // The data is complete by the time the frame is handed on
+        return d;
+    }
+
+
 }
 
 
@@ -44,21 +192,21 @@ void init_frame(py::module &m) {
             case RS2_FORMAT_RGB8: case RS2_FORMAT_BGR8:
                 return BufData(const_cast<void*>(vf.get_data()), 1, bytes_per_pixel_to_format[1], 3,
                     { static_cast<size_t>(vf.get_height()), static_cast<size_t>(vf.get_width()), 3 },
-                    { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()), 1 });
+                    { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()), 1 }).owned_by(self);
                 break;
             case RS2_FORMAT_RGBA8: case RS2_FORMAT_BGRA8:
                 return BufData(const_cast<void*>(vf.get_data()), 1, bytes_per_pixel_to_format[1], 3,
                     { static_cast<size_t>(vf.get_height()), static_cast<size_t>(vf.get_width()), 4 },
-                    { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()), 1 });
+                    { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()), 1 }).owned_by(self);
                 break;
             default:
                 return BufData(const_cast<void*>(vf.get_data()), static_cast<size_t>(vf.get_bytes_per_pixel()), bytes_per_pixel_to_format[vf.get_bytes_per_pixel()], 2,
                     { static_cast<size_t>(vf.get_height()), static_cast<size_t>(vf.get_width()) },
-                    { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()) });
+                    { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()) }).owned_by(self);
             }
         }
         else
-            return BufData(const_cast<void*>(self.get_data()), 1, std::string("@B"), self.get_data_size()); };
+            return BufData(const_cast<void*>(self.get_data()), 1, std::string("@B"), self.get_data_size()).owned_by(self); };
     
     /* rs_frame.hpp */
     py::class_<rs2::stream_profile> stream_profile(m, "stream_profile", "Stores details about the profile of a stream.");
@@ -143,8 +291,19 @@ void init_frame(py::module &m) {
         .def("get_frame_number", &rs2::frame::get_frame_number, "Retrieve the frame number.")
         .def_property_readonly("frame_number", &rs2::frame::get_frame_number, "The frame number. Identical to calling get_frame_number.")
         .def("get_data_size", &rs2::frame::get_data_size, "Retrieve data size from frame handle.")
-        .def("get_data", get_frame_data, "Retrieve data from the frame handle.", py::keep_alive<0, 1>())
+        .def("get_data", get_frame_data, "Retrieve data from the frame handle. Arrays made of it, e.g. with numpy.asanyarray, "
+             "keep the frame alive (and out of its pool): copy what's kept for long.", py::keep_alive<0, 1>())
         .def_property_readonly("data", get_frame_data, "Data from the frame handle. Identical to calling get_data.", py::keep_alive<0, 1>())
+        .def("__dlpack__", []( const rs2::frame & self, py::object /*stream*/, py::kwargs ) { return to_dlpack( self ); },
+             "The frame data as a DLPack capsule, without copying, for e.g. numpy.from_dlpack or torch.from_dlpack; the "
+             "tensor keeps the frame alive. Points are their vertices. Frames left on the GPU by a CUDA block stay there.",
+             "stream"_a = py::none())
+        .def("__dlpack_device__", []( const rs2::frame & self ) {
+                 auto t = make_tensor( self );
+                 return py::make_tuple( t->managed.dl_tensor.device.device_type, t->managed.dl_tensor.device.device_id );
+             }, "Where the frame data is, as a DLPack (device type, device id)")
+        .def_property_readonly("__cuda_array_interface__", cuda_array_interface,
+                               "The frame data on the GPU, for CuPy or Numba; only for frames a CUDA block left there")
         .def("get_profile", &rs2::frame::get_profile, "Retrieve stream profile from frame handle.")
         .def_property_readonly("profile", &rs2::frame::get_profile, "Stream profile from frame handle. Identical to calling get_profile.")
         .def("keep", &rs2::frame::keep, "Keep the frame, otherwise if no refernce to the frame, the frame will be released.")
@@ -246,11 +405,11 @@ void init_frame(py::module &m) {
             size_t h = profile.height(), w = profile.width();
             switch (dims) {
             case 1:
-                return BufData(verts, sizeof(rs2::vertex), "@fff", self.size());
+                return BufData(verts, sizeof(rs2::vertex), "@fff", self.size()).owned_by(self);
             case 2:
-                return BufData(verts, sizeof(float), "@f", 3, self.size());
+                return BufData(verts, sizeof(float), "@f", 3, self.size()).owned_by(self);
             case 3:
-                return BufData(verts, sizeof(float), "@f", 3, { h, w, 3 }, { w*3*sizeof(float), 3*sizeof(float), sizeof(float) });
+                return BufData(verts, sizeof(float), "@f", 3, { h, w, 3 }, { w*3*sizeof(float), 3*sizeof(float), sizeof(float) }).owned_by(self);
             default:
                 throw std::domain_error("dims arg only supports values of 1, 2 or 3");
             }
@@ -261,11 +420,11 @@ void init_frame(py::module &m) {
             size_t h = profile.height(), w = profile.width();
             switch (dims) {
             case 1:
-                return BufData(tex, sizeof(rs2::texture_coordinate), "@ff", self.size());
+                return BufData(tex, sizeof(rs2::texture_coordinate), "@ff", self.size()).owned_by(self);
             case 2:
-                return BufData(tex, sizeof(float), "@f", 2, self.size());
+                return BufData(tex, sizeof(float), "@f", 2, self.size()).owned_by(self);
             case 3:
-                return BufData(tex, sizeof(float), "@f", 2, { h, w, 2 }, { w*2*sizeof(float), 2*sizeof(float), sizeof(float) });
+                return BufData(tex, sizeof(float), "@f", 2, { h, w, 2 }, { w*2*sizeof(float), 2*sizeof(float), sizeof(float) }).owned_by(self);
             default:
                 throw std::domain_error("dims arg only supports values of 1, 2 or 3");
             }
@@ -3,6 +3,7 @@ Copyright(c) 2017 Intel Corporation. All Rights Reserved. */
 
 #include "pyrealsense2.h"
 #include <librealsense2/hpp/rs_processing.hpp>
+#include <algorithm>
 
 void init_processing(py::module &m) {
     /** rs_processing.hpp **/
@@ -41,6 +42,25 @@ void init_processing(py::module &m) {
             auto success = self.try_wait_for_frame(&frame, timeout_ms);
             return std::make_tuple(success, frame);
         }, "timeout_ms"_a = 5000, py::call_guard<py::gil_scoped_release>()) // No docstring in C++
+        .def("poll_batch", [](const rs2::frame_queue &self, unsigned int max_frames, unsigned int timeout_ms) {
+            // Without the GIL, for the frames to keep coming; it's only taken once, to return them all
+            std::vector<rs2::frame> frames;
+            {
+                py::gil_scoped_release gil;
+                size_t const max = max_frames ? max_frames : std::max( self.capacity(), size_t( 1 ) );
+                rs2::frame frame;
+                if (timeout_ms ? self.try_wait_for_frame(&frame, timeout_ms) : self.poll_for_frame(&frame))
+                {
+                    frames.push_back(std::move(frame));
+                    while (frames.size() < max && self.poll_for_frame(&frame))
+                        frames.push_back(std::move(frame));
+                }
+            }
+            return frames;
+        }, "Dequeue all the frames available, or up to max_frames of them, at once; if there are none, wait for up to "
+           "timeout_ms for the first. Python's overhead is there once per batch, rather than once per frame, so this "
+           "is for high frame rates (e.g., with motion streams): start the sensor or pipeline with the queue, and "
+           "poll it in batches.", "max_frames"_a = 0, "timeout_ms"_a = 0)
         .def("__call__", &rs2::frame_queue::operator(), "Identical to calling enqueue.", "f"_a)
         .def("capacity", &rs2::frame_queue::capacity, "Return the capacity of the queue.")
         .def("size", &rs2::frame_queue::size, "Number of enqueued frames.")
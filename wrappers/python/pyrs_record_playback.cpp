@@ -22,6 +22,11 @@ void init_record_playback(py::module &m) {
              "play the same way the file was recorded. If the application takes too long to handle the callback, frames may be dropped. In non real time "
              "mode, playback will wait for each callback to finish handling the data before reading the next frame. In this mode no frames will be dropped, "
              "and the application controls the framerate of playback via callback duration.", "real_time"_a)
+        .def("set_offline", &rs2::playback::set_offline, "Set the playback to work offline, for batch processing: frames are handed out in "
+             "recorded order from a single thread, as fast as the application releases them, with reading held back while max_frames_in_flight "
+             "frames are not released. 0 turns offline playback off.", "max_frames_in_flight"_a)
+        .def("set_range", &rs2::playback::set_range, "Play only the [start, end) part of the file, in nanoseconds from its start (end 0 for the "
+             "end of the file). Takes effect the next time playback starts.", "start"_a, "end"_a)
         // set_playback_speed?
         .def("set_status_changed_callback", [](rs2::playback& self, std::function<void(rs2_playback_status)> callback) {
             self.set_status_changed_callback(callback);
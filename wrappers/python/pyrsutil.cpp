@@ -3,6 +3,32 @@ Copyright(c) 2017 Intel Corporation. All Rights Reserved. */
 
 #include "pyrealsense2.h"
 #include <librealsense2/rsutil.h>
+#include <pybind11/numpy.h>
+
+#include <vector>
+
+
+namespace {
+
+    using float_array = py::array_t< float, py::array::c_style | py::array::forcecast >;
+    using depth_array = py::array_t< uint16_t, py::array::c_style | py::array::forcecast >;
+
+    // The number of rows of an (N, columns) array, which may also be a single row of (columns,)
+    size_t rows_of( float_array const & a, py::ssize_t columns, char const * name )
+    {
+        if( a.ndim() == 1 && a.shape( 0 ) == columns )
+            return 1;
+        if( a.ndim() != 2 || a.shape( 1 ) != columns )
+            throw std::invalid_argument( std::string( name ) + " must be of shape (N, " + std::to_string( columns ) + ")" );
+        return size_t( a.shape( 0 ) );
+    }
+
+    float_array make_rows( size_t n, py::ssize_t columns )
+    {
+        return float_array( std::vector< py::ssize_t >{ py::ssize_t( n ), columns } );
+    }
+
+}
 
 
 void init_util(py::module &m) {
@@ -53,5 +79,90 @@ void init_util(py::module &m) {
     m.def("rs2_project_color_pixel_to_depth_pixel", cp_to_dp, "Given pixel coordinates of the color image and a minimum and maximum depth, compute the corresponding pixel coordinates in the depth image. Returns [-1 -1] on failure.",
           "data"_a, "depth_scale"_a, "depth_min"_a, "depth_max"_a, "depth_intrin"_a, "color_intrin"_a, "color_to_depth"_a,
           "depth_to_color"_a, "from_pixel"_a);
+
+    // The same, for arrays of them: without the GIL, and without Python in between points
+    m.def("rs2_project_points_to_pixels", [](const rs2_intrinsics& intrin, float_array points)
+    {
+        auto n = rows_of(points, 3, "points");
+        auto pixels = make_rows(n, 2);
+        auto from = points.data();
+        auto to = pixels.mutable_data();
+        py::gil_scoped_release gil;
+        for (size_t i = 0; i < n; ++i)
+            rs2_project_point_to_pixel(to + i * 2, &intrin, from + i * 3);
+        return pixels;
+    }, "rs2_project_point_to_pixel for an (N, 3) array of points; returns an (N, 2) array of pixels", "intrin"_a, "points"_a);
+
+    m.def("rs2_deproject_pixels_to_points", [](const rs2_intrinsics& intrin, float_array pixels, float_array depths)
+    {
+        auto n = rows_of(pixels, 2, "pixels");
+        if (size_t(depths.size()) != n)
+            throw std::invalid_argument("there must be a depth for each pixel");
+        auto points = make_rows(n, 3);
+        auto from = pixels.data();
+        auto depth = depths.data();
+        auto to = points.mutable_data();
+        py::gil_scoped_release gil;
+        for (size_t i = 0; i < n; ++i)
+            rs2_deproject_pixel_to_point(to + i * 3, &intrin, from + i * 2, depth[i]);
+        return points;
+    }, "rs2_deproject_pixel_to_point for an (N, 2) array of pixels and their N depths; returns an (N, 3) array of points",
+       "intrin"_a, "pixels"_a, "depths"_a);
+
+    m.def("rs2_transform_points_to_points", [](const rs2_extrinsics& extrin, float_array from_points)
+    {
+        auto n = rows_of(from_points, 3, "from_points");
+        auto to_points = make_rows(n, 3);
+        auto from = from_points.data();
+        auto to = to_points.mutable_data();
+        py::gil_scoped_release gil;
+        for (size_t i = 0; i < n; ++i)
+            rs2_transform_point_to_point(to + i * 3, &extrin, from + i * 3);
+        return to_points;
+    }, "rs2_transform_point_to_point for an (N, 3) array of points", "extrin"_a, "from_points"_a);
+
+    m.def("rs2_deproject_depth_image", [](const rs2_intrinsics& intrin, depth_array depth, float depth_scale)
+    {
+        if (depth.ndim() != 2 || depth.shape(0) != intrin.height || depth.shape(1) != intrin.width)
+            throw std::invalid_argument("depth must be of shape (intrin.height, intrin.width)");
+        size_t const w = intrin.width, h = intrin.height;
+        float_array points(std::vector< py::ssize_t >{ py::ssize_t(h), py::ssize_t(w), 3 });
+        auto from = depth.data();
+        auto to = points.mutable_data();
+        py::gil_scoped_release gil;
+        for (size_t y = 0; y < h; ++y)
+            for (size_t x = 0; x < w; ++x)
+            {
+                float pixel[2] = { float(x), float(y) };
+                auto i = y * w + x;
+                rs2_deproject_pixel_to_point(to + i * 3, &intrin, pixel, from[i] * depth_scale);
+            }
+        return points;
+    }, "Deproject a whole (height, width) Z16 depth image into a (height, width, 3) array of points, in meters. For "
+       "frames, rs.pointcloud does the same, with SIMD where available.", "intrin"_a, "depth"_a, "depth_scale"_a);
+
+    m.def("rs2_project_color_pixels_to_depth_pixels", [](depth_array data, float depth_scale, float depth_min, float depth_max,
+            const rs2_intrinsics& depth_intrin, const rs2_intrinsics& color_intrin,
+            const rs2_extrinsics& color_to_depth, const rs2_extrinsics& depth_to_color,
+            float_array from_pixels)
+    {
+        if (size_t(data.size()) < size_t(depth_intrin.width) * depth_intrin.height)
+            throw std::invalid_argument("data must be the whole depth image");
+        auto n = rows_of(from_pixels, 2, "from_pixels");
+        auto to_pixels = make_rows(n, 2);
+        auto depth = data.data();
+        auto from = from_pixels.data();
+        auto to = to_pixels.mutable_data();
+        py::gil_scoped_release gil;
+        for (size_t i = 0; i < n; ++i)
+        {
+            to[i * 2] = to[i * 2 + 1] = -1.f;
+            rs2_project_color_pixel_to_depth_pixel(to + i * 2, depth, depth_scale, depth_min, depth_max,
+                &depth_intrin, &color_intrin, &color_to_depth, &depth_to_color, from + i * 2);
+        }
+        return to_pixels;
+    }, "rs2_project_color_pixel_to_depth_pixel for an (N, 2) array of color pixels; [-1 -1] for those that fail",
+          "data"_a, "depth_scale"_a, "depth_min"_a, "depth_max"_a, "depth_intrin"_a, "color_intrin"_a, "color_to_depth"_a,
+          "depth_to_color"_a, "from_pixels"_a);
     /** end rsutil.h **/
 }
@@ -18,6 +18,9 @@ public class RsPointCloudRenderer : MonoBehaviour
     [NonSerialized]
     private Vector3[] vertices;
 
+    // Pinned once per mesh instead of on every frame
+    private PinnedArray<Vector3> pinnedVertices;
+
     FrameQueue q;
 
     void Start()
@@ -54,7 +57,10 @@ public class RsPointCloudRenderer : MonoBehaviour
                 indexFormat = IndexFormat.UInt32,
             };
 
-        vertices = new Vector3[width * height];
+        if (pinnedVertices != null)
+            pinnedVertices.Dispose();
+        pinnedVertices = new PinnedArray<Vector3>(width * height);
+        vertices = pinnedVertices.Array;
 
         var indices = new int[vertices.Length];
         for (int i = 0; i < vertices.Length; i++)
@@ -90,6 +96,12 @@ public class RsPointCloudRenderer : MonoBehaviour
             q = null;
         }
 
+        if (pinnedVertices != null)
+        {
+            pinnedVertices.Dispose();
+            pinnedVertices = null;
+        }
+
         if (mesh != null)
             Destroy(null);
     }
@@ -158,7 +170,7 @@ public class RsPointCloudRenderer : MonoBehaviour
 
                     if (points.VertexData != IntPtr.Zero)
                     {
-                        points.CopyVertices(vertices);
+                        points.CopyVertices(pinnedVertices);
 
                         mesh.vertices = vertices;
                         mesh.UploadMeshData(false);
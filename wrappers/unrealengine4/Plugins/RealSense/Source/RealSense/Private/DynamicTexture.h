@@ -1,56 +1,60 @@
-#pragma once
-
-#include "Texture2DResource.h"
-
-struct FTextureUpdateData
-{
-	class FDynamicTexture* Context;
-	void* Data;
-	uint32 DataSize;
-	uint32 Stride;
-	uint32 Width;
-	uint32 Height;
-};
-
-class FDynamicTexture
-{
-private:
-
-	FString Name;
-	UTexture2D* TextureObject = nullptr;
-
-	std::vector<FTextureUpdateData*> TudPool;
-	FThreadSafeCounter CommandCounter;
-
-	FCriticalSection StateMx;
-	FCriticalSection TudMx;
-
-	int Width = 0;
-	int Height = 0;
-	int Bpp = 0;
-	EPixelFormat Format = PF_Unknown;
-	TextureCompressionSettings Compression = TextureCompressionSettings::TC_VectorDisplacementmap;
-
-private:
-
-	void RenderCmd_CreateTexture();
-	void RenderCmd_UpdateTexture(FTextureUpdateData* Tud);
-
-public:
-
-	FDynamicTexture(FString Name, int Width, int Height, EPixelFormat Format, TextureCompressionSettings Compression);
-	virtual ~FDynamicTexture();
-
-	FTextureUpdateData* AllocBuffer();
-	void EnqueUpdateCommand(FTextureUpdateData* Tud);
-
-	void Update(const rs2::video_frame& Frame);
-	void CopyData(FTextureUpdateData* Tud, const rs2::video_frame& Frame);
-
-	inline UTexture2D* GetTextureObject() { return TextureObject; }
-	int GetWidth() const { return Width; }
-	int GetHeight() const { return Height; }
-	int GetBpp() const { return Bpp; }
-	EPixelFormat GetFormat() const { return Format; }
-	TextureCompressionSettings GetCompression() const { return Compression; }
-};
+#pragma once
+
+#include "Texture2DResource.h"
+
+struct FTextureUpdateData
+{
+	class FDynamicTexture* Context = nullptr;
+	void* Data = nullptr; // Staging buffer, allocated by AllocBuffer
+	uint32 DataSize = 0;
+	uint32 Stride = 0;
+	uint32 Width = 0;
+	uint32 Height = 0;
+	rs2::video_frame Frame = rs2::frame(); // When set, uploaded from directly instead of Data; held until then
+};
+
+class FDynamicTexture
+{
+private:
+
+	FString Name;
+	UTexture2D* TextureObject = nullptr;
+
+	std::vector<FTextureUpdateData*> TudPool;
+	FThreadSafeCounter CommandCounter;
+
+	FCriticalSection StateMx;
+	FCriticalSection TudMx;
+
+	int Width = 0;
+	int Height = 0;
+	int Bpp = 0;
+	EPixelFormat Format = PF_Unknown;
+	TextureCompressionSettings Compression = TextureCompressionSettings::TC_VectorDisplacementmap;
+
+private:
+
+	void RenderCmd_CreateTexture();
+	void RenderCmd_UpdateTexture(FTextureUpdateData* Tud);
+
+	FTextureUpdateData* AllocCommand();
+	void ReleaseCommand(FTextureUpdateData* Tud);
+
+public:
+
+	FDynamicTexture(FString Name, int Width, int Height, EPixelFormat Format, TextureCompressionSettings Compression);
+	virtual ~FDynamicTexture();
+
+	FTextureUpdateData* AllocBuffer();
+	void EnqueUpdateCommand(FTextureUpdateData* Tud);
+
+	void Update(const rs2::video_frame& Frame);
+	void CopyData(FTextureUpdateData* Tud, const rs2::video_frame& Frame);
+
+	inline UTexture2D* GetTextureObject() { return TextureObject; }
+	int GetWidth() const { return Width; }
+	int GetHeight() const { return Height; }
+	int GetBpp() const { return Bpp; }
+	EPixelFormat GetFormat() const { return Format; }
+	TextureCompressionSettings GetCompression() const { return Compression; }
+};